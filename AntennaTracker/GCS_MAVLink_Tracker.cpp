@@ -198,6 +198,18 @@ void GCS_MAVLINK_Tracker::packetReceived(const mavlink_status_t &status,
         tracker.tracking_update_pressure(packet);
         break;
     }
+
+    case MAVLINK_MSG_ID_TIMESYNC:
+    {
+        // the vehicle's response to our timesync request gives its
+        // clock, used to find how old its positions are
+        mavlink_timesync_t packet;
+        mavlink_msg_timesync_decode(&msg, &packet);
+        if (packet.tc1 != 0 && packet.ts1 == _timesync_request.sent_ts1) {
+            tracker.tracking_update_timesync(packet.ts1 / 1000, packet.tc1 / 1000, timesync_receive_timestamp_ns() / 1000);
+        }
+        break;
+    }
     }
     GCS_MAVLINK::packetReceived(status, msg);
 }
@@ -114,8 +114,17 @@ private:
         uint32_t last_update_ms;    // last position update in milliseconds
         Vector3f vel;           // the vehicle's velocity in m/s
         int32_t relative_alt;	// the vehicle's relative altitude in meters * 100
+        uint32_t time_boot_ms;  // vehicle's timestamp of the last position
+        float turn_rate;        // filtered turn rate over ground in rad/s, positive clockwise
+        float latency;          // age of the last position when it was received in seconds
     } vehicle;
 
+    // vehicle's clock measured by timesync
+    struct {
+        int64_t offset_us;      // vehicle's clock minus ours
+        bool valid;
+    } vehicle_clock;
+
     // Navigation controller state
     struct NavStatus {
         float bearing;                  // bearing to vehicle in centi-degrees
@@ -214,6 +223,7 @@ private:
     void update_tracking(void);
     void tracking_update_position(const mavlink_global_position_int_t &msg);
     void tracking_update_pressure(const mavlink_scaled_pressure_t &msg);
+    void tracking_update_timesync(uint64_t sent_us, uint64_t vehicle_us, uint64_t received_us);
     void tracking_manual_control(const mavlink_manual_control_t &msg);
     void update_armed_disarmed() const;
     bool get_pan_tilt_norm(float &pan_norm, float &tilt_norm) const override;
@@ -42,6 +42,18 @@
 #ifndef TRACKING_TIMEOUT_SEC
  # define TRACKING_TIMEOUT_SEC              5.0f    // consider we've lost track of vehicle after 5 seconds with no position update.
 #endif
+#ifndef TRACKING_MAX_LATENCY_SEC
+ # define TRACKING_MAX_LATENCY_SEC          2.0f    // longest believable age of a received vehicle position
+#endif
+#ifndef TRACKING_TURN_RATE_TC
+ # define TRACKING_TURN_RATE_TC             0.5f    // time constant in seconds of the vehicle turn rate filter
+#endif
+#ifndef TRACKING_TURN_RATE_MAX
+ # define TRACKING_TURN_RATE_MAX            1.0f    // largest vehicle turn rate in rad/s used to predict its position
+#endif
+#ifndef TRACKING_TURN_RATE_MIN_SPEED
+ # define TRACKING_TURN_RATE_MIN_SPEED      2.0f    // vehicle ground speed in m/s below which its course is too noisy to give a turn rate
+#endif
 #ifndef DISTANCE_MIN_DEFAULT
  # define DISTANCE_MIN_DEFAULT              5.0f    // do not track targets within 5 meters
 #endif
@@ -22,7 +22,6 @@ enum class PWMDisarmed {
 
 //  Filter
 #define SERVO_OUT_FILT_HZ               0.1f
-#define G_Dt                            0.02f
 
 //  Logging parameters
 #define MASK_LOG_ATTITUDE               (1<<0)
@@ -2,7 +2,7 @@
 
 /**
   update_vehicle_position_estimate - updates estimate of vehicle positions
-  should be called at 50hz
+  should be called at the loop rate
  */
 void Tracker::update_vehicle_pos_estimate()
 {
@@ -11,12 +11,23 @@ void Tracker::update_vehicle_pos_estimate()
 
     // if less than 5 seconds since last position update estimate the position
     if (dt < TRACKING_TIMEOUT_SEC) {
-        // project the vehicle position to take account of lost radio packets
+        // project the vehicle position over the time since it was
+        // sent, at a constant speed and turn rate
+        const float horizon = dt + vehicle.latency;
+        const Vector2f &vel_ne = vehicle.vel.xy();
+        Vector2f offset_ne = vel_ne * horizon;
+        const float turn = vehicle.turn_rate * horizon;
+        if (fabsf(turn) > 0.01f) {
+            // integral of the velocity rotated through the turn
+            const float s = sinf(turn) / vehicle.turn_rate;
+            const float c = (1.0f - cosf(turn)) / vehicle.turn_rate;
+            offset_ne.x = vel_ne.x * s - vel_ne.y * c;
+            offset_ne.y = vel_ne.y * s + vel_ne.x * c;
+        }
         vehicle.location_estimate = vehicle.location;
-        float north_offset = vehicle.vel.x * dt;
-        float east_offset = vehicle.vel.y * dt;
-        vehicle.location_estimate.offset(north_offset, east_offset);
-    	vehicle.location_estimate.alt += vehicle.vel.z * 100.0f * dt;
+        vehicle.location_estimate.offset(offset_ne.x, offset_ne.y);
+        // vertical velocity is positive down
+        vehicle.location_estimate.alt -= vehicle.vel.z * 100.0f * horizon;
         // set valid_location flag
         vehicle.location_valid = true;
     } else {
@@ -80,7 +91,7 @@ void Tracker::update_bearing_and_distance()
 }
 
 /**
-  main antenna tracking code, called at 50Hz
+  main antenna tracking code, called at the loop rate
  */
 void Tracker::update_tracking(void)
 {
@@ -136,11 +147,45 @@ void Tracker::tracking_update_position(const mavlink_global_position_int_t &msg)
         return;
     }
 
+    // ignore a position we already have from another link
+    if (vehicle.last_update_ms != 0 && msg.time_boot_ms != 0 && msg.time_boot_ms == vehicle.time_boot_ms) {
+        return;
+    }
+
+    const Vector3f vel{msg.vx*0.01f, msg.vy*0.01f, msg.vz*0.01f};
+
+    // filter the turn rate from the change in course since the last
+    // position, timed by the vehicle's clock to avoid link jitter
+    const float dt = (msg.time_boot_ms - vehicle.time_boot_ms) * 0.001f;
+    if (vehicle.last_update_ms != 0 && is_positive(dt) && dt < TRACKING_TIMEOUT_SEC &&
+        vel.xy().length() > TRACKING_TURN_RATE_MIN_SPEED &&
+        vehicle.vel.xy().length() > TRACKING_TURN_RATE_MIN_SPEED) {
+        const float turn_rate = constrain_float(wrap_PI(vel.xy().angle() - vehicle.vel.xy().angle()) / dt,
+                                                -TRACKING_TURN_RATE_MAX, TRACKING_TURN_RATE_MAX);
+        vehicle.turn_rate += (dt / (dt + TRACKING_TURN_RATE_TC)) * (turn_rate - vehicle.turn_rate);
+    } else {
+        vehicle.turn_rate = 0;
+    }
+
+    // age of the position from the vehicle's clock, if it is known
+    vehicle.latency = 0;
+    if (vehicle_clock.valid) {
+        const int64_t sent_us = int64_t(msg.time_boot_ms) * 1000 - vehicle_clock.offset_us;
+        const float latency = (int64_t(AP_HAL::micros64()) - sent_us) * 1.0e-6f;
+        if (latency >= 0 && latency < TRACKING_MAX_LATENCY_SEC) {
+            vehicle.latency = latency;
+        } else {
+            // the vehicle has probably rebooted, wait for the next timesync
+            vehicle_clock.valid = false;
+        }
+    }
+
     vehicle.location.lat = msg.lat;
     vehicle.location.lng = msg.lon;
     vehicle.location.alt = msg.alt/10;
     vehicle.relative_alt = msg.relative_alt/10;
-    vehicle.vel = Vector3f(msg.vx*0.01f, msg.vy*0.01f, msg.vz*0.01f);
+    vehicle.vel = vel;
+    vehicle.time_boot_ms = msg.time_boot_ms;
     vehicle.last_update_us = AP_HAL::micros();
     vehicle.last_update_ms = AP_HAL::millis();
 #if HAL_LOGGING_ENABLED
@@ -152,6 +197,26 @@ void Tracker::tracking_update_position(const mavlink_global_position_int_t &msg)
 }
 
 
+/**
+   handle the vehicle's response to a timesync request. The offset
+   of its clock assumes the request and response took equal time
+ */
+void Tracker::tracking_update_timesync(uint64_t sent_us, uint64_t vehicle_us, uint64_t received_us)
+{
+    if (received_us < sent_us || received_us - sent_us > TRACKING_MAX_LATENCY_SEC * 1.0e6f) {
+        return;
+    }
+    const uint64_t round_trip_us = received_us - sent_us;
+    const int64_t offset_us = int64_t(vehicle_us) - int64_t(sent_us + round_trip_us / 2);
+    if (!vehicle_clock.valid || llabs(offset_us - vehicle_clock.offset_us) > 1000000) {
+        vehicle_clock.offset_us = offset_us;
+        vehicle_clock.valid = true;
+        return;
+    }
+    // smooth the jitter of the link
+    vehicle_clock.offset_us += (offset_us - vehicle_clock.offset_us) / 4;
+}
+
 /**
    handle an updated pressure reading from the aircraft
  */
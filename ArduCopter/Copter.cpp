@@ -261,10 +261,6 @@ const AP_Scheduler::Task Copter::scheduler_tasks[] = {
 #if HAL_BUTTON_ENABLED
     SCHED_TASK_CLASS(AP_Button,            &copter.button,              update,           5, 100, 168),
 #endif
-#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
-    // don't delete this, there is an equivalent (virtual) in AP_Vehicle for the non-rate loop case
-    SCHED_TASK(update_dynamic_notch_at_specified_rate_main,                       LOOP_RATE, 200, 215),
-#endif
 };
 
 void Copter::get_scheduler_tasks(const AP_Scheduler::Task *&tasks,
@@ -805,19 +801,6 @@ void Copter::one_hz_loop()
 #if AC_CUSTOMCONTROL_MULTI_ENABLED
     custom_control.set_notch_sample_rate(AP::scheduler().get_filtered_loop_rate_hz());
 #endif
-
-#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
-    // see if we should have a separate rate thread
-    if (!started_rate_thread && get_fast_rate_type() != FastRateType::FAST_RATE_DISABLED) {
-        if (hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&Copter::rate_controller_thread, void),
-                                         "rate",
-                                         1536, AP_HAL::Scheduler::PRIORITY_RCOUT, 1)) {
-            started_rate_thread = true;
-        } else {
-            AP_BoardConfig::allocation_error("rate thread");
-        }
-    }
-#endif
 }
 
 void Copter::init_simple_bearing()
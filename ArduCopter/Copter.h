@@ -627,16 +627,6 @@ private:
         RELEASE_GRIPPER_ON_THRUST_LOSS = (1<<2),  // 4
     };
 
-    // type of fast rate attitude controller in operation
-    enum class FastRateType : uint8_t {
-        FAST_RATE_DISABLED            = 0,
-        FAST_RATE_DYNAMIC             = 1,
-        FAST_RATE_FIXED_ARMED         = 2,
-        FAST_RATE_FIXED               = 3,
-    };
-
-    FastRateType get_fast_rate_type() const { return FastRateType(g2.att_enable.get()); }
-
     // returns true if option is enabled for this vehicle
     bool option_is_enabled(FlightOption option) const {
         return (g2.flight_options & uint32_t(option)) != 0;
@@ -736,23 +726,21 @@ private:
     uint16_t get_pilot_speed_dn() const;
     void run_rate_controller_main();
 
-    // if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
-    struct RateControllerRates {
-        uint8_t fast_logging_rate;
-        uint8_t medium_logging_rate;
-        uint8_t filter_rate;
-        uint8_t main_loop_rate;
-    };
-
-    uint8_t calc_gyro_decimation(uint8_t gyro_decimation, uint16_t rate_hz);
-    void rate_controller_thread();
-    void rate_controller_filter_update();
-    void rate_controller_log_update();
-    void rate_controller_set_rates(uint8_t rate_decimation, RateControllerRates& rates, bool warn_cpu_high);
-    void enable_fast_rate_loop(uint8_t rate_decimation, RateControllerRates& rates);
-    void disable_fast_rate_loop(RateControllerRates& rates);
-    void update_dynamic_notch_at_specified_rate_main();
-    // endif AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // rate_thread.cpp
+    FastRateType get_fast_rate_type() const override { return FastRateType(g2.att_enable.get()); }
+    uint8_t get_fast_rate_decimation() const override { return g2.att_decimation.get(); }
+    void rate_controller_run_dt(const Vector3f &gyro_rads, float dt) override;
+    void rate_controller_output(bool full_push) override;
+    void rate_controller_set_rate(uint32_t rate_hz) override;
+    void rate_controller_set_notch_sample_rate(float sample_rate_hz) override;
+    void rate_controller_enabled(bool enabled) override;
+#if HAL_LOGGING_ENABLED
+    RateLogging get_rate_logging() override;
+    void rate_controller_log_update() override;
+    void rate_controller_log_dt(float dt, float dtAvg, float dtMax, float dtMin) override;
+#endif
+#endif
 
 #if AC_CUSTOMCONTROL_MULTI_ENABLED
     void run_custom_controller() { custom_control.update(); }
@@ -1107,9 +1095,6 @@ private:
     Mode *mode_from_mode_num(const Mode::Number mode);
     void exit_mode(Mode *&old_flightmode, Mode *&new_flightmode);
 
-    bool started_rate_thread;
-    bool using_rate_thread;
-
 public:
     void failsafe_check();      // failsafe.cpp
 };
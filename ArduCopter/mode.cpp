@@ -415,6 +415,11 @@ void Copter::update_flight_mode()
     attitude_control->landed_gain_reduction(copter.ap.land_complete); // Adjust gains when landed to attenuate ground oscillation
 
     flightmode->run();
+
+    if (using_rate_thread) {
+        // hand this loop's targets to the rate thread in one piece
+        attitude_control->publish_rate_target();
+    }
 }
 
 // exit_mode - high level call to organise cleanup as a flight mode is exited
@@ -64,6 +64,10 @@ const AP_Scheduler::Task Plane::scheduler_tasks[] = {
     FAST_TASK(ahrs_update),
     FAST_TASK(update_control_mode),
     FAST_TASK(stabilize),
+#if HAL_MOUNT_ENABLED
+    // camera mount's fast update
+    FAST_TASK_CLASS(AP_Mount, &plane.camera_mount, update_fast),
+#endif
     FAST_TASK(set_servos),
     SCHED_TASK(read_radio,             50,    100,   6),
     SCHED_TASK(check_short_failsafe,   50,    100,   9),
@@ -391,7 +395,7 @@ void Plane::one_second_loop()
 
     const float loop_rate = AP::scheduler().get_filtered_loop_rate_hz();
 #if HAL_QUADPLANE_ENABLED
-    if (quadplane.available()) {
+    if (quadplane.available() && !using_rate_thread) {
         quadplane.attitude_control->set_notch_sample_rate(loop_rate);
     }
 #endif
@@ -400,6 +404,38 @@ void Plane::one_second_loop()
     yawController.set_notch_sample_rate(loop_rate);
 }
 
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED && HAL_QUADPLANE_ENABLED
+/*
+  fast rate thread hooks. Only the VTOL rate controller is run in the
+  thread, the fixed wing controllers run their attitude and rate loops
+  together in the main loop and all outputs stay at the main loop rate
+ */
+Plane::FastRateType Plane::get_fast_rate_type() const
+{
+    if (!quadplane.available()) {
+        return FastRateType::FAST_RATE_DISABLED;
+    }
+    return FastRateType(quadplane.fast_rate_enable.get());
+}
+
+void Plane::rate_controller_run_dt(const Vector3f &gyro_rads, float dt)
+{
+    quadplane.rate_thread_run_dt(gyro_rads, dt);
+}
+
+void Plane::rate_controller_set_rate(uint32_t rate_hz)
+{
+    rate_controller_set_notch_sample_rate(rate_hz);
+}
+
+void Plane::rate_controller_set_notch_sample_rate(float sample_rate_hz)
+{
+    if (quadplane.available()) {
+        quadplane.attitude_control->set_notch_sample_rate(sample_rate_hz);
+    }
+}
+#endif // AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED && HAL_QUADPLANE_ENABLED
+
 void Plane::three_hz_loop()
 {
 #if AP_FENCE_ENABLED
@@ -1101,6 +1101,13 @@ private:
     void update_flight_stage();
     void set_flight_stage(AP_FixedWing::FlightStage fs);
     bool flight_option_enabled(FlightOptions flight_option) const;
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED && HAL_QUADPLANE_ENABLED
+    FastRateType get_fast_rate_type() const override;
+    uint8_t get_fast_rate_decimation() const override { return quadplane.fast_rate_decimation.get(); }
+    void rate_controller_run_dt(const Vector3f &gyro_rads, float dt) override;
+    void rate_controller_set_rate(uint32_t rate_hz) override;
+    void rate_controller_set_notch_sample_rate(float sample_rate_hz) override;
+#endif
 
     // navigation.cpp
     void loiter_angle_reset(void);
@@ -1034,6 +1034,7 @@ protected:
     void restore_mode(const char *reason, ModeReason modereason);
 
     bool _enter() override;
+    void _exit() override;
 };
 
 #endif
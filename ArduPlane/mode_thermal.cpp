@@ -18,6 +18,11 @@ bool ModeThermal::_enter()
     return true;
 }
 
+void ModeThermal::_exit()
+{
+    plane.g2.soaring_controller.exit_thermalling();
+}
+
 void ModeThermal::update()
 {
     plane.calc_nav_roll();
@@ -554,7 +554,23 @@ const AP_Param::GroupInfo QuadPlane::var_info2[] = {
     // @Increment: 1
     // @User: Standard
     AP_GROUPINFO("APPROACH_DIST", 39, QuadPlane, approach_distance, 0),
-    
+
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // @Param: FSTRATE_ENABLE
+    // @DisplayName: Enable the fast rate thread
+    // @Description: Enable the fast rate thread, which runs the VTOL rate controller on every filtered gyro sample while in VTOL flight. The VTOL motor outputs are still updated at the main loop rate. In the default case the fast rate divisor, which controls the update frequency of the thread, is dynamically scaled from Q_FSTRATE_DIV to avoid overrun in the gyro sample buffer and main loop slow-downs. Other values can be selected to fix the divisor to Q_FSTRATE_DIV on arming or always.
+    // @User: Advanced
+    // @Values: 0:Disabled,1:Enabled-Dynamic,2:Enabled-FixedWhenArmed,3:Enabled-Fixed
+    AP_GROUPINFO("FSTRATE_ENABLE", 40, QuadPlane, fast_rate_enable, 0),
+
+    // @Param: FSTRATE_DIV
+    // @DisplayName: Fast rate thread divisor
+    // @Description: Fast rate thread divisor used to control the maximum fast rate update rate. The actual rate is the gyro rate in Hz divided by this value. This value is scaled depending on the configuration of Q_FSTRATE_ENABLE.
+    // @User: Advanced
+    // @Range: 1 10
+    AP_GROUPINFO("FSTRATE_DIV", 41, QuadPlane, fast_rate_decimation, 1),
+#endif
+
     AP_GROUPEND
 };
 
@@ -1984,7 +2000,12 @@ void QuadPlane::motors_output(bool run_rate_controller)
         motors->set_dt_s(last_loop_time_s);
         attitude_control->set_dt_s(last_loop_time_s);
         pos_control->set_dt_s(last_loop_time_s);
-        attitude_control->rate_controller_run();
+        if (!plane.using_rate_thread) {
+            attitude_control->rate_controller_run();
+        } else {
+            // the rate thread runs the rate controller, see rate_thread_run_dt()
+            attitude_control->publish_rate_target();
+        }
         // reset sysid and other temporary inputs
         attitude_control->rate_controller_target_reset();
         last_att_control_ms = now;
@@ -2002,6 +2023,22 @@ void QuadPlane::motors_output(bool run_rate_controller)
 
 }
 
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+/*
+  run the rate controller from the fast rate thread. This only runs
+  while motors_output() is running the rate controller from the main
+  loop, which then leaves it to this thread. The motors are output by
+  the main loop
+ */
+void QuadPlane::rate_thread_run_dt(const Vector3f &gyro_rads, float dt)
+{
+    if (!available() || AP_HAL::millis() - last_att_control_ms > 20) {
+        return;
+    }
+    attitude_control->rate_controller_run_dt(gyro_rads, dt);
+}
+#endif
+
 /*
   handle a MAVLink DO_VTOL_TRANSITION
  */
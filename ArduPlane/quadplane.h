@@ -286,6 +286,10 @@ private:
 
     bool should_relax(void);
     void motors_output(bool run_rate_controller = true);
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // run the rate controller from the fast rate thread
+    void rate_thread_run_dt(const Vector3f &gyro_rads, float dt);
+#endif
     void Log_Write_QControl_Tuning();
     void log_QPOS(void);
     float landing_descent_rate_cms(float height_above_ground);
@@ -443,6 +447,12 @@ private:
     // when did we last run the attitude controller?
     uint32_t last_att_control_ms;
 
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // fast rate thread configuration
+    AP_Int8 fast_rate_enable;
+    AP_Int8 fast_rate_decimation;
+#endif
+
     // transition logic
     Transition *transition = nullptr;
 
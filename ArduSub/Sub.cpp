@@ -115,6 +115,7 @@ const AP_Scheduler::Task Sub::scheduler_tasks[] = {
 #endif
     SCHED_TASK(update_batt_compass,   10,    120,  12),
     SCHED_TASK(read_rangefinder,      20,    100,  15),
+    SCHED_TASK(read_barometer,        50,    100,  17),
     SCHED_TASK(update_altitude,       10,    100,  18),
 #if AP_SUB_RC_ENABLED
     SCHED_TASK_CLASS(RC_Channels, (RC_Channels*)&sub.g2.rc_channels, read_aux_all, 10,  50,  18),
@@ -357,12 +358,9 @@ void Sub::read_AHRS()
     ahrs_view.update();
 }
 
-// read baro and rangefinder altitude at 10hz
+// log altitude at 10hz, the baro is read at 50hz by read_barometer()
 void Sub::update_altitude()
 {
-    // read in baro altitude
-    read_barometer();
-
 #if HAL_LOGGING_ENABLED
     if (should_log(MASK_LOG_CTUN)) {
         Log_Write_Control_Tuning();
@@ -14,8 +14,10 @@ void Rover::Log_Write_Attitude()
 
     AP::ahrs().Log_Write();
 
-    // log steering rate controller
-    logger.Write_PID(LOG_PIDS_MSG, g2.attitude_control.get_steering_rate_pid().get_pid_info());
+    // log steering rate controller, the rate thread logs it when running it
+    if (!using_rate_thread) {
+        logger.Write_PID(LOG_PIDS_MSG, g2.attitude_control.get_steering_rate_pid().get_pid_info());
+    }
     logger.Write_PID(LOG_PIDA_MSG, g2.attitude_control.get_throttle_speed_pid_info());
 
     // log pitch control for balance bots
@@ -252,6 +254,29 @@ void Rover::Log_Write_Vehicle_Startup_Messages()
 // libraries/AP_Logger/Logstructure.h; search for "log_Units" for
 // units and "Format characters" for field type information
 
+struct PACKED log_Rate_Thread_Dt {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    float dt;
+    float dtAvg;
+    float dtMax;
+    float dtMin;
+};
+
+// Write the timing of the fast rate thread
+void Rover::Log_Write_Rate_Thread_Dt(float dt, float dtAvg, float dtMax, float dtMin)
+{
+    const log_Rate_Thread_Dt pkt {
+        LOG_PACKET_HEADER_INIT(LOG_RATE_THREAD_DT_MSG),
+        time_us         : AP_HAL::micros64(),
+        dt              : dt,
+        dtAvg           : dtAvg,
+        dtMax           : dtMax,
+        dtMin           : dtMin
+    };
+    logger.WriteBlock(&pkt, sizeof(pkt));
+}
+
 const LogStructure Rover::log_structure[] = {
     LOG_COMMON_STRUCTURES,
 
@@ -306,6 +331,17 @@ const LogStructure Rover::log_structure[] = {
     
     { LOG_GUIDEDTARGET_MSG, sizeof(log_GuidedTarget),
       "GUIP",  "QBffffff",    "TimeUS,Type,pX,pY,pZ,vX,vY,vZ", "s-mmmnnn", "F-000000" },
+
+// @LoggerMessage: RTDT
+// @Description: Steering rate controller time deltas in the fast rate thread
+// @Field: TimeUS: Time since system startup
+// @Field: dt: current time delta
+// @Field: dtAvg: current time delta average
+// @Field: dtMax: Max time delta since last log output
+// @Field: dtMin: Min time delta since last log output
+
+    { LOG_RATE_THREAD_DT_MSG, sizeof(log_Rate_Thread_Dt),
+      "RTDT", "Qffff", "TimeUS,dt,dtAvg,dtMax,dtMin", "sssss", "F----" , true },
 };
 
 uint8_t Rover::get_num_log_structures() const
@@ -428,6 +428,12 @@ public:
     AP_Float fs_gcs_timeout;
 
     class ModeCircle mode_circle;
+
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // fast rate thread configuration
+    AP_Int8 fast_rate_enable;
+    AP_Int8 fast_rate_decimation;
+#endif
 };
 
 extern const AP_Param::Info var_info[];
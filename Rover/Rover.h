@@ -348,12 +348,28 @@ private:
     void Log_Write_Throttle();
     void Log_Write_RC(void);
     void Log_Write_Vehicle_Startup_Messages();
+    void Log_Write_Rate_Thread_Dt(float dt, float dtAvg, float dtMax, float dtMin);
     void Log_Read(uint16_t log_num, uint16_t start_page, uint16_t end_page);
 #endif
 
     // mode.cpp
     Mode *mode_from_mode_num(enum Mode::Number num);
 
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // rate_thread.cpp
+    FastRateType get_fast_rate_type() const override { return FastRateType(g2.fast_rate_enable.get()); }
+    uint8_t get_fast_rate_decimation() const override { return g2.fast_rate_decimation.get(); }
+    void rate_controller_run_dt(const Vector3f &gyro_rads, float dt) override;
+    void rate_controller_set_rate(uint32_t rate_hz) override;
+    void rate_controller_set_notch_sample_rate(float sample_rate_hz) override;
+    void rate_controller_enabled(bool enabled) override;
+#if HAL_LOGGING_ENABLED
+    RateLogging get_rate_logging() override;
+    void rate_controller_log_update() override;
+    void rate_controller_log_dt(float dt, float dtAvg, float dtMax, float dtMin) override;
+#endif
+#endif
+
     // Parameters.cpp
     void load_parameters(void) override;
 
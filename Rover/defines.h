@@ -15,6 +15,7 @@ enum LoggingParameters {
     LOG_NTUN_MSG,
     LOG_STEERING_MSG,
     LOG_GUIDEDTARGET_MSG,
+    LOG_RATE_THREAD_DT_MSG,
 };
 
 #define MASK_LOG_ATTITUDE_FAST  (1<<0)
@@ -0,0 +1,76 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Rover.h"
+#include <AP_InertialSensor/AP_InertialSensor_rate_config.h>
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+
+#pragma GCC optimize("O2")
+
+/*
+  Rover hooks for the fast rate thread, see AP_Vehicle_rate_thread.cpp
+  for the design of the thread. Only the steering rate controller is
+  run in the thread, on each filtered gyro sample, while the heading,
+  navigation and speed controllers stay in the main loop. The steering
+  and throttle outputs are still updated by the main loop, which takes
+  the latest steering rate controller output
+ */
+
+void Rover::rate_controller_run_dt(const Vector3f &gyro_rads, float dt)
+{
+    g2.attitude_control.steering_rate_controller_run_dt(gyro_rads * ahrs.get_rotation_body_to_ned().c, dt);
+}
+
+void Rover::rate_controller_set_rate(uint32_t rate_hz)
+{
+    rate_controller_set_notch_sample_rate(rate_hz);
+}
+
+void Rover::rate_controller_set_notch_sample_rate(float sample_rate_hz)
+{
+    g2.attitude_control.get_steering_rate_pid().set_notch_sample_rate(sample_rate_hz);
+}
+
+void Rover::rate_controller_enabled(bool enabled)
+{
+    g2.attitude_control.set_fast_rate_enabled(enabled);
+}
+
+#if HAL_LOGGING_ENABLED
+Rover::RateLogging Rover::get_rate_logging()
+{
+    if (should_log(MASK_LOG_ATTITUDE_FAST)) {
+        return RateLogging::FAST;
+    }
+    if (should_log(MASK_LOG_ATTITUDE_MED)) {
+        return RateLogging::MEDIUM;
+    }
+    return RateLogging::NONE;
+}
+
+/*
+  log only those items that are updated at the rate loop rate
+ */
+void Rover::rate_controller_log_update()
+{
+    logger.Write_PID(LOG_PIDS_MSG, g2.attitude_control.get_steering_rate_pid().get_pid_info());
+}
+
+void Rover::rate_controller_log_dt(float dt, float dtAvg, float dtMax, float dtMin)
+{
+    Log_Write_Rate_Thread_Dt(dt, dtAvg, dtMax, dtMin);
+}
+#endif // HAL_LOGGING_ENABLED
+
+#endif // AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
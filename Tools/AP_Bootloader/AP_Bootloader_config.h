@@ -10,3 +10,9 @@
 #ifndef AP_BOOTLOADER_NETWORK_ENABLED
 #define AP_BOOTLOADER_NETWORK_ENABLED AP_NETWORKING_ENABLED
 #endif
+
+// DroneCAN updates fetch only the flash sectors that differ from the
+// new image, using the block CRC map served beside the firmware
+#ifndef AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+#define AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED 1
+#endif
@@ -82,6 +82,15 @@
 // GET_CRC		verify CRC of entire flashable area
 // RESET		finalise flash programming, reset chip and starts application
 //
+// Where GET_DEVICE/DEVICE_CAPS reports CAP_PROG_BLOCK the faster workflow is:
+//
+// CHIP_ERASE_LAZY	reset address counter, sectors are erased as programming reaches them
+// loop:
+//      PROG_BLOCK      program a block at an address with a CRC, the host may
+//                      send the next block before the reply to this one so that
+//                      it is received while this one is erased and written
+// GET_CRC		erase any sectors not yet reached and verify CRC
+//
 
 #define BL_PROTOCOL_VERSION 		5		// The revision of the bootloader protocol
 // protocol bytes
@@ -117,9 +126,12 @@
 #define PROTO_EXTF_GET_CRC          0x37	// compute & return a CRC of data in external flash
 
 #define PROTO_CHIP_FULL_ERASE   0x40    // erase program area and reset program address, skip any flash wear optimization and force an erase
+#define PROTO_CHIP_ERASE_LAZY   0x41    // reset program address, erase each sector when programming reaches it
+#define PROTO_PROG_BLOCK        0x42    // write a CRC checked block at an address
 
 #define PROTO_PROG_MULTI_MAX    64	// maximum PROG_MULTI size
 #define PROTO_READ_MULTI_MAX    255	// size of the size field
+#define PROTO_PROG_BLOCK_MAX    1024    // maximum PROG_BLOCK size
 
 /* argument values for PROTO_GET_DEVICE */
 #define PROTO_DEVICE_BL_REV	1	// bootloader revision
@@ -128,6 +140,10 @@
 #define PROTO_DEVICE_FW_SIZE	4	// size of flashable area
 #define PROTO_DEVICE_VEC_AREA	5	// contents of reserved vectors 7-10
 #define PROTO_DEVICE_EXTF_SIZE  6   // size of available external flash
+#define PROTO_DEVICE_CAPS       7   // PROTO_CAP_* flags
+
+/* flags returned for PROTO_DEVICE_CAPS */
+#define PROTO_CAP_PROG_BLOCK    (1U<<0) // CHIP_ERASE_LAZY and PROG_BLOCK
 // all except PROTO_DEVICE_VEC_AREA and PROTO_DEVICE_BOARD_REV should be done
 #define CHECK_GET_DEVICE_FINISHED(x)   ((x & (0xB)) == 0xB)
 
@@ -402,6 +418,37 @@ cout_word(uint32_t val)
     cout((uint8_t *)&val, 4);
 }
 
+/*
+  state of a CHIP_ERASE_LAZY upload, the flash is erased from the
+  start of the program area up to erased_end
+ */
+static struct {
+    bool active;
+    uint16_t next_sector;
+    uint32_t erased_end;
+} lazy_erase;
+
+/*
+  erase sectors until the flash is erased up to end
+ */
+static bool
+lazy_erase_to(uint32_t end)
+{
+    while (lazy_erase.erased_end < end) {
+        const uint32_t size = flash_func_sector_size(lazy_erase.next_sector);
+        if (size == 0) {
+            // end of the program area
+            return true;
+        }
+        if (!flash_func_erase_sector(lazy_erase.next_sector)) {
+            return false;
+        }
+        lazy_erase.erased_end += size;
+        lazy_erase.next_sector++;
+    }
+    return true;
+}
+
 #define TEST_FLASH 0
 
 #if TEST_FLASH
@@ -497,8 +544,8 @@ bootloader(unsigned timeout)
         volatile int c;
         int arg;
         static union {
-            uint8_t		c[256];
-            uint32_t	w[64];
+            uint8_t		c[PROTO_PROG_BLOCK_MAX];
+            uint32_t	w[PROTO_PROG_BLOCK_MAX/4];
         } flash_buffer;
 
         // Wait for a command byte
@@ -603,6 +650,10 @@ bootloader(unsigned timeout)
                 cout((uint8_t *)&board_info.extf_size, sizeof(board_info.extf_size));
                 break;
 
+            case PROTO_DEVICE_CAPS:
+                cout_word(PROTO_CAP_PROG_BLOCK);
+                break;
+
             default:
                 goto cmd_bad;
             }
@@ -634,6 +685,7 @@ bootloader(unsigned timeout)
             // to zero
             done_erase = true;
             timeout = 0;
+            lazy_erase.active = false;
             
             flash_set_keep_unlocked(true);
 
@@ -668,6 +720,110 @@ bootloader(unsigned timeout)
             led_set(LED_BLINK);
             break;
 
+        // prepare for programming, erasing each sector when it is
+        // first programmed so the erase overlaps receiving the data
+        //
+        // command:		CHIP_ERASE_LAZY/EOC
+        // success reply:	INSYNC/OK
+        //
+        case PROTO_CHIP_ERASE_LAZY:
+            if (!done_sync || !CHECK_GET_DEVICE_FINISHED(done_get_device_flags)) {
+                // lower chance of random data on a uart triggering erase
+                goto cmd_bad;
+            }
+
+            /* expect EOC */
+            if (!wait_for_eoc(2)) {
+                goto cmd_bad;
+            }
+
+            done_erase = true;
+            timeout = 0;
+
+            flash_set_keep_unlocked(true);
+
+            lazy_erase.active = true;
+            lazy_erase.next_sector = 0;
+            lazy_erase.erased_end = 0;
+            address = 0;
+            break;
+
+        // program a block at an address
+        //
+        // command:		PROG_BLOCK/<address:4>/<len:2>/<data:len>/<crc:4>/EOC
+        // success reply:	<next address:4>/INSYNC/OK
+        // invalid reply:	INSYNC/INVALID
+        // bad CRC, address or write failure:	<next address:4>/INSYNC/FAILURE
+        //
+        // on failure the host resends from the next address
+        //
+        case PROTO_PROG_BLOCK: {
+            if (!lazy_erase.active) {
+                goto cmd_bad;
+            }
+
+            uint32_t block_address;
+            if (cin_word(&block_address, 100)) {
+                goto cmd_bad;
+            }
+            const int len_lo = cin(50);
+            const int len_hi = cin(50);
+            if (len_lo < 0 || len_hi < 0) {
+                goto cmd_bad;
+            }
+            const uint16_t len = uint16_t(len_lo | (len_hi << 8));
+
+            // sanity-check arguments
+            if (len == 0 || len % 4 || len > sizeof(flash_buffer.c)) {
+                goto cmd_bad;
+            }
+
+            if (!cin_block(flash_buffer.c, len, 1000)) {
+                goto cmd_bad;
+            }
+
+            uint32_t block_crc;
+            if (cin_word(&block_crc, 100)) {
+                goto cmd_bad;
+            }
+
+            if (!wait_for_eoc(200)) {
+                goto cmd_bad;
+            }
+
+            led_set(LED_OFF);
+
+            if (block_address != address ||
+                block_address + len > board_info.fw_size ||
+                crc32_small(0, flash_buffer.c, len) != block_crc) {
+                // lost or corrupted on the way, the host will resend
+                cout_word(address);
+                goto cmd_fail;
+            }
+
+            if (!lazy_erase_to(address + len)) {
+                cout_word(address);
+                goto cmd_fail;
+            }
+
+            // save the first words and don't program it until everything else is done
+#if !BOOT_FROM_EXT_FLASH
+            if (address < sizeof(first_words)) {
+                uint8_t n = MIN(sizeof(first_words)-address, len);
+                memcpy(&first_words[address/4], &flash_buffer.w[0], n);
+                // replace first words with 1 bits we can overwrite later
+                memset(&flash_buffer.w[0], 0xFF, n);
+            }
+#endif
+            if (!flash_write_buffer(address, flash_buffer.w, len/4)) {
+                cout_word(address);
+                goto cmd_fail;
+            }
+            address += len;
+            cout_word(address);
+            break;
+        }
+
         // program data from start of the flash
         //
         // command:		EXTF_ERASE/<len:4>/EOC
@@ -906,6 +1062,11 @@ bootloader(unsigned timeout)
                 goto cmd_bad;
             }
 
+            // finish a lazy erase past the end of the programmed area
+            if (lazy_erase.active && !lazy_erase_to(board_info.fw_size)) {
+                goto cmd_fail;
+            }
+
             // compute CRC of the programmed area
             uint32_t sum = 0;
 
@@ -1131,6 +1292,10 @@ bootloader(unsigned timeout)
                 goto cmd_fail;
             }
 
+            if (lazy_erase.active && !lazy_erase_to(board_info.fw_size)) {
+                goto cmd_fail;
+            }
+
             // program the deferred first word
             if (first_words[0] != 0xffffffff) {
 #if !BOOT_FROM_EXT_FLASH
@@ -31,6 +31,7 @@
 #include <stdio.h>
 #include <AP_HAL_ChibiOS/CANIface.h>
 #include <AP_CheckFirmware/AP_CheckFirmware.h>
+#include "AP_Bootloader_config.h"
 
 static CanardInstance canard;
 static uint32_t canard_memory_pool[4096/4];
@@ -83,6 +84,27 @@ static void processTx(void);
 static HAL_Semaphore can_mutex;
 #endif
 
+// size of each file read
+#define FW_UPDATE_READ_LEN sizeof(uavcan_protocol_file_ReadResponse::data.data)
+
+#if AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+/*
+  a delta update first reads a block CRC map of the new firmware from
+  the file server, named as the firmware with this suffix. The map is
+  a header followed by the CRC32 of each block of the image. Only
+  flash sectors holding a block that differs are erased and fetched
+ */
+#define FW_UPDATE_MAP_SUFFIX ".crcmap"
+#define FW_UPDATE_MAP_MAGIC 0x4d435041 // "APCM"
+#define FW_UPDATE_MAX_SECTORS 256
+
+struct PACKED fw_update_map_header {
+    uint32_t magic;
+    uint32_t block_size;
+    uint32_t image_size;
+};
+#endif
+
 static struct {
     uint32_t rtt_ms;
     uint32_t ofs;
@@ -100,6 +122,17 @@ static struct {
         uavcan_protocol_file_ReadResponse pkt;
     } reads[FW_UPDATE_PIPELINE_LEN];
     uint16_t erased_to;
+    // offset of the next read to queue
+    uint32_t read_ofs;
+    // end of the file being read, zero if not known
+    uint32_t end;
+#if AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+    bool reading_map;
+    bool delta;
+    uint32_t map_block_size;
+    uint32_t image_size;
+    uint32_t changed_sectors[FW_UPDATE_MAX_SECTORS/32];
+#endif
 } fw_update;
 
 /*
@@ -186,6 +219,13 @@ static bool send_fw_read(uint8_t idx)
     pkt.path.path.len = strlen((const char *)fw_update.path);
     pkt.offset = r.offset;
     memcpy(pkt.path.path.data, fw_update.path, pkt.path.path.len);
+#if AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+    if (fw_update.reading_map) {
+        // room for the suffix was checked when the update started
+        memcpy(&pkt.path.path.data[pkt.path.path.len], FW_UPDATE_MAP_SUFFIX, strlen(FW_UPDATE_MAP_SUFFIX));
+        pkt.path.path.len += strlen(FW_UPDATE_MAP_SUFFIX);
+    }
+#endif
 
     uint8_t buffer[UAVCAN_PROTOCOL_FILE_READ_REQUEST_MAX_SIZE];
     uint16_t total_size = uavcan_protocol_file_ReadRequest_encode(&pkt, buffer, true);
@@ -219,6 +259,10 @@ static void send_fw_reads(void)
         if (r.have_reply) {
             continue;
         }
+        if (fw_update.end != 0 && r.offset >= fw_update.end) {
+            // past the end of the file, nothing to read
+            continue;
+        }
         if (r.sent_ms != 0 && now - r.sent_ms < 10+2*MAX(250,fw_update.rtt_ms)) {
             // waiting on a response
             continue;
@@ -255,6 +299,215 @@ static void erase_to(uint16_t sector)
     }
 }
 
+#if AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+/*
+  find the flash sector holding an offset and the offset it starts at
+ */
+static bool find_sector(uint32_t ofs, uint16_t &sector, uint32_t &sector_start)
+{
+    uint32_t start = 0;
+    for (uint16_t s=0; ; s++) {
+        const uint32_t size = flash_func_sector_size(s);
+        if (size == 0) {
+            return false;
+        }
+        if (ofs < start + size) {
+            sector = s;
+            sector_start = start;
+            return true;
+        }
+        start += size;
+    }
+}
+
+static bool sector_changed(uint16_t sector)
+{
+    return (fw_update.changed_sectors[sector/32] & (1U<<(sector%32))) != 0;
+}
+
+/*
+  mark the sector holding an offset as needing to be fetched
+ */
+static bool mark_changed(uint32_t ofs)
+{
+    uint16_t sector;
+    uint32_t sector_start;
+    if (!find_sector(ofs, sector, sector_start) || sector >= FW_UPDATE_MAX_SECTORS) {
+        return false;
+    }
+    fw_update.changed_sectors[sector/32] |= 1U<<(sector%32);
+    return true;
+}
+
+/*
+  CRC32 of the current flash contents
+ */
+static uint32_t flash_crc(uint32_t ofs, uint32_t len)
+{
+    uint32_t crc = 0;
+    while (len > 0) {
+        const uint32_t w = flash_func_read_word(ofs);
+        const uint8_t n = MIN(len, 4U);
+        crc = crc32_small(crc, (const uint8_t *)&w, n);
+        ofs += 4;
+        len -= n;
+    }
+    return crc;
+}
+
+/*
+  compare a piece of the block CRC map against the flash. Returns
+  false if the map can't be used
+ */
+static bool handle_map_data(uint32_t ofs, const uint8_t *data, uint16_t len)
+{
+    if (ofs == 0) {
+        struct fw_update_map_header hdr;
+        if (len < sizeof(hdr)) {
+            return false;
+        }
+        memcpy(&hdr, data, sizeof(hdr));
+        if (hdr.magic != FW_UPDATE_MAP_MAGIC ||
+            hdr.block_size == 0 || hdr.block_size % 4 != 0 ||
+            hdr.image_size == 0 || hdr.image_size > board_info.fw_size) {
+            return false;
+        }
+        fw_update.map_block_size = hdr.block_size;
+        fw_update.image_size = hdr.image_size;
+        const uint32_t num_blocks = (hdr.image_size + hdr.block_size - 1) / hdr.block_size;
+        fw_update.end = sizeof(hdr) + num_blocks*4;
+        memset(fw_update.changed_sectors, 0, sizeof(fw_update.changed_sectors));
+        data += sizeof(hdr);
+        len -= sizeof(hdr);
+        ofs += sizeof(hdr);
+    }
+    if (fw_update.map_block_size == 0) {
+        return false;
+    }
+    // the header and reads are multiples of 4 so no CRC is split
+    for (; len >= 4 && ofs < fw_update.end; data += 4, len -= 4, ofs += 4) {
+        const uint32_t start = ((ofs - sizeof(fw_update_map_header)) / 4) * fw_update.map_block_size;
+        const uint32_t n = MIN(fw_update.map_block_size, fw_update.image_size - start);
+        uint32_t crc;
+        memcpy(&crc, data, sizeof(crc));
+        if (flash_crc(start, n) != crc) {
+            // a block may span two sectors
+            if (!mark_changed(start) || !mark_changed(start + n - 1)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+  move an offset past sectors that are the same in the new firmware
+ */
+static uint32_t skip_unchanged(uint32_t ofs)
+{
+    if (!fw_update.delta) {
+        return ofs;
+    }
+    while (ofs < fw_update.image_size) {
+        uint16_t sector;
+        uint32_t sector_start;
+        if (!find_sector(ofs, sector, sector_start) || sector_changed(sector)) {
+            return ofs;
+        }
+        ofs = sector_start + flash_func_sector_size(sector);
+    }
+    return fw_update.image_size;
+}
+#endif // AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+
+/*
+  offset of the next read to queue
+ */
+static uint32_t next_read_offset(void)
+{
+    uint32_t ofs = fw_update.read_ofs;
+#if AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+    ofs = skip_unchanged(ofs);
+#endif
+    fw_update.read_ofs = ofs + FW_UPDATE_READ_LEN;
+    return ofs;
+}
+
+/*
+  start reading the file from fw_update.ofs
+ */
+static void start_reads(void)
+{
+    fw_update.read_ofs = fw_update.ofs;
+    fw_update.idx = 0;
+    for (uint8_t i=0; i<FW_UPDATE_PIPELINE_LEN; i++) {
+        auto &r = fw_update.reads[i];
+        r.have_reply = false;
+        r.sent_ms = 0;
+        // don't match replies to reads of the last file
+        r.tx_id = 0xFF;
+        r.offset = next_read_offset();
+    }
+}
+
+/*
+  fetch the whole firmware
+ */
+static void start_full_update(void)
+{
+#if AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+    fw_update.reading_map = false;
+    fw_update.delta = false;
+#endif
+    fw_update.ofs = 0;
+    fw_update.end = 0;
+    fw_update.sector = 0;
+    fw_update.sector_ofs = 0;
+    fw_update.erased_to = 0;
+    start_reads();
+}
+
+/*
+  start fetching the firmware after a path has been given
+ */
+static void start_fw_update(void)
+{
+#if AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+    if (strlen((const char *)fw_update.path) + strlen(FW_UPDATE_MAP_SUFFIX) <= sizeof(uavcan_protocol_file_Path::path.data)) {
+        fw_update.reading_map = true;
+        fw_update.delta = false;
+        fw_update.map_block_size = 0;
+        fw_update.ofs = 0;
+        fw_update.end = 0;
+        start_reads();
+        return;
+    }
+#endif
+    start_full_update();
+}
+
+/*
+  check the new firmware and boot it
+ */
+static void finish_fw_update(void)
+{
+    flash_write_flush();
+    flash_set_keep_unlocked(false);
+    const auto ok = check_good_firmware();
+    node_status.vendor_specific_status_code = uint8_t(ok);
+#if AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+    if (ok != check_fw_result_t::CHECK_FW_OK && (fw_update.delta || fw_update.reading_map)) {
+        // the map did not match the firmware, fetch all of it
+        start_full_update();
+        return;
+    }
+#endif
+    fw_update.node_id = 0;
+    if (ok == check_fw_result_t::CHECK_FW_OK) {
+        jump_to_app();
+    }
+}
+
 /*
   handle response to file read for fw update
  */
@@ -299,54 +552,95 @@ static void handle_file_read_response(CanardInstance* ins, CanardRxTransfer* tra
         const uint16_t len = pkt.data.len;
         const uint16_t len_words = (len+3U)/4U;
         const uint8_t *buf = (uint8_t *)pkt.data.data;
-        uint32_t buf32[len_words] {};
-        memcpy((uint8_t*)buf32, buf, len);
 
-        if (fw_update.ofs == 0) {
-            flash_set_keep_unlocked(true);
-        }
+#if AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+        if (fw_update.reading_map) {
+            if (!handle_map_data(fw_update.ofs, buf, len)) {
+                // no map, or one we can't use
+                start_full_update();
+                break;
+            }
+            fw_update.ofs += len;
+            if (len < FW_UPDATE_READ_LEN || fw_update.ofs >= fw_update.end) {
+                // fetch the sectors that differ
+                fw_update.reading_map = false;
+                fw_update.delta = true;
+                fw_update.end = fw_update.image_size;
+                fw_update.ofs = skip_unchanged(0);
+                if (fw_update.ofs >= fw_update.end) {
+                    // nothing has changed
+                    finish_fw_update();
+                    return;
+                }
+                flash_set_keep_unlocked(true);
+                start_reads();
+                break;
+            }
+        } else if (fw_update.delta) {
+            uint32_t buf32[len_words] {};
+            memcpy((uint8_t*)buf32, buf, len);
+            uint16_t sector;
+            uint32_t sector_start;
+            if (!find_sector(fw_update.ofs, sector, sector_start)) {
+                start_full_update();
+                break;
+            }
+            if (fw_update.ofs == sector_start) {
+                flash_func_erase_sector(sector);
+            }
+            if (!flash_write_buffer(fw_update.ofs, buf32, len_words)) {
+                continue;
+            }
+            fw_update.ofs = skip_unchanged(fw_update.ofs + len);
+            if (len < FW_UPDATE_READ_LEN || fw_update.ofs >= fw_update.end) {
+                finish_fw_update();
+                return;
+            }
+        } else
+#endif // AP_BOOTLOADER_CAN_DELTA_UPDATE_ENABLED
+        {
+            uint32_t buf32[len_words] {};
+            memcpy((uint8_t*)buf32, buf, len);
 
-        const uint32_t sector_size = flash_func_sector_size(fw_update.sector);
-        if (sector_size == 0) {
-            // firmware is too big
-            fw_update.node_id = 0;
-            flash_write_flush();
-            flash_set_keep_unlocked(false);
-            node_status.vendor_specific_status_code = uint8_t(check_fw_result_t::FAIL_REASON_BAD_LENGTH_APP);
-            break;
-        }
-        if (fw_update.sector_ofs == 0) {
-            erase_to(fw_update.sector);
-        }
-        if (fw_update.sector_ofs+len > sector_size) {
-            erase_to(fw_update.sector+1);
-        }
-        if (!flash_write_buffer(fw_update.ofs, buf32, len_words)) {
-            continue;
-        }
+            if (fw_update.ofs == 0) {
+                flash_set_keep_unlocked(true);
+            }
 
-        fw_update.ofs += len;
-        fw_update.sector_ofs += len;
-        if (fw_update.sector_ofs >= flash_func_sector_size(fw_update.sector)) {
-            fw_update.sector++;
-            fw_update.sector_ofs -= sector_size;
-        }
+            const uint32_t sector_size = flash_func_sector_size(fw_update.sector);
+            if (sector_size == 0) {
+                // firmware is too big
+                fw_update.node_id = 0;
+                flash_write_flush();
+                flash_set_keep_unlocked(false);
+                node_status.vendor_specific_status_code = uint8_t(check_fw_result_t::FAIL_REASON_BAD_LENGTH_APP);
+                break;
+            }
+            if (fw_update.sector_ofs == 0) {
+                erase_to(fw_update.sector);
+            }
+            if (fw_update.sector_ofs+len > sector_size) {
+                erase_to(fw_update.sector+1);
+            }
+            if (!flash_write_buffer(fw_update.ofs, buf32, len_words)) {
+                continue;
+            }
 
-        if (len < sizeof(uavcan_protocol_file_ReadResponse::data.data)) {
-            fw_update.node_id = 0;
-            flash_write_flush();
-            flash_set_keep_unlocked(false);
-            const auto ok = check_good_firmware();
-            node_status.vendor_specific_status_code = uint8_t(ok);
-            if (ok == check_fw_result_t::CHECK_FW_OK) {
-                jump_to_app();
+            fw_update.ofs += len;
+            fw_update.sector_ofs += len;
+            if (fw_update.sector_ofs >= flash_func_sector_size(fw_update.sector)) {
+                fw_update.sector++;
+                fw_update.sector_ofs -= sector_size;
+            }
+
+            if (len < FW_UPDATE_READ_LEN) {
+                finish_fw_update();
+                return;
             }
-            return;
         }
 
         r.have_reply = false;
         r.sent_ms = 0;
-        r.offset += FW_UPDATE_PIPELINE_LEN*sizeof(uavcan_protocol_file_ReadResponse::data.data);
+        r.offset = next_read_offset();
         send_fw_read(fw_update.idx);
         processTx();
 
@@ -371,15 +665,13 @@ static void handle_begin_firmware_update(CanardInstance* ins, CanardRxTransfer*
             return;
         }
         memset(&fw_update, 0, sizeof(fw_update));
-        for (uint8_t i=0; i<FW_UPDATE_PIPELINE_LEN; i++) {
-            fw_update.reads[i].offset = i*sizeof(uavcan_protocol_file_ReadResponse::data.data);
-        }
         memcpy(fw_update.path, pkt.image_file_remote_path.path.data, pkt.image_file_remote_path.path.len);
         fw_update.path[pkt.image_file_remote_path.path.len] = 0;
         fw_update.node_id = pkt.source_node_id;
         if (fw_update.node_id == 0) {
             fw_update.node_id = transfer->source_node_id;
         }
+        start_fw_update();
     }
 
     uint8_t buffer[UAVCAN_PROTOCOL_FILE_BEGINFIRMWAREUPDATE_RESPONSE_MAX_SIZE];
@@ -751,10 +1043,8 @@ bool can_check_update(void)
     if (comms->magic == APP_BOOTLOADER_COMMS_MAGIC && comms->my_node_id != 0) {
         can_set_node_id(comms->my_node_id);
         fw_update.node_id = comms->server_node_id;
-        for (uint8_t i=0; i<FW_UPDATE_PIPELINE_LEN; i++) {
-            fw_update.reads[i].offset = i*sizeof(uavcan_protocol_file_ReadResponse::data.data);
-        }
         memcpy(fw_update.path, comms->path, sizeof(uavcan_protocol_file_Path::path.data)+1);
+        start_fw_update();
         ret = true;
         // clear comms region
         memset(comms, 0, sizeof(struct app_bootloader_comms));
@@ -71,6 +71,15 @@ int cin_word(uint32_t *wp, unsigned timeout_ms)
     return -1;
 }
 
+/*
+  read a block from the port we last received from. Used once the
+  port is locked, so the whole block comes from the one port
+ */
+bool cin_block(uint8_t *data, uint16_t len, unsigned timeout_ms)
+{
+    return chnReadTimeout(uarts[last_uart], data, len, chTimeMS2I(timeout_ms)) == len;
+}
+
 
 void cout(uint8_t *data, uint32_t len)
 {
@@ -216,7 +225,7 @@ bool flash_write_flush(void)
 /*
   write to flash with buffering to 32 bytes alignment
  */
-bool flash_write_buffer(uint32_t address, const uint32_t *v, uint8_t nwords)
+bool flash_write_buffer(uint32_t address, const uint32_t *v, uint16_t nwords)
 {
     if (fbuf.n > 0 && address != fbuf.address + fbuf.n*4) {
         if (!flash_write_flush()) {
@@ -22,6 +22,7 @@ extern struct boardinfo board_info;
 void init_uarts(void);
 int16_t cin(unsigned timeout_ms);
 int cin_word(uint32_t *wp, unsigned timeout_ms);
+bool cin_block(uint8_t *data, uint16_t len, unsigned timeout_ms);
 void cout(uint8_t *data, uint32_t len);
 void port_setbaud(uint32_t baudrate);
 #if defined(BOOTLOADER_FORWARD_OTG2_SERIAL)
@@ -41,7 +42,7 @@ void flash_set_keep_unlocked(bool);
 void lock_bl_port(void);
 
 bool flash_write_flush(void);
-bool flash_write_buffer(uint32_t address, const uint32_t *v, uint8_t nwords);
+bool flash_write_buffer(uint32_t address, const uint32_t *v, uint16_t nwords);
 
 uint32_t get_mcu_id(void);
 uint32_t get_mcu_desc(uint32_t len, uint8_t *buf);
@@ -329,7 +329,7 @@ public:
 
 #if AP_PERIPH_EFI_ENABLED
     AP_EFI efi;
-    uint32_t efi_update_ms;
+    uint32_t efi_state_version;
 #endif
 
 #if AP_KDECAN_ENABLED
@@ -31,13 +31,13 @@ void AP_Periph_FW::can_efi_update(void)
 #endif
 
     efi.update();
-    const uint32_t update_ms = efi.get_last_update_ms();
-    if (!efi.is_healthy() || efi_update_ms == update_ms) {
+    if (!efi.is_healthy()) {
         return;
     }
-    efi_update_ms = update_ms;
     EFI_State state;
-    efi.get_state(state);
+    if (!efi.get_state_if_newer(state, efi_state_version)) {
+        return;
+    }
 
     {
         /*
@@ -0,0 +1,386 @@
+/*
+  run the host benchmark kernels on a board, so the cost of the hot
+  paths can be compared between MCUs and compiler flags
+
+  Each kernel is run for a number of calls, several times over, and
+  the fastest repetition is reported, which keeps interrupts and the
+  scheduler out of the result. On ChibiOS the time is counted with
+  the DWT cycle counter, elsewhere in microseconds.
+
+  The results are printed on the console as lines of
+    BENCH name cycles_per_call ns_per_call
+  which Tools/scripts/run_benchmarks.py --console turns into the same
+  JSON as the host benchmarks
+*/
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Common/AP_Common.h>
+#include <AP_Common/Location.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
+#include <AP_HAL/utility/RingBuffer.h>
+#include <Filter/LowPassFilter2p.h>
+#include <Filter/NotchFilter.h>
+#include <Filter/HarmonicNotchFilter.h>
+#include <AP_Logger/LogFields.h>
+#include <AP_Logger/LogCompression.h>
+#include <GCS_MAVLink/GCS_MAVLink.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+#include <hal.h>
+#endif
+
+void setup();
+void loop();
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS && defined(STM32_SYS_CK)
+static const uint32_t cycles_per_us = STM32_SYS_CK / 1000000U;
+#elif CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS && defined(STM32_HCLK)
+static const uint32_t cycles_per_us = STM32_HCLK / 1000000U;
+#else
+static const uint32_t cycles_per_us = 1;
+#endif
+
+// times to repeat each kernel, the fastest is reported
+#define BENCH_REPEATS 8
+
+static inline uint32_t cycles()
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+    return DWT->CYCCNT;
+#else
+    return AP_HAL::micros();
+#endif
+}
+
+/*
+  start the DWT cycle counter, which is stopped out of reset
+ */
+static void enable_counter()
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#ifdef __CORE_CM7_H_GENERIC
+    // the M7 DWT is locked against writes
+    DWT->LAR = 0xC5ACCE55;
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+// results are written here so the kernels are not optimised away
+static volatile float sink_f;
+static volatile uint32_t sink_32;
+
+/*
+  fixed inputs, matching the host benchmarks
+ */
+#define FILTER_RATE_HZ 2000
+#define FILTER_NUM_SAMPLES 256
+static Vector3f samples[FILTER_NUM_SAMPLES];
+
+#define FENCE_NUM_POINTS 16
+#define FENCE_NUM_TESTS 32
+static Vector2f fence[FENCE_NUM_POINTS + 1];
+static Vector2f fence_points[FENCE_NUM_TESTS];
+
+#define NUM_LOCS 20
+static Location loc_ref;
+static Location locs[NUM_LOCS];
+
+static uint8_t crc_buf[256];
+
+#define LOG_BM_MSG_TYPE 200
+typedef LogFieldsFormat<uint64_t, float, float, float, float, float, float, uint8_t> IMUFormat;
+static uint8_t log_msg[IMUFormat::length];
+
+static void fill_inputs()
+{
+    for (uint16_t i = 0; i < FILTER_NUM_SAMPLES; i++) {
+        const float t = float(i) / FILTER_RATE_HZ;
+        const float motion = 0.5f * sinf(M_2PI * 2.0f * t);
+        const float noise = 0.2f * sinf(M_2PI * 180.0f * t) + 0.1f * sinf(M_2PI * 360.0f * t) + 0.05f * sinf(M_2PI * 540.0f * t);
+        samples[i] = Vector3f{motion + noise, -motion + 0.7f * noise, 0.3f * motion - noise};
+    }
+
+    for (uint8_t i = 0; i < FENCE_NUM_POINTS; i++) {
+        const float angle = M_2PI * i / FENCE_NUM_POINTS;
+        const float radius = (i & 1) ? 300.0f : 500.0f;
+        fence[i] = Vector2f{radius * cosf(angle), radius * sinf(angle)};
+    }
+    fence[FENCE_NUM_POINTS] = fence[0];
+    for (uint8_t i = 0; i < FENCE_NUM_TESTS; i++) {
+        const float angle = M_2PI * i / FENCE_NUM_TESTS;
+        const float radius = 50.0f + i * 20.0f;
+        fence_points[i] = Vector2f{radius * cosf(angle), radius * sinf(angle)};
+    }
+
+    loc_ref = Location(-353632610, 1491652300, 58400, Location::AltFrame::ABSOLUTE);
+    for (uint8_t i = 0; i < NUM_LOCS; i++) {
+        locs[i] = loc_ref;
+        locs[i].offset_bearing(i * 18, 100 + i * 250);
+    }
+
+    for (uint16_t i = 0; i < sizeof(crc_buf); i++) {
+        crc_buf[i] = i * 7;
+    }
+
+    log_msg[0] = HEAD_BYTE1;
+    log_msg[1] = HEAD_BYTE2;
+    log_msg[2] = LOG_BM_MSG_TYPE;
+}
+
+/*
+  the kernels. Each makes one call of the code being measured per
+  invocation, keeping its state between calls
+ */
+static void bench_lpf2p_float()
+{
+    static LowPassFilter2pFloat filter{FILTER_RATE_HZ, 80};
+    static uint16_t i;
+    sink_f = filter.apply(samples[i].x);
+    i = (i + 1) % FILTER_NUM_SAMPLES;
+}
+
+static void bench_lpf2p_vector3f()
+{
+    static LowPassFilter2pVector3f filter{FILTER_RATE_HZ, 80};
+    static uint16_t i;
+    sink_f = filter.apply(samples[i]).x;
+    i = (i + 1) % FILTER_NUM_SAMPLES;
+}
+
+static NotchFilterVector3f notch;
+
+static void bench_notch_vector3f()
+{
+    static uint16_t i;
+    sink_f = notch.apply(samples[i]).x;
+    i = (i + 1) % FILTER_NUM_SAMPLES;
+}
+
+#define HNOTCH_NUM_MOTORS 4
+static HarmonicNotchFilterParams hnotch_params;
+static HarmonicNotchFilterVector3f hnotch;
+static float motor_freq_hz[HNOTCH_NUM_MOTORS] { 175, 180, 185, 190 };
+
+static void bench_harmonic_notch_vector3f()
+{
+    static uint16_t i;
+    sink_f = hnotch.apply(samples[i]).x;
+    i = (i + 1) % FILTER_NUM_SAMPLES;
+}
+
+static void bench_harmonic_notch_update()
+{
+    static uint16_t i;
+    motor_freq_hz[i % HNOTCH_NUM_MOTORS] = 170 + (i % 40);
+    hnotch.update(HNOTCH_NUM_MOTORS, motor_freq_hz);
+    i++;
+}
+
+static void bench_polygon_outside()
+{
+    static uint8_t i;
+    sink_32 = Polygon_outside(fence_points[i], fence, FENCE_NUM_POINTS + 1);
+    i = (i + 1) % FENCE_NUM_TESTS;
+}
+
+static void bench_polygon_intersects()
+{
+    static uint8_t i;
+    Vector2f intersection;
+    sink_32 = Polygon_intersects(fence, FENCE_NUM_POINTS + 1, fence_points[i], fence_points[(i + FENCE_NUM_TESTS/2) % FENCE_NUM_TESTS], intersection);
+    i = (i + 1) % FENCE_NUM_TESTS;
+}
+
+static void bench_location_get_distance_ne()
+{
+    static uint8_t i;
+    sink_f = loc_ref.get_distance_NE(locs[i]).x;
+    i = (i + 1) % NUM_LOCS;
+}
+
+static void bench_location_offset()
+{
+    static uint8_t i;
+    Location loc = loc_ref;
+    loc.offset(i * 10.0f, i * -20.0f);
+    sink_32 = loc.lat;
+    i = (i + 1) % NUM_LOCS;
+}
+
+static void bench_crc32_256()
+{
+    sink_32 = crc_crc32(0xFFFFFFFF, crc_buf, sizeof(crc_buf));
+}
+
+static void bench_crc16_ccitt_256()
+{
+    sink_32 = crc16_ccitt(crc_buf, sizeof(crc_buf), 0xFFFF);
+}
+
+static void bench_log_pack()
+{
+    static uint64_t time_us = 1000000;
+    IMUFormat::pack(log_msg, time_us, 0.1f, -0.05f, 0.02f, 0.3f, -0.2f, -9.8f, uint8_t(time_us));
+    time_us += 2500;
+    sink_32 = log_msg[3];
+}
+
+static ByteBuffer *log_buffer;
+
+static void bench_log_buffer_write()
+{
+    static uint8_t out[IMUFormat::length];
+    if (log_buffer->space() < sizeof(log_msg)) {
+        // drain in blocks, as the backend io thread does
+        while (log_buffer->read(out, sizeof(out)) == sizeof(out)) {
+        }
+    }
+    sink_32 = log_buffer->write(log_msg, sizeof(log_msg));
+}
+
+#if AP_LOGGER_COMPRESSION_ENABLED
+static AP_Logger_Compression log_compression;
+
+// includes packing the message, so it changes like a real one
+static void bench_log_pack_compress()
+{
+    bench_log_pack();
+    const uint8_t *out;
+    sink_32 = log_compression.compress(log_msg, sizeof(log_msg), out);
+}
+#endif
+
+static uint8_t mav_buf[2*MAVLINK_MAX_PACKET_LEN];
+static uint16_t mav_len;
+
+static void bench_mavlink_pack()
+{
+    static uint32_t time_ms;
+    mavlink_message_t msg;
+    mavlink_msg_global_position_int_pack(1, 1, &msg,
+                                         time_ms, -353632610, 1491652300, 584000, 10000,
+                                         120, -35, 4, 27000);
+    sink_32 = mavlink_msg_to_send_buffer(mav_buf, &msg);
+    time_ms += 10;
+}
+
+static void bench_mavlink_parse()
+{
+    mavlink_message_t msg;
+    mavlink_status_t status;
+    uint8_t count = 0;
+    for (uint16_t i = 0; i < mav_len; i++) {
+        count += mavlink_parse_char(MAVLINK_COMM_0, mav_buf[i], &msg, &status);
+    }
+    sink_32 = count;
+}
+
+static void setup_kernels()
+{
+    notch.init(FILTER_RATE_HZ, 180, 90, 40);
+
+    hnotch_params.set_attenuation(40);
+    hnotch_params.set_bandwidth_hz(90);
+    hnotch_params.set_center_freq_hz(180);
+    hnotch_params.set_freq_min_ratio(1.0);
+    hnotch.allocate_filters(HNOTCH_NUM_MOTORS, 0x0F, hnotch_params.num_composite_notches());
+    hnotch.init(FILTER_RATE_HZ, hnotch_params);
+    hnotch.update(HNOTCH_NUM_MOTORS, motor_freq_hz);
+
+    log_buffer = NEW_NOTHROW ByteBuffer(4096);
+    if (log_buffer == nullptr || log_buffer->get_size() == 0) {
+        AP_HAL::panic("Failed to allocate log buffer");
+    }
+
+#if AP_LOGGER_COMPRESSION_ENABLED
+    // the compressor learns the message length and format from its FMT
+    struct log_Format fmt {};
+    fmt.head1 = HEAD_BYTE1;
+    fmt.head2 = HEAD_BYTE2;
+    fmt.msgid = LOG_FORMAT_MSG;
+    fmt.type = LOG_BM_MSG_TYPE;
+    fmt.length = IMUFormat::length;
+    strncpy(fmt.name, "IMUB", sizeof(fmt.name));
+    strncpy(fmt.format, IMUFormat::fmt, sizeof(fmt.format));
+    log_compression.reset(AP_Logger_Compression::Method::FIELDS);
+    log_compression.update((const uint8_t *)&fmt, sizeof(fmt));
+#endif
+
+    // a packed message for the parser
+    bench_mavlink_pack();
+    mav_len = sink_32;
+}
+
+static const struct {
+    const char *name;
+    void (*fn)();
+    uint16_t calls;
+} kernels[] = {
+    { "LowPassFilter2pFloat", bench_lpf2p_float, 1000 },
+    { "LowPassFilter2pVector3f", bench_lpf2p_vector3f, 1000 },
+    { "NotchFilterVector3f", bench_notch_vector3f, 1000 },
+    { "HarmonicNotchFilterVector3f", bench_harmonic_notch_vector3f, 200 },
+    { "HarmonicNotchFilterUpdate", bench_harmonic_notch_update, 200 },
+    { "PolygonOutside", bench_polygon_outside, 500 },
+    { "PolygonIntersects", bench_polygon_intersects, 500 },
+    { "LocationGetDistanceNE", bench_location_get_distance_ne, 500 },
+    { "LocationOffset", bench_location_offset, 500 },
+    { "Crc32_256", bench_crc32_256, 100 },
+    { "Crc16CCITT_256", bench_crc16_ccitt_256, 100 },
+    { "LogFieldsPack", bench_log_pack, 1000 },
+    { "LogByteBufferWrite", bench_log_buffer_write, 1000 },
+#if AP_LOGGER_COMPRESSION_ENABLED
+    { "LogPackCompress", bench_log_pack_compress, 500 },
+#endif
+    { "MAVLinkPack", bench_mavlink_pack, 500 },
+    { "MAVLinkParse", bench_mavlink_parse, 100 },
+};
+
+void setup()
+{
+    enable_counter();
+    fill_inputs();
+    setup_kernels();
+}
+
+static void run_kernels()
+{
+#ifdef CHIBIOS_BOARD_NAME
+    hal.console->printf("BENCH_BOARD %s %uMHz\n", CHIBIOS_BOARD_NAME, unsigned(cycles_per_us));
+#else
+    hal.console->printf("BENCH_BOARD host\n");
+#endif
+    for (const auto &k : kernels) {
+        // one pass to warm the caches
+        for (uint16_t i = 0; i < k.calls; i++) {
+            k.fn();
+        }
+        uint32_t best = UINT32_MAX;
+        for (uint8_t r = 0; r < BENCH_REPEATS; r++) {
+            const uint32_t start = cycles();
+            for (uint16_t i = 0; i < k.calls; i++) {
+                k.fn();
+            }
+            best = MIN(best, cycles() - start);
+        }
+        const float per_call = float(best) / k.calls;
+        hal.console->printf("BENCH %s %.1f %.1f\n", k.name, double(per_call), double(per_call * 1000.0f / cycles_per_us));
+        hal.scheduler->delay(10);
+    }
+    hal.console->printf("BENCH_DONE\n");
+}
+
+void loop()
+{
+    run_kernels();
+    hal.console->printf("\n");
+    hal.scheduler->delay(5000);
+}
+
+AP_HAL_MAIN();
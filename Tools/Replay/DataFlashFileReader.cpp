@@ -10,6 +10,10 @@
 #include <time.h>
 #include <cinttypes>
 
+#if AP_LOGGERFILEREADER_MMAP_ENABLED
+#include <sys/mman.h>
+#endif
+
 #ifndef PRIu64
 #define PRIu64 "llu"
 #endif
@@ -20,10 +24,40 @@ AP_LoggerFileReader::AP_LoggerFileReader()
 AP_LoggerFileReader::~AP_LoggerFileReader()
 {
     ::printf("Replay counts: %" PRIu64 " bytes  %u entries\n", bytes_read, message_count);
+#if AP_LOGGERFILEREADER_MMAP_ENABLED
+    if (mapped_log != nullptr) {
+        munmap((void *)mapped_log, file_size);
+    }
+#endif
+    free(log_filename);
 }
 
 bool AP_LoggerFileReader::open_log(const char *logfile)
 {
+    log_filename = strdup(logfile);
+#if AP_LOGGERFILEREADER_MMAP_ENABLED
+    /*
+      map the whole log so each message is a memcpy rather than a
+      read() system call. Fall back to AP::FS reads if the log can't
+      be mapped
+     */
+    const int map_fd = ::open(logfile, O_RDONLY);
+    if (map_fd != -1) {
+        struct stat st;
+        if (fstat(map_fd, &st) == 0 && st.st_size > 0) {
+            void *m = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, map_fd, 0);
+            if (m != MAP_FAILED) {
+                madvise(m, st.st_size, MADV_SEQUENTIAL);
+                mapped_log = (const uint8_t *)m;
+                file_size = st.st_size;
+            }
+        }
+        ::close(map_fd);
+        if (mapped_log != nullptr) {
+            return true;
+        }
+    }
+#endif
     fd = AP::FS().open(logfile, O_RDONLY);
     if (fd == -1) {
         return false;
@@ -36,8 +70,40 @@ bool AP_LoggerFileReader::open_log(const char *logfile)
     return true;
 }
 
+bool AP_LoggerFileReader::seek_input(uint64_t offset)
+{
+    if (offset > file_size) {
+        return false;
+    }
+#if AP_LOGGER_COMPRESSION_ENABLED
+    if (offset == 0) {
+        decompressor.reset();
+    }
+#endif
+#if AP_LOGGERFILEREADER_MMAP_ENABLED
+    if (mapped_log != nullptr) {
+        bytes_read = offset;
+        return true;
+    }
+#endif
+    // AP::FS offsets are 32 bit
+    if (offset > INT32_MAX || AP::FS().lseek(fd, offset, SEEK_SET) == -1) {
+        return false;
+    }
+    bytes_read = offset;
+    return true;
+}
+
 ssize_t AP_LoggerFileReader::read_input(void *buffer, const size_t count)
 {
+#if AP_LOGGERFILEREADER_MMAP_ENABLED
+    if (mapped_log != nullptr) {
+        const size_t n = MIN(uint64_t(count), file_size - bytes_read);
+        memcpy(buffer, &mapped_log[bytes_read], n);
+        bytes_read += n;
+        return n;
+    }
+#endif
     uint64_t ret = AP::FS().read(fd, buffer, count);
     bytes_read += ret;
     return ret;
@@ -57,54 +123,357 @@ void AP_LoggerFileReader::get_packet_counts(uint64_t dest[])
     memcpy(dest, packet_counts, sizeof(packet_counts));
 }
 
-bool AP_LoggerFileReader::update()
+/*
+  read the next message into msg, which must hold 256 bytes
+ */
+bool AP_LoggerFileReader::read_message(uint8_t *msg)
 {
-    uint8_t hdr[3];
-    if (read_input(hdr, 3) != 3) {
+    if (read_input(msg, 3) != 3) {
         return false;
     }
-    if (hdr[0] != HEAD_BYTE1 || hdr[1] != HEAD_BYTE2) {
+#if AP_LOGGER_COMPRESSION_ENABLED
+    if (msg[0] == HEAD_BYTE1 &&
+        (msg[1] == HEAD_BYTE2_COMPRESSED || msg[1] == HEAD_BYTE2_COMPRESSED_FIELDS)) {
+        // compressed messages are followed by their length
+        uint8_t in[4+UINT8_MAX];
+        memcpy(in, msg, 3);
+        if (read_input(&in[3], 1) != 1 ||
+            read_input(&in[4], in[3]) != in[3]) {
+            return false;
+        }
+        if (decompressor.decompress(in, msg) == 0) {
+            printf("bad compressed message\n");
+            return false;
+        }
+        compressed_log = true;
+        return true;
+    }
+#endif
+    if (msg[0] != HEAD_BYTE1 || msg[1] != HEAD_BYTE2) {
         printf("bad log header\n");
         return false;
     }
 
-#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
-    // running on stm32 is slow enough it is nice to see progress
-    if (message_count % 500 == 0) {
-        ::printf("line %u pkt 0x%02x t=%u\n", message_count, hdr[2], AP_HAL::millis());
-    }
-#endif
-    packet_counts[hdr[2]]++;
-
-    if (hdr[2] == LOG_FORMAT_MSG) {
+    if (msg[2] == LOG_FORMAT_MSG) {
         struct log_Format f;
-        memcpy(&f, hdr, 3);
-        if (read_input(&f.type, sizeof(f)-3) != sizeof(f)-3) {
+        if (read_input(&msg[3], sizeof(f)-3) != sizeof(f)-3) {
             return false;
         }
+        memcpy(&f, msg, sizeof(f));
         memcpy(&formats[f.type], &f, sizeof(formats[f.type]));
 
-        message_count++;
-        return handle_log_format_msg(f);
+        char name[5] {};
+        memcpy(name, f.name, 4);
+        uint8_t flags = 0;
+        if (index_checkpoint_msg(f)) {
+            flags |= INDEX_CHECKPOINT;
+        }
+        if (index_state_msg(f)) {
+            flags |= INDEX_STATE;
+        }
+        if (strcmp(name, "FMTU") == 0) {
+            flags |= INDEX_STICKY | INDEX_UNITS;
+        } else if (strcmp(name, "PARM") == 0 ||
+                   strcmp(name, "UNIT") == 0 ||
+                   strcmp(name, "MULT") == 0) {
+            flags |= INDEX_STICKY;
+        }
+        index_flags[f.type] = flags;
+#if AP_LOGGER_COMPRESSION_ENABLED
+        decompressor.update(msg, sizeof(f));
+#endif
+        return true;
     }
 
-    const struct log_Format &f = formats[hdr[2]];
+    const struct log_Format &f = formats[msg[2]];
     if (f.length == 0) {
         // can't just throw these away as the format specifies the
         // number of bytes in the message
-        ::printf("No format defined for type (%d)\n", hdr[2]);
+        ::printf("No format defined for type (%d)\n", msg[2]);
         exit(1);
     }
 
-    uint8_t msg[f.length];
-
-    memcpy(msg, hdr, 3);
     if (read_input(&msg[3], f.length-3) != f.length-3) {
         return false;
     }
+#if AP_LOGGER_COMPRESSION_ENABLED
+    decompressor.update(msg, f.length);
+#endif
+    return true;
+}
+
+bool AP_LoggerFileReader::update()
+{
+    uint8_t msg[256];
+    if (!read_message(msg)) {
+        return false;
+    }
 
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+    // running on stm32 is slow enough it is nice to see progress
+    if (message_count % 500 == 0) {
+        ::printf("line %u pkt 0x%02x t=%u\n", message_count, msg[2], AP_HAL::millis());
+    }
+#endif
+    packet_counts[msg[2]]++;
     message_count++;
-    return handle_msg(f, msg);
+
+    if (msg[2] == LOG_FORMAT_MSG) {
+        struct log_Format f;
+        memcpy(&f, msg, sizeof(f));
+        return handle_log_format_msg(f);
+    }
+
+    if (end_time_us != 0 && (index_flags[msg[2]] & INDEX_CHECKPOINT)) {
+        uint64_t time_us;
+        memcpy(&time_us, &msg[3], sizeof(time_us));
+        if (time_us > end_time_us) {
+            return false;
+        }
+    }
+
+    return handle_msg(formats[msg[2]], msg);
+}
+
+bool AP_LoggerFileReader::index_checkpoint_msg(const struct log_Format &f) const
+{
+    return f.format[0] == 'Q' && strncmp(f.labels, "TimeUS,", 7) == 0;
+}
+
+/*
+  sidecar index layout, after the header:
+    sticky record:     'S', uint64_t offset
+    checkpoint record: 'C', uint64_t time_us, uint64_t offset,
+                       uint16_t count, uint64_t state_offsets[count]
+  records are in log order, and the state offsets of a checkpoint
+  are sorted
+ */
+struct PACKED log_index_header {
+    char magic[4];
+    uint16_t version;
+    uint64_t log_size;
+};
+static const char log_index_magic[4] { 'L', 'I', 'D', 'X' };
+static const uint16_t log_index_version = 1;
+
+bool AP_LoggerFileReader::index_valid(const char *index_filename)
+{
+    auto &fs = AP::FS();
+    const int ifd = fs.open(index_filename, O_RDONLY, true);
+    if (ifd == -1) {
+        return false;
+    }
+    struct log_index_header hdr;
+    const bool ret = fs.read(ifd, &hdr, sizeof(hdr)) == int32_t(sizeof(hdr)) &&
+        memcmp(hdr.magic, log_index_magic, sizeof(hdr.magic)) == 0 &&
+        hdr.version == log_index_version &&
+        hdr.log_size == file_size;
+    fs.close(ifd);
+    return ret;
+}
+
+/*
+  scan the whole log, writing a sidecar index
+ */
+bool AP_LoggerFileReader::build_index(const char *index_filename)
+{
+    auto &fs = AP::FS();
+    const int ifd = fs.open(index_filename, O_WRONLY|O_CREAT|O_TRUNC, true);
+    if (ifd == -1) {
+        return false;
+    }
+    ::printf("Building log index %s\n", index_filename);
+
+    // offset+1 of the latest message for each type and instance
+    const uint16_t num_slots = 256 * LOGREADER_INDEX_MAX_INSTANCES;
+    uint64_t *latest = NEW_NOTHROW uint64_t[num_slots];
+    uint64_t *state = NEW_NOTHROW uint64_t[num_slots];
+    if (latest == nullptr || state == nullptr) {
+        delete[] latest;
+        delete[] state;
+        fs.close(ifd);
+        return false;
+    }
+    memset(latest, 0, num_slots * sizeof(latest[0]));
+
+    struct log_index_header hdr {};
+    memcpy(hdr.magic, log_index_magic, sizeof(hdr.magic));
+    hdr.version = log_index_version;
+    hdr.log_size = file_size;
+    bool ok = fs.write(ifd, &hdr, sizeof(hdr)) == int32_t(sizeof(hdr));
+
+    seek_input(0);
+    uint64_t next_checkpoint_us = 0;
+    uint8_t msg[256];
+    while (ok) {
+        const uint64_t offset = bytes_read;
+        if (!read_message(msg)) {
+            break;
+        }
+        const uint8_t type = msg[2];
+        const uint8_t flags = type == LOG_FORMAT_MSG ? uint8_t(INDEX_STICKY) : index_flags[type];
+        if (flags & INDEX_STICKY) {
+            uint8_t rec[1+sizeof(offset)] { 'S' };
+            memcpy(&rec[1], &offset, sizeof(offset));
+            ok = fs.write(ifd, rec, sizeof(rec)) == int32_t(sizeof(rec));
+        }
+        if (flags & INDEX_UNITS) {
+            // mark formats whose last field is an instance number
+            struct log_Format_Units u;
+            memcpy(&u, msg, sizeof(u));
+            const struct log_Format &uf = formats[u.format_type];
+            const uint8_t nunits = strnlen(u.units, sizeof(u.units));
+            const uint8_t nfields = strnlen(uf.format, sizeof(uf.format));
+            if (nunits > 0 && u.units[nunits-1] == '#' &&
+                nfields > 0 && uf.format[nfields-1] == 'B') {
+                index_flags[u.format_type] |= INDEX_INSTANCE;
+            }
+        }
+        if (flags & INDEX_CHECKPOINT) {
+            uint64_t time_us;
+            memcpy(&time_us, &msg[3], sizeof(time_us));
+            if (time_us >= next_checkpoint_us) {
+                next_checkpoint_us = time_us + LOGREADER_INDEX_INTERVAL_US;
+                uint16_t count = 0;
+                for (uint16_t i=0; i<num_slots; i++) {
+                    if (latest[i] == 0) {
+                        continue;
+                    }
+                    // insertion sort, there are only a few dozen
+                    uint16_t j = count++;
+                    for (; j > 0 && state[j-1] > latest[i]-1; j--) {
+                        state[j] = state[j-1];
+                    }
+                    state[j] = latest[i]-1;
+                }
+                uint8_t rec[1+sizeof(time_us)+sizeof(offset)+sizeof(count)] { 'C' };
+                memcpy(&rec[1], &time_us, sizeof(time_us));
+                memcpy(&rec[9], &offset, sizeof(offset));
+                memcpy(&rec[17], &count, sizeof(count));
+                ok = fs.write(ifd, rec, sizeof(rec)) == int32_t(sizeof(rec)) &&
+                    fs.write(ifd, state, count*sizeof(state[0])) == int32_t(count*sizeof(state[0]));
+            }
+        }
+        if (flags & INDEX_STATE) {
+            const uint8_t instance = (flags & INDEX_INSTANCE) ? msg[formats[type].length-1] : 0;
+            latest[type*LOGREADER_INDEX_MAX_INSTANCES + instance % LOGREADER_INDEX_MAX_INSTANCES] = offset+1;
+        }
+    }
+
+    delete[] latest;
+    delete[] state;
+    fs.close(ifd);
+#if AP_LOGGER_COMPRESSION_ENABLED
+    if (compressed_log) {
+        // messages depend on the ones before them, so can't be replayed
+        // from an arbitrary offset
+        ::printf("Seeking is not supported in compressed logs\n");
+        ok = false;
+    }
+#endif
+    if (!ok) {
+        fs.unlink(index_filename);
+    }
+    return ok;
+}
+
+/*
+  replay a single message from before the seek point
+ */
+bool AP_LoggerFileReader::restore_message(uint64_t offset)
+{
+    return seek_input(offset) && update();
+}
+
+bool AP_LoggerFileReader::seek_time(uint64_t start_us)
+{
+    char index_filename[256];
+    snprintf(index_filename, sizeof(index_filename), "%s.idx", log_filename);
+    if (!index_valid(index_filename) && !build_index(index_filename)) {
+        ::printf("Failed to create log index %s\n", index_filename);
+        return false;
+    }
+
+    auto &fs = AP::FS();
+    const int ifd = fs.open(index_filename, O_RDONLY, true);
+    if (ifd == -1) {
+        return false;
+    }
+
+    // find the last checkpoint at or before start_us
+    int32_t checkpoint = -1;
+    uint64_t checkpoint_us = 0;
+    fs.lseek(ifd, sizeof(log_index_header), SEEK_SET);
+    for (int32_t n=0; ; n++) {
+        uint8_t rec[1+8+8+2];
+        if (fs.read(ifd, rec, 1) != 1) {
+            break;
+        }
+        if (rec[0] == 'S') {
+            fs.lseek(ifd, 8, SEEK_CUR);
+            continue;
+        }
+        uint64_t time_us;
+        uint16_t count;
+        if (fs.read(ifd, &rec[1], sizeof(rec)-1) != int32_t(sizeof(rec)-1)) {
+            break;
+        }
+        memcpy(&time_us, &rec[1], sizeof(time_us));
+        memcpy(&count, &rec[17], sizeof(count));
+        if (time_us > start_us) {
+            break;
+        }
+        checkpoint = n;
+        checkpoint_us = time_us;
+        fs.lseek(ifd, count*sizeof(uint64_t), SEEK_CUR);
+    }
+    if (checkpoint == -1) {
+        // start is before the first checkpoint
+        fs.close(ifd);
+        return seek_input(0);
+    }
+
+    // replay sticky messages before the checkpoint, then the state
+    // messages of the checkpoint
+    bool ok = false;
+    fs.lseek(ifd, sizeof(log_index_header), SEEK_SET);
+    for (int32_t n=0; n<=checkpoint; n++) {
+        uint8_t rec[1+8+8+2];
+        if (fs.read(ifd, rec, 1) != 1) {
+            break;
+        }
+        uint64_t offset;
+        if (rec[0] == 'S') {
+            if (fs.read(ifd, &offset, sizeof(offset)) != int32_t(sizeof(offset)) ||
+                !restore_message(offset)) {
+                break;
+            }
+            continue;
+        }
+        if (fs.read(ifd, &rec[1], sizeof(rec)-1) != int32_t(sizeof(rec)-1)) {
+            break;
+        }
+        uint16_t count;
+        memcpy(&count, &rec[17], sizeof(count));
+        if (n < checkpoint) {
+            fs.lseek(ifd, count*sizeof(uint64_t), SEEK_CUR);
+            continue;
+        }
+        ok = true;
+        for (uint16_t i=0; i<count && ok; i++) {
+            uint64_t state_offset;
+            ok = fs.read(ifd, &state_offset, sizeof(state_offset)) == int32_t(sizeof(state_offset)) &&
+                restore_message(state_offset);
+        }
+        memcpy(&offset, &rec[9], sizeof(offset));
+        ok = ok && seek_input(offset);
+    }
+    fs.close(ifd);
+
+    if (ok) {
+        ::printf("Seek to %.3fs from checkpoint at %.3fs\n", start_us*1.0e-6, checkpoint_us*1.0e-6);
+    }
+    return ok;
 }
 
 float AP_LoggerFileReader::get_percent_read()
@@ -1,9 +1,19 @@
 #pragma once
 
 #include <AP_Logger/AP_Logger.h>
+#include <AP_Logger/LogCompression.h>
 
 #define LOGREADER_MAX_FORMATS 255 // must be >= highest MESSAGE
 
+#ifndef AP_LOGGERFILEREADER_MMAP_ENABLED
+#define AP_LOGGERFILEREADER_MMAP_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
+// minimum log time between checkpoints in a sidecar index
+#define LOGREADER_INDEX_INTERVAL_US 1000000U
+// instance numbers above this share index state slots
+#define LOGREADER_INDEX_MAX_INSTANCES 16
+
 class AP_LoggerFileReader
 {
 public:
@@ -14,6 +24,17 @@ public:
     bool open_log(const char *logfile);
     bool update();
 
+    /*
+      position the reader at the last checkpoint at or before start_us
+      (log TimeUS), replaying FMT, parameter and state messages from
+      before the checkpoint. Uses a sidecar index LOGFILE.idx, which
+      is created on first use
+     */
+    bool seek_time(uint64_t start_us);
+
+    // stop reading at the first checkpoint message after end_us
+    void set_end_time(uint64_t end_us) { end_time_us = end_us; }
+
     virtual bool handle_log_format_msg(const struct log_Format &f) = 0;
     virtual bool handle_msg(const struct log_Format &f, uint8_t *msg) = 0;
 
@@ -26,8 +47,43 @@ protected:
 
     struct log_Format formats[LOGREADER_MAX_FORMATS] {};
 
+    // true for messages starting with TimeUS which mark index checkpoints
+    virtual bool index_checkpoint_msg(const struct log_Format &f) const;
+    // true for messages where the latest of each instance must be
+    // replayed to restore state after a seek
+    virtual bool index_state_msg(const struct log_Format &f) const { return false; }
+
 private:
     ssize_t read_input(void *buf, size_t count);
+    bool seek_input(uint64_t offset);
+    bool read_message(uint8_t *msg);
+    bool restore_message(uint64_t offset);
+
+    bool index_valid(const char *index_filename);
+    bool build_index(const char *index_filename);
+
+    enum IndexFlags : uint8_t {
+        INDEX_CHECKPOINT = (1U<<0),
+        INDEX_STICKY     = (1U<<1), // all are replayed, e.g. PARM
+        INDEX_STATE      = (1U<<2), // latest of each instance is replayed
+        INDEX_INSTANCE   = (1U<<3), // last byte is the instance number
+        INDEX_UNITS      = (1U<<4), // FMTU message
+    };
+    uint8_t index_flags[256] {};
+
+    char *log_filename = nullptr;
+    uint64_t end_time_us = 0;
+
+#if AP_LOGGER_COMPRESSION_ENABLED
+    // state for logs written with LOG_COMPRESS
+    AP_Logger_Compression decompressor;
+    bool compressed_log = false;
+#endif
+
+#if AP_LOGGERFILEREADER_MMAP_ENABLED
+    // the whole log mapped read-only, or nullptr to use AP::FS reads
+    const uint8_t *mapped_log = nullptr;
+#endif
 
     uint64_t bytes_read = 0;
     uint64_t file_size = 0; // Total size of the log file
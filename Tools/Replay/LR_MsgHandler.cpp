@@ -8,7 +8,8 @@
 
 extern const AP_HAL::HAL& hal;
 
-#define MSG_CREATE(sname,msgbytes) log_ ##sname msg; memcpy((void*)&msg, (msgbytes)+3, sizeof(msg));
+// messages from older logs may be shorter, missing fields are zero
+#define MSG_CREATE(sname,msgbytes) log_ ##sname msg {}; memcpy((void*)&msg, (msgbytes)+3, MIN(sizeof(msg), size_t(f.length-3)));
 
 LR_MsgHandler::LR_MsgHandler(struct log_Format &_f) :
     MsgHandler(_f) {
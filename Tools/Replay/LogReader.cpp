@@ -147,6 +147,38 @@ bool LogReader::handle_msg(const struct log_Format &f, uint8_t *msg) {
     return true;
 }
 
+/*
+  index checkpoints are at the start of a DAL frame
+ */
+bool LogReader::index_checkpoint_msg(const struct log_Format &f) const
+{
+    return strncmp(f.name, "RFRH", 4) == 0;
+}
+
+/*
+  DAL messages which are only logged when they change, so the latest
+  of each must be replayed after a seek. Messages which feed a
+  measurement or event directly into the EKF are not state
+ */
+bool LogReader::index_state_msg(const struct log_Format &f) const
+{
+    static const char *state_msgs[] = {
+        "RFRH", "RFRN",
+        "RISH", "RISI",
+        "RASH", "RASI",
+        "RBRH", "RBRI",
+        "RRNH", "RRNI",
+        "RGPH", "RGPI", "RGPJ",
+        "RMGH", "RMGI",
+        "RBCH", "RBCI",
+        "RVOH",
+        nullptr
+    };
+    char name[5] {};
+    memcpy(name, f.name, 4);
+    return in_list(name, state_msgs);
+}
+
 /*
   see if a user parameter is set
  */
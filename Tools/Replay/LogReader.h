@@ -21,6 +21,8 @@ public:
     static bool in_list(const char *type, const char *list[]);
 
 protected:
+    bool index_checkpoint_msg(const struct log_Format &f) const override;
+    bool index_state_msg(const struct log_Format &f) const override;
 
 private:
 
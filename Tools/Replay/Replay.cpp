@@ -21,6 +21,7 @@
 #include <AP_HAL/utility/getopt_cpp.h>
 
 #include <AP_Vehicle/AP_Vehicle.h>
+#include <AP_DAL/AP_DAL.h>
 
 #include <GCS_MAVLink/GCS_Dummy.h>
 #include <AP_Filesystem/AP_Filesystem.h>
@@ -31,6 +32,15 @@
 #include <AP_HAL_Linux/Scheduler.h>
 #endif
 
+#if AP_REPLAY_BATCH_ENABLED
+#include <errno.h>
+#include <libgen.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #define streq(x, y) (!strcmp(x, y))
 
 static ReplayVehicle replayvehicle;
@@ -126,14 +136,23 @@ void Replay::usage(void)
     ::printf("\t--force-ekf2 force enable EKF2\n");
     ::printf("\t--force-ekf3 force enable EKF3\n");
     ::printf("\t--progress  show a progress bar during replay\n");
+    ::printf("\t--summary FILENAME  write a summary of the replay to a file\n");
+    ::printf("\t--start-time SECONDS  start replay at this log time, using a LOGFILE.idx index\n");
+    ::printf("\t--end-time SECONDS  stop replay at this log time\n");
+#if AP_REPLAY_BATCH_ENABLED
+    ::printf("\t--jobs N  replay multiple logs with N processes (default number of CPUs)\n");
+    ::printf("\t--batch-dir DIR  output directory for multiple log replay (default replay-batch)\n");
+#endif
 }
 
 enum param_key : uint8_t {
     FORCE_EKF2 = 1,
     FORCE_EKF3,
+    START_TIME,
+    END_TIME,
 };
 
-void Replay::_parse_command_line(uint8_t argc, char * const argv[])
+void Replay::_parse_command_line(int argc, char * const argv[])
 {
     const struct GetOptLong::option options[] = {
         // name           has_arg flag   val
@@ -143,11 +162,18 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
         {"force-ekf2",      false,  0, param_key::FORCE_EKF2},
         {"force-ekf3",      false,  0, param_key::FORCE_EKF3},
         {"progress",        false,  0, 'P'},
+        {"summary",         true,   0, 'S'},
+        {"start-time",      true,   0, param_key::START_TIME},
+        {"end-time",        true,   0, param_key::END_TIME},
+#if AP_REPLAY_BATCH_ENABLED
+        {"jobs",            true,   0, 'j'},
+        {"batch-dir",       true,   0, 'B'},
+#endif
         {"help",            false,  0, 'h'},
         {0, false, 0, 0}
     };
 
-    GetOptLong gopt(argc, argv, "p:F:Ph", options);
+    GetOptLong gopt(argc, argv, "p:F:PS:j:B:h", options);
 
     int opt;
     while ((opt = gopt.getoption()) != -1) {
@@ -182,6 +208,28 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
             show_progress = true;
             break;
 
+        case 'S':
+            summary_filename = gopt.optarg;
+            break;
+
+        case param_key::START_TIME:
+            start_time_us = atof(gopt.optarg) * 1.0e6;
+            break;
+
+        case param_key::END_TIME:
+            end_time_us = atof(gopt.optarg) * 1.0e6;
+            break;
+
+#if AP_REPLAY_BATCH_ENABLED
+        case 'j':
+            batch_jobs = atoi(gopt.optarg);
+            break;
+
+        case 'B':
+            batch_dir = gopt.optarg;
+            break;
+#endif
+
         case 'h':
         default:
             usage();
@@ -192,6 +240,8 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
     argv += gopt.optind;
     argc -= gopt.optind;
 
+    filenames = argv;
+    num_filenames = argc;
     if (argc > 0) {
         filename = argv[0];
     }
@@ -249,7 +299,7 @@ void Replay::setup()
 {
     ::printf("Starting\n");
 
-    uint8_t argc;
+    int argc;
     char * const *argv;
 
     hal.util->commandline_arguments(argc, argv);
@@ -258,6 +308,13 @@ void Replay::setup()
         _parse_command_line(argc, argv);
     }
 
+#if AP_REPLAY_BATCH_ENABLED
+    if (num_filenames > 1 || batch_jobs > 0) {
+        // only returns in the child process replaying one log
+        run_batch();
+    }
+#endif
+
     _vehicle.setup();
 
     set_user_parameters();
@@ -288,15 +345,25 @@ void Replay::setup()
         ::printf("open(%s): %m\n", filename);
         exit(1);
     }
+    if (start_time_us != 0 && !reader.seek_time(start_time_us)) {
+        ::printf("Failed to seek to %.3fs in %s\n", start_time_us*1.0e-6, filename);
+        exit(1);
+    }
+    reader.set_end_time(end_time_us);
 
     if (replay_force_ekf2) {
         write_EKF_formats();
     }
+
+    summary.start_us = AP_HAL::micros64();
 }
 
 void Replay::loop()
 {
     if (!reader.update()) {
+        if (summary_filename != nullptr) {
+            write_summary();
+        }
 #if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
     // If we don't tear down the threads then they continue to access
     // global state during object destruction.
@@ -304,7 +371,11 @@ void Replay::loop()
 #endif
         exit(0);
     }
-    
+
+    if (summary_filename != nullptr) {
+        update_summary();
+    }
+
     // Display progress bar if enabled
     if (show_progress) {
         uint32_t now = AP_HAL::millis();
@@ -335,6 +406,194 @@ void Replay::loop()
     }
 }
 
+/*
+  accumulate EKF3 statistics for the summary, once per EKF frame
+ */
+void Replay::update_summary(void)
+{
+    const uint64_t log_us = AP::dal().micros64();
+    if (log_us == summary.last_log_us) {
+        return;
+    }
+    if (summary.first_log_us == 0) {
+        summary.first_log_us = log_us;
+    }
+    summary.last_log_us = log_us;
+
+    const NavEKF3 &ekf3 = _vehicle.ekf3;
+    if (ekf3.activeCores() == 0) {
+        return;
+    }
+    const int8_t primary = ekf3.getPrimaryCoreIndex();
+    if (summary.primary != -1 && primary != summary.primary) {
+        summary.lane_switches++;
+    }
+    summary.primary = primary;
+
+    float velVar, posVar, hgtVar, tasVar;
+    Vector3f magVar;
+    Vector2f offset;
+    if (!ekf3.getVariances(velVar, posVar, hgtVar, magVar, tasVar, offset)) {
+        return;
+    }
+    summary.ekf3_samples++;
+    summary.vel.update(velVar);
+    summary.pos.update(posVar);
+    summary.hgt.update(hgtVar);
+    summary.mag.update(magVar.length());
+    summary.tas.update(tasVar);
+}
+
+/*
+  write the replay summary. Innovation test ratios are for the EKF3
+  primary lane
+ */
+void Replay::write_summary(void)
+{
+    auto &fs = AP::FS();
+    int fd = fs.open(summary_filename, O_WRONLY|O_CREAT|O_TRUNC, true);
+    if (fd == -1) {
+        ::printf("Failed to open summary file: %s\n", summary_filename);
+        return;
+    }
+    const float n = MAX(summary.ekf3_samples, 1U);
+    char buf[512];
+    const int len = snprintf(buf, sizeof(buf),
+                             "log=%s\n"
+                             "wall_time_s=%.3f\n"
+                             "log_time_s=%.3f\n"
+                             "ekf3_samples=%u\n"
+                             "lane_switches=%u\n"
+                             "final_lane=%d\n"
+                             "vel_test_ratio=%.4f,%.4f\n"
+                             "pos_test_ratio=%.4f,%.4f\n"
+                             "hgt_test_ratio=%.4f,%.4f\n"
+                             "mag_test_ratio=%.4f,%.4f\n"
+                             "tas_test_ratio=%.4f,%.4f\n",
+                             filename,
+                             (AP_HAL::micros64() - summary.start_us) * 1.0e-6,
+                             (summary.last_log_us - summary.first_log_us) * 1.0e-6,
+                             unsigned(summary.ekf3_samples),
+                             unsigned(summary.lane_switches),
+                             int(summary.primary),
+                             summary.vel.sum / n, summary.vel.max,
+                             summary.pos.sum / n, summary.pos.max,
+                             summary.hgt.sum / n, summary.hgt.max,
+                             summary.mag.sum / n, summary.mag.max,
+                             summary.tas.sum / n, summary.tas.max);
+    if (len > 0) {
+        fs.write(fd, buf, MIN(unsigned(len), sizeof(buf)-1));
+    }
+    fs.close(fd);
+}
+
+#if AP_REPLAY_BATCH_ENABLED
+/*
+  replay each log in its own child process, running up to batch_jobs
+  at once. Replay state lives in singletons (parameters, DAL, logger)
+  so independent replays can't share a process. Only returns in a
+  child, with filename set to the log it should replay
+ */
+void Replay::run_batch(void)
+{
+    if (batch_jobs == 0) {
+        batch_jobs = MAX(sysconf(_SC_NPROCESSORS_ONLN), 1);
+    }
+    if (mkdir(batch_dir, 0755) != 0 && errno != EEXIST) {
+        ::printf("mkdir(%s): %m\n", batch_dir);
+        exit(1);
+    }
+    ::fflush(stdout);
+
+    // the child running in each job slot, pid 0 for a free slot
+    struct BatchJob {
+        pid_t pid;
+        uint32_t idx;
+    };
+    BatchJob *jobs = NEW_NOTHROW BatchJob[batch_jobs];
+    if (jobs == nullptr) {
+        ::printf("Failed to allocate %u jobs\n", unsigned(batch_jobs));
+        exit(1);
+    }
+    uint32_t next = 0;
+    uint16_t running = 0;
+    uint32_t failed = 0;
+    while (next < num_filenames || running > 0) {
+        if (next < num_filenames && running < batch_jobs) {
+            const pid_t pid = fork();
+            if (pid == -1) {
+                ::printf("fork: %m\n");
+                exit(1);
+            }
+            if (pid == 0) {
+                delete[] jobs;
+                setup_batch_child(next);
+                return;
+            }
+            for (uint16_t i=0; i<batch_jobs; i++) {
+                if (jobs[i].pid == 0) {
+                    jobs[i].pid = pid;
+                    jobs[i].idx = next;
+                    break;
+                }
+            }
+            next++;
+            running++;
+            continue;
+        }
+        int status;
+        const pid_t pid = wait(&status);
+        if (pid == -1) {
+            break;
+        }
+        for (uint16_t i=0; i<batch_jobs; i++) {
+            if (jobs[i].pid != pid) {
+                continue;
+            }
+            jobs[i].pid = 0;
+            running--;
+            const bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            if (!ok) {
+                failed++;
+            }
+            ::printf("%s: %s\n", filenames[jobs[i].idx], ok ? "OK" : "FAILED");
+        }
+    }
+    delete[] jobs;
+    ::printf("Replayed %u logs, %u failed\n", unsigned(num_filenames), unsigned(failed));
+    exit(failed == 0 ? 0 : 1);
+}
+
+/*
+  run a batch replay child in its own directory under batch_dir, so
+  the output log, parameter storage and summary don't collide with
+  other children
+ */
+void Replay::setup_batch_child(uint32_t idx)
+{
+    char path[PATH_MAX];
+    if (realpath(filenames[idx], path) == nullptr) {
+        ::printf("realpath(%s): %m\n", filenames[idx]);
+        exit(1);
+    }
+    filename = strdup(path);
+
+    char dir[PATH_MAX];
+    snprintf(dir, sizeof(dir), "%s/%03u-%s", batch_dir, unsigned(idx), basename(path));
+    if ((mkdir(dir, 0755) != 0 && errno != EEXIST) || chdir(dir) != 0) {
+        ::printf("%s: %m\n", dir);
+        exit(1);
+    }
+    if (freopen("replay.txt", "w", stdout) == nullptr) {
+        exit(1);
+    }
+    if (summary_filename == nullptr) {
+        summary_filename = "summary.txt";
+    }
+    show_progress = false;
+}
+#endif // AP_REPLAY_BATCH_ENABLED
+
 /*
   setup user -p parameters
  */
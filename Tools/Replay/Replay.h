@@ -21,6 +21,11 @@
 
 #define AP_PARAM_VEHICLE_NAME replayvehicle
 
+// batch replay forks a process per log, which needs a single threaded HAL
+#ifndef AP_REPLAY_BATCH_ENABLED
+#define AP_REPLAY_BATCH_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL)
+#endif
+
 struct user_parameter {
     struct user_parameter *next;
     char name[17];
@@ -99,11 +104,52 @@ private:
     const char *filename;
     ReplayVehicle &_vehicle;
 
+    // all log filenames given on the command line
+    char * const *filenames;
+    uint32_t num_filenames;
+
+    // log time window to replay, zero for the whole log
+    uint64_t start_time_us;
+    uint64_t end_time_us;
+
+    // if set, a summary of the replay is written to this file
+    const char *summary_filename;
+
+    // statistics for the replay summary
+    struct RatioStats {
+        float max;
+        double sum;
+        void update(float v) {
+            max = MAX(max, v);
+            sum += v;
+        }
+    };
+    struct {
+        uint64_t start_us;
+        uint64_t first_log_us;
+        uint64_t last_log_us;
+        uint32_t ekf3_samples;
+        uint32_t lane_switches;
+        int8_t primary = -1;
+        RatioStats vel, pos, hgt, mag, tas;
+    } summary;
+
+    void update_summary(void);
+    void write_summary(void);
+
+#if AP_REPLAY_BATCH_ENABLED
+    uint16_t batch_jobs;
+    const char *batch_dir = "replay-batch";
+
+    void run_batch(void);
+    void setup_batch_child(uint32_t idx);
+#endif
+
     LogReader reader{_vehicle.log_structure, _vehicle.ekf2, _vehicle.ekf3};
     bool show_progress = false;  // Flag to determine if progress bar should be shown
     uint32_t last_progress_update = 0; // Last time progress was displayed
 
-    void _parse_command_line(uint8_t argc, char * const argv[]);
+    void _parse_command_line(int argc, char * const argv[]);
 
     void set_user_parameters(void);
     bool parse_param_line(char *line, char **vname, float &value);
@@ -0,0 +1,184 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  benchmark of the EKF3 prediction and fusion steps using the sensor
+  data from a log recorded with LOG_REPLAY=1
+
+  The log is first replayed through the DAL into EKF3 in the same way
+  as the Replay tool. The state of the first core at the end of the
+  log is then saved, and each benchmark restores that state before
+  every call so all iterations run with the same recorded data.
+
+  usage: replay_ekf3_benchmark [--benchmark_filter=REGEX] LOGFILE
+ */
+
+#include <AP_gbenchmark.h>
+
+#include "../Replay.h"
+#include "../LogReader.h"
+
+#include <AP_DAL/AP_DAL.h>
+#include <AP_NavEKF3/AP_NavEKF3_core.h>
+#include <GCS_MAVLink/GCS_Dummy.h>
+#include <AP_AdvancedFailsafe/AP_AdvancedFailsafe.h>
+
+#include <chrono>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// globals used by the Replay log reader
+user_parameter *user_parameters;
+bool replay_force_ekf2;
+bool replay_force_ekf3;
+
+GCS_Dummy _gcs;
+static AP_Logger logger;
+
+#if AP_ADVANCEDFAILSAFE_ENABLED
+AP_AdvancedFailsafe *AP::advancedfailsafe() { return nullptr; }
+bool AP_AdvancedFailsafe::gcs_terminate(bool should_terminate, const char *reason) { return false; }
+#endif
+
+#if AP_LTM_TELEM_ENABLED
+void AP_LTM_Telem::init() {};
+#endif
+#if AP_DEVO_TELEM_ENABLED
+void AP_DEVO_Telem::init() {};
+#endif
+
+class NavEKF3_Benchmark {
+public:
+    NavEKF2 ekf2;
+    NavEKF3 ekf3;
+
+    // replay a log, returning false if EKF3 did not start
+    bool load(const char *filename);
+
+    // copy the state of the first core
+    void save_core(void);
+    NavEKF3_core &restore_core(void);
+
+    typedef void (*kernel_fn)(NavEKF3_core &core);
+
+    static void UpdateStrapdownEquationsNED(NavEKF3_core &core) {
+        core.UpdateStrapdownEquationsNED();
+    }
+    static void CovariancePrediction(NavEKF3_core &core) {
+        core.CovariancePrediction(nullptr);
+    }
+    static void FuseVelPosNED(NavEKF3_core &core) {
+        core.fuseVelData = true;
+        core.fusePosData = true;
+        core.fuseHgtData = true;
+        core.FuseVelPosNED();
+    }
+    static void FuseMagnetometer(NavEKF3_core &core) {
+        core.FuseMagnetometer();
+    }
+#if EK3_FEATURE_OPTFLOW_FUSION
+    static void FuseOptFlow(NavEKF3_core &core) {
+        // a zero flow rate sample, as the flow buffer is not part of
+        // the saved core state
+        const NavEKF3_core::of_elements ofDataDelayed {};
+        core.FuseOptFlow(ofDataDelayed, true);
+    }
+#endif
+
+private:
+    struct LogStructure log_structure[256] {};
+
+    // raw copy of the first core, restored before each kernel call
+    alignas(NavEKF3_core) uint8_t saved_core[sizeof(NavEKF3_core)];
+};
+
+static NavEKF3_Benchmark bench;
+
+#undef AP_PARAM_VEHICLE_NAME
+#define AP_PARAM_VEHICLE_NAME bench
+
+// parameter table so PARM messages in the log reach the EKF
+const AP_Param::Info var_info[] = {
+    GOBJECTN(ekf2, NavEKF2, "EK2_", NavEKF2),
+    GOBJECTN(ekf3, NavEKF3, "EK3_", NavEKF3),
+    AP_VAREND
+};
+static AP_Param param_loader{var_info};
+
+bool NavEKF3_Benchmark::load(const char *filename)
+{
+    LogReader reader{log_structure, ekf2, ekf3};
+    if (!reader.open_log(filename)) {
+        ::printf("Failed to open log %s\n", filename);
+        return false;
+    }
+    while (reader.update()) {
+    }
+    if (ekf3.core == nullptr || ekf3.num_cores == 0) {
+        ::printf("EKF3 did not start in %s\n", filename);
+        return false;
+    }
+    save_core();
+    return true;
+}
+
+void NavEKF3_Benchmark::save_core(void)
+{
+    memcpy(saved_core, (const void *)&ekf3.core[0], sizeof(saved_core));
+}
+
+NavEKF3_core &NavEKF3_Benchmark::restore_core(void)
+{
+    memcpy((void *)&ekf3.core[0], saved_core, sizeof(saved_core));
+    return ekf3.core[0];
+}
+
+/*
+  time a single call of a kernel, restoring the core state before
+  each call so the timing is not affected by the kernel's own updates
+ */
+static void BM_EKF3Kernel(benchmark::State &state, NavEKF3_Benchmark::kernel_fn kernel)
+{
+    while (state.KeepRunning()) {
+        NavEKF3_core &core = bench.restore_core();
+        const auto start = std::chrono::steady_clock::now();
+        kernel(core);
+        const auto end = std::chrono::steady_clock::now();
+        gbenchmark_escape(&core);
+        state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+    }
+    bench.restore_core();
+}
+
+BENCHMARK_CAPTURE(BM_EKF3Kernel, UpdateStrapdownEquationsNED, &NavEKF3_Benchmark::UpdateStrapdownEquationsNED)->UseManualTime();
+BENCHMARK_CAPTURE(BM_EKF3Kernel, CovariancePrediction, &NavEKF3_Benchmark::CovariancePrediction)->UseManualTime();
+BENCHMARK_CAPTURE(BM_EKF3Kernel, FuseVelPosNED, &NavEKF3_Benchmark::FuseVelPosNED)->UseManualTime();
+BENCHMARK_CAPTURE(BM_EKF3Kernel, FuseMagnetometer, &NavEKF3_Benchmark::FuseMagnetometer)->UseManualTime();
+#if EK3_FEATURE_OPTFLOW_FUSION
+BENCHMARK_CAPTURE(BM_EKF3Kernel, FuseOptFlow, &NavEKF3_Benchmark::FuseOptFlow)->UseManualTime();
+#endif
+
+int main(int argc, char *argv[])
+{
+    benchmark::Initialize(&argc, argv);
+    if (argc != 2) {
+        ::printf("Usage: %s [benchmark options] LOGFILE\n", argv[0]);
+        return 1;
+    }
+    if (!bench.load(argv[1])) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
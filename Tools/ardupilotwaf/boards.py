@@ -83,11 +83,12 @@ class Board:
                 AP_SCRIPTING_ENABLED = 0,
             )
 
-        # embed any scripts from ROMFS/scripts
-        if os.path.exists('ROMFS/scripts'):
-            for f in os.listdir('ROMFS/scripts'):
-                if fnmatch.fnmatch(f, "*.lua"):
-                    env.ROMFS_FILES += [('scripts/'+f,'ROMFS/scripts/'+f)]
+        # embed any scripts from ROMFS/scripts, and fast lane scripts from ROMFS/scripts/fast
+        for d in ['scripts', 'scripts/fast']:
+            if os.path.isdir('ROMFS/'+d):
+                for f in os.listdir('ROMFS/'+d):
+                    if fnmatch.fnmatch(f, "*.lua") or fnmatch.fnmatch(f, "*.luac"):
+                        env.ROMFS_FILES += [(d+'/'+f, 'ROMFS/'+d+'/'+f)]
 
         # allow GCS disable for AP_DAL example
         if cfg.options.no_gcs:
@@ -555,6 +556,12 @@ class Board:
         if cfg.options.ekf_single:
             env.CXXFLAGS += ['-DHAL_WITH_EKF_DOUBLE=0']
 
+        if cfg.options.ekf_mixed_precision:
+            env.CXXFLAGS += ['-DEK3_FEATURE_MIXED_PRECISION=1']
+
+        if cfg.options.static_dispatch:
+            env.CXXFLAGS += ['-DHAL_STATIC_DISPATCH_ENABLED=1']
+
         if cfg.options.consistent_builds:
             # if symbols are renamed we don't want them to affect the output:
             env.CXXFLAGS += ['-fno-rtti']
@@ -613,7 +620,7 @@ class Board:
 
         # Allow lua to load from ROMFS if any lua files are added
         for file in ctx.env.ROMFS_FILES:
-            if file[0].startswith("scripts") and file[0].endswith(".lua"):
+            if file[0].startswith("scripts") and file[0].endswith((".lua", ".luac")):
                 ctx.env.CXXFLAGS += ['-DHAL_HAVE_AP_ROMFS_EMBEDDED_LUA']
                 break
 
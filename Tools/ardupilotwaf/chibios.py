@@ -373,6 +373,26 @@ class generate_apj(Task.Task):
         f.write(json.dumps(d, indent=4))
         f.close()
 
+class generate_crcmap(Task.Task):
+    '''generate a block CRC map of the firmware, served beside the bin
+    file so the DroneCAN bootloader can fetch only the sectors that
+    have changed'''
+    color='CYAN'
+    always_run = True
+    block_size = 1024
+    def keyword(self):
+        return "crcmap_gen"
+    def run(self):
+        import struct, zlib
+        img = open(self.inputs[0].abspath(),'rb').read()
+        # header of magic "APCM", block size and image size, then
+        # the CRC32 of each block as crc32_small() would give
+        crcmap = struct.pack("<III", 0x4d435041, self.block_size, len(img))
+        for ofs in range(0, len(img), self.block_size):
+            block = img[ofs:ofs+self.block_size]
+            crcmap += struct.pack("<I", zlib.crc32(block, 0xffffffff) ^ 0xffffffff)
+        open(self.outputs[0].abspath(), 'wb').write(crcmap)
+
 class build_abin(Task.Task):
     '''build an abin file for skyviper firmware upload via web UI'''
     color='CYAN'
@@ -426,6 +446,11 @@ def chibios_firmware(self):
     generate_apj_task = self.create_task('generate_apj', src=bin_target, tgt=apj_target)
     generate_apj_task.set_run_after(generate_bin_task)
 
+    if self.env.AP_PERIPH and not self.bld.env.BOOTLOADER:
+        crcmap_target = self.bld.bldnode.find_or_declare('bin/' + link_output.change_ext('.bin.crcmap').name)
+        crcmap_task = self.create_task('generate_crcmap', src=bin_target[0], tgt=crcmap_target)
+        crcmap_task.set_run_after(generate_apj_task)
+
     if self.env.BUILD_ABIN:
         abin_target = self.bld.bldnode.find_or_declare('bin/' + link_output.change_ext('.abin').name)
         abin_task = self.create_task('build_abin', src=bin_target, tgt=abin_target)
@@ -482,7 +482,7 @@ def run_step(step):
                     raise ValueError("Bad supplementary_test_binary %s" % supplementary_test_binary)
                 config_name = a[0]
                 binary_name = a[1]
-                instance_num = int(a[2])
+                instance_num = int(a[2]) + opts.instance
                 param_file = a[3].split(",")
                 bin_path = util.reltopdir(os.path.join('build', config_name, 'bin', binary_name))
                 customisation = '-I {}'.format(instance_num)
@@ -516,6 +516,7 @@ def run_step(step):
         "build_opts": copy.copy(build_opts),
         "generate_junit": opts.junit,
         "enable_fgview": opts.enable_fgview,
+        "instance": opts.instance,
     }
     if opts.speedup is not None:
         fly_opts["speedup"] = opts.speedup
@@ -968,6 +969,10 @@ if __name__ == "__main__":
                          default=None,
                          type='int',
                          help='speedup to run the simulations at')
+    group_sim.add_option("--instance",
+                         default=0,
+                         type='int',
+                         help='SITL instance to use, moves all network ports up by 10 per instance')
     group_sim.add_option("--valgrind",
                          default=False,
                          action='store_true',
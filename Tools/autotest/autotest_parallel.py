@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+
+'''
+Run autotest subtests in parallel, each against its own SITL instance
+
+Each subtest runs in a separate autotest.py process with its own SITL
+instance number, so every network port is distinct, and its own
+working directory and BUILDLOGS directory, so eeprom.bin, logs and
+tlogs do not collide. Binaries must already be built, e.g.:
+
+  ./Tools/autotest/autotest.py build.Copter
+  ./Tools/autotest/autotest_parallel.py -j 8 test.Copter -- --no-clean
+
+Arguments after -- are passed to every autotest.py run. Tests which
+need supplementary binaries (test.CAN etc) share multicast CAN and
+are run one at a time after the others. Durations are saved in the
+output directory and used to start the longest tests first next time.
+
+AP_FLAKE8_CLEAN
+'''
+
+import argparse
+import concurrent.futures
+import json
+import os
+import queue
+import subprocess
+import sys
+import threading
+import time
+
+import autotest
+
+
+class ParallelAutoTest(object):
+    def __init__(self, steps, jobs, output_dir, first_instance, timeout, autotest_args):
+        self.steps = steps
+        self.jobs = jobs
+        self.output_dir = os.path.realpath(output_dir)
+        self.first_instance = first_instance
+        self.timeout = timeout
+        self.autotest_args = autotest_args
+        self.autotest_path = os.path.join(os.path.dirname(os.path.realpath(__file__)), "autotest.py")
+        self.print_lock = threading.Lock()
+        self.results = {}
+
+    def progress(self, message):
+        with self.print_lock:
+            print("PARALLEL: %s" % (message,))
+            sys.stdout.flush()
+
+    def expand_steps(self):
+        '''expand test.Vehicle steps into one step per subtest'''
+        ret = []
+        for step in self.steps:
+            if step in autotest.tester_class_map:
+                tester = autotest.tester_class_map[step]("/bin/true", None)
+                for subtest in tester.tests():
+                    if not isinstance(subtest, autotest.Test):
+                        subtest = autotest.Test(subtest)
+                    ret.append("%s.%s" % (step, subtest.name))
+                continue
+            if autotest.find_specific_test_to_run(step) is None:
+                raise ValueError("Not a test step: %s" % step)
+            ret.append(step)
+        return ret
+
+    def is_exclusive(self, step):
+        '''tests with supplementary binaries cannot share the machine'''
+        for prefix in autotest.supplementary_test_binary_map.keys():
+            if step.startswith(prefix + "."):
+                return True
+        return False
+
+    def timings_path(self):
+        return os.path.join(self.output_dir, "timings.json")
+
+    def load_timings(self):
+        try:
+            with open(self.timings_path()) as f:
+                return json.load(f)
+        except (OSError, ValueError):
+            return {}
+
+    def save_timings(self, timings):
+        for (step, result) in self.results.items():
+            timings[step] = result["duration"]
+        with open(self.timings_path(), "w") as f:
+            json.dump(timings, f, indent=2, sort_keys=True)
+
+    def run_step(self, step, instances):
+        instance = instances.get()
+        try:
+            step_dir = os.path.join(self.output_dir, step)
+            os.makedirs(step_dir, exist_ok=True)
+            env = dict(os.environ)
+            env["BUILDLOGS"] = step_dir
+            cmd = [self.autotest_path, "--instance", str(instance)]
+            cmd.extend(self.autotest_args)
+            cmd.append(step)
+            self.progress("Starting %s (instance %u)" % (step, instance))
+            start = time.time()
+            with open(os.path.join(step_dir, "autotest.log"), "w") as log:
+                p = subprocess.Popen(cmd, cwd=step_dir, env=env, stdin=subprocess.DEVNULL,
+                                     stdout=log, stderr=subprocess.STDOUT)
+                try:
+                    returncode = p.wait(timeout=self.timeout)
+                except subprocess.TimeoutExpired:
+                    p.kill()
+                    p.wait()
+                    returncode = None
+            duration = time.time() - start
+        finally:
+            instances.put(instance)
+
+        if returncode == 0:
+            status = "PASSED"
+        elif returncode is None:
+            status = "TIMEOUT"
+        else:
+            status = "FAILED"
+        self.results[step] = {
+            "status": status,
+            "duration": duration,
+            "log": os.path.join(step_dir, "autotest.log"),
+        }
+        self.progress("%s %s (%.1fs)" % (step, status, duration))
+
+    def run_pool(self, steps, jobs):
+        instances = queue.Queue()
+        for i in range(jobs):
+            instances.put(self.first_instance + i)
+        with concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as executor:
+            futures = [executor.submit(self.run_step, step, instances) for step in steps]
+            for future in futures:
+                future.result()
+
+    def report(self, wall_time):
+        passed = [s for s in self.results if self.results[s]["status"] == "PASSED"]
+        failed = sorted([s for s in self.results if self.results[s]["status"] != "PASSED"])
+        test_time = sum([r["duration"] for r in self.results.values()])
+        lines = [
+            "%u tests, %u passed, %u failed" % (len(self.results), len(passed), len(failed)),
+            "%.0fs of tests in %.0fs with %u jobs" % (test_time, wall_time, self.jobs),
+        ]
+        for step in failed:
+            lines.append("%s %s: %s" % (self.results[step]["status"], step, self.results[step]["log"]))
+        with open(os.path.join(self.output_dir, "results.txt"), "w") as f:
+            for step in sorted(self.results.keys()):
+                r = self.results[step]
+                f.write("%-8s %8.1f %s\n" % (r["status"], r["duration"], step))
+        for line in lines:
+            self.progress(line)
+        return len(failed) == 0
+
+    def run(self):
+        os.makedirs(self.output_dir, exist_ok=True)
+        steps = self.expand_steps()
+        timings = self.load_timings()
+
+        # start the longest tests first so the last ones to finish are short
+        steps.sort(key=lambda s: timings.get(s, 0), reverse=True)
+
+        shared = [s for s in steps if not self.is_exclusive(s)]
+        exclusive = [s for s in steps if self.is_exclusive(s)]
+        self.progress("Running %u tests with %u jobs" % (len(steps), self.jobs))
+
+        start = time.time()
+        self.run_pool(shared, self.jobs)
+        self.run_pool(exclusive, 1)
+        wall_time = time.time() - start
+
+        self.save_timings(timings)
+        return self.report(wall_time)
+
+
+if __name__ == '__main__':
+    argv = sys.argv[1:]
+    autotest_args = []
+    if "--" in argv:
+        autotest_args = argv[argv.index("--")+1:]
+        argv = argv[:argv.index("--")]
+
+    parser = argparse.ArgumentParser(description='run autotest subtests in parallel')
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(),
+                        help="number of tests to run at once")
+    parser.add_argument("--output-dir", default=os.path.join(autotest.buildlogs_dirpath(), "parallel"),
+                        help="directory for per-test logs and the results summary")
+    parser.add_argument("--first-instance", type=int, default=1,
+                        help="first SITL instance number to use, jobs use consecutive instances")
+    parser.add_argument("--timeout", type=int, default=1800,
+                        help="timeout for each test in seconds")
+    parser.add_argument("steps", nargs="+",
+                        help="steps to run, e.g. test.Copter or test.Copter.MotorFail")
+    args = parser.parse_args(argv)
+
+    tester = ParallelAutoTest(
+        args.steps,
+        args.jobs,
+        args.output_dir,
+        args.first_instance,
+        args.timeout,
+        autotest_args,
+    )
+    if not tester.run():
+        sys.exit(1)
@@ -1936,6 +1936,7 @@ class TestSuite(ABC):
                  dronecan_tests=False,
                  generate_junit=False,
                  enable_fgview=False,
+                 instance=0,
                  build_opts={}):
 
         self.start_time = time.time()
@@ -2003,6 +2004,7 @@ class TestSuite(ABC):
         self.in_drain_mav = False
         self.tlog = None
         self.enable_fgview = enable_fgview
+        self.instance = instance
 
         self.rc_thread = None
         self.rc_thread_should_quit = False
@@ -2100,13 +2102,14 @@ class TestSuite(ABC):
 
     def adjust_ardupilot_port(self, port):
         '''adjust port in case we do not wish to use the default range (5760 and 5501 etc)'''
-        return port
+        # SITL moves its ports up by 10 for each instance
+        return port + 10 * self.instance
 
     def spare_network_port(self, offset=0):
         '''returns a network port which should be able to be bound'''
         if offset > 2:
             raise ValueError("offset too large")
-        return 8000 + offset
+        return 8000 + 10 * self.instance + offset
 
     def autotest_connection_string_to_ardupilot(self):
         return "tcp:127.0.0.1:%u" % self.adjust_ardupilot_port(5760)
@@ -2114,7 +2117,7 @@ class TestSuite(ABC):
     def sitl_rcin_port(self, offset=0):
         if offset > 2:
             raise ValueError("offset too large")
-        return 5501 + offset
+        return self.adjust_ardupilot_port(5501) + offset
 
     def mavproxy_options(self):
         """Returns options to be passed to MAVProxy."""
@@ -9267,6 +9270,9 @@ Also, ignores heartbeats not from our target system'''
 
         if "model" not in start_sitl_args or start_sitl_args["model"] is None:
             start_sitl_args["model"] = self.frame
+        if self.instance != 0:
+            customisations = start_sitl_args.get("customisations", [])
+            start_sitl_args["customisations"] = customisations + ["-I", str(self.instance)]
         self.progress("Starting SITL", send_statustext=False)
         if binary is None:
             binary = self.binary
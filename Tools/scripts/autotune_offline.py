@@ -0,0 +1,259 @@
+#!/usr/bin/env python
+'''
+suggest multicopter rate controller gains from a flight log
+
+Each axis is fitted with a discrete first-order model with delay, from
+the rate controller output to the measured rate in the RATE log
+message. Candidate gain sets are then flown against that model in
+parallel, using the same criteria as AC_AutoTune_Multi: D is raised
+until the bounce back after a rate twitch exceeds AUTOTUNE_AGGR, then
+P is raised until the overshoot exceeds AUTOTUNE_AGGR.
+
+Use a log with ATTITUDE_FAST logging and some sharp stick inputs on
+each axis. The suggested gains are a starting point, so check them in
+flight before relying on them.
+
+./Tools/scripts/autotune_offline.py --aggr 0.075 --outfile tune.parm 00000012.BIN
+
+AP_FLAKE8_CLEAN
+'''
+
+import math
+import multiprocessing
+import sys
+from argparse import ArgumentParser
+
+import numpy as np
+from pymavlink import mavutil
+
+# constants from AC_AutoTune_Multi.cpp
+AUTOTUNE_PI_RATIO_FOR_TESTING = 0.1
+AUTOTUNE_PI_RATIO_FINAL = 1.0
+AUTOTUNE_YAW_PI_RATIO_FINAL = 0.1
+AUTOTUNE_RD_MAX = 0.200
+AUTOTUNE_RP_MIN = 0.01
+AUTOTUNE_RP_MAX = 2.0
+AUTOTUNE_RD_BACKOFF = 1.0
+AUTOTUNE_RP_BACKOFF = 1.0
+AUTOTUNE_TARGET_RATE_RLLPIT_CDS = 18000
+AUTOTUNE_TARGET_RATE_YAW_CDS = 9000
+
+# log field names of the measured rate and controller output, and the parameter name of each axis
+AXES = {
+    'roll': ('R', 'ROut', 'ATC_RAT_RLL'),
+    'pitch': ('P', 'POut', 'ATC_RAT_PIT'),
+    'yaw': ('Y', 'YOut', 'ATC_RAT_YAW'),
+}
+
+# maximum model delay in samples to consider
+MAX_DELAY = 10
+
+# length of each simulated twitch in seconds
+TWITCH_TIME = 1.0
+
+
+class AxisModel(object):
+    '''discrete model: rate[k+1] = a * rate[k] + b * out[k - delay]'''
+
+    def __init__(self, a, b, delay, dt, fit):
+        self.a = a
+        self.b = b
+        self.delay = delay
+        self.dt = dt
+        self.fit = fit
+
+    def __str__(self):
+        return "a=%.4f b=%.4f delay=%u dt=%.5f fit=%.3f" % (self.a, self.b, self.delay, self.dt, self.fit)
+
+
+def fit_model(rate, out, dt):
+    '''least squares fit of the axis model for each delay, keeping the best'''
+    best = None
+    n = len(rate)
+    for delay in range(MAX_DELAY + 1):
+        y = rate[delay + 1:n]
+        X = np.column_stack((rate[delay:n - 1], out[0:n - delay - 1], np.ones(n - delay - 1)))
+        coef, _, _, _ = np.linalg.lstsq(X, y, rcond=None)
+        residual = y - X.dot(coef)
+        fit = 1.0 - np.var(residual) / max(np.var(y), 1.0e-12)
+        if best is None or fit > best.fit:
+            best = AxisModel(coef[0], coef[1], delay, dt, fit)
+    return best
+
+
+def lowpass_alpha(dt, freq):
+    '''the same as calc_lowpass_alpha_dt()'''
+    if freq <= 0:
+        return 1.0
+    rc = 1.0 / (2 * math.pi * freq)
+    return dt / (dt + rc)
+
+
+def simulate_twitch(job):
+    '''fly a rate step against the model with an AC_PID style controller, return (overshoot, bounce, stable)'''
+    model, P, I, D, imax, filt_T_hz, filt_E_hz, filt_D_hz, target = job
+    dt = model.dt
+    alpha_T = lowpass_alpha(dt, filt_T_hz)
+    alpha_E = lowpass_alpha(dt, filt_E_hz)
+    alpha_D = lowpass_alpha(dt, filt_D_hz)
+    steps = int(TWITCH_TIME / dt)
+
+    rate = 0.0
+    target_filt = 0.0
+    error = 0.0
+    derivative = 0.0
+    integrator = 0.0
+    out_hist = [0.0] * (model.delay + 1)
+    peak = 0.0
+    min_after_peak = None
+    for _ in range(steps):
+        target_filt += alpha_T * (target - target_filt)
+        error_last = error
+        error += alpha_E * ((target_filt - rate) - error)
+        derivative += alpha_D * ((error - error_last) / dt - derivative)
+        integrator = max(-imax, min(imax, integrator + error * I * dt))
+        out = max(-1.0, min(1.0, P * error + D * derivative + integrator))
+        out_hist.append(out)
+        rate = model.a * rate + model.b * out_hist[-1 - model.delay]
+        out_hist.pop(0)
+        if not math.isfinite(rate) or abs(rate) > 10 * target:
+            return (float('inf'), float('inf'), False)
+        if rate >= peak:
+            peak = rate
+            min_after_peak = None
+        elif min_after_peak is None or rate < min_after_peak:
+            min_after_peak = rate
+
+    # settled to within 10% of the target by the end of the twitch
+    stable = abs(rate - target) < 0.1 * target
+    overshoot = peak / target - 1.0
+    bounce = 0.0 if min_after_peak is None else (peak - min_after_peak) / target
+    return (overshoot, bounce, stable)
+
+
+def run_jobs(pool, jobs):
+    if pool is None:
+        return [simulate_twitch(j) for j in jobs]
+    return pool.map(simulate_twitch, jobs)
+
+
+def tune_axis(pool, name, model, params, aggr, min_d, steps):
+    '''tune D then P for one axis as AC_AutoTune_Multi would'''
+    prefix = AXES[name][2]
+    P = params.get(prefix + '_P', 0.135)
+    D = params.get(prefix + '_D', 0.0036)
+    imax = params.get(prefix + '_IMAX', 0.5)
+    filt_T_hz = params.get(prefix + '_FLTT', 0.0)
+    filt_E_hz = params.get(prefix + '_FLTE', 0.0)
+    filt_D_hz = params.get(prefix + '_FLTD', 20.0)
+    if name == 'yaw':
+        target = math.radians(AUTOTUNE_TARGET_RATE_YAW_CDS * 0.01)
+    else:
+        target = math.radians(AUTOTUNE_TARGET_RATE_RLLPIT_CDS * 0.01)
+
+    def job(p, d):
+        return (model, p, p * AUTOTUNE_PI_RATIO_FOR_TESTING, d, imax, filt_T_hz, filt_E_hz, filt_D_hz, target)
+
+    # D up: the largest D whose bounce back stays within the aggressiveness, flown at the current P
+    if name != 'yaw':
+        d_candidates = np.linspace(min_d, AUTOTUNE_RD_MAX, steps)
+        results = run_jobs(pool, [job(P, d) for d in d_candidates])
+        good = [d for d, (_, bounce, stable) in zip(d_candidates, results) if stable and bounce <= aggr]
+        if good:
+            D = max(good) * AUTOTUNE_RD_BACKOFF
+        else:
+            D = min_d
+
+    # P up: the largest P whose overshoot stays within the aggressiveness
+    p_candidates = np.linspace(AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, steps)
+    results = run_jobs(pool, [job(p, D) for p in p_candidates])
+    good = [p for p, (overshoot, _, stable) in zip(p_candidates, results) if stable and overshoot <= aggr]
+    if not good:
+        print("%s: no stable P found, keeping current gains" % name)
+        return None
+    P = max(good) * AUTOTUNE_RP_BACKOFF
+
+    pi_ratio = AUTOTUNE_YAW_PI_RATIO_FINAL if name == 'yaw' else AUTOTUNE_PI_RATIO_FINAL
+    ret = {
+        prefix + '_P': P,
+        prefix + '_I': P * pi_ratio,
+    }
+    if name != 'yaw':
+        ret[prefix + '_D'] = D
+    return ret
+
+
+def load_log(filename, condition):
+    '''return the RATE samples per axis, the mean sample period and the last value of each parameter'''
+    mlog = mavutil.mavlink_connection(filename)
+    params = {}
+    times = []
+    data = {name: ([], []) for name in AXES}
+    while True:
+        msg = mlog.recv_match(type=['RATE', 'PARM'], condition=condition)
+        if msg is None:
+            break
+        if msg.get_type() == 'PARM':
+            params[msg.Name] = msg.Value
+            continue
+        times.append(msg.TimeUS * 1.0e-6)
+        for name, (rate_field, out_field, _) in AXES.items():
+            data[name][0].append(math.radians(getattr(msg, rate_field)))
+            data[name][1].append(getattr(msg, out_field))
+    if len(times) < 100:
+        return None, None, params
+    dt = float(np.median(np.diff(times)))
+    return data, dt, params
+
+
+def main():
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("--aggr", type=float, default=None,
+                        help='bounce back and overshoot limit, defaults to AUTOTUNE_AGGR from the log')
+    parser.add_argument("--min-d", type=float, default=None, help='minimum D, defaults to AUTOTUNE_MIN_D from the log')
+    parser.add_argument("--axes", default="roll,pitch,yaw", help='comma separated list of axes to tune')
+    parser.add_argument("--steps", type=int, default=100, help='number of candidate gains tried for each gain')
+    parser.add_argument("--min-fit", type=float, default=0.5, help='minimum model fit (R squared) needed to tune an axis')
+    parser.add_argument("--jobs", type=int, default=multiprocessing.cpu_count(), help='number of parallel processes')
+    parser.add_argument("--condition", default=None, help='match condition')
+    parser.add_argument("--outfile", default=None, help='write suggested parameters to this file')
+    parser.add_argument("log", metavar="LOG")
+    args = parser.parse_args()
+
+    data, dt, params = load_log(args.log, args.condition)
+    if data is None:
+        print("Not enough RATE data in log")
+        sys.exit(1)
+    aggr = args.aggr if args.aggr is not None else params.get('AUTOTUNE_AGGR', 0.075)
+    min_d = args.min_d if args.min_d is not None else params.get('AUTOTUNE_MIN_D', 0.0005)
+    print("RATE sample period %.5fs, aggressiveness %.3f" % (dt, aggr))
+
+    pool = multiprocessing.Pool(args.jobs) if args.jobs > 1 else None
+    suggested = {}
+    for name in args.axes.split(','):
+        if name not in AXES:
+            print("Unknown axis %s" % name)
+            sys.exit(1)
+        rate, out = data[name]
+        model = fit_model(np.array(rate), np.array(out), dt)
+        print("%s model: %s" % (name, model))
+        if model.fit < args.min_fit or model.b <= 0:
+            print("%s: model fit too poor to tune, fly sharper inputs on this axis" % name)
+            continue
+        gains = tune_axis(pool, name, model, params, aggr, min_d, args.steps)
+        if gains is not None:
+            suggested.update(gains)
+    if pool is not None:
+        pool.close()
+
+    for pname in sorted(suggested.keys()):
+        print("%-16s %.5f (was %s)" % (pname, suggested[pname], params.get(pname, 'unset')))
+    if args.outfile is not None:
+        with open(args.outfile, 'w') as f:
+            for pname in sorted(suggested.keys()):
+                f.write("%s %.5f\n" % (pname, suggested[pname]))
+        print("Wrote %s" % args.outfile)
+
+
+if __name__ == '__main__':
+    main()
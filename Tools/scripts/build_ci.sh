@@ -329,6 +329,8 @@ for t in $CI_BUILD_TARGET; do
         $waf copter
         echo "Building CPUInfo"
         $waf --target=tool/CPUInfo
+        echo "Building Benchmark"
+        $waf --target=tool/Benchmark
 
         # test external flash build
         echo "Building SPRacingH7"
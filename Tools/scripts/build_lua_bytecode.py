@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+
+'''
+compile Lua scripts into bytecode for the ArduPilot scripting engine
+
+This builds a luac compiler from the Lua sources in
+libraries/AP_Scripting/lua/src with the same number formats as the
+firmware, then compiles each script to a stripped .luac file. The
+bytecode header records the type sizes of the compiler, so the
+compiler must be built for the word size of the target: 32 bit for
+flight controllers (needs a multilib host compiler) or --native for
+SITL and 64 bit Linux boards.
+
+Put .luac files in ROMFS/scripts to build them into the firmware, or
+in the scripts directory on the SD card with bit 7 of SCR_DEBUG_OPTS
+set. A .luac file is loaded in place of a .lua file of the same name.
+
+AP_FLAKE8_CLEAN
+'''
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+LUA_SOURCES = [
+    'lapi', 'lauxlib', 'lcode', 'lctype', 'ldebug', 'ldo', 'ldump',
+    'lfunc', 'lgc', 'llex', 'lmem', 'lobject', 'lopcodes', 'lparser',
+    'lstate', 'lstring', 'ltable', 'ltm', 'lundump', 'lvm', 'lzio', 'luac',
+]
+
+# functions the ArduPilot Lua sources expect from the firmware
+STUB_SOURCE = '''
+#include <stdlib.h>
+#include "lua.h"
+static void *l_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+  (void)ud; (void)osize;
+  if (nsize == 0) { free(ptr); return NULL; }
+  return realloc(ptr, nsize);
+}
+lua_State *luaL_newstate(void) { return lua_newstate(l_alloc, NULL); }
+void lua_abort(void) { abort(); }
+'''
+
+
+def build_luac(topdir, builddir, native, cc):
+    '''build a host luac matching the firmware, returns its path'''
+    libdir = os.path.join(topdir, 'libraries')
+    srcdir = os.path.join(libdir, 'AP_Scripting', 'lua', 'src')
+
+    # the compiler uses the host stdio rather than the ArduPilot filesystem
+    stubdir = os.path.join(builddir, 'include', 'AP_Filesystem')
+    os.makedirs(stubdir, exist_ok=True)
+    with open(os.path.join(stubdir, 'posix_compat.h'), 'w') as f:
+        f.write('#pragma once\n')
+    stub_c = os.path.join(builddir, 'stubs.c')
+    with open(stub_c, 'w') as f:
+        f.write(STUB_SOURCE)
+
+    luac = os.path.join(builddir, 'luac')
+    cmd = [cc, '-O1', '-w',
+           '-DCONFIG_HAL_BOARD=HAL_BOARD_SITL',
+           '-DCONFIG_HAL_BOARD_SUBTYPE=HAL_BOARD_SUBTYPE_NONE',
+           '-DLUA_32BITS=1',
+           '-I' + os.path.join(builddir, 'include'),
+           '-I' + libdir,
+           '-I' + srcdir]
+    if not native:
+        cmd.append('-m32')
+    cmd += [stub_c] + [os.path.join(srcdir, s + '.c') for s in LUA_SOURCES]
+    cmd += ['-lm', '-o', luac]
+    subprocess.check_call(cmd)
+    return luac
+
+
+def main():
+    parser = argparse.ArgumentParser(description='compile Lua scripts to ArduPilot bytecode')
+    parser.add_argument('--native', action='store_true',
+                        help='build for the host word size, for SITL and 64 bit Linux boards')
+    parser.add_argument('--cc', default='gcc', help='host C compiler')
+    parser.add_argument('--output-dir', default=None,
+                        help='directory for the .luac files, defaults to next to each script')
+    parser.add_argument('--no-strip', action='store_true',
+                        help='keep debug information such as line numbers in error messages')
+    parser.add_argument('scripts', nargs='+', help='Lua scripts to compile')
+    args = parser.parse_args()
+
+    topdir = os.path.realpath(os.path.join(os.path.dirname(__file__), '..', '..'))
+
+    with tempfile.TemporaryDirectory() as builddir:
+        luac = build_luac(topdir, builddir, args.native, args.cc)
+        for script in args.scripts:
+            name = os.path.splitext(os.path.basename(script))[0] + '.luac'
+            outdir = args.output_dir if args.output_dir is not None else os.path.dirname(script)
+            out = os.path.join(outdir, name)
+            cmd = [luac, '-o', out]
+            if not args.no_strip:
+                cmd.append('-s')
+            cmd.append(script)
+            if subprocess.call(cmd) != 0:
+                print("Failed to compile %s" % script)
+                sys.exit(1)
+            print("%s -> %s (%u bytes)" % (script, out, os.path.getsize(out)))
+
+
+if __name__ == '__main__':
+    main()
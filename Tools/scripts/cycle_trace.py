@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+'''
+decode @SYS/trace.bin written by a firmware built with
+AP_CYCLE_TRACE_ENABLED, giving a histogram of the time taken by each
+traced scope and optionally folded stacks for a flame graph
+
+./Tools/scripts/cycle_trace.py trace.bin
+./Tools/scripts/cycle_trace.py trace.bin --folded trace.folded
+flamegraph.pl trace.folded > trace.svg
+
+The folded stacks hold the self time of each scope in microseconds
+and can also be loaded into speedscope.
+
+This must match AP_CycleTrace::dump()
+
+AP_FLAKE8_CLEAN
+'''
+
+import struct
+import sys
+from argparse import ArgumentParser
+
+TRACE_MAGIC = b'CTRC'
+TRACE_VERSION = 1
+HEADER_FORMAT = '<4sBBBBI'
+ENTRY_FORMAT = '<IIBB'
+NAME_LEN = 16
+
+
+def decode_name(b):
+    return b.split(b'\0', 1)[0].decode('utf-8', errors='replace')
+
+
+def parse(data):
+    '''return cycles per microsecond, scope names and a list of (thread name, entries)'''
+    hsize = struct.calcsize(HEADER_FORMAT)
+    (magic, version, num_scopes, num_threads, _, cycles_per_us) = struct.unpack(HEADER_FORMAT, data[:hsize])
+    if magic != TRACE_MAGIC or version != TRACE_VERSION:
+        raise ValueError("not a version %u trace" % TRACE_VERSION)
+    ofs = hsize
+    scopes = []
+    for i in range(num_scopes):
+        scopes.append(decode_name(data[ofs:ofs+NAME_LEN]))
+        ofs += NAME_LEN
+    esize = struct.calcsize(ENTRY_FORMAT)
+    threads = []
+    for i in range(num_threads):
+        name = decode_name(data[ofs:ofs+NAME_LEN])
+        (count,) = struct.unpack('<I', data[ofs+NAME_LEN:ofs+NAME_LEN+4])
+        ofs += NAME_LEN + 4
+        entries = [struct.unpack(ENTRY_FORMAT, data[ofs+j*esize:ofs+(j+1)*esize]) for j in range(count)]
+        ofs += count * esize
+        threads.append((name, entries))
+    return cycles_per_us, scopes, threads
+
+
+def scope_name(scopes, idx):
+    if idx < len(scopes):
+        return scopes[idx]
+    return "scope%u" % idx
+
+
+def percentile(values, pct):
+    return values[min(len(values)-1, int(len(values) * pct / 100.0))]
+
+
+def print_histograms(cycles_per_us, scopes, threads):
+    times = {}
+    for (tname, entries) in threads:
+        for (start, cycles, scope, depth) in entries:
+            key = (tname, scope_name(scopes, scope))
+            times.setdefault(key, []).append(cycles / float(cycles_per_us))
+    print("%-16s %-14s %7s %8s %8s %8s %8s %8s" % ("Thread", "Scope", "Count", "Min", "Mean", "P50", "P99", "Max"))
+    for key in sorted(times.keys()):
+        t = sorted(times[key])
+        print("%-16s %-14s %7u %8.2f %8.2f %8.2f %8.2f %8.2f" % (
+            key[0], key[1], len(t), t[0], sum(t)/len(t), percentile(t, 50), percentile(t, 99), t[-1]))
+
+
+def folded_stacks(cycles_per_us, scopes, threads):
+    '''
+    rebuild the nesting of each thread's scopes and return the self time
+    of each stack. Entries are written when a scope ends, so they are
+    ordered by start time here. Start times are taken relative to the
+    end of the newest entry so the counter wrapping doesn't matter
+    '''
+    stacks = {}
+    for (tname, entries) in threads:
+        if len(entries) == 0:
+            continue
+        ref = (entries[-1][0] + entries[-1][1]) & 0xFFFFFFFF
+        spans = []
+        for (start, cycles, scope, depth) in entries:
+            age = (ref - start) & 0xFFFFFFFF
+            spans.append((-age, depth, -age + cycles, scope_name(scopes, scope)))
+        spans.sort()
+        open_spans = []
+        for (start, depth, end, name) in spans:
+            while len(open_spans) > 0 and (open_spans[-1][1] <= start or open_spans[-1][0] >= depth):
+                open_spans.pop()
+            path = ";".join([tname] + [s[2] for s in open_spans] + [name])
+            stacks[path] = stacks.get(path, 0) + (end - start)
+            if len(open_spans) > 0:
+                parent = ";".join([tname] + [s[2] for s in open_spans])
+                stacks[parent] = stacks.get(parent, 0) - (end - start)
+            open_spans.append((depth, end, name))
+    return {k: v / float(cycles_per_us) for (k, v) in stacks.items()}
+
+
+def main():
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("trace", help="trace.bin file")
+    parser.add_argument("--folded", default=None, help="write folded stacks to this file")
+    parser.add_argument("--cycles-per-us", type=int, default=None, help="override the CPU clock in the trace")
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        data = f.read()
+    try:
+        (cycles_per_us, scopes, threads) = parse(data)
+    except (ValueError, struct.error) as ex:
+        print("%s: %s" % (args.trace, ex))
+        sys.exit(1)
+    if args.cycles_per_us is not None:
+        cycles_per_us = args.cycles_per_us
+
+    print_histograms(cycles_per_us, scopes, threads)
+
+    if args.folded is not None:
+        with open(args.folded, 'w') as f:
+            for (path, us) in sorted(folded_stacks(cycles_per_us, scopes, threads).items()):
+                us = int(round(us))
+                if us > 0:
+                    f.write("%s %u\n" % (path, us))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+'''
+decompress a log written with LOG_COMPRESS into a normal .BIN log
+that can be read by any log analysis tool
+
+./Tools/scripts/decompress_log.py 00000042.BIN 00000042-decompressed.BIN
+
+This must match libraries/AP_Logger/LogCompression.cpp
+
+AP_FLAKE8_CLEAN
+'''
+
+import sys
+from argparse import ArgumentParser
+
+HEAD_BYTE1 = 0xA3
+HEAD_BYTE2 = 0x95
+HEAD_BYTE2_COMPRESSED = 0x96
+HEAD_BYTE2_COMPRESSED_FIELDS = 0x97
+
+LOG_FORMAT_MSG = 128
+LOG_FORMAT_UNITS_MSG = 116
+LOG_UNIT_MSG = 117
+LOG_MULT_MSG = 118
+# formats, units and multipliers are never compressed
+UNCOMPRESSED_TYPES = {LOG_FORMAT_MSG, LOG_FORMAT_UNITS_MSG, LOG_UNIT_MSG, LOG_MULT_MSG}
+
+LOG_COMPRESSION_MAX_MSG_LEN = 128
+HEADER_LEN = 3
+FRAME_HEADER_LEN = 4
+NUM_SLOTS = 64
+FMT_LEN = 89
+FORMAT_LEN = 16
+UNITS_LEN = 16
+# offset of format_type and units in a FMTU message
+FMTU_TYPE_OFS = 11
+FMTU_UNITS_OFS = 12
+FMTU_LEN = 44
+
+# size of each format character, and whether changes are stored as a difference
+FIELD_SIZES = {
+    'c': (2, True), 'C': (2, True), 'g': (2, True), 'h': (2, True), 'H': (2, True),
+    'e': (4, True), 'E': (4, True), 'f': (4, True), 'i': (4, True), 'I': (4, True), 'L': (4, True),
+    'd': (8, True), 'q': (8, True), 'Q': (8, True),
+    'b': (1, False), 'B': (1, False), 'M': (1, False),
+    'n': (4, False), 'N': (16, False), 'a': (64, False), 'Z': (64, False),
+}
+
+
+class Decompressor(object):
+    def __init__(self):
+        self.lengths = [0] * 256
+        self.formats = [''] * 256
+        self.instance_ofs = [None] * 256
+        self.slots = [None] * NUM_SLOTS
+
+    def has_instance(self, mtype, size):
+        '''true if messages of this type have an instance field'''
+        ofs = self.instance_ofs[mtype]
+        return ofs is not None and HEADER_LEN + ofs < size
+
+    def previous(self, mtype, size, instance):
+        '''return the previous body of a message type and instance, or None if the type is not compressed'''
+        if mtype in UNCOMPRESSED_TYPES:
+            return None
+        if size != self.lengths[mtype] or size <= HEADER_LEN or size > LOG_COMPRESSION_MAX_MSG_LEN:
+            return None
+        idx = (mtype + 17 * instance) % NUM_SLOTS
+        slot = self.slots[idx]
+        if slot is None or slot[0] != mtype or slot[1] != instance:
+            slot = (mtype, instance, bytearray(LOG_COMPRESSION_MAX_MSG_LEN - HEADER_LEN))
+            self.slots[idx] = slot
+        return slot[2]
+
+    def invalidate(self, mtype):
+        '''forget the previous messages of a type'''
+        for i in range(NUM_SLOTS):
+            if self.slots[i] is not None and self.slots[i][0] == mtype:
+                self.slots[i] = None
+
+    def update_instance_field(self, msg):
+        '''learn the offset of the instance field of a type from its FMTU'''
+        if len(msg) < FMTU_LEN:
+            return
+        ftype = msg[FMTU_TYPE_OFS]
+        units = msg[FMTU_UNITS_OFS:FMTU_UNITS_OFS+UNITS_LEN]
+        ofs = None
+        field_ofs = 0
+        for i, c in enumerate(self.formats[ftype][:UNITS_LEN]):
+            if c not in FIELD_SIZES:
+                break
+            size = FIELD_SIZES[c][0]
+            if units[i] == ord('#'):
+                # only single byte instances are used
+                if size == 1 and field_ofs < LOG_COMPRESSION_MAX_MSG_LEN - HEADER_LEN:
+                    ofs = field_ofs
+                break
+            field_ofs += size
+        if ofs != self.instance_ofs[ftype]:
+            self.instance_ofs[ftype] = ofs
+            self.invalidate(ftype)
+
+    def update(self, msg):
+        '''update the state with an uncompressed message'''
+        mtype = msg[2]
+        if mtype == LOG_FORMAT_MSG:
+            ftype, flen = msg[3], msg[4]
+            self.lengths[ftype] = flen
+            self.formats[ftype] = bytes(msg[9:9+FORMAT_LEN]).split(b'\0')[0].decode('ascii', 'replace')
+            self.invalidate(ftype)
+            return
+        if mtype == LOG_FORMAT_UNITS_MSG:
+            self.update_instance_field(msg)
+            return
+        instance = 0
+        if self.has_instance(mtype, len(msg)):
+            instance = msg[HEADER_LEN + self.instance_ofs[mtype]]
+        prev = self.previous(mtype, len(msg), instance)
+        if prev is not None:
+            prev[:len(msg)-HEADER_LEN] = msg[HEADER_LEN:]
+
+    def decompress_bytes(self, mtype, data, prev, body_len):
+        '''decode a message compressed as the XOR with the previous one'''
+        body = bytearray(body_len)
+        n = 0
+        for i in range(0, body_len, 8):
+            mask = data[n]
+            n += 1
+            for j in range(min(8, body_len - i)):
+                x = 0
+                if mask & (1 << j):
+                    x = data[n]
+                    n += 1
+                body[i+j] = prev[i+j] ^ x
+        if n != len(data):
+            raise ValueError("bad compressed message of type %u" % mtype)
+        return body
+
+    def decompress_fields(self, mtype, data, prev, body_len):
+        '''decode a message compressed as the change in each field'''
+        fmt = self.formats[mtype]
+        mask_len = (len(fmt) + 7) // 8
+        mask = data[:mask_len]
+        n = mask_len
+        body = bytearray(body_len)
+        ofs = 0
+        for i, c in enumerate(fmt):
+            if c not in FIELD_SIZES:
+                raise ValueError("unknown format %s for type %u" % (c, mtype))
+            size, integer = FIELD_SIZES[c]
+            if not mask[i//8] & (1 << (i % 8)):
+                body[ofs:ofs+size] = prev[ofs:ofs+size]
+            elif integer:
+                v = 0
+                shift = 0
+                while True:
+                    b = data[n]
+                    n += 1
+                    v |= (b & 0x7F) << shift
+                    shift += 7
+                    if not b & 0x80:
+                        break
+                d = (v >> 1) ^ -(v & 1)
+                value = (int.from_bytes(prev[ofs:ofs+size], 'little') + d) % (1 << (8*size))
+                body[ofs:ofs+size] = value.to_bytes(size, 'little')
+            else:
+                body[ofs:ofs+size] = data[n:n+size]
+                n += size
+            ofs += size
+        if n != len(data) or ofs != body_len:
+            raise ValueError("bad compressed message of type %u" % mtype)
+        return body
+
+    def decompress(self, head2, mtype, data):
+        '''return the message for the data of a compressed message'''
+        size = self.lengths[mtype]
+        instanced = self.has_instance(mtype, size)
+        instance = 0
+        if instanced:
+            if len(data) == 0:
+                raise ValueError("bad compressed message of type %u" % mtype)
+            instance = data[0]
+            data = data[1:]
+        prev = self.previous(mtype, size, instance)
+        if prev is None:
+            raise ValueError("compressed message of type %u without a format" % mtype)
+        body_len = size - HEADER_LEN
+        try:
+            if head2 == HEAD_BYTE2_COMPRESSED:
+                body = self.decompress_bytes(mtype, data, prev, body_len)
+            else:
+                body = self.decompress_fields(mtype, data, prev, body_len)
+        except IndexError:
+            raise ValueError("bad compressed message of type %u" % mtype)
+        if instanced and body[self.instance_ofs[mtype]] != instance:
+            raise ValueError("bad instance in compressed message of type %u" % mtype)
+        prev[:body_len] = body
+        return bytes(bytearray([HEAD_BYTE1, HEAD_BYTE2, mtype])) + bytes(body)
+
+
+def decompress_log(log):
+    d = Decompressor()
+    out = bytearray()
+    ofs = 0
+    while ofs + FRAME_HEADER_LEN <= len(log):
+        if log[ofs] != HEAD_BYTE1 or log[ofs+1] not in (HEAD_BYTE2, HEAD_BYTE2_COMPRESSED, HEAD_BYTE2_COMPRESSED_FIELDS):
+            # skip data that is not a message, such as the header of a block log
+            ofs += 1
+            continue
+        mtype = log[ofs+2]
+        if log[ofs+1] != HEAD_BYTE2:
+            dlen = log[ofs+3]
+            data = log[ofs+FRAME_HEADER_LEN:ofs+FRAME_HEADER_LEN+dlen]
+            if len(data) != dlen:
+                # truncated log
+                break
+            out += d.decompress(log[ofs+1], mtype, data)
+            ofs += FRAME_HEADER_LEN + dlen
+            continue
+        size = FMT_LEN if mtype == LOG_FORMAT_MSG else d.lengths[mtype]
+        if size == 0:
+            raise ValueError("no format for type %u at offset %u" % (mtype, ofs))
+        msg = log[ofs:ofs+size]
+        if len(msg) != size:
+            # truncated log
+            break
+        d.update(bytearray(msg))
+        out += msg
+        ofs += size
+    return out
+
+
+def main():
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("infile", help="compressed log")
+    parser.add_argument("outfile", help="decompressed log to write")
+    args = parser.parse_args()
+
+    with open(args.infile, 'rb') as f:
+        log = bytearray(f.read())
+    try:
+        out = decompress_log(log)
+    except ValueError as ex:
+        print("Failed to decompress %s: %s" % (args.infile, ex))
+        sys.exit(1)
+    with open(args.outfile, 'wb') as f:
+        f.write(out)
+    print("Decompressed %u bytes to %u bytes" % (len(log), len(out)))
+
+
+if __name__ == '__main__':
+    main()
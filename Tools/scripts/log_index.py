@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+'''
+use the .IDX time index written next to a log to find or extract a
+time range of the log
+
+./Tools/scripts/log_index.py 00000042.IDX
+./Tools/scripts/log_index.py 00000042.IDX --start 120 --end 150
+./Tools/scripts/log_index.py 00000042.IDX --start 120 --end 150 --log 00000042.BIN --output window.BIN
+
+Times are in seconds since boot, as in TimeUS fields. The byte ranges
+printed can be fetched with a MAVLink FTP read or LOG_REQUEST_DATA
+without downloading the whole log. The extracted log is the start of
+the log, which holds the formats, followed by the range, so it can be
+read by any log analysis tool.
+
+This must match AP_Logger_File::index_open() and index_message()
+
+AP_FLAKE8_CLEAN
+'''
+
+import struct
+import sys
+from argparse import ArgumentParser
+
+INDEX_MAGIC = b'LIDX'
+INDEX_VERSION = 1
+HEADER_FORMAT = '<4sBBH'
+ENTRY_FORMAT = '<QI'
+
+
+def read_index(data):
+    '''return the interval in seconds and a list of (time in seconds, offset)'''
+    header_len = struct.calcsize(HEADER_FORMAT)
+    if len(data) < header_len:
+        raise ValueError("index too short")
+    (magic, version, entry_size, interval_ms) = struct.unpack(HEADER_FORMAT, data[:header_len])
+    if magic != INDEX_MAGIC or version != INDEX_VERSION or entry_size != struct.calcsize(ENTRY_FORMAT):
+        raise ValueError("not a version %u log index" % INDEX_VERSION)
+    entries = []
+    for ofs in range(header_len, len(data) - entry_size + 1, entry_size):
+        (time_us, offset) = struct.unpack(ENTRY_FORMAT, data[ofs:ofs+entry_size])
+        entries.append((time_us * 1.0e-6, offset))
+    return (interval_ms * 0.001, entries)
+
+
+def find_range(entries, interval, start, end):
+    '''return the start and end offsets holding the messages from start to end seconds.
+    The range is widened by one interval each side, as messages queued by other
+    threads can be a little out of time order. An end of None is the end of the log'''
+    first = entries[0][1]
+    last = None
+    for (t, offset) in entries:
+        if t <= start - interval:
+            first = offset
+        if end is not None and t >= end + interval:
+            last = offset
+            break
+    return (first, last)
+
+
+def main():
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("index", help="log index (.IDX)")
+    parser.add_argument("--start", type=float, default=None, help="start time in seconds since boot")
+    parser.add_argument("--end", type=float, default=None, help="end time in seconds since boot")
+    parser.add_argument("--log", default=None, help="log (.BIN) to extract the range from")
+    parser.add_argument("--output", default=None, help="file to write the extracted range to")
+    args = parser.parse_args()
+
+    with open(args.index, 'rb') as f:
+        try:
+            (interval, entries) = read_index(f.read())
+        except ValueError as ex:
+            print("Bad index %s: %s" % (args.index, ex))
+            sys.exit(1)
+    if len(entries) == 0:
+        print("Index %s has no entries" % args.index)
+        sys.exit(1)
+
+    header_end = entries[0][1]
+    print("Formats: bytes 0-%u" % header_end)
+    if args.start is None:
+        print("Times %.1fs to %.1fs in %u entries" % (entries[0][0], entries[-1][0], len(entries)))
+        return
+
+    (first, last) = find_range(entries, interval, args.start, args.end)
+    print("Range: bytes %u-%s" % (first, "end" if last is None else str(last)))
+
+    if args.log is None or args.output is None:
+        return
+    with open(args.log, 'rb') as f:
+        log = f.read()
+    with open(args.output, 'wb') as f:
+        f.write(log[:header_end])
+        f.write(log[first:last])
+    print("Wrote %u bytes to %s" % (header_end + len(log[first:last]), args.output))
+
+
+if __name__ == '__main__':
+    main()
@@ -4,13 +4,19 @@
 
 '''
 unpack a param.pck file from @PARAM/param.pck via mavlink FTP
+
+With --crc the CRCs of the parameters are printed in the same form as
+@PARAM/param.crc, to compare with a later param.crc and find the
+blocks which need to be downloaded again
 '''
 
-import struct, sys
+import struct, sys, zlib
 
 from argparse import ArgumentParser
 parser = ArgumentParser(description=__doc__)
 parser.add_argument("file", metavar="LOG")
+parser.add_argument("--crc", action='store_true', help="print the parameter CRCs as in param.crc")
+parser.add_argument("--block-size", type=int, default=32, help="parameters per block CRC")
 
 args = parser.parse_args()
 
@@ -44,6 +50,7 @@ if sys.version_info.major < 3:
     pad_byte = chr(0)
 
 count = 0
+crc_data = []
 
 while True:
     # skip pad bytes
@@ -70,9 +77,17 @@ while True:
     data = data[2+name_len+type_len:]
     v, = struct.unpack("<" + type_format, vdata)
     count += 1
-    print("%-16s %f" % (name, float(v)))
+    crc_data.append(name.encode('utf-8') + bytes([0, ptype]) + vdata)
+    if not args.crc:
+        print("%-16s %f" % (name, float(v)))
 
 if count != num_params or count > total_params:
     print("Error: Got %u params expected %u/%u" % (count, num_params, total_params))
     sys.exit(1)
+
+if args.crc:
+    # this must match AP_Filesystem_Param::crc_file_init()
+    print("CRC 0x%08x of %u params" % (zlib.crc32(b''.join(crc_data)), count))
+    for i in range(0, count, args.block_size):
+        print("Block %u: 0x%08x" % (i // args.block_size, zlib.crc32(b''.join(crc_data[i:i+args.block_size]))))
 sys.exit(0)
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+'''
+run the host benchmarks and record the results as JSON, optionally
+comparing against an earlier run to catch performance regressions
+
+./waf configure --board sitl --enable-benchmarks
+./waf benchmarks
+./Tools/scripts/run_benchmarks.py --output bench.json
+./Tools/scripts/run_benchmarks.py --compare bench.json --threshold 10
+
+Every benchmark program in build/<board>/benchmarks is run with
+google benchmark's JSON output. The results are merged into one file
+along with the git hash and date so they can be tracked over
+time. With --compare the exit status is non-zero if any benchmark
+got slower than the baseline by more than the threshold percentage.
+
+With --console the results are instead read from a capture of the
+console of a board running the Benchmark tool firmware:
+
+./waf configure --board MatekH743
+./waf --target=tool/Benchmark --upload
+./Tools/scripts/run_benchmarks.py --console console.txt --output h743.json
+
+AP_FLAKE8_CLEAN
+'''
+
+import json
+import os
+import subprocess
+import sys
+import time
+from argparse import ArgumentParser
+
+
+def git_hash():
+    try:
+        return subprocess.check_output(['git', 'rev-parse', '--short', 'HEAD'], text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def find_programs(bench_dir, names):
+    '''return the benchmark programs to run, optionally filtered by name'''
+    ret = []
+    for f in sorted(os.listdir(bench_dir)):
+        path = os.path.join(bench_dir, f)
+        if not os.path.isfile(path) or not os.access(path, os.X_OK):
+            continue
+        if names and not any(n in f for n in names):
+            continue
+        ret.append(path)
+    return ret
+
+
+def run_program(path, args):
+    '''run one benchmark program, returning its list of results'''
+    cmd = [path, '--benchmark_format=json']
+    if args.filter:
+        cmd.append('--benchmark_filter=%s' % args.filter)
+    if args.repetitions > 1:
+        cmd.append('--benchmark_repetitions=%u' % args.repetitions)
+        cmd.append('--benchmark_report_aggregates_only=true')
+    out = subprocess.check_output(cmd, text=True)
+    return json.loads(out)
+
+
+def collect(args):
+    bench_dir = os.path.join(args.build_dir, args.board, 'benchmarks')
+    if not os.path.isdir(bench_dir):
+        print("No benchmarks in %s, build them with ./waf benchmarks" % bench_dir)
+        sys.exit(1)
+
+    result = {
+        'git_hash': git_hash(),
+        'date': time.strftime('%Y-%m-%dT%H:%M:%S'),
+        'board': args.board,
+        'context': None,
+        'benchmarks': {},
+    }
+    for path in find_programs(bench_dir, args.program):
+        program = os.path.basename(path)
+        print("Running %s" % program)
+        data = run_program(path, args)
+        if result['context'] is None:
+            result['context'] = data.get('context')
+        for b in data.get('benchmarks', []):
+            if b.get('run_type') == 'aggregate' and b.get('aggregate_name') != 'median':
+                continue
+            name = '%s/%s' % (program, b.get('run_name', b['name']))
+            result['benchmarks'][name] = {
+                'cpu_time': b['cpu_time'],
+                'real_time': b['real_time'],
+                'time_unit': b.get('time_unit', 'ns'),
+                'iterations': b['iterations'],
+            }
+    return result
+
+
+def collect_console(args):
+    '''read the results printed by the Benchmark tool firmware'''
+    result = {
+        'git_hash': git_hash(),
+        'date': time.strftime('%Y-%m-%dT%H:%M:%S'),
+        'board': None,
+        'context': None,
+        'benchmarks': {},
+    }
+    with open(args.console) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) >= 2 and fields[0] == 'BENCH_BOARD':
+                result['board'] = fields[1]
+                result['context'] = {'board': fields[1:]}
+            elif len(fields) == 4 and fields[0] == 'BENCH':
+                # later runs replace earlier ones
+                result['benchmarks']['Benchmark/%s' % fields[1]] = {
+                    'cpu_time': float(fields[3]),
+                    'real_time': float(fields[3]),
+                    'time_unit': 'ns',
+                    'cycles': float(fields[2]),
+                    'iterations': 1,
+                }
+    if len(result['benchmarks']) == 0:
+        print("No BENCH results in %s" % args.console)
+        sys.exit(1)
+    return result
+
+
+UNIT_SCALE = {
+    'ns': 1.0,
+    'us': 1.0e3,
+    'ms': 1.0e6,
+    's': 1.0e9,
+}
+
+
+def time_ns(b):
+    return b['cpu_time'] * UNIT_SCALE[b['time_unit']]
+
+
+def compare(result, baseline, threshold):
+    '''print the change of each benchmark, returning the number of regressions'''
+    print("Comparing with %s from %s" % (baseline.get('git_hash'), baseline.get('date')))
+    regressions = 0
+    for name in sorted(result['benchmarks'].keys()):
+        new = result['benchmarks'][name]
+        old = baseline['benchmarks'].get(name)
+        if old is None:
+            print("  %-60s %10.1fns (new)" % (name, time_ns(new)))
+            continue
+        old_ns = time_ns(old)
+        new_ns = time_ns(new)
+        change = 100.0 * (new_ns - old_ns) / old_ns if old_ns > 0 else 0
+        flag = ''
+        if change > threshold:
+            flag = ' REGRESSION'
+            regressions += 1
+        print("  %-60s %10.1fns -> %10.1fns %+6.1f%%%s" % (name, old_ns, new_ns, change, flag))
+    for name in sorted(baseline['benchmarks'].keys()):
+        if name not in result['benchmarks']:
+            print("  %-60s (missing)" % name)
+    return regressions
+
+
+def main():
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument("--board", default="sitl", help="board the benchmarks were built for")
+    parser.add_argument("--build-dir", default="build", help="waf build directory")
+    parser.add_argument("--program", action="append", default=[], help="only run programs whose name contains this")
+    parser.add_argument("--filter", default=None, help="benchmark name regex passed to each program")
+    parser.add_argument("--repetitions", type=int, default=1, help="repeat each benchmark, recording the median")
+    parser.add_argument("--output", default=None, help="write the results to this JSON file")
+    parser.add_argument("--console", default=None, help="read results from a Benchmark tool console capture")
+    parser.add_argument("--compare", default=None, help="baseline JSON file to compare against")
+    parser.add_argument("--threshold", type=float, default=10.0, help="percentage slowdown counted as a regression")
+    args = parser.parse_args()
+
+    if args.console is not None:
+        result = collect_console(args)
+    else:
+        result = collect(args)
+
+    if args.output is not None:
+        with open(args.output, 'w') as f:
+            json.dump(result, f, indent=2, sort_keys=True)
+        print("Wrote %u results to %s" % (len(result['benchmarks']), args.output))
+
+    if args.compare is not None:
+        with open(args.compare) as f:
+            baseline = json.load(f)
+        regressions = compare(result, baseline, args.threshold)
+        if regressions > 0:
+            print("%u benchmarks regressed by more than %.1f%%" % (regressions, args.threshold))
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
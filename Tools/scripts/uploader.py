@@ -233,6 +233,8 @@ class uploader(object):
     EXTF_GET_CRC    = b'\x37'	  # compute & return a CRC of data in external flash
 
     CHIP_FULL_ERASE = b'\x40'     # full erase of flash
+    CHIP_ERASE_LAZY = b'\x41'     # reset address, sectors are erased as programming reaches them
+    PROG_BLOCK      = b'\x42'     # write a CRC checked block at an address
 
     INFO_BL_REV     = b'\x01'        # bootloader protocol revision
     BL_REV_MIN      = 2              # minimum supported bootloader protocol
@@ -241,9 +243,14 @@ class uploader(object):
     INFO_BOARD_REV  = b'\x03'        # board revision
     INFO_FLASH_SIZE = b'\x04'        # max firmware size in bytes
     INFO_EXTF_SIZE  = b'\x06'        # available external flash size
+    INFO_CAPS       = b'\x07'        # capability flags
+
+    CAP_PROG_BLOCK  = 0x01           # CHIP_ERASE_LAZY and PROG_BLOCK supported
 
     PROG_MULTI_MAX  = 252            # protocol max is 255, must be multiple of 4
     READ_MULTI_MAX  = 252            # protocol max is 255
+    PROG_BLOCK_MAX  = 1024           # must be multiple of 4
+    PROG_BLOCK_WINDOW = 2            # blocks sent before waiting for a reply
 
     NSH_INIT        = bytearray(b'\x0d\x0d\x0d')
     NSH_REBOOT_BL   = b"reboot -b\n"
@@ -259,7 +266,8 @@ class uploader(object):
                  source_system=None,
                  source_component=None,
                  no_extf=False,
-                 force_erase=False):
+                 force_erase=False,
+                 no_prog_block=False):
         self.MAVLINK_REBOOT_ID1 = bytearray(b'\xfe\x21\x72\xff\x00\x4c\x00\x00\x40\x40\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xf6\x00\x01\x00\x00\x53\x6b')  # NOQA
         self.MAVLINK_REBOOT_ID0 = bytearray(b'\xfe\x21\x45\xff\x00\x4c\x00\x00\x40\x40\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xf6\x00\x00\x00\x00\xcc\x37')  # NOQA
         if target_component is None:
@@ -270,6 +278,8 @@ class uploader(object):
             source_component = 1
         self.no_extf = no_extf
         self.force_erase = force_erase
+        self.no_prog_block = no_prog_block
+        self.caps = 0
 
         # open the port, keep the default timeout short so we can poll quickly
         self.port = serial.Serial(portname, baudrate_bootloader, timeout=2.0, write_timeout=2.0)
@@ -344,6 +354,16 @@ class uploader(object):
         val = struct.unpack("<I", raw)
         return val[0]
 
+    # receive count bytes, allowing for the bootloader being busy erasing
+    def __recv_wait(self, count, timeout):
+        deadline = time.time() + timeout
+        raw = b''
+        while len(raw) < count:
+            raw += self.port.read(count - len(raw))
+            if len(raw) < count and time.time() > deadline:
+                raise RuntimeError("timeout waiting for data (%u bytes)" % count)
+        return raw
+
     def __recv_uint8(self):
         raw = self.__recv(1)
         val = struct.unpack("<B", raw)
@@ -393,6 +413,17 @@ class uploader(object):
             # timeout, no response yet
             return False
 
+    # get the capability flags, zero for bootloaders without INFO_CAPS
+    def __getCaps(self):
+        self.__send(uploader.GET_DEVICE + uploader.INFO_CAPS + uploader.EOC)
+        raw = self.__recv(2)
+        if raw == self.INSYNC + self.INVALID:
+            return 0
+        raw += self.__recv_wait(2, 2.0)
+        value = struct.unpack("<I", raw)[0]
+        self.__getSync()
+        return value
+
     # send the GET_DEVICE command and wait for an info parameter
     def __getInfo(self, param):
         self.__send(uploader.GET_DEVICE + param + uploader.EOC)
@@ -474,6 +505,89 @@ class uploader(object):
 
         raise RuntimeError("timed out waiting for erase")
 
+    # send the CHIP_ERASE_LAZY command, sectors are then erased as they
+    # are programmed, overlapping the erase with sending the firmware
+    def __erase_lazy(self, label):
+        print("\n", end='')
+        self.__send(uploader.CHIP_ERASE_LAZY +
+                    uploader.EOC)
+        self.__getSync()
+        self.__drawProgressBar(label, 10.0, 10.0)
+
+    # send a PROG_BLOCK command without waiting for the reply
+    def __send_prog_block(self, address, data):
+        crc = zlib.crc32(data, 0xffffffff) ^ 0xffffffff
+        self.__send(uploader.PROG_BLOCK +
+                    struct.pack("<IH", address, len(data)) +
+                    data +
+                    struct.pack("<I", crc) +
+                    uploader.EOC)
+
+    # receive the reply to a PROG_BLOCK, returning (ok, next address)
+    def __recv_prog_block(self):
+        # the bootloader may erase a sector before replying
+        raw = self.__recv_wait(6, 20.0)
+        next_address = struct.unpack("<I", raw[0:4])[0]
+        if raw[4:5] != self.INSYNC:
+            raise RuntimeError("unexpected %s instead of INSYNC" % raw[4:5])
+        if raw[5:6] == self.OK:
+            return (True, next_address)
+        if raw[5:6] == self.FAILED:
+            return (False, next_address)
+        raise RuntimeError("unexpected response %s to PROG_BLOCK" % raw[5:6])
+
+    # get back in sync after a failed PROG_BLOCK, returning the
+    # address the bootloader expects next
+    def __recover_prog_block(self):
+        deadline = time.time() + 20.0
+        while time.time() < deadline:
+            # let replies to blocks already sent arrive, then drop them
+            time.sleep(0.1)
+            self.port.flushInput()
+            try:
+                self.__sync()
+                # a block at an impossible address is refused with the
+                # address the bootloader expects
+                self.__send_prog_block(0xfffffffc, bytearray(4))
+                (ok, next_address) = self.__recv_prog_block()
+                return next_address
+            except RuntimeError:
+                continue
+        raise RuntimeError("lost sync while programming")
+
+    # upload code with PROG_BLOCK, keeping the next block on its way
+    # while the bootloader erases and writes the previous one
+    def __program_blocks(self, label, fw):
+        print("\n", end='')
+        code = fw.image
+        address = 0
+        in_flight = 0
+        failures = 0
+        acked = 0
+        while acked < len(code):
+            while address < len(code) and in_flight < uploader.PROG_BLOCK_WINDOW:
+                block = code[address:address+uploader.PROG_BLOCK_MAX]
+                self.__send_prog_block(address, block)
+                address += len(block)
+                in_flight += 1
+            try:
+                (ok, next_address) = self.__recv_prog_block()
+                in_flight -= 1
+            except RuntimeError:
+                ok = False
+            if ok:
+                acked = next_address
+                if (acked // uploader.PROG_BLOCK_MAX) % 64 == 0:
+                    self.__drawProgressBar(label, acked, len(code))
+                continue
+            failures += 1
+            if failures > 10:
+                raise RuntimeError("Program failed")
+            acked = self.__recover_prog_block()
+            address = acked
+            in_flight = 0
+        self.__drawProgressBar(label, 100, 100)
+
     # send a PROG_MULTI command to write a collection of bytes
     def __program_multi(self, data):
 
@@ -615,7 +729,9 @@ class uploader(object):
         expect_crc = fw.crc(self.fw_maxsize)
         self.__send(uploader.GET_CRC +
                     uploader.EOC)
-        report_crc = self.__recv_int()
+        # after CHIP_ERASE_LAZY the bootloader erases the rest of the
+        # flash before replying
+        report_crc = struct.unpack("<I", self.__recv_wait(4, 20.0))[0]
         self.__getSync()
         if report_crc != expect_crc:
             print("Expected 0x%x" % expect_crc)
@@ -730,6 +846,14 @@ class uploader(object):
                 self.extf_maxsize = 0
                 self.__sync()
 
+        if self.bl_rev >= 5 and not self.no_prog_block:
+            try:
+                self.caps = self.__getCaps()
+            except Exception:
+                print("Could not get bootloader capabilities, assuming none")
+                self.caps = 0
+                self.__sync()
+
         self.board_type = self.__getInfo(uploader.INFO_BOARD_ID)
         self.board_rev = self.__getInfo(uploader.INFO_BOARD_REV)
         self.fw_maxsize = self.__getInfo(uploader.INFO_FLASH_SIZE)
@@ -937,8 +1061,12 @@ class uploader(object):
             self.__verify_extf("Verify ExtF ", fw, fw.property('extf_image_size', 0))
 
         if (fw.property('image_size') > 0):
-            self.__erase("Erase  ")
-            self.__program("Program", fw)
+            if (self.caps & uploader.CAP_PROG_BLOCK) and not self.force_erase:
+                self.__erase_lazy("Erase  ")
+                self.__program_blocks("Program", fw)
+            else:
+                self.__erase("Erase  ")
+                self.__program("Program", fw)
 
             if self.bl_rev == 2:
                 self.__verify_v2("Verify ", fw)
@@ -1137,6 +1265,8 @@ def main():
     parser.add_argument('--erase-extflash', type=lambda x: int(x, 0), default=None,
                         help="Erase sectors containing specified amount of bytes from ext flash")
     parser.add_argument('--force-erase', action="store_true", help="Do not check for pre cleared flash, always erase the chip")
+    parser.add_argument('--no-prog-block', action="store_true",
+                        help="Erase then program in small packets even if the bootloader supports erase while programming")
     parser.add_argument('firmware', nargs="?", action="store", default=None, help="Firmware file to be uploaded")
     args = parser.parse_args()
 
@@ -1175,7 +1305,8 @@ def main():
                                   args.source_system,
                                   args.source_component,
                                   args.no_extf,
-                                  args.force_erase)
+                                  args.force_erase,
+                                  args.no_prog_block)
 
                 except Exception as e:
                     if not is_WSL and not is_WSL2 and "win32" not in _platform:
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+
+'''
+create compact ArduPilot terrain tiles
+
+Each tile file covers one degree of latitude and longitude with a
+single regular grid of heights, stored as 16 bit deltas from a base
+height. Linux boards and SITL map these files into memory when bit 1
+of TERRAIN_OPTIONS is set. Copy the .DTC files into the terrain
+directory alongside any .DAT files.
+
+AP_FLAKE8_CLEAN
+'''
+
+import array
+import math
+import os
+import struct
+import sys
+import time
+import zlib
+
+from argparse import ArgumentParser
+from MAVProxy.modules.mavproxy_map import srtm
+
+TERRAIN_TILE_MAGIC = 0x43545041
+TERRAIN_TILE_FORMAT_VERSION = 1
+TILE_NO_DATA = -32768
+
+
+def to_float32(f):
+    '''emulate single precision float'''
+    return struct.unpack('f', struct.pack('f', f))[0]
+
+
+LOCATION_SCALING_FACTOR = to_float32(0.011131884502145034)
+LOCATION_SCALING_FACTOR_INV = to_float32(89.83204953368922)
+
+
+def longitude_scale(lat):
+    '''get longitude scale factor'''
+    scale = to_float32(math.cos(to_float32(math.radians(lat))))
+    return max(scale, 0.01)
+
+
+def add_offset(lat_e7, lon_e7, ofs_north, ofs_east):
+    '''add offset in meters to a position'''
+    dlat = int(float(ofs_north) * LOCATION_SCALING_FACTOR_INV)
+    dlng = int((float(ofs_east) * LOCATION_SCALING_FACTOR_INV) / longitude_scale((lat_e7+dlat*0.5)*1.0e-7))
+    return (int(lat_e7+dlat), int(lon_e7+dlng))
+
+
+def tile_name(lat_int, lon_int):
+    '''name of the tile file for a degree'''
+    return "%c%02u%c%03u.DTC" % ('S' if lat_int < 0 else 'N', min(abs(lat_int), 99),
+                                 'W' if lon_int < 0 else 'E', min(abs(lon_int), 999))
+
+
+class Tile(object):
+    '''heights over one degree of latitude and longitude'''
+
+    def __init__(self, lat_int, lon_int, spacing):
+        self.lat_int = lat_int
+        self.lon_int = lon_int
+        self.spacing = spacing
+
+        # one grid point past the far edge of the degree so any
+        # position in the degree has four surrounding points. The
+        # degree is widest at the edge closest to the equator
+        deg_m = 1.0e7 * LOCATION_SCALING_FACTOR
+        lon_scale = max(longitude_scale(lat_int), longitude_scale(lat_int+1))
+        self.num_x = int(math.ceil(deg_m / spacing)) + 2
+        self.num_y = int(math.ceil(deg_m * lon_scale / spacing)) + 2
+        self.heights = [None] * (self.num_x * self.num_y)
+
+    def fill(self, downloader):
+        '''look up heights for each grid point'''
+        ref_lat = self.lat_int * 10 * 1000 * 1000
+        ref_lon = self.lon_int * 10 * 1000 * 1000
+        tiles = {}
+        for x in range(self.num_x):
+            for y in range(self.num_y):
+                lat_e7, lon_e7 = add_offset(ref_lat, ref_lon, x*self.spacing, y*self.spacing)
+                lat = lat_e7 * 1.0e-7
+                lon = lon_e7 * 1.0e-7
+                tile_idx = (int(math.floor(lat)), int(math.floor(lon)))
+                while tile_idx not in tiles:
+                    tile = downloader.getTile(tile_idx[0], tile_idx[1])
+                    if tile == 0:
+                        print("waiting on download of %d,%d" % tile_idx)
+                        time.sleep(0.3)
+                        continue
+                    tiles[tile_idx] = tile
+                self.heights[x*self.num_y + y] = tiles[tile_idx].getAltitudeFromLatLon(lat, lon)
+
+    def pack(self):
+        '''pack into the tile file format'''
+        valid = [h for h in self.heights if h is not None]
+        if not valid:
+            return None
+        hmin = min(valid)
+        hmax = max(valid)
+        base = int(round((hmin + hmax) * 0.5))
+        half_span = max(hmax - base, base - hmin)
+        # millimeters per unit of delta, keeping clear of TILE_NO_DATA
+        scale_mm = max(1, int(math.ceil(half_span * 1000.0 / 32767)))
+
+        deltas = array.array('h')
+        for h in self.heights:
+            if h is None:
+                deltas.append(TILE_NO_DATA)
+            else:
+                d = int(round((h - base) * 1000.0 / scale_mm))
+                deltas.append(max(-32767, min(32767, d)))
+        if sys.byteorder != 'little':
+            deltas.byteswap()
+        data = deltas.tobytes()
+
+        header = struct.pack("<IHHhhHHhHI",
+                             TERRAIN_TILE_MAGIC,
+                             TERRAIN_TILE_FORMAT_VERSION,
+                             self.spacing,
+                             self.lat_int,
+                             self.lon_int,
+                             self.num_x,
+                             self.num_y,
+                             base,
+                             scale_mm,
+                             zlib.crc32(data) & 0xFFFFFFFF)
+        return header + data
+
+
+def create_tile(lat_int, lon_int, args, downloader):
+    '''create the tile file for one degree'''
+    name = os.path.join(args.directory, tile_name(lat_int, lon_int))
+    if os.path.exists(name) and not args.force:
+        print("Skipping existing %s" % name)
+        return
+    print("Creating %s" % name)
+    tile = Tile(lat_int, lon_int, args.spacing)
+    tile.fill(downloader)
+    buf = tile.pack()
+    if buf is None:
+        print("No data for %s" % name)
+        return
+    with open(name, 'wb') as f:
+        f.write(buf)
+
+
+def main():
+    parser = ArgumentParser(description='compact terrain tile creator')
+    parser.add_argument("--lat", type=float, required=True)
+    parser.add_argument("--lon", type=float, required=True)
+    parser.add_argument("--radius", type=int, default=100, help="radius in km")
+    parser.add_argument("--spacing", type=int, default=100, help="grid spacing in meters")
+    parser.add_argument("--force", action='store_true', help="overwrite existing tiles")
+    parser.add_argument("--debug", action='store_true', default=False)
+    parser.add_argument("--directory", default="terrain", help="directory to use")
+    args = parser.parse_args()
+
+    downloader = srtm.SRTMDownloader(debug=args.debug)
+    downloader.loadFileList()
+
+    if not os.path.isdir(args.directory):
+        os.mkdir(args.directory)
+
+    done = set()
+    for dx in range(-args.radius, args.radius):
+        for dy in range(-args.radius, args.radius):
+            (lat2, lon2) = add_offset(args.lat*1e7, args.lon*1e7, dx*1000.0, dy*1000.0)
+            if abs(lat2) > 90e7 or abs(lon2) > 180e7:
+                continue
+            tag = (int(math.floor(lat2 * 1.0e-7)), int(math.floor(lon2 * 1.0e-7)))
+            if tag in done:
+                continue
+            done.add(tag)
+            create_tile(tag[0], tag[1], args, downloader)
+
+
+if __name__ == '__main__':
+    main()
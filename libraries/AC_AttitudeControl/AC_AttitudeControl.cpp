@@ -212,13 +212,75 @@ const Vector3f AC_AttitudeControl::get_latest_gyro() const
 #if AC_ATTITUDE_CONTROL_AFTER_RATE_CONTROL
     // rate updates happen before attitude updates so the last gyro value is the last rate gyro value
     // this also allows a separate rate thread to be the source of gyro data
-    return _rate_gyro_rads;
+    RateTelemetry telem;
+    if (get_rate_telemetry(telem)) {
+        return telem.gyro_rads;
+    }
+    return _ahrs.get_gyro_latest();
 #else
     // rate updates happen after attitude updates so the AHRS must be consulted for the last gyro value
     return _ahrs.get_gyro_latest();
 #endif
 }
 
+// hand the current rate targets to the rate controller
+void AC_AttitudeControl::publish_rate_target()
+{
+    const RateTarget target {
+        ang_vel_body_rads : _ang_vel_body_rads,
+        sysid_ang_vel_body_rads : _sysid_ang_vel_body_rads,
+        actuator_sysid : _actuator_sysid,
+        pd_scale : _pd_scale,
+        time_us : AP_HAL::micros(),
+    };
+    _rate_target_buffer.publish(target);
+}
+
+// take the latest rate targets, keeping the previous ones if a
+// consistent copy could not be made. Latency is measured the first
+// time each set of targets is used, which is also when they first
+// reach the motors
+void AC_AttitudeControl::update_rate_target()
+{
+    const uint32_t count = _rate_target_buffer.count();
+    if (count == _rate_target_stats.last_count) {
+        return;
+    }
+    if (!_rate_target_buffer.peek(_rate_target)) {
+        _rate_target_stats.peek_fail++;
+        return;
+    }
+    auto &stats = _rate_target_stats;
+    const uint32_t latency_us = AP_HAL::micros() - _rate_target.time_us;
+    if (stats.count == 0) {
+        stats.latency_min_us = stats.interval_min_us = UINT32_MAX;
+        stats.latency_max_us = stats.interval_max_us = 0;
+        stats.latency_sum_us = 0;
+    }
+    stats.latency_sum_us += latency_us;
+    stats.latency_min_us = MIN(stats.latency_min_us, latency_us);
+    stats.latency_max_us = MAX(stats.latency_max_us, latency_us);
+    if (stats.last_count != 0) {
+        const uint32_t interval_us = _rate_target.time_us - stats.last_time_us;
+        stats.interval_min_us = MIN(stats.interval_min_us, interval_us);
+        stats.interval_max_us = MAX(stats.interval_max_us, interval_us);
+    }
+    stats.count++;
+    stats.last_count = count;
+    stats.last_time_us = _rate_target.time_us;
+}
+
+// publish the gyro and scaling used by the last rate controller run
+void AC_AttitudeControl::publish_rate_telemetry()
+{
+    const RateTelemetry telem {
+        gyro_rads : _rate_gyro_rads,
+        pd_scale_used : _pd_scale_used,
+        time_us : _rate_gyro_time_us,
+    };
+    _rate_telemetry_buffer.publish(telem);
+}
+
 // Ensure attitude controller have zero errors to relax rate controller output
 void AC_AttitudeControl::relax_attitude_controllers()
 {
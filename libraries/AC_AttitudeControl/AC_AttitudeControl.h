@@ -12,6 +12,7 @@
 #include <AC_PID/AC_P.h>
 #include <AP_Vehicle/AP_MultiCopter.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
+#include <AP_HAL/utility/RingBuffer.h>
 
 #define AC_ATTITUDE_CONTROL_ANGLE_P                     4.5f             // default angle P gain for roll, pitch and yaw
 
@@ -332,6 +333,11 @@ public:
     // Run the angular velocity controller with a specified timestep. Must be implemented by derived class.
     virtual void rate_controller_run_dt(const Vector3f& gyro_rads, float dt) { AP_BoardConfig::config_error("rate_controller_run_dt() must be defined"); };
 
+    // Hand the current rate targets to rate_controller_run_dt(). Called
+    // from the main loop once the attitude controllers have run when the
+    // rate controller is run from another thread
+    void publish_rate_target();
+
     // Convert a 321-intrinsic euler angle derivative to an angular velocity vector
     void euler_rate_to_ang_vel(const Quaternion& att, const Vector3f& euler_rate_rads, Vector3f& ang_vel_rads);
 
@@ -561,6 +567,10 @@ public:
     // write ANG message
     void Write_ANG() const;
 
+    // write RTLT message with the rate target latency and interval
+    // since the last call, must be called from the rate controller thread
+    void Write_Rate_Target_Latency();
+
     // User settable parameters
     static const struct AP_Param::GroupInfo var_info[];
 
@@ -620,6 +630,51 @@ protected:
     // timestamp of the latest gyro measurement (in microseconds) value used by the rate controller
     uint64_t            _rate_gyro_time_us;
 
+    // Rate controller inputs, published by the main loop. The rate
+    // controller may run in its own thread so it only ever sees
+    // complete sets of targets from one main loop
+    struct RateTarget {
+        Vector3f ang_vel_body_rads;
+        Vector3f sysid_ang_vel_body_rads;
+        Vector3f actuator_sysid;
+        Vector3f pd_scale;
+        uint32_t time_us;           // time the targets were published
+    };
+    ObjectDoubleBuffer<RateTarget> _rate_target_buffer;
+
+    // Rate targets in use by the rate controller
+    RateTarget          _rate_target { {}, {}, {}, {1,1,1}, 0 };
+
+    // take the latest published rate targets, called by the rate controller
+    void update_rate_target();
+
+    // Rate controller outputs for the attitude controllers and logging
+    struct RateTelemetry {
+        Vector3f gyro_rads;
+        Vector3f pd_scale_used;
+        uint64_t time_us;
+    };
+    ObjectDoubleBuffer<RateTelemetry> _rate_telemetry_buffer;
+
+    // publish the gyro and scaling used by the last rate controller run
+    void publish_rate_telemetry();
+
+    // latest rate controller outputs, safe to call from any thread
+    bool get_rate_telemetry(RateTelemetry &telem) const WARN_IF_UNUSED { return _rate_telemetry_buffer.peek(telem); }
+
+    // Rate target latency and publish interval, only touched by the rate controller thread
+    struct {
+        uint32_t last_count;
+        uint32_t last_time_us;
+        uint32_t latency_sum_us;
+        uint32_t latency_min_us;
+        uint32_t latency_max_us;
+        uint32_t interval_min_us;
+        uint32_t interval_max_us;
+        uint16_t count;
+        uint16_t peek_fail;
+    } _rate_target_stats;
+
     // Intersampling period in seconds
     float               _dt_s;
 
@@ -437,6 +437,8 @@ void AC_AttitudeControl_Heli::rate_controller_run()
         _motors.set_yaw(rate_target_to_motor_yaw(_rate_gyro_rads.z, _ang_vel_body_rads.z));
     }
 
+    publish_rate_telemetry();
+
     _sysid_ang_vel_body_rads.zero();
     _actuator_sysid.zero();
 
@@ -32,10 +32,15 @@ void AC_AttitudeControl::Write_Rate(const AC_PosControl &pos_control) const
 {
     const Vector3f rate_targets = rate_bf_targets() * RAD_TO_DEG;
     const Vector3f &accel_target = pos_control.get_accel_target_NEU_cmss();
-    const Vector3f gyro_rate = _rate_gyro_rads * RAD_TO_DEG;
+    // the rate controller may be running in another thread
+    RateTelemetry telem;
+    if (!get_rate_telemetry(telem)) {
+        return;
+    }
+    const Vector3f gyro_rate = telem.gyro_rads * RAD_TO_DEG;
     const struct log_Rate pkt_rate{
         LOG_PACKET_HEADER_INIT(LOG_RATE_MSG),
-        time_us         : _rate_gyro_time_us,
+        time_us         : telem.time_us,
         control_roll    : rate_targets.x,
         roll            : gyro_rate.x,
         roll_out        : _motors.get_roll()+_motors.get_roll_ff(),
@@ -56,11 +61,11 @@ void AC_AttitudeControl::Write_Rate(const AC_PosControl &pos_control) const
       log P/PD gain scale if not == 1.0
      */
     const Vector3f &scale = get_last_angle_P_scale();
-    const Vector3f &pd_scale = _pd_scale_used;
+    const Vector3f &pd_scale = telem.pd_scale_used;
     if (scale != AC_AttitudeControl::VECTORF_111 || pd_scale != AC_AttitudeControl::VECTORF_111) {
         const struct log_ATSC pkt_ATSC {
             LOG_PACKET_HEADER_INIT(LOG_ATSC_MSG),
-            time_us  : _rate_gyro_time_us,
+            time_us  : telem.time_us,
             scaleP_x : scale.x,
             scaleP_y : scale.y,
             scaleP_z : scale.z,
@@ -72,4 +77,29 @@ void AC_AttitudeControl::Write_Rate(const AC_PosControl &pos_control) const
     }
 }
 
+// Write an RTLT packet
+void AC_AttitudeControl::Write_Rate_Target_Latency()
+{
+    auto &stats = _rate_target_stats;
+    if (stats.count == 0) {
+        // no new targets since the last call
+        stats.latency_min_us = stats.latency_max_us = stats.latency_sum_us = 0;
+        stats.interval_min_us = stats.interval_max_us = 0;
+    }
+    const struct log_RTLT pkt{
+        LOG_PACKET_HEADER_INIT(LOG_RTLT_MSG),
+        time_us         : AP_HAL::micros64(),
+        count           : stats.count,
+        latency_avg_us  : stats.count > 0 ? stats.latency_sum_us / stats.count : 0,
+        latency_min_us  : stats.latency_min_us,
+        latency_max_us  : stats.latency_max_us,
+        interval_min_us : stats.interval_min_us == UINT32_MAX ? 0 : stats.interval_min_us,
+        interval_max_us : stats.interval_max_us,
+        peek_fail       : stats.peek_fail,
+    };
+    AP::logger().WriteBlock(&pkt, sizeof(pkt));
+    stats.count = 0;
+    stats.peek_fail = 0;
+}
+
 #endif // HAL_LOGGING_ENABLED
@@ -441,8 +441,9 @@ void AC_AttitudeControl_Multi::update_throttle_rpy_mix()
 
 void AC_AttitudeControl_Multi::rate_controller_run_dt(const Vector3f& gyro_rads, float dt)
 {
-    // take a copy of the target so that it can't be changed from under us.
-    Vector3f ang_vel_body = _ang_vel_body_rads;
+    // take the latest complete set of targets from the main loop so that they can't be changed from under us.
+    update_rate_target();
+    const RateTarget &target = _rate_target;
 
     // boost angle_p/pd each cycle on high throttle slew
     update_throttle_gain_boost();
@@ -450,21 +451,27 @@ void AC_AttitudeControl_Multi::rate_controller_run_dt(const Vector3f& gyro_rads,
     // move throttle vs attitude mixing towards desired (called from here because this is conveniently called on every iteration)
     update_throttle_rpy_mix();
 
-    ang_vel_body += _sysid_ang_vel_body_rads;
+    const Vector3f ang_vel_body = target.ang_vel_body_rads + target.sysid_ang_vel_body_rads;
 
     _rate_gyro_rads = gyro_rads;
     _rate_gyro_time_us = AP_HAL::micros64();
 
-    _motors.set_roll(get_rate_roll_pid().update_all(ang_vel_body.x, gyro_rads.x,  dt, _motors.limit.roll, _pd_scale.x) + _actuator_sysid.x);
+    const bool limit[3] { _motors.limit.roll, _motors.limit.pitch, _motors.limit.yaw };
+    Vector3f rate_out;
+    _pid_rate_bank.update_all(&ang_vel_body.x, &gyro_rads.x, dt, limit, &target.pd_scale.x, &rate_out.x);
+
+    _motors.set_roll(rate_out.x + target.actuator_sysid.x);
     _motors.set_roll_ff(get_rate_roll_pid().get_ff());
 
-    _motors.set_pitch(get_rate_pitch_pid().update_all(ang_vel_body.y, gyro_rads.y,  dt, _motors.limit.pitch, _pd_scale.y) + _actuator_sysid.y);
+    _motors.set_pitch(rate_out.y + target.actuator_sysid.y);
     _motors.set_pitch_ff(get_rate_pitch_pid().get_ff());
 
-    _motors.set_yaw(get_rate_yaw_pid().update_all(ang_vel_body.z, gyro_rads.z,  dt, _motors.limit.yaw, _pd_scale.z) + _actuator_sysid.z);
+    _motors.set_yaw(rate_out.z + target.actuator_sysid.z);
     _motors.set_yaw_ff(get_rate_yaw_pid().get_ff()*_feedforward_scalar);
 
-    _pd_scale_used = _pd_scale;
+    _pd_scale_used = target.pd_scale;
+
+    publish_rate_telemetry();
 }
 
 // reset the rate controller target loop updates
@@ -479,6 +486,8 @@ void AC_AttitudeControl_Multi::rate_controller_target_reset()
 void AC_AttitudeControl_Multi::rate_controller_run()
 {
     Vector3f gyro_latest_rads = _ahrs.get_gyro_latest();
+    // running in the main loop, so the targets are always current
+    publish_rate_target();
     rate_controller_run_dt(gyro_latest_rads, _dt_s);
 }
 
@@ -5,6 +5,7 @@
 
 #include "AC_AttitudeControl.h"
 #include <AP_Motors/AP_MotorsMulticopter.h>
+#include <AC_PID/AC_PID_Bank.h>
 
 // default rate controller PID gains
 #ifndef AC_ATC_MULTI_RATE_RP_P
@@ -149,6 +150,9 @@ protected:
         }
     };
 
+    // roll, pitch and yaw rate controllers, updated together by the rate controller
+    AC_PID_Bank<3>        _pid_rate_bank {{ &_pid_rate_roll, &_pid_rate_pitch, &_pid_rate_yaw }};
+
     AP_Float              _thr_mix_man;     // throttle vs attitude control prioritisation used when using manual throttle (higher values mean we prioritise attitude control over throttle)
     AP_Float              _thr_mix_min;     // throttle vs attitude control prioritisation used when landing (higher values mean we prioritise attitude control over throttle)
     AP_Float              _thr_mix_max;     // throttle vs attitude control prioritisation used during active flight (higher values mean we prioritise attitude control over throttle)
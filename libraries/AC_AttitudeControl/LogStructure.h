@@ -10,7 +10,8 @@
     LOG_PSOE_MSG, \
     LOG_PSOD_MSG, \
     LOG_PSOT_MSG, \
-    LOG_ANG_MSG
+    LOG_ANG_MSG, \
+    LOG_RTLT_MSG
 
 // @LoggerMessage: PSCN
 // @Description: Position Control North
@@ -175,6 +176,28 @@ struct PACKED log_ANG {
     float sensor_dt;
 };
 
+// @LoggerMessage: RTLT
+// @Description: Rate controller target latency, from the attitude controller publishing targets to the rate controller first using them
+// @Field: TimeUS: Time since system startup
+// @Field: N: number of targets used since the last message
+// @Field: LatAvg: average target latency
+// @Field: LatMin: minimum target latency
+// @Field: LatMax: maximum target latency
+// @Field: IntMin: minimum interval between targets
+// @Field: IntMax: maximum interval between targets
+// @Field: Fail: number of times a consistent copy of the targets could not be taken
+struct PACKED log_RTLT {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint16_t count;
+    uint32_t latency_avg_us;
+    uint32_t latency_min_us;
+    uint32_t latency_max_us;
+    uint32_t interval_min_us;
+    uint32_t interval_max_us;
+    uint16_t peek_fail;
+};
+
 #define PSCx_FMT "Qfffffffff"
 #define PSCx_UNITS "smmmnnnooo"
 #define PSCx_MULTS "F000000000"
@@ -201,4 +224,6 @@ struct PACKED log_ANG {
     { LOG_RATE_MSG, sizeof(log_Rate), \
         "RATE", "Qfffffffffffff",  "TimeUS,RDes,R,ROut,PDes,P,POut,YDes,Y,YOut,ADes,A,AOut,AOutSlew", "skk-kk-kk-oo--", "F?????????BB--" , true }, \
     { LOG_ANG_MSG, sizeof(log_ANG),\
-        "ANG", "Qfffffff", "TimeUS,DesRoll,Roll,DesPitch,Pitch,DesYaw,Yaw,Dt", "sddddhhs", "F0000000" , true }
+        "ANG", "Qfffffff", "TimeUS,DesRoll,Roll,DesPitch,Pitch,DesYaw,Yaw,Dt", "sddddhhs", "F0000000" , true }, \
+    { LOG_RTLT_MSG, sizeof(log_RTLT), \
+        "RTLT", "QHIIIIIH", "TimeUS,N,LatAvg,LatMin,LatMax,IntMin,IntMax,Fail", "s-sssss-", "F-FFFFF-" , true }
@@ -881,9 +881,20 @@ void AC_Avoid::adjust_velocity_inclusion_and_exclusion_polygons(float kP, float
         find_max_quadrant_velocity(backup_vel_inc, quad_1_back_vel, quad_2_back_vel, quad_3_back_vel, quad_4_back_vel);
     }
 
+    // position for skipping exclusion polygons out of reach
+    Vector2f position_xy;
+    const bool have_position = AP::ahrs().get_relative_position_NE_origin_float(position_xy);
+    position_xy *= 100.0f;  // m to cm
+
     // iterate through exclusion polygons
     const uint8_t num_exclusion_polygons = fence->polyfence().get_exclusion_polygon_count();
     for (uint8_t i = 0; i < num_exclusion_polygons; i++) {
+        Polygon_Bounds bounds;
+        if (have_position &&
+            fence->polyfence().get_exclusion_polygon_bounds(i, bounds) &&
+            polygon_out_of_reach(kP, accel_cmss, desired_vel_cms, position_xy, bounds, fence->get_margin(), dt)) {
+            continue;
+        }
         uint16_t num_points;
         const Vector2f* boundary = fence->polyfence().get_exclusion_polygon(i, num_points);
         Vector2f backup_vel_exc;
@@ -895,6 +906,34 @@ void AC_Avoid::adjust_velocity_inclusion_and_exclusion_polygons(float kP, float
     backup_vel = quad_1_back_vel + quad_2_back_vel + quad_3_back_vel + quad_4_back_vel;
 }
 
+/*
+ * Returns true if the vehicle is far enough from the bounds of an exclusion
+ * polygon that adjust_velocity_polygon() would not change the velocity or back away
+ */
+bool AC_Avoid::polygon_out_of_reach(float kP, float accel_cmss, const Vector2f &desired_vel_cms, const Vector2f &position_xy, const Polygon_Bounds &bounds, float margin, float dt) const
+{
+    // the distance to every edge is at least the distance to the bounds
+    const float distance_cm = bounds.distance(position_xy);
+    const float margin_cm = MAX(margin * 100.0f, 0.0f);
+    if (distance_cm <= margin_cm) {
+        // may need to back away
+        return false;
+    }
+    const float speed = desired_vel_cms.length();
+    if (is_zero(speed)) {
+        return true;
+    }
+    switch (_behavior) {
+    case BEHAVIOR_SLIDE:
+        // no edge limits the speed in its direction below the current speed
+        return get_max_speed(kP, accel_cmss, distance_cm - margin_cm, dt) >= speed;
+    case BEHAVIOR_STOP:
+        // the stopping point can't reach an edge
+        return distance_cm > 2.0f + margin_cm + get_stopping_distance(kP, accel_cmss, speed);
+    }
+    return false;
+}
+
 /*
  * Adjusts the desired velocity for the inclusion circles
  */
@@ -1205,7 +1244,7 @@ void AC_Avoid::adjust_velocity_proximity(float kP, float accel_cmss, Vector3f &d
 
     AP_Proximity &_proximity = *proximity;
     // get total number of obstacles
-    const uint8_t obstacle_num = _proximity.get_obstacle_count();
+    const uint16_t obstacle_num = _proximity.get_obstacle_count();
     if (obstacle_num == 0) {
         // no obstacles
         return;
@@ -1234,7 +1273,7 @@ void AC_Avoid::adjust_velocity_proximity(float kP, float accel_cmss, Vector3f &d
         stopping_point_plus_margin = safe_vel * ((2.0f + margin_cm + get_stopping_distance(kP, accel_cmss, speed))/speed);
     }
 
-    for (uint8_t i = 0; i<obstacle_num; i++) {
+    for (uint16_t i = 0; i<obstacle_num; i++) {
         // get obstacle from proximity library
         Vector3f vector_to_obstacle;
         if (!_proximity.get_obstacle(i, vector_to_obstacle)) {
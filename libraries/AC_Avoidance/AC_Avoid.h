@@ -155,6 +155,12 @@ private:
      */
     void adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &desired_vel_cms, Vector2f &backup_vel, const Vector2f* boundary, uint16_t num_points, float margin, float dt, bool stay_inside);
 
+    /*
+     * Returns true if an exclusion polygon with these bounds is too far away
+     * for adjust_velocity_polygon() to change the velocity
+     */
+    bool polygon_out_of_reach(float kP, float accel_cmss, const Vector2f &desired_vel_cms, const Vector2f &position_xy, const Polygon_Bounds &bounds, float margin, float dt) const;
+
     /*
      * Computes distance required to stop, given current speed.
      */
@@ -6,6 +6,7 @@
 #include "AC_Avoid.h"
 #include "AP_OADijkstra.h"
 #include "AP_OABendyRuler.h"
+#include "AP_OAPathPlanner.h"
 #include <AP_Logger/AP_Logger.h>
 #include <AP_AHRS/AP_AHRS.h>
 
@@ -78,6 +79,23 @@ void AP_OADijkstra::Write_Visgraph_point(const uint8_t version, const uint8_t po
 }
 #endif
 
+#if AP_OAPATHPLANNER_ENABLED
+void AP_OAPathPlanner::Write_OAPathPlanner(const OA_RetState result, const OAPathPlannerUsed planner_used, const bool new_request, const uint32_t run_time_us, const uint32_t latency_ms, const uint32_t stale_ms) const
+{
+    const struct log_OAPathPlanner pkt{
+        LOG_PACKET_HEADER_INIT(LOG_OA_PLANNER_MSG),
+        time_us         : AP_HAL::micros64(),
+        result          : uint8_t(result),
+        planner_used    : uint8_t(planner_used),
+        new_request     : new_request,
+        run_time_us     : run_time_us,
+        latency_ms      : latency_ms,
+        stale_ms        : stale_ms,
+    };
+    AP::logger().WriteBlock(&pkt, sizeof(pkt));
+}
+#endif
+
 #if AP_AVOIDANCE_ENABLED
 void AC_Avoid::Write_SimpleAvoidance(const uint8_t state, const Vector3f& desired_vel, const Vector3f& modified_vel, const bool back_up) const
 {
@@ -23,8 +23,18 @@
 #define AP_OAPATHPLANNER_DIJKSTRA_ENABLED AP_OAPATHPLANNER_BACKEND_DEFAULT_ENABLED
 #endif
 
+// reuse visibility graph edges unaffected by a fence change rather than rebuilding the whole graph
+#ifndef AP_OADIJKSTRA_VISGRAPH_REUSE_ENABLED
+#define AP_OADIJKSTRA_VISGRAPH_REUSE_ENABLED (AP_OAPATHPLANNER_DIJKSTRA_ENABLED && HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
+
 
 
 #ifndef AP_OADATABASE_ENABLED
 #define AP_OADATABASE_ENABLED AP_OAPATHPLANNER_ENABLED
 #endif
+
+// sparse voxel map of obstacles held by the OADatabase, sized at runtime by OA_DB_VOX_SIZE
+#ifndef AP_OAVOXELMAP_ENABLED
+#define AP_OAVOXELMAP_ENABLED (AP_OADATABASE_ENABLED && HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
@@ -137,6 +137,14 @@ bool AP_OABendyRuler::update(const Location& current_loc, const Location& destin
     return ret;
 }
 
+// bearing change (in degrees) from the destination of the k'th bearing tested
+// by search_xy_path, alternating left and right in increasing steps
+static float xy_bearing_delta(uint8_t k)
+{
+    const uint8_t i = (k + 1) / 2;
+    return i * OA_BENDYRULER_BEARING_INC_XY * ((k % 2 == 1) ? -1.0f : 1.0f);
+}
+
 // Search for path in the horizontal directions
 bool AP_OABendyRuler::search_xy_path(const Location& current_loc, const Location& destination, float ground_course_deg, Location &destination_new, float lookahead_step1_dist, float lookahead_step2_dist, float bearing_to_dest, float distance_to_dest, bool proximity_only) 
 {
@@ -151,70 +159,92 @@ bool AP_OABendyRuler::search_xy_path(const Location& current_loc, const Location
     float best_margin = -FLT_MAX;
     float best_margin_bearing = best_bearing;
 
-    for (uint8_t i = 0; i <= (170 / OA_BENDYRULER_BEARING_INC_XY); i++) {
-        for (uint8_t bdir = 0; bdir <= 1; bdir++) {
-            // skip duplicate check of bearing straight towards destination
-            if ((i==0) && (bdir > 0)) {
-                continue;
+    // bearings are tested alternating left and right of the destination in increasing steps.
+    // Their margins are calculated in batches in the order they are tested, except the bearing
+    // straight towards the destination which is checked on its own as it is usually clear
+    const uint8_t num_bearings = 1 + 2 * (170 / OA_BENDYRULER_BEARING_INC_XY);
+    Probes probes;
+    probes.count = 0;
+    uint8_t probe_idx = 0;
+    for (uint8_t k = 0; k < num_bearings; k++) {
+        // bearing that we are probing
+        const float bearing_test = wrap_180(bearing_to_dest + xy_bearing_delta(k));
+
+        // ToDo: add effective groundspeed calculations using airspeed
+        // ToDo: add prediction of vehicle's position change as part of turn to desired heading
+
+        // calculate margins from obstacles for the next batch of bearings
+        if (probe_idx >= probes.count) {
+            probes.init(current_loc);
+            const uint8_t batch_end = (k == 0) ? 1 : MIN(k + PROBES_MAX, num_bearings);
+            for (uint8_t b = k; b < batch_end; b++) {
+                // test location is projected from current location at test bearing
+                Location probe_loc = current_loc;
+                probe_loc.offset_bearing(wrap_180(bearing_to_dest + xy_bearing_delta(b)), lookahead_step1_dist);
+                probes.add(probe_loc);
             }
-            // bearing that we are probing
-            const float bearing_delta = i * OA_BENDYRULER_BEARING_INC_XY * (bdir == 0 ? -1.0f : 1.0f);
-            const float bearing_test = wrap_180(bearing_to_dest + bearing_delta);
-
-            // ToDo: add effective groundspeed calculations using airspeed
-            // ToDo: add prediction of vehicle's position change as part of turn to desired heading
-
-            // test location is projected from current location at test bearing
-            Location test_loc = current_loc;
-            test_loc.offset_bearing(bearing_test, lookahead_step1_dist);
+            calc_avoidance_margins(probes, proximity_only);
+            probe_idx = 0;
+        }
+        const Location &test_loc = probes.end[probe_idx];
+        const float margin = probes.margin[probe_idx];
+        probe_idx++;
 
-            // calculate margin from obstacles for this scenario
-            float margin = calc_avoidance_margin(current_loc, test_loc, proximity_only);
-            if (margin > best_margin) {
-                best_margin_bearing = bearing_test;
-                best_margin = margin;
+        if (margin > best_margin) {
+            best_margin_bearing = bearing_test;
+            best_margin = margin;
+        }
+        if (margin > _margin_max) {
+            // this bearing avoids obstacles out to the lookahead_step1_dist
+            // now check in there is a clear path in three directions towards the destination
+            if (!have_best_bearing) {
+                best_bearing = bearing_test;
+                best_bearing_margin = margin;
+                have_best_bearing = true;
+            } else if (fabsf(wrap_180(ground_course_deg - bearing_test)) <
+                       fabsf(wrap_180(ground_course_deg - best_bearing))) {
+                // replace bearing with one that is closer to our current ground course
+                best_bearing = bearing_test;
+                best_bearing_margin = margin;
             }
-            if (margin > _margin_max) {
-                // this bearing avoids obstacles out to the lookahead_step1_dist
-                // now check in there is a clear path in three directions towards the destination
-                if (!have_best_bearing) {
-                    best_bearing = bearing_test;
-                    best_bearing_margin = margin;
-                    have_best_bearing = true;
-                } else if (fabsf(wrap_180(ground_course_deg - bearing_test)) <
-                           fabsf(wrap_180(ground_course_deg - best_bearing))) {
-                    // replace bearing with one that is closer to our current ground course
-                    best_bearing = bearing_test;
-                    best_bearing_margin = margin;
-                }
-
-                // perform second stage test in three directions looking for obstacles
-                const float test_bearings[] { 0.0f, 45.0f, -45.0f };
-                const float bearing_to_dest2 = test_loc.get_bearing_to(destination) * 0.01f;
-                float distance2 = constrain_float(lookahead_step2_dist, OA_BENDYRULER_LOOKAHEAD_STEP2_MIN, test_loc.get_distance(destination));
-                for (uint8_t j = 0; j < ARRAY_SIZE(test_bearings); j++) {
-                    float bearing_test2 = wrap_180(bearing_to_dest2 + test_bearings[j]);
-                    Location test_loc2 = test_loc;
-                    test_loc2.offset_bearing(bearing_test2, distance2);
 
-                    // calculate minimum margin to fence and obstacles for this scenario
-                    float margin2 = calc_avoidance_margin(test_loc, test_loc2, proximity_only);
-                    if (margin2 > _margin_max) {
-                        // if the chosen direction is directly towards the destination avoidance can be turned off
-                        // i == 0 && j == 0 implies no deviation from bearing to destination 
-                        const bool active = (i != 0 || j != 0);
-                        float final_bearing = bearing_test;
-                        float final_margin = margin;
-                        // check if we need ignore test_bearing and continue on previous bearing
-                        const bool ignore_bearing_change = resist_bearing_change(destination, current_loc, active, bearing_test, lookahead_step1_dist, margin, _destination_prev,_bearing_prev, final_bearing, final_margin, proximity_only);
-
-                        // all good, now project in the chosen direction by the full distance
-                        destination_new = current_loc;
-                        destination_new.offset_bearing(final_bearing, MIN(distance_to_dest, lookahead_step1_dist));
-                        _current_lookahead = MIN(_lookahead, _current_lookahead * 1.1f);
-                        Write_OABendyRuler((uint8_t)OABendyType::OA_BENDY_HORIZONTAL, active, bearing_to_dest, 0.0f, ignore_bearing_change, final_margin, destination, destination_new);
-                        return active;
+            // perform second stage test in three directions looking for obstacles
+            // straight towards the destination is checked first on its own, then the other two together
+            const float test_bearings[] { 0.0f, 45.0f, -45.0f };
+            const float bearing_to_dest2 = test_loc.get_bearing_to(destination) * 0.01f;
+            float distance2 = constrain_float(lookahead_step2_dist, OA_BENDYRULER_LOOKAHEAD_STEP2_MIN, test_loc.get_distance(destination));
+            Probes probes2;
+            probes2.count = 0;
+            uint8_t probe2_idx = 0;
+            for (uint8_t j = 0; j < ARRAY_SIZE(test_bearings); j++) {
+                if (probe2_idx >= probes2.count) {
+                    probes2.init(test_loc);
+                    const uint8_t batch_end = (j == 0) ? 1 : ARRAY_SIZE(test_bearings);
+                    for (uint8_t b = j; b < batch_end; b++) {
+                        Location test_loc2 = test_loc;
+                        test_loc2.offset_bearing(wrap_180(bearing_to_dest2 + test_bearings[b]), distance2);
+                        probes2.add(test_loc2);
                     }
+                    // calculate minimum margin to fence and obstacles for these scenarios
+                    calc_avoidance_margins(probes2, proximity_only);
+                    probe2_idx = 0;
+                }
+                const float margin2 = probes2.margin[probe2_idx++];
+                if (margin2 > _margin_max) {
+                    // if the chosen direction is directly towards the destination avoidance can be turned off
+                    // k == 0 && j == 0 implies no deviation from bearing to destination
+                    const bool active = (k != 0 || j != 0);
+                    float final_bearing = bearing_test;
+                    float final_margin = margin;
+                    // check if we need ignore test_bearing and continue on previous bearing
+                    const bool ignore_bearing_change = resist_bearing_change(destination, current_loc, active, bearing_test, lookahead_step1_dist, margin, _destination_prev,_bearing_prev, final_bearing, final_margin, proximity_only);
+
+                    // all good, now project in the chosen direction by the full distance
+                    destination_new = current_loc;
+                    destination_new.offset_bearing(final_bearing, MIN(distance_to_dest, lookahead_step1_dist));
+                    _current_lookahead = MIN(_lookahead, _current_lookahead * 1.1f);
+                    Write_OABendyRuler((uint8_t)OABendyType::OA_BENDY_HORIZONTAL, active, bearing_to_dest, 0.0f, ignore_bearing_change, final_margin, destination, destination_new);
+                    return active;
                 }
             }
         }
@@ -416,235 +446,273 @@ bool AP_OABendyRuler::resist_bearing_change(const Location &destination, const L
     return resisted_change;
 }
 
+// remove all probes and set their common start
+void AP_OABendyRuler::Probes::init(const Location &start_loc)
+{
+    start = start_loc;
+    count = 0;
+
+    // offsets from the EKF origin used by the fence polygons, circles and object database
+    have_NE = start.get_vector_xy_from_origin_NE_cm(start_NE);
+    fan_NE.init(Vector3f(start_NE.x * 0.01f, start_NE.y * 0.01f, 0.0f));
+    Vector3f start_NEU;
+    have_NEU = start.get_vector_from_origin_NEU_cm(start_NEU);
+    fan_NEU.init(start_NEU * 0.01f);
+}
+
+// add probe from start to end_loc, returns false if full
+bool AP_OABendyRuler::Probes::add(const Location &end_loc)
+{
+    if (count >= PROBES_MAX) {
+        return false;
+    }
+    end[count] = end_loc;
+    margin[count] = FLT_MAX;
+
+    have_NE = have_NE && end_loc.get_vector_xy_from_origin_NE_cm(end_NE[count]);
+    if (have_NE) {
+        fan_NE.add(Vector3f(end_NE[count].x * 0.01f, end_NE[count].y * 0.01f, 0.0f));
+    }
+    Vector3f end_NEU;
+    have_NEU = have_NEU && end_loc.get_vector_from_origin_NEU_cm(end_NEU);
+    if (have_NEU) {
+        fan_NEU.add(end_NEU * 0.01f);
+    }
+
+    count++;
+    return true;
+}
+
 // calculate minimum distance between a segment and any obstacle
 float AP_OABendyRuler::calc_avoidance_margin(const Location &start, const Location &end, bool proximity_only) const
 {
-    float margin_min = FLT_MAX;
+    Probes probes;
+    probes.init(start);
+    probes.add(end);
+    calc_avoidance_margins(probes, proximity_only);
+    return probes.margin[0];
+}
 
-    float latest_margin;
-    
-    if (calc_margin_from_object_database(start, end, latest_margin)) {
-        margin_min = MIN(margin_min, latest_margin);
+// calculate minimum distance between each probe and any obstacle
+void AP_OABendyRuler::calc_avoidance_margins(Probes &probes, bool proximity_only) const
+{
+    for (uint8_t i = 0; i < probes.count; i++) {
+        probes.margin[i] = FLT_MAX;
     }
-    
+
+    calc_margins_from_object_database(probes);
+
     if (proximity_only) {
         // only need margin from proximity data
-        return margin_min;
-    }
-    
-    if (calc_margin_from_circular_fence(start, end, latest_margin)) {
-        margin_min = MIN(margin_min, latest_margin);
+        return;
     }
-    
+
+    calc_margins_from_circular_fence(probes);
+
     #if VERTICAL_ENABLED 
     // alt fence only is only needed in vertical avoidance
     if (get_type() == OABendyType::OA_BENDY_VERTICAL) {
-        if (calc_margin_from_alt_fence(start, end, latest_margin)) {
-            margin_min = MIN(margin_min, latest_margin);
-        }
+        calc_margins_from_alt_fence(probes);
     }
     #endif
 
-    if (calc_margin_from_inclusion_and_exclusion_polygons(start, end, latest_margin)) {
-        margin_min = MIN(margin_min, latest_margin);
-    }
-
-    if (calc_margin_from_inclusion_and_exclusion_circles(start, end, latest_margin)) {
-        margin_min = MIN(margin_min, latest_margin);
-    }
+    calc_margins_from_inclusion_and_exclusion_polygons(probes);
 
-    // return smallest margin from any obstacle
-    return margin_min;
+    calc_margins_from_inclusion_and_exclusion_circles(probes);
 }
 
-// calculate minimum distance between a path and the circular fence (centered on home)
-// on success returns true and updates margin
-bool AP_OABendyRuler::calc_margin_from_circular_fence(const Location &start, const Location &end, float &margin) const
+// reduce each probe's margin to its minimum distance from the circular fence (centered on home)
+void AP_OABendyRuler::calc_margins_from_circular_fence(Probes &probes) const
 {
 #if AP_FENCE_ENABLED
     // exit immediately if polygon fence is not enabled
     const AC_Fence *fence = AC_Fence::get_singleton();
     if (fence == nullptr) {
-        return false;
+        return;
     }
     if ((fence->get_enabled_fences() & AC_FENCE_TYPE_CIRCLE) == 0) {
-        return false;
+        return;
     }
 
-    // calculate start and end point's distance from home
+    // calculate start point's distance from home
     const Location &ahrs_home = AP::ahrs().get_home();
-    const float start_dist_sq = ahrs_home.get_distance_NE(start).length_squared();
-    const float end_dist_sq = ahrs_home.get_distance_NE(end).length_squared();
+    const float start_dist_sq = ahrs_home.get_distance_NE(probes.start).length_squared();
 
     // get circular fence radius + margin
     const float fence_radius_plus_margin = fence->get_radius() - fence->get_margin();
 
-    // margin is fence radius minus the longer of start or end distance
-    margin = fence_radius_plus_margin - sqrtf(MAX(start_dist_sq, end_dist_sq));
-    return true;
-#else
-    return false;
+    for (uint8_t i = 0; i < probes.count; i++) {
+        // margin is fence radius minus the longer of start or end distance
+        const float end_dist_sq = ahrs_home.get_distance_NE(probes.end[i]).length_squared();
+        const float margin = fence_radius_plus_margin - sqrtf(MAX(start_dist_sq, end_dist_sq));
+        probes.margin[i] = MIN(probes.margin[i], margin);
+    }
 #endif // AP_FENCE_ENABLED
 }
 
-// calculate minimum distance between a path and the altitude fence
-// on success returns true and updates margin
-bool AP_OABendyRuler::calc_margin_from_alt_fence(const Location &start, const Location &end, float &margin) const
+// reduce each probe's margin to its minimum distance from the altitude fence
+void AP_OABendyRuler::calc_margins_from_alt_fence(Probes &probes) const
 {
 #if AP_FENCE_ENABLED
     // exit immediately if polygon fence is not enabled
     const AC_Fence *fence = AC_Fence::get_singleton();
     if (fence == nullptr) {
-        return false;
+        return;
     }
     if ((fence->get_enabled_fences() & AC_FENCE_TYPE_ALT_MAX) == 0) {
-        return false;
+        return;
     }
 
-    int32_t alt_above_home_cm_start, alt_above_home_cm_end;    
-    if (!start.get_alt_cm(Location::AltFrame::ABOVE_HOME, alt_above_home_cm_start)) {
-        return false;
-    }
-    if (!end.get_alt_cm(Location::AltFrame::ABOVE_HOME, alt_above_home_cm_end )) {
-        return false;
+    int32_t alt_above_home_cm_start;
+    if (!probes.start.get_alt_cm(Location::AltFrame::ABOVE_HOME, alt_above_home_cm_start)) {
+        return;
     }
 
     // safe max alt = fence alt - fence margin
     const float max_fence_alt = fence->get_safe_alt_max();
     const float margin_start =  max_fence_alt - alt_above_home_cm_start * 0.01f;
-    const float margin_end =  max_fence_alt - alt_above_home_cm_end * 0.01f;
 
-    // margin is minimum distance to fence from either start or end location
-    margin = MIN(margin_start,margin_end);
+    for (uint8_t i = 0; i < probes.count; i++) {
+        int32_t alt_above_home_cm_end;
+        if (!probes.end[i].get_alt_cm(Location::AltFrame::ABOVE_HOME, alt_above_home_cm_end)) {
+            continue;
+        }
+        const float margin_end =  max_fence_alt - alt_above_home_cm_end * 0.01f;
 
-    return true;
-#else
-    return false;
+        // margin is minimum distance to fence from either start or end location
+        probes.margin[i] = MIN(probes.margin[i], MIN(margin_start, margin_end));
+    }
 #endif // AP_FENCE_ENABLED
 }
 
-// calculate minimum distance between a path and all inclusion and exclusion polygons
-// on success returns true and updates margin
-bool AP_OABendyRuler::calc_margin_from_inclusion_and_exclusion_polygons(const Location &start, const Location &end, float &margin) const
+// reduce each probe's margin to its minimum distance from all inclusion and exclusion polygons
+void AP_OABendyRuler::calc_margins_from_inclusion_and_exclusion_polygons(Probes &probes) const
 {
 #if AP_FENCE_ENABLED
     const AC_Fence *fence = AC_Fence::get_singleton();
     if (fence == nullptr) {
-        return false;
+        return;
     }
 
     // exclusion polygons enabled along with polygon fences
     if ((fence->get_enabled_fences() & AC_FENCE_TYPE_POLYGON) == 0) {
-        return false;
+        return;
     }
 
     // return immediately if no inclusion nor exclusion polygons
     const uint8_t num_inclusion_polygons = fence->polyfence().get_inclusion_polygon_count();
     const uint8_t num_exclusion_polygons = fence->polyfence().get_exclusion_polygon_count();
     if ((num_inclusion_polygons == 0) && (num_exclusion_polygons == 0)) {
-        return false;
+        return;
     }
 
-    // convert start and end to offsets from EKF origin
-    Vector2f start_NE, end_NE;
-    if (!start.get_vector_xy_from_origin_NE_cm(start_NE) ||
-        !end.get_vector_xy_from_origin_NE_cm(end_NE)) {
-        return false;
+    // start and ends must be known as offsets from EKF origin
+    if (!probes.have_NE) {
+        return;
     }
 
     // get fence margin
     const float fence_margin = fence->get_margin();
 
     // iterate through inclusion polygons and calculate minimum margin
-    bool margin_updated = false;
     for (uint8_t i = 0; i < num_inclusion_polygons; i++) {
         uint16_t num_points;
         const Vector2f* boundary = fence->polyfence().get_inclusion_polygon(i, num_points);
      
         // if outside the fence margin is the closest distance but with negative sign
-        const float sign = Polygon_outside(start_NE, boundary, num_points) ? -1.0f : 1.0f;
+        const float sign = Polygon_outside(probes.start_NE, boundary, num_points) ? -1.0f : 1.0f;
 
         // calculate min distance (in meters) from line to polygon
-        float margin_new = (sign * Polygon_closest_distance_line(boundary, num_points, start_NE, end_NE) * 0.01f) - fence_margin;
-        if (!margin_updated || (margin_new < margin)) {
-            margin_updated = true;
-            margin = margin_new;
+        for (uint8_t p = 0; p < probes.count; p++) {
+            const float margin_new = (sign * Polygon_closest_distance_line(boundary, num_points, probes.start_NE, probes.end_NE[p]) * 0.01f) - fence_margin;
+            probes.margin[p] = MIN(probes.margin[p], margin_new);
         }
     }
 
+    // bounds of each probe, to skip polygons too far away to reduce its margin
+    Polygon_Bounds path_bounds[PROBES_MAX];
+    for (uint8_t p = 0; p < probes.count; p++) {
+        const Vector2f path[] {probes.start_NE, probes.end_NE[p]};
+        Polygon_bounds(path, ARRAY_SIZE(path), path_bounds[p]);
+    }
+
     // iterate through exclusion polygons and calculate minimum margin
     for (uint8_t i = 0; i < num_exclusion_polygons; i++) {
+        Polygon_Bounds bounds;
+        const bool have_bounds = fence->polyfence().get_exclusion_polygon_bounds(i, bounds);
         uint16_t num_points;
         const Vector2f* boundary = fence->polyfence().get_exclusion_polygon(i, num_points);
-   
-        // if start is inside the polygon the margin's sign is reversed
-        const float sign = Polygon_outside(start_NE, boundary, num_points) ? 1.0f : -1.0f;
+        bool have_sign = false;
+        float sign = 1.0f;
+        for (uint8_t p = 0; p < probes.count; p++) {
+            if (have_bounds) {
+                // the path can't come closer to the polygon than to its
+                // bounds, and if it is outside the bounds it is outside
+                // the polygon
+                const float bounds_distance = bounds.distance(path_bounds[p]);
+                if (is_positive(bounds_distance) && (bounds_distance * 0.01f) - fence_margin >= probes.margin[p]) {
+                    continue;
+                }
+            }
 
-        // calculate min distance (in meters) from line to polygon
-        float margin_new = (sign * Polygon_closest_distance_line(boundary, num_points, start_NE, end_NE) * 0.01f) - fence_margin;
-        if (!margin_updated || (margin_new < margin)) {
-            margin_updated = true;
-            margin = margin_new;
+            // if start is inside the polygon the margin's sign is reversed
+            if (!have_sign) {
+                sign = Polygon_outside(probes.start_NE, boundary, num_points) ? 1.0f : -1.0f;
+                have_sign = true;
+            }
+
+            // calculate min distance (in meters) from line to polygon
+            const float margin_new = (sign * Polygon_closest_distance_line(boundary, num_points, probes.start_NE, probes.end_NE[p]) * 0.01f) - fence_margin;
+            probes.margin[p] = MIN(probes.margin[p], margin_new);
         }
     }
-
-    return margin_updated;
-#else
-    return false;
 #endif // AP_FENCE_ENABLED
 }
 
-// calculate minimum distance between a path and all inclusion and exclusion circles
-// on success returns true and updates margin
-bool AP_OABendyRuler::calc_margin_from_inclusion_and_exclusion_circles(const Location &start, const Location &end, float &margin) const
+// reduce each probe's margin to its minimum distance from all inclusion and exclusion circles
+void AP_OABendyRuler::calc_margins_from_inclusion_and_exclusion_circles(Probes &probes) const
 {
 #if AP_FENCE_ENABLED
     // exit immediately if fence is not enabled
     const AC_Fence *fence = AC_Fence::get_singleton();
     if (fence == nullptr) {
-        return false;
+        return;
     }
 
     // inclusion/exclusion circles enabled along with polygon fences
     if ((fence->get_enabled_fences() & AC_FENCE_TYPE_POLYGON) == 0) {
-        return false;
+        return;
     }
 
     // return immediately if no inclusion nor exclusion circles
     const uint8_t num_inclusion_circles = fence->polyfence().get_inclusion_circle_count();
     const uint8_t num_exclusion_circles = fence->polyfence().get_exclusion_circle_count();
     if ((num_inclusion_circles == 0) && (num_exclusion_circles == 0)) {
-        return false;
+        return;
     }
 
-    // convert start and end to offsets from EKF origin
-    Vector2f start_NE, end_NE;
-    if (!start.get_vector_xy_from_origin_NE_cm(start_NE) ||
-        !end.get_vector_xy_from_origin_NE_cm(end_NE)) {
-        return false;
+    // start and ends must be known as offsets from EKF origin
+    if (!probes.have_NE) {
+        return;
     }
 
     // get fence margin
     const float fence_margin = fence->get_margin();
 
     // iterate through inclusion circles and calculate minimum margin
-    bool margin_updated = false;
     for (uint8_t i = 0; i < num_inclusion_circles; i++) {
         Vector2f center_pos_cm;
         float radius;
         if (fence->polyfence().get_inclusion_circle(i, center_pos_cm, radius)) {
 
             // calculate start and ends distance from the center of the circle
-            const float start_dist_sq = (start_NE - center_pos_cm).length_squared();
-            const float end_dist_sq = (end_NE - center_pos_cm).length_squared();
-
-            // margin is fence radius minus the longer of start or end distance
-            const float margin_new = (radius + fence_margin) - (sqrtf(MAX(start_dist_sq, end_dist_sq)) * 0.01f);
+            const float start_dist_sq = (probes.start_NE - center_pos_cm).length_squared();
+            for (uint8_t p = 0; p < probes.count; p++) {
+                const float end_dist_sq = (probes.end_NE[p] - center_pos_cm).length_squared();
 
-            // update margin with lowest value so far
-            if (!margin_updated || (margin_new < margin)) {
-                margin_updated = true;
-                margin = margin_new;
+                // margin is fence radius minus the longer of start or end distance
+                const float margin_new = (radius + fence_margin) - (sqrtf(MAX(start_dist_sq, end_dist_sq)) * 0.01f);
+                probes.margin[p] = MIN(probes.margin[p], margin_new);
             }
         }
     }
@@ -654,66 +722,36 @@ bool AP_OABendyRuler::calc_margin_from_inclusion_and_exclusion_circles(const Loc
         Vector2f center_pos_cm;
         float radius;
         if (fence->polyfence().get_exclusion_circle(i, center_pos_cm, radius)) {
-
-            // first calculate distance between circle's center and segment
-            const float dist_cm = Vector2f::closest_distance_between_line_and_point(start_NE, end_NE, center_pos_cm);
-
-            // margin is distance to the center minus the radius
-            const float margin_new = (dist_cm * 0.01f) - (radius + fence_margin);
-
-            // update margin with lowest value so far
-            if (!margin_updated || (margin_new < margin)) {
-                margin_updated = true;
-                margin = margin_new;
-            }
+            // margin is distance between circle's center and each probe minus the radius
+            const Vector3f center_pos {center_pos_cm.x * 0.01f, center_pos_cm.y * 0.01f, 0.0f};
+            probes.fan_NE.update_margins(center_pos, radius + fence_margin, probes.margin);
         }
     }
-
-    return margin_updated;
-#else
-    return false;
 #endif // AP_FENCE_ENABLED
 }
 
-// calculate minimum distance between a path and proximity sensor obstacles
-// on success returns true and updates margin
-bool AP_OABendyRuler::calc_margin_from_object_database(const Location &start, const Location &end, float &margin) const
+// reduce each probe's margin to its minimum distance from proximity sensor obstacles
+void AP_OABendyRuler::calc_margins_from_object_database(Probes &probes) const
 {
     // exit immediately if db is empty
     AP_OADatabase *oaDb = AP::oadatabase();
     if (oaDb == nullptr || !oaDb->healthy()) {
-        return false;
+        return;
     }
 
-    // convert start and end to offsets (in cm) from EKF origin
-    Vector3f start_NEU,end_NEU;
-    if (!start.get_vector_from_origin_NEU_cm(start_NEU) ||
-        !end.get_vector_from_origin_NEU_cm(end_NEU)) {
-        return false;
-    }
-    if (start_NEU == end_NEU) {
-        return false;
+    // start and ends must be known as offsets from EKF origin
+    if (!probes.have_NEU) {
+        return;
     }
 
-    // check each obstacle's distance from segment
-    float smallest_margin = FLT_MAX;
-    for (uint16_t i=0; i<oaDb->database_count(); i++) {
-        const AP_OADatabase::OA_DbItem& item = oaDb->get_item(i);
-        const Vector3f point_cm = item.pos * 100.0f;
-        // margin is distance between line segment and obstacle minus obstacle's radius
-        const float m = Vector3f::closest_distance_between_line_and_point(start_NEU, end_NEU, point_cm) * 0.01f - item.radius;
-        if (m < smallest_margin) {
-            smallest_margin = m;
-        }
+    // margin is distance between probe and closest obstacle minus obstacle's radius
+    float margins[PROBES_MAX];
+    if (!oaDb->get_closest_margins(probes.fan_NEU, margins)) {
+        return;
     }
-
-    // return smallest margin
-    if (smallest_margin < FLT_MAX) {
-        margin = smallest_margin;
-        return true;
+    for (uint8_t p = 0; p < probes.count; p++) {
+        probes.margin[p] = MIN(probes.margin[p], margins[p]);
     }
-
-    return false;
 }
 
 #endif  // AP_OAPATHPLANNER_BENDYRULER_ENABLED
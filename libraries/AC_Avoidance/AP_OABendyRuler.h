@@ -7,6 +7,7 @@
 #include <AP_Common/AP_Common.h>
 #include <AP_Common/Location.h>
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/segment_fan.h>
 #include <AP_Logger/AP_Logger_config.h>
 
 /*
@@ -45,31 +46,53 @@ private:
     // search for path in the Vertical directions
     bool search_vertical_path(const Location &current_loc, const Location &destination, Location &destination_new, float lookahead_step1_dist, float lookahead_step2_dist, float bearing_to_dest, float distance_to_dest, bool proximity_only);
 
+    // maximum number of probes whose margins are calculated together
+    static constexpr uint8_t PROBES_MAX = SegmentFan::MAX_SEGMENTS;
+
+    // paths (probes) from a common start whose minimum distances from obstacles are calculated together,
+    // so each obstacle is fetched and prepared once and then checked against all the probes
+    struct Probes {
+        // remove all probes and set their common start
+        void init(const Location &start_loc);
+
+        // add probe from start to end_loc, returns false if full
+        bool add(const Location &end_loc);
+
+        Location start;                 // common start of probes
+        Location end[PROBES_MAX];       // end of each probe
+        uint8_t count;                  // number of probes
+        float margin[PROBES_MAX];       // minimum distance (in meters) between each probe and any obstacle, FLT_MAX if none
+        bool have_NE;                   // true if start_NE, end_NE and fan_NE are valid
+        Vector2f start_NE;              // start as an offset (in cm) from the EKF origin
+        Vector2f end_NE[PROBES_MAX];    // ends as offsets (in cm) from the EKF origin
+        SegmentFan fan_NE;              // probes as offsets in meters from the EKF origin, with zero altitude
+        bool have_NEU;                  // true if fan_NEU is valid
+        SegmentFan fan_NEU;             // probes as offsets in meters from the EKF origin, with altitude
+    };
+
     // calculate minimum distance between a path and any obstacle
     float calc_avoidance_margin(const Location &start, const Location &end, bool proximity_only) const;
 
+    // calculate minimum distance between each probe and any obstacle
+    void calc_avoidance_margins(Probes &probes, bool proximity_only) const;
+
     // determine if BendyRuler should accept the new bearing or try and resist it. Returns true if bearing is not changed  
     bool resist_bearing_change(const Location &destination, const Location &current_loc, bool active, float bearing_test, float lookahead_step1_dist, float margin, Location &prev_dest, float &prev_bearing, float &final_bearing, float &final_margin, bool proximity_only) const;    
 
-    // calculate minimum distance between a path and the circular fence (centered on home)
-    // on success returns true and updates margin
-    bool calc_margin_from_circular_fence(const Location &start, const Location &end, float &margin) const;
+    // reduce each probe's margin to its minimum distance from the circular fence (centered on home)
+    void calc_margins_from_circular_fence(Probes &probes) const;
 
-    // calculate minimum distance between a path and the altitude fence
-    // on success returns true and updates margin
-    bool calc_margin_from_alt_fence(const Location &start, const Location &end, float &margin) const;
+    // reduce each probe's margin to its minimum distance from the altitude fence
+    void calc_margins_from_alt_fence(Probes &probes) const;
 
-    // calculate minimum distance between a path and all inclusion and exclusion polygons
-    // on success returns true and updates margin
-    bool calc_margin_from_inclusion_and_exclusion_polygons(const Location &start, const Location &end, float &margin) const;
+    // reduce each probe's margin to its minimum distance from all inclusion and exclusion polygons
+    void calc_margins_from_inclusion_and_exclusion_polygons(Probes &probes) const;
 
-    // calculate minimum distance between a path and all inclusion and exclusion circles
-    // on success returns true and updates margin
-    bool calc_margin_from_inclusion_and_exclusion_circles(const Location &start, const Location &end, float &margin) const;
+    // reduce each probe's margin to its minimum distance from all inclusion and exclusion circles
+    void calc_margins_from_inclusion_and_exclusion_circles(Probes &probes) const;
 
-    // calculate minimum distance between a path and proximity sensor obstacles
-    // on success returns true and updates margin
-    bool calc_margin_from_object_database(const Location &start, const Location &end, float &margin) const;
+    // reduce each probe's margin to its minimum distance from proximity sensor obstacles
+    void calc_margins_from_object_database(Probes &probes) const;
 
     // Logging function
 #if HAL_LOGGING_ENABLED
@@ -40,6 +40,12 @@ extern const AP_HAL::HAL& hal;
     #define AP_OADATABASE_DISTANCE_FROM_HOME 3
 #endif
 
+#ifndef AP_OADATABASE_GRID_CELL_SIZE
+    #define AP_OADATABASE_GRID_CELL_SIZE 2.0f   // size (in meters) of each cube of the spatial index
+#endif
+
+#define AP_OADATABASE_GRID_NONE UINT16_MAX      // index used to mark the end of a grid bucket's list
+
 const AP_Param::GroupInfo AP_OADatabase::var_info[] = {
 
     // @Param: SIZE
@@ -107,6 +113,26 @@ const AP_Param::GroupInfo AP_OADatabase::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO_FRAME("ALT_MIN", 8, AP_OADatabase, _min_alt, 0.0f, AP_PARAM_FRAME_COPTER | AP_PARAM_FRAME_HELI | AP_PARAM_FRAME_TRICOPTER),
 
+#if AP_OAVOXELMAP_ENABLED
+    // @Param: VOX_SIZE
+    // @DisplayName: OADatabase voxel map maximum number of voxels
+    // @Description: Maximum number of voxels (cubes of space) in the voxel map which remembers obstacles seen by proximity sensors until they are seen to be gone. Each voxel uses 8 bytes of RAM plus a third for spare space. Set to 0 to disable the voxel map.
+    // @Range: 0 20000
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("VOX_SIZE", 9, AP_OADatabase, _voxel_map_size_param, 0),
+
+    // @Param: VOX_RES
+    // @DisplayName: OADatabase voxel map resolution
+    // @Description: Length of each side of the voxels in the voxel map. Smaller voxels give a more detailed map but fill the map more quickly
+    // @Units: m
+    // @Range: 0.1 5
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("VOX_RES", 10, AP_OADatabase, _voxel_map_resolution, 0.5f),
+#endif
+
+
     AP_GROUPEND
 };
 
@@ -135,8 +161,18 @@ void AP_OADatabase::init()
         GCS_SEND_TEXT(MAV_SEVERITY_INFO, "DB init failed . Sizes queue:%u, db:%u", (unsigned int)_queue.size, (unsigned int)_database.size);
         delete _queue.items;
         delete[] _database.items;
+        delete[] _grid.head;
+        delete[] _grid.next;
+        _grid.head = nullptr;
+        _grid.next = nullptr;
         return;
     }
+
+#if AP_OAVOXELMAP_ENABLED
+    if ((_voxel_map_size_param > 0) && !_voxel_map.init(_voxel_map_size_param, _voxel_map_resolution, _queue.size)) {
+        GCS_SEND_TEXT(MAV_SEVERITY_INFO, "DB voxel map init failed. Size:%u", (unsigned int)_voxel_map_size_param);
+    }
+#endif
 }
 
 void AP_OADatabase::update()
@@ -147,6 +183,9 @@ void AP_OADatabase::update()
 
     process_queue();
     database_items_remove_all_expired();
+#if AP_OAVOXELMAP_ENABLED
+    _voxel_map.update();
+#endif
 }
 
 // Push an object into the database. Pos is the offset in meters from the EKF origin, measurement timestamp in ms, distance in meters
@@ -159,44 +198,64 @@ void AP_OADatabase::queue_push(const Vector3f &pos, const uint32_t timestamp_ms,
 // Push an object into the database. Pos is the offset in meters from the EKF origin, measurement timestamp in ms, distance in meters, radius in meters
 void AP_OADatabase::queue_push(const Vector3f &pos, const uint32_t timestamp_ms, const float distance, float radius, const OA_DbItem::Source source, const uint32_t id)
 {
-    if (!healthy()) {
+    if (!healthy() || !vehicle_pos_allows_push()) {
+        return;
+    }
+
+    // Apply min radius parameter
+    radius = MAX(_radius_min, radius);
+
+    // ignore objects that outside of the max distance
+    if (is_positive(_dist_max)) {
+        const float closest_point = distance - radius;
+        if (closest_point > _dist_max) {
+            return;
+        }
+    }
+
+    const OA_DbItem item = {pos, timestamp_ms, radius, id, 0, AP_OADatabase::OA_DbItemImportance::Normal, source};
+    _queue.items->push(item);
+}
+
+// Push a range sensor reading of an object at pos from a sensor at origin into the voxel map.
+// Positions are offsets in meters from the EKF origin (NEU), distance in meters
+void AP_OADatabase::queue_push_ray(const Vector3f &origin, const Vector3f &pos, const float distance)
+{
+#if AP_OAVOXELMAP_ENABLED
+    if (!healthy() || !_voxel_map.healthy() || !vehicle_pos_allows_push()) {
         return;
     }
 
+    // ignore objects that outside of the max distance
+    if (is_positive(_dist_max) && (distance > _dist_max)) {
+        return;
+    }
+
+    _voxel_map.queue_ray(origin, pos);
+#endif
+}
+
+// returns false if objects should not be stored because the vehicle is low and near home
+bool AP_OADatabase::vehicle_pos_allows_push() const
+{
     // check if this obstacle needs to be rejected from DB because of low altitude near home
 #if APM_BUILD_COPTER_OR_HELI
     if (!is_zero(_min_alt)) { 
         Vector3f current_pos;
         if (!AP::ahrs().get_relative_position_NED_home(current_pos)) {
             // we do not know where the vehicle is
-            return;
+            return false;
         }
         if (current_pos.xy().length() < AP_OADATABASE_DISTANCE_FROM_HOME) {
             // vehicle is within a small radius of home 
             if (-current_pos.z < _min_alt) {
                 // vehicle is below the minimum alt
-                return;
+                return false;
             }
         }
     }
 #endif
-
-    // Apply min radius parameter
-    radius = MAX(_radius_min, radius);
-
-    // ignore objects that outside of the max distance
-    if (is_positive(_dist_max)) {
-        const float closest_point = distance - radius;
-        if (closest_point > _dist_max) {
-            return;
-        }
-    }
-
-    const OA_DbItem item = {pos, timestamp_ms, radius, id, 0, AP_OADatabase::OA_DbItemImportance::Normal, source};
-    {
-        WITH_SEMAPHORE(_queue.sem);
-        _queue.items->push(item);
-    }
+    return true;
 }
 
 void AP_OADatabase::init_queue()
@@ -206,7 +265,7 @@ void AP_OADatabase::init_queue()
         return;
     }
 
-    _queue.items = NEW_NOTHROW ObjectBuffer<OA_DbItem>(_queue.size);
+    _queue.items = NEW_NOTHROW ObjectBuffer_SPSC<OA_DbItem>(_queue.size);
     if (_queue.items != nullptr && _queue.items->get_size() == 0) {
         // allocation failed
         delete _queue.items;
@@ -222,6 +281,26 @@ void AP_OADatabase::init_database()
     }
 
     _database.items = NEW_NOTHROW OA_DbItem[_database.size];
+
+    // spatial index with at least one bucket per item, the database is
+    // searched linearly if this can't be allocated
+    uint32_t num_buckets = 1;
+    while (num_buckets < _database.size) {
+        num_buckets <<= 1;
+    }
+    _grid.head = NEW_NOTHROW uint16_t[num_buckets];
+    _grid.next = NEW_NOTHROW uint16_t[_database.size];
+    if ((_grid.head == nullptr) || (_grid.next == nullptr)) {
+        delete[] _grid.head;
+        delete[] _grid.next;
+        _grid.head = nullptr;
+        _grid.next = nullptr;
+        return;
+    }
+    for (uint32_t i=0; i<num_buckets; i++) {
+        _grid.head[i] = AP_OADATABASE_GRID_NONE;
+    }
+    _grid.mask = num_buckets - 1;
 }
 
 // get bitmask of gcs channels item should be sent to based on its importance
@@ -291,42 +370,226 @@ bool AP_OADatabase::process_queue()
 
     for (uint16_t queue_index=0; queue_index<queue_available; queue_index++) {
         OA_DbItem item;
-
-        bool pop_success;
-        {
-            WITH_SEMAPHORE(_queue.sem);
-            pop_success = _queue.items->pop(item);
-        }
-        if (!pop_success) {
+        if (!_queue.items->pop(item)) {
             return false;
         }
 
         item.send_to_gcs = get_send_to_gcs_flags(item.importance);
 
-        // compare item to all items in database. If found a similar item, update the existing, else add it as a new one
-        bool found = false;
-        for (uint16_t i=0; i<_database.count; i++) {
-            if (item_match(_database.items[i], item)) {
-                database_item_refresh(_database.items[i], item);
-                found = true;
-                break;
+        // find a similar item in the database. If found update the existing, else add it as a new one
+        const int32_t i = database_item_find(item);
+        if (i >= 0) {
+            OA_DbItem &current_item = _database.items[i];
+            const Vector3f pos_prev = current_item.pos;
+            database_item_refresh(current_item, item);
+            if (current_item.pos != pos_prev) {
+                // move item to its new grid cell
+                const Vector3f pos_new = current_item.pos;
+                current_item.pos = pos_prev;
+                grid_remove(i);
+                current_item.pos = pos_new;
+                grid_insert(i);
             }
-        }
-
-        if (!found) {
+            if (current_item.source == OA_DbItem::Source::proximity) {
+                _database.max_proximity_radius = MAX(_database.max_proximity_radius, current_item.radius);
+            }
+            _database.max_radius = MAX(_database.max_radius, current_item.radius);
+        } else {
             database_item_add(item);
         }
     }
     return (_queue.items->available() > 0);
 }
 
+// find an item in the database likely to be the same as item
+// returns its index or -1 if there is no match
+int32_t AP_OADatabase::database_item_find(const OA_DbItem &item) const
+{
+    // proximity items can only match items whose center is within the larger of their radii,
+    // so only the grid cells around the item need to be checked
+    if (item.source == OA_DbItem::Source::proximity) {
+        const float radius = MAX(item.radius, _database.max_proximity_radius);
+        const Vector3f min = item.pos - Vector3f(radius, radius, radius);
+        const Vector3f max = item.pos + Vector3f(radius, radius, radius);
+        if (grid_box_usable(min, max)) {
+            for (int32_t x=grid_cell(min.x); x<=grid_cell(max.x); x++) {
+                for (int32_t y=grid_cell(min.y); y<=grid_cell(max.y); y++) {
+                    for (int32_t z=grid_cell(min.z); z<=grid_cell(max.z); z++) {
+                        for (uint16_t i=_grid.head[grid_bucket(x, y, z)]; i!=AP_OADATABASE_GRID_NONE; i=_grid.next[i]) {
+                            if (item_match(_database.items[i], item)) {
+                                return i;
+                            }
+                        }
+                    }
+                }
+            }
+            return -1;
+        }
+    }
+
+    // compare item to all items in database
+    for (uint16_t i=0; i<_database.count; i++) {
+        if (item_match(_database.items[i], item)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// returns grid cell number of a position along one axis
+int32_t AP_OADatabase::grid_cell(float pos) const
+{
+    return (int32_t)floorf(pos * (1.0f / AP_OADATABASE_GRID_CELL_SIZE));
+}
+
+// returns index of the bucket holding items in a grid cell
+uint16_t AP_OADatabase::grid_bucket(int32_t x, int32_t y, int32_t z) const
+{
+    const uint32_t hash = ((uint32_t)x * 73856093U) ^ ((uint32_t)y * 19349663U) ^ ((uint32_t)z * 83492791U);
+    return hash & _grid.mask;
+}
+
+// add item to the grid
+void AP_OADatabase::grid_insert(uint16_t index)
+{
+    if (_grid.head == nullptr) {
+        return;
+    }
+    const Vector3f &pos = _database.items[index].pos;
+    const uint16_t bucket = grid_bucket(grid_cell(pos.x), grid_cell(pos.y), grid_cell(pos.z));
+    _grid.next[index] = _grid.head[bucket];
+    _grid.head[bucket] = index;
+}
+
+// remove item from the grid, it must be at the position it was inserted with
+void AP_OADatabase::grid_remove(uint16_t index)
+{
+    if (_grid.head == nullptr) {
+        return;
+    }
+    const Vector3f &pos = _database.items[index].pos;
+    uint16_t *link = &_grid.head[grid_bucket(grid_cell(pos.x), grid_cell(pos.y), grid_cell(pos.z))];
+    while (*link != AP_OADATABASE_GRID_NONE) {
+        if (*link == index) {
+            *link = _grid.next[index];
+            return;
+        }
+        link = &_grid.next[*link];
+    }
+}
+
+// returns true if the grid cells within a box between min and max
+// can be visited faster than checking every item in the database
+bool AP_OADatabase::grid_box_usable(const Vector3f &min, const Vector3f &max) const
+{
+    if (_grid.head == nullptr) {
+        return false;
+    }
+    // calculated as floats as the box may be too large to hold as cell numbers
+    const float scaler = 1.0f / AP_OADATABASE_GRID_CELL_SIZE;
+    const float num_cells = (floorf(max.x * scaler) - floorf(min.x * scaler) + 1) *
+                            (floorf(max.y * scaler) - floorf(min.y * scaler) + 1) *
+                            (floorf(max.z * scaler) - floorf(min.z * scaler) + 1);
+    return num_cells <= MIN(_grid.mask + 1U, (uint32_t)_database.count);
+}
+
+// calculate minimum distance between each line segment of a fan and the objects in the database
+// (less each object's radius) and the occupied voxels of the voxel map
+// segments are offsets in meters from the EKF origin, in the same frame as the objects' positions
+// returns false if the database and voxel map are empty
+bool AP_OADatabase::get_closest_margins(const SegmentFan &segments, float margins[]) const
+{
+    bool found = database_closest_margins(segments, margins);
+#if AP_OAVOXELMAP_ENABLED
+    float voxel_margins[SegmentFan::MAX_SEGMENTS];
+    if (_voxel_map.get_closest_margins(segments, voxel_margins)) {
+        for (uint8_t i=0; i<segments.count(); i++) {
+            margins[i] = found ? MIN(margins[i], voxel_margins[i]) : voxel_margins[i];
+        }
+        found = true;
+    }
+#endif
+    return found;
+}
+
+// calculate minimum distance between each line segment of a fan and the objects in the database, less each object's radius
+// returns false if the database is empty
+bool AP_OADatabase::database_closest_margins(const SegmentFan &segments, float margins[]) const
+{
+    if (!healthy() || (_database.count == 0) || (segments.count() == 0)) {
+        return false;
+    }
+
+    // bounds of segments
+    Vector3f seg_min = segments.start();
+    Vector3f seg_max = segments.start();
+    for (uint8_t i=0; i<segments.count(); i++) {
+        const Vector3f seg_end = segments.end(i);
+        for (uint8_t j=0; j<3; j++) {
+            seg_min[j] = MIN(seg_min[j], seg_end[j]);
+            seg_max[j] = MAX(seg_max[j], seg_end[j]);
+        }
+    }
+
+    // search the grid in a box around the segments, doubling its size until the
+    // closest object found to each segment is closer than any object outside the box could be
+    float search_dist = AP_OADATABASE_GRID_CELL_SIZE;
+    while (true) {
+        const float expand = search_dist + _database.max_radius;
+        const Vector3f min = seg_min - Vector3f(expand, expand, expand);
+        const Vector3f max = seg_max + Vector3f(expand, expand, expand);
+        if (!grid_box_usable(min, max)) {
+            break;
+        }
+        for (uint8_t i=0; i<segments.count(); i++) {
+            margins[i] = FLT_MAX;
+        }
+        for (int32_t x=grid_cell(min.x); x<=grid_cell(max.x); x++) {
+            for (int32_t y=grid_cell(min.y); y<=grid_cell(max.y); y++) {
+                for (int32_t z=grid_cell(min.z); z<=grid_cell(max.z); z++) {
+                    for (uint16_t i=_grid.head[grid_bucket(x, y, z)]; i!=AP_OADATABASE_GRID_NONE; i=_grid.next[i]) {
+                        segments.update_margins(_database.items[i].pos, _database.items[i].radius, margins);
+                    }
+                }
+            }
+        }
+        // objects outside the box are more than expand from every segment
+        bool all_found = true;
+        for (uint8_t i=0; i<segments.count(); i++) {
+            all_found &= (margins[i] <= search_dist);
+        }
+        if (all_found) {
+            return true;
+        }
+        search_dist *= 2.0f;
+    }
+
+    // check each object's distance from the segments
+    for (uint8_t i=0; i<segments.count(); i++) {
+        margins[i] = FLT_MAX;
+    }
+    for (uint16_t i=0; i<_database.count; i++) {
+        segments.update_margins(_database.items[i].pos, _database.items[i].radius, margins);
+    }
+    return true;
+}
+
 void AP_OADatabase::database_item_add(const OA_DbItem &item)
 {
     if (_database.count >= _database.size) {
         return;
     }
+    if ((_database.count == 0) || ((int32_t)(item.timestamp_ms - _database.oldest_ms) < 0)) {
+        _database.oldest_ms = item.timestamp_ms;
+    }
+    if (item.source == OA_DbItem::Source::proximity) {
+        _database.max_proximity_radius = MAX(_database.max_proximity_radius, item.radius);
+    }
+    _database.max_radius = MAX(_database.max_radius, item.radius);
+
     _database.items[_database.count] = item;
     _database.items[_database.count].send_to_gcs = get_send_to_gcs_flags(_database.items[_database.count].importance);
+    grid_insert(_database.count);
     _database.count++;
 }
 
@@ -338,6 +601,7 @@ void AP_OADatabase::database_item_remove(const uint16_t index)
     }
 
     // radius of 0 tells the GCS we don't care about it any more (aka it expired)
+    grid_remove(index);
     _database.items[index].radius = 0;
     _database.items[index].send_to_gcs = get_send_to_gcs_flags(_database.items[index].importance);
 
@@ -348,8 +612,10 @@ void AP_OADatabase::database_item_remove(const uint16_t index)
 
     if (index != _database.count) {
         // copy last object in array over expired object
+        grid_remove(_database.count);
         _database.items[index] = _database.items[_database.count];
         _database.items[index].send_to_gcs = get_send_to_gcs_flags(_database.items[index].importance);
+        grid_insert(index);
     }
 }
 
@@ -385,11 +651,29 @@ void AP_OADatabase::database_items_remove_all_expired()
 
     const uint32_t now_ms = AP_HAL::millis();
     const uint32_t expiry_ms = (uint32_t)_database_expiry_seconds * 1000;
+
+    // nothing can have expired until the oldest item has
+    if ((_database.count == 0) || (now_ms - _database.oldest_ms <= expiry_ms)) {
+        return;
+    }
+
+    // remove expired items, recalculating the oldest timestamp and largest radius of those remaining
+    _database.oldest_ms = now_ms;
+    _database.max_radius = 0;
+    _database.max_proximity_radius = 0;
     uint16_t index = 0;
     while (index < _database.count) {
-        if (now_ms - _database.items[index].timestamp_ms > expiry_ms) {
+        const OA_DbItem &item = _database.items[index];
+        if (now_ms - item.timestamp_ms > expiry_ms) {
             database_item_remove(index);
         } else {
+            if ((int32_t)(item.timestamp_ms - _database.oldest_ms) < 0) {
+                _database.oldest_ms = item.timestamp_ms;
+            }
+            if (item.source == OA_DbItem::Source::proximity) {
+                _database.max_proximity_radius = MAX(_database.max_proximity_radius, item.radius);
+            }
+            _database.max_radius = MAX(_database.max_radius, item.radius);
             index++;
         }
     }
@@ -467,6 +751,13 @@ void AP_OADatabase::send_adsb_vehicle(mavlink_channel_t chan, uint16_t interval_
         num_sent++;
     }
 
+#if AP_OAVOXELMAP_ENABLED
+    // send voxels with any capacity left, their ids follow the database's
+    if (_output_level >= OutputLevel::ALL) {
+        num_sent += _voxel_map.send_adsb_vehicle(chan, _database.size, num_to_send - num_sent);
+    }
+#endif
+
     // clear expired items in case the database size shrank
     while (_highest_index_sent[chan] > _database.count) {
         if (!HAVE_PAYLOAD_SPACE(chan, ADSB_VEHICLE) || (num_sent >= num_to_send)) {
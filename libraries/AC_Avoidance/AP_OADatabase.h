@@ -6,8 +6,10 @@
 
 #include <AP_HAL/Semaphores.h>
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/segment_fan.h>
 #include <GCS_MAVLink/GCS_MAVLink.h>
 #include <AP_Param/AP_Param.h>
+#include "AP_OAVoxelMap.h"
 
 class AP_OADatabase {
 public:
@@ -52,6 +54,10 @@ public:
     void queue_push(const Vector3f &pos, const uint32_t timestamp_ms, const float distance, float radius, const OA_DbItem::Source source, const uint32_t id = 0);
     void queue_push(const Vector3f &pos, const uint32_t timestamp_ms, const float distance, const OA_DbItem::Source source, const uint32_t id = 0);
 
+    // Push a range sensor reading of an object at pos from a sensor at origin into the voxel map.
+    // Positions are offsets in meters from the EKF origin (NEU), distance in meters
+    void queue_push_ray(const Vector3f &origin, const Vector3f &pos, const float distance);
+
     // returns true if database is healthy
     bool healthy() const { return (_queue.items != nullptr) && (_database.items != nullptr); }
 
@@ -64,6 +70,17 @@ public:
     // empty queue and try and put into database. Return true if there's more work to do
     bool process_queue();
 
+    // calculate minimum distance between each line segment of a fan and the objects in the database
+    // (less each object's radius) and the occupied voxels of the voxel map
+    // segments are offsets in meters from the EKF origin, in the same frame as the objects' positions
+    // returns false if the database and voxel map are empty
+    bool get_closest_margins(const SegmentFan &segments, float margins[]) const;
+
+#if AP_OAVOXELMAP_ENABLED
+    // get voxel map for queries by path planners, returns nullptr if the map is not enabled
+    const AP_OAVoxelMap *get_voxel_map() const { return _voxel_map.healthy() ? &_voxel_map : nullptr; }
+#endif
+
     // send ADSB_VEHICLE mavlink messages
     void send_adsb_vehicle(mavlink_channel_t chan, uint16_t interval_ms);
 
@@ -75,12 +92,34 @@ private:
     void init_queue();
     void init_database();
 
+    // returns false if objects should not be stored because the vehicle is low and near home
+    bool vehicle_pos_allows_push() const;
+
+    // calculate minimum distance between each line segment of a fan and the objects in the database, less each object's radius
+    // returns false if the database is empty
+    bool database_closest_margins(const SegmentFan &segments, float margins[]) const;
+
     // database item management
     void database_item_add(const OA_DbItem &item);
     void database_item_refresh(OA_DbItem &current_item, const OA_DbItem &new_item) const;
     void database_item_remove(const uint16_t index);
     void database_items_remove_all_expired();
 
+    // find an item in the database likely to be the same as item
+    // returns its index or -1 if there is no match
+    int32_t database_item_find(const OA_DbItem &item) const;
+
+    // spatial index of database items, a hashed grid of cubes of
+    // AP_OADATABASE_GRID_CELL_SIZE meters holding a linked list of the items in each
+    int32_t grid_cell(float pos) const;
+    uint16_t grid_bucket(int32_t x, int32_t y, int32_t z) const;
+    void grid_insert(uint16_t index);
+    void grid_remove(uint16_t index);
+
+    // returns true if the grid cells within a box between min and max
+    // can be visited faster than checking every item in the database
+    bool grid_box_usable(const Vector3f &min, const Vector3f &max) const;
+
     // get bitmask of gcs channels item should be sent to based on its importance
     // returns 0xFF (send to all channels) if should be sent or 0 if it should not be sent
     uint8_t get_send_to_gcs_flags(const OA_DbItemImportance importance) const;
@@ -105,11 +144,19 @@ private:
     AP_Float        _radius_min;                            // objects minimum radius (in meters)
     AP_Float        _dist_max;                              // objects maximum distance (in meters)
     AP_Float        _min_alt;                               // OADatabase minimum vehicle height check (in meters)
+#if AP_OAVOXELMAP_ENABLED
+    AP_Int16        _voxel_map_size_param;                  // voxel map size
+    AP_Float        _voxel_map_resolution;                  // voxel map resolution (in meters)
+
+    AP_OAVoxelMap   _voxel_map;                             // memory of obstacles seen by range sensors
+#endif
 
     struct {
-        ObjectBuffer<OA_DbItem> *items;                     // thread safe incoming queue of points from proximity sensor to be put into database
+        // incoming queue of points to be put into the database. All
+        // producers push from the main loop and only the path planner
+        // thread pops, so a lock free single producer queue is used
+        ObjectBuffer_SPSC<OA_DbItem> *items;
         uint16_t        size;                               // cached value of _queue_size_param.
-        HAL_Semaphore   sem;                                // semaphore for multi-thread use of queue
     } _queue;
     float dist_to_radius_scalar;                            // scalar to convert the distance and beam width to an object radius
 
@@ -117,8 +164,17 @@ private:
         OA_DbItem       *items;                             // array of objects in the database
         uint16_t        count;                              // number of objects in the items array
         uint16_t        size;                               // cached value of _database_size_param that sticks after initialized
+        float           max_radius;                         // upper bound of radius of items in the database
+        float           max_proximity_radius;               // upper bound of radius of proximity items in the database
+        uint32_t        oldest_ms;                          // lower bound of timestamp of items in the database
     } _database;
 
+    struct {
+        uint16_t        *head;                              // index of first item in each bucket (or UINT16_MAX if empty)
+        uint16_t        *next;                              // index of next item in the same bucket for each item (or UINT16_MAX)
+        uint16_t        mask;                               // number of buckets minus one, the number of buckets is a power of two
+    } _grid;
+
     uint16_t _next_index_to_send[MAVLINK_COMM_NUM_BUFFERS]; // index of next object in _database to send to GCS
     uint16_t _highest_index_sent[MAVLINK_COMM_NUM_BUFFERS]; // highest index in _database sent to GCS
     uint32_t _last_send_to_gcs_ms[MAVLINK_COMM_NUM_BUFFERS];// system time that send_adsb_vehicle was last called
@@ -26,6 +26,8 @@
 
 #include <AP_AHRS/AP_AHRS.h>
 #include <AP_Logger/AP_Logger.h>
+#include <AP_Math/crc.h>
+#include <AP_Common/Bitmask.h>
 #include <GCS_MAVLink/GCS.h>
 
 #define OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK  32      // expanding arrays for fence points and paths to destination will grow in increments of 20 elements
@@ -37,7 +39,13 @@ AP_OADijkstra::AP_OADijkstra(AP_Int16 &options) :
         _inclusion_polygon_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _exclusion_polygon_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _exclusion_circle_pts(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
-        _short_path_data(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+#if AP_OADIJKSTRA_VISGRAPH_REUSE_ENABLED
+        _visgraph_fence_items(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK, AP_ExpandingArrayGeneric::Growth::CONTIGUOUS),
+        _visgraph_nodes(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK, AP_ExpandingArrayGeneric::Growth::CONTIGUOUS),
+        _visgraph_changed_bounds(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
+#endif
+        _short_path_data(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK, AP_ExpandingArrayGeneric::Growth::CONTIGUOUS),
+        _short_path_open(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK, AP_ExpandingArrayGeneric::Growth::CONTIGUOUS),
         _path(OA_DIJKSTRA_EXPANDING_ARRAY_ELEMENTS_PER_CHUNK),
         _options(options)
 {
@@ -618,9 +626,18 @@ bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &
         return false;
     }
 
+    // bounds of segment, polygons whose bounds do not touch these cannot be crossed
+    const Vector2f seg[] {seg_start, seg_end};
+    Polygon_Bounds seg_bounds;
+    Polygon_bounds(seg, ARRAY_SIZE(seg), seg_bounds);
+    Polygon_Bounds bounds;
+
     // determine if segment crosses any of the inclusion polygons
     uint16_t num_points = 0;
     for (uint8_t i = 0; i < fence->polyfence().get_inclusion_polygon_count(); i++) {
+        if (fence->polyfence().get_inclusion_polygon_bounds(i, bounds) && is_positive(seg_bounds.distance(bounds))) {
+            continue;
+        }
         const Vector2f* boundary = fence->polyfence().get_inclusion_polygon(i, num_points);
         if (boundary != nullptr) {
             Vector2f intersection;
@@ -632,6 +649,9 @@ bool AP_OADijkstra::intersects_fence(const Vector2f &seg_start, const Vector2f &
 
     // determine if segment crosses any of the exclusion polygons
     for (uint8_t i = 0; i < fence->polyfence().get_exclusion_polygon_count(); i++) {
+        if (fence->polyfence().get_exclusion_polygon_bounds(i, bounds) && is_positive(seg_bounds.distance(bounds))) {
+            continue;
+        }
         const Vector2f* boundary = fence->polyfence().get_exclusion_polygon(i, num_points);
         if (boundary != nullptr) {
             Vector2f intersection;
@@ -694,8 +714,59 @@ bool AP_OADijkstra::create_fence_visgraph(AP_OADijkstra_Error &err_id)
         return false;
     }
 
+    // destination's visgraph must be recalculated against the latest fence
+    _destination_visgraph_ok = false;
+
+#if AP_OADIJKSTRA_VISGRAPH_REUSE_ENABLED
+    // find areas of the fence which have changed since the visgraph was last built
+    // the visgraph is rebuilt from scratch if this fails
+    bool reuse_ok = update_visgraph_changed_bounds();
+
+    // match the previous nodes to the latest nodes by position
+    // nodes are only moved by a change to the fence they belong to
+    Bitmask<OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX> reused_nodes;
+    for (uint8_t i = 0; i < _visgraph_nodes_num; i++) {
+        VisGraphNode &node = _visgraph_nodes[i];
+        node.new_idx = OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX;
+        for (uint8_t j = 0; reuse_ok && j < total_numpoints(); j++) {
+            Vector2f point;
+            if (!reused_nodes.get(j) && get_point(j, point) && (point == node.pos)) {
+                node.new_idx = j;
+                reused_nodes.set(j);
+                break;
+            }
+        }
+    }
+
+    // keep edges between reused nodes which are well clear of the changes, renumbering them to the latest nodes
+    uint16_t num_reused_items = 0;
+    for (uint16_t i = 0; reuse_ok && i < _fence_visgraph.num_items(); i++) {
+        const AP_OAVisGraph::VisGraphItem &item = _fence_visgraph[i];
+        if ((item.id1.id_num >= _visgraph_nodes_num) || (item.id2.id_num >= _visgraph_nodes_num)) {
+            continue;
+        }
+        const VisGraphNode &node1 = _visgraph_nodes[item.id1.id_num];
+        const VisGraphNode &node2 = _visgraph_nodes[item.id2.id_num];
+        if ((node1.new_idx != OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) &&
+            (node2.new_idx != OA_DIJKSTRA_POLYGON_SHORTPATH_NOTSET_IDX) &&
+            !visgraph_changed(node1.pos, node2.pos)) {
+            _fence_visgraph.set_item(num_reused_items++,
+                                     {AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, node1.new_idx},
+                                     {AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, node2.new_idx},
+                                     item.distance_cm);
+        }
+    }
+    _fence_visgraph.truncate(num_reused_items);
+    if (!reuse_ok) {
+        reused_nodes.clearall();
+    }
+
+    // the previous nodes are no longer valid until the visgraph has been completed
+    _visgraph_nodes_num = 0;
+#else
     // clear fence points visibility graph
     _fence_visgraph.clear();
+#endif
 
     // calculate distance from each point to all other points
     for (uint8_t i = 0; i < total_numpoints() - 1; i++) {
@@ -704,6 +775,12 @@ bool AP_OADijkstra::create_fence_visgraph(AP_OADijkstra_Error &err_id)
             for (uint8_t j = i + 1; j < total_numpoints(); j++) {
                 Vector2f end_seg;
                 if (get_point(j, end_seg)) {
+#if AP_OADIJKSTRA_VISGRAPH_REUSE_ENABLED
+                    // visibility between reused nodes is unchanged unless the segment is near a change
+                    if (reused_nodes.get(i) && reused_nodes.get(j) && !visgraph_changed(start_seg, end_seg)) {
+                        continue;
+                    }
+#endif
                     // if line segment does not intersect with any inclusion or exclusion zones add to visgraph
                     if (!intersects_fence(start_seg, end_seg)) {
                         if (!_fence_visgraph.add_item({AP_OAVisGraph::OATYPE_INTERMEDIATE_POINT, i},
@@ -719,9 +796,161 @@ bool AP_OADijkstra::create_fence_visgraph(AP_OADijkstra_Error &err_id)
         }
     }
 
+#if AP_OADIJKSTRA_VISGRAPH_REUSE_ENABLED
+    // failure to record the fence only means the next visgraph is built from scratch
+    IGNORE_RETURN(record_visgraph_source());
+#endif
+
+    return true;
+}
+
+#if AP_OADIJKSTRA_VISGRAPH_REUSE_ENABLED
+// get a single item across all polygons and circles of the fence
+// returns false if index is past the last item
+bool AP_OADijkstra::get_visgraph_fence_item(uint16_t index, VisGraphFenceItem &item) const
+{
+    const AC_PolyFence_loader &polyfence = AP::fence()->polyfence();
+    item.matched = false;
+
+    // inclusion polygons
+    if (index < polyfence.get_inclusion_polygon_count()) {
+        uint16_t num_points;
+        const Vector2f* boundary = polyfence.get_inclusion_polygon(index, num_points);
+        item.crc = crc_crc32(0, (const uint8_t *)boundary, num_points * sizeof(Vector2f));
+        return polyfence.get_inclusion_polygon_bounds(index, item.bounds);
+    }
+    index -= polyfence.get_inclusion_polygon_count();
+
+    // exclusion polygons
+    if (index < polyfence.get_exclusion_polygon_count()) {
+        uint16_t num_points;
+        const Vector2f* boundary = polyfence.get_exclusion_polygon(index, num_points);
+        item.crc = crc_crc32(0, (const uint8_t *)boundary, num_points * sizeof(Vector2f));
+        return polyfence.get_exclusion_polygon_bounds(index, item.bounds);
+    }
+    index -= polyfence.get_exclusion_polygon_count();
+
+    // exclusion circles
+    if (index < polyfence.get_exclusion_circle_count()) {
+        Vector2f center_pos_cm;
+        float radius;
+        if (!polyfence.get_exclusion_circle(index, center_pos_cm, radius)) {
+            return false;
+        }
+        item.crc = crc_crc32(0, (const uint8_t *)&center_pos_cm, sizeof(center_pos_cm));
+        item.crc = crc_crc32(item.crc, (const uint8_t *)&radius, sizeof(radius));
+        const Vector2f radius_cm {radius * 100.0f, radius * 100.0f};
+        item.bounds = {center_pos_cm - radius_cm, center_pos_cm + radius_cm};
+        return true;
+    }
+    index -= polyfence.get_exclusion_circle_count();
+
+    // inclusion circles block any segment with an end outside them, so
+    // they are held as a single item whose area covers everything
+    if (index == 0) {
+        item.crc = 0;
+        for (uint8_t i = 0; i < polyfence.get_inclusion_circle_count(); i++) {
+            Vector2f center_pos_cm;
+            float radius;
+            if (polyfence.get_inclusion_circle(i, center_pos_cm, radius)) {
+                item.crc = crc_crc32(item.crc, (const uint8_t *)&center_pos_cm, sizeof(center_pos_cm));
+                item.crc = crc_crc32(item.crc, (const uint8_t *)&radius, sizeof(radius));
+            }
+        }
+        item.bounds = {Vector2f{-FLT_MAX, -FLT_MAX}, Vector2f{FLT_MAX, FLT_MAX}};
+        return true;
+    }
+
+    return false;
+}
+
+// find the areas of the fence that have changed since the fence visgraph was last built
+// returns false on failure (out of memory)
+bool AP_OADijkstra::update_visgraph_changed_bounds()
+{
+    _visgraph_changed_bounds_num = 0;
+    for (VisGraphFenceItem &prev_item : _visgraph_fence_items.items(_visgraph_fence_items_num)) {
+        prev_item.matched = false;
+    }
+
+    // items in the latest fence but not the previous one
+    VisGraphFenceItem item;
+    for (uint16_t i = 0; get_visgraph_fence_item(i, item); i++) {
+        bool found = false;
+        for (VisGraphFenceItem &prev_item : _visgraph_fence_items.items(_visgraph_fence_items_num)) {
+            if (!prev_item.matched && (prev_item.crc == item.crc) &&
+                (prev_item.bounds.min == item.bounds.min) && (prev_item.bounds.max == item.bounds.max)) {
+                prev_item.matched = true;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            if (!_visgraph_changed_bounds.expand_to_hold(_visgraph_changed_bounds_num + 1)) {
+                return false;
+            }
+            _visgraph_changed_bounds[_visgraph_changed_bounds_num++] = item.bounds;
+        }
+    }
+
+    // items in the previous fence but not the latest one
+    for (const VisGraphFenceItem &prev_item : _visgraph_fence_items.items(_visgraph_fence_items_num)) {
+        if (!prev_item.matched) {
+            if (!_visgraph_changed_bounds.expand_to_hold(_visgraph_changed_bounds_num + 1)) {
+                return false;
+            }
+            _visgraph_changed_bounds[_visgraph_changed_bounds_num++] = prev_item.bounds;
+        }
+    }
+
     return true;
 }
 
+// returns true if a line segment between two nodes may be blocked differently since the fence visgraph was last built
+bool AP_OADijkstra::visgraph_changed(const Vector2f &seg_start, const Vector2f &seg_end) const
+{
+    const Vector2f seg[] {seg_start, seg_end};
+    Polygon_Bounds seg_bounds;
+    Polygon_bounds(seg, ARRAY_SIZE(seg), seg_bounds);
+    for (uint16_t i = 0; i < _visgraph_changed_bounds_num; i++) {
+        if (!is_positive(seg_bounds.distance(_visgraph_changed_bounds[i]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// record the fence items and nodes the fence visgraph has been built from
+// returns false on failure (out of memory)
+bool AP_OADijkstra::record_visgraph_source()
+{
+    _visgraph_fence_items_num = 0;
+    _visgraph_nodes_num = 0;
+
+    VisGraphFenceItem item;
+    uint16_t num_items = 0;
+    for (uint16_t i = 0; get_visgraph_fence_item(i, item); i++) {
+        if (!_visgraph_fence_items.expand_to_hold(num_items + 1)) {
+            return false;
+        }
+        _visgraph_fence_items[num_items++] = item;
+    }
+
+    if (!_visgraph_nodes.expand_to_hold(total_numpoints())) {
+        return false;
+    }
+    for (uint8_t i = 0; i < total_numpoints(); i++) {
+        if (!get_point(i, _visgraph_nodes[i].pos)) {
+            return false;
+        }
+    }
+
+    _visgraph_fence_items_num = num_items;
+    _visgraph_nodes_num = total_numpoints();
+    return true;
+}
+#endif  // AP_OADIJKSTRA_VISGRAPH_REUSE_ENABLED
+
 // updates visibility graph for a given position which is an offset (in cm) from the ekf origin
 // to add an additional position (i.e. the destination) set add_extra_position = true and provide the position in the extra_position argument
 // requires create_inclusion_polygon_with_margin to have been run
@@ -756,13 +985,47 @@ bool AP_OADijkstra::update_visgraph(AP_OAVisGraph& visgraph, const AP_OAVisGraph
     return true;
 }
 
+// add node to the open set using its tentative distance
+// returns false on failure (out of memory)
+bool AP_OADijkstra::add_open_node(node_index node_idx)
+{
+    // heuristic is simple Euclidean distance from the node to the destination
+    // this never overestimates the remaining distance so the optimal path is still found
+    const ShortPathNode &node = _short_path_data[node_idx];
+    Vector2f node_pos;
+    if (!convert_node_to_point(node.id, node_pos)) {
+        // shouldn't happen
+        return true;
+    }
+    const float est_distance_cm = node.distance_cm + (node_pos - _path_destination).length();
+
+    // a node whose distance is reduced is added again, the stale element is skipped once the node is visited
+    if (!_short_path_open.expand_to_hold(_short_path_open_numpoints + 1)) {
+        return false;
+    }
+
+    // sift new element up from the bottom of the heap
+    uint16_t i = _short_path_open_numpoints++;
+    while (i > 0) {
+        const uint16_t parent = (i - 1) / 2;
+        if (_short_path_open[parent].est_distance_cm <= est_distance_cm) {
+            break;
+        }
+        _short_path_open[i] = _short_path_open[parent];
+        i = parent;
+    }
+    _short_path_open[i] = {est_distance_cm, node_idx};
+    return true;
+}
+
 // update total distance for all nodes visible from current node
 // curr_node_idx is an index into the _short_path_data array
-void AP_OADijkstra::update_visible_node_distances(node_index curr_node_idx)
+// returns false on failure (out of memory)
+bool AP_OADijkstra::update_visible_node_distances(node_index curr_node_idx)
 {
     // sanity check
     if (curr_node_idx >= _short_path_data_numpoints) {
-        return;
+        return true;
     }
 
     // get current node for convenience
@@ -779,8 +1042,7 @@ void AP_OADijkstra::update_visible_node_distances(node_index curr_node_idx)
         }
 
         // search visibility graph for items visible from current_node
-        for (uint16_t i = 0; i < curr_visgraph.num_items(); i++) {
-            const AP_OAVisGraph::VisGraphItem &item = curr_visgraph[i];
+        for (const AP_OAVisGraph::VisGraphItem &item : curr_visgraph.items()) {
             // match if current node's id matches either of the id's in the graph (i.e. either end of the vector)
             if ((curr_node.id == item.id1) || (curr_node.id == item.id2)) {
                 AP_OAVisGraph::OAItemID matching_id = (curr_node.id == item.id1) ? item.id2 : item.id1;
@@ -789,15 +1051,19 @@ void AP_OADijkstra::update_visible_node_distances(node_index curr_node_idx)
                 if (find_node_from_id(matching_id, item_node_idx)) {
                     // if current node's distance + distance to item is less than item's current distance, update item's distance
                     const float dist_to_item_via_current_node = _short_path_data[curr_node_idx].distance_cm + item.distance_cm;
-                    if (dist_to_item_via_current_node < _short_path_data[item_node_idx].distance_cm) {
+                    if (!_short_path_data[item_node_idx].visited && (dist_to_item_via_current_node < _short_path_data[item_node_idx].distance_cm)) {
                         // update item's distance and set "distance_from_idx" to current node's index
                         _short_path_data[item_node_idx].distance_cm = dist_to_item_via_current_node;
                         _short_path_data[item_node_idx].distance_from_idx = curr_node_idx;
+                        if (!add_open_node(item_node_idx)) {
+                            return false;
+                        }
                     }
                 }
             }
         }
     }
+    return true;
 }
 
 // find a node's index into _short_path_data array from it's id (i.e. id type and id number)
@@ -832,43 +1098,42 @@ bool AP_OADijkstra::find_node_from_id(const AP_OAVisGraph::OAItemID &id, node_in
     return false;
 }
 
-// find index of node with lowest tentative distance (ignore visited nodes)
+// find index of node with lowest tentative distance plus straight line distance to destination (ignore visited nodes)
+// the node is removed from the open set
 // returns true if successful and node_idx argument is updated
-bool AP_OADijkstra::find_closest_node_idx(node_index &node_idx) const
+bool AP_OADijkstra::find_closest_node_idx(node_index &node_idx)
 {
-    node_index lowest_idx = 0;
-    float lowest_dist = FLT_MAX;
-
-    // scan through all nodes looking for closest
-    for (node_index i=0; i<_short_path_data_numpoints; i++) {
-        const ShortPathNode &node = _short_path_data[i];
-        if (node.visited || is_equal(_short_path_data[i].distance_cm, FLT_MAX)) {
-            // if node is already visited OR cannot be reached yet, we can't use it
-            continue;
-        }
-        // figure out the pos of this node
-        Vector2f node_pos;
-        float dist_with_heuristics = FLT_MAX;
-        if (convert_node_to_point(node.id, node_pos)) {
-            // heuristics is is simple Euclidean distance from the node to the destination
-            // This should be admissible, therefore optimal path is guaranteed
-            const float heuristics = (node_pos-_path_destination).length();
-            dist_with_heuristics = node.distance_cm + heuristics;
-        } else {
-            // shouldn't happen
-            return false;
+    while (_short_path_open_numpoints > 0) {
+        // take the top of the heap
+        const node_index top_idx = _short_path_open[0].idx;
+
+        // move last element to the top and sift it down
+        const ShortPathOpenItem last = _short_path_open[--_short_path_open_numpoints];
+        uint16_t i = 0;
+        while (true) {
+            uint16_t child = 2 * i + 1;
+            if (child >= _short_path_open_numpoints) {
+                break;
+            }
+            if ((child + 1 < _short_path_open_numpoints) &&
+                (_short_path_open[child + 1].est_distance_cm < _short_path_open[child].est_distance_cm)) {
+                child++;
+            }
+            if (last.est_distance_cm <= _short_path_open[child].est_distance_cm) {
+                break;
+            }
+            _short_path_open[i] = _short_path_open[child];
+            i = child;
         }
-        if (dist_with_heuristics < lowest_dist) {
-            // for NOW, this is the closest node
-            lowest_idx = i;
-            lowest_dist = dist_with_heuristics;
+        if (_short_path_open_numpoints > 0) {
+            _short_path_open[i] = last;
         }
-    }
 
-    if (lowest_dist < FLT_MAX) {
-        // found the closest node
-        node_idx = lowest_idx;
-        return true;
+        // skip stale elements of nodes that have already been visited
+        if (!_short_path_data[top_idx].visited) {
+            node_idx = top_idx;
+            return true;
+        }
     }
     return false;
 }
@@ -891,9 +1156,14 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
         err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
         return false;
     }
-    if (!update_visgraph(_destination_visgraph, {AP_OAVisGraph::OATYPE_DESTINATION, 0}, _path_destination)) {
-        err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
-        return false;
+    // destination's visgraph only changes with the destination or fence
+    if (!_destination_visgraph_ok || (_path_destination != _destination_visgraph_pos)) {
+        _destination_visgraph_ok = update_visgraph(_destination_visgraph, {AP_OAVisGraph::OATYPE_DESTINATION, 0}, _path_destination);
+        if (!_destination_visgraph_ok) {
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+            return false;
+        }
+        _destination_visgraph_pos = _path_destination;
     }
 
     // expand _short_path_data if necessary
@@ -914,6 +1184,7 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
 
     // start algorithm from source point
     node_index current_node_idx = 0;
+    _short_path_open_numpoints = 0;
 
     // update nodes visible from source point
     for (uint16_t i = 0; i < _source_visgraph.num_items(); i++) {
@@ -921,6 +1192,10 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
         if (find_node_from_id(_source_visgraph[i].id2, node_idx)) {
             _short_path_data[node_idx].distance_cm = _source_visgraph[i].distance_cm;
             _short_path_data[node_idx].distance_from_idx = current_node_idx;
+            if (!add_open_node(node_idx)) {
+                err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+                return false;
+            }
         } else {
             err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_COULD_NOT_FIND_PATH;
             return false;
@@ -938,7 +1213,10 @@ bool AP_OADijkstra::calc_shortest_path(const Location &origin, const Location &d
             break;
         }
         // update distances to all neighbours of current node
-        update_visible_node_distances(current_node_idx);
+        if (!update_visible_node_distances(current_node_idx)) {
+            err_id = AP_OADijkstra_Error::DIJKSTRA_ERROR_OUT_OF_MEMORY;
+            return false;
+        }
 
         // mark current node as visited
         _short_path_data[current_node_idx].visited = true;
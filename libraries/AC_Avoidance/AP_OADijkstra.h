@@ -123,6 +123,45 @@ private:
     // returns true on success.  returns false on failure and err_id is updated
     bool create_fence_visgraph(AP_OADijkstra_Error &err_id);
 
+#if AP_OADIJKSTRA_VISGRAPH_REUSE_ENABLED
+    // fence items (polygons and circles) the fence visgraph was built from
+    // used to find the areas of the fence that have changed when the fence is reloaded
+    struct VisGraphFenceItem {
+        uint32_t crc;               // crc of the item's points or center and radius
+        Polygon_Bounds bounds;      // area (offsets in cm from EKF origin) in which the item can block a line segment
+        bool matched;               // true if the item is also in the latest fence
+    };
+    AP_ExpandingArray<VisGraphFenceItem> _visgraph_fence_items;
+    uint16_t _visgraph_fence_items_num;     // number of items held in above array
+
+    // nodes the fence visgraph was built from
+    struct VisGraphNode {
+        Vector2f pos;               // position as an offset (in cm) from the EKF origin
+        uint8_t new_idx;            // index of the node at the same position in the latest nodes (or 255 if none)
+    };
+    AP_ExpandingArray<VisGraphNode> _visgraph_nodes;
+    uint8_t _visgraph_nodes_num;            // number of nodes held in above array
+
+    // areas of the fence added or removed since the fence visgraph was last built
+    AP_ExpandingArray<Polygon_Bounds> _visgraph_changed_bounds;
+    uint16_t _visgraph_changed_bounds_num;  // number of areas held in above array
+
+    // get a single item across all polygons and circles of the fence
+    // returns false if index is past the last item
+    bool get_visgraph_fence_item(uint16_t index, VisGraphFenceItem &item) const;
+
+    // find the areas of the fence that have changed since the fence visgraph was last built
+    // returns false on failure (out of memory)
+    bool update_visgraph_changed_bounds();
+
+    // returns true if a line segment between two nodes may be blocked differently since the fence visgraph was last built
+    bool visgraph_changed(const Vector2f &seg_start, const Vector2f &seg_end) const;
+
+    // record the fence items and nodes the fence visgraph has been built from
+    // returns false on failure (out of memory)
+    bool record_visgraph_source();
+#endif
+
     // calculate shortest path from origin to destination
     // returns true on success.  returns false on failure and err_id is updated
     // requires create_polygon_fence_with_margin and create_polygon_fence_visgraph to have been run
@@ -161,6 +200,8 @@ private:
     AP_OAVisGraph _fence_visgraph;          // holds distances between all inclusion/exclusion fence points (with margin)
     AP_OAVisGraph _source_visgraph;         // holds distances from source point to all other nodes
     AP_OAVisGraph _destination_visgraph;    // holds distances from the destination to all other nodes
+    bool _destination_visgraph_ok;          // true if _destination_visgraph holds distances from _destination_visgraph_pos with the latest fence
+    Vector2f _destination_visgraph_pos;     // destination position used to create _destination_visgraph (offset in cm from EKF origin)
 
     // updates visibility graph for a given position which is an offset (in cm) from the ekf origin
     // to add an additional position (i.e. the destination) set add_extra_position = true and provide the position in the extra_position argument
@@ -178,17 +219,31 @@ private:
     AP_ExpandingArray<ShortPathNode> _short_path_data;
     node_index _short_path_data_numpoints;  // number of elements in _short_path_data array
 
+    // open set of nodes to be visited held as a binary heap ordered by lowest estimated total distance
+    struct ShortPathOpenItem {
+        float est_distance_cm;          // distance from source to node plus straight line distance from node to destination
+        node_index idx;                 // index into _short_path_data
+    };
+    AP_ExpandingArray<ShortPathOpenItem> _short_path_open;
+    uint16_t _short_path_open_numpoints;    // number of elements in _short_path_open heap
+
+    // add node to the open set using its tentative distance
+    // returns false on failure (out of memory)
+    bool add_open_node(node_index node_idx);
+
     // update total distance for all nodes visible from current node
     // curr_node_idx is an index into the _short_path_data array
-    void update_visible_node_distances(node_index curr_node_idx);
+    // returns false on failure (out of memory)
+    bool update_visible_node_distances(node_index curr_node_idx);
 
     // find a node's index into _short_path_data array from it's id (i.e. id type and id number)
     // returns true if successful and node_idx is updated
     bool find_node_from_id(const AP_OAVisGraph::OAItemID &id, node_index &node_idx) const;
 
-    // find index of node with lowest tentative distance (ignore visited nodes)
+    // find index of node with lowest tentative distance plus straight line distance to destination (ignore visited nodes)
+    // the node is removed from the open set
     // returns true if successful and node_idx argument is updated
-    bool find_closest_node_idx(node_index &node_idx) const;
+    bool find_closest_node_idx(node_index &node_idx);
 
     // final path variables and functions
     AP_ExpandingArray<AP_OAVisGraph::OAItemID> _path;   // ids of points on return path in reverse order (i.e. destination is first element)
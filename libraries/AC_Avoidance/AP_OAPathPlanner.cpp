@@ -30,6 +30,7 @@ extern const AP_HAL::HAL &hal;
 // parameter defaults
 static constexpr float OA_MARGIN_MAX_DEFAULT = 5;
 static constexpr int16_t OA_OPTIONS_DEFAULT = 1;
+static constexpr int8_t OA_CPU_PCT_DEFAULT = 20;
 
 static constexpr int16_t OA_UPDATE_MS = 1000;      // path planning updates run at 1hz
 static constexpr int16_t OA_TIMEOUT_MS = 3000;     // results over 3 seconds old are ignored
@@ -71,6 +72,15 @@ const AP_Param::GroupInfo AP_OAPathPlanner::var_info[] = {
     // @Path: AP_OABendyRuler.cpp
     AP_SUBGROUPPTR(_oabendyruler, "BR_", 6, AP_OAPathPlanner, AP_OABendyRuler),
 
+    // @Param: CPU_PCT
+    // @DisplayName: Object Avoidance path planner CPU budget
+    // @Description: Percentage of time the path planners may run for in the avoidance thread. A path planning run that takes longer than this allows delays the next one. New destinations are planned for as soon as the budget allows, existing ones are refined once a second
+    // @Units: %
+    // @Range: 1 100
+    // @Increment: 1
+    // @User: Advanced
+    AP_GROUPINFO("CPU_PCT", 7, AP_OAPathPlanner, _cpu_pct, OA_CPU_PCT_DEFAULT),
+
     AP_GROUPEND
 };
 
@@ -277,18 +287,24 @@ void AP_OAPathPlanner::avoidance_thread()
         }
 
         const uint32_t now = AP_HAL::millis();
-        if (now - avoidance_latest_ms < OA_UPDATE_MS) {
-            continue;
+
+        // keep the database up to date whether or not the planners run
+        if (now - database_update_ms >= OA_UPDATE_MS) {
+            database_update_ms = now;
+            _oadatabase.update();
         }
-        avoidance_latest_ms = now;
 
-        _oadatabase.update();
+        if (now - avoidance_latest_ms < avoidance_hold_ms) {
+            // keep within the CPU budget
+            continue;
+        }
 
         // values returned by path planners
         Location origin_new;
         Location destination_new;
         Location next_destination_new;
         bool dest_to_next_dest_clear = false;
+        bool new_request;
         {
             WITH_SEMAPHORE(_rsem);
             if (now - avoidance_request.request_time_ms > OA_TIMEOUT_MS) {
@@ -296,6 +312,15 @@ void AP_OAPathPlanner::avoidance_thread()
                 continue;
             }
 
+            // a new destination is planned for straight away, so the
+            // main thread isn't left waiting for the next update. The
+            // latest result is refined at OA_UPDATE_MS
+            new_request = !avoidance_request.destination.same_latlon_as(avoidance_result.destination) ||
+                          !avoidance_request.next_destination.same_latlon_as(avoidance_result.next_destination);
+            if (!new_request && now - avoidance_latest_ms < OA_UPDATE_MS) {
+                continue;
+            }
+
             // copy request to avoid conflict with main thread
             avoidance_request2 = avoidance_request;
 
@@ -304,6 +329,15 @@ void AP_OAPathPlanner::avoidance_thread()
             destination_new = avoidance_request.destination;
             next_destination_new = avoidance_request.next_destination;
         }
+        avoidance_latest_ms = now;
+
+        // plan with the latest database
+        if (database_update_ms != now) {
+            database_update_ms = now;
+            _oadatabase.update();
+        }
+
+        const uint32_t start_us = AP_HAL::micros();
 
         // run background task looking for best alternative destination
         OA_RetState res = OA_NOT_REQUIRED;
@@ -403,10 +437,21 @@ void AP_OAPathPlanner::avoidance_thread()
 
         } // switch
 
+        // hold off the next run so the planners use no more than
+        // _cpu_pct of the time, without letting results time out
+        const uint32_t run_time_us = AP_HAL::micros() - start_us;
+        const uint8_t cpu_pct = constrain_int16(_cpu_pct, 1, 100);
+        avoidance_hold_ms = MIN(run_time_us / (10U * cpu_pct), uint32_t(OA_TIMEOUT_MS / 2));
+
         {
             // give the main thread the avoidance result
             WITH_SEMAPHORE(_rsem);
 
+            const uint32_t result_ms = AP_HAL::millis();
+            Write_OAPathPlanner(res, path_planner_used, new_request, run_time_us,
+                                result_ms - avoidance_request2.request_time_ms,
+                                result_ms - avoidance_result.result_time_ms);
+
             // place the destination and next destination used into the result (used by the caller to verify the result matches their request)
             avoidance_result.destination = avoidance_request2.destination;
             avoidance_result.next_destination = avoidance_request2.next_destination;
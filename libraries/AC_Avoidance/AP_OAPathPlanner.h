@@ -94,6 +94,13 @@ private:
     // helper function to map OABendyType to OAPathPlannerUsed
     OAPathPlannerUsed map_bendytype_to_pathplannerused(AP_OABendyRuler::OABendyType bendy_type);
 
+    // logging of path planner timing
+#if HAL_LOGGING_ENABLED
+    void Write_OAPathPlanner(const OA_RetState result, const OAPathPlannerUsed planner_used, const bool new_request, const uint32_t run_time_us, const uint32_t latency_ms, const uint32_t stale_ms) const;
+#else
+    void Write_OAPathPlanner(const OA_RetState result, const OAPathPlannerUsed planner_used, const bool new_request, const uint32_t run_time_us, const uint32_t latency_ms, const uint32_t stale_ms) const {}
+#endif
+
     // an avoidance request from the navigation code
     struct avoidance_info {
         Location current_loc;
@@ -121,6 +128,7 @@ private:
     AP_Int8 _type;                  // avoidance algorithm to be used
     AP_Float _margin_max;           // object avoidance will ignore objects more than this many meters from vehicle
     AP_Int16 _options;              // Bitmask for options while recovering from Object Avoidance
+    AP_Int8 _cpu_pct;               // percentage of time the path planners may use
     
     // internal variables used by front end
     HAL_Semaphore _rsem;            // semaphore for multi-thread use of avoidance_request and avoidance_result
@@ -129,6 +137,8 @@ private:
     AP_OADijkstra *_oadijkstra;     // Dijkstra's algorithm
     AP_OADatabase _oadatabase;      // Database of dynamic objects to avoid
     uint32_t avoidance_latest_ms;   // last time Dijkstra's or BendyRuler algorithms ran (in the avoidance thread)
+    uint32_t avoidance_hold_ms;     // time after avoidance_latest_ms the planners must wait to keep within their CPU budget
+    uint32_t database_update_ms;    // last time the database was updated (in the avoidance thread)
     uint32_t _last_update_ms;       // system time that mission_avoidance was called in main thread
     uint32_t _activated_ms;         // system time that object avoidance was most recently activated (used to avoid timeout error on first run)
 
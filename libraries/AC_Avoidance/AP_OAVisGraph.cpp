@@ -20,8 +20,9 @@
 #include "AP_OAVisGraph.h"
 
 // constructor initialises expanding array to use 20 elements per chunk
+// items are kept in one block where possible as the graph is scanned linearly
 AP_OAVisGraph::AP_OAVisGraph() :
-    _items(20)
+    _items(20, AP_ExpandingArrayGeneric::Growth::CONTIGUOUS)
 {
 }
 
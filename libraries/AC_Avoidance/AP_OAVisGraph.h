@@ -6,6 +6,7 @@
 
 #include <AP_Common/AP_Common.h>
 #include <AP_Common/AP_ExpandingArray.h>
+#include <AP_Math/AP_Math.h>
 
 /*
  * Visibility graph used by Dijkstra's algorithm for path planning around fence, stay-out zones and moving obstacles
@@ -43,6 +44,9 @@ public:
     // clear all elements from graph
     void clear() { _num_items = 0; }
 
+    // keep only the first num items in the graph
+    void truncate(uint16_t num) { _num_items = MIN(num, _num_items); }
+
     // get number of items in visibility graph table
     uint16_t num_items() const { return _num_items; }
 
@@ -53,6 +57,13 @@ public:
     // Note: no protection against out-of-bounds accesses so use with num_items()
     const VisGraphItem& operator[](uint16_t i) const { return _items[i]; }
 
+    // range of all items, for example: for (const VisGraphItem &item : visgraph.items())
+    AP_ExpandingArray<VisGraphItem>::range<const VisGraphItem> items() const { return _items.items(_num_items); }
+
+    // replace an item already in the graph
+    // Note: no protection against out-of-bounds accesses so use with num_items()
+    void set_item(uint16_t i, const OAItemID &id1, const OAItemID &id2, float distance_cm) { _items[i] = {id1, id2, distance_cm}; }
+
 private:
 
     AP_ExpandingArray<VisGraphItem> _items;
@@ -0,0 +1,454 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AC_Avoidance_config.h"
+
+#if AP_OAVOXELMAP_ENABLED
+
+#include "AP_OAVoxelMap.h"
+
+#include <AP_Common/Location.h>
+#include <GCS_MAVLink/GCS.h>
+
+#define AP_OAVOXELMAP_LOG_ODDS_HIT          8       // log odds added to the voxel holding an obstacle
+#define AP_OAVOXELMAP_LOG_ODDS_MISS         2       // log odds subtracted from voxels a sensor ray passed through
+#define AP_OAVOXELMAP_LOG_ODDS_MAX          40      // upper limit of log odds so obstacles which move away are forgotten quickly enough
+#define AP_OAVOXELMAP_RAYS_PER_UPDATE       50      // maximum number of readings added to the map on each update
+#define AP_OAVOXELMAP_RAY_STEPS_MAX         1024    // maximum number of voxels a ray can cross
+#define AP_OAVOXELMAP_AGE_SLOTS             64      // number of slots visited on each update when the map is nearly full
+#define AP_OAVOXELMAP_SEND_SCAN_MAX         128     // maximum number of slots checked each time voxels are sent to the GCS
+#define AP_OAVOXELMAP_SLOTS_MAX             32768   // maximum number of slots in the hash table
+
+// allocate space for up to num_voxels voxels of resolution meters and a queue of queue_size readings
+// returns false if the memory could not be allocated
+bool AP_OAVoxelMap::init(uint16_t num_voxels, float resolution, uint16_t queue_size)
+{
+    if ((num_voxels == 0) || (queue_size == 0)) {
+        return false;
+    }
+
+    // keep at least a quarter of the slots empty so searches stay short
+    uint32_t num_slots = 2;
+    while ((num_slots < (uint32_t)num_voxels + num_voxels / 3 + 1) && (num_slots < AP_OAVOXELMAP_SLOTS_MAX)) {
+        num_slots <<= 1;
+    }
+    _size = MIN((uint32_t)num_voxels, (num_slots * 3) / 4);
+    _mask = num_slots - 1;
+    _resolution = MAX(resolution, 0.1f);
+    _inv_resolution = 1.0f / _resolution;
+
+    // all voxels are allocated up front so nothing is allocated or freed while flying
+    _voxels = NEW_NOTHROW Voxel[num_slots];
+    _rays = NEW_NOTHROW ObjectBuffer_SPSC<Ray>(queue_size);
+    if ((_voxels == nullptr) || (_rays == nullptr) || (_rays->get_size() == 0)) {
+        delete[] _voxels;
+        delete _rays;
+        _voxels = nullptr;
+        _rays = nullptr;
+        return false;
+    }
+    memset(_voxels, 0, num_slots * sizeof(Voxel));
+    _count = 0;
+    return true;
+}
+
+// queue a reading of an obstacle at end from a sensor at origin
+// positions are offsets in meters from the EKF origin (NEU)
+void AP_OAVoxelMap::queue_ray(const Vector3f &origin, const Vector3f &end)
+{
+    if (!healthy()) {
+        return;
+    }
+    _rays->push(Ray{origin, end});
+}
+
+// add queued readings to the map
+void AP_OAVoxelMap::update()
+{
+    if (!healthy()) {
+        return;
+    }
+
+    // a fixed number of readings is added so that a burst of readings can't stall the path planner
+    const uint16_t num_rays = MIN(_rays->available(), (uint32_t)AP_OAVOXELMAP_RAYS_PER_UPDATE);
+    for (uint16_t i=0; i<num_rays; i++) {
+        Ray ray;
+        if (!_rays->pop(ray)) {
+            break;
+        }
+        insert_ray(ray.origin, ray.end);
+    }
+
+    age_voxels();
+}
+
+// add a reading to the map
+void AP_OAVoxelMap::insert_ray(const Vector3f &origin, const Vector3f &end)
+{
+    RayWalker walker;
+    if (!walker.init(origin, end, _inv_resolution)) {
+        return;
+    }
+    const int16_t end_x = voxel_coord(end.x);
+    const int16_t end_y = voxel_coord(end.y);
+    const int16_t end_z = voxel_coord(end.z);
+
+    // the ray passed through every voxel before the obstacle so lower their odds of being occupied.
+    // Voxels not in the map are already assumed to be clear
+    int16_t x, y, z;
+    while (walker.next(x, y, z)) {
+        if ((x == end_x) && (y == end_y) && (z == end_z)) {
+            break;
+        }
+        const int32_t slot = slot_find(x, y, z);
+        if (slot >= 0) {
+            Voxel &voxel = _voxels[slot];
+            if (voxel.log_odds <= AP_OAVOXELMAP_LOG_ODDS_MISS) {
+                slot_remove(slot);
+            } else {
+                voxel.log_odds -= AP_OAVOXELMAP_LOG_ODDS_MISS;
+            }
+        }
+    }
+
+    // raise the odds of the voxel holding the obstacle, the reading is lost if the map is full
+    const int32_t slot = slot_find(end_x, end_y, end_z);
+    if (slot >= 0) {
+        Voxel &voxel = _voxels[slot];
+        voxel.log_odds = MIN(voxel.log_odds + AP_OAVOXELMAP_LOG_ODDS_HIT, AP_OAVOXELMAP_LOG_ODDS_MAX);
+    } else {
+        slot_add(end_x, end_y, end_z, AP_OAVOXELMAP_LOG_ODDS_HIT);
+    }
+}
+
+// forget voxels which have not been seen recently when the map is nearly full
+// a few slots are visited on each call, lowering their odds so voxels which
+// are not seen again are removed and voxels which are still seen survive
+void AP_OAVoxelMap::age_voxels()
+{
+    if (_count < (_size * 3) / 4) {
+        return;
+    }
+    for (uint16_t i=0; i<AP_OAVOXELMAP_AGE_SLOTS; i++) {
+        Voxel &voxel = _voxels[_age_index];
+        if (voxel.log_odds == 1) {
+            // removal may move another voxel into this slot so visit it again
+            slot_remove(_age_index);
+            continue;
+        }
+        if (voxel.log_odds > 1) {
+            voxel.log_odds--;
+        }
+        _age_index = (_age_index + 1) & _mask;
+    }
+}
+
+// returns the slot at which the search for a voxel starts
+uint16_t AP_OAVoxelMap::slot_home(int16_t x, int16_t y, int16_t z) const
+{
+    const uint32_t hash = ((uint32_t)x * 73856093U) ^ ((uint32_t)y * 19349663U) ^ ((uint32_t)z * 83492791U);
+    return hash & _mask;
+}
+
+// returns slot holding a voxel or -1 if it is not in the map
+int32_t AP_OAVoxelMap::slot_find(int16_t x, int16_t y, int16_t z) const
+{
+    // the table always has an empty slot so this ends
+    for (uint16_t slot=slot_home(x, y, z); _voxels[slot].log_odds != 0; slot=(slot+1) & _mask) {
+        const Voxel &voxel = _voxels[slot];
+        if ((voxel.x == x) && (voxel.y == y) && (voxel.z == z)) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+// add a voxel which is not already in the map
+// returns its slot or -1 if the map is full
+int32_t AP_OAVoxelMap::slot_add(int16_t x, int16_t y, int16_t z, int8_t log_odds)
+{
+    if (_count >= _size) {
+        return -1;
+    }
+    uint16_t slot = slot_home(x, y, z);
+    while (_voxels[slot].log_odds != 0) {
+        slot = (slot + 1) & _mask;
+    }
+    _voxels[slot] = Voxel{x, y, z, log_odds};
+    _count++;
+    return slot;
+}
+
+// remove the voxel in a slot
+// voxels after it whose search passes through the slot are moved back so no search stops early
+void AP_OAVoxelMap::slot_remove(uint16_t slot)
+{
+    uint16_t empty = slot;
+    uint16_t next = slot;
+    while (true) {
+        next = (next + 1) & _mask;
+        const Voxel &voxel = _voxels[next];
+        if (voxel.log_odds == 0) {
+            break;
+        }
+        // voxel can stay if its home lies cyclically within (empty, next]
+        const uint16_t home = slot_home(voxel.x, voxel.y, voxel.z);
+        const bool stays = (empty <= next) ? ((empty < home) && (home <= next)) : ((empty < home) || (home <= next));
+        if (!stays) {
+            _voxels[empty] = voxel;
+            empty = next;
+        }
+    }
+    _voxels[empty].log_odds = 0;
+    _count--;
+}
+
+// returns center of a voxel
+Vector3f AP_OAVoxelMap::voxel_center(const Voxel &voxel) const
+{
+    return Vector3f{(voxel.x + 0.5f) * _resolution, (voxel.y + 0.5f) * _resolution, (voxel.z + 0.5f) * _resolution};
+}
+
+// returns true if pos lies within an occupied voxel
+bool AP_OAVoxelMap::is_occupied(const Vector3f &pos) const
+{
+    if (!healthy()) {
+        return false;
+    }
+    const int32_t x = voxel_coord(pos.x);
+    const int32_t y = voxel_coord(pos.y);
+    const int32_t z = voxel_coord(pos.z);
+    if ((x <= INT16_MIN) || (x >= INT16_MAX) || (y <= INT16_MIN) || (y >= INT16_MAX) || (z <= INT16_MIN) || (z >= INT16_MAX)) {
+        return false;
+    }
+    return slot_find(x, y, z) >= 0;
+}
+
+// returns true if the line segment between start and end passes through no occupied voxel
+bool AP_OAVoxelMap::segment_clear(const Vector3f &start, const Vector3f &end) const
+{
+    if (!healthy() || (_count == 0)) {
+        return true;
+    }
+
+    RayWalker walker;
+    if (walker.init(start, end, _inv_resolution)) {
+        int16_t x, y, z;
+        while (walker.next(x, y, z)) {
+            if (slot_find(x, y, z) >= 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // segment is too long to step along so check every voxel
+    // using the sphere around each voxel
+    const float radius = _resolution * 0.866f;
+    for (uint32_t slot=0; slot<=_mask; slot++) {
+        if ((_voxels[slot].log_odds != 0) &&
+            (Vector3f::closest_distance_between_line_and_point(start, end, voxel_center(_voxels[slot])) < radius)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// calculate minimum distance between each line segment of a fan and the occupied voxels
+// each voxel is treated as the sphere around it
+// returns false if the map is empty
+bool AP_OAVoxelMap::get_closest_margins(const SegmentFan &segments, float margins[]) const
+{
+    if (!healthy() || (_count == 0) || (segments.count() == 0)) {
+        return false;
+    }
+
+    const float radius = _resolution * 0.866f;
+
+    // bounds of segments
+    Vector3f seg_min = segments.start();
+    Vector3f seg_max = segments.start();
+    for (uint8_t i=0; i<segments.count(); i++) {
+        const Vector3f seg_end = segments.end(i);
+        for (uint8_t j=0; j<3; j++) {
+            seg_min[j] = MIN(seg_min[j], seg_end[j]);
+            seg_max[j] = MAX(seg_max[j], seg_end[j]);
+        }
+    }
+
+    // search the voxels in a box around the segments, doubling its size until the
+    // closest voxel found to each segment is closer than any voxel outside the box could be
+    float search_dist = _resolution;
+    while (true) {
+        const float expand = search_dist + radius;
+        const Vector3f min = seg_min - Vector3f(expand, expand, expand);
+        const Vector3f max = seg_max + Vector3f(expand, expand, expand);
+        const int32_t min_x = MAX(voxel_coord(min.x), INT16_MIN + 1);
+        const int32_t min_y = MAX(voxel_coord(min.y), INT16_MIN + 1);
+        const int32_t min_z = MAX(voxel_coord(min.z), INT16_MIN + 1);
+        const int32_t max_x = MIN(voxel_coord(max.x), INT16_MAX - 1);
+        const int32_t max_y = MIN(voxel_coord(max.y), INT16_MAX - 1);
+        const int32_t max_z = MIN(voxel_coord(max.z), INT16_MAX - 1);
+
+        // stop once the box holds more voxels than the map
+        const float num_cells = (float)(max_x - min_x + 1) * (float)(max_y - min_y + 1) * (float)(max_z - min_z + 1);
+        if (num_cells > _count) {
+            break;
+        }
+        for (uint8_t i=0; i<segments.count(); i++) {
+            margins[i] = FLT_MAX;
+        }
+        for (int32_t x=min_x; x<=max_x; x++) {
+            for (int32_t y=min_y; y<=max_y; y++) {
+                for (int32_t z=min_z; z<=max_z; z++) {
+                    const int32_t slot = slot_find(x, y, z);
+                    if (slot >= 0) {
+                        segments.update_margins(voxel_center(_voxels[slot]), radius, margins);
+                    }
+                }
+            }
+        }
+        // voxels outside the box are more than expand from every segment
+        bool all_found = true;
+        for (uint8_t i=0; i<segments.count(); i++) {
+            all_found &= (margins[i] <= search_dist);
+        }
+        if (all_found) {
+            return true;
+        }
+        search_dist *= 2.0f;
+    }
+
+    // check each voxel's distance from the segments
+    for (uint8_t i=0; i<segments.count(); i++) {
+        margins[i] = FLT_MAX;
+    }
+    for (uint32_t slot=0; slot<=_mask; slot++) {
+        if (_voxels[slot].log_odds != 0) {
+            segments.update_margins(voxel_center(_voxels[slot]), radius, margins);
+        }
+    }
+    return true;
+}
+
+#if HAL_GCS_ENABLED
+// send occupied voxels as ADSB_VEHICLE mavlink messages with ids starting from id_offset
+// returns the number of messages sent, which will be no more than max_to_send
+uint16_t AP_OAVoxelMap::send_adsb_vehicle(mavlink_channel_t chan, uint16_t id_offset, uint16_t max_to_send)
+{
+    if (!healthy()) {
+        return 0;
+    }
+
+    const char callsign[9] = "OA_VOX";
+    uint16_t num_sent = 0;
+    for (uint16_t i=0; (i<AP_OAVOXELMAP_SEND_SCAN_MAX) && (num_sent<max_to_send); i++) {
+        if (!HAVE_PAYLOAD_SPACE(chan, ADSB_VEHICLE)) {
+            break;
+        }
+
+        const uint16_t slot = _next_index_to_send[chan] & _mask;
+        _next_index_to_send[chan] = (slot + 1) & _mask;
+
+        const Voxel &voxel = _voxels[slot];
+        if (voxel.log_odds == 0) {
+            continue;
+        }
+
+        // convert voxel's position as an offset from EKF origin to Location
+        const Vector3f pos = voxel_center(voxel);
+        const Location voxel_loc(Vector3f(pos.x * 100.0f, pos.y * 100.0f, pos.z * 100.0f), Location::AltFrame::ABOVE_ORIGIN);
+
+        mavlink_msg_adsb_vehicle_send(chan,
+            (uint32_t)id_offset + slot,
+            voxel_loc.lat,
+            voxel_loc.lng,
+            0,                          // altitude_type
+            voxel_loc.alt,
+            0,                          // heading
+            0,                          // hor_velocity
+            0,                          // ver_velocity
+            callsign,                   // callsign
+            255,                        // emitter_type
+            0,                          // tslc
+            0,                          // flags
+            (uint16_t)(_resolution * 50.0f));   // squawk, half the voxel size in cm
+
+        num_sent++;
+    }
+    return num_sent;
+}
+#endif  // HAL_GCS_ENABLED
+
+// start stepping through the voxels crossed by a line segment
+// returns false if the segment is outside the range of voxel coordinates or crosses too many voxels
+bool AP_OAVoxelMap::RayWalker::init(const Vector3f &start, const Vector3f &end, float inv_resolution)
+{
+    const Vector3f s = start * inv_resolution;
+    const Vector3f e = end * inv_resolution;
+    uint32_t steps = 0;
+    for (uint8_t j=0; j<3; j++) {
+        if ((fabsf(s[j]) >= INT16_MAX - 1) || (fabsf(e[j]) >= INT16_MAX - 1)) {
+            return false;
+        }
+        _pos[j] = (int32_t)floorf(s[j]);
+        const int32_t end_pos = (int32_t)floorf(e[j]);
+        const float d = e[j] - s[j];
+        if (end_pos > _pos[j]) {
+            _step[j] = 1;
+            _t_delta[j] = 1.0f / d;
+            _t_max[j] = (_pos[j] + 1 - s[j]) * _t_delta[j];
+        } else if (end_pos < _pos[j]) {
+            _step[j] = -1;
+            _t_delta[j] = -1.0f / d;
+            _t_max[j] = (s[j] - _pos[j]) * _t_delta[j];
+        } else {
+            // never crosses a boundary along this axis
+            _step[j] = 0;
+            _t_delta[j] = FLT_MAX;
+            _t_max[j] = FLT_MAX;
+        }
+        steps += abs(end_pos - _pos[j]);
+    }
+    if (steps >= AP_OAVOXELMAP_RAY_STEPS_MAX) {
+        return false;
+    }
+    _steps_left = steps + 1;
+    return true;
+}
+
+// get the current voxel and move to the next one crossed by the segment
+// returns false once the voxel holding the end of the segment has been passed
+bool AP_OAVoxelMap::RayWalker::next(int16_t &x, int16_t &y, int16_t &z)
+{
+    if (_steps_left == 0) {
+        return false;
+    }
+    x = _pos[0];
+    y = _pos[1];
+    z = _pos[2];
+    _steps_left--;
+
+    // step across the closest voxel boundary
+    uint8_t axis = (_t_max[0] < _t_max[1]) ? 0 : 1;
+    if (_t_max[2] < _t_max[axis]) {
+        axis = 2;
+    }
+    _pos[axis] += _step[axis];
+    _t_max[axis] += _t_delta[axis];
+    return true;
+}
+
+#endif  // AP_OAVOXELMAP_ENABLED
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "AC_Avoidance_config.h"
+
+#if AP_OAVOXELMAP_ENABLED
+
+#include <AP_Common/AP_Common.h>
+#include <AP_HAL/utility/RingBuffer.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/segment_fan.h>
+#include <GCS_MAVLink/GCS_MAVLink.h>
+
+/*
+ * Sparse 3D occupancy map of obstacles seen by range sensors.
+ *
+ * Space is divided into cubes (voxels) which hold a log-odds
+ * estimate of being occupied. A reading adds to the voxel holding
+ * the obstacle and subtracts from the voxels the sensor ray passed
+ * through, so obstacles persist until they are seen to be gone.
+ * Only voxels which may be occupied are stored, in an open
+ * addressing hash table allocated once at startup so the map's
+ * memory use is fixed and it never touches the heap while flying.
+ */
+class AP_OAVoxelMap {
+public:
+    AP_OAVoxelMap() {}
+
+    CLASS_NO_COPY(AP_OAVoxelMap);  /* Do not allow copies */
+
+    // allocate space for up to num_voxels voxels of resolution meters and a queue of queue_size readings
+    // returns false if the memory could not be allocated
+    bool init(uint16_t num_voxels, float resolution, uint16_t queue_size);
+
+    // returns true if the map has been allocated
+    bool healthy() const { return (_voxels != nullptr) && (_rays != nullptr); }
+
+    // queue a reading of an obstacle at end from a sensor at origin
+    // positions are offsets in meters from the EKF origin (NEU)
+    // called from the main thread
+    void queue_ray(const Vector3f &origin, const Vector3f &end);
+
+    // add queued readings to the map, called from the path planner thread
+    void update();
+
+    // number of voxels in the map
+    uint16_t count() const { return _count; }
+
+    // returns true if pos lies within an occupied voxel
+    bool is_occupied(const Vector3f &pos) const;
+
+    // returns true if the line segment between start and end passes through no occupied voxel
+    bool segment_clear(const Vector3f &start, const Vector3f &end) const;
+
+    // calculate minimum distance between each line segment of a fan and the occupied voxels
+    // returns false if the map is empty
+    bool get_closest_margins(const SegmentFan &segments, float margins[]) const;
+
+#if HAL_GCS_ENABLED
+    // send occupied voxels as ADSB_VEHICLE mavlink messages with ids starting from id_offset
+    // returns the number of messages sent, which will be no more than max_to_send
+    uint16_t send_adsb_vehicle(mavlink_channel_t chan, uint16_t id_offset, uint16_t max_to_send);
+#endif
+
+private:
+
+    struct Voxel {
+        int16_t x;          // voxel coordinates, position divided by resolution
+        int16_t y;
+        int16_t z;
+        int8_t log_odds;    // log odds of being occupied, zero for an unused slot
+    };
+
+    struct Ray {
+        Vector3f origin;
+        Vector3f end;
+    };
+
+    // steps through the voxels crossed by a line segment in order from its start
+    class RayWalker {
+    public:
+        // returns false if the segment is outside the range of voxel coordinates or crosses too many voxels
+        bool init(const Vector3f &start, const Vector3f &end, float inv_resolution);
+
+        // get the current voxel, returns false once the voxel holding the end of the segment has been passed
+        bool next(int16_t &x, int16_t &y, int16_t &z);
+
+    private:
+        int32_t _pos[3];        // current voxel
+        int8_t _step[3];        // direction to step along each axis
+        float _t_max[3];        // proportion along segment at which the next voxel boundary along each axis is crossed
+        float _t_delta[3];      // proportion along segment between voxel boundaries along each axis
+        uint16_t _steps_left;   // number of voxels left to visit
+    };
+
+    // add a reading to the map
+    void insert_ray(const Vector3f &origin, const Vector3f &end);
+
+    // hash table management
+    uint16_t slot_home(int16_t x, int16_t y, int16_t z) const;
+    int32_t slot_find(int16_t x, int16_t y, int16_t z) const;
+    int32_t slot_add(int16_t x, int16_t y, int16_t z, int8_t log_odds);
+    void slot_remove(uint16_t slot);
+
+    // forget voxels which have not been seen recently when the map is nearly full
+    void age_voxels();
+
+    // returns voxel coordinate of a position along one axis, not limited to the range of voxel coordinates
+    int32_t voxel_coord(float pos) const { return (int32_t)floorf(pos * _inv_resolution); }
+
+    // returns center of a voxel
+    Vector3f voxel_center(const Voxel &voxel) const;
+
+    Voxel *_voxels;                 // hash table of voxels
+    uint16_t _mask;                 // number of slots minus one, the number of slots is a power of two
+    uint16_t _size;                 // maximum number of voxels
+    uint16_t _count;                // number of voxels in the table
+    uint16_t _age_index;            // next slot to be visited by age_voxels
+    float _resolution;              // length in meters of each side of a voxel
+    float _inv_resolution;          // inverse of _resolution
+    ObjectBuffer_SPSC<Ray> *_rays;  // readings waiting to be added to the map
+
+#if HAL_GCS_ENABLED
+    uint16_t _next_index_to_send[MAVLINK_COMM_NUM_BUFFERS]; // index of next slot to check for sending to GCS
+#endif
+};
+
+#endif  // AP_OAVOXELMAP_ENABLED
@@ -7,7 +7,8 @@
     LOG_OA_BENDYRULER_MSG, \
     LOG_OA_DIJKSTRA_MSG, \
     LOG_SIMPLE_AVOID_MSG, \
-    LOG_OD_VISGRAPH_MSG
+    LOG_OD_VISGRAPH_MSG, \
+    LOG_OA_PLANNER_MSG
 
 // @LoggerMessage: OABR
 // @Description: Object avoidance (Bendy Ruler) diagnostics
@@ -107,6 +108,26 @@ struct PACKED log_OD_Visgraph {
   int32_t Lon;
 };
 
+// @LoggerMessage: OAPP
+// @Description: Object avoidance path planner timing
+// @Field: TimeUS: Time since system startup
+// @Field: Res: Result of the path planners
+// @Field: Used: Path planner that produced the result
+// @Field: New: True if the planners ran early for a new destination
+// @Field: RunT: Time taken by the path planners
+// @Field: Lat: Age of the request when its result was published
+// @Field: Stale: Time since the previous result was published
+struct PACKED log_OAPathPlanner {
+  LOG_PACKET_HEADER;
+  uint64_t time_us;
+  uint8_t result;
+  uint8_t planner_used;
+  uint8_t new_request;
+  uint32_t run_time_us;
+  uint32_t latency_ms;
+  uint32_t stale_ms;
+};
+
 #if AP_AVOIDANCE_ENABLED
 #define LOG_STRUCTURE_FROM_AVOIDANCE \
     { LOG_OA_BENDYRULER_MSG, sizeof(log_OABendyRuler), \
@@ -116,7 +137,9 @@ struct PACKED log_OD_Visgraph {
     { LOG_SIMPLE_AVOID_MSG, sizeof(log_SimpleAvoid), \
       "SA",  "QBffffffB","TimeUS,State,DVelX,DVelY,DVelZ,MVelX,MVelY,MVelZ,Back", "s-nnnnnn-", "F--------", true }, \
      { LOG_OD_VISGRAPH_MSG, sizeof(log_OD_Visgraph), \
-      "OAVG", "QBBLL", "TimeUS,version,point_num,Lat,Lon", "s--DU", "F--GG", true},
+      "OAVG", "QBBLL", "TimeUS,version,point_num,Lat,Lon", "s--DU", "F--GG", true}, \
+    { LOG_OA_PLANNER_MSG, sizeof(log_OAPathPlanner), \
+      "OAPP", "QBBBIII", "TimeUS,Res,Used,New,RunT,Lat,Stale", "s---sss", "F---FCC", true },
 #else
 #define LOG_STRUCTURE_FROM_AVOIDANCE
 #endif // AP_AVOIDANCE_ENABLED
@@ -26,6 +26,11 @@
 #define Debug(fmt, args ...)
 #endif
 
+// distance outside the bounds of a polygon beyond which we take a
+// point to be outside the polygon without checking, allowing for the
+// difference between the lat/lon and offset from origin points
+#define POLYFENCE_BOUNDS_TOLERANCE_CM 10
+
 extern const AP_HAL::HAL& hal;
 
 static StorageAccess fence_storage(StorageManager::StorageFence);
@@ -251,7 +256,9 @@ bool AC_PolyFence_loader::breached(const Location& loc, float& distance_outside_
         float distance;
         bool valid_distance = Polygon_closest_distance_point(boundary.points, boundary.count, scaled_pos, distance);
         distance *= 0.01f; // convert back to meters
-        if (Polygon_outside(pos, boundary.points_lla, boundary.count)) {
+        // well outside the bounds is outside the polygon
+        const bool outside_bounds = boundary.bounds.distance(scaled_pos) > POLYFENCE_BOUNDS_TOLERANCE_CM;
+        if (outside_bounds || Polygon_outside(pos, boundary.points_lla, boundary.count)) {
             num_inclusion_outside++;
             if (valid_distance) {
                 if (is_positive(distance_outside_fence)) {
@@ -268,6 +275,13 @@ bool AC_PolyFence_loader::breached(const Location& loc, float& distance_outside_
     // check we are outside each exclusion zone:
     for (uint8_t i=0; i<_num_loaded_exclusion_boundaries; i++) {
         const ExclusionBoundary &boundary = _loaded_exclusion_boundary[i];
+        const float bounds_distance = boundary.bounds.distance(scaled_pos);
+        if (bounds_distance > POLYFENCE_BOUNDS_TOLERANCE_CM &&
+            -bounds_distance * 0.01f <= distance_outside_fence) {
+            // outside this zone and further from it than from a zone
+            // already checked, so it can't change the result
+            continue;
+        }
         float distance;
         bool valid_distance = Polygon_closest_distance_point(boundary.points, boundary.count, scaled_pos, distance);
         distance *= 0.01f; // convert back to meters
@@ -784,6 +798,7 @@ bool AC_PolyFence_loader::load_from_storage()
                 storage_valid = false;
                 break;
             }
+            Polygon_bounds(boundary.points, boundary.count, boundary.bounds);
             _num_loaded_inclusion_boundaries++;
             break;
         }
@@ -803,6 +818,7 @@ bool AC_PolyFence_loader::load_from_storage()
                 storage_valid = false;
                 break;
             }
+            Polygon_bounds(boundary.points, boundary.count, boundary.bounds);
             _num_loaded_exclusion_boundaries++;
             break;
         }
@@ -926,6 +942,16 @@ Vector2f* AC_PolyFence_loader::get_exclusion_polygon(uint16_t index, uint16_t &n
     return boundary.points;
 }
 
+/// returns the bounds of an exclusion polygon
+bool AC_PolyFence_loader::get_exclusion_polygon_bounds(uint16_t index, Polygon_Bounds &bounds) const
+{
+    if (index >= _num_loaded_exclusion_boundaries) {
+        return false;
+    }
+    bounds = _loaded_exclusion_boundary[index].bounds;
+    return true;
+}
+
 /// returns pointer to array of inclusion polygon points and num_points is filled in with the number of points in the polygon
 /// points are offsets in cm from EKF origin in NE frame
 Vector2f* AC_PolyFence_loader::get_inclusion_polygon(uint16_t index, uint16_t &num_points) const
@@ -940,6 +966,16 @@ Vector2f* AC_PolyFence_loader::get_inclusion_polygon(uint16_t index, uint16_t &n
     return boundary.points;
 }
 
+/// returns the bounds of an inclusion polygon
+bool AC_PolyFence_loader::get_inclusion_polygon_bounds(uint16_t index, Polygon_Bounds &bounds) const
+{
+    if (index >= _num_loaded_inclusion_boundaries) {
+        return false;
+    }
+    bounds = _loaded_inclusion_boundary[index].bounds;
+    return true;
+}
+
 /// returns the specified exclusion circle
 /// circle center offsets in cm from EKF origin in NE frame, radius is in meters
 bool AC_PolyFence_loader::get_exclusion_circle(uint8_t index, Vector2f &center_pos_cm, float &radius) const
@@ -1698,6 +1734,8 @@ bool AC_PolyFence_loader::get_item(const uint16_t seq, AC_PolyFenceItem &item) {
 
 Vector2f* AC_PolyFence_loader::get_exclusion_polygon(uint16_t index, uint16_t &num_points) const { return nullptr; }
 Vector2f* AC_PolyFence_loader::get_inclusion_polygon(uint16_t index, uint16_t &num_points) const { return nullptr; }
+bool AC_PolyFence_loader::get_exclusion_polygon_bounds(uint16_t index, Polygon_Bounds &bounds) const { return false; }
+bool AC_PolyFence_loader::get_inclusion_polygon_bounds(uint16_t index, Polygon_Bounds &bounds) const { return false; }
 
 bool AC_PolyFence_loader::get_exclusion_circle(uint8_t index, Vector2f &center_pos_cm, float &radius) const { return false; }
 bool AC_PolyFence_loader::get_inclusion_circle(uint8_t index, Vector2f &center_pos_cm, float &radius) const { return false; }
@@ -83,6 +83,9 @@ public:
     /// points are offsets in cm from EKF origin in NE frame
     Vector2f* get_exclusion_polygon(uint16_t index, uint16_t &num_points) const;
 
+    /// returns the bounds of an exclusion polygon, in cm from EKF origin in NE frame
+    bool get_exclusion_polygon_bounds(uint16_t index, Polygon_Bounds &bounds) const;
+
     /// return system time of last update to the exclusion polygon points
     uint32_t get_exclusion_polygon_update_ms() const {
         return _load_time_ms;
@@ -100,6 +103,9 @@ public:
     /// points are offsets in cm from EKF origin in NE frame
     Vector2f* get_inclusion_polygon(uint16_t index, uint16_t &num_points) const;
 
+    /// returns the bounds of an inclusion polygon, in cm from EKF origin in NE frame
+    bool get_inclusion_polygon_bounds(uint16_t index, Polygon_Bounds &bounds) const;
+
     /// return system time of last update to the inclusion polygon points
     uint32_t get_inclusion_polygon_update_ms() const {
         return _load_time_ms;
@@ -306,6 +312,7 @@ private:
         Vector2f *points; // pointer into the _loaded_offsets_from_origin array
         Vector2l *points_lla; // pointer into the _loaded_points_lla array
         uint8_t count; // count of points in the boundary
+        Polygon_Bounds bounds; // bounding box of points
     };
     InclusionBoundary *_loaded_inclusion_boundary;
 
@@ -316,6 +323,7 @@ private:
         Vector2f *points; // pointer into the _loaded_offsets_from_origin array
         Vector2l *points_lla; // pointer into the _loaded_points_lla_lla array
         uint8_t count; // count of points in the boundary
+        Polygon_Bounds bounds; // bounding box of points
     };
     ExclusionBoundary *_loaded_exclusion_boundary;
 
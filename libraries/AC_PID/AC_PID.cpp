@@ -194,6 +194,17 @@ void AC_PID::set_notch_sample_rate(float sample_rate)
 // Applies filters to the target and error, calculates the derivative and updates the integrator.
 // If `limit` is true, the integrator is allowed to shrink but not grow.
 float AC_PID::update_all(float target, float measurement, float dt, bool limit, float pd_scale)
+{
+    const FilterAlphas alpha {
+        get_filt_T_alpha(dt),
+        get_filt_E_alpha(dt),
+        is_positive(dt) ? get_filt_D_alpha(dt) : 0.0f
+    };
+    return update_all(target, measurement, dt, alpha, limit, pd_scale);
+}
+
+// Computes the PID output as above, using filter alphas calculated by the caller for dt.
+float AC_PID::update_all(float target, float measurement, float dt, const FilterAlphas &alpha, bool limit, float pd_scale)
 {
     // Return zero if input is invalid (NaN or infinite)
     if (!isfinite(target) || !isfinite(measurement)) {
@@ -239,7 +250,7 @@ float AC_PID::update_all(float target, float measurement, float dt, bool limit,
         }
 #endif
         // Apply first-order low-pass filter to target value
-        _target += get_filt_T_alpha(dt) * (target - _target);
+        _target += alpha.T * (target - _target);
 
         // Calculate error and apply error filter
         const float error_last = _error;
@@ -251,12 +262,12 @@ float AC_PID::update_all(float target, float measurement, float dt, bool limit,
         }
 #endif
         // apply notch filters before FTLD/FLTE to minimize shot noise
-        _error += get_filt_E_alpha(dt) * (error - _error);
+        _error += alpha.E * (error - _error);
 
         if (is_positive(dt)) {
             // Compute and low-pass filter the error derivative (D term)
             float derivative = (_error - error_last) / dt;
-            _derivative += get_filt_D_alpha(dt) * (derivative - _derivative);
+            _derivative += alpha.D * (derivative - _derivative);
             // Calculate target derivative for D_FF contribution
             _target_derivative = (_target - target_last) / dt;
         }
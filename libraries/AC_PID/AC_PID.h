@@ -64,6 +64,17 @@ public:
     // If `limit` is true, the integrator is allowed to shrink but not grow.
     float update_all(float target, float measurement, float dt, bool limit = false, float pd_scale = 1.0f);
 
+    // low-pass filter alphas of the target, error and derivative filters for a given dt
+    struct FilterAlphas {
+        float T;
+        float E;
+        float D;
+    };
+
+    // As update_all() above, with the filter alphas for dt already calculated by the caller.
+    // Used by AC_PID_Bank to avoid recalculating them on every update.
+    float update_all(float target, float measurement, float dt, const FilterAlphas &alpha, bool limit = false, float pd_scale = 1.0f);
+
     // Computes the PID output from an error input only (target assumed to be zero).
     // Applies error filtering and updates the derivative and integrator.
     // Target and measurement must be set separately for logging.
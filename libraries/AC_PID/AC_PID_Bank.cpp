@@ -0,0 +1,56 @@
+/// @file	AC_PID_Bank.cpp
+/// @brief	Group of AC_PID controllers updated together, with their filter alphas cached per dt.
+
+#include <AP_Math/AP_Math.h>
+#include "AC_PID_Bank.h"
+
+template <uint8_t N>
+AC_PID_Bank<N>::AC_PID_Bank(AC_PID *const (&pids)[N]) :
+    _dt(-1.0f)
+{
+    for (uint8_t i = 0; i < N; i++) {
+        _pid[i] = pids[i];
+    }
+}
+
+// Recalculates the cached filter alphas when dt or any of the filter frequencies differ
+// from the values they were calculated for. Parameters can change at any time, so the
+// frequencies are compared on every update; that is far cheaper than the alphas themselves.
+template <uint8_t N>
+void AC_PID_Bank<N>::update_alphas(float dt)
+{
+    bool changed = !is_equal(dt, _dt);
+    for (uint8_t i = 0; i < N && !changed; i++) {
+        changed = !is_equal(_pid[i]->filt_T_hz().get(), _filt_T_hz[i]) ||
+                  !is_equal(_pid[i]->filt_E_hz().get(), _filt_E_hz[i]) ||
+                  !is_equal(_pid[i]->filt_D_hz().get(), _filt_D_hz[i]);
+    }
+    if (!changed) {
+        return;
+    }
+
+    _dt = dt;
+    for (uint8_t i = 0; i < N; i++) {
+        _filt_T_hz[i] = _pid[i]->filt_T_hz().get();
+        _filt_E_hz[i] = _pid[i]->filt_E_hz().get();
+        _filt_D_hz[i] = _pid[i]->filt_D_hz().get();
+        _alpha_T[i] = _pid[i]->get_filt_T_alpha(dt);
+        _alpha_E[i] = _pid[i]->get_filt_E_alpha(dt);
+        _alpha_D[i] = is_positive(dt) ? _pid[i]->get_filt_D_alpha(dt) : 0.0f;
+    }
+}
+
+// Updates every controller in turn with the cached filter alphas.
+template <uint8_t N>
+void AC_PID_Bank<N>::update_all(const float target[N], const float measurement[N], float dt, const bool limit[N], const float pd_scale[N], float out[N])
+{
+    update_alphas(dt);
+
+    for (uint8_t i = 0; i < N; i++) {
+        const AC_PID::FilterAlphas alpha { _alpha_T[i], _alpha_E[i], _alpha_D[i] };
+        out[i] = _pid[i]->update_all(target[i], measurement[i], dt, alpha, limit[i], pd_scale[i]);
+    }
+}
+
+// instantiate for the roll, pitch and yaw rate controllers
+template class AC_PID_Bank<3>;
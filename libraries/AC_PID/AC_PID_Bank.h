@@ -0,0 +1,46 @@
+#pragma once
+
+/// @file	AC_PID_Bank.h
+/// @brief	Group of AC_PID controllers updated together, with their filter alphas cached per dt.
+
+#include "AC_PID.h"
+
+/// @class	AC_PID_Bank
+/// @brief	Runs N AC_PID controllers in one pass, e.g. the roll, pitch and yaw rate controllers.
+///
+/// The low-pass filter alphas of every member are held in arrays and
+/// only recalculated when dt or a filter frequency changes, rather than
+/// three times per controller per update. The controller state and
+/// parameters stay in the AC_PID objects, so tuning, resets and logging
+/// through the individual controllers are unchanged.
+template <uint8_t N>
+class AC_PID_Bank {
+public:
+
+    // pids must outlive the bank
+    AC_PID_Bank(AC_PID *const (&pids)[N]);
+
+    CLASS_NO_COPY(AC_PID_Bank);
+
+    // Updates every controller as AC_PID::update_all() would, writing the outputs to out.
+    // Element i of each array belongs to the i'th controller.
+    void update_all(const float target[N], const float measurement[N], float dt, const bool limit[N], const float pd_scale[N], float out[N]);
+
+private:
+
+    // recalculate the cached filter alphas if dt or any filter frequency has changed
+    void update_alphas(float dt);
+
+    AC_PID *_pid[N];
+
+    // filter frequencies and dt the alphas were calculated for
+    float _dt;
+    float _filt_T_hz[N];
+    float _filt_E_hz[N];
+    float _filt_D_hz[N];
+
+    // cached filter alphas
+    float _alpha_T[N];
+    float _alpha_E[N];
+    float _alpha_D[N];
+};
@@ -28,6 +28,8 @@ static const uint32_t EKF_INIT_SENSOR_MIN_UPDATE_MS = 500; // Sensor must update
 static const uint32_t LANDING_TARGET_TIMEOUT_MS = 2000; // Sensor must update within this many ms, else prec landing will be switched off
 static const uint32_t LANDING_TARGET_LOST_TIMEOUT_MS = 180000; // Target will be considered as "lost" if the last known location of the target is more than this many ms ago
 static const float    LANDING_TARGET_LOST_DIST_THRESH_M  = 30; // If the last known location of the landing target is beyond this many meters, then we will consider it lost
+static const float    INERTIAL_HISTORY_MARGIN_S = 0.1f; // history is kept this much longer than the lag so queued measurements can be matched to their frame
+static const uint32_t LOS_MEAS_TIMEOUT_MS = 1000; // queued measurements older than this are discarded
 
 const AP_Param::GroupInfo AC_PrecLand::var_info[] = {
     // @Param: ENABLED
@@ -225,7 +227,10 @@ void AC_PrecLand::init(uint16_t update_rate_hz)
     _lag.set(constrain_float(_lag, 0.02f, 0.25f));  // must match LAG parameter range at line 124
 
     // calculate inertial buffer size from lag and minimum of main loop rate and update_rate_hz argument
-    const uint16_t inertial_buffer_size = MAX((uint16_t)roundf(_lag * update_rate_hz), 1);
+    // with a margin so measurements queued before the latest update can be recalled
+    _lag_frames = MAX((uint16_t)roundf(_lag * update_rate_hz), 1);
+    _inertial_period_us = 1000000UL / MAX(update_rate_hz, 1);
+    const uint16_t inertial_buffer_size = _lag_frames + (uint16_t)roundf(INERTIAL_HISTORY_MARGIN_S * update_rate_hz);
 
     // instantiate ring buffer to hold inertial history, return on failure so no backends are created
     _inertial_history = NEW_NOTHROW ObjectArray<inertial_data_frame_s>(inertial_buffer_size);
@@ -496,12 +501,15 @@ void AC_PrecLand::handle_msg(const mavlink_landing_target_t &packet, uint32_t ti
 // run target position estimator
 void AC_PrecLand::run_estimator(float rangefinder_alt_m, bool rangefinder_alt_valid)
 {
-    _inertial_data_delayed = (*_inertial_history)[0];
+    // the delayed time horizon is the sensor lag behind the newest frame
+    const uint16_t available = _inertial_history->available();
+    _inertial_delayed_idx = available > _lag_frames ? available - _lag_frames : 0;
+    _inertial_data_delayed = (*_inertial_history)[_inertial_delayed_idx];
 
     switch ((EstimatorType)_estimator_type.get()) {
         case EstimatorType::RAW_SENSOR: {
             // Return if there's any invalid velocity data
-            for (uint8_t i=0; i<_inertial_history->available(); i++) {
+            for (uint16_t i=_inertial_delayed_idx; i<available; i++) {
                 const struct inertial_data_frame_s *inertial_data = (*_inertial_history)[i];
                 if (!inertial_data->inertialNavVelocityValid) {
                     _target_acquired = false;
@@ -517,8 +525,8 @@ void AC_PrecLand::run_estimator(float rangefinder_alt_m, bool rangefinder_alt_va
                 _target_vel_rel_est_NE.y = -_inertial_data_delayed->inertialNavVelocity.y;
             }
 
-            // Update if a new Line-Of-Sight measurement is available
-            if (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
+            // Update with each new Line-Of-Sight measurement, the latest one wins
+            while (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
                 if (!_estimator_initialized) {
                     GCS_SEND_TEXT(MAV_SEVERITY_INFO, "PrecLand: Target Found");
                     _estimator_initialized = true;
@@ -548,8 +556,8 @@ void AC_PrecLand::run_estimator(float rangefinder_alt_m, bool rangefinder_alt_va
                 _ekf_y.predict(dt, -vehicleDelVel.y, _accel_noise*dt);
             }
 
-            // Update if a new Line-Of-Sight measurement is available
-            if (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
+            // Fuse each new Line-Of-Sight measurement
+            while (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
                 float xy_pos_var = sq(_target_pos_rel_meas_NED.z*(0.01f + 0.01f*AP::ahrs().get_gyro().length()) + 0.02f);
                 if (!_estimator_initialized) {
                     // Inform the user landing target has been found
@@ -618,12 +626,23 @@ void AC_PrecLand::check_ekf_init_timeout()
     }
 }
 
-// get 3D vector from vehicle to target and frame.  returns true on success, false on failure
-bool AC_PrecLand::retrieve_los_meas(Vector3f& target_vec_unit, VectorFrame& frame)
+// get the oldest queued measurement from the backend, rotated to the body frame.  returns true on success, false on failure
+bool AC_PrecLand::retrieve_los_meas(los_meas_t &meas)
 {
-    const uint32_t los_meas_time_ms = _backend->los_meas_time_ms();
-    if ((los_meas_time_ms != _last_backend_los_meas_ms) && _backend->get_los_meas(target_vec_unit, frame)) {
-        _last_backend_los_meas_ms = los_meas_time_ms;
+    const uint32_t now_ms = AP_HAL::millis();
+    while (_backend->pop_los_meas(meas)) {
+        const uint32_t age_ms = now_ms - meas.time_ms;
+        if (age_ms > LOS_MEAS_TIMEOUT_MS) {
+            // queued while we were not running the estimator
+            continue;
+        }
+        _last_backend_los_meas_ms = meas.time_ms;
+
+        _meas_latency.sum_ms += age_ms;
+        _meas_latency.max_ms = MAX(_meas_latency.max_ms, uint16_t(age_ms));
+        _meas_latency.count++;
+
+        Vector3f &target_vec_unit = meas.vec_unit;
         if (!is_zero(_yaw_align)) {
             // Apply sensor yaw alignment rotation
             target_vec_unit.rotate_xy(cd_to_rad(_yaw_align));
@@ -650,32 +669,36 @@ bool AC_PrecLand::retrieve_los_meas(Vector3f& target_vec_unit, VectorFrame& fram
 // If a new measurement was retrieved, sets _target_pos_rel_meas_NED and returns true
 bool AC_PrecLand::construct_pos_meas_using_rangefinder(float rangefinder_alt_m, bool rangefinder_alt_valid)
 {
-    Vector3f target_vec_unit;
-    VectorFrame target_vec_frame;
-    if (retrieve_los_meas(target_vec_unit, target_vec_frame)) {
-        _inertial_data_delayed = (*_inertial_history)[0];
+    los_meas_t meas;
+    while (retrieve_los_meas(meas)) {
+        const Vector3f &target_vec_unit = meas.vec_unit;
+
+        // use the attitude the lag before the measurement arrived, which is
+        // the delayed time horizon unless it was queued before the latest update
+        const uint16_t meas_idx = inertial_history_index(uint64_t(meas.time_ms) * 1000U);
+        const inertial_data_frame_s *inertial_data_meas = (*_inertial_history)[MAX(uint16_t(meas_idx + 1), _lag_frames) - _lag_frames];
 
         // sanity check vector is pointing in the right direction
         const bool target_vec_valid = target_vec_unit.projected(_approach_vector_body).dot(_approach_vector_body) > 0.0f;
 
         // calculate 3D vector to target in NED frame
         Vector3f target_vec_unit_ned;
-        switch (target_vec_frame) {
+        switch (meas.frame) {
         case VectorFrame::BODY_FRD:
             // convert to NED
-            target_vec_unit_ned = _inertial_data_delayed->Tbn * target_vec_unit;
+            target_vec_unit_ned = inertial_data_meas->Tbn * target_vec_unit;
             break;
         case VectorFrame::LOCAL_FRD:
             // rotate vector using delayed yaw
             float roll_rad, pitch_rad, yaw_rad;
-            _inertial_data_delayed->Tbn.to_euler(&roll_rad, &pitch_rad, &yaw_rad);
+            inertial_data_meas->Tbn.to_euler(&roll_rad, &pitch_rad, &yaw_rad);
             target_vec_unit_ned = target_vec_unit;
             target_vec_unit_ned.rotate_xy(-yaw_rad);
             break;
         }
 
-        const Vector3f approach_vector_NED = _inertial_data_delayed->Tbn * _approach_vector_body;
-        const bool alt_valid = (rangefinder_alt_valid && rangefinder_alt_m > 0.0f) || (_backend->distance_to_target() > 0.0f);
+        const Vector3f approach_vector_NED = inertial_data_meas->Tbn * _approach_vector_body;
+        const bool alt_valid = (rangefinder_alt_valid && rangefinder_alt_m > 0.0f) || (meas.distance > 0.0f);
         if (target_vec_valid && alt_valid) {
             // distance to target and distance to target along approach vector
             float dist_to_target, dist_to_target_along_av;
@@ -684,11 +707,11 @@ bool AC_PrecLand::construct_pos_meas_using_rangefinder(float rangefinder_alt_m,
             if (!_cam_offset.get().is_zero()) {
                 // user has specifed offset for camera
                 // take its height into account while calculating distance
-                cam_pos_ned = _inertial_data_delayed->Tbn * _cam_offset;
+                cam_pos_ned = inertial_data_meas->Tbn * _cam_offset;
             }
-            if (_backend->distance_to_target() > 0.0f) {
+            if (meas.distance > 0.0f) {
                 // sensor has provided distance to landing target
-                dist_to_target = _backend->distance_to_target();
+                dist_to_target = meas.distance;
             } else {
                 // sensor only knows the horizontal location of the landing target
                 // rely on rangefinder for the vertical target
@@ -697,7 +720,7 @@ bool AC_PrecLand::construct_pos_meas_using_rangefinder(float rangefinder_alt_m,
             }
 
             // Compute camera position relative to IMU
-            const Vector3f accel_pos_ned = _inertial_data_delayed->Tbn * AP::ins().get_imu_pos_offset(AP::ahrs().get_primary_accel_index());
+            const Vector3f accel_pos_ned = inertial_data_meas->Tbn * AP::ins().get_imu_pos_offset(AP::ahrs().get_primary_accel_index());
             const Vector3f cam_pos_ned_rel_imu = cam_pos_ned - accel_pos_ned;
 
             // Compute target position relative to IMU
@@ -716,6 +739,28 @@ bool AC_PrecLand::construct_pos_meas_using_rangefinder(float rangefinder_alt_m,
     return false;
 }
 
+// index into the inertial history of the frame recorded closest to time_us
+uint16_t AC_PrecLand::inertial_history_index(uint64_t time_us) const
+{
+    const uint16_t newest = _inertial_history->available() - 1;
+    const uint64_t newest_us = (*_inertial_history)[newest]->time_usec;
+
+    // frames are pushed once per update so the age gives the index,
+    // then step over any jitter in the update rate
+    int32_t idx = newest;
+    if (time_us < newest_us) {
+        idx -= (newest_us - time_us + _inertial_period_us/2) / _inertial_period_us;
+    }
+    idx = constrain_int32(idx, 0, newest);
+    while (idx > 0 && (*_inertial_history)[idx]->time_usec > time_us + _inertial_period_us/2) {
+        idx--;
+    }
+    while (idx < newest && (*_inertial_history)[idx]->time_usec + _inertial_period_us/2 < time_us) {
+        idx++;
+    }
+    return idx;
+}
+
 // calculate target's position and velocity relative to the vehicle (used as input to position controller)
 // results are stored in_target_pos_rel_out_NE, _target_vel_rel_out_NE
 void AC_PrecLand::run_output_prediction()
@@ -724,7 +769,7 @@ void AC_PrecLand::run_output_prediction()
     _target_vel_rel_out_NE = _target_vel_rel_est_NE;
 
     // Predict forward from delayed time horizon
-    for (uint8_t i=1; i<_inertial_history->available(); i++) {
+    for (uint16_t i=_inertial_delayed_idx+1; i<_inertial_history->available(); i++) {
         const struct inertial_data_frame_s *inertial_data = (*_inertial_history)[i];
         _target_vel_rel_out_NE.x -= inertial_data->correctedVehicleDeltaVelocityNED.x;
         _target_vel_rel_out_NE.y -= inertial_data->correctedVehicleDeltaVelocityNED.y;
@@ -839,9 +884,13 @@ void AC_PrecLand::Write_Precland()
         meas_z          : target_pos_meas.z,
         last_meas       : last_backend_los_meas_ms(),
         ekf_outcount    : ekf_outlier_count(),
-        estimator       : (uint8_t)_estimator_type
+        estimator       : (uint8_t)_estimator_type,
+        meas_count      : _meas_latency.count,
+        lat_avg         : uint16_t(_meas_latency.count > 0 ? _meas_latency.sum_ms / _meas_latency.count : 0),
+        lat_max         : _meas_latency.max_ms
     };
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
+    _meas_latency = {};
 }
 #endif
 
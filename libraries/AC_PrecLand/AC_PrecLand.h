@@ -168,6 +168,14 @@ private:
         LOCAL_FRD = 1,    // forward-right-down where forward is aligned with front of the vehicle in the horizontal plane
     };
 
+    // a line-of-sight measurement queued by a backend
+    struct los_meas_t {
+        Vector3f vec_unit;      // unit vector pointing towards target in earth or body frame (see frame)
+        VectorFrame frame;      // frame of vector pointing towards target
+        uint32_t time_ms;       // system time in milliseconds when the vector was measured
+        float distance;         // distance from the sensor to landing target in meters (0 means distance is not known)
+    };
+
     // check the status of the target
     void check_target_status(float rangefinder_alt_m, bool rangefinder_alt_valid);
 
@@ -184,10 +192,14 @@ private:
     void run_estimator(float rangefinder_alt_m, bool rangefinder_alt_valid);
 
     // If a new measurement was retrieved, sets _target_pos_rel_meas_NED and returns true
+    // call until it returns false to use all queued measurements
     bool construct_pos_meas_using_rangefinder(float rangefinder_alt_m, bool rangefinder_alt_valid);
 
-    // get 3D vector from vehicle to target and frame.  returns true on success, false on failure
-    bool retrieve_los_meas(Vector3f& target_vec_unit, VectorFrame& frame);
+    // get the oldest queued measurement from the backend, rotated to the body frame.  returns true on success, false on failure
+    bool retrieve_los_meas(los_meas_t &meas);
+
+    // index into the inertial history of the frame recorded closest to time_us
+    uint16_t inertial_history_index(uint64_t time_us) const;
 
     // calculate target's position and velocity relative to the vehicle (used as input to position controller)
     // results are stored in_target_pos_rel_out_NE, _target_vel_rel_out_NE
@@ -249,6 +261,16 @@ private:
     };
     ObjectArray<inertial_data_frame_s> *_inertial_history;
     struct inertial_data_frame_s *_inertial_data_delayed;
+    uint16_t _inertial_delayed_idx;     // index of the frame at the estimator's delayed time horizon
+    uint16_t _lag_frames;               // number of frames covered by the sensor lag
+    uint32_t _inertial_period_us;       // expected time between frames
+
+    // age of measurements when they are used by the estimator, reset when logged
+    struct {
+        uint32_t sum_ms;
+        uint16_t max_ms;
+        uint16_t count;
+    } _meas_latency;
 
     // backend state
     struct precland_state {
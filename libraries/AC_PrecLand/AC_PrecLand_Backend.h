@@ -26,19 +26,9 @@ public:
     // retrieve updates from sensor
     virtual void update() = 0;
 
-    // provides a unit vector towards the target in body frame
-    //  returns same as have_los_meas()
-    bool get_los_meas(Vector3f& vec_unit, AC_PrecLand::VectorFrame& frame) const {
-        if (!_los_meas.valid) {
-            return false;
-        }
-        vec_unit = _los_meas.vec_unit;
-        frame = _los_meas.frame;
-        return true;
-    };
-
-    // returns system time in milliseconds of last los measurement
-    uint32_t los_meas_time_ms() const { return _los_meas.time_ms; };
+    // provides the oldest unit vector towards the target queued since the last call
+    //  returns false if there are none
+    bool pop_los_meas(AC_PrecLand::los_meas_t &meas) { return _los_queue.pop(meas); }
 
     // returns distance to target in meters (0 means distance is not known)
     float distance_to_target() const { return _distance_to_target; };
@@ -50,6 +40,12 @@ public:
     int8_t get_bus(void) const { return _frontend._bus.get(); }
     
 protected:
+    // queue the latest measurement for the estimator, so none are missed
+    // if several arrive between estimator updates
+    void queue_los_meas() {
+        _los_queue.push_force(AC_PrecLand::los_meas_t{_los_meas.vec_unit, _los_meas.frame, _los_meas.time_ms, _distance_to_target});
+    }
+
     const AC_PrecLand&  _frontend;          // reference to precision landing front end
     AC_PrecLand::precland_state &_state;    // reference to this instances state
 
@@ -60,6 +56,7 @@ protected:
         bool valid;         // true if there is a valid measurement from the sensor
     } _los_meas;
     float               _distance_to_target;    // distance from the sensor to landing target in meters
+    ObjectArray<AC_PrecLand::los_meas_t> _los_queue{AC_PRECLAND_LOS_QUEUE_LEN};
 };
 
 #endif // AC_PRECLAND_ENABLED
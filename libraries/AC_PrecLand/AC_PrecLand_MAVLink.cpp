@@ -49,6 +49,7 @@ void AC_PrecLand_MAVLink::handle_msg(const mavlink_landing_target_t &packet, uin
     _distance_to_target = MAX(0, packet.distance);
     _los_meas.time_ms = timestamp_ms;
     _los_meas.valid = true;
+    queue_los_meas();
 }
 
 #endif // AC_PRECLAND_MAVLINK_ENABLED
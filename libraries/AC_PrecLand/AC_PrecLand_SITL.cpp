@@ -33,6 +33,7 @@ void AC_PrecLand_SITL::update()
 
         _los_meas.valid = true;
         _los_meas.time_ms = _sitl->precland_sim.last_update_ms();
+        queue_los_meas();
     } else {
         _los_meas.valid = false;
     }
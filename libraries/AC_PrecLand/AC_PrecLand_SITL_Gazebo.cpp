@@ -32,6 +32,7 @@ void AC_PrecLand_SITL_Gazebo::update()
         _los_meas.frame = AC_PrecLand::VectorFrame::BODY_FRD;
         _los_meas.valid = true;
         _los_meas.time_ms = irlock.last_update_ms();
+        queue_los_meas();
     }
     _los_meas.valid = _los_meas.valid && AP_HAL::millis() - _los_meas.time_ms <= 1000;
 }
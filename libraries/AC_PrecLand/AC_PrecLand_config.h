@@ -25,3 +25,9 @@
 #ifndef AC_PRECLAND_SITL_GAZEBO_ENABLED
 #define AC_PRECLAND_SITL_GAZEBO_ENABLED (AC_PRECLAND_BACKEND_DEFAULT_ENABLED && CONFIG_HAL_BOARD == HAL_BOARD_SITL)
 #endif
+
+// number of line-of-sight measurements a backend can hold between
+// estimator updates, so high rate targets are not dropped
+#ifndef AC_PRECLAND_LOS_QUEUE_LEN
+#define AC_PRECLAND_LOS_QUEUE_LEN 8
+#endif
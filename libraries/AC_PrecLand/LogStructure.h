@@ -21,6 +21,9 @@
 // @Field: LastMeasMS: Time when target was last detected
 // @Field: EKFOutl: EKF's outlier count
 // @Field: Est: Type of estimator used
+// @Field: MCnt: Number of measurements used by the estimator since the last message
+// @Field: LatAvg: Average age of measurements when used by the estimator
+// @Field: LatMax: Maximum age of measurements when used by the estimator
 
 // precision landing logging
 struct PACKED log_Precland {
@@ -38,12 +41,15 @@ struct PACKED log_Precland {
     uint32_t last_meas;
     uint32_t ekf_outcount;
     uint8_t estimator;
+    uint16_t meas_count;
+    uint16_t lat_avg;
+    uint16_t lat_max;
 };
 
 #if AC_PRECLAND_ENABLED
 #define LOG_STRUCTURE_FROM_PRECLAND                                     \
     { LOG_PRECLAND_MSG, sizeof(log_Precland),                           \
-      "PL",    "QBBfffffffIIB",    "TimeUS,Heal,TAcq,pX,pY,vX,vY,mX,mY,mZ,LastMeasMS,EKFOutl,Est", "s--mmnnmmms--","F--BBBBBBBC--" , true },
+      "PL",    "QBBfffffffIIBHHH",    "TimeUS,Heal,TAcq,pX,pY,vX,vY,mX,mY,mZ,LastMeasMS,EKFOutl,Est,MCnt,LatAvg,LatMax", "s--mmnnmmms---ss","F--BBBBBBBC---CC" , true },
 #else
 #define LOG_STRUCTURE_FROM_PRECLAND
 #endif
@@ -1,5 +1,6 @@
 #include <AP_HAL/AP_HAL.h>
 #include "AC_WPNav.h"
+#include <AP_Scheduler/AP_Scheduler.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -101,6 +102,15 @@ const AP_Param::GroupInfo AC_WPNav::var_info[] = {
     // @User: Standard
     AP_GROUPINFO("ACCEL_C",     13, AC_WPNav, _wp_accel_c_cmss, 0.0),
 
+    // @Param: TER_LKAHD
+    // @DisplayName: Waypoint Terrain following lookahead
+    // @Description: When following terrain from the terrain database, the terrain this far ahead along the desired velocity is also looked up and the vehicle climbs early if it is higher than the terrain below. Zero disables the lookahead
+    // @Units: s
+    // @Range: 0 5
+    // @Increment: 0.1
+    // @User: Advanced
+    AP_GROUPINFO("TER_LKAHD",   14, AC_WPNav, _terrain_lookahead_s, 0.0),
+
     AP_GROUPEND
 };
 
@@ -462,7 +472,11 @@ bool AC_WPNav::advance_wp_target_along_track(float dt)
     const float offset_u_scalar = _pos_control.pos_terrain_U_scaler_cm(terr_offset_u_cm, get_terrain_margin_m() * 100.0);
 
     // input shape the terrain offset
-    _pos_control.set_pos_terrain_target_U_cm(terr_offset_u_cm);
+    float terr_target_u_cm = terr_offset_u_cm;
+    if (_is_terrain_alt) {
+        UNUSED_RESULT(get_terrain_target_offset_cm(terr_target_u_cm));
+    }
+    _pos_control.set_pos_terrain_target_U_cm(terr_target_u_cm);
 
     // get position controller's position offset (post input shaping) so it can be used in position error calculation
     const Vector3p& psc_pos_offset_neu_cm = _pos_control.get_pos_offset_NEU_cm();
@@ -666,11 +680,9 @@ bool AC_WPNav::get_terrain_offset_cm(float& offset_cm)
         return false;
     case AC_WPNav::TerrainSource::TERRAIN_FROM_TERRAINDATABASE:
 #if AP_TERRAIN_AVAILABLE
-        float terrain_alt_m = 0.0f;
-        AP_Terrain *terrain = AP::terrain();
-        if (terrain != nullptr &&
-            terrain->height_above_terrain(terrain_alt_m, true)) {
-            offset_cm = _pos_control.get_pos_estimate_NEU_cm().z - (terrain_alt_m * 100.0);
+        update_terrain_database_offset();
+        if (_terrain_database.ok) {
+            offset_cm = _terrain_database.offset_cm;
             return true;
         }
 #endif
@@ -681,6 +693,65 @@ bool AC_WPNav::get_terrain_offset_cm(float& offset_cm)
     return false;
 }
 
+// get terrain's altitude (in cm above the ekf origin) to use as the position controller's terrain target
+// the terrain ahead is only used when it is higher so that the vehicle climbs early but never descends early
+bool AC_WPNav::get_terrain_target_offset_cm(float& offset_cm)
+{
+    if (!get_terrain_offset_cm(offset_cm)) {
+        return false;
+    }
+#if AP_TERRAIN_AVAILABLE
+    if (get_terrain_source() == TerrainSource::TERRAIN_FROM_TERRAINDATABASE && _terrain_database.ahead_ok) {
+        offset_cm = MAX(offset_cm, _terrain_database.offset_ahead_cm);
+    }
+#endif
+    return true;
+}
+
+#if AP_TERRAIN_AVAILABLE
+// look up the terrain database offsets at the current position and, if enabled, the lookahead position
+// the offsets are needed several times per loop so each lookup is done at most once per scheduler tick
+void AC_WPNav::update_terrain_database_offset()
+{
+    const uint32_t now_ticks = AP::scheduler().ticks32();
+    if (_terrain_database.updated && _terrain_database.ticks == now_ticks) {
+        return;
+    }
+    _terrain_database.updated = true;
+    _terrain_database.ticks = now_ticks;
+    _terrain_database.ok = false;
+    _terrain_database.ahead_ok = false;
+
+    float terrain_alt_m = 0.0f;
+    AP_Terrain *terrain = AP::terrain();
+    if (terrain == nullptr || !terrain->height_above_terrain(terrain_alt_m, true)) {
+        return;
+    }
+    _terrain_database.offset_cm = _pos_control.get_pos_estimate_NEU_cm().z - (terrain_alt_m * 100.0);
+    _terrain_database.ok = true;
+
+    if (!is_positive(_terrain_lookahead_s)) {
+        return;
+    }
+
+    // terrain height at the position the desired velocity will reach after the lookahead time
+    Location loc;
+    int32_t alt_amsl_cm;
+    if (!AP::ahrs().get_location(loc) || !loc.get_alt_cm(Location::AltFrame::ABSOLUTE, alt_amsl_cm)) {
+        return;
+    }
+    const float terrain_amsl_m = alt_amsl_cm * 0.01 - terrain_alt_m;
+    const Vector2f lookahead_ne_m = _pos_control.get_vel_desired_NEU_cms().xy() * (0.01 * _terrain_lookahead_s);
+    loc.offset(lookahead_ne_m.x, lookahead_ne_m.y);
+    float terrain_ahead_amsl_m;
+    if (!terrain->height_amsl(loc, terrain_ahead_amsl_m)) {
+        return;
+    }
+    _terrain_database.offset_ahead_cm = _terrain_database.offset_cm + (terrain_ahead_amsl_m - terrain_amsl_m) * 100.0;
+    _terrain_database.ahead_ok = true;
+}
+#endif
+
 ///
 /// spline methods
 ///
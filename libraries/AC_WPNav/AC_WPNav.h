@@ -40,6 +40,10 @@ public:
     // get terrain's altitude (in cm above the ekf origin) at the current position (+ve means terrain below vehicle is above ekf origin's altitude)
     bool get_terrain_offset_cm(float& offset_cm);
 
+    // get terrain's altitude (in cm above the ekf origin) to use as the position controller's terrain target.
+    // this is the terrain offset at the current position, raised to the terrain ahead of the vehicle if WPNAV_TER_LKAHD is set
+    bool get_terrain_target_offset_cm(float& offset_cm);
+
     // return terrain following altitude margin.  vehicle will stop if distance from target altitude is larger than this margin
     float get_terrain_margin_m() const { return MAX(_terrain_margin_m, 0.1); }
 
@@ -266,6 +270,7 @@ protected:
     AP_Float    _wp_accel_z_cmss;   // vertical acceleration in cm/s/s during missions
     AP_Float    _wp_jerk_msss;      // maximum jerk used to generate scurve trajectories in m/s/s/s
     AP_Float    _terrain_margin_m;  // terrain following altitude margin. vehicle will stop if distance from target altitude is larger than this margin
+    AP_Float    _terrain_lookahead_s;   // time ahead along the desired velocity to look up terrain for the terrain target
 
     // WPNAV_SPEED param change checker
     bool _check_wp_speed_change;    // if true WPNAV_SPEED param should be checked for changes in-flight
@@ -305,4 +310,19 @@ protected:
     AP_Int8     _rangefinder_use;               // parameter that specifies if the range finder should be used for terrain following commands
     bool        _rangefinder_healthy;           // true if rangefinder distance is healthy (i.e. between min and maximum)
     float       _rangefinder_terrain_offset_cm; // latest rangefinder based terrain offset (e.g. terrain's height above EKF origin)
+
+#if AP_TERRAIN_AVAILABLE
+    // update the terrain database offsets, at most once per scheduler tick
+    void update_terrain_database_offset();
+
+    // terrain database offsets, memoized as the offset is needed several times per loop
+    struct {
+        uint32_t ticks;             // scheduler tick the offsets were looked up on
+        bool updated;               // true once ticks has been set
+        bool ok;                    // true if offset_cm is valid
+        bool ahead_ok;              // true if offset_ahead_cm is valid
+        float offset_cm;            // terrain's height above the EKF origin at the current position
+        float offset_ahead_cm;      // terrain's height above the EKF origin at the lookahead position
+    } _terrain_database;
+#endif
 };
@@ -655,6 +655,8 @@ float AR_AttitudeControl::get_steering_out_rate(float desired_rate, bool motor_l
     // sanity check dt
     dt = constrain_float(dt, 0.0f, 1.0f);
 
+    WITH_SEMAPHORE(_fast_steer.sem);
+
     // update steering limit flags used by higher level controllers (e.g. position controller)
     _steering_limit_left = motor_limit_left;
     _steering_limit_right = motor_limit_right;
@@ -665,6 +667,7 @@ float AR_AttitudeControl::get_steering_out_rate(float desired_rate, bool motor_l
         _steer_rate_pid.reset_filter();
         _steer_rate_pid.reset_I();
         _desired_turn_rate = AP::ahrs().get_yaw_rate_earth();
+        _fast_steer.output_valid = false;
     }
     _steer_turn_last_ms = now;
 
@@ -707,6 +710,12 @@ float AR_AttitudeControl::get_steering_out_rate(float desired_rate, bool motor_l
         _desired_turn_rate = constrain_float(_desired_turn_rate, -turn_rate_max, turn_rate_max);
     }
 
+    // the fast rate thread runs the pid on the next gyro sample
+    _fast_steer.motor_limit = motor_limit_left || motor_limit_right;
+    if (_fast_steer.enabled && _fast_steer.output_valid) {
+        return _fast_steer.output;
+    }
+
     // update pid to calculate output to motors
     float output = _steer_rate_pid.update_all(_desired_turn_rate, AP::ahrs().get_yaw_rate_earth(), dt, (motor_limit_left || motor_limit_right));
     output += _steer_rate_pid.get_ff();
@@ -714,6 +723,30 @@ float AR_AttitudeControl::get_steering_out_rate(float desired_rate, bool motor_l
     return output;
 }
 
+// enable or disable running the steering rate pid from the fast rate thread
+void AR_AttitudeControl::set_fast_rate_enabled(bool enabled)
+{
+    WITH_SEMAPHORE(_fast_steer.sem);
+    _fast_steer.enabled = enabled;
+    _fast_steer.output_valid = false;
+}
+
+/*
+  run the steering rate pid on a gyro sample from the fast rate
+  thread, towards the desired turn rate from the latest call to
+  get_steering_out_rate(). Nothing is done unless the steering rate
+  controller is in use
+ */
+void AR_AttitudeControl::steering_rate_controller_run_dt(float yaw_rate_earth, float dt)
+{
+    WITH_SEMAPHORE(_fast_steer.sem);
+    if (!_fast_steer.enabled || (_steer_turn_last_ms == 0) || ((AP_HAL::millis() - _steer_turn_last_ms) > AR_ATTCONTROL_TIMEOUT_MS)) {
+        return;
+    }
+    _fast_steer.output = _steer_rate_pid.update_all(_desired_turn_rate, yaw_rate_earth, dt, _fast_steer.motor_limit) + _steer_rate_pid.get_ff();
+    _fast_steer.output_valid = true;
+}
+
 // get latest desired turn rate in rad/sec (recorded during calls to get_steering_out_rate)
 float AR_AttitudeControl::get_desired_turn_rate() const
 {
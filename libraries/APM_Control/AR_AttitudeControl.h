@@ -3,6 +3,7 @@
 #include <AP_Common/AP_Common.h>
 #include <AC_PID/AC_PID.h>
 #include <AC_PID/AC_P.h>
+#include <AP_HAL/Semaphores.h>
 
 class AR_AttitudeControl {
 public:
@@ -39,6 +40,12 @@ public:
     // also sets steering_limit_left and steering_limit_right flags
     float get_steering_out_rate(float desired_rate, bool motor_limit_left, bool motor_limit_right, float dt);
 
+    // fast rate thread support. While enabled the steering rate pid is
+    // run by steering_rate_controller_run_dt() on each gyro sample and
+    // get_steering_out_rate() returns its latest output
+    void set_fast_rate_enabled(bool enabled);
+    void steering_rate_controller_run_dt(float yaw_rate_earth, float dt);
+
     // get latest desired turn rate in rad/sec recorded during calls to get_steering_out_rate.  For reporting purposes only
     float get_desired_turn_rate() const;
 
@@ -166,6 +173,15 @@ private:
     bool     _steering_limit_left;  // true when the steering control has reached its left limit (e.g. motor has reached limits or accel or turn rate limits applied)
     bool     _steering_limit_right; // true when the steering control has reached its right limit (e.g. motor has reached limits or accel or turn rate limits applied)
 
+    // steering rate pid run from the fast rate thread
+    struct {
+        HAL_Semaphore sem;          // protects the steering rate pid and its inputs
+        float output;               // latest output
+        bool motor_limit;           // motor limit from the latest call to get_steering_out_rate
+        bool output_valid;          // output has been calculated since the pid was reset
+        bool enabled;
+    } _fast_steer;
+
     // throttle control
     uint32_t _speed_last_ms;        // system time of last call to get_throttle_out_speed
     float    _desired_speed;        // last recorded desired speed
@@ -129,7 +129,7 @@ void setup()
     float override_pitch = 0;
 
     // Read in user provided configuration
-    uint8_t argc;
+    int argc;
     char * const *argv;
     hal.util->commandline_arguments(argc, argv);
     if (argc > 1) {
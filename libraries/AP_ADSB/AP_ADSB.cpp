@@ -205,8 +205,13 @@ void AP_ADSB::init(void)
         in_state.list_size_param.set(constrain_int16(in_state.list_size_param, 1, INT16_MAX));
 
         in_state.vehicle_list = NEW_NOTHROW adsb_vehicle_t[in_state.list_size_param];
+        in_state.vehicle_distance = NEW_NOTHROW float[in_state.list_size_param];
 
-        if (in_state.vehicle_list == nullptr) {
+        if (in_state.vehicle_list == nullptr || in_state.vehicle_distance == nullptr) {
+            delete[] in_state.vehicle_list;
+            in_state.vehicle_list = nullptr;
+            delete[] in_state.vehicle_distance;
+            in_state.vehicle_distance = nullptr;
             // dynamic RAM allocation of in_state.vehicle_list[] failed
             _init_failed = true; // this keeps us from constantly trying to init forever in main update
             GCS_SEND_TEXT(MAV_SEVERITY_INFO, "ADSB: Unable to initialize ADSB vehicle list");
@@ -440,7 +445,9 @@ void AP_ADSB::update(const AP_ADSB::Loc &loc)
 
 /*
  * determine index and distance of furthest vehicle. This is
- * used to bump it off when a new closer aircraft is detected
+ * used to bump it off when a new closer aircraft is detected.
+ * Distances are those calculated when each vehicle was last
+ * updated, which is at least as often as we move appreciably
  */
 void AP_ADSB::determine_furthest_aircraft(void)
 {
@@ -451,7 +458,7 @@ void AP_ADSB::determine_furthest_aircraft(void)
         if (is_special_vehicle(in_state.vehicle_list[index].info.ICAO_address)) {
             continue;
         }
-        const float distance = _my_loc.get_distance(get_location(in_state.vehicle_list[index]));
+        const float distance = in_state.vehicle_distance[index];
         if (max_distance < distance || index == 0) {
             max_distance = distance;
             max_distance_index = index;
@@ -494,6 +501,11 @@ void AP_ADSB::delete_vehicle(const uint16_t index)
     }
     if (index != (in_state.vehicle_count-1)) {
         in_state.vehicle_list[index] = in_state.vehicle_list[in_state.vehicle_count-1];
+        in_state.vehicle_distance[index] = in_state.vehicle_distance[in_state.vehicle_count-1];
+        // the furthest vehicle may have been the one moved
+        if (in_state.furthest_vehicle_index == in_state.vehicle_count-1) {
+            in_state.furthest_vehicle_index = index;
+        }
     }
     // TODO: is memset needed? When we decrement the index we essentially forget about it
     memset(&in_state.vehicle_list[in_state.vehicle_count-1], 0, sizeof(adsb_vehicle_t));
@@ -556,12 +568,12 @@ void AP_ADSB::handle_adsb_vehicle(const adsb_vehicle_t &vehicle)
     } else if (is_tracked_in_list) {
 
         // found, update it
-        set_vehicle(index, vehicle);
+        set_vehicle(index, vehicle, my_loc_distance_to_vehicle);
 
     } else if (in_state.vehicle_count < in_state.list_size_allocated) {
 
         // not found and there's room, add it to the end of the list
-        set_vehicle(in_state.vehicle_count, vehicle);
+        set_vehicle(in_state.vehicle_count, vehicle, my_loc_distance_to_vehicle);
         in_state.vehicle_count++;
 
     } else {
@@ -580,7 +592,7 @@ void AP_ADSB::handle_adsb_vehicle(const adsb_vehicle_t &vehicle)
 
             if (my_loc_distance_to_vehicle < in_state.furthest_vehicle_distance) { // is closer than the furthest
                 // replace with the furthest vehicle
-                set_vehicle(in_state.furthest_vehicle_index, vehicle);
+                set_vehicle(in_state.furthest_vehicle_index, vehicle, my_loc_distance_to_vehicle);
 
                 // in_state.furthest_vehicle_index is now invalid because the vehicle was overwritten, need
                 // to run determine_furthest_aircraft() to determine a new one next time
@@ -604,13 +616,26 @@ void AP_ADSB::handle_adsb_vehicle(const adsb_vehicle_t &vehicle)
 /*
  * Copy a vehicle's data into the list
  */
-void AP_ADSB::set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle)
+void AP_ADSB::set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle, const float distance)
 {
     if (index >= in_state.list_size_allocated) {
         // out of range
         return;
     }
     in_state.vehicle_list[index] = vehicle;
+    in_state.vehicle_distance[index] = distance;
+
+    // keep the furthest vehicle current so a full list doesn't need to be searched for it
+    if (in_state.furthest_vehicle_distance > 0 && !is_special_vehicle(vehicle.info.ICAO_address)) {
+        if (distance > in_state.furthest_vehicle_distance) {
+            in_state.furthest_vehicle_index = index;
+            in_state.furthest_vehicle_distance = distance;
+        } else if (index == in_state.furthest_vehicle_index) {
+            // it came closer, so another vehicle may now be the furthest
+            in_state.furthest_vehicle_distance = 0;
+            in_state.furthest_vehicle_index = 0;
+        }
+    }
 
 #if HAL_LOGGING_ENABLED
     write_log(vehicle);
@@ -230,7 +230,7 @@ private:
     // check to see if we are initialized (and possibly do initialization)
     bool check_startup();
 
-    // compares current vector against vehicle_list to detect threats
+    // find the furthest vehicle in vehicle_list from the cached distances
     void determine_furthest_aircraft(void);
 
     // return index of given vehicle if ICAO_ADDRESS matches. return -1 if no match
@@ -239,7 +239,8 @@ private:
     // remove a vehicle from the list
     void delete_vehicle(const uint16_t index);
 
-    void set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle);
+    // copy a vehicle into the list along with its distance from us in metres
+    void set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle, const float distance);
 
     // Generates pseudorandom ICAO from gps time, lat, and lon
     uint32_t genICAO(const Location &loc) const;
@@ -268,6 +269,10 @@ private:
         AP_Int16    list_size_param;
         uint16_t    list_size_allocated;
         adsb_vehicle_t *vehicle_list;
+        // distance in metres from us to each vehicle in vehicle_list
+        // when it was last updated, so the furthest can be found without
+        // recalculating the distance to every vehicle
+        float       *vehicle_distance;
         uint16_t    vehicle_count;
         AP_Int32    list_radius;
         AP_Int16    list_altitude;
@@ -471,6 +471,10 @@ void AP_AHRS::update(bool skip_ins_update)
     // update AOA and SSA
     update_AOA_SSA();
 
+#if AP_SENSOR_DEMAND_ENABLED
+    update_sensor_demand();
+#endif
+
 #if HAL_GCS_ENABLED
     state.active_EKF = _active_EKF_type();
     if (state.active_EKF != last_active_ekf_type) {
@@ -1200,6 +1204,39 @@ bool AP_AHRS::use_compass(void)
     return false;
 }
 
+#if AP_SENSOR_DEMAND_ENABLED
+/*
+  tell sensor backends which data the estimators need, so compass and
+  airspeed sensors can be polled less often when nothing fuses them.
+  DCM still gets enough compass data at the idle rate
+ */
+void AP_AHRS::update_sensor_demand(void)
+{
+    auto &demand = AP::sensor_demand();
+
+    // the compass is needed unless EKF3 runs alone and none of its
+    // source sets can use the compass for yaw
+    bool compass_needed = true;
+#if HAL_NAVEKF3_AVAILABLE
+    if (ekf_type() == EKFType::THREE) {
+        compass_needed = EKF3.compass_yaw_enabled();
+#if HAL_NAVEKF2_AVAILABLE
+        compass_needed |= _ekf2_started;
+#endif
+    }
+#endif
+    demand.set_rate_hz(AP_SensorDemand::Sensor::COMPASS, AP_SensorDemand::Consumer::AHRS,
+                       compass_needed ? 100 : 0);
+
+#if AP_AIRSPEED_ENABLED
+    const AP_Airspeed *airspeed = AP::airspeed();
+    const bool airspeed_needed = airspeed != nullptr && airspeed->use();
+    demand.set_rate_hz(AP_SensorDemand::Sensor::AIRSPEED, AP_SensorDemand::Consumer::AHRS,
+                       airspeed_needed ? 50 : 0);
+#endif
+}
+#endif  // AP_SENSOR_DEMAND_ENABLED
+
 // return the quaternion defining the rotation from NED to XYZ (body) axes
 bool AP_AHRS::_get_quaternion(Quaternion &quat) const
 {
@@ -28,6 +28,7 @@
 #include "AP_AHRS_Backend.h"
 #include <AP_NavEKF2/AP_NavEKF2.h>
 #include <AP_NavEKF3/AP_NavEKF3.h>
+#include <AP_Common/AP_SensorDemand.h>
 #include <AP_NavEKF/AP_Nav_Common.h>              // definitions shared by inertial and ekf nav filters
 
 #include "AP_AHRS_DCM.h"
@@ -832,6 +833,11 @@ private:
     uint32_t _last_AOA_update_ms;
     void update_AOA_SSA(void);
 
+#if AP_SENSOR_DEMAND_ENABLED
+    // tell sensor backends which data the estimators need
+    void update_sensor_demand(void);
+#endif
+
     EKFType last_active_ekf_type;
 
 #if AP_AHRS_SIM_ENABLED
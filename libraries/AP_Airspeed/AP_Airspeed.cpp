@@ -645,6 +645,12 @@ void AP_Airspeed::read(uint8_t i)
     // remember raw pressure for logging
     state[i].corrected_pressure = airspeed_pressure;
 
+    // noise of the raw samples the backend averaged into this reading
+    if (!sensor[i]->get_pressure_noise(state[i].pressure_noise, state[i].pressure_samples)) {
+        state[i].pressure_noise = 0;
+        state[i].pressure_samples = 0;
+    }
+
 #ifndef HAL_BUILD_AP_PERIPH
     if (state[i].cal.start_ms != 0) {
         update_calibration(i, raw_pressure);
@@ -803,7 +809,9 @@ void AP_Airspeed::Log_Airspeed()
             healthy       : healthy(i),
             health_prob   : get_health_probability(i),
             test_ratio    : get_test_ratio(i),
-            primary       : get_primary()
+            primary       : get_primary(),
+            samples       : state[i].pressure_samples,
+            noise         : state[i].pressure_noise,
         };
         AP::logger().WriteBlock(&pkt, sizeof(pkt));
 
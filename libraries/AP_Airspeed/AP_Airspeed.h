@@ -249,6 +249,12 @@ public:
         return get_corrected_pressure(primary);
     }
 
+    // standard deviation in Pascal of the raw samples averaged into
+    // the last pressure reading, 0 if not known
+    float get_pressure_noise(uint8_t i) const {
+        return state[i].pressure_noise;
+    }
+
 #if AP_AIRSPEED_MSP_ENABLED
     void handle_msp(const MSP::msp_airspeed_data_message_t &pkt);
 #endif
@@ -292,6 +298,8 @@ private:
         float	last_pressure;
         float   filtered_pressure;
         float	corrected_pressure;
+        float   pressure_noise;
+        uint16_t pressure_samples;
         uint32_t last_update_ms;
         bool	healthy;
 
@@ -127,10 +127,8 @@ void AP_Airspeed_ASP5033::timer()
     constexpr float temp_scale = 1.0 / 256;
 
     WITH_SEMAPHORE(sem);
-    press_sum += press * press_scale;
-    temp_sum += temp * temp_scale;
-    press_count++;
-    temp_count++;
+    add_pressure_sample(press * press_scale);
+    add_temperature_sample(temp * temp_scale);
 
     last_sample_ms = AP_HAL::millis();
 }
@@ -145,15 +143,8 @@ bool AP_Airspeed_ASP5033::get_differential_pressure(float &pressure)
         return false;
     }
 
-    if (press_count == 0) {
-        pressure = last_pressure;
-        return true;
-    }
-
-    last_pressure = pressure = press_sum / press_count;
-
-    press_count = 0;
-    press_sum = 0;
+    average_pressure(last_pressure);
+    pressure = last_pressure;
 
     return true;
 }
@@ -166,14 +157,8 @@ bool AP_Airspeed_ASP5033::get_temperature(float &temperature)
     if (AP_HAL::millis() - last_sample_ms > 100) {
         return false;
     }
-    if (temp_count == 0) {
-        temperature = last_temperature;
-        return true;
-    }
-
-    last_temperature = temperature = temp_sum / temp_count;
-    temp_count = 0;
-    temp_sum = 0;
+    average_temperature(last_temperature);
+    temperature = last_temperature;
 
     return true;
 }
@@ -44,12 +44,8 @@ public:
 private:
     void timer();
     bool confirm_sensor_id(void);
-    float temp_sum;
-    float press_sum;
     float last_pressure;
     float last_temperature;
-    uint32_t press_count;
-    uint32_t temp_count;
     uint32_t last_sample_ms;
 
     AP_HAL::I2CDevice *dev;
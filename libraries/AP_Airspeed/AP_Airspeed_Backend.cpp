@@ -63,4 +63,63 @@ void AP_Airspeed_Backend::set_bus_id(uint32_t id)
     frontend.param[instance].bus_id.set_and_save(int32_t(id));
 }
 
+void AP_Airspeed_Backend::SampleSum::add(float v)
+{
+    if (count == 0) {
+        first = v;
+        sum = 0;
+        sum_sq = 0;
+    } else if (count == UINT16_MAX) {
+        return;
+    }
+    const float d = v - first;
+    sum += d;
+    sum_sq += d * d;
+    count++;
+}
+
+bool AP_Airspeed_Backend::SampleSum::take(float &mean, float &variance, uint16_t &n)
+{
+    if (count == 0) {
+        return false;
+    }
+    const float dmean = sum / count;
+    mean = first + dmean;
+    variance = count > 1 ? MAX((sum_sq - sum * dmean) / (count - 1), 0) : 0;
+    n = count;
+    count = 0;
+    return true;
+}
+
+void AP_Airspeed_Backend::average_pressure(float &pressure)
+{
+    float variance;
+    uint16_t n;
+    if (!pressure_sum.take(pressure, variance, n)) {
+        pressure_stats.samples = 0;
+        return;
+    }
+    pressure_stats.noise = sqrtf(variance);
+    pressure_stats.samples = n;
+    pressure_stats.valid = true;
+}
+
+void AP_Airspeed_Backend::average_temperature(float &temperature)
+{
+    float variance;
+    uint16_t n;
+    temperature_sum.take(temperature, variance, n);
+}
+
+bool AP_Airspeed_Backend::get_pressure_noise(float &noise, uint16_t &samples)
+{
+    WITH_SEMAPHORE(sem);
+    if (!pressure_stats.valid) {
+        return false;
+    }
+    noise = pressure_stats.noise;
+    samples = pressure_stats.samples;
+    return true;
+}
+
 #endif  // AP_AIRSPEED_ENABLED
@@ -58,6 +58,11 @@ public:
     virtual bool get_hygrometer(uint32_t &last_sample_ms, float &temperature, float &humidity) { return false; }
 #endif
 
+    // standard deviation in Pascal of the raw pressure samples
+    // averaged by the last get_differential_pressure(), and their
+    // number. False if the backend doesn't average samples
+    bool get_pressure_noise(float &noise, uint16_t &samples);
+
 protected:
     int8_t get_pin(void) const;
     float get_psi_range(void) const;
@@ -105,6 +110,20 @@ protected:
     // set bus ID of this instance, for ARSPD_DEVID parameters
     void set_bus_id(uint32_t id);
 
+    /*
+      every raw sample read by the backend between reads by the
+      frontend is added with these, with sem held
+     */
+    void add_pressure_sample(float pressure) { pressure_sum.add(pressure); }
+    void add_temperature_sample(float temperature) { temperature_sum.add(temperature); }
+
+    /*
+      average the samples added since the last call into value,
+      leaving it unchanged if there are none. Call with sem held
+     */
+    void average_pressure(float &pressure);
+    void average_temperature(float &temperature);
+
     enum class DevType {
         SITL     = 0x01,
         MS4525   = 0x02,
@@ -122,6 +141,26 @@ protected:
 private:
     AP_Airspeed &frontend;
     uint8_t instance;
+
+    // running sums of raw samples. Samples are summed relative to
+    // the first one so the variance doesn't lose precision
+    struct SampleSum {
+        float first;
+        float sum;
+        float sum_sq;
+        uint16_t count;
+
+        void add(float v);
+        // mean and variance of the samples, clearing the sums
+        bool take(float &mean, float &variance, uint16_t &n);
+    } pressure_sum, temperature_sum;
+
+    // statistics of the last pressure average
+    struct {
+        float noise;
+        uint16_t samples;
+        bool valid;
+    } pressure_stats;
 };
 
 #endif  // AP_AIRSPEED_ENABLED
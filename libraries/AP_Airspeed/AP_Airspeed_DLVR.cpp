@@ -27,6 +27,12 @@ extern const AP_HAL::HAL &hal;
 
 #define DLVR_I2C_ADDR 0x28
 
+// the sensor updates much faster than this, every sample between
+// reads by the frontend is averaged
+#ifndef AP_AIRSPEED_DLVR_RATE_HZ
+#define AP_AIRSPEED_DLVR_RATE_HZ 100U
+#endif
+
 #ifdef DLVR_DEBUGGING
  # define Debug(fmt, args ...)  do {hal.console->printf("%s:%d: " fmt "\n", __FUNCTION__, __LINE__, ## args); hal.scheduler->delay(1); } while(0)
 #else
@@ -68,7 +74,7 @@ void AP_Airspeed_DLVR::setup()
     dev->set_device_type(uint8_t(DevType::DLVR));
     set_bus_id(dev->get_bus_id());
 
-    dev->register_periodic_callback(1000000UL/50U,
+    dev->register_periodic_callback(1000000UL/AP_AIRSPEED_DLVR_RATE_HZ,
                                     FUNCTOR_BIND_MEMBER(&AP_Airspeed_DLVR::timer, void));
 }
 
@@ -135,10 +141,8 @@ void AP_Airspeed_DLVR::timer()
     }
 #pragma GCC diagnostic pop
 
-    pressure_sum += INCH_OF_H2O_TO_PASCAL * press_h2o;
-    temperature_sum += temp;
-    press_count++;
-    temp_count++;
+    add_pressure_sample(INCH_OF_H2O_TO_PASCAL * press_h2o);
+    add_temperature_sample(temp);
     last_sample_time_ms = now;
 }
 
@@ -151,11 +155,7 @@ bool AP_Airspeed_DLVR::get_differential_pressure(float &_pressure)
         return false;
     }
 
-    if (press_count > 0) {
-        pressure = pressure_sum / press_count;
-        press_count = 0;
-        pressure_sum = 0;
-    }
+    average_pressure(pressure);
 
     _pressure = pressure;
     return true;
@@ -170,11 +170,7 @@ bool AP_Airspeed_DLVR::get_temperature(float &_temperature)
         return false;
     }
 
-    if (temp_count > 0) {
-        temperature = temperature_sum / temp_count;
-        temp_count = 0;
-        temperature_sum = 0;
-    }
+    average_temperature(temperature);
 
     _temperature = temperature;
     return true;
@@ -95,8 +95,8 @@ found_sensor:
     // drop to 2 retries for runtime
     _dev->set_retries(2);
     
-    _dev->register_periodic_callback(20000,
-                                     FUNCTOR_BIND_MEMBER(&AP_Airspeed_MS4525::_timer, void));
+    _poller.register_callback(*_dev, 20000,
+                              FUNCTOR_BIND_MEMBER(&AP_Airspeed_MS4525::_timer, void));
     return true;
 }
 
@@ -197,10 +197,10 @@ void AP_Airspeed_MS4525::_collect()
 
     WITH_SEMAPHORE(sem);
 
-    _press_sum += press + press2;
-    _temp_sum += temp + temp2;
-    _press_count += 2;
-    _temp_count += 2;
+    add_pressure_sample(press);
+    add_pressure_sample(press2);
+    add_temperature_sample(temp);
+    add_temperature_sample(temp2);
 
     _last_sample_time_ms = AP_HAL::millis();
 }
@@ -228,9 +228,11 @@ void AP_Airspeed_MS4525::_voltage_correction(float &diff_press_pa, float &temper
 	temperature -= voltage_diff * temp_slope;
 }
 
-// 50Hz timer
+// 50Hz timer, slower when the data isn't needed
 void AP_Airspeed_MS4525::_timer()
 {
+    _poller.update(*_dev);
+
     if (_measurement_started_ms == 0) {
         _measure();
         return;
@@ -251,12 +253,7 @@ bool AP_Airspeed_MS4525::get_differential_pressure(float &pressure)
         return false;
     }
 
-    if (_press_count > 0) {
-        _pressure = _press_sum / _press_count;
-        _press_count = 0;
-        _press_sum = 0;
-    }
-
+    average_pressure(_pressure);
     pressure = _pressure;
     return true;
 }
@@ -270,12 +267,7 @@ bool AP_Airspeed_MS4525::get_temperature(float &temperature)
         return false;
     }
 
-    if (_temp_count > 0) {
-        _temperature = _temp_sum / _temp_count;
-        _temp_count = 0;
-        _temp_sum = 0;
-    }
-
+    average_temperature(_temperature);
     temperature = _temperature;
     return true;
 }
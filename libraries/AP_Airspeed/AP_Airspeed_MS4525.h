@@ -24,6 +24,7 @@
 
 #include <AP_HAL/AP_HAL.h>
 #include <AP_HAL/I2CDevice.h>
+#include <AP_Common/AP_SensorDemand.h>
 #include <utility>
 
 #include "AP_Airspeed_Backend.h"
@@ -54,15 +55,12 @@ private:
     float _get_pressure(int16_t dp_raw) const;
     float _get_temperature(int16_t dT_raw) const;
 
-    float _temp_sum;
-    float _press_sum;
-    uint32_t _temp_count;
-    uint32_t _press_count;
     float _temperature;
     float _pressure;
     uint32_t _last_sample_time_ms;
     uint32_t _measurement_started_ms;
     AP_HAL::I2CDevice *_dev;
+    AP_SensorDemand::Poller _poller{AP_SensorDemand::Sensor::AIRSPEED};
 
     bool probe(uint8_t bus, uint8_t address);
 };
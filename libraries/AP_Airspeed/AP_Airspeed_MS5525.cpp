@@ -203,10 +203,8 @@ void AP_Airspeed_MS5525::calculate(void)
     
     WITH_SEMAPHORE(sem);
 
-    pressure_sum += P_Pa;
-    temperature_sum += Temp_C;
-    press_count++;
-    temp_count++;
+    add_pressure_sample(P_Pa);
+    add_temperature_sample(Temp_C);
     last_sample_time_ms = AP_HAL::millis();
 }
 
@@ -272,11 +270,7 @@ bool AP_Airspeed_MS5525::get_differential_pressure(float &_pressure)
         return false;
     }
 
-    if (press_count > 0) {
-        pressure = pressure_sum / press_count;
-        press_count = 0;
-        pressure_sum = 0;
-    }
+    average_pressure(pressure);
     _pressure = pressure;
 
     return true;
@@ -291,12 +285,7 @@ bool AP_Airspeed_MS5525::get_temperature(float &_temperature)
         return false;
     }
 
-    if (temp_count > 0) {
-        temperature = temperature_sum / temp_count;
-        temp_count = 0;
-        temperature_sum = 0;
-    }
-
+    average_temperature(temperature);
     _temperature = temperature;
     return true;
 }
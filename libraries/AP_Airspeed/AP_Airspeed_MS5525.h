@@ -62,10 +62,6 @@ private:
 
     float pressure;
     float temperature;
-    float temperature_sum;
-    float pressure_sum;
-    uint32_t temp_count;
-    uint32_t press_count;
     
     uint32_t last_sample_time_ms;
 
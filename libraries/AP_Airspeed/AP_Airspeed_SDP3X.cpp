@@ -177,10 +177,8 @@ void AP_Airspeed_SDP3X::_timer()
 
     WITH_SEMAPHORE(sem);
 
-    _press_sum += diff_press_pa;
-    _temp_sum += temperature;
-    _press_count++;
-    _temp_count++;
+    add_pressure_sample(diff_press_pa);
+    add_temperature_sample(temperature);
     _last_sample_time_ms = now;
 }
 
@@ -291,12 +289,7 @@ bool AP_Airspeed_SDP3X::get_differential_pressure(float &pressure)
         return false;
     }
 
-    if (_press_count > 0) {
-        _press = _press_sum / _press_count;
-        _press_count = 0;
-        _press_sum = 0;
-    }
-
+    average_pressure(_press);
     pressure = _correct_pressure(_press);
     return true;
 }
@@ -310,12 +303,7 @@ bool AP_Airspeed_SDP3X::get_temperature(float &temperature)
         return false;
     }
 
-    if (_temp_count > 0) {
-        _temp = _temp_sum / _temp_count;
-        _temp_count = 0;
-        _temp_sum = 0;
-    }
-
+    average_temperature(_temp);
     temperature = _temp;
     return true;
 }
@@ -60,10 +60,6 @@ private:
 
     float _temp;
     float _press;
-    uint16_t _temp_count;
-    uint16_t _press_count;
-    float _temp_sum;
-    float _press_sum;
     uint32_t _last_sample_time_ms;
     uint16_t _scale;
 
@@ -18,6 +18,7 @@
 #if AP_ARMING_ENABLED
 
 #include "AP_Arming.h"
+#include <AP_Common/AP_BootTrace.h>
 #include <AP_HAL/AP_HAL.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
 #include <AP_BattMonitor/AP_BattMonitor.h>
@@ -79,6 +80,12 @@
 #define AP_ARMING_MAGFIELD_ERROR_THRESHOLD 100
 #define AP_ARMING_AHRS_GPS_ERROR_MAX    10      // accept up to 10m difference between AHRS and GPS
 
+#if AP_ARMING_CHECK_TIMING_ENABLED
+#define ARMING_CHECK_TIMER(check) CheckTimer check_timer(*this, TimedCheck::check)
+#else
+#define ARMING_CHECK_TIMER(check)
+#endif
+
 #if APM_BUILD_TYPE(APM_BUILD_ArduPlane)
   #define ARMING_RUDDER_DEFAULT         (uint8_t)RudderArming::ARMONLY
 #else
@@ -244,9 +251,53 @@ void AP_Arming::update(void)
         display_fail = false;
     }
 
-    pre_arm_checks(display_fail);
+    bool checks_passed;
+    {
+        ARMING_CHECK_TIMER(ALL);
+        checks_passed = pre_arm_checks(display_fail);
+    }
+    if (checks_passed) {
+        // end of the boot trace
+#if AP_BOOT_TRACE_ENABLED
+        AP::boot_trace().ready_to_arm();
+#endif
+    }
+
+#if AP_ARMING_CHECK_TIMING_ENABLED
+    if (display_fail) {
+        report_check_timing();
+    }
+#endif
 }
 
+#if AP_ARMING_CHECK_TIMING_ENABLED
+AP_Arming::CheckTimer::CheckTimer(const AP_Arming &_arming, TimedCheck _check) :
+    arming(_arming),
+    check(_check),
+    start_us(AP_HAL::micros())
+{
+}
+
+AP_Arming::CheckTimer::~CheckTimer()
+{
+    const uint32_t dt_us = MIN(AP_HAL::micros() - start_us, UINT16_MAX);
+    uint16_t &max_us = arming.check_time_max_us[uint8_t(check)];
+    max_us = MAX(max_us, uint16_t(dt_us));
+}
+
+// report the longest time taken by each timed check since the last report
+void AP_Arming::report_check_timing()
+{
+    GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "Arming: max us mis=%u fen=%u ter=%u sys=%u all=%u",
+                  unsigned(check_time_max_us[uint8_t(TimedCheck::MISSION)]),
+                  unsigned(check_time_max_us[uint8_t(TimedCheck::FENCE)]),
+                  unsigned(check_time_max_us[uint8_t(TimedCheck::TERRAIN)]),
+                  unsigned(check_time_max_us[uint8_t(TimedCheck::SYSTEM)]),
+                  unsigned(check_time_max_us[uint8_t(TimedCheck::ALL)]));
+    memset(check_time_max_us, 0, sizeof(check_time_max_us));
+}
+#endif // AP_ARMING_CHECK_TIMING_ENABLED
+
 #if AP_ARMING_CRASHDUMP_ACK_ENABLED
 void AP_Arming::CrashDump::check_reset()
 {
@@ -869,6 +920,8 @@ bool AP_Arming::manual_transmitter_checks(bool report)
 #if AP_MISSION_ENABLED
 bool AP_Arming::mission_checks(bool report)
 {
+    ARMING_CHECK_TIMER(MISSION);
+
     AP_Mission *mission = AP::mission();
     if (check_enabled(Check::MISSION) && _required_mission_items) {
         if (mission == nullptr) {
@@ -888,13 +941,25 @@ bool AP_Arming::mission_checks(bool report)
           {MIS_ITEM_CHECK_VTOL_TAKEOFF,  MAV_CMD_NAV_VTOL_TAKEOFF,   "vtol takeoff"},
           {MIS_ITEM_CHECK_RETURN_TO_LAUNCH,  MAV_CMD_NAV_RETURN_TO_LAUNCH,   "RTL"},
         };
-        for (uint8_t i = 0; i < ARRAY_SIZE(misChecks); i++) {
-            if (_required_mission_items & misChecks[i].check) {
-                if (!mission->contains_item(misChecks[i].mis_item_type)) {
-                    check_failed(Check::MISSION, report, "Missing mission item: %s", misChecks[i].type);
-                    return false;
+        const uint32_t required_items = _required_mission_items;
+        if (!mission_items.valid ||
+            mission_items.mission_change_ms != mission->last_change_time_ms() ||
+            mission_items.required_items != required_items) {
+            mission_items.missing_item = UINT8_MAX;
+            for (uint8_t i = 0; i < ARRAY_SIZE(misChecks); i++) {
+                if ((required_items & misChecks[i].check) &&
+                    !mission->contains_item(misChecks[i].mis_item_type)) {
+                    mission_items.missing_item = i;
+                    break;
                 }
             }
+            mission_items.mission_change_ms = mission->last_change_time_ms();
+            mission_items.required_items = required_items;
+            mission_items.valid = true;
+        }
+        if (mission_items.missing_item < ARRAY_SIZE(misChecks)) {
+            check_failed(Check::MISSION, report, "Missing mission item: %s", misChecks[mission_items.missing_item].type);
+            return false;
         }
         if (_required_mission_items & MIS_ITEM_CHECK_RALLY) {
 #if HAL_RALLY_ENABLED
@@ -1069,6 +1134,8 @@ bool AP_Arming::heater_min_temperature_checks(bool report)
  */
 bool AP_Arming::system_checks(bool report)
 {
+    ARMING_CHECK_TIMER(SYSTEM);
+
     char buffer[MAVLINK_MSG_STATUSTEXT_FIELD_TEXT_LEN+1] {};
 
     if (check_enabled(Check::SYSTEM)) {
@@ -1181,6 +1248,8 @@ bool AP_Arming::terrain_database_required() const
 // check terrain database is fit-for-purpose
 bool AP_Arming::terrain_checks(bool report) const
 {
+    ARMING_CHECK_TIMER(TERRAIN);
+
     if (!check_enabled(Check::PARAMETERS)) {
         return true;
     }
@@ -1303,6 +1372,8 @@ bool AP_Arming::can_checks(bool report)
 #if AP_FENCE_ENABLED
 bool AP_Arming::fence_checks(bool display_failure)
 {
+    ARMING_CHECK_TIMER(FENCE);
+
     const AC_Fence *fence = AP::fence();
     if (fence == nullptr) {
         return true;
@@ -4,6 +4,7 @@
 #include <AP_HAL/Semaphores.h>
 #include <AP_Param/AP_Param.h>
 #include <AP_GPS/AP_GPS_config.h>
+#include <AP_Mission/AP_Mission_config.h>
 #include <AP_BoardConfig/AP_BoardConfig_config.h>
 
 #include "AP_Arming_config.h"
@@ -305,6 +306,42 @@ private:
         MIS_ITEM_CHECK_MAX
     };
 
+#if AP_MISSION_ENABLED
+    // result of the search for required mission items. Searching
+    // reads every command from storage, so it is only repeated when
+    // the mission or the required items change
+    struct {
+        uint32_t mission_change_ms;
+        uint32_t required_items;
+        uint8_t missing_item;   // index of first missing item, UINT8_MAX if none
+        bool valid;
+    } mission_items;
+#endif
+
+#if AP_ARMING_CHECK_TIMING_ENABLED
+    enum class TimedCheck : uint8_t {
+        MISSION = 0,
+        FENCE,
+        TERRAIN,
+        SYSTEM,
+        ALL,
+        NUM_CHECKS
+    };
+    // longest time taken by each check since the last report
+    mutable uint16_t check_time_max_us[uint8_t(TimedCheck::NUM_CHECKS)];
+
+    class CheckTimer {
+    public:
+        CheckTimer(const AP_Arming &_arming, TimedCheck _check);
+        ~CheckTimer();
+    private:
+        const AP_Arming &arming;
+        const TimedCheck check;
+        const uint32_t start_us;
+    };
+    void report_check_timing();
+#endif
+
 #if AP_ARMING_AUX_AUTH_ENABLED
     // auxiliary authorisation
     static const uint8_t aux_auth_count_max = 3;    // maximum number of auxiliary authorisers
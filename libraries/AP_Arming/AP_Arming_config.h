@@ -13,3 +13,9 @@
 #ifndef AP_ARMING_CRASHDUMP_ACK_ENABLED
 #define AP_ARMING_CRASHDUMP_ACK_ENABLED AP_CRASHDUMP_ENABLED
 #endif
+
+// report the time taken by the slower pre-arm checks, for finding
+// disarmed loop overruns
+#ifndef AP_ARMING_CHECK_TIMING_ENABLED
+#define AP_ARMING_CHECK_TIMING_ENABLED 0
+#endif
@@ -241,6 +241,8 @@ void AP_Avoidance::add_obstacle(const uint32_t obstacle_timestamp_ms,
     _obstacles[index]._location = loc;
     _obstacles[index]._velocity = vel_ned;
     _obstacles[index].timestamp_ms = obstacle_timestamp_ms;
+    // new information, so recalculate the threat level on the next check
+    _obstacles[index].next_check_ms = 0;
 }
 
 void AP_Avoidance::add_obstacle(const uint32_t obstacle_timestamp_ms,
@@ -287,9 +289,16 @@ float closest_approach_xy(const Location &my_loc,
                           const Vector3f &obstacle_vel,
                           const uint8_t time_horizon)
 {
+    return closest_approach_xy(obstacle_loc.get_distance_NE(my_loc), my_vel, obstacle_vel, time_horizon);
+}
 
+// as above, with the position of my_loc relative to the obstacle
+float closest_approach_xy(const Vector2f &delta_pos_ne,
+                          const Vector3f &my_vel,
+                          const Vector3f &obstacle_vel,
+                          const uint8_t time_horizon)
+{
     Vector2f delta_vel_ne = Vector2f(obstacle_vel[0] - my_vel[0], obstacle_vel[1] - my_vel[1]);
-    const Vector2f delta_pos_ne = obstacle_loc.get_distance_NE(my_loc);
 
     Vector2f line_segment_ne = delta_vel_ne * time_horizon;
 
@@ -334,22 +343,26 @@ float closest_approach_z(const Location &my_loc,
     return ret*0.01f;
 }
 
-void AP_Avoidance::update_threat_level(const Location &my_loc,
+void AP_Avoidance::update_threat_level(const LocationFrame &my_frame,
                                        const Vector3f &my_vel,
                                        AP_Avoidance::Obstacle &obstacle)
 {
 
+    const Location &my_loc = my_frame.get_origin();
     Location &obstacle_loc = obstacle._location;
     Vector3f &obstacle_vel = obstacle._velocity;
 
+    // our position relative to the obstacle
+    const Vector2f delta_pos_ne = -my_frame.get_distance_NE(obstacle_loc);
+
     obstacle.threat_level = MAV_COLLISION_THREAT_LEVEL_NONE;
 
     const uint32_t obstacle_age = AP_HAL::millis() - obstacle.timestamp_ms;
-    float closest_xy = closest_approach_xy(my_loc, my_vel, obstacle_loc, obstacle_vel, _fail_time_horizon + obstacle_age/1000);
+    float closest_xy = closest_approach_xy(delta_pos_ne, my_vel, obstacle_vel, _fail_time_horizon + obstacle_age/1000);
     if (closest_xy < _fail_distance_xy) {
         obstacle.threat_level = MAV_COLLISION_THREAT_LEVEL_HIGH;
     } else {
-        closest_xy = closest_approach_xy(my_loc, my_vel, obstacle_loc, obstacle_vel, _warn_time_horizon + obstacle_age/1000);
+        closest_xy = closest_approach_xy(delta_pos_ne, my_vel, obstacle_vel, _warn_time_horizon + obstacle_age/1000);
         if (closest_xy < _warn_distance_xy) {
             obstacle.threat_level = MAV_COLLISION_THREAT_LEVEL_LOW;
         }
@@ -378,7 +391,7 @@ void AP_Avoidance::update_threat_level(const Location &my_loc,
     // level is none - but only *once the GCS has been informed*!
     obstacle.closest_approach_xy = closest_xy;
     obstacle.closest_approach_z = closest_z;
-    float current_distance = my_loc.get_distance(obstacle_loc);
+    float current_distance = delta_pos_ne.length();
     obstacle.distance_to_closest_approach = current_distance - closest_xy;
     Vector2f net_velocity_ne = Vector2f(my_vel[0] - obstacle_vel[0], my_vel[1] - obstacle_vel[1]);
     obstacle.time_to_closest_approach = 0.0f;
@@ -386,6 +399,20 @@ void AP_Avoidance::update_threat_level(const Location &my_loc,
         ! is_zero(net_velocity_ne.length())) {
         obstacle.time_to_closest_approach = obstacle.distance_to_closest_approach / net_velocity_ne.length();
     }
+
+    // An obstacle that is far enough away can't become a threat until
+    // either of us has closed the distance at up to MAX_CLOSING_SPEED,
+    // over both the time until the next check and the look-ahead
+    // horizon, which grows with its age.  Until then it is skipped by
+    // check_for_threats() unless it is updated, so a long list of
+    // distant ADSB vehicles costs little on each update
+    obstacle.next_check_ms = 0;
+    if (obstacle.threat_level == MAV_COLLISION_THREAT_LEVEL_NONE) {
+        const float slack_s = ((current_distance - _warn_distance_xy) / MAX_CLOSING_SPEED - (_warn_time_horizon + obstacle_age*0.001f)) * 0.5f;
+        if (slack_s > 0) {
+            obstacle.next_check_ms = AP_HAL::millis() + MIN(uint32_t(slack_s * 1000), MAX_RECHECK_INTERVAL_MS);
+        }
+    }
 }
 
 MAV_COLLISION_THREAT_LEVEL AP_Avoidance::current_threat_level() const {
@@ -475,17 +502,22 @@ void AP_Avoidance::check_for_threats()
         return;
     }
 
-    // we always check all obstacles to see if they are threats since it
-    // is most likely our own position and/or velocity have changed
+    // we check all obstacles to see if they are threats since it is
+    // most likely our own position and/or velocity have changed, except
+    // those too far away to have become one since they were last checked.
     // determine the current most-serious-threat
     _current_most_serious_threat = -1;
+    const uint32_t now_ms = AP_HAL::millis();
+    const LocationFrame my_frame{my_loc};
     for (uint8_t i=0; i<_obstacle_count; i++) {
 
         AP_Avoidance::Obstacle &obstacle = _obstacles[i];
-        const uint32_t obstacle_age = AP_HAL::millis() - obstacle.timestamp_ms;
+        const uint32_t obstacle_age = now_ms - obstacle.timestamp_ms;
         debug("i=%d src_id=%d timestamp=%u age=%d", i, obstacle.src_id, obstacle.timestamp_ms, obstacle_age);
 
-        update_threat_level(my_loc, my_vel, obstacle);
+        if (obstacle.next_check_ms == 0 || int32_t(now_ms - obstacle.next_check_ms) >= 0) {
+            update_threat_level(my_frame, my_vel, obstacle);
+        }
         debug("   threat-level=%d", obstacle.threat_level);
 
         // ignore any really old data:
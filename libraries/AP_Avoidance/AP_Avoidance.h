@@ -74,6 +74,7 @@ public:
         float time_to_closest_approach; // seconds, 3D approach
         float distance_to_closest_approach; // metres, 3D
         uint32_t last_gcs_report_time; // millis
+        uint32_t next_check_ms; // millis, threat level need not be recalculated before this unless the obstacle is updated
     };
 
 
@@ -156,6 +157,12 @@ private:
     const uint32_t MAX_OBSTACLE_AGE_MS = 5000;      // obstacles that have not been heard from for 5 seconds are removed from the list
     const static uint8_t _gcs_notify_interval = 1; // seconds
 
+    // highest closing speed assumed between us and an obstacle when
+    // deciding how long a distant obstacle can go without its threat
+    // level being recalculated, and the longest it can go
+    const float MAX_CLOSING_SPEED = 200.0f; // meters/second
+    const uint32_t MAX_RECHECK_INTERVAL_MS = 2000;
+
     // speed below which we will fly directly away from a threat
     // rather than perpendicular to its velocity:
     const uint8_t _low_velocity_threshold = 1; // meters/second
@@ -173,7 +180,7 @@ private:
     uint32_t src_id_for_adsb_vehicle(const AP_ADSB::adsb_vehicle_t &vehicle) const;
 
     void check_for_threats();
-    void update_threat_level(const Location &my_loc,
+    void update_threat_level(const LocationFrame &my_frame,
                              const Vector3f &my_vel,
                              AP_Avoidance::Obstacle &obstacle);
 
@@ -221,6 +228,10 @@ float closest_approach_xy(const Location &my_loc,
                           const Location &obstacle_loc,
                           const Vector3f &obstacle_vel,
                           uint8_t time_horizon);
+float closest_approach_xy(const Vector2f &delta_pos_ne,
+                          const Vector3f &my_vel,
+                          const Vector3f &obstacle_vel,
+                          uint8_t time_horizon);
 
 float closest_approach_z(const Location &my_loc,
                          const Vector3f &my_vel,
@@ -25,6 +25,7 @@
 #include <GCS_MAVLink/GCS.h>
 #include <AP_Common/AP_Common.h>
 #include <AP_HAL/AP_HAL.h>
+#include <AP_Common/AP_BootTrace.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
 #include <AP_CANManager/AP_CANManager.h>
@@ -367,6 +368,8 @@ void AP_Baro::calibrate(bool save)
     _guessed_ground_temperature = get_external_temperature();
 
     // panic if all sensors are not calibrated
+    AP_BOOT_TRACE("baro cal");
+
     uint8_t num_calibrated = 0;
     for (uint8_t i=0; i<_num_sensors; i++) {
         if (sensors[i].calibrated) {
@@ -677,6 +680,7 @@ void AP_Baro::init(void)
         AP_BoardConfig::config_error("Baro: unable to initialise driver");
     }
 #endif
+    AP_BOOT_TRACE("baro detect");
 #ifdef HAL_BUILD_AP_PERIPH
     // AP_Periph always is set calibrated. We only want the pressure,
     // so ground calibration is unnecessary
@@ -767,12 +771,34 @@ void AP_Baro::_probe_i2c_barometers(void)
 #endif  // APM_BUILD_TYPE(APM_BUILD_ArduSub)
     };
 
+#if AP_HAL_I2C_PROBE_SCAN_ENABLED
+    // check all the addresses on all the buses at once, so absent
+    // devices are skipped below without waiting on each of them
+    AP_HAL::I2CProbeScan scan;
+    for (const auto &spec : baroprobespec) {
+        if (!(probe & spec.bit)) {
+            continue;
+        }
+        FOREACH_I2C_MASK(i, mask) {
+            if (!_have_i2c_driver(i, spec.addr)) {
+                scan.add(i, spec.addr);
+            }
+        }
+    }
+    scan.scan();
+#endif
+
     for (const auto &spec : baroprobespec) {
         if (!(probe & spec.bit)) {
             // not in mask to be probed for
             continue;
         }
         FOREACH_I2C_MASK(i, mask) {
+#if AP_HAL_I2C_PROBE_SCAN_ENABLED
+            if (!scan.maybe_present(i, spec.addr)) {
+                continue;
+            }
+#endif
             ADD_BACKEND(spec.probefn(*this, std::move(GET_I2C_DEVICE(i, spec.addr))));
         }
     }
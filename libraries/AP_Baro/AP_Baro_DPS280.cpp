@@ -200,7 +200,7 @@ bool AP_Baro_DPS280::init(bool _is_dps310)
     dev->get_semaphore()->give();
 
     // request 64Hz update. New data will be available at 32Hz
-    dev->register_periodic_callback((1000 / 64) * AP_USEC_PER_MSEC, FUNCTOR_BIND_MEMBER(&AP_Baro_DPS280::timer, void));
+    poller.register_callback(*dev, (1000 / 64) * AP_USEC_PER_MSEC, FUNCTOR_BIND_MEMBER(&AP_Baro_DPS280::timer, void));
 
     return true;
 }
@@ -249,6 +249,8 @@ void AP_Baro_DPS280::check_health(void)
 //  accumulate a new sensor reading
 void AP_Baro_DPS280::timer(void)
 {
+    poller.update(*dev);
+
     uint8_t buf[6];
     uint8_t ready;
 
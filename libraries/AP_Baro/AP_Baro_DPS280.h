@@ -7,6 +7,7 @@
 #include <AP_HAL/AP_HAL.h>
 #include <AP_HAL/Device.h>
 #include <AP_HAL/utility/OwnPtr.h>
+#include <AP_Common/AP_SensorDemand.h>
 
 #ifndef HAL_BARO_DPS280_I2C_ADDR
  #define HAL_BARO_DPS280_I2C_ADDR  0x76
@@ -40,6 +41,7 @@ protected:
     void check_health();
 
     AP_HAL::OwnPtr<AP_HAL::Device> dev;
+    AP_SensorDemand::Poller poller{AP_SensorDemand::Sensor::BARO};
 
     uint8_t instance;
 
@@ -7,6 +7,7 @@
 #include <AP_HAL/AP_HAL.h>
 #include <AP_HAL/Semaphores.h>
 #include <AP_HAL/Device.h>
+#include <AP_Common/AP_SensorDemand.h>
 
 #ifndef HAL_BARO_MS5611_I2C_ADDR
 #define HAL_BARO_MS5611_I2C_ADDR 0x77
@@ -33,6 +34,12 @@
 #define MS5837_30BA_02BA_SELECTION_THRESHOLD 37000
 #endif
 
+// pressure samples averaged into each sample of the fitted window,
+// one temperature and pressure cycle of the read state machine
+#define MS56XX_FIT_DECIMATION 4
+// number of decimated pressure samples in the fitted window
+#define MS56XX_FIT_WINDOW 8
+
 class AP_Baro_MS56XX : public AP_Baro_Backend
 {
 public:
@@ -58,6 +65,12 @@ protected:
     /* Last compensated values from accumulated sample */
     float _D1, _D2;
 
+    /*
+      set by sensors sampled fast enough to use a lag compensated
+      pressure estimate, must be set before AP_Baro_MS56XX::_init()
+     */
+    bool _fast_sample;
+
     // Internal calibration registers
     struct {
         uint16_t c1, c2, c3, c4, c5, c6;
@@ -73,12 +86,19 @@ private:
     static void _update_and_wrap_accumulator(uint32_t *accum, uint32_t val,
                                              uint8_t *count, uint8_t max_count);
 
+    // add a pressure sample to the fitted window, decimating it
+    void _update_fit_window(uint32_t val);
+
+    // fit a line through samples, oldest first, evaluated at the newest
+    static float _fit_newest(const float *samples, uint8_t n);
+
     uint16_t _read_prom_word(uint8_t word);
     uint32_t _read_adc();
 
     void _timer();
 
     AP_HAL::OwnPtr<AP_HAL::Device> _dev;
+    AP_SensorDemand::Poller _poller{AP_SensorDemand::Sensor::BARO};
 
     /* Shared values between thread sampling the HW and main thread */
     struct {
@@ -88,6 +108,15 @@ private:
         uint8_t d2_count;
     } _accum;
 
+    /* Decimated pressure samples, shared like _accum */
+    struct {
+        uint32_t block_sum;
+        uint8_t block_count;
+        float samples[MS56XX_FIT_WINDOW];
+        uint8_t next;
+        uint8_t count;
+    } _fit;
+
     uint8_t _state;
 
     bool _discard_next;
@@ -40,7 +40,11 @@ void AP_BattMonitor_EFI::read()
     /*
       a simple mapping of 1 Amp == 1 litre/hour and 1Ah = 1Litre
      */
-    efi->get_state(efi_state);
+    if (!efi->get_state_if_newer(efi_state, efi_state_version)) {
+        // nothing new, keep the last values
+        _state.healthy = true;
+        return;
+    }
 
     _state.current_amps = efi_state.fuel_consumption_rate_cm3pm*0.001*60; // litres/hour
     // use arbitrary 1.0 Volts
@@ -21,5 +21,8 @@ public:
     bool has_consumed_energy(void) const override {
         return true;
     }
+
+private:
+    uint32_t efi_state_version;
 };
 #endif // AP_BATTERY_EFI_ENABLED
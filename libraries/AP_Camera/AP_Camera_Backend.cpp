@@ -48,6 +48,7 @@ void AP_Camera_Backend::update()
     }
 
     // check feedback pin
+    record_pose();
     check_feedback();
 
     // time based triggering
@@ -387,11 +388,19 @@ void AP_Camera_Backend::setup_feedback_callback()
     }
 }
 
+// queue a feedback pin event, called from the interrupt or timer
+void AP_Camera_Backend::feedback_pin_event(uint32_t timestamp_us)
+{
+    // the timestamp must be in place before the count says it is there
+    feedback_trigger_timestamps_us[feedback_trigger_count % AP_CAMERA_FEEDBACK_QUEUE_LEN] = timestamp_us;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    feedback_trigger_count++;
+}
+
 // interrupt handler for interrupt based feedback trigger
 void AP_Camera_Backend::feedback_pin_isr(uint8_t pin, bool high, uint32_t timestamp_us)
 {
-    feedback_trigger_timestamp_us = timestamp_us;
-    feedback_trigger_count++;
+    feedback_pin_event(timestamp_us);
 }
 
 // check if feedback pin is high for timer based feedback trigger, when
@@ -402,43 +411,116 @@ void AP_Camera_Backend::feedback_pin_timer()
     uint8_t trigger_polarity = _params.feedback_polarity == 0 ? 0 : 1;
     if (pin_state == trigger_polarity &&
         last_pin_state != trigger_polarity) {
-        feedback_trigger_timestamp_us = AP_HAL::micros();
-        feedback_trigger_count++;
+        feedback_pin_event(AP_HAL::micros());
     }
     last_pin_state = pin_state;
 }
 
-// check for feedback pin update and log if necessary
+// check for feedback pin updates and log each of them with the pose
+// at the time the pin changed
 void AP_Camera_Backend::check_feedback()
 {
-    if (feedback_trigger_logged_count != feedback_trigger_count) {
+    const uint32_t trigger_count = feedback_trigger_count;
+    if (feedback_trigger_logged_count == trigger_count) {
+        return;
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    // events beyond the length of the queue have been overwritten
+    if (trigger_count - feedback_trigger_logged_count > AP_CAMERA_FEEDBACK_QUEUE_LEN) {
+        feedback_trigger_logged_count = trigger_count - AP_CAMERA_FEEDBACK_QUEUE_LEN;
+    }
+
 #if HAL_LOGGING_ENABLED
-        const uint32_t timestamp32 = feedback_trigger_timestamp_us;
+    const uint32_t now_us = AP_HAL::micros();
+    const uint64_t now_us64 = AP_HAL::micros64();
 #endif
-        feedback_trigger_logged_count = feedback_trigger_count;
+    while (feedback_trigger_logged_count != trigger_count) {
+        const uint32_t timestamp32 = feedback_trigger_timestamps_us[feedback_trigger_logged_count % AP_CAMERA_FEEDBACK_QUEUE_LEN];
+        feedback_trigger_logged_count++;
 
-        // we should consider doing this inside the ISR and pin_timer
-        prep_mavlink_msg_camera_feedback(feedback_trigger_timestamp_us);
+        Pose pose;
+        get_pose_at(timestamp32, pose);
+        prep_mavlink_msg_camera_feedback(timestamp32, pose);
 
 #if HAL_LOGGING_ENABLED
         // log camera message
-        uint32_t tdiff = AP_HAL::micros() - timestamp32;
-        uint64_t timestamp = AP_HAL::micros64();
-        Write_Camera(timestamp - tdiff);
+        Write_Camera(now_us64 - (now_us - timestamp32), &pose);
 #endif
     }
 }
 
-void AP_Camera_Backend::prep_mavlink_msg_camera_feedback(uint64_t timestamp_us)
+// get the vehicle's current location and attitude
+void AP_Camera_Backend::get_current_pose(Pose &pose) const
 {
     const AP_AHRS &ahrs = AP::ahrs();
-    if (!ahrs.get_location(camera_feedback.location)) {
+    if (!ahrs.get_location(pose.location)) {
         // completely ignore this failure!  AHRS will provide its best guess.
     }
+    pose.time_us = AP_HAL::micros();
+    pose.roll_deg = ahrs.get_roll_deg();
+    pose.pitch_deg = ahrs.get_pitch_deg();
+    pose.yaw_deg = ahrs.get_yaw_deg();
+}
+
+// add the current pose to the history, only needed with a feedback pin
+void AP_Camera_Backend::record_pose()
+{
+    if (_params.feedback_pin <= 0) {
+        return;
+    }
+    pose_history_head = (pose_history_head + 1) % AP_CAMERA_POSE_HISTORY_LEN;
+    get_current_pose(pose_history[pose_history_head]);
+    pose_history_count = MIN(pose_history_count + 1, AP_CAMERA_POSE_HISTORY_LEN);
+}
+
+// get the pose at time_us by interpolating between the recorded poses
+// either side of it. Times outside the history use the nearest pose
+void AP_Camera_Backend::get_pose_at(uint32_t time_us, Pose &pose) const
+{
+    if (pose_history_count == 0) {
+        get_current_pose(pose);
+        return;
+    }
+    const Pose *newer = &pose_history[pose_history_head];
+    if (int32_t(time_us - newer->time_us) >= 0) {
+        pose = *newer;
+        return;
+    }
+    for (uint8_t i = 1; i < pose_history_count; i++) {
+        const Pose *older = &pose_history[(pose_history_head + AP_CAMERA_POSE_HISTORY_LEN - i) % AP_CAMERA_POSE_HISTORY_LEN];
+        if (int32_t(time_us - older->time_us) >= 0) {
+            const float frac = float(time_us - older->time_us) / float(newer->time_us - older->time_us);
+            pose = *older;
+            if (older->location.initialised() && newer->location.initialised()) {
+                pose.location.offset(older->location.get_distance_NED_postype(newer->location) * frac);
+            }
+            pose.roll_deg = wrap_180(older->roll_deg + wrap_180(newer->roll_deg - older->roll_deg) * frac);
+            pose.pitch_deg = older->pitch_deg + (newer->pitch_deg - older->pitch_deg) * frac;
+            pose.yaw_deg = wrap_360(older->yaw_deg + wrap_180(newer->yaw_deg - older->yaw_deg) * frac);
+            pose.time_us = time_us;
+            return;
+        }
+        newer = older;
+    }
+    // older than the history
+    pose = *newer;
+}
+
+void AP_Camera_Backend::prep_mavlink_msg_camera_feedback(uint64_t timestamp_us)
+{
+    Pose pose;
+    get_current_pose(pose);
+    prep_mavlink_msg_camera_feedback(timestamp_us, pose);
+}
+
+void AP_Camera_Backend::prep_mavlink_msg_camera_feedback(uint64_t timestamp_us, const Pose &pose)
+{
+    camera_feedback.location = pose.location;
     camera_feedback.timestamp_us = timestamp_us;
-    camera_feedback.roll_deg = ahrs.get_roll_deg();
-    camera_feedback.pitch_deg = ahrs.get_pitch_deg();
-    camera_feedback.yaw_deg = ahrs.get_yaw_deg();
+    camera_feedback.roll_deg = pose.roll_deg;
+    camera_feedback.pitch_deg = pose.pitch_deg;
+    camera_feedback.yaw_deg = pose.yaw_deg;
     camera_feedback.feedback_trigger_logged_count = feedback_trigger_logged_count;
 
     GCS_SEND_MESSAGE(MSG_CAMERA_FEEDBACK);
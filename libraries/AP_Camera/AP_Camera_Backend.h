@@ -160,10 +160,30 @@ protected:
     void setup_feedback_callback();
     void feedback_pin_isr(uint8_t pin, bool high, uint32_t timestamp_us);
     void feedback_pin_timer();
+    void feedback_pin_event(uint32_t timestamp_us);
     void check_feedback();
 
+    // vehicle location and attitude at a point in time
+    struct Pose {
+        uint32_t time_us;           // system time of the pose
+        Location location;
+        float roll_deg;
+        float pitch_deg;
+        float yaw_deg;
+    };
+    void get_current_pose(Pose &pose) const;
+
+    // history of poses so feedback pin events can be tagged with the
+    // pose when they happened rather than when they are processed
+    void record_pose();
+    void get_pose_at(uint32_t time_us, Pose &pose) const;
+    Pose pose_history[AP_CAMERA_POSE_HISTORY_LEN];
+    uint8_t pose_history_head;
+    uint8_t pose_history_count;
+
     // store vehicle location and attitude for use in camera_feedback message to GCS
     void prep_mavlink_msg_camera_feedback(uint64_t timestamp_us);
+    void prep_mavlink_msg_camera_feedback(uint64_t timestamp_us, const Pose &pose);
     struct {
         uint64_t timestamp_us;      // system time of most recent image
         Location location;          // location where most recent image was taken
@@ -181,9 +201,9 @@ protected:
 
     // Logging Function
     void log_picture();
-    void Write_Camera(uint64_t timestamp_us=0);
+    void Write_Camera(uint64_t timestamp_us=0, const Pose *pose=nullptr);
     void Write_Trigger();
-    void Write_CameraInfo(enum LogMessages msg, uint64_t timestamp_us=0);
+    void Write_CameraInfo(enum LogMessages msg, uint64_t timestamp_us=0, const Pose *pose=nullptr);
 
     // get corresponding mount instance for the camera
     uint8_t get_mount_instance() const;
@@ -201,8 +221,9 @@ protected:
     bool timer_installed;   // true if feedback pin change detected using timer
     bool isr_installed;     // true if feedback pin change is detected with an interrupt
     uint8_t last_pin_state; // last pin state.  used by timer based detection
-    uint32_t feedback_trigger_count;        // number of times the interrupt detected the feedback pin changed
-    uint32_t feedback_trigger_timestamp_us; // system time (in microseconds) that timer detected the feedback pin changed
+    volatile uint32_t feedback_trigger_count;   // number of times the interrupt detected the feedback pin changed
+    // system times (in microseconds) that the feedback pin changed, indexed by count
+    uint32_t feedback_trigger_timestamps_us[AP_CAMERA_FEEDBACK_QUEUE_LEN];
     uint32_t feedback_trigger_logged_count; // number of times the feedback has been logged
     bool trigger_pending;           // true if a call to take_pic() was delayed due to the minimum time interval time
     uint32_t last_picture_time_ms;    // system time that photo was last taken
@@ -9,7 +9,7 @@
 #include <AP_AHRS/AP_AHRS.h>
 
 // Write a Camera packet.  Also writes a Mount packet if available
-void AP_Camera_Backend::Write_CameraInfo(enum LogMessages msg, uint64_t timestamp_us)
+void AP_Camera_Backend::Write_CameraInfo(enum LogMessages msg, uint64_t timestamp_us, const Pose *pose)
 {
     // exit immediately if no logger
     AP_Logger *logger = AP_Logger::get_singleton();
@@ -22,12 +22,13 @@ void AP_Camera_Backend::Write_CameraInfo(enum LogMessages msg, uint64_t timestam
         return;
     }
 
-    const AP_AHRS &ahrs = AP::ahrs();
-
-    Location current_loc;
-    if (!ahrs.get_location(current_loc)) {
-        // completely ignore this failure!  AHRS will provide its best guess.
+    // use the pose the picture was taken at if known, otherwise the current pose
+    Pose current_pose;
+    if (pose == nullptr) {
+        get_current_pose(current_pose);
+        pose = &current_pose;
     }
+    const Location &current_loc = pose->location;
 
     int32_t altitude_cm = 0;
     int32_t altitude_rel_cm = 0;
@@ -62,9 +63,9 @@ void AP_Camera_Backend::Write_CameraInfo(enum LogMessages msg, uint64_t timestam
         altitude    : altitude_cm,
         altitude_rel: altitude_rel_cm,
         altitude_gps: altitude_gps_cm,
-        roll        : (int16_t)ahrs.roll_sensor,
-        pitch       : (int16_t)ahrs.pitch_sensor,
-        yaw         : (uint16_t)ahrs.yaw_sensor
+        roll        : (int16_t)(pose->roll_deg * 100),
+        pitch       : (int16_t)(pose->pitch_deg * 100),
+        yaw         : (uint16_t)(wrap_360(pose->yaw_deg) * 100)
     };
     AP::logger().WriteCriticalBlock(&pkt, sizeof(pkt));
 
@@ -77,9 +78,9 @@ void AP_Camera_Backend::Write_CameraInfo(enum LogMessages msg, uint64_t timestam
 }
 
 // Write a Camera packet
-void AP_Camera_Backend::Write_Camera(uint64_t timestamp_us)
+void AP_Camera_Backend::Write_Camera(uint64_t timestamp_us, const Pose *pose)
 {
-    Write_CameraInfo(LOG_CAMERA_MSG, timestamp_us);
+    Write_CameraInfo(LOG_CAMERA_MSG, timestamp_us, pose);
 }
 
 // Write a Trigger packet
@@ -55,6 +55,17 @@
 #define AP_CAMERA_SEND_THERMAL_RANGE_ENABLED AP_MOUNT_SEND_THERMAL_RANGE_ENABLED
 #endif
 
+// number of feedback pin events that can be queued between updates
+#ifndef AP_CAMERA_FEEDBACK_QUEUE_LEN
+#define AP_CAMERA_FEEDBACK_QUEUE_LEN 8
+#endif
+
+// number of vehicle poses kept to tag feedback pin events with the
+// pose at the time they happened, recorded at the camera update rate
+#ifndef AP_CAMERA_POSE_HISTORY_LEN
+#define AP_CAMERA_POSE_HISTORY_LEN 8
+#endif
+
 #ifndef HAL_RUNCAM_ENABLED
 #define HAL_RUNCAM_ENABLED 1
 #endif
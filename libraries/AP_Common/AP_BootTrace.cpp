@@ -0,0 +1,90 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_BootTrace.h"
+
+#if AP_BOOT_TRACE_ENABLED
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Common/ExpandingString.h>
+
+/*
+  record the end of a boot stage
+ */
+void AP_BootTrace::stage(const char *name)
+{
+    if (_complete || _num_stages >= AP_BOOT_TRACE_MAX_STAGES) {
+        return;
+    }
+    _stages[_num_stages].name = name;
+    _stages[_num_stages].end_us = AP_HAL::micros();
+    _num_stages++;
+}
+
+/*
+  the vehicle is ready to arm for the first time, everything from the
+  last stage until now was spent waiting for sensors and the EKF
+ */
+void AP_BootTrace::ready_to_arm()
+{
+    if (_complete) {
+        return;
+    }
+    stage("ready to arm");
+    _complete = true;
+}
+
+bool AP_BootTrace::get_stage(uint8_t idx, const char *&name, uint32_t &start_us, uint32_t &duration_us) const
+{
+    if (idx >= _num_stages) {
+        return false;
+    }
+    name = _stages[idx].name;
+    // the first stage starts at boot
+    start_us = idx == 0 ? 0 : _stages[idx-1].end_us;
+    duration_us = _stages[idx].end_us - start_us;
+    return true;
+}
+
+/*
+  write the stages as text, for @SYS/boot.txt
+ */
+void AP_BootTrace::info(ExpandingString &str) const
+{
+    str.printf("%-20s %10s %10s\n", "Stage", "Start(ms)", "Time(ms)");
+    for (uint8_t i=0; i<_num_stages; i++) {
+        const char *name;
+        uint32_t start_us, duration_us;
+        if (get_stage(i, name, start_us, duration_us)) {
+            str.printf("%-20s %10.1f %10.1f\n", name, start_us*0.001, duration_us*0.001);
+        }
+    }
+    if (!_complete) {
+        str.printf("not yet ready to arm\n");
+    }
+}
+
+static AP_BootTrace _boot_trace;
+
+namespace AP {
+
+AP_BootTrace &boot_trace()
+{
+    return _boot_trace;
+}
+
+};
+
+#endif // AP_BOOT_TRACE_ENABLED
@@ -0,0 +1,85 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+  boot trace, recording how long each stage of initialisation takes
+  from power on until the vehicle is first ready to arm
+
+  Each stage is timed from the end of the previous one, so the stages
+  form a timeline covering the whole boot. Stages are reported in
+  @SYS/boot.txt and written as messages at the start of each log
+ */
+
+#pragma once
+
+#include <AP_HAL/AP_HAL_Boards.h>
+
+#ifndef AP_BOOT_TRACE_ENABLED
+#ifdef HAL_BOOTLOADER_BUILD
+#define AP_BOOT_TRACE_ENABLED 0
+#else
+#define AP_BOOT_TRACE_ENABLED 1
+#endif
+#endif
+
+#if AP_BOOT_TRACE_ENABLED
+
+#include <stdint.h>
+
+#ifndef AP_BOOT_TRACE_MAX_STAGES
+#define AP_BOOT_TRACE_MAX_STAGES 32
+#endif
+
+class ExpandingString;
+
+class AP_BootTrace {
+public:
+    // record the end of a boot stage. name must be a string constant
+    void stage(const char *name);
+
+    // record the vehicle first being ready to arm, which ends the trace
+    void ready_to_arm();
+
+    // true once the vehicle has been ready to arm
+    bool complete() const { return _complete; }
+
+    uint8_t num_stages() const { return _num_stages; }
+
+    // get the name, start and duration of a stage in microseconds
+    bool get_stage(uint8_t idx, const char *&name, uint32_t &start_us, uint32_t &duration_us) const;
+
+    // write the stages as text
+    void info(ExpandingString &str) const;
+
+private:
+    struct {
+        const char *name;
+        uint32_t end_us;
+    } _stages[AP_BOOT_TRACE_MAX_STAGES];
+    volatile uint8_t _num_stages;
+    bool _complete;
+};
+
+namespace AP {
+    AP_BootTrace &boot_trace();
+};
+
+#define AP_BOOT_TRACE(name) AP::boot_trace().stage(name)
+
+#else
+
+#define AP_BOOT_TRACE(name) do {} while (0)
+
+#endif // AP_BOOT_TRACE_ENABLED
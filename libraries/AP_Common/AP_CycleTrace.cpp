@@ -0,0 +1,196 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_CycleTrace.h"
+
+#if AP_CYCLE_TRACE_ENABLED
+
+#include <AP_Common/ExpandingString.h>
+#include <AP_Math/AP_Math.h>
+#include <stdio.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+#include <ch.h>
+#endif
+
+extern const AP_HAL::HAL& hal;
+
+/*
+  trace.bin format, little endian, must match Tools/scripts/cycle_trace.py:
+    header: "CTRC", version, number of scopes, number of threads, pad, cycles per microsecond
+    scope names: 16 bytes each
+    per thread: name (16 bytes), entry count (uint32), entries
+ */
+#define CYCLE_TRACE_MAGIC "CTRC"
+#define CYCLE_TRACE_VERSION 1
+
+static const char *scope_names[] = {
+    "RATE_PID",
+    "RATE_OUTPUT",
+    "GYRO_FILTER",
+    "NOTCH_UPDATE",
+    "DSHOT_SEND",
+    "INS_UPDATE",
+};
+static_assert(ARRAY_SIZE(scope_names) == uint8_t(AP_CycleTrace::Scope::NUM_SCOPES), "scope_names must match Scope");
+
+struct PACKED CycleTraceHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t num_scopes;
+    uint8_t num_threads;
+    uint8_t pad;
+    uint32_t cycles_per_us;
+};
+
+AP_CycleTrace::ScopeTimer::ScopeTimer(Scope _scope) :
+    ring(AP::cycle_trace().thread_ring()),
+    scope(_scope)
+{
+    if (ring != nullptr) {
+        ring->depth++;
+    }
+    // taken last so the lookup is not part of the scope
+    start = cycles();
+}
+
+/*
+  start the DWT cycle counter, which is stopped out of reset
+ */
+void AP_CycleTrace::enable_counter()
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#ifdef __CORE_CM7_H_GENERIC
+    // the M7 DWT is locked against writes
+    DWT->LAR = 0xC5ACCE55;
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    _counter_enabled = true;
+}
+
+/*
+  find the ring of the calling thread, allocating it the first time
+  the thread traces a scope. Lookup does not take the semaphore
+ */
+AP_CycleTrace::Ring *AP_CycleTrace::thread_ring()
+{
+    const void *thread = hal.scheduler->current_thread_id();
+    if (thread == nullptr) {
+        return nullptr;
+    }
+    const uint8_t num_rings = _num_rings;
+    for (uint8_t i=0; i<num_rings; i++) {
+        if (_rings[i]->thread == thread) {
+            return _rings[i];
+        }
+    }
+    if (num_rings >= AP_CYCLE_TRACE_MAX_THREADS) {
+        return nullptr;
+    }
+
+    WITH_SEMAPHORE(_sem);
+
+    // only this thread can add its own ring, but another may have
+    // added one since we looked
+    const uint8_t n = _num_rings;
+    if (n >= AP_CYCLE_TRACE_MAX_THREADS) {
+        return nullptr;
+    }
+    Ring *ring = NEW_NOTHROW Ring;
+    if (ring == nullptr) {
+        return nullptr;
+    }
+    if (!_counter_enabled) {
+        enable_counter();
+    }
+    ring->thread = thread;
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS && CH_CFG_USE_REGISTRY == TRUE
+    strncpy(ring->name, chThdGetSelfX()->name, sizeof(ring->name));
+#else
+    snprintf(ring->name, sizeof(ring->name), "thread%u", unsigned(n));
+#endif
+    _rings[n] = ring;
+    _num_rings = n + 1;
+    return ring;
+}
+
+/*
+  write the rings as @SYS/trace.bin. The rings keep being written
+  while they are copied, so entries that may have been overwritten
+  during the copy are dropped
+ */
+void AP_CycleTrace::dump(ExpandingString &str)
+{
+    const uint8_t num_rings = _num_rings;
+
+    CycleTraceHeader hdr {};
+    memcpy(hdr.magic, CYCLE_TRACE_MAGIC, sizeof(hdr.magic));
+    hdr.version = CYCLE_TRACE_VERSION;
+    hdr.num_scopes = ARRAY_SIZE(scope_names);
+    hdr.num_threads = num_rings;
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS && defined(STM32_SYS_CK)
+    hdr.cycles_per_us = STM32_SYS_CK / 1000000U;
+#elif CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS && defined(STM32_HCLK)
+    hdr.cycles_per_us = STM32_HCLK / 1000000U;
+#else
+    hdr.cycles_per_us = 1;
+#endif
+    str.append((const char *)&hdr, sizeof(hdr));
+
+    for (const char *name : scope_names) {
+        char buf[16] {};
+        strncpy(buf, name, sizeof(buf));
+        str.append(buf, sizeof(buf));
+    }
+
+    Entry *copy = NEW_NOTHROW Entry[AP_CYCLE_TRACE_RING_SIZE];
+    if (copy == nullptr) {
+        str.reset();
+        return;
+    }
+    for (uint8_t i=0; i<num_rings; i++) {
+        const Ring &ring = *_rings[i];
+        const uint32_t head = ring.head.load(std::memory_order_acquire);
+        const uint32_t count = MIN(head, uint32_t(AP_CYCLE_TRACE_RING_SIZE));
+        for (uint32_t j=0; j<count; j++) {
+            copy[j] = ring.entries[(head - count + j) & (AP_CYCLE_TRACE_RING_SIZE-1)];
+        }
+        // oldest entries the writer may have reached during the copy
+        const uint32_t written = ring.head.load(std::memory_order_acquire) - head;
+        const uint32_t skip = MIN(written, count);
+        const uint32_t valid = count - skip;
+
+        str.append(ring.name, sizeof(ring.name));
+        str.append((const char *)&valid, sizeof(valid));
+        str.append((const char *)&copy[skip], valid * sizeof(Entry));
+    }
+    delete[] copy;
+}
+
+static AP_CycleTrace _cycle_trace;
+
+namespace AP {
+
+AP_CycleTrace &cycle_trace()
+{
+    return _cycle_trace;
+}
+
+};
+
+#endif // AP_CYCLE_TRACE_ENABLED
@@ -0,0 +1,156 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+  cycle trace, recording how long hot code paths take in CPU cycles
+
+  A TRACE_SCOPE(id) at the top of a block times the block with the
+  DWT cycle counter on ChibiOS, or in microseconds elsewhere. Each
+  thread writes completed scopes into its own ring without locking,
+  so scopes can be nested and used in the IMU and rate threads. The
+  rings are read back as @SYS/trace.bin, which
+  Tools/scripts/cycle_trace.py turns into per-scope histograms and
+  folded stacks for flame graphs.
+
+  This is a development tool and is off by default
+ */
+
+#pragma once
+
+#include <AP_HAL/AP_HAL_Boards.h>
+
+#ifndef AP_CYCLE_TRACE_ENABLED
+#define AP_CYCLE_TRACE_ENABLED 0
+#endif
+
+#if AP_CYCLE_TRACE_ENABLED
+
+#include <stdint.h>
+#include <atomic>
+#include <AP_Common/AP_Common.h>
+#include <AP_HAL/AP_HAL.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+#include <hal.h>
+#endif
+
+#ifndef AP_CYCLE_TRACE_MAX_THREADS
+#define AP_CYCLE_TRACE_MAX_THREADS 8
+#endif
+
+// entries kept per thread, must be a power of 2
+#ifndef AP_CYCLE_TRACE_RING_SIZE
+#define AP_CYCLE_TRACE_RING_SIZE 512
+#endif
+
+static_assert((AP_CYCLE_TRACE_RING_SIZE & (AP_CYCLE_TRACE_RING_SIZE-1)) == 0, "AP_CYCLE_TRACE_RING_SIZE must be a power of 2");
+
+class ExpandingString;
+
+class AP_CycleTrace {
+public:
+    // traced scopes. Names are in AP_CycleTrace.cpp and new scopes
+    // go at the end so old traces still decode
+    enum class Scope : uint8_t {
+        RATE_PID = 0,
+        RATE_OUTPUT,
+        GYRO_FILTER,
+        NOTCH_UPDATE,
+        DSHOT_SEND,
+        INS_UPDATE,
+        NUM_SCOPES
+    };
+
+    // one completed scope
+    struct PACKED Entry {
+        uint32_t start;
+        uint32_t cycles;
+        uint8_t scope;
+        uint8_t depth;
+    };
+
+    // the ring of one thread. Only the owning thread writes to it
+    struct Ring {
+        const void *thread;
+        char name[16];
+        uint8_t depth;
+        std::atomic<uint32_t> head;
+        Entry entries[AP_CYCLE_TRACE_RING_SIZE];
+    };
+
+    // current cycle count
+    static inline uint32_t cycles() {
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+        return DWT->CYCCNT;
+#else
+        return AP_HAL::micros();
+#endif
+    }
+
+    // ring of the calling thread, allocated on first use. Returns
+    // nullptr if there is no space for another thread
+    Ring *thread_ring();
+
+    // record a completed scope
+    static inline void record(Ring &ring, Scope scope, uint32_t start, uint8_t depth) {
+        const uint32_t idx = ring.head.load(std::memory_order_relaxed);
+        Entry &e = ring.entries[idx & (AP_CYCLE_TRACE_RING_SIZE-1)];
+        e.start = start;
+        e.cycles = cycles() - start;
+        e.scope = uint8_t(scope);
+        e.depth = depth;
+        ring.head.store(idx+1, std::memory_order_release);
+    }
+
+    // write the rings as @SYS/trace.bin
+    void dump(ExpandingString &str);
+
+    // times one scope, use with TRACE_SCOPE()
+    class ScopeTimer {
+    public:
+        ScopeTimer(Scope _scope);
+        ~ScopeTimer() {
+            if (ring != nullptr) {
+                ring->depth--;
+                record(*ring, scope, start, ring->depth);
+            }
+        }
+    private:
+        Ring *ring;
+        uint32_t start;
+        Scope scope;
+    };
+
+private:
+    void enable_counter();
+
+    Ring *_rings[AP_CYCLE_TRACE_MAX_THREADS];
+    // rings are only added, and are complete before the count includes them
+    std::atomic<uint8_t> _num_rings;
+    HAL_Semaphore _sem;
+    bool _counter_enabled;
+};
+
+namespace AP {
+    AP_CycleTrace &cycle_trace();
+};
+
+#define TRACE_SCOPE(id) AP_CycleTrace::ScopeTimer trace_scope_ ## id(AP_CycleTrace::Scope::id)
+
+#else
+
+#define TRACE_SCOPE(id) do {} while (0)
+
+#endif // AP_CYCLE_TRACE_ENABLED
@@ -23,16 +23,47 @@ extern const AP_HAL::HAL& hal;
 AP_ExpandingArrayGeneric::~AP_ExpandingArrayGeneric(void)
 {
     // free chunks
-    for (uint16_t i=0; i<chunk_count; i++) {
+    for (uint16_t i=contig_chunks; i<chunk_count; i++) {
         free(chunk_ptrs[i]);
     }
     // free chunks_ptrs array
     free(chunk_ptrs);
+    // free contiguous block
+    free(contig_base);
+}
+
+// grow the contiguous block by num_chunks, returns false if it could not be reallocated
+bool AP_ExpandingArrayGeneric::expand_contiguous(uint16_t num_chunks)
+{
+    const uint32_t old_size = uint32_t(contig_chunks) * chunk_size * elem_size;
+    const uint32_t new_size = uint32_t(contig_chunks + num_chunks) * chunk_size * elem_size;
+    if (hal.util->available_memory() < 100U + new_size) {
+        // fail if reallocating would leave less than 100 bytes of memory free
+        return false;
+    }
+    uint8_t *new_base = (uint8_t *)mem_realloc(contig_base, old_size, new_size);
+    if (new_base == nullptr) {
+        return false;
+    }
+    // zero new elements as calloc does for chunks
+    memset(&new_base[old_size], 0, new_size - old_size);
+
+    contig_base = new_base;
+    contig_chunks += num_chunks;
+    contig_items = contig_chunks * chunk_size;
+    chunk_count = contig_chunks;
+    return true;
 }
 
 // expand the array by specified number of chunks, returns true on success
 bool AP_ExpandingArrayGeneric::expand(uint16_t num_chunks)
 {
+    // keep growing as one block while all elements are in it. If that
+    // fails the block stays as the first chunks and we carry on in chunks
+    if (growth == Growth::CONTIGUOUS && is_contiguous() && expand_contiguous(num_chunks)) {
+        return true;
+    }
+
     // expand chunk_ptrs array if necessary
     if (chunk_count + num_chunks >= chunk_count_max) {
         uint16_t chunk_ptr_size = chunk_count + num_chunks + chunk_ptr_increment;
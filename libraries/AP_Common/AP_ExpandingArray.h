@@ -31,6 +31,14 @@
  *       the old array's data will be copied to the new array and finally the old array will be freed.
  *    2. a new chunk will be allocated and a pointer to this new chunk will be added to the chunk_ptrs array
  *
+ * With Growth::CONTIGUOUS the array is instead kept as a single block which is reallocated (and copied) on each expand.
+ * Elements are then accessed with a single index into the block. If the block cannot be reallocated (e.g. memory is
+ * fragmented) the existing block is kept as the first chunks and the array carries on growing in chunks.
+ * Only use this for arrays which do not hold pointers to their own elements, as elements move when the block is reallocated.
+ *
+ * items(count) gives a range for iterating over the first count elements, stepping through each chunk by pointer:
+ *    for (T &item : array.items(count)) { ... }
+ *
  * Warnings:
  *    1. memset, memcpy, memcmp cannot be used because the individual elements are not guaranteed to be next to each other in memory
  *    2. operator[] functions do not perform any range checking so max_items() should be used when necessary to avoid out-of-bound memory access
@@ -45,9 +53,16 @@ class AP_ExpandingArrayGeneric
 {
 public:
 
-    AP_ExpandingArrayGeneric(uint16_t element_size, uint16_t elements_per_chunk) :
+    // how the array grows, see the description above
+    enum class Growth : uint8_t {
+        CHUNKED,
+        CONTIGUOUS,
+    };
+
+    AP_ExpandingArrayGeneric(uint16_t element_size, uint16_t elements_per_chunk, Growth _growth = Growth::CHUNKED) :
         elem_size(element_size),
-        chunk_size(elements_per_chunk)
+        chunk_size(elements_per_chunk),
+        growth(_growth)
     {}
 
     ~AP_ExpandingArrayGeneric(void);
@@ -64,17 +79,28 @@ public:
     // expand to hold at least num_items
     bool expand_to_hold(uint16_t num_items);
 
+    // true if all elements are held in a single block
+    bool is_contiguous() const { return contig_chunks == chunk_count; }
+
 protected:
 
+    // grow the contiguous block by num_chunks, returns false if it could not be reallocated
+    bool expand_contiguous(uint16_t num_chunks);
+
     const uint16_t elem_size;   // number of bytes for each element
     const uint16_t chunk_size;  // the number of T elements in each chunk
     const uint16_t chunk_ptr_increment = 32;    // chunk_ptrs array is grown by this many elements each time it fills
+    const Growth growth;
 
     typedef uint8_t* chunk_ptr_t;   // pointer to a chunk
 
-    chunk_ptr_t *chunk_ptrs;    // array of pointers to allocated chunks
+    chunk_ptr_t *chunk_ptrs;    // array of pointers to allocated chunks, entries below contig_chunks are unused
     uint16_t chunk_count_max;   // number of elements in chunk_ptrs array
     uint16_t chunk_count;       // number of allocated chunks
+
+    uint8_t *contig_base;       // block holding the first contig_chunks chunks
+    uint16_t contig_chunks;     // number of chunks held in contig_base
+    uint16_t contig_items;      // number of elements held in contig_base
 };
 
 template <typename T>
@@ -82,8 +108,8 @@ class AP_ExpandingArray : public AP_ExpandingArrayGeneric
 {
 public:
 
-    AP_ExpandingArray(uint16_t elements_per_chunk) :
-        AP_ExpandingArrayGeneric(sizeof(T), elements_per_chunk)
+    AP_ExpandingArray(uint16_t elements_per_chunk, Growth _growth = Growth::CHUNKED) :
+        AP_ExpandingArrayGeneric(sizeof(T), elements_per_chunk, _growth)
     {}
 
     /* Do not allow copies */
@@ -92,10 +118,13 @@ public:
     // allow use as an array for assigning to elements. no bounds checking is performed
     T &operator[](uint16_t i)
     {
-        const uint16_t chunk_num = i / chunk_size;
-        const uint16_t chunk_index = (i % chunk_size);
         #pragma GCC diagnostic push
         #pragma GCC diagnostic ignored "-Wcast-align"
+        if (i < contig_items) {
+            return ((T *)contig_base)[i];
+        }
+        const uint16_t chunk_num = i / chunk_size;
+        const uint16_t chunk_index = (i % chunk_size);
         T *el_array = (T *)chunk_ptrs[chunk_num];
         #pragma GCC diagnostic pop
         return el_array[chunk_index];
@@ -104,12 +133,82 @@ public:
     // allow use as an array for accessing elements. no bounds checking is performed
     const T &operator[](uint16_t i) const
     {
-        const uint16_t chunk_num = i / chunk_size;
-        const uint16_t chunk_index = (i % chunk_size);
         #pragma GCC diagnostic push
         #pragma GCC diagnostic ignored "-Wcast-align"
+        if (i < contig_items) {
+            return ((const T *)contig_base)[i];
+        }
+        const uint16_t chunk_num = i / chunk_size;
+        const uint16_t chunk_index = (i % chunk_size);
         const T *el_array = (const T *)chunk_ptrs[chunk_num];
         #pragma GCC diagnostic pop
         return el_array[chunk_index];
     }
+
+    // iterator over elements, E is T or const T
+    template <typename E>
+    class iterator {
+    public:
+        iterator(const AP_ExpandingArray<T> &_array, uint16_t _idx) :
+            array(_array),
+            idx(_idx)
+        {
+            point();
+        }
+
+        E &operator*() const { return *ptr; }
+
+        iterator &operator++()
+        {
+            idx++;
+            if (++ptr == run_end) {
+                point();
+            }
+            return *this;
+        }
+
+        bool operator!=(const iterator &other) const { return idx != other.idx; }
+
+    private:
+        // point at element idx and the end of the elements stored next to it
+        void point()
+        {
+            #pragma GCC diagnostic push
+            #pragma GCC diagnostic ignored "-Wcast-align"
+            if (idx < array.contig_items) {
+                ptr = (E *)array.contig_base + idx;
+                run_end = (E *)array.contig_base + array.contig_items;
+            } else if (idx < array.max_items()) {
+                E *chunk = (E *)array.chunk_ptrs[idx / array.chunk_size];
+                ptr = chunk + (idx % array.chunk_size);
+                run_end = chunk + array.chunk_size;
+            } else {
+                ptr = run_end = nullptr;
+            }
+            #pragma GCC diagnostic pop
+        }
+
+        const AP_ExpandingArray<T> &array;
+        uint16_t idx;
+        E *ptr;
+        E *run_end;
+    };
+
+    // range of the first count elements, no bounds checking is performed
+    template <typename E>
+    class range {
+    public:
+        range(const AP_ExpandingArray<T> &_array, uint16_t _count) :
+            array(_array),
+            count(_count)
+        {}
+        iterator<E> begin() const { return iterator<E>(array, 0); }
+        iterator<E> end() const { return iterator<E>(array, count); }
+    private:
+        const AP_ExpandingArray<T> &array;
+        const uint16_t count;
+    };
+
+    range<T> items(uint16_t count) { return range<T>(*this, count); }
+    range<const T> items(uint16_t count) const { return range<const T>(*this, count); }
 };
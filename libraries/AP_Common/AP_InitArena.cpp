@@ -0,0 +1,133 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_InitArena.h"
+
+#if AP_INIT_ARENA_ENABLED
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Common/ExpandingString.h>
+#include <string.h>
+#include <stdlib.h>
+
+extern const AP_HAL::HAL& hal;
+
+/*
+  allocate zeroed memory for owner
+ */
+void *AP_InitArena::allocate(size_t size, const char *owner)
+{
+    if (size == 0) {
+        size = 1;
+    }
+    // keep every allocation aligned for any type
+    size = (size + 7U) & ~size_t(7U);
+
+    WITH_SEMAPHORE(sem);
+
+    void *ret;
+    if (size > max_packed_size) {
+        ret = calloc(1, size);
+        if (ret == nullptr) {
+            return nullptr;
+        }
+        heap_bytes += size;
+    } else {
+        if (chunk == nullptr || chunk_used + size > AP_INIT_ARENA_CHUNK_SIZE) {
+            uint8_t *new_chunk = (uint8_t *)calloc(1, AP_INIT_ARENA_CHUNK_SIZE);
+            if (new_chunk == nullptr) {
+                return nullptr;
+            }
+            if (chunk != nullptr) {
+                wasted_bytes += AP_INIT_ARENA_CHUNK_SIZE - chunk_used;
+            }
+            chunk = new_chunk;
+            chunk_used = 0;
+            num_chunks++;
+        }
+        ret = &chunk[chunk_used];
+        chunk_used += size;
+    }
+    add_to_owner(owner, size);
+    return ret;
+}
+
+/*
+  record memory allocated elsewhere against owner
+ */
+void AP_InitArena::account(const char *owner, size_t size)
+{
+    WITH_SEMAPHORE(sem);
+    add_to_owner(owner, size);
+}
+
+void AP_InitArena::add_to_owner(const char *owner, size_t size)
+{
+    for (auto &o : owners) {
+        if (o.name == nullptr) {
+            o.name = owner;
+        } else if (strcmp(o.name, owner) != 0) {
+            continue;
+        }
+        o.bytes += size;
+        o.count++;
+        return;
+    }
+    other_bytes += size;
+    other_count++;
+}
+
+/*
+  write usage by owner as text, for @SYS/mem.txt
+ */
+void AP_InitArena::info(ExpandingString &str)
+{
+    WITH_SEMAPHORE(sem);
+
+    str.printf("%-16s %8s %6s\n", "Owner", "Bytes", "Count");
+    uint32_t total = 0;
+    for (const auto &o : owners) {
+        if (o.name == nullptr) {
+            break;
+        }
+        str.printf("%-16s %8u %6u\n", o.name, unsigned(o.bytes), unsigned(o.count));
+        total += o.bytes;
+    }
+    if (other_count > 0) {
+        str.printf("%-16s %8u %6u\n", "(other)", unsigned(other_bytes), unsigned(other_count));
+        total += other_bytes;
+    }
+    str.printf("%-16s %8u\n", "Total", unsigned(total));
+    str.printf("\nArena chunks:%u size:%u used:%u wasted:%u heap:%u\n",
+               unsigned(num_chunks),
+               unsigned(AP_INIT_ARENA_CHUNK_SIZE),
+               unsigned(num_chunks > 0 ? (num_chunks - 1) * AP_INIT_ARENA_CHUNK_SIZE - wasted_bytes + chunk_used : 0),
+               unsigned(wasted_bytes),
+               unsigned(heap_bytes));
+    str.printf("Free memory: %u\n", unsigned(hal.util->available_memory()));
+}
+
+static AP_InitArena _init_arena;
+
+namespace AP {
+
+AP_InitArena &init_arena()
+{
+    return _init_arena;
+}
+
+};
+
+#endif // AP_INIT_ARENA_ENABLED
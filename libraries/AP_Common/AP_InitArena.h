@@ -0,0 +1,116 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+  arena for memory allocated at init time that is never freed
+
+  Subsystems opt in by allocating through the arena rather than with
+  NEW_NOTHROW or calloc. Small allocations are packed one after
+  another into chunks, so long lived allocations end up contiguous
+  instead of scattered through the heap between short lived ones.
+  Larger allocations come straight from the heap. Every allocation is
+  tagged with an owner name, giving a per-subsystem report of where
+  the memory went.
+
+  Memory from the arena must never be freed or deleted. Subsystems
+  which keep their memory elsewhere can still record it against their
+  name with account()
+ */
+
+#pragma once
+
+#include <AP_HAL/AP_HAL_Boards.h>
+
+#ifndef AP_INIT_ARENA_ENABLED
+#ifdef HAL_BOOTLOADER_BUILD
+#define AP_INIT_ARENA_ENABLED 0
+#else
+#define AP_INIT_ARENA_ENABLED 1
+#endif
+#endif
+
+#if AP_INIT_ARENA_ENABLED
+
+#include <AP_HAL/Semaphores.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <utility>
+
+// size of each chunk small allocations are packed into
+#ifndef AP_INIT_ARENA_CHUNK_SIZE
+#define AP_INIT_ARENA_CHUNK_SIZE 4096
+#endif
+
+// number of owners that can be reported separately, others are
+// counted together
+#ifndef AP_INIT_ARENA_MAX_OWNERS
+#define AP_INIT_ARENA_MAX_OWNERS 16
+#endif
+
+class ExpandingString;
+
+class AP_InitArena {
+public:
+    // allocate zeroed memory for owner, which must be a string
+    // constant. Returns nullptr on failure
+    void *allocate(size_t size, const char *owner);
+
+    // allocate and construct an object for owner that lives until reboot
+    template <typename T, typename... Args>
+    T *create(const char *owner, Args&&... args) {
+        void *mem = allocate(sizeof(T), owner);
+        if (mem == nullptr) {
+            return nullptr;
+        }
+        return new (mem) T(std::forward<Args>(args)...);
+    }
+
+    // record memory owner allocated outside the arena
+    void account(const char *owner, size_t size);
+
+    // write usage by owner as text
+    void info(ExpandingString &str);
+
+private:
+    // allocations bigger than this come straight from the heap
+    static const uint32_t max_packed_size = AP_INIT_ARENA_CHUNK_SIZE / 4;
+
+    struct Owner {
+        const char *name;
+        uint32_t bytes;
+        uint16_t count;
+    } owners[AP_INIT_ARENA_MAX_OWNERS];
+    uint32_t other_bytes;
+    uint16_t other_count;
+
+    // the chunk being filled
+    uint8_t *chunk;
+    uint32_t chunk_used;
+
+    uint16_t num_chunks;
+    uint32_t wasted_bytes;      // unused space at the end of full chunks
+    uint32_t heap_bytes;        // allocations too large to pack
+
+    HAL_Semaphore sem;
+
+    void add_to_owner(const char *owner, size_t size);
+};
+
+namespace AP {
+    AP_InitArena &init_arena();
+};
+
+#endif // AP_INIT_ARENA_ENABLED
@@ -0,0 +1,89 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_SensorDemand.h"
+
+#include <AP_Math/AP_Math.h>
+
+// how often backends look for a change in demand
+#define SENSOR_DEMAND_CHECK_MS 500
+
+void AP_SensorDemand::set_rate_hz(Sensor sensor, Consumer consumer, uint16_t rate_hz)
+{
+#if AP_SENSOR_DEMAND_ENABLED
+    if (sensor >= Sensor::NUM_SENSORS || consumer >= Consumer::NUM_CONSUMERS) {
+        return;
+    }
+    _rate_hz[uint8_t(sensor)][uint8_t(consumer)] = rate_hz;
+    _declared_mask |= 1U<<uint8_t(sensor);
+#endif
+}
+
+uint32_t AP_SensorDemand::period_us(Sensor sensor, uint32_t nominal_period_us) const
+{
+#if AP_SENSOR_DEMAND_ENABLED
+    if (sensor >= Sensor::NUM_SENSORS || (_declared_mask & (1U<<uint8_t(sensor))) == 0) {
+        return nominal_period_us;
+    }
+    uint16_t rate_hz = 0;
+    for (uint8_t i=0; i<uint8_t(Consumer::NUM_CONSUMERS); i++) {
+        rate_hz = MAX(rate_hz, _rate_hz[uint8_t(sensor)][i]);
+    }
+    if (rate_hz == 0) {
+        rate_hz = AP_SENSOR_DEMAND_IDLE_HZ;
+    }
+    return MAX(nominal_period_us, 1000000U / rate_hz);
+#else
+    return nominal_period_us;
+#endif
+}
+
+void AP_SensorDemand::Poller::register_callback(AP_HAL::Device &dev, uint32_t period_us, AP_HAL::Device::PeriodicCb cb)
+{
+    nominal_period_us = period_us;
+    current_period_us = period_us;
+    handle = dev.register_periodic_callback(period_us, cb);
+}
+
+/*
+  adjust the period of the callback if demand has changed. Called
+  from the callback on the bus thread
+ */
+void AP_SensorDemand::Poller::update(AP_HAL::Device &dev)
+{
+#if AP_SENSOR_DEMAND_ENABLED
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - last_check_ms < SENSOR_DEMAND_CHECK_MS) {
+        return;
+    }
+    last_check_ms = now_ms;
+    const uint32_t period = AP::sensor_demand().period_us(sensor, nominal_period_us);
+    if (period != current_period_us && handle != nullptr &&
+        dev.adjust_periodic_callback(handle, period)) {
+        current_period_us = period;
+    }
+#endif
+}
+
+static AP_SensorDemand _sensor_demand;
+
+namespace AP {
+
+AP_SensorDemand &sensor_demand()
+{
+    return _sensor_demand;
+}
+
+};
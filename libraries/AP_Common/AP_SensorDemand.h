@@ -0,0 +1,96 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+  sensor demand, letting consumers of baro, compass and airspeed data
+  say how often they need it
+
+  Each consumer declares the rate it needs for a class of sensor, 0
+  meaning it does not need the data. Backends poll at the fastest rate
+  any consumer needs, never faster than their own rate, and drop to
+  AP_SENSOR_DEMAND_IDLE_HZ when no consumer needs the data, freeing
+  time on shared buses. A sensor class no consumer has declared a rate
+  for is polled at the backend's own rate
+ */
+
+#pragma once
+
+#include <AP_HAL/AP_HAL_Boards.h>
+
+#ifndef AP_SENSOR_DEMAND_ENABLED
+#define AP_SENSOR_DEMAND_ENABLED 1
+#endif
+
+// rate kept up when nothing needs the data, so logging and health
+// checks still see fresh samples
+#ifndef AP_SENSOR_DEMAND_IDLE_HZ
+#define AP_SENSOR_DEMAND_IDLE_HZ 10
+#endif
+
+#include <stdint.h>
+#include <AP_HAL/AP_HAL.h>
+
+class AP_SensorDemand {
+public:
+    enum class Sensor : uint8_t {
+        BARO = 0,
+        COMPASS,
+        AIRSPEED,
+        NUM_SENSORS
+    };
+
+    enum class Consumer : uint8_t {
+        AHRS = 0,
+        COMPASS_CAL,
+        NUM_CONSUMERS
+    };
+
+    // declare the rate a consumer needs, 0 if it doesn't need the data
+    void set_rate_hz(Sensor sensor, Consumer consumer, uint16_t rate_hz);
+
+    // period a backend with the given nominal period should poll at
+    uint32_t period_us(Sensor sensor, uint32_t nominal_period_us) const;
+
+    /*
+      a periodic callback of a backend following demand. Register the
+      callback with register_callback() in place of
+      register_periodic_callback() and call update() at the start of
+      the callback
+     */
+    class Poller {
+    public:
+        Poller(Sensor _sensor) : sensor(_sensor) {}
+
+        void register_callback(AP_HAL::Device &dev, uint32_t period_us, AP_HAL::Device::PeriodicCb cb);
+        void update(AP_HAL::Device &dev);
+
+    private:
+        AP_HAL::Device::PeriodicHandle handle = nullptr;
+        const Sensor sensor;
+        uint32_t nominal_period_us;
+        uint32_t current_period_us;
+        uint32_t last_check_ms;
+    };
+
+private:
+    // rates declared by each consumer
+    uint16_t _rate_hz[uint8_t(Sensor::NUM_SENSORS)][uint8_t(Consumer::NUM_CONSUMERS)];
+    // sensors any consumer has declared a rate for
+    uint8_t _declared_mask;
+};
+
+namespace AP {
+    AP_SensorDemand &sensor_demand();
+};
@@ -630,4 +630,38 @@ void Location::linearly_interpolate_alt(const Location &point1, const Location &
     set_alt_cm(point1.alt + (point2.alt - point1.alt) * constrain_float(line_path_proportion(point1, point2), 0.0f, 1.0f), point2.get_alt_frame());
 }
 
+void LocationFrame::set_origin(const Location &origin)
+{
+    _origin = origin;
+    const ftype lat_rad = origin.lat * (1.0e-7 * DEG_TO_RAD);
+    _lng_scale = Location::longitude_scale(origin.lat);
+    // first order change of scale, halved as the scale of a pair of
+    // locations is taken at their mid latitude
+    _lng_scale_dlat = sinF(lat_rad) * (0.5e-7 * DEG_TO_RAD);
+}
+
+Vector2f LocationFrame::get_distance_NE(const Location &loc) const
+{
+    const int32_t dlat = loc.lat - _origin.lat;
+    return Vector2f(dlat * LATLON_TO_M,
+                    Location::diff_longitude(loc.lng, _origin.lng) * LATLON_TO_M * lng_scale(dlat));
+}
+
+void LocationFrame::get_distance_NE(const Location *locs, Vector2f *ne, uint16_t count) const
+{
+    for (uint16_t i=0; i<count; i++) {
+        ne[i] = get_distance_NE(locs[i]);
+    }
+}
+
+Location LocationFrame::offset(ftype ofs_north, ftype ofs_east) const
+{
+    Location loc = _origin;
+    const int32_t dlat = ofs_north * LATLON_TO_M_INV;
+    const int64_t dlng = (ofs_east * LATLON_TO_M_INV) / lng_scale(dlat);
+    loc.lat = Location::limit_lattitude(loc.lat + dlat);
+    loc.lng = Location::wrap_longitude(dlng + loc.lng);
+    return loc;
+}
+
 #endif // HAL_BOOTLOADER_BUILD
@@ -0,0 +1,114 @@
+#include <AP_gtest.h>
+#include <stdlib.h>
+#include <AP_Common/AP_ExpandingArray.h>
+#include <AP_HAL/AP_HAL.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// set to make the next mem_realloc fail
+static bool fail_next_realloc;
+
+void * WEAK mem_realloc(void *ptr, size_t old_size, size_t new_size)
+{
+    if (fail_next_realloc) {
+        fail_next_realloc = false;
+        return nullptr;
+    }
+
+    if (new_size == 0) {
+        free(ptr);
+        return nullptr;
+    }
+
+    if (ptr == nullptr) {
+        return malloc(new_size);
+    }
+
+    void *new_ptr = malloc(new_size);
+    if (new_ptr != nullptr) {
+        size_t copy_size = new_size > old_size ? old_size : new_size;
+        memcpy(new_ptr, ptr, copy_size);
+        free(ptr);
+    }
+
+    return new_ptr;
+}
+
+static void fill(AP_ExpandingArray<uint32_t> &array, uint16_t start, uint16_t count)
+{
+    for (uint16_t i = start; i < count; i++) {
+        array[i] = i * 3;
+    }
+}
+
+static void check(const AP_ExpandingArray<uint32_t> &array, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        EXPECT_EQ(i * 3U, array[i]);
+    }
+    // the range visits the same elements in order
+    uint16_t n = 0;
+    for (const uint32_t &v : array.items(count)) {
+        EXPECT_EQ(n * 3U, v);
+        n++;
+    }
+    EXPECT_EQ(count, n);
+}
+
+TEST(ExpandingArray, Chunked)
+{
+    // allocated with new so members start zeroed, as in the vehicle code
+    AP_ExpandingArray<uint32_t> &array = *NEW_NOTHROW AP_ExpandingArray<uint32_t>(4);
+    EXPECT_TRUE(array.expand_to_hold(10));
+    EXPECT_EQ(12, array.max_items());
+    EXPECT_FALSE(array.is_contiguous());
+    fill(array, 0, 10);
+    check(array, 10);
+}
+
+TEST(ExpandingArray, Contiguous)
+{
+    AP_ExpandingArray<uint32_t> &array = *NEW_NOTHROW AP_ExpandingArray<uint32_t>(4, AP_ExpandingArrayGeneric::Growth::CONTIGUOUS);
+    EXPECT_TRUE(array.expand_to_hold(3));
+    fill(array, 0, 3);
+    EXPECT_TRUE(array.expand_to_hold(10));
+    EXPECT_TRUE(array.is_contiguous());
+    EXPECT_EQ(12, array.max_items());
+    // elements keep their values when the block moves and new ones are zeroed
+    EXPECT_EQ(6U, array[2]);
+    EXPECT_EQ(0U, array[11]);
+    fill(array, 3, 10);
+    check(array, 10);
+    EXPECT_EQ(&array[0] + 9, &array[9]);
+}
+
+TEST(ExpandingArray, ContiguousFallback)
+{
+    AP_ExpandingArray<uint32_t> &array = *NEW_NOTHROW AP_ExpandingArray<uint32_t>(4, AP_ExpandingArrayGeneric::Growth::CONTIGUOUS);
+    EXPECT_TRUE(array.expand_to_hold(8));
+    fill(array, 0, 8);
+
+    // block can't be reallocated, the array carries on in chunks
+    fail_next_realloc = true;
+    EXPECT_TRUE(array.expand_to_hold(16));
+    EXPECT_FALSE(array.is_contiguous());
+    EXPECT_EQ(20, array.max_items());
+    fill(array, 8, 16);
+    check(array, 16);
+    EXPECT_TRUE(array.expand_to_hold(30));
+    fill(array, 16, 30);
+    check(array, 30);
+}
+
+TEST(ExpandingArray, EmptyRange)
+{
+    AP_ExpandingArray<uint32_t> &array = *NEW_NOTHROW AP_ExpandingArray<uint32_t>(4);
+    uint16_t n = 0;
+    for (uint32_t &v : array.items(0)) {
+        (void)v;
+        n++;
+    }
+    EXPECT_EQ(0, n);
+}
+
+AP_GTEST_MAIN()
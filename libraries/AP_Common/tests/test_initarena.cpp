@@ -0,0 +1,53 @@
+#include <AP_gtest.h>
+#include <AP_Common/AP_InitArena.h>
+#include <AP_Common/ExpandingString.h>
+#include <AP_HAL/AP_HAL.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+TEST(InitArena, Packing)
+{
+    AP_InitArena *arena = NEW_NOTHROW AP_InitArena();
+
+    // small allocations are aligned, zeroed and packed one after another
+    uint8_t *a = (uint8_t *)arena->allocate(3, "A");
+    uint8_t *b = (uint8_t *)arena->allocate(16, "B");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(0u, uintptr_t(a) % 8);
+    EXPECT_EQ(0u, uintptr_t(b) % 8);
+    EXPECT_EQ(a + 8, b);
+    for (uint8_t i = 0; i < 16; i++) {
+        EXPECT_EQ(0, b[i]);
+    }
+
+    // large allocations come from the heap
+    uint8_t *c = (uint8_t *)arena->allocate(AP_INIT_ARENA_CHUNK_SIZE, "A");
+    ASSERT_NE(c, nullptr);
+    EXPECT_NE(b + 16, c);
+
+    struct Obj {
+        Obj(int _v) : v(_v) {}
+        int v;
+    };
+    Obj *obj = arena->create<Obj>("B", 42);
+    ASSERT_NE(obj, nullptr);
+    EXPECT_EQ(42, obj->v);
+    EXPECT_EQ(b + 16, (uint8_t *)obj);
+}
+
+TEST(InitArena, Report)
+{
+    AP_InitArena *arena = NEW_NOTHROW AP_InitArena();
+    arena->allocate(10, "Terrain");
+    arena->allocate(6, "Terrain");
+    arena->account("EKF3", 1000);
+
+    ExpandingString str;
+    arena->info(str);
+    EXPECT_NE(nullptr, strstr(str.get_string(), "Terrain                24      2"));
+    EXPECT_NE(nullptr, strstr(str.get_string(), "EKF3                 1000      1"));
+    EXPECT_NE(nullptr, strstr(str.get_string(), "Total                1024"));
+}
+
+AP_GTEST_MAIN()
@@ -322,6 +322,43 @@ TEST(Location, Distance)
 
 }
 
+TEST(Location, LocationFrame)
+{
+    // check the local projection against the Location methods at a
+    // range of latitudes, out to 10km from the origin
+    const int32_t lats[] { 0, -353632610, 515000000, 780000000 };
+    for (const int32_t lat : lats) {
+        const Location origin{lat, 1491652300, 0, Location::AltFrame::ABSOLUTE};
+        const LocationFrame frame{origin};
+        for (uint16_t bearing = 0; bearing < 360; bearing += 30) {
+            for (const float dist : { 10.0f, 1000.0f, 10000.0f }) {
+                Location loc = origin;
+                loc.offset_bearing(bearing, dist);
+                const Vector2f ne = origin.get_distance_NE(loc);
+                EXPECT_VECTOR2F_NEAR(ne, frame.get_distance_NE(loc), 0.005);
+                EXPECT_NEAR(origin.get_distance(loc), frame.get_distance(loc), 0.005);
+
+                Location loc2 = origin;
+                loc2.offset(ne.x, ne.y);
+                const Location loc3 = frame.offset(ne.x, ne.y);
+                EXPECT_NEAR(loc2.lat, loc3.lat, 1);
+                EXPECT_NEAR(loc2.lng, loc3.lng, 1);
+            }
+        }
+
+        // batch conversion matches single conversions
+        Location locs[4];
+        Vector2f ne[4];
+        for (uint8_t i=0; i<4; i++) {
+            locs[i] = frame.offset(i * 100, i * -50);
+        }
+        frame.get_distance_NE(locs, ne, 4);
+        for (uint8_t i=0; i<4; i++) {
+            EXPECT_VECTOR2F_EQ(frame.get_distance_NE(locs[i]), ne[i]);
+        }
+    }
+}
+
 TEST(Location, Sanitize)
 {
     // we will sanitize test_loc with test_default_loc
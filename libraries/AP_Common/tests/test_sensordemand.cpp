@@ -0,0 +1,41 @@
+#include <AP_gtest.h>
+#include <AP_Common/AP_SensorDemand.h>
+#include <AP_HAL/AP_HAL.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+using Sensor = AP_SensorDemand::Sensor;
+using Consumer = AP_SensorDemand::Consumer;
+
+TEST(SensorDemand, Undeclared)
+{
+    AP_SensorDemand *demand = NEW_NOTHROW AP_SensorDemand();
+
+    // sensors nothing has asked about run at the backend rate
+    EXPECT_EQ(10000U, demand->period_us(Sensor::COMPASS, 10000));
+    EXPECT_EQ(2500U, demand->period_us(Sensor::BARO, 2500));
+}
+
+TEST(SensorDemand, Rates)
+{
+    AP_SensorDemand *demand = NEW_NOTHROW AP_SensorDemand();
+
+    // nothing needs the compass, so it drops to the idle rate
+    demand->set_rate_hz(Sensor::COMPASS, Consumer::AHRS, 0);
+    EXPECT_EQ(1000000U / AP_SENSOR_DEMAND_IDLE_HZ, demand->period_us(Sensor::COMPASS, 10000));
+
+    // the fastest consumer sets the rate
+    demand->set_rate_hz(Sensor::COMPASS, Consumer::AHRS, 25);
+    EXPECT_EQ(40000U, demand->period_us(Sensor::COMPASS, 10000));
+    demand->set_rate_hz(Sensor::COMPASS, Consumer::COMPASS_CAL, 50);
+    EXPECT_EQ(20000U, demand->period_us(Sensor::COMPASS, 10000));
+
+    // never faster than the backend rate
+    demand->set_rate_hz(Sensor::COMPASS, Consumer::COMPASS_CAL, 1000);
+    EXPECT_EQ(12500U, demand->period_us(Sensor::COMPASS, 12500));
+
+    // other sensors are not affected
+    EXPECT_EQ(20000U, demand->period_us(Sensor::AIRSPEED, 20000));
+}
+
+AP_GTEST_MAIN()
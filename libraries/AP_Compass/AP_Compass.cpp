@@ -3,6 +3,7 @@
 #if AP_COMPASS_ENABLED
 
 #include <AP_HAL/AP_HAL.h>
+#include <AP_Common/AP_BootTrace.h>
 #if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
 #include <AP_HAL_Linux/I2CDevice.h>
 #endif
@@ -843,6 +844,7 @@ void Compass::init()
     if (_compass_count == 0) {
         // detect available backends. Only called once
         _detect_backends();
+        AP_BOOT_TRACE("compass detect");
     }
 
     if (_compass_count != 0) {
@@ -1102,13 +1104,66 @@ bool Compass::_have_i2c_driver(uint8_t bus, uint8_t address) const
         CHECK_UNREG_LIMIT_RETURN; \
     } while (0)
 
-#define GET_I2C_DEVICE(bus, address) _have_i2c_driver(bus, address)?nullptr:hal.i2c_mgr->get_device(bus, address)
+#define GET_I2C_DEVICE(bus, address) _get_i2c_device(bus, address)
+// for devices that are only reachable once another device has set
+// them up, so would not answer a scan
+#define GET_I2C_DEVICE_NOSCAN(bus, address) _get_i2c_device(bus, address, false)
+
+/*
+  wrapper around hal.i2c_mgr->get_device() that skips devices we
+  already have and, during an external probe, devices that a scan
+  found absent
+ */
+AP_HAL::OwnPtr<AP_HAL::I2CDevice> Compass::_get_i2c_device(uint8_t bus, uint8_t address, bool scan)
+{
+    if (_have_i2c_driver(bus, address)) {
+        return nullptr;
+    }
+#if AP_HAL_I2C_PROBE_SCAN_ENABLED
+    if (_i2c_scan != nullptr) {
+        if (_i2c_scan_collect) {
+            if (scan) {
+                _i2c_scan->add(bus, address);
+            }
+            return nullptr;
+        }
+        if (scan && !_i2c_scan->maybe_present(bus, address)) {
+            return nullptr;
+        }
+    }
+#endif
+    return hal.i2c_mgr->get_device(bus, address);
+}
 
 /*
   look for compasses on external i2c buses
  */
 void Compass::_probe_external_i2c_compasses(void)
 {
+#if AP_HAL_I2C_PROBE_SCAN_ENABLED
+    /*
+      a first pass through the probes only collects the addresses they
+      would open. Those are scanned on all buses at once, then the
+      real pass skips the addresses that did not answer
+     */
+    AP_HAL::I2CProbeScan scan;
+    _i2c_scan = &scan;
+    _i2c_scan_collect = true;
+    _probe_i2c_compass_list();
+    _i2c_scan_collect = false;
+    scan.scan();
+    _probe_i2c_compass_list();
+    _i2c_scan = nullptr;
+#else
+    _probe_i2c_compass_list();
+#endif
+}
+
+/*
+  probe for each compass type on the i2c buses
+ */
+void Compass::_probe_i2c_compass_list(void)
+{
 #if !defined(HAL_SKIP_AUTO_INTERNAL_I2C_PROBE)
     bool all_external = (AP_BoardConfig::get_board_type() == AP_BoardConfig::PX4_BOARD_PIXHAWK2);
     (void)all_external;  // in case all backends using this are compiled out
@@ -1195,20 +1250,20 @@ void Compass::_probe_external_i2c_compasses(void)
     // AK09916 on ICM20948
 #if AP_COMPASS_AK09916_ENABLED && AP_COMPASS_ICM20948_ENABLED
     FOREACH_I2C_EXTERNAL(i) {
-        ADD_BACKEND(DRIVER_ICM20948, AP_Compass_AK09916::probe_ICM20948(GET_I2C_DEVICE(i, HAL_COMPASS_AK09916_I2C_ADDR),
+        ADD_BACKEND(DRIVER_ICM20948, AP_Compass_AK09916::probe_ICM20948(GET_I2C_DEVICE_NOSCAN(i, HAL_COMPASS_AK09916_I2C_ADDR),
                     GET_I2C_DEVICE(i, HAL_COMPASS_ICM20948_I2C_ADDR),
                     true, ROTATION_PITCH_180_YAW_90));
-        ADD_BACKEND(DRIVER_ICM20948, AP_Compass_AK09916::probe_ICM20948(GET_I2C_DEVICE(i, HAL_COMPASS_AK09916_I2C_ADDR),
+        ADD_BACKEND(DRIVER_ICM20948, AP_Compass_AK09916::probe_ICM20948(GET_I2C_DEVICE_NOSCAN(i, HAL_COMPASS_AK09916_I2C_ADDR),
                     GET_I2C_DEVICE(i, HAL_COMPASS_ICM20948_I2C_ADDR2),
                     true, ROTATION_PITCH_180_YAW_90));
     }
 
 #if !defined(HAL_SKIP_AUTO_INTERNAL_I2C_PROBE)
     FOREACH_I2C_INTERNAL(i) {
-        ADD_BACKEND(DRIVER_ICM20948, AP_Compass_AK09916::probe_ICM20948(GET_I2C_DEVICE(i, HAL_COMPASS_AK09916_I2C_ADDR),
+        ADD_BACKEND(DRIVER_ICM20948, AP_Compass_AK09916::probe_ICM20948(GET_I2C_DEVICE_NOSCAN(i, HAL_COMPASS_AK09916_I2C_ADDR),
                     GET_I2C_DEVICE(i, HAL_COMPASS_ICM20948_I2C_ADDR),
                     all_external, ROTATION_PITCH_180_YAW_90));
-        ADD_BACKEND(DRIVER_ICM20948, AP_Compass_AK09916::probe_ICM20948(GET_I2C_DEVICE(i, HAL_COMPASS_AK09916_I2C_ADDR),
+        ADD_BACKEND(DRIVER_ICM20948, AP_Compass_AK09916::probe_ICM20948(GET_I2C_DEVICE_NOSCAN(i, HAL_COMPASS_AK09916_I2C_ADDR),
                     GET_I2C_DEVICE(i, HAL_COMPASS_ICM20948_I2C_ADDR2),
                     all_external, ROTATION_PITCH_180_YAW_90));
     }
@@ -381,6 +381,7 @@ private:
     // load backend drivers
     bool _add_backend(AP_Compass_Backend *backend);
     __INITFUNC__ void _probe_external_i2c_compasses(void);
+    __INITFUNC__ void _probe_i2c_compass_list(void);
     __INITFUNC__ void _detect_backends(void);
     __INITFUNC__ void probe_i2c_spi_compasses(void);
 #if AP_COMPASS_DRONECAN_ENABLED
@@ -407,6 +408,16 @@ private:
     // see if we already have probed a i2c driver by bus number and address
     bool _have_i2c_driver(uint8_t bus_num, uint8_t address) const;
 
+    // get a device to probe, see GET_I2C_DEVICE
+    AP_HAL::OwnPtr<AP_HAL::I2CDevice> _get_i2c_device(uint8_t bus, uint8_t address, bool scan=true);
+
+#if AP_HAL_I2C_PROBE_SCAN_ENABLED
+    // scan of the external probe addresses, only set while probing
+    AP_HAL::I2CProbeScan *_i2c_scan;
+    // true on the pass that collects addresses for _i2c_scan
+    bool _i2c_scan_collect;
+#endif
+
 #if AP_COMPASS_CALIBRATION_FIXED_YAW_ENABLED
     /*
       get mag field with the effects of offsets, diagonals and
@@ -515,7 +526,7 @@ private:
     AP_Enum<LearnType> _learn;
 
     // board orientation from AHRS
-    enum Rotation _board_orientation = ROTATION_NONE;
+    FastRotation _board_orientation;
 
     // declination in radians
     AP_Float    _declination;
@@ -572,7 +583,7 @@ private:
         uint32_t    last_update_usec;
 
         // board specific orientation
-        enum Rotation rotation;
+        FastRotation rotation;
 
         // accumulated samples, protected by _sem, used by AP_Compass_Backend
         Vector3f accum;
@@ -22,7 +22,7 @@ void AP_Compass_Backend::rotate_field(Vector3f &mag, uint8_t instance)
     if (MAG_BOARD_ORIENTATION != ROTATION_NONE) {
         mag.rotate(MAG_BOARD_ORIENTATION);
     }
-    mag.rotate(state.rotation);
+    state.rotation.rotate(mag);
 
 #ifdef HAL_HEATER_MAG_OFFSET
     /*
@@ -49,7 +49,7 @@ void AP_Compass_Backend::rotate_field(Vector3f &mag, uint8_t instance)
 #endif
 
     if (!state.external) {
-        mag.rotate(_compass._board_orientation);
+        _compass._board_orientation.rotate(mag);
     } else {
         // add user selectable orientation
         mag.rotate((enum Rotation)state.orientation.get());
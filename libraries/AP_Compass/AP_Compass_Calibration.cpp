@@ -4,6 +4,7 @@
 #include <GCS_MAVLink/GCS.h>
 #include <AP_AHRS/AP_AHRS.h>
 #include <AP_InternalError/AP_InternalError.h>
+#include <AP_Common/AP_SensorDemand.h>
 
 #include "AP_Compass.h"
 
@@ -36,6 +37,12 @@ void Compass::cal_update()
 
     AP_Notify::flags.compass_cal_running = running;
 
+#if AP_SENSOR_DEMAND_ENABLED
+    // calibration wants every sample
+    AP::sensor_demand().set_rate_hz(AP_SensorDemand::Sensor::COMPASS, AP_SensorDemand::Consumer::COMPASS_CAL,
+                                    is_calibrating() ? 100 : 0);
+#endif
+
     if (is_calibrating()) {
         _cal_has_run = true;
         return;
@@ -119,9 +119,9 @@ bool AP_Compass_LIS3MDL::init()
         set_external(compass_instance, true);
     }
     
-    // call timer() at 80Hz
-    dev->register_periodic_callback(1000000U/80U,
-                                    FUNCTOR_BIND_MEMBER(&AP_Compass_LIS3MDL::timer, void));
+    // call timer() at 80Hz, slower when the data isn't needed
+    poller.register_callback(*dev, 1000000U/80U,
+                             FUNCTOR_BIND_MEMBER(&AP_Compass_LIS3MDL::timer, void));
 
     return true;
 
@@ -132,6 +132,8 @@ fail:
 
 void AP_Compass_LIS3MDL::timer()
 {
+    poller.update(*dev);
+
     struct PACKED {
         int16_t magx;
         int16_t magy;
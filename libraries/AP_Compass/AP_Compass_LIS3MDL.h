@@ -22,6 +22,7 @@
 #include <AP_HAL/AP_HAL.h>
 #include <AP_HAL/Device.h>
 #include <AP_Math/AP_Math.h>
+#include <AP_Common/AP_SensorDemand.h>
 
 #include "AP_Compass.h"
 #include "AP_Compass_Backend.h"
@@ -51,6 +52,7 @@ private:
                        enum Rotation rotation);
 
     AP_HAL::OwnPtr<AP_HAL::Device> dev;
+    AP_SensorDemand::Poller poller{AP_SensorDemand::Sensor::COMPASS};
     
     /**
      * Device periodic callback to read data from the sensor.
@@ -129,9 +129,8 @@ bool AP_Compass_QMC5883L::init()
         set_external(_instance, true);
     }
 
-    //Enable 100HZ
-    _dev->register_periodic_callback(10000,
-        FUNCTOR_BIND_MEMBER(&AP_Compass_QMC5883L::timer, void));
+    //Enable 100HZ, slower when the data isn't needed
+    _poller.register_callback(*_dev, 10000, FUNCTOR_BIND_MEMBER(&AP_Compass_QMC5883L::timer, void));
 
     return true;
 
@@ -157,6 +156,8 @@ bool AP_Compass_QMC5883L::_check_whoami()
 
 void AP_Compass_QMC5883L::timer()
 {
+    _poller.update(*_dev);
+
     struct PACKED {
     	le16_t rx;
     	le16_t ry;
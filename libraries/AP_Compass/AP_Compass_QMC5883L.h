@@ -24,6 +24,7 @@
 #include <AP_HAL/AP_HAL.h>
 #include <AP_HAL/I2CDevice.h>
 #include <AP_Math/AP_Math.h>
+#include <AP_Common/AP_SensorDemand.h>
 
 #include "AP_Compass.h"
 #include "AP_Compass_Backend.h"
@@ -65,6 +66,7 @@ private:
     bool init();
 
     AP_HAL::OwnPtr<AP_HAL::Device> _dev;
+    AP_SensorDemand::Poller _poller{AP_SensorDemand::Sensor::COMPASS};
 
     enum Rotation _rotation;
     uint8_t _instance;
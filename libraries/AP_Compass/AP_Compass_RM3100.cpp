@@ -158,15 +158,17 @@ bool AP_Compass_RM3100::init()
         set_external(compass_instance, true);
     }
     
-    // call timer() at 80Hz
-    dev->register_periodic_callback(1000000U/80U,
-                                    FUNCTOR_BIND_MEMBER(&AP_Compass_RM3100::timer, void));
+    // call timer() at 80Hz, slower when the data isn't needed
+    poller.register_callback(*dev, 1000000U/80U,
+                             FUNCTOR_BIND_MEMBER(&AP_Compass_RM3100::timer, void));
 
     return true;
 }
 
 void AP_Compass_RM3100::timer()
 {
+    poller.update(*dev);
+
     struct PACKED {
         uint8_t magx_2;
         uint8_t magx_1;
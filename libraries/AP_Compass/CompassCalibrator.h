@@ -9,6 +9,9 @@
 #define COMPASS_CAL_NUM_SPHERE_PARAMS       4
 #define COMPASS_CAL_NUM_ELLIPSOID_PARAMS    9
 #define COMPASS_CAL_NUM_SAMPLES             300     // number of samples required before fitting begins
+#ifndef COMPASS_CAL_FIT_BUDGET_US
+#define COMPASS_CAL_FIT_BUDGET_US           2000    // time each update may spend running fit steps
+#endif
 
 class CompassCalibrator {
 public:
@@ -182,15 +185,24 @@ private:
     void calc_initial_offset();
 
     // run sphere fit to calculate diagonals and offdiagonals
-    void calc_sphere_jacob(const Vector3f& sample, const param_t& params, float* ret) const;
+    // the jacobian functions also return the sample's residual
+    float calc_sphere_jacob(const Vector3f& sample, const param_t& params, float* ret) const;
     void run_sphere_fit();
 
     // run ellipsoid fit to calculate diagonals and offdiagonals
-    void calc_ellipsoid_jacob(const Vector3f& sample, const param_t& params, float* ret) const;
+    float calc_ellipsoid_jacob(const Vector3f& sample, const param_t& params, float* ret) const;
     void run_ellipsoid_fit();
 
+    // run one step of the sphere or ellipsoid fit, moving on to the
+    // next status once enough steps have been run
+    void run_fit_step();
+
     // update the completion mask based on a single sample
     void update_completion_mask(const Vector3f& sample);
+    void update_completion_mask(const Vector3f& sample, const Matrix3f& softiron);
+
+    // soft iron matrix from the current fit parameters
+    Matrix3f get_softiron_matrix() const;
 
     // reset and updated the completion mask using all samples in the sample buffer
     void update_completion_mask();
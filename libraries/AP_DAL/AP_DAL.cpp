@@ -6,6 +6,7 @@
 #include <AP_Vehicle/AP_Vehicle.h>
 #include <AP_OpticalFlow/AP_OpticalFlow.h>
 #include <AP_WheelEncoder/AP_WheelEncoder.h>
+#include <AP_Scheduler/AP_Scheduler.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
 #include <AP_NavEKF3/AP_NavEKF3_feature.h>
 #include <AP_NavEKF/AP_Nav_Common.h>
@@ -80,6 +81,16 @@ void AP_DAL::start_frame(AP_DAL::FrameType frametype)
 #endif
     _RFRN.wheelencoder_enabled = AP::wheelencoder() && (AP::wheelencoder()->num_sensors() > 0);
     _RFRN.ekf_type = ahrs.get_ekf_type();
+#if AP_SCHEDULER_ENABLED
+    if (!_RFRN.armed) {
+        // filter over a few seconds with a 5% deadband so RFRN is
+        // rarely rewritten
+        _cpu_load_filt += 0.001f * (AP::scheduler().load_average()*100 - _cpu_load_filt);
+        if (fabsf(_cpu_load_filt - _RFRN.cpu_load) >= 5) {
+            _RFRN.cpu_load = constrain_float(_cpu_load_filt, 0, 100);
+        }
+    }
+#endif
     WRITE_REPLAY_BLOCK_IFCHANGED(RFRN, _RFRN, old);
 
     // update body conversion
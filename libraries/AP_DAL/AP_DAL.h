@@ -110,6 +110,9 @@ public:
     // returns armed state for the current frame
     bool get_armed() const { return _RFRN.armed; }
 
+    // main loop CPU load in percent, only updated while disarmed
+    uint8_t cpu_load() const { return _RFRN.cpu_load; }
+
     // memory available at start of current frame.  While this could
     // potentially change as we go through the frame, the
     // ramifications of being out of memory are that you don't start
@@ -370,6 +373,9 @@ private:
     Location _home;
     uint32_t _last_imu_time_us;
 
+    // filtered scheduler load, used for _RFRN.cpu_load
+    float _cpu_load_filt;
+
     AP_DAL_InertialSensor _ins;
     AP_DAL_Baro _baro;
     AP_DAL_GPS _gps;
@@ -42,6 +42,7 @@ void AP_DAL_InertialSensor::start_frame()
         }
 
         update_filtered(i);
+        update_delta_angle_quat(i);
 
         WRITE_REPLAY_BLOCK_IFCHANGED(RISI, RISI, old_RISI);
 
@@ -66,3 +67,9 @@ void AP_DAL_InertialSensor::update_filtered(uint8_t i)
         accel_filtered[i] += ((_RISI[i].delta_velocity/_RISI[i].delta_velocity_dt) - accel_filtered[i]) * alpha;
     }
 }
+
+// update the rotation by the latest delta angle
+void AP_DAL_InertialSensor::update_delta_angle_quat(uint8_t i)
+{
+    delta_angle_quat[i].from_axis_angle(_RISI[i].delta_angle.toftype());
+}
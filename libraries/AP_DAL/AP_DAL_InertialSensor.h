@@ -41,6 +41,10 @@ public:
         return _RISI[i].get_delta_angle_ret;
     }
 
+    // rotation by the latest delta angle, calculated once per IMU so
+    // the EKF cores accumulating down-sampled IMU data can share it
+    const QuaternionF &get_delta_angle_quat(uint8_t i) const { return delta_angle_quat[i]; }
+
     // return the main loop delta_t in seconds
     float get_loop_delta_t(void) const { return _RISH.loop_delta_t; }
 
@@ -56,6 +60,7 @@ public:
         _RISI[msg.instance] = msg;
         pos[msg.instance] = AP::ins().get_imu_pos_offset(msg.instance);
         update_filtered(msg.instance);
+        update_delta_angle_quat(msg.instance);
     }
 
 private:
@@ -69,7 +74,10 @@ private:
     Vector3f gyro_filtered[INS_MAX_INSTANCES];
     Vector3f accel_filtered[INS_MAX_INSTANCES];
 
+    QuaternionF delta_angle_quat[INS_MAX_INSTANCES];
+
     uint8_t _primary_gyro;
 
     void update_filtered(uint8_t i);
+    void update_delta_angle_quat(uint8_t i);
 };
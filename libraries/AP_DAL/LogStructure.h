@@ -76,6 +76,7 @@ struct log_RFRF {
 // @FieldValueEnum: EKT: AP_DAL::EKFType
 // @Field: Flags: bitmask of boolean state
 // @FieldBitmaskEnum: Flags: AP_DAL::RFRNFlags
+// @Field: Load: filtered scheduler load, only updated while disarmed
 struct log_RFRN {
     int32_t lat;
     int32_t lng;
@@ -93,6 +94,7 @@ struct log_RFRN {
     uint8_t wheelencoder_enabled:1;
     uint8_t takeoff_expected:1;
     uint8_t touchdown_expected:1;
+    uint8_t cpu_load;
     uint8_t _end;
 };
 
@@ -588,7 +590,7 @@ struct log_RBOH {
     { LOG_RFRF_MSG, RLOG_SIZE(RFRF),                          \
       "RFRF", "BB", "FTypes,Slow", "--", "--" }, \
     { LOG_RFRN_MSG, RLOG_SIZE(RFRN),                            \
-      "RFRN", "IIIfIfffBBB", "HLat,HLon,HAlt,E2T,AM,TX,TY,TZ,VC,EKT,Flags", "DUm-bddd---", "GGB--------" }, \
+      "RFRN", "IIIfIfffBBBB", "HLat,HLon,HAlt,E2T,AM,TX,TY,TZ,VC,EKT,Flags,Load", "DUm-bddd---%", "GGB--------0" }, \
     { LOG_REV2_MSG, RLOG_SIZE(REV2),                                   \
       "REV2", "B", "Event", "-", "-" }, \
     { LOG_RSO2_MSG, RLOG_SIZE(RSO2),                         \
@@ -15,6 +15,7 @@
 #include <GCS_MAVLink/GCS.h>
 #include <AP_BattMonitor/AP_BattMonitor.h>
 #include <AP_AHRS/AP_AHRS.h>
+#include <AP_Logger/AP_Logger.h>
 #if AP_DDS_ARM_SERVER_ENABLED
 #include <AP_Arming/AP_Arming.h>
 # endif // AP_DDS_ARM_SERVER_ENABLED
@@ -169,6 +170,115 @@ const AP_Param::GroupInfo AP_DDS_Client::var_info[] {
     // @User: Standard
     AP_GROUPINFO("_MAX_RETRY", 6, AP_DDS_Client, ping_max_retry, 10),
 
+#if AP_DDS_TIME_PUB_ENABLED
+    // @Param: _RATE_TIME
+    // @DisplayName: DDS time publish rate
+    // @Description: Rate at which the time topic is checked and published. Set to 0 to stop publishing the topic.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_TIME", 7, AP_DDS_Client, rate_hz.time, 1000 / DELAY_TIME_TOPIC_MS),
+#endif
+
+#if AP_DDS_BATTERY_STATE_PUB_ENABLED
+    // @Param: _RATE_BATT
+    // @DisplayName: DDS battery state publish rate
+    // @Description: Rate at which the battery state topic is checked and published. Set to 0 to stop publishing the topic. Between keepalives the topic is only published when its content has changed.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_BATT", 8, AP_DDS_Client, rate_hz.battery_state, 1000 / DELAY_BATTERY_STATE_TOPIC_MS),
+#endif
+
+#if AP_DDS_LOCAL_POSE_PUB_ENABLED
+    // @Param: _RATE_LPOSE
+    // @DisplayName: DDS local pose publish rate
+    // @Description: Rate at which the local pose topic is checked and published. Set to 0 to stop publishing the topic.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_LPOSE", 9, AP_DDS_Client, rate_hz.local_pose, 1000 / DELAY_LOCAL_POSE_TOPIC_MS),
+#endif
+
+#if AP_DDS_LOCAL_VEL_PUB_ENABLED
+    // @Param: _RATE_LVEL
+    // @DisplayName: DDS local velocity publish rate
+    // @Description: Rate at which the local velocity topic is checked and published. Set to 0 to stop publishing the topic.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_LVEL", 10, AP_DDS_Client, rate_hz.local_velocity, 1000 / DELAY_LOCAL_VELOCITY_TOPIC_MS),
+#endif
+
+#if AP_DDS_AIRSPEED_PUB_ENABLED
+    // @Param: _RATE_ASPD
+    // @DisplayName: DDS airspeed publish rate
+    // @Description: Rate at which the airspeed topic is checked and published. Set to 0 to stop publishing the topic.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_ASPD", 11, AP_DDS_Client, rate_hz.airspeed, 1000 / DELAY_AIRSPEED_TOPIC_MS),
+#endif
+
+#if AP_DDS_RC_PUB_ENABLED
+    // @Param: _RATE_RC
+    // @DisplayName: DDS RC publish rate
+    // @Description: Rate at which the RC topic is checked and published. Set to 0 to stop publishing the topic.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_RC", 12, AP_DDS_Client, rate_hz.rc, 1000 / DELAY_RC_TOPIC_MS),
+#endif
+
+#if AP_DDS_IMU_PUB_ENABLED
+    // @Param: _RATE_IMU
+    // @DisplayName: DDS IMU publish rate
+    // @Description: Rate at which the IMU topic is checked and published. Set to 0 to stop publishing the topic.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_IMU", 13, AP_DDS_Client, rate_hz.imu, 1000 / DELAY_IMU_TOPIC_MS),
+#endif
+
+#if AP_DDS_GEOPOSE_PUB_ENABLED
+    // @Param: _RATE_GPOSE
+    // @DisplayName: DDS geographic pose publish rate
+    // @Description: Rate at which the geographic pose topic is checked and published. Set to 0 to stop publishing the topic.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_GPOSE", 14, AP_DDS_Client, rate_hz.geo_pose, 1000 / DELAY_GEO_POSE_TOPIC_MS),
+#endif
+
+#if AP_DDS_CLOCK_PUB_ENABLED
+    // @Param: _RATE_CLOCK
+    // @DisplayName: DDS clock publish rate
+    // @Description: Rate at which the clock topic is checked and published. Set to 0 to stop publishing the topic.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_CLOCK", 15, AP_DDS_Client, rate_hz.clock, 1000 / DELAY_CLOCK_TOPIC_MS),
+#endif
+
+#if AP_DDS_GPS_GLOBAL_ORIGIN_PUB_ENABLED
+    // @Param: _RATE_ORIGIN
+    // @DisplayName: DDS GPS global origin publish rate
+    // @Description: Rate at which the GPS global origin topic is checked and published. Set to 0 to stop publishing the topic. Between keepalives the topic is only published when its content has changed.
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("_RATE_ORIGIN", 16, AP_DDS_Client, rate_hz.gps_global_origin, 1000 / DELAY_GPS_GLOBAL_ORIGIN_TOPIC_MS),
+#endif
+
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+    // @Param: _IMU_BATCH
+    // @DisplayName: DDS IMU batch size
+    // @Description: Number of IMU samples published in each ImuBatch message. One sample is taken per main loop, with the time it was read from the sensor. Larger batches use less bandwidth per sample but add latency. Set to 0 to disable the topic.
+    // @Range: 0 16
+    // @User: Advanced
+    AP_GROUPINFO("_IMU_BATCH", 17, AP_DDS_Client, imu_batch_size, 0),
+#endif
+
     AP_GROUPEND
 };
 
@@ -407,6 +517,41 @@ void AP_DDS_Client::update_topic(sensor_msgs_msg_BatteryState& msg, const uint8_
         }
     }
 }
+
+bool AP_DDS_Client::battery_state_changed(const sensor_msgs_msg_BatteryState& msg, const uint8_t instance, uint64_t now_ms)
+{
+    if (instance >= AP_BATT_MONITOR_MAX_INSTANCES) {
+        return false;
+    }
+    auto &prev = prev_battery_state[instance];
+
+    // Small changes are sensor noise, so only publish once they exceed the message's useful resolution.
+    const auto differs = [](float a, float b, float tolerance) {
+        if (isnan(a) || isnan(b)) {
+            return isnan(a) != isnan(b);
+        }
+        return fabsf(a - b) > tolerance;
+    };
+    if (!differs(msg.voltage, prev.voltage, 0.05) &&
+        !differs(msg.current, prev.current, 0.1) &&
+        !differs(msg.percentage, prev.percentage, 0.005) &&
+        msg.power_supply_status == prev.power_supply_status &&
+        msg.power_supply_health == prev.power_supply_health &&
+        msg.present == prev.present &&
+        prev.publish_ms != 0 &&
+        now_ms - prev.publish_ms < AP_DDS_ONCHANGE_KEEPALIVE_MS) {
+        return false;
+    }
+
+    prev.voltage = msg.voltage;
+    prev.current = msg.current;
+    prev.percentage = msg.percentage;
+    prev.power_supply_status = msg.power_supply_status;
+    prev.power_supply_health = msg.power_supply_health;
+    prev.present = msg.present;
+    prev.publish_ms = now_ms;
+    return true;
+}
 #endif // AP_DDS_BATTERY_STATE_PUB_ENABLED
 
 #if AP_DDS_LOCAL_POSE_PUB_ENABLED
@@ -679,6 +824,61 @@ void AP_DDS_Client::update_topic(sensor_msgs_msg_Imu& msg)
 }
 #endif // AP_DDS_IMU_PUB_ENABLED
 
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+bool AP_DDS_Client::update_topic_imu_batch(ardupilot_msgs_msg_ImuBatch& msg)
+{
+    auto &ins = AP::ins();
+    if (!imu_batch_stream_enabled) {
+        // room for the samples that arrive between two full batches
+        imu_batch_stream_enabled = ins.enable_sample_stream(2 * AP_DDS_IMU_BATCH_MAX_SAMPLES);
+        if (!imu_batch_stream_enabled) {
+            return false;
+        }
+    }
+
+    const uint32_t batch_size = MIN(uint32_t(imu_batch_size.get()), uint32_t(AP_DDS_IMU_BATCH_MAX_SAMPLES));
+    AP_InertialSensor::StreamSample sample;
+    while (msg.time_offset_us_size < batch_size && ins.get_stream_sample(sample)) {
+        if (msg.time_offset_us_size == 0 || sample.instance != msg.instance) {
+            // a change of IMU restarts the batch so all samples share a sensor
+            msg.instance = sample.instance;
+            msg.time_offset_us_size = 0;
+            imu_batch_first_us = sample.sample_us;
+        }
+        const uint32_t i = msg.time_offset_us_size++;
+        msg.time_offset_us[i] = sample.sample_us - imu_batch_first_us;
+        msg.angular_velocity[i].x = sample.gyro.x;
+        msg.angular_velocity[i].y = sample.gyro.y;
+        msg.angular_velocity[i].z = sample.gyro.z;
+        msg.linear_acceleration[i].x = sample.accel.x;
+        msg.linear_acceleration[i].y = sample.accel.y;
+        msg.linear_acceleration[i].z = sample.accel.z;
+        msg.angular_velocity_size = msg.time_offset_us_size;
+        msg.linear_acceleration_size = msg.time_offset_us_size;
+    }
+
+    if (msg.time_offset_us_size == 0) {
+        return false;
+    }
+    const uint64_t now_us = AP_HAL::micros64();
+    if (msg.time_offset_us_size < batch_size &&
+        now_us - imu_batch_first_us < AP_DDS_IMU_BATCH_MAX_LATENCY_MS * 1000ULL) {
+        return false;
+    }
+
+    // move the first sample's boot time onto the clock used by the other topics
+    uint64_t stamp_us = imu_batch_first_us;
+    uint64_t utc_usec;
+    if (AP::rtc().get_utc_usec(utc_usec)) {
+        stamp_us += utc_usec - now_us;
+    }
+    msg.header.stamp.sec = stamp_us / 1000000ULL;
+    msg.header.stamp.nanosec = (stamp_us % 1000000ULL) * 1000UL;
+    STRCPY(msg.header.frame_id, BASE_LINK_NED_FRAME_ID);
+    return true;
+}
+#endif // AP_DDS_IMU_BATCH_PUB_ENABLED
+
 #if AP_DDS_CLOCK_PUB_ENABLED
 void AP_DDS_Client::update_topic(rosgraph_msgs_msg_Clock& msg)
 {
@@ -704,6 +904,23 @@ void AP_DDS_Client::update_topic(geographic_msgs_msg_GeoPointStamped& msg)
         msg.position.altitude = ekf_origin.alt * 0.01;
     }
 }
+
+bool AP_DDS_Client::gps_global_origin_changed(const geographic_msgs_msg_GeoPointStamped& msg, uint64_t now_ms)
+{
+    // The origin rarely moves, so only publish it when it does and as a keepalive.
+    const double tolerance_lat_lon = 1e-8; // One order of magnitude smaller than the origin's resolution.
+    const double tolerance_alt = 1e-3;
+    if (abs(msg.position.latitude - prev_gps_global_origin_msg.position.latitude) > tolerance_lat_lon ||
+        abs(msg.position.longitude - prev_gps_global_origin_msg.position.longitude) > tolerance_lat_lon ||
+        abs(msg.position.altitude - prev_gps_global_origin_msg.position.altitude) > tolerance_alt ||
+        last_gps_global_origin_publish_ms == 0 ||
+        now_ms - last_gps_global_origin_publish_ms >= AP_DDS_ONCHANGE_KEEPALIVE_MS) {
+        prev_gps_global_origin_msg.position = msg.position;
+        last_gps_global_origin_publish_ms = now_ms;
+        return true;
+    }
+    return false;
+}
 #endif // AP_DDS_GPS_GLOBAL_ORIGIN_PUB_ENABLED
 
 #if AP_DDS_STATUS_PUB_ENABLED
@@ -1499,7 +1716,7 @@ void AP_DDS_Client::write_time_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = builtin_interfaces_msg_Time_size_of_topic(&time_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::TIME_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::TIME_PUB), ub, topic_size);
         const bool success = builtin_interfaces_msg_Time_serialize_topic(&ub, &time_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1515,7 +1732,7 @@ void AP_DDS_Client::write_nav_sat_fix_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = sensor_msgs_msg_NavSatFix_size_of_topic(&nav_sat_fix_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::NAV_SAT_FIX_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::NAV_SAT_FIX_PUB), ub, topic_size);
         const bool success = sensor_msgs_msg_NavSatFix_serialize_topic(&ub, &nav_sat_fix_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1532,7 +1749,7 @@ void AP_DDS_Client::write_static_transforms()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = tf2_msgs_msg_TFMessage_size_of_topic(&tx_static_transforms_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::STATIC_TRANSFORMS_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::STATIC_TRANSFORMS_PUB), ub, topic_size);
         const bool success = tf2_msgs_msg_TFMessage_serialize_topic(&ub, &tx_static_transforms_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1549,7 +1766,7 @@ void AP_DDS_Client::write_battery_state_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = sensor_msgs_msg_BatteryState_size_of_topic(&battery_state_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::BATTERY_STATE_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::BATTERY_STATE_PUB), ub, topic_size);
         const bool success = sensor_msgs_msg_BatteryState_serialize_topic(&ub, &battery_state_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1566,7 +1783,7 @@ void AP_DDS_Client::write_local_pose_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = geometry_msgs_msg_PoseStamped_size_of_topic(&local_pose_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::LOCAL_POSE_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::LOCAL_POSE_PUB), ub, topic_size);
         const bool success = geometry_msgs_msg_PoseStamped_serialize_topic(&ub, &local_pose_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1583,7 +1800,7 @@ void AP_DDS_Client::write_tx_local_velocity_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = geometry_msgs_msg_TwistStamped_size_of_topic(&tx_local_velocity_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::LOCAL_VELOCITY_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::LOCAL_VELOCITY_PUB), ub, topic_size);
         const bool success = geometry_msgs_msg_TwistStamped_serialize_topic(&ub, &tx_local_velocity_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1599,7 +1816,7 @@ void AP_DDS_Client::write_tx_local_airspeed_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = ardupilot_msgs_msg_Airspeed_size_of_topic(&tx_local_airspeed_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::LOCAL_AIRSPEED_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::LOCAL_AIRSPEED_PUB), ub, topic_size);
         const bool success = ardupilot_msgs_msg_Airspeed_serialize_topic(&ub, &tx_local_airspeed_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1615,7 +1832,7 @@ void AP_DDS_Client::write_tx_local_rc_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = ardupilot_msgs_msg_Rc_size_of_topic(&tx_local_rc_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::LOCAL_RC_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::LOCAL_RC_PUB), ub, topic_size);
         const bool success = ardupilot_msgs_msg_Rc_serialize_topic(&ub, &tx_local_rc_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1631,7 +1848,7 @@ void AP_DDS_Client::write_imu_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = sensor_msgs_msg_Imu_size_of_topic(&imu_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::IMU_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::IMU_PUB), ub, topic_size);
         const bool success = sensor_msgs_msg_Imu_serialize_topic(&ub, &imu_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1641,6 +1858,23 @@ void AP_DDS_Client::write_imu_topic()
 }
 #endif // AP_DDS_IMU_PUB_ENABLED
 
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+void AP_DDS_Client::write_imu_batch_topic()
+{
+    WITH_SEMAPHORE(csem);
+    if (connected) {
+        ucdrBuffer ub {};
+        const uint32_t topic_size = ardupilot_msgs_msg_ImuBatch_size_of_topic(&imu_batch_topic, 0);
+        prepare_output_stream(to_underlying(TopicIndex::IMU_BATCH_PUB), ub, topic_size);
+        const bool success = ardupilot_msgs_msg_ImuBatch_serialize_topic(&ub, &imu_batch_topic);
+        if (!success) {
+            // TODO sometimes serialization fails on bootup. Determine why.
+            // AP_HAL::panic("FATAL: DDS_Client failed to serialize");
+        }
+    }
+}
+#endif // AP_DDS_IMU_BATCH_PUB_ENABLED
+
 #if AP_DDS_GEOPOSE_PUB_ENABLED
 void AP_DDS_Client::write_geo_pose_topic()
 {
@@ -1648,7 +1882,7 @@ void AP_DDS_Client::write_geo_pose_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = geographic_msgs_msg_GeoPoseStamped_size_of_topic(&geo_pose_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::GEOPOSE_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::GEOPOSE_PUB), ub, topic_size);
         const bool success = geographic_msgs_msg_GeoPoseStamped_serialize_topic(&ub, &geo_pose_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1665,7 +1899,7 @@ void AP_DDS_Client::write_clock_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = rosgraph_msgs_msg_Clock_size_of_topic(&clock_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::CLOCK_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::CLOCK_PUB), ub, topic_size);
         const bool success = rosgraph_msgs_msg_Clock_serialize_topic(&ub, &clock_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1682,7 +1916,7 @@ void AP_DDS_Client::write_gps_global_origin_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = geographic_msgs_msg_GeoPointStamped_size_of_topic(&gps_global_origin_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::GPS_GLOBAL_ORIGIN_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::GPS_GLOBAL_ORIGIN_PUB), ub, topic_size);
         const bool success = geographic_msgs_msg_GeoPointStamped_serialize_topic(&ub, &gps_global_origin_topic);
         if (!success) {
             // AP_HAL::panic("FATAL: DDS_Client failed to serialize");
@@ -1698,7 +1932,7 @@ void AP_DDS_Client::write_goal_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = geographic_msgs_msg_GeoPointStamped_size_of_topic(&goal_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::GOAL_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::GOAL_PUB), ub, topic_size);
         const bool success = geographic_msgs_msg_GeoPointStamped_serialize_topic(&ub, &goal_topic);
         if (!success) {
             // AP_HAL::panic("FATAL: DDS_Client failed to serialize");
@@ -1714,7 +1948,7 @@ void AP_DDS_Client::write_status_topic()
     if (connected) {
         ucdrBuffer ub {};
         const uint32_t topic_size = ardupilot_msgs_msg_Status_size_of_topic(&status_topic, 0);
-        uxr_prepare_output_stream(&session, reliable_out, topics[to_underlying(TopicIndex::STATUS_PUB)].dw_id, &ub, topic_size);
+        prepare_output_stream(to_underlying(TopicIndex::STATUS_PUB), ub, topic_size);
         const bool success = ardupilot_msgs_msg_Status_serialize_topic(&ub, &status_topic);
         if (!success) {
             // TODO sometimes serialization fails on bootup. Determine why.
@@ -1724,15 +1958,74 @@ void AP_DDS_Client::write_status_topic()
 }
 #endif // AP_DDS_STATUS_PUB_ENABLED
 
+bool AP_DDS_Client::publish_due(const AP_Int16& rate_hz, uint64_t& last_ms, const uint64_t now_ms)
+{
+    if (rate_hz <= 0) {
+        return false;
+    }
+    const uint32_t interval_ms = 1000U / MIN(rate_hz.get(), 1000);
+    if (now_ms - last_ms < interval_ms) {
+        return false;
+    }
+    last_ms = now_ms;
+    return true;
+}
+
+bool AP_DDS_Client::prepare_output_stream(const uint8_t topic_index, ucdrBuffer& ub, const uint32_t topic_size)
+{
+    if (uxr_prepare_output_stream(&session, reliable_out, topics[topic_index].dw_id, &ub, topic_size) == UXR_INVALID_REQUEST_ID) {
+        return false;
+    }
+    topic_stats[topic_index].bytes += topic_size;
+    topic_stats[topic_index].msgs++;
+    return true;
+}
+
+void AP_DDS_Client::update_topic_stats(const uint64_t now_ms)
+{
+    static_assert(ARRAY_SIZE(topics) <= max_topics, "too many DDS topics for topic_stats");
+
+    const uint32_t dt_ms = now_ms - last_topic_stats_ms;
+    if (dt_ms < 1000) {
+        return;
+    }
+    last_topic_stats_ms = now_ms;
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(topics); i++) {
+        auto &stats = topic_stats[i];
+        if (stats.msgs == 0) {
+            continue;
+        }
+#if HAL_LOGGING_ENABLED
+        // @LoggerMessage: DDST
+        // @Description: DDS per-topic traffic
+        // @Field: TimeUS: Time since system startup
+        // @Field: Id: topic index in the DDS topic table
+        // @Field: Rate: messages published per second
+        // @Field: BW: bytes of topic data published per second
+        AP::logger().WriteStreaming("DDST",
+                                    "TimeUS,Id,Rate,BW",
+                                    "s#zB",
+                                    "F---",
+                                    "QBfI",
+                                    AP_HAL::micros64(),
+                                    i,
+                                    stats.msgs * 1000.0f / dt_ms,
+                                    uint32_t(uint64_t(stats.bytes) * 1000U / dt_ms));
+#endif
+        stats.bytes = 0;
+        stats.msgs = 0;
+    }
+}
+
 void AP_DDS_Client::update()
 {
     WITH_SEMAPHORE(csem);
     const auto cur_time_ms = AP_HAL::millis64();
 
 #if AP_DDS_TIME_PUB_ENABLED
-    if (cur_time_ms - last_time_time_ms > DELAY_TIME_TOPIC_MS) {
+    if (publish_due(rate_hz.time, last_time_time_ms, cur_time_ms)) {
         update_topic(time_topic);
-        last_time_time_ms = cur_time_ms;
         write_time_topic();
     }
 #endif // AP_DDS_TIME_PUB_ENABLED
@@ -1744,72 +2037,71 @@ void AP_DDS_Client::update()
     }
 #endif // AP_DDS_NAVSATFIX_PUB_ENABLED
 #if AP_DDS_BATTERY_STATE_PUB_ENABLED
-    if (cur_time_ms - last_battery_state_time_ms > DELAY_BATTERY_STATE_TOPIC_MS) {
+    if (publish_due(rate_hz.battery_state, last_battery_state_time_ms, cur_time_ms)) {
         for (uint8_t battery_instance = 0; battery_instance < AP_BATT_MONITOR_MAX_INSTANCES; battery_instance++) {
             update_topic(battery_state_topic, battery_instance);
-            if (battery_state_topic.present) {
+            if (battery_state_topic.present && battery_state_changed(battery_state_topic, battery_instance, cur_time_ms)) {
                 write_battery_state_topic();
             }
         }
-        last_battery_state_time_ms = cur_time_ms;
     }
 #endif // AP_DDS_BATTERY_STATE_PUB_ENABLED
 #if AP_DDS_LOCAL_POSE_PUB_ENABLED
-    if (cur_time_ms - last_local_pose_time_ms > DELAY_LOCAL_POSE_TOPIC_MS) {
+    if (publish_due(rate_hz.local_pose, last_local_pose_time_ms, cur_time_ms)) {
         update_topic(local_pose_topic);
-        last_local_pose_time_ms = cur_time_ms;
         write_local_pose_topic();
     }
 #endif // AP_DDS_LOCAL_POSE_PUB_ENABLED
 #if AP_DDS_LOCAL_VEL_PUB_ENABLED
-    if (cur_time_ms - last_local_velocity_time_ms > DELAY_LOCAL_VELOCITY_TOPIC_MS) {
+    if (publish_due(rate_hz.local_velocity, last_local_velocity_time_ms, cur_time_ms)) {
         update_topic(tx_local_velocity_topic);
-        last_local_velocity_time_ms = cur_time_ms;
         write_tx_local_velocity_topic();
     }
 #endif // AP_DDS_LOCAL_VEL_PUB_ENABLED
 #if AP_DDS_AIRSPEED_PUB_ENABLED
-    if (cur_time_ms - last_airspeed_time_ms > DELAY_AIRSPEED_TOPIC_MS) {
-        last_airspeed_time_ms = cur_time_ms;
+    if (publish_due(rate_hz.airspeed, last_airspeed_time_ms, cur_time_ms)) {
         if (update_topic(tx_local_airspeed_topic)) {
             write_tx_local_airspeed_topic();
         }
     }
 #endif // AP_DDS_AIRSPEED_PUB_ENABLED
 #if AP_DDS_RC_PUB_ENABLED
-    if (cur_time_ms - last_rc_time_ms > DELAY_RC_TOPIC_MS) {
-        last_rc_time_ms = cur_time_ms;
+    if (publish_due(rate_hz.rc, last_rc_time_ms, cur_time_ms)) {
         if (update_topic(tx_local_rc_topic)) {
             write_tx_local_rc_topic();
         }
     }
 #endif // AP_DDS_RC_PUB_ENABLED
 #if AP_DDS_IMU_PUB_ENABLED
-    if (cur_time_ms - last_imu_time_ms > DELAY_IMU_TOPIC_MS) {
+    if (publish_due(rate_hz.imu, last_imu_time_ms, cur_time_ms)) {
         update_topic(imu_topic);
-        last_imu_time_ms = cur_time_ms;
         write_imu_topic();
     }
 #endif // AP_DDS_IMU_PUB_ENABLED
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+    if (imu_batch_size > 0 && update_topic_imu_batch(imu_batch_topic)) {
+        write_imu_batch_topic();
+        imu_batch_topic.time_offset_us_size = 0;
+    }
+#endif // AP_DDS_IMU_BATCH_PUB_ENABLED
 #if AP_DDS_GEOPOSE_PUB_ENABLED
-    if (cur_time_ms - last_geo_pose_time_ms > DELAY_GEO_POSE_TOPIC_MS) {
+    if (publish_due(rate_hz.geo_pose, last_geo_pose_time_ms, cur_time_ms)) {
         update_topic(geo_pose_topic);
-        last_geo_pose_time_ms = cur_time_ms;
         write_geo_pose_topic();
     }
 #endif // AP_DDS_GEOPOSE_PUB_ENABLED
 #if AP_DDS_CLOCK_PUB_ENABLED
-    if (cur_time_ms - last_clock_time_ms > DELAY_CLOCK_TOPIC_MS) {
+    if (publish_due(rate_hz.clock, last_clock_time_ms, cur_time_ms)) {
         update_topic(clock_topic);
-        last_clock_time_ms = cur_time_ms;
         write_clock_topic();
     }
 #endif // AP_DDS_CLOCK_PUB_ENABLED
 #if AP_DDS_GPS_GLOBAL_ORIGIN_PUB_ENABLED
-    if (cur_time_ms - last_gps_global_origin_time_ms > DELAY_GPS_GLOBAL_ORIGIN_TOPIC_MS) {
+    if (publish_due(rate_hz.gps_global_origin, last_gps_global_origin_time_ms, cur_time_ms)) {
         update_topic(gps_global_origin_topic);
-        last_gps_global_origin_time_ms = cur_time_ms;
-        write_gps_global_origin_topic();
+        if (gps_global_origin_changed(gps_global_origin_topic, cur_time_ms)) {
+            write_gps_global_origin_topic();
+        }
     }
 #endif // AP_DDS_GPS_GLOBAL_ORIGIN_PUB_ENABLED
 #if AP_DDS_GOAL_PUB_ENABLED
@@ -1829,6 +2121,8 @@ void AP_DDS_Client::update()
     }
 #endif // AP_DDS_STATUS_PUB_ENABLED
 
+    update_topic_stats(cur_time_ms);
+
     status_ok = uxr_run_session_time(&session, 1);
 }
 
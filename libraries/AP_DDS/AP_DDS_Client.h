@@ -26,6 +26,9 @@
 #if AP_DDS_IMU_PUB_ENABLED
 #include "sensor_msgs/msg/Imu.h"
 #endif // AP_DDS_IMU_PUB_ENABLED
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+#include "ardupilot_msgs/msg/ImuBatch.h"
+#endif // AP_DDS_IMU_BATCH_PUB_ENABLED
 #if AP_DDS_STATUS_PUB_ENABLED
 #include "ardupilot_msgs/msg/Status.h"
 #endif // AP_DDS_STATUS_PUB_ENABLED
@@ -116,6 +119,11 @@ private:
     //! @brief Serialize the current gps global origin and publish to the IO stream(s)
     void write_gps_global_origin_topic();
     static void update_topic(geographic_msgs_msg_GeoPointStamped& msg);
+    //! @brief Check whether the origin differs from the one last published, or the keepalive is due
+    bool gps_global_origin_changed(const geographic_msgs_msg_GeoPointStamped& msg, uint64_t now_ms);
+    geographic_msgs_msg_GeoPointStamped prev_gps_global_origin_msg;
+    // The last ms timestamp AP_DDS actually published a gps global origin message
+    uint64_t last_gps_global_origin_publish_ms;
 # endif // AP_DDS_GPS_GLOBAL_ORIGIN_PUB_ENABLED
 
 #if AP_DDS_GOAL_PUB_ENABLED
@@ -180,6 +188,18 @@ private:
     //! @brief Serialize the current nav_sat_fix state and publish it to the IO stream(s)
     void write_battery_state_topic();
     static void update_topic(sensor_msgs_msg_BatteryState& msg, const uint8_t instance);
+    //! @brief Check whether a battery state differs from the one last published, or the keepalive is due
+    bool battery_state_changed(const sensor_msgs_msg_BatteryState& msg, const uint8_t instance, uint64_t now_ms);
+    // The battery values last published for each instance
+    struct {
+        float voltage;
+        float current;
+        float percentage;
+        uint8_t power_supply_status;
+        uint8_t power_supply_health;
+        bool present;
+        uint64_t publish_ms;
+    } prev_battery_state[AP_BATT_MONITOR_MAX_INSTANCES];
 #endif // AP_DDS_BATTERY_STATE_PUB_ENABLED
 
 #if AP_DDS_NAVSATFIX_PUB_ENABLED
@@ -200,6 +220,19 @@ private:
     void write_imu_topic();
 #endif // AP_DDS_IMU_PUB_ENABLED
 
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+    ardupilot_msgs_msg_ImuBatch imu_batch_topic;
+    // Sensor time in microseconds of the first sample in imu_batch_topic
+    uint64_t imu_batch_first_us;
+    // True once AP_InertialSensor is queueing samples for us
+    bool imu_batch_stream_enabled;
+    //! @brief Add queued IMU samples to the batch
+    //! @return True if the batch is ready to publish
+    bool update_topic_imu_batch(ardupilot_msgs_msg_ImuBatch& msg);
+    //! @brief Serialize the current IMU batch and publish to the IO stream(s)
+    void write_imu_batch_topic();
+#endif // AP_DDS_IMU_BATCH_PUB_ENABLED
+
 #if AP_DDS_CLOCK_PUB_ENABLED
     rosgraph_msgs_msg_Clock clock_topic;
     // The last ms timestamp AP_DDS wrote a Clock message
@@ -302,6 +335,23 @@ private:
         SocketAPM *socket;
     } udp;
 #endif
+    //! @brief Prepare the output stream for a topic of topic_size bytes, counting the bytes sent
+    //! @return True if the stream has room for the topic
+    bool prepare_output_stream(const uint8_t topic_index, ucdrBuffer& ub, const uint32_t topic_size);
+
+    //! @brief Check whether a topic published at rate_hz is due, updating last_ms if so
+    static bool publish_due(const AP_Int16& rate_hz, uint64_t& last_ms, const uint64_t now_ms);
+
+    // per-topic traffic since the last bandwidth report
+    static constexpr uint8_t max_topics = 24;
+    struct {
+        uint32_t bytes;
+        uint16_t msgs;
+    } topic_stats[max_topics];
+    uint64_t last_topic_stats_ms;
+    //! @brief Log the traffic of each topic once per second
+    void update_topic_stats(const uint64_t now_ms);
+
     // pointer to transport's communication structure
     uxrCommunication *comm{nullptr};
 
@@ -346,6 +396,45 @@ public:
     //! @brief Maximum number of attempts to ping the XRCE agent before exiting
     AP_Int8 ping_max_retry;
 
+    //! @brief Publish rates of the periodic topics in Hz, 0 disables a topic
+    struct {
+#if AP_DDS_TIME_PUB_ENABLED
+        AP_Int16 time;
+#endif
+#if AP_DDS_BATTERY_STATE_PUB_ENABLED
+        AP_Int16 battery_state;
+#endif
+#if AP_DDS_LOCAL_POSE_PUB_ENABLED
+        AP_Int16 local_pose;
+#endif
+#if AP_DDS_LOCAL_VEL_PUB_ENABLED
+        AP_Int16 local_velocity;
+#endif
+#if AP_DDS_AIRSPEED_PUB_ENABLED
+        AP_Int16 airspeed;
+#endif
+#if AP_DDS_RC_PUB_ENABLED
+        AP_Int16 rc;
+#endif
+#if AP_DDS_IMU_PUB_ENABLED
+        AP_Int16 imu;
+#endif
+#if AP_DDS_GEOPOSE_PUB_ENABLED
+        AP_Int16 geo_pose;
+#endif
+#if AP_DDS_CLOCK_PUB_ENABLED
+        AP_Int16 clock;
+#endif
+#if AP_DDS_GPS_GLOBAL_ORIGIN_PUB_ENABLED
+        AP_Int16 gps_global_origin;
+#endif
+    } rate_hz;
+
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+    //! @brief Number of IMU samples per ImuBatch message, 0 disables the topic
+    AP_Int8 imu_batch_size;
+#endif
+
     //! @brief Enum used to mark a topic as a data reader or writer
     enum class Topic_rw : uint8_t {
         DataReader = 0,
@@ -7,6 +7,9 @@
 #if AP_DDS_IMU_PUB_ENABLED
 #include "sensor_msgs/msg/Imu.h"
 #endif //AP_DDS_IMU_PUB_ENABLED
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+#include "ardupilot_msgs/msg/ImuBatch.h"
+#endif // AP_DDS_IMU_BATCH_PUB_ENABLED
 
 #include "uxr/client/client.h"
 
@@ -30,6 +33,9 @@ enum class TopicIndex: uint8_t {
 #if AP_DDS_IMU_PUB_ENABLED
     IMU_PUB,
 #endif //AP_DDS_IMU_PUB_ENABLED
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+    IMU_BATCH_PUB,
+#endif // AP_DDS_IMU_BATCH_PUB_ENABLED
 #if AP_DDS_LOCAL_POSE_PUB_ENABLED
     LOCAL_POSE_PUB,
 #endif // AP_DDS_LOCAL_POSE_PUB_ENABLED
@@ -169,6 +175,24 @@ constexpr struct AP_DDS_Client::Topic_table AP_DDS_Client::topics[] = {
         },
     },
 #endif //AP_DDS_IMU_PUB_ENABLED
+#if AP_DDS_IMU_BATCH_PUB_ENABLED
+    {
+        .topic_id = to_underlying(TopicIndex::IMU_BATCH_PUB),
+        .pub_id = to_underlying(TopicIndex::IMU_BATCH_PUB),
+        .sub_id = to_underlying(TopicIndex::IMU_BATCH_PUB),
+        .dw_id = uxrObjectId{.id=to_underlying(TopicIndex::IMU_BATCH_PUB), .type=UXR_DATAWRITER_ID},
+        .dr_id = uxrObjectId{.id=to_underlying(TopicIndex::IMU_BATCH_PUB), .type=UXR_DATAREADER_ID},
+        .topic_rw = Topic_rw::DataWriter,
+        .topic_name = "rt/ap/imu/experimental/batch",
+        .type_name = "ardupilot_msgs::msg::dds_::ImuBatch_",
+        .qos = {
+            .durability = UXR_DURABILITY_VOLATILE,
+            .reliability = UXR_RELIABILITY_BEST_EFFORT,
+            .history = UXR_HISTORY_KEEP_LAST,
+            .depth = 5,
+        },
+    },
+#endif // AP_DDS_IMU_BATCH_PUB_ENABLED
 #if AP_DDS_LOCAL_POSE_PUB_ENABLED
     {
         .topic_id = to_underlying(TopicIndex::LOCAL_POSE_PUB),
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <AP_BattMonitor/AP_BattMonitor_config.h>
 #include <AP_GPS/AP_GPS_config.h>
+#include <AP_InertialSensor/AP_InertialSensor_config.h>
 #include <AP_HAL/AP_HAL_Boards.h>
 #include <AP_Networking/AP_Networking_Config.h>
 #include <AP_VisualOdom/AP_VisualOdom_config.h>
@@ -34,6 +36,21 @@
 #define AP_DDS_DELAY_IMU_TOPIC_MS 5
 #endif
 
+// Batches of loop-rate IMU samples, with the sensor time of each sample
+#ifndef AP_DDS_IMU_BATCH_PUB_ENABLED
+#define AP_DDS_IMU_BATCH_PUB_ENABLED (AP_DDS_EXPERIMENTAL_ENABLED && AP_INERTIALSENSOR_SAMPLE_STREAM_ENABLED)
+#endif
+
+// Must not exceed the sequence bounds in ardupilot_msgs/msg/ImuBatch.idl
+#ifndef AP_DDS_IMU_BATCH_MAX_SAMPLES
+#define AP_DDS_IMU_BATCH_MAX_SAMPLES 16
+#endif
+
+// A partial batch is published once its first sample is this old
+#ifndef AP_DDS_IMU_BATCH_MAX_LATENCY_MS
+#define AP_DDS_IMU_BATCH_MAX_LATENCY_MS 20
+#endif
+
 #ifndef AP_DDS_TIME_PUB_ENABLED
 #define AP_DDS_TIME_PUB_ENABLED 1
 #endif
@@ -106,6 +123,12 @@
 #define AP_DDS_DELAY_BATTERY_STATE_TOPIC_MS 1000
 #endif
 
+// Slow topics that are only published when their content changes are
+// still re-sent at this interval so late joining subscribers receive them
+#ifndef AP_DDS_ONCHANGE_KEEPALIVE_MS
+#define AP_DDS_ONCHANGE_KEEPALIVE_MS 10000
+#endif
+
 #ifndef AP_DDS_DELAY_STATUS_TOPIC_MS
 #define AP_DDS_DELAY_STATUS_TOPIC_MS 100
 #endif
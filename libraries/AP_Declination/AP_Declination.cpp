@@ -33,6 +33,16 @@
   calculate magnetic field intensity and orientation
 */
 bool AP_Declination::get_mag_field_ef(float latitude_deg, float longitude_deg, float &intensity_gauss, float &declination_deg, float &inclination_deg)
+{
+    Cache cache;
+    return cache.get_mag_field_ef(latitude_deg, longitude_deg, intensity_gauss, declination_deg, inclination_deg);
+}
+
+/*
+  calculate magnetic field intensity and orientation, reloading the
+  cell corners only when the point has moved to another cell
+*/
+bool AP_Declination::Cache::get_mag_field_ef(float latitude_deg, float longitude_deg, float &intensity_gauss, float &declination_deg, float &inclination_deg)
 {
     bool valid_input_data = true;
 
@@ -67,55 +77,74 @@ bool AP_Declination::get_mag_field_ef(float latitude_deg, float longitude_deg, f
     }
 
     /* find index of nearest low sampling point */
-    uint32_t min_lat_index = constrain_int32(static_cast<uint32_t>((-(SAMPLING_MIN_LAT) + min_lat)  / SAMPLING_RES), 0, LAT_TABLE_SIZE - 2);
-    uint32_t min_lon_index = constrain_int32(static_cast<uint32_t>((-(SAMPLING_MIN_LON) + min_lon) / SAMPLING_RES), 0, LON_TABLE_SIZE -2);
-
-    /* calculate intensity */
-
-    float data_sw = intensity_table[min_lat_index][min_lon_index];
-    float data_se = intensity_table[min_lat_index][min_lon_index + 1];
-    float data_ne = intensity_table[min_lat_index + 1][min_lon_index + 1];
-    float data_nw = intensity_table[min_lat_index + 1][min_lon_index];
-
-    /* perform bilinear interpolation on the four grid corners */
-
-    float data_min = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_se - data_sw) + data_sw;
-    float data_max = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_ne - data_nw) + data_nw;
-
-    intensity_gauss = ((latitude_deg - min_lat) / SAMPLING_RES) * (data_max - data_min) + data_min;
-
-    /* calculate declination */
+    const uint8_t min_lat_index = constrain_int32(static_cast<uint32_t>((-(SAMPLING_MIN_LAT) + min_lat)  / SAMPLING_RES), 0, LAT_TABLE_SIZE - 2);
+    const uint8_t min_lon_index = constrain_int32(static_cast<uint32_t>((-(SAMPLING_MIN_LON) + min_lon) / SAMPLING_RES), 0, LON_TABLE_SIZE -2);
 
-    data_sw = declination_table[min_lat_index][min_lon_index];
-    data_se = declination_table[min_lat_index][min_lon_index + 1];
-    data_ne = declination_table[min_lat_index + 1][min_lon_index + 1];
-    data_nw = declination_table[min_lat_index + 1][min_lon_index];
+    if (min_lat_index != lat_index || min_lon_index != lon_index) {
+        load_cell(min_lat_index, min_lon_index);
+    }
 
     /* perform bilinear interpolation on the four grid corners */
+    const float lat_frac = (latitude_deg - min_lat) / SAMPLING_RES;
+    const float lon_frac = (longitude_deg - min_lon) / SAMPLING_RES;
 
-    data_min = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_se - data_sw) + data_sw;
-    data_max = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_ne - data_nw) + data_nw;
-
-    declination_deg = ((latitude_deg - min_lat) / SAMPLING_RES) * (data_max - data_min) + data_min;
+    intensity_gauss = interpolate(intensity, lat_frac, lon_frac);
+    declination_deg = interpolate(declination, lat_frac, lon_frac);
+    inclination_deg = interpolate(inclination, lat_frac, lon_frac);
 
-    /* calculate inclination */
+    return valid_input_data;
+}
 
-    data_sw = inclination_table[min_lat_index][min_lon_index];
-    data_se = inclination_table[min_lat_index][min_lon_index + 1];
-    data_ne = inclination_table[min_lat_index + 1][min_lon_index + 1];
-    data_nw = inclination_table[min_lat_index + 1][min_lon_index];
+/*
+  load the corner values of a cell from the tables
+*/
+void AP_Declination::Cache::load_cell(uint8_t _lat_index, uint8_t _lon_index)
+{
+    const struct {
+        const int16_t (&table)[LAT_TABLE_SIZE][LON_TABLE_SIZE];
+        float scale;
+        corners &c;
+    } tables[] {
+        { intensity_table, INTENSITY_SCALE, intensity },
+        { declination_table, ANGLE_SCALE, declination },
+        { inclination_table, ANGLE_SCALE, inclination },
+    };
+    for (const auto &t : tables) {
+        t.c.sw = t.table[_lat_index][_lon_index] * t.scale;
+        t.c.se = t.table[_lat_index][_lon_index + 1] * t.scale;
+        t.c.ne = t.table[_lat_index + 1][_lon_index + 1] * t.scale;
+        t.c.nw = t.table[_lat_index + 1][_lon_index] * t.scale;
+    }
+    lat_index = _lat_index;
+    lon_index = _lon_index;
+}
 
-    /* perform bilinear interpolation on the four grid corners */
+float AP_Declination::Cache::interpolate(const corners &c, float lat_frac, float lon_frac)
+{
+    const float data_min = lon_frac * (c.se - c.sw) + c.sw;
+    const float data_max = lon_frac * (c.ne - c.nw) + c.nw;
+    return lat_frac * (data_max - data_min) + data_min;
+}
 
-    data_min = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_se - data_sw) + data_sw;
-    data_max = ((longitude_deg - min_lon) / SAMPLING_RES) * (data_ne - data_nw) + data_nw;
+/*
+  get earth field as a Vector3f in Gauss and the declination in
+  degrees given a Location
+*/
+Vector3f AP_Declination::Cache::get_earth_field_ga(const Location &loc, float &declination_deg)
+{
+    float inclination_deg=0, intensity_gauss=0;
+    declination_deg = 0;
+    get_mag_field_ef(loc.lat*1.0e-7f, loc.lng*1.0e-7f, intensity_gauss, declination_deg, inclination_deg);
 
-    inclination_deg = ((latitude_deg - min_lat) / SAMPLING_RES) * (data_max - data_min) + data_min;
+    // create earth field
+    Vector3f mag_ef = Vector3f(intensity_gauss, 0.0, 0.0);
+    Matrix3f R;
 
-    return valid_input_data;
+    R.from_euler(0.0f, -radians(inclination_deg), radians(declination_deg));
+    mag_ef = R * mag_ef;
+    return mag_ef;
 }
 
-
 /*
  calculate magnetic field intensity and orientation
 */
@@ -133,14 +162,7 @@ float AP_Declination::get_declination(float latitude_deg, float longitude_deg)
 */
 Vector3f AP_Declination::get_earth_field_ga(const Location &loc)
 {
-    float declination_deg=0, inclination_deg=0, intensity_gauss=0;
-    get_mag_field_ef(loc.lat*1.0e-7f, loc.lng*1.0e-7f, intensity_gauss, declination_deg, inclination_deg);
-
-    // create earth field
-    Vector3f mag_ef = Vector3f(intensity_gauss, 0.0, 0.0);
-    Matrix3f R;
-
-    R.from_euler(0.0f, -radians(inclination_deg), radians(declination_deg));
-    mag_ef = R * mag_ef;
-    return mag_ef;
+    Cache cache;
+    float declination_deg;
+    return cache.get_earth_field_ga(loc, declination_deg);
 }
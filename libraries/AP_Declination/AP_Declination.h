@@ -27,8 +27,37 @@ public:
       get declination in degrees for a given latitude_deg and longitude_deg
      */
     static float get_declination(float latitude_deg, float longitude_deg);
-    
+
+    /*
+      field lookups that keep the corner values of the last table
+      cell used, so repeated lookups at nearby points only
+      interpolate
+     */
+    class Cache {
+    public:
+        // as AP_Declination::get_mag_field_ef()
+        bool get_mag_field_ef(float latitude_deg, float longitude_deg, float &intensity_gauss, float &declination_deg, float &inclination_deg);
+
+        // earth field in Gauss, and the declination in degrees, given a Location
+        Vector3f get_earth_field_ga(const Location &loc, float &declination_deg);
+
+    private:
+        // corners of the cell, south-west, south-east, north-east, north-west
+        struct corners {
+            float sw, se, ne, nw;
+        } intensity, declination, inclination;
+        uint8_t lat_index = UINT8_MAX;
+        uint8_t lon_index = UINT8_MAX;
+
+        void load_cell(uint8_t _lat_index, uint8_t _lon_index);
+        static float interpolate(const corners &c, float lat_frac, float lon_frac);
+    };
+
 private:
+    // table units
+    static constexpr float ANGLE_SCALE = 0.01f;         // degrees
+    static constexpr float INTENSITY_SCALE = 1.0e-4f;   // Gauss
+
     static const float SAMPLING_RES;
     static const float SAMPLING_MIN_LAT;
     static const float SAMPLING_MAX_LAT;
@@ -38,7 +67,8 @@ private:
     static const uint32_t LAT_TABLE_SIZE = 19;
     static const uint32_t LON_TABLE_SIZE = 37;
 
-    static const float declination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE];
-    static const float inclination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE];
-    static const float intensity_table[LAT_TABLE_SIZE][LON_TABLE_SIZE];
+    // packed tables, angles in ANGLE_SCALE and intensity in INTENSITY_SCALE units
+    static const int16_t declination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE];
+    static const int16_t inclination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE];
+    static const int16_t intensity_table[LAT_TABLE_SIZE][LON_TABLE_SIZE];
 };
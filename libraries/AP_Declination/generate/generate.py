@@ -24,14 +24,18 @@ if not Path("AP_Declination.h").is_file():
     raise OSError("Please run this tool from the AP_Declination directory")
 
 
-def write_table(f,name, table):
-    '''write one table'''
-    f.write("__EXTFLASHFUNC__ const float AP_Declination::%s[%u][%u] = {\n" %
+# table units, must match AP_Declination.h
+ANGLE_SCALE = 0.01
+INTENSITY_SCALE = 1.0e-4
+
+def write_table(f,name, table, scale):
+    '''write one table as int16 in units of scale'''
+    f.write("__EXTFLASHFUNC__ const int16_t AP_Declination::%s[%u][%u] = {\n" %
                 (name, NUM_LAT, NUM_LON))
     for i in range(NUM_LAT):
         f.write("    {")
         for j in range(NUM_LON):
-            f.write("%.5ff" % table[i][j])
+            f.write("%d" % int(round(table[i][j] / scale)))
             if j != NUM_LON-1:
                 f.write(",")
         f.write("}")
@@ -158,6 +162,11 @@ for i,lat in enumerate(lats):
         inclination_table[i][j] = mag[1]
         intensity_table[i][j] = mag[2]
 
+# check the error against the values as stored
+declination_table = np.round(declination_table / ANGLE_SCALE) * ANGLE_SCALE
+inclination_table = np.round(inclination_table / ANGLE_SCALE) * ANGLE_SCALE
+intensity_table = np.round(intensity_table / INTENSITY_SCALE) * INTENSITY_SCALE
+
 with open(args.filename, 'w') as f:
     f.write('''// this is an auto-generated file from the IGRF tables. Do not edit
 // To re-generate run generate/generate.py
@@ -179,9 +188,9 @@ const float AP_Declination::SAMPLING_MAX_LON = %u;
            SAMPLING_MAX_LON))
 
 
-    write_table(f,'declination_table', declination_table)
-    write_table(f,'inclination_table', inclination_table)
-    write_table(f,'intensity_table', intensity_table)
+    write_table(f,'declination_table', declination_table, ANGLE_SCALE)
+    write_table(f,'inclination_table', inclination_table, ANGLE_SCALE)
+    write_table(f,'intensity_table', intensity_table, INTENSITY_SCALE)
 
 if args.check_error:
     print("Checking for maximum error")
@@ -9,69 +9,69 @@ const float AP_Declination::SAMPLING_MAX_LAT = 90;
 const float AP_Declination::SAMPLING_MIN_LON = -180;
 const float AP_Declination::SAMPLING_MAX_LON = 180;
 
-__EXTFLASHFUNC__ const float AP_Declination::declination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE] = {
-    {148.83402f,138.83401f,128.83401f,118.83402f,108.83402f,98.83402f,88.83402f,78.83402f,68.83402f,58.83402f,48.83402f,38.83402f,28.83402f,18.83402f,8.83402f,-1.16598f,-11.16598f,-21.16598f,-31.16598f,-41.16598f,-51.16598f,-61.16598f,-71.16598f,-81.16598f,-91.16598f,-101.16598f,-111.16598f,-121.16598f,-131.16598f,-141.16598f,-151.16598f,-161.16598f,-171.16598f,178.83402f,168.83402f,158.83402f,148.83402f},
-    {129.09306f,116.89412f,105.78898f,95.63017f,86.23504f,77.42476f,69.04348f,60.96591f,53.09841f,45.37592f,37.75568f,30.20867f,22.70998f,15.23027f,7.73037f,0.16098f,-7.53238f,-15.40109f,-23.48496f,-31.80703f,-40.37375f,-49.18062f,-58.22152f,-67.49946f,-77.03640f,-86.88079f,-97.11212f,-107.84156f,-119.20626f,-131.35191f,-144.39481f,-158.35719f,-173.08769f,171.78274f,156.78187f,142.43310f,129.09306f},
-    {85.81367f,77.83602f,71.40003f,65.88433f,60.88263f,56.08204f,51.22755f,46.12774f,40.67419f,34.85457f,28.74909f,22.50583f,16.29363f,10.23812f,4.36029f,-1.45095f,-7.40778f,-13.74178f,-20.61213f,-28.04922f,-35.95530f,-44.15322f,-52.45486f,-60.71951f,-68.88732f,-76.99183f,-85.16746f,-93.67473f,-102.97950f,-113.96429f,-128.46293f,-150.36073f,175.55488f,138.00554f,112.28051f,96.48319f,85.81367f},
-    {48.22805f,46.81921f,45.24300f,43.71189f,42.27245f,40.80022f,39.00177f,36.49549f,32.95972f,28.26545f,22.54379f,16.18846f,9.77818f,3.88971f,-1.16066f,-5.50500f,-9.68832f,-14.40052f,-20.13990f,-26.99385f,-34.63319f,-42.50584f,-50.08478f,-57.00760f,-63.07978f,-68.20773f,-72.30336f,-75.14845f,-76.14220f,-73.56875f,-61.46573f,-19.66028f,28.39616f,43.98783f,48.35027f,49.03265f,48.22805f},
-    {31.42931f,31.60530f,31.28145f,30.79047f,30.38024f,30.16777f,29.97487f,29.25597f,27.27948f,23.46202f,17.66378f,10.37176f,2.68673f,-4.06559f,-9.01317f,-12.19989f,-14.47861f,-17.04830f,-21.00672f,-26.83158f,-33.98769f,-41.32654f,-47.85214f,-52.97945f,-56.36644f,-57.72068f,-56.62201f,-52.29959f,-43.64045f,-30.08348f,-13.41611f,2.35315f,14.41455f,22.53506f,27.54777f,30.28028f,31.42931f},
-    {22.67985f,23.21169f,23.25494f,22.99742f,22.63545f,22.42369f,22.46877f,22.43187f,21.42571f,18.33186f,12.46440f,4.21692f,-4.75068f,-12.30560f,-17.22721f,-19.74039f,-20.77499f,-21.16946f,-22.14607f,-25.39336f,-31.01102f,-37.19196f,-42.26227f,-45.34969f,-45.95366f,-43.77299f,-38.67388f,-30.72261f,-20.87969f,-11.16390f,-2.84711f,4.17466f,10.15622f,15.07307f,18.83144f,21.33469f,22.67985f},
-    {17.07334f,17.59062f,17.77934f,17.69577f,17.34929f,16.88674f,16.56217f,16.38656f,15.63204f,12.86517f,6.93562f,-1.75751f,-10.98436f,-18.20308f,-22.41588f,-24.27993f,-24.67590f,-23.50719f,-21.00605f,-19.72369f,-21.87960f,-26.21214f,-30.23195f,-32.25069f,-31.49417f,-28.07385f,-22.58093f,-15.67611f,-8.73630f,-3.38117f,0.43868f,3.90117f,7.49078f,10.92679f,13.85484f,15.93237f,17.07334f},
-    {13.37426f,13.67217f,13.78744f,13.78998f,13.54222f,12.98780f,12.38852f,11.96065f,11.09372f,8.25499f,2.21162f,-6.34723f,-14.82596f,-20.89032f,-23.89434f,-24.45752f,-23.26867f,-20.14461f,-15.21492f,-10.62227f,-9.09952f,-11.18829f,-14.91638f,-17.58833f,-17.75073f,-15.65321f,-12.03643f,-7.38772f,-2.92537f,-0.15156f,1.30857f,3.04660f,5.56513f,8.30463f,10.76538f,12.51642f,13.37426f},
-    {11.10969f,11.11944f,11.01236f,10.99728f,10.84097f,10.32286f,9.70494f,9.19687f,8.09157f,4.94277f,-1.12864f,-9.05484f,-16.32980f,-21.04376f,-22.55109f,-21.19496f,-17.89373f,-13.44411f,-8.58084f,-4.24867f,-1.62827f,-1.86509f,-4.55045f,-7.42469f,-8.64775f,-8.12536f,-6.32716f,-3.48850f,-0.64489f,0.72027f,0.97976f,1.90952f,4.01623f,6.51266f,8.80749f,10.44185f,11.10969f},
-    {9.88349f,9.72040f,9.41289f,9.38439f,9.33291f,8.89921f,8.31537f,7.68011f,6.17272f,2.60695f,-3.33977f,-10.37899f,-16.38823f,-19.72660f,-19.70115f,-16.80477f,-12.41185f,-7.91607f,-4.15177f,-1.10381f,1.22204f,1.82879f,0.23517f,-2.13784f,-3.62813f,-3.94630f,-3.34494f,-1.85961f,-0.22644f,0.26762f,-0.08803f,0.44077f,2.38763f,4.89878f,7.32401f,9.15291f,9.88349f},
-    {9.12464f,9.18177f,8.94457f,9.04553f,9.19618f,8.89744f,8.21223f,7.14260f,4.96349f,0.86055f,-4.97931f,-11.14357f,-15.85640f,-17.78532f,-16.57645f,-13.08478f,-8.67898f,-4.59243f,-1.60427f,0.55144f,2.39028f,3.23916f,2.31654f,0.46434f,-0.91732f,-1.53003f,-1.62589f,-1.18564f,-0.62403f,-0.86624f,-1.66562f,-1.50145f,0.21812f,2.79294f,5.56329f,7.91823f,9.12464f},
-    {8.06290f,8.93172f,9.29767f,9.81684f,10.30693f,10.20311f,9.30721f,7.53634f,4.41412f,-0.45099f,-6.41113f,-11.85029f,-15.25565f,-15.88209f,-13.96742f,-10.49677f,-6.46933f,-2.75504f,-0.08743f,1.66921f,3.12874f,3.96903f,3.45981f,2.05876f,0.88578f,0.20951f,-0.29117f,-0.68669f,-1.18101f,-2.27487f,-3.63054f,-3.95562f,-2.62221f,-0.08793f,3.01927f,6.01454f,8.06290f},
-    {6.31041f,8.41617f,9.93058f,11.21483f,12.13996f,12.23034f,11.14011f,8.66524f,4.49928f,-1.34733f,-7.71989f,-12.71272f,-15.08305f,-14.75641f,-12.45343f,-9.09705f,-5.35725f,-1.83470f,0.82823f,2.57001f,3.86519f,4.69588f,4.60243f,3.76104f,2.87601f,2.13967f,1.24833f,0.02788f,-1.62859f,-3.80231f,-5.90990f,-6.79346f,-5.87079f,-3.45535f,-0.15720f,3.34006f,6.31041f},
-    {4.26294f,7.59975f,10.43666f,12.70491f,14.16020f,14.43398f,13.18770f,10.10768f,4.90586f,-2.08386f,-9.15208f,-14.09196f,-15.93051f,-15.08268f,-12.51517f,-9.09089f,-5.35759f,-1.77919f,1.14514f,3.24292f,4.77489f,5.90082f,6.46683f,6.42854f,5.95440f,5.04613f,3.49019f,1.14215f,-1.96091f,-5.46021f,-8.43365f,-9.79880f,-9.13330f,-6.77311f,-3.34752f,0.50970f,4.26294f},
-    {2.57464f,6.81988f,10.72127f,13.95370f,16.10049f,16.72460f,15.39548f,11.64478f,5.15172f,-3.36781f,-11.49173f,-16.72206f,-18.40831f,-17.31430f,-14.50140f,-10.79977f,-6.74992f,-2.76545f,0.78143f,3.70100f,6.08013f,8.07892f,9.67963f,10.67456f,10.77058f,9.65347f,7.07600f,3.02043f,-2.09809f,-7.27683f,-11.16806f,-12.81861f,-12.13043f,-9.62141f,-5.97603f,-1.77704f,2.57464f},
-    {1.43503f,6.27921f,10.88019f,14.88261f,17.80063f,19.02158f,17.77297f,13.12636f,4.53718f,-6.54055f,-16.27050f,-21.85552f,-23.31365f,-21.85455f,-18.61101f,-14.36797f,-9.64057f,-4.79964f,-0.13239f,4.18385f,8.10605f,11.64519f,14.70734f,16.97990f,17.92977f,16.88820f,13.23164f,6.81146f,-1.34665f,-8.97876f,-14.01257f,-15.81005f,-14.85926f,-12.00033f,-7.99733f,-3.40265f,1.43502f},
-    {0.13094f,5.45479f,10.54962f,15.08235f,18.55436f,20.17754f,18.67574f,12.20150f,-0.36226f,-15.49225f,-26.46004f,-31.19380f,-31.33251f,-28.66356f,-24.33699f,-19.03627f,-13.18344f,-7.06335f,-0.88475f,5.19490f,11.05071f,16.55252f,21.50321f,25.56424f,28.16988f,28.41286f,24.95220f,16.43585f,3.63861f,-8.67079f,-16.18909f,-18.69045f,-17.68753f,-14.54612f,-10.18137f,-5.16795f,0.13094f},
-    {-4.14830f,1.12345f,5.96040f,9.84415f,11.94596f,10.80871f,4.02869f,-10.36405f,-27.94912f,-39.79617f,-44.16477f,-43.57950f,-40.12657f,-34.99189f,-28.83083f,-22.02403f,-14.80922f,-7.34799f,0.23881f,7.85050f,15.39197f,22.75942f,29.82156f,36.38924f,42.15868f,46.59144f,48.63821f,46.09967f,34.72041f,12.13936f,-8.98865f,-18.65098f,-20.47841f,-18.40133f,-14.39834f,-9.45818f,-4.14830f},
-    {-169.79948f,-159.79948f,-149.79948f,-139.79948f,-129.79948f,-119.79948f,-109.79948f,-99.79948f,-89.79948f,-79.79948f,-69.79948f,-59.79948f,-49.79948f,-39.79948f,-29.79948f,-19.79948f,-9.79948f,0.20052f,10.20052f,20.20052f,30.20052f,40.20052f,50.20052f,60.20052f,70.20052f,80.20052f,90.20052f,100.20052f,110.20052f,120.20052f,130.20052f,140.20052f,150.20052f,160.20052f,170.20052f,-179.79948f,-169.79948f}
+__EXTFLASHFUNC__ const int16_t AP_Declination::declination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE] = {
+    {14883,13883,12883,11883,10883,9883,8883,7883,6883,5883,4883,3883,2883,1883,883,-117,-1117,-2117,-3117,-4117,-5117,-6117,-7117,-8117,-9117,-10117,-11117,-12117,-13117,-14117,-15117,-16117,-17117,17883,16883,15883,14883},
+    {12909,11689,10579,9563,8624,7742,6904,6097,5310,4538,3776,3021,2271,1523,773,16,-753,-1540,-2348,-3181,-4037,-4918,-5822,-6750,-7704,-8688,-9711,-10784,-11921,-13135,-14439,-15836,-17309,17178,15678,14243,12909},
+    {8581,7784,7140,6588,6088,5608,5123,4613,4067,3485,2875,2251,1629,1024,436,-145,-741,-1374,-2061,-2805,-3596,-4415,-5245,-6072,-6889,-7699,-8517,-9367,-10298,-11396,-12846,-15036,17555,13801,11228,9648,8581},
+    {4823,4682,4524,4371,4227,4080,3900,3650,3296,2827,2254,1619,978,389,-116,-550,-969,-1440,-2014,-2699,-3463,-4251,-5008,-5701,-6308,-6821,-7230,-7515,-7614,-7357,-6147,-1966,2840,4399,4835,4903,4823},
+    {3143,3161,3128,3079,3038,3017,2997,2926,2728,2346,1766,1037,269,-407,-901,-1220,-1448,-1705,-2101,-2683,-3399,-4133,-4785,-5298,-5637,-5772,-5662,-5230,-4364,-3008,-1342,235,1441,2254,2755,3028,3143},
+    {2268,2321,2325,2300,2264,2242,2247,2243,2143,1833,1246,422,-475,-1231,-1723,-1974,-2077,-2117,-2215,-2539,-3101,-3719,-4226,-4535,-4595,-4377,-3867,-3072,-2088,-1116,-285,417,1016,1507,1883,2133,2268},
+    {1707,1759,1778,1770,1735,1689,1656,1639,1563,1287,694,-176,-1098,-1820,-2242,-2428,-2468,-2351,-2101,-1972,-2188,-2621,-3023,-3225,-3149,-2807,-2258,-1568,-874,-338,44,390,749,1093,1385,1593,1707},
+    {1337,1367,1379,1379,1354,1299,1239,1196,1109,825,221,-635,-1483,-2089,-2389,-2446,-2327,-2014,-1521,-1062,-910,-1119,-1492,-1759,-1775,-1565,-1204,-739,-293,-15,131,305,557,830,1077,1252,1337},
+    {1111,1112,1101,1100,1084,1032,970,920,809,494,-113,-905,-1633,-2104,-2255,-2119,-1789,-1344,-858,-425,-163,-187,-455,-742,-865,-813,-633,-349,-64,72,98,191,402,651,881,1044,1111},
+    {988,972,941,938,933,890,832,768,617,261,-334,-1038,-1639,-1973,-1970,-1680,-1241,-792,-415,-110,122,183,24,-214,-363,-395,-334,-186,-23,27,-9,44,239,490,732,915,988},
+    {912,918,894,905,920,890,821,714,496,86,-498,-1114,-1586,-1779,-1658,-1308,-868,-459,-160,55,239,324,232,46,-92,-153,-163,-119,-62,-87,-167,-150,22,279,556,792,912},
+    {806,893,930,982,1031,1020,931,754,441,-45,-641,-1185,-1526,-1588,-1397,-1050,-647,-276,-9,167,313,397,346,206,89,21,-29,-69,-118,-227,-363,-396,-262,-9,302,601,806},
+    {631,842,993,1121,1214,1223,1114,867,450,-135,-772,-1271,-1508,-1476,-1245,-910,-536,-183,83,257,387,470,460,376,288,214,125,3,-163,-380,-591,-679,-587,-346,-16,334,631},
+    {426,760,1044,1270,1416,1443,1319,1011,491,-208,-915,-1409,-1593,-1508,-1252,-909,-536,-178,115,324,477,590,647,643,595,505,349,114,-196,-546,-843,-980,-913,-677,-335,51,426},
+    {257,682,1072,1395,1610,1672,1540,1164,515,-337,-1149,-1672,-1841,-1731,-1450,-1080,-675,-277,78,370,608,808,968,1067,1077,965,708,302,-210,-728,-1117,-1282,-1213,-962,-598,-178,257},
+    {144,628,1088,1488,1780,1902,1777,1313,454,-654,-1627,-2186,-2331,-2185,-1861,-1437,-964,-480,-13,418,811,1165,1471,1698,1793,1689,1323,681,-135,-898,-1401,-1581,-1486,-1200,-800,-340,144},
+    {13,545,1055,1508,1855,2018,1868,1220,-36,-1549,-2646,-3119,-3133,-2866,-2434,-1904,-1318,-706,-88,519,1105,1655,2150,2556,2817,2841,2495,1644,364,-867,-1619,-1869,-1769,-1455,-1018,-517,13},
+    {-415,112,596,984,1195,1081,403,-1036,-2795,-3980,-4416,-4358,-4013,-3499,-2883,-2202,-1481,-735,24,785,1539,2276,2982,3639,4216,4659,4864,4610,3472,1214,-899,-1865,-2048,-1840,-1440,-946,-415},
+    {-16980,-15980,-14980,-13980,-12980,-11980,-10980,-9980,-8980,-7980,-6980,-5980,-4980,-3980,-2980,-1980,-980,20,1020,2020,3020,4020,5020,6020,7020,8020,9020,10020,11020,12020,13020,14020,15020,16020,17020,-17980,-16980}
 };
 
-__EXTFLASHFUNC__ const float AP_Declination::inclination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE] = {
-    {-72.02070f,-72.02071f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02070f,-72.02071f,-72.02070f,-72.02071f},
-    {-78.23208f,-77.46612f,-76.54604f,-75.51344f,-74.40408f,-73.25043f,-72.08420f,-70.93779f,-69.84384f,-68.83332f,-67.93241f,-67.15960f,-66.52407f,-66.02648f,-65.66205f,-65.42519f,-65.31392f,-65.33255f,-65.49161f,-65.80511f,-66.28626f,-66.94289f,-67.77395f,-68.76776f,-69.90201f,-71.14489f,-72.45664f,-73.79090f,-75.09549f,-76.31306f,-77.38240f,-78.24183f,-78.83644f,-79.12876f,-79.10879f,-78.79618f,-78.23208f},
-    {-80.80007f,-78.97830f,-77.14756f,-75.29021f,-73.38193f,-71.40769f,-69.37743f,-67.33857f,-65.37896f,-63.61481f,-62.16302f,-61.10460f,-60.45316f,-60.14557f,-60.06470f,-60.08698f,-60.13217f,-60.19219f,-60.32958f,-60.65151f,-61.27183f,-62.27481f,-63.69257f,-65.50302f,-67.64474f,-70.03800f,-72.60073f,-75.25455f,-77.92173f,-80.51496f,-82.91263f,-84.88736f,-85.95658f,-85.63251f,-84.30522f,-82.60297f,-80.80007f},
-    {-77.45516f,-75.43606f,-73.49604f,-71.57699f,-69.59653f,-67.45749f,-65.08505f,-62.48902f,-59.81600f,-57.35291f,-55.46368f,-54.46054f,-54.44855f,-55.23685f,-56.40404f,-57.49090f,-58.18917f,-58.42457f,-58.34278f,-58.24952f,-58.51231f,-59.42525f,-61.10217f,-63.46936f,-66.34503f,-69.53469f,-72.88656f,-76.29320f,-79.66218f,-82.88130f,-85.73520f,-87.38955f,-86.36194f,-84.15583f,-81.83294f,-79.58616f,-77.45517f},
-    {-71.58214f,-69.61565f,-67.71488f,-65.86479f,-64.01505f,-62.04510f,-59.77482f,-57.07400f,-54.02405f,-51.03212f,-48.80491f,-48.09823f,-49.26412f,-51.92460f,-55.16562f,-58.07793f,-60.10267f,-61.01513f,-60.84749f,-59.97822f,-59.15799f,-59.18575f,-60.45940f,-62.86069f,-65.97595f,-69.36736f,-72.71868f,-75.80268f,-78.35851f,-80.06262f,-80.67983f,-80.25871f,-79.08901f,-77.46953f,-75.59576f,-73.59787f,-71.58215f},
-    {-64.39807f,-62.40221f,-60.40960f,-58.42549f,-56.48151f,-54.55795f,-52.49863f,-50.03954f,-47.03044f,-43.80319f,-41.39118f,-41.16169f,-43.78688f,-48.51954f,-53.83971f,-58.60413f,-62.35170f,-64.81766f,-65.60605f,-64.62579f,-62.64650f,-61.08659f,-61.05364f,-62.68316f,-65.34905f,-68.24163f,-70.78236f,-72.62117f,-73.51797f,-73.52965f,-73.02048f,-72.24528f,-71.21594f,-69.88980f,-68.25886f,-66.38361f,-64.39807f},
-    {-55.02826f,-52.87120f,-50.69073f,-48.44731f,-46.19513f,-44.04849f,-42.00465f,-39.74123f,-36.79801f,-33.33110f,-30.77621f,-31.26765f,-35.68330f,-42.58861f,-49.78570f,-56.05256f,-61.22645f,-65.24992f,-67.52021f,-67.43115f,-65.26549f,-62.35447f,-60.45735f,-60.49007f,-61.96843f,-63.81210f,-65.26064f,-65.90429f,-65.53604f,-64.51130f,-63.52424f,-62.77292f,-61.94296f,-60.76846f,-59.16172f,-57.17787f,-55.02826f},
-    {-42.23934f,-39.72248f,-37.30606f,-34.84704f,-32.29950f,-29.84715f,-27.62882f,-25.25073f,-22.02346f,-18.13398f,-15.56621f,-17.09131f,-23.52381f,-32.78684f,-42.11183f,-49.91489f,-55.93881f,-60.34177f,-62.85919f,-63.04596f,-60.93631f,-57.41244f,-54.21948f,-52.82417f,-53.10885f,-54.02972f,-54.81946f,-54.92826f,-53.94911f,-52.38029f,-51.27875f,-50.79557f,-50.20937f,-49.05107f,-47.23568f,-44.84941f,-42.23934f},
-    {-25.31616f,-22.26353f,-19.64432f,-17.13765f,-14.48794f,-11.90452f,-9.56551f,-6.93532f,-3.35246f,0.62534f,2.69744f,0.20162f,-7.49683f,-18.49333f,-29.80260f,-38.99555f,-45.22087f,-48.81124f,-50.28975f,-49.88122f,-47.49942f,-43.57896f,-39.80201f,-37.81589f,-37.58213f,-38.12733f,-38.79073f,-38.91636f,-37.84560f,-36.15384f,-35.28930f,-35.35164f,-35.11620f,-33.90633f,-31.71407f,-28.67497f,-25.31616f},
-    {-5.22365f,-1.68002f,0.98130f,3.28459f,5.73141f,8.13291f,10.33797f,12.92226f,16.28019f,19.52644f,20.64919f,17.75076f,10.26968f,-0.68527f,-12.39654f,-21.81573f,-27.55757f,-29.98547f,-30.24089f,-29.18412f,-26.62224f,-22.51726f,-18.50023f,-16.36665f,-16.02599f,-16.47452f,-17.18522f,-17.56335f,-16.82114f,-15.49276f,-15.21405f,-16.04947f,-16.38744f,-15.33409f,-12.92178f,-9.31548f,-5.22365f},
-    {14.65727f,18.24457f,20.73560f,22.68750f,24.74090f,26.83478f,28.82717f,31.06453f,33.64927f,35.73650f,35.91607f,33.06931f,26.82267f,17.82545f,8.14938f,0.35249f,-4.22224f,-5.65846f,-5.08244f,-3.67265f,-1.30171f,2.36894f,6.00997f,7.96495f,8.31670f,8.01335f,7.45026f,6.96852f,7.19717f,7.76654f,7.31456f,5.77666f,4.68883f,5.07867f,7.05547f,10.50432f,14.65727f},
-    {31.00203f,34.03206f,36.22486f,37.93041f,39.71929f,41.67672f,43.64451f,45.63057f,47.51149f,48.64179f,48.13476f,45.46014f,40.64785f,34.34474f,27.90343f,22.77471f,19.78522f,19.08118f,19.96093f,21.39191f,23.28877f,25.96005f,28.61507f,30.09860f,30.42073f,30.29938f,30.04062f,29.74069f,29.65970f,29.53545f,28.53162f,26.62276f,24.91817f,24.37385f,25.31100f,27.72542f,31.00203f},
-    {43.33608f,45.45851f,47.28808f,48.92364f,50.69187f,52.68920f,54.75852f,56.70372f,58.24993f,58.87748f,58.03709f,55.61656f,52.01961f,47.93440f,44.13769f,41.24459f,39.61639f,39.39065f,40.22833f,41.47069f,42.89022f,44.59331f,46.23881f,47.24171f,47.57154f,47.63935f,47.66249f,47.62919f,47.50096f,47.00810f,45.71114f,43.68014f,41.65440f,40.38784f,40.27252f,41.37670f,43.33608f},
-    {53.10131f,54.36161f,55.82606f,57.45873f,59.32146f,61.39014f,63.50628f,65.43734f,66.85905f,67.31408f,66.44780f,64.38450f,61.68268f,58.96721f,56.68844f,55.08044f,54.25566f,54.24982f,54.89128f,55.82780f,56.83438f,57.87845f,58.85920f,59.59271f,60.06042f,60.40887f,60.71534f,60.90716f,60.81057f,60.15911f,58.74748f,56.73559f,54.64618f,53.02448f,52.20550f,52.28132f,53.10131f},
-    {61.90363f,62.59082f,63.73000f,65.25974f,67.10373f,69.13404f,71.16923f,72.97878f,74.24745f,74.58969f,73.79370f,72.08739f,69.99806f,68.01780f,66.44167f,65.38391f,64.86230f,64.84287f,65.21557f,65.80372f,66.46017f,67.12970f,67.80720f,68.49179f,69.18909f,69.89166f,70.52514f,70.92481f,70.86509f,70.14456f,68.73300f,66.86155f,64.92449f,63.29260f,62.20331f,61.74779f,61.90363f},
-    {70.57319f,70.97549f,71.81891f,73.05700f,74.60513f,76.33503f,78.07584f,79.60158f,80.60606f,80.76720f,79.99878f,78.58008f,76.92858f,75.37566f,74.11340f,73.22087f,72.70518f,72.52979f,72.62677f,72.91213f,73.31657f,73.81370f,74.42101f,75.17239f,76.07666f,77.07532f,78.01176f,78.63384f,78.66938f,77.98598f,76.70086f,75.10445f,73.50638f,72.14451f,71.16426f,70.63412f,70.57319f},
-    {78.82351f,79.06440f,79.60559f,80.41612f,81.44382f,82.60991f,83.79747f,84.82323f,85.41014f,85.29919f,84.52961f,83.39228f,82.15604f,80.99185f,79.99787f,79.22370f,78.68527f,78.37555f,78.27394f,78.35635f,78.60546f,79.01788f,79.60326f,80.37283f,81.31875f,82.38760f,83.44917f,84.26774f,84.54142f,84.12292f,83.18704f,82.03917f,80.91872f,79.97342f,79.28584f,78.89722f,78.82351f},
-    {85.92404f,85.99807f,86.21370f,86.55320f,86.98729f,87.46743f,87.90712f,88.15645f,88.05609f,87.61718f,86.98684f,86.28678f,85.58976f,84.94098f,84.37090f,83.90045f,83.54357f,83.30879f,83.20077f,83.22179f,83.37274f,83.65354f,84.06234f,84.59369f,85.23581f,85.96691f,86.74942f,87.51716f,88.14109f,88.39226f,88.15089f,87.63861f,87.08412f,86.59723f,86.22810f,86.00055f,85.92404f},
-    {88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f,88.21420f}
+__EXTFLASHFUNC__ const int16_t AP_Declination::inclination_table[LAT_TABLE_SIZE][LON_TABLE_SIZE] = {
+    {-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202,-7202},
+    {-7823,-7747,-7655,-7551,-7440,-7325,-7208,-7094,-6984,-6883,-6793,-6716,-6652,-6603,-6566,-6543,-6531,-6533,-6549,-6581,-6629,-6694,-6777,-6877,-6990,-7114,-7246,-7379,-7510,-7631,-7738,-7824,-7884,-7913,-7911,-7880,-7823},
+    {-8080,-7898,-7715,-7529,-7338,-7141,-6938,-6734,-6538,-6361,-6216,-6110,-6045,-6015,-6006,-6009,-6013,-6019,-6033,-6065,-6127,-6227,-6369,-6550,-6764,-7004,-7260,-7525,-7792,-8051,-8291,-8489,-8596,-8563,-8431,-8260,-8080},
+    {-7746,-7544,-7350,-7158,-6960,-6746,-6509,-6249,-5982,-5735,-5546,-5446,-5445,-5524,-5640,-5749,-5819,-5842,-5834,-5825,-5851,-5943,-6110,-6347,-6635,-6953,-7289,-7629,-7966,-8288,-8574,-8739,-8636,-8416,-8183,-7959,-7746},
+    {-7158,-6962,-6771,-6586,-6402,-6205,-5977,-5707,-5402,-5103,-4880,-4810,-4926,-5192,-5517,-5808,-6010,-6102,-6085,-5998,-5916,-5919,-6046,-6286,-6598,-6937,-7272,-7580,-7836,-8006,-8068,-8026,-7909,-7747,-7560,-7360,-7158},
+    {-6440,-6240,-6041,-5843,-5648,-5456,-5250,-5004,-4703,-4380,-4139,-4116,-4379,-4852,-5384,-5860,-6235,-6482,-6561,-6463,-6265,-6109,-6105,-6268,-6535,-6824,-7078,-7262,-7352,-7353,-7302,-7225,-7122,-6989,-6826,-6638,-6440},
+    {-5503,-5287,-5069,-4845,-4620,-4405,-4200,-3974,-3680,-3333,-3078,-3127,-3568,-4259,-4979,-5605,-6123,-6525,-6752,-6743,-6527,-6235,-6046,-6049,-6197,-6381,-6526,-6590,-6554,-6451,-6352,-6277,-6194,-6077,-5916,-5718,-5503},
+    {-4224,-3972,-3731,-3485,-3230,-2985,-2763,-2525,-2202,-1813,-1557,-1709,-2352,-3279,-4211,-4991,-5594,-6034,-6286,-6305,-6094,-5741,-5422,-5282,-5311,-5403,-5482,-5493,-5395,-5238,-5128,-5080,-5021,-4905,-4724,-4485,-4224},
+    {-2532,-2226,-1964,-1714,-1449,-1190,-957,-694,-335,63,270,20,-750,-1849,-2980,-3900,-4522,-4881,-5029,-4988,-4750,-4358,-3980,-3782,-3758,-3813,-3879,-3892,-3785,-3615,-3529,-3535,-3512,-3391,-3171,-2867,-2532},
+    {-522,-168,98,328,573,813,1034,1292,1628,1953,2065,1775,1027,-69,-1240,-2182,-2756,-2999,-3024,-2918,-2662,-2252,-1850,-1637,-1603,-1647,-1719,-1756,-1682,-1549,-1521,-1605,-1639,-1533,-1292,-932,-522},
+    {1466,1824,2074,2269,2474,2683,2883,3106,3365,3574,3592,3307,2682,1783,815,35,-422,-566,-508,-367,-130,237,601,796,832,801,745,697,720,777,731,578,469,508,706,1050,1466},
+    {3100,3403,3622,3793,3972,4168,4364,4563,4751,4864,4813,4546,4065,3434,2790,2277,1979,1908,1996,2139,2329,2596,2862,3010,3042,3030,3004,2974,2966,2954,2853,2662,2492,2437,2531,2773,3100},
+    {4334,4546,4729,4892,5069,5269,5476,5670,5825,5888,5804,5562,5202,4793,4414,4124,3962,3939,4023,4147,4289,4459,4624,4724,4757,4764,4766,4763,4750,4701,4571,4368,4165,4039,4027,4138,4334},
+    {5310,5436,5583,5746,5932,6139,6351,6544,6686,6731,6645,6438,6168,5897,5669,5508,5426,5425,5489,5583,5683,5788,5886,5959,6006,6041,6072,6091,6081,6016,5875,5674,5465,5302,5221,5228,5310},
+    {6190,6259,6373,6526,6710,6913,7117,7298,7425,7459,7379,7209,7000,6802,6644,6538,6486,6484,6522,6580,6646,6713,6781,6849,6919,6989,7053,7092,7087,7014,6873,6686,6492,6329,6220,6175,6190},
+    {7057,7098,7182,7306,7461,7634,7808,7960,8061,8077,8000,7858,7693,7538,7411,7322,7271,7253,7263,7291,7332,7381,7442,7517,7608,7708,7801,7863,7867,7799,7670,7510,7351,7214,7116,7063,7057},
+    {7882,7906,7961,8042,8144,8261,8380,8482,8541,8530,8453,8339,8216,8099,8000,7922,7869,7838,7827,7836,7861,7902,7960,8037,8132,8239,8345,8427,8454,8412,8319,8204,8092,7997,7929,7890,7882},
+    {8592,8600,8621,8655,8699,8747,8791,8816,8806,8762,8699,8629,8559,8494,8437,8390,8354,8331,8320,8322,8337,8365,8406,8459,8524,8597,8675,8752,8814,8839,8815,8764,8708,8660,8623,8600,8592},
+    {8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821,8821}
 };
 
-__EXTFLASHFUNC__ const float AP_Declination::intensity_table[LAT_TABLE_SIZE][LON_TABLE_SIZE] = {
-    {0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f,0.54507f},
-    {0.60562f,0.59923f,0.59133f,0.58213f,0.57184f,0.56070f,0.54892f,0.53679f,0.52458f,0.51262f,0.50121f,0.49067f,0.48128f,0.47330f,0.46697f,0.46249f,0.46006f,0.45986f,0.46203f,0.46665f,0.47372f,0.48312f,0.49460f,0.50778f,0.52217f,0.53717f,0.55217f,0.56652f,0.57964f,0.59102f,0.60027f,0.60715f,0.61152f,0.61342f,0.61294f,0.61026f,0.60562f},
-    {0.62993f,0.61663f,0.60163f,0.58513f,0.56721f,0.54792f,0.52741f,0.50597f,0.48417f,0.46274f,0.44252f,0.42424f,0.40840f,0.39524f,0.38483f,0.37722f,0.37262f,0.37149f,0.37444f,0.38211f,0.39496f,0.41303f,0.43591f,0.46271f,0.49220f,0.52288f,0.55321f,0.58160f,0.60660f,0.62705f,0.64217f,0.65166f,0.65569f,0.65477f,0.64966f,0.64113f,0.62993f},
-    {0.61859f,0.59954f,0.57951f,0.55859f,0.53652f,0.51281f,0.48703f,0.45921f,0.43010f,0.40125f,0.37460f,0.35184f,0.33383f,0.32034f,0.31043f,0.30313f,0.29816f,0.29624f,0.29887f,0.30789f,0.32478f,0.35003f,0.38290f,0.42162f,0.46385f,0.50716f,0.54918f,0.58755f,0.62009f,0.64502f,0.66138f,0.66918f,0.66921f,0.66276f,0.65127f,0.63614f,0.61859f},
-    {0.58434f,0.56134f,0.53820f,0.51511f,0.49174f,0.46715f,0.44010f,0.40984f,0.37699f,0.34382f,0.31364f,0.28967f,0.27359f,0.26453f,0.25966f,0.25610f,0.25262f,0.24997f,0.25053f,0.25779f,0.27518f,0.30435f,0.34417f,0.39141f,0.44206f,0.49253f,0.54000f,0.58194f,0.61593f,0.64015f,0.65395f,0.65794f,0.65353f,0.64245f,0.62626f,0.60641f,0.58434f},
-    {0.53921f,0.51448f,0.48995f,0.46595f,0.44250f,0.41888f,0.39359f,0.36521f,0.33366f,0.30097f,0.27115f,0.24895f,0.23726f,0.23477f,0.23677f,0.23885f,0.23920f,0.23803f,0.23691f,0.23986f,0.25296f,0.28060f,0.32245f,0.37391f,0.42855f,0.48085f,0.52753f,0.56643f,0.59562f,0.61429f,0.62316f,0.62341f,0.61626f,0.60311f,0.58508f,0.56327f,0.53921f},
-    {0.48785f,0.46379f,0.43988f,0.41636f,0.39367f,0.37182f,0.34998f,0.32674f,0.30099f,0.27346f,0.24780f,0.22959f,0.22251f,0.22507f,0.23198f,0.23916f,0.24558f,0.25057f,0.25278f,0.25389f,0.26060f,0.28058f,0.31692f,0.36595f,0.41928f,0.46891f,0.51065f,0.54231f,0.56238f,0.57214f,0.57493f,0.57236f,0.56426f,0.55095f,0.53309f,0.51149f,0.48785f},
-    {0.43209f,0.41089f,0.38995f,0.36941f,0.34979f,0.33155f,0.31470f,0.29826f,0.28044f,0.26067f,0.24164f,0.22828f,0.22418f,0.22862f,0.23770f,0.24867f,0.26122f,0.27397f,0.28296f,0.28650f,0.28895f,0.29863f,0.32271f,0.36133f,0.40653f,0.44908f,0.48374f,0.50731f,0.51774f,0.51826f,0.51530f,0.51075f,0.50252f,0.48985f,0.47321f,0.45336f,0.43209f},
-    {0.37890f,0.36283f,0.34739f,0.33271f,0.31922f,0.30724f,0.29696f,0.28780f,0.27809f,0.26658f,0.25432f,0.24439f,0.23994f,0.24247f,0.25117f,0.26398f,0.27930f,0.29517f,0.30771f,0.31403f,0.31546f,0.31823f,0.33068f,0.35590f,0.38846f,0.42051f,0.44683f,0.46322f,0.46680f,0.46142f,0.45465f,0.44832f,0.43950f,0.42721f,0.41228f,0.39568f,0.37890f},
-    {0.34114f,0.33192f,0.32348f,0.31616f,0.31061f,0.30672f,0.30410f,0.30225f,0.29980f,0.29492f,0.28700f,0.27755f,0.26956f,0.26653f,0.27083f,0.28123f,0.29446f,0.30791f,0.31935f,0.32678f,0.32987f,0.33216f,0.33985f,0.35562f,0.37648f,0.39779f,0.41572f,0.42632f,0.42691f,0.42012f,0.41134f,0.40209f,0.39087f,0.37775f,0.36429f,0.35181f,0.34114f},
-    {0.32818f,0.32516f,0.32319f,0.32283f,0.32517f,0.32980f,0.33535f,0.34062f,0.34397f,0.34296f,0.33615f,0.32475f,0.31211f,0.30265f,0.30010f,0.30443f,0.31265f,0.32241f,0.33228f,0.34067f,0.34700f,0.35327f,0.36224f,0.37416f,0.38773f,0.40158f,0.41356f,0.42060f,0.42076f,0.41455f,0.40362f,0.38928f,0.37303f,0.35700f,0.34334f,0.33369f,0.32818f},
-    {0.33981f,0.34000f,0.34266f,0.34809f,0.35721f,0.36937f,0.38240f,0.39400f,0.40180f,0.40293f,0.39568f,0.38157f,0.36502f,0.35110f,0.34343f,0.34233f,0.34605f,0.35337f,0.36304f,0.37282f,0.38187f,0.39163f,0.40273f,0.41394f,0.42487f,0.43601f,0.44625f,0.45294f,0.45399f,0.44803f,0.43420f,0.41393f,0.39124f,0.37028f,0.35389f,0.34377f,0.33981f},
-    {0.37236f,0.37289f,0.37826f,0.38816f,0.40237f,0.41956f,0.43724f,0.45274f,0.46333f,0.46592f,0.45864f,0.44316f,0.42447f,0.40808f,0.39741f,0.39283f,0.39339f,0.39860f,0.40735f,0.41725f,0.42701f,0.43745f,0.44902f,0.46095f,0.47308f,0.48570f,0.49764f,0.50631f,0.50895f,0.50305f,0.48719f,0.46316f,0.43591f,0.41060f,0.39068f,0.37789f,0.37236f},
-    {0.42245f,0.42215f,0.42846f,0.44064f,0.45724f,0.47601f,0.49435f,0.50993f,0.52038f,0.52304f,0.51631f,0.50148f,0.48288f,0.46550f,0.45264f,0.44515f,0.44269f,0.44488f,0.45083f,0.45875f,0.46742f,0.47714f,0.48867f,0.50225f,0.51759f,0.53373f,0.54863f,0.55948f,0.56339f,0.55795f,0.54232f,0.51859f,0.49131f,0.46537f,0.44426f,0.42977f,0.42245f},
-    {0.48319f,0.48226f,0.48758f,0.49842f,0.51308f,0.52913f,0.54416f,0.55622f,0.56358f,0.56459f,0.55836f,0.54575f,0.52954f,0.51323f,0.49956f,0.48985f,0.48445f,0.48324f,0.48569f,0.49085f,0.49796f,0.50710f,0.51894f,0.53390f,0.55144f,0.56981f,0.58634f,0.59810f,0.60259f,0.59827f,0.58527f,0.56571f,0.54318f,0.52144f,0.50331f,0.49032f,0.48319f},
-    {0.53929f,0.53799f,0.54070f,0.54691f,0.55552f,0.56497f,0.57363f,0.58010f,0.58328f,0.58236f,0.57702f,0.56775f,0.55586f,0.54317f,0.53137f,0.52173f,0.51505f,0.51167f,0.51159f,0.51458f,0.52039f,0.52900f,0.54059f,0.55506f,0.57159f,0.58845f,0.60334f,0.61392f,0.61846f,0.61626f,0.60790f,0.59512f,0.58032f,0.56589f,0.55363f,0.54459f,0.53929f},
-    {0.57278f,0.57090f,0.57068f,0.57187f,0.57403f,0.57656f,0.57878f,0.58007f,0.57991f,0.57795f,0.57409f,0.56849f,0.56162f,0.55414f,0.54681f,0.54040f,0.53554f,0.53271f,0.53223f,0.53423f,0.53873f,0.54564f,0.55475f,0.56559f,0.57735f,0.58891f,0.59900f,0.60643f,0.61040f,0.61066f,0.60758f,0.60203f,0.59514f,0.58801f,0.58156f,0.57637f,0.57278f},
-    {0.57900f,0.57728f,0.57584f,0.57463f,0.57360f,0.57263f,0.57160f,0.57039f,0.56890f,0.56707f,0.56489f,0.56241f,0.55976f,0.55710f,0.55465f,0.55263f,0.55127f,0.55074f,0.55121f,0.55273f,0.55530f,0.55883f,0.56314f,0.56798f,0.57300f,0.57785f,0.58216f,0.58562f,0.58802f,0.58928f,0.58943f,0.58865f,0.58716f,0.58523f,0.58309f,0.58097f,0.57900f},
-    {0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f,0.56830f}
+__EXTFLASHFUNC__ const int16_t AP_Declination::intensity_table[LAT_TABLE_SIZE][LON_TABLE_SIZE] = {
+    {5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451,5451},
+    {6056,5992,5913,5821,5718,5607,5489,5368,5246,5126,5012,4907,4813,4733,4670,4625,4601,4599,4620,4666,4737,4831,4946,5078,5222,5372,5522,5665,5796,5910,6003,6071,6115,6134,6129,6103,6056},
+    {6299,6166,6016,5851,5672,5479,5274,5060,4842,4627,4425,4242,4084,3952,3848,3772,3726,3715,3744,3821,3950,4130,4359,4627,4922,5229,5532,5816,6066,6270,6422,6517,6557,6548,6497,6411,6299},
+    {6186,5995,5795,5586,5365,5128,4870,4592,4301,4012,3746,3518,3338,3203,3104,3031,2982,2962,2989,3079,3248,3500,3829,4216,4638,5072,5492,5876,6201,6450,6614,6692,6692,6628,6513,6361,6186},
+    {5843,5613,5382,5151,4917,4672,4401,4098,3770,3438,3136,2897,2736,2645,2597,2561,2526,2500,2505,2578,2752,3044,3442,3914,4421,4925,5400,5819,6159,6402,6540,6579,6535,6424,6263,6064,5843},
+    {5392,5145,4900,4659,4425,4189,3936,3652,3337,3010,2712,2490,2373,2348,2368,2388,2392,2380,2369,2399,2530,2806,3224,3739,4286,4808,5275,5664,5956,6143,6232,6234,6163,6031,5851,5633,5392},
+    {4878,4638,4399,4164,3937,3718,3500,3267,3010,2735,2478,2296,2225,2251,2320,2392,2456,2506,2528,2539,2606,2806,3169,3660,4193,4689,5106,5423,5624,5721,5749,5724,5643,5510,5331,5115,4878},
+    {4321,4109,3900,3694,3498,3316,3147,2983,2804,2607,2416,2283,2242,2286,2377,2487,2612,2740,2830,2865,2889,2986,3227,3613,4065,4491,4837,5073,5177,5183,5153,5108,5025,4898,4732,4534,4321},
+    {3789,3628,3474,3327,3192,3072,2970,2878,2781,2666,2543,2444,2399,2425,2512,2640,2793,2952,3077,3140,3155,3182,3307,3559,3885,4205,4468,4632,4668,4614,4546,4483,4395,4272,4123,3957,3789},
+    {3411,3319,3235,3162,3106,3067,3041,3022,2998,2949,2870,2776,2696,2665,2708,2812,2945,3079,3194,3268,3299,3322,3398,3556,3765,3978,4157,4263,4269,4201,4113,4021,3909,3777,3643,3518,3411},
+    {3282,3252,3232,3228,3252,3298,3353,3406,3440,3430,3362,3247,3121,3026,3001,3044,3126,3224,3323,3407,3470,3533,3622,3742,3877,4016,4136,4206,4208,4145,4036,3893,3730,3570,3433,3337,3282},
+    {3398,3400,3427,3481,3572,3694,3824,3940,4018,4029,3957,3816,3650,3511,3434,3423,3460,3534,3630,3728,3819,3916,4027,4139,4249,4360,4462,4529,4540,4480,4342,4139,3912,3703,3539,3438,3398},
+    {3724,3729,3783,3882,4024,4196,4372,4527,4633,4659,4586,4432,4245,4081,3974,3928,3934,3986,4073,4172,4270,4374,4490,4610,4731,4857,4976,5063,5090,5030,4872,4632,4359,4106,3907,3779,3724},
+    {4224,4222,4285,4406,4572,4760,4944,5099,5204,5230,5163,5015,4829,4655,4526,4452,4427,4449,4508,4588,4674,4771,4887,5022,5176,5337,5486,5595,5634,5579,5423,5186,4913,4654,4443,4298,4224},
+    {4832,4823,4876,4984,5131,5291,5442,5562,5636,5646,5584,5457,5295,5132,4996,4898,4844,4832,4857,4908,4980,5071,5189,5339,5514,5698,5863,5981,6026,5983,5853,5657,5432,5214,5033,4903,4832},
+    {5393,5380,5407,5469,5555,5650,5736,5801,5833,5824,5770,5677,5559,5432,5314,5217,5150,5117,5116,5146,5204,5290,5406,5551,5716,5884,6033,6139,6185,6163,6079,5951,5803,5659,5536,5446,5393},
+    {5728,5709,5707,5719,5740,5766,5788,5801,5799,5779,5741,5685,5616,5541,5468,5404,5355,5327,5322,5342,5387,5456,5547,5656,5774,5889,5990,6064,6104,6107,6076,6020,5951,5880,5816,5764,5728},
+    {5790,5773,5758,5746,5736,5726,5716,5704,5689,5671,5649,5624,5598,5571,5546,5526,5513,5507,5512,5527,5553,5588,5631,5680,5730,5778,5822,5856,5880,5893,5894,5886,5872,5852,5831,5810,5790},
+    {5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683,5683}
 };
 
@@ -117,9 +117,31 @@ TEST(MagField, test_field_error)
     for (const auto &d : test_data) {
         Location loc(d.lat*1.0e7, d.lon*1.0e7, 0, Location::AltFrame::ABSOLUTE);
         const Vector3f m = AP_Declination::get_earth_field_ga(loc);
-        EXPECT_FLOAT_EQ(roundf(m.x*1000), roundf(d.field.x));
-        EXPECT_FLOAT_EQ(roundf(m.y*1000), roundf(d.field.y));
-        EXPECT_FLOAT_EQ(roundf(m.z*1000), roundf(d.field.z));
+        // the int16 tables are within 0.05 mGauss of the float tables
+        // the test data was generated from
+        EXPECT_NEAR(m.x*1000, d.field.x, 0.1);
+        EXPECT_NEAR(m.y*1000, d.field.y, 0.1);
+        EXPECT_NEAR(m.z*1000, d.field.z, 0.1);
+    }
+}
+
+TEST(MagField, cache)
+{
+    // lookups through a cache match uncached lookups, moving within
+    // and between table cells
+    AP_Declination::Cache cache;
+    for (const auto &d : test_data) {
+        for (uint8_t i=0; i<4; i++) {
+            const float lat = d.lat + i * 3.3;
+            const float lon = d.lon - i * 4.1;
+            float intensity1, declination1, inclination1;
+            float intensity2, declination2, inclination2;
+            EXPECT_EQ(AP_Declination::get_mag_field_ef(lat, lon, intensity1, declination1, inclination1),
+                      cache.get_mag_field_ef(lat, lon, intensity2, declination2, inclination2));
+            EXPECT_FLOAT_EQ(intensity1, intensity2);
+            EXPECT_FLOAT_EQ(declination1, declination2);
+            EXPECT_FLOAT_EQ(inclination1, inclination2);
+        }
     }
 }
 
@@ -186,7 +186,29 @@ bool CanardInterface::shouldAcceptTransfer(const CanardInstance* ins,
                                            CanardTransferType transfer_type,
                                            uint8_t source_node_id) {
     CanardInterface* iface = (CanardInterface*) ins->user_reference;
-    return iface->accept_message(data_type_id, transfer_type, *out_data_type_signature);
+    return iface->accept_message_cached(data_type_id, transfer_type, *out_data_type_signature);
+}
+
+bool CanardInterface::accept_message_cached(uint16_t data_type_id, CanardTransferType transfer_type, uint64_t &signature)
+{
+    auto &entry = accept_cache[(data_type_id ^ (uint16_t(transfer_type) << 3)) & (DRONECAN_ACCEPT_CACHE_SIZE-1)];
+    if (entry.valid && entry.data_type_id == data_type_id && entry.transfer_type == transfer_type) {
+        signature = entry.signature;
+        return entry.accept;
+    }
+    entry.accept = accept_message(data_type_id, transfer_type, signature);
+    entry.signature = signature;
+    entry.data_type_id = data_type_id;
+    entry.transfer_type = transfer_type;
+    entry.valid = true;
+    return entry.accept;
+}
+
+void CanardInterface::flush_accept_cache()
+{
+    for (auto &entry : accept_cache) {
+        entry.valid = false;
+    }
 }
 
 #if AP_TEST_DRONECAN_DRIVERS
@@ -329,66 +351,89 @@ void CanardInterface::update_rx_protocol_stats(int16_t res)
 void CanardInterface::processRx() {
     AP_HAL::CANFrame rxmsg;
     for (uint8_t i=0; i<num_ifaces; i++) {
-        while(true) {
-            if (ifaces[i] == NULL) {
-                break;
-            }
-            bool read_select = true;
-            bool write_select = false;
-            ifaces[i]->select(read_select, write_select, nullptr, 0);
-            if (!read_select) { // No data pending
-                break;
-            }
-            CanardCANFrame rx_frame {};
+        if (ifaces[i] == NULL) {
+            continue;
+        }
+        // read frames in batches so the receive semaphore is taken
+        // once per batch rather than once per frame
+        while (true) {
+            uint8_t count = 0;
+            bool more = true;
+            while (count < DRONECAN_RX_BATCH_SIZE) {
+                bool read_select = true;
+                bool write_select = false;
+                ifaces[i]->select(read_select, write_select, nullptr, 0);
+                if (!read_select) { // No data pending
+                    more = false;
+                    break;
+                }
 
-            //palToggleLine(HAL_GPIO_PIN_LED);
-            uint64_t timestamp;
-            AP_HAL::CANIface::CanIOFlags flags;
-            if (ifaces[i]->receive(rxmsg, timestamp, flags) <= 0) {
-                break;
-            }
+                //palToggleLine(HAL_GPIO_PIN_LED);
+                AP_HAL::CANIface::CanIOFlags flags;
+                if (ifaces[i]->receive(rxmsg, rx_batch_timestamp[count], flags) <= 0) {
+                    more = false;
+                    break;
+                }
 
-            if (!rxmsg.isExtended()) {
-                // 11 bit frame, see if we have a handler
-                if (aux_11bit_driver != nullptr) {
-                    aux_11bit_driver->handle_frame(rxmsg);
+                if (!rxmsg.isExtended()) {
+                    // 11 bit frame, see if we have a handler
+                    if (aux_11bit_driver != nullptr) {
+                        aux_11bit_driver->handle_frame(rxmsg);
+                    }
+                    continue;
                 }
-                continue;
-            }
 
-            rx_frame.data_len = AP_HAL::CANFrame::dlcToDataLength(rxmsg.dlc);
-            memcpy(rx_frame.data, rxmsg.data, rx_frame.data_len);
+                CanardCANFrame &rx_frame = rx_batch[count++];
+                rx_frame = {};
+                rx_frame.data_len = AP_HAL::CANFrame::dlcToDataLength(rxmsg.dlc);
+                memcpy(rx_frame.data, rxmsg.data, rx_frame.data_len);
 #if HAL_CANFD_SUPPORTED
-            rx_frame.canfd = rxmsg.canfd;
+                rx_frame.canfd = rxmsg.canfd;
+                if (rxmsg.canfd) {
+                    last_canfd_rx_ms = AP_HAL::millis();
+                }
 #endif
-            rx_frame.id = rxmsg.id;
+                rx_frame.id = rxmsg.id;
 #if CANARD_MULTI_IFACE
-            rx_frame.iface_id = i;
+                rx_frame.iface_id = i;
 #endif
-            {
-                WITH_SEMAPHORE(_sem_rx);
-
-                const int16_t res = canardHandleRxFrame(&canard, &rx_frame, timestamp);
-                if (res == -CANARD_ERROR_RX_MISSED_START) {
-                    // this might remaining frames from a message that we don't accept, so check
-                    uint64_t dummy_signature;
-                    if (shouldAcceptTransfer(&canard,
-                                        &dummy_signature,
-                                        extractDataType(rx_frame.id),
-                                        extractTransferType(rx_frame.id),
-                                        1)) { // doesn't matter what we pass here
-                        update_rx_protocol_stats(res);
-                    } else {
-                        protocol_stats.rx_ignored_not_wanted++;
-                    }
-                } else {
-                    update_rx_protocol_stats(res);
-                }
+            }
+            handle_rx_batch(count);
+            if (!more) {
+                break;
             }
         }
     }
 }
 
+void CanardInterface::handle_rx_batch(uint8_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    WITH_SEMAPHORE(_sem_rx);
+
+    for (uint8_t j=0; j<count; j++) {
+        const CanardCANFrame &rx_frame = rx_batch[j];
+        const int16_t res = canardHandleRxFrame(&canard, &rx_frame, rx_batch_timestamp[j]);
+        if (res == -CANARD_ERROR_RX_MISSED_START) {
+            // this might remaining frames from a message that we don't accept, so check
+            uint64_t dummy_signature;
+            if (shouldAcceptTransfer(&canard,
+                                &dummy_signature,
+                                extractDataType(rx_frame.id),
+                                extractTransferType(rx_frame.id),
+                                1)) { // doesn't matter what we pass here
+                update_rx_protocol_stats(res);
+            } else {
+                protocol_stats.rx_ignored_not_wanted++;
+            }
+        } else {
+            update_rx_protocol_stats(res);
+        }
+    }
+}
+
 void CanardInterface::process(uint32_t duration_ms) {
 #if AP_TEST_DRONECAN_DRIVERS
     const uint64_t deadline = AP_HAL::micros64() + duration_ms*1000;
@@ -405,10 +450,19 @@ void CanardInterface::process(uint32_t duration_ms) {
             WITH_SEMAPHORE(_sem_rx);
             WITH_SEMAPHORE(_sem_tx);
             canardCleanupStaleTransfers(&canard, AP_HAL::micros64());
+
+            // subscribers may come and go, so the accept cache is
+            // rebuilt once a second
+            const uint32_t now_ms = AP_HAL::millis();
+            if (now_ms - accept_cache_flush_ms >= 1000) {
+                accept_cache_flush_ms = now_ms;
+                flush_accept_cache();
+            }
         }
         const uint64_t now = AP_HAL::micros64();
         if (now < deadline) {
             IGNORE_RETURN(sem_handle.wait(deadline - now));
+            wait_us += uint32_t(AP_HAL::micros64() - now);
         } else {
             break;
         }
@@ -4,6 +4,14 @@
 #include <canard/interface.h>
 #include <dronecan_msgs.h>
 
+#ifndef DRONECAN_RX_BATCH_SIZE
+#define DRONECAN_RX_BATCH_SIZE 8 // frames read from an interface before taking the receive semaphore
+#endif
+
+#ifndef DRONECAN_ACCEPT_CACHE_SIZE
+#define DRONECAN_ACCEPT_CACHE_SIZE 32 // must be a power of 2
+#endif
+
 class AP_DroneCAN;
 class CANSensor;
 
@@ -68,7 +76,22 @@ public:
     // get reference to the semaphore that is held during message receive
     HAL_Semaphore &get_sem_rx(void) { return _sem_rx; }
 
+    // total time spent in process() waiting for frames
+    uint32_t get_wait_us() const { return wait_us; }
+
+    // system time of the last CAN FD frame received, zero if none
+    uint32_t get_last_canfd_rx_ms() const { return last_canfd_rx_ms; }
+
 private:
+    // look up whether transfers of a data type are accepted, caching the answer
+    bool accept_message_cached(uint16_t data_type_id, CanardTransferType transfer_type, uint64_t &signature);
+
+    // forget all cached accept results, so handlers added or removed since are seen
+    void flush_accept_cache();
+
+    // pass the frames in rx_batch to canard
+    void handle_rx_batch(uint8_t count);
+
     CanardInstance canard;
     AP_HAL::CANIface* ifaces[HAL_NUM_CAN_IFACES];
 #if AP_TEST_DRONECAN_DRIVERS
@@ -85,5 +108,24 @@ private:
 
     // auxillary 11 bit CANSensor
     CANSensor *aux_11bit_driver;
+
+    // frames read from one interface, handed to canard under a single take of _sem_rx
+    CanardCANFrame rx_batch[DRONECAN_RX_BATCH_SIZE];
+    uint64_t rx_batch_timestamp[DRONECAN_RX_BATCH_SIZE];
+
+    // direct mapped cache of accept_message() results. Every single
+    // frame transfer asks whether it is wanted, and without the cache
+    // one walks the handler list under its semaphore
+    struct {
+        uint64_t signature;
+        uint16_t data_type_id;
+        uint8_t transfer_type;
+        bool valid;
+        bool accept;
+    } accept_cache[DRONECAN_ACCEPT_CACHE_SIZE];
+    uint32_t accept_cache_flush_ms;
+
+    uint32_t wait_us;
+    uint32_t last_canfd_rx_ms;
 };
 #endif // HAL_ENABLE_DRONECAN_DRIVERS
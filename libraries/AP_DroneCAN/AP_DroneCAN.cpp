@@ -129,7 +129,7 @@ const AP_Param::GroupInfo AP_DroneCAN::var_info[] = {
     // @Param: OPTION
     // @DisplayName: DroneCAN options
     // @Description: Option flags
-    // @Bitmask: 0:ClearDNADatabase,1:IgnoreDNANodeConflicts,2:EnableCanfd,3:IgnoreDNANodeUnhealthy,4:SendServoAsPWM,5:SendGNSS,6:UseHimarkServo,7:HobbyWingESC,8:EnableStats,9:EnableFlexDebug
+    // @Bitmask: 0:ClearDNADatabase,1:IgnoreDNANodeConflicts,2:EnableCanfd,3:IgnoreDNANodeUnhealthy,4:SendServoAsPWM,5:SendGNSS,6:UseHimarkServo,7:HobbyWingESC,8:EnableStats,9:EnableFlexDebug,10:CanfdBulkTransfers
     // @User: Advanced
     AP_GROUPINFO("OPTION", 5, AP_DroneCAN, _options, 0),
     
@@ -531,6 +531,9 @@ void AP_DroneCAN::loop(void)
         // the CPU, preventing low priority threads from running
         hal.scheduler->delay_microseconds(100);
 
+        const uint32_t loop_start_us = AP_HAL::micros();
+        const uint32_t wait_start_us = canard_iface.get_wait_us();
+
         canard_iface.process(1);
 
         safety_state_send();
@@ -579,6 +582,9 @@ void AP_DroneCAN::loop(void)
 #if AP_RELAY_DRONECAN_ENABLED
         relay_hardpoint_send();
 #endif
+
+        // time spent working rather than waiting for frames, for the thread utilisation in CANS
+        _busy_us += (AP_HAL::micros() - loop_start_us) - (canard_iface.get_wait_us() - wait_start_us);
     }
 }
 
@@ -780,7 +786,7 @@ void AP_DroneCAN::SRV_send_actuator(void)
         }
         msg.commands.len = i;
         if (i > 0) {
-            if (act_out_array.broadcast(msg) > 0) {
+            if (act_out_array.broadcast(msg, bulk_canfd()) > 0) {
                 _srv_send_count++;
             } else {
                 _fail_send_count++;
@@ -862,7 +868,7 @@ void AP_DroneCAN::SRV_send_esc(void)
         }
         esc_msg.cmd.len = k;
 
-        if (esc_raw.broadcast(esc_msg)) {
+        if (esc_raw.broadcast(esc_msg, bulk_canfd())) {
             _esc_send_count++;
         } else {
             _fail_send_count++;
@@ -1944,6 +1950,8 @@ void AP_DroneCAN::logging(void)
     if (now_ms - last_log_ms < 1000) {
         return;
     }
+    const float util_pct = 0.1 * _busy_us / (now_ms - last_log_ms);
+    _busy_us = 0;
     last_log_ms = now_ms;
     if (HAL_NUM_CAN_IFACES <= _driver_index) {
         // no interface?
@@ -1977,11 +1985,12 @@ void AP_DroneCAN::logging(void)
 // @Field: Etx: ESC successful send count
 // @Field: Stx: Servo successful send count
 // @Field: Ftx: ESC/Servo failed-to-send count
+// @Field: Ut: DroneCAN thread utilisation
     AP::logger().WriteStreaming("CANS",
-                                "TimeUS,I,T,Trq,Trej,Tov,Tto,Tab,R,Rov,Rer,Bo,Etx,Stx,Ftx",
-                                "s#-------------",
-                                "F--------------",
-                                "QBIIIIIIIIIIIII",
+                                "TimeUS,I,T,Trq,Trej,Tov,Tto,Tab,R,Rov,Rer,Bo,Etx,Stx,Ftx,Ut",
+                                "s#-------------%",
+                                "F---------------",
+                                "QBIIIIIIIIIIIIIf",
                                 AP_HAL::micros64(),
                                 _driver_index,
                                 s.tx_success,
@@ -1996,10 +2005,34 @@ void AP_DroneCAN::logging(void)
                                 s.num_busoff_err,
                                 _esc_send_count,
                                 _srv_send_count,
-                                _fail_send_count);
+                                _fail_send_count,
+                                util_pct);
 #endif // HAL_LOGGING_ENABLED
 }
 
+/*
+  high volume transfers are sent as CAN FD frames when all transfers
+  are, or when the CanfdBulkTransfers option is set and another node
+  has sent a CAN FD frame in the last 3 seconds. A bus without FD
+  capable nodes falls back to classic frames, as a classic controller
+  would raise error frames on every FD frame
+ */
+bool AP_DroneCAN::bulk_canfd() const
+{
+#if HAL_CANFD_SUPPORTED
+    if (option_is_set(Options::CANFD_ENABLED)) {
+        return true;
+    }
+    if (!option_is_set(Options::CANFD_BULK)) {
+        return false;
+    }
+    const uint32_t last_canfd_rx_ms = canard_iface.get_last_canfd_rx_ms();
+    return last_canfd_rx_ms != 0 && AP_HAL::millis() - last_canfd_rx_ms < 3000;
+#else
+    return false;
+#endif
+}
+
 // add an 11 bit auxillary driver
 bool AP_DroneCAN::add_11bit_driver(CANSensor *sensor)
 {
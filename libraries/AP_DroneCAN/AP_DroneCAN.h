@@ -151,6 +151,7 @@ public:
         USE_HOBBYWING_ESC         = (1U<<7),
         ENABLE_STATS              = (1U<<8),
         ENABLE_FLEX_DEBUG         = (1U<<9),
+        CANFD_BULK                = (1U<<10),
     };
 
     // check if a option is set
@@ -158,6 +159,9 @@ public:
         return (uint16_t(_options.get()) & uint16_t(option)) != 0;
     }
 
+    // true if high volume transfers (ESC and actuator commands, RTCM) should be sent as CAN FD frames
+    bool bulk_canfd() const;
+
     // check if a option is set and if it is then reset it to
     // 0. return true if it was set
     bool check_and_reset_option(Options option);
@@ -271,6 +275,9 @@ private:
     // last log time
     uint32_t last_log_ms;
 
+    // time spent in loop() outside of waits since the last log
+    uint32_t _busy_us;
+
 #if AP_DRONECAN_SEND_GPS
     // send GNSS Fix and yaw, same thing AP_GPS_DroneCAN would receive
     void gnss_send_fix();
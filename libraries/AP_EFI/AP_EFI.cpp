@@ -154,7 +154,11 @@ void AP_EFI::update()
     if (backend) {
         backend->update();
 #if HAL_LOGGING_ENABLED
-        log_status();
+        // only log when the backend has published something new
+        if (logged_state_version != state_version) {
+            logged_state_version = state_version;
+            log_status();
+        }
 #endif
     }
 }
@@ -334,6 +338,19 @@ void AP_EFI::get_state(EFI_State &_state)
     _state = state;
 }
 
+// get a copy of state structure if it is newer than version
+bool AP_EFI::get_state_if_newer(EFI_State &_state, uint32_t &version)
+{
+    if (version == state_version) {
+        // avoid taking the semaphore and copying when nothing has changed
+        return false;
+    }
+    WITH_SEMAPHORE(sem);
+    _state = state;
+    version = state_version;
+    return true;
+}
+
 void AP_EFI::handle_EFI_message(const mavlink_message_t &msg) {
     if (backend != nullptr) {
         backend->handle_EFI_message(msg);
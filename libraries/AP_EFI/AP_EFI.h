@@ -77,6 +77,14 @@ public:
     // get a copy of state structure
     void get_state(EFI_State &state);
 
+    // version of the state structure, incremented each time a backend
+    // publishes new data
+    uint32_t get_state_version() const { return state_version; }
+
+    // get a copy of the state structure only if it has been updated
+    // since version, which is updated to the version copied
+    bool get_state_if_newer(EFI_State &state, uint32_t &version);
+
     // Parameter info
     static const struct AP_Param::GroupInfo var_info[];
 
@@ -148,6 +156,12 @@ private:
     // Semaphore for access to shared frontend data
     HAL_Semaphore sem;
 
+    // incremented each time the backend copies to the frontend state
+    volatile uint32_t state_version;
+#if HAL_LOGGING_ENABLED
+    uint32_t logged_state_version;
+#endif
+
     // write to log
     void log_status();
 };
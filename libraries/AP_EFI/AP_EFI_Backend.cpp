@@ -30,6 +30,7 @@ void AP_EFI_Backend::copy_to_frontend()
 {
     WITH_SEMAPHORE(frontend.sem);
     frontend.state = internal_state;
+    frontend.state_version++;
 }
 
 bool AP_EFI_Backend::healthy() const
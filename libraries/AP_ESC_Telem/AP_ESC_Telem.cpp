@@ -100,6 +100,36 @@ uint8_t AP_ESC_Telem::get_motor_frequencies_hz(uint8_t nfreqs, float* freqs) con
     return MIN(valid_escs, nfreqs);
 }
 
+// return all the motor frequencies and their average with one read of
+// the time, so that every harmonic notch updated in a loop can share them
+void AP_ESC_Telem::get_motor_frequencies(MotorFrequencies &freqs) const
+{
+    const uint32_t now_us = AP_HAL::micros();
+    float sum_hz = 0.0f;
+    uint8_t valid_escs = 0;
+
+    freqs.num_freqs = 0;
+    freqs.newest_update_us = 0;
+    for (uint8_t i = 0; i < ESC_TELEM_MAX_ESCS; i++) {
+        float rpm;
+        if (get_rpm(i, rpm, now_us)) {
+            const float freq_hz = rpm * (1.0f / 60.0f);
+            freqs.freqs_hz[freqs.num_freqs++] = freq_hz;
+            sum_hz += freq_hz;
+            valid_escs++;
+            const uint32_t update_us = _rpm_data[i].last_update_us;
+            if (freqs.newest_update_us == 0 || int32_t(update_us - freqs.newest_update_us) > 0) {
+                freqs.newest_update_us = update_us;
+            }
+        } else if (was_rpm_data_ever_reported(_rpm_data[i])) {
+            // as get_motor_frequencies_hz(), keep ESCs that have gone
+            // quiet so the notches don't shift
+            freqs.freqs_hz[freqs.num_freqs++] = 0.0f;
+        }
+    }
+    freqs.average_hz = valid_escs > 0 ? sum_hz / valid_escs : 0.0f;
+}
+
 // get mask of ESCs that sent valid telemetry and/or rpm data in the last
 // ESC_TELEM_DATA_TIMEOUT_MS/ESC_RPM_DATA_TIMEOUT_US
 uint32_t AP_ESC_Telem::get_active_esc_mask() const {
@@ -182,6 +212,11 @@ bool AP_ESC_Telem::is_telemetry_active(uint32_t servo_channel_mask) const
 
 // get an individual ESC's slewed rpm if available, returns true on success
 bool AP_ESC_Telem::get_rpm(uint8_t esc_index, float& rpm) const
+{
+    return get_rpm(esc_index, rpm, AP_HAL::micros());
+}
+
+bool AP_ESC_Telem::get_rpm(uint8_t esc_index, float& rpm, uint32_t now) const
 {
     if (esc_index >= ESC_TELEM_MAX_ESCS) {
         return false;
@@ -193,7 +228,6 @@ bool AP_ESC_Telem::get_rpm(uint8_t esc_index, float& rpm) const
         return false;
     }
 
-    const uint32_t now = AP_HAL::micros();
     if (rpmdata.data_valid) {
         const float slew = MIN(1.0f, (now - rpmdata.last_update_us) * rpmdata.update_rate_hz * (1.0f / 1e6f));
         rpm = (rpmdata.prev_rpm + (rpmdata.rpm - rpmdata.prev_rpm) * slew);
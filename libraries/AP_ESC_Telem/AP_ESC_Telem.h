@@ -92,6 +92,16 @@ public:
     // return all of the motor frequencies in Hz for dynamic filtering
     uint8_t get_motor_frequencies_hz(uint8_t nfreqs, float* freqs) const;
 
+    // all of the motor frequencies from a single pass over the ESCs,
+    // for consumers that would otherwise query them repeatedly
+    struct MotorFrequencies {
+        uint8_t num_freqs;                      // as get_motor_frequencies_hz()
+        float freqs_hz[ESC_TELEM_MAX_ESCS];
+        float average_hz;                       // as get_average_motor_frequency_hz()
+        uint32_t newest_update_us;              // time the newest rpm data was received, zero if none
+    };
+    void get_motor_frequencies(MotorFrequencies &freqs) const;
+
     // get the number of ESCs that sent valid telemetry data in the last ESC_TELEM_DATA_TIMEOUT_MS
     uint8_t get_num_active_escs() const;
 
@@ -133,6 +143,9 @@ public:
 
 private:
 
+    // get an individual ESC's slewed rpm at now_us
+    bool get_rpm(uint8_t esc_index, float& rpm, uint32_t now_us) const;
+
     // helper that validates RPM data
     static bool rpm_data_within_timeout (const volatile AP_ESC_Telem_Backend::RpmData &instance, const uint32_t timeout_us);
     static bool was_rpm_data_ever_reported (const volatile AP_ESC_Telem_Backend::RpmData &instance);
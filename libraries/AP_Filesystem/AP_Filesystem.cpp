@@ -294,6 +294,39 @@ uint32_t AP_Filesystem::bytes_until_fsync(int fd)
     return backend.fs.bytes_until_fsync(fd);
 }
 
+// reserve size bytes from the start of a file without changing its size
+bool AP_Filesystem::preallocate(int fd, uint32_t size)
+{
+    const Backend &backend = backend_by_fd(fd);
+    return backend.fs.preallocate(fd, size);
+}
+
+// stream written data to the disk
+void AP_Filesystem::writeback(int fd, uint32_t offset, uint32_t count)
+{
+    const Backend &backend = backend_by_fd(fd);
+    backend.fs.writeback(fd, offset, count);
+}
+
+// map part of an open file for reading
+const uint8_t *AP_Filesystem::mmap(int fd, uint32_t offset, uint32_t length)
+{
+    const Backend &backend = backend_by_fd(fd);
+    return backend.fs.mmap(fd, offset, length);
+}
+
+void AP_Filesystem::munmap(int fd, const uint8_t *ptr, uint32_t length)
+{
+    const Backend &backend = backend_by_fd(fd);
+    backend.fs.munmap(ptr, length);
+}
+
+bool AP_Filesystem::mmap_zero_copy(int fd)
+{
+    const Backend &backend = backend_by_fd(fd);
+    return backend.fs.mmap_zero_copy();
+}
+
 // return free disk space in bytes
 int64_t AP_Filesystem::disk_free(const char *path)
 {
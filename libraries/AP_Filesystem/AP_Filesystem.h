@@ -114,6 +114,22 @@ public:
     // streaming performance/robustness. if zero, any number can be written.
     uint32_t bytes_until_fsync(int fd);
 
+    // reserve size bytes from the start of a file without changing its
+    // size. Returns false if not supported
+    bool preallocate(int fd, uint32_t size);
+
+    // start writing count bytes at offset to the disk, and wait for
+    // everything before offset to be written
+    void writeback(int fd, uint32_t offset, uint32_t count);
+
+    // map length bytes of an open file from offset for reading,
+    // nullptr on failure. Must be unmapped before the file is closed
+    const uint8_t *mmap(int fd, uint32_t offset, uint32_t length);
+    void munmap(int fd, const uint8_t *ptr, uint32_t length);
+
+    // return true if mmap() maps the file without copying it
+    bool mmap_zero_copy(int fd);
+
     // return free disk space in bytes, -1 on error
     int64_t disk_free(const char *path);
 
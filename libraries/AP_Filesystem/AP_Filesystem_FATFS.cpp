@@ -10,6 +10,7 @@
 #include <AP_Math/AP_Math.h>
 #include <stdio.h>
 #include <AP_Common/time.h>
+#include <AP_Common/ExpandingString.h>
 
 #include <ff.h>
 #include <AP_HAL_ChibiOS/sdcard.h>
@@ -42,6 +43,20 @@ static HAL_Semaphore sem;
 typedef struct {
     FIL fobj; // should be first member; it's the most used
     char *name;
+    // size of the cluster chain allocated by preallocate()
+    FSIZE_t preallocated;
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    // read-ahead or write-behind data from file offset cache_ofs,
+    // allocated on the first small read or write
+    uint8_t *cache;
+    FSIZE_t cache_ofs;
+    uint16_t cache_len;
+    bool cache_dirty;
+    bool cache_alloc_failed;
+    // position seen by the caller while cache is allocated, the
+    // FATFS position may be ahead of it after a read-ahead
+    FSIZE_t pos;
+#endif
 } FAT_FILE;
 
 #define MAX_FILES 16
@@ -99,23 +114,16 @@ static void free_file_descriptor(int fileno)
     FAT_FILE *stream = fileno_to_stream(fileno);
     if (stream != nullptr) {
         file_table[fileno] = NULL;
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+        if (stream->cache != nullptr) {
+            hal.util->free_type(stream->cache, AP_FILESYSTEM_FATFS_CACHE_SIZE, AP_HAL::Util::MEM_DMA_SAFE);
+        }
+#endif
         free(stream->name);
         free(stream);
     }
 }
 
-static FIL *fileno_to_fatfs(int fileno)
-{
-    FAT_FILE *stream;
-
-    stream = fileno_to_stream(fileno);
-    if (stream == nullptr) { // unknown fileno?
-        return nullptr; // errno already set
-    }
-
-    return &stream->fobj;
-}
-
 static int fatfs_to_errno(FRESULT Result)
 {
     switch (Result) {
@@ -302,41 +310,51 @@ int AP_Filesystem_FATFS::close(int fileno)
 
     errno = 0;
 
-    fh = fileno_to_fatfs(fileno);
-    if (fh == nullptr) { // unknown fileno?
+    FAT_FILE *stream = fileno_to_stream(fileno);
+    if (stream == nullptr) { // unknown fileno?
         return -1; // errno already set
     }
+    fh = &stream->fobj;
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    const bool flushed = cache_flush(stream);
+#endif
+#if FF_USE_EXPAND
+    if (stream->preallocated > fh->obj.objsize) {
+        // free the preallocated clusters after the data
+        const FSIZE_t size = fh->obj.objsize;
+        fh->obj.objsize = stream->preallocated;
+        if (f_lseek(fh, size) != FR_OK || f_truncate(fh) != FR_OK) {
+            fh->obj.objsize = size;
+        }
+    }
+#endif
     res = f_close(fh);
     free_file_descriptor(fileno);
     if (res != FR_OK) {
         errno = fatfs_to_errno((FRESULT)res);
         return -1;
     }
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    if (!flushed) {
+        errno = EIO;
+        return -1;
+    }
+#endif
     return 0;
 }
 
-int32_t AP_Filesystem_FATFS::read(int fd, void *buf, uint32_t count)
+/*
+  read from the file, in chunks that are safe for DMA
+ */
+static int32_t fat_read(FIL *fh, void *buf, uint32_t count)
 {
     UINT bytes = count;
     int res;
-    FIL *fh;
-
-    FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
-
-    CHECK_REMOUNT();
 
     if (count > 0) {
         *(char *) buf = 0;
     }
 
-    errno = 0;
-
-    fh = fileno_to_fatfs(fd);
-    if (fh == nullptr) { // unknown fd?
-        return -1; // errno already set
-    }
-
     UINT total = 0;
     do {
         UINT size = 0;
@@ -366,22 +384,13 @@ int32_t AP_Filesystem_FATFS::read(int fd, void *buf, uint32_t count)
     return (ssize_t)total;
 }
 
-int32_t AP_Filesystem_FATFS::write(int fd, const void *buf, uint32_t count)
+/*
+  write to the file, in chunks that are safe for DMA
+ */
+static int32_t fat_write(FIL *fh, const void *buf, uint32_t count)
 {
     UINT bytes = count;
     FRESULT res;
-    FIL *fh;
-    errno = 0;
-
-    FS_CHECK_ALLOWED(-1);
-    WITH_SEMAPHORE(sem);
-
-    CHECK_REMOUNT();
-
-    fh = fileno_to_fatfs(fd);
-    if (fh == nullptr) { // unknown fd?
-        return -1; // errno already set
-    }
 
     UINT total = 0;
     do {
@@ -416,6 +425,235 @@ int32_t AP_Filesystem_FATFS::write(int fd, const void *buf, uint32_t count)
     return (ssize_t)total;
 }
 
+// move the FATFS position if it isn't already there
+static bool fat_seek(FIL *fh, FSIZE_t ofs)
+{
+    if (fh->fptr == ofs) {
+        return true;
+    }
+    const FRESULT res = f_lseek(fh, ofs);
+    if (res != FR_OK) {
+        errno = fatfs_to_errno(res);
+        return false;
+    }
+    return true;
+}
+
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+/*
+  the cache turns the small sequential reads and writes of terrain,
+  scripting and parameter files into whole multi-sector transfers.
+  Reads and writes of a full cache size or more go straight to the
+  card
+ */
+static struct {
+    uint32_t read_hits;
+    uint32_t read_fills;
+    uint32_t read_direct;
+    uint32_t write_hits;
+    uint32_t write_flushes;
+    uint32_t write_direct;
+    uint32_t alloc_fails;
+} cache_stats;
+
+static bool cache_alloc(FAT_FILE *stream)
+{
+    if (stream->cache_alloc_failed) {
+        return false;
+    }
+    stream->cache = (uint8_t *)hal.util->malloc_type(AP_FILESYSTEM_FATFS_CACHE_SIZE, AP_HAL::Util::MEM_DMA_SAFE);
+    if (stream->cache == nullptr) {
+        // carry on without it
+        stream->cache_alloc_failed = true;
+        cache_stats.alloc_fails++;
+        return false;
+    }
+    stream->cache_len = 0;
+    stream->cache_dirty = false;
+    stream->pos = stream->fobj.fptr;
+    return true;
+}
+
+/*
+  write out pending data. It is kept as read-ahead data afterwards
+ */
+static bool cache_flush(FAT_FILE *stream)
+{
+    if (stream->cache == nullptr || !stream->cache_dirty) {
+        return true;
+    }
+    FIL *fh = &stream->fobj;
+    if (!fat_seek(fh, stream->cache_ofs)) {
+        return false;
+    }
+    const int32_t ret = fat_write(fh, stream->cache, stream->cache_len);
+    if (ret != stream->cache_len) {
+        if (ret >= 0) {
+            errno = EIO;
+        }
+        // the data is lost, as it would have been for a direct write
+        stream->cache_len = 0;
+        stream->cache_dirty = false;
+        return false;
+    }
+    stream->cache_dirty = false;
+    cache_stats.write_flushes++;
+    return true;
+}
+
+static int32_t cache_read(FAT_FILE *stream, uint8_t *buf, uint32_t count)
+{
+    FIL *fh = &stream->fobj;
+    if (!cache_flush(stream)) {
+        return -1;
+    }
+    uint32_t total = 0;
+    while (count > 0) {
+        if (stream->pos >= stream->cache_ofs && stream->pos < stream->cache_ofs + stream->cache_len) {
+            const uint32_t n = MIN(count, stream->cache_ofs + stream->cache_len - stream->pos);
+            memcpy(buf, &stream->cache[stream->pos - stream->cache_ofs], n);
+            stream->pos += n;
+            total += n;
+            buf += n;
+            count -= n;
+            cache_stats.read_hits++;
+            continue;
+        }
+        if (count >= AP_FILESYSTEM_FATFS_CACHE_SIZE) {
+            if (!fat_seek(fh, stream->pos)) {
+                return -1;
+            }
+            const int32_t ret = fat_read(fh, buf, count);
+            if (ret < 0) {
+                return -1;
+            }
+            stream->pos += ret;
+            total += ret;
+            cache_stats.read_direct++;
+            break;
+        }
+        // read ahead from the start of the sector, which lets
+        // FATFS read the whole cache in a single multi-block transfer
+        const FSIZE_t start = stream->pos & ~FSIZE_t(511);
+        stream->cache_len = 0;
+        if (!fat_seek(fh, start)) {
+            return -1;
+        }
+        const int32_t ret = fat_read(fh, stream->cache, AP_FILESYSTEM_FATFS_CACHE_SIZE);
+        if (ret < 0) {
+            return -1;
+        }
+        stream->cache_ofs = start;
+        stream->cache_len = ret;
+        cache_stats.read_fills++;
+        if (stream->pos >= start + ret) {
+            // end of file
+            break;
+        }
+    }
+    return total;
+}
+
+static int32_t cache_write(FAT_FILE *stream, const uint8_t *buf, uint32_t count)
+{
+    FIL *fh = &stream->fobj;
+    if (stream->cache_dirty && stream->pos != stream->cache_ofs + stream->cache_len) {
+        // not contiguous with the pending data
+        if (!cache_flush(stream)) {
+            return -1;
+        }
+    }
+    if (!stream->cache_dirty) {
+        // discard read-ahead data, it may be overwritten
+        stream->cache_len = 0;
+    }
+    uint32_t total = 0;
+    while (count > 0) {
+        if (stream->cache_len == 0) {
+            if (count >= AP_FILESYSTEM_FATFS_CACHE_SIZE) {
+                if (!fat_seek(fh, stream->pos)) {
+                    return -1;
+                }
+                const int32_t ret = fat_write(fh, buf, count);
+                if (ret < 0) {
+                    return -1;
+                }
+                stream->pos += ret;
+                total += ret;
+                cache_stats.write_direct++;
+                break;
+            }
+            stream->cache_ofs = stream->pos;
+        }
+        // stop the first block at a sector boundary so later flushes
+        // are whole aligned sectors
+        const uint32_t limit = AP_FILESYSTEM_FATFS_CACHE_SIZE - (stream->cache_ofs & 511U);
+        const uint32_t n = MIN(count, limit - stream->cache_len);
+        memcpy(&stream->cache[stream->cache_len], buf, n);
+        stream->cache_len += n;
+        stream->cache_dirty = true;
+        stream->pos += n;
+        total += n;
+        buf += n;
+        count -= n;
+        cache_stats.write_hits++;
+        if (stream->cache_len == limit) {
+            if (!cache_flush(stream)) {
+                return -1;
+            }
+            stream->cache_len = 0;
+        }
+    }
+    return total;
+}
+#endif // AP_FILESYSTEM_FATFS_CACHE_ENABLED
+
+int32_t AP_Filesystem_FATFS::read(int fd, void *buf, uint32_t count)
+{
+    FS_CHECK_ALLOWED(-1);
+    WITH_SEMAPHORE(sem);
+
+    CHECK_REMOUNT();
+
+    errno = 0;
+
+    FAT_FILE *stream = fileno_to_stream(fd);
+    if (stream == nullptr) { // unknown fd?
+        return -1; // errno already set
+    }
+
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    if (stream->cache != nullptr ||
+        (count < AP_FILESYSTEM_FATFS_CACHE_SIZE && cache_alloc(stream))) {
+        return cache_read(stream, (uint8_t *)buf, count);
+    }
+#endif
+    return fat_read(&stream->fobj, buf, count);
+}
+
+int32_t AP_Filesystem_FATFS::write(int fd, const void *buf, uint32_t count)
+{
+    errno = 0;
+
+    FS_CHECK_ALLOWED(-1);
+    WITH_SEMAPHORE(sem);
+
+    CHECK_REMOUNT();
+
+    FAT_FILE *stream = fileno_to_stream(fd);
+    if (stream == nullptr) { // unknown fd?
+        return -1; // errno already set
+    }
+
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    if (stream->cache != nullptr ||
+        (count < AP_FILESYSTEM_FATFS_CACHE_SIZE && cache_alloc(stream))) {
+        return cache_write(stream, (const uint8_t *)buf, count);
+    }
+#endif
+    return fat_write(&stream->fobj, buf, count);
+}
+
 int AP_Filesystem_FATFS::fsync(int fileno)
 {
     FIL *fh;
@@ -426,10 +664,16 @@ int AP_Filesystem_FATFS::fsync(int fileno)
 
     errno = 0;
 
-    fh = fileno_to_fatfs(fileno);
-    if (fh == nullptr) { // unknown fileno?
+    FAT_FILE *stream = fileno_to_stream(fileno);
+    if (stream == nullptr) { // unknown fileno?
         return -1; // errno already set
     }
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    if (!cache_flush(stream)) {
+        return -1;
+    }
+#endif
+    fh = &stream->fobj;
     res = f_sync(fh);
     if (res != FR_OK) {
         errno = fatfs_to_errno((FRESULT)res);
@@ -447,10 +691,37 @@ off_t AP_Filesystem_FATFS::lseek(int fileno, off_t position, int whence)
     FS_CHECK_ALLOWED(-1);
     WITH_SEMAPHORE(sem);
 
-    fh = fileno_to_fatfs(fileno);
-    if (fh == nullptr) { // unknown fileno?
+    FAT_FILE *stream = fileno_to_stream(fileno);
+    if (stream == nullptr) { // unknown fileno?
         return -1; // errno already set
     }
+    fh = &stream->fobj;
+
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    if (stream->cache != nullptr) {
+        if (!cache_flush(stream)) {
+            return -1;
+        }
+        if (whence == SEEK_END) {
+            position += f_size(fh);
+        } else if (whence==SEEK_CUR) {
+            position += stream->pos;
+        }
+        if (position >= 0 && FSIZE_t(position) <= f_size(fh)) {
+            // FATFS reads the sector when it seeks to the middle of
+            // one, so leave it to the next read or write that needs it
+            stream->pos = position;
+            return position;
+        }
+        res = f_lseek(fh, position);
+        if (res) {
+            errno = fatfs_to_errno(res);
+            return -1;
+        }
+        stream->pos = fh->fptr;
+        return fh->fptr;
+    }
+#endif
 
     if (whence == SEEK_END) {
         position += f_size(fh);
@@ -687,6 +958,40 @@ int AP_Filesystem_FATFS::closedir(void *dirp_void)
     return 0;
 }
 
+/*
+  allocate a contiguous cluster chain for an empty file, so writes
+  don't need to search for and link a new cluster each time they
+  reach the end of one. The recorded file size stays at the data
+  written, and the clusters after it are freed on close
+ */
+bool AP_Filesystem_FATFS::preallocate(int fd, uint32_t size)
+{
+#if FF_USE_EXPAND
+    FS_CHECK_ALLOWED(false);
+    WITH_SEMAPHORE(sem);
+
+    FAT_FILE *stream = fileno_to_stream(fd);
+    if (stream == nullptr) {
+        return false;
+    }
+    FIL *fh = &stream->fobj;
+    // f_expand only works on an empty file. A contiguous exFAT file
+    // has no FAT entries, so can't be written past its recorded size
+    if (fh->obj.objsize != 0 || fh->obj.fs->fs_type == FS_EXFAT) {
+        return false;
+    }
+    if (f_expand(fh, size, 1) != FR_OK) {
+        return false;
+    }
+    // f_write follows the allocated chain as the size grows
+    fh->obj.objsize = 0;
+    stream->preallocated = size;
+    return true;
+#else
+    return false;
+#endif
+}
+
 // return number of bytes that should be written before fsync for optimal
 // streaming performance/robustness. if zero, any number can be written.
 // assume similar to old logging code that max-IO-size boundaries are good.
@@ -695,14 +1000,19 @@ uint32_t AP_Filesystem_FATFS::bytes_until_fsync(int fd)
     FS_CHECK_ALLOWED(0);
     WITH_SEMAPHORE(sem);
 
-    FIL *fh = fileno_to_fatfs(fd);
-    if (fh == nullptr) { // unknown fd?
+    FAT_FILE *stream = fileno_to_stream(fd);
+    if (stream == nullptr) { // unknown fd?
         return 0; // return "any number", the write/fsync will fail anyway
     }
 
     const uint32_t block_size = MAX_IO_SIZE;
 
-    uint32_t block_pos = fh->fptr % block_size;
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    const FSIZE_t pos = stream->cache != nullptr ? stream->pos : stream->fobj.fptr;
+#else
+    const FSIZE_t pos = stream->fobj.fptr;
+#endif
+    uint32_t block_pos = pos % block_size;
     return block_size - block_pos;
 }
 
@@ -861,6 +1171,30 @@ AP_Filesystem_Backend::FormatStatus AP_Filesystem_FATFS::get_format_status(void)
     return format_status;
 }
 
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+// report file cache counters
+void AP_Filesystem_FATFS::cache_info(ExpandingString &str)
+{
+    WITH_SEMAPHORE(sem);
+    uint8_t allocated = 0;
+    for (uint8_t i=0; i<MAX_FILES; i++) {
+        if (file_table[i] != nullptr && file_table[i]->cache != nullptr) {
+            allocated++;
+        }
+    }
+    str.printf("CacheSize: %u\n", unsigned(AP_FILESYSTEM_FATFS_CACHE_SIZE));
+    str.printf("Allocated: %u AllocFail: %u\n", unsigned(allocated), unsigned(cache_stats.alloc_fails));
+    str.printf("Read Hit: %u Fill: %u Direct: %u\n",
+               unsigned(cache_stats.read_hits),
+               unsigned(cache_stats.read_fills),
+               unsigned(cache_stats.read_direct));
+    str.printf("Write Hit: %u Flush: %u Direct: %u\n",
+               unsigned(cache_stats.write_hits),
+               unsigned(cache_stats.write_flushes),
+               unsigned(cache_stats.write_direct));
+}
+#endif
+
 /*
   convert POSIX errno to text with user message.
 */
@@ -11,6 +11,8 @@
 #include <stddef.h>
 #include "AP_Filesystem_backend.h"
 
+class ExpandingString;
+
 #if AP_FILESYSTEM_FATFS_ENABLED
 
 // Seek offset macros
@@ -38,6 +40,9 @@ public:
 
     uint32_t bytes_until_fsync(int fd) override;
 
+    // allocate a contiguous cluster chain for an empty file
+    bool preallocate(int fd, uint32_t size) override;
+
     // return free disk space in bytes, -1 on error
     int64_t disk_free(const char *path) override;
 
@@ -57,6 +62,11 @@ public:
     bool format(void) override;
     AP_Filesystem_Backend::FormatStatus get_format_status() const override;
 
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    // report file cache counters
+    static void cache_info(ExpandingString &str);
+#endif
+
 private:
     void format_handler(void);
     FormatStatus format_status;
@@ -24,9 +24,11 @@
 #include "AP_Filesystem_Param.h"
 #include <AP_Param/AP_Param.h>
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
 #include <ctype.h>
 
 #define PACKED_NAME "param.pck"
+#define CRC_NAME "param.crc"
 
 extern const AP_HAL::HAL& hal;
 
@@ -53,6 +55,29 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
         return -1;
     }
     struct rfile &r = file[idx];
+    if (is_crc_file(fname)) {
+        if (!read_only) {
+            errno = EROFS;
+            return -1;
+        }
+        uint16_t block_size = default_crc_block_size;
+        const char *q = strstr(fname, "?block=");
+        if (q != nullptr) {
+            const uint32_t v = strtoul(q+7, nullptr, 10);
+            if (v == 0 || v >= UINT16_MAX) {
+                errno = EINVAL;
+                return -1;
+            }
+            block_size = v;
+        }
+        memset(&r, 0, sizeof(r));
+        if (!crc_file_init(r, block_size)) {
+            errno = ENOMEM;
+            return -1;
+        }
+        r.open = true;
+        return idx;
+    }
     if (read_only) {
         r.cursors = NEW_NOTHROW cursor[num_cursors];
         if (r.cursors == nullptr) {
@@ -68,6 +93,7 @@ int AP_Filesystem_Param::open(const char *fname, int flags, bool allow_absolute_
     r.read_size = 0;
     r.file_size = 0;
     r.writebuf = nullptr;
+    r.crcdata = nullptr;
     if (!read_only) {
         // setup for upload
         r.writebuf = NEW_NOTHROW ExpandingString();
@@ -144,9 +170,80 @@ int AP_Filesystem_Param::close(int fd)
     r.cursors = nullptr;
     delete r.writebuf;
     r.writebuf = nullptr;
+    delete [] r.crcdata;
+    r.crcdata = nullptr;
     return ret;
 }
 
+/*
+  param.crc format:
+    uint16_t magic = 0x671d
+    uint16_t total_params
+    uint16_t block_size     // parameters per block
+    uint16_t num_blocks
+    uint32_t crc            // CRC of all parameters
+    uint32_t block_crc[num_blocks]
+
+  The CRCs are CRC32 (as zlib) over each parameter's name, a zero
+  byte, its type and its value as it is sent in param.pck, in the
+  order of param.pck. Block N covers the parameters downloaded with
+  param.pck?start=N*block_size&count=block_size, so a GCS holding an
+  earlier download can skip the download if the CRC matches, or
+  fetch only the blocks whose CRC has changed.
+
+  Parameters can be changed without being saved, so there is no
+  reliable notification of a change and the CRCs are calculated each
+  time the file is opened. This is one pass over the parameters,
+  much less work than packing them for download.
+ */
+bool AP_Filesystem_Param::crc_file_init(struct rfile &r, uint16_t block_size)
+{
+    struct crc_header hdr;
+    hdr.total_params = AP_Param::count_parameters();
+    hdr.block_size = block_size;
+    hdr.num_blocks = (hdr.total_params + block_size - 1) / block_size;
+    r.file_size = sizeof(hdr) + hdr.num_blocks * sizeof(uint32_t);
+    r.crcdata = NEW_NOTHROW uint8_t[r.file_size];
+    if (r.crcdata == nullptr) {
+        return false;
+    }
+
+    uint32_t *block_crc = (uint32_t *)&r.crcdata[sizeof(hdr)];
+    uint32_t crc = 0xFFFFFFFF;
+    uint32_t bcrc = 0xFFFFFFFF;
+    uint16_t idx = 0;
+    AP_Param::ParamToken token;
+    enum ap_var_type ptype;
+    for (AP_Param *ap = AP_Param::first(&token, &ptype);
+         ap != nullptr && idx < hdr.num_blocks * block_size;
+         ap = AP_Param::next_scalar(&token, &ptype)) {
+        uint8_t buf[AP_MAX_NAME_SIZE+1+1+4] {};
+        ap->copy_name_token(token, (char *)buf, AP_MAX_NAME_SIZE, true);
+        const uint8_t name_len = strnlen((const char *)buf, AP_MAX_NAME_SIZE);
+        buf[name_len+1] = uint8_t(ptype);
+        const uint8_t type_len = AP_Param::type_size(ptype);
+        memcpy(&buf[name_len+2], ap, type_len);
+        const uint8_t len = name_len + 2 + type_len;
+        crc = crc_crc32(crc, buf, len);
+        bcrc = crc_crc32(bcrc, buf, len);
+        idx++;
+        if (idx % block_size == 0) {
+            block_crc[idx/block_size-1] = bcrc ^ 0xFFFFFFFF;
+            bcrc = 0xFFFFFFFF;
+        }
+    }
+    if (idx % block_size != 0) {
+        block_crc[idx/block_size] = bcrc ^ 0xFFFFFFFF;
+    }
+    // the count may have been wrong; report what was found
+    hdr.total_params = idx;
+    hdr.num_blocks = (idx + block_size - 1) / block_size;
+    r.file_size = sizeof(hdr) + hdr.num_blocks * sizeof(uint32_t);
+    hdr.crc = crc ^ 0xFFFFFFFF;
+    memcpy(r.crcdata, &hdr, sizeof(hdr));
+    return true;
+}
+
 /*
   packed format:
     file header:
@@ -333,6 +430,15 @@ int32_t AP_Filesystem_Param::read(int fd, void *buf, uint32_t count)
         errno = EINVAL;
         return -1;
     }
+    if (r.crcdata != nullptr) {
+        if (r.file_ofs >= r.file_size) {
+            return 0;
+        }
+        count = MIN(count, r.file_size - r.file_ofs);
+        memcpy(buf, &r.crcdata[r.file_ofs], count);
+        r.file_ofs += count;
+        return count;
+    }
     size_t header_total = 0;
 
     /*
@@ -478,6 +584,11 @@ int AP_Filesystem_Param::stat(const char *name, struct stat *stbuf)
         return -1;
     }
     memset(stbuf, 0, sizeof(*stbuf));
+    if (is_crc_file(name)) {
+        const uint16_t num_blocks = (AP_Param::count_parameters() + default_crc_block_size - 1) / default_crc_block_size;
+        stbuf->st_size = sizeof(struct crc_header) + num_blocks * sizeof(uint32_t);
+        return 0;
+    }
     // give size estimation to avoid needing to scan entire file
     stbuf->st_size = AP_Param::count_parameters() * 12;
     return 0;
@@ -493,7 +604,14 @@ bool AP_Filesystem_Param::check_file_name(const char *name)
         (name[packed_len] == 0 || name[packed_len] == '?')) {
         return true;
     }
-    return false;
+    return is_crc_file(name);
+}
+
+bool AP_Filesystem_Param::is_crc_file(const char *name) const
+{
+    const uint8_t crc_len = strlen(CRC_NAME);
+    return strncmp(name, CRC_NAME, crc_len) == 0 &&
+        (name[crc_len] == 0 || name[crc_len] == '?');
 }
 
 /*
@@ -49,6 +49,20 @@ private:
     // Support both protocol versions
     static constexpr uint16_t pmagic = 0x671b;
     static constexpr uint16_t pmagic_with_default = 0x671c;
+    // magic of the param.crc file
+    static constexpr uint16_t pmagic_crc = 0x671d;
+
+    // default number of parameters covered by each block CRC
+    static constexpr uint16_t default_crc_block_size = 32;
+
+    // header at front of the param.crc file
+    struct PACKED crc_header {
+        uint16_t magic = pmagic_crc;
+        uint16_t total_params;
+        uint16_t block_size;
+        uint16_t num_blocks;
+        uint32_t crc;
+    };
 
     // header at front of the file
     struct header {
@@ -76,11 +90,16 @@ private:
         uint32_t file_size;
         struct cursor *cursors;
         ExpandingString *writebuf; // for upload
+        uint8_t *crcdata;          // contents of param.crc
     } file[max_open_file];
 
     bool token_seek(const struct rfile &r, const uint32_t data_ofs, struct cursor &c);
     uint8_t pack_param(const struct rfile &r, struct cursor &c, uint8_t *buf);
     bool check_file_name(const char *fname);
+    bool is_crc_file(const char *fname) const;
+
+    // fill in the contents of param.crc
+    bool crc_file_init(struct rfile &r, uint16_t block_size);
 
     // finish uploading parameters
     bool finish_upload(const rfile &r);
@@ -36,7 +36,7 @@ int AP_Filesystem_ROMFS::open(const char *fname, int flags, bool allow_absolute_
     WITH_SEMAPHORE(record_sem); // search for free file record
     uint8_t idx;
     for (idx=0; idx<max_open_file; idx++) {
-        if (file[idx].data == nullptr) {
+        if (file[idx].stream == nullptr) {
             break;
         }
     }
@@ -44,41 +44,40 @@ int AP_Filesystem_ROMFS::open(const char *fname, int flags, bool allow_absolute_
         errno = ENFILE;
         return -1;
     }
-    file[idx].data = AP_ROMFS::find_decompress(fname, file[idx].size);
-    if (file[idx].data == nullptr) {
+    // files are decompressed as they are read, so large files don't
+    // need a buffer the size of the whole file
+    file[idx].stream = AP_ROMFS::stream_open(fname, file[idx].size);
+    if (file[idx].stream == nullptr) {
         errno = ENOENT;
         return -1;
     }
-    file[idx].ofs = 0;
     return idx;
 }
 
 int AP_Filesystem_ROMFS::close(int fd)
 {
-    if (fd < 0 || fd >= max_open_file || file[fd].data == nullptr) {
+    if (fd < 0 || fd >= max_open_file || file[fd].stream == nullptr) {
         errno = EBADF;
         return -1;
     }
 
     WITH_SEMAPHORE(record_sem); // release file record
-    AP_ROMFS::free(file[fd].data);
-    file[fd].data = nullptr;
+    AP_ROMFS::stream_close(file[fd].stream);
+    file[fd].stream = nullptr;
     return 0;
 }
 
 int32_t AP_Filesystem_ROMFS::read(int fd, void *buf, uint32_t count)
 {
-    if (fd < 0 || fd >= max_open_file || file[fd].data == nullptr) {
+    if (fd < 0 || fd >= max_open_file || file[fd].stream == nullptr) {
         errno = EBADF;
         return -1;
     }
-    count = MIN(file[fd].size - file[fd].ofs, count);
-    if (count == 0) {
-        return 0;
+    const int32_t ret = AP_ROMFS::stream_read(file[fd].stream, (uint8_t *)buf, count);
+    if (ret < 0) {
+        errno = EIO;
     }
-    memcpy(buf, &file[fd].data[file[fd].ofs], count);
-    file[fd].ofs += count;
-    return count;
+    return ret;
 }
 
 int32_t AP_Filesystem_ROMFS::write(int fd, const void *buf, uint32_t count)
@@ -94,26 +93,35 @@ int AP_Filesystem_ROMFS::fsync(int fd)
 
 int32_t AP_Filesystem_ROMFS::lseek(int fd, int32_t offset, int seek_from)
 {
-    if (fd < 0 || fd >= max_open_file || file[fd].data == nullptr) {
+    if (fd < 0 || fd >= max_open_file || file[fd].stream == nullptr) {
         errno = EBADF;
         return -1;
     }
+    AP_ROMFS::Stream *stream = file[fd].stream;
+    uint32_t ofs;
     switch (seek_from) {
     case SEEK_SET:
         if (offset < 0) {
             errno = EINVAL;
             return -1;
         }
-        file[fd].ofs = MIN(file[fd].size, (uint32_t)offset);
+        ofs = offset;
         break;
     case SEEK_CUR:
-        file[fd].ofs = MIN(file[fd].size, offset+file[fd].ofs);
+        ofs = MAX(int32_t(AP_ROMFS::stream_offset(stream)) + offset, 0);
         break;
     case SEEK_END:
-        file[fd].ofs = file[fd].size;
+        ofs = file[fd].size;
         break;
+    default:
+        ofs = AP_ROMFS::stream_offset(stream);
+        break;
+    }
+    if (!AP_ROMFS::stream_seek(stream, ofs)) {
+        errno = EIO;
+        return -1;
     }
-    return file[fd].ofs;
+    return AP_ROMFS::stream_offset(stream);
 }
 
 int AP_Filesystem_ROMFS::stat(const char *name, struct stat *stbuf)
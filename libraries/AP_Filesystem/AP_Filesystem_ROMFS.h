@@ -20,6 +20,7 @@
 #if AP_FILESYSTEM_ROMFS_ENABLED
 
 #include <AP_HAL/Semaphores.h>
+#include <AP_ROMFS/AP_ROMFS.h>
 
 #include "AP_Filesystem_backend.h"
 
@@ -65,9 +66,8 @@ private:
     static constexpr uint8_t max_open_file = 4;
     static constexpr uint8_t max_open_dir = 4;
     struct rfile {
-        const uint8_t *data;
+        AP_ROMFS::Stream *stream;
         uint32_t size;
-        uint32_t ofs;
     } file[max_open_file];
 
     // allow up to 4 directory opens
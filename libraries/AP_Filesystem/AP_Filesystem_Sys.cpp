@@ -25,7 +25,13 @@
 #include <AP_Math/AP_Math.h>
 #include <AP_CANManager/AP_CANManager.h>
 #include <AP_Scheduler/AP_Scheduler.h>
+#include <AP_Param/AP_Param.h>
 #include <AP_Common/ExpandingString.h>
+#include <AP_Scripting/AP_Scripting.h>
+#include <AP_Common/AP_InitArena.h>
+#include <AP_Common/AP_BootTrace.h>
+#include <AP_Common/AP_CycleTrace.h>
+#include <AP_Networking/AP_Networking.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -36,10 +42,32 @@ struct SysFileList {
 static const SysFileList sysfs_file_list[] = {
     {"threads.txt"},
     {"tasks.txt"},
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+    {"task_hist.txt"},
+#endif
     {"dma.txt"},
     {"memory.txt"},
+#if AP_INIT_ARENA_ENABLED
+    {"mem.txt"},
+#endif
+#if AP_BOOT_TRACE_ENABLED
+    {"boot.txt"},
+#endif
+#if AP_CYCLE_TRACE_ENABLED
+    {"trace.bin"},
+#endif
     {"uarts.txt"},
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    {"sd_cache.txt"},
+#endif
+#if AP_NETWORKING_ENABLED && AP_NETWORKING_LWIP_STATS_ENABLED
+    {"lwip.txt"},
+#endif
     {"timers.txt"},
+    {"param_save.txt"},
+#if AP_SCRIPTING_ENABLED
+    {"scripts.txt"},
+#endif
 #if HAL_MAX_CAN_PROTOCOL_DRIVERS
     {"can_log.txt"},
 #endif
@@ -105,6 +133,11 @@ int AP_Filesystem_Sys::open(const char *fname, int flags, bool allow_absolute_pa
     if (strcmp(fname, "tasks.txt") == 0) {
         AP::scheduler().task_info(*r.str);
     }
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+    if (strcmp(fname, "task_hist.txt") == 0) {
+        AP::scheduler().task_histogram_info(*r.str);
+    }
+#endif
 #endif
     if (strcmp(fname, "dma.txt") == 0) {
         hal.util->dma_info(*r.str);
@@ -112,14 +145,50 @@ int AP_Filesystem_Sys::open(const char *fname, int flags, bool allow_absolute_pa
     if (strcmp(fname, "memory.txt") == 0) {
         hal.util->mem_info(*r.str);
     }
+#if AP_INIT_ARENA_ENABLED
+    if (strcmp(fname, "mem.txt") == 0) {
+        AP::init_arena().info(*r.str);
+    }
+#endif
+#if AP_BOOT_TRACE_ENABLED
+    if (strcmp(fname, "boot.txt") == 0) {
+        AP::boot_trace().info(*r.str);
+    }
+#endif
+#if AP_CYCLE_TRACE_ENABLED
+    if (strcmp(fname, "trace.bin") == 0) {
+        AP::cycle_trace().dump(*r.str);
+    }
+#endif
 #if HAL_UART_STATS_ENABLED
     if (strcmp(fname, "uarts.txt") == 0) {
         hal.util->uart_info(*r.str);
     }
+#endif
+#if AP_FILESYSTEM_FATFS_CACHE_ENABLED
+    if (strcmp(fname, "sd_cache.txt") == 0) {
+        AP_Filesystem_FATFS::cache_info(*r.str);
+    }
+#endif
+#if AP_NETWORKING_ENABLED && AP_NETWORKING_LWIP_STATS_ENABLED
+    if (strcmp(fname, "lwip.txt") == 0) {
+        AP::network().lwip_info(*r.str);
+    }
 #endif
     if (strcmp(fname, "timers.txt") == 0) {
         hal.util->timer_info(*r.str);
     }
+    if (strcmp(fname, "param_save.txt") == 0) {
+        AP_Param::save_info(*r.str);
+    }
+#if AP_SCRIPTING_ENABLED
+    if (strcmp(fname, "scripts.txt") == 0) {
+        AP_Scripting *scripting = AP_Scripting::get_singleton();
+        if (scripting != nullptr) {
+            scripting->scripts_info(*r.str);
+        }
+    }
+#endif
 #if HAL_CANMANAGER_ENABLED
     if (strcmp(fname, "can_log.txt") == 0) {
         AP::can().log_retrieve(*r.str);
@@ -68,6 +68,41 @@ void AP_Filesystem_Backend::unload_file(FileData *fd)
     }
 }
 
+/*
+  map part of a file by reading it into a buffer. The file position
+  is left unchanged, as it would be by a real mapping
+*/
+const uint8_t *AP_Filesystem_Backend::mmap(int fd, uint32_t offset, uint32_t length)
+{
+    if (length == 0) {
+        return nullptr;
+    }
+    const int32_t pos = lseek(fd, 0, SEEK_CUR);
+    if (pos == -1) {
+        return nullptr;
+    }
+    uint8_t *data = (uint8_t *)malloc(length);
+    if (data == nullptr) {
+        return nullptr;
+    }
+    const bool ok = lseek(fd, offset, SEEK_SET) == int32_t(offset) &&
+                    read(fd, data, length) == int32_t(length);
+    lseek(fd, pos, SEEK_SET);
+    if (!ok) {
+        free(data);
+        return nullptr;
+    }
+    return data;
+}
+
+/*
+  unmap data from mmap()
+*/
+void AP_Filesystem_Backend::munmap(const uint8_t *ptr, uint32_t length)
+{
+    free(const_cast<uint8_t *>(ptr));
+}
+
 // return true if file operations are allowed
 bool AP_Filesystem_Backend::file_op_allowed(void) const
 {
@@ -63,6 +63,24 @@ public:
     // streaming performance/robustness. if zero, any number can be written.
     virtual uint32_t bytes_until_fsync(int fd) { return 0; }
 
+    // reserve size bytes from the start of a file without changing its
+    // size, so later writes don't have to allocate. Returns false if
+    // not supported
+    virtual bool preallocate(int fd, uint32_t size) { return false; }
+
+    // start writing count bytes at offset to the disk, and wait for
+    // everything before offset to be written, so data is streamed out
+    // instead of being flushed in large bursts
+    virtual void writeback(int fd, uint32_t offset, uint32_t count) {}
+
+    // map length bytes of an open file starting at offset for
+    // reading, returning nullptr on failure. The default reads the
+    // data into an allocated buffer, backends that can map the file
+    // directly override this and return true from mmap_zero_copy()
+    virtual const uint8_t *mmap(int fd, uint32_t offset, uint32_t length);
+    virtual void munmap(const uint8_t *ptr, uint32_t length);
+    virtual bool mmap_zero_copy(void) const { return false; }
+
     // return free disk space in bytes, -1 on error
     virtual int64_t disk_free(const char *path) { return 0; }
 
@@ -16,6 +16,16 @@
 #define AP_FILESYSTEM_FATFS_ENABLED HAL_OS_FATFS_IO
 #endif
 
+// size of the read-ahead and write-behind cache given to each open
+// FATFS file, 0 to disable
+#ifndef AP_FILESYSTEM_FATFS_CACHE_SIZE
+#define AP_FILESYSTEM_FATFS_CACHE_SIZE (HAL_MEM_CLASS >= HAL_MEM_CLASS_500 ? 4096 : 0)
+#endif
+
+#ifndef AP_FILESYSTEM_FATFS_CACHE_ENABLED
+#define AP_FILESYSTEM_FATFS_CACHE_ENABLED (AP_FILESYSTEM_FATFS_ENABLED && AP_FILESYSTEM_FATFS_CACHE_SIZE > 0)
+#endif
+
 #ifndef AP_FILESYSTEM_LITTLEFS_ENABLED
 #define AP_FILESYSTEM_LITTLEFS_ENABLED HAL_OS_LITTLEFS_IO
 #endif
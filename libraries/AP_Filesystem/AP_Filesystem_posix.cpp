@@ -34,6 +34,10 @@
 #include <utime.h>
 #endif
 
+#if AP_FILESYSTEM_POSIX_HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 extern const AP_HAL::HAL& hal;
 
 /*
@@ -125,6 +129,61 @@ int AP_Filesystem_Posix::fsync(int fd)
 #endif
 }
 
+bool AP_Filesystem_Posix::preallocate(int fd, uint32_t size)
+{
+#if AP_FILESYSTEM_POSIX_HAVE_FALLOCATE
+    FS_CHECK_ALLOWED(false);
+    // keep the size so readers never see the space not yet written
+    return ::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, size) == 0;
+#else
+    return false;
+#endif
+}
+
+void AP_Filesystem_Posix::writeback(int fd, uint32_t offset, uint32_t count)
+{
+#if AP_FILESYSTEM_POSIX_HAVE_FALLOCATE
+    FS_CHECK_ALLOWED();
+    // start writing the new data now rather than when the kernel
+    // decides to flush a large number of dirty pages at once
+    ::sync_file_range(fd, offset, count, SYNC_FILE_RANGE_WRITE);
+    if (offset > 0) {
+        // the earlier data was started by the previous call, so this
+        // wait is short. Once written it is dropped from the page
+        // cache as it won't be read again
+        ::sync_file_range(fd, 0, offset, SYNC_FILE_RANGE_WAIT_BEFORE|SYNC_FILE_RANGE_WRITE|SYNC_FILE_RANGE_WAIT_AFTER);
+        ::posix_fadvise(fd, 0, offset, POSIX_FADV_DONTNEED);
+    }
+#endif
+}
+
+#if AP_FILESYSTEM_POSIX_HAVE_MMAP
+const uint8_t *AP_Filesystem_Posix::mmap(int fd, uint32_t offset, uint32_t length)
+{
+    FS_CHECK_ALLOWED(nullptr);
+    // touching a mapped page past the end of the file raises SIGBUS
+    struct stat st;
+    if (length == 0 || ::fstat(fd, &st) != 0 || uint64_t(offset) + length > uint64_t(st.st_size)) {
+        return nullptr;
+    }
+    // the mapping has to start on a page boundary
+    const uint32_t page_mask = uint32_t(::sysconf(_SC_PAGESIZE)) - 1;
+    const uint32_t delta = offset & page_mask;
+    void *p = ::mmap(nullptr, length + delta, PROT_READ, MAP_SHARED, fd, offset - delta);
+    if (p == MAP_FAILED) {
+        return nullptr;
+    }
+    return (const uint8_t *)p + delta;
+}
+
+void AP_Filesystem_Posix::munmap(const uint8_t *ptr, uint32_t length)
+{
+    const uint32_t page_mask = uint32_t(::sysconf(_SC_PAGESIZE)) - 1;
+    const uint32_t delta = uintptr_t(ptr) & page_mask;
+    ::munmap(const_cast<uint8_t *>(ptr - delta), length + delta);
+}
+#endif
+
 int32_t AP_Filesystem_Posix::lseek(int fd, int32_t offset, int seek_from)
 {
     FS_CHECK_ALLOWED(-1);
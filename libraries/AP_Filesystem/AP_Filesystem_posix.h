@@ -37,6 +37,14 @@
 #define AP_FILESYSTEM_POSIX_HAVE_FSYNC 1
 #endif
 
+#ifndef AP_FILESYSTEM_POSIX_HAVE_FALLOCATE
+#define AP_FILESYSTEM_POSIX_HAVE_FALLOCATE defined(__linux__)
+#endif
+
+#ifndef AP_FILESYSTEM_POSIX_HAVE_MMAP
+#define AP_FILESYSTEM_POSIX_HAVE_MMAP (CONFIG_HAL_BOARD != HAL_BOARD_QURT)
+#endif
+
 #ifndef AP_FILESYSTEM_POSIX_HAVE_STATFS
 #define AP_FILESYSTEM_POSIX_HAVE_STATFS 1
 #endif
@@ -54,6 +62,13 @@ public:
     int32_t read(int fd, void *buf, uint32_t count) override;
     int32_t write(int fd, const void *buf, uint32_t count) override;
     int fsync(int fd) override;
+    bool preallocate(int fd, uint32_t size) override;
+    void writeback(int fd, uint32_t offset, uint32_t count) override;
+#if AP_FILESYSTEM_POSIX_HAVE_MMAP
+    const uint8_t *mmap(int fd, uint32_t offset, uint32_t length) override;
+    void munmap(const uint8_t *ptr, uint32_t length) override;
+    bool mmap_zero_copy(void) const override { return true; }
+#endif
     int32_t lseek(int fd, int32_t offset, int whence) override;
     int stat(const char *pathname, struct stat *stbuf) override;
     int unlink(const char *pathname) override;
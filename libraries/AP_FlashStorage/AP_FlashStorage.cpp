@@ -258,6 +258,35 @@ bool AP_FlashStorage::write(uint16_t offset, uint16_t length)
     return true;
 }
 
+/*
+  return true if the other sector holds old data, so a switch will
+  need an erase, and the current sector is more than used_pct full
+ */
+bool AP_FlashStorage::needs_compact(uint8_t used_pct) const
+{
+    if (write_error || reserved_space == 0) {
+        // the other sector is available, no erase needed to switch
+        return false;
+    }
+    const uint32_t usable = flash_sector_size - reserved_space;
+    return write_offset * 100U > usable * used_pct;
+}
+
+/*
+  compact into the other sector ahead of time
+ */
+bool AP_FlashStorage::compact(uint8_t used_pct)
+{
+    if (!needs_compact(used_pct)) {
+        return true;
+    }
+    if (!flash_erase_ok()) {
+        return false;
+    }
+    debug("compacting at write_offset=%u\n", unsigned(write_offset));
+    return switch_full_sector();
+}
+
 /*
   load all data from a flash sector into mem_buffer
  */
@@ -130,6 +130,16 @@ public:
     // write some data to storage from mem_buffer
     bool write(uint16_t offset, uint16_t length) WARN_IF_UNUSED;
 
+    // if the other sector holds old data and the current sector is
+    // more than used_pct full then write everything out and erase the
+    // other sector. Should only be called when safe to have CPU
+    // offline for an erase. Doing this ahead of time means writes
+    // later on, when an erase is not allowed, can fill a whole sector
+    bool compact(uint8_t used_pct) WARN_IF_UNUSED;
+
+    // return true if compact() would need to erase a sector
+    bool needs_compact(uint8_t used_pct) const;
+
     // fixed storage size
     static const uint16_t storage_size = HAL_STORAGE_SIZE;
     
@@ -55,6 +55,12 @@ extern const AP_HAL::HAL& hal;
 
 #define AP_FOLLOW_POS_P_DEFAULT 0.1f    // position error gain default
 
+// track filter gains, applied to each received sample
+#define AP_FOLLOW_TRACK_POS_GAIN    0.5f    // fraction of the position error corrected
+#define AP_FOLLOW_TRACK_VEL_GAIN    0.5f    // fraction of the velocity error corrected
+#define AP_FOLLOW_TRACK_ACCEL_GAIN  0.2f    // fraction of the implied acceleration error corrected
+#define AP_FOLLOW_TRACK_DT_MIN      0.05f   // minimum sample interval used to derive velocity and acceleration (s)
+
 #if APM_BUILD_TYPE(APM_BUILD_ArduPlane)
  #define AP_FOLLOW_ALT_TYPE_DEFAULT 0
  #define AP_FOLLOW_DIST_MAX_DEFAULT 0
@@ -160,7 +166,7 @@ const AP_Param::GroupInfo AP_Follow::var_info[] = {
     // @Param: _OPTIONS
     // @DisplayName: Follow options
     // @Description: Follow options bitmask
-    // @Values: 0:None,1: Mount Follows lead vehicle on mode enter
+    // @Bitmask: 0:Mount Follows lead vehicle on mode enter,1:Use lead vehicle acceleration filtered from its track
     // @User: Standard
     AP_GROUPINFO("_OPTIONS", 11, AP_Follow, _options, 0),
 
@@ -489,6 +495,11 @@ void AP_Follow::handle_msg(const mavlink_message_t &msg)
         _using_follow_target = false; // reset follow-target usage flag
     }
 
+#if AP_FOLLOW_TRACKS_ENABLED
+    // track every vehicle, not only the one we follow
+    update_tracks(msg);
+#endif
+
     if (!should_handle_message(msg)) {
         // ignore message if filtering rules reject it (e.g., wrong sysid)
         return;
@@ -611,25 +622,10 @@ bool AP_Follow::handle_global_position_int_message(const mavlink_message_t &msg)
         return false;
     }
 
-    Location _target_location;
-    _target_location.lat = packet.lat;
-    _target_location.lng = packet.lon;
-
-    // set target altitude based on configured altitude type
-    if (_alt_type == AP_FOLLOW_ALTITUDE_TYPE_RELATIVE) {
-        // use relative altitude above home
-        _target_location.set_alt_cm(packet.relative_alt / 10, Location::AltFrame::ABOVE_HOME);
-    } else {
-        // use absolute altitude
-        _target_location.set_alt_cm(packet.alt / 10, Location::AltFrame::ABSOLUTE);
-    }
-
     // convert global location to local NED frame position
-    if (!_target_location.get_vector_from_origin_NEU(_target_pos_ned_m)) {
+    if (!get_pos_NED_m(packet, _target_pos_ned_m)) {
         return false;
     }
-    _target_pos_ned_m.z = -_target_pos_ned_m.z; // convert NEU -> NED
-    _target_pos_ned_m *= 0.01;  // convert from cm to meters
 
     // decode target velocity components (in m/s)
     _target_vel_ned_ms.x = packet.vx * 0.01f; // velocity north
@@ -638,6 +634,14 @@ bool AP_Follow::handle_global_position_int_message(const mavlink_message_t &msg)
 
     // target acceleration not available in GLOBAL_POSITION_INT
     _target_accel_ned_mss.zero();
+#if AP_FOLLOW_TRACKS_ENABLED
+    if (option_is_enabled(Option::TRACK_ACCEL)) {
+        const Track *track = find_track(msg.sysid);
+        if (track != nullptr && track->valid) {
+            _target_accel_ned_mss = track->accel_ned_mss;
+        }
+    }
+#endif
 
     if (packet.hdg <= 36000) {
         // valid heading field available (in centi-degrees)
@@ -681,26 +685,10 @@ bool AP_Follow::handle_follow_target_message(const mavlink_message_t &msg)
         return false;
     }
 
-    // build Location object from latitude, longitude, and altitude (alt in meters)
-    const Location _target_location {
-        packet.lat,
-        packet.lon,
-        int32_t(packet.alt * 100),  // convert meters to centimeters
-        Location::AltFrame::ABSOLUTE
-    };
-
     // convert global location to local NED frame position
-    if (!_target_location.get_vector_from_origin_NEU(_target_pos_ned_m)) {
-        return false;
-    }
-    _target_pos_ned_m *= 0.01; // convert from cm to meters
-
-    // adjust Z coordinate to NED frame (NEU altitude -> NED)
-    Location origin;
-    if (!AP::ahrs().get_origin(origin)) {
+    if (!get_pos_NED_m(packet, _target_pos_ned_m)) {
         return false;
     }
-    _target_pos_ned_m.z = -packet.alt + origin.alt * 0.01;
 
     // decode velocity if available (bit 1 of est_capabilities)
     if (packet.est_capabilities & (1<<1)) {
@@ -718,6 +706,14 @@ bool AP_Follow::handle_follow_target_message(const mavlink_message_t &msg)
         _target_accel_ned_mss.z = packet.acc[2]; // acceleration down
     } else {
         _target_accel_ned_mss.zero();
+#if AP_FOLLOW_TRACKS_ENABLED
+        if (option_is_enabled(Option::TRACK_ACCEL)) {
+            const Track *track = find_track(msg.sysid);
+            if (track != nullptr && track->valid) {
+                _target_accel_ned_mss = track->accel_ned_mss;
+            }
+        }
+#endif
     }
 
     // decode attitude if available (bit 3 of est_capabilities)
@@ -761,6 +757,249 @@ bool AP_Follow::handle_follow_target_message(const mavlink_message_t &msg)
     return true;
 }
 
+// Converts the position in a GLOBAL_POSITION_INT message to the NED frame relative to the origin (meters).
+bool AP_Follow::get_pos_NED_m(const mavlink_global_position_int_t &packet, Vector3p &pos_ned_m) const
+{
+    Location target_location;
+    target_location.lat = packet.lat;
+    target_location.lng = packet.lon;
+
+    // set target altitude based on configured altitude type
+    if (_alt_type == AP_FOLLOW_ALTITUDE_TYPE_RELATIVE) {
+        // use relative altitude above home
+        target_location.set_alt_cm(packet.relative_alt / 10, Location::AltFrame::ABOVE_HOME);
+    } else {
+        // use absolute altitude
+        target_location.set_alt_cm(packet.alt / 10, Location::AltFrame::ABSOLUTE);
+    }
+
+    // convert global location to local NED frame position
+    if (!target_location.get_vector_from_origin_NEU(pos_ned_m)) {
+        return false;
+    }
+    pos_ned_m.z = -pos_ned_m.z; // convert NEU -> NED
+    pos_ned_m *= 0.01;  // convert from cm to meters
+
+    return true;
+}
+
+// Converts the position in a FOLLOW_TARGET message to the NED frame relative to the origin (meters).
+bool AP_Follow::get_pos_NED_m(const mavlink_follow_target_t &packet, Vector3p &pos_ned_m) const
+{
+    // build Location object from latitude, longitude, and altitude (alt in meters)
+    const Location target_location {
+        packet.lat,
+        packet.lon,
+        int32_t(packet.alt * 100),  // convert meters to centimeters
+        Location::AltFrame::ABSOLUTE
+    };
+
+    // convert global location to local NED frame position
+    if (!target_location.get_vector_from_origin_NEU(pos_ned_m)) {
+        return false;
+    }
+    pos_ned_m *= 0.01; // convert from cm to meters
+
+    // adjust Z coordinate to NED frame (NEU altitude -> NED)
+    Location origin;
+    if (!AP::ahrs().get_origin(origin)) {
+        return false;
+    }
+    pos_ned_m.z = -packet.alt + origin.alt * 0.01;
+
+    return true;
+}
+
+
+#if AP_FOLLOW_TRACKS_ENABLED
+//==============================================================================
+// Multi-Vehicle Tracking
+//==============================================================================
+
+// Updates the track of the sender of any GLOBAL_POSITION_INT or FOLLOW_TARGET message.
+void AP_Follow::update_tracks(const mavlink_message_t &msg)
+{
+    if (!_enabled || msg.sysid == mavlink_system.sysid) {
+        return;
+    }
+
+    switch (msg.msgid) {
+    case MAVLINK_MSG_ID_GLOBAL_POSITION_INT: {
+        mavlink_global_position_int_t packet;
+        mavlink_msg_global_position_int_decode(&msg, &packet);
+        Vector3p pos_ned_m;
+        if ((packet.lat == 0 && packet.lon == 0) || !get_pos_NED_m(packet, pos_ned_m)) {
+            break;
+        }
+        const Vector3f vel_ned_ms{packet.vx * 0.01f, packet.vy * 0.01f, packet.vz * 0.01f};
+        update_track(msg.sysid, packet.time_boot_ms, false, pos_ned_m, &vel_ned_ms, nullptr);
+        break;
+    }
+    case MAVLINK_MSG_ID_FOLLOW_TARGET: {
+        mavlink_follow_target_t packet;
+        mavlink_msg_follow_target_decode(&msg, &packet);
+        Vector3p pos_ned_m;
+        if ((packet.lat == 0 && packet.lon == 0) ||
+            (packet.est_capabilities & (1<<0)) == 0 ||
+            !get_pos_NED_m(packet, pos_ned_m)) {
+            break;
+        }
+        const Vector3f vel_ned_ms{packet.vel[0], packet.vel[1], packet.vel[2]};
+        const Vector3f accel_ned_mss{packet.acc[0], packet.acc[1], packet.acc[2]};
+        update_track(msg.sysid, packet.timestamp, true, pos_ned_m,
+                     (packet.est_capabilities & (1<<1)) ? &vel_ned_ms : nullptr,
+                     (packet.est_capabilities & (1<<2)) ? &accel_ned_mss : nullptr);
+        break;
+    }
+    }
+}
+
+// Filters a position sample into a vehicle's track. The sample is placed at the sender's
+// jitter-corrected timestamp so link latency and lost packets do not show up as target motion.
+void AP_Follow::update_track(uint8_t sysid, uint32_t offboard_ms, bool follow_target, const Vector3p &pos_ned_m,
+                             const Vector3f *vel_ned_ms, const Vector3f *accel_ned_mss)
+{
+    WITH_SEMAPHORE(_follow_sem);
+
+    Track *track = alloc_track(sysid);
+    if (track == nullptr) {
+        // all slots are held by vehicles we are still hearing from
+        return;
+    }
+
+    // the two messages are timestamped differently, so once FOLLOW_TARGET is seen only it is used
+    if (track->using_follow_target != follow_target) {
+        if (!follow_target) {
+            return;
+        }
+        track->using_follow_target = true;
+        track->valid = false;
+        track->jitter.reset();
+    }
+
+    const uint32_t now_ms = AP_HAL::millis();
+    const uint32_t sample_ms = track->jitter.correct_offboard_timestamp_msec(offboard_ms, now_ms);
+    const float dt = int32_t(sample_ms - track->sample_ms) * 0.001f;
+    if (track->valid && !is_positive(dt)) {
+        // duplicate or reordered sample, e.g. relayed twice over a mesh
+        return;
+    }
+    track->last_update_ms = now_ms;
+
+    if (!track->valid || (dt > AP_FOLLOW_TIMEOUT_MS * 0.001f)) {
+        // initialise from the sample
+        track->pos_ned_m = pos_ned_m;
+        track->vel_ned_ms = (vel_ned_ms != nullptr) ? *vel_ned_ms : Vector3f();
+        track->accel_ned_mss = (accel_ned_mss != nullptr) ? *accel_ned_mss : Vector3f();
+        track->valid = true;
+    } else {
+        // predict the state at the time the sample was taken
+        const Vector3f delta_vel_ms = track->accel_ned_mss * dt;
+        const Vector3p pred_pos_ned_m = track->pos_ned_m + ((track->vel_ned_ms + delta_vel_ms * 0.5f) * dt).topostype();
+        const Vector3f pred_vel_ned_ms = track->vel_ned_ms + delta_vel_ms;
+
+        // correct the prediction toward the sample, using the velocity implied by
+        // the position error if the sender does not report velocity
+        const Vector3f pos_err_m = (pos_ned_m - pred_pos_ned_m).tofloat();
+        const float dt_limited = MAX(dt, AP_FOLLOW_TRACK_DT_MIN);
+        const Vector3f vel_err_ms = (vel_ned_ms != nullptr) ? (*vel_ned_ms - pred_vel_ned_ms) : (pos_err_m / dt_limited);
+        track->pos_ned_m = pred_pos_ned_m + (pos_err_m * AP_FOLLOW_TRACK_POS_GAIN).topostype();
+        track->vel_ned_ms = pred_vel_ned_ms + vel_err_ms * AP_FOLLOW_TRACK_VEL_GAIN;
+
+        if (accel_ned_mss != nullptr) {
+            track->accel_ned_mss = *accel_ned_mss;
+        } else {
+            // acceleration from the velocity error, limited to what the estimate shaping allows
+            track->accel_ned_mss += vel_err_ms * (AP_FOLLOW_TRACK_ACCEL_GAIN / dt_limited);
+            if (is_positive(_accel_max_ne_mss.get())) {
+                track->accel_ned_mss.limit_length_xy(_accel_max_ne_mss);
+            }
+            if (is_positive(_accel_max_d_mss.get())) {
+                track->accel_ned_mss.z = constrain_float(track->accel_ned_mss.z, -_accel_max_d_mss, _accel_max_d_mss);
+            }
+        }
+    }
+    track->sample_ms = sample_ms;
+
+#if HAL_LOGGING_ENABLED
+    Log_Write_FOLT(*track);
+#endif
+}
+
+// Returns the track of a vehicle, or nullptr if it is not tracked.
+const AP_Follow::Track *AP_Follow::find_track(uint8_t sysid) const
+{
+    for (const auto &track : _tracks) {
+        if (track.sysid == sysid) {
+            return &track;
+        }
+    }
+    return nullptr;
+}
+
+// Returns the track of a vehicle, taking a free or stale slot if it is not yet tracked.
+AP_Follow::Track *AP_Follow::alloc_track(uint8_t sysid)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    Track *free_track = nullptr;
+    Track *oldest_track = nullptr;
+    for (auto &track : _tracks) {
+        if (track.sysid == sysid) {
+            return &track;
+        }
+        if ((free_track == nullptr) &&
+            ((track.sysid == 0) || (now_ms - track.last_update_ms > AP_FOLLOW_TIMEOUT_MS))) {
+            free_track = &track;
+        }
+        if ((oldest_track == nullptr) || (now_ms - track.last_update_ms > now_ms - oldest_track->last_update_ms)) {
+            oldest_track = &track;
+        }
+    }
+
+    // always make room for the vehicle we follow
+    if ((free_track == nullptr) && (sysid == _sysid)) {
+        free_track = oldest_track;
+    }
+    if (free_track != nullptr) {
+        free_track->sysid = sysid;
+        free_track->valid = false;
+        free_track->using_follow_target = false;
+        free_track->jitter.reset();
+    }
+    return free_track;
+}
+
+// Retrieves the predicted position and velocity of a tracked vehicle in the NED frame (relative to origin).
+bool AP_Follow::get_track_pos_vel_NED_m(uint8_t sysid, Vector3p &pos_ned_m, Vector3f &vel_ned_ms)
+{
+    WITH_SEMAPHORE(_follow_sem);
+
+    const uint32_t now_ms = AP_HAL::millis();
+    const Track *track = find_track(sysid);
+    if ((track == nullptr) || !track->valid || (now_ms - track->last_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
+        return false;
+    }
+
+    // project forward from when the sample was taken, covering the link latency
+    const float dt = MAX(int32_t(now_ms - track->sample_ms), 0) * 0.001f;
+    const Vector3f delta_vel_ms = track->accel_ned_mss * dt;
+    pos_ned_m = track->pos_ned_m + ((track->vel_ned_ms + delta_vel_ms * 0.5f) * dt).topostype();
+    vel_ned_ms = track->vel_ned_ms + delta_vel_ms;
+
+    return true;
+}
+
+// Retrieves the predicted global location and velocity of a tracked vehicle for LUA bindings.
+bool AP_Follow::get_track_location_and_velocity(uint8_t sysid, Location &loc, Vector3f &vel_ned)
+{
+    Vector3p pos_ned_m;
+    if (!get_track_pos_vel_NED_m(sysid, pos_ned_m, vel_ned)) {
+        return false;
+    }
+    return AP::ahrs().get_location_from_origin_offset_NED(loc, pos_ned_m);
+}
+#endif  // AP_FOLLOW_TRACKS_ENABLED
+
 
 //==============================================================================
 // Offset Initialization and Adjustment Functions
@@ -903,6 +1142,43 @@ void AP_Follow::Log_Write_FOLL()
                                 loc_estimate.alt
                                 );
 }
+
+#if AP_FOLLOW_TRACKS_ENABLED
+// Writes an onboard log message for each update of a vehicle's track.
+void AP_Follow::Log_Write_FOLT(const Track &track)
+{
+    // @LoggerMessage: FOLT
+    // @Description: Follow library tracked vehicle state
+    // @Field: TimeUS: Time since system startup (microseconds)
+    // @Field: SysID: Tracked vehicle's mavlink system id
+    // @Field: PN: Filtered position, North of origin (m)
+    // @Field: PE: Filtered position, East of origin (m)
+    // @Field: PD: Filtered position, Down from origin (m)
+    // @Field: VN: Filtered velocity, North (m/s)
+    // @Field: VE: Filtered velocity, East (m/s)
+    // @Field: VD: Filtered velocity, Down (m/s)
+    // @Field: AN: Filtered acceleration, North (m/s/s)
+    // @Field: AE: Filtered acceleration, East (m/s/s)
+    // @Field: Lag: Time between the sample being taken and received (ms)
+    AP::logger().WriteStreaming("FOLT",
+                                "TimeUS,SysID,PN,PE,PD,VN,VE,VD,AN,AE,Lag",  // labels
+                                "s#mmmnnnoos",    // units
+                                "F-00000000C",    // mults
+                                "QBffffffffH",    // fmt
+                                AP_HAL::micros64(),
+                                track.sysid,
+                                (double)track.pos_ned_m.x,
+                                (double)track.pos_ned_m.y,
+                                (double)track.pos_ned_m.z,
+                                (double)track.vel_ned_ms.x,
+                                (double)track.vel_ned_ms.y,
+                                (double)track.vel_ned_ms.z,
+                                (double)track.accel_ned_mss.x,
+                                (double)track.accel_ned_mss.y,
+                                uint16_t(MIN(track.last_update_ms - track.sample_ms, uint32_t(UINT16_MAX)))
+                                );
+}
+#endif  // AP_FOLLOW_TRACKS_ENABLED
 #endif  // HAL_LOGGING_ENABLED
 
 
@@ -41,7 +41,8 @@ public:
 
     // enum for FOLLOW_OPTIONS parameter
     enum class Option {
-        MOUNT_FOLLOW_ON_ENTER = 1
+        MOUNT_FOLLOW_ON_ENTER = 1,
+        TRACK_ACCEL = 2,        // use the target acceleration filtered from its track
     };
 
     // enum for YAW_BEHAVE parameter
@@ -111,6 +112,14 @@ public:
     // Retrieves the distance vector to the target, the distance vector including configured offsets, and the target’s velocity in the NED frame (units: meters).
     bool get_target_dist_and_vel_NED_m(Vector3f &dist_ned, Vector3f &dist_with_ofs, Vector3f &vel_ned);
 
+#if AP_FOLLOW_TRACKS_ENABLED
+    // Retrieves the predicted position and velocity in the NED frame of any tracked vehicle, compensated for link latency.
+    bool get_track_pos_vel_NED_m(uint8_t sysid, Vector3p &pos_ned_m, Vector3f &vel_ned_ms);
+
+    // Retrieves the predicted global location and velocity of any tracked vehicle (for LUA bindings).
+    bool get_track_location_and_velocity(uint8_t sysid, Location &loc, Vector3f &vel_ned);
+#endif
+
     //==========================================================================
     // Accessor Methods
     //==========================================================================
@@ -186,6 +195,39 @@ private:
     bool handle_global_position_int_message(const mavlink_message_t &msg);
     bool handle_follow_target_message(const mavlink_message_t &msg);
 
+    // convert the position in mavlink messages to NED frame relative to the origin (meters)
+    bool get_pos_NED_m(const mavlink_global_position_int_t &packet, Vector3p &pos_ned_m) const;
+    bool get_pos_NED_m(const mavlink_follow_target_t &packet, Vector3p &pos_ned_m) const;
+
+#if AP_FOLLOW_TRACKS_ENABLED
+    // filtered kinematic state of a vehicle sending position messages
+    struct Track {
+        JitterCorrection jitter{500};   // maps the sender's timestamps to ours
+        Vector3p pos_ned_m;             // filtered position at sample_ms (NED frame, meters)
+        Vector3f vel_ned_ms;            // filtered velocity at sample_ms (NED frame, m/s)
+        Vector3f accel_ned_mss;         // filtered acceleration (NED frame, m/s²)
+        uint32_t sample_ms;             // jitter-corrected time the last sample was taken by the sender (ms)
+        uint32_t last_update_ms;        // time the last sample was received (ms)
+        uint8_t sysid;                  // sender's sysid, 0 if the slot is free
+        bool valid;                     // true once the state has been initialised
+        bool using_follow_target;       // true if FOLLOW_TARGET is used in preference to GLOBAL_POSITION_INT
+    } _tracks[AP_FOLLOW_MAX_TRACKS];
+
+    // update the tracks from every position message, whichever vehicle sent it
+    void update_tracks(const mavlink_message_t &msg);
+    void update_track(uint8_t sysid, uint32_t offboard_ms, bool follow_target, const Vector3p &pos_ned_m,
+                      const Vector3f *vel_ned_ms, const Vector3f *accel_ned_mss);
+
+    // returns the track of a vehicle, or nullptr if it is not tracked
+    const Track *find_track(uint8_t sysid) const;
+
+    // returns the track of a vehicle, taking a free or stale slot if it is not tracked
+    Track *alloc_track(uint8_t sysid);
+
+    // write out an onboard-log message for a track update
+    void Log_Write_FOLT(const Track &track);
+#endif
+
     // write out an onboard-log message to help diagnose follow problems:
     void Log_Write_FOLL();
 
@@ -5,3 +5,12 @@
 #ifndef AP_FOLLOW_ENABLED
 #define AP_FOLLOW_ENABLED 1
 #endif
+
+#ifndef AP_FOLLOW_TRACKS_ENABLED
+#define AP_FOLLOW_TRACKS_ENABLED (AP_FOLLOW_ENABLED && HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
+
+// number of vehicles tracked from their position messages
+#ifndef AP_FOLLOW_MAX_TRACKS
+#define AP_FOLLOW_MAX_TRACKS 6
+#endif
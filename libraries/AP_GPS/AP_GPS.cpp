@@ -222,8 +222,8 @@ const AP_Param::GroupInfo AP_GPS::var_info[] = {
 #if AP_GPS_BLENDED_ENABLED
     // @Param: _BLEND_MASK
     // @DisplayName: Multi GPS Blending Mask
-    // @Description: Determines which of the accuracy measures Horizontal position, Vertical Position and Speed are used to calculate the weighting on each GPS receiver when soft switching has been selected by setting GPS_AUTO_SWITCH to 2(Blend)
-    // @Bitmask: 0:Horiz Pos,1:Vert Pos,2:Speed
+    // @Description: Determines which of the accuracy measures Horizontal position, Vertical Position and Speed are used to calculate the weighting on each GPS receiver when soft switching has been selected by setting GPS_AUTO_SWITCH to 2(Blend). Time Align moves each receiver's position along its velocity to the time of the newest data before blending, for receivers with different rates or lags
+    // @Bitmask: 0:Horiz Pos,1:Vert Pos,2:Speed,3:Time Align
     // @User: Advanced
     AP_GROUPINFO("_BLEND_MASK", 20, AP_GPS, _blend_mask, 5),
 
@@ -878,6 +878,9 @@ void AP_GPS::update_instance(uint8_t instance)
         send_blob_update(instance);
     }
 
+    // correction data waiting for space in the port
+    drivers[instance]->send_injected_data();
+
     // we have an active driver for this instance
     bool result = drivers[instance]->read();
     uint32_t tnow = AP_HAL::millis();
@@ -1343,6 +1346,7 @@ void AP_GPS::inject_data(uint8_t instance, const uint8_t *data, uint16_t len)
 {
     if (instance < GPS_MAX_RECEIVERS && drivers[instance] != nullptr) {
         drivers[instance]->inject_data(data, len);
+        timing[instance].last_inject_ms = AP_HAL::millis();
     }
 }
 
@@ -1510,9 +1514,9 @@ void AP_GPS::handle_gps_rtcm_fragment(uint8_t flags, const uint8_t *data, uint8_
         return;
     }
 
-    // see if we need to allocate re-assembly buffer
+    // see if we need to allocate re-assembly buffers
     if (rtcm_buffer == nullptr) {
-        rtcm_buffer = (struct rtcm_buffer *)calloc(1, sizeof(*rtcm_buffer));
+        rtcm_buffer = (struct rtcm_buffer *)calloc(AP_GPS_RTCM_REASSEMBLY_SLOTS, sizeof(*rtcm_buffer));
         if (rtcm_buffer == nullptr) {
             // nothing to do but discard the data
             return;
@@ -1521,34 +1525,63 @@ void AP_GPS::handle_gps_rtcm_fragment(uint8_t flags, const uint8_t *data, uint8_
 
     const uint8_t fragment = (flags >> 1U) & 0x03;
     const uint8_t sequence = (flags >> 3U) & 0x1F;
-    uint8_t* start_of_fragment_in_buffer = &rtcm_buffer->buffer[MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN * (uint16_t)fragment];
-    bool should_clear_previous_fragments = false;
 
-    if (rtcm_buffer->fragments_received) {
-        const bool sequence_nr_changed = rtcm_buffer->sequence != sequence;
-        const bool seen_this_fragment_index = rtcm_buffer->fragments_received & (1U << fragment);
+    /*
+      find the buffer for this sequence number. Blocks arriving over
+      more than one link can interleave, so a new sequence number
+      takes a free buffer, or the one idle for longest, rather than
+      discarding a block that is still being received
+     */
+    const uint32_t now_ms = AP_HAL::millis();
+    struct rtcm_buffer *rb = nullptr;
+    struct rtcm_buffer *oldest = nullptr;
+    for (uint8_t i=0; i<AP_GPS_RTCM_REASSEMBLY_SLOTS; i++) {
+        struct rtcm_buffer &b = rtcm_buffer[i];
+        if (b.fragments_received != 0 && now_ms - b.last_fragment_ms > 1000) {
+            // too old to complete, and the sequence number may have
+            // wrapped around to it again
+            rtcm_stats.fragments_discarded += __builtin_popcount(b.fragments_received);
+            b.fragment_count = 0;
+            b.fragments_received = 0;
+        }
+        if (b.fragments_received != 0 && b.sequence == sequence) {
+            rb = &b;
+            break;
+        }
+        if (oldest == nullptr ||
+            (b.fragments_received == 0 && oldest->fragments_received != 0) ||
+            ((b.fragments_received == 0) == (oldest->fragments_received == 0) && b.last_fragment_ms < oldest->last_fragment_ms)) {
+            oldest = &b;
+        }
+    }
+    if (rb == nullptr) {
+        rb = oldest;
+        if (rb->fragments_received != 0) {
+            // discard the partial block
+            rtcm_stats.fragments_discarded += __builtin_popcount(rb->fragments_received);
+            rb->fragment_count = 0;
+            rb->fragments_received = 0;
+        }
+    }
+    rb->last_fragment_ms = now_ms;
+
+    uint8_t* start_of_fragment_in_buffer = &rb->buffer[MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN * (uint16_t)fragment];
 
+    if (rb->fragments_received & (1U << fragment)) {
         // check whether this is a duplicate fragment. If it is, we can
         // return early.
-        if (!sequence_nr_changed && seen_this_fragment_index && !memcmp(start_of_fragment_in_buffer, data, len)) {
+        if (!memcmp(start_of_fragment_in_buffer, data, len)) {
             return;
         }
-
-        // not a duplicate
-        should_clear_previous_fragments = sequence_nr_changed || seen_this_fragment_index;
-    }
-
-    if (should_clear_previous_fragments) {
-        // we have one or more partial fragments already received
-        // which conflict with the new fragment, discard previous fragments
-        rtcm_buffer->fragment_count = 0;
-        rtcm_stats.fragments_discarded += __builtin_popcount(rtcm_buffer->fragments_received);
-        rtcm_buffer->fragments_received = 0;
+        // not a duplicate, the previous fragments conflict with it
+        rb->fragment_count = 0;
+        rtcm_stats.fragments_discarded += __builtin_popcount(rb->fragments_received);
+        rb->fragments_received = 0;
     }
 
     // add this fragment
-    rtcm_buffer->sequence = sequence;
-    rtcm_buffer->fragments_received |= (1U << fragment);
+    rb->sequence = sequence;
+    rb->fragments_received |= (1U << fragment);
 
     // copy the data
     memcpy(start_of_fragment_in_buffer, data, len);
@@ -1558,23 +1591,23 @@ void AP_GPS::handle_gps_rtcm_fragment(uint8_t flags, const uint8_t *data, uint8_
     // block of RTCM data of an exact multiple of the buffer size you
     // need to send a final packet of zero length
     if (len < MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN) {
-        rtcm_buffer->fragment_count = fragment+1;
-        rtcm_buffer->total_length = (MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*fragment) + len;
-    } else if (rtcm_buffer->fragments_received == 0x0F) {
+        rb->fragment_count = fragment+1;
+        rb->total_length = (MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*fragment) + len;
+    } else if (rb->fragments_received == 0x0F) {
         // special case of 4 full fragments
-        rtcm_buffer->fragment_count = 4;
-        rtcm_buffer->total_length = MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*4;
+        rb->fragment_count = 4;
+        rb->total_length = MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*4;
     }
 
 
     // see if we have all fragments
-    if (rtcm_buffer->fragment_count != 0 &&
-        rtcm_buffer->fragments_received == (1U << rtcm_buffer->fragment_count) - 1) {
+    if (rb->fragment_count != 0 &&
+        rb->fragments_received == (1U << rb->fragment_count) - 1) {
         // we have them all, inject
-        rtcm_stats.fragments_used += __builtin_popcount(rtcm_buffer->fragments_received);
-        inject_data(rtcm_buffer->buffer, rtcm_buffer->total_length);
-        rtcm_buffer->fragment_count = 0;
-        rtcm_buffer->fragments_received = 0;
+        rtcm_stats.fragments_used += __builtin_popcount(rb->fragments_received);
+        inject_data(rb->buffer, rb->total_length);
+        rb->fragment_count = 0;
+        rb->fragments_received = 0;
     }
 }
 
@@ -1941,7 +1974,9 @@ void AP_GPS::Write_GPS(uint8_t i)
         delta_ms      : last_message_delta_time_ms(i),
         alt_ellipsoid : alt_ellipsoid,
         rtcm_fragments_used: rtcm_stats.fragments_used,
-        rtcm_fragments_discarded: rtcm_stats.fragments_discarded
+        rtcm_fragments_discarded: rtcm_stats.fragments_discarded,
+        rtcm_dropped  : drivers[i] != nullptr ? drivers[i]->inject_dropped() : uint16_t(0),
+        rtcm_age_ms   : timing[i].last_inject_ms != 0 ? uint16_t(MIN(AP_HAL::millis() - timing[i].last_inject_ms, UINT16_MAX)) : uint16_t(UINT16_MAX)
     };
     AP::logger().WriteBlock(&pkt2, sizeof(pkt2));
 }
@@ -664,6 +664,9 @@ private:
         // count of delayed frames
         uint8_t delayed_count;
 
+        // the time correction data was last injected in system milliseconds
+        uint32_t last_inject_ms;
+
         // the average time delta
         float average_delta_ms;
     };
@@ -731,12 +734,14 @@ private:
               2 bits for fragment number
               5 bits for sequence number
 
-      The rtcm_buffer is allocated on first use. Once a block of data
-      is successfully reassembled it is injected into all active GPS
-      backends. This assumes we don't want more than 4*180=720 bytes
-      in a RTCM data block
+      AP_GPS_RTCM_REASSEMBLY_SLOTS buffers are allocated on first use,
+      so blocks with different sequence numbers can be received at the
+      same time. Once a block of data is successfully reassembled it is
+      injected into all active GPS backends. This assumes we don't want
+      more than 4*180=720 bytes in a RTCM data block
      */
     struct rtcm_buffer {
+        uint32_t last_fragment_ms;
         uint8_t fragments_received;
         uint8_t sequence;
         uint8_t fragment_count;
@@ -8,6 +8,7 @@
 #define BLEND_MASK_USE_HPOS_ACC     1
 #define BLEND_MASK_USE_VPOS_ACC     2
 #define BLEND_MASK_USE_SPD_ACC      4
+#define BLEND_MASK_TIME_ALIGN       8
 
 #define BLEND_COUNTER_FAILURE_INCREMENT 10
 
@@ -225,6 +226,29 @@ void AP_GPS_Blended::calc_state(void)
     _blended_antenna_offset.zero();
     _blended_lag_sec = 0;
 
+    /*
+      with time alignment each receiver is moved along its velocity
+      to the time the newest data is valid for, so receivers running
+      at different rates and lags don't make the blend jitter
+     */
+    const bool time_align = (gps._blend_mask & BLEND_MASK_TIME_ALIGN) != 0;
+    uint32_t target_ms = 0;
+    bool have_target = false;
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        _align[i].lag_sec = 0;
+        gps.get_lag(i, _align[i].lag_sec);
+        _align[i].valid_ms = gps.timing[i].last_message_time_ms - uint32_t(_align[i].lag_sec * 1000);
+        if (_blend_weights[i] > 0.0f &&
+            (!have_target || int32_t(_align[i].valid_ms - target_ms) > 0)) {
+            target_ms = _align[i].valid_ms;
+            have_target = true;
+        }
+    }
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        // limit the prediction, as data that old won't be blended
+        _align[i].dt_ms = (time_align && _blend_weights[i] > 0.0f) ? MIN(target_ms - _align[i].valid_ms, 1000U) : 0;
+    }
+
 #if HAL_LOGGING_ENABLED
     const uint32_t last_blended_message_time_ms = timing.last_message_time_ms;
 #endif
@@ -303,6 +327,19 @@ void AP_GPS_Blended::calc_state(void)
      * This will be statistically the most likely location, but will be not stable enough for direct use by the autopilot.
     */
 
+    // location of each receiver at the blend time
+    Location locations[GPS_MAX_RECEIVERS];
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        locations[i] = gps.state[i].location;
+        if (_align[i].dt_ms > 0) {
+            const float dt = _align[i].dt_ms * 0.001f;
+            locations[i].offset(gps.state[i].velocity.x * dt, gps.state[i].velocity.y * dt);
+            if (gps.state[i].have_vertical_velocity) {
+                locations[i].alt -= int32_t(gps.state[i].velocity.z * dt * 100);
+            }
+        }
+    }
+
     // Use the GPS with the highest weighting as the reference position
     float best_weight = 0.0f;
     uint8_t best_index = 0;
@@ -310,7 +347,7 @@ void AP_GPS_Blended::calc_state(void)
         if (_blend_weights[i] > best_weight) {
             best_weight = _blend_weights[i];
             best_index = i;
-            state.location = gps.state[i].location;
+            state.location = locations[i];
         }
     }
 
@@ -320,8 +357,8 @@ void AP_GPS_Blended::calc_state(void)
     blended_NE_offset_m.zero();
     for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
         if (_blend_weights[i] > 0.0f && i != best_index) {
-            blended_NE_offset_m += state.location.get_distance_NE(gps.state[i].location) * _blend_weights[i];
-            blended_alt_offset_cm += (float)(gps.state[i].location.alt - state.location.alt) * _blend_weights[i];
+            blended_NE_offset_m += state.location.get_distance_NE(locations[i]) * _blend_weights[i];
+            blended_alt_offset_cm += (float)(locations[i].alt - state.location.alt) * _blend_weights[i];
         }
     }
 
@@ -351,7 +388,7 @@ void AP_GPS_Blended::calc_state(void)
     if (!weeks_consistent) {
         // use data from highest weighted sensor
         state.time_week = gps.state[best_index].time_week;
-        state.time_week_ms = gps.state[best_index].time_week_ms;
+        state.time_week_ms = gps.state[best_index].time_week_ms + _align[best_index].dt_ms;
     } else {
         // use week number from highest weighting GPS (they should all have the same week number)
         state.time_week = gps.state[best_index].time_week;
@@ -359,26 +396,31 @@ void AP_GPS_Blended::calc_state(void)
         double temp_time_0 = 0.0;
         for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
             if (_blend_weights[i] > 0.0f) {
-                temp_time_0 += (double)gps.state[i].time_week_ms * (double)_blend_weights[i];
+                temp_time_0 += (double)(gps.state[i].time_week_ms + _align[i].dt_ms) * (double)_blend_weights[i];
             }
         }
         state.time_week_ms = (uint32_t)temp_time_0;
     }
 
-    // calculate a blended value for the timing data and lag
-    double temp_time_1 = 0.0;
-    double temp_time_2 = 0.0;
-    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-        if (_blend_weights[i] > 0.0f) {
-            temp_time_1 += (double)gps.timing[i].last_fix_time_ms * (double) _blend_weights[i];
-            temp_time_2 += (double)gps.timing[i].last_message_time_ms * (double)_blend_weights[i];
-            float gps_lag_sec = 0;
-            gps.get_lag(i, gps_lag_sec);
-            _blended_lag_sec += gps_lag_sec * _blend_weights[i];
+    if (time_align && have_target) {
+        // publish whenever any receiver has new data, keeping the
+        // newest message times, with a lag that gives the time the
+        // blend is valid for
+        _blended_lag_sec = MAX(int32_t(timing.last_message_time_ms - target_ms), 0) * 0.001f;
+    } else {
+        // calculate a blended value for the timing data and lag
+        double temp_time_1 = 0.0;
+        double temp_time_2 = 0.0;
+        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+            if (_blend_weights[i] > 0.0f) {
+                temp_time_1 += (double)gps.timing[i].last_fix_time_ms * (double) _blend_weights[i];
+                temp_time_2 += (double)gps.timing[i].last_message_time_ms * (double)_blend_weights[i];
+                _blended_lag_sec += _align[i].lag_sec * _blend_weights[i];
+            }
         }
+        timing.last_fix_time_ms = (uint32_t)temp_time_1;
+        timing.last_message_time_ms = (uint32_t)temp_time_2;
     }
-    timing.last_fix_time_ms = (uint32_t)temp_time_1;
-    timing.last_message_time_ms = (uint32_t)temp_time_2;
 
 #if HAL_LOGGING_ENABLED
     if (timing.last_message_time_ms > last_blended_message_time_ms &&
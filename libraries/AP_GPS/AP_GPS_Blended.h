@@ -66,6 +66,13 @@ private:
     float _blend_weights[GPS_MAX_RECEIVERS]; // blend weight for each GPS. The blend weights must sum to 1.0 across all instances.
     uint8_t _blend_health_counter;  // 0 = perfectly health, 100 = very unhealthy
 
+    // time alignment of each receiver
+    struct {
+        float lag_sec;      // reported receiver lag
+        uint32_t valid_ms;  // system time the latest data is valid for
+        uint16_t dt_ms;     // time the data is moved forward for the blend
+    } _align[GPS_MAX_RECEIVERS];
+
     AP_GPS::GPS_timing &timing;
     bool _calc_weights(void);
 };
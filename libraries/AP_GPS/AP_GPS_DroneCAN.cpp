@@ -804,7 +804,8 @@ void AP_GPS_DroneCAN::send_rtcm(void)
     msg.protocol_id = UAVCAN_EQUIPMENT_GNSS_RTCMSTREAM_PROTOCOL_ID_RTCM3;
     memcpy(msg.data.data, ptr, outlen);
     msg.data.len = outlen;
-    if (_detected_modules[_detected_module].ap_dronecan->rtcm_stream.broadcast(msg)) {
+    AP_DroneCAN *ap_dronecan = _detected_modules[_detected_module].ap_dronecan;
+    if (ap_dronecan->rtcm_stream.broadcast(msg, ap_dronecan->bulk_canfd())) {
         _rtcm_stream.buf->advance(outlen);
         _rtcm_stream.last_send_ms = now;
     }
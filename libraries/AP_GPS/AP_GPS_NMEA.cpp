@@ -64,6 +64,21 @@ bool AP_GPS_NMEA::read(void)
     send_config();
 
     numc = port->available();
+
+    // decode in place from the receive buffer where the UART supports
+    // it, so the bytes between sentences can be skipped over in bulk
+    ByteBuffer::IoVec vec[2];
+    const uint8_t nvec = port->peek_iovec(vec, numc);
+    if (nvec > 0) {
+        for (uint8_t i = 0; i < nvec; i++) {
+            if (_decode_buffer((const char *)vec[i].data, vec[i].len)) {
+                parsed = true;
+            }
+        }
+        port->consume(vec[0].len + (nvec > 1 ? vec[1].len : 0));
+        return parsed;
+    }
+
     while (numc--) {
         char c = port->read();
 #if AP_GPS_DEBUG_LOGGING_ENABLED
@@ -76,6 +91,34 @@ bool AP_GPS_NMEA::read(void)
     return parsed;
 }
 
+/*
+  decode a buffer of characters, return true if we have successfully completed a sentence
+ */
+bool AP_GPS_NMEA::_decode_buffer(const char *buf, uint32_t len)
+{
+#if AP_GPS_DEBUG_LOGGING_ENABLED
+    log_data((const uint8_t *)buf, len);
+#endif
+    bool parsed = false;
+    const char *end = buf + len;
+    while (buf < end) {
+        if (_sentence_done) {
+            // everything up to the start of the next sentence is
+            // ignored, and the start resets the sentence state
+            while (buf < end && *buf != '$' && *buf != '#') {
+                buf++;
+            }
+            if (buf == end) {
+                break;
+            }
+        }
+        if (_decode(*buf++)) {
+            parsed = true;
+        }
+    }
+    return parsed;
+}
+
 /*
   decode one character, return true if we have successfully completed a sentence, false otherwise
  */
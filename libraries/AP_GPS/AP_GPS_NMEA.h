@@ -100,6 +100,16 @@ private:
     ///
     bool                        _decode(char c);
 
+    /// Update the decode state machine with a buffer of characters,
+    /// skipping over the characters between sentences
+    ///
+    /// @param	buf		The next characters in the NMEA input stream
+    /// @param	len		The number of characters in buf
+    /// @returns		True if any sentence completed in the buffer
+    ///					updated the GPS state
+    ///
+    bool                        _decode_buffer(const char *buf, uint32_t len);
+
     /// Parses the @p as a NMEA-style decimal number with
     /// up to 3 decimal digits.
     ///
@@ -89,12 +89,22 @@ AP_GPS_SBF::read(void)
 {
     bool ret = false;
     uint32_t available_bytes = port->available();
-    for (uint32_t i = 0; i < available_bytes; i++) {
-        uint8_t temp = port->read();
+    // parse in place from the receive buffer where the UART supports it
+    ByteBuffer::IoVec vec[2];
+    const uint8_t nvec = port->peek_iovec(vec, available_bytes);
+    if (nvec > 0) {
+        for (uint8_t i = 0; i < nvec; i++) {
+            ret |= parse_buffer(vec[i].data, vec[i].len);
+        }
+        port->consume(vec[0].len + (nvec > 1 ? vec[1].len : 0));
+    } else {
+        for (uint32_t i = 0; i < available_bytes; i++) {
+            uint8_t temp = port->read();
 #if AP_GPS_DEBUG_LOGGING_ENABLED
-        log_data(&temp, 1);
+            log_data(&temp, 1);
 #endif
-        ret |= parse(temp);
+            ret |= parse(temp);
+        }
     }
 
     const uint32_t now = AP_HAL::millis();
@@ -236,6 +246,37 @@ bool AP_GPS_SBF::logging_healthy(void) const
     }
 }
 
+/*
+  parse a buffer of bytes. The body of a block is copied in one go,
+  only the bytes of the header and the last byte of the body, which
+  triggers the CRC check, go through parse()
+ */
+bool
+AP_GPS_SBF::parse_buffer(const uint8_t *buf, uint32_t len)
+{
+#if AP_GPS_DEBUG_LOGGING_ENABLED
+    log_data(buf, len);
+#endif
+    bool ret = false;
+    uint32_t i = 0;
+    while (i < len) {
+        if (sbf_msg.sbf_state == sbf_msg_parser_t::DATA) {
+            const int32_t remaining = int32_t(sbf_msg.length - 8) - sbf_msg.read;
+            if (remaining > 1) {
+                const uint32_t n = MIN(len - i, uint32_t(remaining - 1));
+                if (sbf_msg.read < sizeof(sbf_msg.data)) {
+                    memcpy(&sbf_msg.data.bytes[sbf_msg.read], &buf[i], MIN(n, uint32_t(sizeof(sbf_msg.data) - sbf_msg.read)));
+                }
+                sbf_msg.read += n;
+                i += n;
+                continue;
+            }
+        }
+        ret |= parse(buf[i++]);
+    }
+    return ret;
+}
+
 bool
 AP_GPS_SBF::parse(uint8_t temp)
 {
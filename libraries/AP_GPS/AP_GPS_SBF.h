@@ -63,6 +63,7 @@ public:
 private:
 
     bool parse(uint8_t temp);
+    bool parse_buffer(const uint8_t *buf, uint32_t len);
     bool process_message();
 
     static const uint8_t SBF_PREAMBLE1 = '$';
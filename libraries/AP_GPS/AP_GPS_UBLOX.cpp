@@ -685,13 +685,76 @@ AP_GPS_UBLOX::read(void)
     }
 
     const uint16_t numc = MIN(port->available(), 8192U);
-    for (uint16_t i = 0; i < numc; i++) {        // Process bytes received
+
+    // parse in place from the receive buffer where the UART supports
+    // it, falling back to reading a byte at a time
+    ByteBuffer::IoVec vec[2];
+    const uint8_t nvec = port->peek_iovec(vec, numc);
+    uint8_t vec_idx = 0;
+    uint32_t vec_ofs = 0;
+    uint16_t consumed = 0;
+#if GPS_MOVING_BASELINE
+    // the RTCMv3 parser needs to see every byte
+    const bool bulk_parse = nvec > 0 && rtcm3_parser == nullptr;
+#else
+    const bool bulk_parse = nvec > 0;
+#endif
+
+    for (uint16_t i = 0; i < numc; ) {        // Process bytes received
+
+        if (bulk_parse && vec_idx < nvec) {
+            // skip to the next preamble, or gather as much of the
+            // payload as is contiguous, without going through the
+            // state machine for each byte
+            const uint8_t *ptr = &vec[vec_idx].data[vec_ofs];
+            const uint32_t n = MIN(vec[vec_idx].len - vec_ofs, uint32_t(numc - i));
+            uint32_t nbulk = 0;
+            if (_step == 0) {
+                const uint8_t *sync = (const uint8_t *)memchr(ptr, PREAMBLE1, n);
+                nbulk = (sync != nullptr) ? uint32_t(sync - ptr) : n;
+            } else if (_step == 6) {
+                // the payload length was checked against sizeof(_buffer) in step 5
+                nbulk = MIN(n, uint32_t(_payload_length - _payload_counter));
+                memcpy(&_buffer[_payload_counter], ptr, nbulk);
+                for (uint32_t j = 0; j < nbulk; j++) {
+                    _ck_b += (_ck_a += ptr[j]);
+                }
+                _payload_counter += nbulk;
+                if (_payload_counter == _payload_length) {
+                    _step++;
+                }
+            }
+            if (nbulk > 0) {
+#if AP_GPS_DEBUG_LOGGING_ENABLED
+                log_data(ptr, nbulk);
+#endif
+                vec_ofs += nbulk;
+                if (vec_ofs >= vec[vec_idx].len) {
+                    vec_idx++;
+                    vec_ofs = 0;
+                }
+                consumed += nbulk;
+                i += nbulk;
+                continue;
+            }
+        }
 
         // read the next byte
         uint8_t data;
-        if (!port->read(data)) {
+        if (nvec > 0) {
+            if (vec_idx >= nvec) {
+                break;
+            }
+            data = vec[vec_idx].data[vec_ofs++];
+            if (vec_ofs >= vec[vec_idx].len) {
+                vec_idx++;
+                vec_ofs = 0;
+            }
+            consumed++;
+        } else if (!port->read(data)) {
             break;
         }
+        i++;
 #if AP_GPS_DEBUG_LOGGING_ENABLED
         log_data(&data, 1);
 #endif
@@ -818,6 +881,9 @@ AP_GPS_UBLOX::read(void)
             break;
         }
     }
+    if (consumed > 0) {
+        port->consume(consumed);
+    }
     return parsed;
 }
 
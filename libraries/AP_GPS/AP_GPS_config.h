@@ -97,6 +97,10 @@
   #define AP_GPS_UBLOX_ENABLED AP_GPS_BACKEND_DEFAULT_ENABLED
 #endif
 
+#ifndef AP_GPS_RTCM_REASSEMBLY_SLOTS
+  #define AP_GPS_RTCM_REASSEMBLY_SLOTS 2
+#endif
+
 #ifndef AP_GPS_RTCM_DECODE_ENABLED
   #define AP_GPS_RTCM_DECODE_ENABLED HAL_PROGRAM_SIZE_LIMIT_KB > 1024
 #endif
@@ -121,12 +121,50 @@ void
 AP_GPS_Backend::inject_data(const uint8_t *data, uint16_t len)
 {
     // not all backends have valid ports
-    if (port != nullptr) {
-        if (port->txspace() > len) {
-            port->write(data, len);
-        } else {
-            Debug("GPS %d: Not enough TXSPACE", state.instance + 1);
+    if (port == nullptr) {
+        return;
+    }
+    WITH_SEMAPHORE(inject_queue.sem);
+    send_injected_data();
+    if ((inject_queue.buf == nullptr || inject_queue.buf->is_empty()) && port->txspace() > len) {
+        port->write(data, len);
+        return;
+    }
+    if (inject_queue.buf == nullptr) {
+        // give enough space for a full round from a NTRIP server with all
+        // constellations
+        inject_queue.buf = NEW_NOTHROW ByteBuffer(2400);
+    }
+    if (inject_queue.buf == nullptr || inject_queue.buf->space() < len) {
+        Debug("GPS %d: Not enough TXSPACE", state.instance + 1);
+        inject_queue.dropped++;
+        return;
+    }
+    inject_queue.buf->write(data, len);
+    send_injected_data();
+}
+
+/*
+  write as much of the queued injection data as the port has space for
+ */
+void AP_GPS_Backend::send_injected_data(void)
+{
+    if (inject_queue.buf == nullptr || port == nullptr) {
+        return;
+    }
+    WITH_SEMAPHORE(inject_queue.sem);
+    while (true) {
+        uint32_t n = 0;
+        const uint8_t *ptr = inject_queue.buf->readptr(n);
+        n = MIN(n, port->txspace());
+        if (ptr == nullptr || n == 0) {
+            break;
+        }
+        n = port->write(ptr, n);
+        if (n == 0) {
+            break;
         }
+        inject_queue.buf->advance(n);
     }
 }
 
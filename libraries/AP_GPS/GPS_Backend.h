@@ -42,9 +42,7 @@
 #define AP_GPS_MB_MAX_LAG 0.25f
 #endif
 
-#if AP_GPS_DEBUG_LOGGING_ENABLED
 #include <AP_HAL/utility/RingBuffer.h>
-#endif
 
 class AP_GPS_Backend
 {
@@ -53,7 +51,9 @@ public:
 
     // we declare a virtual destructor so that GPS drivers can
     // override with a custom destructor if need be.
-    virtual ~AP_GPS_Backend(void) {}
+    virtual ~AP_GPS_Backend(void) {
+        delete inject_queue.buf;
+    }
 
     // The read() method is the only one needed in each driver. It
     // should return true when the backend has successfully received a
@@ -68,6 +68,12 @@ public:
 
     virtual void inject_data(const uint8_t *data, uint16_t len);
 
+    // write injected data that was waiting for space in the port
+    void send_injected_data(void);
+
+    // number of injected blocks dropped as the port couldn't keep up
+    uint16_t inject_dropped(void) const { return inject_queue.dropped; }
+
 #if HAL_GCS_ENABLED
     //MAVLink methods
     virtual bool supports_mavlink_gps_rtk_message() const { return false; }
@@ -177,6 +183,17 @@ protected:
     void set_alt_amsl_cm(AP_GPS::GPS_State &_state, int32_t alt_amsl_cm);
 
 private:
+    /*
+      injected data waiting for space in the port. It is allocated
+      when the port first can't take a whole block, and whole blocks
+      are dropped when it is full so the GPS never sees part of one
+     */
+    struct {
+        ByteBuffer *buf;
+        HAL_Semaphore sem;
+        uint16_t dropped;
+    } inject_queue;
+
     // itow from previous message
     uint64_t _pseudo_itow;
     int32_t _pseudo_itow_delta_ms;
@@ -66,6 +66,8 @@ struct PACKED log_GPS {
 // @Field: AEl: altitude above WGS-84 ellipsoid; INT32_MIN (-2147483648) if unknown
 // @Field: RTCMFU: RTCM fragments used
 // @Field: RTCMFD: RTCM fragments discarded
+// @Field: RTCMDr: injected data blocks dropped as the GPS port couldn't keep up
+// @Field: RTCMAge: time since correction data was last injected, 65535 if never
 struct PACKED log_GPA {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -81,6 +83,8 @@ struct PACKED log_GPA {
     int32_t  alt_ellipsoid;
     uint16_t rtcm_fragments_used;
     uint16_t rtcm_fragments_discarded;
+    uint16_t rtcm_dropped;
+    uint16_t rtcm_age_ms;
 };
 
 /*
@@ -207,7 +211,7 @@ struct PACKED log_GPS_RAWS {
     { LOG_GPS_MSG, sizeof(log_GPS), \
       "GPS",  "QBBIHBcLLeffffB", "TimeUS,I,Status,GMS,GWk,NSats,HDop,Lat,Lng,Alt,Spd,GCrs,VZ,Yaw,U", "s#-s-S-DUmnhnh-", "F--C-0BGGB000--" , true }, \
     { LOG_GPA_MSG,  sizeof(log_GPA), \
-      "GPA",  "QBCCCCfBIHeHH", "TimeUS,I,VDop,HAcc,VAcc,SAcc,YAcc,VV,SMS,Delta,AEl,RTCMFU,RTCMFD", "s#-mmnd-ssm--", "F-BBBB0-CCB--" , true }, \
+      "GPA",  "QBCCCCfBIHeHHHH", "TimeUS,I,VDop,HAcc,VAcc,SAcc,YAcc,VV,SMS,Delta,AEl,RTCMFU,RTCMFD,RTCMDr,RTCMAge", "s#-mmnd-ssm---s", "F-BBBB0-CCB---C" , true }, \
     { LOG_GPS_UBX1_MSG, sizeof(log_Ubx1), \
       "UBX1", "QBHBBHI",  "TimeUS,Instance,noisePerMS,jamInd,aPower,agcCnt,config", "s#-----", "F------"  , true }, \
     { LOG_GPS_UBX2_MSG, sizeof(log_Ubx2), \
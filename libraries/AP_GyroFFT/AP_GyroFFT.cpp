@@ -53,6 +53,7 @@ extern const AP_HAL::HAL& hal;
 #define FFT_STACK_SIZE              1024
 #define FFT_MIN_SAMPLES_PER_FRAME   16
 #define FFT_HARMONIC_FIT_DEFAULT    10
+#define FFT_SPECTRUM_LOG_MS         500     // averaging period of each logged spectrum
 #define FFT_HARMONIC_FIT_FILTER_HZ  15.0f
 #define FFT_HARMONIC_FIT_MULT       50.0f
 #define FFT_HARMONIC_FIT_TRACK_ROLL    4
@@ -169,8 +170,8 @@ const AP_Param::GroupInfo AP_GyroFFT::var_info[] = {
 
     // @Param: OPTIONS
     // @DisplayName: FFT options
-    // @Description: FFT configuration options. Values: 1:Apply the FFT *after* the filter bank,2:Check noise at the motor frequencies using ESC data as a reference
-    // @Bitmask: 0:Enable post-filter FFT,1:Check motor noise
+    // @Description: FFT configuration options. Values: 1:Apply the FFT *after* the filter bank,2:Check noise at the motor frequencies using ESC data as a reference,4:Analyse all three gyro axes in one pass rather than one axis per pass,8:Also find the noise peak of each secondary IMU during the batched pass, requires FFT_SAMPLE_MODE=0 and the batched pass,16:Log an averaged vibration spectrum of each IMU at 2Hz in place of INS_LOG_BAT raw sample logging, requires FFT_SAMPLE_MODE=0
+    // @Bitmask: 0:Enable post-filter FFT,1:Check motor noise,2:Batch all axes,3:Analyse secondary IMUs,4:Log IMU spectra
     // @User: Advanced
     // @RebootRequired: True
     AP_GROUPINFO("OPTIONS", 15, AP_GyroFFT, _options, 0),
@@ -318,6 +319,29 @@ __INITFUNC__ void AP_GyroFFT::init(uint16_t loop_rate_hz)
         return;
     }
 
+    // secondary IMUs are sampled at the raw gyro rate and run through their own engine state so that
+    // the averaging of the primary gyro is not disturbed
+    if ((_options & uint32_t(Options::SecondaryIMUs)) && batch_axes() && _sample_mode == 0 && _ins->get_gyro_count() > 1) {
+        _secondary_state = hal.dsp->fft_init(_window_size, _fft_sampling_rate_hz);
+        if (_secondary_state == nullptr) {
+            GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "AP_GyroFFT: no memory for secondary IMUs");
+        }
+    }
+
+    // the vibration spectra are averaged from the same raw gyro windows, so have the same bins as the FFT
+    if (log_spectrum() && _sample_mode == 0) {
+        for (uint8_t i = 0; i < _ins->get_gyro_count(); i++) {
+            if (_ins->get_raw_gyro_rate_hz(i) != _fft_sampling_rate_hz) {
+                continue;
+            }
+            _spectrum[i] = hal.dsp->psd_init(_window_size, _fft_sampling_rate_hz, _window_overlap);
+            if (_spectrum[i] == nullptr) {
+                GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "AP_GyroFFT: no memory for IMU%u spectrum", unsigned(i));
+                break;
+            }
+        }
+    }
+
     // per-axis frame time
     _frame_time_ms = _samples_per_frame * 1000 / _fft_sampling_rate_hz;
     // The update rate for the output, defaults are 1Khz / (1 - 0.5) * 32 == 62hz
@@ -329,6 +353,9 @@ __INITFUNC__ void AP_GyroFFT::init(uint16_t loop_rate_hz)
         for (uint8_t peak = 0; peak < FrequencyPeak::MAX_TRACKED_PEAKS; peak++) {
             _thread_state._center_freq_hz_filtered[axis][peak] = _fft_min_hz;
         }
+        for (uint8_t i = 0; i < INS_MAX_INSTANCES; i++) {
+            _thread_state._imu_center_freq_hz[i][axis] = _fft_min_hz;
+        }
         // number of cycles to average over, two complete windows to be sure
         _noise_calibration_cycles[axis] = (_window_size / _samples_per_frame) * 2;
         // harmonic frequency fit should change relatively slowly
@@ -346,6 +373,9 @@ __INITFUNC__ void AP_GyroFFT::init(uint16_t loop_rate_hz)
         // smooth the bandwidth output more aggressively
         _center_bandwidth_filter[peak].set_cutoff_frequency(output_rate, output_rate * 0.25f * scale_factor);
     }
+    for (uint8_t i = 0; i < INS_MAX_INSTANCES; i++) {
+        _imu_center_freq_filter[i].set_cutoff_frequency(output_rate, output_rate * 0.48f * scale_factor);
+    }
 
     // turn down the SNR threshold if examining post-filter
     if (using_post_filter_samples()) {
@@ -450,10 +480,44 @@ uint16_t AP_GyroFFT::run_cycle()
     // take a copy of the config inside the semaphore
     EngineConfig config = _config;
 
+    read_spectra();
+
     _sem.give();
 
-    uint32_t now = AP_HAL::micros();
+    const uint32_t now = AP_HAL::micros();
+
+    if (batch_axes()) {
+        // analyse all three axes in one pass, all of them have a full window
+        for (_update_axis = 0; _update_axis < XYZ_AXIS_COUNT; _update_axis++) {
+            analyse_axis(now, config);
+            if (_secondary_state == nullptr) {
+                update_secondary_spectra(_update_axis);
+            }
+        }
+        _update_axis = 0;
+        if (_secondary_state != nullptr) {
+            analyse_secondary_imus(config);
+        }
+    } else {
+        analyse_axis(now, config);
+        update_secondary_spectra(_update_axis);
+        // move onto the next axis
+        _update_axis = (_update_axis + 1) % XYZ_AXIS_COUNT;
+    }
+
+    // ready to receive another frame, because lock contention is so expensive we don't lock
+    // around this flag but rather rely on the semaphore at the beginning of the loop to
+    // ensure eventual visibility to the main loop
+    _thread_state._analysis_started = false;
 
+    // samples remaining in the next axis
+    return get_available_samples(_update_axis);
+}
+
+// run the FFT on the current update axis of the primary gyro
+// called from FFT thread
+void AP_GyroFFT::analyse_axis(uint32_t start_us, const EngineConfig& config)
+{
     // get the appropriate gyro buffer
     FloatBuffer& gyro_buffer = (_sample_mode == 0 ?_ins->get_raw_gyro_window(_update_axis) : _downsampled_gyro_data[_update_axis]);
     // if we have many more samples than the window size then we are struggling to 
@@ -461,6 +525,9 @@ uint16_t AP_GyroFFT::run_cycle()
     if (gyro_buffer.available() > uint32_t(_state->_window_size + uint16_t(_samples_per_frame >> 1))) { // half the frame size is a heuristic
         gyro_buffer.advance(gyro_buffer.available() - _state->_window_size);
     }
+    if (_sample_mode == 0) {
+        update_spectrum(_ins->get_first_usable_gyro(), gyro_buffer);
+    }
     // let's go!
     hal.dsp->fft_start(_state, gyro_buffer, _samples_per_frame);
 
@@ -473,7 +540,7 @@ uint16_t AP_GyroFFT::run_cycle()
 
     // record how we are doing
     _thread_state._last_output_us[_update_axis] = AP_HAL::micros();
-    _output_cycle_micros = _thread_state._last_output_us[_update_axis] - now;
+    _output_cycle_micros = _thread_state._last_output_us[_update_axis] - start_us;
 
 #if AP_SIM_ENABLED && HAL_LOGGING_ENABLED
     // extra logging when running simulations
@@ -508,17 +575,104 @@ uint16_t AP_GyroFFT::run_cycle()
         _state->_freq_bins[_state->_peak_data[1]._bin],
         _state->_freq_bins[_state->_peak_data[2]._bin]);
 #endif
+}
 
-    // move onto the next axis
-    _update_axis = (_update_axis + 1) % XYZ_AXIS_COUNT;
+// find the center peak of each axis of the secondary gyros using the
+// same window as the primary gyro. These peaks are not used by the
+// primary tracking but allow notches to follow each IMU separately
+// called from FFT thread
+void AP_GyroFFT::analyse_secondary_imus(const EngineConfig& config)
+{
+    const uint8_t primary = _ins->get_first_usable_gyro();
 
-    // ready to receive another frame, because lock contention is so expensive we don't lock
-    // around this flag but rather rely on the semaphore at the beginning of the loop to
-    // ensure eventual visibility to the main loop
-    _thread_state._analysis_started = false;
+    for (uint8_t i = 0; i < _ins->get_gyro_count(); i++) {
+        if (i == primary) {
+            _thread_state._imu_center_freq_hz[i] = _thread_state._center_freq_hz_filtered[FrequencyPeak::CENTER];
+            continue;
+        }
+        // the bins are only correct for gyros running at the same rate as the primary
+        if (_ins->get_raw_gyro_rate_hz(i) != _fft_sampling_rate_hz) {
+            continue;
+        }
+        for (uint8_t axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            FloatBuffer& gyro_buffer = _ins->get_raw_gyro_window(i, axis);
+            if (gyro_buffer.available() < _secondary_state->_window_size) {
+                continue;
+            }
+            if (gyro_buffer.available() > uint32_t(_secondary_state->_window_size + uint16_t(_samples_per_frame >> 1))) {
+                gyro_buffer.advance(gyro_buffer.available() - _secondary_state->_window_size);
+            }
+            update_spectrum(i, gyro_buffer);
+            hal.dsp->fft_start(_secondary_state, gyro_buffer, _samples_per_frame);
+            hal.dsp->fft_analyse(_secondary_state, config._fft_start_bin, config._fft_end_bin, config._attenuation_cutoff);
 
-    // samples remaining in the next axis
-    return get_available_samples(_update_axis);
+            float freq = _secondary_state->_peak_data[FrequencyPeak::CENTER]._freq_hz;
+            if (!isfinite(freq) || freq < config._fft_min_hz || freq > config._fft_max_hz) {
+                freq = config._fft_min_hz;
+            }
+            _thread_state._imu_center_freq_hz[i][axis] = _imu_center_freq_filter[i].apply(axis, freq);
+        }
+    }
+}
+
+// add the next window of an IMU to its vibration spectrum, the samples are left for the FFT
+// called from FFT thread
+void AP_GyroFFT::update_spectrum(uint8_t instance, FloatBuffer& gyro_buffer)
+{
+    if (_spectrum[instance] != nullptr) {
+        hal.dsp->psd_add_segment(_spectrum[instance], gyro_buffer);
+    }
+}
+
+// the secondary IMUs are only consumed by the FFT when Options::SecondaryIMUs is set,
+// otherwise consume their windows here at the same rate as the primary gyro
+// called from FFT thread
+void AP_GyroFFT::update_secondary_spectra(uint8_t axis)
+{
+    const uint8_t primary = _ins->get_first_usable_gyro();
+
+    for (uint8_t i = 0; i < _ins->get_gyro_count(); i++) {
+        if (i == primary || _spectrum[i] == nullptr) {
+            continue;
+        }
+        FloatBuffer& gyro_buffer = _ins->get_raw_gyro_window(i, axis);
+        if (gyro_buffer.available() < _state->_window_size) {
+            continue;
+        }
+        if (gyro_buffer.available() > uint32_t(_state->_window_size + uint16_t(_samples_per_frame >> 1))) {
+            gyro_buffer.advance(gyro_buffer.available() - _state->_window_size);
+        }
+        hal.dsp->psd_add_segment(_spectrum[i], gyro_buffer);
+        gyro_buffer.advance(_samples_per_frame);
+    }
+}
+
+// reduce each vibration spectrum to fixed point bins for logging and restart the averages
+// called from FFT thread with the semaphore held
+void AP_GyroFFT::read_spectra()
+{
+    const uint32_t now = AP_HAL::millis();
+    if (now - _spectrum_read_ms < FFT_SPECTRUM_LOG_MS) {
+        return;
+    }
+    _spectrum_read_ms = now;
+
+    for (uint8_t i = 0; i < INS_MAX_INSTANCES; i++) {
+        AP_HAL::DSP::PSDState* psd = _spectrum[i];
+        if (psd == nullptr) {
+            continue;
+        }
+        SpectrumLog& log = _spectrum_log[i];
+        // the largest bin is INT16_MAX so that the bins can be logged as an int16_t array
+        log.num_bins = hal.dsp->psd_read(psd, (uint16_t*)log.bins, FFT_SPECTRUM_BINS, log.scale, INT16_MAX);
+        if (log.num_bins == 0) {
+            continue;
+        }
+        memset(&log.bins[log.num_bins], 0, sizeof(int16_t) * (FFT_SPECTRUM_BINS - log.num_bins));
+        const uint16_t group = (psd->_fft->_num_stored_freqs + FFT_SPECTRUM_BINS - 1) / FFT_SPECTRUM_BINS;
+        log.bin_hz = group * psd->_fft->_bin_resolution;
+        _spectrum_log_mask |= 1U << i;
+    }
 }
 
 // whether analysis can be run again or not
@@ -532,6 +686,16 @@ bool AP_GyroFFT::start_analysis() {
         return false;
     }
 
+    if (batch_axes()) {
+        for (uint8_t axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            if (get_available_samples(axis) < _state->_window_size) {
+                return false;
+            }
+        }
+        _thread_state._analysis_started = true;
+        return true;
+    }
+
     if (get_available_samples(_update_axis) >= _state->_window_size) {
         _thread_state._analysis_started = true;
         return true;
@@ -1021,6 +1185,42 @@ void AP_GyroFFT::write_log_messages()
         log_noise_peak(2, FrequencyPeak::UPPER_SHOULDER);
     }
 
+    if (_secondary_state != nullptr) {
+        for (uint8_t i = 0; i < _ins->get_gyro_count(); i++) {
+            // @LoggerMessage: FTNI
+            // @Description: FFT Noise Frequency Peak of each IMU
+            // @Field: TimeUS: microseconds since system startup
+            // @Field: I: IMU instance
+            // @Field: PkX: center noise frequency on roll
+            // @Field: PkY: center noise frequency on pitch
+            // @Field: PkZ: center noise frequency on yaw
+            const Vector3f &peak = get_imu_noise_center_freq_hz(i);
+            AP::logger().WriteStreamingFields("FTNI", "TimeUS,I,PkX,PkY,PkZ", "s#zzz", "F----",
+                AP_HAL::micros64(), i, peak.x, peak.y, peak.z);
+        }
+    }
+
+    if (_spectrum_log_mask != 0) {
+        WITH_SEMAPHORE(_sem);
+        for (uint8_t i = 0; i < INS_MAX_INSTANCES; i++) {
+            if (!(_spectrum_log_mask & (1U << i))) {
+                continue;
+            }
+            // @LoggerMessage: FTSP
+            // @Description: FFT averaged vibration spectrum of each IMU
+            // @Field: TimeUS: microseconds since system startup
+            // @Field: I: IMU instance
+            // @Field: N: number of valid bins
+            // @Field: BinHz: width of each bin, bin i covers frequencies from i * BinHz
+            // @Field: Scale: power spectral density of a bin is the bin value multiplied by Scale, averaged over the three axes
+            // @Field: Bins: power spectral density of each bin
+            const SpectrumLog& log = _spectrum_log[i];
+            AP::logger().WriteStreaming("FTSP", "TimeUS,I,N,BinHz,Scale,Bins", "s#-z--", "F-----", "QBBffa",
+                AP_HAL::micros64(), i, log.num_bins, log.bin_hz, log.scale, log.bins);
+        }
+        _spectrum_log_mask = 0;
+    }
+
 #if DEBUG_FFT
     const uint32_t now = AP_HAL::millis();
     // output at 1hz
@@ -1056,7 +1256,7 @@ void AP_GyroFFT::write_log_messages()
 // write a single log message
 void AP_GyroFFT::log_noise_peak(uint8_t id, FrequencyPeak peak) const
 {
-    AP::logger().WriteStreaming("FTN2", "TimeUS,Id,PkX,PkY,PkZ,BwX,BwY,BwZ,SnX,SnY,SnZ,EnX,EnY,EnZ", "s#zzzzzz------", "F-------------", "QBffffffffffff",
+    AP::logger().WriteStreamingFields("FTN2", "TimeUS,Id,PkX,PkY,PkZ,BwX,BwY,BwZ,SnX,SnY,SnZ,EnX,EnY,EnZ", "s#zzzzzz------", "F-------------",
         AP_HAL::micros64(),
         id,
         get_noise_center_freq_hz(peak).x,
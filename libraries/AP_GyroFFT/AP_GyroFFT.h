@@ -29,6 +29,8 @@
 #include <Filter/FilterWithBuffer.h>
 
 #define DEBUG_FFT   0
+// number of bins in each logged vibration spectrum, the size of a logger int16_t array
+#define FFT_SPECTRUM_BINS   32
 
 // a library that leverages the HAL DSP support to perform FFT analysis on gyro samples
 class AP_GyroFFT
@@ -40,7 +42,10 @@ public:
 
     enum class Options : uint32_t {
         FFTPostFilter = 1 << 0,
-        ESCNoiseCheck = 1 << 1
+        ESCNoiseCheck = 1 << 1,
+        BatchAxes = 1 << 2,
+        SecondaryIMUs = 1 << 3,
+        LogSpectrum = 1 << 4,
     };
 
     AP_GyroFFT();
@@ -111,6 +116,12 @@ public:
     bool using_post_filter_samples() const { return (_options & uint32_t(Options::FFTPostFilter)) != 0; }
     // post filter mask of IMUs
     bool check_esc_noise() const { return (_options & uint32_t(Options::ESCNoiseCheck)) != 0; }
+    // analyse all three axes in one pass of the FFT thread
+    bool batch_axes() const { return (_options & uint32_t(Options::BatchAxes)) != 0; }
+    // log an averaged vibration spectrum of each IMU
+    bool log_spectrum() const { return (_options & uint32_t(Options::LogSpectrum)) != 0; }
+    // detected peak frequency of each IMU, only updated for secondary IMUs when Options::SecondaryIMUs is set
+    const Vector3f& get_imu_noise_center_freq_hz(uint8_t instance) const { return _global_state._imu_center_freq_hz[instance]; }
     // look for a frequency in the detected noise
     float has_noise_at_frequency_hz(float freq) const;
     static float calculate_notch_frequency(float* freqs, uint16_t numpeaks, float harmonic_fit, uint8_t& harmonics);
@@ -192,6 +203,16 @@ private:
     }
     // write single log messages
     void log_noise_peak(uint8_t id, FrequencyPeak peak) const;
+    // run the FFT on the current update axis of the primary gyro
+    void analyse_axis(uint32_t start_us, const EngineConfig& config);
+    // find the center peak of each axis of the secondary gyros
+    void analyse_secondary_imus(const EngineConfig& config);
+    // accumulate the vibration spectrum of an IMU without consuming samples
+    void update_spectrum(uint8_t instance, FloatBuffer& gyro_buffer);
+    // accumulate the vibration spectrum of secondary IMUs that are not otherwise analysed
+    void update_secondary_spectra(uint8_t axis);
+    // reduce the vibration spectra ready for logging
+    void read_spectra();
     // calculate the peak noise frequency
     void calculate_noise(bool calibrating, const EngineConfig& config);
     // calculate noise peaks based on energy and history
@@ -257,6 +278,8 @@ private:
         Vector3f _center_freq_energy_filtered[FrequencyPeak::MAX_TRACKED_PEAKS];
         // filtered detected peak width
         Vector3f _center_bandwidth_hz_filtered[FrequencyPeak::MAX_TRACKED_PEAKS];
+        // filtered center peak frequency of each IMU
+        Vector3f _imu_center_freq_hz[INS_MAX_INSTANCES];
         // axes that still require noise calibration
         uint8_t _noise_needs_calibration : 3;
         // whether the analyzer is mid-cycle
@@ -283,6 +306,21 @@ private:
 
     // state of the FFT engine
     AP_HAL::DSP::FFTWindowState* _state;
+    // state of the FFT engine used for secondary IMUs, which has no averaging
+    AP_HAL::DSP::FFTWindowState* _secondary_state;
+    // averaged vibration spectrum of each IMU
+    AP_HAL::DSP::PSDState* _spectrum[INS_MAX_INSTANCES];
+    // the last spectrum of each IMU waiting to be logged, protected by _sem
+    struct SpectrumLog {
+        int16_t bins[FFT_SPECTRUM_BINS];
+        float scale;
+        float bin_hz;
+        uint8_t num_bins;
+    } _spectrum_log[INS_MAX_INSTANCES];
+    // mask of IMUs with a spectrum waiting to be logged
+    uint8_t _spectrum_log_mask;
+    // when the spectra were last read
+    uint32_t _spectrum_read_ms;
     // update state machine step information
     uint8_t _update_axis;
     // noise base of the gyros
@@ -312,6 +350,8 @@ private:
     MedianLowPassFilter3dFloat _center_bandwidth_filter[FrequencyPeak::MAX_TRACKED_PEAKS];
     // smoothing filter on the frequency fit
     LowPassFilterConstDtFloat _harmonic_fit_filter[XYZ_AXIS_COUNT];
+    // smoothing filter on the center peak frequency of each IMU
+    MedianLowPassFilter3dFloat _imu_center_freq_filter[INS_MAX_INSTANCES];
 
     // configured sampling rate
     uint16_t _fft_sampling_rate_hz;
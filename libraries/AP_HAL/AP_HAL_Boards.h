@@ -284,6 +284,10 @@
 #define AP_HAL_SHARED_DMA_ENABLED 1
 #endif
 
+#ifndef AP_HAL_I2C_PROBE_SCAN_ENABLED
+#define AP_HAL_I2C_PROBE_SCAN_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS && !defined(HAL_BOOTLOADER_BUILD))
+#endif
+
 #ifndef HAL_ENABLE_THREAD_STATISTICS
 #define HAL_ENABLE_THREAD_STATISTICS 0
 #endif
@@ -404,6 +408,12 @@
 #define HAL_INS_RATE_LOOP 0
 #endif
 
+// call the hwdef enumerated sensor backends directly on hot paths
+// rather than through their virtual interfaces, see --static-dispatch
+#ifndef HAL_STATIC_DISPATCH_ENABLED
+#define HAL_STATIC_DISPATCH_ENABLED 0
+#endif
+
 #define HAL_GPIO_LED_OFF (!HAL_GPIO_LED_ON)
 
 #ifndef HAL_REBOOT_ON_MEMORY_ERRORS
@@ -42,7 +42,7 @@ DSP::FFTWindowState::FFTWindowState(uint16_t window_size, uint16_t sample_rate,
     // includes DC ad Nyquist components and needs to be large enough for intermediate steps
     _freq_bins = (float*)hal.util->malloc_type(sizeof(float) * _window_size, DSP_MEM_REGION);
     _derivative_freq_bins = (float*)hal.util->malloc_type(sizeof(float) * _num_stored_freqs, DSP_MEM_REGION);
-    _hanning_window = (float*)hal.util->malloc_type(sizeof(float) * _window_size, DSP_MEM_REGION);
+    _hanning_window = hal.dsp->get_hanning_window(_window_size, _window_scale);
     // allocate workspace, including Nyquist component
     _rfft_data = (float*)hal.util->malloc_type(sizeof(float) * (_window_size + 2), DSP_MEM_REGION);
     // sliding window of frequency bin frames
@@ -60,15 +60,6 @@ DSP::FFTWindowState::FFTWindowState(uint16_t window_size, uint16_t sample_rate,
         free_data_structures();
         return;
     }
-
-    // create the Hanning window
-    // https://holometer.fnal.gov/GH_FFT.pdf - equation 19
-    for (uint16_t i = 0; i < window_size; i++) {
-        _hanning_window[i] = (0.5f - 0.5f * cosf(2.0f * M_PI * i / ((float)window_size - 1)));
-        _window_scale += _hanning_window[i];
-    }
-    // Calculate the inverse of the Effective Noise Bandwidth - equation 24
-    _window_scale = 2.0f / sq(_window_scale);
 }
 
 DSP::FFTWindowState::~FFTWindowState()
@@ -82,7 +73,7 @@ void DSP::FFTWindowState::free_data_structures()
     _freq_bins = nullptr;
     hal.util->free_type(_derivative_freq_bins, sizeof(float) * _num_stored_freqs, DSP_MEM_REGION);
     _derivative_freq_bins = nullptr;
-    hal.util->free_type(_hanning_window, sizeof(float) * (_window_size), DSP_MEM_REGION);
+    // the Hanning window is shared and owned by the DSP
     _hanning_window = nullptr;
     hal.util->free_type(_rfft_data, sizeof(float) * (_window_size + 2), DSP_MEM_REGION);
     _rfft_data = nullptr;
@@ -92,6 +83,150 @@ void DSP::FFTWindowState::free_data_structures()
     _sliding_window = nullptr;
 }
 
+/*
+  return the shared Hanning window of the given size, creating it on first use.
+  Windows are never freed so the pointer remains valid for the lifetime of all users
+ */
+const float* DSP::get_hanning_window(uint16_t window_size, float& window_scale)
+{
+    WITH_SEMAPHORE(_hanning_sem);
+
+    for (auto &w : _hanning_windows) {
+        if (w.window != nullptr && w.size == window_size) {
+            window_scale = w.scale;
+            return w.window;
+        }
+    }
+
+    for (auto &w : _hanning_windows) {
+        if (w.window != nullptr) {
+            continue;
+        }
+        float* window = (float*)hal.util->malloc_type(sizeof(float) * window_size, DSP_MEM_REGION);
+        if (window == nullptr) {
+            return nullptr;
+        }
+        // create the Hanning window
+        // https://holometer.fnal.gov/GH_FFT.pdf - equation 19
+        float scale = 0;
+        for (uint16_t i = 0; i < window_size; i++) {
+            window[i] = (0.5f - 0.5f * cosf(2.0f * M_PI * i / ((float)window_size - 1)));
+            scale += window[i];
+        }
+        // Calculate the inverse of the Effective Noise Bandwidth - equation 24
+        w.scale = 2.0f / sq(scale);
+        w.size = window_size;
+        w.window = window;
+        window_scale = w.scale;
+        return window;
+    }
+
+    // all slots in use
+    return nullptr;
+}
+
+DSP::PSDState::PSDState(FFTWindowState* fft, uint16_t segment_advance) :
+    _fft(fft),
+    _segment_advance(segment_advance)
+{
+    _power = (float*)hal.util->malloc_type(sizeof(float) * _fft->_num_stored_freqs, DSP_MEM_REGION);
+    if (_power != nullptr) {
+        memset(_power, 0, sizeof(float) * _fft->_num_stored_freqs);
+    }
+}
+
+DSP::PSDState::~PSDState()
+{
+    hal.util->free_type(_power, sizeof(float) * _fft->_num_stored_freqs, DSP_MEM_REGION);
+    delete _fft;
+}
+
+// initialise a streaming PSD engine
+DSP::PSDState* DSP::psd_init(uint16_t window_size, uint16_t sample_rate, float overlap)
+{
+    FFTWindowState* fft = fft_init(window_size, sample_rate);
+    if (fft == nullptr) {
+        return nullptr;
+    }
+    const uint16_t advance = MAX(1, lrintf((1.0f - constrain_float(overlap, 0.0f, 0.9f)) * window_size));
+    PSDState* psd = NEW_NOTHROW PSDState(fft, advance);
+    if (psd == nullptr) {
+        delete fft;
+        return nullptr;
+    }
+    if (psd->_power == nullptr) {
+        delete psd;
+        return nullptr;
+    }
+    return psd;
+}
+
+// add the power of every complete segment in samples to the PSD
+uint16_t DSP::psd_update(PSDState* psd, FloatBuffer& samples)
+{
+    FFTWindowState* fft = psd->_fft;
+    uint16_t segments = 0;
+
+    while (samples.available() >= fft->_window_size) {
+        fft_start(fft, samples, psd->_segment_advance);
+        fft_power(fft);
+        vector_add_float(psd->_power, fft->_freq_bins, psd->_power, fft->_num_stored_freqs);
+        segments++;
+    }
+    psd->_segments += segments;
+    return segments;
+}
+
+// add the power of the next segment in samples to the PSD, leaving the samples in place
+bool DSP::psd_add_segment(PSDState* psd, FloatBuffer& samples)
+{
+    FFTWindowState* fft = psd->_fft;
+
+    if (samples.available() < fft->_window_size) {
+        return false;
+    }
+    fft_start(fft, samples, 0);
+    fft_power(fft);
+    vector_add_float(psd->_power, fft->_freq_bins, psd->_power, fft->_num_stored_freqs);
+    psd->_segments++;
+    return true;
+}
+
+// reduce the averaged PSD to fixed point bins and restart the average
+uint16_t DSP::psd_read(PSDState* psd, uint16_t* bins, uint16_t num_bins, float& scale, uint16_t full_scale)
+{
+    FFTWindowState* fft = psd->_fft;
+    if (psd->_segments == 0 || num_bins == 0) {
+        return 0;
+    }
+
+    // frequencies summed into each bin
+    const uint16_t group = (fft->_num_stored_freqs + num_bins - 1) / num_bins;
+    num_bins = (fft->_num_stored_freqs + group - 1) / group;
+
+    // average over the segments and scale for the input window
+    const float power_scale = fft->_window_scale / psd->_segments;
+    float max_power = 0;
+    for (uint16_t b = 0; b < num_bins; b++) {
+        float power = 0;
+        for (uint16_t i = b * group; i < MIN((b + 1) * group, fft->_num_stored_freqs); i++) {
+            power += psd->_power[i];
+        }
+        psd->_power[b] = power * power_scale;
+        max_power = MAX(max_power, psd->_power[b]);
+    }
+
+    scale = max_power / full_scale;
+    const float inv_scale = is_positive(scale) ? 1.0f / scale : 0.0f;
+    for (uint16_t b = 0; b < num_bins; b++) {
+        bins[b] = lrintf(psd->_power[b] * inv_scale);
+    }
+
+    memset(psd->_power, 0, sizeof(float) * fft->_num_stored_freqs);
+    psd->_segments = 0;
+    return num_bins;
+}
+
 // step 3: find the magnitudes of the complex data
 void DSP::step_cmplx_mag(FFTWindowState* fft, uint16_t start_bin, uint16_t end_bin, float noise_att_cutoff)
 {
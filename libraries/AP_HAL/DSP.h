@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include "AP_HAL_Namespace.h"
 #include <AP_HAL/utility/RingBuffer.h>
+#include <AP_HAL/Semaphores.h>
 
 #define DSP_MEM_REGION AP_HAL::Util::MEM_FAST
 // Maximum tolerated number of cycles with missing signal
@@ -74,7 +75,8 @@ public:
         // three highest peaks
         FrequencyPeakData _peak_data[MAX_TRACKED_PEAKS];
         // Hanning window for incoming samples, see https://en.wikipedia.org/wiki/Window_function#Hann_.28Hanning.29_window
-        float* _hanning_window;
+        // this is shared between all states of the same window size
+        const float* _hanning_window;
         // Use in calculating the PS of the signal [Heinz] equations (20) & (21)
         float _window_scale;
         // averaging is ongoing
@@ -101,7 +103,42 @@ public:
     // finish the averaging process
     uint16_t fft_stop_average(FFTWindowState* fft, uint16_t start_bin, uint16_t end_bin, float* peaks);
 
+    // shared Hanning window of the given size, allocated on first use and never freed
+    const float* get_hanning_window(uint16_t window_size, float& window_scale);
+
+    // streaming power spectral density estimate using Welch's method of averaging
+    // the power of overlapping windowed segments
+    class PSDState {
+    public:
+        PSDState(FFTWindowState* fft, uint16_t segment_advance);
+        ~PSDState();
+        CLASS_NO_COPY(PSDState);
+
+        // FFT state used to calculate each segment
+        FFTWindowState* const _fft;
+        // number of samples between the start of successive segments
+        const uint16_t _segment_advance;
+        // accumulated power of each stored frequency
+        float* _power;
+        // number of segments accumulated in _power
+        uint32_t _segments;
+    };
+    // initialise a PSD engine, overlap is the fraction of each segment shared with the next
+    PSDState* psd_init(uint16_t window_size, uint16_t sample_rate, float overlap);
+    // add all of the complete segments available in samples, returns the number of segments added
+    uint16_t psd_update(PSDState* psd, FloatBuffer& samples);
+    // add the next complete segment in samples without consuming any samples, for
+    // use when the samples are also consumed by another analysis
+    bool psd_add_segment(PSDState* psd, FloatBuffer& samples);
+    // reduce the averaged PSD into num_bins fixed point bins, adjacent frequencies are summed
+    // when num_bins is less than the number of stored frequencies. The power of bin i is
+    // bins[i] * scale, where the largest bin is full_scale. Returns the number of bins written
+    // and restarts the average
+    uint16_t psd_read(PSDState* psd, uint16_t* bins, uint16_t num_bins, float& scale, uint16_t full_scale = UINT16_MAX);
+
 protected:
+    // calculate the power of each stored frequency of the windowed samples into _freq_bins
+    virtual void fft_power(FFTWindowState* state) = 0;
     // step 3: find the magnitudes of the complex data
     void step_cmplx_mag(FFTWindowState* fft, uint16_t start_bin, uint16_t end_bin, float noise_att_cutoff);
     // calculate the noise width of a peak based on the input parameters
@@ -136,5 +173,15 @@ protected:
     // init averaging FFT data
     bool fft_init_average(FFTWindowState* fft);
 
+private:
+    // cache of Hanning windows shared by all FFT users
+    static const uint8_t MAX_HANNING_WINDOWS = 4;
+    struct {
+        float* window;
+        float scale;
+        uint16_t size;
+    } _hanning_windows[MAX_HANNING_WINDOWS];
+    HAL_Semaphore _hanning_sem;
+
 #endif // HAL_WITH_DSP
 };
@@ -191,6 +191,14 @@ bool AP_HAL::Device::read_registers(uint8_t first_reg, uint8_t *recv, uint32_t r
     return result;
 }
 
+bool AP_HAL::Device::transfer_queued(const uint8_t *send, uint32_t send_len,
+                                     uint8_t *recv, uint32_t recv_len, TransferCb cb)
+{
+    WITH_SEMAPHORE(get_semaphore());
+    cb(transfer(send, send_len, recv, recv_len));
+    return true;
+}
+
 bool AP_HAL::Device::transfer_bank(uint8_t bank, const uint8_t *send, uint32_t send_len,
                         uint8_t *recv, uint32_t recv_len)
 {
@@ -67,6 +67,7 @@ public:
     typedef void* RegisterRWHandle;
 
     FUNCTOR_TYPEDEF(BankSelectCb, bool, uint8_t);
+    FUNCTOR_TYPEDEF(TransferCb, void, bool);
 
     Device(enum BusType type)
     {
@@ -138,6 +139,21 @@ public:
         return transfer(send_recv, len, send_recv, len);
     }
 
+    /*
+     * Queue a transfer() to run on the bus thread and return without
+     * waiting for it. cb is called on the bus thread with the result
+     * once the transfer is done. The buffers must stay valid until
+     * then. Transfers queued on a bus run back to back, in order,
+     * with the bus held for the whole chain.
+     *
+     * The default runs the transfer and the callback immediately.
+     *
+     * Return: true if the transfer was queued, false if the queue is
+     * full, in which case cb will not be called.
+     */
+    virtual bool transfer_queued(const uint8_t *send, uint32_t send_len,
+                                 uint8_t *recv, uint32_t recv_len, TransferCb cb);
+
     /*
      * Sets the required flags before transaction starts
      * this is to be used by Wide SPI communication interfaces like
@@ -0,0 +1,168 @@
+/*
+ * This file is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_HAL.h"
+#include "I2CDevice.h"
+
+#if AP_HAL_I2C_PROBE_SCAN_ENABLED
+
+#include <AP_Common/AP_Common.h>
+
+extern const AP_HAL::HAL& hal;
+
+// time allowed for all buses to finish their scan
+#define I2C_PROBE_SCAN_TIMEOUT_MS 500
+
+namespace {
+
+/*
+  scan of one bus. Each transfer queues the next one from its
+  completion callback, so the whole bus is worked through on its bus
+  thread without involving the caller
+ */
+class I2CProbeScanBus {
+public:
+    I2CProbeScanBus(AP_HAL::I2CDevice *_dev, const uint8_t *_addresses, uint32_t _requested) :
+        dev(_dev),
+        addresses(_addresses),
+        requested(_requested)
+    {}
+
+    ~I2CProbeScanBus() {
+        delete dev;
+    }
+
+    // start the scan, done is set once it has finished
+    void start(void) {
+        if (!queue_next()) {
+            done = true;
+        }
+    }
+
+    volatile bool done = false;
+    uint32_t absent = 0;
+
+private:
+    // queue a read at the next requested address, false if finished
+    bool queue_next(void) {
+        while (idx < 32 && (requested & (1U<<idx)) == 0) {
+            idx++;
+        }
+        if (idx >= 32) {
+            return false;
+        }
+        dev->set_address(addresses[idx]);
+        return dev->transfer_queued(nullptr, 0, &buf, 1, FUNCTOR_BIND_MEMBER(&I2CProbeScanBus::transfer_done, void, bool));
+    }
+
+    void transfer_done(bool ok) {
+        if (!ok) {
+            absent |= 1U<<idx;
+        }
+        idx++;
+        if (!queue_next()) {
+            done = true;
+        }
+    }
+
+    AP_HAL::I2CDevice *dev;
+    const uint8_t *addresses;
+    const uint32_t requested;
+    uint8_t idx = 0;
+    uint8_t buf;
+};
+
+}
+
+int8_t AP_HAL::I2CProbeScan::find_address(uint8_t address) const
+{
+    for (uint8_t i=0; i<num_addresses; i++) {
+        if (addresses[i] == address) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void AP_HAL::I2CProbeScan::add(uint8_t bus, uint8_t address)
+{
+    if (bus >= max_buses) {
+        return;
+    }
+    int8_t idx = find_address(address);
+    if (idx < 0) {
+        if (num_addresses >= max_addresses) {
+            return;
+        }
+        idx = num_addresses++;
+        addresses[idx] = address;
+    }
+    requested[bus] |= 1U<<idx;
+}
+
+void AP_HAL::I2CProbeScan::scan(void)
+{
+    I2CProbeScanBus *buses[max_buses] {};
+
+    for (uint8_t b=0; b<max_buses; b++) {
+        if (requested[b] == 0) {
+            continue;
+        }
+        AP_HAL::I2CDevice *dev = hal.i2c_mgr->get_device_ptr(b, addresses[__builtin_ctz(requested[b])]);
+        if (dev == nullptr) {
+            continue;
+        }
+        // an absent device only needs to be missed twice
+        dev->set_retries(1);
+        buses[b] = NEW_NOTHROW I2CProbeScanBus(dev, addresses, requested[b]);
+        if (buses[b] == nullptr) {
+            delete dev;
+            continue;
+        }
+        buses[b]->start();
+    }
+
+    const uint32_t start_ms = AP_HAL::millis();
+    for (uint8_t b=0; b<max_buses; b++) {
+        if (buses[b] == nullptr) {
+            continue;
+        }
+        while (!buses[b]->done && AP_HAL::millis() - start_ms < I2C_PROBE_SCAN_TIMEOUT_MS) {
+            hal.scheduler->delay_microseconds(200);
+        }
+        if (!buses[b]->done) {
+            // the bus thread still has our buffers, so this scan is
+            // leaked rather than freed. Nothing is marked absent
+            continue;
+        }
+        absent[b] = buses[b]->absent;
+        delete buses[b];
+    }
+    scanned = true;
+}
+
+bool AP_HAL::I2CProbeScan::maybe_present(uint8_t bus, uint8_t address) const
+{
+    if (!scanned || bus >= max_buses) {
+        return true;
+    }
+    const int8_t idx = find_address(address);
+    if (idx < 0) {
+        return true;
+    }
+    return (absent[bus] & (1U<<idx)) == 0;
+}
+
+#endif  // AP_HAL_I2C_PROBE_SCAN_ENABLED
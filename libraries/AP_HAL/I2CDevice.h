@@ -101,6 +101,45 @@ public:
     virtual uint32_t get_bus_mask_internal(void) const { return 0x01; }
 };
 
+#if AP_HAL_I2C_PROBE_SCAN_ENABLED
+/*
+  scan for devices that acknowledge their address before probing
+  them. Addresses are added per bus, then scan() checks them all with
+  a one byte read. Each bus works through its own addresses on its
+  bus thread using queued transfers, so the time spent waiting on
+  absent devices is overlapped across buses.
+
+  Anything that was not scanned, or where the scan did not complete,
+  counts as possibly present, so a failed scan only costs the normal
+  probes.
+ */
+class I2CProbeScan {
+public:
+    // note that address will be probed on bus
+    void add(uint8_t bus, uint8_t address);
+
+    // scan all the added addresses
+    void scan(void);
+
+    // false only if the scan found no device at address on bus
+    bool maybe_present(uint8_t bus, uint8_t address) const;
+
+    static const uint8_t max_buses = 8;
+    static const uint8_t max_addresses = 32;
+
+private:
+    // find the index of address, or -1 if not added
+    int8_t find_address(uint8_t address) const;
+
+    uint8_t addresses[max_addresses];
+    uint8_t num_addresses = 0;
+    // bitmasks of address indexes, per bus number
+    uint32_t requested[max_buses] {};
+    uint32_t absent[max_buses] {};
+    bool scanned = false;
+};
+#endif  // AP_HAL_I2C_PROBE_SCAN_ENABLED
+
 /*
   convenient macros for iterating over I2C bus numbers
  */
@@ -387,6 +387,13 @@ public:
     */
     virtual void force_trigger_groups(bool onoff) {};
 
+    /*
+      get the time of the last push() and the time the first output
+      frame after it started, for output latency measurement. Returns
+      false if the frame start time is not known
+    */
+    virtual bool get_push_timing(uint32_t &push_us, uint32_t &send_us) const { return false; }
+
     /*
      * calculate the prescaler required to achieve the desire bitrate
      */
@@ -150,58 +150,58 @@ void SIMState::fdm_input_local(void)
                       attitude);
     }
     if (benewake_tf02 != nullptr) {
-        benewake_tf02->update(sitl_model->rangefinder_range());
+        benewake_tf02->update(*sitl_model);
     }
     if (benewake_tf03 != nullptr) {
-        benewake_tf03->update(sitl_model->rangefinder_range());
+        benewake_tf03->update(*sitl_model);
     }
     if (benewake_tfmini != nullptr) {
-        benewake_tfmini->update(sitl_model->rangefinder_range());
+        benewake_tfmini->update(*sitl_model);
     }
     if (nooploop != nullptr) {
-        nooploop->update(sitl_model->rangefinder_range());
+        nooploop->update(*sitl_model);
     }
     if (teraranger_serial != nullptr) {
-        teraranger_serial->update(sitl_model->rangefinder_range());
+        teraranger_serial->update(*sitl_model);
     }
     if (lightwareserial != nullptr) {
-        lightwareserial->update(sitl_model->rangefinder_range());
+        lightwareserial->update(*sitl_model);
     }
     if (lightwareserial_binary != nullptr) {
-        lightwareserial_binary->update(sitl_model->rangefinder_range());
+        lightwareserial_binary->update(*sitl_model);
     }
     if (lanbao != nullptr) {
-        lanbao->update(sitl_model->rangefinder_range());
+        lanbao->update(*sitl_model);
     }
     if (blping != nullptr) {
-        blping->update(sitl_model->rangefinder_range());
+        blping->update(*sitl_model);
     }
     if (leddarone != nullptr) {
-        leddarone->update(sitl_model->rangefinder_range());
+        leddarone->update(*sitl_model);
     }
     if (rds02uf != nullptr) {
-        rds02uf->update(sitl_model->rangefinder_range());
+        rds02uf->update(*sitl_model);
     }
     if (USD1_v0 != nullptr) {
-        USD1_v0->update(sitl_model->rangefinder_range());
+        USD1_v0->update(*sitl_model);
     }
     if (USD1_v1 != nullptr) {
-        USD1_v1->update(sitl_model->rangefinder_range());
+        USD1_v1->update(*sitl_model);
     }
     if (maxsonarseriallv != nullptr) {
-        maxsonarseriallv->update(sitl_model->rangefinder_range());
+        maxsonarseriallv->update(*sitl_model);
     }
     if (wasp != nullptr) {
-        wasp->update(sitl_model->rangefinder_range());
+        wasp->update(*sitl_model);
     }
     if (nmea != nullptr) {
-        nmea->update(sitl_model->rangefinder_range());
+        nmea->update(*sitl_model);
     }
     if (rf_mavlink != nullptr) {
-        rf_mavlink->update(sitl_model->rangefinder_range());
+        rf_mavlink->update(*sitl_model);
     }
     if (gyus42v2 != nullptr) {
-        gyus42v2->update(sitl_model->rangefinder_range());
+        gyus42v2->update(*sitl_model);
     }
     if (efi_ms != nullptr) {
         efi_ms->update();
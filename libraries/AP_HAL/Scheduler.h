@@ -79,6 +79,12 @@ public:
 
     virtual bool     in_main_thread() const = 0;
 
+    /*
+      opaque identifier of the calling thread, or nullptr if the HAL
+      cannot identify threads
+     */
+    virtual const void *current_thread_id() const { return nullptr; }
+
     /*
       disable interrupts and return a context that can be used to
       restore the interrupt state. This can be used to protect
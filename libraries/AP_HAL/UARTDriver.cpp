@@ -106,6 +106,32 @@ ssize_t AP_HAL::UARTDriver::read(uint8_t *buffer, uint16_t count)
     return read_locked(buffer, count, 0);
 }
 
+uint8_t AP_HAL::UARTDriver::peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len)
+{
+    if (lock_read_key != 0) {
+        return 0;
+    }
+    return _peek_iovec(vec, len);
+}
+
+bool AP_HAL::UARTDriver::consume(uint32_t n)
+{
+    if (lock_read_key != 0) {
+        return false;
+    }
+#if AP_UART_MONITOR_ENABLED
+    auto monitor = _monitor_read_buffer;
+    if (monitor != nullptr) {
+        ByteBuffer::IoVec vec[2];
+        const uint8_t nvec = _peek_iovec(vec, n);
+        for (uint8_t i = 0; i < nvec; i++) {
+            monitor->write(vec[i].data, vec[i].len);
+        }
+    }
+#endif
+    return _consume(n);
+}
+
 bool AP_HAL::UARTDriver::read(uint8_t &b)
 {
     ssize_t n = read(&b, 1);
@@ -154,6 +180,29 @@ bool AP_HAL::UARTDriver::discard_input()
     return _discard_input();
 }
 
+/*
+  space for bulk data, limited so that the data queued can be sent
+  within the bulk latency. When nothing is queued all the space is
+  available, so bulk data still flows on links too slow to send one
+  packet within the latency
+ */
+uint32_t AP_HAL::UARTDriver::txspace_bulk()
+{
+    const uint32_t space = txspace();
+    if (_bulk_latency_ms == 0) {
+        return space;
+    }
+    const uint32_t queued = _tx_queued();
+    if (queued == 0) {
+        return space;
+    }
+    const uint32_t limit = uint64_t(bw_in_bytes_per_second()) * _bulk_latency_ms / 1000U;
+    if (queued >= limit) {
+        return 0;
+    }
+    return MIN(space, limit - queued);
+}
+
 /*
   default implementation of receive_time_constraint_us() will be used
   for subclasses that don't implement the call (eg. network
@@ -4,6 +4,7 @@
 
 #include "AP_HAL_Namespace.h"
 #include "utility/BetterStream.h"
+#include "utility/RingBuffer.h"
 #include <AP_Logger/AP_Logger_config.h>
 
 #ifndef HAL_UART_STATS_ENABLED
@@ -15,7 +16,6 @@
 #endif
 
 class ExpandingString;
-class ByteBuffer;
 
 /* Pure virtual UARTDriver class */
 class AP_HAL::UARTDriver : public AP_HAL::BetterStream {
@@ -55,6 +55,18 @@ public:
     int16_t read(void) override;
     bool read(uint8_t &b) override WARN_IF_UNUSED;
     ssize_t read(uint8_t *buffer, uint16_t count) override;
+
+    /*
+      zero copy read. Points vec at up to len bytes of the receive
+      buffer without removing them, returning the number of vec
+      elements filled out (two if the data wraps). The bytes stay valid
+      until consume() removes them. Returns 0 if the backend does not
+      support it, in which case use read()
+     */
+    uint8_t peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len);
+
+    // remove n bytes previously returned by peek_iovec()
+    bool consume(uint32_t n);
     
     void end();
     void flush();
@@ -62,6 +74,18 @@ public:
     virtual bool is_initialized() = 0;
     virtual bool tx_pending() = 0;
 
+    /*
+      two level transmit queueing. Data that can wait, such as file,
+      log and parameter transfers, checks txspace_bulk() instead of
+      txspace() before writing. Bulk data is only accepted while the
+      data already queued can be sent within the bulk latency, so
+      latency critical data written with the full txspace() is never
+      queued behind more than that much bulk data. A latency of 0, the
+      default, treats bulk data like any other
+     */
+    uint32_t txspace_bulk();
+    void set_bulk_latency_ms(uint16_t latency_ms) { _bulk_latency_ms = latency_ms; }
+
     // lock a port for exclusive use. Use a key of 0 to unlock
     bool lock_port(uint32_t write_key, uint32_t read_key);
 
@@ -258,6 +282,14 @@ protected:
     // discard incoming data on the port
     virtual bool _discard_input(void) = 0;
 
+    // backend zero copy read methods, only needed where the receive buffer is a ByteBuffer
+    virtual uint8_t _peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len) { return 0; }
+    virtual bool _consume(uint32_t n) { return false; }
+
+    // bytes written but not yet sent, for txspace_bulk(). Backends
+    // that don't know this accept bulk data whenever there is space
+    virtual uint32_t _tx_queued() { return 0; }
+
     // Helper to check if flow control is enabled given the passed setting
     bool flow_control_enabled(enum flow_control flow_control_setting) const;
 
@@ -272,6 +304,7 @@ protected:
     uint16_t _last_options;
 
 private:
+    uint16_t _bulk_latency_ms;
 
 #if AP_UART_MONITOR_ENABLED
     ByteBuffer *_monitor_read_buffer;
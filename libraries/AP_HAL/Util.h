@@ -124,7 +124,7 @@ public:
     /**
        return commandline arguments, if available
      */
-    virtual void commandline_arguments(uint8_t &argc, char * const *&argv) { argc = 0; }
+    virtual void commandline_arguments(int &argc, char * const *&argv) { argc = 0; }
 
     virtual bool toneAlarm_init(uint8_t types) { return false;}
     virtual void toneAlarm_set_buzzer_tone(float frequency, float volume, uint32_t duration_ms) {}
@@ -187,6 +187,12 @@ public:
     // generate Random values, will block until enough entropy is available
     virtual bool get_true_random_vals(uint8_t* data, size_t size, uint32_t timeout_us) { return false; }
 
+    // update crc over len bytes with a CRC peripheral, as crc_crc32()
+    // and crc16_ccitt() do. Returns false if there is no peripheral
+    // or it is in use, and the caller must calculate it in software
+    virtual bool crc32_hw(uint32_t &crc, const uint8_t *buf, uint32_t len) { return false; }
+    virtual bool crc16_ccitt_hw(uint16_t &crc, const uint8_t *buf, uint32_t len) { return false; }
+
     // log info on stack usage
     virtual void log_stack_info(void) {}
 
@@ -291,6 +291,7 @@ class HWDef:
     def write_IMU_config(self, f):
         '''write IMU config defines'''
         devlist = []
+        drivers = []
         wrapper = ''
         seen = set()
         for dev in self.imu_list:
@@ -314,24 +315,35 @@ class HWDef:
                     (wrapper, dev[i]) = self.parse_i2c_device(dev[i])
             n = len(devlist)+1
             devlist.append('HAL_INS_PROBE%u' % n)
+            # the driver index lets the frontend call the backend
+            # update without a virtual call in static dispatch builds
+            if driver not in drivers:
+                drivers.append(driver)
+            dispatch = drivers.index(driver)+1
+            if dev[-1].startswith("BOARD_MATCH("):
+                probe = 'INS_DISPATCH_PROBE(%u, AP_InertialSensor_%s::probe(*this,%s))' % (
+                    dispatch, driver, ','.join(dev[1:-1]))
+            else:
+                probe = 'INS_DISPATCH_PROBE(%u, AP_InertialSensor_%s::probe(*this,%s))' % (
+                    dispatch, driver, ','.join(dev[1:]))
             if aux_devid != -1:
-                f.write('#define HAL_INS_PROBE%u %s ADD_BACKEND_AUX(AP_InertialSensor_%s::probe(*this,%s),%d)\n' %
-                        (n, wrapper, driver, ','.join(dev[1:]), aux_devid))
+                f.write('#define HAL_INS_PROBE%u %s ADD_BACKEND_AUX(%s,%d)\n' %
+                        (n, wrapper, probe, aux_devid))
             elif instance != -1:
-                f.write('#define HAL_INS_PROBE%u %s ADD_BACKEND_INSTANCE(AP_InertialSensor_%s::probe(*this,%s),%d)\n' %
-                        (n, wrapper, driver, ','.join(dev[1:]), instance))
+                f.write('#define HAL_INS_PROBE%u %s ADD_BACKEND_INSTANCE(%s,%d)\n' %
+                        (n, wrapper, probe, instance))
             elif dev[-1].startswith("BOARD_MATCH("):
-                f.write(
-                    '#define HAL_INS_PROBE%u %s ADD_BACKEND_BOARD_MATCH(%s, AP_InertialSensor_%s::probe(*this,%s))\n'
-                    % (n, wrapper, dev[-1], driver, ','.join(dev[1:-1])))
+                f.write('#define HAL_INS_PROBE%u %s ADD_BACKEND_BOARD_MATCH(%s, %s)\n' %
+                        (n, wrapper, dev[-1], probe))
             else:
-                f.write(
-                    '#define HAL_INS_PROBE%u %s ADD_BACKEND(AP_InertialSensor_%s::probe(*this,%s))\n'
-                    % (n, wrapper, driver, ','.join(dev[1:])))
+                f.write('#define HAL_INS_PROBE%u %s ADD_BACKEND(%s)\n' %
+                        (n, wrapper, probe))
         if len(devlist) > 0:
             if len(devlist) < 3:
                 self.write_defaulting_define(f, 'INS_MAX_INSTANCES', len(devlist))
-            f.write('#define HAL_INS_PROBE_LIST %s\n\n' % ';'.join(devlist))
+            f.write('#define HAL_INS_PROBE_LIST %s\n' % ';'.join(devlist))
+            f.write('#define HAL_INS_DRIVER_LIST(X) %s\n\n' %
+                    ' '.join(['X(%u, %s)' % (i+1, d) for i, d in enumerate(drivers)]))
 
     def write_MAG_config(self, f):
         '''write MAG config defines'''
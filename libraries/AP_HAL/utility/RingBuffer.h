@@ -461,6 +461,164 @@ private:
     HAL_Semaphore sem;
 };
 
+/*
+  lock free ring buffer class for objects of fixed size, for use with
+  exactly one producer thread and one consumer thread. Only the
+  producer may call push() and only the consumer may call pop(),
+  peek() or clear(); the other methods may be called from either
+  thread. The head index is only written by the consumer and the tail
+  index only by the producer, so no semaphore is needed
+ */
+template <class T>
+class ObjectBuffer_SPSC {
+public:
+    ObjectBuffer_SPSC(uint32_t _size) {
+        // one slot is always left empty to tell a full buffer from
+        // an empty one
+        buffer = NEW_NOTHROW T[_size+1];
+        size = buffer != nullptr ? _size+1 : 0;
+    }
+    ~ObjectBuffer_SPSC(void) {
+        delete[] buffer;
+    }
+
+    /* Do not allow copies */
+    CLASS_NO_COPY(ObjectBuffer_SPSC);
+
+    // return size of ringbuffer
+    uint32_t get_size(void) const {
+        return size > 0 ? size-1 : 0;
+    }
+
+    // return number of objects available to be read from the front of the queue
+    uint32_t available(void) const {
+        const uint32_t _head = head.load(std::memory_order_acquire);
+        const uint32_t _tail = tail.load(std::memory_order_acquire);
+        return _tail >= _head ? _tail - _head : size - _head + _tail;
+    }
+
+    // return number of objects that could be written to the back of the queue
+    uint32_t space(void) const {
+        return get_size() - available();
+    }
+
+    // true is available() == 0
+    bool is_empty(void) const WARN_IF_UNUSED {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    // push one object onto the back of the queue, producer only
+    bool push(const T &object) {
+        if (size == 0) {
+            return false;
+        }
+        const uint32_t _tail = tail.load(std::memory_order_relaxed);
+        const uint32_t next = (_tail + 1) % size;
+        if (next == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        buffer[_tail] = object;
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // copy the object at the front of the queue without removing it, consumer only
+    bool peek(T &object) const WARN_IF_UNUSED {
+        const uint32_t _head = head.load(std::memory_order_relaxed);
+        if (_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        object = buffer[_head];
+        return true;
+    }
+
+    // pop earliest object off the front of the queue, consumer only
+    bool pop(T &object) WARN_IF_UNUSED {
+        if (!peek(object)) {
+            return false;
+        }
+        head.store((head.load(std::memory_order_relaxed) + 1) % size, std::memory_order_release);
+        return true;
+    }
+
+    // throw away an object from the front of the queue, consumer only
+    bool pop(void) {
+        const uint32_t _head = head.load(std::memory_order_relaxed);
+        if (_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        head.store((_head + 1) % size, std::memory_order_release);
+        return true;
+    }
+
+    // Discards the buffer content, emptying it, consumer only
+    void clear(void) {
+        head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    T *buffer;
+    uint32_t size;
+    std::atomic<uint32_t> head{0}; // next object to read, written by the consumer
+    std::atomic<uint32_t> tail{0}; // next slot to write, written by the producer
+};
+
+/*
+  lock free double buffer holding the latest value of an object, for
+  handing state from one writer thread to any number of reader
+  threads. The writer always fills the slot readers are not being
+  directed to, so a reader only has to retry if the writer completes
+  one update and starts another while it is copying. The sequence is
+  odd while a write is in progress and increases by two for each
+  completed write
+ */
+template <class T>
+class ObjectDoubleBuffer {
+public:
+    ObjectDoubleBuffer(void) {}
+
+    /* Do not allow copies */
+    CLASS_NO_COPY(ObjectDoubleBuffer);
+
+    // replace the current object, writer only
+    void publish(const T &object) {
+        const uint32_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot[((s >> 1) + 1) & 1] = object;
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    // copy the latest object, returns false if nothing has been
+    // published or a consistent copy could not be taken in max_tries
+    bool peek(T &object, uint8_t max_tries=3) const WARN_IF_UNUSED {
+        for (uint8_t i=0; i<max_tries; i++) {
+            const uint32_t s1 = seq.load(std::memory_order_acquire);
+            if (s1 < 2) {
+                return false;
+            }
+            object = slot[(s1 >> 1) & 1];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint32_t s2 = seq.load(std::memory_order_relaxed);
+            // the slot we copied is next written by the write that
+            // makes the sequence odd at (s1 & ~1) + 3
+            if (s2 - (s1 & ~1U) < 3) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // number of completed writes, changes whenever a new object is published
+    uint32_t count(void) const {
+        return seq.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    T slot[2];
+    std::atomic<uint32_t> seq{0};
+};
+
 /*
   ring buffer class for objects of fixed size with pointer
   access. Note that this is not thread safe, buf offers efficient
@@ -16,6 +16,7 @@
  */
 #include <AP_gtest.h>
 
+#include <thread>
 #include <utility>
 #include <AP_HAL/utility/RingBuffer.h>
 
@@ -102,6 +103,119 @@ TEST(ObjectBufferTest, SetSize)
     EXPECT_TRUE(x.is_empty());
 }
 
+TEST(ObjectBufferSPSCTest, Basic)
+{
+    const uint16_t size = 32;
+    ObjectBuffer_SPSC<uint32_t> x{size};
+    EXPECT_EQ(x.available(), 0U);
+    EXPECT_EQ(x.get_size(), unsigned(size));
+    EXPECT_EQ(x.space(), unsigned(size));
+    EXPECT_TRUE(x.is_empty());
+
+    // fill the buffer, the next push must fail
+    for (uint32_t i=0; i<size; i++) {
+        EXPECT_TRUE(x.push(i));
+    }
+    EXPECT_FALSE(x.push(size));
+    EXPECT_EQ(x.available(), unsigned(size));
+    EXPECT_EQ(x.space(), 0U);
+
+    // objects come out in order, including after the indexes wrap
+    uint32_t v;
+    for (uint32_t i=0; i<3*size; i++) {
+        EXPECT_TRUE(x.peek(v));
+        EXPECT_EQ(v, i);
+        EXPECT_TRUE(x.pop(v));
+        EXPECT_EQ(v, i);
+        EXPECT_TRUE(x.push(i+size));
+    }
+    EXPECT_EQ(x.available(), unsigned(size));
+
+    x.clear();
+    EXPECT_TRUE(x.is_empty());
+    EXPECT_FALSE(x.pop(v));
+    EXPECT_FALSE(x.pop());
+}
+
+TEST(ObjectBufferSPSCTest, Threads)
+{
+    const uint32_t count = 10000;
+    ObjectBuffer_SPSC<uint32_t> x{16};
+    std::thread producer([&x]() {
+        for (uint32_t i=0; i<count; ) {
+            if (x.push(i)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expected = 0;
+    while (expected < count) {
+        uint32_t v;
+        if (x.pop(v)) {
+            ASSERT_EQ(v, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(x.is_empty());
+}
+
+TEST(ObjectDoubleBufferTest, Basic)
+{
+    ObjectDoubleBuffer<uint32_t> x;
+    uint32_t v;
+    EXPECT_EQ(x.count(), 0U);
+    EXPECT_FALSE(x.peek(v));
+
+    for (uint32_t i=0; i<5; i++) {
+        x.publish(i);
+        EXPECT_EQ(x.count(), i+1);
+        EXPECT_TRUE(x.peek(v));
+        EXPECT_EQ(v, i);
+        // peeking does not consume
+        EXPECT_TRUE(x.peek(v));
+        EXPECT_EQ(v, i);
+    }
+}
+
+TEST(ObjectDoubleBufferTest, Threads)
+{
+    // every published object has all elements equal, so a torn copy
+    // shows up as a mismatch
+    struct Obj {
+        uint32_t v[16];
+    };
+    const uint32_t count = 100000;
+    ObjectDoubleBuffer<Obj> x;
+    std::thread writer([&x]() {
+        Obj obj;
+        for (uint32_t i=1; i<=count; i++) {
+            for (auto &e : obj.v) {
+                e = i;
+            }
+            x.publish(obj);
+        }
+    });
+    uint32_t last = 0;
+    while (last < count) {
+        Obj obj;
+        if (!x.peek(obj)) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (const auto &e : obj.v) {
+            ASSERT_EQ(e, obj.v[0]);
+        }
+        ASSERT_GE(obj.v[0], last);
+        last = obj.v[0];
+    }
+    writer.join();
+}
+
 TEST(ObjectBufferTest, PeekTest)
 {
     ByteBuffer bb(128);
@@ -77,6 +77,16 @@ uint16_t DSP::fft_analyse(AP_HAL::DSP::FFTWindowState* state, uint16_t start_bin
     return step_calc_frequencies_f32(fft, start_bin, end_bin);
 }
 
+// calculate the power of each stored frequency of the windowed samples
+void DSP::fft_power(AP_HAL::DSP::FFTWindowState* state)
+{
+    FFTWindowStateARM* fft = (FFTWindowStateARM*)state;
+    step_arm_cfft_f32(fft);
+    step_bitreversal(fft);
+    step_stage_rfft_f32(fft);
+    step_arm_cmplx_mag_squared_f32(fft);
+}
+
 // create an instance of the FFT state machine
 DSP::FFTWindowStateARM::FFTWindowStateARM(uint16_t window_size, uint16_t sample_rate, uint8_t sliding_window_size)
     : AP_HAL::DSP::FFTWindowState::FFTWindowState(window_size, sample_rate, sliding_window_size)
@@ -221,6 +231,15 @@ void DSP::step_arm_cmplx_mag_f32(FFTWindowStateARM* fft, uint16_t start_bin, uin
     // 256  -  29us F7, 28us F4,  7us H7
     // 512  -  55us F7, 93us F4, 13us H7
     // 1024 - 131us F7,          25us H7
+    step_arm_cmplx_mag_squared_f32(fft);
+    step_cmplx_mag(fft, start_bin, end_bin, noise_att_cutoff);
+
+    TIMER_END(_arm_cmplx_mag_f32_timer);
+}
+
+// step 5a: find the power of each frequency from the complex data
+void DSP::step_arm_cmplx_mag_squared_f32(FFTWindowStateARM* fft)
+{
     // General case for the magnitudes - see https://stackoverflow.com/questions/42299932/dsp-libraries-rfft-strange-results
     // The frequency of each of those frequency components are given by k*fs/N
 
@@ -229,10 +248,6 @@ void DSP::step_arm_cmplx_mag_f32(FFTWindowStateARM* fft, uint16_t start_bin, uin
     fft->_freq_bins[fft->_bin_count] = sq(fft->_rfft_data[1]); // Nyquist
     fft->_rfft_data[fft->_window_size] = fft->_rfft_data[1]; // Nyquist for the interpolator
     fft->_rfft_data[fft->_window_size + 1] = 0;
-
-    step_cmplx_mag(fft, start_bin, end_bin, noise_att_cutoff);
-
-    TIMER_END(_arm_cmplx_mag_f32_timer);
 }
 
 // step 6: find the bin with the highest energy and interpolate the required frequency
@@ -48,6 +48,7 @@ public:
     };
 
 protected:
+    void fft_power(FFTWindowState* state) override;
     void vector_max_float(const float* vin, uint16_t len, float* maxValue, uint16_t* maxIndex) const override {
         uint32_t mindex;
         arm_max_f32(vin, len, maxValue, &mindex);
@@ -71,6 +72,7 @@ private:
     void step_arm_cfft_f32(FFTWindowStateARM* fft);
     void step_bitreversal(FFTWindowStateARM* fft);
     void step_stage_rfft_f32(FFTWindowStateARM* fft);
+    void step_arm_cmplx_mag_squared_f32(FFTWindowStateARM* fft);
     void step_arm_cmplx_mag_f32(FFTWindowStateARM* fft, uint16_t start_bin, uint16_t end_bin, float noise_att_cutoff);
     uint16_t step_calc_frequencies_f32(FFTWindowStateARM* fft, uint16_t start_bin, uint16_t end_bin);
     // candan's frequency interpolator
@@ -30,6 +30,8 @@
 #define HAL_DEVICE_THREAD_STACK 1024
 #endif
 
+#define EVT_TRANSFER_QUEUED EVENT_MASK(0)
+
 using namespace ChibiOS;
 
 extern const AP_HAL::HAL& hal;
@@ -56,6 +58,9 @@ void DeviceBus::bus_thread(void *arg)
     struct DeviceBus *binfo = (struct DeviceBus *)arg;
 
     while (true) {
+        // transfers queued by other threads go ahead of the callbacks
+        binfo->run_queued_transfers();
+
         uint64_t now = AP_HAL::micros64();
         DeviceBus::callback_info *callback;
 
@@ -95,46 +100,86 @@ void DeviceBus::bus_thread(void *arg)
         if (delay < 100) {
             delay = 100;
         }
-        hal.scheduler->delay_microseconds(delay);
+        // a queued transfer wakes the thread early
+        sysinterval_t ticks = chTimeUS2I(delay);
+        if (ticks < CH_CFG_ST_TIMEDELTA) {
+            ticks = CH_CFG_ST_TIMEDELTA;
+        }
+        chEvtWaitAnyTimeout(EVT_TRANSFER_QUEUED, ticks);
     }
     return;
 }
 
-#if CH_CFG_USE_HEAP == TRUE
-AP_HAL::Device::PeriodicHandle DeviceBus::register_periodic_callback(uint32_t period_usec, AP_HAL::Device::PeriodicCb cb, AP_HAL::Device *_hal_device)
+/*
+  run the queued transfers back to back, taking the bus once for the
+  whole chain rather than once per transfer
+ */
+void DeviceBus::run_queued_transfers(void)
 {
-    if (!thread_started) {
-        thread_started = true;
-
-        hal_device = _hal_device;
-        // setup a name for the thread
-        const uint8_t name_len = 7;
-        char *name = (char *)malloc(name_len);
-        if (name == nullptr){
-            return nullptr;
-        }
-        switch (hal_device->bus_type()) {
-        case AP_HAL::Device::BUS_TYPE_I2C:
-            snprintf(name, name_len, "I2C%u",
-                     hal_device->bus_num());
-            break;
-
-        case AP_HAL::Device::BUS_TYPE_SPI:
-            snprintf(name, name_len, "SPI%u",
-                     hal_device->bus_num());
-            break;
-        default:
+    if (transfer_queue_count == 0) {
+        return;
+    }
+    WITH_SEMAPHORE(semaphore);
+    while (true) {
+        queued_transfer t;
+        chSysLock();
+        if (transfer_queue_count == 0) {
+            chSysUnlock();
             break;
         }
+        t = transfer_queue[transfer_queue_head];
+        transfer_queue_head = (transfer_queue_head + 1) % HAL_DEVICE_TRANSFER_QUEUE_LEN;
+        transfer_queue_count--;
+        chSysUnlock();
 
-        thread_ctx = thread_create_alloc(THD_WORKING_AREA_SIZE(HAL_DEVICE_THREAD_STACK),
-                                         name,
-                                         thread_priority,           /* Initial priority.    */
-                                         DeviceBus::bus_thread,    /* Thread function.     */
-                                         this);                     /* Thread parameter.    */
-        if (thread_ctx == nullptr) {
-            AP_HAL::panic("Failed to create bus thread %s", name);
-        }
+        t.cb(t.dev->transfer(t.send, t.send_len, t.recv, t.recv_len));
+    }
+}
+
+#if CH_CFG_USE_HEAP == TRUE
+bool DeviceBus::start_thread(AP_HAL::Device *_hal_device)
+{
+    if (thread_started) {
+        return true;
+    }
+    thread_started = true;
+
+    hal_device = _hal_device;
+    // setup a name for the thread
+    const uint8_t name_len = 7;
+    char *name = (char *)malloc(name_len);
+    if (name == nullptr){
+        return false;
+    }
+    switch (hal_device->bus_type()) {
+    case AP_HAL::Device::BUS_TYPE_I2C:
+        snprintf(name, name_len, "I2C%u",
+                 hal_device->bus_num());
+        break;
+
+    case AP_HAL::Device::BUS_TYPE_SPI:
+        snprintf(name, name_len, "SPI%u",
+                 hal_device->bus_num());
+        break;
+    default:
+        break;
+    }
+
+    thread_ctx = thread_create_alloc(THD_WORKING_AREA_SIZE(HAL_DEVICE_THREAD_STACK),
+                                     name,
+                                     thread_priority,           /* Initial priority.    */
+                                     DeviceBus::bus_thread,    /* Thread function.     */
+                                     this);                     /* Thread parameter.    */
+    if (thread_ctx == nullptr) {
+        AP_HAL::panic("Failed to create bus thread %s", name);
+    }
+    return true;
+}
+
+AP_HAL::Device::PeriodicHandle DeviceBus::register_periodic_callback(uint32_t period_usec, AP_HAL::Device::PeriodicCb cb, AP_HAL::Device *_hal_device)
+{
+    if (!start_thread(_hal_device)) {
+        return nullptr;
     }
     DeviceBus::callback_info *callback = NEW_NOTHROW DeviceBus::callback_info;
     if (callback == nullptr) {
@@ -150,6 +195,33 @@ AP_HAL::Device::PeriodicHandle DeviceBus::register_periodic_callback(uint32_t pe
 
     return callback;
 }
+
+/*
+  add a transfer to the queue and wake the bus thread to run it
+ */
+bool DeviceBus::queue_transfer(AP_HAL::Device *_hal_device, const uint8_t *send, uint32_t send_len,
+                               uint8_t *recv, uint32_t recv_len, AP_HAL::Device::TransferCb cb)
+{
+    if (!start_thread(_hal_device)) {
+        return false;
+    }
+    chSysLock();
+    if (transfer_queue_count >= HAL_DEVICE_TRANSFER_QUEUE_LEN) {
+        chSysUnlock();
+        return false;
+    }
+    queued_transfer &t = transfer_queue[(transfer_queue_head + transfer_queue_count) % HAL_DEVICE_TRANSFER_QUEUE_LEN];
+    t.dev = _hal_device;
+    t.send = send;
+    t.send_len = send_len;
+    t.recv = recv;
+    t.recv_len = recv_len;
+    t.cb = cb;
+    transfer_queue_count++;
+    chSysUnlock();
+    chEvtSignal(thread_ctx, EVT_TRANSFER_QUEUED);
+    return true;
+}
 #endif // CH_CFG_USE_HEAP
 
 /*
@@ -29,6 +29,10 @@
 #include "shared_dma.h"
 #include "hwdef/common/bouncebuffer.h"
 
+#ifndef HAL_DEVICE_TRANSFER_QUEUE_LEN
+#define HAL_DEVICE_TRANSFER_QUEUE_LEN 8
+#endif
+
 namespace ChibiOS {
 
 class DeviceBus {
@@ -49,11 +53,21 @@ public:
     bool adjust_timer(AP_HAL::Device::PeriodicHandle h, uint32_t period_usec);
     static void bus_thread(void *arg);
 
+    // queue a transfer on hal_device to run on the bus thread, see AP_HAL::Device::transfer_queued()
+    bool queue_transfer(AP_HAL::Device *hal_device, const uint8_t *send, uint32_t send_len,
+                        uint8_t *recv, uint32_t recv_len, AP_HAL::Device::TransferCb cb);
+
     bool bouncebuffer_setup(const uint8_t *&buf_tx, uint16_t tx_len,
                             uint8_t *&buf_rx, uint16_t rx_len) WARN_IF_UNUSED;
     void bouncebuffer_finish(const uint8_t *buf_tx, uint8_t *buf_rx, uint16_t rx_len);
 
 private:
+    // start the bus thread, named after the bus of hal_device
+    bool start_thread(AP_HAL::Device *hal_device);
+
+    // run all queued transfers with the bus semaphore held
+    void run_queued_transfers(void);
+
     struct callback_info {
         struct callback_info *next;
         AP_HAL::Device::PeriodicCb cb;
@@ -68,6 +82,18 @@ private:
     // support for bounce buffers for DMA-safe transfers
     struct bouncebuffer_t *bounce_buffer_tx;
     struct bouncebuffer_t *bounce_buffer_rx;
+
+    // transfers waiting for the bus thread, protected by a system lock
+    struct queued_transfer {
+        AP_HAL::Device *dev;
+        const uint8_t *send;
+        uint32_t send_len;
+        uint8_t *recv;
+        uint32_t recv_len;
+        AP_HAL::Device::TransferCb cb;
+    } transfer_queue[HAL_DEVICE_TRANSFER_QUEUE_LEN];
+    uint8_t transfer_queue_head;
+    uint8_t transfer_queue_count;
 };
 
 }
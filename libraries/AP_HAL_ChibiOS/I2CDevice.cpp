@@ -440,6 +440,12 @@ AP_HAL::Device::PeriodicHandle I2CDevice::register_periodic_callback(uint32_t pe
     return bus.register_periodic_callback(period_usec, cb, this);
 }
 
+bool I2CDevice::transfer_queued(const uint8_t *send, uint32_t send_len,
+                                uint8_t *recv, uint32_t recv_len, AP_HAL::Device::TransferCb cb)
+{
+    return bus.queue_transfer(this, send, send_len, recv, recv_len, cb);
+}
+
 
 /*
   adjust a periodic callback
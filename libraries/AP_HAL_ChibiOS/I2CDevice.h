@@ -55,7 +55,7 @@ public:
     static void set_bus_to_floating(uint8_t busidx);
 };
 
-class I2CDevice : public AP_HAL::I2CDevice {
+class I2CDevice final : public AP_HAL::I2CDevice {
 public:
     static I2CDevice *from(AP_HAL::I2CDevice *dev)
     {
@@ -88,6 +88,10 @@ public:
     /* See AP_HAL::Device::adjust_periodic_callback() */
     bool adjust_periodic_callback(AP_HAL::Device::PeriodicHandle h, uint32_t period_usec) override;
 
+    /* See AP_HAL::Device::transfer_queued() */
+    bool transfer_queued(const uint8_t *send, uint32_t send_len,
+                         uint8_t *recv, uint32_t recv_len, AP_HAL::Device::TransferCb cb) override;
+
     AP_HAL::Semaphore* get_semaphore() override {
         // if asking for invalid bus number use bus 0 semaphore
         return &bus.semaphore;
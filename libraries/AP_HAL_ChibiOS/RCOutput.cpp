@@ -40,6 +40,7 @@
 #include <AP_InternalError/AP_InternalError.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
 #include <AP_Common/ExpandingString.h>
+#include <AP_Common/AP_CycleTrace.h>
 #include <GCS_MAVLink/GCS.h>
 
 #if AP_SIM_ENABLED
@@ -75,6 +76,9 @@ struct RCOutput::pwm_group RCOutput::pwm_group_list[] = { HAL_PWM_GROUPS };
 struct RCOutput::irq_state RCOutput::irq;
 #endif
 const uint8_t RCOutput::NUM_GROUPS = ARRAY_SIZE(RCOutput::pwm_group_list);
+#if HAL_DSHOT_ENABLED
+uint8_t RCOutput::dshot_send_order[ARRAY_SIZE(RCOutput::pwm_group_list)];
+#endif
 
 // event mask for triggering a PWM send
 // EVT_PWM_SEND  = 11
@@ -983,6 +987,10 @@ bool RCOutput::setup_group_DMA(pwm_group &group, uint32_t bitrate, uint32_t bit_
     }
     // reset the pulse time inside the lock
     group.dshot_pulse_time_us = group.dshot_pulse_send_time_us = pulse_time_us;
+#if HAL_SERIALLED_ENABLED
+    // buffer contents and bit widths may have changed
+    group.serial_led_encoded = false;
+#endif
 
 #ifdef HAL_WITH_BIDIR_DSHOT
     // configure input capture DMA if required
@@ -1060,6 +1068,10 @@ bool RCOutput::setup_group_DMA(pwm_group &group, uint32_t bitrate, uint32_t bit_
  */
 void RCOutput::set_group_mode(pwm_group &group)
 {
+#if HAL_DSHOT_ENABLED
+    // the rcout thread replans the send order before the next send
+    _dshot_send_order_valid = false;
+#endif
     if (group.pwm_started) {
         pwmStop(group.pwm_drv);
         group.pwm_started = false;
@@ -1351,6 +1363,10 @@ void RCOutput::push(void)
     }
     corked = false;
     memcpy(period, period_corked, sizeof(period));
+#if HAL_DSHOT_ENABLED
+    _last_push_us = AP_HAL::micros();
+    _push_send_pending = true;
+#endif
     push_local();
 #if HAL_WITH_IO_MCU
     if (iomcu_enabled) {
@@ -1359,6 +1375,22 @@ void RCOutput::push(void)
 #endif
 }
 
+#if HAL_DSHOT_ENABLED
+/*
+  time of the last push() and of the first DShot DMA start after it
+ */
+bool RCOutput::get_push_timing(uint32_t &push_us, uint32_t &send_us) const
+{
+    PushTiming timing;
+    if (!_push_timing.peek(timing)) {
+        return false;
+    }
+    push_us = timing.push_us;
+    send_us = timing.send_us;
+    return true;
+}
+#endif
+
 /*
   enable sbus output
  */
@@ -1464,6 +1496,42 @@ void RCOutput::led_timer_tick(rcout_timer_t cycle_start_us, rcout_timer_t timeou
     }
 }
 
+#if HAL_DSHOT_ENABLED
+/*
+  plan the order in which the DShot groups are sent each cycle. With
+  bi-directional DShot a group whose TIMx_UP DMA is shared with its
+  input capture has to finish receiving telemetry before another group
+  can start, whereas other groups receive telemetry while the
+  following groups are sent. Sending the groups that do not hold up
+  the cycle first lets their telemetry overlap the rest of the sends,
+  and leaves the waits to the groups at the end, where the wait after
+  the final group is covered by dshot_collect_dma_locks(). Groups not
+  running DShot are left out of the plan
+ */
+void RCOutput::dshot_plan_send_order()
+{
+    uint8_t n = 0;
+    // first the groups that never hold up the next send, then those that may
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        for (uint8_t i = 0; i < NUM_GROUPS; i++) {
+            const pwm_group &group = pwm_group_list[i];
+            if (!is_dshot_protocol(group.current_mode)) {
+                continue;
+            }
+            bool holds_up = false;
+#if defined(HAL_WITH_BIDIR_DSHOT) && defined(HAL_TIM_UP_SHARED)
+            holds_up = group.shared_up_dma && (group.ch_mask & _bdshot.mask) != 0;
+#endif
+            if (holds_up == (pass == 1)) {
+                dshot_send_order[n++] = i;
+            }
+        }
+    }
+    _dshot_send_count = n;
+    _dshot_send_order_valid = true;
+}
+#endif // HAL_DSHOT_ENABLED
+
 // send dshot for all groups that support it
 void RCOutput::dshot_send_groups(rcout_timer_t cycle_start_us, rcout_timer_t timeout_period_us)
 {
@@ -1472,6 +1540,10 @@ void RCOutput::dshot_send_groups(rcout_timer_t cycle_start_us, rcout_timer_t tim
         return;
     }
 
+    if (!_dshot_send_order_valid) {
+        dshot_plan_send_order();
+    }
+
     bool command_sent = false;
     // queue up a command if there is one
     if (_dshot_current_command.cycle == 0
@@ -1479,7 +1551,8 @@ void RCOutput::dshot_send_groups(rcout_timer_t cycle_start_us, rcout_timer_t tim
         // got a new command
     }
 
-    for (auto &group : pwm_group_list) {
+    for (uint8_t s = 0; s < _dshot_send_count; s++) {
+        pwm_group &group = pwm_group_list[dshot_send_order[s]];
         bool pulse_sent = false;
         // send a dshot command
         if (group.can_send_dshot_pulse()
@@ -1492,8 +1565,9 @@ void RCOutput::dshot_send_groups(rcout_timer_t cycle_start_us, rcout_timer_t tim
             pulse_sent = true;
         }
 #if defined(HAL_WITH_BIDIR_DSHOT) && defined(HAL_TIM_UP_SHARED)
-        // prevent the next send going out until the previous send has released its DMA channel
-        if (pulse_sent && group.shared_up_dma && group.bdshot.enabled) {
+        // prevent the next send going out until the previous send has released its DMA channel,
+        // there is no need to wait after the last group
+        if (pulse_sent && group.shared_up_dma && group.bdshot.enabled && s + 1 < _dshot_send_count) {
             chEvtWaitOneTimeout(DSHOT_CASCADE, calc_ticks_remaining(group, cycle_start_us, timeout_period_us, _dshot_period_us));
         }
 #else
@@ -1629,6 +1703,8 @@ void RCOutput::fill_DMA_buffer_dshot(dmar_uint_t *buffer, uint8_t stride, uint16
 void RCOutput::dshot_send(pwm_group &group, rcout_timer_t cycle_start_us, rcout_timer_t timeout_period_us)
 {
 #if HAL_DSHOT_ENABLED
+    TRACE_SCOPE(DSHOT_SEND);
+
     if (soft_serial_waiting() || !is_dshot_send_allowed(group.dshot_state)) {
         // doing serial output or DMAR input, don't send DShot pulses
         return;
@@ -1725,6 +1801,12 @@ void RCOutput::dshot_send(pwm_group &group, rcout_timer_t cycle_start_us, rcout_
     chEvtGetAndClearEvents(group.dshot_event_mask | DSHOT_CASCADE);
     // start sending the pulses out
     send_pulses_DMAR(group, DSHOT_BUFFER_LENGTH);
+
+    if (_push_send_pending) {
+        // first frame with the values from the last push()
+        _push_send_pending = false;
+        _push_timing.publish(PushTiming{_last_push_us, AP_HAL::micros()});
+    }
 #endif // HAL_DSHOT_ENABLED
 }
 
@@ -2549,10 +2631,26 @@ bool RCOutput::set_serial_led_num_LEDs(const uint16_t chan, uint8_t num_leds, ou
 
 #pragma GCC push_options
 #pragma GCC optimize("O2")
-// Fill the group DMA buffer with data to be output
+/*
+  Fill the group DMA buffer with data to be output. Padding, clock
+  channels and ProfiLED blank frames don't change between sends, so
+  once the buffer has been filled only the LEDs changed since the last
+  send are encoded
+ */
 void RCOutput::fill_DMA_buffer_serial_led(pwm_group& group)
 {
-    memset(group.dma_buffer, 0, group.dma_buffer_len);
+    const bool full = !group.serial_led_encoded;
+    uint8_t start = group.serial_led_dirty_start;
+    uint8_t end = MIN(group.serial_led_dirty_end, group.serial_nleds);
+    if (full) {
+        memset(group.dma_buffer, 0, group.dma_buffer_len);
+        start = 0;
+        end = group.serial_nleds;
+    }
+    group.serial_led_encoded = true;
+    group.serial_led_dirty_start = 0;
+    group.serial_led_dirty_end = 0;
+
     for (uint8_t j = 0; j < 4; j++) {
         if (group.serial_led_data[j] == nullptr) {
             // something very bad has happended
@@ -2561,13 +2659,15 @@ void RCOutput::fill_DMA_buffer_serial_led(pwm_group& group)
 
         if (group.current_mode == MODE_PROFILED && (group.clock_mask & 1U<<j) != 0) {
             // output clock channel
-            for (uint8_t i = 0; i < group.serial_nleds; i++) {
-                _set_profiled_clock(&group, j, i);
+            if (full) {
+                for (uint8_t i = 0; i < group.serial_nleds; i++) {
+                    _set_profiled_clock(&group, j, i);
+                }
             }
             continue;
         }
 
-        for (uint8_t i = 0; i < group.serial_nleds; i++) {
+        for (uint8_t i = start; i < end; i++) {
             const SerialLed& led = group.serial_led_data[j][i];
             switch (group.current_mode) {
                 case MODE_NEOPIXEL:
@@ -2591,6 +2691,23 @@ void RCOutput::fill_DMA_buffer_serial_led(pwm_group& group)
     }
 }
 
+/*
+  expand a byte MSB first into 8 interleaved DMA words, looking up the
+  pulse width for each bit
+*/
+void RCOutput::_expand_serial_led_byte(dmar_uint_t *buf, uint8_t byte, const dmar_uint_t ticks[2])
+{
+    const uint8_t stride = 4;
+    buf[0*stride] = ticks[(byte >> 7) & 1];
+    buf[1*stride] = ticks[(byte >> 6) & 1];
+    buf[2*stride] = ticks[(byte >> 5) & 1];
+    buf[3*stride] = ticks[(byte >> 4) & 1];
+    buf[4*stride] = ticks[(byte >> 3) & 1];
+    buf[5*stride] = ticks[(byte >> 2) & 1];
+    buf[6*stride] = ticks[(byte >> 1) & 1];
+    buf[7*stride] = ticks[byte & 1];
+}
+
 /*
   setup neopixel (WS2812B) output data for a given output channel
   and a LED number. LED -1 is all LEDs
@@ -2601,13 +2718,11 @@ void RCOutput::_set_neopixel_rgb_data(pwm_group *grp, uint8_t idx, uint8_t led,
     const uint8_t neopixel_bit_length = 24;
     const uint8_t stride = 4;
     dmar_uint_t *buf = grp->dma_buffer + (led * neopixel_bit_length + pad_start_bits) * stride + idx;
-    uint32_t bits = (green<<16) | (red<<8) | blue;
-    const uint32_t BIT_0 = NEOP_BIT_0_TICKS * grp->bit_width_mul;
-    const uint32_t BIT_1 = NEOP_BIT_1_TICKS * grp->bit_width_mul;
-    for (uint16_t b=0; b < 24; b++) {
-        buf[b * stride] = (bits & 0x800000) ? BIT_1 : BIT_0;
-        bits <<= 1;
-    }
+    const dmar_uint_t ticks[2] { dmar_uint_t(NEOP_BIT_0_TICKS * grp->bit_width_mul),
+                                 dmar_uint_t(NEOP_BIT_1_TICKS * grp->bit_width_mul) };
+    _expand_serial_led_byte(buf, green, ticks);
+    _expand_serial_led_byte(buf + 8*stride, red, ticks);
+    _expand_serial_led_byte(buf + 16*stride, blue, ticks);
 }
 
 /*
@@ -2620,12 +2735,12 @@ void RCOutput::_set_profiled_rgb_data(pwm_group *grp, uint8_t idx, uint8_t led,
     const uint8_t bit_length = 25;
     const uint8_t stride = 4;
     dmar_uint_t *buf = grp->dma_buffer + (led * bit_length + pad_start_bits) * stride + idx;
-    uint32_t bits = 0x1000000 | (blue<<16) | (red<<8) | green;
-    const uint32_t BIT_1 = PROFI_BIT_1_TICKS * grp->bit_width_mul;
-    for (uint16_t b=0; b < bit_length; b++) {
-        buf[b * stride] = (bits & 0x1000000) ? 0 : BIT_1;
-        bits <<= 1;
-    }
+    // bits are inverted, with a leading 1 bit
+    const dmar_uint_t ticks[2] { dmar_uint_t(PROFI_BIT_1_TICKS * grp->bit_width_mul), 0 };
+    buf[0] = 0;
+    _expand_serial_led_byte(buf + 1*stride, blue, ticks);
+    _expand_serial_led_byte(buf + 9*stride, red, ticks);
+    _expand_serial_led_byte(buf + 17*stride, green, ticks);
 }
 
 /*
@@ -2750,11 +2865,24 @@ void RCOutput::serial_led_set_single_rgb_data(pwm_group& group, uint8_t idx, uin
     switch (group.current_mode) {
         case MODE_PROFILED:
         case MODE_NEOPIXEL:
-        case MODE_NEOPIXELRGB:
-            group.serial_led_data[idx][led].red = red;
-            group.serial_led_data[idx][led].green = green;
-            group.serial_led_data[idx][led].blue = blue;
+        case MODE_NEOPIXELRGB: {
+            SerialLed &data = group.serial_led_data[idx][led];
+            if (data.red == red && data.green == green && data.blue == blue) {
+                // unchanged, nothing to encode
+                break;
+            }
+            data.red = red;
+            data.green = green;
+            data.blue = blue;
+            if (group.serial_led_dirty_start >= group.serial_led_dirty_end) {
+                group.serial_led_dirty_start = led;
+                group.serial_led_dirty_end = led + 1;
+            } else {
+                group.serial_led_dirty_start = MIN(group.serial_led_dirty_start, led);
+                group.serial_led_dirty_end = MAX(group.serial_led_dirty_end, uint8_t(led + 1));
+            }
             break;
+        }
         default:
             break;
     }
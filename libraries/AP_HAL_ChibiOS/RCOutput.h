@@ -297,6 +297,13 @@ public:
     */
     void force_trigger_groups(bool onoff) override { force_trigger = onoff; }
 
+#if HAL_DSHOT_ENABLED
+    /*
+      time of the last push() and of the first DShot DMA start after it
+    */
+    bool get_push_timing(uint32_t &push_us, uint32_t &send_us) const override;
+#endif
+
     /*
      timer information
      */
@@ -390,6 +397,11 @@ private:
         // structure to hold serial LED data until it can be transferred
         // to the DMA buffer
         SerialLed* serial_led_data[4];
+        // range of LEDs changed since the DMA buffer was last filled
+        uint8_t serial_led_dirty_start;
+        uint8_t serial_led_dirty_end;
+        // DMA buffer holds encoded LED data, only changed LEDs need encoding
+        bool serial_led_encoded;
 #endif
 
         eventmask_t dshot_event_mask;
@@ -613,9 +625,25 @@ private:
 
     DshotEscType _dshot_esc_type;
 
+    // push() and first DMA start after it, for output latency
+    // measurement. The pair is published by the rcout thread
+    struct PushTiming {
+        uint32_t push_us;
+        uint32_t send_us;
+    };
+    ObjectDoubleBuffer<PushTiming> _push_timing;
+    volatile uint32_t _last_push_us;
+    volatile bool _push_send_pending;
+
     // control updates to channel masks
     bool _disable_channel_mask_updates;
 
+    // order in which dshot_send_groups() sends the DShot groups, see
+    // dshot_plan_send_order()
+    static uint8_t dshot_send_order[];
+    uint8_t _dshot_send_count;
+    volatile bool _dshot_send_order_valid;
+
     bool dshot_command_is_active(const pwm_group& group) const {
       return (_dshot_current_command.chan == RCOutput::ALL_CHANNELS || (group.ch_mask & (1UL << _dshot_current_command.chan)))
                 && _dshot_current_command.cycle > 0;
@@ -715,6 +743,7 @@ private:
     static const eventmask_t EVT_PWM_SYNTHETIC_SEND  = EVENT_MASK(13);
 
     void dshot_send_groups(rcout_timer_t cycle_start_us, rcout_timer_t timeout_us);
+    void dshot_plan_send_order();
     void dshot_send(pwm_group &group, rcout_timer_t cycle_start_us, rcout_timer_t timeout_us);
     bool dshot_send_command(pwm_group &group, uint8_t command, uint8_t chan);
     static void dshot_update_tick(virtual_timer_t*, void* p);
@@ -768,6 +797,7 @@ private:
     void _set_profiled_rgb_data(pwm_group *grp, uint8_t idx, uint8_t led, uint8_t red, uint8_t green, uint8_t blue);
     void _set_profiled_clock(pwm_group *grp, uint8_t idx, uint8_t led);
     void _set_profiled_blank_frame(pwm_group *grp, uint8_t idx, uint8_t led);
+    static void _expand_serial_led_byte(dmar_uint_t *buf, uint8_t byte, const dmar_uint_t ticks[2]);
 #if AP_HAL_SHARED_DMA_ENABLED
     /*
       serial output support
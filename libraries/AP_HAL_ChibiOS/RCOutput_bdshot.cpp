@@ -53,6 +53,8 @@ void RCOutput::set_bidir_dshot_mask(uint32_t mask)
 #ifdef HAL_WITH_BIDIR_DSHOT
     const uint32_t local_mask = (mask >> chan_offset) & ~_bdshot.disabled_mask;
     _bdshot.mask = local_mask;
+    // groups may now hold up the send cycle differently
+    _dshot_send_order_valid = false;
     // we now need to reconfigure the DMA channels since they are affected by the value of the mask
     for (uint8_t i = 0; i < NUM_GROUPS; i++ ) {
         pwm_group &group = pwm_group_list[i];
@@ -349,6 +349,12 @@ bool SPIDevice::adjust_periodic_callback(AP_HAL::Device::PeriodicHandle h, uint3
     return bus.adjust_timer(h, period_usec);
 }
 
+bool SPIDevice::transfer_queued(const uint8_t *send, uint32_t send_len,
+                                uint8_t *recv, uint32_t recv_len, AP_HAL::Device::TransferCb cb)
+{
+    return bus.queue_transfer(this, send, send_len, recv, recv_len, cb);
+}
+
 /*
   stop the SPI peripheral and set the SCK line as a GPIO to prevent the clock
   line floating while we are waiting for the next spiStart()
@@ -86,7 +86,7 @@ struct SPIDesc {
 };
 
 
-class SPIDevice : public AP_HAL::SPIDevice {
+class SPIDevice final : public AP_HAL::SPIDevice {
 public:
     SPIDevice(SPIBus &_bus, SPIDesc &_device_desc);
 
@@ -141,6 +141,10 @@ public:
     /* See AP_HAL::Device::adjust_periodic_callback() */
     bool adjust_periodic_callback(AP_HAL::Device::PeriodicHandle h, uint32_t period_usec) override;
 
+    /* See AP_HAL::Device::transfer_queued() */
+    bool transfer_queued(const uint8_t *send, uint32_t send_len,
+                         uint8_t *recv, uint32_t recv_len, AP_HAL::Device::TransferCb cb) override;
+
     bool set_chip_select(bool set) override;
 
     bool acquire_bus(bool acquire, bool skip_cs);
@@ -171,7 +171,19 @@ void Scheduler::delay_microseconds(uint16_t usec)
         ticks = 1;
     }
     ticks = MIN(TIME_MAX_INTERVAL, ticks);
+#if HAL_ENABLE_THREAD_STATISTICS
+    const uint32_t start_us = AP_HAL::micros();
+#endif
     chThdSleep(MAX(ticks,CH_CFG_ST_TIMEDELTA)); //Suspends Thread for desired microseconds
+#if HAL_ENABLE_THREAD_STATISTICS
+    // record how late the thread woke, from the tick resolution,
+    // higher priority threads and interrupts
+    const uint32_t slept_us = AP_HAL::micros() - start_us;
+    const uint16_t late_us = MIN(slept_us - MIN(slept_us, uint32_t(usec)), UINT16_MAX);
+    thread_t *tp = chThdGetSelfX();
+    tp->ap_wake_late_max_us = MAX(tp->ap_wake_late_max_us, late_us);
+    tp->ap_wake_late_logged_us = MAX(tp->ap_wake_late_logged_us, late_us);
+#endif
 }
 
 /*
@@ -109,6 +109,7 @@ public:
     void     reboot(bool hold_in_bootloader) override;
 
     bool     in_main_thread() const override { return get_main_thread() == chThdGetSelfX(); }
+    const void *current_thread_id() const override { return chThdGetSelfX(); }
 
     void     set_system_initialized() override;
     bool     is_system_initialized() override { return _initialized; };
@@ -251,8 +251,14 @@ void Storage::_timer_tick(void)
     }
     if (_dirty_mask.empty()) {
         _last_empty_ms = AP_HAL::millis();
+#ifdef STORAGE_FLASH_PAGE
+        if (_initialisedType == StorageBackend::Flash) {
+            _flash_compact();
+        }
+#endif
         return;
     }
+    _last_busy_ms = AP_HAL::millis();
 
     // write out the first dirty line. We don't write more
     // than one to keep the latency of this call to a minimum
@@ -357,6 +363,30 @@ bool Storage::_flash_write(uint16_t line)
 #endif
 }
 
+/*
+  compact flash storage while disarmed and idle, so the sector erase
+  happens now rather than when a save is made later
+ */
+void Storage::_flash_compact(void)
+{
+#ifdef STORAGE_FLASH_PAGE
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms < 10000 ||
+        now_ms - _last_busy_ms < 2000 ||
+        now_ms - _last_compact_ms < 30000 ||
+        !_flash_erase_ok() ||
+        !_flash.needs_compact(HAL_FLASH_STORAGE_COMPACT_PCT)) {
+        return;
+    }
+    _last_compact_ms = now_ms;
+    // as with line writes, a change made while compacting marks the
+    // line dirty so it is written again afterwards
+    if (!_flash.compact(HAL_FLASH_STORAGE_COMPACT_PCT)) {
+        ::printf("Storage: compact failed\n");
+    }
+#endif
+}
+
 /*
   callback to write data to flash
  */
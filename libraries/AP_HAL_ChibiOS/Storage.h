@@ -54,6 +54,15 @@ static_assert(CH_STORAGE_SIZE % CH_STORAGE_LINE_SIZE == 0,
 #define AP_FLASH_STORAGE_DOUBLE_PAGE 0
 #endif
 
+/*
+  when disarmed and storage has been idle, compact flash storage once
+  the current sector is this percentage full so that saves in flight
+  don't run out of space that can be written without an erase
+ */
+#ifndef HAL_FLASH_STORAGE_COMPACT_PCT
+#define HAL_FLASH_STORAGE_COMPACT_PCT 50
+#endif
+
 class ChibiOS::Storage : public AP_HAL::Storage {
 public:
     void init() override {}
@@ -106,6 +115,9 @@ private:
 
     void _flash_load(void);
     bool _flash_write(uint16_t line);
+    void _flash_compact(void);
+    uint32_t _last_busy_ms;
+    uint32_t _last_compact_ms;
 
 #if HAL_WITH_RAMTRON
     AP_RAMTRON fram;
@@ -343,6 +343,11 @@ void UARTDriver::_begin(uint32_t b, uint16_t rxS, uint16_t txS)
         // re-enable on a new begin() unless high baudrate
         tx_dma_enabled = false;
     }
+    if (_baudrate <= CONTENTION_BAUD_THRESHOLD && sdef.dma_tx && Shared_DMA::is_contended(sdef.dma_tx_stream_id)) {
+        // other peripherals have been fighting over this stream since
+        // boot, start without TX DMA rather than adding to it
+        tx_dma_enabled = false;
+    }
     if (_baudrate <= 115200 && sdef.dma_tx && Shared_DMA::is_shared(sdef.dma_tx_stream_id)) {
         // avoid DMA on shared low-baudrate links
         tx_dma_enabled = false;
@@ -772,6 +777,32 @@ ssize_t UARTDriver::_read(uint8_t *buffer, uint16_t count)
     return ret;
 }
 
+/*
+  point vec at received bytes in place, the receive thread only
+  appends to _readbuf so they stay valid until consumed
+ */
+uint8_t UARTDriver::_peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len)
+{
+    if (_uart_owner_thd != chThdGetSelfX() || !_rx_initialised) {
+        return 0;
+    }
+    return _readbuf.peekiovec(vec, len);
+}
+
+bool UARTDriver::_consume(uint32_t n)
+{
+    if (_uart_owner_thd != chThdGetSelfX() || !_rx_initialised) {
+        return false;
+    }
+    if (!_readbuf.advance(n)) {
+        return false;
+    }
+    if (!_rts_is_active) {
+        update_rts_line();
+    }
+    return true;
+}
+
 /* write a block of bytes to the port */
 size_t UARTDriver::_write(const uint8_t *buffer, size_t size)
 {
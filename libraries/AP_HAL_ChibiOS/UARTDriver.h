@@ -282,6 +282,9 @@ protected:
     ssize_t _read(uint8_t *buffer, uint16_t count) override;
     uint32_t _available() override;
     bool _discard_input() override;
+    uint8_t _peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len) override;
+    bool _consume(uint32_t n) override;
+    uint32_t _tx_queued() override { return _tx_initialised ? _writebuf.available() : 0; }
 
 #if HAL_UART_STATS_ENABLED
     // Getters for cumulative tx and rx counts
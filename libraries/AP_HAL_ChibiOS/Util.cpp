@@ -364,19 +364,31 @@ bool Util::was_watchdog_reset() const
     return stm32_was_watchdog_reset();
 }
 
-#if CH_DBG_ENABLE_STACK_CHECK == TRUE && !defined(HAL_BOOTLOADER_BUILD)
+#if HAL_ENABLE_THREAD_STATISTICS && !defined(HAL_BOOTLOADER_BUILD)
 /*
-  display stack usage as text buffer for @SYS/threads.txt
+  CPU cycles used by all threads and interrupts since the thread
+  statistics were last reset
  */
-__RAMFUNC__ void Util::thread_info(ExpandingString &str)
+static uint64_t total_thread_cycles(void)
 {
-#if HAL_ENABLE_THREAD_STATISTICS
     uint64_t cumulative_cycles = currcore->kernel_stats.m_crit_isr.cumulative;
     for (thread_t *tp = chRegFirstThread(); tp; tp = chRegNextThread(tp)) {
         if (tp->stats.best > 0) { // not run
             cumulative_cycles += (uint64_t)tp->stats.cumulative;
         }
     }
+    return cumulative_cycles;
+}
+#endif
+
+#if CH_DBG_ENABLE_STACK_CHECK == TRUE && !defined(HAL_BOOTLOADER_BUILD)
+/*
+  display stack usage as text buffer for @SYS/threads.txt
+ */
+__RAMFUNC__ void Util::thread_info(ExpandingString &str)
+{
+#if HAL_ENABLE_THREAD_STATISTICS
+    const uint64_t cumulative_cycles = total_thread_cycles();
 #endif
     // a header to allow for machine parsers to determine format
     const uint32_t isr_stack_size = uint32_t((const uint8_t *)&__main_stack_end__ - (const uint8_t *)&__main_stack_base__);
@@ -405,10 +417,12 @@ __RAMFUNC__ void Util::thread_info(ExpandingString &str)
 #if HAL_ENABLE_THREAD_STATISTICS
         time_measurement_t stats = tp->stats;
         if (tp->stats.best > 0) { // not run
-            str.printf("%-13.13s PRI=%3u sp=%p STACK=%4u/%4u LOAD=%4.1f%%%s\n",
+            // LATE and PI are since boot, see log_stack_info()
+            str.printf("%-13.13s PRI=%3u sp=%p STACK=%4u/%4u LOAD=%4.1f%% LATE=%5uus PI=%5u%s\n",
                         tp->name, unsigned(tp->realprio), tp->wabase,
                         unsigned(stack_free(tp->wabase)), unsigned(total_stack),
                         100.0f * float(stats.cumulative) / float(cumulative_cycles),
+                        unsigned(tp->ap_wake_late_max_us), unsigned(tp->ap_boost_count),
                         // more than a loop slice is bad for everyone else, warn on
                         // more than a 200Hz slice so that only the worst offenders are identified
                         // also don't do this for the main or idle threads
@@ -424,6 +438,9 @@ __RAMFUNC__ void Util::thread_info(ExpandingString &str)
         } else {
             tp->stats.cumulative = 0U;
         }
+        // the logged load window restarts with the counters
+        tp->ap_cycles_logged = 0;
+        tp->ap_total_logged = 0;
 #else
         str.printf("%-13.13s PRI=%3u sp=%p STACK=%u/%u\n",
                     tp->name, unsigned(tp->realprio), tp->wabase,
@@ -725,6 +742,59 @@ bool Util::get_true_random_vals(uint8_t* data, size_t size, uint32_t timeout_us)
 #endif
 }
 
+#if HAL_USE_HW_CRC && defined(CRC) && defined(CRC_CR_REV_IN)
+/*
+  the CRC peripheral is shared, so a caller that finds it busy uses
+  software rather than waiting. On first use it is checked against
+  the standard check values, both aligned and unaligned, and never
+  used again if it does not match
+ */
+bool Util::crc_hw_take()
+{
+    if (crc_state == CRCState::FAILED || !crc_sem.take_nonblocking()) {
+        return false;
+    }
+    if (crc_state == CRCState::UNCHECKED) {
+        union {
+            uint32_t align;
+            uint8_t bytes[16];
+        } buf;
+        bool ok = true;
+        for (uint8_t ofs = 0; ofs < 4; ofs++) {
+            memcpy(&buf.bytes[ofs], "123456789", 9);
+            ok &= stm32_crc32_update(0xFFFFFFFFU, &buf.bytes[ofs], 9) == 0x340BC6D9U;
+            ok &= stm32_crc16_ccitt_update(0xFFFFU, &buf.bytes[ofs], 9) == 0x29B1U;
+        }
+        crc_state = ok ? CRCState::OK : CRCState::FAILED;
+        if (!ok) {
+            crc_sem.give();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Util::crc32_hw(uint32_t &crc, const uint8_t *buf, uint32_t len)
+{
+    if (!crc_hw_take()) {
+        return false;
+    }
+    crc = stm32_crc32_update(crc, buf, len);
+    crc_sem.give();
+    return true;
+}
+
+bool Util::crc16_ccitt_hw(uint16_t &crc, const uint8_t *buf, uint32_t len)
+{
+    if (!crc_hw_take()) {
+        return false;
+    }
+    crc = stm32_crc16_ccitt_update(crc, buf, len);
+    crc_sem.give();
+    return true;
+}
+#endif // HAL_USE_HW_CRC && defined(CRC) && defined(CRC_CR_REV_IN)
+
 /*
   log info on stack usage. Called at 1Hz by logging thread, logs next
   thread on each call
@@ -768,10 +838,52 @@ void Util::log_stack_info(void)
         strncpy_noterm(pkt.name, tp->name, sizeof(pkt.name));
     }
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
+#if HAL_ENABLE_THREAD_STATISTICS
+    if (tp != nullptr) {
+        log_thread_stats(tp, thread_id);
+    }
+#endif
     last_tp = tp;
 #endif
 }
 
+#if HAL_ENABLE_THREAD_STATISTICS && HAL_LOGGING_ENABLED
+/*
+  log the CPU use and scheduling of a thread since it was last
+  logged. Reading @SYS/threads.txt resets the ChibiOS counters, which
+  restarts the load window
+ */
+void Util::log_thread_stats(thread_t *tp, uint8_t thread_id)
+{
+    chSysLock();
+    const uint64_t cycles = tp->stats.cumulative;
+    const uint32_t boost_count = tp->ap_boost_count;
+    const uint16_t wake_late_us = tp->ap_wake_late_logged_us;
+    tp->ap_wake_late_logged_us = 0;
+    chSysUnlock();
+    const uint64_t total = total_thread_cycles();
+
+    float load = 0;
+    if (cycles >= tp->ap_cycles_logged && total > tp->ap_total_logged) {
+        load = 100.0f * float(cycles - tp->ap_cycles_logged) / float(total - tp->ap_total_logged);
+    }
+
+    const struct log_THRD pkt {
+        LOG_PACKET_HEADER_INIT(LOG_THRD_MSG),
+        time_us       : AP_HAL::micros64(),
+        thread_id     : thread_id,
+        load          : load,
+        wake_late_max : wake_late_us,
+        boost_count   : uint16_t(MIN(boost_count - tp->ap_boost_logged, UINT16_MAX)),
+    };
+    AP::logger().WriteBlock(&pkt, sizeof(pkt));
+
+    tp->ap_cycles_logged = cycles;
+    tp->ap_total_logged = total;
+    tp->ap_boost_logged = boost_count;
+}
+#endif
+
 #if AP_CRASHDUMP_ENABLED
 size_t Util::last_crash_dump_size() const
 {
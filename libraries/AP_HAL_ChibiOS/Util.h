@@ -108,6 +108,12 @@ public:
     // returns true random values
     bool get_true_random_vals(uint8_t* data, size_t size, uint32_t timeout_us) override;
 
+#if HAL_USE_HW_CRC && defined(CRC) && defined(CRC_CR_REV_IN)
+    // CRCs using the CRC peripheral
+    bool crc32_hw(uint32_t &crc, const uint8_t *buf, uint32_t len) override;
+    bool crc16_ccitt_hw(uint16_t &crc, const uint8_t *buf, uint32_t len) override;
+#endif
+
     // set armed state
     void set_soft_armed(const bool b) override;
 
@@ -146,6 +152,9 @@ private:
 
     // log info on stack usage
     void log_stack_info(void) override;
+#if HAL_ENABLE_THREAD_STATISTICS && HAL_LOGGING_ENABLED
+    void log_thread_stats(thread_t *tp, uint8_t thread_id);
+#endif
 
 #if AP_CRASHDUMP_ENABLED
     // get last crash dump
@@ -157,6 +166,18 @@ private:
     void boot_to_dfu() override;
 #endif
 
+#if HAL_USE_HW_CRC && defined(CRC) && defined(CRC_CR_REV_IN)
+    // take the CRC peripheral if it is free and has passed its check
+    bool crc_hw_take();
+
+    HAL_Semaphore crc_sem;
+    enum class CRCState : uint8_t {
+        UNCHECKED,
+        OK,
+        FAILED,
+    } crc_state;
+#endif
+
 #if HAL_UART_STATS_ENABLED
     struct uart_stats {
         AP_HAL::UARTDriver::StatsTracker serial[HAL_UART_NUM_SERIAL_PORTS];
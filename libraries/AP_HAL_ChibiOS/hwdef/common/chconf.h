@@ -709,9 +709,24 @@ extern "C" {
  * @details User fields added to the end of the @p thread_t structure.
  */
 #ifndef CH_CFG_THREAD_EXTRA_FIELDS
+#if HAL_ENABLE_THREAD_STATISTICS
+/*
+ * thread statistics beyond the ChibiOS ones, see Util::thread_info()
+ * and Util::log_stack_info(). The *_logged fields are the values when
+ * the thread was last logged, giving a window for each log message
+ */
+#define CH_CFG_THREAD_EXTRA_FIELDS                                          \
+  uint32_t ap_boost_count;                                                  \
+  uint32_t ap_boost_logged;                                                 \
+  uint64_t ap_cycles_logged;                                                \
+  uint64_t ap_total_logged;                                                 \
+  uint16_t ap_wake_late_max_us;                                             \
+  uint16_t ap_wake_late_logged_us;
+#else
 #define CH_CFG_THREAD_EXTRA_FIELDS                                          \
   /* Add threads custom fields here.*/
 #endif
+#endif
 
 /**
  * @brief   Threads initialization hook.
@@ -720,9 +735,20 @@ extern "C" {
  * @note    It is invoked from within @p _thread_init() and implicitly from all
  *          the threads creation APIs.
  */
+#if HAL_ENABLE_THREAD_STATISTICS
+#define CH_CFG_THREAD_INIT_HOOK(tp) {                                       \
+  (tp)->ap_boost_count = 0;                                                 \
+  (tp)->ap_boost_logged = 0;                                                \
+  (tp)->ap_cycles_logged = 0;                                               \
+  (tp)->ap_total_logged = 0;                                                \
+  (tp)->ap_wake_late_max_us = 0;                                            \
+  (tp)->ap_wake_late_logged_us = 0;                                         \
+}
+#else
 #define CH_CFG_THREAD_INIT_HOOK(tp) {                                       \
   /* Add threads initialization code here.*/                                \
 }
+#endif
 
 /**
  * @brief   Threads finalization hook.
@@ -736,9 +762,22 @@ extern "C" {
  * @brief   Context switch hook.
  * @details This hook is invoked just before switching between threads.
  */
+#if HAL_ENABLE_THREAD_STATISTICS
+/*
+ * count switches into a thread running above its own priority, which
+ * only happens when it has inherited the priority of a higher
+ * priority thread waiting on a mutex it holds
+ */
+#define CH_CFG_CONTEXT_SWITCH_HOOK(ntp, otp) {                              \
+  if ((ntp)->hdr.pqueue.prio > (ntp)->realprio) {                           \
+    (ntp)->ap_boost_count++;                                                \
+  }                                                                         \
+}
+#else
 #define CH_CFG_CONTEXT_SWITCH_HOOK(ntp, otp) {                              \
   /* Context switch code here.*/                                            \
 }
+#endif
 
 /**
  * @brief   ISR enter hook.
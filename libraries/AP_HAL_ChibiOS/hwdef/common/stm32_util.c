@@ -565,6 +565,63 @@ unsigned int stm32_rand_generate_nonblocking(unsigned char* output, unsigned int
 
 #endif // #if HAL_USE_HW_RNG && defined(RNG)
 
+#if HAL_USE_HW_CRC && defined(CRC) && defined(CRC_CR_REV_IN)
+static void stm32_crc_start(uint32_t cr, uint32_t poly, uint32_t init)
+{
+    static bool clock_enabled;
+    if (!clock_enabled) {
+#if defined(RCC_AHB4ENR_CRCEN)
+        RCC->AHB4ENR |= RCC_AHB4ENR_CRCEN;
+        (void)RCC->AHB4ENR;
+#elif defined(RCC_AHB1ENR_CRCEN)
+        RCC->AHB1ENR |= RCC_AHB1ENR_CRCEN;
+        (void)RCC->AHB1ENR;
+#endif
+        clock_enabled = true;
+    }
+    CRC->POL = poly;
+    CRC->INIT = init;
+    // reset loads INIT into the data register
+    CRC->CR = cr | CRC_CR_RESET;
+}
+
+static void stm32_crc_feed(const uint8_t *buf, uint32_t len)
+{
+    while (len > 0 && ((uintptr_t)buf & 3U) != 0) {
+        *(volatile uint8_t *)&CRC->DR = *buf++;
+        len--;
+    }
+    const uint32_t *words = (const uint32_t *)buf;
+    for (; len >= 4; len -= 4) {
+        // a word is processed from its top byte, so swap it to
+        // process the bytes in memory order
+        CRC->DR = __REV(*words++);
+    }
+    buf = (const uint8_t *)words;
+    while (len--) {
+        *(volatile uint8_t *)&CRC->DR = *buf++;
+    }
+}
+
+/*
+  reflected CRC32. The unit calculates it unreflected, so the crc is
+  reflected into INIT and the result reflected back by REV_OUT
+ */
+uint32_t stm32_crc32_update(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    stm32_crc_start(CRC_CR_REV_IN_0 | CRC_CR_REV_OUT, 0x04C11DB7U, __RBIT(crc));
+    stm32_crc_feed(buf, len);
+    return CRC->DR;
+}
+
+uint16_t stm32_crc16_ccitt_update(uint16_t crc, const uint8_t *buf, uint32_t len)
+{
+    stm32_crc_start(CRC_CR_POLYSIZE_0, 0x1021U, crc);
+    stm32_crc_feed(buf, len);
+    return CRC->DR & 0xFFFFU;
+}
+#endif // HAL_USE_HW_CRC && defined(CRC) && defined(CRC_CR_REV_IN)
+
 /*
   see if we should limit flash to 1M on devices with older revisions of STM32F427
  */
@@ -179,6 +179,16 @@ bool stm32_rand_generate_blocking(unsigned char* output, unsigned int sz, uint32
 unsigned int stm32_rand_generate_nonblocking(unsigned char* output, unsigned int sz);
 #endif
 
+/*
+  update a CRC using the CRC peripheral, with the same results as
+  crc_crc32() and crc16_ccitt() in AP_Math. Needs a peripheral with
+  programmable polynomial and bit reversal
+ */
+#if HAL_USE_HW_CRC && defined(CRC) && defined(CRC_CR_REV_IN)
+uint32_t stm32_crc32_update(uint32_t crc, const uint8_t *buf, uint32_t len);
+uint16_t stm32_crc16_ccitt_update(uint16_t crc, const uint8_t *buf, uint32_t len);
+#endif
+
 // To be defined in HAL code
 extern uint32_t chibios_rand_generate(void);
 
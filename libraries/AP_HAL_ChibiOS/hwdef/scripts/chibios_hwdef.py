@@ -39,6 +39,9 @@ class ChibiOSHWDef(hwdef.HWDef):
         self.default_params_filepath = default_params_filepath
         self.have_defaults_file = False
 
+        # sorted (name, value, read_only) defaults for HAL_PARAM_DEFAULTS_TABLE
+        self.param_defaults_table = None
+
         # if true then parameters will be appended in special apj-tool
         # section at end of binary:
         self.force_apj_default_parameters = False
@@ -967,6 +970,11 @@ class ChibiOSHWDef(hwdef.HWDef):
             f.write("#define HAL_USE_HW_RNG TRUE\n")
         elif 'HAL_USE_HW_RNG' not in defines.keys():
             f.write("#define HAL_USE_HW_RNG FALSE\n")
+        # use the CRC peripheral on H7, other chips can enable it in hwdef.dat
+        if self.mcu_series.startswith("STM32H7") and 'HAL_USE_HW_CRC' not in defines.keys():
+            f.write("#ifndef HAL_USE_HW_CRC\n#define HAL_USE_HW_CRC TRUE\n#endif\n")
+        elif 'HAL_USE_HW_CRC' not in defines.keys():
+            f.write("#ifndef HAL_USE_HW_CRC\n#define HAL_USE_HW_CRC FALSE\n#endif\n")
 
         if self.get_config('PROCESS_STACK', required=False):
             self.env_vars['PROCESS_STACK'] = self.get_config('PROCESS_STACK')
@@ -2510,6 +2518,8 @@ Please run: Tools/scripts/build_bootloaders.py %s
         else:
             self.write_define(f, 'AP_PARAM_DEFAULTS_FILE_PARSING_ENABLED', 0)
 
+        self.write_param_defaults_table(f)
+
         if self.mcu_series.startswith("STM32H7"):
             # add in ADC3 on H7 to get MCU temperature and reference voltage
             self.periph_list.append('ADC3')
@@ -2746,6 +2756,42 @@ Please run: Tools/scripts/build_bootloaders.py %s
 
         return True
 
+    def get_param_defaults_table(self, content):
+        '''parse processed defaults the way AP_Param::parse_param_line
+        does, returning (name, value, read_only) sorted by name. Where a
+        name is given more than once the last one wins'''
+        defaults = {}
+        for line in content.splitlines():
+            if line.startswith('#'):
+                continue
+            tokens = [t for t in re.split(r'[, =\t\r\n]+', line) if t != '']
+            if len(tokens) < 2 or len(tokens[0]) > 16:
+                continue
+            name = tokens[0]
+            try:
+                value = float(tokens[1])
+            except ValueError:
+                try:
+                    value = float(int(tokens[1], 0))
+                except ValueError:
+                    self.error("Bad value for %s in defaults: %s" % (name, tokens[1]))
+            if value != value or value in (float('inf'), float('-inf')):
+                self.error("Bad value for %s in defaults: %s" % (name, tokens[1]))
+            read_only = len(tokens) > 2 and tokens[2] == '@READONLY'
+            defaults[name] = (value, read_only)
+        return [(name, defaults[name][0], defaults[name][1]) for name in sorted(defaults.keys())]
+
+    def write_param_defaults_table(self, f):
+        '''write the parameter defaults as a table for AP_Param to load
+        from flash rather than parsing defaults.parm at boot'''
+        if self.param_defaults_table is None:
+            return
+        f.write('\n// parameter defaults, sorted by name\n')
+        f.write('#define HAL_PARAM_DEFAULTS_TABLE')
+        for (name, value, read_only) in self.param_defaults_table:
+            f.write(' \\\n   { "%s", %sf, %s },' % (name, repr(value), 'true' if read_only else 'false'))
+        f.write('\n\n')
+
     def romfs_add(self, romfs_filename, filename):
         '''add a file to ROMFS'''
         self.romfs[romfs_filename] = filename
@@ -3084,6 +3130,10 @@ Please run: Tools/scripts/build_bootloaders.py %s
         self.romfs_add('defaults.parm', filepath)
         self.have_defaults_file = True
 
+        # the ROMFS copy is kept for logging and for users to read back
+        with open(filepath, 'r') as defaults_fh:
+            self.param_defaults_table = self.get_param_defaults_table(defaults_fh.read())
+
     def run(self):
         # process input file
         self.process_hwdefs()
@@ -68,6 +68,43 @@ bool Shared_DMA::is_shared()
     return is_shared(stream_id1) || is_shared(stream_id2);
 }
 
+/*
+  return true if a stream has been heavily contended since boot. Once
+  set this stays set, so peripherals opened later (or re-opened at a
+  new baudrate) start without DMA rather than having to discover the
+  contention themselves
+*/
+bool Shared_DMA::is_contended(uint8_t stream_id)
+{
+    return (stream_id < SHARED_DMA_MAX_STREAM_ID) && locks[stream_id].heavily_contended;
+}
+
+// record a lock attempt on one stream in the contention score and statistics
+void Shared_DMA::update_contention(uint8_t stream_id, bool contended)
+{
+    if (stream_id >= SHARED_DMA_MAX_STREAM_ID) {
+        return;
+    }
+    dma_lock &l = locks[stream_id];
+    if (contended) {
+        if (l.contention_score < SHARED_DMA_CONTENTION_THRESHOLD + 3) {
+            l.contention_score += 3;
+        }
+        if (l.contention_score > SHARED_DMA_CONTENTION_THRESHOLD) {
+            l.heavily_contended = true;
+        }
+    } else if (l.contention_score > 0) {
+        l.contention_score--;
+    }
+    if (_contention_stats != nullptr) {
+        if (contended) {
+            _contention_stats[stream_id].contended_locks++;
+        } else {
+            _contention_stats[stream_id].uncontended_locks++;
+        }
+    }
+}
+
 //remove any assigned deallocator or allocator
 void Shared_DMA::unregister()
 {
@@ -90,7 +127,23 @@ bool Shared_DMA::lock_stream(uint8_t stream_id)
     bool cont = false;
     if (stream_id < SHARED_DMA_MAX_STREAM_ID) {
         const thread_t* curr_owner = locks[stream_id].mutex.owner;
-        chMtxLock(&locks[stream_id].mutex);
+        if (curr_owner == nullptr || _contention_stats == nullptr) {
+            chMtxLock(&locks[stream_id].mutex);
+        } else {
+            // someone holds the lock, measure how long we wait for it
+            const uint32_t start_us = AP_HAL::micros();
+            chMtxLock(&locks[stream_id].mutex);
+            const uint32_t wait_us = AP_HAL::micros() - start_us;
+            volatile dma_stats &stats = _contention_stats[stream_id];
+            uint8_t bucket = 0;
+            for (uint32_t limit_us = 10; bucket < SHARED_DMA_WAIT_BUCKETS-1 && wait_us >= limit_us; limit_us *= 10) {
+                bucket++;
+            }
+            stats.wait_hist[bucket]++;
+            if (wait_us > stats.max_wait_us) {
+                stats.max_wait_us = wait_us;
+            }
+        }
         cont = curr_owner != nullptr && curr_owner != locks[stream_id].mutex.owner;
     }
     return cont;
@@ -152,23 +205,6 @@ void Shared_DMA::lock_core(void)
         allocate(this);
     }
 #endif
-    // update contention stats
-    if (_contention_stats != nullptr) {
-        if (stream_id1 < SHARED_DMA_MAX_STREAM_ID) {
-            if (contention) {
-                _contention_stats[stream_id1].contended_locks++;
-            } else {
-                _contention_stats[stream_id1].uncontended_locks++;
-            }
-        }
-        if (stream_id2 < SHARED_DMA_MAX_STREAM_ID) {
-            if (contention) {
-                _contention_stats[stream_id2].contended_locks++;
-            } else {
-                _contention_stats[stream_id2].uncontended_locks++;
-            }
-        }
-    }
     have_lock = true;
 }
 
@@ -179,6 +215,8 @@ void Shared_DMA::lock(void)
     bool c2 = lock_stream(stream_id2);
     contention = c1 || c2;
     lock_core();
+    update_contention(stream_id1, c1);
+    update_contention(stream_id2, c2);
 }
 
 // lock the DMA channels, non-blocking
@@ -188,36 +226,28 @@ bool Shared_DMA::lock_nonblock(void)
         chSysDisable();
         if (locks[stream_id1].obj != nullptr && locks[stream_id1].obj != this) {
             locks[stream_id1].obj->contention = true;
-            if (_contention_stats != nullptr) {
-                _contention_stats[stream_id1].contended_locks++;
-            }
+            update_contention(stream_id1, true);
         }
         chSysEnable();
         contention = true;
         return false;
     }
 
-    if (_contention_stats != nullptr && stream_id1 < SHARED_DMA_MAX_STREAM_ID) {
-        _contention_stats[stream_id1].uncontended_locks++;
-    }
+    update_contention(stream_id1, false);
 
     if (!lock_stream_nonblocking(stream_id2)) {
         unlock_stream(stream_id1, false);
         chSysDisable();
         if (locks[stream_id2].obj != nullptr && locks[stream_id2].obj != this) {
             locks[stream_id2].obj->contention = true;
-            if (_contention_stats != nullptr) {
-                _contention_stats[stream_id2].contended_locks++;
-            }
+            update_contention(stream_id2, true);
         }
         chSysEnable();
         contention = true;
         return false;
     }
     lock_core();
-    if (_contention_stats != nullptr && stream_id2 < SHARED_DMA_MAX_STREAM_ID) {
-        _contention_stats[stream_id2].uncontended_locks++;
-    }
+    update_contention(stream_id2, false);
     return true;
 }
 
@@ -254,7 +284,7 @@ void Shared_DMA::dma_info(ExpandingString &str)
     }
 
     // a header to allow for machine parsers to determine format
-    str.printf("DMAV1\n");
+    str.printf("DMAV2\n");
 
     for (uint8_t i = 0; i < SHARED_DMA_MAX_STREAM_ID; i++) {
         // ignore locks not in use
@@ -270,14 +300,25 @@ void Shared_DMA::dma_info(ExpandingString &str)
 #define STREAM_MUX 7
 #define STREAM_OFFSET 1
 #endif
-        const char* fmt = "DMA=%1u:%1u TX=%8u ULCK=%8u CLCK=%8u CONT=%4.1f%%\n";
+        const char* fmt = "DMA=%1u:%1u TX=%8u ULCK=%8u CLCK=%8u CONT=%4.1f%%%c";
         float cond_per = 100.0f * float(_contention_stats[i].contended_locks)
             / (1 + _contention_stats[i].contended_locks + _contention_stats[i].uncontended_locks);
         str.printf(fmt, i / STREAM_MUX + 1, i % STREAM_MUX + STREAM_OFFSET,  _contention_stats[i].transactions,
-            _contention_stats[i].uncontended_locks, _contention_stats[i].contended_locks, cond_per);
+            _contention_stats[i].uncontended_locks, _contention_stats[i].contended_locks, cond_per,
+            locks[i].heavily_contended ? '*' : ' ');
+
+        // histogram of time spent waiting for a contended lock
+        volatile uint32_t *h = _contention_stats[i].wait_hist;
+        str.printf(" WAIT<10us=%6u <100us=%6u <1ms=%6u <10ms=%6u >=10ms=%6u MAX=%6uus\n",
+                   unsigned(h[0]), unsigned(h[1]), unsigned(h[2]), unsigned(h[3]), unsigned(h[4]),
+                   unsigned(_contention_stats[i].max_wait_us));
 
         _contention_stats[i].contended_locks = 0;
         _contention_stats[i].uncontended_locks = 0;
+        for (uint8_t b = 0; b < SHARED_DMA_WAIT_BUCKETS; b++) {
+            h[b] = 0;
+        }
+        _contention_stats[i].max_wait_us = 0;
     }
 }
 
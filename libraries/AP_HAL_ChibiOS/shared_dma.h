@@ -23,6 +23,17 @@
 // DMA stream ID for stream_id2 when only one is needed
 #define SHARED_DMA_NONE 255
 
+// number of buckets in the lock wait time histogram, <10us, <100us,
+// <1ms, <10ms and >=10ms
+#define SHARED_DMA_WAIT_BUCKETS 5
+
+// contention score above which a stream is considered heavily
+// contended. Contended locks add 3 and uncontended locks subtract 1,
+// so this is reached when more than 25% of locks are contended
+#ifndef SHARED_DMA_CONTENTION_THRESHOLD
+#define SHARED_DMA_CONTENTION_THRESHOLD 1000
+#endif
+
 #if AP_HAL_SHARED_DMA_ENABLED
 
 class ChibiOS::Shared_DMA
@@ -71,6 +82,11 @@ public:
     static bool is_shared(uint8_t stream_id);
     bool is_shared();
 
+    // return true if the measured contention on a stream since boot
+    // has been high enough that low rate peripherals should avoid
+    // using DMA on it
+    static bool is_contended(uint8_t stream_id);
+
 private:
     dma_allocate_fn_t allocate;
     dma_allocate_fn_t deallocate;
@@ -94,6 +110,9 @@ private:
     // lock one stream, non-blocking
     bool lock_stream_nonblocking(uint8_t stream_id);
 
+    // record a lock attempt on one stream in the contention score and statistics
+    static void update_contention(uint8_t stream_id, bool contended);
+
     static struct dma_lock {
         // semaphore to ensure only one peripheral uses a DMA channel at a time
 #if CH_CFG_USE_MUTEXES == TRUE
@@ -105,6 +124,11 @@ private:
 
         // point to object that holds the allocation, if allocated
         Shared_DMA *obj;
+
+        // running contention score, always maintained so drivers can
+        // avoid DMA on streams that are heavily contended
+        uint16_t contention_score;
+        bool heavily_contended;
     } locks[SHARED_DMA_MAX_STREAM_ID+1];
 
     // contention statistics
@@ -112,6 +136,9 @@ private:
         uint32_t contended_locks;
         uint32_t uncontended_locks;
         uint32_t transactions;
+        // time spent waiting for a contended lock
+        uint32_t wait_hist[SHARED_DMA_WAIT_BUCKETS];
+        uint32_t max_wait_us;
     } *_contention_stats;
 };
 
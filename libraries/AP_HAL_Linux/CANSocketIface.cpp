@@ -35,12 +35,16 @@
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <sys/time.h>
+#include <time.h>
 #include <net/if.h>
 #include <linux/can/raw.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #include <cstring>
 #include "Scheduler.h"
 #include <AP_CANManager/AP_CANManager.h>
 #include <AP_Common/ExpandingString.h>
+#include <AP_Math/AP_Math.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -124,8 +128,11 @@ int CANIface::_openSocket(const std::string& iface_name)
     // Configure
     {
         const int on = 1;
-        // Timestamping
-        if (setsockopt(s, SOL_SOCKET, SO_TIMESTAMP, &on, sizeof(on)) < 0) {
+        // Timestamping, kernel software receive timestamps where
+        // available, falling back to SO_TIMESTAMP on older kernels
+        const int ts_flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+        if (setsockopt(s, SOL_SOCKET, SO_TIMESTAMPING, &ts_flags, sizeof(ts_flags)) < 0 &&
+            setsockopt(s, SOL_SOCKET, SO_TIMESTAMP, &on, sizeof(on)) < 0) {
             return -1;
         }
         // Socket loopback
@@ -273,130 +280,217 @@ void CANIface::_pollWrite()
         if (!_hasReadyTx()) {
             break;
         }
-        const CanTxItem tx = _tx_queue.top();
-        uint64_t curr_time = AP_HAL::micros64();
-        if (tx.deadline >= curr_time) {
-            // hal.console->printf("%x TDEAD: %lu CURRT: %lu DEL: %lu\n",tx.frame.id,  tx.deadline, curr_time, tx.deadline-curr_time);
-            const int res = _write(tx.frame);
-            if (res == 1) {                   // Transmitted successfully
+
+        // take as many frames as the socket TX queue has room for,
+        // dropping any that are past their deadline
+        CanTxItem batch[CAN_TX_BATCH_SIZE];
+        uint8_t n = 0;
+        const uint64_t curr_time = AP_HAL::micros64();
+        const unsigned room = MIN(_max_frames_in_socket_tx_queue - _frames_in_socket_tx_queue, unsigned(CAN_TX_BATCH_SIZE));
+        while (n < room && !_tx_queue.empty()) {
+            const CanTxItem &tx = _tx_queue.top();
+            if (tx.deadline >= curr_time) {
+                batch[n++] = tx;
+            } else {
+                stats.tx_timedout++;
+            }
+            (void)_tx_queue.pop();
+        }
+        if (n == 0) {
+            continue;
+        }
+
+        const int res = _writeBatch(batch, n);
+        uint8_t sent = 0;
+        if (res > 0) {                        // Transmitted successfully
+            sent = res;
+            for (uint8_t i = 0; i < sent; i++) {
                 _incrementNumFramesInSocketTxQueue();
-                if (tx.loopback) {
-                    _pending_loopback_ids.insert(tx.frame.id);
+                if (batch[i].loopback) {
+                    _pending_loopback_ids.insert(batch[i].frame.id);
                 }
-                stats.tx_success++;
-                stats.last_transmit_us = curr_time;
-            } else if (res == 0) {            // Not transmitted, nor is it an error
-                stats.tx_overflow++;
-                break;                        // Leaving the loop, the frame remains enqueued for the next retry
-            } else {                          // Transmission error
-                stats.tx_rejected++;
             }
-        } else {
-            // hal.console->printf("TDEAD: %lu CURRT: %lu DEL: %lu\n", tx.deadline, curr_time, curr_time-tx.deadline);
-            stats.tx_timedout++;
+            stats.tx_success += sent;
+            stats.last_transmit_us = curr_time;
+        } else if (res < 0) {                 // Transmission error, the first frame is dropped
+            stats.tx_rejected++;
+            sent = 1;
         }
 
-        // Removing the frame from the queue even if transmission failed
-        (void)_tx_queue.pop();
+        // frames that were not sent go back on the queue for the next retry
+        for (uint8_t i = sent; i < n; i++) {
+            _tx_queue.push(batch[i]);
+        }
+        if (res == 0) {                       // Not transmitted, nor is it an error
+            stats.tx_overflow++;
+            break;
+        }
     }
 }
 
 bool CANIface::_pollRead()
 {
+    bool received = false;
     uint8_t iterations_count = 0;
     while (iterations_count < CAN_MAX_POLL_ITERATIONS_COUNT)
     {
         iterations_count++;
-        CanRxItem rx;
-        rx.timestamp_us = AP_HAL::micros64();  // Monotonic timestamp is not required to be precise (unlike UTC)
-        bool loopback = false;
-        const int res = _read(rx.frame, rx.timestamp_us, loopback);
-        if (res == 1) {
+        CanRxItem rx[CAN_RX_BATCH_SIZE];
+        bool loopback[CAN_RX_BATCH_SIZE];
+        uint8_t num_frames;
+        const int res = _readBatch(rx, loopback, num_frames);
+        if (res < 0) {
+            stats.rx_errors++;
+            break;
+        }
+        for (uint8_t i = 0; i < num_frames; i++) {
             bool accept = true;
-            if (loopback) {           // We receive loopback for all CAN frames
+            if (loopback[i]) {        // We receive loopback for all CAN frames
                 _confirmSentFrame();
-                rx.flags |= Loopback;
-                accept = _wasInPendingLoopbackSet(rx.frame);
+                rx[i].flags |= Loopback;
+                accept = _wasInPendingLoopbackSet(rx[i].frame);
                 stats.tx_confirmed++;
             }
             if (accept) {
                 WITH_SEMAPHORE(sem);
-                _rx_queue.push(rx);
+                _rx_queue.push(rx[i]);
                 stats.rx_received++;
-                return true;
+                received = true;
             }
-        } else if (res == 0) {
-            break;
-        } else {
-            stats.rx_errors++;
+        }
+        if (res < CAN_RX_BATCH_SIZE) {
+            // socket drained
             break;
         }
     }
-    return false;
+    return received;
 }
 
-int CANIface::_write(const AP_HAL::CANFrame& frame) const
+/*
+  send frames with one sendmmsg() call. Returns the number of frames
+  sent, 0 if the socket can't take any at the moment or negative on
+  an error with the first frame
+ */
+int CANIface::_writeBatch(const CanTxItem items[], uint8_t n) const
 {
     if (_fd < 0) {
         return -1;
     }
     errno = 0;
 
-    const can_frame sockcan_frame = makeSocketCanFrame(frame);
+    can_frame sockcan_frames[CAN_TX_BATCH_SIZE];
+    iovec iov[CAN_TX_BATCH_SIZE];
+    mmsghdr msgs[CAN_TX_BATCH_SIZE] {};
+    for (uint8_t i = 0; i < n; i++) {
+        sockcan_frames[i] = makeSocketCanFrame(items[i].frame);
+        iov[i].iov_base = &sockcan_frames[i];
+        iov[i].iov_len = sizeof(sockcan_frames[i]);
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
 
-    const int res = write(_fd, &sockcan_frame, sizeof(sockcan_frame));
+    const int res = sendmmsg(_fd, msgs, n, MSG_DONTWAIT);
     if (res <= 0) {
         if (errno == ENOBUFS || errno == EAGAIN) {  // Writing is not possible atm, not an error
             return 0;
         }
-        return res;
+        return res < 0 ? res : -1;
     }
-    if (res != sizeof(sockcan_frame)) {
-        return -1;
-    }
-    return 1;
+    return res;
 }
 
+/*
+  extract the kernel receive timestamp of a frame, in microseconds of
+  CLOCK_REALTIME. Returns 0 if the kernel didn't supply one
+ */
+static uint64_t kernelTimestampUs(msghdr &msg)
+{
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+        if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            scm_timestamping ts;
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            return uint64_t(ts.ts[0].tv_sec) * 1000000ULL + ts.ts[0].tv_nsec / 1000U;
+        }
+        if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+            timeval tv;
+            memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+            return uint64_t(tv.tv_sec) * 1000000ULL + tv.tv_usec;
+        }
+    }
+    return 0;
+}
 
-int CANIface::_read(AP_HAL::CANFrame& frame, uint64_t& timestamp_us, bool& loopback) const
+/*
+  receive up to CAN_RX_BATCH_SIZE frames with one recvmmsg() call.
+  Returns the number of frames taken from the socket or negative on
+  error. The frames passing the filters are returned in items, with
+  their count in num_frames
+ */
+int CANIface::_readBatch(CanRxItem items[], bool loopback[], uint8_t &num_frames) const
 {
+    num_frames = 0;
     if (_fd < 0) {
         return -1;
     }
-    auto iov = iovec();
-    auto sockcan_frame = can_frame();
-    iov.iov_base = &sockcan_frame;
-    iov.iov_len  = sizeof(sockcan_frame);
+    can_frame sockcan_frames[CAN_RX_BATCH_SIZE];
+    iovec iov[CAN_RX_BATCH_SIZE];
     union {
-        uint8_t data[CMSG_SPACE(sizeof(::timeval))];
+        uint8_t data[CMSG_SPACE(sizeof(scm_timestamping))];
         struct cmsghdr align;
-    } control;
-
-    auto msg = msghdr();
-    msg.msg_iov    = &iov;
-    msg.msg_iovlen = 1;
-    msg.msg_control = control.data;
-    msg.msg_controllen = sizeof(control.data);
-
-    const int res = recvmsg(_fd, &msg, MSG_DONTWAIT);
+    } control[CAN_RX_BATCH_SIZE];
+    mmsghdr msgs[CAN_RX_BATCH_SIZE] {};
+    for (uint8_t i = 0; i < CAN_RX_BATCH_SIZE; i++) {
+        iov[i].iov_base = &sockcan_frames[i];
+        iov[i].iov_len = sizeof(sockcan_frames[i]);
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = control[i].data;
+        msgs[i].msg_hdr.msg_controllen = sizeof(control[i].data);
+    }
+
+    const int res = recvmmsg(_fd, msgs, CAN_RX_BATCH_SIZE, MSG_DONTWAIT, nullptr);
     if (res <= 0) {
         return (res < 0 && errno == EWOULDBLOCK) ? 0 : res;
     }
+
     /*
-     * Flags
+     * Kernel timestamps are taken on CLOCK_REALTIME when the frame
+     * arrived, map them onto our monotonic clock
      */
-    loopback = (msg.msg_flags & static_cast<int>(MSG_CONFIRM)) != 0;
+    const uint64_t now_us = AP_HAL::micros64();
+    timespec real_ts;
+    clock_gettime(CLOCK_REALTIME, &real_ts);
+    const uint64_t real_now_us = uint64_t(real_ts.tv_sec) * 1000000ULL + real_ts.tv_nsec / 1000U;
+
+    for (int i = 0; i < res; i++) {
+        /*
+         * Flags
+         */
+        const bool is_loopback = (msgs[i].msg_hdr.msg_flags & static_cast<int>(MSG_CONFIRM)) != 0;
+        if (!is_loopback && !_checkHWFilters(sockcan_frames[i])) {
+            continue;
+        }
 
-    if (!loopback && !_checkHWFilters(sockcan_frame)) {
-        return 0;
+        CanRxItem &rx = items[num_frames];
+        rx = CanRxItem();
+        rx.frame = makeUavcanFrame(sockcan_frames[i]);
+        /*
+         * Timestamp
+         */
+        const uint64_t kernel_us = kernelTimestampUs(msgs[i].msg_hdr);
+        const uint64_t age_us = real_now_us - kernel_us;
+        if (kernel_us != 0 && kernel_us <= real_now_us && age_us < now_us) {
+            rx.timestamp_us = now_us - age_us;
+        } else {
+            rx.timestamp_us = now_us;
+        }
+        loopback[num_frames] = is_loopback;
+        num_frames++;
     }
-
-    frame = makeUavcanFrame(sockcan_frame);
-    /*
-     * Timestamp
-     */
-    timestamp_us = AP_HAL::micros64();
-    return 1;
+    return res;
 }
 
 // Might block forever, only to be used for testing
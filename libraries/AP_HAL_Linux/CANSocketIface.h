@@ -51,6 +51,9 @@ enum class SocketCanError
 };
 
 #define CAN_MAX_POLL_ITERATIONS_COUNT 100
+// maximum frames moved by one recvmmsg()/sendmmsg() call
+#define CAN_RX_BATCH_SIZE 16
+#define CAN_TX_BATCH_SIZE 8
 #define CAN_MAX_INIT_TRIES_COUNT 100
 #define CAN_FILTER_NUMBER 8
 
@@ -120,9 +123,9 @@ private:
 
     bool _pollRead();
 
-    int _write(const AP_HAL::CANFrame& frame) const;
+    int _writeBatch(const CanTxItem items[], uint8_t n) const;
 
-    int _read(AP_HAL::CANFrame& frame, uint64_t& ts_usec, bool& loopback) const;
+    int _readBatch(CanRxItem items[], bool loopback[], uint8_t &num_frames) const;
 
     void _incrementNumFramesInSocketTxQueue();
 
@@ -328,6 +328,8 @@ void _usage(void)
     printf("\tcpu affinity:\n");
     printf("\t                   --cpu-affinity 1 (single cpu) or 1,3 (multiple cpus) or 1-3 (range of cpus)\n");
     printf("\t                   -c 1 (single cpu) or 1,3 (multiple cpus) or 1-3 (range of cpus)\n");
+    printf("\tthread cpu affinity, may be repeated (main, timer, uart, rcin, io or a thread name):\n");
+    printf("\t                   --thread-affinity main=2 --thread-affinity timer=3\n");
 }
 
 void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
@@ -347,6 +349,7 @@ void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
         CMDLINE_SERIAL7,
         CMDLINE_SERIAL8,
         CMDLINE_SERIAL9,
+        CMDLINE_THREAD_AFFINITY,
     };
 
     int opt;
@@ -377,6 +380,7 @@ void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
         {"module-directory",    true,  0, 'M'},
         {"defaults",            true,  0, 'd'},
         {"cpu-affinity",        true,  0, 'c'},
+        {"thread-affinity",     true,  0, CMDLINE_THREAD_AFFINITY},
         {"help",                false,  0, 'h'},
         {0, false, 0, 0}
     };
@@ -446,6 +450,22 @@ void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
             }
             Linux::Scheduler::from(scheduler)->set_cpu_affinity(cpu_affinity);
             break;
+        case CMDLINE_THREAD_AFFINITY: {
+            char name[16] {};
+            const char *cpus = strchr(gopt.optarg, '=');
+            if (cpus == nullptr || size_t(cpus - gopt.optarg) >= sizeof(name)) {
+                fprintf(stderr, "Could not parse thread affinity: %s\n", gopt.optarg);
+                exit(1);
+            }
+            memcpy(name, gopt.optarg, cpus - gopt.optarg);
+            cpu_set_t cpu_affinity;
+            if (!utilInstance.parse_cpu_set(cpus + 1, &cpu_affinity) ||
+                !Linux::Scheduler::from(scheduler)->set_thread_affinity(name, cpu_affinity)) {
+                fprintf(stderr, "Could not parse thread affinity: %s\n", gopt.optarg);
+                exit(1);
+            }
+            break;
+        }
         case 'h':
             _usage();
             exit(0);
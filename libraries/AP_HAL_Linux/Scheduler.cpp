@@ -5,10 +5,13 @@
 #include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
 #include <sys/mman.h>
 #include <sys/time.h>
 #include <unistd.h>
 
+#include <AP_Common/ExpandingString.h>
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
@@ -34,6 +37,8 @@ extern const AP_HAL::HAL& hal;
 
 #define APM_LINUX_TIMER_RATE            1000
 #define APM_LINUX_UART_RATE             100
+// longest wait for input on the UARTs while there is nothing to send
+#define APM_LINUX_UART_IDLE_TIMEOUT_MS  100
 #if CONFIG_HAL_BOARD_SUBTYPE == HAL_BOARD_SUBTYPE_LINUX_NAVIO ||    \
     CONFIG_HAL_BOARD_SUBTYPE == HAL_BOARD_SUBTYPE_LINUX_ERLEBRAIN2 || \
     CONFIG_HAL_BOARD_SUBTYPE == HAL_BOARD_SUBTYPE_LINUX_BH || \
@@ -63,6 +68,7 @@ extern const AP_HAL::HAL& hal;
 Scheduler::Scheduler()
 {
     CPU_ZERO(&_cpu_affinity);
+    CPU_ZERO(&_process_affinity);
 }
 
 
@@ -80,7 +86,11 @@ void Scheduler::init_realtime()
     }
 #endif
 
-    mlockall(MCL_CURRENT|MCL_FUTURE);
+    // lock all current and future memory, including thread stacks,
+    // so the realtime threads never take a page fault
+    if (mlockall(MCL_CURRENT|MCL_FUTURE) != 0) {
+        fprintf(stderr, "WARNING: failed to lock memory: %m\n");
+    }
 
     struct sched_param param = { .sched_priority = APM_LINUX_MAIN_PRIORITY };
     if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == -1) {
@@ -91,13 +101,88 @@ void Scheduler::init_realtime()
 
 void Scheduler::init_cpu_affinity()
 {
-    if (!CPU_COUNT(&_cpu_affinity)) {
-        return;
+    /*
+      cpus isolated with isolcpus= are not in the default affinity,
+      threads only run there when pinned to them
+     */
+    FILE *f = fopen("/sys/devices/system/cpu/isolated", "r");
+    if (f != nullptr) {
+        char isolated[64] {};
+        if (fgets(isolated, sizeof(isolated), f) != nullptr && isolated[0] != '\n' && isolated[0] != '\0') {
+            isolated[strcspn(isolated, "\n")] = '\0';
+            printf("Isolated cpus: %s\n", isolated);
+        }
+        fclose(f);
     }
 
-    if (sched_setaffinity(0, sizeof(_cpu_affinity), &_cpu_affinity) != 0) {
+    if (CPU_COUNT(&_cpu_affinity) &&
+        sched_setaffinity(0, sizeof(_cpu_affinity), &_cpu_affinity) != 0) {
         AP_HAL::panic("Failed to set affinity for main process: %m");
     }
+
+    // remember the process wide affinity before pinning the main
+    // thread, as threads it creates would otherwise inherit its pinning
+    if (sched_getaffinity(0, sizeof(_process_affinity), &_process_affinity) != 0) {
+        CPU_ZERO(&_process_affinity);
+    }
+    apply_thread_affinity("main", pthread_self());
+}
+
+bool Scheduler::set_thread_affinity(const char *name, const cpu_set_t &cpu_affinity)
+{
+    if (_num_thread_affinity >= ARRAY_SIZE(_thread_affinity) ||
+        strlen(name) >= sizeof(_thread_affinity[0].name)) {
+        return false;
+    }
+    struct thread_affinity &a = _thread_affinity[_num_thread_affinity++];
+    strncpy(a.name, name, sizeof(a.name) - 1);
+    a.cpu_affinity = cpu_affinity;
+    return true;
+}
+
+void Scheduler::apply_thread_affinity(const char *name, pthread_t ctx) const
+{
+    // scheduler threads are named "ap-<name>"
+    if (strncmp(name, "ap-", 3) == 0) {
+        name += 3;
+    }
+    const cpu_set_t *cpu_affinity = &_process_affinity;
+    for (uint8_t i = 0; i < _num_thread_affinity; i++) {
+        if (strcmp(_thread_affinity[i].name, name) == 0) {
+            cpu_affinity = &_thread_affinity[i].cpu_affinity;
+            break;
+        }
+    }
+    if (_num_thread_affinity == 0 || !CPU_COUNT(cpu_affinity)) {
+        // nothing pinned, the inherited affinity is right
+        return;
+    }
+    if (pthread_setaffinity_np(ctx, sizeof(*cpu_affinity), cpu_affinity) != 0) {
+        fprintf(stderr, "WARNING: failed to set affinity for thread %s\n", name);
+    }
+}
+
+/*
+  wake-up latency of the periodic scheduler threads since the last
+  report, how late each woke against its schedule
+ */
+void Scheduler::thread_info(ExpandingString &str)
+{
+    const struct {
+        const char *name;
+        PeriodicThread *thread;
+    } threads[] = {
+        { "timer", &_timer_thread },
+        { "rcin", &_rcin_thread },
+        { "io", &_io_thread },
+    };
+    str.printf("ThreadsV1\n");
+    for (const auto &t : threads) {
+        uint32_t avg_us, max_us;
+        if (t.thread->get_wakeup_latency(avg_us, max_us)) {
+            str.printf("%-13.13s WAKE_AVG=%5uus WAKE_MAX=%6uus\n", t.name, unsigned(avg_us), unsigned(max_us));
+        }
+    }
 }
 
 void Scheduler::init()
@@ -295,6 +380,59 @@ void Scheduler::_uart_task()
     _run_uarts();
 }
 
+/*
+  keep the registration in step with the UART's current fd. Edge
+  triggered, as a UART whose read buffer is full leaves its fd readable
+ */
+void Scheduler::UARTPollable::update(Poller &poller, int fd, uint32_t open_count)
+{
+    if (fd == _fd && open_count == _open_count) {
+        return;
+    }
+    if (_fd >= 0) {
+        poller.unregister_pollable(this);
+    }
+    _fd = fd;
+    _open_count = open_count;
+    if (_fd >= 0 && !poller.register_pollable(this, EPOLLIN | EPOLLET)) {
+        _fd = -1;
+    }
+}
+
+/*
+  wait until a UART has input, a write is queued or the UART period
+  passes with data still waiting to be sent
+ */
+void Scheduler::_wait_uarts(uint32_t period_usec)
+{
+    if (!_uart_poller) {
+        microsleep(period_usec);
+        return;
+    }
+
+    // mark ourselves as waiting before checking for pending writes so
+    // that a write after the check always wakes us
+    _uart_waiting = true;
+
+    bool tx_pending = false;
+    for (uint8_t i=0; i<hal.num_serial; i++) {
+        UARTDriver *uart = UARTDriver::from(hal.serial(i));
+        _uart_pollables[i].update(_uart_poller, uart->get_read_fd(), uart->get_open_count());
+        tx_pending = tx_pending || uart->tx_pending();
+    }
+
+    const int timeout_ms = tx_pending ? MAX(period_usec / 1000U, 1U) : APM_LINUX_UART_IDLE_TIMEOUT_MS;
+    _uart_poller.poll(timeout_ms);
+    _uart_waiting = false;
+}
+
+void Scheduler::wakeup_uart_thread()
+{
+    if (_uart_waiting.exchange(false)) {
+        _uart_poller.wakeup();
+    }
+}
+
 void Scheduler::_io_task()
 {
     // process any pending storage writes
@@ -360,6 +498,30 @@ bool Scheduler::SchedulerThread::_run()
     return PeriodicThread::_run();
 }
 
+bool Scheduler::UARTThread::_run()
+{
+    _sched._wait_all_threads();
+
+    while (!_should_exit) {
+        _sched._wait_uarts(_period_usec);
+        _task();
+    }
+
+    _started = false;
+    _should_exit = false;
+
+    return true;
+}
+
+bool Scheduler::UARTThread::stop()
+{
+    if (!SchedulerThread::stop()) {
+        return false;
+    }
+    _sched._uart_poller.wakeup();
+    return true;
+}
+
 void Scheduler::teardown()
 {
     _timer_thread.stop();
@@ -1,15 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <pthread.h>
 
 #include "AP_HAL_Linux.h"
 
+#include "Poller.h"
 #include "Semaphores.h"
 #include "Thread.h"
 
 #define LINUX_SCHEDULER_MAX_TIMER_PROCS 10
 #define LINUX_SCHEDULER_MAX_TIMESLICED_PROCS 10
 #define LINUX_SCHEDULER_MAX_IO_PROCS 10
+#define LINUX_SCHEDULER_MAX_THREAD_AFFINITY 10
 
 #define AP_LINUX_SENSORS_STACK_SIZE  256 * 1024
 #define AP_LINUX_SENSORS_SCHED_POLICY  SCHED_FIFO
@@ -33,6 +36,7 @@ public:
     void     register_io_process(AP_HAL::MemberProc) override;
 
     bool     in_main_thread() const override;
+    const void *current_thread_id() const override { return (const void *)pthread_self(); }
 
     void     register_timer_failsafe(AP_HAL::Proc, uint32_t period_us) override;
 
@@ -60,6 +64,26 @@ public:
      */
     void set_cpu_affinity(const cpu_set_t &cpu_affinity) { _cpu_affinity = cpu_affinity; }
 
+    /*
+      pin a single thread to a set of cpus, overriding the process
+      wide affinity. The name is "main", a scheduler thread without
+      its "ap-" prefix (timer, uart, rcin, io) or the name given to
+      thread_create(). Must be called before init()
+     */
+    bool set_thread_affinity(const char *name, const cpu_set_t &cpu_affinity);
+
+    // apply any affinity configured for the named thread
+    void apply_thread_affinity(const char *name, pthread_t ctx) const;
+
+    // report wake-up latency of the scheduler threads for @SYS/threads.txt
+    void thread_info(ExpandingString &str);
+
+    /*
+      wake the UART thread if it is waiting for input with nothing to
+      send. Called when bytes are queued for transmit
+     */
+    void wakeup_uart_thread();
+
 private:
     class SchedulerThread : public PeriodicThread {
     public:
@@ -74,6 +98,35 @@ private:
         Scheduler &_sched;
     };
 
+    /*
+      the UART thread waits in epoll for input on any UART instead of
+      waking at a fixed rate. It still runs at the UART rate while
+      there is data waiting to be sent
+     */
+    class UARTThread : public SchedulerThread {
+    public:
+        UARTThread(Thread::task_t t, Scheduler &sched)
+            : SchedulerThread(t, sched)
+        { }
+
+        bool stop() override;
+
+    protected:
+        bool _run() override;
+    };
+
+    // registration of one UART's input fd with the UART poller. The
+    // fd is owned by the UART's device, so it is never closed here
+    class UARTPollable : public Pollable {
+    public:
+        ~UARTPollable() { _fd = -1; }
+
+        void update(Poller &poller, int fd, uint32_t open_count);
+
+    private:
+        uint32_t _open_count;
+    };
+
     void     init_realtime();
 
     void     init_cpu_affinity();
@@ -101,7 +154,7 @@ private:
     SchedulerThread _timer_thread{FUNCTOR_BIND_MEMBER(&Scheduler::_timer_task, void), *this};
     SchedulerThread _io_thread{FUNCTOR_BIND_MEMBER(&Scheduler::_io_task, void), *this};
     SchedulerThread _rcin_thread{FUNCTOR_BIND_MEMBER(&Scheduler::_rcin_task, void), *this};
-    SchedulerThread _uart_thread{FUNCTOR_BIND_MEMBER(&Scheduler::_uart_task, void), *this};
+    UARTThread _uart_thread{FUNCTOR_BIND_MEMBER(&Scheduler::_uart_task, void), *this};
 
     void _timer_task();
     void _io_task();
@@ -110,6 +163,11 @@ private:
 
     void _run_io();
     void _run_uarts();
+    void _wait_uarts(uint32_t period_usec);
+
+    Poller _uart_poller;
+    UARTPollable _uart_pollables[AP_HAL::HAL::num_serial];
+    std::atomic<bool> _uart_waiting;
 
     uint64_t _stopped_clock_usec;
     uint64_t _last_stack_debug_msec;
@@ -117,6 +175,13 @@ private:
 
     Semaphore _io_semaphore;
     cpu_set_t _cpu_affinity;
+
+    struct thread_affinity {
+        char name[16];
+        cpu_set_t cpu_affinity;
+    } _thread_affinity[LINUX_SCHEDULER_MAX_THREAD_AFFINITY];
+    uint8_t _num_thread_affinity;
+    cpu_set_t _process_affinity;
 };
 
 }
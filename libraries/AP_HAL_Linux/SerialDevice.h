@@ -23,4 +23,10 @@ public:
 
     /* Depends on lower level to implement, most devices are fine with defaults */
     virtual void set_parity(int v) { }
+
+    /*
+     * File descriptor that becomes readable when there is data (or a
+     * connection) to handle, or -1 if the device can't be waited on
+     */
+    virtual int get_read_fd() const { return -1; }
 };
@@ -18,6 +18,10 @@ public:
     virtual void set_speed(uint32_t speed) override;
     virtual ssize_t write(const uint8_t *buf, uint16_t n) override;
     virtual ssize_t read(uint8_t *buf, uint16_t n) override;
+    // the listener becomes readable when a client is waiting to be accepted
+    int get_read_fd() const override {
+        return sock != nullptr ? sock->get_read_fd() : listener.get_read_fd();
+    }
 
 private:
     SocketAPM_native listener{false};
@@ -199,6 +199,7 @@ bool Thread::start(const char *name, int policy, int prio)
 
     if (name) {
         pthread_setname_np(_ctx, name);
+        Scheduler::from(hal.scheduler)->apply_thread_affinity(name, _ctx);
     }
 
     _started = true;
@@ -265,6 +266,15 @@ bool PeriodicThread::_run()
             next_run_usec = AP_HAL::micros64();
         } else {
             Scheduler::from(hal.scheduler)->microsleep(dt);
+
+            // how late we woke
+            const uint64_t now_usec = AP_HAL::micros64();
+            const uint32_t late_usec = now_usec > next_run_usec ? now_usec - next_run_usec : 0;
+            _wakeup_sum_us += late_usec;
+            _wakeup_count++;
+            if (late_usec > _wakeup_max_us) {
+                _wakeup_max_us = late_usec;
+            }
         }
         next_run_usec += _period_usec;
 
@@ -277,6 +287,20 @@ bool PeriodicThread::_run()
     return true;
 }
 
+bool PeriodicThread::get_wakeup_latency(uint32_t &avg_us, uint32_t &max_us)
+{
+    const uint32_t count = _wakeup_count;
+    if (count == 0) {
+        return false;
+    }
+    avg_us = _wakeup_sum_us / count;
+    max_us = _wakeup_max_us;
+    _wakeup_sum_us = 0;
+    _wakeup_count = 0;
+    _wakeup_max_us = 0;
+    return true;
+}
+
 bool PeriodicThread::stop()
 {
     if (!is_started()) {
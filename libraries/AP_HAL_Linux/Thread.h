@@ -87,10 +87,22 @@ public:
 
     bool stop() override;
 
+    /*
+     * Average and maximum lateness of the thread's wake-ups against
+     * its schedule since the last call, in microseconds. Returns false
+     * if the thread hasn't woken since then.
+     */
+    bool get_wakeup_latency(uint32_t &avg_us, uint32_t &max_us);
+
 protected:
     bool _run() override;
 
     uint64_t _period_usec = 0;
+
+    // wake-up latency statistics
+    uint64_t _wakeup_sum_us = 0;
+    uint32_t _wakeup_count = 0;
+    uint32_t _wakeup_max_us = 0;
 };
 
 }
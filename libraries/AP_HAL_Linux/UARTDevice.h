@@ -20,6 +20,7 @@ public:
         return _flow_control;
     }
     virtual void set_parity(int v) override;
+    int get_read_fd() const override { return _fd; }
 
 private:
     void _disable_crlf();
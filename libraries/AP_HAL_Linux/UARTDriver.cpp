@@ -20,6 +20,7 @@
 #include <AP_HAL/AP_HAL.h>
 
 #include "ConsoleDevice.h"
+#include "Scheduler.h"
 #include "TCPServerDevice.h"
 #include "UARTDevice.h"
 #include "UDPDevice.h"
@@ -72,6 +73,7 @@ void UARTDriver::_begin(uint32_t b, uint16_t rxS, uint16_t txS)
         _connected = _device->open();
         if (_connected) {
             _device->set_blocking(false);
+            _open_count++;
         }
     }
     _initialised = false;
@@ -271,6 +273,22 @@ ssize_t UARTDriver::_read(uint8_t *buffer, uint16_t count)
     return _readbuf.read(buffer, count);
 }
 
+uint8_t UARTDriver::_peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len)
+{
+    if (!_initialised) {
+        return 0;
+    }
+    return _readbuf.peekiovec(vec, len);
+}
+
+bool UARTDriver::_consume(uint32_t n)
+{
+    if (!_initialised) {
+        return false;
+    }
+    return _readbuf.advance(n);
+}
+
 bool UARTDriver::_discard_input()
 {
     if (!_initialised) {
@@ -294,6 +312,9 @@ size_t UARTDriver::_write(const uint8_t *buffer, size_t size)
 
     size_t ret = _writebuf.write(buffer, size);
     _write_mutex.give();
+    if (ret > 0) {
+        Scheduler::from(hal.scheduler)->wakeup_uart_thread();
+    }
     return ret;
 }
 
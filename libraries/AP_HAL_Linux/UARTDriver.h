@@ -27,6 +27,16 @@ public:
     bool _write_pending_bytes(void);
     virtual void _timer_tick(void) override;
 
+    /*
+      file descriptor the UART thread can wait on for input, -1 if
+      there is none. The open count changes whenever the device is
+      re-opened, as the fd number may be reused
+     */
+    int get_read_fd() const {
+        return (_initialised && _device) ? _device->get_read_fd() : -1;
+    }
+    uint32_t get_open_count() const { return _open_count; }
+
     virtual enum flow_control get_flow_control(void) override
     {
         return _device->get_flow_control();
@@ -68,6 +78,7 @@ private:
     char *_flag;
     bool _connected; // true if a client has connected
     bool _packetise; // true if writes should try to be on mavlink boundaries
+    uint32_t _open_count;
 
     void _allocate_buffers(uint16_t rxS, uint16_t txS);
     void _deallocate_buffers();
@@ -99,6 +110,9 @@ protected:
     uint32_t _available() override;
     size_t _write(const uint8_t *buffer, size_t size) override;
     ssize_t _read(uint8_t *buffer, uint16_t count) override WARN_IF_UNUSED;
+    uint8_t _peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len) override;
+    bool _consume(uint32_t n) override;
+    uint32_t _tx_queued() override { return _initialised ? _writebuf.available() : 0; }
 };
 
 }
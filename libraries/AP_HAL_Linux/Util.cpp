@@ -10,6 +10,7 @@
 #include <AP_HAL/AP_HAL.h>
 
 #include "Heat_Pwm.h"
+#include "Scheduler.h"
 #include "Util.h"
 
 using namespace Linux;
@@ -55,7 +56,7 @@ void Util::set_imu_target_temp(int8_t *target)
 /**
    return commandline arguments, if available
 */
-void Util::commandline_arguments(uint8_t &argc, char * const *&argv)
+void Util::commandline_arguments(int &argc, char * const *&argv)
 {
     argc = saved_argc;
     argv = saved_argv;
@@ -296,3 +297,8 @@ bool Util::parse_cpu_set(const char *str, cpu_set_t *cpu_set) const
 
     return true;
 }
+
+void Util::thread_info(ExpandingString &str)
+{
+    Scheduler::from(hal.scheduler)->thread_info(str);
+}
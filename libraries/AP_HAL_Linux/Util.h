@@ -33,7 +33,7 @@ public:
     /**
        return commandline arguments, if available
      */
-    void commandline_arguments(uint8_t &argc, char * const *&argv) override;
+    void commandline_arguments(int &argc, char * const *&argv) override;
 
     /*
       get/set system clock in UTC microseconds
@@ -95,6 +95,9 @@ public:
     // fills data with random values of requested size
     bool get_random_vals(uint8_t* data, size_t size) override;
 
+    // scheduler thread wake-up latency for @SYS/threads.txt
+    void thread_info(ExpandingString &str) override;
+
 private:
 #if CONFIG_HAL_BOARD_SUBTYPE == HAL_BOARD_SUBTYPE_LINUX_DISCO
     static ToneAlarm_Disco _toneAlarm;
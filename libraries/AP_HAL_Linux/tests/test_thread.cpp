@@ -117,4 +117,18 @@ TEST(LinuxThread, periodic_thread)
     EXPECT_TRUE(thr.join());
 }
 
+TEST(LinuxThread, poller_timeout)
+{
+    Poller poller;
+    ASSERT_TRUE(bool(poller));
+
+    // nothing registered but the wakeup fd, so this times out
+    EXPECT_EQ(poller.poll(10), 0);
+
+    // a wakeup is reported as an event
+    poller.wakeup();
+    EXPECT_EQ(poller.poll(1000), 1);
+    EXPECT_EQ(poller.poll(0), 0);
+}
+
 AP_GTEST_MAIN()
@@ -62,6 +62,14 @@ uint16_t DSP::fft_analyse(AP_HAL::DSP::FFTWindowState* state, uint16_t start_bin
     return step_calc_frequencies(fft, start_bin, end_bin);
 }
 
+// calculate the power of each stored frequency of the windowed samples
+void DSP::fft_power(AP_HAL::DSP::FFTWindowState* state)
+{
+    FFTWindowStateSITL* fft = (FFTWindowStateSITL*)state;
+    step_fft(fft);
+    fft->_freq_bins[fft->_bin_count] = std::norm(fft->buf[fft->_bin_count]);
+}
+
 // create an instance of the FFT state machine
 DSP::FFTWindowStateSITL::FFTWindowStateSITL(uint16_t window_size, uint16_t sample_rate, uint8_t sliding_window_size)
     : AP_HAL::DSP::FFTWindowState::FFTWindowState(window_size, sample_rate, sliding_window_size)
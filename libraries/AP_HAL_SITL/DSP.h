@@ -51,6 +51,7 @@ public:
 private:
     void step_hanning(FFTWindowStateSITL* fft, FloatBuffer& samples, uint16_t advance);
     void step_fft(FFTWindowStateSITL* fft);
+    void fft_power(FFTWindowState* state) override;
     void mult_f32(const float* v1, const float* v2, float* vout, uint16_t len);
     void vector_max_float(const float* vin, uint16_t len, float* maxValue, uint16_t* maxIndex) const override;
     void vector_scale_float(const float* vin, float scale, float* vout, uint16_t len) const override;
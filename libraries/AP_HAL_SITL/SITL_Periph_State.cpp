@@ -136,7 +136,7 @@ void SITL_State::wait_clock(uint64_t wait_time_usec)
             sim_update();
             update_voltage_current(input, 0);
         } else {
-            usleep(1000);
+            Scheduler::from(hal.scheduler)->wait_clock_advance(wait_time_usec, 10000);
         }
     }
 }
@@ -103,6 +103,10 @@ void SITL_State::_sitl_setup()
         _sitl->irlock_port = _irlock_port;
 
         _sitl->rcin_port = _rcin_port;
+
+#if AP_SIM_PROFILE_ENABLED
+        _sitl->profile.set_enabled(enable_sim_profile);
+#endif
     }
 
     // start with non-zero clock
@@ -148,7 +152,10 @@ void SITL_State::_fdm_input_step(void)
 void SITL_State::wait_clock(uint64_t wait_time_usec)
 {
     float speedup = sitl_model->get_speedup();
-    if (speedup < 1) {
+    if (is_zero(speedup)) {
+        // unlimited speedup, treat as a very high speedup for sleeps
+        speedup = 1000;
+    } else if (speedup < 1) {
         // for purposes of sleeps treat low speedups as 1
         speedup = 1.0;
     }
@@ -173,7 +180,8 @@ void SITL_State::wait_clock(uint64_t wait_time_usec)
                 }
             }
 #endif
-            usleep(1000);
+            // woken by the main thread when the clock reaches wait_time_usec
+            _scheduler->wait_clock_advance(wait_time_usec, 10000);
         }
     }
     // check the outbound TCP queue size.  If it is too long then
@@ -242,7 +250,10 @@ void SITL_State::_fdm_input_local(void)
     struct sitl_input input;
 
     // construct servos structure for FDM
-    _simulator_servos(input);
+    {
+        SIM_PROFILE(_sitl->profile, "servos");
+        _simulator_servos(input);
+    }
 
 #if AP_SIM_JSON_MASTER_ENABLED
     // read servo inputs from ride along flight controllers
@@ -253,11 +264,14 @@ void SITL_State::_fdm_input_local(void)
     multicast_servo_update(input);
 
     // update the model
-    sitl_model->update_home();
-    sitl_model->update_model(input);
+    {
+        SIM_PROFILE(_sitl->profile, "model");
+        sitl_model->update_home();
+        sitl_model->update_model(input);
 
-    // get FDM output from the model
-    sitl_model->fill_fdm(_sitl->state);
+        // get FDM output from the model
+        sitl_model->fill_fdm(_sitl->state);
+    }
 
 #if HAL_NUM_CAN_IFACES
     if (CANIface::num_interfaces() > 0) {
@@ -282,6 +296,10 @@ void SITL_State::_fdm_input_local(void)
     set_height_agl();
 
     _update_count++;
+
+#if AP_SIM_PROFILE_ENABLED
+    _sitl->profile.step_done();
+#endif
 }
 
 /*
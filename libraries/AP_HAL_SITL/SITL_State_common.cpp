@@ -289,16 +289,19 @@ void SITL_State_Common::sim_update(void)
 {
 #if AP_SIM_SOLOGIMBAL_ENABLED
     if (gimbal != nullptr) {
+        SIM_PROFILE(_sitl->profile, "gimbal");
         gimbal->update(*sitl_model);
     }
 #endif
 #if AP_SIM_ADSB_ENABLED
     if (adsb != nullptr) {
+        SIM_PROFILE(_sitl->profile, "adsb");
         adsb->update(*sitl_model);
     }
 #endif  // AP_SIM_ADSB_ENABLED
 #if !defined(HAL_BUILD_AP_PERIPH)
     if (vicon != nullptr) {
+        SIM_PROFILE(_sitl->profile, "vicon");
         Quaternion attitude;
         sitl_model->get_attitude(attitude);
         vicon->update(sitl_model->get_location(),
@@ -308,16 +311,20 @@ void SITL_State_Common::sim_update(void)
     }
 #endif
     for (uint8_t i=0; i<num_serial_rangefinders; i++) {
-        serial_rangefinders[i]->update(sitl_model->rangefinder_range());
+        SIM_PROFILE(_sitl->profile, "rangefinder");
+        serial_rangefinders[i]->update(*sitl_model);
     }
     if (efi_ms != nullptr) {
+        SIM_PROFILE(_sitl->profile, "efi");
         efi_ms->update();
     }
     if (efi_hirth != nullptr) {
+        SIM_PROFILE(_sitl->profile, "efi");
         efi_hirth->update();
     }
 
     if (frsky_d != nullptr) {
+        SIM_PROFILE(_sitl->profile, "frsky");
         frsky_d->update();
     }
     // if (frsky_sport != nullptr) {
@@ -329,75 +336,90 @@ void SITL_State_Common::sim_update(void)
 
 #if AP_SIM_CRSF_ENABLED
     if (crsf != nullptr) {
+        SIM_PROFILE(_sitl->profile, "crsf");
         crsf->update();
     }
 #endif
 
 #if AP_SIM_PS_LD06_ENABLED
     if (ld06 != nullptr) {
+        SIM_PROFILE(_sitl->profile, "proximity");
         ld06->update(sitl_model->get_location());
     }
 #endif  // AP_SIM_PS_LD06_ENABLED
 
 #if AP_SIM_PS_RPLIDARA2_ENABLED
     if (rplidara2 != nullptr) {
+        SIM_PROFILE(_sitl->profile, "proximity");
         rplidara2->update(sitl_model->get_location());
     }
 #endif
 
 #if AP_SIM_PS_RPLIDARA1_ENABLED
     if (rplidara1 != nullptr) {
+        SIM_PROFILE(_sitl->profile, "proximity");
         rplidara1->update(sitl_model->get_location());
     }
 #endif
 #if AP_SIM_PS_TERARANGERTOWER_ENABLED
     if (terarangertower != nullptr) {
+        SIM_PROFILE(_sitl->profile, "proximity");
         terarangertower->update(sitl_model->get_location());
     }
 #endif
 
 #if AP_SIM_PS_LIGHTWARE_SF45B_ENABLED
     if (sf45b != nullptr) {
+        SIM_PROFILE(_sitl->profile, "proximity");
         sf45b->update(sitl_model->get_location());
     }
 #endif
 
 #if AP_SIM_ADSB_SAGETECH_MXS_ENABLED
     if (sagetech_mxs != nullptr) {
+        SIM_PROFILE(_sitl->profile, "adsb");
         sagetech_mxs->update(sitl_model);
     }
 #endif
 
     if (vectornav != nullptr) {
+        SIM_PROFILE(_sitl->profile, "external_ahrs");
         vectornav->update();
     }
 
     if (microstrain5 != nullptr) {
+        SIM_PROFILE(_sitl->profile, "external_ahrs");
         microstrain5->update();
     }
 
     if (microstrain7 != nullptr) {
+        SIM_PROFILE(_sitl->profile, "external_ahrs");
         microstrain7->update();
     }
     if (inertiallabs != nullptr) {
+        SIM_PROFILE(_sitl->profile, "external_ahrs");
         inertiallabs->update();
     }
 
 #if AP_SIM_AIS_ENABLED
     if (ais != nullptr) {
+        SIM_PROFILE(_sitl->profile, "ais");
         ais->update(*sitl_model);
     }
     if (ais_replay != nullptr) {
+        SIM_PROFILE(_sitl->profile, "ais");
         ais_replay->update();
     }
 #endif
     for (uint8_t i=0; i<ARRAY_SIZE(gps); i++) {
         if (gps[i] != nullptr) {
+            SIM_PROFILE(_sitl->profile, "gps");
             gps[i]->update();
         }
     }
 
     if (elrs != nullptr) {
+        SIM_PROFILE(_sitl->profile, "elrs");
         elrs->update();
     }
 }
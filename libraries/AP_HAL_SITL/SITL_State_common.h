@@ -88,6 +88,11 @@ public:
     uint16_t pwm_output[SITL_NUM_CHANNELS];
     bool output_ready = false;
 
+#if AP_SIM_PROFILE_ENABLED
+    // print where the simulation step time goes
+    bool enable_sim_profile;
+#endif
+
 #if AP_SIM_SOLOGIMBAL_ENABLED
     // simulated gimbal
     bool enable_gimbal;
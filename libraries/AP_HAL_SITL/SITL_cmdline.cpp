@@ -82,7 +82,7 @@ void SITL_State::_usage(void)
            "\t--help|-h                display this help information\n"
            "\t--wipe|-w                wipe eeprom\n"
            "\t--unhide-groups|-u       parameter enumeration ignores AP_PARAM_FLAG_ENABLE\n"
-           "\t--speedup|-s SPEEDUP     set simulation speedup\n"
+           "\t--speedup|-s SPEEDUP     set simulation speedup, 0 for as fast as possible\n"
            "\t--rate|-r RATE           set SITL framerate\n"
            "\t--console|-C             use console instead of TCP ports\n"
            "\t--instance|-I N          set instance of SITL (adds 10*instance to all port numbers)\n"
@@ -117,6 +117,7 @@ void SITL_State::_usage(void)
            "\t--start-time TIMESTR     set simulation start time in UNIX timestamp\n"
            "\t--sysid ID               set MAV_SYSID\n"
            "\t--slave number           set the number of JSON slaves\n"
+           "\t--profile-sim            print where simulation step time is spent\n"
         );
 }
 
@@ -303,6 +304,7 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         CMDLINE_START_TIME,
         CMDLINE_SYSID,
         CMDLINE_SLAVE,
+        CMDLINE_PROFILE_SIM,
 #if STORAGE_USE_FLASH
         CMDLINE_SET_STORAGE_FLASH_ENABLED,
 #endif
@@ -363,6 +365,7 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         {"start-time",      true,   0, CMDLINE_START_TIME},
         {"sysid",           true,   0, CMDLINE_SYSID},
         {"slave",           true,   0, CMDLINE_SLAVE},
+        {"profile-sim",     false,  0, CMDLINE_PROFILE_SIM},
 #if STORAGE_USE_FLASH
         {"set-storage-flash-enabled", true,   0, CMDLINE_SET_STORAGE_FLASH_ENABLED},
 #endif
@@ -572,6 +575,11 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
 #endif  // AP_SIM_JSON_MASTER_ENABLED
             break;
         }
+        case CMDLINE_PROFILE_SIM:
+#if AP_SIM_PROFILE_ENABLED
+            enable_sim_profile = true;
+#endif
+            break;
         default:
             _usage();
             exit(1);
@@ -301,12 +301,43 @@ void Scheduler::_run_io_procs()
 void Scheduler::stop_clock(uint64_t time_usec)
 {
     _stopped_clock_usec = time_usec;
+    // order the clock update before reading the wake time, pairs with wait_clock_advance()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (time_usec >= _clock_next_wake_usec) {
+        pthread_mutex_lock(&_clock_mutex);
+        _clock_next_wake_usec = UINT64_MAX;
+        pthread_cond_broadcast(&_clock_cond);
+        pthread_mutex_unlock(&_clock_mutex);
+    }
     if (_sitlState->_sitl != nullptr && time_usec - _last_io_run > 10000) {
         _last_io_run = time_usec;
         _run_io_procs();
     }
 }
 
+/*
+  wait for the main thread to advance the clock. The wake time is
+  published before the clock is checked, so stop_clock() either sees
+  it or this thread sees the new time. The wall clock limit keeps
+  threads running if the main thread stops advancing time
+ */
+void Scheduler::wait_clock_advance(uint64_t wait_time_usec, uint32_t max_wall_usec)
+{
+    pthread_mutex_lock(&_clock_mutex);
+    if (wait_time_usec < _clock_next_wake_usec) {
+        _clock_next_wake_usec = wait_time_usec;
+    }
+    if (AP_HAL::micros64() < wait_time_usec) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        const uint64_t ns = ts.tv_nsec + uint64_t(max_wall_usec) * 1000ULL;
+        ts.tv_sec += ns / 1000000000ULL;
+        ts.tv_nsec = ns % 1000000000ULL;
+        pthread_cond_timedwait(&_clock_cond, &_clock_mutex, &ts);
+    }
+    pthread_mutex_unlock(&_clock_mutex);
+}
+
 /*
   trampoline for thread create
 */
@@ -5,6 +5,7 @@
 #include "AP_HAL_SITL_Namespace.h"
 #include <sys/time.h>
 #include <pthread.h>
+#include <atomic>
 
 #define SITL_SCHEDULER_MAX_TIMER_PROCS 8
 
@@ -28,6 +29,7 @@ public:
     void register_timer_failsafe(AP_HAL::Proc, uint32_t period_us) override;
 
     bool in_main_thread() const override;
+    const void *current_thread_id() const override { return (const void *)pthread_self(); }
     bool is_system_initialized() override { return _initialized; };
     void set_system_initialized() override;
 
@@ -49,6 +51,13 @@ public:
 
     uint64_t stopped_clock_usec() const { return _stopped_clock_usec; }
 
+    /*
+      block a thread other than the main thread until the simulated
+      clock reaches wait_time_usec or max_wall_usec of wall clock time
+      has passed
+     */
+    void wait_clock_advance(uint64_t wait_time_usec, uint32_t max_wall_usec);
+
     static void _run_io_procs();
     static bool _should_exit;
 
@@ -99,6 +108,13 @@ private:
     uint64_t _last_io_run;
     pthread_t _main_ctx;
 
+    // threads waiting in wait_clock_advance() are woken when the
+    // clock passes the earliest of their wait times, rather than
+    // polling with wall clock sleeps
+    pthread_mutex_t _clock_mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t _clock_cond = PTHREAD_COND_INITIALIZER;
+    std::atomic<uint64_t> _clock_next_wake_usec {UINT64_MAX};
+
     static HAL_Semaphore _thread_sem;
     struct thread_attr {
         struct thread_attr *next;
@@ -233,6 +233,20 @@ ssize_t UARTDriver::_read(uint8_t *buffer, uint16_t count)
     return ret;
 }
 
+uint8_t UARTDriver::_peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len)
+{
+    return _readbuffer.peekiovec(vec, len);
+}
+
+bool UARTDriver::_consume(uint32_t n)
+{
+    if (!_readbuffer.advance(n)) {
+        return false;
+    }
+    _rx_stats_bytes += n;
+    return true;
+}
+
 bool UARTDriver::_discard_input(void)
 {
     _readbuffer.clear();
@@ -147,6 +147,9 @@ protected:
     void _end() override;
     void _flush() override;
     bool _discard_input() override;
+    uint8_t _peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len) override;
+    bool _consume(uint32_t n) override;
+    uint32_t _tx_queued() override { return _writebuffer.available(); }
 
 #if HAL_UART_STATS_ENABLED
     // Getters for cumulative tx and rx counts
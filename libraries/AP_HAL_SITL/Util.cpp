@@ -110,7 +110,7 @@ void HALSITL::Util::set_cmdline_parameters()
 /**
    return commandline arguments, if available
 */
-void HALSITL::Util::commandline_arguments(uint8_t &argc, char * const *&argv)
+void HALSITL::Util::commandline_arguments(int &argc, char * const *&argv)
 {
     argc = saved_argc;
     argv = saved_argv;
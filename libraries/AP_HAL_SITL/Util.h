@@ -33,7 +33,7 @@ public:
     /**
        return commandline arguments, if available
      */
-    void commandline_arguments(uint8_t &argc, char * const *&argv) override;
+    void commandline_arguments(int &argc, char * const *&argv) override;
     
     uint64_t get_hw_rtc() const override;
     void set_hw_rtc(uint64_t time_utc_usec) override { /* fail silently */ }
@@ -77,8 +77,8 @@ AP_IOMCU *AP_IOMCU::singleton;
  */
 void AP_IOMCU::init(void)
 {
-    // uart runs at 1.5MBit
-    uart.begin(1500*1000, 128, 128);
+    // uart runs at 1.5MBit, buffers hold a full batched reply
+    uart.begin(IOMCU_DEFAULT_BAUDRATE, 256, 256);
 #ifdef AP_IOMCU_UART_OPTIONS
     uart.set_options(AP_IOMCU_UART_OPTIONS);
 #endif
@@ -122,11 +122,10 @@ void AP_IOMCU::thread_main(void)
     thread_ctx = chThdGetSelfX();
     chEvtSignal(thread_ctx, initial_event_mask);
 
-    uart.begin(1500*1000, 128, 128);
+    uart.begin(IOMCU_DEFAULT_BAUDRATE, 256, 256);
     uart.set_unbuffered_writes(true);
 
 #if HAL_WITH_IO_MCU_BIDIR_DSHOT
-    uint16_t erpm_period_ms = 10; // default 100Hz
 #if HAVE_AP_BLHELI_SUPPORT
     AP_BLHeli* blh = AP_BLHeli::get_singleton();
     if (blh && blh->get_telemetry_rate() > 0) {
@@ -143,6 +142,11 @@ void AP_IOMCU::thread_main(void)
             INTERNAL_ERROR(AP_InternalError::error_t::iomcu_reset);
             last_reg_access_ms = 0;
         }
+        if (baudrate != IOMCU_DEFAULT_BAUDRATE && now_ms - last_reg_access_ms > IOMCU_BAUDRATE_FALLBACK_MS) {
+            // the IOMCU will have gone back to the boot baudrate
+            baudrate = IOMCU_DEFAULT_BAUDRATE;
+            uart.begin(baudrate);
+        }
 
         eventmask_t mask = chEvtWaitAnyTimeout(~0, chTimeMS2I(10));
 
@@ -319,33 +323,41 @@ void AP_IOMCU::thread_main(void)
 
         // check for regular timed events
         uint32_t now = AP_HAL::millis();
-        if (now - last_rc_read_ms > 20) {
-            // read RC input at 50Hz
-            read_rc_input();
-            last_rc_read_ms = AP_HAL::millis();
-        }
+        if (is_chibios_backend) {
+            // pick up anything not already sent back with servo output
+            const uint8_t batch_mask = batch_due_mask(now);
+            if (batch_mask != 0) {
+                batch_transfer(batch_mask, nullptr, 0);
+            }
+        } else {
+            if (now - last_rc_read_ms > 20) {
+                // read RC input at 50Hz
+                read_rc_input();
+                last_rc_read_ms = AP_HAL::millis();
+            }
 
-        if (now - last_status_read_ms > 50) {
-            // read status at 20Hz
-            read_status();
-            last_status_read_ms = AP_HAL::millis();
-            write_log();
-        }
+            if (now - last_status_read_ms > 50) {
+                // read status at 20Hz
+                read_status();
+                last_status_read_ms = AP_HAL::millis();
+                write_log();
+            }
 
-        if (now - last_servo_read_ms > 50) {
-            // read servo out at 20Hz
-            read_servo();
-            last_servo_read_ms = AP_HAL::millis();
-        }
+            if (now - last_servo_read_ms > 50) {
+                // read servo out at 20Hz
+                read_servo();
+                last_servo_read_ms = AP_HAL::millis();
+            }
 #if HAL_WITH_IO_MCU_BIDIR_DSHOT
-        if (AP_BoardConfig::io_dshot() && now - last_erpm_read_ms > erpm_period_ms) {
-            // read erpm at configured rate. A more efficient scheme might be to 
-            // send erpm info back with the response from a PWM send, but that would
-            // require a reworking of the registers model
-            read_erpm();
-            last_erpm_read_ms = AP_HAL::millis();
+            if (AP_BoardConfig::io_dshot() && now - last_erpm_read_ms > erpm_period_ms) {
+                // read erpm at configured rate
+                read_erpm();
+                last_erpm_read_ms = AP_HAL::millis();
+            }
+#endif
         }
 
+#if HAL_WITH_IO_MCU_BIDIR_DSHOT
         if (AP_BoardConfig::io_dshot() && now - last_telem_read_ms > 100) {
             // read dshot telemetry at 10Hz
             // needs to be at least 4Hz since each ESC updates at ~1Hz and we
@@ -354,6 +366,14 @@ void AP_IOMCU::thread_main(void)
             last_telem_read_ms = AP_HAL::millis();
         }
 #endif
+#if AP_IOMCU_FAST_BAUDRATE
+        if (is_chibios_backend && baudrate != AP_IOMCU_FAST_BAUDRATE &&
+            !hal.util->get_soft_armed() && now - last_baudrate_attempt_ms > 5000) {
+            last_baudrate_attempt_ms = now;
+            set_fast_baudrate();
+        }
+#endif
+
         // update options at the same rate that the iomcu updates the state
         if (now - last_safety_option_check_ms > 100) {
             update_safety_options();
@@ -394,13 +414,199 @@ void AP_IOMCU::send_servo_out()
         uint32_t now = AP_HAL::micros();
         if (now - last_servo_out_us >= 2000 || AP_BoardConfig::io_dshot()) {
             // don't send data at more than 500Hz except when using dshot which is more timing sensitive
-            if (write_registers(PAGE_DIRECT_PWM, 0, n, pwm_out.pwm)) {
+            bool ok;
+            if (is_chibios_backend) {
+                // the reply brings back any pages that are due
+                ok = batch_transfer(batch_due_mask(AP_HAL::millis()), pwm_out.pwm, n);
+            } else {
+                ok = write_registers(PAGE_DIRECT_PWM, 0, n, pwm_out.pwm);
+            }
+            if (ok) {
                 last_servo_out_us = now;
             }
         }
     }
 }
 
+/*
+  pages to fetch in a batched transfer at this time
+ */
+uint8_t AP_IOMCU::batch_due_mask(uint32_t now_ms) const
+{
+    uint8_t mask = 0;
+    // RC input is cheap to add to a batch, so fetch it more often
+    if (now_ms - last_rc_read_ms >= AP_IOMCU_BATCH_RC_PERIOD_MS) {
+        mask |= BATCH_RCIN;
+    }
+    if (now_ms - last_status_read_ms > 50) {
+        mask |= BATCH_STATUS;
+    }
+    if (pwm_out.num_channels > 0 && now_ms - last_servo_read_ms > 50) {
+        mask |= BATCH_SERVOS;
+    }
+#if HAL_WITH_IO_MCU_BIDIR_DSHOT
+    if (AP_BoardConfig::io_dshot() && now_ms - last_erpm_read_ms > erpm_period_ms) {
+        mask |= BATCH_ERPM;
+    }
+#endif
+    return mask;
+}
+
+/*
+  batched transfer, optionally sending servo output. The reply holds
+  the pages selected by mask in the order of the BATCH_* bits. This
+  must match AP_IOMCU_FW::fill_batch_reply()
+ */
+bool AP_IOMCU::batch_transfer(uint8_t mask, const uint16_t *pwm, uint8_t num_pwm)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    uint8_t reply_count = 0;
+    if (mask & BATCH_RCIN) {
+        reply_count += sizeof(rc_input)/2;
+        last_rc_read_ms = now_ms;
+    }
+    if (mask & BATCH_STATUS) {
+        reply_count += sizeof(reg_status)/2;
+        last_status_read_ms = now_ms;
+    }
+    if (mask & BATCH_SERVOS) {
+        reply_count += IOMCU_MAX_RC_CHANNELS;
+        last_servo_read_ms = now_ms;
+    }
+    if (mask & BATCH_ERPM) {
+        reply_count += sizeof(struct page_dshot_erpm)/2;
+#if HAL_WITH_IO_MCU_BIDIR_DSHOT
+        last_erpm_read_ms = now_ms;
+#endif
+    }
+    if (num_pwm > PKT_MAX_REGS) {
+        return false;
+    }
+
+    IOPacket pkt;
+
+    discard_input();
+
+    pkt.code = num_pwm > 0 ? CODE_WRITE : CODE_READ;
+    pkt.count = num_pwm;
+    pkt.page = PAGE_BATCH;
+    pkt.offset = mask;
+    pkt.crc = 0;
+    if (num_pwm > 0) {
+        memcpy(pkt.regs, pwm, num_pwm*2);
+    }
+
+    const uint8_t pkt_size = num_pwm > 0 ? pkt.get_size() : 4;
+    pkt.crc = crc_crc8((const uint8_t *)&pkt, pkt_size);
+
+    size_t ret = write_wait((uint8_t *)&pkt, pkt_size);
+
+    if (ret != pkt_size) {
+        debug("write failed3 %u %u\n", unsigned(pkt_size), mask);
+        protocol_fail_count++;
+        goto failed;
+    }
+
+    // wait for the expected number of reply bytes or timeout
+    if (!uart.wait_timeout(reply_count*2+4, 10)) {
+        debug("t=%lu timeout batch mask=%u avail=%u\n", AP_HAL::millis(), mask, uart.available());
+        protocol_fail_count++;
+        goto failed;
+    }
+
+    {
+        uint8_t *b = (uint8_t *)&pkt;
+        const uint8_t n = uart.available();
+        if (n != reply_count*2+4) {
+            debug("t=%lu bad batch len %u %u\n", AP_HAL::millis(), n, reply_count);
+            protocol_fail_count++;
+            goto failed;
+        }
+        uart.read(b, n);
+
+        const uint8_t got_crc = pkt.crc;
+        pkt.crc = 0;
+        const uint8_t expected_crc = crc_crc8((const uint8_t *)&pkt, n);
+        if (got_crc != expected_crc || pkt.code != CODE_SUCCESS || pkt.count != reply_count) {
+            debug("t=%lu bad batch reply crc=%02x/%02x code=%02x count=%u\n",
+                  AP_HAL::millis(), got_crc, expected_crc, pkt.code, pkt.count);
+            protocol_fail_count++;
+            goto failed;
+        }
+    }
+
+    if (protocol_fail_count > IOMCU_MAX_REPEATED_FAILURES) {
+        handle_repeated_failures();
+    }
+    total_errors += protocol_fail_count;
+    protocol_fail_count = 0;
+    protocol_count++;
+    last_reg_access_ms = AP_HAL::millis();
+
+    {
+        const uint8_t *p = (const uint8_t *)pkt.regs;
+        if (mask & BATCH_RCIN) {
+            memcpy(&rc_input, p, sizeof(rc_input));
+            p += sizeof(rc_input);
+            handle_rc_input();
+        }
+        if (mask & BATCH_STATUS) {
+            memcpy(&reg_status, p, sizeof(reg_status));
+            p += sizeof(reg_status);
+            handle_status();
+            write_log();
+        }
+        if (mask & BATCH_SERVOS) {
+            memcpy(pwm_in.pwm, p, IOMCU_MAX_RC_CHANNELS*2);
+            p += IOMCU_MAX_RC_CHANNELS*2;
+        }
+#if HAL_WITH_IO_MCU_BIDIR_DSHOT
+        if (mask & BATCH_ERPM) {
+            memcpy(&dshot_erpm, p, sizeof(dshot_erpm));
+            handle_erpm();
+        }
+#endif
+    }
+    return true;
+
+failed:
+    if (mask & BATCH_STATUS) {
+        handle_status_failure();
+        write_log();
+    }
+    return false;
+}
+
+#if AP_IOMCU_FAST_BAUDRATE
+/*
+  move the link to AP_IOMCU_FAST_BAUDRATE. The IOMCU switches once it
+  has acknowledged the request, and both sides go back to
+  IOMCU_DEFAULT_BAUDRATE if the link fails
+ */
+void AP_IOMCU::set_fast_baudrate(void)
+{
+    const uint32_t fast = AP_IOMCU_FAST_BAUDRATE;
+    uint16_t regs[2];
+    memcpy(regs, &fast, sizeof(regs));
+    if (!write_registers(PAGE_SETUP, PAGE_REG_SETUP_BAUDRATE, 2, regs)) {
+        return;
+    }
+    // let the reply finish before the IOMCU changes rate
+    hal.scheduler->delay_microseconds(200);
+    uart.begin(fast);
+    baudrate = fast;
+
+    struct page_config cfg;
+    if (!read_registers(PAGE_CONFIG, 0, sizeof(cfg)/2, (uint16_t *)&cfg)) {
+        // stay at the boot rate, the IOMCU falls back to it too
+        baudrate = IOMCU_DEFAULT_BAUDRATE;
+        uart.begin(baudrate);
+        return;
+    }
+    DEV_PRINTF("IOMCU: link at %u baud\n", unsigned(fast));
+}
+#endif
+
 /*
   read RC input
  */
@@ -410,6 +616,14 @@ void AP_IOMCU::read_rc_input()
     if (!read_registers(PAGE_RAW_RCIN, 0, sizeof(rc_input)/2, r)) {
         return;
     }
+    handle_rc_input();
+}
+
+/*
+  handle new RC input
+ */
+void AP_IOMCU::handle_rc_input()
+{
     if (rc_input.flags_failsafe && rc().option_is_enabled(RC_Channels::Option::IGNORE_FAILSAFE)) {
         rc_input.flags_failsafe = false;
     }
@@ -428,6 +642,14 @@ void AP_IOMCU::read_erpm()
     if (!read_registers(PAGE_RAW_DSHOT_ERPM, 0, sizeof(dshot_erpm)/2, r)) {
         return;
     }
+    handle_erpm();
+}
+
+/*
+  pass new dshot erpm to the ESC telemetry
+ */
+void AP_IOMCU::handle_erpm()
+{
     uint8_t motor_poles = 14;
 #if HAVE_AP_BLHELI_SUPPORT
     AP_BLHeli* blh = AP_BLHeli::get_singleton();
@@ -489,13 +711,29 @@ void AP_IOMCU::read_status()
 {
     uint16_t *r = (uint16_t *)&reg_status;
     if (!read_registers(PAGE_STATUS, 0, sizeof(reg_status)/2, r)) {
-        read_status_errors++;
-        if (read_status_errors == 20 && last_iocmu_timestamp_ms != 0) {
-            // the IOMCU has stopped responding to status requests
-            INTERNAL_ERROR(AP_InternalError::error_t::iomcu_reset);
-        }
+        handle_status_failure();
         return;
     }
+    handle_status();
+}
+
+/*
+  count a failed status read
+ */
+void AP_IOMCU::handle_status_failure()
+{
+    read_status_errors++;
+    if (read_status_errors == 20 && last_iocmu_timestamp_ms != 0) {
+        // the IOMCU has stopped responding to status requests
+        INTERNAL_ERROR(AP_InternalError::error_t::iomcu_reset);
+    }
+}
+
+/*
+  handle new status registers
+ */
+void AP_IOMCU::handle_status()
+{
     if (read_status_ok == 0) {
         // reset error count on first good read
         read_status_errors = 0;
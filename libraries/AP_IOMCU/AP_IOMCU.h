@@ -21,6 +21,17 @@ typedef struct ch_thread thread_t;
 #define AP_IOMCU_FW_FLASH_SIZE (0x10000 - 0x1000)
 #endif
 
+// faster link baudrate to switch to once the IOMCU is found, 0 to
+// stay at IOMCU_DEFAULT_BAUDRATE
+#ifndef AP_IOMCU_FAST_BAUDRATE
+#define AP_IOMCU_FAST_BAUDRATE 0
+#endif
+
+// RC input period when it is batched with other transfers
+#ifndef AP_IOMCU_BATCH_RC_PERIOD_MS
+#define AP_IOMCU_BATCH_RC_PERIOD_MS 5
+#endif
+
 
 class AP_IOMCU
 #ifdef HAL_WITH_ESC_TELEM
@@ -244,6 +255,20 @@ private:
     void read_telem(void);
     void read_servo(void);
     void read_status(void);
+    void handle_rc_input(void);
+    void handle_erpm(void);
+    void handle_status(void);
+    void handle_status_failure(void);
+    uint8_t batch_due_mask(uint32_t now_ms) const;
+    bool batch_transfer(uint8_t mask, const uint16_t *pwm, uint8_t num_pwm);
+#if AP_IOMCU_FAST_BAUDRATE
+    void set_fast_baudrate(void);
+    uint32_t last_baudrate_attempt_ms;
+#endif
+    uint32_t baudrate = IOMCU_DEFAULT_BAUDRATE;
+#if HAL_WITH_IO_MCU_BIDIR_DSHOT
+    uint16_t erpm_period_ms = 10; // default 100Hz
+#endif
     void discard_input(void);
     void event_failed(uint32_t event_mask);
     void update_safety_options(void);
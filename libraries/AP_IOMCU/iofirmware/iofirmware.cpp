@@ -194,6 +194,12 @@ static void dma_tx_end_cb(hal_uart_driver *uart)
     TOGGLE_PIN_DEBUG(108);
     TOGGLE_PIN_DEBUG(108);
 #endif
+    // the reply to a baudrate change has gone, so switch now
+    if (iomcu.pending_baudrate != 0) {
+        iomcu.set_baudrate(iomcu.pending_baudrate);
+        iomcu.pending_baudrate = 0;
+    }
+
 #if AP_HAL_SHARED_DMA_ENABLED
     chSysLockFromISR();
     chEvtSignalI(iomcu.thread_ctx, IOEVENT_TX_END);
@@ -344,7 +350,7 @@ static UARTConfig uart_cfg = {
 #if defined(STM32H7)
 0,                 // timeout
 #endif
-    1500000,      //1.5MBit
+    IOMCU_DEFAULT_BAUDRATE,
     USART_CR1_IDLEIE
 #if defined(STM32H7)
      | USART_CR1_FIFOEN
@@ -562,6 +568,19 @@ void AP_IOMCU_FW::update()
         hal.scheduler->reboot(false);
         while (true) {}
     }
+    // go back to the boot baudrate if the FMU can't be heard, so
+    // the link recovers if the FMU has done the same
+    const uint32_t valid_pkts = reg_status.total_pkts - reg_status.num_errors;
+    if (valid_pkts != last_valid_pkts) {
+        last_valid_pkts = valid_pkts;
+        last_valid_pkt_ms = last_ms;
+    } else if (baudrate != IOMCU_DEFAULT_BAUDRATE &&
+               last_ms - last_valid_pkt_ms > IOMCU_BAUDRATE_FALLBACK_MS) {
+        chSysLock();
+        set_baudrate(IOMCU_DEFAULT_BAUDRATE);
+        chSysUnlock();
+    }
+
     if ((mask & IOEVENT_PWM) ||
         (last_safety_off != reg_status.flag_safety_off)) {
         last_safety_off = reg_status.flag_safety_off;
@@ -883,6 +902,10 @@ void AP_IOMCU_FW::page_status_update(void)
 
 bool AP_IOMCU_FW::handle_code_read()
 {
+    if (rx_io_packet.page == PAGE_BATCH) {
+        return fill_batch_reply(rx_io_packet.offset);
+    }
+
     uint16_t *values = nullptr;
 #define COPY_PAGE(_page_name)							\
 	do {									\
@@ -1084,34 +1107,37 @@ bool AP_IOMCU_FW::handle_code_write()
             break;
         }
 
-        default:
+        case PAGE_REG_SETUP_BAUDRATE: {
+            if (rx_io_packet.count != 2) {
+                return false;
+            }
+            uint32_t v;
+            memcpy(&v, &rx_io_packet.regs[0], 4);
+            // the USART needs 16 clocks per bit
+            if (v < IOMCU_DEFAULT_BAUDRATE || v > HAL_IO_FMU_COMMS.clock / 16) {
+                return false;
+            }
+            pending_baudrate = v;
             break;
         }
-        break;
 
-    case PAGE_DIRECT_PWM: {
-        if (override_active) {
-            // no input when override is active
+        default:
             break;
         }
-        if (rx_io_packet.count > sizeof(reg_direct_pwm.pwm)/2) {
+        break;
+
+    case PAGE_DIRECT_PWM:
+        if (!handle_direct_pwm()) {
             return false;
         }
-        /* copy channel data */
-        uint16_t i = 0, num_values = rx_io_packet.count;
-        while ((i < IOMCU_MAX_RC_CHANNELS) && (num_values > 0)) {
-            /* XXX range-check value? */
-            if (rx_io_packet.regs[i] != PWM_IGNORE_THIS_CHANNEL) {
-                reg_direct_pwm.pwm[i] = rx_io_packet.regs[i];
-            }
+        break;
 
-            num_values--;
-            i++;
+    case PAGE_BATCH:
+        // servo output with the reply carrying the requested pages
+        if (!handle_direct_pwm()) {
+            return false;
         }
-        fmu_data_received_time = last_ms;
-        chEvtSignalI(thread_ctx, IOEVENT_PWM);
-        break;
-    }
+        return fill_batch_reply(rx_io_packet.offset);
 
     case PAGE_MIXING: { // multi-packet message
         uint16_t offset = rx_io_packet.offset, num_values = rx_io_packet.count;
@@ -1178,6 +1204,85 @@ bool AP_IOMCU_FW::handle_code_write()
     return true;
 }
 
+/*
+  take direct PWM values from the FMU
+ */
+bool AP_IOMCU_FW::handle_direct_pwm()
+{
+    if (override_active) {
+        // no input when override is active
+        return true;
+    }
+    if (rx_io_packet.count > sizeof(reg_direct_pwm.pwm)/2) {
+        return false;
+    }
+    /* copy channel data */
+    uint16_t i = 0, num_values = rx_io_packet.count;
+    while ((i < IOMCU_MAX_RC_CHANNELS) && (num_values > 0)) {
+        /* XXX range-check value? */
+        if (rx_io_packet.regs[i] != PWM_IGNORE_THIS_CHANNEL) {
+            reg_direct_pwm.pwm[i] = rx_io_packet.regs[i];
+        }
+
+        num_values--;
+        i++;
+    }
+    fmu_data_received_time = last_ms;
+    chEvtSignalI(thread_ctx, IOEVENT_PWM);
+    return true;
+}
+
+/*
+  reply with the pages selected by mask, in the order of the BATCH_*
+  bits. This must match AP_IOMCU::batch_transfer()
+ */
+bool AP_IOMCU_FW::fill_batch_reply(uint8_t mask)
+{
+    uint8_t *p = (uint8_t *)tx_io_packet.regs;
+    if (mask & BATCH_RCIN) {
+        memcpy(p, &rc_input, sizeof(rc_input));
+        p += sizeof(rc_input);
+    }
+    if (mask & BATCH_STATUS) {
+        memcpy(p, &reg_status, sizeof(reg_status));
+        p += sizeof(reg_status);
+    }
+    if (mask & BATCH_SERVOS) {
+        memcpy(p, reg_servo.pwm, sizeof(reg_servo.pwm));
+        p += sizeof(reg_servo.pwm);
+    }
+    if (mask & BATCH_ERPM) {
+#ifdef HAL_WITH_BIDIR_DSHOT
+        memcpy(p, &dshot_erpm, sizeof(dshot_erpm));
+        // as for a read of PAGE_RAW_DSHOT_ERPM
+        memset(&dshot_erpm, 0, sizeof(dshot_erpm));
+#else
+        memset(p, 0, sizeof(struct page_dshot_erpm));
+#endif
+        p += sizeof(struct page_dshot_erpm);
+    }
+    tx_io_packet.count = (p - (uint8_t *)tx_io_packet.regs) / 2;
+    tx_io_packet.code = CODE_SUCCESS;
+    tx_io_packet.page = PAGE_BATCH;
+    tx_io_packet.offset = mask;
+    tx_io_packet.crc = 0;
+    tx_io_packet.crc =  crc_crc8((const uint8_t *)&tx_io_packet, tx_io_packet.get_size());
+    return true;
+}
+
+/*
+  change the baudrate of the link to the FMU. Called with the link idle
+ */
+void AP_IOMCU_FW::set_baudrate(uint32_t _baudrate)
+{
+    USART_TypeDef *u = HAL_IO_FMU_COMMS.usart;
+    const uint32_t cr1 = u->CR1;
+    u->CR1 = cr1 & ~USART_CR1_UE;
+    u->BRR = (HAL_IO_FMU_COMMS.clock + _baudrate/2) / _baudrate;
+    u->CR1 = cr1;
+    baudrate = _baudrate;
+}
+
 void AP_IOMCU_FW::schedule_reboot(uint32_t time_ms)
 {
     do_reboot = true;
@@ -39,6 +39,9 @@ public:
 
     bool handle_code_write();
     bool handle_code_read();
+    bool handle_direct_pwm();
+    bool fill_batch_reply(uint8_t mask);
+    void set_baudrate(uint32_t baudrate);
     void schedule_reboot(uint32_t time_ms);
 #if AP_IOMCU_PROFILED_SUPPORT_ENABLED
     void profiled_update();
@@ -202,6 +205,12 @@ public:
     uint8_t dsm_bind_state;
     uint32_t last_dsm_bind_ms;
     uint32_t last_failsafe_ms;
+
+    // link baudrate, a new rate is applied once the reply setting it is sent
+    uint32_t baudrate = IOMCU_DEFAULT_BAUDRATE;
+    volatile uint32_t pending_baudrate;
+    uint32_t last_valid_pkts;
+    uint32_t last_valid_pkt_ms;
 };
 
 // GPIO macros
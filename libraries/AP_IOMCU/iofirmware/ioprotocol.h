@@ -13,6 +13,8 @@
 
 // 22 is enough for the rc_input page in one transfer
 #define PKT_MAX_REGS 22
+// batched replies can use the full 6 bit count, see PAGE_BATCH
+#define PKT_MAX_BATCH_REGS 63
 // The number of channels that can be propagated - due to SBUS_OUT is higher than the physical channels
 #define IOMCU_MAX_RC_CHANNELS 16
 // The actual number of output channels
@@ -33,7 +35,7 @@ IOPacket  {
     uint8_t 	crc;
     uint8_t 	page;
     uint8_t 	offset;
-    uint16_t	regs[PKT_MAX_REGS];
+    uint16_t	regs[PKT_MAX_BATCH_REGS];
 
     // get packet size in bytes
     uint8_t get_size(void) const
@@ -81,8 +83,20 @@ enum iopage {
 #if AP_IOMCU_PROFILED_SUPPORT_ENABLED
     PAGE_PROFILED = 208,
 #endif
+    PAGE_BATCH = 209,
 };
 
+/*
+  batched transfers. A read of PAGE_BATCH, or a write of direct PWM
+  values to it, is answered with all of the pages selected by the
+  offset in one reply. Each page is sent whole, in the order of the
+  bits below
+ */
+#define BATCH_RCIN      (1U<<0) // struct page_rc_input
+#define BATCH_STATUS    (1U<<1) // struct page_reg_status
+#define BATCH_SERVOS    (1U<<2) // IOMCU_MAX_RC_CHANNELS servo values
+#define BATCH_ERPM      (1U<<3) // struct page_dshot_erpm
+
 // setup page registers
 #define PAGE_REG_SETUP_FEATURES	0
 #define P_SETUP_FEATURES_SBUS1_OUT	1
@@ -113,12 +127,19 @@ enum iopage {
 #define PAGE_REG_SETUP_RC_PROTOCOLS 23 // uses 2 slots, 23 and 24
 #define PAGE_REG_SETUP_DSHOT_PERIOD 25
 #define PAGE_REG_SETUP_CHANNEL_MASK 27
+#define PAGE_REG_SETUP_BAUDRATE     28 // uses 2 slots, 28 and 29
 
 // config page registers
 #define PAGE_CONFIG_PROTOCOL_VERSION  0
 #define PAGE_CONFIG_PROTOCOL_VERSION2 1
 #define IOMCU_PROTOCOL_VERSION       4
-#define IOMCU_PROTOCOL_VERSION2     10
+#define IOMCU_PROTOCOL_VERSION2     11
+
+// baudrate of the link at boot. A faster rate can be set with
+// PAGE_REG_SETUP_BAUDRATE, and the IOMCU goes back to this rate if it
+// hears nothing valid for IOMCU_BAUDRATE_FALLBACK_MS
+#define IOMCU_DEFAULT_BAUDRATE 1500000
+#define IOMCU_BAUDRATE_FALLBACK_MS 200
 
 // magic value for rebooting to bootloader
 #define REBOOT_BL_MAGIC 14662
@@ -254,3 +275,7 @@ struct __attribute__((packed, aligned(2))) page_profiled {
     uint8_t green;
 };
 #endif
+
+static_assert(sizeof(struct page_rc_input) + sizeof(struct page_reg_status) +
+              IOMCU_MAX_RC_CHANNELS*2 + sizeof(struct page_dshot_erpm) <= PKT_MAX_BATCH_REGS*2,
+              "batched pages must fit in one packet");
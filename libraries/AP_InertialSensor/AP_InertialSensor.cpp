@@ -6,6 +6,8 @@
 
 #include <AP_Common/AP_Common.h>
 #include <AP_HAL/AP_HAL.h>
+#include <AP_Common/AP_BootTrace.h>
+#include <AP_Common/AP_CycleTrace.h>
 #include <AP_HAL/I2CDevice.h>
 #include <AP_HAL/SPIDevice.h>
 #include <AP_HAL/DSP.h>
@@ -962,11 +964,13 @@ AP_InertialSensor::init(uint16_t loop_rate)
 
     if (_gyro_count == 0 && _accel_count == 0) {
         _start_backends();
+        AP_BOOT_TRACE("INS detect");
     }
 
     // calibrate gyros unless gyro calibration has been disabled
     if (gyro_calibration_timing() != GYRO_CAL_NEVER && _gyro_count > 0) {
         init_gyro();
+        AP_BOOT_TRACE("gyro cal");
     }
 
     _sample_period_usec = 1000*1000UL / _loop_rate;
@@ -1120,6 +1124,52 @@ bool AP_InertialSensor::_add_backend(AP_InertialSensor_Backend *backend)
     return true;
 }
 
+#if AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED
+/*
+  record which HAL_INS_DRIVER_LIST entry a hwdef probed backend is
+ */
+AP_InertialSensor_Backend *AP_InertialSensor::_dispatch_tag(AP_InertialSensor_Backend *backend, uint8_t dispatch_id)
+{
+    if (backend != nullptr) {
+        backend->dispatch_id = dispatch_id;
+    }
+    return backend;
+}
+
+/*
+  call update() on a backend, using a direct call when the driver
+  class is known from hwdef. The qualified calls are not virtual so
+  can be inlined
+ */
+void AP_InertialSensor::_update_backend(AP_InertialSensor_Backend &backend)
+{
+    switch (backend.dispatch_id) {
+#define INS_DISPATCH_UPDATE(id, driver) case id: static_cast<AP_InertialSensor_##driver &>(backend).AP_InertialSensor_##driver::update(); return;
+    HAL_INS_DRIVER_LIST(INS_DISPATCH_UPDATE)
+#undef INS_DISPATCH_UPDATE
+    default:
+        break;
+    }
+    backend.update();
+}
+
+/*
+  call accumulate() on a backend, which for most drivers is an empty
+  function that the direct call removes
+ */
+void AP_InertialSensor::_accumulate_backend(AP_InertialSensor_Backend &backend)
+{
+    switch (backend.dispatch_id) {
+#define INS_DISPATCH_ACCUMULATE(id, driver) case id: static_cast<AP_InertialSensor_##driver &>(backend).AP_InertialSensor_##driver::accumulate(); return;
+    HAL_INS_DRIVER_LIST(INS_DISPATCH_ACCUMULATE)
+#undef INS_DISPATCH_ACCUMULATE
+    default:
+        break;
+    }
+    backend.accumulate();
+}
+#endif  // AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED
+
 /*
   detect available backends for this board
  */
@@ -1195,6 +1245,13 @@ AP_InertialSensor::detect_backends(void)
 // macro for use by HAL_INS_PROBE_LIST
 #define GET_I2C_DEVICE(bus, address) hal.i2c_mgr->get_device(bus, address)
 
+// hwdef probes are tagged with their driver for _update_backend()
+#if AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED
+#define INS_DISPATCH_PROBE(dispatch_id, probe) _dispatch_tag(probe, dispatch_id)
+#else
+#define INS_DISPATCH_PROBE(dispatch_id, probe) probe
+#endif
+
 #if AP_EXTERNAL_AHRS_ENABLED
     // if enabled, make the first IMU the external AHRS
     const int8_t serial_port = AP::externalAHRS().get_port(AP_ExternalAHRS::AvailableSensor::IMU);
@@ -1862,6 +1919,8 @@ void AP_InertialSensor::_save_gyro_calibration()
  */
 void AP_InertialSensor::HarmonicNotch::update_params(uint8_t instance, bool converging, float gyro_rate)
 {
+    TRACE_SCOPE(NOTCH_UPDATE);
+
     if (!is_equal(last_bandwidth_hz[instance], params.bandwidth_hz()) ||
         !is_equal(last_attenuation_dB[instance], params.attenuation_dB()) ||
         !is_equal(last_center_freq_hz[instance], params.center_freq_hz()) ||
@@ -1893,6 +1952,8 @@ void AP_InertialSensor::set_primary(uint8_t instance)
  */
 void AP_InertialSensor::update(void)
 {
+    TRACE_SCOPE(INS_UPDATE);
+
     // during initialisation update() may be called without
     // wait_for_sample(), and a wait is implied
     wait_for_sample();
@@ -1907,7 +1968,11 @@ void AP_InertialSensor::update(void)
             _delta_angle_valid[i] = false;
         }
         for (uint8_t i=0; i<_backend_count; i++) {
+#if AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED
+            _update_backend(*_backends[i]);
+#else
             _backends[i]->update();
+#endif
         }
 
         if (!_startup_error_counts_set) {
@@ -1990,6 +2055,11 @@ void AP_InertialSensor::update(void)
         send_uart_data();
     }
 #endif
+#if AP_INERTIALSENSOR_SAMPLE_STREAM_ENABLED
+    if (sample_stream != nullptr) {
+        push_stream_sample();
+    }
+#endif
 }
 
 /*
@@ -2070,7 +2140,11 @@ check_sample:
             for (uint8_t i=0; i<_backend_count; i++) {
                 // this is normally a nop, but can be used by backends
                 // that don't accumulate samples on a timer
+#if AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED
+                _accumulate_backend(*_backends[i]);
+#else
                 _backends[i]->accumulate();
+#endif
             }
 
             for (uint8_t i=0; i<_gyro_count; i++) {
@@ -2788,6 +2862,41 @@ void AP_InertialSensor::send_uart_data(void)
 }
 #endif // AP_SERIALMANAGER_IMUOUT_ENABLED
 
+#if AP_INERTIALSENSOR_SAMPLE_STREAM_ENABLED
+bool AP_InertialSensor::enable_sample_stream(uint16_t depth)
+{
+    if (sample_stream == nullptr) {
+        sample_stream = NEW_NOTHROW ObjectBuffer_TS<StreamSample>(depth);
+    }
+    return sample_stream != nullptr && sample_stream->get_size() != 0;
+}
+
+bool AP_InertialSensor::get_stream_sample(StreamSample &sample)
+{
+    return sample_stream != nullptr && sample_stream->pop(sample);
+}
+
+/*
+  queue the samples used by this update(), stamped with the time the
+  backend read the gyro sample rather than the time of the update, so
+  the consumer sees the sensor timing without main loop jitter
+ */
+void AP_InertialSensor::push_stream_sample()
+{
+    const uint8_t gyro_instance = get_first_usable_gyro();
+    StreamSample sample;
+    sample.sample_us = _gyro_last_sample_us[gyro_instance];
+    if (sample.sample_us == 0) {
+        return;
+    }
+    sample.gyro = get_gyro(gyro_instance);
+    sample.accel = get_accel(get_first_usable_accel());
+    sample.instance = gyro_instance;
+    // keep the newest samples if the consumer falls behind
+    sample_stream->push_force(sample);
+}
+#endif // AP_INERTIALSENSOR_SAMPLE_STREAM_ENABLED
+
 #if AP_EXTERNAL_AHRS_ENABLED
 void AP_InertialSensor::handle_external(const AP_ExternalAHRS::ins_data_message_t &pkt)
 {
@@ -20,6 +20,7 @@
 #include <AP_SerialManager/AP_SerialManager_config.h>
 #include "AP_InertialSensor_Params.h"
 #include "AP_InertialSensor_tempcal.h"
+#include "SampleClock.h"
 
 #ifndef AP_SIM_INS_ENABLED
 #define AP_SIM_INS_ENABLED AP_SIM_ENABLED
@@ -168,7 +169,7 @@ public:
     bool has_fft_notch() const;
 #endif
 #endif
-    uint16_t get_raw_gyro_rate_hz(uint8_t instance) const { return _gyro_raw_sample_rates[_first_usable_gyro]; }
+    uint16_t get_raw_gyro_rate_hz(uint8_t instance) const { return _gyro_raw_sample_rates[instance]; }
     uint16_t get_raw_gyro_rate_hz() const { return get_raw_gyro_rate_hz(_first_usable_gyro); }
     bool set_gyro_window_size(uint16_t size);
     // get accel offsets in m/s/s
@@ -327,6 +328,21 @@ public:
     } uart;
 #endif // AP_SERIALMANAGER_IMUOUT_ENABLED
 
+#if AP_INERTIALSENSOR_SAMPLE_STREAM_ENABLED
+    // a sample of the first usable IMU, queued on each update()
+    struct StreamSample {
+        uint64_t sample_us;     // time the gyro sample was read from the sensor
+        Vector3f gyro;          // filtered gyro, rad/s
+        Vector3f accel;         // filtered accel, m/s/s
+        uint8_t instance;
+    };
+    // start queueing samples for a consumer on another thread, holding
+    // up to depth samples. Returns false if allocation fails
+    bool enable_sample_stream(uint16_t depth);
+    // pop the oldest queued sample, returns false if there are none
+    bool get_stream_sample(StreamSample &sample);
+#endif // AP_INERTIALSENSOR_SAMPLE_STREAM_ENABLED
+
     enum IMU_SENSOR_TYPE {
         IMU_SENSOR_TYPE_ACCEL = 0,
         IMU_SENSOR_TYPE_GYRO = 1,
@@ -485,6 +501,12 @@ private:
     // load backend drivers
     bool _add_backend(AP_InertialSensor_Backend *backend);
     void _start_backends();
+
+#if AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED
+    static AP_InertialSensor_Backend *_dispatch_tag(AP_InertialSensor_Backend *backend, uint8_t dispatch_id);
+    void _update_backend(AP_InertialSensor_Backend &backend) __RAMFUNC__;
+    void _accumulate_backend(AP_InertialSensor_Backend &backend) __RAMFUNC__;
+#endif
     AP_InertialSensor_Backend *_find_backend(int16_t backend_id, uint8_t instance);
 
     // gyro initialisation
@@ -622,11 +644,9 @@ private:
     uint64_t _accel_last_sample_us[INS_MAX_INSTANCES];
     uint64_t _gyro_last_sample_us[INS_MAX_INSTANCES];
 
-    // sample times for checking real sensor rate for FIFO sensors
-    uint16_t _sample_accel_count[INS_MAX_INSTANCES];
-    uint32_t _sample_accel_start_us[INS_MAX_INSTANCES];
-    uint16_t _sample_gyro_count[INS_MAX_INSTANCES];
-    uint32_t _sample_gyro_start_us[INS_MAX_INSTANCES];
+    // sample clock of FIFO sensors against the system clock
+    SampleClock _accel_clock[INS_MAX_INSTANCES];
+    SampleClock _gyro_clock[INS_MAX_INSTANCES];
     
     // temperatures for an instance if available
     float _temperature[INS_MAX_INSTANCES];
@@ -650,11 +670,11 @@ private:
     AP_Int8     _enable_mask;
     
     // board orientation from AHRS
-    enum Rotation _board_orientation;
+    FastRotation _board_orientation;
 
     // per-sensor orientation to allow for board type defaults at runtime
-    enum Rotation _gyro_orientation[INS_MAX_INSTANCES];
-    enum Rotation _accel_orientation[INS_MAX_INSTANCES];
+    FastRotation _gyro_orientation[INS_MAX_INSTANCES];
+    FastRotation _accel_orientation[INS_MAX_INSTANCES];
 
     // calibrated_ok/id_ok flags
     bool _gyro_cal_ok[INS_MAX_INSTANCES];
@@ -805,8 +825,13 @@ private:
     bool raw_logging_option_set(RAW_LOGGING_OPTION option) const {
         return (raw_logging_options.get() & int32_t(option)) != 0;
     }
+#if AP_INERTIALSENSOR_SAMPLE_STREAM_ENABLED
+    ObjectBuffer_TS<StreamSample> *sample_stream;
+    void push_stream_sample();
+#endif
+
     // if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
-    // Support for the fast rate thread in copter
+    // Support for the fast rate thread in AP_Vehicle
     FastRateBuffer* fast_rate_buffer;
     bool fast_rate_buffer_enabled;
 
@@ -815,14 +840,15 @@ public:
     void enable_fast_rate_buffer();
     // disable the fast rate buffer and stop pushing samples to it
     void disable_fast_rate_buffer();
-    // get the next available gyro sample from the fast rate buffer
-    bool get_next_gyro_sample(Vector3f& gyro);
+    // get the next available gyro sample from the fast rate buffer, with the
+    // time it was read from the sensor and the time filtering finished
+    bool get_next_gyro_sample(Vector3f& gyro, uint32_t& sample_us, uint32_t& filtered_us);
     // get the number of available gyro samples in the fast rate buffer
     uint32_t get_num_gyro_samples();
     // set the rate at which samples are collected, unused samples are dropped
     void set_rate_decimation(uint8_t rdec);
-    // push a new gyro sample into the fast rate buffer
-    bool push_next_gyro_sample(const Vector3f& gyro);
+    // push a new filtered gyro sample into the fast rate buffer
+    bool push_next_gyro_sample(const Vector3f& gyro, uint32_t sample_us);
     // run the filter parmeter update code.
     void update_backend_filters();
     // are rate loop samples enabled for this instance?
@@ -7,6 +7,7 @@
 #include "AP_InertialSensor_Backend.h"
 #include <AP_Logger/AP_Logger.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
+#include <AP_Common/AP_CycleTrace.h>
 #if AP_MODULE_SUPPORTED
 #include <AP_Module/AP_Module.h>
 #endif
@@ -30,8 +31,7 @@ AP_InertialSensor_Backend::AP_InertialSensor_Backend(AP_InertialSensor &imu) :
  */
 void AP_InertialSensor_Backend::notify_accel_fifo_reset(uint8_t instance)
 {
-    _imu._sample_accel_count[instance] = 0;
-    _imu._sample_accel_start_us[instance] = 0;    
+    _imu._accel_clock[instance].reset();
 }
 
 /*
@@ -39,8 +39,7 @@ void AP_InertialSensor_Backend::notify_accel_fifo_reset(uint8_t instance)
  */
 void AP_InertialSensor_Backend::notify_gyro_fifo_reset(uint8_t instance)
 {
-    _imu._sample_gyro_count[instance] = 0;
-    _imu._sample_gyro_start_us[instance] = 0;
+    _imu._gyro_clock[instance].reset();
 }
 
 // set the amount of oversamping a accel is doing
@@ -68,37 +67,62 @@ bool AP_InertialSensor_Backend::sensors_converging() const
   update the sensor rate for FIFO sensors
 
   FIFO sensors produce samples at a fixed rate, but the clock in the
-  sensor may vary slightly from the system clock. This slowly adjusts
-  the rate to the observed rate
+  sensor may vary slightly from the system clock. The sample clock
+  regression gives the observed rate, and the rate used is slowly
+  adjusted to it. Returns true when the rate has been updated
 */
-void AP_InertialSensor_Backend::_update_sensor_rate(uint16_t &count, uint32_t &start_us, float &rate_hz) const
+bool AP_InertialSensor_Backend::_update_sensor_rate(SampleClock &clock, uint64_t now_us, float &rate_hz, uint8_t n_samples) const
 {
-    uint32_t now = AP_HAL::micros();
-    if (start_us == 0) {
-        count = 0;
-        start_us = now;
-    } else {
-        count++;
-        if (now - start_us > 1000000UL) {
-            float observed_rate_hz = count * 1.0e6f / (now - start_us);
+    if (!clock.update(now_us, n_samples, rate_hz)) {
+        return false;
+    }
+    float observed_rate_hz = 1.0e6f / clock.period_us();
 #if 0
-            printf("IMU RATE: %.1f should be %.1f\n", observed_rate_hz, rate_hz);
-#endif
-            float filter_constant = 0.98f;
-            float upper_limit = 1.05f;
-            float lower_limit = 0.95f;
-            if (sensors_converging()) {
-                // converge quickly for first 30s, then more slowly
-                filter_constant = 0.8f;
-                upper_limit = 2.0f;
-                lower_limit = 0.5f;
-            }
-            observed_rate_hz = constrain_float(observed_rate_hz, rate_hz*lower_limit, rate_hz*upper_limit);
-            rate_hz = filter_constant * rate_hz + (1-filter_constant) * observed_rate_hz;
-            count = 0;
-            start_us = now;
-        }
+    printf("IMU RATE: %.1f should be %.1f\n", observed_rate_hz, rate_hz);
+#endif
+    float filter_constant = 0.98f;
+    float upper_limit = 1.05f;
+    float lower_limit = 0.95f;
+    if (sensors_converging()) {
+        // converge quickly for first 30s, then more slowly
+        filter_constant = 0.8f;
+        upper_limit = 2.0f;
+        lower_limit = 0.5f;
     }
+    observed_rate_hz = constrain_float(observed_rate_hz, rate_hz*lower_limit, rate_hz*upper_limit);
+    rate_hz = filter_constant * rate_hz + (1-filter_constant) * observed_rate_hz;
+    return true;
+}
+
+/*
+  update the gyro sample clock, returning the estimated time of the
+  latest sample. The estimate follows the sensor clock rather than
+  when the FIFO happened to be read, so it doesn't carry the read
+  jitter into delta angle timing, the fast rate buffer or the FFT
+ */
+uint64_t AP_InertialSensor_Backend::_update_gyro_rate(uint8_t instance, uint8_t n_samples)
+{
+    SampleClock &clock = _imu._gyro_clock[instance];
+    const uint64_t now_us = AP_HAL::micros64();
+    if (_update_sensor_rate(clock, now_us, _imu._gyro_raw_sample_rates[instance], n_samples)) {
+#if HAL_LOGGING_ENABLED
+        Write_ICLK(instance, AP_InertialSensor::IMU_SENSOR_TYPE_GYRO, _imu._gyro_raw_sample_rates[instance], clock);
+#endif
+    }
+    return clock.last_sample_us(now_us);
+}
+
+// update the accel sample clock, see _update_gyro_rate()
+uint64_t AP_InertialSensor_Backend::_update_accel_rate(uint8_t instance, uint8_t n_samples)
+{
+    SampleClock &clock = _imu._accel_clock[instance];
+    const uint64_t now_us = AP_HAL::micros64();
+    if (_update_sensor_rate(clock, now_us, _imu._accel_raw_sample_rates[instance], n_samples)) {
+#if HAL_LOGGING_ENABLED
+        Write_ICLK(instance, AP_InertialSensor::IMU_SENSOR_TYPE_ACCEL, _imu._accel_raw_sample_rates[instance], clock);
+#endif
+    }
+    return clock.last_sample_us(now_us);
 }
 
 void AP_InertialSensor_Backend::_rotate_and_correct_accel(uint8_t instance, Vector3f &accel) 
@@ -110,7 +134,7 @@ void AP_InertialSensor_Backend::_rotate_and_correct_accel(uint8_t instance, Vect
      */
 
     // rotate for sensor orientation
-    accel.rotate(_imu._accel_orientation[instance]);
+    _imu._accel_orientation[instance].rotate(accel);
 
 #if HAL_INS_TEMPERATURE_CAL_ENABLE
     if (_imu.tcal_learning) {
@@ -141,13 +165,13 @@ void AP_InertialSensor_Backend::_rotate_and_correct_accel(uint8_t instance, Vect
     }
 
     // rotate to body frame
-    accel.rotate(_imu._board_orientation);
+    _imu._board_orientation.rotate(accel);
 }
 
 void AP_InertialSensor_Backend::_rotate_and_correct_gyro(uint8_t instance, Vector3f &gyro) 
 {
     // rotate for sensor orientation
-    gyro.rotate(_imu._gyro_orientation[instance]);
+    _imu._gyro_orientation[instance].rotate(gyro);
 
 #if HAL_INS_TEMPERATURE_CAL_ENABLE
     if (_imu.tcal_learning) {
@@ -166,7 +190,7 @@ void AP_InertialSensor_Backend::_rotate_and_correct_gyro(uint8_t instance, Vecto
         gyro -= _imu._gyro_offset(instance);
     }
 
-    gyro.rotate(_imu._board_orientation);
+    _imu._board_orientation.rotate(gyro);
 }
 
 /*
@@ -218,6 +242,8 @@ void AP_InertialSensor_Backend::save_gyro_window(const uint8_t instance, const V
  */
 void AP_InertialSensor_Backend::apply_gyro_filters(const uint8_t instance, const Vector3f &gyro)
 {
+    TRACE_SCOPE(GYRO_FILTER);
+
     uint8_t filter_phase = 0;
     save_gyro_window(instance, gyro, filter_phase++);
 
@@ -266,7 +292,7 @@ void AP_InertialSensor_Backend::apply_gyro_filters(const uint8_t instance, const
 
 #if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
     if (_imu.is_rate_loop_gyro_enabled(instance)) {
-        if (_imu.push_next_gyro_sample(gyro_filtered)) {
+        if (_imu.push_next_gyro_sample(gyro_filtered, _imu._gyro_last_sample_us[instance])) {
             // if we used the value, record it for publication to the front-end
             _imu._gyro_filtered[instance] = gyro_filtered;
         }
@@ -287,8 +313,7 @@ void AP_InertialSensor_Backend::_notify_new_gyro_raw_sample(uint8_t instance,
     }
     float dt;
 
-    _update_sensor_rate(_imu._sample_gyro_count[instance], _imu._sample_gyro_start_us[instance],
-                        _imu._gyro_raw_sample_rates[instance]);
+    const uint64_t clock_us = _update_gyro_rate(instance);
 
     uint64_t last_sample_us = _imu._gyro_last_sample_us[instance];
 
@@ -310,8 +335,8 @@ void AP_InertialSensor_Backend::_notify_new_gyro_raw_sample(uint8_t instance,
         }
 
         dt = 1.0f / _imu._gyro_raw_sample_rates[instance];
-        _imu._gyro_last_sample_us[instance] = AP_HAL::micros64();
-        sample_us = _imu._gyro_last_sample_us[instance];
+        _imu._gyro_last_sample_us[instance] = clock_us;
+        sample_us = clock_us;
     }
 
 #if AP_MODULE_SUPPORTED
@@ -371,6 +396,84 @@ void AP_InertialSensor_Backend::_notify_new_gyro_raw_sample(uint8_t instance,
     update_primary();
 }
 
+/*
+  handle a burst of gyro samples from a FIFO based backend, see
+  _notify_new_gyro_raw_samples() in the header
+ */
+void AP_InertialSensor_Backend::_notify_new_gyro_raw_samples(uint8_t instance, const Vector3f *gyro, uint8_t n)
+{
+    if (n == 0 || has_been_killed(instance)) {
+        return;
+    }
+
+    const uint64_t clock_us = _update_gyro_rate(instance, n);
+
+    // don't accept below 40Hz
+    if (_imu._gyro_raw_sample_rates[instance] < 40) {
+        return;
+    }
+
+    const float dt = 1.0f / _imu._gyro_raw_sample_rates[instance];
+    const uint32_t dt_us = dt * 1.0e6f;
+    const uint64_t last_sample_us = _imu._gyro_last_sample_us[instance];
+    const uint64_t now = AP_HAL::micros64();
+
+    for (uint8_t i = 0; i < n; i++) {
+#if AP_MODULE_SUPPORTED
+        // call gyro_sample hook if any
+        AP_Module::call_hook_gyro_sample(instance, dt, gyro[i]);
+#endif
+        // push gyros if optical flow present
+        if (hal.opticalflow) {
+            hal.opticalflow->push_gyro(gyro[i].x, gyro[i].y, dt);
+        }
+    }
+
+    {
+        WITH_SEMAPHORE(_sem);
+
+        float sample_dt = dt;
+        if (now - last_sample_us > 100000U) {
+            // zero accumulator if sensor was unhealthy for 0.1s, the
+            // first sample of the burst then adds no delta angle
+            _imu._delta_angle_acc[instance].zero();
+            _imu._delta_angle_acc_dt[instance] = 0;
+            _imu._last_raw_gyro[instance] = gyro[0];
+            _imu._last_delta_angle[instance].zero();
+            sample_dt = 0;
+        }
+
+        for (uint8_t i = 0; i < n; i++) {
+            // compute delta angle and coning correction as in
+            // _notify_new_gyro_raw_sample()
+            const Vector3f delta_angle = (gyro[i] + _imu._last_raw_gyro[instance]) * 0.5f * sample_dt;
+            Vector3f delta_coning = (_imu._delta_angle_acc[instance] +
+                                     _imu._last_delta_angle[instance] * (1.0f / 6.0f));
+            delta_coning = delta_coning % delta_angle;
+            delta_coning *= 0.5f;
+
+            _imu._delta_angle_acc[instance] += delta_angle + delta_coning;
+            _imu._delta_angle_acc_dt[instance] += sample_dt;
+
+            _imu._last_delta_angle[instance] = delta_angle;
+            _imu._last_raw_gyro[instance] = gyro[i];
+            _imu._gyro_last_sample_us[instance] = clock_us - (n - 1 - i) * dt_us;
+
+            // apply gyro filters and sample for FFT
+            apply_gyro_filters(instance, gyro[i]);
+
+            // the filtered value is only valid for this sample so the
+            // sample is logged here rather than after the burst
+            log_gyro_raw(instance, _imu._gyro_last_sample_us[instance], gyro[i], _imu._gyro_filtered[instance]);
+            sample_dt = dt;
+        }
+
+        _imu._new_gyro_data[instance] = true;
+    }
+
+    update_primary();
+}
+
 /*
   handle a delta-angle sample from the backend. This assumes FIFO
   style sampling and the sample should not be rotated or corrected for
@@ -385,8 +488,7 @@ void AP_InertialSensor_Backend::_notify_new_delta_angle(uint8_t instance, const
     }
     float dt;
 
-    _update_sensor_rate(_imu._sample_gyro_count[instance], _imu._sample_gyro_start_us[instance],
-                        _imu._gyro_raw_sample_rates[instance]);
+    const uint64_t clock_us = _update_gyro_rate(instance);
 
     uint64_t last_sample_us = _imu._gyro_last_sample_us[instance];
 
@@ -396,8 +498,8 @@ void AP_InertialSensor_Backend::_notify_new_delta_angle(uint8_t instance, const
     }
 
     dt = 1.0f / _imu._gyro_raw_sample_rates[instance];
-    _imu._gyro_last_sample_us[instance] = AP_HAL::micros64();
-    uint64_t sample_us = _imu._gyro_last_sample_us[instance];
+    _imu._gyro_last_sample_us[instance] = clock_us;
+    uint64_t sample_us = clock_us;
 
     Vector3f gyro = dangle / dt;
 
@@ -543,8 +645,7 @@ void AP_InertialSensor_Backend::_notify_new_accel_raw_sample(uint8_t instance,
     }
     float dt;
 
-    _update_sensor_rate(_imu._sample_accel_count[instance], _imu._sample_accel_start_us[instance],
-                        _imu._accel_raw_sample_rates[instance]);
+    const uint64_t clock_us = _update_accel_rate(instance);
 
     uint64_t last_sample_us = _imu._accel_last_sample_us[instance];
 
@@ -566,8 +667,8 @@ void AP_InertialSensor_Backend::_notify_new_accel_raw_sample(uint8_t instance,
         }
 
         dt = 1.0f / _imu._accel_raw_sample_rates[instance];
-        _imu._accel_last_sample_us[instance] = AP_HAL::micros64();
-        sample_us = _imu._accel_last_sample_us[instance];
+        _imu._accel_last_sample_us[instance] = clock_us;
+        sample_us = clock_us;
     }
 
 #if AP_MODULE_SUPPORTED
@@ -616,6 +717,91 @@ void AP_InertialSensor_Backend::_notify_new_accel_raw_sample(uint8_t instance,
 #endif
 }
 
+/*
+  handle a burst of accel samples from a FIFO based backend, see
+  _notify_new_accel_raw_samples() in the header
+ */
+void AP_InertialSensor_Backend::_notify_new_accel_raw_samples(uint8_t instance, const Vector3f *accel, uint8_t n)
+{
+    if (n == 0 || has_been_killed(instance)) {
+        return;
+    }
+
+    const uint64_t clock_us = _update_accel_rate(instance, n);
+
+    // don't accept below 40Hz
+    if (_imu._accel_raw_sample_rates[instance] < 40) {
+        return;
+    }
+
+    const float dt = 1.0f / _imu._accel_raw_sample_rates[instance];
+    const uint32_t dt_us = dt * 1.0e6f;
+    const uint64_t last_sample_us = _imu._accel_last_sample_us[instance];
+    const uint64_t now = AP_HAL::micros64();
+    _imu._accel_last_sample_us[instance] = clock_us;
+
+    for (uint8_t i = 0; i < n; i++) {
+#if AP_MODULE_SUPPORTED
+        // call accel_sample hook if any
+        AP_Module::call_hook_accel_sample(instance, dt, accel[i], false);
+#endif
+        _imu.calc_vibration_and_clipping(instance, accel[i], dt);
+    }
+
+    {
+        WITH_SEMAPHORE(_sem);
+
+        float sample_dt = dt;
+        if (now - last_sample_us > 100000U) {
+            // zero accumulator if sensor was unhealthy for 0.1s
+            _imu._delta_velocity_acc[instance].zero();
+            _imu._delta_velocity_acc_dt[instance] = 0;
+            sample_dt = 0;
+        }
+
+        // the low pass filter runs over chunks of the burst with its
+        // state held in registers
+        uint8_t i = 0;
+        while (i < n) {
+            Vector3f filtered[8];
+            const uint8_t count = MIN(n - i, uint8_t(ARRAY_SIZE(filtered)));
+            _imu._accel_filter[instance].apply_batch(&accel[i], filtered, count);
+            for (uint8_t j = 0; j < count; j++, i++) {
+                _imu._delta_velocity_acc[instance] += accel[i] * sample_dt;
+                _imu._delta_velocity_acc_dt[instance] += sample_dt;
+                sample_dt = dt;
+
+                _imu._accel_filtered[instance] = filtered[j];
+                const bool filter_failed = filtered[j].is_nan() || filtered[j].is_inf();
+                if (filter_failed) {
+                    _imu._accel_filter[instance].reset();
+                }
+
+                _imu.set_accel_peak_hold(instance, _imu._accel_filtered[instance]);
+
+                const uint64_t sample_us = clock_us - (n - 1 - i) * dt_us;
+#if AP_INERTIALSENSOR_BATCHSAMPLER_ENABLED
+                if (!_imu.batchsampler.doing_post_filter_logging()) {
+                    log_accel_raw(instance, sample_us, accel[i]);
+                } else {
+                    log_accel_raw(instance, sample_us, _imu._accel_filtered[instance]);
+                }
+#else
+                log_accel_raw(instance, sample_us, accel[i]);
+#endif
+                if (filter_failed) {
+                    // the rest of the chunk was filtered before the
+                    // reset, restart from the next sample
+                    i++;
+                    break;
+                }
+            }
+        }
+
+        _imu._new_accel_data[instance] = true;
+    }
+}
+
 /*
   handle a delta-velocity sample from the backend. This assumes FIFO style sampling and
   the sample should not be rotated or corrected for offsets
@@ -630,8 +816,7 @@ void AP_InertialSensor_Backend::_notify_new_delta_velocity(uint8_t instance, con
     }
     float dt;
 
-    _update_sensor_rate(_imu._sample_accel_count[instance], _imu._sample_accel_start_us[instance],
-                        _imu._accel_raw_sample_rates[instance]);
+    const uint64_t clock_us = _update_accel_rate(instance);
 
     uint64_t last_sample_us = _imu._accel_last_sample_us[instance];
 
@@ -641,8 +826,8 @@ void AP_InertialSensor_Backend::_notify_new_delta_velocity(uint8_t instance, con
     }
 
     dt = 1.0f / _imu._accel_raw_sample_rates[instance];
-    _imu._accel_last_sample_us[instance] = AP_HAL::micros64();
-    uint64_t sample_us = _imu._accel_last_sample_us[instance];
+    _imu._accel_last_sample_us[instance] = clock_us;
+    uint64_t sample_us = clock_us;
 
     Vector3f accel = dvel / dt;
 
@@ -703,7 +888,7 @@ void AP_InertialSensor_Backend::_notify_new_accel_sensor_rate_sample(uint8_t ins
 
     // get batch sampling in correct orientation
     Vector3f accel = _accel;
-    accel.rotate(_imu._accel_orientation[instance]);
+    _imu._accel_orientation[instance].rotate(accel);
 
     _imu.batchsampler.sample(instance, AP_InertialSensor::IMU_SENSOR_TYPE_ACCEL, AP_HAL::micros64(), accel);
 #endif
@@ -718,7 +903,7 @@ void AP_InertialSensor_Backend::_notify_new_gyro_sensor_rate_sample(uint8_t inst
 
     // get batch sampling in correct orientation
     Vector3f gyro = _gyro;
-    gyro.rotate(_imu._gyro_orientation[instance]);
+    _imu._gyro_orientation[instance].rotate(gyro);
 
     _imu.batchsampler.sample(instance, AP_InertialSensor::IMU_SENSOR_TYPE_GYRO, AP_HAL::micros64(), gyro);
 #endif
@@ -190,6 +190,15 @@ protected:
 
     // alternative interface using delta-angles. Rotation and correction is handled inside this function
     void _notify_new_delta_angle(uint8_t instance, const Vector3f &dangle);
+
+    // batched interface for FIFO based sensors, equivalent to calling
+    // _notify_new_gyro_raw_sample() with sample_us=0 for each of the
+    // n samples, oldest first. The samples must already be rotated
+    // and corrected. The rate estimate and backend semaphore are
+    // handled once per burst and the filters run over the whole
+    // burst, and each sample is timestamped back from the time of
+    // the call at the sensor rate
+    void _notify_new_gyro_raw_samples(uint8_t instance, const Vector3f *gyro, uint8_t n) __RAMFUNC__;
     
     // rotate accel vector, scale, offset and publish
     void _publish_accel(uint8_t instance, const Vector3f &accel) __RAMFUNC__; /* front end */
@@ -204,6 +213,10 @@ protected:
 
     // alternative interface using delta-velocities. Rotation and correction is handled inside this function
     void _notify_new_delta_velocity(uint8_t instance, const Vector3f &dvelocity);
+
+    // batched accel interface for FIFO based sensors, see
+    // _notify_new_gyro_raw_samples()
+    void _notify_new_accel_raw_samples(uint8_t instance, const Vector3f *accel, uint8_t n) __RAMFUNC__;
     
     // set the amount of oversamping a accel is doing
     void _set_accel_oversampling(uint8_t instance, uint8_t n);
@@ -237,8 +250,11 @@ protected:
         _imu._gyro_raw_sampling_multiplier[instance] = mul;
     }
 
-    // update the sensor rate for FIFO sensors
-    void _update_sensor_rate(uint16_t &count, uint32_t &start_us, float &rate_hz) const __RAMFUNC__;
+    // update the sensor rate for FIFO sensors, returning the time of
+    // the latest sample
+    uint64_t _update_gyro_rate(uint8_t instance, uint8_t n_samples=1) __RAMFUNC__;
+    uint64_t _update_accel_rate(uint8_t instance, uint8_t n_samples=1) __RAMFUNC__;
+    bool _update_sensor_rate(SampleClock &clock, uint64_t now_us, float &rate_hz, uint8_t n_samples) const __RAMFUNC__;
 
     // return true if the sensors are still converging and sampling rates could change significantly
     bool sensors_converging() const;
@@ -360,6 +376,12 @@ protected:
     // function which instantiates an instance of the backend sensor
     // driver if the sensor is available
 
+#if AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED
+    // index into HAL_INS_DRIVER_LIST of this backend, zero if it was
+    // not probed from hwdef and must be called through the vtable
+    uint8_t dispatch_id;
+#endif
+
 private:
 
     bool should_log_imu_raw() const ;
@@ -368,6 +390,7 @@ private:
 
     // logging
     void Write_ACC(const uint8_t instance, const uint64_t sample_us, const Vector3f &accel) const __RAMFUNC__; // Write ACC data packet: raw accel data
+    void Write_ICLK(const uint8_t instance, const uint8_t type, const float rate_hz, const SampleClock &clock) const; // Write ICLK data packet: sample clock estimate
 
 protected:
     void Write_GYR(const uint8_t instance, const uint64_t sample_us, const Vector3f &gyro, bool use_sample_timestamp=false) const __RAMFUNC__;  // Write GYR data packet: raw gyro data
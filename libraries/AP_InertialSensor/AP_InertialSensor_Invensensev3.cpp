@@ -208,6 +208,8 @@ AP_InertialSensor_Invensensev3::~AP_InertialSensor_Invensensev3()
     if (fifo_buffer != nullptr) {
         hal.util->free_type(fifo_buffer, INV3_FIFO_BUFFER_LEN * INV3_SAMPLE_SIZE + 1, AP_HAL::Util::MEM_DMA_SAFE);
     }
+    delete[] burst_accel;
+    delete[] burst_gyro;
 }
 
 AP_InertialSensor_Backend *AP_InertialSensor_Invensensev3::probe(AP_InertialSensor &imu,
@@ -390,6 +392,13 @@ void AP_InertialSensor_Invensensev3::start()
         AP_HAL::panic("Invensensev3: Unable to allocate FIFO buffer");
     }
 
+    // converted samples of one FIFO burst
+    burst_accel = NEW_NOTHROW Vector3f[INV3_FIFO_BUFFER_LEN];
+    burst_gyro = NEW_NOTHROW Vector3f[INV3_FIFO_BUFFER_LEN];
+    if (burst_accel == nullptr || burst_gyro == nullptr) {
+        AP_HAL::panic("Invensensev3: Unable to allocate sample buffer");
+    }
+
     // start the timer process to read samples, using the fastest rate avilable
     periodic_handle = dev->register_periodic_callback(backend_period_us, FUNCTOR_BIND_MEMBER(&AP_InertialSensor_Invensensev3::read_fifo, void));
 }
@@ -447,8 +456,10 @@ bool AP_InertialSensor_Invensensev3::accumulate_samples(const FIFOData *data, ui
 #if INV3_ENABLE_FIFO_LOGGING
     const uint64_t tstart = AP_HAL::micros64();
 #endif
-    for (uint8_t i = 0; i < n_samples; i++) {
-        const FIFOData &d = data[i];
+    bool ret = true;
+    uint8_t n = 0;
+    for (; n < n_samples; n++) {
+        const FIFOData &d = data[n];
 
         // we have a header to confirm we don't have FIFO corruption! no more mucking
         // about with the temperature registers
@@ -456,31 +467,32 @@ bool AP_InertialSensor_Invensensev3::accumulate_samples(const FIFOData *data, ui
         // ICM42688 - HEADER_TIMESTAMP_FSYNC bit 2-3 : 10
         if ((d.header & 0xFC) != 0x68) { // ACCEL_EN | GYRO_EN | TMST_FIELD_EN
             // no or bad data
-            return false;
+            ret = false;
+            break;
         }
 
-        Vector3f accel{float(d.accel[0]), float(d.accel[1]), float(d.accel[2])};
-        Vector3f gyro{float(d.gyro[0]), float(d.gyro[1]), float(d.gyro[2])};
-
-        accel *= accel_scale;
-        gyro *= gyro_scale;
+        Vector3f &accel = burst_accel[n];
+        Vector3f &gyro = burst_gyro[n];
+        accel = Vector3f{float(d.accel[0]), float(d.accel[1]), float(d.accel[2])} * accel_scale;
+        gyro = Vector3f{float(d.gyro[0]), float(d.gyro[1]), float(d.gyro[2])} * gyro_scale;
 
 #if INV3_ENABLE_FIFO_LOGGING
-        Write_GYR(gyro_instance, tstart+(i*backend_period_us), gyro, true);
+        Write_GYR(gyro_instance, tstart+(n*backend_period_us), gyro, true);
 #endif
 
         const float temp = d.temperature * temp_sensitivity + temp_zero;
 
-        // these four calls are about 40us
         _rotate_and_correct_accel(accel_instance, accel);
         _rotate_and_correct_gyro(gyro_instance, gyro);
 
-        _notify_new_accel_raw_sample(accel_instance, accel, 0);
-        _notify_new_gyro_raw_sample(gyro_instance, gyro);
-
         temp_filtered = temp_filter.apply(temp);
     }
-    return true;
+
+    // pass the good samples of the burst to the frontend in one go
+    _notify_new_accel_raw_samples(accel_instance, burst_accel, n);
+    _notify_new_gyro_raw_samples(gyro_instance, burst_gyro, n);
+
+    return ret;
 }
 
 #if HAL_INS_HIGHRES_SAMPLE
@@ -508,41 +520,44 @@ bool AP_InertialSensor_Invensensev3::accumulate_highres_samples(const FIFODataHi
 #if INV3_ENABLE_FIFO_LOGGING
     const uint64_t tstart = AP_HAL::micros64();
 #endif
-    for (uint8_t i = 0; i < n_samples; i++) {
-        const FIFODataHighRes &d = data[i];
+    bool ret = true;
+    uint8_t n = 0;
+    for (; n < n_samples; n++) {
+        const FIFODataHighRes &d = data[n];
 
         // we have a header to confirm we don't have FIFO corruption! no more mucking
         // about with the temperature registers
         if ((d.header & 0xFC) != 0x78) { // ACCEL_EN | GYRO_EN | HIRES_EN | TMST_FIELD_EN
             // no or bad data
-            return false;
+            ret = false;
+            break;
         }
 
-        Vector3f accel{uint20_to_float(d.accel[1], d.accel[0], d.ax),
+        Vector3f &accel = burst_accel[n];
+        Vector3f &gyro = burst_gyro[n];
+        accel = Vector3f{uint20_to_float(d.accel[1], d.accel[0], d.ax),
             uint20_to_float(d.accel[3], d.accel[2], d.ay),
-            uint20_to_float(d.accel[5], d.accel[4], d.az)};
-        Vector3f gyro{uint20_to_float(d.gyro[1], d.gyro[0], d.gx),
+            uint20_to_float(d.accel[5], d.accel[4], d.az)} * accel_scale;
+        gyro = Vector3f{uint20_to_float(d.gyro[1], d.gyro[0], d.gx),
             uint20_to_float(d.gyro[3], d.gyro[2], d.gy),
-            uint20_to_float(d.gyro[5], d.gyro[4], d.gz)};
-
-        accel *= accel_scale;
-        gyro *= gyro_scale;
+            uint20_to_float(d.gyro[5], d.gyro[4], d.gz)} * gyro_scale;
 
 #if INV3_ENABLE_FIFO_LOGGING
-        Write_GYR(gyro_instance, tstart+(i*backend_period_us), gyro, true);
+        Write_GYR(gyro_instance, tstart+(n*backend_period_us), gyro, true);
 #endif
         const float temp = d.temperature * temp_sensitivity + temp_zero;
 
-        // these four calls are about 40us
         _rotate_and_correct_accel(accel_instance, accel);
         _rotate_and_correct_gyro(gyro_instance, gyro);
 
-        _notify_new_accel_raw_sample(accel_instance, accel, 0);
-        _notify_new_gyro_raw_sample(gyro_instance, gyro);
-
         temp_filtered = temp_filter.apply(temp);
     }
-    return true;
+
+    // pass the good samples of the burst to the frontend in one go
+    _notify_new_accel_raw_samples(accel_instance, burst_accel, n);
+    _notify_new_gyro_raw_samples(gyro_instance, burst_gyro, n);
+
+    return ret;
 }
 #endif
 
@@ -147,6 +147,10 @@ private:
     // buffer for fifo read
     void* fifo_buffer;
 
+    // converted samples of one fifo read, passed to the frontend as a burst
+    Vector3f *burst_accel;
+    Vector3f *burst_gyro;
+
     float temp_filtered;
     LowPassFilter2pFloat temp_filter;
     uint32_t sampling_rate_hz;
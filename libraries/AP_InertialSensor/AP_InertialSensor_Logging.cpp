@@ -40,6 +40,25 @@ void AP_InertialSensor_Backend::Write_GYR(const uint8_t instance, const uint64_t
         AP::logger().WriteBlock(&pkt, sizeof(pkt));
 }
 
+// Write ICLK data packet: sample clock estimate
+void AP_InertialSensor_Backend::Write_ICLK(const uint8_t instance, const uint8_t type, const float rate_hz, const SampleClock &clock) const
+{
+    AP_Logger *logger = AP_Logger::get_singleton();
+    if (logger == nullptr || !logger->logging_started()) {
+        return;
+    }
+    const struct log_ICLK pkt {
+        LOG_PACKET_HEADER_INIT(LOG_ICLK_MSG),
+        time_us  : AP_HAL::micros64(),
+        instance : instance,
+        type     : type,
+        rate     : rate_hz,
+        drift    : clock.drift_ppm(),
+        jitter   : clock.jitter_us()
+    };
+    logger->WriteBlock(&pkt, sizeof(pkt));
+}
+
 // Write IMU data packet: raw accel/gyro data
 void AP_InertialSensor::Write_IMU_instance(const uint64_t time_us, const uint8_t imu_instance) const
 {
@@ -177,8 +196,8 @@ void AP_InertialSensor::write_notch_log_messages() const
         const float* notches = notch.calculated_notch_freq_hz;
         if (notch.num_calculated_notch_frequencies > 1) {
             // log per motor center frequencies
-            AP::logger().WriteStreaming(
-                "FTN", "TimeUS,I,NDn,NF1,NF2,NF3,NF4,NF5,NF6,NF7,NF8,NF9,NF10,NF11,NF12", "s#-zzzzzzzzzzzz", "F--------------", "QBBffffffffffff",
+            AP::logger().WriteStreamingFields(
+                "FTN", "TimeUS,I,NDn,NF1,NF2,NF3,NF4,NF5,NF6,NF7,NF8,NF9,NF10,NF11,NF12", "s#-zzzzzzzzzzzz", "F--------------",
                 now_us,
                 i,
                 notch.num_calculated_notch_frequencies,
@@ -187,8 +206,8 @@ void AP_InertialSensor::write_notch_log_messages() const
                 notches[8], notches[9], notches[10], notches[11]);
         } else {
             // log single center frequency
-            AP::logger().WriteStreaming(
-                "FTNS", "TimeUS,I,NF", "s#z", "F--", "QBf",
+            AP::logger().WriteStreamingFields(
+                "FTNS", "TimeUS,I,NF", "s#z", "F--",
                 now_us,
                 i,
                 notches[0]);
@@ -51,6 +51,11 @@
 #define AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED AP_INERTIALSENSOR_ENABLED
 #endif
 
+// queue of loop-rate samples for streaming to a companion computer
+#ifndef AP_INERTIALSENSOR_SAMPLE_STREAM_ENABLED
+#define AP_INERTIALSENSOR_SAMPLE_STREAM_ENABLED (AP_INERTIALSENSOR_ENABLED && HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
+
 #ifndef AP_INERTIALSENSOR_ALLOW_NO_SENSORS
 #define AP_INERTIALSENSOR_ALLOW_NO_SENSORS 0
 #endif
@@ -74,6 +79,16 @@
 #define AP_INERTIALSENSOR_BATCHSAMPLER_ENABLED (AP_INERTIALSENSOR_ENABLED && HAL_LOGGING_ENABLED)
 #endif
 
+// update the hwdef IMU backends through a switch on the driver
+// rather than a virtual call
+#ifndef AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED
+#if defined(HAL_INS_DRIVER_LIST)
+#define AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED HAL_STATIC_DISPATCH_ENABLED
+#else
+#define AP_INERTIALSENSOR_STATIC_DISPATCH_ENABLED 0
+#endif
+#endif
+
 #ifndef AP_INERTIALSENSOR_KILL_IMU_ENABLED
 #define AP_INERTIALSENSOR_KILL_IMU_ENABLED 1
 #endif
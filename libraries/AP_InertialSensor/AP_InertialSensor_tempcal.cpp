@@ -209,36 +209,42 @@ Vector3f AP_InertialSensor_TCal::polynomial_eval(float tdiff, const AP_Vector3f
 }
 
 /*
-  correct a single sensor for the current temperature
+  correct a single sensor for the current temperature. The
+  temperature is only updated a few times a second, so the correction
+  is kept until it changes
  */
-void AP_InertialSensor_TCal::correct_sensor(float temperature, float cal_temp, const AP_Vector3f coeff[3], Vector3f &v) const
+void AP_InertialSensor_TCal::correct_sensor(float temperature, float cal_temp, const AP_Vector3f coeff[3], CorrectionCache &cache, Vector3f &v) const
 {
     if (enable != Enable::Enabled) {
         return;
     }
-    temperature = constrain_float(temperature, temp_min, temp_max);
-    cal_temp = constrain_float(cal_temp, temp_min, temp_max);
-
-
-    // get the polynomial correction for the difference between the
-    // current temperature and the mid temperature
-    v -= polynomial_eval(temperature - TEMP_REFERENCE, coeff);
-
-    // we need to add the correction for the temperature
-    // difference between the TREF, which is the reference used for
-    // the calibration process, and the cal_temp, which is the
-    // temperature that the offsets and scale factors was setup for
-    v += polynomial_eval(cal_temp - TEMP_REFERENCE, coeff);
+    if (!cache.valid || !is_equal(temperature, cache.temperature) || !is_equal(cal_temp, cache.cal_temp)) {
+        cache.temperature = temperature;
+        cache.cal_temp = cal_temp;
+
+        temperature = constrain_float(temperature, temp_min, temp_max);
+        cal_temp = constrain_float(cal_temp, temp_min, temp_max);
+
+        // get the polynomial correction for the difference between the
+        // current temperature and the mid temperature, and add the
+        // correction for the temperature difference between the TREF,
+        // which is the reference used for the calibration process, and
+        // the cal_temp, which is the temperature that the offsets and
+        // scale factors was setup for
+        cache.correction = polynomial_eval(cal_temp - TEMP_REFERENCE, coeff) - polynomial_eval(temperature - TEMP_REFERENCE, coeff);
+        cache.valid = true;
+    }
+    v += cache.correction;
 }
 
 void AP_InertialSensor_TCal::correct_accel(float temperature, float cal_temp, Vector3f &accel) const
 {
-    correct_sensor(temperature, cal_temp, accel_coeff, accel);
+    correct_sensor(temperature, cal_temp, accel_coeff, accel_cache, accel);
 }
 
 void AP_InertialSensor_TCal::correct_gyro(float temperature, float cal_temp, Vector3f &gyro) const
 {
-    correct_sensor(temperature, cal_temp, gyro_coeff, gyro);
+    correct_sensor(temperature, cal_temp, gyro_coeff, gyro_cache, gyro);
 }
 
 /*
@@ -449,6 +455,10 @@ bool AP_InertialSensor_TCal::Learn::save_calibration(float temperature)
     }
     tcal.temp_min.set_and_save_ifchanged(start_temp);
     tcal.temp_max.set_and_save_ifchanged(temperature);
+
+    // the cached corrections were for the old coefficients
+    tcal.accel_cache.valid = false;
+    tcal.gyro_cache.valid = false;
     return true;
 }
 
@@ -73,7 +73,18 @@ private:
     Vector3f gyro_tref;
     Learn *learn;
 
-    void correct_sensor(float temperature, float cal_temp, const AP_Vector3f coeff[3], Vector3f &v) const;
+    // correction for the last temperatures seen, so the polynomials are
+    // only evaluated when the temperature changes rather than per sample
+    struct CorrectionCache {
+        float temperature;
+        float cal_temp;
+        Vector3f correction;
+        bool valid;
+    };
+    mutable CorrectionCache accel_cache;
+    mutable CorrectionCache gyro_cache;
+
+    void correct_sensor(float temperature, float cal_temp, const AP_Vector3f coeff[3], CorrectionCache &cache, Vector3f &v) const;
     Vector3f polynomial_eval(float temperature, const AP_Vector3f coeff[3]) const;
 
     // get instance number
@@ -90,17 +90,17 @@ bool AP_InertialSensor::is_dynamic_fifo_enabled(uint8_t instance) const
 }
 
 // get the next available gyro sample from the fast rate buffer
-bool AP_InertialSensor::get_next_gyro_sample(Vector3f& gyro)
+bool AP_InertialSensor::get_next_gyro_sample(Vector3f& gyro, uint32_t& sample_us, uint32_t& filtered_us)
 {
     if (!fast_rate_buffer_enabled || fast_rate_buffer == nullptr) {
         return false;
     }
 
-    return fast_rate_buffer->get_next_gyro_sample(gyro);
+    return fast_rate_buffer->get_next_gyro_sample(gyro, sample_us, filtered_us);
 }
 
 
-bool FastRateBuffer::get_next_gyro_sample(Vector3f& gyro)
+bool FastRateBuffer::get_next_gyro_sample(Vector3f& gyro, uint32_t& sample_us, uint32_t& filtered_us)
 {
     if (!use_rate_loop_gyro_samples()) {
         return false;
@@ -112,7 +112,14 @@ bool FastRateBuffer::get_next_gyro_sample(Vector3f& gyro)
 
     WITH_SEMAPHORE(_mutex);
 
-    return _rate_loop_gyro_window.pop(gyro);
+    GyroSample sample;
+    if (!_rate_loop_gyro_window.pop(sample)) {
+        return false;
+    }
+    gyro = sample.gyro;
+    sample_us = sample.sample_us;
+    filtered_us = sample.filtered_us;
+    return true;
 }
 
 void FastRateBuffer::reset()
@@ -120,7 +127,7 @@ void FastRateBuffer::reset()
     _rate_loop_gyro_window.clear();
 }
 
-bool AP_InertialSensor::push_next_gyro_sample(const Vector3f& gyro)
+bool AP_InertialSensor::push_next_gyro_sample(const Vector3f& gyro, uint32_t sample_us)
 {
     if (!fast_rate_buffer_enabled || fast_rate_buffer == nullptr) {
         return false;
@@ -134,7 +141,12 @@ bool AP_InertialSensor::push_next_gyro_sample(const Vector3f& gyro)
     */
     WITH_SEMAPHORE(fast_rate_buffer->_mutex);
 
-    if (!fast_rate_buffer->_rate_loop_gyro_window.push(gyro)) {
+    const FastRateBuffer::GyroSample sample {
+        gyro : gyro,
+        sample_us : sample_us,
+        filtered_us : AP_HAL::micros(),
+    };
+    if (!fast_rate_buffer->_rate_loop_gyro_window.push(sample)) {
         debug("dropped rate loop sample");
     }
     fast_rate_buffer->rate_decimation_count = 0;
@@ -29,7 +29,7 @@ class FastRateBuffer
 {
     friend class AP_InertialSensor;
 public:
-    bool get_next_gyro_sample(Vector3f& gyro);
+    bool get_next_gyro_sample(Vector3f& gyro, uint32_t& sample_us, uint32_t& filtered_us);
     uint32_t get_num_gyro_samples() { return _rate_loop_gyro_window.available(); }
     void set_rate_decimation(uint8_t rdec) { rate_decimation = rdec; }
     // whether or not to push the current gyro sample
@@ -42,7 +42,12 @@ private:
       binary semaphore for rate loop to use to start a rate loop when
       we hav finished filtering the primary IMU
      */
-    ObjectBuffer<Vector3f> _rate_loop_gyro_window{AP_INERTIAL_SENSOR_RATE_LOOP_BUFFER_SIZE};
+    struct GyroSample {
+        Vector3f gyro;
+        uint32_t sample_us;     // time the sample was read from the sensor
+        uint32_t filtered_us;   // time filtering finished
+    };
+    ObjectBuffer<GyroSample> _rate_loop_gyro_window{AP_INERTIAL_SENSOR_RATE_LOOP_BUFFER_SIZE};
     uint8_t rate_decimation; // 0 means off
     uint8_t rate_decimation_count;
     HAL_BinarySemaphore _notifier;
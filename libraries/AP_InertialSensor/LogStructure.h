@@ -8,7 +8,8 @@
     LOG_IMU_MSG, \
     LOG_ISBH_MSG, \
     LOG_ISBD_MSG, \
-    LOG_VIBE_MSG
+    LOG_VIBE_MSG, \
+    LOG_ICLK_MSG
 
 // @LoggerMessage: ACC
 // @Description: IMU accelerometer data
@@ -129,6 +130,24 @@ struct PACKED log_Vibe {
     uint32_t clipping;
 };
 
+// @LoggerMessage: ICLK
+// @Description: IMU sample clock estimate
+// @Field: TimeUS: Time since system startup
+// @Field: I: sensor instance number
+// @Field: Type: 0 for accelerometer, 1 for gyroscope
+// @Field: Rate: sample rate in use
+// @Field: Drift: sensor clock drift from its nominal rate
+// @Field: Jit: RMS jitter of sample times about the fitted sample clock
+struct PACKED log_ICLK {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t instance;
+    uint8_t type;
+    float rate;
+    float drift;
+    float jitter;
+};
+
 #define LOG_STRUCTURE_FROM_INERTIALSENSOR        \
     { LOG_ACC_MSG, sizeof(log_ACC), \
       "ACC", "QBQfff",        "TimeUS,I,SampleUS,AccX,AccY,AccZ", "s#sooo", "F-F000" , true }, \
@@ -141,4 +160,6 @@ struct PACKED log_Vibe {
     { LOG_ISBH_MSG, sizeof(log_ISBH), \
       "ISBH", "QHBBHHQf", "TimeUS,N,type,instance,mul,smp_cnt,SampleUS,smp_rate", "s-----sz", "F-----F-" },  \
     { LOG_ISBD_MSG, sizeof(log_ISBD), \
-      "ISBD", "QHHaaa", "TimeUS,N,seqno,x,y,z", "s--ooo", "F--???" },
+      "ISBD", "QHHaaa", "TimeUS,N,seqno,x,y,z", "s--ooo", "F--???" }, \
+    { LOG_ICLK_MSG, sizeof(log_ICLK), \
+      "ICLK", "QBBfff", "TimeUS,I,Type,Rate,Drift,Jit", "s#-z-s", "F-000F" , true },
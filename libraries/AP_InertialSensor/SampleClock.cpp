@@ -0,0 +1,108 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SampleClock.h"
+#include <AP_Math/AP_Math.h>
+
+// a gap this long in the data restarts the regression
+#define SAMPLE_CLOCK_GAP_US 100000U
+
+bool SampleClock::update(uint64_t now_us, uint16_t n_samples, float nominal_rate_hz)
+{
+    if (ref_us == 0 || now_us - last_us > SAMPLE_CLOCK_GAP_US || !is_positive(nominal_rate_hz)) {
+        // the first read only gives the reference, the samples in it
+        // were taken at unknown times
+        ref_us = now_us;
+        last_us = now_us;
+        window_us = now_us;
+        count = 0;
+        nominal_period_us = is_positive(nominal_rate_hz) ? 1.0e6f / nominal_rate_hz : 0;
+        mean_x = mean_y = 0;
+        var_x = cov_xy = 0;
+        jitter_sq = 0;
+        n_updates = 0;
+        return false;
+    }
+
+    count += n_samples;
+    const float x = count;
+    const float y = now_us - ref_us;
+
+    if (valid()) {
+        jitter_sq += 0.01f * (sq(y - predict(x)) - jitter_sq);
+    }
+
+    // average equally to start with, then weight by time
+    float alpha = 1.0f / (n_updates + 1);
+    if (n_updates >= min_updates) {
+        alpha = MIN((now_us - last_us) * 1.0e-6f / time_constant_s, alpha);
+    } else {
+        n_updates++;
+    }
+    last_us = now_us;
+
+    const float dx = x - mean_x;
+    const float dy = y - mean_y;
+    mean_x += alpha * dx;
+    mean_y += alpha * dy;
+    var_x = (1 - alpha) * (var_x + alpha * dx * dx);
+    cov_xy = (1 - alpha) * (cov_xy + alpha * dx * dy);
+
+    if (now_us - window_us < 1000000U) {
+        return false;
+    }
+    window_us = now_us;
+
+    // move the reference up to now to keep the values small enough
+    // for float precision
+    if (valid()) {
+        const int32_t shift_us = predict(x);
+        ref_us += shift_us;
+        mean_y -= shift_us;
+    } else {
+        ref_us = now_us;
+        mean_y -= y;
+    }
+    mean_x -= x;
+    count = 0;
+
+    return valid();
+}
+
+uint64_t SampleClock::last_sample_us(uint64_t now_us) const
+{
+    if (!valid()) {
+        return now_us;
+    }
+    const uint64_t t = ref_us + int32_t(predict(count));
+    if (t > now_us) {
+        // the fit runs through the read times, so can't be after now
+        return now_us;
+    }
+    return t;
+}
+
+float SampleClock::drift_ppm(void) const
+{
+    if (!valid() || !is_positive(period_us())) {
+        return 0;
+    }
+    return (nominal_period_us / period_us() - 1) * 1.0e6f;
+}
+
+float SampleClock::jitter_us(void) const
+{
+    return sqrtf(jitter_sq);
+}
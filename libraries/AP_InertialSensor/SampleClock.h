@@ -0,0 +1,81 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <stdint.h>
+
+/*
+  estimate of the sample clock of a FIFO sensor against the system
+  clock.
+
+  Each FIFO read gives the number of samples so far and the time of
+  the read. A linear regression of read time against sample count,
+  exponentially weighted over a few seconds, gives the sample period
+  and a time for each sample that is free of the jitter in when the
+  FIFO happened to be read
+ */
+class SampleClock
+{
+public:
+    // add n_samples read at now_us from a sensor with the given
+    // nominal rate. Returns true about once a second when a new
+    // period estimate is available
+    bool update(uint64_t now_us, uint16_t n_samples, float nominal_rate_hz);
+
+    // forget the history, for a FIFO reset or gap in the data
+    void reset(void) {
+        ref_us = 0;
+    }
+
+    // true once the regression can be used
+    bool valid(void) const {
+        return ref_us != 0 && n_updates >= min_updates && var_x > 0;
+    }
+
+    // estimated sample period in microseconds
+    float period_us(void) const {
+        return cov_xy / var_x;
+    }
+
+    // estimated time of the latest sample, or now_us if not known
+    uint64_t last_sample_us(uint64_t now_us) const;
+
+    // sensor clock error against the nominal rate in parts per million
+    float drift_ppm(void) const;
+
+    // RMS difference between read times and the fit in microseconds
+    float jitter_us(void) const;
+
+private:
+    static constexpr uint8_t min_updates = 16;
+
+    // time the history is weighted over
+    static constexpr float time_constant_s = 4.0f;
+
+    // predicted read time for sample count x, relative to ref_us
+    float predict(float x) const {
+        return mean_y + period_us() * (x - mean_x);
+    }
+
+    uint64_t ref_us;        // system time the regression is relative to
+    uint64_t last_us;       // time of the last update
+    uint64_t window_us;     // start of the current rate window
+    uint32_t count;         // samples since ref_us
+    float nominal_period_us;
+    float mean_x, mean_y;   // weighted means of sample count and time
+    float var_x, cov_xy;    // weighted variance and covariance
+    float jitter_sq;        // weighted mean squared residual
+    uint16_t n_updates;
+};
@@ -202,6 +202,33 @@ void AP_L1_Control::_prevent_indecision(float &Nu)
     }
 }
 
+/*
+  recalculate the leg geometry if the waypoints have changed
+ */
+void AP_L1_Control::_update_leg(const Location &prev_WP, const Location &next_WP)
+{
+    if (_leg.valid && _leg.prev_WP.same_latlon_as(prev_WP) && _leg.next_WP.same_latlon_as(next_WP)) {
+        return;
+    }
+    _leg.prev_WP = prev_WP;
+    _leg.next_WP = next_WP;
+    _leg.lng_scale = Location::longitude_scale((prev_WP.lat + next_WP.lat) / 2);
+    _leg.AB = _leg_offset_NE(next_WP);
+    _leg.length = _leg.AB.length();
+    if (_leg.length >= 1.0e-6f) {
+        _leg.AB_unit = _leg.AB / _leg.length;
+        _leg.bearing = atan2f(_leg.AB_unit.y, _leg.AB_unit.x);
+    }
+    _leg.valid = true;
+}
+
+// NE offset in meters of a location from the start of the current leg
+Vector2f AP_L1_Control::_leg_offset_NE(const Location &loc) const
+{
+    return Vector2f((loc.lat - _leg.prev_WP.lat) * LATLON_TO_M,
+                    Location::diff_longitude(loc.lng, _leg.prev_WP.lng) * LATLON_TO_M * _leg.lng_scale);
+}
+
 // update L1 control for waypoint navigation
 void AP_L1_Control::update_waypoint(const Location &prev_WP, const Location &next_WP, float dist_min)
 {
@@ -235,8 +262,14 @@ void AP_L1_Control::update_waypoint(const Location &prev_WP, const Location &nex
 
     Vector2f _groundspeed_vector = _ahrs.groundspeed_vector();
 
+    _update_leg(prev_WP, next_WP);
+
+    // Calculate the NE position of the aircraft relative to WP A and B
+    const Vector2f A_air = _leg_offset_NE(_current_loc);
+    const Vector2f B_air = A_air - _leg.AB;
+
     // update _target_bearing_cd
-    _target_bearing_cd = _current_loc.get_bearing_to(next_WP);
+    _target_bearing_cd = int32_t(wrap_360_cd(degrees(atan2f(-B_air.y, -B_air.x)) * 100) + 0.5f);
 
     // Calculate groundspeed
     float groundSpeed = _groundspeed_vector.length();
@@ -256,22 +289,21 @@ void AP_L1_Control::update_waypoint(const Location &prev_WP, const Location &nex
     // 0.3183099 = 1/1/pipi
     _L1_dist = MAX(0.3183099f * _L1_damping * _L1_period * groundSpeed, dist_min);
 
-    // Calculate the NE position of WP B relative to WP A
-    Vector2f AB = prev_WP.get_distance_NE(next_WP);
-    float AB_length = AB.length();
+    // Unit vector from WP A to WP B
+    Vector2f AB = _leg.AB_unit;
+    float AB_bearing = _leg.bearing;
+    const float AB_length = _leg.length;
 
     // Check for AB zero length and track directly to the destination
     // if too small
-    if (AB.length() < 1.0e-6f) {
-        AB = _current_loc.get_distance_NE(next_WP);
+    if (AB_length < 1.0e-6f) {
+        AB = -B_air;
         if (AB.length() < 1.0e-6f) {
             AB = Vector2f(cosf(get_yaw()), sinf(get_yaw()));
         }
+        AB.normalize();
+        AB_bearing = atan2f(AB.y, AB.x);
     }
-    AB.normalize();
-
-    // Calculate the NE position of the aircraft relative to WP A
-    const Vector2f A_air = prev_WP.get_distance_NE(_current_loc);
 
     // calculate distance to target track, for reporting
     _crosstrack_error = A_air % AB;
@@ -292,7 +324,6 @@ void AP_L1_Control::update_waypoint(const Location &prev_WP, const Location &nex
     } else if (alongTrackDist > AB_length + groundSpeed*3) {
         // we have passed point B by 3 seconds. Head towards B
         // Calc Nu to fly To WP B
-        const Vector2f B_air = next_WP.get_distance_NE(_current_loc);
         Vector2f B_air_unit = (B_air).normalized(); // Unit vector from WP B to aircraft
         xtrackVel = _groundspeed_vector % (-B_air_unit); // Velocity across line
         ltrackVel = _groundspeed_vector * (-B_air_unit); // Velocity along line
@@ -327,7 +358,7 @@ void AP_L1_Control::update_waypoint(const Location &prev_WP, const Location &nex
         Nu1 += _L1_xtrack_i;
 
         Nu = Nu1 + Nu2;
-        _nav_bearing = wrap_PI(atan2f(AB.y, AB.x) + Nu1);   // bearing (radians) from AC to L1 point
+        _nav_bearing = wrap_PI(AB_bearing + Nu1);   // bearing (radians) from AC to L1 point
     }
 
     _prevent_indecision(Nu);
@@ -132,6 +132,24 @@ private:
         Location center_WP;
     } _last_loiter;
 
+    /*
+      geometry of the current waypoint leg, only recalculated when
+      the waypoints change. Positions near the leg are projected onto
+      a local NE plane about the start of the leg
+     */
+    struct {
+        Location prev_WP;
+        Location next_WP;
+        Vector2f AB;            // NE offset of next_WP from prev_WP, m
+        Vector2f AB_unit;       // unit vector along the leg
+        float length;           // leg length, m
+        float bearing;          // bearing of the leg, radians
+        float lng_scale;        // longitude scale across the leg
+        bool valid;
+    } _leg;
+    void _update_leg(const Location &prev_WP, const Location &next_WP);
+    Vector2f _leg_offset_NE(const Location &loc) const;
+
     bool _reverse = false;
     float get_yaw() const;
     int32_t get_yaw_sensor() const;
@@ -117,7 +117,7 @@ const AP_Param::GroupInfo AP_Logger::var_info[] = {
 
     // @Param: _REPLAY
     // @DisplayName: Enable logging of information needed for Replay
-    // @Description: If LOG_REPLAY is set to 1 then the EKF2 and EKF3 state estimators will log detailed information needed for diagnosing problems with the Kalman filter. LOG_DISARMED must be set to 1 or 2 or else the log will not contain the pre-flight data required for replay testing of the EKF's. It is suggested that you also raise LOG_FILE_BUFSIZE to give more buffer space for logging and use a high quality microSD card to ensure no sensor data is lost.
+    // @Description: If LOG_REPLAY is set to 1 then the EKF2 and EKF3 state estimators will log detailed information needed for diagnosing problems with the Kalman filter. LOG_DISARMED must be set to 1 or 2 or else the log will not contain the pre-flight data required for replay testing of the EKF's. It is suggested that you also raise LOG_FILE_BUFSIZE to give more buffer space for logging and use a high quality microSD card to ensure no sensor data is lost. Setting LOG_COMPRESS to 2 greatly reduces the size of replay logs.
     // @Values: 0:Disabled,1:Enabled
     // @User: Standard
     AP_GROUPINFO("_REPLAY",  3, AP_Logger, _params.log_replay,       0),
@@ -202,6 +202,57 @@ const AP_Param::GroupInfo AP_Logger::var_info[] = {
     // @RebootRequired: True
     AP_GROUPINFO("_MAX_FILES", 12, AP_Logger, _params.max_log_files, MAX_LOG_FILES),
 
+#if AP_LOGGER_COMPRESSION_ENABLED
+    // @Param: _COMPRESS
+    // @DisplayName: Compress file and block logs
+    // @Description: If enabled, messages in file and block logs are stored as the difference from the previous message of the same type, which typically reduces the log size several times. Byte differences work on any message; field differences use the format of each message to store numeric fields as the change in their value and usually compress high rate messages further. Compressed logs must be decompressed with Tools/scripts/decompress_log.py before they can be read by most log analysis tools; Replay reads them directly. The setting takes effect when the next log is started.
+    // @Values: 0:Disabled,1:Byte differences,2:Field differences
+    // @User: Advanced
+    AP_GROUPINFO("_COMPRESS", 13, AP_Logger, _params.compress, 0),
+#endif
+
+#if AP_LOGGER_FILE_PREALLOC_ENABLED
+    // @Param: _FILE_PREALLOC
+    // @DisplayName: Log file preallocation size
+    // @Description: If non-zero, space for log files is reserved this many megabytes at a time, limited by the free space. On Linux boards written data is also streamed to the disk as it arrives instead of being flushed by the operating system in large bursts, which avoids long write stalls on eMMC. On FAT formatted SD cards the space is reserved once as a contiguous area when the log is opened, so writes don't have to update the FAT as the file grows; set this to at least the size of a typical log. The DSF log message records the write rate and the longest and average time taken by writes to the log file. A value of zero disables this.
+    // @Units: MB
+    // @Range: 0 1024
+    // @User: Advanced
+    AP_GROUPINFO("_FILE_PREALLOC", 14, AP_Logger, _params.file_prealloc, 0),
+#endif
+
+#if AP_LOGGER_DECIMATION_ENABLED
+    // @Param: _DECIMATE
+    // @DisplayName: Decimate log messages when the log can't keep up
+    // @Description: If enabled, streaming messages are thinned out evenly when the write buffer of a log backend starts to fill, instead of messages being dropped at random once it is full. High rate messages such as IMU, RATE and PID are decimated first and the most. Each message type keeps a minimum rate, and non-streaming messages are never decimated. The DSF log message records the backpressure level and the number of messages decimated.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("_DECIMATE", 15, AP_Logger, _params.decimate, 1),
+#endif
+
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+    // @Param: _FILE_FILTER
+    // @DisplayName: Messages logged to the file backend
+    // @Description: This selects which messages are logged to the file backend. High rate messages are IMU, RATE, PID, ACC, GYR, MOTB, VIBE and the notch filter messages. Non-streaming messages such as events, errors, mode changes and parameters are always logged. Each backend has its own setting, so for example a summary can be sent over MAVLink while the full log is written to the SD card.
+    // @Values: 0:All messages,1:No high rate messages,2:No streaming messages
+    // @User: Advanced
+    AP_GROUPINFO("_FILE_FILTER", 16, AP_Logger, _params.file_filter, 0),
+
+    // @Param: _MAV_FILTER
+    // @DisplayName: Messages logged to the mavlink backend
+    // @Description: This selects which messages are logged to the mavlink backend. High rate messages are IMU, RATE, PID, ACC, GYR, MOTB, VIBE and the notch filter messages. Non-streaming messages such as events, errors, mode changes and parameters are always logged. Together with LOG_MAV_RATEMAX this can limit the mavlink backend to a low rate summary without reducing the other backends.
+    // @Values: 0:All messages,1:No high rate messages,2:No streaming messages
+    // @User: Advanced
+    AP_GROUPINFO("_MAV_FILTER", 17, AP_Logger, _params.mav_filter, 0),
+
+    // @Param: _BLK_FILTER
+    // @DisplayName: Messages logged to the block backend
+    // @Description: This selects which messages are logged to the block backend. High rate messages are IMU, RATE, PID, ACC, GYR, MOTB, VIBE and the notch filter messages. Non-streaming messages such as events, errors, mode changes and parameters are always logged.
+    // @Values: 0:All messages,1:No high rate messages,2:No streaming messages
+    // @User: Advanced
+    AP_GROUPINFO("_BLK_FILTER", 18, AP_Logger, _params.blk_filter, 0),
+#endif
+
     AP_GROUPEND
 };
 
@@ -724,8 +775,7 @@ void AP_Logger::save_format_Replay(const void *pBuffer)
         f->name = strndup(fmt->name, sizeof(fmt->name));
         f->fmt = strndup(fmt->format, sizeof(fmt->format));
         f->labels = strndup(fmt->labels, sizeof(fmt->labels));
-        f->next = log_write_fmts;
-        log_write_fmts = f;
+        log_write_fmt_add(f, true);
     }
 }
 #endif
@@ -856,6 +906,17 @@ bool AP_Logger::logging_started(void) const {
     return false;
 }
 
+bool AP_Logger::init_thread_staging_buffer(uint16_t size)
+{
+    bool ret = false;
+    for (uint8_t i=0; i< _next_backend; i++) {
+        if (backends[i]->init_thread_staging_buffer(size)) {
+            ret = true;
+        }
+    }
+    return ret;
+}
+
 void AP_Logger::handle_mavlink_msg(GCS_MAVLINK &link, const mavlink_message_t &msg)
 {
     switch (msg.msgid) {
@@ -1040,11 +1101,158 @@ void AP_Logger::WriteV(const char *name, const char *labels, const char *units,
         return;
     }
 
+    if (_next_backend == 0) {
+        return;
+    }
+    if (f->fmt == nullptr) {
+        INTERNAL_ERROR(AP_InternalError::error_t::logger_logwrite_missingfmt);
+        return;
+    }
+
+    // stack-allocate a buffer so we can WriteBlock(); this could be
+    // 255 bytes!
+    uint8_t buffer[f->msg_len];
+    WriteV_pack(buffer, *f, arg_list);
+    for (uint8_t i=0; i<_next_backend; i++) {
+        backends[i]->WritePrioritisedBlock(buffer, f->msg_len, is_critical, is_streaming);
+    }
+}
+
+/*
+  pack the arguments of a Write() into a message. This is done once,
+  and the message is then written to each backend
+ */
+void AP_Logger::WriteV_pack(uint8_t *buffer, const log_write_fmt &f, va_list arg_list) const
+{
+    const char *fmt = f.fmt;
+    uint8_t offset = 0;
+    buffer[offset++] = HEAD_BYTE1;
+    buffer[offset++] = HEAD_BYTE2;
+    buffer[offset++] = f.msg_type;
+    for (uint8_t i=0; i<strlen(fmt); i++) {
+        uint8_t charlen = 0;
+        switch(fmt[i]) {
+        case 'b': {
+            int8_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(int8_t));
+            offset += sizeof(int8_t);
+            break;
+        }
+        case 'h':
+        case 'c': {
+            int16_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(int16_t));
+            offset += sizeof(int16_t);
+            break;
+        }
+        case 'd': {
+            double tmp = va_arg(arg_list, double);
+            memcpy(&buffer[offset], &tmp, sizeof(double));
+            offset += sizeof(double);
+            break;
+        }
+        case 'i':
+        case 'L':
+        case 'e': {
+            int32_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(int32_t));
+            offset += sizeof(int32_t);
+            break;
+        }
+        case 'f': {
+            float tmp = va_arg(arg_list, double);
+            memcpy(&buffer[offset], &tmp, sizeof(float));
+            offset += sizeof(float);
+            break;
+        }
+        case 'g': {
+            Float16_t tmp;
+            tmp.set(va_arg(arg_list, double));;
+            memcpy(&buffer[offset], &tmp, sizeof(tmp));
+            offset += sizeof(tmp);
+            break;
+        }
+        case 'n':
+            charlen = 4;
+            break;
+        case 'M':
+        case 'B': {
+            uint8_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(uint8_t));
+            offset += sizeof(uint8_t);
+            break;
+        }
+        case 'H':
+        case 'C': {
+            uint16_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(uint16_t));
+            offset += sizeof(uint16_t);
+            break;
+        }
+        case 'I':
+        case 'E': {
+            uint32_t tmp = va_arg(arg_list, uint32_t);
+            memcpy(&buffer[offset], &tmp, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+            break;
+        }
+        case 'N':
+            charlen = 16;
+            break;
+        case 'Z':
+            charlen = 64;
+            break;
+        case 'q': {
+            int64_t tmp = va_arg(arg_list, int64_t);
+            memcpy(&buffer[offset], &tmp, sizeof(int64_t));
+            offset += sizeof(int64_t);
+            break;
+        }
+        case 'Q': {
+            uint64_t tmp = va_arg(arg_list, uint64_t);
+            memcpy(&buffer[offset], &tmp, sizeof(uint64_t));
+            offset += sizeof(uint64_t);
+            break;
+        }
+        case 'a': {
+            int16_t *tmp = va_arg(arg_list, int16_t*);
+            const uint8_t bytes = 32*2;
+            memcpy(&buffer[offset], tmp, bytes);
+            offset += bytes;
+            break;
+        }
+        }
+        if (charlen != 0) {
+            char *tmp = va_arg(arg_list, char*);
+            uint8_t len = strnlen(tmp, charlen);
+            memcpy(&buffer[offset], tmp, len);
+            memset(&buffer[offset+len], 0, charlen-len);
+            offset += charlen;
+        }
+    }
+}
+
+/*
+  write a message packed by WriteFields(), filling in its header
+ */
+void AP_Logger::WriteFields_block(const char *name, const char *labels, const char *units, const char *mults, const char *fmt,
+                                  uint8_t *buffer, uint8_t msg_len, bool is_streaming)
+{
+    // as in WriteV, IDs can be re-used in replay
+    const bool direct_comp = APM_BUILD_TYPE(APM_BUILD_Replay);
+    struct log_write_fmt *f = msg_fmt_for_name(name, labels, units, mults, fmt, direct_comp);
+    if (f == nullptr) {
+#if !APM_BUILD_TYPE(APM_BUILD_Replay)
+        INTERNAL_ERROR(AP_InternalError::error_t::logger_mapfailure);
+#endif
+        return;
+    }
+
+    buffer[0] = HEAD_BYTE1;
+    buffer[1] = HEAD_BYTE2;
+    buffer[2] = f->msg_type;
     for (uint8_t i=0; i<_next_backend; i++) {
-        va_list arg_copy;
-        va_copy(arg_copy, arg_list);
-        backends[i]->Write(f->msg_type, arg_copy, is_critical, is_streaming);
-        va_end(arg_copy);
+        backends[i]->WritePrioritisedBlock(buffer, msg_len, false, is_streaming);
     }
 }
 
@@ -1117,11 +1325,45 @@ bool AP_Logger::assert_same_fmt_for_name(const AP_Logger::log_write_fmt *f,
 }
 #endif
 
+/*
+  bucket of log_write_fmt_hash for a name. Names are at most
+  LS_NAME_SIZE characters, so this is cheap
+ */
+uint8_t AP_Logger::log_write_fmt_bucket(const char *name)
+{
+    uint32_t h = 0;
+    for (uint8_t i=0; i<LS_NAME_SIZE && name[i] != 0; i++) {
+        h = h * 31 + uint8_t(name[i]);
+    }
+    return (h ^ (h >> 7)) % LOG_WRITE_FMT_HASH_SIZE;
+}
+
+/*
+  add a format to the list of formats and to the hash
+ */
+void AP_Logger::log_write_fmt_add(struct log_write_fmt *f, bool at_start)
+{
+    if (at_start || (log_write_fmts == nullptr)) {
+        f->next = log_write_fmts;
+        log_write_fmts = f;
+    } else {
+        struct log_write_fmt *list_end = log_write_fmts;
+        while (list_end->next) {
+            list_end=list_end->next;
+        }
+        list_end->next = f;
+    }
+    const uint8_t bucket = log_write_fmt_bucket(f->name);
+    f->hash_next = log_write_fmt_hash[bucket];
+    log_write_fmt_hash[bucket] = f;
+    _num_write_fmts++;
+}
+
 AP_Logger::log_write_fmt *AP_Logger::msg_fmt_for_name(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, const bool direct_comp, const bool copy_strings)
 {
     WITH_SEMAPHORE(log_write_fmts_sem);
     struct log_write_fmt *f;
-    for (f = log_write_fmts; f; f=f->next) {
+    for (f = log_write_fmt_hash[log_write_fmt_bucket(name)]; f; f=f->hash_next) {
         if (!direct_comp) {
             if (f->name == name) { // ptr comparison
                 // already have an ID for this name:
@@ -1201,17 +1443,8 @@ AP_Logger::log_write_fmt *AP_Logger::msg_fmt_for_name(const char *name, const ch
 
     f->msg_len = tmp;
 
-    // add direct_comp formats to start of list, otherwise add to the end, this minimises the number of string comparisons when walking the list in future calls
-    if (direct_comp || (log_write_fmts == nullptr)) {
-        f->next = log_write_fmts;
-        log_write_fmts = f;
-    } else {
-        struct log_write_fmt *list_end = log_write_fmts;
-        while (list_end->next) {
-            list_end=list_end->next;
-        }
-        list_end->next = f;
-    }
+    // add direct_comp formats to start of list, otherwise add to the end
+    log_write_fmt_add(f, direct_comp);
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
     struct log_write_fmt_strings ls_strings = {};
@@ -12,6 +12,7 @@
 #include <AP_Param/AP_Param.h>
 #include <AP_Mission/AP_Mission.h>
 #include <AP_Logger/LogStructure.h>
+#include <AP_Logger/LogFields.h>
 #include <AP_Vehicle/ModeReason.h>
 
 #include <stdint.h>
@@ -190,6 +191,7 @@ class AP_Logger
 {
     friend class AP_Logger_Backend; // for _num_types
     friend class AP_Logger_RateLimiter;
+    friend class AP_Logger_Decimation;
 
 public:
     FUNCTOR_TYPEDEF(vehicle_startup_message_Writer, void);
@@ -294,6 +296,22 @@ public:
     void WriteCritical(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, ...);
     void WriteV(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, va_list arg_list, bool is_critical=false, bool is_streaming=false);
 
+    /*
+      as Write() and WriteStreaming(), but the format is derived from
+      the types of the fields at compile time (see LogFields.h), and
+      the message is packed without parsing a format string. Values
+      must be passed with the exact type of their field, for example
+      a uint8_t instance number rather than an int
+     */
+    template <typename... Fields>
+    void WriteFields(const char *name, const char *labels, const char *units, const char *mults, const Fields&... fields) {
+        WriteFields_pack(name, labels, units, mults, false, fields...);
+    }
+    template <typename... Fields>
+    void WriteStreamingFields(const char *name, const char *labels, const char *units, const char *mults, const Fields&... fields) {
+        WriteFields_pack(name, labels, units, mults, true, fields...);
+    }
+
     void Write_PID(uint8_t msg_type, const class AP_PIDInfo &info);
 
     // returns true if logging of a message should be attempted
@@ -301,6 +319,12 @@ public:
 
     bool logging_started(void) const;
 
+    // give the calling thread its own buffer to stage log messages
+    // in, so its writes do not contend with other threads for the
+    // backend write buffer. Intended for high rate threads, currently
+    // only AP_Logger_File supports this
+    bool init_thread_staging_buffer(uint16_t size = AP_LOGGER_STAGING_BUFFER_SIZE);
+
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
     // currently only AP_Logger_File support this:
     void flush(void);
@@ -349,6 +373,20 @@ public:
         AP_Float blk_ratemax;
         AP_Float disarm_ratemax;
         AP_Int16 max_log_files;
+#if AP_LOGGER_COMPRESSION_ENABLED
+        AP_Int8 compress;
+#endif
+#if AP_LOGGER_FILE_PREALLOC_ENABLED
+        AP_Int16 file_prealloc; // in megabytes
+#endif
+#if AP_LOGGER_DECIMATION_ENABLED
+        AP_Int8 decimate;
+#endif
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+        AP_Int8 file_filter;
+        AP_Int8 mav_filter;
+        AP_Int8 blk_filter;
+#endif
     } _params;
 
     const struct LogStructure *structure(uint16_t num) const;
@@ -392,6 +430,8 @@ public:
     // efficiency of finding message types
     struct log_write_fmt {
         struct log_write_fmt *next;
+        // next format in the same bucket of log_write_fmt_hash
+        struct log_write_fmt *hash_next;
         uint8_t msg_type;
         uint8_t msg_len;
         const char *name;
@@ -401,6 +441,9 @@ public:
         const char *mults;
     } *log_write_fmts;
 
+    // number of formats registered for messages from Write()
+    uint8_t num_write_fmts() const { return _num_write_fmts; }
+
     // return (possibly allocating) a log_write_fmt for a name
     struct log_write_fmt *msg_fmt_for_name(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, const bool direct_comp = false, const bool copy_strings = false);
 
@@ -455,6 +498,14 @@ private:
      */
     HAL_Semaphore log_write_fmts_sem;
 
+    // log_write_fmts hashed on name, so finding the format for a
+    // name doesn't walk the whole list
+    static constexpr uint8_t LOG_WRITE_FMT_HASH_SIZE = 32;
+    struct log_write_fmt *log_write_fmt_hash[LOG_WRITE_FMT_HASH_SIZE];
+    static uint8_t log_write_fmt_bucket(const char *name);
+    void log_write_fmt_add(struct log_write_fmt *f, bool at_start);
+    uint8_t _num_write_fmts;
+
     // return (possibly allocating) a log_write_fmt for a name
     const struct log_write_fmt *log_write_fmt_for_msg_type(uint8_t msg_type) const;
 
@@ -463,6 +514,19 @@ private:
     // return a msg_type which is not currently in use (or -1 if none available)
     int16_t find_free_msg_type() const;
 
+    void WriteV_pack(uint8_t *buffer, const log_write_fmt &f, va_list arg_list) const;
+
+    // support for WriteFields()
+    template <typename... Fields>
+    void WriteFields_pack(const char *name, const char *labels, const char *units, const char *mults, bool is_streaming, const Fields&... fields) {
+        using Format = LogFieldsFormat<Fields...>;
+        uint8_t buffer[Format::length];
+        Format::pack(buffer, fields...);
+        WriteFields_block(name, labels, units, mults, Format::fmt, buffer, sizeof(buffer), is_streaming);
+    }
+    void WriteFields_block(const char *name, const char *labels, const char *units, const char *mults, const char *fmt,
+                           uint8_t *buffer, uint8_t msg_len, bool is_streaming);
+
     // fill LogStructure with information about msg_type
     bool fill_logstructure(struct LogStructure &logstruct, const uint8_t msg_type) const;
 
@@ -14,6 +14,9 @@
 #include <Filter/Filter.h>
 #include "AP_Logger.h"
 #include <AP_IOMCU/AP_IOMCU.h>
+#include <AP_HAL/utility/RingBuffer.h>
+#include "LogCompression.h"
+#include "AP_Logger_Decimation.h"
 
 #if HAL_LOGGER_FENCE_ENABLED
     #include <AC_Fence/AC_Fence.h>
@@ -74,6 +77,14 @@ void AP_Logger_Backend::periodic_1Hz()
         // handle log rotation once we stop logging
         stop_logging_async();
     }
+#if AP_LOGGER_DECIMATION_ENABLED
+    if (decimation == nullptr && _front._params.decimate) {
+        decimation = NEW_NOTHROW AP_Logger_Decimation(_front);
+    }
+    if (decimation != nullptr) {
+        decimation->update_rates();
+    }
+#endif
     df_stats_log();
 }
 
@@ -94,6 +105,11 @@ void AP_Logger_Backend::periodic_tasks()
         _last_periodic_10Hz = now;
     }
     periodic_fullrate();
+#if AP_LOGGER_DECIMATION_ENABLED
+    if (decimation != nullptr) {
+        decimation->set_buffer_used(_front._params.decimate ? buffer_used_percent() : 0);
+    }
+#endif
 }
 
 void AP_Logger_Backend::start_new_log_reset_variables()
@@ -104,6 +120,40 @@ void AP_Logger_Backend::start_new_log_reset_variables()
     _formats_written.clearall();
 }
 
+#if AP_LOGGER_COMPRESSION_ENABLED
+void AP_Logger_Backend::compression_start_log()
+{
+    _compression_active = false;
+    const auto method = AP_Logger_Compression::Method(_front._params.compress.get());
+    if (method != AP_Logger_Compression::Method::BYTES &&
+        method != AP_Logger_Compression::Method::FIELDS) {
+        return;
+    }
+    if (_compression == nullptr) {
+        _compression = NEW_NOTHROW AP_Logger_Compression();
+        if (_compression == nullptr) {
+            return;
+        }
+    }
+    _compression->reset(method);
+    _compression_active = true;
+}
+#endif
+
+uint32_t AP_Logger_Backend::write_message(ByteBuffer &buf, const void *pBuffer, uint16_t size)
+{
+#if AP_LOGGER_COMPRESSION_ENABLED
+    if (_compression_active) {
+        const uint8_t *compressed;
+        const uint16_t n = _compression->compress((const uint8_t *)pBuffer, size, compressed);
+        if (n > 0) {
+            return buf.write(compressed, n);
+        }
+    }
+#endif
+    return buf.write((const uint8_t *)pBuffer, size);
+}
+
 // We may need to make sure data is loggable before starting the
 // EKF; when allow_start_ekf we should be able to log that data
 bool AP_Logger_Backend::allow_start_ekf() const
@@ -194,139 +244,6 @@ bool AP_Logger_Backend::Write_Emit_FMT(uint8_t msg_type)
     return true;
 }
 
-bool AP_Logger_Backend::Write(const uint8_t msg_type, va_list arg_list, bool is_critical, bool is_streaming)
-{
-    // stack-allocate a buffer so we can WriteBlock(); this could be
-    // 255 bytes!  If we were willing to lose the WriteBlock
-    // abstraction we could do WriteBytes() here instead?
-    const char *fmt  = nullptr;
-    uint8_t msg_len;
-    AP_Logger::log_write_fmt *f;
-    for (f = _front.log_write_fmts; f; f=f->next) {
-        if (f->msg_type == msg_type) {
-            fmt = f->fmt;
-            msg_len = f->msg_len;
-            break;
-        }
-    }
-    if (fmt == nullptr) {
-        INTERNAL_ERROR(AP_InternalError::error_t::logger_logwrite_missingfmt);
-        return false;
-    }
-    if (bufferspace_available() < msg_len) {
-        return false;
-    }
-
-    uint8_t buffer[msg_len];
-    uint8_t offset = 0;
-    buffer[offset++] = HEAD_BYTE1;
-    buffer[offset++] = HEAD_BYTE2;
-    buffer[offset++] = msg_type;
-    for (uint8_t i=0; i<strlen(fmt); i++) {
-        uint8_t charlen = 0;
-        switch(fmt[i]) {
-        case 'b': {
-            int8_t tmp = va_arg(arg_list, int);
-            memcpy(&buffer[offset], &tmp, sizeof(int8_t));
-            offset += sizeof(int8_t);
-            break;
-        }
-        case 'h':
-        case 'c': {
-            int16_t tmp = va_arg(arg_list, int);
-            memcpy(&buffer[offset], &tmp, sizeof(int16_t));
-            offset += sizeof(int16_t);
-            break;
-        }
-        case 'd': {
-            double tmp = va_arg(arg_list, double);
-            memcpy(&buffer[offset], &tmp, sizeof(double));
-            offset += sizeof(double);
-            break;
-        }
-        case 'i':
-        case 'L':
-        case 'e': {
-            int32_t tmp = va_arg(arg_list, int);
-            memcpy(&buffer[offset], &tmp, sizeof(int32_t));
-            offset += sizeof(int32_t);
-            break;
-        }
-        case 'f': {
-            float tmp = va_arg(arg_list, double);
-            memcpy(&buffer[offset], &tmp, sizeof(float));
-            offset += sizeof(float);
-            break;
-        }
-        case 'g': {
-            Float16_t tmp;
-            tmp.set(va_arg(arg_list, double));;
-            memcpy(&buffer[offset], &tmp, sizeof(tmp));
-            offset += sizeof(tmp);
-            break;
-        }
-        case 'n':
-            charlen = 4;
-            break;
-        case 'M':
-        case 'B': {
-            uint8_t tmp = va_arg(arg_list, int);
-            memcpy(&buffer[offset], &tmp, sizeof(uint8_t));
-            offset += sizeof(uint8_t);
-            break;
-        }
-        case 'H':
-        case 'C': {
-            uint16_t tmp = va_arg(arg_list, int);
-            memcpy(&buffer[offset], &tmp, sizeof(uint16_t));
-            offset += sizeof(uint16_t);
-            break;
-        }
-        case 'I':
-        case 'E': {
-            uint32_t tmp = va_arg(arg_list, uint32_t);
-            memcpy(&buffer[offset], &tmp, sizeof(uint32_t));
-            offset += sizeof(uint32_t);
-            break;
-        }
-        case 'N':
-            charlen = 16;
-            break;
-        case 'Z':
-            charlen = 64;
-            break;
-        case 'q': {
-            int64_t tmp = va_arg(arg_list, int64_t);
-            memcpy(&buffer[offset], &tmp, sizeof(int64_t));
-            offset += sizeof(int64_t);
-            break;
-        }
-        case 'Q': {
-            uint64_t tmp = va_arg(arg_list, uint64_t);
-            memcpy(&buffer[offset], &tmp, sizeof(uint64_t));
-            offset += sizeof(uint64_t);
-            break;
-        }
-        case 'a': {
-            int16_t *tmp = va_arg(arg_list, int16_t*);
-            const uint8_t bytes = 32*2;
-            memcpy(&buffer[offset], tmp, bytes);
-            offset += bytes;
-            break;
-        }
-        }
-        if (charlen != 0) {
-            char *tmp = va_arg(arg_list, char*);
-            uint8_t len = strnlen(tmp, charlen);
-            memcpy(&buffer[offset], tmp, len);
-            memset(&buffer[offset+len], 0, charlen-len);
-            offset += charlen;
-        }
-    }
-
-    return WritePrioritisedBlock(buffer, msg_len, is_critical, is_streaming);
-}
-
 bool AP_Logger_Backend::StartNewLogOK() const
 {
     if (logging_started()) {
@@ -454,6 +371,12 @@ bool AP_Logger_Backend::WritePrioritisedBlock(const void *pBuffer, uint16_t size
         return false;
     }
 
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+    if (!is_critical && filtered(((const uint8_t *)pBuffer)[2], writev_streaming)) {
+        return false;
+    }
+#endif
+
     if (!is_critical && rate_limiter != nullptr) {
         const uint8_t *msgbuf = (const uint8_t *)pBuffer;
         if (!rate_limiter->should_log(msgbuf[2], writev_streaming)) {
@@ -461,6 +384,15 @@ bool AP_Logger_Backend::WritePrioritisedBlock(const void *pBuffer, uint16_t size
         }
     }
 
+#if AP_LOGGER_DECIMATION_ENABLED
+    if (!is_critical && decimation != nullptr) {
+        const uint8_t *msgbuf = (const uint8_t *)pBuffer;
+        if (!decimation->should_log(msgbuf[2], writev_streaming)) {
+            return false;
+        }
+    }
+#endif
+
     if (!ensure_format_emitted(pBuffer, size)) {
         return false;
     }
@@ -468,6 +400,37 @@ bool AP_Logger_Backend::WritePrioritisedBlock(const void *pBuffer, uint16_t size
     return _WritePrioritisedBlock(pBuffer, size, is_critical);
 }
 
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+bool AP_Logger_Backend::filtered(uint8_t msg_type, bool writev_streaming)
+{
+    const Filter filter = message_filter();
+    if (filter == Filter::ALL) {
+        return false;
+    }
+    MsgClass &c = msg_class[msg_type];
+    if (c == MsgClass::UNKNOWN) {
+        const char *name;
+        uint8_t min_hz;
+        if (!AP_Logger_Decimation::is_streaming(_front, msg_type, writev_streaming, name)) {
+            c = MsgClass::NON_STREAMING;
+        } else if (AP_Logger_Decimation::high_rate_message(name, min_hz)) {
+            c = MsgClass::HIGH_RATE;
+        } else {
+            c = MsgClass::STREAMING;
+        }
+    }
+    switch (filter) {
+    case Filter::ALL:
+        break;
+    case Filter::NO_HIGH_RATE:
+        return c == MsgClass::HIGH_RATE;
+    case Filter::NO_STREAMING:
+        return c != MsgClass::NON_STREAMING;
+    }
+    return false;
+}
+#endif
+
 bool AP_Logger_Backend::ShouldLog(bool is_critical)
 {
     if (!_front.WritesEnabled()) {
@@ -687,6 +650,16 @@ bool AP_Logger_Backend::logging_enabled() const
 
 void AP_Logger_Backend::Write_AP_Logger_Stats_File(const struct df_stats &_stats)
 {
+    const uint32_t dt_ms = AP_HAL::millis() - _stats.start_ms;
+    uint8_t decimation_level = 0;
+    uint32_t decimated_high_rate = 0;
+    uint32_t decimated_normal = 0;
+#if AP_LOGGER_DECIMATION_ENABLED
+    if (decimation != nullptr) {
+        decimation_level = decimation->level();
+        decimation->get_and_clear_counts(decimated_high_rate, decimated_normal);
+    }
+#endif
     const struct log_DSF pkt {
         LOG_PACKET_HEADER_INIT(LOG_DF_FILE_STATS),
         time_us         : AP_HAL::micros64(),
@@ -696,6 +669,13 @@ void AP_Logger_Backend::Write_AP_Logger_Stats_File(const struct df_stats &_stats
         buf_space_min   : _stats.buf_space_min,
         buf_space_max   : _stats.buf_space_max,
         buf_space_avg   : (_stats.blocks) ? (_stats.buf_space_sigma / _stats.blocks) : 0,
+        write_time_max  : _stats.write_time_max,
+        write_time_avg  : (_stats.writes) ? (_stats.write_time_sigma / _stats.writes) : 0,
+        write_rate      : (dt_ms) ? uint32_t(uint64_t(_stats.write_bytes) * 1000U / dt_ms) : 0,
+        decimation_level : decimation_level,
+        decimated_high_rate : decimated_high_rate,
+        decimated_normal : decimated_normal,
+        write_fmts      : _front.num_write_fmts(),
     };
     WriteBlock(&pkt, sizeof(pkt));
 }
@@ -713,9 +693,20 @@ void AP_Logger_Backend::df_stats_gather(const uint16_t bytes_written, uint32_t s
     stats.blocks++;
 }
 
+void AP_Logger_Backend::df_stats_write_time(uint32_t time_us, uint32_t bytes)
+{
+    if (time_us > stats.write_time_max) {
+        stats.write_time_max = time_us;
+    }
+    stats.write_time_sigma += time_us;
+    stats.write_bytes += bytes;
+    stats.writes++;
+}
+
 void AP_Logger_Backend::df_stats_clear() {
     memset(&stats, '\0', sizeof(stats));
     stats.buf_space_min = -1;
+    stats.start_ms = AP_HAL::millis();
 }
 
 void AP_Logger_Backend::df_stats_log() {
@@ -166,7 +166,6 @@ public:
 
     // write a log message out to the log of msg_type type, with
     // values contained in arg_list:
-    bool Write(uint8_t msg_type, va_list arg_list, bool is_critical=false, bool is_streaming=false);
 
     // these methods are used when reporting system status over mavlink
     virtual bool logging_enabled() const;
@@ -184,6 +183,9 @@ public:
 
     virtual void io_timer(void) {}
 
+    // give the calling thread its own buffer to stage messages in
+    virtual bool init_thread_staging_buffer(uint16_t size) { return false; }
+
 protected:
 
     AP_Logger &_front;
@@ -218,6 +220,19 @@ protected:
 
     // must be called when a new log is being started:
     virtual void start_new_log_reset_variables();
+
+#if AP_LOGGER_COMPRESSION_ENABLED
+    // start or stop compression according to LOG_COMPRESS, called
+    // by backends with their write lock held when a new log starts
+    void compression_start_log();
+    // compression state, allocated on first use
+    class AP_Logger_Compression *_compression;
+    // true if the current log is compressed
+    bool _compression_active;
+#endif
+    // write a message to a write buffer, compressed if the current
+    // log is compressed. Returns the number of bytes written
+    uint32_t write_message(class ByteBuffer &buf, const void *pBuffer, uint16_t size);
     // convert between log numbering in storage and normalized numbering
     uint16_t log_num_from_list_entry(const uint16_t list_entry);
 
@@ -247,11 +262,41 @@ protected:
     bool _initialised;
 
     void df_stats_gather(uint16_t bytes_written, uint32_t space_remaining);
+    // record the time taken by a write to the storage
+    void df_stats_write_time(uint32_t time_us, uint32_t bytes);
     void df_stats_log();
     void df_stats_clear();
 
     AP_Logger_RateLimiter *rate_limiter;
 
+#if AP_LOGGER_DECIMATION_ENABLED
+    // percentage of the write buffer in use, used to decide how much
+    // to decimate. Zero for backends with no write buffer
+    virtual uint8_t buffer_used_percent() const { return 0; }
+    class AP_Logger_Decimation *decimation;
+#endif
+
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+    // values of the LOG_*_FILTER parameters
+    enum class Filter : uint8_t {
+        ALL = 0,
+        NO_HIGH_RATE = 1,
+        NO_STREAMING = 2,
+    };
+    // the LOG_*_FILTER parameter of this backend
+    virtual Filter message_filter() const { return Filter::ALL; }
+    // returns true if a message is excluded by message_filter()
+    bool filtered(uint8_t msg_type, bool writev_streaming);
+    enum class MsgClass : uint8_t {
+        UNKNOWN = 0,
+        NON_STREAMING,
+        STREAMING,
+        HIGH_RATE,
+    };
+    // class of each message type, found on first use
+    MsgClass msg_class[256];
+#endif
+
 private:
     // statistics support
     struct df_stats {
@@ -260,6 +305,11 @@ private:
         uint32_t buf_space_min;
         uint32_t buf_space_max;
         uint32_t buf_space_sigma;
+        uint16_t writes;
+        uint32_t write_time_max;
+        uint32_t write_time_sigma;
+        uint32_t write_bytes;
+        uint32_t start_ms;
     };
     struct df_stats stats;
 
@@ -73,6 +73,13 @@ void AP_Logger_Block::Init(void)
     }
 }
 
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+AP_Logger_Backend::Filter AP_Logger_Block::message_filter() const
+{
+    return Filter(_front._params.blk_filter.get());
+}
+#endif
+
 uint32_t AP_Logger_Block::bufferspace_available()
 {
     // because AP_Logger_Block devices are ring buffers, we *always*
@@ -80,6 +87,14 @@ uint32_t AP_Logger_Block::bufferspace_available()
     return df_NumPages * df_PageSize;
 }
 
+#if AP_LOGGER_DECIMATION_ENABLED
+uint8_t AP_Logger_Block::buffer_used_percent() const
+{
+    const uint32_t size = writebuf.get_size();
+    return size ? 100U - uint8_t(uint64_t(writebuf.space()) * 100U / size) : 0;
+}
+#endif
+
 // *** LOGGER PUBLIC FUNCTIONS ***
 void AP_Logger_Block::StartWrite(uint32_t PageAdr)
 {
@@ -164,7 +179,7 @@ bool AP_Logger_Block::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
         return false;
     }
 
-    writebuf.write((uint8_t*)pBuffer, size);
+    write_message(writebuf, pBuffer, size);
     df_stats_gather(size, writebuf.space());
 
     return true;
@@ -588,6 +603,13 @@ void AP_Logger_Block::start_new_log(void)
     }
     writebuf.write((uint8_t*)&hdr, sizeof(FileHeader));
 
+#if AP_LOGGER_COMPRESSION_ENABLED
+    {
+        WITH_SEMAPHORE(write_sem);
+        compression_start_log();
+    }
+#endif
+
     start_new_log_reset_variables();
 
     return;
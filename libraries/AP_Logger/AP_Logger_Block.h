@@ -28,6 +28,12 @@ public:
     uint16_t get_num_logs() override;
     void start_new_log(void) override;
     uint32_t bufferspace_available() override;
+#if AP_LOGGER_DECIMATION_ENABLED
+    uint8_t buffer_used_percent() const override;
+#endif
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+    Filter message_filter() const override;
+#endif
     void stop_logging(void) override;
     void stop_logging_async(void) override;
     bool logging_failed() const override;
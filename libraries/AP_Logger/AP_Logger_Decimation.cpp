@@ -0,0 +1,174 @@
+#include "AP_Logger_Decimation.h"
+
+#if AP_LOGGER_DECIMATION_ENABLED
+
+#include "AP_Logger.h"
+#include <AP_Scheduler/AP_Scheduler.h>
+
+/*
+  streaming messages decimated before all others, with the rate each
+  is kept at or above. A name ending in '*' matches all messages
+  starting with the rest of the name
+ */
+#ifndef AP_LOGGER_DECIMATION_HIGH_RATE
+#define AP_LOGGER_DECIMATION_HIGH_RATE \
+    { "IMU", 25 },                     \
+    { "RATE", 25 },                    \
+    { "PID*", 25 },                    \
+    { "ACC", 25 },                     \
+    { "GYR", 25 },                     \
+    { "MOTB", 10 },                    \
+    { "VIBE", 5 },                     \
+    { "FTN*", 5 },
+#endif
+
+// other streaming messages are kept at or above this rate
+#ifndef AP_LOGGER_DECIMATION_NORMAL_MIN_HZ
+#define AP_LOGGER_DECIMATION_NORMAL_MIN_HZ 10
+#endif
+
+static const struct {
+    const char *name;
+    uint8_t min_hz;
+} high_rate_messages[] = {
+    AP_LOGGER_DECIMATION_HIGH_RATE
+};
+
+// percentage of the write buffer in use to reach each level
+static const uint8_t level_thresholds[] { 50, 65, 80 };
+// the buffer must empty this much below a threshold to drop a level
+#define LEVEL_HYSTERESIS 10
+
+AP_Logger_Decimation::AP_Logger_Decimation(const AP_Logger &_front) :
+    front(_front)
+{
+}
+
+void AP_Logger_Decimation::set_buffer_used(uint8_t percent)
+{
+    static_assert(ARRAY_SIZE(level_thresholds) == MAX_LEVEL, "one threshold per level");
+    uint8_t level = 0;
+    while (level < MAX_LEVEL && percent >= level_thresholds[level]) {
+        level++;
+    }
+    if (level > _level) {
+        _level = level;
+    } else if (_level > 0 && percent + LEVEL_HYSTERESIS < level_thresholds[_level-1]) {
+        _level--;
+    }
+}
+
+bool AP_Logger_Decimation::high_rate_message(const char *name, uint8_t &min_hz)
+{
+    for (const auto &h : high_rate_messages) {
+        const size_t len = strlen(h.name);
+        const bool match = (len > 0 && h.name[len-1] == '*') ?
+            strncmp(name, h.name, len-1) == 0 :
+            strncmp(name, h.name, LS_NAME_SIZE) == 0;
+        if (match) {
+            min_hz = h.min_hz;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AP_Logger_Decimation::is_streaming(const AP_Logger &front, uint8_t msgid, bool writev_streaming, const char *&name)
+{
+    const auto *s = front.structure_for_msg_type(msgid);
+    if (s != nullptr) {
+        name = s->name;
+        return s->streaming;
+    }
+    // messages from Write() are classed by the caller
+    const auto *f = front.log_write_fmt_for_msg_type(msgid);
+    name = (f != nullptr) ? f->name : "";
+    return writev_streaming;
+}
+
+void AP_Logger_Decimation::classify(uint8_t msgid, bool writev_streaming)
+{
+    MsgState &m = msgs[msgid];
+    const char *name;
+    if (!is_streaming(front, msgid, writev_streaming, name)) {
+        m.priority = Priority::CRITICAL;
+        return;
+    }
+    m.min_hz = AP_LOGGER_DECIMATION_NORMAL_MIN_HZ;
+    m.priority = high_rate_message(name, m.min_hz) ? Priority::HIGH_RATE : Priority::NORMAL;
+}
+
+bool AP_Logger_Decimation::should_log(uint8_t msgid, bool writev_streaming)
+{
+    MsgState &m = msgs[msgid];
+    if (m.priority == Priority::UNKNOWN) {
+        classify(msgid, writev_streaming);
+    }
+    if (m.priority == Priority::CRITICAL) {
+        return true;
+    }
+
+#if !defined(HAL_BUILD_AP_PERIPH)
+    // all instances of a multi-instance message in a tick get the
+    // same decision, so the instances stay together
+    const uint16_t sched_ticks = AP::scheduler().ticks();
+    if (sched_ticks == m.last_sched_count) {
+        if (!m.last_return) {
+            if (m.priority == Priority::HIGH_RATE) {
+                decimated_high_rate++;
+            } else {
+                decimated_normal++;
+            }
+        }
+        return m.last_return;
+    }
+    m.last_sched_count = sched_ticks;
+#endif
+    if (m.count < UINT16_MAX) {
+        m.count++;
+    }
+
+    // keep one in every 2^shift messages
+    uint8_t shift = 0;
+    if (m.priority == Priority::HIGH_RATE) {
+        shift = _level;
+    } else if (_level > 1) {
+        shift = _level - 1;
+    }
+    const uint16_t max_divisor = MAX(m.rate_hz / MAX(m.min_hz, 1U), 1U);
+    const uint16_t divisor = MIN(uint16_t(1U << shift), max_divisor);
+    if (divisor <= 1) {
+        m.phase = 0;
+        m.last_return = true;
+        return true;
+    }
+
+    m.last_return = (m.phase == 0);
+    m.phase = (m.phase + 1) % divisor;
+    if (!m.last_return) {
+        if (m.priority == Priority::HIGH_RATE) {
+            decimated_high_rate++;
+        } else {
+            decimated_normal++;
+        }
+    }
+    return m.last_return;
+}
+
+void AP_Logger_Decimation::update_rates()
+{
+    for (auto &m : msgs) {
+        m.rate_hz = m.count;
+        m.count = 0;
+    }
+}
+
+void AP_Logger_Decimation::get_and_clear_counts(uint32_t &high_rate, uint32_t &normal)
+{
+    high_rate = decimated_high_rate;
+    normal = decimated_normal;
+    decimated_high_rate = 0;
+    decimated_normal = 0;
+}
+
+#endif // AP_LOGGER_DECIMATION_ENABLED
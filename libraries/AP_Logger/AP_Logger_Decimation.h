@@ -0,0 +1,85 @@
+/*
+  decimation of streaming log messages when a backend can't keep up
+
+  When the write buffer of a backend fills, messages used to be
+  dropped in whatever order they arrived, leaving random gaps in every
+  message type. Instead, as the buffer fills each streaming message
+  type is thinned out evenly, keeping every Nth message. High rate
+  messages such as IMU and RATE are decimated first and the most, and
+  no type is decimated below its minimum rate. Non-streaming and
+  critical messages are never decimated.
+ */
+#pragma once
+
+#include "AP_Logger_config.h"
+
+#if AP_LOGGER_DECIMATION_ENABLED
+
+#include <stdint.h>
+
+class AP_Logger_Decimation
+{
+public:
+    AP_Logger_Decimation(const class AP_Logger &_front);
+
+    // set the backpressure from the percentage of the write buffer
+    // in use
+    void set_buffer_used(uint8_t percent);
+
+    // return false if a message should be dropped to relieve the
+    // backpressure
+    bool should_log(uint8_t msgid, bool writev_streaming);
+
+    // measure the rate of each message type, called at 1Hz
+    void update_rates();
+
+    // backpressure level from 0 (none) to MAX_LEVEL
+    uint8_t level() const { return _level; }
+
+    // messages decimated in each class since the last call
+    void get_and_clear_counts(uint32_t &high_rate, uint32_t &normal);
+
+    // returns true if a message type is streaming, setting its name
+    static bool is_streaming(const class AP_Logger &front, uint8_t msgid, bool writev_streaming, const char *&name);
+
+    // returns true if a streaming message is one of the high rate
+    // messages decimated first, setting the rate it is kept at or
+    // above
+    static bool high_rate_message(const char *name, uint8_t &min_hz);
+
+private:
+    const class AP_Logger &front;
+
+    enum class Priority : uint8_t {
+        UNKNOWN = 0,
+        CRITICAL,   // never decimated
+        NORMAL,     // decimated under heavy backpressure
+        HIGH_RATE,  // decimated first
+    };
+
+    static constexpr uint8_t MAX_LEVEL = 3;
+
+    struct MsgState {
+        Priority priority;
+        // rate below which this type is not decimated
+        uint8_t min_hz;
+        // position in the decimation cycle
+        uint8_t phase;
+        // this decision is reused for the other instances of a
+        // multi-instance message in the same scheduler tick
+        bool last_return;
+        uint16_t last_sched_count;
+        // messages seen this second and the rate in the last second
+        uint16_t count;
+        uint16_t rate_hz;
+    } msgs[256];
+
+    // find the priority and minimum rate of a message type
+    void classify(uint8_t msgid, bool writev_streaming);
+
+    uint8_t _level;
+    uint32_t decimated_high_rate;
+    uint32_t decimated_normal;
+};
+
+#endif // AP_LOGGER_DECIMATION_ENABLED
@@ -109,6 +109,9 @@ void AP_Logger_File::Init()
             AP::FS().unlink(filename);
             free(filename);
         }
+#if AP_LOGGER_FILE_INDEX_ENABLED
+        index_remove(last_log_num);
+#endif
     }
 
     Prep_MinSpace();
@@ -185,6 +188,13 @@ void AP_Logger_File::periodic_fullrate()
     AP_Logger_Backend::push_log_blocks();
 }
 
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+AP_Logger_Backend::Filter AP_Logger_File::message_filter() const
+{
+    return Filter(_front._params.file_filter.get());
+}
+#endif
+
 uint32_t AP_Logger_File::bufferspace_available()
 {
     const uint32_t space = _writebuf.space();
@@ -193,6 +203,14 @@ uint32_t AP_Logger_File::bufferspace_available()
     return (space > crit) ? space - crit : 0;
 }
 
+#if AP_LOGGER_DECIMATION_ENABLED
+uint8_t AP_Logger_File::buffer_used_percent() const
+{
+    const uint32_t size = _writebuf.get_size();
+    return size ? 100U - uint8_t(uint64_t(_writebuf.space()) * 100U / size) : 0;
+}
+#endif
+
 bool AP_Logger_File::recent_open_error(void) const
 {
     if (_open_error_ms == 0) {
@@ -361,6 +379,9 @@ void AP_Logger_File::Prep_MinSpace()
             } else {
                 free(filename_to_remove);
             }
+#if AP_LOGGER_FILE_INDEX_ENABLED
+            index_remove(log_to_remove);
+#endif
         }
         log_to_remove++;
         if (log_to_remove > _front.get_max_num_logs()) {
@@ -375,9 +396,18 @@ void AP_Logger_File::Prep_MinSpace()
   Note: Caller must free.
  */
 char *AP_Logger_File::_log_file_name(const uint16_t log_num) const
+{
+    return _log_file_name(log_num, "BIN");
+}
+
+/*
+  construct the name of a file belonging to a log, such as its index
+  Note: Caller must free.
+ */
+char *AP_Logger_File::_log_file_name(const uint16_t log_num, const char *ext) const
 {
     char *buf = nullptr;
-    if (asprintf(&buf, "%s/%08u.BIN", _log_directory, (unsigned)log_num) == -1) {
+    if (asprintf(&buf, "%s/%08u.%s", _log_directory, (unsigned)log_num, ext) == -1) {
         return nullptr;
     }
     return buf;
@@ -442,6 +472,24 @@ bool AP_Logger_File::StartNewLogOK() const
 /* Write a block of data at current offset */
 bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical)
 {
+#if AP_LOGGER_FILE_STAGING_ENABLED && !APM_BUILD_TYPE(APM_BUILD_Replay)
+    StagingBuffer *staging = size <= UINT8_MAX ? find_staging_buffer() : nullptr;
+    if (staging != nullptr) {
+        // formats are written directly so they are always ahead of
+        // the messages using them, which may be staged by any thread
+        const uint8_t msg_type = ((const uint8_t *)pBuffer)[2];
+        switch (msg_type) {
+        case LOG_FORMAT_MSG:
+        case LOG_FORMAT_UNITS_MSG:
+        case LOG_UNIT_MSG:
+        case LOG_MULT_MSG:
+            break;
+        default:
+            return write_staged(*staging, pBuffer, size, is_critical);
+        }
+    }
+#endif
+
     WITH_SEMAPHORE(semaphore);
 
 #if APM_BUILD_TYPE(APM_BUILD_Replay)
@@ -482,11 +530,153 @@ bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
         return false;
     }
 
-    _writebuf.write((uint8_t*)pBuffer, size);
+    const uint32_t written = write_message(_writebuf, pBuffer, size);
+#if AP_LOGGER_FILE_INDEX_ENABLED
+    index_message(written);
+#else
+    (void)written;
+#endif
     df_stats_gather(size, _writebuf.space());
     return true;
 }
 
+#if AP_LOGGER_FILE_STAGING_ENABLED
+/*
+  allocate a staging buffer for the calling thread
+ */
+bool AP_Logger_File::init_thread_staging_buffer(uint16_t size)
+{
+    const void *thread = hal.scheduler->current_thread_id();
+    if (thread == nullptr) {
+        return false;
+    }
+
+    WITH_SEMAPHORE(semaphore);
+
+    const uint8_t num_staging = _num_staging;
+    for (uint8_t i=0; i<num_staging; i++) {
+        if (_staging[i].thread == thread) {
+            return true;
+        }
+    }
+    if (num_staging >= ARRAY_SIZE(_staging)) {
+        return false;
+    }
+    ByteBuffer *buf = NEW_NOTHROW ByteBuffer(size);
+    if (buf == nullptr || buf->get_size() != size) {
+        delete buf;
+        return false;
+    }
+    _staging[num_staging].thread = thread;
+    _staging[num_staging].buf = buf;
+    _num_staging = num_staging + 1;
+    return true;
+}
+
+/*
+  find the staging buffer of the calling thread, if it has one. This
+  does not take the semaphore
+ */
+AP_Logger_File::StagingBuffer *AP_Logger_File::find_staging_buffer() const
+{
+    const uint8_t num_staging = _num_staging;
+    if (num_staging == 0) {
+        return nullptr;
+    }
+    const void *thread = hal.scheduler->current_thread_id();
+    for (uint8_t i=0; i<num_staging; i++) {
+        if (_staging[i].thread == thread) {
+            return const_cast<StagingBuffer *>(&_staging[i]);
+        }
+    }
+    return nullptr;
+}
+
+/*
+  write a message to a staging buffer from its own thread. Each
+  message is preceded by its length, and is only drained by the IO
+  thread once it is complete
+ */
+bool AP_Logger_File::write_staged(StagingBuffer &staging, const void *pBuffer, uint16_t size, bool is_critical)
+{
+    ByteBuffer &buf = *staging.buf;
+    const uint32_t space = buf.space();
+
+    // we reserve some amount of space for critical messages:
+    if ((!is_critical && space < critical_message_reserved_space(buf.get_size())) ||
+        space < 1U + size) {
+        staging.dropped++;
+        return false;
+    }
+
+    const uint8_t len = size;
+    buf.write(&len, sizeof(len));
+    buf.write((const uint8_t*)pBuffer, size);
+    return true;
+}
+
+/*
+  move staged messages into the write buffer, called from the IO thread
+ */
+void AP_Logger_File::drain_staging_buffers()
+{
+    const uint8_t num_staging = _num_staging;
+    if (num_staging == 0) {
+        return;
+    }
+
+    WITH_SEMAPHORE(semaphore);
+
+    for (uint8_t i=0; i<num_staging; i++) {
+        StagingBuffer &staging = _staging[i];
+        const uint32_t dropped = staging.dropped;
+        _dropped += dropped - staging.dropped_reported;
+        staging.dropped_reported = dropped;
+
+        // messages are moved whole, so they are never interleaved
+        // with messages from other threads
+        ByteBuffer &buf = *staging.buf;
+        uint8_t len;
+        while (buf.peekbytes(&len, sizeof(len)) == sizeof(len) &&
+               buf.available() >= 1U + len &&
+               _writebuf.space() >= len) {
+            buf.advance(sizeof(len));
+            if (buf.read(_staged_msg, len) != len) {
+                break;
+            }
+            const uint32_t written = write_message(_writebuf, _staged_msg, len);
+#if AP_LOGGER_FILE_INDEX_ENABLED
+            index_message(written);
+#else
+            (void)written;
+#endif
+            df_stats_gather(len, _writebuf.space());
+        }
+    }
+}
+
+/*
+  throw away staged messages that were intended for the previous
+  log. The owning thread may be part way through writing a message,
+  so only complete messages are removed
+ */
+void AP_Logger_File::discard_staging_buffers()
+{
+    const uint8_t num_staging = _num_staging;
+
+    WITH_SEMAPHORE(semaphore);
+
+    for (uint8_t i=0; i<num_staging; i++) {
+        ByteBuffer &buf = *_staging[i].buf;
+        uint8_t len;
+        while (buf.peekbytes(&len, sizeof(len)) == sizeof(len) &&
+               buf.available() >= 1U + len) {
+            buf.advance(1U + len);
+        }
+    }
+}
+#endif // AP_LOGGER_FILE_STAGING_ENABLED
+
 /*
   find the highest log number
  */
@@ -718,6 +908,9 @@ void AP_Logger_File::stop_logging(void)
         _write_fd = -1;
         AP::FS().close(fd);
     }
+#if AP_LOGGER_FILE_INDEX_ENABLED
+    index_close();
+#endif
     if (have_sem) {
         write_fd_semaphore.give();
     }
@@ -845,7 +1038,24 @@ void AP_Logger_File::start_new_log(void)
     _last_write_ms = AP_HAL::millis();
     _open_error_ms = 0;
     _write_offset = 0;
+#if AP_LOGGER_FILE_PREALLOC_ENABLED
+    _preallocated = 0;
+    _writeback_offset = 0;
+    _preallocate_stopped = false;
+#endif
     _writebuf.clear();
+#if AP_LOGGER_FILE_STAGING_ENABLED
+    discard_staging_buffers();
+#endif
+#if AP_LOGGER_COMPRESSION_ENABLED
+    {
+        WITH_SEMAPHORE(semaphore);
+        compression_start_log();
+    }
+#endif
+#if AP_LOGGER_FILE_INDEX_ENABLED
+    index_open(log_num);
+#endif
     write_fd_semaphore.give();
 
     // now update lastlog.txt with the new log number
@@ -934,6 +1144,10 @@ void AP_Logger_File::io_timer(void)
         write_lastlog_file(log_num);
     }
 
+#if AP_LOGGER_FILE_STAGING_ENABLED
+    drain_staging_buffers();
+#endif
+
     uint32_t nbytes = _writebuf.available();
     if (nbytes == 0) {
         return;
@@ -987,11 +1201,17 @@ void AP_Logger_File::io_timer(void)
         return;
     }
 
+    const uint32_t write_start_us = AP_HAL::micros();
+#if AP_LOGGER_FILE_PREALLOC_ENABLED
+    preallocate_ahead();
+#endif
+
     uint32_t bytes_until_fsync = AP::FS().bytes_until_fsync(_write_fd);
     if (bytes_until_fsync > 0 && nbytes > bytes_until_fsync) {
         nbytes = bytes_until_fsync; // write exactly enough to sync
     }
 
+    last_io_operation = "write";
     ssize_t nwritten = AP::FS().write(_write_fd, head, nbytes);
     last_io_operation = "";
     if (nwritten <= 0) {
@@ -1023,6 +1243,12 @@ void AP_Logger_File::io_timer(void)
             AP::FS().fsync(_write_fd);
             last_io_operation = "";
         }
+#if AP_LOGGER_FILE_PREALLOC_ENABLED
+        writeback_written();
+#endif
+#if AP_LOGGER_FILE_INDEX_ENABLED
+        index_write();
+#endif
 
 #if AP_RTC_ENABLED && CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
         // ChibiOS does not update mtime on writes, so if we opened
@@ -1036,10 +1262,173 @@ void AP_Logger_File::io_timer(void)
         }
 #endif
     }
+    df_stats_write_time(AP_HAL::micros() - write_start_us, MAX(nwritten, 0));
 
     write_fd_semaphore.give();
 }
 
+#if AP_LOGGER_FILE_PREALLOC_ENABLED
+// writeback is started each time this many bytes have been written
+#define LOGGER_WRITEBACK_SIZE (256*1024UL)
+
+/*
+  keep at least half of LOG_FILE_PREALLOC reserved ahead of the write
+  offset, so the filesystem allocates large contiguous extents rather
+  than a few blocks on each write. Filesystems that can only
+  preallocate an empty file get a single allocation when it is opened
+ */
+void AP_Logger_File::preallocate_ahead()
+{
+    uint32_t prealloc = uint32_t(MAX(_front._params.file_prealloc.get(), 0)) * 1024U * 1024U;
+    if (prealloc == 0 || _preallocate_stopped ||
+        _write_offset + prealloc/2 < _preallocated) {
+        return;
+    }
+    // leave the space that stops logging free
+    last_io_operation = "disk_space_avail";
+    const int64_t avail = disk_space_avail() - _free_space_min_avail;
+    if (avail < int64_t(prealloc)) {
+        prealloc = MAX(avail, 0);
+    }
+    const uint32_t size = _write_offset + prealloc;
+    if (prealloc == 0 || size < _write_offset) {
+        // disk nearly full, or past 4GB
+        _preallocate_stopped = true;
+        last_io_operation = "";
+        return;
+    }
+    last_io_operation = "preallocate";
+    if (AP::FS().preallocate(_write_fd, size)) {
+        _preallocated = size;
+    } else {
+        // not supported, or the filesystem can't extend an existing
+        // allocation. Don't try again for this file
+        _preallocate_stopped = true;
+    }
+    last_io_operation = "";
+}
+
+/*
+  start writing data to the disk as it is written, so the kernel
+  never has a large amount of dirty log data to flush at once
+ */
+void AP_Logger_File::writeback_written()
+{
+    if (_front._params.file_prealloc <= 0 ||
+        _write_offset - _writeback_offset < LOGGER_WRITEBACK_SIZE) {
+        return;
+    }
+    last_io_operation = "writeback";
+    AP::FS().writeback(_write_fd, _writeback_offset, _write_offset - _writeback_offset);
+    last_io_operation = "";
+    _writeback_offset = _write_offset;
+}
+#endif // AP_LOGGER_FILE_PREALLOC_ENABLED
+
+#if AP_LOGGER_FILE_INDEX_ENABLED
+#define LOGGER_INDEX_VERSION 1
+#ifndef LOGGER_INDEX_INTERVAL_MS
+#define LOGGER_INDEX_INTERVAL_MS 1000
+#endif
+
+/*
+  start the index of a new log, called with write_fd_semaphore held
+  once the log is open
+ */
+void AP_Logger_File::index_open(uint16_t log_num)
+{
+    {
+        WITH_SEMAPHORE(semaphore);
+        // anything already queued is at the start of the new log
+        _queued_offset = _writebuf.available();
+        _index_last_ms = 0;
+        _index_num_pending = 0;
+    }
+
+    char *fname = _log_file_name(log_num, "IDX");
+    if (fname == nullptr) {
+        return;
+    }
+    const int fd = AP::FS().open(fname, O_WRONLY|O_CREAT|O_TRUNC);
+    free(fname);
+    if (fd == -1) {
+        // the log is still written without an index
+        return;
+    }
+    const IndexHeader header {
+        { 'L', 'I', 'D', 'X' },
+        LOGGER_INDEX_VERSION,
+        sizeof(IndexEntry),
+        LOGGER_INDEX_INTERVAL_MS,
+    };
+    if (AP::FS().write(fd, &header, sizeof(header)) != sizeof(header)) {
+        AP::FS().close(fd);
+        return;
+    }
+    _index_fd = fd;
+}
+
+void AP_Logger_File::index_close()
+{
+    if (_index_fd != -1) {
+        AP::FS().close(_index_fd);
+        _index_fd = -1;
+    }
+}
+
+void AP_Logger_File::index_remove(uint16_t log_num)
+{
+    char *fname = _log_file_name(log_num, "IDX");
+    if (fname != nullptr) {
+        AP::FS().unlink(fname);
+        free(fname);
+    }
+}
+
+void AP_Logger_File::index_message(uint32_t size)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    if (_index_fd != -1 && size > 0 &&
+        now_ms - _index_last_ms >= LOGGER_INDEX_INTERVAL_MS &&
+        _startup_messagewriter->finished()) {
+        // if the index can't keep up it gets a gap rather than
+        // holding up the log
+        if (_index_num_pending < ARRAY_SIZE(_index_pending)) {
+            _index_pending[_index_num_pending++] = { AP_HAL::micros64(), _queued_offset };
+        }
+        _index_last_ms = now_ms;
+    }
+    _queued_offset += size;
+}
+
+void AP_Logger_File::index_write()
+{
+    IndexEntry entries[ARRAY_SIZE(_index_pending)];
+    uint8_t n = 0;
+    {
+        WITH_SEMAPHORE(semaphore);
+        // an entry is only written once the data it points at is
+        // in the log
+        while (n < _index_num_pending && _index_pending[n].offset < _write_offset) {
+            entries[n] = _index_pending[n];
+            n++;
+        }
+        _index_num_pending -= n;
+        memmove(&_index_pending[0], &_index_pending[n], _index_num_pending * sizeof(IndexEntry));
+    }
+    if (n == 0 || _index_fd == -1) {
+        return;
+    }
+    last_io_operation = "index";
+    const ssize_t len = n * sizeof(IndexEntry);
+    if (AP::FS().write(_index_fd, entries, len) != len) {
+        // stop indexing rather than risk a partial entry
+        index_close();
+    }
+    last_io_operation = "";
+}
+#endif // AP_LOGGER_FILE_INDEX_ENABLED
+
 bool AP_Logger_File::io_thread_alive() const
 {
     if (!hal.scheduler->is_system_initialized()) {
@@ -1097,6 +1486,9 @@ void AP_Logger_File::erase_next(void)
 
     AP::FS().unlink(fname);
     free(fname);
+#if AP_LOGGER_FILE_INDEX_ENABLED
+    index_remove(erase.log_num);
+#endif
 
     erase.log_num++;
     if (erase.log_num <= _front.get_max_num_logs()) {
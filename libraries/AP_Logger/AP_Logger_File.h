@@ -43,6 +43,12 @@ public:
     /* Write a block of data at current offset */
     bool _WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical) override;
     uint32_t bufferspace_available() override;
+#if AP_LOGGER_DECIMATION_ENABLED
+    uint8_t buffer_used_percent() const override;
+#endif
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+    Filter message_filter() const override;
+#endif
 
     // high level interface
     uint16_t find_last_log() override;
@@ -66,6 +72,10 @@ public:
     bool logging_started(void) const override { return _write_fd != -1; }
     void io_timer(void) override;
 
+#if AP_LOGGER_FILE_STAGING_ENABLED
+    bool init_thread_staging_buffer(uint16_t size) override;
+#endif
+
 protected:
 
     bool WritesOK() const override;
@@ -85,6 +95,18 @@ private:
     uint16_t _read_fd_log_num;
     uint32_t _read_offset;
     uint32_t _write_offset;
+#if AP_LOGGER_FILE_PREALLOC_ENABLED
+    // reserve space ahead of the write offset and stream written data
+    // to the disk, called with write_fd_semaphore held
+    void preallocate_ahead();
+    void writeback_written();
+    // bytes reserved in the current file
+    uint32_t _preallocated;
+    // offset up to which writeback has been started
+    uint32_t _writeback_offset;
+    // the filesystem can't extend the preallocation
+    bool _preallocate_stopped;
+#endif
     volatile uint32_t _open_error_ms;
     const char *_log_directory;
     bool _last_write_failed;
@@ -111,11 +133,32 @@ private:
 
     // write buffer
     ByteBuffer _writebuf{0};
+
+#if AP_LOGGER_FILE_STAGING_ENABLED
+    // per-thread staging buffers. Each buffer is only written by its
+    // own thread without taking the semaphore, and only read by
+    // drain_staging_buffers() with the semaphore held
+    struct StagingBuffer {
+        const void *thread;
+        ByteBuffer *buf;
+        uint32_t dropped;
+        uint32_t dropped_reported;
+    } _staging[AP_LOGGER_STAGING_MAX_THREADS];
+    // entries are only added, and are complete before the count includes them
+    std::atomic<uint8_t> _num_staging{0};
+    // workspace for a message being drained
+    uint8_t _staged_msg[UINT8_MAX];
+    StagingBuffer *find_staging_buffer() const;
+    bool write_staged(StagingBuffer &staging, const void *pBuffer, uint16_t size, bool is_critical);
+    void drain_staging_buffers();
+    void discard_staging_buffers();
+#endif
     const uint16_t _writebuf_chunk = HAL_LOGGER_WRITE_CHUNK_SIZE;
     uint32_t _last_write_time;
 
     /* construct a file name given a log number. Caller must free. */
     char *_log_file_name(const uint16_t log_num) const;
+    char *_log_file_name(const uint16_t log_num, const char *ext) const;
     char *_lastlog_file_name() const;
     uint32_t _get_log_size(const uint16_t log_num);
     uint32_t _get_log_time(const uint16_t log_num);
@@ -156,6 +199,45 @@ private:
     const char *last_io_operation = "";
 
     bool start_new_log_pending;
+
+#if AP_LOGGER_FILE_INDEX_ENABLED
+    /*
+      time index of the log, written to NNNNNNNN.IDX next to the log.
+      The file is a header followed by one entry each
+      LOGGER_INDEX_INTERVAL_MS. Each entry gives the offset in the
+      log of the first message queued at or after its time. The
+      first entry is made once the startup messages have been
+      written, so the log up to its offset holds the formats. A GCS
+      can read the index over MAVLink FTP and then fetch just that
+      start of the log and the range of offsets it wants.
+     */
+    struct PACKED IndexHeader {
+        char magic[4];      // "LIDX"
+        uint8_t version;
+        uint8_t entry_size;
+        uint16_t interval_ms;
+    };
+    struct PACKED IndexEntry {
+        uint64_t time_us;   // AP_HAL::micros64(), as in TimeUS fields
+        uint32_t offset;
+    };
+    int _index_fd = -1;
+    // file offset of the next message queued in _writebuf
+    uint32_t _queued_offset;
+    uint32_t _index_last_ms;
+    // entries waiting for their data to be written, protected by semaphore
+    IndexEntry _index_pending[8];
+    uint8_t _index_num_pending;
+    // account for a message of size bytes queued, called with
+    // semaphore held
+    void index_message(uint32_t size);
+    // write out index entries covering data already in the log,
+    // called with write_fd_semaphore held
+    void index_write();
+    void index_open(uint16_t log_num);
+    void index_close();
+    void index_remove(uint16_t log_num);
+#endif
 };
 
 #endif // HAL_LOGGING_FILESYSTEM_ENABLED
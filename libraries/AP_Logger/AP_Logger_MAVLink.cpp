@@ -60,6 +60,13 @@ bool AP_Logger_MAVLink::logging_failed() const
     return !_sending_to_client;
 }
 
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+AP_Logger_Backend::Filter AP_Logger_MAVLink::message_filter() const
+{
+    return Filter(_front._params.mav_filter.get());
+}
+#endif
+
 uint32_t AP_Logger_MAVLink::bufferspace_available() {
     return (_blockcount_free * 200 + remaining_space_in_current_block());
 }
@@ -568,7 +575,7 @@ bool AP_Logger_MAVLink::send_log_block(struct dm_block &block)
     const uint16_t min_payload_space = 500;
     static_assert(MAVLINK_MSG_ID_REMOTE_LOG_DATA_BLOCK_LEN <= min_payload_space,
                   "minimum allocated space is less than payload length");
-    if (_link->txspace() < min_payload_space) {
+    if (_link->txspace_bulk() < min_payload_space) {
         return false;
     }
 
@@ -142,6 +142,9 @@ private:
     void Write_DMS(AP_Logger_MAVLink &logger);
 
     uint32_t bufferspace_available() override; // in bytes
+#if AP_LOGGER_BACKEND_FILTER_ENABLED
+    Filter message_filter() const override;
+#endif
     uint8_t remaining_space_in_current_block() const;
     // write buffer
     uint8_t _blockcount_free;
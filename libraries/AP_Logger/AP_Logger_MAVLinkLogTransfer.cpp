@@ -251,7 +251,7 @@ void AP_Logger::handle_log_send_listing()
 {
     WITH_SEMAPHORE(_log_send_sem);
 
-    if (!HAVE_PAYLOAD_SPACE(_log_sending_link->get_chan(), LOG_ENTRY)) {
+    if (!HAVE_PAYLOAD_SPACE_BULK(_log_sending_link->get_chan(), LOG_ENTRY)) {
         // no space
         return;
     }
@@ -288,7 +288,7 @@ bool AP_Logger::handle_log_send_data()
 {
     WITH_SEMAPHORE(_log_send_sem);
 
-    if (!HAVE_PAYLOAD_SPACE(_log_sending_link->get_chan(), LOG_DATA)) {
+    if (!HAVE_PAYLOAD_SPACE_BULK(_log_sending_link->get_chan(), LOG_DATA)) {
         // no space
         return false;
     }
@@ -47,6 +47,51 @@
 
 #endif
 
+// allow high rate threads to stage their log messages in their own
+// buffer rather than contending for the backend write buffer
+#ifndef AP_LOGGER_FILE_STAGING_ENABLED
+#define AP_LOGGER_FILE_STAGING_ENABLED HAL_LOGGING_FILESYSTEM_ENABLED && HAL_PROGRAM_SIZE_LIMIT_KB > 1024
+#endif
+
+#ifndef AP_LOGGER_STAGING_MAX_THREADS
+#define AP_LOGGER_STAGING_MAX_THREADS 4
+#endif
+
+#ifndef AP_LOGGER_STAGING_BUFFER_SIZE
+#define AP_LOGGER_STAGING_BUFFER_SIZE 4096
+#endif
+
+// optional streaming compression of file and block logs
+#ifndef AP_LOGGER_COMPRESSION_ENABLED
+#define AP_LOGGER_COMPRESSION_ENABLED (HAL_LOGGING_FILESYSTEM_ENABLED || HAL_LOGGING_BLOCK_ENABLED) && HAL_PROGRAM_SIZE_LIMIT_KB > 1024
+#endif
+
+// preallocation and streaming writeback of log files where the
+// filesystem supports it
+#ifndef AP_LOGGER_FILE_PREALLOC_ENABLED
+#define AP_LOGGER_FILE_PREALLOC_ENABLED HAL_LOGGING_FILESYSTEM_ENABLED && (AP_FILESYSTEM_POSIX_ENABLED || AP_FILESYSTEM_FATFS_ENABLED)
+#endif
+
+// a time index of each file log, so a GCS can fetch a time range
+// without downloading the whole log
+#ifndef AP_LOGGER_FILE_INDEX_ENABLED
+#define AP_LOGGER_FILE_INDEX_ENABLED HAL_LOGGING_FILESYSTEM_ENABLED && HAL_PROGRAM_SIZE_LIMIT_KB > 1024
+#endif
+
+// even decimation of streaming messages when a backend can't keep up
+#ifndef AP_LOGGER_DECIMATION_ENABLED
+#define AP_LOGGER_DECIMATION_ENABLED HAL_LOGGING_ENABLED && HAL_PROGRAM_SIZE_LIMIT_KB > 1024
+#endif
+
+// per-backend filters of which messages are logged
+#ifndef AP_LOGGER_BACKEND_FILTER_ENABLED
+#define AP_LOGGER_BACKEND_FILTER_ENABLED AP_LOGGER_DECIMATION_ENABLED
+#endif
+
+#if AP_LOGGER_BACKEND_FILTER_ENABLED && !AP_LOGGER_DECIMATION_ENABLED
+#error "AP_LOGGER_BACKEND_FILTER_ENABLED requires AP_LOGGER_DECIMATION_ENABLED"
+#endif
+
 #ifndef HAL_LOGGER_FILE_CONTENTS_ENABLED
 #define HAL_LOGGER_FILE_CONTENTS_ENABLED HAL_LOGGING_FILESYSTEM_ENABLED && !AP_FILESYSTEM_LITTLEFS_ENABLED
 #endif
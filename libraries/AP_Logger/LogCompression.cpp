@@ -0,0 +1,393 @@
+#include "LogCompression.h"
+
+#if AP_LOGGER_COMPRESSION_ENABLED
+
+#include <string.h>
+#include "LogStructure.h"
+
+/*
+  size of a field of a format string. integer is set for fields that
+  are differenced, other fields are copied when they change. Returns
+  0 for an unknown format character
+ */
+static uint8_t field_size(char c, bool &integer)
+{
+    integer = true;
+    switch (c) {
+    case 'c': case 'C': case 'g': case 'h': case 'H':
+        return 2;
+    case 'e': case 'E': case 'f': case 'i': case 'I': case 'L':
+        return 4;
+    case 'd': case 'q': case 'Q':
+        return 8;
+    default:
+        break;
+    }
+    integer = false;
+    switch (c) {
+    case 'b': case 'B': case 'M':
+        return 1;
+    case 'n':
+        return 4;
+    case 'N':
+        return 16;
+    case 'a': case 'Z':
+        return 64;
+    default:
+        return 0;
+    }
+}
+
+// fields are little-endian, as on all supported boards
+static uint64_t get_field(const uint8_t *p, uint8_t size)
+{
+    uint64_t v = 0;
+    memcpy(&v, p, size);
+    return v;
+}
+
+// zigzag encoded difference of two fields of the same size
+static uint64_t field_delta(const uint8_t *p, const uint8_t *prev, uint8_t size)
+{
+    const uint8_t shift = 64 - 8*size;
+    const int64_t d = int64_t((get_field(p, size) - get_field(prev, size)) << shift) >> shift;
+    return (uint64_t(d) << 1) ^ uint64_t(d >> 63);
+}
+
+static uint8_t put_varint(uint8_t *p, uint64_t v)
+{
+    uint8_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = uint8_t(v) | 0x80;
+        v >>= 7;
+    }
+    p[n++] = uint8_t(v);
+    return n;
+}
+
+// decode a varint from in[n..in_len), returning false if it runs off the end
+static bool get_varint(const uint8_t *in, uint16_t in_len, uint16_t &n, uint64_t &v)
+{
+    v = 0;
+    for (uint8_t shift=0; shift<64; shift+=7) {
+        if (n >= in_len) {
+            return false;
+        }
+        const uint8_t b = in[n++];
+        v |= uint64_t(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AP_Logger_Compression::reset(Method _method)
+{
+    method = _method;
+    memset(slots, 0, sizeof(slots));
+    memset(lengths, 0, sizeof(lengths));
+    memset(formats, 0, sizeof(formats));
+    memset(instance_ofs, NO_INSTANCE, sizeof(instance_ofs));
+}
+
+bool AP_Logger_Compression::has_instance(uint8_t type, uint16_t size) const
+{
+    return instance_ofs[type] != NO_INSTANCE && HEADER_LEN + instance_ofs[type] < size;
+}
+
+AP_Logger_Compression::Slot *AP_Logger_Compression::slot_for(uint8_t type, uint16_t size, uint8_t instance)
+{
+    switch (type) {
+    case LOG_FORMAT_MSG:
+    case LOG_FORMAT_UNITS_MSG:
+    case LOG_UNIT_MSG:
+    case LOG_MULT_MSG:
+        return nullptr;
+    default:
+        break;
+    }
+    if (size != lengths[type] || size <= HEADER_LEN || size > LOG_COMPRESSION_MAX_MSG_LEN) {
+        return nullptr;
+    }
+    auto &slot = slots[(type + 17U*instance) % NUM_SLOTS];
+    if (!slot.valid || slot.type != type || slot.instance != instance) {
+        // first message of this type and instance, or the slot was
+        // used by another. Compress against zeros
+        slot.valid = true;
+        slot.type = type;
+        slot.instance = instance;
+        slot.count = 0;
+        memset(slot.body, 0, sizeof(slot.body));
+    }
+    return &slot;
+}
+
+void AP_Logger_Compression::invalidate(uint8_t type)
+{
+    for (auto &slot : slots) {
+        if (slot.type == type) {
+            slot.valid = false;
+        }
+    }
+}
+
+void AP_Logger_Compression::update_instance_field(const uint8_t *msg, uint16_t size)
+{
+    if (size < sizeof(log_Format_Units)) {
+        return;
+    }
+    const struct log_Format_Units *f = (const struct log_Format_Units *)msg;
+    const char *fmt = formats[f->format_type];
+    const uint8_t num_fields = strnlen(fmt, FORMAT_LEN);
+    uint8_t ofs = NO_INSTANCE;
+    uint16_t field_ofs = 0;
+    for (uint8_t i=0; i<num_fields && i<UNITS_LEN; i++) {
+        bool integer;
+        const uint8_t fsize = field_size(fmt[i], integer);
+        if (fsize == 0) {
+            break;
+        }
+        if (f->units[i] == '#') {
+            // only single byte instances are used
+            if (fsize == 1 && field_ofs < MAX_BODY_LEN) {
+                ofs = field_ofs;
+            }
+            break;
+        }
+        field_ofs += fsize;
+    }
+    if (ofs != instance_ofs[f->format_type]) {
+        instance_ofs[f->format_type] = ofs;
+        invalidate(f->format_type);
+    }
+}
+
+void AP_Logger_Compression::update(const uint8_t *msg, uint16_t size)
+{
+    if (size < HEADER_LEN) {
+        return;
+    }
+    if (msg[2] == LOG_FORMAT_MSG) {
+        if (size >= sizeof(log_Format)) {
+            const struct log_Format *f = (const struct log_Format *)msg;
+            lengths[f->type] = f->length;
+            memcpy(formats[f->type], f->format, FORMAT_LEN);
+            // a new format for the type restarts its compression
+            invalidate(f->type);
+        }
+        return;
+    }
+    if (msg[2] == LOG_FORMAT_UNITS_MSG) {
+        update_instance_field(msg, size);
+        return;
+    }
+    const uint8_t instance = has_instance(msg[2], size) ? msg[HEADER_LEN + instance_ofs[msg[2]]] : 0;
+    Slot *slot = slot_for(msg[2], size, instance);
+    if (slot != nullptr) {
+        memcpy(slot->body, &msg[HEADER_LEN], size - HEADER_LEN);
+        slot->count = 0;
+    }
+}
+
+uint16_t AP_Logger_Compression::compress_bytes(uint8_t *out, uint16_t start, const uint8_t *body, uint8_t body_len, const uint8_t *prev)
+{
+    uint16_t n = start;
+    for (uint8_t i=0; i<body_len; i+=8) {
+        uint8_t &mask = out[n++];
+        mask = 0;
+        for (uint8_t j=0; j<8 && i+j<body_len; j++) {
+            const uint8_t x = body[i+j] ^ prev[i+j];
+            if (x != 0) {
+                mask |= 1U<<j;
+                out[n++] = x;
+            }
+        }
+    }
+    out[1] = HEAD_BYTE2_COMPRESSED;
+    return n;
+}
+
+uint16_t AP_Logger_Compression::compress_fields(uint8_t *out, uint16_t start, const uint8_t *body, uint8_t body_len, const uint8_t *prev, const char *fmt)
+{
+    const uint8_t num_fields = strnlen(fmt, FORMAT_LEN);
+    uint8_t *mask = &out[start];
+    const uint8_t mask_len = (num_fields + 7) / 8;
+    memset(mask, 0, mask_len);
+    uint16_t n = start + mask_len;
+    uint8_t ofs = 0;
+    for (uint8_t i=0; i<num_fields; i++) {
+        bool integer;
+        const uint8_t size = field_size(fmt[i], integer);
+        if (size == 0 || ofs + size > body_len) {
+            return 0;
+        }
+        if (memcmp(&body[ofs], &prev[ofs], size) != 0) {
+            mask[i/8] |= 1U<<(i%8);
+            if (integer) {
+                n += put_varint(&out[n], field_delta(&body[ofs], &prev[ofs], size));
+            } else {
+                memcpy(&out[n], &body[ofs], size);
+                n += size;
+            }
+        }
+        ofs += size;
+    }
+    if (ofs != body_len) {
+        // format does not match the length
+        return 0;
+    }
+    out[1] = HEAD_BYTE2_COMPRESSED_FIELDS;
+    return n;
+}
+
+uint16_t AP_Logger_Compression::compress(const uint8_t *msg, uint16_t size, const uint8_t *&out)
+{
+    if (size < HEADER_LEN) {
+        return 0;
+    }
+    const bool instanced = has_instance(msg[2], size);
+    const uint8_t instance = instanced ? msg[HEADER_LEN + instance_ofs[msg[2]]] : 0;
+    Slot *slot = slot_for(msg[2], size, instance);
+    if (slot == nullptr) {
+        update(msg, size);
+        return 0;
+    }
+
+    const uint8_t *body = &msg[HEADER_LEN];
+    const uint8_t body_len = size - HEADER_LEN;
+    const uint16_t start = FRAME_HEADER_LEN + (instanced ? 1 : 0);
+    if (++slot->count >= LOG_COMPRESSION_KEYFRAME_INTERVAL) {
+        // periodic uncompressed message
+        memcpy(slot->body, body, body_len);
+        slot->count = 0;
+        return 0;
+    }
+
+    uint8_t *out_frame = frame;
+    uint16_t n = compress_bytes(frame, start, body, body_len, slot->body);
+    if (method == Method::FIELDS) {
+        // use whichever method gives the smaller message, fields are
+        // usually better but bytes win when many fields change noisily
+        const uint16_t n_fields = compress_fields(frame_fields, start, body, body_len, slot->body, formats[msg[2]]);
+        if (n_fields != 0 && n_fields < n) {
+            n = n_fields;
+            out_frame = frame_fields;
+        }
+    }
+    memcpy(slot->body, body, body_len);
+
+    if (n >= size) {
+        // no gain, write the message as it is
+        slot->count = 0;
+        return 0;
+    }
+    out_frame[0] = HEAD_BYTE1;
+    out_frame[2] = msg[2];
+    out_frame[3] = n - FRAME_HEADER_LEN;
+    if (instanced) {
+        out_frame[FRAME_HEADER_LEN] = instance;
+    }
+    out = out_frame;
+    return n;
+}
+
+bool AP_Logger_Compression::decompress_bytes(const uint8_t *in, uint16_t start, uint16_t in_len, uint8_t *body, uint8_t body_len, const uint8_t *prev) const
+{
+    uint16_t n = start;
+    for (uint8_t i=0; i<body_len; i+=8) {
+        if (n >= in_len) {
+            return false;
+        }
+        const uint8_t mask = in[n++];
+        for (uint8_t j=0; j<8 && i+j<body_len; j++) {
+            uint8_t x = 0;
+            if (mask & (1U<<j)) {
+                if (n >= in_len) {
+                    return false;
+                }
+                x = in[n++];
+            }
+            body[i+j] = prev[i+j] ^ x;
+        }
+    }
+    return n == in_len;
+}
+
+bool AP_Logger_Compression::decompress_fields(const uint8_t *in, uint16_t start, uint16_t in_len, uint8_t *body, uint8_t body_len, const uint8_t *prev, const char *fmt) const
+{
+    const uint8_t num_fields = strnlen(fmt, FORMAT_LEN);
+    const uint8_t mask_len = (num_fields + 7) / 8;
+    const uint8_t *mask = &in[start];
+    uint16_t n = start + mask_len;
+    if (n > in_len) {
+        return false;
+    }
+    uint8_t ofs = 0;
+    for (uint8_t i=0; i<num_fields; i++) {
+        bool integer;
+        const uint8_t size = field_size(fmt[i], integer);
+        if (size == 0 || ofs + size > body_len) {
+            return false;
+        }
+        if ((mask[i/8] & (1U<<(i%8))) == 0) {
+            memcpy(&body[ofs], &prev[ofs], size);
+        } else if (integer) {
+            uint64_t v;
+            if (!get_varint(in, in_len, n, v)) {
+                return false;
+            }
+            const int64_t d = int64_t(v >> 1) ^ -int64_t(v & 1);
+            const uint64_t value = get_field(&prev[ofs], size) + uint64_t(d);
+            memcpy(&body[ofs], &value, size);
+        } else {
+            if (n + size > in_len) {
+                return false;
+            }
+            memcpy(&body[ofs], &in[n], size);
+            n += size;
+        }
+        ofs += size;
+    }
+    return ofs == body_len && n == in_len;
+}
+
+uint16_t AP_Logger_Compression::decompress(const uint8_t *in, uint8_t *msg)
+{
+    const uint8_t type = in[2];
+    const uint16_t size = lengths[type];
+    const uint16_t in_len = FRAME_HEADER_LEN + in[3];
+    const bool instanced = has_instance(type, size);
+    if (instanced && in_len <= FRAME_HEADER_LEN) {
+        return 0;
+    }
+    const uint8_t instance = instanced ? in[FRAME_HEADER_LEN] : 0;
+    Slot *slot = slot_for(type, size, instance);
+    if (slot == nullptr) {
+        return 0;
+    }
+
+    const uint16_t start = FRAME_HEADER_LEN + (instanced ? 1 : 0);
+    const uint8_t body_len = size - HEADER_LEN;
+    uint8_t *body = &msg[HEADER_LEN];
+    bool ok = false;
+    switch (in[1]) {
+    case HEAD_BYTE2_COMPRESSED:
+        ok = decompress_bytes(in, start, in_len, body, body_len, slot->body);
+        break;
+    case HEAD_BYTE2_COMPRESSED_FIELDS:
+        ok = decompress_fields(in, start, in_len, body, body_len, slot->body, formats[type]);
+        break;
+    }
+    if (!ok || (instanced && body[instance_ofs[type]] != instance)) {
+        return 0;
+    }
+    memcpy(slot->body, body, body_len);
+
+    msg[0] = HEAD_BYTE1;
+    msg[1] = HEAD_BYTE2;
+    msg[2] = type;
+    return size;
+}
+
+#endif // AP_LOGGER_COMPRESSION_ENABLED
@@ -0,0 +1,160 @@
+/*
+  streaming compression of log messages
+
+  Each message is compared with the previous message of the same
+  type. Timestamps, counters and most sensor fields change slowly
+  between messages of the same type, so there are two methods:
+
+  Bytes: the message is XORed with the previous one, and the result
+  is stored as a mask byte for each 8 bytes of the message followed
+  by the non-zero bytes of that group.
+
+  Fields: the message is split into fields using the format string
+  from its FMT message. A mask has one bit for each field that
+  changed. Multi-byte numeric fields that changed are stored as the
+  zigzag varint of their difference from the previous value, so a
+  TimeUS field usually takes 2 bytes instead of 8. Floats are
+  differenced as integers, which keeps the sign, exponent and top of
+  the mantissa out of the output when the value changes slowly.
+  Single bytes and strings are stored as they are. When this method
+  is selected each message uses whichever of the two is smaller.
+
+  Messages with an instance field, marked '#' in their FMTU units,
+  are compared with the previous message of the same type and
+  instance. Sensor messages such as IMU and the replay RISI, RGPI
+  and RMGI are written for each instance in turn, so comparing with
+  the previous message of the type would compare different sensors.
+
+  A compressed message is framed as:
+    HEAD_BYTE1, HEAD_BYTE2_COMPRESSED(_FIELDS), type, length, data[length]
+  where data starts with the instance for messages with an instance
+  field.
+
+  FMT, FMTU, UNIT and MULT messages are never compressed, and every
+  LOG_COMPRESSION_KEYFRAME_INTERVAL messages of each type are written
+  uncompressed so a reader can recover after damage to the log. The
+  length and format of each type are learned from its FMT message, so
+  the compressor and decompressor build exactly the same state from
+  the same stream and share one implementation.
+ */
+#pragma once
+
+#include "AP_Logger_config.h"
+
+#if AP_LOGGER_COMPRESSION_ENABLED
+
+#include <stdint.h>
+
+// second header byte of a message compressed with Method::BYTES
+#define HEAD_BYTE2_COMPRESSED 0x96
+// second header byte of a message compressed with Method::FIELDS
+#define HEAD_BYTE2_COMPRESSED_FIELDS 0x97
+
+// messages longer than this are always written uncompressed
+#ifndef LOG_COMPRESSION_MAX_MSG_LEN
+#define LOG_COMPRESSION_MAX_MSG_LEN 128
+#endif
+
+// every this many messages of a type one is written uncompressed
+#ifndef LOG_COMPRESSION_KEYFRAME_INTERVAL
+#define LOG_COMPRESSION_KEYFRAME_INTERVAL 100
+#endif
+
+class AP_Logger_Compression {
+public:
+    // values of LOG_COMPRESS
+    enum class Method : uint8_t {
+        NONE = 0,
+        BYTES = 1,
+        FIELDS = 2,
+    };
+
+    // forget all state, must be called at the start of each
+    // log. method only affects compress(), decompress() handles
+    // messages from either method
+    void reset(Method method = Method::BYTES);
+
+    /*
+      compress a complete message. Returns the size of the compressed
+      message in out, or 0 if the message should be written as it
+      is. The state is updated either way. out remains valid until
+      the next call
+     */
+    uint16_t compress(const uint8_t *msg, uint16_t size, const uint8_t *&out);
+
+    /*
+      decompress a compressed message, including its 4 byte header,
+      into msg. Returns the size of the message or 0 if the message
+      can't be decompressed
+     */
+    uint16_t decompress(const uint8_t *in, uint8_t *msg);
+
+    // update the state with a message that was not compressed
+    void update(const uint8_t *msg, uint16_t size);
+
+    // the length of a message type, or 0 if its format is not known
+    uint8_t message_length(uint8_t type) const { return lengths[type]; }
+
+private:
+    static constexpr uint8_t HEADER_LEN = 3;
+    static constexpr uint8_t FRAME_HEADER_LEN = 4;
+    static constexpr uint8_t MAX_BODY_LEN = LOG_COMPRESSION_MAX_MSG_LEN - HEADER_LEN;
+    static constexpr uint8_t NUM_SLOTS = 64;
+    static constexpr uint8_t FORMAT_LEN = 16;
+    static constexpr uint8_t UNITS_LEN = 16;
+    static constexpr uint8_t NO_INSTANCE = 0xFF;
+
+    struct Slot {
+        uint8_t type;
+        uint8_t instance;
+        bool valid;
+        // messages since the last uncompressed one
+        uint8_t count;
+        uint8_t body[MAX_BODY_LEN];
+    };
+
+    // slot holding the previous message of a type and instance, or
+    // nullptr if messages of this type and size are not compressed
+    Slot *slot_for(uint8_t type, uint16_t size, uint8_t instance);
+
+    // true if messages of this type and size have an instance field
+    bool has_instance(uint8_t type, uint16_t size) const;
+
+    // learn the offset of the instance field of a type from its FMTU
+    void update_instance_field(const uint8_t *msg, uint16_t size);
+
+    // forget the previous messages of a type
+    void invalidate(uint8_t type);
+
+    // encode body against prev into out from start, returning the
+    // frame length or 0 if the message can't be encoded this way
+    uint16_t compress_bytes(uint8_t *out, uint16_t start, const uint8_t *body, uint8_t body_len, const uint8_t *prev);
+    uint16_t compress_fields(uint8_t *out, uint16_t start, const uint8_t *body, uint8_t body_len, const uint8_t *prev, const char *fmt);
+
+    // decode the data of a frame from start into body, returning
+    // false if the data is not valid
+    bool decompress_bytes(const uint8_t *in, uint16_t start, uint16_t in_len, uint8_t *body, uint8_t body_len, const uint8_t *prev) const;
+    bool decompress_fields(const uint8_t *in, uint16_t start, uint16_t in_len, uint8_t *body, uint8_t body_len, const uint8_t *prev, const char *fmt) const;
+
+    Method method;
+
+    // the previous message of each type and instance, which share a
+    // slot when they hash to the same one
+    Slot slots[NUM_SLOTS];
+
+    // length and format of each message type from its FMT message
+    uint8_t lengths[256];
+    char formats[256][FORMAT_LEN];
+
+    // offset in the body of the instance field of each type from its
+    // FMTU message, or NO_INSTANCE
+    uint8_t instance_ofs[256];
+
+    // workspace for the output of compress() with each method. A
+    // changed 16 bit field takes at most 3 bytes, which is the largest
+    // expansion
+    uint8_t frame[FRAME_HEADER_LEN + 1 + MAX_BODY_LEN + (MAX_BODY_LEN + 7) / 8];
+    uint8_t frame_fields[FRAME_HEADER_LEN + 1 + (FORMAT_LEN / 8) + (MAX_BODY_LEN * 3 + 1) / 2];
+};
+
+#endif // AP_LOGGER_COMPRESSION_ENABLED
@@ -0,0 +1,56 @@
+/*
+  compile-time formats for messages written with
+  AP_Logger::WriteStreamingFields() and WriteFields()
+
+  The format string and length of the message are derived from the
+  C++ types of the fields, so nothing is parsed when a message is
+  written. Only types with a unique format character are supported;
+  scaled fields such as 'c' and 'L', and strings, need the format
+  string based Write() or a LogStructure.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <AP_Common/float16.h>
+#include "LogStructure.h"
+
+template <typename T> struct LogFieldFormat;
+template <> struct LogFieldFormat<int8_t>    { static constexpr char fmt = 'b'; };
+template <> struct LogFieldFormat<uint8_t>   { static constexpr char fmt = 'B'; };
+template <> struct LogFieldFormat<int16_t>   { static constexpr char fmt = 'h'; };
+template <> struct LogFieldFormat<uint16_t>  { static constexpr char fmt = 'H'; };
+template <> struct LogFieldFormat<int32_t>   { static constexpr char fmt = 'i'; };
+template <> struct LogFieldFormat<uint32_t>  { static constexpr char fmt = 'I'; };
+template <> struct LogFieldFormat<int64_t>   { static constexpr char fmt = 'q'; };
+template <> struct LogFieldFormat<uint64_t>  { static constexpr char fmt = 'Q'; };
+template <> struct LogFieldFormat<float>     { static constexpr char fmt = 'f'; };
+template <> struct LogFieldFormat<double>    { static constexpr char fmt = 'd'; };
+template <> struct LogFieldFormat<Float16_t> { static constexpr char fmt = 'g'; };
+
+// total size of a list of types
+template <typename... Types> struct LogFieldsSize;
+template <> struct LogFieldsSize<> { static constexpr uint16_t size = 0; };
+template <typename T, typename... Types> struct LogFieldsSize<T, Types...> {
+    static constexpr uint16_t size = sizeof(T) + LogFieldsSize<Types...>::size;
+};
+
+template <typename... Fields>
+struct LogFieldsFormat {
+    static constexpr char fmt[] { LogFieldFormat<Fields>::fmt..., '\0' };
+    static constexpr uint8_t length = LOG_PACKET_HEADER_LEN + LogFieldsSize<Fields...>::size;
+
+    static_assert(sizeof...(Fields) < LS_FORMAT_SIZE, "too many fields");
+    static_assert(LOG_PACKET_HEADER_LEN + LogFieldsSize<Fields...>::size <= UINT8_MAX, "message too long");
+
+    // pack the fields into a message after its header
+    static void pack(uint8_t *buffer, const Fields&... fields) {
+        uint8_t *p = &buffer[LOG_PACKET_HEADER_LEN];
+        // the elements of a braced list are evaluated in order
+        const int unused[] { 0, (memcpy(p, &fields, sizeof(fields)), p += sizeof(fields), 0)... };
+        (void)unused;
+    }
+};
+
+template <typename... Fields>
+constexpr char LogFieldsFormat<Fields...>::fmt[];
@@ -228,6 +228,13 @@ struct PACKED log_DSF {
     uint32_t buf_space_min;
     uint32_t buf_space_max;
     uint32_t buf_space_avg;
+    uint32_t write_time_max;
+    uint32_t write_time_avg;
+    uint32_t write_rate;
+    uint8_t decimation_level;
+    uint32_t decimated_high_rate;
+    uint32_t decimated_normal;
+    uint8_t write_fmts;
 };
 
 struct PACKED log_Event {
@@ -317,6 +324,10 @@ struct PACKED log_MAV {
     uint16_t stream_slowdown_ms;
     uint16_t times_full;
     uint32_t GCS_SYSID_last_seen_ms;
+    uint16_t send_loop_avg_us;
+    uint16_t send_loop_max_us;
+    uint32_t tx_bytes_per_sec;
+    uint16_t bw_scale_pct;
 };
 
 struct PACKED log_RSSI {
@@ -478,6 +489,8 @@ struct PACKED log_TERRAIN {
     uint16_t pending;
     uint16_t loaded;
     float reference_offset;
+    uint32_t cache_hits;
+    uint32_t cache_misses;
 };
 
 struct PACKED log_ARSP {
@@ -494,6 +507,8 @@ struct PACKED log_ARSP {
     float   health_prob;
     float   test_ratio;
     uint8_t primary;
+    uint16_t samples;
+    float   noise;
 };
 
 struct PACKED log_DMS {
@@ -547,6 +562,21 @@ struct PACKED log_Performance {
     uint64_t rtc;
 };
 
+struct PACKED log_Task_Histogram {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t task;
+    uint16_t count;
+    uint16_t run_p50;
+    uint16_t run_p90;
+    uint16_t run_p99;
+    uint16_t run_max;
+    uint16_t slip_p50;
+    uint16_t slip_p90;
+    uint16_t slip_p99;
+    uint16_t starved;
+};
+
 struct PACKED log_SRTL {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -595,6 +625,16 @@ struct PACKED log_STAK {
     char name[16];
 };
 
+// thread CPU use and scheduling over the time since the thread was last logged
+struct PACKED log_THRD {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t thread_id;
+    float load;
+    uint16_t wake_late_max;
+    uint16_t boost_count;
+};
+
 struct PACKED log_File {
     LOG_PACKET_HEADER;
     char filename[16];
@@ -610,6 +650,11 @@ struct PACKED log_Scripting {
     uint32_t run_time;
     int32_t total_mem;
     int32_t run_mem;
+    uint32_t vm_steps;
+    uint32_t gc_time;
+    int32_t gc_freed;
+    uint32_t jitter;
+    uint8_t lane;
 };
 
 struct PACKED log_MotBatt {
@@ -687,6 +732,8 @@ struct PACKED log_VER {
 // @Field: Hp: Probability sensor is healthy
 // @Field: TR: innovation test ratio
 // @Field: Pri: True if sensor is the primary sensor
+// @Field: N: Number of raw samples averaged into this reading
+// @Field: PN: Standard deviation of the raw pressure samples
 
 // @LoggerMessage: DMS
 // @Description: DataFlash-Over-MAVLink statistics
@@ -714,6 +761,13 @@ struct PACKED log_VER {
 // @Field: FMn: Minimum free space in write buffer in last time period
 // @Field: FMx: Maximum free space in write buffer in last time period
 // @Field: FAv: Average free space in write buffer in last time period
+// @Field: WMx: Longest write to the storage in last time period
+// @Field: WAv: Average time of writes to the storage in last time period
+// @Field: WR: Rate of writes to the storage in last time period
+// @Field: BP: Backpressure level deciding how much streaming messages are decimated, 0 for none
+// @Field: DcH: Number of high rate messages decimated in last time period
+// @Field: DcN: Number of other streaming messages decimated in last time period
+// @Field: Fmts: Number of formats registered for messages written by name
 
 // @LoggerMessage: ERR
 // @Description: Specifically coded error messages
@@ -780,6 +834,10 @@ struct PACKED log_VER {
 // @Field: ss: stream slowdown is the number of ms being added to each message to fit within bandwidth
 // @Field: tf: times buffer was full when a message was going to be sent
 // @Field: mgs: time MAV_GCS_SYSID heartbeat (or manual control) last seen
+// @Field: sla: average time spent in each call to send messages on this channel
+// @Field: slm: maximum time spent in a call to send messages on this channel
+// @Field: txr: bytes sent per second
+// @Field: bws: percentage the intervals of streams faster than 1Hz are scaled by to keep within MAVx_BW_PCT of the link bandwidth
 
 // @LoggerMessage: MAVC
 // @Description: MAVLink command we have just executed
@@ -882,6 +940,20 @@ struct PACKED log_VER {
 // @Field: Ex: number of microseconds being added to each loop to address scheduler overruns
 // @Field: R: RTC time, time since Unix epoch
 
+// @LoggerMessage: TSKH
+// @Description: Scheduler task run time and start slip percentiles, taken from log2 histograms so each value is the upper bound of its histogram bucket
+// @Field: TimeUS: Time since system startup
+// @Field: I: task index in the merged vehicle and common task tables
+// @Field: N: number of runs of the task in this period
+// @Field: T50: median task run time
+// @Field: T90: 90th percentile task run time
+// @Field: T99: 99th percentile task run time
+// @Field: TMax: maximum task run time
+// @Field: S50: median time from the task being due to it starting
+// @Field: S90: 90th percentile time from the task being due to it starting
+// @Field: S99: 99th percentile time from the task being due to it starting
+// @Field: Stv: number of times the task was due but skipped as it would not fit in the time left in the loop
+
 // @LoggerMessage: POWR
 // @Description: System power information
 // @Field: TimeUS: Time since system startup
@@ -1049,6 +1121,8 @@ struct PACKED log_VER {
 // @Field: Pending: Number of tile requests outstanding
 // @Field: Loaded: Number of tiles in memory
 // @Field: ROfs: terrain reference offset for arming altitude
+// @Field: CHit: Number of terrain cache lookups which found the tile in memory
+// @Field: CMiss: Number of terrain cache lookups which had to load the tile
 
 // @LoggerMessage: TSYN
 // @Description: Time synchronisation response information
@@ -1094,6 +1168,14 @@ struct PACKED log_VER {
 // @Field: Free: free stack
 // @Field: Name: thread name
 
+// @LoggerMessage: THRD
+// @Description: Thread CPU use and scheduling since the thread was last logged. Written after the STAK message for the same thread when thread statistics are enabled
+// @Field: TimeUS: Time since system startup
+// @Field: Id: thread ID, as in the STAK message
+// @Field: Load: percentage of CPU time used by the thread, since @SYS/threads.txt was read if that was more recent
+// @Field: Late: longest time the thread woke after the end of a requested sleep
+// @Field: PI: number of times the thread ran at a priority inherited from a higher priority thread waiting on a mutex it held
+
 // @LoggerMessage: FILE
 // @Description: File data
 // @Field: FileName: File name
@@ -1108,6 +1190,12 @@ struct PACKED log_VER {
 // @Field: Runtime: run time
 // @Field: Total_mem: total memory usage of all scripts
 // @Field: Run_mem: run memory usage
+// @Field: Steps: number of Lua VM instructions executed
+// @Field: GCTime: time spent collecting garbage after the run
+// @Field: GCFreed: memory freed by garbage collection after the run
+// @Field: Jitter: how long after it was due the run started
+// @Field: Lane: scripting lane the script runs in
+// @FieldValueEnum: Lane: lua_scripts::Lane
 
 // @LoggerMessage: VER
 // @Description: Ardupilot version
@@ -1180,7 +1268,7 @@ LOG_STRUCTURE_FROM_MISSION \
       "RAD", "QBBBBBHH", "TimeUS,RSSI,RemRSSI,TxBuf,Noise,RemNoise,RxErrors,Fixed", "s-------", "F-------", true }, \
 LOG_STRUCTURE_FROM_CAMERA \
 LOG_STRUCTURE_FROM_MOUNT \
-    { LOG_ARSP_MSG, sizeof(log_ARSP), "ARSP",  "QBffcffBBffB", "TimeUS,I,Airspeed,DiffPress,Temp,RawPress,Offset,U,H,Hp,TR,Pri", "s#nPOPP-----", "F-00B00-----", true }, \
+    { LOG_ARSP_MSG, sizeof(log_ARSP), "ARSP",  "QBffcffBBffBHf", "TimeUS,I,Airspeed,DiffPress,Temp,RawPress,Offset,U,H,Hp,TR,Pri,N,PN", "s#nPOPP------P", "F-00B00------0", true }, \
     LOG_STRUCTURE_FROM_BATTMONITOR \
     { LOG_MAG_MSG, sizeof(log_MAG), \
       "MAG", "QBhhhhhhhhhBI",    "TimeUS,I,MagX,MagY,MagZ,OfsX,OfsY,OfsZ,MOX,MOY,MOZ,Health,S", "s#GGGGGGGGG-s", "F-CCCCCCCCC-F", true }, \
@@ -1194,13 +1282,15 @@ LOG_STRUCTURE_FROM_MOUNT \
     LOG_STRUCTURE_FROM_PROXIMITY                                    \
     { LOG_PERFORMANCE_MSG, sizeof(log_Performance),                     \
       "PM",  "QHHHIIHHIIIIIIQ", "TimeUS,LR,NLon,NL,MaxT,Mem,Load,ErrL,InE,ErC,SPIC,I2CC,I2CI,Ex,R", "sz---b%------ss", "F----0A------FF" }, \
+    { LOG_TASK_HISTOGRAM_MSG, sizeof(log_Task_Histogram),               \
+      "TSKH", "QBHHHHHHHHH", "TimeUS,I,N,T50,T90,T99,TMax,S50,S90,S99,Stv", "s#-sssssss-", "F--FFFFFFF-" }, \
     { LOG_SRTL_MSG, sizeof(log_SRTL), \
       "SRTL", "QBHHBfff", "TimeUS,Active,NumPts,MaxPts,Action,N,E,D", "s----mmm", "F----000" }, \
 LOG_STRUCTURE_FROM_AVOIDANCE \
     { LOG_SIMSTATE_MSG, sizeof(log_AHRS), \
       "SIM","QccCfLLffff","TimeUS,Roll,Pitch,Yaw,Alt,Lat,Lng,Q1,Q2,Q3,Q4", "sddhmDU----", "FBBB0GG0000", true }, \
     { LOG_TERRAIN_MSG, sizeof(log_TERRAIN), \
-      "TERR","QBLLHffHHf","TimeUS,Status,Lat,Lng,Spacing,TerrH,CHeight,Pending,Loaded,ROfs", "s-DU-mm--m", "F-GG-00--0", true }, \
+      "TERR","QBLLHffHHfII","TimeUS,Status,Lat,Lng,Spacing,TerrH,CHeight,Pending,Loaded,ROfs,CHit,CMiss", "s-DU-mm--m--", "F-GG-00--0--", true }, \
 LOG_STRUCTURE_FROM_ESC_TELEM \
 LOG_STRUCTURE_FROM_SERVO_TELEM \
     { LOG_PIDR_MSG, sizeof(log_PID), \
@@ -1229,11 +1319,11 @@ LOG_STRUCTURE_FROM_HAL \
 LOG_STRUCTURE_FROM_RPM \
 LOG_STRUCTURE_FROM_FENCE \
     { LOG_DF_FILE_STATS, sizeof(log_DSF), \
-      "DSF", "QIHIIII", "TimeUS,Dp,Blk,Bytes,FMn,FMx,FAv", "s--b---", "F--0---" }, \
+      "DSF", "QIHIIIIIIIBIIB", "TimeUS,Dp,Blk,Bytes,FMn,FMx,FAv,WMx,WAv,WR,BP,DcH,DcN,Fmts", "s--b---ssB----", "F--0---FF0----" }, \
     { LOG_RALLY_MSG, sizeof(log_Rally), \
       "RALY", "QBBLLhB", "TimeUS,Tot,Seq,Lat,Lng,Alt,Flags", "s--DUm-", "F--GGB-" },  \
     { LOG_MAV_MSG, sizeof(log_MAV),   \
-      "MAV", "QBHHHBHHI",   "TimeUS,chan,txp,rxp,rxdp,flags,ss,tf,mgs", "s#----s-s", "F-000-C-C" },   \
+      "MAV", "QBHHHBHHIHHIH",   "TimeUS,chan,txp,rxp,rxdp,flags,ss,tf,mgs,sla,slm,txr,bws", "s#----s-sssB%", "F-000-C-CFF00" },   \
 LOG_STRUCTURE_FROM_VISUALODOM \
     { LOG_OPTFLOW_MSG, sizeof(log_Optflow), \
       "OF",   "QBffff",   "TimeUS,Qual,flowX,flowY,bodyX,bodyY", "s-EEEE", "F-0000" , true }, \
@@ -1252,11 +1342,13 @@ LOG_STRUCTURE_FROM_VISUALODOM \
     LOG_STRUCTURE_FROM_AC_ATTITUDECONTROL,                              \
     { LOG_STAK_MSG, sizeof(log_STAK), \
       "STAK", "QBBHHN", "TimeUS,Id,Pri,Total,Free,Name", "s#----", "F-----", true }, \
+    { LOG_THRD_MSG, sizeof(log_THRD), \
+      "THRD", "QBfHH", "TimeUS,Id,Load,Late,PI", "s#%s-", "F-0F-", true }, \
     { LOG_FILE_MSG, sizeof(log_File), \
       "FILE",   "NIBZ",       "FileName,Offset,Length,Data", "----", "----" }, \
 LOG_STRUCTURE_FROM_AIS \
     { LOG_SCRIPTING_MSG, sizeof(log_Scripting), \
-      "SCR",   "QNIii", "TimeUS,Name,Runtime,Total_mem,Run_mem", "s#sbb", "F-F--", true }, \
+      "SCR",   "QNIiiIIiIB", "TimeUS,Name,Runtime,Total_mem,Run_mem,Steps,GCTime,GCFreed,Jitter,Lane", "s#sbb-sbs-", "F-F---F-F-", true }, \
     { LOG_VER_MSG, sizeof(log_VER), \
       "VER",   "QBHBBBBIZHBBII", "TimeUS,BT,BST,Maj,Min,Pat,FWT,GH,FWS,APJ,BU,FV,IMI,ICI", "s-------------", "F-------------", false }, \
     { LOG_MOTBATT_MSG, sizeof(log_MotBatt), \
@@ -1327,6 +1419,7 @@ enum LogMessages : uint8_t {
     LOG_DF_FILE_STATS,
     LOG_SRTL_MSG,
     LOG_PERFORMANCE_MSG,
+    LOG_TASK_HISTOGRAM_MSG,
     LOG_OPTFLOW_MSG,
     LOG_EVENT_MSG,
     LOG_WHEELENCODER_MSG,
@@ -1339,6 +1432,7 @@ enum LogMessages : uint8_t {
     LOG_IDS_FROM_PRECLAND,
     LOG_IDS_FROM_AIS,
     LOG_STAK_MSG,
+    LOG_THRD_MSG,
     LOG_FILE_MSG,
     LOG_SCRIPTING_MSG,
     LOG_VIDEO_STABILISATION_MSG,
@@ -3,6 +3,7 @@
 #if HAL_LOGGING_ENABLED
 
 #include "AP_Common/AP_FWVersion.h"
+#include <AP_Common/AP_BootTrace.h>
 #include "LoggerMessageWriter.h"
 #include <AP_Scheduler/AP_Scheduler.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
@@ -270,6 +271,7 @@ void LoggerMessageWriter_WriteSysInfo::reset()
 {
     LoggerMessageWriter::reset();
     stage = Stage::FIRMWARE_STRING;
+    boot_trace_stage = 0;
 }
 
 void LoggerMessageWriter_WriteSysInfo::process() {
@@ -333,8 +335,41 @@ void LoggerMessageWriter_WriteSysInfo::process() {
         if (! _logger_backend->Write_MessageF("Param space used: %u/%u", AP_Param::storage_used(), AP_Param::storage_size())) {
             return; // call me again
         }
+        stage = Stage::PARAM_LOAD_TIME;
+        FALLTHROUGH;
+
+    case Stage::PARAM_LOAD_TIME: {
+        const auto &t = AP_Param::get_load_timing();
+        // a scan time of zero means the headers were not sorted
+        if (! _logger_backend->Write_MessageF("Param load: %u in %uus defaults %uus scan %uus",
+                                              unsigned(t.headers),
+                                              unsigned(t.defaults_us + t.scan_us + t.load_us),
+                                              unsigned(t.defaults_us),
+                                              unsigned(t.scan_us))) {
+            return; // call me again
+        }
+        stage = Stage::BOOT_TRACE;
+        FALLTHROUGH;
+    }
+
+    case Stage::BOOT_TRACE: {
+#if AP_BOOT_TRACE_ENABLED
+        const AP_BootTrace &trace = AP::boot_trace();
+        const char *name;
+        uint32_t start_us, duration_us;
+        while (trace.get_stage(boot_trace_stage, name, start_us, duration_us)) {
+            if (! _logger_backend->Write_MessageF("Boot: %s %ums at %ums",
+                                                  name,
+                                                  unsigned(duration_us / 1000),
+                                                  unsigned(start_us / 1000))) {
+                return; // call me again
+            }
+            boot_trace_stage++;
+        }
+#endif
         stage = Stage::RC_PROTOCOL;
         FALLTHROUGH;
+    }
 
     case Stage::RC_PROTOCOL: {
 #if CONFIG_HAL_BOARD != HAL_BOARD_LINUX
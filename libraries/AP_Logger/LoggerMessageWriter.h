@@ -35,10 +35,13 @@ private:
         VER,  // i.e. the "VER" message
         SYSTEM_ID,
         PARAM_SPACE_USED,
+        PARAM_LOAD_TIME,
+        BOOT_TRACE,
         RC_PROTOCOL,
         RC_OUTPUT,
     };
     Stage stage;
+    uint8_t boot_trace_stage;
 };
 
 class LoggerMessageWriter_WriteEntireMission : public LoggerMessageWriter {
@@ -0,0 +1,112 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_HAL/utility/RingBuffer.h>
+#include <AP_Logger/LogFields.h>
+#include <AP_Logger/LogCompression.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  the pieces of the logger write path that run for every message:
+  packing the fields, compressing against the previous message of the
+  same type and copying into the backend ring buffer. The messages
+  are a fixed IMU-like sequence sampled at 400Hz
+ */
+
+#define LOG_BM_MSG_TYPE 200
+#define LOG_BM_NUM_MSGS 256
+
+typedef LogFieldsFormat<uint64_t, float, float, float, float, float, float, uint8_t> IMUFormat;
+
+static uint8_t msgs[LOG_BM_NUM_MSGS][IMUFormat::length];
+
+static void fill_msgs()
+{
+    for (uint16_t i = 0; i < LOG_BM_NUM_MSGS; i++) {
+        const float t = i * 0.0025f;
+        uint8_t *msg = msgs[i];
+        msg[0] = HEAD_BYTE1;
+        msg[1] = HEAD_BYTE2;
+        msg[2] = LOG_BM_MSG_TYPE;
+        IMUFormat::pack(msg, uint64_t(1000000 + i * 2500),
+                        0.1f * sinf(t), -0.05f * cosf(t), 0.02f * sinf(3 * t),
+                        0.3f * cosf(t), -0.2f * sinf(t), -9.8f + 0.1f * sinf(5 * t),
+                        uint8_t(0));
+    }
+}
+
+static void BM_LogFieldsPack(benchmark::State& state)
+{
+    fill_msgs();
+    uint64_t time_us = 1000000;
+
+    while (state.KeepRunning()) {
+        for (uint16_t i = 0; i < LOG_BM_NUM_MSGS; i++) {
+            IMUFormat::pack(msgs[i], time_us, 0.1f, -0.05f, 0.02f, 0.3f, -0.2f, -9.8f, uint8_t(i));
+            time_us += 2500;
+        }
+        gbenchmark_escape(msgs);
+    }
+}
+
+static void BM_LogByteBufferWrite(benchmark::State& state)
+{
+    fill_msgs();
+    ByteBuffer buffer{16384};
+    uint8_t out[IMUFormat::length];
+    uint16_t i = 0;
+
+    while (state.KeepRunning()) {
+        if (buffer.space() < sizeof(msgs[i])) {
+            // drain in blocks, as the backend io thread does
+            while (buffer.read(out, sizeof(out)) == sizeof(out)) {
+            }
+        }
+        buffer.write(msgs[i], sizeof(msgs[i]));
+        i = (i + 1) % LOG_BM_NUM_MSGS;
+    }
+}
+
+#if AP_LOGGER_COMPRESSION_ENABLED
+static void BM_LogCompression(benchmark::State& state)
+{
+    fill_msgs();
+    AP_Logger_Compression compression;
+    compression.reset(AP_Logger_Compression::Method(state.range(0)));
+
+    // the compressor learns the message length and format from its FMT
+    struct log_Format fmt {};
+    fmt.head1 = HEAD_BYTE1;
+    fmt.head2 = HEAD_BYTE2;
+    fmt.msgid = LOG_FORMAT_MSG;
+    fmt.type = LOG_BM_MSG_TYPE;
+    fmt.length = IMUFormat::length;
+    strncpy(fmt.name, "IMUB", sizeof(fmt.name));
+    strncpy(fmt.format, IMUFormat::fmt, sizeof(fmt.format));
+    compression.update((const uint8_t *)&fmt, sizeof(fmt));
+
+    uint16_t i = 0;
+    uint64_t total_in = 0;
+    uint64_t total_out = 0;
+
+    while (state.KeepRunning()) {
+        const uint8_t *out;
+        uint16_t len = compression.compress(msgs[i], sizeof(msgs[i]), out);
+        gbenchmark_escape(&out);
+        total_in += sizeof(msgs[i]);
+        total_out += len > 0 ? len : sizeof(msgs[i]);
+        i = (i + 1) % LOG_BM_NUM_MSGS;
+    }
+    state.counters["ratio"] = total_in > 0 ? double(total_out) / total_in : 0;
+}
+#endif
+
+BENCHMARK(BM_LogFieldsPack);
+BENCHMARK(BM_LogByteBufferWrite);
+#if AP_LOGGER_COMPRESSION_ENABLED
+BENCHMARK(BM_LogCompression)
+    ->Arg(int(AP_Logger_Compression::Method::BYTES))
+    ->Arg(int(AP_Logger_Compression::Method::FIELDS));
+#endif
+
+BENCHMARK_MAIN();
@@ -646,10 +646,11 @@ void SCurve::get_jerk_accel_vel_pos_at_time(float time_now, float &Jt_out, float
     uint8_t pnt = num_segs;
     float Jm, tj, T0, A0, V0, P0;
 
-    // find active segment at time_now
+    // find active segment at time_now, the first segment that ends after it
     for (uint8_t i = 0; i < num_segs; i++) {
-        if (time_now < segment[num_segs - 1 - i].end_time) {
-            pnt = num_segs - 1 - i;
+        if (time_now < segment[i].end_time) {
+            pnt = i;
+            break;
         }
     }
     if (pnt == 0) {
@@ -713,10 +714,16 @@ void SCurve::calc_javp_for_segment_incr_jerk(float time_now, float tj, float Jm,
     }
     const float Alpha = Jm * 0.5f;
     const float Beta = M_PI / tj;
-    Jt = Alpha * (1.0f - cosf(Beta * time_now));
-    At = A0 + Alpha * time_now - (Alpha / Beta) * sinf(Beta * time_now);
-    Vt = V0 + A0 * time_now + (Alpha * 0.5f) * (time_now * time_now) + (Alpha / (Beta * Beta)) * cosf(Beta * time_now) - Alpha / (Beta * Beta);
-    Pt = P0 + V0 * time_now + 0.5f * A0 * (time_now * time_now) + (-Alpha / (Beta * Beta)) * time_now + Alpha * (time_now * time_now * time_now) / 6.0f + (Alpha / (Beta * Beta * Beta)) * sinf(Beta * time_now);
+    // Alpha / Beta^n written as multiples of tj / pi to avoid the divisions
+    const float Alpha_B1 = Alpha * tj * (1.0f / M_PI);
+    const float Alpha_B2 = Alpha_B1 * tj * (1.0f / M_PI);
+    const float Alpha_B3 = Alpha_B2 * tj * (1.0f / M_PI);
+    const float sin_bt = sinf(Beta * time_now);
+    const float cos_bt = cosf(Beta * time_now);
+    Jt = Alpha * (1.0f - cos_bt);
+    At = A0 + Alpha * time_now - Alpha_B1 * sin_bt;
+    Vt = V0 + A0 * time_now + (Alpha * 0.5f) * (time_now * time_now) + Alpha_B2 * cos_bt - Alpha_B2;
+    Pt = P0 + V0 * time_now + 0.5f * A0 * (time_now * time_now) - Alpha_B2 * time_now + Alpha * (time_now * time_now * time_now) * (1.0f / 6.0f) + Alpha_B3 * sin_bt;
 }
 
 // Calculate the jerk, acceleration, velocity and position at time time_now when running the decreasing jerk magnitude time segment based on a raised cosine profile
@@ -731,13 +738,21 @@ void SCurve::calc_javp_for_segment_decr_jerk(float time_now, float tj, float Jm,
     }
     const float Alpha = Jm * 0.5f;
     const float Beta = M_PI / tj;
+    // 1 / Beta^2 and Alpha / Beta^n written as multiples of tj / pi to avoid the divisions
+    const float inv_B2 = sq(tj * (1.0f / M_PI));
+    const float Alpha_B1 = Alpha * tj * (1.0f / M_PI);
+    const float Alpha_B2 = Alpha * inv_B2;
+    const float Alpha_B3 = Alpha_B2 * tj * (1.0f / M_PI);
     const float AT = Alpha * tj;
-    const float VT = Alpha * ((tj * tj) * 0.5f - 2.0f / (Beta * Beta));
-    const float PT = Alpha * ((-1.0f / (Beta * Beta)) * tj + (1.0f / 6.0f) * (tj * tj * tj));
-    Jt = Alpha * (1.0f - cosf(Beta * (time_now + tj)));
-    At = (A0 - AT) + Alpha * (time_now + tj) - (Alpha / Beta) * sinf(Beta * (time_now + tj));
-    Vt = (V0 - VT) + (A0 - AT) * time_now + 0.5f * Alpha * (time_now + tj) * (time_now + tj) + (Alpha / (Beta * Beta)) * cosf(Beta * (time_now + tj)) - Alpha / (Beta * Beta);
-    Pt = (P0 - PT) + (V0 - VT) * time_now + 0.5f * (A0 - AT) * (time_now * time_now) + (-Alpha / (Beta * Beta)) * (time_now + tj) + (Alpha / 6.0f) * (time_now + tj) * (time_now + tj) * (time_now + tj) + (Alpha / (Beta * Beta * Beta)) * sinf(Beta * (time_now + tj));
+    const float VT = Alpha * ((tj * tj) * 0.5f - 2.0f * inv_B2);
+    const float PT = Alpha * (-inv_B2 * tj + (1.0f / 6.0f) * (tj * tj * tj));
+    const float t = time_now + tj;
+    const float sin_bt = sinf(Beta * t);
+    const float cos_bt = cosf(Beta * t);
+    Jt = Alpha * (1.0f - cos_bt);
+    At = (A0 - AT) + Alpha * t - Alpha_B1 * sin_bt;
+    Vt = (V0 - VT) + (A0 - AT) * time_now + 0.5f * Alpha * t * t + Alpha_B2 * cos_bt - Alpha_B2;
+    Pt = (P0 - PT) + (V0 - VT) * time_now + 0.5f * (A0 - AT) * (time_now * time_now) - Alpha_B2 * t + (Alpha * (1.0f / 6.0f)) * t * t * t + Alpha_B3 * sin_bt;
 }
 
 // generate the segments for a path of length L
@@ -0,0 +1,59 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  software CRCs over a log block sized buffer, the baseline for the
+  CRC peripheral on boards that have one
+ */
+
+#define CRC_BUFFER_LEN 512
+
+static void fill(uint8_t *buf)
+{
+    for (uint16_t i = 0; i < CRC_BUFFER_LEN; i++) {
+        buf[i] = i * 37;
+    }
+}
+
+static void BM_CRC32(benchmark::State& state)
+{
+    uint8_t buf[CRC_BUFFER_LEN];
+    fill(buf);
+
+    while (state.KeepRunning()) {
+        uint32_t crc = crc_crc32(0xFFFFFFFF, buf, sizeof(buf));
+        gbenchmark_escape(&crc);
+    }
+}
+
+static void BM_CRC32Small(benchmark::State& state)
+{
+    uint8_t buf[CRC_BUFFER_LEN];
+    fill(buf);
+
+    while (state.KeepRunning()) {
+        uint32_t crc = crc32_small(0xFFFFFFFF, buf, sizeof(buf));
+        gbenchmark_escape(&crc);
+    }
+}
+
+static void BM_CRC16CCITT(benchmark::State& state)
+{
+    uint8_t buf[CRC_BUFFER_LEN];
+    fill(buf);
+
+    while (state.KeepRunning()) {
+        uint16_t crc = crc16_ccitt(buf, sizeof(buf), 0xFFFF);
+        gbenchmark_escape(&crc);
+    }
+}
+
+BENCHMARK(BM_CRC32);
+BENCHMARK(BM_CRC32Small);
+BENCHMARK(BM_CRC16CCITT);
+
+BENCHMARK_MAIN();
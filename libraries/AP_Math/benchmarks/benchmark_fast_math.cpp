@@ -0,0 +1,73 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/fast_math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  compare libm sinf/cosf/atan2f with the fast_math.h approximations
+ */
+
+static void BM_LibmSinCos(benchmark::State& state)
+{
+    float x = 0.3f;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&x);
+        float s = sinf(x);
+        float c = cosf(x);
+        gbenchmark_escape(&s);
+        gbenchmark_escape(&c);
+        x += 0.1f;
+    }
+}
+
+template <FastMathAccuracy A>
+static void BM_FastSinCos(benchmark::State& state)
+{
+    float x = 0.3f;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&x);
+        float s, c;
+        fast_sincosf<A>(x, s, c);
+        gbenchmark_escape(&s);
+        gbenchmark_escape(&c);
+        x += 0.1f;
+    }
+}
+
+static void BM_LibmAtan2(benchmark::State& state)
+{
+    float x = -1.3f, y = 0.7f;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&x);
+        gbenchmark_escape(&y);
+        float a = atan2f(y, x);
+        gbenchmark_escape(&a);
+        x += 0.01f;
+    }
+}
+
+template <FastMathAccuracy A>
+static void BM_FastAtan2(benchmark::State& state)
+{
+    float x = -1.3f, y = 0.7f;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&x);
+        gbenchmark_escape(&y);
+        float a = fast_atan2f<A>(y, x);
+        gbenchmark_escape(&a);
+        x += 0.01f;
+    }
+}
+
+BENCHMARK(BM_LibmSinCos);
+BENCHMARK_TEMPLATE(BM_FastSinCos, FastMathAccuracy::LOW);
+BENCHMARK_TEMPLATE(BM_FastSinCos, FastMathAccuracy::MEDIUM);
+BENCHMARK_TEMPLATE(BM_FastSinCos, FastMathAccuracy::HIGH);
+BENCHMARK(BM_LibmAtan2);
+BENCHMARK_TEMPLATE(BM_FastAtan2, FastMathAccuracy::LOW);
+BENCHMARK_TEMPLATE(BM_FastAtan2, FastMathAccuracy::MEDIUM);
+BENCHMARK_TEMPLATE(BM_FastAtan2, FastMathAccuracy::HIGH);
+
+BENCHMARK_MAIN();
@@ -100,4 +100,24 @@ static void BM_GeodesicGridSections(benchmark::State& state)
 /* Benchmark each section */
 BENCHMARK(BM_GeodesicGridSections)->DenseRange(0, 79);
 
+/* Inclusive lookups of directions spread over the sphere, as done by the
+ * compass calibrator for each sample */
+static void BM_GeodesicGridSectionsSpread(benchmark::State& state)
+{
+    Vector3f v[256];
+    for (unsigned int i = 0; i < ARRAY_SIZE(v); i++) {
+        const float pitch = M_PI * ((i + 0.5f) / ARRAY_SIZE(v) - 0.5f);
+        const float yaw = i * M_GOLDEN * M_2PI;
+        v[i] = Vector3f{cosf(pitch) * cosf(yaw), cosf(pitch) * sinf(yaw), sinf(pitch)};
+    }
+
+    unsigned int i = 0;
+    while (state.KeepRunning()) {
+        int s = AP_GeodesicGrid::section(v[i++ % ARRAY_SIZE(v)], true);
+        gbenchmark_escape(&s);
+    }
+}
+
+BENCHMARK(BM_GeodesicGridSectionsSpread);
+
 BENCHMARK_MAIN();
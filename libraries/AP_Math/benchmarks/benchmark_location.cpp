@@ -0,0 +1,88 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Common/Location.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  compare Location distances from a reference with the LocationFrame
+  projection about it, for a set of 20 rally/obstacle sized offsets
+ */
+
+#define NUM_LOCS 20
+
+static void make_locs(Location &ref, Location *locs)
+{
+    ref = Location(-353632610, 1491652300, 58400, Location::AltFrame::ABSOLUTE);
+    for (uint8_t i = 0; i < NUM_LOCS; i++) {
+        locs[i] = ref;
+        locs[i].offset_bearing(i * 18, 100 + i * 250);
+    }
+}
+
+static void BM_LocationGetDistanceNE(benchmark::State& state)
+{
+    Location ref;
+    Location locs[NUM_LOCS];
+    make_locs(ref, locs);
+
+    while (state.KeepRunning()) {
+        Vector2f ne[NUM_LOCS];
+        for (uint8_t i = 0; i < NUM_LOCS; i++) {
+            ne[i] = ref.get_distance_NE(locs[i]);
+        }
+        gbenchmark_escape(ne);
+    }
+}
+
+static void BM_LocationFrameGetDistanceNE(benchmark::State& state)
+{
+    Location ref;
+    Location locs[NUM_LOCS];
+    make_locs(ref, locs);
+
+    while (state.KeepRunning()) {
+        const LocationFrame frame{ref};
+        Vector2f ne[NUM_LOCS];
+        frame.get_distance_NE(locs, ne, NUM_LOCS);
+        gbenchmark_escape(ne);
+    }
+}
+
+static void BM_LocationOffset(benchmark::State& state)
+{
+    Location ref;
+    Location locs[NUM_LOCS];
+    make_locs(ref, locs);
+
+    while (state.KeepRunning()) {
+        for (uint8_t i = 0; i < NUM_LOCS; i++) {
+            locs[i] = ref;
+            locs[i].offset(i * 10.0f, i * -20.0f);
+        }
+        gbenchmark_escape(locs);
+    }
+}
+
+static void BM_LocationFrameOffset(benchmark::State& state)
+{
+    Location ref;
+    Location locs[NUM_LOCS];
+    make_locs(ref, locs);
+
+    while (state.KeepRunning()) {
+        const LocationFrame frame{ref};
+        for (uint8_t i = 0; i < NUM_LOCS; i++) {
+            locs[i] = frame.offset(i * 10.0f, i * -20.0f);
+        }
+        gbenchmark_escape(locs);
+    }
+}
+
+BENCHMARK(BM_LocationGetDistanceNE);
+BENCHMARK(BM_LocationFrameGetDistanceNE);
+BENCHMARK(BM_LocationOffset);
+BENCHMARK(BM_LocationFrameOffset);
+
+BENCHMARK_MAIN();
@@ -4,21 +4,163 @@
 
 const AP_HAL::HAL& hal = AP_HAL::get_HAL();
 
+/*
+  the float operators use SIMD when AP_MATH_SIMD_ENABLED is set. The
+  Scalar benchmarks run the generic code on the same values for
+  comparison
+ */
+
+static const Matrix3f m1(Vector3f(1.0f, 2.0f, 3.0f),
+                         Vector3f(4.0f, 5.0f, 6.0f),
+                         Vector3f(7.0f, 8.0f, 9.0f));
+static const Matrix3f m2(Vector3f(0.5f, -1.5f, 2.0f),
+                         Vector3f(3.0f, 0.25f, -4.0f),
+                         Vector3f(-2.0f, 7.0f, 1.0f));
+static const Vector3f v1(1.5f, -2.0f, 0.75f);
+static const Quaternion q1(0.8365163f, 0.48296291f, 0.22414387f, -0.12940952f);
+static const Quaternion q2(0.5f, -0.5f, 0.5f, 0.5f);
+
+static Vector3f scalar_mul(const Matrix3f &m, const Vector3f &v)
+{
+    return Vector3f(m.a.x * v.x + m.a.y * v.y + m.a.z * v.z,
+                    m.b.x * v.x + m.b.y * v.y + m.b.z * v.z,
+                    m.c.x * v.x + m.c.y * v.y + m.c.z * v.z);
+}
+
+static Matrix3f scalar_mul(const Matrix3f &m, const Matrix3f &n)
+{
+    return Matrix3f(scalar_mul(n.transposed(), m.a),
+                    scalar_mul(n.transposed(), m.b),
+                    scalar_mul(n.transposed(), m.c));
+}
+
+static Quaternion scalar_mul(const Quaternion &q, const Quaternion &r)
+{
+    return Quaternion(q.q1*r.q1 - q.q2*r.q2 - q.q3*r.q3 - q.q4*r.q4,
+                      q.q1*r.q2 + q.q2*r.q1 + q.q3*r.q4 - q.q4*r.q3,
+                      q.q1*r.q3 - q.q2*r.q4 + q.q3*r.q1 + q.q4*r.q2,
+                      q.q1*r.q4 + q.q2*r.q3 - q.q3*r.q2 + q.q4*r.q1);
+}
+
+static Vector3f scalar_mul(const Quaternion &q, const Vector3f &v)
+{
+    const Vector3f qv(q.q2, q.q3, q.q4);
+    const Vector3f uv = (qv % v) * 2.0f;
+    return v + uv * q.q1 + (qv % uv);
+}
+
 static void BM_MatrixMultiplication(benchmark::State& state)
 {
-    Matrix3f m1(Vector3f(1.0f, 2.0f, 3.0f),
-                Vector3f(4.0f, 5.0f, 6.0f),
-                Vector3f(7.0f, 8.0f, 9.0f));
-    Matrix3f m2(Vector3f(1.0f, 2.0f, 3.0f),
-                Vector3f(4.0f, 5.0f, 6.0f),
-                Vector3f(7.0f, 8.0f, 9.0f));
+    Matrix3f a = m1, b = m2;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&a);
+        gbenchmark_escape(&b);
+        Matrix3f m3 = a * b;
+        gbenchmark_escape(&m3);
+    }
+}
 
+static void BM_MatrixMultiplicationScalar(benchmark::State& state)
+{
+    Matrix3f a = m1, b = m2;
     while (state.KeepRunning()) {
-        Matrix3f m3 = m1 * m2;
+        gbenchmark_escape(&a);
+        gbenchmark_escape(&b);
+        Matrix3f m3 = scalar_mul(a, b);
         gbenchmark_escape(&m3);
     }
 }
 
+static void BM_MatrixVector(benchmark::State& state)
+{
+    Matrix3f m = m1;
+    Vector3f v = v1;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        gbenchmark_escape(&v);
+        Vector3f r = m * v;
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_MatrixVectorScalar(benchmark::State& state)
+{
+    Matrix3f m = m1;
+    Vector3f v = v1;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        gbenchmark_escape(&v);
+        Vector3f r = scalar_mul(m, v);
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_MatrixTransposeVector(benchmark::State& state)
+{
+    Matrix3f m = m1;
+    Vector3f v = v1;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        gbenchmark_escape(&v);
+        Vector3f r = m.mul_transpose(v);
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_QuaternionMultiplication(benchmark::State& state)
+{
+    Quaternion a = q1, b = q2;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&a);
+        gbenchmark_escape(&b);
+        Quaternion r = a * b;
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_QuaternionMultiplicationScalar(benchmark::State& state)
+{
+    Quaternion a = q1, b = q2;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&a);
+        gbenchmark_escape(&b);
+        Quaternion r = scalar_mul(a, b);
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_QuaternionRotation(benchmark::State& state)
+{
+    Quaternion q = q1;
+    Vector3f v = v1;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&q);
+        gbenchmark_escape(&v);
+        Vector3f r = q * v;
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_QuaternionRotationScalar(benchmark::State& state)
+{
+    Quaternion q = q1;
+    Vector3f v = v1;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&q);
+        gbenchmark_escape(&v);
+        Vector3f r = scalar_mul(q, v);
+        gbenchmark_escape(&r);
+    }
+}
+
 BENCHMARK(BM_MatrixMultiplication);
+BENCHMARK(BM_MatrixMultiplicationScalar);
+BENCHMARK(BM_MatrixVector);
+BENCHMARK(BM_MatrixVectorScalar);
+BENCHMARK(BM_MatrixTransposeVector);
+BENCHMARK(BM_QuaternionMultiplication);
+BENCHMARK(BM_QuaternionMultiplicationScalar);
+BENCHMARK(BM_QuaternionRotation);
+BENCHMARK(BM_QuaternionRotationScalar);
 
 BENCHMARK_MAIN();
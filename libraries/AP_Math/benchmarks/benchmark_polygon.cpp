@@ -0,0 +1,82 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  the fence and path planner geometry kernels, run against a fixed 16
+  point closed fence polygon in NE metres. The test points and path
+  segments sweep across the fence so both inside and outside branches
+  are exercised
+ */
+
+#define FENCE_NUM_POINTS 16
+#define NUM_TESTS 32
+
+static Vector2f fence[FENCE_NUM_POINTS + 1];
+static Vector2f points[NUM_TESTS];
+
+static void make_fence()
+{
+    for (uint8_t i = 0; i < FENCE_NUM_POINTS; i++) {
+        const float angle = M_2PI * i / FENCE_NUM_POINTS;
+        // star shaped so the polygon is not convex
+        const float radius = (i & 1) ? 300.0f : 500.0f;
+        fence[i] = Vector2f{radius * cosf(angle), radius * sinf(angle)};
+    }
+    // closed polygon, last point equals the first
+    fence[FENCE_NUM_POINTS] = fence[0];
+
+    for (uint8_t i = 0; i < NUM_TESTS; i++) {
+        const float angle = M_2PI * i / NUM_TESTS;
+        const float radius = 50.0f + i * 20.0f;
+        points[i] = Vector2f{radius * cosf(angle), radius * sinf(angle)};
+    }
+}
+
+static void BM_PolygonOutside(benchmark::State& state)
+{
+    make_fence();
+
+    while (state.KeepRunning()) {
+        uint8_t outside = 0;
+        for (uint8_t i = 0; i < NUM_TESTS; i++) {
+            outside += Polygon_outside(points[i], fence, FENCE_NUM_POINTS + 1);
+        }
+        gbenchmark_escape(&outside);
+    }
+}
+
+static void BM_PolygonIntersects(benchmark::State& state)
+{
+    make_fence();
+
+    while (state.KeepRunning()) {
+        uint8_t intersects = 0;
+        for (uint8_t i = 0; i < NUM_TESTS; i++) {
+            Vector2f intersection;
+            intersects += Polygon_intersects(fence, FENCE_NUM_POINTS + 1, points[i], points[(i + NUM_TESTS/2) % NUM_TESTS], intersection);
+        }
+        gbenchmark_escape(&intersects);
+    }
+}
+
+static void BM_PolygonClosestDistanceLine(benchmark::State& state)
+{
+    make_fence();
+
+    while (state.KeepRunning()) {
+        float dist = 0;
+        for (uint8_t i = 0; i < NUM_TESTS; i++) {
+            dist += Polygon_closest_distance_line(fence, FENCE_NUM_POINTS + 1, points[i], points[(i + 1) % NUM_TESTS]);
+        }
+        gbenchmark_escape(&dist);
+    }
+}
+
+BENCHMARK(BM_PolygonOutside);
+BENCHMARK(BM_PolygonIntersects);
+BENCHMARK(BM_PolygonClosestDistanceLine);
+
+BENCHMARK_MAIN();
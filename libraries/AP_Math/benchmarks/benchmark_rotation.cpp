@@ -0,0 +1,88 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  compare rotating a sample with Vector3::rotate() against a
+  FastRotation resolved once for the same rotation
+ */
+
+static void BM_RotateSwitch(benchmark::State& state)
+{
+    const enum Rotation rotation = (enum Rotation)state.range(0);
+    Vector3f v(1.5f, -2.0f, 9.81f);
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        v.rotate(rotation);
+        gbenchmark_escape(&v);
+    }
+}
+
+static void BM_RotateFast(benchmark::State& state)
+{
+    const FastRotation rotation = (enum Rotation)state.range(0);
+    Vector3f v(1.5f, -2.0f, 9.81f);
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        rotation.rotate(v);
+        gbenchmark_escape(&v);
+    }
+}
+
+/*
+  sensor orientations and the board orientation applied in turn, as
+  when samples from several IMUs are processed
+ */
+static const enum Rotation mixed[] {
+    ROTATION_YAW_270, ROTATION_NONE, ROTATION_ROLL_180_YAW_90, ROTATION_NONE,
+    ROTATION_YAW_180, ROTATION_NONE, ROTATION_PITCH_180, ROTATION_YAW_90,
+    ROTATION_NONE, ROTATION_ROLL_180,
+};
+
+static void BM_RotateSwitchMixed(benchmark::State& state)
+{
+    Vector3f v(1.5f, -2.0f, 9.81f);
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        v.rotate(mixed[i]);
+        gbenchmark_escape(&v);
+        i = (i + 1) % ARRAY_SIZE(mixed);
+    }
+}
+
+static void BM_RotateFastMixed(benchmark::State& state)
+{
+    FastRotation rotations[ARRAY_SIZE(mixed)];
+    for (uint8_t i=0; i<ARRAY_SIZE(mixed); i++) {
+        rotations[i] = mixed[i];
+    }
+    Vector3f v(1.5f, -2.0f, 9.81f);
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        rotations[i].rotate(v);
+        gbenchmark_escape(&v);
+        i = (i + 1) % ARRAY_SIZE(mixed);
+    }
+}
+
+BENCHMARK(BM_RotateSwitch)
+    ->Arg(ROTATION_NONE)
+    ->Arg(ROTATION_YAW_270)
+    ->Arg(ROTATION_ROLL_180_YAW_90)
+    ->Arg(ROTATION_YAW_45)
+    ->Arg(ROTATION_PITCH_7);
+BENCHMARK(BM_RotateFast)
+    ->Arg(ROTATION_NONE)
+    ->Arg(ROTATION_YAW_270)
+    ->Arg(ROTATION_ROLL_180_YAW_90)
+    ->Arg(ROTATION_YAW_45)
+    ->Arg(ROTATION_PITCH_7);
+
+BENCHMARK(BM_RotateSwitchMixed);
+BENCHMARK(BM_RotateFastMixed);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,54 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/segment_fan.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// margins of a fan of probes from 100 obstacles, one probe at a time
+static void BM_SegmentFanScalar(benchmark::State& state)
+{
+    Vector3f ends[SegmentFan::MAX_SEGMENTS];
+    for (uint8_t i = 0; i < SegmentFan::MAX_SEGMENTS; i++) {
+        ends[i] = Vector3f(15.0f * cosf(radians(i * 5)), 15.0f * sinf(radians(i * 5)), 0.0f);
+    }
+
+    while (state.KeepRunning()) {
+        float margins[SegmentFan::MAX_SEGMENTS];
+        for (uint8_t i = 0; i < SegmentFan::MAX_SEGMENTS; i++) {
+            margins[i] = FLT_MAX;
+            for (uint8_t j = 0; j < 100; j++) {
+                const Vector3f p(j * 0.3f, 10.0f - j * 0.2f, 0.0f);
+                margins[i] = MIN(margins[i], Vector3f::closest_distance_between_line_and_point(Vector3f(), ends[i], p) - 0.5f);
+            }
+        }
+        gbenchmark_escape(margins);
+    }
+}
+
+// margins of a fan of probes from 100 obstacles, all probes at once
+static void BM_SegmentFanBatch(benchmark::State& state)
+{
+    SegmentFan fan;
+    fan.init(Vector3f());
+    for (uint8_t i = 0; i < SegmentFan::MAX_SEGMENTS; i++) {
+        fan.add(Vector3f(15.0f * cosf(radians(i * 5)), 15.0f * sinf(radians(i * 5)), 0.0f));
+    }
+
+    while (state.KeepRunning()) {
+        float margins[SegmentFan::MAX_SEGMENTS];
+        for (uint8_t i = 0; i < SegmentFan::MAX_SEGMENTS; i++) {
+            margins[i] = FLT_MAX;
+        }
+        for (uint8_t j = 0; j < 100; j++) {
+            const Vector3f p(j * 0.3f, 10.0f - j * 0.2f, 0.0f);
+            fan.update_margins(p, 0.5f, margins);
+        }
+        gbenchmark_escape(margins);
+    }
+}
+
+BENCHMARK(BM_SegmentFanScalar);
+BENCHMARK(BM_SegmentFanBatch);
+
+BENCHMARK_MAIN();
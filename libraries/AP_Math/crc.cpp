@@ -21,6 +21,27 @@
 
 #include <AP_HAL/AP_HAL_Boards.h>
 
+/*
+  crc_crc32() and crc16_ccitt() use the CRC peripheral, if the board
+  has one, for buffers long enough to be worth setting it up
+ */
+#ifndef AP_CRC_HW_ENABLED
+#if defined(HAL_USE_HW_CRC) && !defined(HAL_BOOTLOADER_BUILD)
+#define AP_CRC_HW_ENABLED HAL_USE_HW_CRC
+#else
+#define AP_CRC_HW_ENABLED 0
+#endif
+#endif
+
+#ifndef AP_CRC_HW_MIN_LENGTH
+#define AP_CRC_HW_MIN_LENGTH 32
+#endif
+
+#if AP_CRC_HW_ENABLED
+#include <AP_HAL/AP_HAL.h>
+extern const AP_HAL::HAL& hal;
+#endif
+
 /**
  * crc4 method from datasheet for 16 bytes (8 short values)
  * 
@@ -352,6 +373,11 @@ static const uint32_t crc32_tab[] = {
 
 uint32_t crc_crc32(uint32_t crc, const uint8_t *buf, uint32_t size)
 {
+#if AP_CRC_HW_ENABLED
+	if (size >= AP_CRC_HW_MIN_LENGTH && hal.util->crc32_hw(crc, buf, size)) {
+		return crc;
+	}
+#endif
 	for (uint32_t i=0; i<size; i++) {
 		crc = crc32_tab[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
 	}
@@ -423,6 +449,11 @@ static const uint16_t crc16tab[256] = {
 
 uint16_t crc16_ccitt(const uint8_t *buf, uint32_t len, uint16_t crc)
 {
+#if AP_CRC_HW_ENABLED
+    if (len >= AP_CRC_HW_MIN_LENGTH && hal.util->crc16_ccitt_hw(crc, buf, len)) {
+        return crc;
+    }
+#endif
     for (uint32_t i = 0; i < len; i++) {
         crc = (crc << 8) ^ crc16tab[((crc >> 8) ^ *buf++) & 0x00FF];
     }
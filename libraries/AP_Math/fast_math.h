@@ -0,0 +1,161 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  polynomial approximations of float trig functions for inner loops
+  that do not need full libm accuracy. The accuracy is chosen at each
+  call site with a template argument, so only the polynomial needed is
+  compiled in. Maximum absolute errors, checked in
+  tests/test_fast_math.cpp:
+
+                  sin/cos    atan2
+    LOW           2e-4       7e-4
+    MEDIUM        1e-6       2e-6
+    HIGH          3e-7       3e-7   (within a few ulp of libm)
+
+  sin and cos are reduced to [-pi/4, pi/4] with a three part pi/2, so
+  the errors hold for |x| up to about 1e4. Larger angles should be
+  wrapped first.
+ */
+
+#include <stdint.h>
+#include <math.h>
+
+enum class FastMathAccuracy : uint8_t {
+    LOW,
+    MEDIUM,
+    HIGH,
+};
+
+namespace AP_FastMath {
+
+// sin(r) for |r| <= pi/4
+template <FastMathAccuracy A>
+static inline float sin_poly(float r)
+{
+    const float r2 = r * r;
+    if (A == FastMathAccuracy::LOW) {
+        return r * (0.99903142f + r2 * -0.16034397f);
+    }
+    if (A == FastMathAccuracy::MEDIUM) {
+        return r * (0.99999500f + r2 * (-0.16660162f + r2 * 0.0081215572f));
+    }
+    return r * (1.0f + r2 * (-0.16666637f + r2 * (0.0083315847f + r2 * -0.00019462121f)));
+}
+
+// cos(r) for |r| <= pi/4
+template <FastMathAccuracy A>
+static inline float cos_poly(float r)
+{
+    const float r2 = r * r;
+    if (A == FastMathAccuracy::LOW) {
+        return 0.99999007f + r2 * (-0.49970837f + r2 * 0.040398829f);
+    }
+    if (A == FastMathAccuracy::MEDIUM) {
+        return 0.99999997f + r2 * (-0.49999857f + r2 * (0.041655031f + r2 * -0.0013585948f));
+    }
+    return 1.0f + r2 * (-0.5f + r2 * (0.041666617f + r2 * (-0.0013886615f + r2 * 2.4379620e-05f)));
+}
+
+// atan(z) for 0 <= z <= 1
+template <FastMathAccuracy A>
+static inline float atan_poly(float z)
+{
+    const float z2 = z * z;
+    if (A == FastMathAccuracy::LOW) {
+        return z * (0.99535785f + z2 * (-0.28868954f + z2 * 0.079338296f));
+    }
+    if (A == FastMathAccuracy::MEDIUM) {
+        return z * (0.99997722f + z2 * (-0.33262282f + z2 * (0.19354029f + z2 * (-0.11642624f +
+                    z2 * (0.052647060f + z2 * -0.011719014f)))));
+    }
+    return z * (0.99999933f + z2 * (-0.33329856f + z2 * (0.19946513f + z2 * (-0.13908382f +
+                z2 * (0.096415956f + z2 * (-0.055904492f + z2 * (0.021857756f + z2 * -0.0040531843f)))))));
+}
+
+} // namespace AP_FastMath
+
+/*
+  sin and cos of x together, sharing the range reduction
+ */
+template <FastMathAccuracy A>
+static inline void fast_sincosf(float x, float &s, float &c)
+{
+    // x = k*pi/2 + r with |r| <= pi/4. pi/2 is split in three so the
+    // first two products are exact for the supported range of k
+    const int32_t k = int32_t(x * float(2/M_PI) + (x >= 0 ? 0.5f : -0.5f));
+    const float fk = k;
+    const float r = ((x - fk * 1.5703125f) - fk * 4.8375129699707031e-4f) - fk * 7.5497899548918822e-8f;
+    const float sr = AP_FastMath::sin_poly<A>(r);
+    const float cr = AP_FastMath::cos_poly<A>(r);
+    switch (k & 3) {
+    case 0:
+        s = sr;
+        c = cr;
+        break;
+    case 1:
+        s = cr;
+        c = -sr;
+        break;
+    case 2:
+        s = -sr;
+        c = -cr;
+        break;
+    default:
+        s = -cr;
+        c = sr;
+        break;
+    }
+}
+
+template <FastMathAccuracy A>
+static inline float fast_sinf(float x)
+{
+    float s, c;
+    fast_sincosf<A>(x, s, c);
+    return s;
+}
+
+template <FastMathAccuracy A>
+static inline float fast_cosf(float x)
+{
+    float s, c;
+    fast_sincosf<A>(x, s, c);
+    return c;
+}
+
+/*
+  atan2(y, x), returns 0 when both are zero
+ */
+template <FastMathAccuracy A>
+static inline float fast_atan2f(float y, float x)
+{
+    const float ax = fabsf(x);
+    const float ay = fabsf(y);
+    const float mx = ay > ax ? ay : ax;
+    const float mn = ay > ax ? ax : ay;
+    if (!(mx > 0)) {
+        return 0;
+    }
+    float a = AP_FastMath::atan_poly<A>(mn / mx);
+    if (ay > ax) {
+        a = float(M_PI_2) - a;
+    }
+    if (x < 0) {
+        a = float(M_PI) - a;
+    }
+    return y < 0 ? -a : a;
+}
@@ -0,0 +1,60 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Math.h"
+#include "fast_rotation.h"
+
+void FastRotation::set(enum Rotation _rotation)
+{
+    rotation = _rotation;
+    if (rotation >= ROTATION_MAX) {
+        // custom rotations can change, invalid ones raise an internal error
+        type = Type::GENERIC;
+        return;
+    }
+
+    // the columns of the matrix are the rotated unit vectors
+    Vector3f x_vec(1, 0, 0);
+    Vector3f y_vec(0, 1, 0);
+    Vector3f z_vec(0, 0, 1);
+    x_vec.rotate(rotation);
+    y_vec.rotate(rotation);
+    z_vec.rotate(rotation);
+    m = Matrix3f(x_vec.x, y_vec.x, z_vec.x,
+                 x_vec.y, y_vec.y, z_vec.y,
+                 x_vec.z, y_vec.z, z_vec.z);
+
+    // axis swaps and sign changes have a single +-1 in each row
+    type = Type::PERMUTATION;
+    for (uint8_t i=0; i<3; i++) {
+        uint8_t count = 0;
+        for (uint8_t j=0; j<3; j++) {
+            const float v = m[i][j];
+            if (is_zero(v)) {
+                continue;
+            }
+            if (!is_equal(fabsf(v), 1.0f)) {
+                count = 0;
+                break;
+            }
+            index[i] = j;
+            count++;
+        }
+        if (count != 1) {
+            type = Type::MATRIX;
+            break;
+        }
+    }
+}
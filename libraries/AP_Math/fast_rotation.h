@@ -0,0 +1,79 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "rotations.h"
+#include "vector3.h"
+#include "matrix3.h"
+
+/*
+  a standard rotation resolved once, when it is set, into a form that
+  is applied per sample without the large switch in
+  Vector3::rotate(). Most sensor orientations are axis swaps and sign
+  changes, these are applied as a permutation and give the same result
+  as Vector3::rotate(). Other fixed rotations are applied as a matrix
+  multiply, and custom rotations are passed to Vector3::rotate() as
+  they can change at runtime.
+
+  It converts to and from enum Rotation so it can replace an enum
+  Rotation member. Setting it is not atomic with respect to a rotate()
+  on another thread.
+ */
+class FastRotation {
+public:
+    FastRotation(enum Rotation _rotation = ROTATION_NONE) {
+        set(_rotation);
+    }
+
+    FastRotation &operator=(enum Rotation _rotation) {
+        set(_rotation);
+        return *this;
+    }
+
+    operator enum Rotation() const {
+        return rotation;
+    }
+
+    void set(enum Rotation _rotation);
+
+    void rotate(Vector3f &v) const {
+        switch (type) {
+        case Type::PERMUTATION:
+            v = Vector3f(m.a[index[0]] * v[index[0]],
+                         m.b[index[1]] * v[index[1]],
+                         m.c[index[2]] * v[index[2]]);
+            return;
+        case Type::MATRIX:
+            v = m * v;
+            return;
+        case Type::GENERIC:
+            v.rotate(rotation);
+            return;
+        }
+    }
+
+private:
+    enum class Type : uint8_t {
+        PERMUTATION,    // each output is +-1 times one input
+        MATRIX,
+        GENERIC,        // use Vector3::rotate()
+    };
+
+    enum Rotation rotation;
+    Type type;
+    // for a permutation, the input axis used for each output axis
+    uint8_t index[3];
+    Matrix3f m;
+};
@@ -251,6 +251,47 @@ void Matrix3<T>::from_axis_angle(const Vector3<T> &v, T theta)
     c.z = t*z*z + C;
 }
 
+#if AP_MATH_SIMD_ENABLED
+using namespace AP_Math_SIMD;
+
+static_assert(sizeof(Matrix3<float>) == 9 * sizeof(float), "Matrix3f must be 9 packed floats");
+
+template <>
+Vector3<float> Matrix3<float>::operator *(const Vector3<float> &v) const
+{
+    f32x4 r0, r1, r2;
+    load_rows3(&a.x, r0, r1, r2);
+    const f32x4 vv = set(v.x, v.y, v.z, 0);
+    float ret[4];
+    store(ret, sum3_transposed(mul(r0, vv), mul(r1, vv), mul(r2, vv)));
+    return Vector3<float>(ret[0], ret[1], ret[2]);
+}
+
+template <>
+Vector3<float> Matrix3<float>::mul_transpose(const Vector3<float> &v) const
+{
+    f32x4 r0, r1, r2;
+    load_rows3(&a.x, r0, r1, r2);
+    float ret[4];
+    store(ret, add(add(mul(r0, dup(v.x)), mul(r1, dup(v.y))), mul(r2, dup(v.z))));
+    return Vector3<float>(ret[0], ret[1], ret[2]);
+}
+
+template <>
+Matrix3<float> Matrix3<float>::operator *(const Matrix3<float> &m) const
+{
+    // each row of the result is the rows of m weighted by a row of this
+    f32x4 m0, m1, m2;
+    load_rows3(&m.a.x, m0, m1, m2);
+    float ret[3][4];
+    store(ret[0], add(add(mul(dup(a.x), m0), mul(dup(a.y), m1)), mul(dup(a.z), m2)));
+    store(ret[1], add(add(mul(dup(b.x), m0), mul(dup(b.y), m1)), mul(dup(b.z), m2)));
+    store(ret[2], add(add(mul(dup(c.x), m0), mul(dup(c.y), m1)), mul(dup(c.z), m2)));
+    return Matrix3<float>(ret[0][0], ret[0][1], ret[0][2],
+                          ret[1][0], ret[1][1], ret[1][2],
+                          ret[2][0], ret[2][1], ret[2][2]);
+}
+#endif  // AP_MATH_SIMD_ENABLED
 
 // define for float and double
 template class Matrix3<float>;
@@ -41,6 +41,7 @@
 
 #include "vector3.h"
 #include "vector2.h"
+#include "simd.h"
 
 template <typename T>
 class Vector3;
@@ -284,6 +285,13 @@ public:
     }
 };
 
+#if AP_MATH_SIMD_ENABLED
+// SIMD versions of the float operations, see simd.h
+template <> Vector3<float> Matrix3<float>::operator *(const Vector3<float> &v) const;
+template <> Vector3<float> Matrix3<float>::mul_transpose(const Vector3<float> &v) const;
+template <> Matrix3<float> Matrix3<float>::operator *(const Matrix3<float> &m) const;
+#endif
+
 typedef Matrix3<int16_t>                Matrix3i;
 typedef Matrix3<uint16_t>               Matrix3ui;
 typedef Matrix3<int32_t>                Matrix3l;
@@ -47,7 +47,7 @@ template <typename T, uint8_t N>
 void MatrixN<T,N>::force_symmetry(void)
 {
     for (uint8_t i = 0; i < N; i++) {
-        for (uint8_t j = 0; j < (i - 1); j++) {
+        for (uint8_t j = 0; j < i; j++) {
             v[i][j] = (v[i][j] + v[j][i]) / 2;
             v[j][i] = v[i][j];
         }
@@ -58,3 +58,6 @@ template void MatrixN<float,4>::mult(const VectorN<float,4> &A, const VectorN<fl
 template MatrixN<float,4> &MatrixN<float,4>::operator -=(const MatrixN<float,4> &B);
 template MatrixN<float,4> &MatrixN<float,4>::operator +=(const MatrixN<float,4> &B);
 template void MatrixN<float,4>::force_symmetry(void);
+
+template void MatrixN<float,3>::force_symmetry(void);
+template void MatrixN<double,3>::force_symmetry(void);
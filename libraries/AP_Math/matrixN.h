@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include "math.h"
+#include <cmath>
 #include <stdint.h>
 #include "vectorN.h"
 
@@ -18,6 +18,9 @@ class MatrixN {
     friend class VectorN<T,N>;
 
 public:
+    static constexpr uint8_t rows = N;
+    static constexpr uint8_t cols = N;
+
     // constructor from zeros
     MatrixN(void) {
         memset(v, 0, sizeof(v));        
@@ -31,6 +34,15 @@ public:
         }
     }
 
+    // allow a matrix to be indexed as M[i][j]
+    T *operator[](uint8_t i) {
+        return v[i];
+    }
+
+    const T *operator[](uint8_t i) const {
+        return v[i];
+    }
+
     // multiply two vectors to give a matrix, in-place
     void mult(const VectorN<T,N> &A, const VectorN<T,N> &B);
 
@@ -43,6 +55,95 @@ public:
     // Matrix symmetry routine
     void force_symmetry(void);
 
+    /*
+      the fused operations below are defined in the header so the
+      loops over the constant dimensions are unrolled where they are
+      used. Each symmetric result is calculated on the upper triangle
+      and mirrored
+     */
+
+    // set to A * B * transpose(A), for a symmetric B
+    void mult_ABAt(const MatrixN<T,N> &A, const MatrixN<T,N> &B) {
+        T AB[N][N];
+        for (uint8_t i = 0; i < N; i++) {
+            for (uint8_t k = 0; k < N; k++) {
+                T sum = 0;
+                for (uint8_t j = 0; j < N; j++) {
+                    sum += A.v[i][j] * B.v[j][k];
+                }
+                AB[i][k] = sum;
+            }
+        }
+        for (uint8_t i = 0; i < N; i++) {
+            for (uint8_t j = i; j < N; j++) {
+                T sum = 0;
+                for (uint8_t k = 0; k < N; k++) {
+                    sum += AB[i][k] * A.v[j][k];
+                }
+                v[i][j] = v[j][i] = sum;
+            }
+        }
+    }
+
+    /*
+      symmetric rank M update, subtract A * B * transpose(A) where A is
+      N x M and B is a symmetric M x M matrix. This is the P - K*S*K'
+      covariance update of a Kalman filter fusing M observations
+     */
+    template <uint8_t M>
+    void sub_ABAt(const T (&A)[N][M], const T (&B)[M][M]) {
+        T AB[N][M];
+        for (uint8_t i = 0; i < N; i++) {
+            for (uint8_t k = 0; k < M; k++) {
+                T sum = 0;
+                for (uint8_t j = 0; j < M; j++) {
+                    sum += A[i][j] * B[j][k];
+                }
+                AB[i][k] = sum;
+            }
+        }
+        for (uint8_t i = 0; i < N; i++) {
+            for (uint8_t j = i; j < N; j++) {
+                T sum = 0;
+                for (uint8_t k = 0; k < M; k++) {
+                    sum += AB[i][k] * A[j][k];
+                }
+                v[i][j] -= sum;
+                v[j][i] = v[i][j];
+            }
+        }
+    }
+
+    /*
+      Cholesky decomposition of a symmetric positive definite matrix,
+      sets L to the lower triangular matrix with L * transpose(L) equal
+      to this matrix. Returns false if the matrix is not positive
+      definite
+     */
+    bool cholesky(MatrixN<T,N> &L) const {
+        for (uint8_t j = 0; j < N; j++) {
+            T d = v[j][j];
+            for (uint8_t k = 0; k < j; k++) {
+                d -= L.v[j][k] * L.v[j][k];
+            }
+            if (!(d > 0)) {
+                return false;
+            }
+            const T Ljj = std::sqrt(d);
+            const T Ljj_inv = 1 / Ljj;
+            L.v[j][j] = Ljj;
+            for (uint8_t i = j + 1; i < N; i++) {
+                T sum = v[i][j];
+                for (uint8_t k = 0; k < j; k++) {
+                    sum -= L.v[i][k] * L.v[j][k];
+                }
+                L.v[i][j] = sum * Ljj_inv;
+                L.v[j][i] = 0;
+            }
+        }
+        return true;
+    }
+
 private:
     T v[N][N];
 };
@@ -228,3 +228,41 @@ bool Polygon_closest_distance_point(const Vector2f *V, unsigned N, const Vector2
     closest = sqrtf(closest_sq);
     return true;
 }
+
+/*
+  calculate the bounds of the polygon V, defined by N points
+ */
+void Polygon_bounds(const Vector2f *V, unsigned N, Polygon_Bounds &bounds)
+{
+    if (N == 0) {
+        bounds.min.zero();
+        bounds.max.zero();
+        return;
+    }
+    bounds.min = bounds.max = V[0];
+    for (unsigned i=1; i<N; i++) {
+        bounds.min.x = MIN(bounds.min.x, V[i].x);
+        bounds.min.y = MIN(bounds.min.y, V[i].y);
+        bounds.max.x = MAX(bounds.max.x, V[i].x);
+        bounds.max.y = MAX(bounds.max.y, V[i].y);
+    }
+}
+
+bool Polygon_Bounds::contains(const Vector2f &p) const
+{
+    return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+}
+
+float Polygon_Bounds::distance(const Vector2f &p) const
+{
+    const float dx = MAX(MAX(min.x - p.x, p.x - max.x), 0.0f);
+    const float dy = MAX(MAX(min.y - p.y, p.y - max.y), 0.0f);
+    return norm(dx, dy);
+}
+
+float Polygon_Bounds::distance(const Polygon_Bounds &b) const
+{
+    const float dx = MAX(MAX(min.x - b.max.x, b.min.x - max.x), 0.0f);
+    const float dy = MAX(MAX(min.y - b.max.y, b.min.y - max.y), 0.0f);
+    return norm(dx, dy);
+}
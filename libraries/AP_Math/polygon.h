@@ -44,4 +44,28 @@ float Polygon_closest_distance_line(const Vector2f *V, unsigned N, const Vector2
   closed polygon V, defined by N points of cartesian. Returns true if successful, false otherwise
  */
  bool Polygon_closest_distance_point(const Vector2f *V, unsigned N, const Vector2f &p, float& closest);
+
+/*
+  axis aligned bounding box of a polygon. The distance to the box is
+  never more than the distance to the polygon, so it can be used to
+  skip polygons which can't be closer than a distance already found
+ */
+struct Polygon_Bounds {
+    Vector2f min;
+    Vector2f max;
+
+    // true if point p is within the bounds
+    bool contains(const Vector2f &p) const;
+
+    // distance from point p to the bounds, zero if p is within them
+    float distance(const Vector2f &p) const;
+
+    // distance between these bounds and b, zero if they overlap
+    float distance(const Polygon_Bounds &b) const;
+};
+
+/*
+  calculate the bounds of the polygon V, defined by N points
+ */
+void Polygon_bounds(const Vector2f *V, unsigned N, Polygon_Bounds &bounds);
  
\ No newline at end of file
@@ -772,6 +772,56 @@ QuaternionT<T> &QuaternionT<T>::operator*=(const QuaternionT<T> &v)
     return *this;
 }
 
+#if AP_MATH_SIMD_ENABLED
+using namespace AP_Math_SIMD;
+
+static_assert(sizeof(QuaternionT<float>) == 4 * sizeof(float), "Quaternion must be 4 packed floats");
+
+/*
+  the product as the four rows of the scalar version, each lane
+  holding one component
+ */
+static inline f32x4 quaternion_product(const float *q, const float *r)
+{
+    const f32x4 v = load(r);
+    // w2 x2 y2 z2 reordered to line up with x1, y1 and z1
+    const f32x4 px = mul(swap_pairs(v), set(-1, 1, -1, 1));
+    const f32x4 py = mul(swap_halves(v), set(-1, 1, 1, -1));
+    const f32x4 pz = mul(reverse(v), set(-1, -1, 1, 1));
+    return add(add(add(mul(dup(q[0]), v), mul(dup(q[1]), px)), mul(dup(q[2]), py)), mul(dup(q[3]), pz));
+}
+
+template <>
+QuaternionT<float> QuaternionT<float>::operator*(const QuaternionT<float> &v) const
+{
+    QuaternionT<float> ret;
+    store(&ret.q1, quaternion_product(&q1, &v.q1));
+    return ret;
+}
+
+template <>
+QuaternionT<float> &QuaternionT<float>::operator*=(const QuaternionT<float> &v)
+{
+    store(&q1, quaternion_product(&q1, &v.q1));
+    return *this;
+}
+
+template <>
+Vector3<float> QuaternionT<float>::operator*(const Vector3<float> &v) const
+{
+    // same formula as the scalar version, with the cross products
+    // done as lane rotations
+    const f32x4 qv = shift_down(load(&q1));
+    const f32x4 vv = set(v.x, v.y, v.z, 0);
+    f32x4 uv = sub(mul(yzx(qv), zxy(vv)), mul(zxy(qv), yzx(vv)));
+    uv = add(uv, uv);
+    const f32x4 r = sub(add(mul(dup(q1), uv), mul(yzx(qv), zxy(uv))), mul(zxy(qv), yzx(uv)));
+    float ret[4];
+    store(ret, add(vv, r));
+    return Vector3<float>(ret[0], ret[1], ret[2]);
+}
+#endif  // AP_MATH_SIMD_ENABLED
+
 template <typename T>
 QuaternionT<T> QuaternionT<T>::operator/(const QuaternionT<T> &v) const
 {
@@ -200,6 +200,13 @@ public:
     }
 };
 
+#if AP_MATH_SIMD_ENABLED
+// SIMD versions of the float operations, see simd.h
+template <> QuaternionT<float> QuaternionT<float>::operator*(const QuaternionT<float> &v) const;
+template <> Vector3<float> QuaternionT<float>::operator*(const Vector3<float> &v) const;
+template <> QuaternionT<float> &QuaternionT<float>::operator*=(const QuaternionT<float> &v);
+#endif
+
 typedef QuaternionT<float> Quaternion;
 typedef QuaternionT<double> QuaternionD;
 
@@ -0,0 +1,63 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Math.h"
+#include "segment_fan.h"
+
+#pragma GCC optimize("O2")
+
+// remove all segments and set the common start point
+void SegmentFan::init(const Vector3f &start)
+{
+    _start = start;
+    _count = 0;
+}
+
+// add a segment from the start point to end, returns false if full
+bool SegmentFan::add(const Vector3f &end)
+{
+    if (_count >= MAX_SEGMENTS) {
+        return false;
+    }
+    const Vector3f line_vec = end - _start;
+    const float length_sq = line_vec.length_squared();
+    _dx[_count] = line_vec.x;
+    _dy[_count] = line_vec.y;
+    _dz[_count] = line_vec.z;
+    _inv_length_sq[_count] = is_positive(length_sq) ? 1.0f / length_sq : 0.0f;
+    _count++;
+    return true;
+}
+
+// for each segment reduce margins[i] to the closest distance
+// between the segment and point p less offset, if that is smaller
+void SegmentFan::update_margins(const Vector3f &p, float offset, float margins[]) const
+{
+    const float px = p.x - _start.x;
+    const float py = p.y - _start.y;
+    const float pz = p.z - _start.z;
+
+    // no branches or calls in this loop so it can be vectorised
+    for (uint8_t i = 0; i < _count; i++) {
+        // proportion of the way along the segment of the point closest to p
+        float t = (px * _dx[i] + py * _dy[i] + pz * _dz[i]) * _inv_length_sq[i];
+        t = MIN(MAX(t, 0.0f), 1.0f);
+        const float ex = px - t * _dx[i];
+        const float ey = py - t * _dy[i];
+        const float ez = pz - t * _dz[i];
+        const float margin = sqrtf(ex * ex + ey * ey + ez * ez) - offset;
+        margins[i] = MIN(margins[i], margin);
+    }
+}
@@ -0,0 +1,56 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "vector3.h"
+
+/*
+  a fan of line segments sharing a start point, such as the probes of
+  an avoidance algorithm. The segments are held as arrays of their
+  components so the distance from a point to every segment is
+  calculated in a single loop the compiler can vectorise
+ */
+class SegmentFan {
+public:
+    static constexpr uint8_t MAX_SEGMENTS = 8;
+
+    // remove all segments and set the common start point
+    void init(const Vector3f &start);
+
+    // add a segment from the start point to end, returns false if full
+    bool add(const Vector3f &end);
+
+    // number of segments
+    uint8_t count() const { return _count; }
+
+    // start point shared by all segments
+    const Vector3f &start() const { return _start; }
+
+    // end point of a segment
+    // Note: no protection against out-of-bounds accesses so use with count()
+    Vector3f end(uint8_t i) const { return _start + Vector3f(_dx[i], _dy[i], _dz[i]); }
+
+    // for each segment reduce margins[i] to the closest distance
+    // between the segment and point p less offset, if that is smaller
+    void update_margins(const Vector3f &p, float offset, float margins[]) const;
+
+private:
+    Vector3f _start;
+    uint8_t _count;
+    float _dx[MAX_SEGMENTS];            // segment end minus start
+    float _dy[MAX_SEGMENTS];
+    float _dz[MAX_SEGMENTS];
+    float _inv_length_sq[MAX_SEGMENTS]; // inverse of segment length squared, zero for zero length segments
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+/*
+  4 lane float vector operations used to specialise the hot float
+  Matrix3, Vector3 and Quaternion operations on hosts with SSE and on
+  64 bit ARM Linux boards with NEON.
+
+  The kernels do the same multiplies and adds in the same order as the
+  scalar code and never fuse them, so the results are bit for bit
+  identical to the scalar implementation unless the compiler contracts
+  the scalar code into fused multiply-adds. 32 bit ARM NEON flushes
+  denormals to zero so is not used.
+
+  Only the first three lanes of values holding a Vector3 or a matrix
+  row are meaningful, the fourth lane is ignored.
+ */
+
+#ifndef AP_MATH_SIMD_ENABLED
+#if defined(__SSE__) || (defined(__ARM_NEON) && defined(__aarch64__))
+#define AP_MATH_SIMD_ENABLED 1
+#else
+#define AP_MATH_SIMD_ENABLED 0
+#endif
+#endif  // AP_MATH_SIMD_ENABLED
+
+#if AP_MATH_SIMD_ENABLED
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#else
+#include <arm_neon.h>
+#endif
+
+namespace AP_Math_SIMD {
+
+#if defined(__SSE__)
+
+typedef __m128 f32x4;
+
+static inline f32x4 load(const float *p) { return _mm_loadu_ps(p); }
+static inline void store(float *p, f32x4 v) { _mm_storeu_ps(p, v); }
+static inline f32x4 set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+static inline f32x4 dup(float x) { return _mm_set1_ps(x); }
+static inline f32x4 add(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+static inline f32x4 sub(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+static inline f32x4 mul(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+
+// (v1, v2, v3, v3): moves lanes down by one
+static inline f32x4 shift_down(f32x4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 2, 1)); }
+// (v1, v2, v0, v3)
+static inline f32x4 yzx(f32x4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)); }
+// (v2, v0, v1, v3)
+static inline f32x4 zxy(f32x4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2)); }
+// (v1, v0, v3, v2)
+static inline f32x4 swap_pairs(f32x4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+// (v2, v3, v0, v1)
+static inline f32x4 swap_halves(f32x4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)); }
+// (v3, v2, v1, v0)
+static inline f32x4 reverse(f32x4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+/*
+  returns (sum(p0), sum(p1), sum(p2), -) where sum(p) is (p.x + p.y) + p.z
+ */
+static inline f32x4 sum3_transposed(f32x4 p0, f32x4 p1, f32x4 p2)
+{
+    const f32x4 t0 = _mm_unpacklo_ps(p0, p1);  // p0x p1x p0y p1y
+    const f32x4 t1 = _mm_unpackhi_ps(p0, p1);  // p0z p1z -   -
+    const f32x4 t2 = _mm_unpacklo_ps(p2, p2);  // p2x p2x p2y p2y
+    const f32x4 t3 = _mm_unpackhi_ps(p2, p2);  // p2z p2z -   -
+    const f32x4 x = _mm_movelh_ps(t0, t2);
+    const f32x4 y = _mm_movehl_ps(t2, t0);
+    const f32x4 z = _mm_movelh_ps(t1, t3);
+    return _mm_add_ps(_mm_add_ps(x, y), z);
+}
+
+#else  // NEON
+
+typedef float32x4_t f32x4;
+
+static inline f32x4 load(const float *p) { return vld1q_f32(p); }
+static inline void store(float *p, f32x4 v) { vst1q_f32(p, v); }
+static inline f32x4 set(float x, float y, float z, float w)
+{
+    const float v[4] { x, y, z, w };
+    return vld1q_f32(v);
+}
+static inline f32x4 dup(float x) { return vdupq_n_f32(x); }
+static inline f32x4 add(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+static inline f32x4 sub(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+static inline f32x4 mul(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+
+static inline f32x4 shift_down(f32x4 v) { return vextq_f32(v, v, 1); }
+static inline f32x4 yzx(f32x4 v) { return vcopyq_laneq_f32(vextq_f32(v, v, 1), 2, v, 0); }
+static inline f32x4 zxy(f32x4 v) { return vcopyq_laneq_f32(vextq_f32(v, v, 3), 0, v, 2); }
+static inline f32x4 swap_pairs(f32x4 v) { return vrev64q_f32(v); }
+static inline f32x4 swap_halves(f32x4 v) { return vextq_f32(v, v, 2); }
+static inline f32x4 reverse(f32x4 v) { return vrev64q_f32(vextq_f32(v, v, 2)); }
+
+static inline f32x4 sum3_transposed(f32x4 p0, f32x4 p1, f32x4 p2)
+{
+    const f32x4 t0 = vzip1q_f32(p0, p1);
+    const f32x4 t1 = vzip2q_f32(p0, p1);
+    const f32x4 t2 = vzip1q_f32(p2, p2);
+    const f32x4 t3 = vzip2q_f32(p2, p2);
+    const f32x4 x = vcombine_f32(vget_low_f32(t0), vget_low_f32(t2));
+    const f32x4 y = vcombine_f32(vget_high_f32(t0), vget_high_f32(t2));
+    const f32x4 z = vcombine_f32(vget_low_f32(t1), vget_low_f32(t3));
+    return vaddq_f32(vaddq_f32(x, y), z);
+}
+
+#endif
+
+/*
+  load the three rows of a row major 3x3 matrix of 9 floats without
+  reading past its end
+ */
+static inline void load_rows3(const float *m, f32x4 &r0, f32x4 &r1, f32x4 &r2)
+{
+    r0 = load(&m[0]);
+    r1 = load(&m[3]);
+    r2 = shift_down(load(&m[5]));
+}
+
+} // namespace AP_Math_SIMD
+
+#endif  // AP_MATH_SIMD_ENABLED
@@ -0,0 +1,75 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/fast_math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// maximum errors against double precision, as documented in fast_math.h
+template <FastMathAccuracy A>
+static void check_sincos(double max_err)
+{
+    double err = 0;
+    for (int32_t i = -200000; i <= 200000; i++) {
+        const float x = i * 1.0e-3f;
+        float s, c;
+        fast_sincosf<A>(x, s, c);
+        err = MAX(err, fabs(double(s) - sin(double(x))));
+        err = MAX(err, fabs(double(c) - cos(double(x))));
+        EXPECT_FLOAT_EQ(s, fast_sinf<A>(x));
+        EXPECT_FLOAT_EQ(c, fast_cosf<A>(x));
+    }
+    EXPECT_LE(err, max_err);
+}
+
+template <FastMathAccuracy A>
+static void check_atan2(double max_err)
+{
+    double err = 0;
+    for (uint16_t i = 0; i < 3600; i++) {
+        const double angle = radians(i * 0.1);
+        for (const double r : { 1.0e-3, 1.0, 250.0 }) {
+            const float y = r * sin(angle);
+            const float x = r * cos(angle);
+            err = MAX(err, fabs(wrap_PI(double(fast_atan2f<A>(y, x)) - atan2(double(y), double(x)))));
+        }
+    }
+    EXPECT_LE(err, max_err);
+    EXPECT_FLOAT_EQ(fast_atan2f<A>(0, 0), 0);
+    EXPECT_FLOAT_EQ(fast_atan2f<A>(1, 0), M_PI_2);
+    EXPECT_FLOAT_EQ(fast_atan2f<A>(-1, 0), -M_PI_2);
+    EXPECT_FLOAT_EQ(fast_atan2f<A>(0, -1), M_PI);
+}
+
+TEST(FastMathTest, SinCosLow)
+{
+    check_sincos<FastMathAccuracy::LOW>(2e-4);
+}
+
+TEST(FastMathTest, SinCosMedium)
+{
+    check_sincos<FastMathAccuracy::MEDIUM>(1e-6);
+}
+
+TEST(FastMathTest, SinCosHigh)
+{
+    check_sincos<FastMathAccuracy::HIGH>(3e-7);
+}
+
+TEST(FastMathTest, Atan2Low)
+{
+    check_atan2<FastMathAccuracy::LOW>(7e-4);
+}
+
+TEST(FastMathTest, Atan2Medium)
+{
+    check_atan2<FastMathAccuracy::MEDIUM>(2e-6);
+}
+
+TEST(FastMathTest, Atan2High)
+{
+    check_atan2<FastMathAccuracy::HIGH>(3e-7);
+}
+
+AP_GTEST_PANIC()
+AP_GTEST_MAIN()
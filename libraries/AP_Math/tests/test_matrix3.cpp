@@ -103,6 +103,34 @@ TEST_P(Matrix3fTest, Inverses)
     }
 }
 
+// the float products may use SIMD, check them against the double versions
+TEST_P(Matrix3fTest, Products)
+{
+    auto param = GetParam();
+    const Matrix3f m2(Vector3f(0.5f, -1.5f, 2.0f),
+                      Vector3f(3.0f, 0.25f, -4.0f),
+                      Vector3f(-2.0f, 7.0f, 1.0f));
+    const Vector3f v(1.5f, -2.0f, 0.75f);
+
+    const Matrix3d md = param.m.todouble();
+    const Vector3f mv = param.m * v;
+    const Vector3d mvd = md * v.todouble();
+    const Vector3f mtv = param.m.mul_transpose(v);
+    const Vector3d mtvd = md.mul_transpose(v.todouble());
+    for (uint8_t i = 0; i < 3; i++) {
+        EXPECT_FLOAT_EQ(mvd[i], mv[i]);
+        EXPECT_FLOAT_EQ(mtvd[i], mtv[i]);
+    }
+
+    const Matrix3f mm = param.m * m2;
+    const Matrix3d mmd = md * m2.todouble();
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            EXPECT_FLOAT_EQ(mmd[i][j], mm[i][j]);
+        }
+    }
+}
+
 INSTANTIATE_TEST_CASE_P(InvertibleMatrices,
                         Matrix3fTest,
                         ::testing::ValuesIn(invertible));
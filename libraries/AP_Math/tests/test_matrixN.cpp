@@ -0,0 +1,121 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/matrixN.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// a symmetric positive definite matrix
+static MatrixN<float,3> test_matrix()
+{
+    MatrixN<float,3> P;
+    const float v[3][3] {
+        { 4.0f,  1.2f, -0.6f },
+        { 1.2f,  3.0f,  0.4f },
+        {-0.6f,  0.4f,  2.0f },
+    };
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            P[i][j] = v[i][j];
+        }
+    }
+    return P;
+}
+
+TEST(MatrixNTest, ForceSymmetry)
+{
+    MatrixN<float,4> M;
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 0; j < 4; j++) {
+            M[i][j] = i * 4 + j;
+        }
+    }
+    M.force_symmetry();
+    for (uint8_t i = 0; i < 4; i++) {
+        EXPECT_FLOAT_EQ(M[i][i], i * 5);
+        for (uint8_t j = 0; j < i; j++) {
+            EXPECT_FLOAT_EQ(M[i][j], M[j][i]);
+            EXPECT_FLOAT_EQ(M[i][j], (i * 4 + j + j * 4 + i) * 0.5f);
+        }
+    }
+}
+
+TEST(MatrixNTest, MultABAt)
+{
+    const MatrixN<float,3> B = test_matrix();
+    MatrixN<float,3> A;
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            A[i][j] = 0.5f * i - 0.25f * j + 0.1f;
+        }
+    }
+    MatrixN<float,3> R;
+    R.mult_ABAt(A, B);
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            double expected = 0;
+            for (uint8_t k = 0; k < 3; k++) {
+                for (uint8_t l = 0; l < 3; l++) {
+                    expected += double(A[i][k]) * B[k][l] * A[j][l];
+                }
+            }
+            EXPECT_NEAR(R[i][j], expected, 1e-5);
+            EXPECT_FLOAT_EQ(R[i][j], R[j][i]);
+        }
+    }
+}
+
+TEST(MatrixNTest, SubABAt)
+{
+    MatrixN<float,3> P = test_matrix();
+    const float K[3][2] {
+        { 0.6f, 0.1f },
+        { 0.2f, 0.5f },
+        {-0.3f, 0.4f },
+    };
+    const float S[2][2] {
+        { 5.0f, 1.2f },
+        { 1.2f, 4.0f },
+    };
+    const MatrixN<float,3> P0 = P;
+    P.sub_ABAt(K, S);
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            double expected = P0[i][j];
+            for (uint8_t k = 0; k < 2; k++) {
+                for (uint8_t l = 0; l < 2; l++) {
+                    expected -= double(K[i][k]) * S[k][l] * K[j][l];
+                }
+            }
+            EXPECT_NEAR(P[i][j], expected, 1e-5);
+            EXPECT_FLOAT_EQ(P[i][j], P[j][i]);
+        }
+    }
+}
+
+TEST(MatrixNTest, Cholesky)
+{
+    const MatrixN<float,3> P = test_matrix();
+    MatrixN<float,3> L;
+    EXPECT_TRUE(P.cholesky(L));
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            if (j > i) {
+                EXPECT_FLOAT_EQ(L[i][j], 0);
+            }
+            float sum = 0;
+            for (uint8_t k = 0; k < 3; k++) {
+                sum += L[i][k] * L[j][k];
+            }
+            EXPECT_NEAR(sum, P[i][j], 1e-5);
+        }
+    }
+
+    // not positive definite
+    MatrixN<float,3> N = P;
+    N[2][2] = -1;
+    EXPECT_FALSE(N.cholesky(L));
+}
+
+AP_GTEST_PANIC()
+AP_GTEST_MAIN()
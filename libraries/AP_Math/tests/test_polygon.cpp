@@ -355,6 +355,36 @@ TEST(Polygon, simple)
     TEST_POLYGON_POINTS(SIMPLE_boundary, SIMPLE_test_points);
 }
 
+TEST(Polygon, bounds)
+{
+    Polygon_Bounds bounds;
+    Polygon_bounds(SIMPLE_boundary, ARRAY_SIZE(SIMPLE_boundary), bounds);
+    EXPECT_FLOAT_EQ(-1, bounds.min.x);
+    EXPECT_FLOAT_EQ(-3, bounds.min.y);
+    EXPECT_FLOAT_EQ(1, bounds.max.x);
+    EXPECT_FLOAT_EQ(2, bounds.max.y);
+
+    EXPECT_TRUE(bounds.contains(Vector2f{0,0}));
+    EXPECT_TRUE(bounds.contains(Vector2f{1,2}));
+    EXPECT_FALSE(bounds.contains(Vector2f{1.5,0}));
+    EXPECT_FLOAT_EQ(0, bounds.distance(Vector2f{0.5,-2}));
+    EXPECT_FLOAT_EQ(2, bounds.distance(Vector2f{3,0}));
+    EXPECT_FLOAT_EQ(5, bounds.distance(Vector2f{4,6}));
+
+    // the distance to the bounds is never more than to the polygon
+    for (const auto &p : { Vector2f{3,0}, Vector2f{4,6}, Vector2f{-5,-5}, Vector2f{0,10} }) {
+        float closest;
+        EXPECT_TRUE(Polygon_closest_distance_point(SIMPLE_boundary, ARRAY_SIZE(SIMPLE_boundary), p, closest));
+        EXPECT_LE(bounds.distance(p), closest + 1e-6);
+    }
+
+    const Polygon_Bounds other { Vector2f{4,-3}, Vector2f{5,5} };
+    EXPECT_FLOAT_EQ(3, bounds.distance(other));
+    EXPECT_FLOAT_EQ(3, other.distance(bounds));
+    const Polygon_Bounds overlapping { Vector2f{0,0}, Vector2f{5,5} };
+    EXPECT_FLOAT_EQ(0, bounds.distance(overlapping));
+}
+
 AP_GTEST_MAIN()
 
 
@@ -251,4 +251,31 @@ TEST(QuaternionTest, Quaternion_length_squared)
     EXPECT_FLOAT_EQ(q.length_squared(), 1.44);
 }
 
+// the float products may use SIMD, check them against the double versions
+TEST(QuaternionTest, FloatProductsMatchDouble)
+{
+    const Quaternion q1{0.8365163, 0.48296291, 0.22414387, -0.12940952};
+    const Quaternion q2{0.5, -0.5, 0.5, 0.5};
+    const Vector3f v{1.5, -2.0, 0.75};
+
+    const Quaternion p = q1 * q2;
+    const QuaternionD pd = q1.todouble() * q2.todouble();
+    Quaternion p2 = q1;
+    p2 *= q2;
+    EXPECT_FLOAT_EQ(pd.q1, p.q1);
+    EXPECT_FLOAT_EQ(pd.q2, p.q2);
+    EXPECT_FLOAT_EQ(pd.q3, p.q3);
+    EXPECT_FLOAT_EQ(pd.q4, p.q4);
+    EXPECT_FLOAT_EQ(p.q1, p2.q1);
+    EXPECT_FLOAT_EQ(p.q2, p2.q2);
+    EXPECT_FLOAT_EQ(p.q3, p2.q3);
+    EXPECT_FLOAT_EQ(p.q4, p2.q4);
+
+    const Vector3f r = q1 * v;
+    const Vector3d rd = q1.todouble() * v.todouble();
+    EXPECT_FLOAT_EQ(rd.x, r.x);
+    EXPECT_FLOAT_EQ(rd.y, r.y);
+    EXPECT_FLOAT_EQ(rd.z, r.z);
+}
+
 AP_GTEST_MAIN()
\ No newline at end of file
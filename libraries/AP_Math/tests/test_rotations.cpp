@@ -138,6 +138,37 @@ TEST(RotationsTest, TestRotateMatrix)
     }
 }
 
+TEST(RotationsTest, TestFastRotation)
+{
+    for (enum Rotation r = ROTATION_NONE;
+         r < ROTATION_MAX;
+         r = (enum Rotation)((uint8_t)r+1)) {
+        const FastRotation fr = r;
+        EXPECT_EQ(r, (enum Rotation)fr);
+        Vector3f vec(1.5f, -2.25f, 3.125f);
+        Vector3f vec2 = vec;
+        vec.rotate(r);
+        fr.rotate(vec2);
+        EXPECT_LE((vec - vec2).length(), 1e-5);
+    }
+
+    // axis swaps and sign changes give exactly the same result
+    const enum Rotation exact[] {
+        ROTATION_NONE, ROTATION_YAW_90, ROTATION_YAW_180, ROTATION_YAW_270,
+        ROTATION_ROLL_180, ROTATION_ROLL_90_YAW_90, ROTATION_PITCH_270,
+        ROTATION_ROLL_270_YAW_90, ROTATION_ROLL_90_PITCH_180_YAW_90,
+    };
+    for (const auto r : exact) {
+        FastRotation fr;
+        fr = r;
+        Vector3f vec(0.1f, -7.3f, 1e-3f);
+        Vector3f vec2 = vec;
+        vec.rotate(r);
+        fr.rotate(vec2);
+        EXPECT_TRUE(vec == vec2);
+    }
+}
+
 #if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
 TEST(RotationsTest, TestFailedGetLinux)
 {
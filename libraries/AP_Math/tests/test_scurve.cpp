@@ -17,6 +17,39 @@ TEST(LinesScurve, test_calculate_path)
     EXPECT_FLOAT_EQ(t6_out, 0.25000018);
 }
 
+TEST(LinesScurve, test_track_continuity)
+{
+    // step along a straight track at a fine time step and check that the
+    // kinematic outputs are consistent with each other across all segments
+    SCurve scurve, prev_leg, next_leg;
+    prev_leg.init();
+    next_leg.init();
+    scurve.calculate_track(Vector3f{0, 0, 0}, Vector3f{100, 0, 0},
+                           10, 2.5, 1.5, 5, 2.5, 62.8319, 10);
+
+    const float dt = 0.01;
+    Vector3f pos_last, vel_last, accel_last;
+    bool finished = false;
+    uint32_t steps = 0;
+    while (!finished && steps < 10000) {
+        Vector3f pos, vel, accel;
+        finished = scurve.advance_target_along_track(prev_leg, next_leg, 2, 5, false, dt, pos, vel, accel);
+        steps++;
+        // position never goes backwards and follows the velocity
+        EXPECT_GE(pos.x, pos_last.x - 1e-4);
+        EXPECT_NEAR((pos.x - pos_last.x) / dt, 0.5 * (vel.x + vel_last.x), 0.01);
+        // velocity follows the acceleration
+        EXPECT_NEAR((vel.x - vel_last.x) / dt, 0.5 * (accel.x + accel_last.x), 0.1);
+        EXPECT_LE(vel.x, 10 + 1e-3);
+        EXPECT_LE(fabsf(accel.x), 5 + 1e-3);
+        pos_last = pos;
+        vel_last = vel;
+        accel_last = accel;
+    }
+    EXPECT_TRUE(finished);
+    EXPECT_NEAR(pos_last.x, 100, 0.01);
+    EXPECT_NEAR(vel_last.x, 0, 0.01);
+}
 
 AP_GTEST_MAIN()
 int hal = 0; //weirdly the build will fail without this
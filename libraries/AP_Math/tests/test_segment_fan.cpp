@@ -0,0 +1,62 @@
+#include <AP_gtest.h>
+#include <AP_Common/AP_Common.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/segment_fan.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// margins must match the distance calculated for each segment on its own
+TEST(SegmentFan, matches_closest_distance)
+{
+    const Vector3f start {1.0f, -2.0f, 0.5f};
+    const Vector3f ends[] {
+        {11.0f, -2.0f, 0.5f},
+        {1.0f, 8.0f, 0.5f},
+        {-6.0f, -9.0f, 3.0f},
+        {1.0f, -2.0f, 0.5f},    // zero length
+        {4.0f, 2.0f, -1.0f},
+    };
+    const Vector3f points[] {
+        {5.0f, 0.0f, 0.0f},
+        {-3.0f, -3.0f, 1.0f},
+        {20.0f, 20.0f, 0.0f},
+    };
+
+    SegmentFan fan;
+    fan.init(start);
+    for (uint8_t i = 0; i < ARRAY_SIZE(ends); i++) {
+        EXPECT_TRUE(fan.add(ends[i]));
+    }
+    EXPECT_EQ(fan.count(), ARRAY_SIZE(ends));
+
+    float margins[ARRAY_SIZE(ends)];
+    float expected[ARRAY_SIZE(ends)];
+    for (uint8_t i = 0; i < ARRAY_SIZE(ends); i++) {
+        margins[i] = FLT_MAX;
+        expected[i] = FLT_MAX;
+    }
+    const float radius = 0.25f;
+    for (const Vector3f &p : points) {
+        fan.update_margins(p, radius, margins);
+        for (uint8_t i = 0; i < ARRAY_SIZE(ends); i++) {
+            expected[i] = MIN(expected[i], Vector3f::closest_distance_between_line_and_point(start, ends[i], p) - radius);
+        }
+    }
+    for (uint8_t i = 0; i < ARRAY_SIZE(ends); i++) {
+        EXPECT_NEAR(margins[i], expected[i], 1e-4f);
+    }
+}
+
+TEST(SegmentFan, full)
+{
+    SegmentFan fan;
+    fan.init(Vector3f());
+    for (uint8_t i = 0; i < SegmentFan::MAX_SEGMENTS; i++) {
+        EXPECT_TRUE(fan.add(Vector3f(i, 1.0f, 0.0f)));
+    }
+    EXPECT_FALSE(fan.add(Vector3f(1.0f, 1.0f, 1.0f)));
+    EXPECT_EQ(fan.count(), SegmentFan::MAX_SEGMENTS);
+}
+
+AP_GTEST_MAIN()
@@ -832,6 +832,12 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
         return false;
     }
 
+#if AP_MISSION_CMD_CACHE_SIZE > 0
+    if (cmd_cache_get(index, cmd)) {
+        return true;
+    }
+#endif
+
     // ensure all bytes of cmd are zeroed
     cmd = {};
 
@@ -890,6 +896,10 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
     // set command's index to it's position in eeprom
     cmd.index = index;
 
+#if AP_MISSION_CMD_CACHE_SIZE > 0
+    cmd_cache_put(cmd);
+#endif
+
     // return success
     return true;
 }
@@ -984,6 +994,11 @@ bool AP_Mission::write_cmd_to_storage(uint16_t index, const Mission_Command& cmd
         _storage.write_block(pos_in_storage+5, packed.bytes, 10);
     }
 
+#if AP_MISSION_CMD_CACHE_SIZE > 0
+    cmd_cache_invalidate(index);
+#endif
+    _markers_valid = false;
+
     // remember when the mission last changed
     if (index != 0) {
         // Update of home location is not a true change
@@ -2299,11 +2314,9 @@ bool AP_Mission::jump_to_tag(const uint16_t tag)
 // Returns 0 if no appropriate JUMP_TAG match can be found.
 uint16_t AP_Mission::get_index_of_jump_tag(const uint16_t tag) const
 {
-    const auto count = num_commands();
-    for (uint16_t i = 1; i < count; i++) {
-        if (get_command_id(i) != uint16_t(MAV_CMD_JUMP_TAG)) {
-            continue;
-        }
+    for (uint16_t i = next_index_of_id(MAV_CMD_JUMP_TAG, 1);
+         i != 0;
+         i = next_index_of_id(MAV_CMD_JUMP_TAG, i+1)) {
         Mission_Command tmp;
         if (!read_cmd_from_storage(i, tmp)) {
             continue;
@@ -2419,11 +2432,9 @@ uint16_t AP_Mission::get_landing_sequence_start(const Location &current_loc)
     float min_distance = -1;
 
     // Go through mission looking for nearest landing start command
-    const auto count = num_commands();
-    for (uint16_t i = 1; i < count; i++) {
-        if (get_command_id(i) != uint16_t(MAV_CMD_DO_LAND_START)) {
-            continue;
-        }
+    for (uint16_t i = next_index_of_id(MAV_CMD_DO_LAND_START, 1);
+         i != 0;
+         i = next_index_of_id(MAV_CMD_DO_LAND_START, i+1)) {
         Mission_Command tmp;
         if (!read_cmd_from_storage(i, tmp)) {
             continue;
@@ -2492,18 +2503,18 @@ bool AP_Mission::jump_to_closest_mission_leg(const Location &current_loc)
     uint16_t search_remaining = 1000;
 
     // Go through mission and check each DO_RETURN_PATH_START
-    for (uint16_t i = 1; i < num_commands(); i++) {
-        if (get_command_id(i) == uint16_t(MAV_CMD_DO_RETURN_PATH_START)) {
-            uint16_t tmp_index;
-            float tmp_distance;
-            if (distance_to_mission_leg(i, search_remaining, tmp_distance, tmp_index, current_loc) && (min_distance < 0 || tmp_distance <= min_distance)){
-                min_distance = tmp_distance;
-                landing_start_index = tmp_index;
-            }
-            if (search_remaining == 0) {
-                // Run out of time to search, stop and return the best so far
-                break;
-            }
+    for (uint16_t i = next_index_of_id(MAV_CMD_DO_RETURN_PATH_START, 1);
+         i != 0;
+         i = next_index_of_id(MAV_CMD_DO_RETURN_PATH_START, i+1)) {
+        uint16_t tmp_index;
+        float tmp_distance;
+        if (distance_to_mission_leg(i, search_remaining, tmp_distance, tmp_index, current_loc) && (min_distance < 0 || tmp_distance <= min_distance)){
+            min_distance = tmp_distance;
+            landing_start_index = tmp_index;
+        }
+        if (search_remaining == 0) {
+            // Run out of time to search, stop and return the best so far
+            break;
         }
     }
 
@@ -2528,18 +2539,17 @@ bool AP_Mission::jump_to_abort_landing_sequence(const Location &current_loc)
 {
     uint16_t abort_index = 0;
     float min_distance = FLT_MAX;
+    const LocationFrame frame{current_loc};
 
-    const auto count = num_commands();
-    for (uint16_t i = 1; i < count; i++) {
-        if (get_command_id(i) != uint16_t(MAV_CMD_DO_GO_AROUND)) {
-            continue;
-        }
+    for (uint16_t i = next_index_of_id(MAV_CMD_DO_GO_AROUND, 1);
+         i != 0;
+         i = next_index_of_id(MAV_CMD_DO_GO_AROUND, i+1)) {
         Mission_Command tmp;
         if (!read_cmd_from_storage(i, tmp)) {
             continue;
         }
         if (tmp.id == MAV_CMD_DO_GO_AROUND) {
-            float tmp_distance = tmp.content.location.get_distance(current_loc);
+            float tmp_distance = frame.get_distance(tmp.content.location);
             if (tmp_distance < min_distance) {
                 min_distance = tmp_distance;
                 abort_index = i;
@@ -2945,6 +2955,124 @@ uint16_t AP_Mission::get_command_id(uint16_t index) const
     return id;
 }
 
+#if AP_MISSION_CMD_CACHE_SIZE > 0
+/*
+  look for a command in the cache of recently read commands
+ */
+bool AP_Mission::cmd_cache_get(uint16_t index, Mission_Command &cmd) const
+{
+    for (auto &c : _cmd_cache) {
+        if (c.cmd.index == index) {
+            c.last_used = ++_cmd_cache_clock;
+            cmd = c.cmd;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+  add a command read from storage to the cache, replacing the least
+  recently used entry
+ */
+void AP_Mission::cmd_cache_put(const Mission_Command &cmd) const
+{
+    CachedCommand *oldest = &_cmd_cache[0];
+    for (auto &c : _cmd_cache) {
+        if (c.cmd.index == 0) {
+            oldest = &c;
+            break;
+        }
+        if (c.last_used < oldest->last_used) {
+            oldest = &c;
+        }
+    }
+    oldest->cmd = cmd;
+    oldest->last_used = ++_cmd_cache_clock;
+}
+
+/*
+  remove a command from the cache after it is written
+ */
+void AP_Mission::cmd_cache_invalidate(uint16_t index) const
+{
+    for (auto &c : _cmd_cache) {
+        if (c.cmd.index == index) {
+            c.cmd.index = 0;
+        }
+    }
+}
+#endif // AP_MISSION_CMD_CACHE_SIZE
+
+/*
+  return true if the command ID is one searched for by ID
+ */
+bool AP_Mission::is_marker_cmd(uint16_t id)
+{
+    switch (id) {
+    case MAV_CMD_DO_LAND_START:
+    case MAV_CMD_DO_RETURN_PATH_START:
+    case MAV_CMD_DO_GO_AROUND:
+    case MAV_CMD_JUMP_TAG:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+  rebuild the index of marker commands if commands have been written
+  or the number of commands has changed
+ */
+void AP_Mission::update_markers(void) const
+{
+    const uint16_t count = num_commands();
+    if (_markers_valid && _markers_count == count) {
+        return;
+    }
+    _num_markers = 0;
+    _markers_overflow = false;
+    for (uint16_t i = 1; i < count; i++) {
+        const uint16_t id = get_command_id(i);
+        if (!is_marker_cmd(id)) {
+            continue;
+        }
+        if (_num_markers == ARRAY_SIZE(_markers)) {
+            _markers_overflow = true;
+            break;
+        }
+        _markers[_num_markers++] = { i, id };
+    }
+    _markers_count = count;
+    _markers_valid = true;
+}
+
+/*
+  return the first index at or after start of a command with this ID,
+  or 0 if there is none. The ID must be one of the marker commands
+ */
+uint16_t AP_Mission::next_index_of_id(uint16_t id, uint16_t start) const
+{
+    WITH_SEMAPHORE(_rsem);
+
+    update_markers();
+    if (!_markers_overflow) {
+        for (uint8_t i = 0; i < _num_markers; i++) {
+            if (_markers[i].index >= start && _markers[i].id == id) {
+                return _markers[i].index;
+            }
+        }
+        return 0;
+    }
+    const uint16_t count = num_commands();
+    for (uint16_t i = MAX(start, 1U); i < count; i++) {
+        if (get_command_id(i) == id) {
+            return i;
+        }
+    }
+    return 0;
+}
+
 /*
   see if the mission contains a particular item
  */
@@ -930,6 +930,38 @@ private:
     // fast call to get command ID of a mission index
     uint16_t get_command_id(uint16_t index) const;
 
+#if AP_MISSION_CMD_CACHE_SIZE > 0
+    // recently read commands, an index of 0 means the entry is unused
+    struct CachedCommand {
+        Mission_Command cmd;
+        uint32_t last_used;
+    };
+    mutable CachedCommand _cmd_cache[AP_MISSION_CMD_CACHE_SIZE];
+    mutable uint32_t _cmd_cache_clock;
+    bool cmd_cache_get(uint16_t index, Mission_Command &cmd) const;
+    void cmd_cache_put(const Mission_Command &cmd) const;
+    void cmd_cache_invalidate(uint16_t index) const;
+#endif
+
+    // indexes of the commands searched for by ID when jumping to a
+    // landing sequence, return path, go around or jump tag. Rebuilt
+    // after a write or a change in the number of commands
+    struct MarkerIndex {
+        uint16_t index;
+        uint16_t id;
+    };
+    mutable MarkerIndex _markers[AP_MISSION_MARKER_INDEX_SIZE];
+    mutable uint8_t _num_markers;
+    mutable bool _markers_overflow;     // too many to index, search storage
+    mutable bool _markers_valid;
+    mutable uint16_t _markers_count;    // num_commands() when built
+    static bool is_marker_cmd(uint16_t id);
+    void update_markers(void) const;
+
+    // return the first index at or after start of a command with this
+    // ID, or 0 if there is none
+    uint16_t next_index_of_id(uint16_t id, uint16_t start) const;
+
     // memoisation of contains-relative:
     bool _contains_terrain_alt_items;  // true if the mission has terrain-relative items
     uint32_t _last_contains_relative_calculated_ms;  // will be equal to _last_change_time_ms if _contains_terrain_alt_items is up-to-date
@@ -7,3 +7,18 @@
 #ifndef AP_MISSION_NAV_PAYLOAD_PLACE_ENABLED
 #define AP_MISSION_NAV_PAYLOAD_PLACE_ENABLED 1
 #endif
+
+// number of decoded commands kept to save reading them from storage
+#ifndef AP_MISSION_CMD_CACHE_SIZE
+#if HAL_PROGRAM_SIZE_LIMIT_KB > 1024
+#define AP_MISSION_CMD_CACHE_SIZE 16
+#else
+#define AP_MISSION_CMD_CACHE_SIZE 0
+#endif
+#endif
+
+// number of landing sequence, return path, go around and jump tag
+// commands whose index is kept to save searching the whole mission
+#ifndef AP_MISSION_MARKER_INDEX_SIZE
+#define AP_MISSION_MARKER_INDEX_SIZE 32
+#endif
@@ -207,6 +207,16 @@ void AP_Motors6DOF::add_motor_raw_6dof(int8_t motor_num, float roll_fac, float p
     _throttle_factor[motor_num] = throttle_fac;
     _forward_factor[motor_num] = forward_fac;
     _lateral_factor[motor_num] = lat_fac;
+    invalidate_mix_rows();
+}
+
+void AP_Motors6DOF::update_mix_rows()
+{
+    AP_MotorsMatrix::update_mix_rows();
+    for (uint8_t j = 0; j < _mix.num_rows; j++) {
+        _mix6dof.forward[j] = _forward_factor[_mix.motor[j]];
+        _mix6dof.lateral[j] = _lateral_factor[_mix.motor[j]];
+    }
 }
 
 // output_min - sends minimum values out to the motors
@@ -311,9 +321,6 @@ void AP_Motors6DOF::output_armed_stabilizing()
         forward_thrust = _forward_in;
         lateral_thrust = _lateral_in;
 
-        float rpy_out[AP_MOTORS_MAX_NUM_MOTORS]; // buffer so we don't have to multiply coefficients multiple times.
-        float linear_out[AP_MOTORS_MAX_NUM_MOTORS]; // 3 linear DOF mix for each motor
-
         // initialize limits flags
         limit.roll = false;
         limit.pitch = false;
@@ -331,31 +338,28 @@ void AP_Motors6DOF::output_armed_stabilizing()
             limit.throttle_upper = true;
         }
 
-        // calculate roll, pitch and yaw for each motor
-        for (i=0; i<AP_MOTORS_MAX_NUM_MOTORS; i++) {
-            if (motor_enabled[i]) {
-                rpy_out[i] = roll_thrust * _roll_factor[i] +
-                             pitch_thrust * _pitch_factor[i] +
-                             yaw_thrust * _yaw_factor[i];
-
-            }
+        // evaluate the mixing matrix over the packed rows of the
+        // enabled motors, a single loop the compiler can vectorise
+        if (!_mix.valid) {
+            update_mix_rows();
         }
-
-        // calculate linear command for each motor
-        // linear factors should be 0.0 or 1.0 for now
-        for (i=0; i<AP_MOTORS_MAX_NUM_MOTORS; i++) {
-            if (motor_enabled[i]) {
-                linear_out[i] = throttle_thrust * _throttle_factor[i] +
-                                forward_thrust * _forward_factor[i] +
-                                lateral_thrust * _lateral_factor[i];
-            }
+        const uint8_t num_rows = _mix.num_rows;
+        float *thrust_out = _mix.out;
+        for (uint8_t j = 0; j < num_rows; j++) {
+            const float rpy_out = roll_thrust * _mix.roll[j] +
+                                  pitch_thrust * _mix.pitch[j] +
+                                  yaw_thrust * _mix.yaw[j];
+            // linear factors should be 0.0 or 1.0 for now
+            const float linear_out = throttle_thrust * _mix.throttle[j] +
+                                     forward_thrust * _mix6dof.forward[j] +
+                                     lateral_thrust * _mix6dof.lateral[j];
+            thrust_out[j] = rpy_out + linear_out;
         }
 
         // Calculate final output for each motor
-        for (i=0; i<AP_MOTORS_MAX_NUM_MOTORS; i++) {
-            if (motor_enabled[i]) {
-                _thrust_rpyt_out[i] = constrain_float(_motor_reverse[i]*(rpy_out[i] + linear_out[i]),-1.0f,1.0f);
-            }
+        for (uint8_t j = 0; j < num_rows; j++) {
+            i = _mix.motor[j];
+            _thrust_rpyt_out[i] = constrain_float(_motor_reverse[i]*thrust_out[j],-1.0f,1.0f);
         }
     }
 
@@ -65,6 +65,9 @@ protected:
     void output_armed_stabilizing_vectored();
     void output_armed_stabilizing_vectored_6dof();
 
+    // also pack the forward and lateral factors into _mix6dof
+    void update_mix_rows() override;
+
     // Parameters
     AP_Int8             _motor_reverse[AP_MOTORS_MAX_NUM_MOTORS];
     AP_Float            _forwardVerticalCouplingFactor;
@@ -72,6 +75,12 @@ protected:
     float               _forward_factor[AP_MOTORS_MAX_NUM_MOTORS]; // each motors contribution to forward/backward
     float               _lateral_factor[AP_MOTORS_MAX_NUM_MOTORS];  // each motors contribution to lateral (left/right)
 
+    // forward and lateral factors packed in the rows of _mix
+    struct {
+        float forward[AP_MOTORS_MAX_NUM_MOTORS];
+        float lateral[AP_MOTORS_MAX_NUM_MOTORS];
+    } _mix6dof;
+
     float _max_throttle = 1.0f;
     // current limiting
     float _output_limited = 1.0f;
@@ -106,6 +106,7 @@ bool AP_MotorsMatrix::set_throttle_factor(int8_t motor_num, float throttle_facto
     }
 
     _throttle_factor[motor_num] = throttle_factor;
+    invalidate_mix_rows();
     return true;
 }
 
@@ -164,14 +165,22 @@ void AP_MotorsMatrix::output_to_motors()
             break;
         case SpoolState::SPOOLING_UP:
         case SpoolState::THROTTLE_UNLIMITED:
-        case SpoolState::SPOOLING_DOWN:
-            // set motor output based on thrust requests
-            for (i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-                if (motor_enabled[i]) {
-                    set_actuator_with_slew(_actuator[i], thr_lin.thrust_to_actuator(_thrust_rpyt_out[i]));
-                }
+        case SpoolState::SPOOLING_DOWN: {
+            // set motor output based on thrust requests, linearising the enabled motors in one pass
+            if (!_mix.valid) {
+                update_mix_rows();
+            }
+            float thrust[AP_MOTORS_MAX_NUM_MOTORS];
+            float actuator[AP_MOTORS_MAX_NUM_MOTORS];
+            for (uint8_t j = 0; j < _mix.num_rows; j++) {
+                thrust[j] = _thrust_rpyt_out[_mix.motor[j]];
+            }
+            thr_lin.thrust_to_actuator(thrust, actuator, _mix.num_rows);
+            for (uint8_t j = 0; j < _mix.num_rows; j++) {
+                set_actuator_with_slew(_actuator[_mix.motor[j]], actuator[j]);
             }
             break;
+        }
     }
 
     // convert output to PWM and send to each motor
@@ -271,29 +280,51 @@ void AP_MotorsMatrix::output_armed_stabilizing()
     // Octo-Quad (x8) + : MOT_YAW_HEADROOM = 300, ATC_RAT_RLL_IMAX = 0.5,   ATC_RAT_PIT_IMAX = 0.5,   ATC_RAT_YAW_IMAX = 0.25
     // Quads cannot make use of motor loss handling because it doesn't have enough degrees of freedom.
 
+    // the mixer works on the packed rows of the enabled motors
+    if (!_mix.valid) {
+        update_mix_rows();
+    }
+    const uint8_t num_rows = _mix.num_rows;
+    const float *roll_factor = _mix.roll;
+    const float *pitch_factor = _mix.pitch;
+    const float *yaw_factor = _mix.yaw;
+    const float *throttle_factor = _mix.throttle;
+    float *thrust_out = _mix.out;
+
+    // row of the lost motor if thrust boost is active, otherwise num_rows
+    uint8_t lost_row = num_rows;
+    if (_thrust_boost) {
+        for (uint8_t j = 0; j < num_rows; j++) {
+            if (_mix.motor[j] == _motor_lost_index) {
+                lost_row = j;
+                break;
+            }
+        }
+    }
+
+    // calculate the thrust outputs for roll and pitch
+    for (uint8_t j = 0; j < num_rows; j++) {
+        thrust_out[j] = roll_thrust * roll_factor[j] + pitch_thrust * pitch_factor[j];
+    }
+
     // calculate amount of yaw we can fit into the throttle range
     // this is always equal to or less than the requested yaw from the pilot or rate controller
     float yaw_allowed = 1.0f; // amount of yaw we can fit in
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            // calculate the thrust outputs for roll and pitch
-            _thrust_rpyt_out[i] = roll_thrust * _roll_factor[i] + pitch_thrust * _pitch_factor[i];
-
-            // Check the maximum yaw control that can be used on this channel
-            // Exclude any lost motors if thrust boost is enabled
-            if (!is_zero(_yaw_factor[i]) && (!_thrust_boost || i != _motor_lost_index)) {
-                const float thrust_rp_best_throttle = throttle_thrust_best_rpy + _thrust_rpyt_out[i];
-                float motor_room;
-                if (is_positive(yaw_thrust * _yaw_factor[i])) {
-                    // room to upper limit
-                    motor_room = 1.0 - thrust_rp_best_throttle;
-                } else {
-                    // room to lower limit
-                    motor_room = thrust_rp_best_throttle;
-                }
-                const float motor_yaw_allowed = MAX(motor_room, 0.0)/fabsf(_yaw_factor[i]);
-                yaw_allowed = MIN(yaw_allowed, motor_yaw_allowed);
+    for (uint8_t j = 0; j < num_rows; j++) {
+        // Check the maximum yaw control that can be used on this channel
+        // Exclude any lost motors if thrust boost is enabled
+        if (!is_zero(yaw_factor[j]) && j != lost_row) {
+            const float thrust_rp_best_throttle = throttle_thrust_best_rpy + thrust_out[j];
+            float motor_room;
+            if (is_positive(yaw_thrust * yaw_factor[j])) {
+                // room to upper limit
+                motor_room = 1.0 - thrust_rp_best_throttle;
+            } else {
+                // room to lower limit
+                motor_room = thrust_rp_best_throttle;
             }
+            const float motor_yaw_allowed = MAX(motor_room, 0.0)/fabsf(yaw_factor[j]);
+            yaw_allowed = MIN(yaw_allowed, motor_yaw_allowed);
         }
     }
 
@@ -308,18 +339,18 @@ void AP_MotorsMatrix::output_armed_stabilizing()
     yaw_allowed = MAX(yaw_allowed, yaw_allowed_min);
 
     // Include the lost motor scaled by _thrust_boost_ratio to smoothly transition this motor in and out of the calculation
-    if (_thrust_boost && motor_enabled[_motor_lost_index]) {
+    if (lost_row < num_rows) {
         // Check the maximum yaw control that can be used on this channel
         // Exclude any lost motors if thrust boost is enabled
-        if (!is_zero(_yaw_factor[_motor_lost_index])){
-            const float thrust_rp_best_throttle = throttle_thrust_best_rpy + _thrust_rpyt_out[_motor_lost_index];
+        if (!is_zero(yaw_factor[lost_row])){
+            const float thrust_rp_best_throttle = throttle_thrust_best_rpy + thrust_out[lost_row];
             float motor_room;
-            if (is_positive(yaw_thrust * _yaw_factor[_motor_lost_index])) {
+            if (is_positive(yaw_thrust * yaw_factor[lost_row])) {
                 motor_room = 1.0 - thrust_rp_best_throttle;
             } else {
                 motor_room = thrust_rp_best_throttle;
             }
-            const float motor_yaw_allowed = MAX(motor_room, 0.0)/fabsf(_yaw_factor[_motor_lost_index]);
+            const float motor_yaw_allowed = MAX(motor_room, 0.0)/fabsf(yaw_factor[lost_row]);
             yaw_allowed = boost_ratio(yaw_allowed, MIN(yaw_allowed, motor_yaw_allowed));
         }
     }
@@ -333,26 +364,24 @@ void AP_MotorsMatrix::output_armed_stabilizing()
     // add yaw control to thrust outputs
     float rpy_low = 1.0f;   // lowest thrust value
     float rpy_high = -1.0f; // highest thrust value
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            _thrust_rpyt_out[i] = _thrust_rpyt_out[i] + yaw_thrust * _yaw_factor[i];
+    for (uint8_t j = 0; j < num_rows; j++) {
+        thrust_out[j] = thrust_out[j] + yaw_thrust * yaw_factor[j];
 
-            // record lowest roll + pitch + yaw command
-            if (_thrust_rpyt_out[i] < rpy_low) {
-                rpy_low = _thrust_rpyt_out[i];
-            }
-            // record highest roll + pitch + yaw command
-            // Exclude any lost motors if thrust boost is enabled
-            if (_thrust_rpyt_out[i] > rpy_high && (!_thrust_boost || i != _motor_lost_index)) {
-                rpy_high = _thrust_rpyt_out[i];
-            }
+        // record lowest roll + pitch + yaw command
+        if (thrust_out[j] < rpy_low) {
+            rpy_low = thrust_out[j];
+        }
+        // record highest roll + pitch + yaw command
+        // Exclude any lost motors if thrust boost is enabled
+        if (thrust_out[j] > rpy_high && j != lost_row) {
+            rpy_high = thrust_out[j];
         }
     }
     // Include the lost motor scaled by _thrust_boost_ratio to smoothly transition this motor in and out of the calculation
-    if (_thrust_boost) {
+    if (lost_row < num_rows) {
         // record highest roll + pitch + yaw command
-        if (_thrust_rpyt_out[_motor_lost_index] > rpy_high && motor_enabled[_motor_lost_index]) {
-            rpy_high = boost_ratio(rpy_high, _thrust_rpyt_out[_motor_lost_index]);
+        if (thrust_out[lost_row] > rpy_high) {
+            rpy_high = boost_ratio(rpy_high, thrust_out[lost_row]);
         }
     }
 
@@ -391,10 +420,11 @@ void AP_MotorsMatrix::output_armed_stabilizing()
 
     // add scaled roll, pitch, constrained yaw and throttle for each motor
     const float throttle_thrust_best_plus_adj = throttle_thrust_best_rpy + thr_adj;
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            _thrust_rpyt_out[i] = (throttle_thrust_best_plus_adj * _throttle_factor[i]) + (rpy_scale * _thrust_rpyt_out[i]);
-        }
+    for (uint8_t j = 0; j < num_rows; j++) {
+        thrust_out[j] = (throttle_thrust_best_plus_adj * throttle_factor[j]) + (rpy_scale * thrust_out[j]);
+    }
+    for (uint8_t j = 0; j < num_rows; j++) {
+        _thrust_rpyt_out[_mix.motor[j]] = thrust_out[j];
     }
 
     // determine throttle thrust for harmonic notch
@@ -417,26 +447,19 @@ void AP_MotorsMatrix::check_for_failed_motor(float throttle_thrust_best_plus_adj
 {
     // record filtered and scaled thrust output for motor loss monitoring purposes
     float alpha = _dt_s / (_dt_s + 0.5f);
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            _thrust_rpyt_out_filt[i] += alpha * (_thrust_rpyt_out[i] - _thrust_rpyt_out_filt[i]);
-        }
-    }
-
     float rpyt_high = 0.0f;
     float rpyt_sum = 0.0f;
-    uint8_t number_motors = 0.0f;
-    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            number_motors += 1;
-            rpyt_sum += _thrust_rpyt_out_filt[i];
-            // record highest filtered thrust command
-            if (_thrust_rpyt_out_filt[i] > rpyt_high) {
-                rpyt_high = _thrust_rpyt_out_filt[i];
-                // hold motor lost index constant while thrust boost is active
-                if (!_thrust_boost) {
-                    _motor_lost_index = i;
-                }
+    const uint8_t number_motors = _mix.num_rows;
+    for (uint8_t j = 0; j < number_motors; j++) {
+        const uint8_t i = _mix.motor[j];
+        _thrust_rpyt_out_filt[i] += alpha * (_thrust_rpyt_out[i] - _thrust_rpyt_out_filt[i]);
+        rpyt_sum += _thrust_rpyt_out_filt[i];
+        // record highest filtered thrust command
+        if (_thrust_rpyt_out_filt[i] > rpyt_high) {
+            rpyt_high = _thrust_rpyt_out_filt[i];
+            // hold motor lost index constant while thrust boost is active
+            if (!_thrust_boost) {
+                _motor_lost_index = i;
             }
         }
     }
@@ -521,6 +544,8 @@ void AP_MotorsMatrix::add_motor_raw(int8_t motor_num, float roll_fac, float pitc
         // set order that motor appears in test
         _test_order[motor_num] = testing_order;
 
+        invalidate_mix_rows();
+
         // call parent class method
         add_motor_num(motor_num);
     }
@@ -554,6 +579,7 @@ void AP_MotorsMatrix::remove_motor(int8_t motor_num)
         _pitch_factor[motor_num] = 0.0f;
         _yaw_factor[motor_num] = 0.0f;
         _throttle_factor[motor_num] = 0.0f;
+        invalidate_mix_rows();
     }
 }
 
@@ -1338,6 +1364,31 @@ void AP_MotorsMatrix::normalise_rpy_factors()
             }
         }
     }
+    invalidate_mix_rows();
+}
+
+/*
+  pack the factors of the enabled motors into contiguous rows. The
+  mixer runs at the rate loop rate, so it iterates over just these
+  rows rather than testing motor_enabled[] for every possible motor
+ */
+void AP_MotorsMatrix::update_mix_rows()
+{
+    uint8_t num_rows = 0;
+    for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
+        if (!motor_enabled[i]) {
+            continue;
+        }
+        _mix.roll[num_rows] = _roll_factor[i];
+        _mix.pitch[num_rows] = _pitch_factor[i];
+        _mix.yaw[num_rows] = _yaw_factor[i];
+        _mix.throttle[num_rows] = _throttle_factor[i];
+        _mix.out[num_rows] = _thrust_rpyt_out[i];
+        _mix.motor[num_rows] = i;
+        num_rows++;
+    }
+    _mix.num_rows = num_rows;
+    _mix.valid = true;
 }
 
 
@@ -1362,6 +1413,7 @@ void AP_MotorsMatrix::disable_yaw_torque(void)
     for (uint8_t i = 0; i < AP_MOTORS_MAX_NUM_MOTORS; i++) {
         _yaw_factor[i] = 0;
     }
+    invalidate_mix_rows();
 }
 
 #if APM_BUILD_TYPE(APM_BUILD_UNKNOWN)
@@ -127,6 +127,10 @@ protected:
     // normalizes the roll, pitch and yaw factors so maximum magnitude is 0.5
     void                normalise_rpy_factors();
 
+    // must be called after changing any factor or enabled motor so
+    // the mixer repacks its rows before the next output
+    void                invalidate_mix_rows() { _mix.valid = false; }
+
     // call vehicle supplied thrust compensation if set
     void                thrust_compensation(void) override;
 
@@ -149,12 +153,28 @@ protected:
     float               _thrust_rpyt_out_filt[AP_MOTORS_MAX_NUM_MOTORS];    // filtered thrust outputs with 1 second time constant
     uint8_t             _motor_lost_index;  // index number of the lost motor
 
+    // factors of the enabled motors packed into contiguous rows, in
+    // motor order, so the mixer loops touch only the motors in use
+    struct {
+        float roll[AP_MOTORS_MAX_NUM_MOTORS];
+        float pitch[AP_MOTORS_MAX_NUM_MOTORS];
+        float yaw[AP_MOTORS_MAX_NUM_MOTORS];
+        float throttle[AP_MOTORS_MAX_NUM_MOTORS];
+        float out[AP_MOTORS_MAX_NUM_MOTORS];    // mixer working output of each row
+        uint8_t motor[AP_MOTORS_MAX_NUM_MOTORS]; // motor index of each row
+        uint8_t num_rows;
+        bool valid;
+    } _mix;
+
     motor_frame_class   _active_frame_class; // active frame class (i.e. quad, hexa, octa, etc)
     motor_frame_type    _active_frame_type;  // active frame type (i.e. plus, x, v, etc)
 
     const char*         _frame_class_string = ""; // string representation of frame class
     const char*         _frame_type_string = "";  //  string representation of frame type
 
+    // pack the factors of the enabled motors into _mix
+    virtual void        update_mix_rows();
+
 private:
 
     // helper to return value scaled between boost and normal based on the value of _thrust_boost_ratio
@@ -104,6 +104,24 @@ float Thrust_Linearization::thrust_to_actuator(float thrust_in) const
     return spin_min + (spin_max - spin_min) * apply_thrust_curve_and_volt_scaling(thrust_in);
 }
 
+// converts num desired thrusts to linearized actuator outputs in a range of 0~1
+// the same curve as above, using the terms calculated once per output cycle in update_curve()
+void Thrust_Linearization::thrust_to_actuator(const float thrust_in[], float actuator[], uint8_t num) const
+{
+    if (curve.linear) {
+        for (uint8_t i = 0; i < num; i++) {
+            const float thrust = constrain_float(thrust_in[i], 0.0, 1.0);
+            actuator[i] = curve.spin_min + curve.spin_range * (curve.gain * thrust);
+        }
+        return;
+    }
+    for (uint8_t i = 0; i < num; i++) {
+        const float thrust = constrain_float(thrust_in[i], 0.0, 1.0);
+        const float throttle = (curve.offset + safe_sqrt(curve.sqrt_offset + curve.sqrt_gain * thrust)) * curve.gain;
+        actuator[i] = curve.spin_min + curve.spin_range * constrain_float(throttle, 0.0, 1.0);
+    }
+}
+
 // inverse of above, tested with AP_Motors/examples/expo_inverse_test
 // used to calculate equivelent motor throttle level to direct ouput, used in tailsitter transtions
 float Thrust_Linearization::actuator_to_thrust(float actuator) const
@@ -160,6 +178,7 @@ void Thrust_Linearization::update_lift_max_from_batt_voltage()
     if ((batt_voltage_max <= 0) || (batt_voltage_min >= batt_voltage_max) || (_batt_voltage < 0.25 * batt_voltage_min)) {
         batt_voltage_filt.reset(1.0);
         lift_max = 1.0;
+        update_curve();
         return;
     }
 
@@ -180,6 +199,29 @@ void Thrust_Linearization::update_lift_max_from_batt_voltage()
     float thrust_curve_expo = constrain_float(curve_expo, -1.0, 1.0);
     lift_max = batt_voltage_filt.get() * (1 - thrust_curve_expo) + thrust_curve_expo * batt_voltage_filt.get() * batt_voltage_filt.get();
 #endif
+    update_curve();
+}
+
+// calculate the terms of apply_thrust_curve_and_volt_scaling() that do not depend on thrust
+// so the batched thrust_to_actuator() is left with one square root per motor
+void Thrust_Linearization::update_curve()
+{
+    float battery_scale = 1.0;
+    if (is_positive(batt_voltage_filt.get())) {
+        battery_scale = 1.0 / batt_voltage_filt.get();
+    }
+    const float thrust_curve_expo = constrain_float(curve_expo, -1.0, 1.0);
+    curve.linear = is_zero(thrust_curve_expo);
+    if (curve.linear) {
+        curve.gain = lift_max * battery_scale;
+    } else {
+        curve.sqrt_offset = (1.0 - thrust_curve_expo) * (1.0 - thrust_curve_expo);
+        curve.sqrt_gain = 4.0 * thrust_curve_expo * lift_max;
+        curve.offset = thrust_curve_expo - 1.0;
+        curve.gain = battery_scale / (2.0 * thrust_curve_expo);
+    }
+    curve.spin_min = spin_min;
+    curve.spin_range = spin_max - spin_min;
 }
 
 // return gain scheduling gain based on voltage and air density
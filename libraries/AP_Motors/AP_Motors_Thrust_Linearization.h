@@ -20,6 +20,10 @@ public:
     // Converts desired thrust to linearized actuator output in a range of 0~1
     float thrust_to_actuator(float thrust_in) const;
 
+    // Converts num desired thrusts to linearized actuator outputs, as thrust_to_actuator() above
+    // Uses the curve terms from the last call to update_lift_max_from_batt_voltage()
+    void thrust_to_actuator(const float thrust_in[], float actuator[], uint8_t num) const;
+
     // Inverse of above
     float actuator_to_thrust(float actuator) const;
 
@@ -56,6 +60,20 @@ protected:
     AP_Float batt_voltage_min; // minimum voltage used to scale lift
 
 private:
+    // recalculate the curve terms used by the batched thrust_to_actuator()
+    void update_curve();
+
+    // thrust curve and voltage scaling terms, recalculated once per output cycle
+    struct {
+        bool  linear;       // true if the expo is zero
+        float sqrt_offset;  // (1 - expo)^2
+        float sqrt_gain;    // 4 * expo * lift_max
+        float offset;       // expo - 1
+        float gain;         // battery_scale / (2 * expo), or lift_max * battery_scale if linear
+        float spin_min;     // actuator output at zero thrust
+        float spin_range;   // spin_max - spin_min
+    } curve;
+
     float               lift_max;          // maximum lift ratio from battery voltage
     float               throttle_limit;    // ratio of throttle limit between hover and maximum
     LowPassFilterFloat  batt_voltage_filt; // filtered battery voltage expressed as a percentage (0 ~ 1.0) of batt_voltage_max
@@ -56,7 +56,7 @@ void setup()
     AP_Motors::motor_frame_class frame_class = AP_Motors::MOTOR_FRAME_QUAD;
 
     // Parse the command line arguments
-    uint8_t argc;
+    int argc;
     char * const *argv;
     hal.util->commandline_arguments(argc, argv);
     if (argc > 1) {
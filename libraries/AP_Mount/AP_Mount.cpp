@@ -216,7 +216,9 @@ void AP_Mount::update()
     // update each instance
     for (uint8_t instance=0; instance<AP_MOUNT_MAX_INSTANCES; instance++) {
         if (_backends[instance] != nullptr) {
+            const uint32_t start_us = AP_HAL::micros();
             _backends[instance]->update();
+            _backends[instance]->record_update_time(AP_HAL::micros() - start_us);
         }
     }
 }
@@ -227,7 +229,9 @@ void AP_Mount::update_fast()
     // update each instance
     for (uint8_t instance=0; instance<AP_MOUNT_MAX_INSTANCES; instance++) {
         if (_backends[instance] != nullptr) {
+            const uint32_t start_us = AP_HAL::micros();
             _backends[instance]->update_fast();
+            _backends[instance]->record_update_time(AP_HAL::micros() - start_us);
         }
     }
 }
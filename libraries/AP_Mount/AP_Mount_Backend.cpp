@@ -413,6 +413,22 @@ bool AP_Mount_Backend::handle_global_position_int(uint8_t msg_sysid, const mavli
 
 #if HAL_LOGGING_ENABLED
 // write mount log packet
+// record the time taken by a call to update() or update_fast()
+void AP_Mount_Backend::record_update_time(uint32_t dt_us)
+{
+    _update_load.counter_us += dt_us;
+    _update_load.max_counter_us = MAX(_update_load.max_counter_us, dt_us);
+
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _update_load.window_start_ms >= 1000) {
+        _update_load.window_start_ms = now_ms;
+        _update_load.load_us = _update_load.counter_us;
+        _update_load.max_us = _update_load.max_counter_us;
+        _update_load.counter_us = 0;
+        _update_load.max_counter_us = 0;
+    }
+}
+
 void AP_Mount_Backend::write_log(uint64_t timestamp_us)
 {
     // return immediately if no yaw estimate
@@ -456,6 +472,8 @@ void AP_Mount_Backend::write_log(uint64_t timestamp_us)
         desired_yaw_ef: target_yaw_is_ef ? target_yaw : nanf,
         actual_yaw_ef : yaw_ef,
         rangefinder_dist : rangefinder_dist,
+        update_load   : get_update_load_us(),
+        update_max    : get_update_max_us(),
     };
     AP::logger().WriteCriticalBlock(&pkt, sizeof(pkt));
 }
@@ -147,6 +147,14 @@ public:
     // write mount log packet
     void write_log(uint64_t timestamp_us);
 
+    // record the time taken by a call to update() or update_fast()
+    void record_update_time(uint32_t dt_us);
+
+    // microseconds per second spent in update() and update_fast() and
+    // the longest single call, over the last second
+    uint32_t get_update_load_us() const { return _update_load.load_us; }
+    uint32_t get_update_max_us() const { return _update_load.max_us; }
+
     //
     // camera controls for gimbals that include a camera
     //
@@ -341,6 +349,15 @@ private:
 
     uint32_t _last_warning_ms;      // system time of last warning sent to GCS
 
+    // time spent updating this backend
+    struct {
+        uint32_t window_start_ms;   // system time the current one second window started
+        uint32_t counter_us;        // time spent in this window
+        uint32_t max_counter_us;    // longest call in this window
+        uint32_t load_us;           // time spent in the last window
+        uint32_t max_us;            // longest call in the last window
+    } _update_load;
+
     // structure holding the last RC inputs
     struct {
         bool    initialised;
@@ -89,6 +89,7 @@ void AP_Mount_Servo::update()
     }
 
     // send target angles or rates depending on the target type
+    _stabilise_fast = false;
     switch (mnt_target.target_type) {
         case MountTargetType::RATE:
             update_angle_target_from_rate(mnt_target.rate_rads, mnt_target.angle_rad);
@@ -97,6 +98,7 @@ void AP_Mount_Servo::update()
             // update _angle_bf_output_rad based on angle target
             if ((mount_mode != MAV_MOUNT_MODE_RETRACT) && (mount_mode != MAV_MOUNT_MODE_NEUTRAL)) {
                 update_angle_outputs(mnt_target.angle_rad);
+                _stabilise_fast = requires_stabilization;
             }
             break;
     }
@@ -111,6 +113,24 @@ void AP_Mount_Servo::update()
     move_servo(_pan_idx,  degrees(_angle_bf_output_rad.z)*10, _params.yaw_angle_min*10, _params.yaw_angle_max*10);
 }
 
+/*
+  targets are updated at the mount update rate, but the vehicle's
+  attitude and rates used to stabilise the servos are re-applied at the
+  main loop rate
+ */
+void AP_Mount_Servo::update_fast()
+{
+    if (!_stabilise_fast) {
+        return;
+    }
+
+    update_angle_outputs(mnt_target.angle_rad);
+
+    move_servo(_roll_idx, degrees(_angle_bf_output_rad.x)*10, _params.roll_angle_min*10, _params.roll_angle_max*10);
+    move_servo(_tilt_idx, degrees(_angle_bf_output_rad.y)*10, _params.pitch_angle_min*10, _params.pitch_angle_max*10);
+    move_servo(_pan_idx,  degrees(_angle_bf_output_rad.z)*10, _params.yaw_angle_min*10, _params.yaw_angle_max*10);
+}
+
 // returns true if this mount can control its roll
 bool AP_Mount_Servo::has_roll_control() const
 {
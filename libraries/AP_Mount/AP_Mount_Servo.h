@@ -33,6 +33,9 @@ public:
     // update mount position - should be called periodically
     void update() override;
 
+    // re-apply stabilisation from the latest vehicle attitude at the main loop rate
+    void update_fast() override;
+
     // returns true if this mount can control its roll
     bool has_roll_control() const override;
 
@@ -65,5 +68,6 @@ private:
     SRV_Channel::Function    _open_idx;  // SRV_Channel mount open function index
 
     Vector3f _angle_bf_output_rad;  // final body frame output angle in radians
+    bool _stabilise_fast;           // true if outputs follow the angle target and may be stabilised by update_fast()
 };
 #endif // HAL_MOUNT_SERVO_ENABLED
@@ -19,6 +19,8 @@
 // @Field: DYawE: Desired yaw in earth frame
 // @Field: YawE: Actual yaw in earth frame
 // @Field: Dist: Rangefinder distance
+// @Field: Load: Time spent updating the mount over the last second
+// @Field: LMax: Longest single update over the last second
 
 struct PACKED log_Mount {
     LOG_PACKET_HEADER;
@@ -33,12 +35,14 @@ struct PACKED log_Mount {
     float    desired_yaw_ef;
     float    actual_yaw_ef;
     float    rangefinder_dist;
+    uint32_t update_load;
+    uint32_t update_max;
 };
 
 #if HAL_MOUNT_ENABLED
 #define LOG_STRUCTURE_FROM_MOUNT \
     { LOG_MOUNT_MSG, sizeof(log_Mount), \
-      "MNT", "QBfffffffff","TimeUS,I,DRoll,Roll,DPitch,Pitch,DYawB,YawB,DYawE,YawE,Dist", "s#ddddddddm", "F---------0" },
+      "MNT", "QBfffffffffII","TimeUS,I,DRoll,Roll,DPitch,Pitch,DYawB,YawB,DYawE,YawE,Dist,Load,LMax", "s#ddddddddmss", "F---------0FF" },
 #else
 #define LOG_STRUCTURE_FROM_MOUNT
 #endif
@@ -7,6 +7,7 @@
 #include "AP_MultiHeap.h"
 
 #include <AP_Math/AP_Math.h>
+#include <AP_Common/ExpandingString.h>
 #include <stdio.h>
 
 /*
@@ -66,6 +67,18 @@ void MultiHeap::destroy(void)
     if (!available()) {
         return;
     }
+    // give the pool pages back first so the heaps are empty
+    for (uint16_t i=0; i<pool_num_pages; i++) {
+        heap_free(pool_pages[i].base);
+    }
+    if (pool_pages != nullptr) {
+        heap_free(pool_pages);
+    }
+    pool_pages = nullptr;
+    pool_num_pages = 0;
+    pool_max_pages = 0;
+    memset(pools, 0, sizeof(pools));
+
     for (uint8_t i=0; i<num_heaps; i++) {
         if (heaps[i].hp != nullptr) {
             heap_destroy(heaps[i].hp);
@@ -86,23 +99,50 @@ bool MultiHeap::available(void) const
 }
 
 /*
-  allocate memory from a heap
+  allocate memory, from the pools for small sizes
  */
 void *MultiHeap::allocate(uint32_t size)
 {
     if (!available() || size == 0) {
         return nullptr;
     }
+    if (size <= MULTIHEAP_POOL_MAX_SIZE) {
+        return pool_allocate(pool_class(size));
+    }
+    return heap_allocate_expand(size);
+}
+
+/*
+  allocate memory from the first heap with space
+ */
+void *MultiHeap::allocate_from_heaps(uint32_t size)
+{
     for (uint8_t i=0; i<num_heaps; i++) {
         if (heaps[i].hp == nullptr) {
             break;
         }
         void *newptr = heap_allocate(heaps[i].hp, size);
         if (newptr != nullptr) {
-            last_failed = false;
             return newptr;
         }
     }
+    return nullptr;
+}
+
+/*
+  allocate memory from a heap, adding a heap if needed and allowed
+ */
+void *MultiHeap::heap_allocate_expand(uint32_t size)
+{
+    void *newptr = allocate_from_heaps(size);
+    if (newptr == nullptr && pool_release_pages()) {
+        // pages of free small blocks may have been in the way
+        newptr = allocate_from_heaps(size);
+    }
+    if (newptr != nullptr) {
+        last_failed = false;
+        return newptr;
+    }
     if (!allow_expansion || !last_failed) {
         /*
           we only allow expansion when the last allocation
@@ -166,6 +206,11 @@ void MultiHeap::deallocate(void *ptr)
     if (!available() || ptr == nullptr) {
         return;
     }
+    const int32_t page = pool_find_page(ptr);
+    if (page >= 0) {
+        pool_free(pool_pages[page], ptr);
+        return;
+    }
     heap_free(ptr);
 }
 
@@ -179,6 +224,13 @@ void *MultiHeap::change_size(void *ptr, uint32_t old_size, uint32_t new_size)
         deallocate(ptr);
         return nullptr;
     }
+    if (ptr != nullptr && new_size <= MULTIHEAP_POOL_MAX_SIZE) {
+        const int32_t page = pool_find_page(ptr);
+        if (page >= 0 && pool_pages[page].cls == pool_class(new_size)) {
+            // the block is already the right size
+            return ptr;
+        }
+    }
     /*
       we don't want to require the underlying allocation system to
       support realloc() and we also want to be able to handle the case
@@ -201,3 +253,209 @@ void *MultiHeap::change_size(void *ptr, uint32_t old_size, uint32_t new_size)
     deallocate(ptr);
     return newp;
 }
+
+/*
+  find the page holding a pointer with a binary search of the page table
+ */
+int32_t MultiHeap::pool_find_page(const void *ptr) const
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+    if (pool_num_pages == 0 || p < pool_pages[0].base) {
+        return -1;
+    }
+    // find the last page starting at or before p
+    uint16_t lo = 0;
+    uint16_t hi = pool_num_pages;
+    while (hi - lo > 1) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (pool_pages[mid].base <= p) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    if (p >= pool_pages[lo].base + POOL_PAGE_SIZE) {
+        return -1;
+    }
+    return lo;
+}
+
+/*
+  allocate a block of a size class, taking a new page from the heaps
+  when there are no free blocks
+ */
+void *MultiHeap::pool_allocate(uint8_t cls)
+{
+    Pool &pool = pools[cls];
+    if (pool.free_list == nullptr && !pool_add_page(cls)) {
+        return nullptr;
+    }
+
+    PoolBlock *block = pool.free_list;
+    pool.free_list = block->next;
+    pool.num_free--;
+    pool.num_used++;
+    pool_pages[pool_find_page(block)].num_used++;
+
+    return block;
+}
+
+/*
+  take a page from the heaps and add its blocks to a size class
+ */
+bool MultiHeap::pool_add_page(uint8_t cls)
+{
+    if (pool_num_pages == pool_max_pages) {
+        // grow the page table
+        const uint16_t new_max = MIN(uint32_t(MAX(pool_max_pages * 2U, 32U)), uint32_t(UINT16_MAX));
+        if (new_max == pool_max_pages) {
+            return false;
+        }
+        PoolPage *new_pages = (PoolPage *)heap_allocate_expand(new_max * sizeof(PoolPage));
+        if (new_pages == nullptr) {
+            return false;
+        }
+        if (pool_pages != nullptr) {
+            memcpy(new_pages, pool_pages, pool_num_pages * sizeof(PoolPage));
+            heap_free(pool_pages);
+        }
+        pool_pages = new_pages;
+        pool_max_pages = new_max;
+    }
+
+    uint8_t *base = (uint8_t *)heap_allocate_expand(POOL_PAGE_SIZE);
+    if (base == nullptr) {
+        return false;
+    }
+
+    // keep the table sorted by address
+    uint16_t idx = pool_num_pages;
+    while (idx > 0 && pool_pages[idx-1].base > base) {
+        pool_pages[idx] = pool_pages[idx-1];
+        idx--;
+    }
+    pool_pages[idx].base = base;
+    pool_pages[idx].num_used = 0;
+    pool_pages[idx].cls = cls;
+    pool_num_pages++;
+
+    // thread the new blocks onto the free list in address order
+    Pool &pool = pools[cls];
+    const uint16_t block_size = pool_block_size(cls);
+    const uint16_t num_blocks = pool_blocks_per_page(cls);
+    for (uint16_t i=num_blocks; i>0; i--) {
+        PoolBlock *block = (PoolBlock *)(base + (i-1) * block_size);
+        block->next = pool.free_list;
+        pool.free_list = block;
+    }
+    pool.num_free += num_blocks;
+    pool.num_pages++;
+
+    return true;
+}
+
+/*
+  return a block to its size class
+ */
+void MultiHeap::pool_free(PoolPage &page, void *ptr)
+{
+    Pool &pool = pools[page.cls];
+    PoolBlock *block = (PoolBlock *)ptr;
+    block->next = pool.free_list;
+    pool.free_list = block;
+    pool.num_free++;
+    pool.num_used--;
+    page.num_used--;
+}
+
+/*
+  give pages in which every block is free back to the heaps. This is
+  slow, but is only done when a heap allocation has failed
+ */
+bool MultiHeap::pool_release_pages(void)
+{
+    bool any_unused = false;
+    for (uint16_t i=0; i<pool_num_pages; i++) {
+        if (pool_pages[i].num_used == 0) {
+            any_unused = true;
+            break;
+        }
+    }
+    if (!any_unused) {
+        return false;
+    }
+
+    // take the blocks of unused pages out of the free lists
+    for (uint8_t cls=0; cls<POOL_NUM_CLASSES; cls++) {
+        Pool &pool = pools[cls];
+        for (PoolBlock **link = &pool.free_list; *link != nullptr; ) {
+            if (pool_pages[pool_find_page(*link)].num_used == 0) {
+                *link = (*link)->next;
+                pool.num_free--;
+            } else {
+                link = &(*link)->next;
+            }
+        }
+    }
+
+    // free the unused pages, keeping the table sorted
+    uint16_t n = 0;
+    for (uint16_t i=0; i<pool_num_pages; i++) {
+        PoolPage &page = pool_pages[i];
+        if (page.num_used == 0) {
+            pools[page.cls].num_pages--;
+            heap_free(page.base);
+            continue;
+        }
+        pool_pages[n++] = page;
+    }
+    pool_num_pages = n;
+
+    return true;
+}
+
+/*
+  write pool and heap usage as text. Pool fragmentation is the
+  proportion of pool memory held in free blocks, heap fragmentation is
+  the proportion of free heap memory not in the largest free block
+ */
+void MultiHeap::info(ExpandingString &str) const
+{
+    if (!available()) {
+        return;
+    }
+    uint32_t pool_bytes = 0;
+    uint32_t pool_free_bytes = 0;
+    for (uint8_t cls=0; cls<POOL_NUM_CLASSES; cls++) {
+        const Pool &pool = pools[cls];
+        const uint16_t block_size = pool_block_size(cls);
+        str.printf("POOL %-3u PAGES=%-4u USED=%-6u FREE=%-6u\n",
+                   unsigned(block_size),
+                   unsigned(pool.num_pages),
+                   unsigned(pool.num_used),
+                   unsigned(pool.num_free));
+        pool_bytes += pool.num_pages * POOL_PAGE_SIZE;
+        pool_free_bytes += pool.num_free * block_size;
+    }
+    str.printf("POOLS SIZE=%-7u FREE=%-7u FRAG=%u%%\n",
+               unsigned(pool_bytes),
+               unsigned(pool_free_bytes),
+               unsigned(pool_bytes > 0 ? (100U * pool_free_bytes) / pool_bytes : 0));
+
+    uint32_t free_bytes = 0;
+    uint32_t largest_block = 0;
+    for (uint8_t i=0; i<num_heaps; i++) {
+        if (heaps[i].hp == nullptr) {
+            break;
+        }
+        uint32_t heap_free_bytes, heap_largest;
+        heap_status(heaps[i].hp, heap_free_bytes, heap_largest);
+        free_bytes += heap_free_bytes;
+        largest_block = MAX(largest_block, heap_largest);
+    }
+    str.printf("HEAPS SIZE=%-7u FREE=%-7u LARGEST=%-7u FRAG=%u%%\n",
+               unsigned(sum_size),
+               unsigned(free_bytes),
+               unsigned(largest_block),
+               unsigned(free_bytes > 0 ? (100U * (free_bytes - largest_block)) / free_bytes : 0));
+}
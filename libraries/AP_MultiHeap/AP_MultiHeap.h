@@ -12,6 +12,17 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/*
+  allocations of up to this many bytes are served from pools of fixed
+  size blocks rather than the underlying heaps, so the small
+  allocations lua makes constantly do not fragment the heaps
+ */
+#ifndef MULTIHEAP_POOL_MAX_SIZE
+#define MULTIHEAP_POOL_MAX_SIZE 64
+#endif
+
+class ExpandingString;
+
 class MultiHeap {
 public:
     /*
@@ -33,6 +44,9 @@ public:
     // allocation API
     void *change_size(void *ptr, uint32_t old_size, uint32_t new_size);
 
+    // write pool and heap usage and fragmentation as text
+    void info(ExpandingString &str) const;
+
     /*
       get the size that we have expanded to. Used by error reporting in scripting
      */
@@ -57,6 +71,58 @@ private:
     // re-use memory when possible
     bool last_failed;
 
+    /*
+      small block pools. Each size class has a free list threaded
+      through its free blocks, filled a page at a time from the
+      heaps. The pages are kept in a table sorted by address so the
+      page, and so the size class, of any pointer can be found. Pages
+      only go back to the heaps when a heap allocation fails and every
+      block in the page is free
+     */
+    static constexpr uint8_t POOL_GRANULE = 8;
+    static constexpr uint8_t POOL_NUM_CLASSES = MULTIHEAP_POOL_MAX_SIZE / POOL_GRANULE;
+    static constexpr uint16_t POOL_PAGE_SIZE = 1024;
+
+    struct PoolBlock {
+        PoolBlock *next;
+    };
+    struct PoolPage {
+        uint8_t *base;
+        uint16_t num_used;  // number of blocks allocated to the user
+        uint8_t cls;        // size class of the blocks
+    };
+    struct Pool {
+        PoolBlock *free_list;
+        uint32_t num_free;  // number of blocks in free_list
+        uint32_t num_used;  // number of blocks allocated to the user
+        uint16_t num_pages;
+    } pools[POOL_NUM_CLASSES];
+
+    PoolPage *pool_pages;   // all pages, sorted by base address
+    uint16_t pool_num_pages;
+    uint16_t pool_max_pages;
+
+    // size class for an allocation size of at most MULTIHEAP_POOL_MAX_SIZE
+    static uint8_t pool_class(uint32_t size) { return (size - 1) / POOL_GRANULE; }
+    static uint16_t pool_block_size(uint8_t cls) { return (cls + 1) * POOL_GRANULE; }
+    static uint16_t pool_blocks_per_page(uint8_t cls) { return POOL_PAGE_SIZE / pool_block_size(cls); }
+
+    // index of the page holding ptr, -1 if ptr is not in a pool
+    int32_t pool_find_page(const void *ptr) const;
+
+    void *pool_allocate(uint8_t cls);
+    bool pool_add_page(uint8_t cls);
+    void pool_free(PoolPage &page, void *ptr);
+
+    // return completely free pages to the heaps, returns true if any were released
+    bool pool_release_pages(void);
+
+    // allocate from the heaps, expanding them if allowed
+    void *heap_allocate_expand(uint32_t size);
+
+    // allocate from the first heap with space
+    void *allocate_from_heaps(uint32_t size);
+
 
     /*
       low level allocation functions
@@ -76,4 +142,7 @@ private:
     // free some memory that was allocated by heap_allocate. The implementation must
     // be able to determine which heap the allocation was from using the pointer
     void heap_free(void *ptr);
+
+    // get the free memory in a heap and the largest block which could be allocated
+    void heap_status(void *heap, uint32_t &free_bytes, uint32_t &largest_block) const;
 };
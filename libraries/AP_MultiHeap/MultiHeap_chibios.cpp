@@ -44,4 +44,13 @@ void MultiHeap::heap_free(void *ptr)
     return chHeapFree(ptr);
 }
 
+void MultiHeap::heap_status(void *heap, uint32_t &free_bytes, uint32_t &largest_block) const
+{
+    size_t totalp = 0;
+    size_t largest = 0;
+    chHeapStatus((memory_heap_t *)heap, &totalp, &largest);
+    free_bytes = totalp;
+    largest_block = largest;
+}
+
 #endif // CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
@@ -116,4 +116,15 @@ void MultiHeap::heap_free(void *ptr)
     free(header);
 }
 
+/*
+  get free memory of a heap. Fragmentation is not simulated, so the
+  largest block is all of the free memory
+ */
+void MultiHeap::heap_status(void *heap_ptr, uint32_t &free_bytes, uint32_t &largest_block) const
+{
+    const struct heap *heapp = (const struct heap*)heap_ptr;
+    free_bytes = heapp->max_heap_size - heapp->current_heap_usage;
+    largest_block = free_bytes;
+}
+
 #endif // CONFIG_HAL_BOARD != HAL_BOARD_CHIBIOS
@@ -54,4 +54,61 @@ TEST(MultiHeap, Tests)
     delete[] allocs;
 }
 
+/*
+  check that small allocations through change_size keep their
+  contents, and that pool pages go back to the heap when all their
+  blocks are freed
+ */
+TEST(MultiHeap, Pools)
+{
+    static MultiHeap h;
+
+    EXPECT_TRUE(h.create(20000, 1, false, 0));
+
+    const uint32_t max_allocs = 400;
+    struct alloc {
+        uint8_t *ptr;
+        uint32_t size;
+        uint8_t fill;
+    };
+    auto *allocs = new alloc[max_allocs] {};
+
+    for (uint32_t i=0; i<20000; i++) {
+        auto &a = allocs[get_random16() % max_allocs];
+        for (uint32_t j=0; j<a.size; j++) {
+            EXPECT_EQ(a.ptr[j], a.fill);
+        }
+        const uint32_t size = get_random16() % 100;
+        uint8_t *p = (uint8_t *)h.change_size(a.ptr, a.size, size);
+        if (size != 0 && p == nullptr) {
+            // out of memory, the old allocation is still valid
+            continue;
+        }
+        EXPECT_TRUE(size==0?p == nullptr : p != nullptr);
+        for (uint32_t j=0; j<MIN(a.size, size); j++) {
+            EXPECT_EQ(p[j], a.fill);
+        }
+        a.ptr = p;
+        a.size = size;
+        a.fill = i;
+        memset(a.ptr, a.fill, a.size);
+    }
+
+    for (uint32_t i=0; i<max_allocs; i++) {
+        auto &a = allocs[i];
+        h.change_size(a.ptr, a.size, 0);
+        a.ptr = nullptr;
+        a.size = 0;
+    }
+
+    // with every pool block free the whole heap is available for a
+    // single large allocation
+    void *big = h.allocate(18000);
+    EXPECT_TRUE(big != nullptr);
+    h.deallocate(big);
+
+    h.destroy();
+    delete[] allocs;
+}
+
 AP_GTEST_MAIN()
@@ -609,3 +609,17 @@ bool AP_NavEKF_Source::gps_yaw_enabled(void) const
     }
     return false;
 }
+
+// return true if compass yaw is enabled on any source
+bool AP_NavEKF_Source::compass_yaw_enabled(void) const
+{
+    for (uint8_t i=0; i<AP_NAKEKF_SOURCE_SET_MAX; i++) {
+        const auto &src = _source_set[i];
+        const SourceYaw yaw = SourceYaw(src.yaw.get());
+        if (yaw == SourceYaw::COMPASS ||
+            yaw == SourceYaw::GPS_COMPASS_FALLBACK) {
+            return true;
+        }
+    }
+    return false;
+}
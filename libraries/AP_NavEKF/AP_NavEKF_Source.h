@@ -122,6 +122,9 @@ public:
     // return true if GPS yaw is enabled on any source
     bool gps_yaw_enabled(void) const;
 
+    // return true if compass yaw is enabled on any source
+    bool compass_yaw_enabled(void) const;
+
     // return true if wheel encoder is enabled on any source
     bool wheel_encoder_enabled(void) const;
 
@@ -20,6 +20,18 @@
 #include <AP_Math/AP_Math.h>
 #include <AP_Math/vectorN.h>
 #include "AP_Nav_Common.h"
+#include <AP_NavEKF3/AP_NavEKF3_feature.h>
+
+/*
+  when EKF3 cores can run on a worker thread the scratch space must be
+  per-thread. This costs a little CPU for the thread local address
+  lookup so it is only done on the HALs that support threaded cores
+ */
+#if EK3_FEATURE_THREADED_CORES
+#define NAVEKF_SCRATCH_STORAGE static thread_local
+#else
+#define NAVEKF_SCRATCH_STORAGE static
+#endif
 
 /*
   this declares a common parent class for AP_NavEKF2 and
@@ -42,10 +54,10 @@ public:
 #endif
 
 protected:
-    static Matrix24 KH;                   // intermediate result used for covariance updates
-    static Matrix24 KHP;                  // intermediate result used for covariance updates
-    static Matrix24 nextP;                // Predicted covariance matrix before addition of process noise to diagonals
-    static Vector28 Kfusion;              // intermediate fusion vector
+    NAVEKF_SCRATCH_STORAGE Matrix24 KH;       // intermediate result used for covariance updates
+    NAVEKF_SCRATCH_STORAGE Matrix24 KHP;      // intermediate result used for covariance updates
+    NAVEKF_SCRATCH_STORAGE Matrix24 nextP;    // Predicted covariance matrix before addition of process noise to diagonals
+    NAVEKF_SCRATCH_STORAGE Vector28 Kfusion;  // intermediate fusion vector
 
     // fill all the common scratch variables with NaN on SITL
     void fill_scratch_variables(void);
@@ -8,6 +8,27 @@
 #include <string.h>
 #include <AP_InternalError/AP_InternalError.h>
 
+#define EKF_BUFFER_CACHE_LINE 64U
+
+static uint32_t cache_line_align(uint32_t n)
+{
+    return (n + EKF_BUFFER_CACHE_LINE - 1) & ~(EKF_BUFFER_CACHE_LINE - 1);
+}
+
+/*
+  allocate zeroed storage starting on a cache line. buffer is set to
+  the allocation to free, the aligned start is returned
+ */
+static void *alloc_aligned(void *&buffer, uint32_t bytes)
+{
+    free(buffer);
+    buffer = calloc(1, bytes + EKF_BUFFER_CACHE_LINE - 1);
+    if (buffer == nullptr) {
+        return nullptr;
+    }
+    return (void *)((uintptr_t(buffer) + EKF_BUFFER_CACHE_LINE - 1) & ~uintptr_t(EKF_BUFFER_CACHE_LINE - 1));
+}
+
 // constructor
 ekf_ring_buffer::ekf_ring_buffer(uint8_t _elsize) :
     elsize(_elsize),
@@ -16,13 +37,13 @@ ekf_ring_buffer::ekf_ring_buffer(uint8_t _elsize) :
 
 bool ekf_ring_buffer::init(uint8_t _size)
 {
-    if (buffer) {
-        free(buffer);
-    }
-    buffer = calloc(_size, elsize);
-    if (buffer == nullptr) {
+    const uint32_t times_bytes = cache_line_align(_size * sizeof(uint32_t));
+    uint8_t *p = (uint8_t *)alloc_aligned(buffer, times_bytes + _size * uint32_t(elsize));
+    if (p == nullptr) {
         return false;
     }
+    times = (uint32_t *)p;
+    elements = p + times_bytes;
     size = _size;
     reset();
     return true;
@@ -33,16 +54,7 @@ bool ekf_ring_buffer::init(uint8_t _size)
  */
 void *ekf_ring_buffer::get_offset(uint8_t idx) const
 {
-    return (void*)(((uint8_t*)buffer)+idx*uint32_t(elsize));
-}
-
-/*
-  get a reference to the timestamp for an index
- */
-uint32_t ekf_ring_buffer::time_ms(uint8_t idx) const
-{
-    EKF_obs_element_t *el = (EKF_obs_element_t *)get_offset(idx);
-    return el->time_ms;
+    return (void*)(((uint8_t*)elements)+idx*uint32_t(elsize));
 }
 
 /*
@@ -52,6 +64,36 @@ uint32_t ekf_ring_buffer::time_ms(uint8_t idx) const
 */
 bool ekf_ring_buffer::recall(void *element, const uint32_t sample_time_ms)
 {
+    if (sorted) {
+        // binary search for the number of elements at or before the
+        // sample time, all of which are consumed. The youngest of
+        // them is the only one that can be less than 100msec old
+        uint8_t lo = 0;
+        uint8_t hi = count;
+        while (lo < hi) {
+            const uint8_t mid = (lo + hi) / 2;
+            if (int32_t(sample_time_ms - time_ms((oldest+mid) % size)) >= 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == 0) {
+            return false;
+        }
+        const uint8_t best_index = (oldest+lo-1) % size;
+        count -= lo;
+        oldest = (oldest+lo) % size;
+        if (count == 0) {
+            sorted = true;
+        }
+        if (sample_time_ms - time_ms(best_index) >= 100) {
+            return false;
+        }
+        memcpy(element, get_offset(best_index), elsize);
+        return true;
+    }
+
     bool ret = false;
     uint8_t best_index = 0;  // only valid when ret becomes true
     while (count > 0) {
@@ -71,6 +113,9 @@ bool ekf_ring_buffer::recall(void *element, const uint32_t sample_time_ms)
         count--;
         oldest = (oldest+1) % size;
     }
+    if (count == 0) {
+        sorted = true;
+    }
 
     if (ret) {
         memcpy(element, get_offset(best_index), elsize);
@@ -79,6 +124,20 @@ bool ekf_ring_buffer::recall(void *element, const uint32_t sample_time_ms)
     return ret;
 }
 
+/*
+  recall from several buffers at the same sample time
+ */
+uint32_t ekf_ring_buffer::recall_all(const recall_entry *entries, uint8_t n, const uint32_t sample_time_ms)
+{
+    uint32_t found = 0;
+    for (uint8_t i=0; i<n; i++) {
+        if (entries[i].buf->recall(entries[i].element, sample_time_ms)) {
+            found |= 1U<<i;
+        }
+    }
+    return found;
+}
+
 /*
  * Writes data and timestamp to a Ring buffer and advances indices that
  * define the location of the newest and oldest data
@@ -94,6 +153,13 @@ void ekf_ring_buffer::push(const void *element)
 
     // New data is written at the head
     memcpy(get_offset(head), element, elsize);
+    const uint32_t t = ((const EKF_obs_element_t *)element)->time_ms;
+    if (count > 0 && int32_t(t - time_ms((head+size-1) % size)) < 0) {
+        // older than the previous sample, search linearly until the
+        // buffer has been emptied
+        sorted = false;
+    }
+    times[head] = t;
 
     if (count < size) {
         count++;
@@ -108,6 +174,7 @@ void ekf_ring_buffer::reset()
 {
     count = 0;
     oldest = 0;
+    sorted = true;
 }
 
 ////////////////////////////////////////////////////
@@ -118,7 +185,8 @@ void ekf_ring_buffer::reset()
 
 // constructor
 ekf_imu_buffer::ekf_imu_buffer(uint8_t _elsize) :
-    elsize(_elsize)
+    elsize(_elsize),
+    buffer(nullptr)
 {}
 
 /*
@@ -126,18 +194,15 @@ ekf_imu_buffer::ekf_imu_buffer(uint8_t _elsize) :
  */
 void *ekf_imu_buffer::get_offset(uint8_t idx) const
 {
-    return (void*)(((uint8_t*)buffer)+idx*uint32_t(elsize));
+    return (void*)(((uint8_t*)elements)+idx*uint32_t(elsize));
 }
 
 // initialise buffer, returns false when allocation has failed
 bool ekf_imu_buffer::init(uint32_t size)
 {
-    if (buffer != nullptr) {
-        // allow for init twice
-        free(buffer);
-    }
-    buffer = calloc(size, elsize);
-    if (buffer == nullptr) {
+    // allows for init twice
+    elements = alloc_aligned(buffer, size * uint32_t(elsize));
+    if (elements == nullptr) {
         return false;
     }
     _size = size;
@@ -192,7 +257,7 @@ void ekf_imu_buffer::reset()
 {
     _youngest = 0;
     _oldest = 0;
-    memset(buffer, 0, _size*uint32_t(elsize));
+    memset(elements, 0, _size*uint32_t(elsize));
 }
 
 // retrieves data from the ring buffer at a specified index
@@ -2,8 +2,10 @@
   common EKF buffer classes. These handles the storage buffers for EKF
   data to bring it onto the fusion time horizon
 */
+#pragma once
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <type_traits>
 
 typedef struct {
@@ -30,6 +32,18 @@ public:
     */
     bool recall(void *element, const uint32_t sample_time_ms);
 
+    // a buffer and the element to recall into for recall_all()
+    struct recall_entry {
+        ekf_ring_buffer *buf;
+        void *element;
+    };
+
+    /*
+     * recall from several buffers at the same sample time. Returns a
+     * mask with bit i set when data was found for entries[i]
+     */
+    static uint32_t recall_all(const recall_entry *entries, uint8_t n, const uint32_t sample_time_ms);
+
     /*
      * Writes data and timestamp to a Ring buffer and advances indices that
      * define the location of the newest and oldest data
@@ -43,6 +57,13 @@ private:
     const uint8_t elsize;
     void *buffer;
 
+    // cache line aligned element storage within buffer
+    void *elements;
+
+    // timestamps of the elements, kept apart from the elements so a
+    // search only touches a few cache lines
+    uint32_t *times;
+
     // size of allocated buffer in elsize units
     uint8_t size;
 
@@ -52,7 +73,12 @@ private:
     // total number of elements in the buffer
     uint8_t count;
 
-    uint32_t time_ms(uint8_t idx) const;
+    // true while the elements in the buffer are in time order
+    bool sorted;
+
+    uint32_t time_ms(uint8_t idx) const {
+        return times[idx];
+    }
     void *get_offset(uint8_t idx) const;
 };
 
@@ -79,6 +105,11 @@ public:
         return ekf_ring_buffer::recall(&element, sample_time);
     }
 
+    // entry for ekf_ring_buffer::recall_all()
+    ekf_ring_buffer::recall_entry batch_entry(element_type &element) {
+        return ekf_ring_buffer::recall_entry{this, &element};
+    }
+
     void push(const element_type &element) {
         return ekf_ring_buffer::push(&element);
     }
@@ -136,6 +167,8 @@ public:
 protected:
     const uint8_t elsize;
     void *buffer;
+    // cache line aligned element storage within buffer
+    void *elements;
     uint8_t _size,_oldest,_youngest;
     bool _filled;
 
@@ -203,3 +236,279 @@ public:
         return ekf_imu_buffer::get_youngest_index();
     }
 };
+
+
+/*
+  output predictor state history, indexed in the same way as the IMU
+  buffer. The element type must have quat, velocity and position
+  members.
+
+  Each state component is held in its own cache line aligned
+  array. Changes to every element (a tracking correction or reset
+  added to all elements, a value written to all elements, or a
+  rotation of all quaternions) are held as a running offset, fill
+  value or pending rotation for the component, so they cost O(1)
+  rather than a pass through the whole history.
+ */
+template <typename element_type>
+class EKF_output_buffer_t
+{
+public:
+    typedef decltype(element_type::quat) quat_type;
+    typedef decltype(element_type::velocity) vec_type;
+    typedef decltype(vec_type::x) scalar_type;
+
+    EKF_output_buffer_t() {}
+    ~EKF_output_buffer_t() {
+        free(buffer);
+    }
+
+    // initialise buffer, returns false when allocation has failed
+    bool init(uint8_t size);
+
+    // zeroes all data in the buffer
+    void reset() {
+        fill(element_type{quat_type(0, 0, 0, 0), vec_type(), vec_type()});
+    }
+
+    // retrieve the element at an index
+    element_type get(uint8_t index) const;
+
+    // store an element at an index
+    void set(uint8_t index, const element_type &element);
+
+    // write the same data to all elements
+    void fill(const element_type &element);
+    void fill_quat(const quat_type &q);
+    void fill_velocity(uint8_t axis, scalar_type v) {
+        vel[axis].fill(v, write_seq);
+    }
+    void fill_position(uint8_t axis, scalar_type p) {
+        pos[axis].fill(p, write_seq);
+    }
+
+    // add a change to all elements
+    void add_velocity(const vec_type &dv) {
+        for (uint8_t i=0; i<3; i++) {
+            vel[i].offset += dv[i];
+        }
+    }
+    void add_position(const vec_type &dp) {
+        for (uint8_t i=0; i<3; i++) {
+            pos[i].offset += dp[i];
+        }
+    }
+    void add_position(uint8_t axis, scalar_type dp) {
+        pos[axis].offset += dp;
+    }
+
+    // post-multiply all quaternions by a rotation
+    void rotate_quat(const quat_type &rot);
+
+private:
+    static const uint8_t cache_line = 64;
+
+    /*
+      a vector component. Elements stored at or before fill_seq read
+      as fill_value, later ones as their stored value, plus offset
+     */
+    struct sum_column {
+        scalar_type *data;
+        scalar_type offset;
+        scalar_type fill_value;
+        uint32_t fill_seq;
+
+        void fill(scalar_type v, uint32_t seq) {
+            offset = 0;
+            fill_value = v;
+            fill_seq = seq;
+        }
+        scalar_type get(uint8_t index, uint32_t seq) const {
+            return (seq <= fill_seq ? fill_value : data[index]) + offset;
+        }
+        // move the offset into the stored values, so it doesn't grow
+        // and cost precision over a long flight
+        void fold(uint8_t size) {
+            if (offset == 0) {
+                return;
+            }
+            for (uint8_t i=0; i<size; i++) {
+                data[i] += offset;
+            }
+            fill_value += offset;
+            offset = 0;
+        }
+    };
+    sum_column vel[3];
+    sum_column pos[3];
+
+    /*
+      quaternions. Elements stored at or before fill_seq read as
+      fill_value, elements stored between fill_seq and rot_seq are
+      post-multiplied by rot
+     */
+    struct {
+        quat_type *data;
+        quat_type fill_value;
+        uint32_t fill_seq;
+        quat_type rot;
+        uint32_t rot_seq;
+        // number of elements stored after fill_seq
+        uint8_t stored_count;
+        // number of those stored at or before rot_seq
+        uint8_t rot_count;
+    } quat;
+
+    // sequence number of the last store to each element
+    uint32_t *seq;
+    uint32_t write_seq;
+
+    // elements stored since the offsets were last folded
+    uint8_t fold_count;
+
+    void *buffer = nullptr;
+    uint8_t size;
+
+    // rewrite all elements with their current values and restart
+    // the sequence numbers
+    void renumber(void);
+};
+
+template <typename element_type>
+bool EKF_output_buffer_t<element_type>::init(uint8_t _size)
+{
+    free(buffer);
+    const auto align = [](uint32_t n) { return (n + cache_line - 1) & ~uint32_t(cache_line - 1); };
+    const uint32_t scalar_bytes = align(_size * sizeof(scalar_type));
+    const uint32_t quat_bytes = align(_size * sizeof(quat_type));
+    const uint32_t seq_bytes = align(_size * sizeof(uint32_t));
+    buffer = calloc(1, 6*scalar_bytes + quat_bytes + seq_bytes + cache_line);
+    if (buffer == nullptr) {
+        return false;
+    }
+    uint8_t *p = (uint8_t *)((uintptr_t(buffer) + cache_line - 1) & ~uintptr_t(cache_line - 1));
+    quat.data = (quat_type *)p;
+    p += quat_bytes;
+    for (uint8_t i=0; i<3; i++) {
+        vel[i].data = (scalar_type *)p;
+        p += scalar_bytes;
+        pos[i].data = (scalar_type *)p;
+        p += scalar_bytes;
+    }
+    seq = (uint32_t *)p;
+    size = _size;
+    write_seq = 0;
+    fold_count = 0;
+    reset();
+    return true;
+}
+
+template <typename element_type>
+element_type EKF_output_buffer_t<element_type>::get(uint8_t index) const
+{
+    element_type ret;
+    const uint32_t s = seq[index];
+    if (s <= quat.fill_seq) {
+        ret.quat = quat.fill_value;
+    } else if (s <= quat.rot_seq) {
+        ret.quat = quat.data[index] * quat.rot;
+    } else {
+        ret.quat = quat.data[index];
+    }
+    for (uint8_t i=0; i<3; i++) {
+        ret.velocity[i] = vel[i].get(index, s);
+        ret.position[i] = pos[i].get(index, s);
+    }
+    return ret;
+}
+
+template <typename element_type>
+void EKF_output_buffer_t<element_type>::set(uint8_t index, const element_type &element)
+{
+    if (write_seq == UINT32_MAX) {
+        renumber();
+    }
+    const uint32_t s = seq[index];
+    if (s <= quat.fill_seq) {
+        quat.stored_count++;
+    } else if (s <= quat.rot_seq) {
+        quat.rot_count--;
+    }
+    seq[index] = ++write_seq;
+    quat.data[index] = element.quat;
+    for (uint8_t i=0; i<3; i++) {
+        vel[i].data[index] = element.velocity[i] - vel[i].offset;
+        pos[i].data[index] = element.position[i] - pos[i].offset;
+    }
+    if (++fold_count >= size) {
+        // once per wrap of the buffer
+        fold_count = 0;
+        for (uint8_t i=0; i<3; i++) {
+            vel[i].fold(size);
+            pos[i].fold(size);
+        }
+    }
+}
+
+template <typename element_type>
+void EKF_output_buffer_t<element_type>::fill(const element_type &element)
+{
+    fill_quat(element.quat);
+    for (uint8_t i=0; i<3; i++) {
+        vel[i].fill(element.velocity[i], write_seq);
+        pos[i].fill(element.position[i], write_seq);
+    }
+}
+
+template <typename element_type>
+void EKF_output_buffer_t<element_type>::fill_quat(const quat_type &q)
+{
+    quat.fill_value = q;
+    quat.fill_seq = write_seq;
+    quat.rot_seq = write_seq;
+    quat.stored_count = 0;
+    quat.rot_count = 0;
+}
+
+template <typename element_type>
+void EKF_output_buffer_t<element_type>::rotate_quat(const quat_type &rot)
+{
+    quat.fill_value = quat.fill_value * rot;
+    if (quat.rot_count > 0) {
+        // elements stored before the previous rotation are still in
+        // the buffer, so apply it to them before starting a new one
+        for (uint8_t i=0; i<size; i++) {
+            if (seq[i] > quat.fill_seq && seq[i] <= quat.rot_seq) {
+                quat.data[i] = quat.data[i] * quat.rot;
+            }
+        }
+    }
+    quat.rot = rot;
+    quat.rot_seq = write_seq;
+    quat.rot_count = quat.stored_count;
+}
+
+template <typename element_type>
+void EKF_output_buffer_t<element_type>::renumber(void)
+{
+    for (uint8_t i=0; i<size; i++) {
+        const element_type e = get(i);
+        quat.data[i] = e.quat;
+        for (uint8_t j=0; j<3; j++) {
+            vel[j].data[i] = e.velocity[j];
+            pos[j].data[i] = e.position[j];
+        }
+        seq[i] = 1;
+    }
+    for (uint8_t j=0; j<3; j++) {
+        vel[j].offset = 0;
+        vel[j].fill_seq = 0;
+        pos[j].offset = 0;
+        pos[j].fill_seq = 0;
+    }
+    quat.fill_seq = 0;
+    quat.rot_seq = 0;
+    quat.stored_count = size;
+    quat.rot_count = 0;
+    write_seq = 1;
+}
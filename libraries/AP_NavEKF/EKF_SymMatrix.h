@@ -0,0 +1,100 @@
+/*
+  packed storage for symmetric EKF covariance matrices
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <AP_Math/vectorN.h>
+
+/*
+  symmetric NxN matrix held as only the upper triangle, stored column
+  by column. Element (i,j) with i<=j is at j*(j+1)/2+i, so a column of
+  the upper triangle is contiguous in memory, which matches the access
+  pattern of the generated covariance prediction code.
+
+  Elements are accessed with the same M[i][j] syntax as a full
+  matrix. M[i][j] and M[j][i] refer to the same storage, so callers
+  must not apply an in-place update to both halves of the matrix.
+ */
+template <typename T, uint8_t N>
+class EKF_SymMatrix {
+public:
+    static constexpr uint16_t num_elements = uint16_t(N) * (N+1) / 2;
+
+    // packed index of element (i,j)
+    static constexpr uint16_t index(uint8_t i, uint8_t j) {
+        return i <= j ? uint16_t(j) * (j+1) / 2 + i : uint16_t(i) * (i+1) / 2 + j;
+    }
+
+    class Row {
+    public:
+        Row(T *_data, uint8_t _row) : data(_data), row(_row) {}
+        T &operator[](uint8_t col) const {
+#if MATH_CHECK_INDEXES
+            assert(col < N);
+#endif
+            return data[index(row, col)];
+        }
+    private:
+        T *data;
+        const uint8_t row;
+    };
+
+    class ConstRow {
+    public:
+        ConstRow(const T *_data, uint8_t _row) : data(_data), row(_row) {}
+        const T &operator[](uint8_t col) const {
+#if MATH_CHECK_INDEXES
+            assert(col < N);
+#endif
+            return data[index(row, col)];
+        }
+    private:
+        const T *data;
+        const uint8_t row;
+    };
+
+    Row operator[](uint8_t row) {
+#if MATH_CHECK_INDEXES
+        assert(row < N);
+#endif
+        return Row(_v, row);
+    }
+
+    ConstRow operator[](uint8_t row) const {
+#if MATH_CHECK_INDEXES
+        assert(row < N);
+#endif
+        return ConstRow(_v, row);
+    }
+
+    // zero rows and columns in the range [first,last]
+    void zero_rows_cols(uint8_t first, uint8_t last) {
+        for (uint8_t i=first; i<=last; i++) {
+            for (uint8_t j=0; j<N; j++) {
+                _v[index(i, j)] = 0;
+            }
+        }
+    }
+
+    void zero(void) {
+        memset(_v, 0, sizeof(_v));
+    }
+
+private:
+    T _v[num_elements];
+};
@@ -0,0 +1,42 @@
+/*
+  benchmark of EKF observation buffer recall. Each iteration pushes a
+  sample and recalls at a delayed time horizon, as the EKF does each
+  prediction cycle, with the argument being the number of samples
+  held in the buffer
+ */
+#include <AP_gbenchmark.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_NavEKF/EKF_Buffer.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+struct obs_element : EKF_obs_element_t {
+    float data[6];
+};
+
+static void BM_EKFBufferRecall(benchmark::State& state)
+{
+    const uint8_t held = state.range(0);
+    EKF_obs_buffer_t<obs_element> buf;
+    buf.init(held + 1);
+
+    obs_element e {};
+    obs_element out;
+    uint32_t now_ms = 0;
+    for (uint8_t i=0; i<held; i++) {
+        e.time_ms = now_ms++;
+        buf.push(e);
+    }
+
+    while (state.KeepRunning()) {
+        e.time_ms = now_ms++;
+        buf.push(e);
+        buf.recall(out, now_ms - held);
+        gbenchmark_escape(&out);
+    }
+}
+
+BENCHMARK(BM_EKFBufferRecall)->Arg(4)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,49 @@
+/*
+  benchmark of the EKFGSF_yaw model bank, running the prediction for
+  every IMU sample and fusing a velocity measurement every tenth
+  sample while the vehicle circles at constant speed
+ */
+#include <AP_gbenchmark.h>
+
+#include <AP_NavEKF/EKFGSF_yaw.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static constexpr ftype imu_dt = 0.0025f;
+static constexpr ftype speed = 10.0f;
+static constexpr ftype yaw_rate = 0.2f;
+
+// one IMU sample, fusing velocity when fuse_vel is set
+static void step(EKFGSF_yaw &gsf, uint32_t i, bool fuse_vel)
+{
+    const ftype yaw = yaw_rate * imu_dt * i;
+    const Vector3F del_ang{0, 0, yaw_rate * imu_dt};
+    const Vector3F del_vel{0, speed * yaw_rate * imu_dt, -GRAVITY_MSS * imu_dt};
+    gsf.update(del_ang, del_vel, imu_dt, imu_dt, true, 0);
+    if (fuse_vel) {
+        gsf.fuseVelData(Vector2F{speed * cosF(yaw), speed * sinF(yaw)}, 0.5f);
+    }
+}
+
+static void BM_EKFGSFUpdate(benchmark::State& state)
+{
+    EKFGSF_yaw *gsf = NEW_NOTHROW EKFGSF_yaw();
+
+    // align and converge before timing
+    uint32_t i = 0;
+    for (; i < 4000; i++) {
+        step(*gsf, i, i % 10 == 0);
+    }
+
+    while (state.KeepRunning()) {
+        step(*gsf, i, i % 10 == 0);
+        i++;
+        gbenchmark_escape(gsf);
+    }
+
+    delete gsf;
+}
+
+BENCHMARK(BM_EKFGSFUpdate);
+
+BENCHMARK_MAIN();
@@ -5,6 +5,7 @@
  */
 
 #include <AP_NavEKF/EKF_Buffer.h>
+#include <AP_Math/AP_Math.h>
 #include <stdlib.h>
 
 #include <AP_HAL/AP_HAL.h>
@@ -122,6 +123,96 @@ TEST(EKF_Buffer, EKF_Buffer)
     EXPECT_FALSE(buf.recall(d2, 103));
 }
 
+TEST(EKF_Buffer, matches_linear_search)
+{
+    // compare against scanning from the oldest element, with
+    // occasional out of order samples and time wrap
+    struct test_data : EKF_obs_element_t {
+        uint32_t data;
+    };
+    const uint8_t size = 10;
+    EKF_obs_buffer_t<test_data> buf;
+    ASSERT_TRUE(buf.init(size));
+    test_data ref[size];
+    uint8_t ref_oldest = 0;
+    uint8_t ref_count = 0;
+
+    srandom(23);
+    uint32_t now = 0xFFFF0000U;
+    for (uint32_t n=0; n<20000; n++) {
+        if (random() % 3 != 0) {
+            test_data d;
+            now += random() % 40;
+            d.time_ms = now;
+            if (random() % 50 == 0) {
+                d.time_ms -= random() % 200;
+            }
+            d.data = n;
+            buf.push(d);
+            ref[(ref_oldest+ref_count) % size] = d;
+            if (ref_count < size) {
+                ref_count++;
+            } else {
+                ref_oldest = (ref_oldest+1) % size;
+            }
+            continue;
+        }
+        const uint32_t sample_time_ms = now - random() % 250;
+        bool ref_ret = false;
+        uint32_t ref_data = 0;
+        while (ref_count > 0) {
+            const int32_t dt = sample_time_ms - ref[ref_oldest].time_ms;
+            if (dt < 0) {
+                break;
+            }
+            if (dt < 100) {
+                ref_ret = true;
+                ref_data = ref[ref_oldest].data;
+            }
+            ref_count--;
+            ref_oldest = (ref_oldest+1) % size;
+        }
+        test_data d2;
+        ASSERT_EQ(ref_ret, buf.recall(d2, sample_time_ms));
+        if (ref_ret) {
+            ASSERT_EQ(ref_data, d2.data);
+        }
+    }
+}
+
+TEST(EKF_Buffer, recall_all)
+{
+    struct test_data : EKF_obs_element_t {
+        uint32_t data;
+    };
+    EKF_obs_buffer_t<test_data> buf1, buf2, buf3;
+    buf1.init(4);
+    buf2.init(4);
+    buf3.init(4);
+    test_data d;
+    d.time_ms = 100;
+    d.data = 1;
+    buf1.push(d);
+    d.time_ms = 105;
+    d.data = 2;
+    buf3.push(d);
+    d.time_ms = 120;
+    d.data = 3;
+    buf3.push(d);
+
+    test_data d1 {}, d2 {}, d3 {};
+    const ekf_ring_buffer::recall_entry entries[] {
+        buf1.batch_entry(d1),
+        buf2.batch_entry(d2),
+        buf3.batch_entry(d3),
+    };
+    EXPECT_EQ(ekf_ring_buffer::recall_all(entries, ARRAY_SIZE(entries), 110), 0x5U);
+    EXPECT_EQ(d1.data, 1U);
+    EXPECT_EQ(d3.data, 2U);
+    EXPECT_EQ(ekf_ring_buffer::recall_all(entries, ARRAY_SIZE(entries), 130), 0x4U);
+    EXPECT_EQ(d3.data, 3U);
+}
+
 TEST(ekf_imu_buffer, one_element_case)
 {
     // test degenerate 1-element case:
@@ -176,6 +267,129 @@ TEST(ekf_imu_buffer, is_filled)
     EXPECT_EQ(b->is_filled(), true);
 }
 
+TEST(EKF_output_buffer, matches_full_history)
+{
+    // compare against applying every change to every element
+    struct element {
+        Quaternion quat;
+        Vector3f velocity;
+        Vector3f position;
+    };
+    const uint8_t size = 12;
+    EKF_output_buffer_t<element> buf;
+    ASSERT_TRUE(buf.init(size));
+    element ref[size];
+    for (auto &e : ref) {
+        e.quat.zero();
+        e.velocity.zero();
+        e.position.zero();
+    }
+
+    srandom(17);
+    const auto rnd = []() { return float(random() % 2001) * 0.001f - 1.0f; };
+    uint8_t youngest = 0;
+    for (uint32_t n=0; n<5000; n++) {
+        const uint32_t op = random() % 20;
+        if (op < 10) {
+            element e;
+            e.quat.from_euler(rnd(), rnd(), rnd());
+            e.velocity = Vector3f(rnd(), rnd(), rnd());
+            e.position = Vector3f(rnd(), rnd(), rnd()) * 100;
+            youngest = (youngest + 1) % size;
+            buf.set(youngest, e);
+            ref[youngest] = e;
+        } else if (op < 14) {
+            const Vector3f dv(rnd(), rnd(), rnd());
+            const Vector3f dp(rnd(), rnd(), rnd());
+            buf.add_velocity(dv);
+            buf.add_position(dp);
+            for (auto &e : ref) {
+                e.velocity += dv;
+                e.position += dp;
+            }
+        } else if (op == 14) {
+            const uint8_t axis = random() % 3;
+            const float v = rnd();
+            buf.fill_velocity(axis, v);
+            buf.fill_position(axis, v * 10);
+            for (auto &e : ref) {
+                e.velocity[axis] = v;
+                e.position[axis] = v * 10;
+            }
+        } else if (op == 15) {
+            const float dp = rnd() * 1000;
+            buf.add_position(2, dp);
+            for (auto &e : ref) {
+                e.position.z += dp;
+            }
+        } else if (op < 18) {
+            Quaternion rot;
+            rot.from_euler(0, 0, rnd());
+            buf.rotate_quat(rot);
+            for (auto &e : ref) {
+                e.quat = e.quat * rot;
+            }
+        } else if (op == 18) {
+            Quaternion q;
+            q.from_euler(rnd(), rnd(), rnd());
+            buf.fill_quat(q);
+            for (auto &e : ref) {
+                e.quat = q;
+            }
+        } else if (n % 7 == 0) {
+            element e;
+            e.quat.from_euler(rnd(), rnd(), rnd());
+            e.velocity = Vector3f(rnd(), rnd(), rnd());
+            e.position = Vector3f(rnd(), rnd(), rnd());
+            buf.fill(e);
+            for (auto &r : ref) {
+                r = e;
+            }
+        }
+
+        for (uint8_t i=0; i<size; i++) {
+            const element e = buf.get(i);
+            for (uint8_t j=0; j<4; j++) {
+                ASSERT_NEAR(e.quat[j], ref[i].quat[j], 1.0e-4);
+            }
+            for (uint8_t j=0; j<3; j++) {
+                ASSERT_NEAR(e.velocity[j], ref[i].velocity[j], 1.0e-3);
+                ASSERT_NEAR(e.position[j], ref[i].position[j], 1.0e-1);
+            }
+        }
+    }
+
+    buf.reset();
+    const element e = buf.get(0);
+    EXPECT_FLOAT_EQ(e.quat.q1, 0);
+    EXPECT_FLOAT_EQ(e.position.z, 0);
+}
+
+TEST(EKF_output_buffer, long_flight_precision)
+{
+    // corrections accumulated over a long flight must not cost
+    // precision on newly stored elements
+    struct element {
+        Quaternion quat;
+        Vector3f velocity;
+        Vector3f position;
+    };
+    const uint8_t size = 12;
+    EKF_output_buffer_t<element> buf;
+    ASSERT_TRUE(buf.init(size));
+    uint8_t youngest = 0;
+    for (uint32_t n=0; n<200000; n++) {
+        buf.add_position(Vector3f(1, 1, 1));
+        element e {};
+        e.position = Vector3f(0.001f, 0.002f, 0.003f) * (n % 100);
+        youngest = (youngest + 1) % size;
+        buf.set(youngest, e);
+        const element r = buf.get(youngest);
+        ASSERT_NEAR(r.position.x, e.position.x, 1.0e-4);
+        ASSERT_NEAR(r.position.z, e.position.z, 1.0e-4);
+    }
+}
+
 AP_GTEST_MAIN()
 
 #endif // HAL_SITL or HAL_LINUX
@@ -0,0 +1,59 @@
+#include <AP_gtest.h>
+
+/*
+  tests for AP_NavEKF/EKF_SymMatrix.h
+ */
+
+#include <AP_NavEKF/EKF_SymMatrix.h>
+#include <AP_Math/AP_Math.h>
+
+#include <AP_HAL/AP_HAL.h>
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+TEST(EKF_SymMatrix, Packing)
+{
+    EXPECT_EQ((EKF_SymMatrix<float,24>::num_elements), 300U);
+    EXPECT_EQ(sizeof(EKF_SymMatrix<float,24>), 300U*sizeof(float));
+
+    // every upper triangle element maps to a unique index
+    bool used[300] {};
+    for (uint8_t j=0; j<24; j++) {
+        for (uint8_t i=0; i<=j; i++) {
+            const uint16_t idx = EKF_SymMatrix<float,24>::index(i, j);
+            ASSERT_LT(idx, 300U);
+            EXPECT_FALSE(used[idx]);
+            used[idx] = true;
+            EXPECT_EQ(idx, (EKF_SymMatrix<float,24>::index(j, i)));
+        }
+    }
+}
+
+TEST(EKF_SymMatrix, Access)
+{
+    EKF_SymMatrix<float,24> P;
+    P.zero();
+    for (uint8_t i=0; i<24; i++) {
+        for (uint8_t j=i; j<24; j++) {
+            P[i][j] = i*100 + j;
+        }
+    }
+    for (uint8_t i=0; i<24; i++) {
+        for (uint8_t j=0; j<24; j++) {
+            EXPECT_FLOAT_EQ(P[i][j], MIN(i,j)*100 + MAX(i,j));
+        }
+    }
+
+    // writing the lower half updates the shared element
+    P[5][2] = -1;
+    EXPECT_FLOAT_EQ(P[2][5], -1);
+
+    // zeroing rows also zeroes the matching columns
+    P.zero_rows_cols(4, 5);
+    for (uint8_t i=0; i<24; i++) {
+        EXPECT_FLOAT_EQ(P[i][4], 0);
+        EXPECT_FLOAT_EQ(P[5][i], 0);
+    }
+    EXPECT_FLOAT_EQ(P[3][6], 306);
+}
+
+AP_GTEST_MAIN()
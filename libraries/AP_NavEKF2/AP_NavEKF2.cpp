@@ -3,6 +3,7 @@
 #include "AP_NavEKF2.h"
 
 #include <AP_DAL/AP_DAL.h>
+#include <AP_Common/AP_InitArena.h>
 #include <AP_HAL/AP_HAL.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_Logger/AP_Logger.h>
@@ -707,6 +708,10 @@ bool NavEKF2::InitialiseFilter(void)
                 num_cores++;
             }
         }
+#if AP_INIT_ARENA_ENABLED
+        // cores stay in fast memory, but are included in the memory report
+        AP::init_arena().account("EKF2", sizeof(NavEKF2_core)*num_cores);
+#endif
 
         // Set the primary initially to be the lowest index
         primary = 0;
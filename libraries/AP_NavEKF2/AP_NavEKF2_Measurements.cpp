@@ -393,7 +393,8 @@ void NavEKF2_core::readIMUData()
 
     // Rotate quaternon atitude from previous to new and normalise.
     // Accumulation using quaternions prevents introduction of coning errors due to downsampling
-    imuQuatDownSampleNew.rotate(imuDataNew.delAng);
+    // The rotation for the sample is calculated once per IMU by the DAL
+    imuQuatDownSampleNew *= ins.get_delta_angle_quat(imuDataNew.gyro_index);
     imuQuatDownSampleNew.normalize();
 
     // Rotate the latest delta velocity into body frame at the start of accumulation
@@ -628,9 +629,9 @@ void NavEKF2_core::readGpsData()
                 const auto &compass = dal.compass();
                 if (compass.have_scale_factor(magSelectIndex) &&
                     compass.auto_declination_enabled()) {
-                    table_earth_field_ga = AP_Declination::get_earth_field_ga(gpsloc).toftype();
-                    table_declination = radians(AP_Declination::get_declination(gpsloc.lat*1.0e-7,
-                                                                                gpsloc.lng*1.0e-7));
+                    float declination_deg;
+                    table_earth_field_ga = table_field_cache.get_earth_field_ga(gpsloc, declination_deg).toftype();
+                    table_declination = radians(declination_deg);
                     have_table_earth_field = true;
                     if (frontend->_mag_ef_limit > 0) {
                         // initialise earth field from tables
@@ -25,6 +25,7 @@
 #endif
 
 #include <AP_Common/Location.h>
+#include <AP_Declination/AP_Declination.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_Math/vectorN.h>
 #include <AP_NavEKF/AP_NavEKF_core_common.h>
@@ -1180,6 +1181,7 @@ private:
     bool have_table_earth_field;   // true when we have initialised table_earth_field_ga
     Vector3F table_earth_field_ga; // earth field from WMM tables
     ftype table_declination;       // declination in radians from the tables
+    AP_Declination::Cache table_field_cache; // table cell of the last earth field lookup
 
     // timing statistics
     struct ekf_timing timing;
@@ -10,9 +10,12 @@
 #include <AP_BoardConfig/AP_BoardConfig.h>
 
 #include "AP_DAL/AP_DAL.h"
+#include <AP_Common/AP_InitArena.h>
 
 #include <new>
 
+extern const AP_HAL::HAL& hal;
+
 /*
   parameter defaults for different types of vehicle. The
   APM_BUILD_DIRECTORY is taken from the main vehicle directory name
@@ -739,11 +742,27 @@ const AP_Param::GroupInfo NavEKF3::var_info2[] = {
 
     // @Param: OPTIONS
     // @DisplayName: Optional EKF behaviour
-    // @Description: EKF optional behaviour. Bit 0 (JammingExpected): Setting JammingExpected will change the EKF behaviour such that if dead reckoning navigation is possible it will require the preflight alignment GPS quality checks controlled by EK3_GPS_CHECK and EK3_CHECK_SCALE to pass before resuming GPS use if GPS lock is lost for more than 2 seconds to prevent bad position estimate. Bit 1 (Manual lane switching): DANGEROUS – If enabled, this disables automatic lane switching. If the active lane becomes unhealthy, no automatic switching will occur. Users must manually set EK3_PRIMARY to change lanes. No health checks will be performed on the selected lane. Use with extreme caution.
-    // @Bitmask: 0:JammingExpected, 1: ManualLaneSwitching
+    // @Description: EKF optional behaviour. Bit 0 (JammingExpected): Setting JammingExpected will change the EKF behaviour such that if dead reckoning navigation is possible it will require the preflight alignment GPS quality checks controlled by EK3_GPS_CHECK and EK3_CHECK_SCALE to pass before resuming GPS use if GPS lock is lost for more than 2 seconds to prevent bad position estimate. Bit 1 (Manual lane switching): DANGEROUS – If enabled, this disables automatic lane switching. If the active lane becomes unhealthy, no automatic switching will occur. Users must manually set EK3_PRIMARY to change lanes. No health checks will be performed on the selected lane. Use with extreme caution. Bit 2 (StaggerFusion): If enabled and more than one core is running, the magnetometer, optical flow, range beacon and airspeed fusion steps of each core take turns on successive EKF updates rather than all running on the same update. This reduces the worst case loop time at the cost of fusing those measurements up to one update late per additional core. Bit 3 (ThreadedCores): If enabled and more than one core is running, the non-primary cores are run on a separate thread in parallel with the primary core. Only available on Linux and SITL boards, which have more than one CPU core. Bit 4 (AdaptiveCores): If enabled, while disarmed the EKF reduces its CPU use when the scheduler load stays above 90% for 5 seconds, by first staggering fusion and then stopping the highest numbered lane, and restores lanes when the load stays below 60% for 30 seconds. The number of running lanes is never changed while armed.
+    // @Bitmask: 0:JammingExpected, 1: ManualLaneSwitching, 2:StaggerFusion, 3:ThreadedCores, 4:AdaptiveCores
     // @User: Advanced
     AP_GROUPINFO("OPTIONS",  11, NavEKF3, _options, 0),
 
+    // @Param: FLOW_RATE
+    // @DisplayName: Optical flow fusion rate
+    // @Description: When set above zero, optical flow samples are averaged together and fused at this rate, so every sample from a high rate flow sensor is used without fusing each one. The flow measurement noise, EK3_FLOW_M_NSE, is that of a single sample and the EKF reduces it by the number of samples averaged. When zero, each sample is fused on its own and samples arriving within 50 msec of the previous one are discarded. Fusion is never faster than 20Hz.
+    // @Range: 0 20
+    // @Units: Hz
+    // @User: Advanced
+    AP_GROUPINFO("FLOW_RATE", 12, NavEKF3, _flowFuseRate, 0),
+
+    // @Param: BCN_RATE
+    // @DisplayName: Range beacon maximum fusion rate
+    // @Description: The maximum rate at which range beacon measurements are fused, shared between all beacons. Beacons are taken in turn, so each beacon gets an equal share of the fusions and a system with many beacons reporting at a high rate does not use more CPU than this allows. Set to zero for no limit, where up to one measurement is fused on each EKF update.
+    // @Range: 0 400
+    // @Units: Hz
+    // @User: Advanced
+    AP_GROUPINFO("BCN_RATE", 13, NavEKF3, _rngBcnFuseRate, 0),
+
     AP_GROUPEND
 };
 
@@ -831,6 +850,13 @@ bool NavEKF3::InitialiseFilter(void)
         for (uint8_t i = 0; i < num_cores; i++) {
             new (&core[i]) NavEKF3_core(this, dal);
         }
+#if AP_INIT_ARENA_ENABLED
+        // cores stay in fast memory, but are included in the memory report
+        AP::init_arena().account("EKF3", sizeof(NavEKF3_core)*num_cores);
+#endif
+        num_cores_max = num_cores;
+        core_budget_level = 0;
+        core_restart_mask = 0;
     }
 
     // Set up any cores that have been created
@@ -903,6 +929,52 @@ bool NavEKF3::coreBetterScore(uint8_t new_core, uint8_t current_core) const
     return coreRelativeErrors[new_core] < coreRelativeErrors[current_core];
 }
 
+#if EK3_FEATURE_THREADED_CORES
+/*
+  start the worker thread used to run the non-primary cores. Returns
+  false if the thread is not available, in which case all cores are
+  run on the calling thread
+*/
+bool NavEKF3::start_core_thread(void)
+{
+    switch (core_thread_state) {
+    case CoreThreadState::RUNNING:
+        return true;
+    case CoreThreadState::FAILED:
+        return false;
+    case CoreThreadState::NOT_STARTED:
+        break;
+    }
+    if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&NavEKF3::core_thread, void),
+                                      "EK3", 16384, AP_HAL::Scheduler::PRIORITY_MAIN, 0)) {
+        GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "EKF3: core thread failed to start");
+        core_thread_state = CoreThreadState::FAILED;
+        return false;
+    }
+    core_thread_state = CoreThreadState::RUNNING;
+    return true;
+}
+
+/*
+  worker thread loop. Each frame is started by the main thread, which
+  runs the primary core itself and then waits for this thread to
+  finish the other cores, so the cores are never accessed by both
+  threads at the same time
+*/
+void NavEKF3::core_thread(void)
+{
+    while (true) {
+        core_thread_start.wait_blocking();
+        for (uint8_t i=0; i<num_cores; i++) {
+            if (i != primary) {
+                core[i].UpdateFilter(core_thread_allow_prediction[i]);
+            }
+        }
+        core_thread_done.signal();
+    }
+}
+#endif // EK3_FEATURE_THREADED_CORES
+
 /* 
   Update Filter States - this should be called whenever new IMU data is available
   Execution speed governed by SCHED_LOOP_RATE
@@ -917,6 +989,27 @@ void NavEKF3::UpdateFilter(void)
 
     imuSampleTime_us = dal.micros64();
 
+    bool updates_run = false;
+#if EK3_FEATURE_THREADED_CORES
+    if (num_cores > 1 && option_is_enabled(Option::ThreadedCores) && start_core_thread()) {
+        // the prediction decision uses DAL timing data so must be
+        // made for all cores on this thread before any core is run
+        for (uint8_t i=0; i<num_cores; i++) {
+            core_thread_allow_prediction[i] = true;
+            if (core[i].getFramesSincePredict() < (_framesPerPrediction+3) &&
+                dal.ekf_low_time_remaining(AP_DAL::EKFType::EKF3, i)) {
+                core_thread_allow_prediction[i] = false;
+            }
+        }
+        // run the primary here while the worker runs the others
+        core_thread_start.signal();
+        core[primary].UpdateFilter(core_thread_allow_prediction[primary]);
+        core_thread_done.wait_blocking();
+        for (uint8_t i=0; i<num_cores; i++) {
+            updates_run |= core[i].updatesRun();
+        }
+    } else
+#endif
     for (uint8_t i=0; i<num_cores; i++) {
         // if we have not overrun by more than 3 IMU frames, and we
         // have already used more than 1/3 of the CPU budget for this
@@ -928,8 +1021,16 @@ void NavEKF3::UpdateFilter(void)
             allow_state_prediction = false;
         }
         core[i].UpdateFilter(allow_state_prediction);
+        updates_run |= core[i].updatesRun();
+    }
+
+    // advance the slot used to stagger expensive fusion steps across cores
+    if (updates_run) {
+        fusionFrame++;
     }
 
+    update_core_budget();
+
     // If the current core selected has a bad error score or is unhealthy, switch to a healthy core with the lowest fault score
     // Don't start running the check until the primary core has started returned healthy for at least 10 seconds to avoid switching
     // due to initial alignment fluctuations and race conditions
@@ -1077,6 +1178,103 @@ void NavEKF3::switchLane(uint8_t new_lane_index)
     }
 }
 
+/*
+  adapt the number of running lanes to the scheduler load reported
+  by the DAL. Each step up the budget level either staggers fusion
+  across the running lanes or stops the highest numbered lane, so the
+  levels run all lanes, all lanes staggered, one fewer lane, one fewer
+  lane staggered and so on. The level only changes while disarmed, and
+  the load comes from the DAL so replay makes the same decisions
+*/
+void NavEKF3::update_core_budget(void)
+{
+    // keep bootstrapping lanes that have been brought back into use
+    for (uint8_t i=0; i<num_cores; i++) {
+        if ((core_restart_mask & (1U<<i)) && core[i].InitialiseFilterBootstrap()) {
+            core_restart_mask &= ~(1U<<i);
+        }
+    }
+
+    if (num_cores_max < 2 || dal.get_armed()) {
+        core_load_high_ms = 0;
+        core_load_low_ms = 0;
+        return;
+    }
+
+    static constexpr uint8_t load_high_pct = 90;
+    static constexpr uint8_t load_low_pct = 60;
+    static constexpr uint32_t load_high_time_ms = 5000;
+    static constexpr uint32_t load_low_time_ms = 30000;
+
+    const uint32_t now_ms = dal.millis();
+    const uint8_t load = dal.cpu_load();
+    const uint8_t max_level = 2 * (num_cores_max - 1);
+    uint8_t level = core_budget_level;
+
+    if (!option_is_enabled(Option::AdaptiveCores)) {
+        level = 0;
+    } else if (load > load_high_pct) {
+        core_load_low_ms = 0;
+        if (core_load_high_ms == 0) {
+            core_load_high_ms = now_ms;
+        } else if (now_ms - core_load_high_ms > load_high_time_ms && level < max_level) {
+            level++;
+            core_load_high_ms = 0;
+        }
+    } else if (load < load_low_pct) {
+        core_load_high_ms = 0;
+        if (core_load_low_ms == 0) {
+            core_load_low_ms = now_ms;
+        } else if (now_ms - core_load_low_ms > load_low_time_ms && level > 0) {
+            level--;
+            core_load_low_ms = 0;
+        }
+    } else {
+        core_load_high_ms = 0;
+        core_load_low_ms = 0;
+    }
+
+    if (level == core_budget_level) {
+        return;
+    }
+
+    const uint8_t new_num_cores = num_cores_max - (level + 1) / 2;
+    if (primary >= new_num_cores) {
+        // on the ground the primary is normally forced to the user
+        // selected lane, so hand over to the first lane before
+        // stopping the primary, and wait if it is not yet healthy
+        if (!core[0].healthy()) {
+            return;
+        }
+        primary = 0;
+    }
+
+    // lanes brought back have stale states so are re-initialised
+    for (uint8_t i=num_cores; i<new_num_cores; i++) {
+        core[i].restartFilter();
+        core_restart_mask |= 1U<<i;
+    }
+    for (uint8_t i=new_num_cores; i<num_cores; i++) {
+        core_restart_mask &= ~(1U<<i);
+    }
+
+    const bool lanes_changed = new_num_cores != num_cores;
+    num_cores = new_num_cores;
+    core_budget_level = level;
+    if (lanes_changed) {
+        resetCoreErrors();
+    }
+    GCS_SEND_TEXT(MAV_SEVERITY_INFO, "EKF3: running %u of %u lanes%s",
+                  unsigned(num_cores), unsigned(num_cores_max),
+                  stagger_fusion_enabled() ? ", staggered" : "");
+}
+
+// true if fusion is staggered across cores, by option or to reduce CPU load
+bool NavEKF3::stagger_fusion_enabled(void) const
+{
+    return option_is_enabled(Option::StaggerFusion) || (core_budget_level & 1U) != 0;
+}
+
 void NavEKF3::requestYawReset(void)
 {
     dal.log_event3(AP_DAL::Event::requestYawReset);
@@ -24,12 +24,15 @@
 #include <AP_Param/AP_Param.h>
 #include <AP_NavEKF/AP_Nav_Common.h>
 #include <AP_NavEKF/AP_NavEKF_Source.h>
+#include <AP_HAL/Semaphores.h>
+#include "AP_NavEKF3_feature.h"
 
 class NavEKF3_core;
 class EKFGSF_yaw;
 
 class NavEKF3 {
     friend class NavEKF3_core;
+    friend class NavEKF3_Benchmark;
 
 public:
     NavEKF3();
@@ -340,6 +343,9 @@ public:
     // set position, velocity and yaw sources to either 0=primary, 1=secondary, 2=tertiary
     void setPosVelYawSourceSet(uint8_t source_set_idx);
 
+    // return true if any source set can use the compass for yaw
+    bool compass_yaw_enabled(void) const { return sources.compass_yaw_enabled(); }
+
     // write EKF information to on-board logs
     void Log_Write();
 
@@ -371,12 +377,36 @@ public:
 private:
     class AP_DAL &dal;
 
-    uint8_t num_cores; // number of allocated cores
+    uint8_t num_cores; // number of running cores
+    uint8_t num_cores_max; // number of allocated cores
     uint8_t primary;   // current primary core
     NavEKF3_core *core = nullptr;
 
     uint32_t _frameTimeUsec;        // time per IMU frame
     uint8_t  _framesPerPrediction;  // expected number of IMU frames per prediction
+    uint8_t  fusionFrame;           // count of frames with EKF updates, used to stagger fusion across cores
+
+    // adaptation of the running lane count to CPU load, see update_core_budget()
+    uint8_t  core_budget_level;     // 0 runs all lanes, odd levels stagger fusion, each even step drops a lane
+    uint8_t  core_restart_mask;     // lanes brought back into use that have not yet re-initialised
+    uint32_t core_load_high_ms;     // time the load first went above the high threshold, 0 if not above
+    uint32_t core_load_low_ms;      // time the load first went below the low threshold, 0 if not below
+    void update_core_budget(void);
+    bool stagger_fusion_enabled(void) const;
+
+#if EK3_FEATURE_THREADED_CORES
+    // worker thread for running the non-primary cores
+    void core_thread(void);
+    bool start_core_thread(void);
+    enum class CoreThreadState : uint8_t {
+        NOT_STARTED,
+        RUNNING,
+        FAILED,
+    } core_thread_state;
+    HAL_BinarySemaphore core_thread_start;   // signalled by the main thread to start a frame
+    HAL_BinarySemaphore core_thread_done;    // signalled by the worker when the frame is complete
+    bool core_thread_allow_prediction[MAX_EKF_CORES];
+#endif
   
     // values for EK3_LOG_LEVEL
     enum class LogLevel {
@@ -428,6 +458,7 @@ private:
     AP_Float _rngBcnNoise;          // Range beacon measurement noise (m)
     AP_Int16 _rngBcnInnovGate;      // Percentage number of standard deviations applied to range beacon innovation consistency check
     AP_Int8  _rngBcnDelay_ms;       // effective average delay of range beacon measurements rel to IMU (msec)
+    AP_Int16 _rngBcnFuseRate;       // maximum rate range beacon measurements are fused at, 0 for no limit (Hz)
     AP_Float _useRngSwSpd;          // Maximum horizontal ground speed to use range finder as the primary height source (m/s)
     AP_Float _accBiasLim;           // Accelerometer bias limit (m/s/s)
     AP_Int8 _magMask;               // Bitmask forcing specific EKF core instances to use simple heading magnetometer fusion.
@@ -436,6 +467,7 @@ private:
     AP_Float _visOdmVelErrMin;      // Observation 1-STD velocity error assumed for visual odometry sensor at highest reported quality (m/s)
     AP_Float _wencOdmVelErr;        // Observation 1-STD velocity error assumed for wheel odometry sensor (m/s)
     AP_Int8  _flowUse;              // Controls if the optical flow data is fused into the main navigation estimator and/or the terrain estimator.
+    AP_Int8  _flowFuseRate;         // rate optical flow samples are averaged down to before fusion, 0 to fuse each sample (Hz)
     AP_Float _hrt_filt_freq;        // frequency of output observer height rate complementary filter in Hz
     AP_Int16 _mag_ef_limit;         // limit on difference between WMM tables and learned earth field.
     AP_Int8 _gsfRunMask;            // mask controlling which EKF3 instances run a separate EKF-GSF yaw estimator
@@ -459,6 +491,9 @@ private:
     enum class Option {
         JammingExpected     = (1<<0),
         ManualLaneSwitch   = (1<<1),
+        StaggerFusion      = (1<<2),
+        ThreadedCores      = (1<<3),
+        AdaptiveCores      = (1<<4),
     };
     bool option_is_enabled(Option option) const {
         return (_options & (uint32_t)option) != 0;
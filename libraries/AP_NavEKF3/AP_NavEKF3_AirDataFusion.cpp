@@ -20,19 +20,19 @@
 void NavEKF3_core::FuseAirspeed()
 {
     // declarations
-    ftype SH_TAS[3];
-    ftype SK_TAS[2];
+    gtype SH_TAS[3];
+    gtype SK_TAS[2];
     Vector24 H_TAS = {};
 
     // copy required states to local variable names
-    const ftype vn = stateStruct.velocity.x;
-    const ftype ve = stateStruct.velocity.y;
-    const ftype vd = stateStruct.velocity.z;
-    const ftype vwn = stateStruct.wind_vel.x;
-    const ftype vwe = stateStruct.wind_vel.y;
+    const gtype vn = stateStruct.velocity.x;
+    const gtype ve = stateStruct.velocity.y;
+    const gtype vd = stateStruct.velocity.z;
+    const gtype vwn = stateStruct.wind_vel.x;
+    const gtype vwe = stateStruct.wind_vel.y;
 
     // calculate the predicted airspeed
-    const ftype VtasPred = norm((ve - vwe) , (vn - vwn) , vd);
+    const gtype VtasPred = norm((ve - vwe) , (vn - vwn) , vd);
     // perform fusion of True Airspeed measurement
     if (VtasPred > 1.0f)
     {
@@ -49,7 +49,7 @@ void NavEKF3_core::FuseAirspeed()
         H_TAS[22] = -SH_TAS[2];
         H_TAS[23] = -SH_TAS[1];
         // calculate Kalman gains
-        ftype temp = (tasDataDelayed.tasVariance + SH_TAS[2]*(P[4][4]*SH_TAS[2] + P[5][4]*SH_TAS[1] - P[22][4]*SH_TAS[2] - P[23][4]*SH_TAS[1] + P[6][4]*vd*SH_TAS[0]) + SH_TAS[1]*(P[4][5]*SH_TAS[2] + P[5][5]*SH_TAS[1] - P[22][5]*SH_TAS[2] - P[23][5]*SH_TAS[1] + P[6][5]*vd*SH_TAS[0]) - SH_TAS[2]*(P[4][22]*SH_TAS[2] + P[5][22]*SH_TAS[1] - P[22][22]*SH_TAS[2] - P[23][22]*SH_TAS[1] + P[6][22]*vd*SH_TAS[0]) - SH_TAS[1]*(P[4][23]*SH_TAS[2] + P[5][23]*SH_TAS[1] - P[22][23]*SH_TAS[2] - P[23][23]*SH_TAS[1] + P[6][23]*vd*SH_TAS[0]) + vd*SH_TAS[0]*(P[4][6]*SH_TAS[2] + P[5][6]*SH_TAS[1] - P[22][6]*SH_TAS[2] - P[23][6]*SH_TAS[1] + P[6][6]*vd*SH_TAS[0]));
+        gtype temp = (gtype(tasDataDelayed.tasVariance) + SH_TAS[2]*(Pg(4,4)*SH_TAS[2] + Pg(5,4)*SH_TAS[1] - Pg(22,4)*SH_TAS[2] - Pg(23,4)*SH_TAS[1] + Pg(6,4)*vd*SH_TAS[0]) + SH_TAS[1]*(Pg(4,5)*SH_TAS[2] + Pg(5,5)*SH_TAS[1] - Pg(22,5)*SH_TAS[2] - Pg(23,5)*SH_TAS[1] + Pg(6,5)*vd*SH_TAS[0]) - SH_TAS[2]*(Pg(4,22)*SH_TAS[2] + Pg(5,22)*SH_TAS[1] - Pg(22,22)*SH_TAS[2] - Pg(23,22)*SH_TAS[1] + Pg(6,22)*vd*SH_TAS[0]) - SH_TAS[1]*(Pg(4,23)*SH_TAS[2] + Pg(5,23)*SH_TAS[1] - Pg(22,23)*SH_TAS[2] - Pg(23,23)*SH_TAS[1] + Pg(6,23)*vd*SH_TAS[0]) + vd*SH_TAS[0]*(Pg(4,6)*SH_TAS[2] + Pg(5,6)*SH_TAS[1] - Pg(22,6)*SH_TAS[2] - Pg(23,6)*SH_TAS[1] + Pg(6,6)*vd*SH_TAS[0]));
         if (temp >= tasDataDelayed.tasVariance) {
             SK_TAS[0] = 1.0f / temp;
             faultStatus.bad_airspeed = false;
@@ -63,25 +63,25 @@ void NavEKF3_core::FuseAirspeed()
         SK_TAS[1] = SH_TAS[1];
 
         if (tasDataDelayed.allowFusion && !airDataFusionWindOnly) {
-            Kfusion[0] = SK_TAS[0]*(P[0][4]*SH_TAS[2] - P[0][22]*SH_TAS[2] + P[0][5]*SK_TAS[1] - P[0][23]*SK_TAS[1] + P[0][6]*vd*SH_TAS[0]);
-            Kfusion[1] = SK_TAS[0]*(P[1][4]*SH_TAS[2] - P[1][22]*SH_TAS[2] + P[1][5]*SK_TAS[1] - P[1][23]*SK_TAS[1] + P[1][6]*vd*SH_TAS[0]);
-            Kfusion[2] = SK_TAS[0]*(P[2][4]*SH_TAS[2] - P[2][22]*SH_TAS[2] + P[2][5]*SK_TAS[1] - P[2][23]*SK_TAS[1] + P[2][6]*vd*SH_TAS[0]);
-            Kfusion[3] = SK_TAS[0]*(P[3][4]*SH_TAS[2] - P[3][22]*SH_TAS[2] + P[3][5]*SK_TAS[1] - P[3][23]*SK_TAS[1] + P[3][6]*vd*SH_TAS[0]);
-            Kfusion[4] = SK_TAS[0]*(P[4][4]*SH_TAS[2] - P[4][22]*SH_TAS[2] + P[4][5]*SK_TAS[1] - P[4][23]*SK_TAS[1] + P[4][6]*vd*SH_TAS[0]);
-            Kfusion[5] = SK_TAS[0]*(P[5][4]*SH_TAS[2] - P[5][22]*SH_TAS[2] + P[5][5]*SK_TAS[1] - P[5][23]*SK_TAS[1] + P[5][6]*vd*SH_TAS[0]);
-            Kfusion[6] = SK_TAS[0]*(P[6][4]*SH_TAS[2] - P[6][22]*SH_TAS[2] + P[6][5]*SK_TAS[1] - P[6][23]*SK_TAS[1] + P[6][6]*vd*SH_TAS[0]);
-            Kfusion[7] = SK_TAS[0]*(P[7][4]*SH_TAS[2] - P[7][22]*SH_TAS[2] + P[7][5]*SK_TAS[1] - P[7][23]*SK_TAS[1] + P[7][6]*vd*SH_TAS[0]);
-            Kfusion[8] = SK_TAS[0]*(P[8][4]*SH_TAS[2] - P[8][22]*SH_TAS[2] + P[8][5]*SK_TAS[1] - P[8][23]*SK_TAS[1] + P[8][6]*vd*SH_TAS[0]);
-            Kfusion[9] = SK_TAS[0]*(P[9][4]*SH_TAS[2] - P[9][22]*SH_TAS[2] + P[9][5]*SK_TAS[1] - P[9][23]*SK_TAS[1] + P[9][6]*vd*SH_TAS[0]);
+            Kfusion[0] = SK_TAS[0]*(Pg(0,4)*SH_TAS[2] - Pg(0,22)*SH_TAS[2] + Pg(0,5)*SK_TAS[1] - Pg(0,23)*SK_TAS[1] + Pg(0,6)*vd*SH_TAS[0]);
+            Kfusion[1] = SK_TAS[0]*(Pg(1,4)*SH_TAS[2] - Pg(1,22)*SH_TAS[2] + Pg(1,5)*SK_TAS[1] - Pg(1,23)*SK_TAS[1] + Pg(1,6)*vd*SH_TAS[0]);
+            Kfusion[2] = SK_TAS[0]*(Pg(2,4)*SH_TAS[2] - Pg(2,22)*SH_TAS[2] + Pg(2,5)*SK_TAS[1] - Pg(2,23)*SK_TAS[1] + Pg(2,6)*vd*SH_TAS[0]);
+            Kfusion[3] = SK_TAS[0]*(Pg(3,4)*SH_TAS[2] - Pg(3,22)*SH_TAS[2] + Pg(3,5)*SK_TAS[1] - Pg(3,23)*SK_TAS[1] + Pg(3,6)*vd*SH_TAS[0]);
+            Kfusion[4] = SK_TAS[0]*(Pg(4,4)*SH_TAS[2] - Pg(4,22)*SH_TAS[2] + Pg(4,5)*SK_TAS[1] - Pg(4,23)*SK_TAS[1] + Pg(4,6)*vd*SH_TAS[0]);
+            Kfusion[5] = SK_TAS[0]*(Pg(5,4)*SH_TAS[2] - Pg(5,22)*SH_TAS[2] + Pg(5,5)*SK_TAS[1] - Pg(5,23)*SK_TAS[1] + Pg(5,6)*vd*SH_TAS[0]);
+            Kfusion[6] = SK_TAS[0]*(Pg(6,4)*SH_TAS[2] - Pg(6,22)*SH_TAS[2] + Pg(6,5)*SK_TAS[1] - Pg(6,23)*SK_TAS[1] + Pg(6,6)*vd*SH_TAS[0]);
+            Kfusion[7] = SK_TAS[0]*(Pg(7,4)*SH_TAS[2] - Pg(7,22)*SH_TAS[2] + Pg(7,5)*SK_TAS[1] - Pg(7,23)*SK_TAS[1] + Pg(7,6)*vd*SH_TAS[0]);
+            Kfusion[8] = SK_TAS[0]*(Pg(8,4)*SH_TAS[2] - Pg(8,22)*SH_TAS[2] + Pg(8,5)*SK_TAS[1] - Pg(8,23)*SK_TAS[1] + Pg(8,6)*vd*SH_TAS[0]);
+            Kfusion[9] = SK_TAS[0]*(Pg(9,4)*SH_TAS[2] - Pg(9,22)*SH_TAS[2] + Pg(9,5)*SK_TAS[1] - Pg(9,23)*SK_TAS[1] + Pg(9,6)*vd*SH_TAS[0]);
         } else {
             // zero indexes 0 to 9
             zero_range(&Kfusion[0], 0, 9);
         }
 
         if (tasDataDelayed.allowFusion && !inhibitDelAngBiasStates && !airDataFusionWindOnly) {
-            Kfusion[10] = SK_TAS[0]*(P[10][4]*SH_TAS[2] - P[10][22]*SH_TAS[2] + P[10][5]*SK_TAS[1] - P[10][23]*SK_TAS[1] + P[10][6]*vd*SH_TAS[0]);
-            Kfusion[11] = SK_TAS[0]*(P[11][4]*SH_TAS[2] - P[11][22]*SH_TAS[2] + P[11][5]*SK_TAS[1] - P[11][23]*SK_TAS[1] + P[11][6]*vd*SH_TAS[0]);
-            Kfusion[12] = SK_TAS[0]*(P[12][4]*SH_TAS[2] - P[12][22]*SH_TAS[2] + P[12][5]*SK_TAS[1] - P[12][23]*SK_TAS[1] + P[12][6]*vd*SH_TAS[0]);
+            Kfusion[10] = SK_TAS[0]*(Pg(10,4)*SH_TAS[2] - Pg(10,22)*SH_TAS[2] + Pg(10,5)*SK_TAS[1] - Pg(10,23)*SK_TAS[1] + Pg(10,6)*vd*SH_TAS[0]);
+            Kfusion[11] = SK_TAS[0]*(Pg(11,4)*SH_TAS[2] - Pg(11,22)*SH_TAS[2] + Pg(11,5)*SK_TAS[1] - Pg(11,23)*SK_TAS[1] + Pg(11,6)*vd*SH_TAS[0]);
+            Kfusion[12] = SK_TAS[0]*(Pg(12,4)*SH_TAS[2] - Pg(12,22)*SH_TAS[2] + Pg(12,5)*SK_TAS[1] - Pg(12,23)*SK_TAS[1] + Pg(12,6)*vd*SH_TAS[0]);
         } else {
             // zero indexes 10 to 12
             zero_range(&Kfusion[0], 10, 12);
@@ -91,7 +91,7 @@ void NavEKF3_core::FuseAirspeed()
             for (uint8_t index = 0; index < 3; index++) {
                 const uint8_t stateIndex = index + 13;
                 if (!dvelBiasAxisInhibit[index]) {
-                    Kfusion[stateIndex] = SK_TAS[0]*(P[stateIndex][4]*SH_TAS[2] - P[stateIndex][22]*SH_TAS[2] + P[stateIndex][5]*SK_TAS[1] - P[stateIndex][23]*SK_TAS[1] + P[stateIndex][6]*vd*SH_TAS[0]);
+                    Kfusion[stateIndex] = SK_TAS[0]*(Pg(stateIndex,4)*SH_TAS[2] - Pg(stateIndex,22)*SH_TAS[2] + Pg(stateIndex,5)*SK_TAS[1] - Pg(stateIndex,23)*SK_TAS[1] + Pg(stateIndex,6)*vd*SH_TAS[0]);
                 } else {
                     Kfusion[stateIndex] = 0.0f;
                 }
@@ -103,20 +103,20 @@ void NavEKF3_core::FuseAirspeed()
 
         // zero Kalman gains to inhibit magnetic field state estimation
         if (tasDataDelayed.allowFusion && !inhibitMagStates && !airDataFusionWindOnly) {
-            Kfusion[16] = SK_TAS[0]*(P[16][4]*SH_TAS[2] - P[16][22]*SH_TAS[2] + P[16][5]*SK_TAS[1] - P[16][23]*SK_TAS[1] + P[16][6]*vd*SH_TAS[0]);
-            Kfusion[17] = SK_TAS[0]*(P[17][4]*SH_TAS[2] - P[17][22]*SH_TAS[2] + P[17][5]*SK_TAS[1] - P[17][23]*SK_TAS[1] + P[17][6]*vd*SH_TAS[0]);
-            Kfusion[18] = SK_TAS[0]*(P[18][4]*SH_TAS[2] - P[18][22]*SH_TAS[2] + P[18][5]*SK_TAS[1] - P[18][23]*SK_TAS[1] + P[18][6]*vd*SH_TAS[0]);
-            Kfusion[19] = SK_TAS[0]*(P[19][4]*SH_TAS[2] - P[19][22]*SH_TAS[2] + P[19][5]*SK_TAS[1] - P[19][23]*SK_TAS[1] + P[19][6]*vd*SH_TAS[0]);
-            Kfusion[20] = SK_TAS[0]*(P[20][4]*SH_TAS[2] - P[20][22]*SH_TAS[2] + P[20][5]*SK_TAS[1] - P[20][23]*SK_TAS[1] + P[20][6]*vd*SH_TAS[0]);
-            Kfusion[21] = SK_TAS[0]*(P[21][4]*SH_TAS[2] - P[21][22]*SH_TAS[2] + P[21][5]*SK_TAS[1] - P[21][23]*SK_TAS[1] + P[21][6]*vd*SH_TAS[0]);
+            Kfusion[16] = SK_TAS[0]*(Pg(16,4)*SH_TAS[2] - Pg(16,22)*SH_TAS[2] + Pg(16,5)*SK_TAS[1] - Pg(16,23)*SK_TAS[1] + Pg(16,6)*vd*SH_TAS[0]);
+            Kfusion[17] = SK_TAS[0]*(Pg(17,4)*SH_TAS[2] - Pg(17,22)*SH_TAS[2] + Pg(17,5)*SK_TAS[1] - Pg(17,23)*SK_TAS[1] + Pg(17,6)*vd*SH_TAS[0]);
+            Kfusion[18] = SK_TAS[0]*(Pg(18,4)*SH_TAS[2] - Pg(18,22)*SH_TAS[2] + Pg(18,5)*SK_TAS[1] - Pg(18,23)*SK_TAS[1] + Pg(18,6)*vd*SH_TAS[0]);
+            Kfusion[19] = SK_TAS[0]*(Pg(19,4)*SH_TAS[2] - Pg(19,22)*SH_TAS[2] + Pg(19,5)*SK_TAS[1] - Pg(19,23)*SK_TAS[1] + Pg(19,6)*vd*SH_TAS[0]);
+            Kfusion[20] = SK_TAS[0]*(Pg(20,4)*SH_TAS[2] - Pg(20,22)*SH_TAS[2] + Pg(20,5)*SK_TAS[1] - Pg(20,23)*SK_TAS[1] + Pg(20,6)*vd*SH_TAS[0]);
+            Kfusion[21] = SK_TAS[0]*(Pg(21,4)*SH_TAS[2] - Pg(21,22)*SH_TAS[2] + Pg(21,5)*SK_TAS[1] - Pg(21,23)*SK_TAS[1] + Pg(21,6)*vd*SH_TAS[0]);
         } else {
             // zero indexes 16 to 21
             zero_range(&Kfusion[0], 16, 21);
         }
 
         if (tasDataDelayed.allowFusion && !inhibitWindStates && !treatWindStatesAsTruth) {
-            Kfusion[22] = SK_TAS[0]*(P[22][4]*SH_TAS[2] - P[22][22]*SH_TAS[2] + P[22][5]*SK_TAS[1] - P[22][23]*SK_TAS[1] + P[22][6]*vd*SH_TAS[0]);
-            Kfusion[23] = SK_TAS[0]*(P[23][4]*SH_TAS[2] - P[23][22]*SH_TAS[2] + P[23][5]*SK_TAS[1] - P[23][23]*SK_TAS[1] + P[23][6]*vd*SH_TAS[0]);
+            Kfusion[22] = SK_TAS[0]*(Pg(22,4)*SH_TAS[2] - Pg(22,22)*SH_TAS[2] + Pg(22,5)*SK_TAS[1] - Pg(22,23)*SK_TAS[1] + Pg(22,6)*vd*SH_TAS[0]);
+            Kfusion[23] = SK_TAS[0]*(Pg(23,4)*SH_TAS[2] - Pg(23,22)*SH_TAS[2] + Pg(23,5)*SK_TAS[1] - Pg(23,23)*SK_TAS[1] + Pg(23,6)*vd*SH_TAS[0]);
         } else {
             // zero indexes 22 to 23 = 2
             zero_range(&Kfusion[0], 22, 23);
@@ -178,8 +178,8 @@ void NavEKF3_core::FuseAirspeed()
                 }
             }
             for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=stateIndexLim; j++) {
-                    P[i][j] = P[i][j] - KHP[i][j];
+                for (unsigned j = i; j<=stateIndexLim; j++) {
+                    P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
                 }
             }
         }
@@ -202,6 +202,11 @@ void NavEKF3_core::SelectTasFusion()
         airSpdFusionDelayed = false;
     }
 
+    // let another core use this update slot for airspeed fusion
+    if (deferFusion(FusionSlot::TAS)) {
+        return;
+    }
+
     // get true airspeed measurement
     readAirSpdData();
 
@@ -455,8 +460,8 @@ void NavEKF3_core::FuseSideslip()
             }
         }
         for (unsigned i = 0; i<=stateIndexLim; i++) {
-            for (unsigned j = 0; j<=stateIndexLim; j++) {
-                P[i][j] = P[i][j] - KHP[i][j];
+            for (unsigned j = i; j<=stateIndexLim; j++) {
+                P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
             }
         }
     }
@@ -730,8 +735,8 @@ void NavEKF3_core::FuseDragForces()
             }
         }
         for (unsigned i = 0; i<=stateIndexLim; i++) {
-            for (unsigned j = 0; j<=stateIndexLim; j++) {
-                P[i][j] = P[i][j] - KHP[i][j];
+            for (unsigned j = i; j<=stateIndexLim; j++) {
+                P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
             }
         }
     }
@@ -408,7 +408,8 @@ void NavEKF3_core::SelectMagFusion()
     }
 
     // check for availability of magnetometer or other yaw data to fuse
-    magDataToFuse = storedMag.recall(magDataDelayed,imuDataDelayed.time_ms);
+    // leaving the data in the buffer if another core has this update slot
+    magDataToFuse = !deferFusion(FusionSlot::MAG) && storedMag.recall(magDataDelayed,imuDataDelayed.time_ms);
 
     // Control reset of yaw and magnetic field states if we are using compass data
     if (magDataToFuse) {
@@ -481,16 +482,16 @@ void NavEKF3_core::FuseMagnetometer()
     // calculate observation jacobians and Kalman gains
 
     // create aliases for state to make code easier to read:
-    const ftype q0       = stateStruct.quat[0];
-    const ftype q1       = stateStruct.quat[1];
-    const ftype q2       = stateStruct.quat[2];
-    const ftype q3       = stateStruct.quat[3];
-    const ftype magN     = stateStruct.earth_magfield[0];
-    const ftype magE     = stateStruct.earth_magfield[1];
-    const ftype magD     = stateStruct.earth_magfield[2];
-    const ftype magXbias = stateStruct.body_magfield[0];
-    const ftype magYbias = stateStruct.body_magfield[1];
-    const ftype magZbias = stateStruct.body_magfield[2];
+    const gtype q0       = stateStruct.quat[0];
+    const gtype q1       = stateStruct.quat[1];
+    const gtype q2       = stateStruct.quat[2];
+    const gtype q3       = stateStruct.quat[3];
+    const gtype magN     = stateStruct.earth_magfield[0];
+    const gtype magE     = stateStruct.earth_magfield[1];
+    const gtype magD     = stateStruct.earth_magfield[2];
+    const gtype magXbias = stateStruct.body_magfield[0];
+    const gtype magYbias = stateStruct.body_magfield[1];
+    const gtype magZbias = stateStruct.body_magfield[2];
 
     // rotate predicted earth components into body axes and calculate
     // predicted measurements
@@ -516,10 +517,10 @@ void NavEKF3_core::FuseMagnetometer()
     innovMag = MagPred - magDataDelayed.mag;
 
     // scale magnetometer observation error with total angular rate to allow for timing errors
-    const ftype R_MAG = sq(constrain_ftype(frontend->_magNoise, 0.01f, 0.5f)) + sq(frontend->magVarRateScale*imuDataDelayed.delAng.length() / imuDataDelayed.delAngDT);
+    const gtype R_MAG = sq(constrain_ftype(frontend->_magNoise, 0.01f, 0.5f)) + sq(frontend->magVarRateScale*imuDataDelayed.delAng.length() / imuDataDelayed.delAngDT);
 
     // calculate common expressions used to calculate observation jacobians an innovation variance for each component
-    const Vector9 SH_MAG {
+    const Vector9G SH_MAG {
         2.0f*magD*q3 + 2.0f*magE*q2 + 2.0f*magN*q1,
         2.0f*magD*q0 - 2.0f*magE*q1 + 2.0f*magN*q2,
         2.0f*magD*q1 + 2.0f*magE*q0 - 2.0f*magN*q3,
@@ -533,7 +534,7 @@ void NavEKF3_core::FuseMagnetometer()
 
     // Calculate the innovation variance for each axis
     // X axis
-    varInnovMag[0] = (P[19][19] + R_MAG + P[1][19]*SH_MAG[0] - P[2][19]*SH_MAG[1] + P[3][19]*SH_MAG[2] - P[16][19]*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + (2.0f*q0*q3 + 2.0f*q1*q2)*(P[19][17] + P[1][17]*SH_MAG[0] - P[2][17]*SH_MAG[1] + P[3][17]*SH_MAG[2] - P[16][17]*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + P[17][17]*(2.0f*q0*q3 + 2.0f*q1*q2) - P[18][17]*(2.0f*q0*q2 - 2.0f*q1*q3) + P[0][17]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (2.0f*q0*q2 - 2.0f*q1*q3)*(P[19][18] + P[1][18]*SH_MAG[0] - P[2][18]*SH_MAG[1] + P[3][18]*SH_MAG[2] - P[16][18]*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + P[17][18]*(2.0f*q0*q3 + 2.0f*q1*q2) - P[18][18]*(2.0f*q0*q2 - 2.0f*q1*q3) + P[0][18]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + (SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)*(P[19][0] + P[1][0]*SH_MAG[0] - P[2][0]*SH_MAG[1] + P[3][0]*SH_MAG[2] - P[16][0]*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + P[17][0]*(2.0f*q0*q3 + 2.0f*q1*q2) - P[18][0]*(2.0f*q0*q2 - 2.0f*q1*q3) + P[0][0]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + P[17][19]*(2.0f*q0*q3 + 2.0f*q1*q2) - P[18][19]*(2.0f*q0*q2 - 2.0f*q1*q3) + SH_MAG[0]*(P[19][1] + P[1][1]*SH_MAG[0] - P[2][1]*SH_MAG[1] + P[3][1]*SH_MAG[2] - P[16][1]*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + P[17][1]*(2.0f*q0*q3 + 2.0f*q1*q2) - P[18][1]*(2.0f*q0*q2 - 2.0f*q1*q3) + P[0][1]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - SH_MAG[1]*(P[19][2] + P[1][2]*SH_MAG[0] - P[2][2]*SH_MAG[1] + P[3][2]*SH_MAG[2] - P[16][2]*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + P[17][2]*(2.0f*q0*q3 + 2.0f*q1*q2) - P[18][2]*(2.0f*q0*q2 - 2.0f*q1*q3) + P[0][2]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + SH_MAG[2]*(P[19][3] + P[1][3]*SH_MAG[0] - P[2][3]*SH_MAG[1] + P[3][3]*SH_MAG[2] - P[16][3]*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + P[17][3]*(2.0f*q0*q3 + 2.0f*q1*q2) - P[18][3]*(2.0f*q0*q2 - 2.0f*q1*q3) + P[0][3]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6])*(P[19][16] + P[1][16]*SH_MAG[0] - P[2][16]*SH_MAG[1] + P[3][16]*SH_MAG[2] - P[16][16]*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + P[17][16]*(2.0f*q0*q3 + 2.0f*q1*q2) - P[18][16]*(2.0f*q0*q2 - 2.0f*q1*q3) + P[0][16]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + P[0][19]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2));
+    varInnovMag[0] = (Pg(19,19) + R_MAG + Pg(1,19)*SH_MAG[0] - Pg(2,19)*SH_MAG[1] + Pg(3,19)*SH_MAG[2] - Pg(16,19)*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + (2.0f*q0*q3 + 2.0f*q1*q2)*(Pg(19,17) + Pg(1,17)*SH_MAG[0] - Pg(2,17)*SH_MAG[1] + Pg(3,17)*SH_MAG[2] - Pg(16,17)*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + Pg(17,17)*(2.0f*q0*q3 + 2.0f*q1*q2) - Pg(18,17)*(2.0f*q0*q2 - 2.0f*q1*q3) + Pg(0,17)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (2.0f*q0*q2 - 2.0f*q1*q3)*(Pg(19,18) + Pg(1,18)*SH_MAG[0] - Pg(2,18)*SH_MAG[1] + Pg(3,18)*SH_MAG[2] - Pg(16,18)*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + Pg(17,18)*(2.0f*q0*q3 + 2.0f*q1*q2) - Pg(18,18)*(2.0f*q0*q2 - 2.0f*q1*q3) + Pg(0,18)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + (SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)*(Pg(19,0) + Pg(1,0)*SH_MAG[0] - Pg(2,0)*SH_MAG[1] + Pg(3,0)*SH_MAG[2] - Pg(16,0)*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + Pg(17,0)*(2.0f*q0*q3 + 2.0f*q1*q2) - Pg(18,0)*(2.0f*q0*q2 - 2.0f*q1*q3) + Pg(0,0)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + Pg(17,19)*(2.0f*q0*q3 + 2.0f*q1*q2) - Pg(18,19)*(2.0f*q0*q2 - 2.0f*q1*q3) + SH_MAG[0]*(Pg(19,1) + Pg(1,1)*SH_MAG[0] - Pg(2,1)*SH_MAG[1] + Pg(3,1)*SH_MAG[2] - Pg(16,1)*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + Pg(17,1)*(2.0f*q0*q3 + 2.0f*q1*q2) - Pg(18,1)*(2.0f*q0*q2 - 2.0f*q1*q3) + Pg(0,1)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - SH_MAG[1]*(Pg(19,2) + Pg(1,2)*SH_MAG[0] - Pg(2,2)*SH_MAG[1] + Pg(3,2)*SH_MAG[2] - Pg(16,2)*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + Pg(17,2)*(2.0f*q0*q3 + 2.0f*q1*q2) - Pg(18,2)*(2.0f*q0*q2 - 2.0f*q1*q3) + Pg(0,2)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + SH_MAG[2]*(Pg(19,3) + Pg(1,3)*SH_MAG[0] - Pg(2,3)*SH_MAG[1] + Pg(3,3)*SH_MAG[2] - Pg(16,3)*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + Pg(17,3)*(2.0f*q0*q3 + 2.0f*q1*q2) - Pg(18,3)*(2.0f*q0*q2 - 2.0f*q1*q3) + Pg(0,3)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6])*(Pg(19,16) + Pg(1,16)*SH_MAG[0] - Pg(2,16)*SH_MAG[1] + Pg(3,16)*SH_MAG[2] - Pg(16,16)*(SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6]) + Pg(17,16)*(2.0f*q0*q3 + 2.0f*q1*q2) - Pg(18,16)*(2.0f*q0*q2 - 2.0f*q1*q3) + Pg(0,16)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + Pg(0,19)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2));
     if (varInnovMag[0] >= R_MAG) {
         faultStatus.bad_xmag = false;
     } else {
@@ -545,7 +546,7 @@ void NavEKF3_core::FuseMagnetometer()
     }
 
     // Y axis
-    varInnovMag[1] = (P[20][20] + R_MAG + P[0][20]*SH_MAG[2] + P[1][20]*SH_MAG[1] + P[2][20]*SH_MAG[0] - P[17][20]*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - (2.0f*q0*q3 - 2.0f*q1*q2)*(P[20][16] + P[0][16]*SH_MAG[2] + P[1][16]*SH_MAG[1] + P[2][16]*SH_MAG[0] - P[17][16]*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - P[16][16]*(2.0f*q0*q3 - 2.0f*q1*q2) + P[18][16]*(2.0f*q0*q1 + 2.0f*q2*q3) - P[3][16]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + (2.0f*q0*q1 + 2.0f*q2*q3)*(P[20][18] + P[0][18]*SH_MAG[2] + P[1][18]*SH_MAG[1] + P[2][18]*SH_MAG[0] - P[17][18]*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - P[16][18]*(2.0f*q0*q3 - 2.0f*q1*q2) + P[18][18]*(2.0f*q0*q1 + 2.0f*q2*q3) - P[3][18]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)*(P[20][3] + P[0][3]*SH_MAG[2] + P[1][3]*SH_MAG[1] + P[2][3]*SH_MAG[0] - P[17][3]*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - P[16][3]*(2.0f*q0*q3 - 2.0f*q1*q2) + P[18][3]*(2.0f*q0*q1 + 2.0f*q2*q3) - P[3][3]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - P[16][20]*(2.0f*q0*q3 - 2.0f*q1*q2) + P[18][20]*(2.0f*q0*q1 + 2.0f*q2*q3) + SH_MAG[2]*(P[20][0] + P[0][0]*SH_MAG[2] + P[1][0]*SH_MAG[1] + P[2][0]*SH_MAG[0] - P[17][0]*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - P[16][0]*(2.0f*q0*q3 - 2.0f*q1*q2) + P[18][0]*(2.0f*q0*q1 + 2.0f*q2*q3) - P[3][0]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + SH_MAG[1]*(P[20][1] + P[0][1]*SH_MAG[2] + P[1][1]*SH_MAG[1] + P[2][1]*SH_MAG[0] - P[17][1]*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - P[16][1]*(2.0f*q0*q3 - 2.0f*q1*q2) + P[18][1]*(2.0f*q0*q1 + 2.0f*q2*q3) - P[3][1]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + SH_MAG[0]*(P[20][2] + P[0][2]*SH_MAG[2] + P[1][2]*SH_MAG[1] + P[2][2]*SH_MAG[0] - P[17][2]*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - P[16][2]*(2.0f*q0*q3 - 2.0f*q1*q2) + P[18][2]*(2.0f*q0*q1 + 2.0f*q2*q3) - P[3][2]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6])*(P[20][17] + P[0][17]*SH_MAG[2] + P[1][17]*SH_MAG[1] + P[2][17]*SH_MAG[0] - P[17][17]*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - P[16][17]*(2.0f*q0*q3 - 2.0f*q1*q2) + P[18][17]*(2.0f*q0*q1 + 2.0f*q2*q3) - P[3][17]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - P[3][20]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2));
+    varInnovMag[1] = (Pg(20,20) + R_MAG + Pg(0,20)*SH_MAG[2] + Pg(1,20)*SH_MAG[1] + Pg(2,20)*SH_MAG[0] - Pg(17,20)*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - (2.0f*q0*q3 - 2.0f*q1*q2)*(Pg(20,16) + Pg(0,16)*SH_MAG[2] + Pg(1,16)*SH_MAG[1] + Pg(2,16)*SH_MAG[0] - Pg(17,16)*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - Pg(16,16)*(2.0f*q0*q3 - 2.0f*q1*q2) + Pg(18,16)*(2.0f*q0*q1 + 2.0f*q2*q3) - Pg(3,16)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + (2.0f*q0*q1 + 2.0f*q2*q3)*(Pg(20,18) + Pg(0,18)*SH_MAG[2] + Pg(1,18)*SH_MAG[1] + Pg(2,18)*SH_MAG[0] - Pg(17,18)*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - Pg(16,18)*(2.0f*q0*q3 - 2.0f*q1*q2) + Pg(18,18)*(2.0f*q0*q1 + 2.0f*q2*q3) - Pg(3,18)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)*(Pg(20,3) + Pg(0,3)*SH_MAG[2] + Pg(1,3)*SH_MAG[1] + Pg(2,3)*SH_MAG[0] - Pg(17,3)*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - Pg(16,3)*(2.0f*q0*q3 - 2.0f*q1*q2) + Pg(18,3)*(2.0f*q0*q1 + 2.0f*q2*q3) - Pg(3,3)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - Pg(16,20)*(2.0f*q0*q3 - 2.0f*q1*q2) + Pg(18,20)*(2.0f*q0*q1 + 2.0f*q2*q3) + SH_MAG[2]*(Pg(20,0) + Pg(0,0)*SH_MAG[2] + Pg(1,0)*SH_MAG[1] + Pg(2,0)*SH_MAG[0] - Pg(17,0)*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - Pg(16,0)*(2.0f*q0*q3 - 2.0f*q1*q2) + Pg(18,0)*(2.0f*q0*q1 + 2.0f*q2*q3) - Pg(3,0)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + SH_MAG[1]*(Pg(20,1) + Pg(0,1)*SH_MAG[2] + Pg(1,1)*SH_MAG[1] + Pg(2,1)*SH_MAG[0] - Pg(17,1)*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - Pg(16,1)*(2.0f*q0*q3 - 2.0f*q1*q2) + Pg(18,1)*(2.0f*q0*q1 + 2.0f*q2*q3) - Pg(3,1)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + SH_MAG[0]*(Pg(20,2) + Pg(0,2)*SH_MAG[2] + Pg(1,2)*SH_MAG[1] + Pg(2,2)*SH_MAG[0] - Pg(17,2)*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - Pg(16,2)*(2.0f*q0*q3 - 2.0f*q1*q2) + Pg(18,2)*(2.0f*q0*q1 + 2.0f*q2*q3) - Pg(3,2)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6])*(Pg(20,17) + Pg(0,17)*SH_MAG[2] + Pg(1,17)*SH_MAG[1] + Pg(2,17)*SH_MAG[0] - Pg(17,17)*(SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6]) - Pg(16,17)*(2.0f*q0*q3 - 2.0f*q1*q2) + Pg(18,17)*(2.0f*q0*q1 + 2.0f*q2*q3) - Pg(3,17)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - Pg(3,20)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2));
     if (varInnovMag[1] >= R_MAG) {
         faultStatus.bad_ymag = false;
     } else {
@@ -557,7 +558,7 @@ void NavEKF3_core::FuseMagnetometer()
     }
 
     // Z axis
-    varInnovMag[2] = (P[21][21] + R_MAG + P[0][21]*SH_MAG[1] - P[1][21]*SH_MAG[2] + P[3][21]*SH_MAG[0] + P[18][21]*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + (2.0f*q0*q2 + 2.0f*q1*q3)*(P[21][16] + P[0][16]*SH_MAG[1] - P[1][16]*SH_MAG[2] + P[3][16]*SH_MAG[0] + P[18][16]*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + P[16][16]*(2.0f*q0*q2 + 2.0f*q1*q3) - P[17][16]*(2.0f*q0*q1 - 2.0f*q2*q3) + P[2][16]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (2.0f*q0*q1 - 2.0f*q2*q3)*(P[21][17] + P[0][17]*SH_MAG[1] - P[1][17]*SH_MAG[2] + P[3][17]*SH_MAG[0] + P[18][17]*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + P[16][17]*(2.0f*q0*q2 + 2.0f*q1*q3) - P[17][17]*(2.0f*q0*q1 - 2.0f*q2*q3) + P[2][17]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + (SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)*(P[21][2] + P[0][2]*SH_MAG[1] - P[1][2]*SH_MAG[2] + P[3][2]*SH_MAG[0] + P[18][2]*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + P[16][2]*(2.0f*q0*q2 + 2.0f*q1*q3) - P[17][2]*(2.0f*q0*q1 - 2.0f*q2*q3) + P[2][2]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + P[16][21]*(2.0f*q0*q2 + 2.0f*q1*q3) - P[17][21]*(2.0f*q0*q1 - 2.0f*q2*q3) + SH_MAG[1]*(P[21][0] + P[0][0]*SH_MAG[1] - P[1][0]*SH_MAG[2] + P[3][0]*SH_MAG[0] + P[18][0]*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + P[16][0]*(2.0f*q0*q2 + 2.0f*q1*q3) - P[17][0]*(2.0f*q0*q1 - 2.0f*q2*q3) + P[2][0]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - SH_MAG[2]*(P[21][1] + P[0][1]*SH_MAG[1] - P[1][1]*SH_MAG[2] + P[3][1]*SH_MAG[0] + P[18][1]*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + P[16][1]*(2.0f*q0*q2 + 2.0f*q1*q3) - P[17][1]*(2.0f*q0*q1 - 2.0f*q2*q3) + P[2][1]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + SH_MAG[0]*(P[21][3] + P[0][3]*SH_MAG[1] - P[1][3]*SH_MAG[2] + P[3][3]*SH_MAG[0] + P[18][3]*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + P[16][3]*(2.0f*q0*q2 + 2.0f*q1*q3) - P[17][3]*(2.0f*q0*q1 - 2.0f*q2*q3) + P[2][3]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + (SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6])*(P[21][18] + P[0][18]*SH_MAG[1] - P[1][18]*SH_MAG[2] + P[3][18]*SH_MAG[0] + P[18][18]*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + P[16][18]*(2.0f*q0*q2 + 2.0f*q1*q3) - P[17][18]*(2.0f*q0*q1 - 2.0f*q2*q3) + P[2][18]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + P[2][21]*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2));
+    varInnovMag[2] = (Pg(21,21) + R_MAG + Pg(0,21)*SH_MAG[1] - Pg(1,21)*SH_MAG[2] + Pg(3,21)*SH_MAG[0] + Pg(18,21)*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + (2.0f*q0*q2 + 2.0f*q1*q3)*(Pg(21,16) + Pg(0,16)*SH_MAG[1] - Pg(1,16)*SH_MAG[2] + Pg(3,16)*SH_MAG[0] + Pg(18,16)*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + Pg(16,16)*(2.0f*q0*q2 + 2.0f*q1*q3) - Pg(17,16)*(2.0f*q0*q1 - 2.0f*q2*q3) + Pg(2,16)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - (2.0f*q0*q1 - 2.0f*q2*q3)*(Pg(21,17) + Pg(0,17)*SH_MAG[1] - Pg(1,17)*SH_MAG[2] + Pg(3,17)*SH_MAG[0] + Pg(18,17)*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + Pg(16,17)*(2.0f*q0*q2 + 2.0f*q1*q3) - Pg(17,17)*(2.0f*q0*q1 - 2.0f*q2*q3) + Pg(2,17)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + (SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)*(Pg(21,2) + Pg(0,2)*SH_MAG[1] - Pg(1,2)*SH_MAG[2] + Pg(3,2)*SH_MAG[0] + Pg(18,2)*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + Pg(16,2)*(2.0f*q0*q2 + 2.0f*q1*q3) - Pg(17,2)*(2.0f*q0*q1 - 2.0f*q2*q3) + Pg(2,2)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + Pg(16,21)*(2.0f*q0*q2 + 2.0f*q1*q3) - Pg(17,21)*(2.0f*q0*q1 - 2.0f*q2*q3) + SH_MAG[1]*(Pg(21,0) + Pg(0,0)*SH_MAG[1] - Pg(1,0)*SH_MAG[2] + Pg(3,0)*SH_MAG[0] + Pg(18,0)*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + Pg(16,0)*(2.0f*q0*q2 + 2.0f*q1*q3) - Pg(17,0)*(2.0f*q0*q1 - 2.0f*q2*q3) + Pg(2,0)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) - SH_MAG[2]*(Pg(21,1) + Pg(0,1)*SH_MAG[1] - Pg(1,1)*SH_MAG[2] + Pg(3,1)*SH_MAG[0] + Pg(18,1)*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + Pg(16,1)*(2.0f*q0*q2 + 2.0f*q1*q3) - Pg(17,1)*(2.0f*q0*q1 - 2.0f*q2*q3) + Pg(2,1)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + SH_MAG[0]*(Pg(21,3) + Pg(0,3)*SH_MAG[1] - Pg(1,3)*SH_MAG[2] + Pg(3,3)*SH_MAG[0] + Pg(18,3)*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + Pg(16,3)*(2.0f*q0*q2 + 2.0f*q1*q3) - Pg(17,3)*(2.0f*q0*q1 - 2.0f*q2*q3) + Pg(2,3)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + (SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6])*(Pg(21,18) + Pg(0,18)*SH_MAG[1] - Pg(1,18)*SH_MAG[2] + Pg(3,18)*SH_MAG[0] + Pg(18,18)*(SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6]) + Pg(16,18)*(2.0f*q0*q2 + 2.0f*q1*q3) - Pg(17,18)*(2.0f*q0*q1 - 2.0f*q2*q3) + Pg(2,18)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2)) + Pg(2,21)*(SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2));
     if (varInnovMag[2] >= R_MAG) {
         faultStatus.bad_zmag = false;
     } else {
@@ -599,7 +600,7 @@ void NavEKF3_core::FuseMagnetometer()
             H_MAG[21] = 0.0f;
 
             // calculate Kalman gain
-            const Vector5 SK_MX {
+            const Vector5G SK_MX {
                 1.0f / varInnovMag[0],
                 SH_MAG[3] + SH_MAG[4] - SH_MAG[5] - SH_MAG[6],
                 SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2,
@@ -607,21 +608,21 @@ void NavEKF3_core::FuseMagnetometer()
                 2.0f*q0*q3 + 2.0f*q1*q2
             };
 
-            Kfusion[0] = SK_MX[0]*(P[0][19] + P[0][1]*SH_MAG[0] - P[0][2]*SH_MAG[1] + P[0][3]*SH_MAG[2] + P[0][0]*SK_MX[2] - P[0][16]*SK_MX[1] + P[0][17]*SK_MX[4] - P[0][18]*SK_MX[3]);
-            Kfusion[1] = SK_MX[0]*(P[1][19] + P[1][1]*SH_MAG[0] - P[1][2]*SH_MAG[1] + P[1][3]*SH_MAG[2] + P[1][0]*SK_MX[2] - P[1][16]*SK_MX[1] + P[1][17]*SK_MX[4] - P[1][18]*SK_MX[3]);
-            Kfusion[2] = SK_MX[0]*(P[2][19] + P[2][1]*SH_MAG[0] - P[2][2]*SH_MAG[1] + P[2][3]*SH_MAG[2] + P[2][0]*SK_MX[2] - P[2][16]*SK_MX[1] + P[2][17]*SK_MX[4] - P[2][18]*SK_MX[3]);
-            Kfusion[3] = SK_MX[0]*(P[3][19] + P[3][1]*SH_MAG[0] - P[3][2]*SH_MAG[1] + P[3][3]*SH_MAG[2] + P[3][0]*SK_MX[2] - P[3][16]*SK_MX[1] + P[3][17]*SK_MX[4] - P[3][18]*SK_MX[3]);
-            Kfusion[4] = SK_MX[0]*(P[4][19] + P[4][1]*SH_MAG[0] - P[4][2]*SH_MAG[1] + P[4][3]*SH_MAG[2] + P[4][0]*SK_MX[2] - P[4][16]*SK_MX[1] + P[4][17]*SK_MX[4] - P[4][18]*SK_MX[3]);
-            Kfusion[5] = SK_MX[0]*(P[5][19] + P[5][1]*SH_MAG[0] - P[5][2]*SH_MAG[1] + P[5][3]*SH_MAG[2] + P[5][0]*SK_MX[2] - P[5][16]*SK_MX[1] + P[5][17]*SK_MX[4] - P[5][18]*SK_MX[3]);
-            Kfusion[6] = SK_MX[0]*(P[6][19] + P[6][1]*SH_MAG[0] - P[6][2]*SH_MAG[1] + P[6][3]*SH_MAG[2] + P[6][0]*SK_MX[2] - P[6][16]*SK_MX[1] + P[6][17]*SK_MX[4] - P[6][18]*SK_MX[3]);
-            Kfusion[7] = SK_MX[0]*(P[7][19] + P[7][1]*SH_MAG[0] - P[7][2]*SH_MAG[1] + P[7][3]*SH_MAG[2] + P[7][0]*SK_MX[2] - P[7][16]*SK_MX[1] + P[7][17]*SK_MX[4] - P[7][18]*SK_MX[3]);
-            Kfusion[8] = SK_MX[0]*(P[8][19] + P[8][1]*SH_MAG[0] - P[8][2]*SH_MAG[1] + P[8][3]*SH_MAG[2] + P[8][0]*SK_MX[2] - P[8][16]*SK_MX[1] + P[8][17]*SK_MX[4] - P[8][18]*SK_MX[3]);
-            Kfusion[9] = SK_MX[0]*(P[9][19] + P[9][1]*SH_MAG[0] - P[9][2]*SH_MAG[1] + P[9][3]*SH_MAG[2] + P[9][0]*SK_MX[2] - P[9][16]*SK_MX[1] + P[9][17]*SK_MX[4] - P[9][18]*SK_MX[3]);
+            Kfusion[0] = SK_MX[0]*(Pg(0,19) + Pg(0,1)*SH_MAG[0] - Pg(0,2)*SH_MAG[1] + Pg(0,3)*SH_MAG[2] + Pg(0,0)*SK_MX[2] - Pg(0,16)*SK_MX[1] + Pg(0,17)*SK_MX[4] - Pg(0,18)*SK_MX[3]);
+            Kfusion[1] = SK_MX[0]*(Pg(1,19) + Pg(1,1)*SH_MAG[0] - Pg(1,2)*SH_MAG[1] + Pg(1,3)*SH_MAG[2] + Pg(1,0)*SK_MX[2] - Pg(1,16)*SK_MX[1] + Pg(1,17)*SK_MX[4] - Pg(1,18)*SK_MX[3]);
+            Kfusion[2] = SK_MX[0]*(Pg(2,19) + Pg(2,1)*SH_MAG[0] - Pg(2,2)*SH_MAG[1] + Pg(2,3)*SH_MAG[2] + Pg(2,0)*SK_MX[2] - Pg(2,16)*SK_MX[1] + Pg(2,17)*SK_MX[4] - Pg(2,18)*SK_MX[3]);
+            Kfusion[3] = SK_MX[0]*(Pg(3,19) + Pg(3,1)*SH_MAG[0] - Pg(3,2)*SH_MAG[1] + Pg(3,3)*SH_MAG[2] + Pg(3,0)*SK_MX[2] - Pg(3,16)*SK_MX[1] + Pg(3,17)*SK_MX[4] - Pg(3,18)*SK_MX[3]);
+            Kfusion[4] = SK_MX[0]*(Pg(4,19) + Pg(4,1)*SH_MAG[0] - Pg(4,2)*SH_MAG[1] + Pg(4,3)*SH_MAG[2] + Pg(4,0)*SK_MX[2] - Pg(4,16)*SK_MX[1] + Pg(4,17)*SK_MX[4] - Pg(4,18)*SK_MX[3]);
+            Kfusion[5] = SK_MX[0]*(Pg(5,19) + Pg(5,1)*SH_MAG[0] - Pg(5,2)*SH_MAG[1] + Pg(5,3)*SH_MAG[2] + Pg(5,0)*SK_MX[2] - Pg(5,16)*SK_MX[1] + Pg(5,17)*SK_MX[4] - Pg(5,18)*SK_MX[3]);
+            Kfusion[6] = SK_MX[0]*(Pg(6,19) + Pg(6,1)*SH_MAG[0] - Pg(6,2)*SH_MAG[1] + Pg(6,3)*SH_MAG[2] + Pg(6,0)*SK_MX[2] - Pg(6,16)*SK_MX[1] + Pg(6,17)*SK_MX[4] - Pg(6,18)*SK_MX[3]);
+            Kfusion[7] = SK_MX[0]*(Pg(7,19) + Pg(7,1)*SH_MAG[0] - Pg(7,2)*SH_MAG[1] + Pg(7,3)*SH_MAG[2] + Pg(7,0)*SK_MX[2] - Pg(7,16)*SK_MX[1] + Pg(7,17)*SK_MX[4] - Pg(7,18)*SK_MX[3]);
+            Kfusion[8] = SK_MX[0]*(Pg(8,19) + Pg(8,1)*SH_MAG[0] - Pg(8,2)*SH_MAG[1] + Pg(8,3)*SH_MAG[2] + Pg(8,0)*SK_MX[2] - Pg(8,16)*SK_MX[1] + Pg(8,17)*SK_MX[4] - Pg(8,18)*SK_MX[3]);
+            Kfusion[9] = SK_MX[0]*(Pg(9,19) + Pg(9,1)*SH_MAG[0] - Pg(9,2)*SH_MAG[1] + Pg(9,3)*SH_MAG[2] + Pg(9,0)*SK_MX[2] - Pg(9,16)*SK_MX[1] + Pg(9,17)*SK_MX[4] - Pg(9,18)*SK_MX[3]);
 
             if (!inhibitDelAngBiasStates) {
-                Kfusion[10] = SK_MX[0]*(P[10][19] + P[10][1]*SH_MAG[0] - P[10][2]*SH_MAG[1] + P[10][3]*SH_MAG[2] + P[10][0]*SK_MX[2] - P[10][16]*SK_MX[1] + P[10][17]*SK_MX[4] - P[10][18]*SK_MX[3]);
-                Kfusion[11] = SK_MX[0]*(P[11][19] + P[11][1]*SH_MAG[0] - P[11][2]*SH_MAG[1] + P[11][3]*SH_MAG[2] + P[11][0]*SK_MX[2] - P[11][16]*SK_MX[1] + P[11][17]*SK_MX[4] - P[11][18]*SK_MX[3]);
-                Kfusion[12] = SK_MX[0]*(P[12][19] + P[12][1]*SH_MAG[0] - P[12][2]*SH_MAG[1] + P[12][3]*SH_MAG[2] + P[12][0]*SK_MX[2] - P[12][16]*SK_MX[1] + P[12][17]*SK_MX[4] - P[12][18]*SK_MX[3]);
+                Kfusion[10] = SK_MX[0]*(Pg(10,19) + Pg(10,1)*SH_MAG[0] - Pg(10,2)*SH_MAG[1] + Pg(10,3)*SH_MAG[2] + Pg(10,0)*SK_MX[2] - Pg(10,16)*SK_MX[1] + Pg(10,17)*SK_MX[4] - Pg(10,18)*SK_MX[3]);
+                Kfusion[11] = SK_MX[0]*(Pg(11,19) + Pg(11,1)*SH_MAG[0] - Pg(11,2)*SH_MAG[1] + Pg(11,3)*SH_MAG[2] + Pg(11,0)*SK_MX[2] - Pg(11,16)*SK_MX[1] + Pg(11,17)*SK_MX[4] - Pg(11,18)*SK_MX[3]);
+                Kfusion[12] = SK_MX[0]*(Pg(12,19) + Pg(12,1)*SH_MAG[0] - Pg(12,2)*SH_MAG[1] + Pg(12,3)*SH_MAG[2] + Pg(12,0)*SK_MX[2] - Pg(12,16)*SK_MX[1] + Pg(12,17)*SK_MX[4] - Pg(12,18)*SK_MX[3]);
             } else {
                 // zero indexes 10 to 12
                 zero_range(&Kfusion[0], 10, 12);
@@ -631,7 +632,7 @@ void NavEKF3_core::FuseMagnetometer()
                 for (uint8_t index = 0; index < 3; index++) {
                     const uint8_t stateIndex = index + 13;
                     if (!dvelBiasAxisInhibit[index]) {
-                        Kfusion[stateIndex] = SK_MX[0]*(P[stateIndex][19] + P[stateIndex][1]*SH_MAG[0] - P[stateIndex][2]*SH_MAG[1] + P[stateIndex][3]*SH_MAG[2] + P[stateIndex][0]*SK_MX[2] - P[stateIndex][16]*SK_MX[1] + P[stateIndex][17]*SK_MX[4] - P[stateIndex][18]*SK_MX[3]);
+                        Kfusion[stateIndex] = SK_MX[0]*(Pg(stateIndex,19) + Pg(stateIndex,1)*SH_MAG[0] - Pg(stateIndex,2)*SH_MAG[1] + Pg(stateIndex,3)*SH_MAG[2] + Pg(stateIndex,0)*SK_MX[2] - Pg(stateIndex,16)*SK_MX[1] + Pg(stateIndex,17)*SK_MX[4] - Pg(stateIndex,18)*SK_MX[3]);
                     } else {
                         Kfusion[stateIndex] = 0.0f;
                     }
@@ -642,12 +643,12 @@ void NavEKF3_core::FuseMagnetometer()
             }
             // zero Kalman gains to inhibit magnetic field state estimation
             if (!inhibitMagStates) {
-                Kfusion[16] = SK_MX[0]*(P[16][19] + P[16][1]*SH_MAG[0] - P[16][2]*SH_MAG[1] + P[16][3]*SH_MAG[2] + P[16][0]*SK_MX[2] - P[16][16]*SK_MX[1] + P[16][17]*SK_MX[4] - P[16][18]*SK_MX[3]);
-                Kfusion[17] = SK_MX[0]*(P[17][19] + P[17][1]*SH_MAG[0] - P[17][2]*SH_MAG[1] + P[17][3]*SH_MAG[2] + P[17][0]*SK_MX[2] - P[17][16]*SK_MX[1] + P[17][17]*SK_MX[4] - P[17][18]*SK_MX[3]);
-                Kfusion[18] = SK_MX[0]*(P[18][19] + P[18][1]*SH_MAG[0] - P[18][2]*SH_MAG[1] + P[18][3]*SH_MAG[2] + P[18][0]*SK_MX[2] - P[18][16]*SK_MX[1] + P[18][17]*SK_MX[4] - P[18][18]*SK_MX[3]);
-                Kfusion[19] = SK_MX[0]*(P[19][19] + P[19][1]*SH_MAG[0] - P[19][2]*SH_MAG[1] + P[19][3]*SH_MAG[2] + P[19][0]*SK_MX[2] - P[19][16]*SK_MX[1] + P[19][17]*SK_MX[4] - P[19][18]*SK_MX[3]);
-                Kfusion[20] = SK_MX[0]*(P[20][19] + P[20][1]*SH_MAG[0] - P[20][2]*SH_MAG[1] + P[20][3]*SH_MAG[2] + P[20][0]*SK_MX[2] - P[20][16]*SK_MX[1] + P[20][17]*SK_MX[4] - P[20][18]*SK_MX[3]);
-                Kfusion[21] = SK_MX[0]*(P[21][19] + P[21][1]*SH_MAG[0] - P[21][2]*SH_MAG[1] + P[21][3]*SH_MAG[2] + P[21][0]*SK_MX[2] - P[21][16]*SK_MX[1] + P[21][17]*SK_MX[4] - P[21][18]*SK_MX[3]);
+                Kfusion[16] = SK_MX[0]*(Pg(16,19) + Pg(16,1)*SH_MAG[0] - Pg(16,2)*SH_MAG[1] + Pg(16,3)*SH_MAG[2] + Pg(16,0)*SK_MX[2] - Pg(16,16)*SK_MX[1] + Pg(16,17)*SK_MX[4] - Pg(16,18)*SK_MX[3]);
+                Kfusion[17] = SK_MX[0]*(Pg(17,19) + Pg(17,1)*SH_MAG[0] - Pg(17,2)*SH_MAG[1] + Pg(17,3)*SH_MAG[2] + Pg(17,0)*SK_MX[2] - Pg(17,16)*SK_MX[1] + Pg(17,17)*SK_MX[4] - Pg(17,18)*SK_MX[3]);
+                Kfusion[18] = SK_MX[0]*(Pg(18,19) + Pg(18,1)*SH_MAG[0] - Pg(18,2)*SH_MAG[1] + Pg(18,3)*SH_MAG[2] + Pg(18,0)*SK_MX[2] - Pg(18,16)*SK_MX[1] + Pg(18,17)*SK_MX[4] - Pg(18,18)*SK_MX[3]);
+                Kfusion[19] = SK_MX[0]*(Pg(19,19) + Pg(19,1)*SH_MAG[0] - Pg(19,2)*SH_MAG[1] + Pg(19,3)*SH_MAG[2] + Pg(19,0)*SK_MX[2] - Pg(19,16)*SK_MX[1] + Pg(19,17)*SK_MX[4] - Pg(19,18)*SK_MX[3]);
+                Kfusion[20] = SK_MX[0]*(Pg(20,19) + Pg(20,1)*SH_MAG[0] - Pg(20,2)*SH_MAG[1] + Pg(20,3)*SH_MAG[2] + Pg(20,0)*SK_MX[2] - Pg(20,16)*SK_MX[1] + Pg(20,17)*SK_MX[4] - Pg(20,18)*SK_MX[3]);
+                Kfusion[21] = SK_MX[0]*(Pg(21,19) + Pg(21,1)*SH_MAG[0] - Pg(21,2)*SH_MAG[1] + Pg(21,3)*SH_MAG[2] + Pg(21,0)*SK_MX[2] - Pg(21,16)*SK_MX[1] + Pg(21,17)*SK_MX[4] - Pg(21,18)*SK_MX[3]);
             } else {
                 // zero indexes 16 to 21
                 zero_range(&Kfusion[0], 16, 21);
@@ -655,8 +656,8 @@ void NavEKF3_core::FuseMagnetometer()
 
             // zero Kalman gains to inhibit wind state estimation
             if (!inhibitWindStates && !treatWindStatesAsTruth) {
-                Kfusion[22] = SK_MX[0]*(P[22][19] + P[22][1]*SH_MAG[0] - P[22][2]*SH_MAG[1] + P[22][3]*SH_MAG[2] + P[22][0]*SK_MX[2] - P[22][16]*SK_MX[1] + P[22][17]*SK_MX[4] - P[22][18]*SK_MX[3]);
-                Kfusion[23] = SK_MX[0]*(P[23][19] + P[23][1]*SH_MAG[0] - P[23][2]*SH_MAG[1] + P[23][3]*SH_MAG[2] + P[23][0]*SK_MX[2] - P[23][16]*SK_MX[1] + P[23][17]*SK_MX[4] - P[23][18]*SK_MX[3]);
+                Kfusion[22] = SK_MX[0]*(Pg(22,19) + Pg(22,1)*SH_MAG[0] - Pg(22,2)*SH_MAG[1] + Pg(22,3)*SH_MAG[2] + Pg(22,0)*SK_MX[2] - Pg(22,16)*SK_MX[1] + Pg(22,17)*SK_MX[4] - Pg(22,18)*SK_MX[3]);
+                Kfusion[23] = SK_MX[0]*(Pg(23,19) + Pg(23,1)*SH_MAG[0] - Pg(23,2)*SH_MAG[1] + Pg(23,3)*SH_MAG[2] + Pg(23,0)*SK_MX[2] - Pg(23,16)*SK_MX[1] + Pg(23,17)*SK_MX[4] - Pg(23,18)*SK_MX[3]);
             } else {
                 // zero indexes 22 to 23 = 2
                 zero_range(&Kfusion[0], 22, 23);
@@ -681,7 +682,7 @@ void NavEKF3_core::FuseMagnetometer()
             H_MAG[21] = 0.0f;
 
             // calculate Kalman gain
-            const Vector5 SK_MY {
+            const Vector5G SK_MY {
                 1.0f / varInnovMag[1],
                 SH_MAG[3] - SH_MAG[4] + SH_MAG[5] - SH_MAG[6],
                 SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2,
@@ -689,21 +690,21 @@ void NavEKF3_core::FuseMagnetometer()
                 2.0f*q0*q1 + 2.0f*q2*q3
             };
 
-            Kfusion[0] = SK_MY[0]*(P[0][20] + P[0][0]*SH_MAG[2] + P[0][1]*SH_MAG[1] + P[0][2]*SH_MAG[0] - P[0][3]*SK_MY[2] - P[0][17]*SK_MY[1] - P[0][16]*SK_MY[3] + P[0][18]*SK_MY[4]);
-            Kfusion[1] = SK_MY[0]*(P[1][20] + P[1][0]*SH_MAG[2] + P[1][1]*SH_MAG[1] + P[1][2]*SH_MAG[0] - P[1][3]*SK_MY[2] - P[1][17]*SK_MY[1] - P[1][16]*SK_MY[3] + P[1][18]*SK_MY[4]);
-            Kfusion[2] = SK_MY[0]*(P[2][20] + P[2][0]*SH_MAG[2] + P[2][1]*SH_MAG[1] + P[2][2]*SH_MAG[0] - P[2][3]*SK_MY[2] - P[2][17]*SK_MY[1] - P[2][16]*SK_MY[3] + P[2][18]*SK_MY[4]);
-            Kfusion[3] = SK_MY[0]*(P[3][20] + P[3][0]*SH_MAG[2] + P[3][1]*SH_MAG[1] + P[3][2]*SH_MAG[0] - P[3][3]*SK_MY[2] - P[3][17]*SK_MY[1] - P[3][16]*SK_MY[3] + P[3][18]*SK_MY[4]);
-            Kfusion[4] = SK_MY[0]*(P[4][20] + P[4][0]*SH_MAG[2] + P[4][1]*SH_MAG[1] + P[4][2]*SH_MAG[0] - P[4][3]*SK_MY[2] - P[4][17]*SK_MY[1] - P[4][16]*SK_MY[3] + P[4][18]*SK_MY[4]);
-            Kfusion[5] = SK_MY[0]*(P[5][20] + P[5][0]*SH_MAG[2] + P[5][1]*SH_MAG[1] + P[5][2]*SH_MAG[0] - P[5][3]*SK_MY[2] - P[5][17]*SK_MY[1] - P[5][16]*SK_MY[3] + P[5][18]*SK_MY[4]);
-            Kfusion[6] = SK_MY[0]*(P[6][20] + P[6][0]*SH_MAG[2] + P[6][1]*SH_MAG[1] + P[6][2]*SH_MAG[0] - P[6][3]*SK_MY[2] - P[6][17]*SK_MY[1] - P[6][16]*SK_MY[3] + P[6][18]*SK_MY[4]);
-            Kfusion[7] = SK_MY[0]*(P[7][20] + P[7][0]*SH_MAG[2] + P[7][1]*SH_MAG[1] + P[7][2]*SH_MAG[0] - P[7][3]*SK_MY[2] - P[7][17]*SK_MY[1] - P[7][16]*SK_MY[3] + P[7][18]*SK_MY[4]);
-            Kfusion[8] = SK_MY[0]*(P[8][20] + P[8][0]*SH_MAG[2] + P[8][1]*SH_MAG[1] + P[8][2]*SH_MAG[0] - P[8][3]*SK_MY[2] - P[8][17]*SK_MY[1] - P[8][16]*SK_MY[3] + P[8][18]*SK_MY[4]);
-            Kfusion[9] = SK_MY[0]*(P[9][20] + P[9][0]*SH_MAG[2] + P[9][1]*SH_MAG[1] + P[9][2]*SH_MAG[0] - P[9][3]*SK_MY[2] - P[9][17]*SK_MY[1] - P[9][16]*SK_MY[3] + P[9][18]*SK_MY[4]);
+            Kfusion[0] = SK_MY[0]*(Pg(0,20) + Pg(0,0)*SH_MAG[2] + Pg(0,1)*SH_MAG[1] + Pg(0,2)*SH_MAG[0] - Pg(0,3)*SK_MY[2] - Pg(0,17)*SK_MY[1] - Pg(0,16)*SK_MY[3] + Pg(0,18)*SK_MY[4]);
+            Kfusion[1] = SK_MY[0]*(Pg(1,20) + Pg(1,0)*SH_MAG[2] + Pg(1,1)*SH_MAG[1] + Pg(1,2)*SH_MAG[0] - Pg(1,3)*SK_MY[2] - Pg(1,17)*SK_MY[1] - Pg(1,16)*SK_MY[3] + Pg(1,18)*SK_MY[4]);
+            Kfusion[2] = SK_MY[0]*(Pg(2,20) + Pg(2,0)*SH_MAG[2] + Pg(2,1)*SH_MAG[1] + Pg(2,2)*SH_MAG[0] - Pg(2,3)*SK_MY[2] - Pg(2,17)*SK_MY[1] - Pg(2,16)*SK_MY[3] + Pg(2,18)*SK_MY[4]);
+            Kfusion[3] = SK_MY[0]*(Pg(3,20) + Pg(3,0)*SH_MAG[2] + Pg(3,1)*SH_MAG[1] + Pg(3,2)*SH_MAG[0] - Pg(3,3)*SK_MY[2] - Pg(3,17)*SK_MY[1] - Pg(3,16)*SK_MY[3] + Pg(3,18)*SK_MY[4]);
+            Kfusion[4] = SK_MY[0]*(Pg(4,20) + Pg(4,0)*SH_MAG[2] + Pg(4,1)*SH_MAG[1] + Pg(4,2)*SH_MAG[0] - Pg(4,3)*SK_MY[2] - Pg(4,17)*SK_MY[1] - Pg(4,16)*SK_MY[3] + Pg(4,18)*SK_MY[4]);
+            Kfusion[5] = SK_MY[0]*(Pg(5,20) + Pg(5,0)*SH_MAG[2] + Pg(5,1)*SH_MAG[1] + Pg(5,2)*SH_MAG[0] - Pg(5,3)*SK_MY[2] - Pg(5,17)*SK_MY[1] - Pg(5,16)*SK_MY[3] + Pg(5,18)*SK_MY[4]);
+            Kfusion[6] = SK_MY[0]*(Pg(6,20) + Pg(6,0)*SH_MAG[2] + Pg(6,1)*SH_MAG[1] + Pg(6,2)*SH_MAG[0] - Pg(6,3)*SK_MY[2] - Pg(6,17)*SK_MY[1] - Pg(6,16)*SK_MY[3] + Pg(6,18)*SK_MY[4]);
+            Kfusion[7] = SK_MY[0]*(Pg(7,20) + Pg(7,0)*SH_MAG[2] + Pg(7,1)*SH_MAG[1] + Pg(7,2)*SH_MAG[0] - Pg(7,3)*SK_MY[2] - Pg(7,17)*SK_MY[1] - Pg(7,16)*SK_MY[3] + Pg(7,18)*SK_MY[4]);
+            Kfusion[8] = SK_MY[0]*(Pg(8,20) + Pg(8,0)*SH_MAG[2] + Pg(8,1)*SH_MAG[1] + Pg(8,2)*SH_MAG[0] - Pg(8,3)*SK_MY[2] - Pg(8,17)*SK_MY[1] - Pg(8,16)*SK_MY[3] + Pg(8,18)*SK_MY[4]);
+            Kfusion[9] = SK_MY[0]*(Pg(9,20) + Pg(9,0)*SH_MAG[2] + Pg(9,1)*SH_MAG[1] + Pg(9,2)*SH_MAG[0] - Pg(9,3)*SK_MY[2] - Pg(9,17)*SK_MY[1] - Pg(9,16)*SK_MY[3] + Pg(9,18)*SK_MY[4]);
 
             if (!inhibitDelAngBiasStates) {
-                Kfusion[10] = SK_MY[0]*(P[10][20] + P[10][0]*SH_MAG[2] + P[10][1]*SH_MAG[1] + P[10][2]*SH_MAG[0] - P[10][3]*SK_MY[2] - P[10][17]*SK_MY[1] - P[10][16]*SK_MY[3] + P[10][18]*SK_MY[4]);
-                Kfusion[11] = SK_MY[0]*(P[11][20] + P[11][0]*SH_MAG[2] + P[11][1]*SH_MAG[1] + P[11][2]*SH_MAG[0] - P[11][3]*SK_MY[2] - P[11][17]*SK_MY[1] - P[11][16]*SK_MY[3] + P[11][18]*SK_MY[4]);
-                Kfusion[12] = SK_MY[0]*(P[12][20] + P[12][0]*SH_MAG[2] + P[12][1]*SH_MAG[1] + P[12][2]*SH_MAG[0] - P[12][3]*SK_MY[2] - P[12][17]*SK_MY[1] - P[12][16]*SK_MY[3] + P[12][18]*SK_MY[4]);
+                Kfusion[10] = SK_MY[0]*(Pg(10,20) + Pg(10,0)*SH_MAG[2] + Pg(10,1)*SH_MAG[1] + Pg(10,2)*SH_MAG[0] - Pg(10,3)*SK_MY[2] - Pg(10,17)*SK_MY[1] - Pg(10,16)*SK_MY[3] + Pg(10,18)*SK_MY[4]);
+                Kfusion[11] = SK_MY[0]*(Pg(11,20) + Pg(11,0)*SH_MAG[2] + Pg(11,1)*SH_MAG[1] + Pg(11,2)*SH_MAG[0] - Pg(11,3)*SK_MY[2] - Pg(11,17)*SK_MY[1] - Pg(11,16)*SK_MY[3] + Pg(11,18)*SK_MY[4]);
+                Kfusion[12] = SK_MY[0]*(Pg(12,20) + Pg(12,0)*SH_MAG[2] + Pg(12,1)*SH_MAG[1] + Pg(12,2)*SH_MAG[0] - Pg(12,3)*SK_MY[2] - Pg(12,17)*SK_MY[1] - Pg(12,16)*SK_MY[3] + Pg(12,18)*SK_MY[4]);
             } else {
                 // zero indexes 10 to 12
                 zero_range(&Kfusion[0], 10, 12);
@@ -713,7 +714,7 @@ void NavEKF3_core::FuseMagnetometer()
                 for (uint8_t index = 0; index < 3; index++) {
                     const uint8_t stateIndex = index + 13;
                     if (!dvelBiasAxisInhibit[index]) {
-                        Kfusion[stateIndex] = SK_MY[0]*(P[stateIndex][20] + P[stateIndex][0]*SH_MAG[2] + P[stateIndex][1]*SH_MAG[1] + P[stateIndex][2]*SH_MAG[0] - P[stateIndex][3]*SK_MY[2] - P[stateIndex][17]*SK_MY[1] - P[stateIndex][16]*SK_MY[3] + P[stateIndex][18]*SK_MY[4]);
+                        Kfusion[stateIndex] = SK_MY[0]*(Pg(stateIndex,20) + Pg(stateIndex,0)*SH_MAG[2] + Pg(stateIndex,1)*SH_MAG[1] + Pg(stateIndex,2)*SH_MAG[0] - Pg(stateIndex,3)*SK_MY[2] - Pg(stateIndex,17)*SK_MY[1] - Pg(stateIndex,16)*SK_MY[3] + Pg(stateIndex,18)*SK_MY[4]);
                     } else {
                         Kfusion[stateIndex] = 0.0f;
                     }
@@ -725,12 +726,12 @@ void NavEKF3_core::FuseMagnetometer()
 
             // zero Kalman gains to inhibit magnetic field state estimation
             if (!inhibitMagStates) {
-                Kfusion[16] = SK_MY[0]*(P[16][20] + P[16][0]*SH_MAG[2] + P[16][1]*SH_MAG[1] + P[16][2]*SH_MAG[0] - P[16][3]*SK_MY[2] - P[16][17]*SK_MY[1] - P[16][16]*SK_MY[3] + P[16][18]*SK_MY[4]);
-                Kfusion[17] = SK_MY[0]*(P[17][20] + P[17][0]*SH_MAG[2] + P[17][1]*SH_MAG[1] + P[17][2]*SH_MAG[0] - P[17][3]*SK_MY[2] - P[17][17]*SK_MY[1] - P[17][16]*SK_MY[3] + P[17][18]*SK_MY[4]);
-                Kfusion[18] = SK_MY[0]*(P[18][20] + P[18][0]*SH_MAG[2] + P[18][1]*SH_MAG[1] + P[18][2]*SH_MAG[0] - P[18][3]*SK_MY[2] - P[18][17]*SK_MY[1] - P[18][16]*SK_MY[3] + P[18][18]*SK_MY[4]);
-                Kfusion[19] = SK_MY[0]*(P[19][20] + P[19][0]*SH_MAG[2] + P[19][1]*SH_MAG[1] + P[19][2]*SH_MAG[0] - P[19][3]*SK_MY[2] - P[19][17]*SK_MY[1] - P[19][16]*SK_MY[3] + P[19][18]*SK_MY[4]);
-                Kfusion[20] = SK_MY[0]*(P[20][20] + P[20][0]*SH_MAG[2] + P[20][1]*SH_MAG[1] + P[20][2]*SH_MAG[0] - P[20][3]*SK_MY[2] - P[20][17]*SK_MY[1] - P[20][16]*SK_MY[3] + P[20][18]*SK_MY[4]);
-                Kfusion[21] = SK_MY[0]*(P[21][20] + P[21][0]*SH_MAG[2] + P[21][1]*SH_MAG[1] + P[21][2]*SH_MAG[0] - P[21][3]*SK_MY[2] - P[21][17]*SK_MY[1] - P[21][16]*SK_MY[3] + P[21][18]*SK_MY[4]);
+                Kfusion[16] = SK_MY[0]*(Pg(16,20) + Pg(16,0)*SH_MAG[2] + Pg(16,1)*SH_MAG[1] + Pg(16,2)*SH_MAG[0] - Pg(16,3)*SK_MY[2] - Pg(16,17)*SK_MY[1] - Pg(16,16)*SK_MY[3] + Pg(16,18)*SK_MY[4]);
+                Kfusion[17] = SK_MY[0]*(Pg(17,20) + Pg(17,0)*SH_MAG[2] + Pg(17,1)*SH_MAG[1] + Pg(17,2)*SH_MAG[0] - Pg(17,3)*SK_MY[2] - Pg(17,17)*SK_MY[1] - Pg(17,16)*SK_MY[3] + Pg(17,18)*SK_MY[4]);
+                Kfusion[18] = SK_MY[0]*(Pg(18,20) + Pg(18,0)*SH_MAG[2] + Pg(18,1)*SH_MAG[1] + Pg(18,2)*SH_MAG[0] - Pg(18,3)*SK_MY[2] - Pg(18,17)*SK_MY[1] - Pg(18,16)*SK_MY[3] + Pg(18,18)*SK_MY[4]);
+                Kfusion[19] = SK_MY[0]*(Pg(19,20) + Pg(19,0)*SH_MAG[2] + Pg(19,1)*SH_MAG[1] + Pg(19,2)*SH_MAG[0] - Pg(19,3)*SK_MY[2] - Pg(19,17)*SK_MY[1] - Pg(19,16)*SK_MY[3] + Pg(19,18)*SK_MY[4]);
+                Kfusion[20] = SK_MY[0]*(Pg(20,20) + Pg(20,0)*SH_MAG[2] + Pg(20,1)*SH_MAG[1] + Pg(20,2)*SH_MAG[0] - Pg(20,3)*SK_MY[2] - Pg(20,17)*SK_MY[1] - Pg(20,16)*SK_MY[3] + Pg(20,18)*SK_MY[4]);
+                Kfusion[21] = SK_MY[0]*(Pg(21,20) + Pg(21,0)*SH_MAG[2] + Pg(21,1)*SH_MAG[1] + Pg(21,2)*SH_MAG[0] - Pg(21,3)*SK_MY[2] - Pg(21,17)*SK_MY[1] - Pg(21,16)*SK_MY[3] + Pg(21,18)*SK_MY[4]);
             } else {
                 // zero indexes 16 to 21
                 zero_range(&Kfusion[0], 16, 21);
@@ -738,8 +739,8 @@ void NavEKF3_core::FuseMagnetometer()
 
             // zero Kalman gains to inhibit wind state estimation
             if (!inhibitWindStates && !treatWindStatesAsTruth) {
-                Kfusion[22] = SK_MY[0]*(P[22][20] + P[22][0]*SH_MAG[2] + P[22][1]*SH_MAG[1] + P[22][2]*SH_MAG[0] - P[22][3]*SK_MY[2] - P[22][17]*SK_MY[1] - P[22][16]*SK_MY[3] + P[22][18]*SK_MY[4]);
-                Kfusion[23] = SK_MY[0]*(P[23][20] + P[23][0]*SH_MAG[2] + P[23][1]*SH_MAG[1] + P[23][2]*SH_MAG[0] - P[23][3]*SK_MY[2] - P[23][17]*SK_MY[1] - P[23][16]*SK_MY[3] + P[23][18]*SK_MY[4]);
+                Kfusion[22] = SK_MY[0]*(Pg(22,20) + Pg(22,0)*SH_MAG[2] + Pg(22,1)*SH_MAG[1] + Pg(22,2)*SH_MAG[0] - Pg(22,3)*SK_MY[2] - Pg(22,17)*SK_MY[1] - Pg(22,16)*SK_MY[3] + Pg(22,18)*SK_MY[4]);
+                Kfusion[23] = SK_MY[0]*(Pg(23,20) + Pg(23,0)*SH_MAG[2] + Pg(23,1)*SH_MAG[1] + Pg(23,2)*SH_MAG[0] - Pg(23,3)*SK_MY[2] - Pg(23,17)*SK_MY[1] - Pg(23,16)*SK_MY[3] + Pg(23,18)*SK_MY[4]);
             } else {
                 // zero indexes 22 to 23
                 zero_range(&Kfusion[0], 22, 23);
@@ -765,7 +766,7 @@ void NavEKF3_core::FuseMagnetometer()
             H_MAG[21] = 1.0f;
 
             // calculate Kalman gain
-            const Vector5 SK_MZ {
+            const Vector5G SK_MZ {
                 1.0f / varInnovMag[2],
                 SH_MAG[3] - SH_MAG[4] - SH_MAG[5] + SH_MAG[6],
                 SH_MAG[7] + SH_MAG[8] - 2.0f*magD*q2,
@@ -773,21 +774,21 @@ void NavEKF3_core::FuseMagnetometer()
                 2.0f*q0*q2 + 2.0f*q1*q3
             };
 
-            Kfusion[0] = SK_MZ[0]*(P[0][21] + P[0][0]*SH_MAG[1] - P[0][1]*SH_MAG[2] + P[0][3]*SH_MAG[0] + P[0][2]*SK_MZ[2] + P[0][18]*SK_MZ[1] + P[0][16]*SK_MZ[4] - P[0][17]*SK_MZ[3]);
-            Kfusion[1] = SK_MZ[0]*(P[1][21] + P[1][0]*SH_MAG[1] - P[1][1]*SH_MAG[2] + P[1][3]*SH_MAG[0] + P[1][2]*SK_MZ[2] + P[1][18]*SK_MZ[1] + P[1][16]*SK_MZ[4] - P[1][17]*SK_MZ[3]);
-            Kfusion[2] = SK_MZ[0]*(P[2][21] + P[2][0]*SH_MAG[1] - P[2][1]*SH_MAG[2] + P[2][3]*SH_MAG[0] + P[2][2]*SK_MZ[2] + P[2][18]*SK_MZ[1] + P[2][16]*SK_MZ[4] - P[2][17]*SK_MZ[3]);
-            Kfusion[3] = SK_MZ[0]*(P[3][21] + P[3][0]*SH_MAG[1] - P[3][1]*SH_MAG[2] + P[3][3]*SH_MAG[0] + P[3][2]*SK_MZ[2] + P[3][18]*SK_MZ[1] + P[3][16]*SK_MZ[4] - P[3][17]*SK_MZ[3]);
-            Kfusion[4] = SK_MZ[0]*(P[4][21] + P[4][0]*SH_MAG[1] - P[4][1]*SH_MAG[2] + P[4][3]*SH_MAG[0] + P[4][2]*SK_MZ[2] + P[4][18]*SK_MZ[1] + P[4][16]*SK_MZ[4] - P[4][17]*SK_MZ[3]);
-            Kfusion[5] = SK_MZ[0]*(P[5][21] + P[5][0]*SH_MAG[1] - P[5][1]*SH_MAG[2] + P[5][3]*SH_MAG[0] + P[5][2]*SK_MZ[2] + P[5][18]*SK_MZ[1] + P[5][16]*SK_MZ[4] - P[5][17]*SK_MZ[3]);
-            Kfusion[6] = SK_MZ[0]*(P[6][21] + P[6][0]*SH_MAG[1] - P[6][1]*SH_MAG[2] + P[6][3]*SH_MAG[0] + P[6][2]*SK_MZ[2] + P[6][18]*SK_MZ[1] + P[6][16]*SK_MZ[4] - P[6][17]*SK_MZ[3]);
-            Kfusion[7] = SK_MZ[0]*(P[7][21] + P[7][0]*SH_MAG[1] - P[7][1]*SH_MAG[2] + P[7][3]*SH_MAG[0] + P[7][2]*SK_MZ[2] + P[7][18]*SK_MZ[1] + P[7][16]*SK_MZ[4] - P[7][17]*SK_MZ[3]);
-            Kfusion[8] = SK_MZ[0]*(P[8][21] + P[8][0]*SH_MAG[1] - P[8][1]*SH_MAG[2] + P[8][3]*SH_MAG[0] + P[8][2]*SK_MZ[2] + P[8][18]*SK_MZ[1] + P[8][16]*SK_MZ[4] - P[8][17]*SK_MZ[3]);
-            Kfusion[9] = SK_MZ[0]*(P[9][21] + P[9][0]*SH_MAG[1] - P[9][1]*SH_MAG[2] + P[9][3]*SH_MAG[0] + P[9][2]*SK_MZ[2] + P[9][18]*SK_MZ[1] + P[9][16]*SK_MZ[4] - P[9][17]*SK_MZ[3]);
+            Kfusion[0] = SK_MZ[0]*(Pg(0,21) + Pg(0,0)*SH_MAG[1] - Pg(0,1)*SH_MAG[2] + Pg(0,3)*SH_MAG[0] + Pg(0,2)*SK_MZ[2] + Pg(0,18)*SK_MZ[1] + Pg(0,16)*SK_MZ[4] - Pg(0,17)*SK_MZ[3]);
+            Kfusion[1] = SK_MZ[0]*(Pg(1,21) + Pg(1,0)*SH_MAG[1] - Pg(1,1)*SH_MAG[2] + Pg(1,3)*SH_MAG[0] + Pg(1,2)*SK_MZ[2] + Pg(1,18)*SK_MZ[1] + Pg(1,16)*SK_MZ[4] - Pg(1,17)*SK_MZ[3]);
+            Kfusion[2] = SK_MZ[0]*(Pg(2,21) + Pg(2,0)*SH_MAG[1] - Pg(2,1)*SH_MAG[2] + Pg(2,3)*SH_MAG[0] + Pg(2,2)*SK_MZ[2] + Pg(2,18)*SK_MZ[1] + Pg(2,16)*SK_MZ[4] - Pg(2,17)*SK_MZ[3]);
+            Kfusion[3] = SK_MZ[0]*(Pg(3,21) + Pg(3,0)*SH_MAG[1] - Pg(3,1)*SH_MAG[2] + Pg(3,3)*SH_MAG[0] + Pg(3,2)*SK_MZ[2] + Pg(3,18)*SK_MZ[1] + Pg(3,16)*SK_MZ[4] - Pg(3,17)*SK_MZ[3]);
+            Kfusion[4] = SK_MZ[0]*(Pg(4,21) + Pg(4,0)*SH_MAG[1] - Pg(4,1)*SH_MAG[2] + Pg(4,3)*SH_MAG[0] + Pg(4,2)*SK_MZ[2] + Pg(4,18)*SK_MZ[1] + Pg(4,16)*SK_MZ[4] - Pg(4,17)*SK_MZ[3]);
+            Kfusion[5] = SK_MZ[0]*(Pg(5,21) + Pg(5,0)*SH_MAG[1] - Pg(5,1)*SH_MAG[2] + Pg(5,3)*SH_MAG[0] + Pg(5,2)*SK_MZ[2] + Pg(5,18)*SK_MZ[1] + Pg(5,16)*SK_MZ[4] - Pg(5,17)*SK_MZ[3]);
+            Kfusion[6] = SK_MZ[0]*(Pg(6,21) + Pg(6,0)*SH_MAG[1] - Pg(6,1)*SH_MAG[2] + Pg(6,3)*SH_MAG[0] + Pg(6,2)*SK_MZ[2] + Pg(6,18)*SK_MZ[1] + Pg(6,16)*SK_MZ[4] - Pg(6,17)*SK_MZ[3]);
+            Kfusion[7] = SK_MZ[0]*(Pg(7,21) + Pg(7,0)*SH_MAG[1] - Pg(7,1)*SH_MAG[2] + Pg(7,3)*SH_MAG[0] + Pg(7,2)*SK_MZ[2] + Pg(7,18)*SK_MZ[1] + Pg(7,16)*SK_MZ[4] - Pg(7,17)*SK_MZ[3]);
+            Kfusion[8] = SK_MZ[0]*(Pg(8,21) + Pg(8,0)*SH_MAG[1] - Pg(8,1)*SH_MAG[2] + Pg(8,3)*SH_MAG[0] + Pg(8,2)*SK_MZ[2] + Pg(8,18)*SK_MZ[1] + Pg(8,16)*SK_MZ[4] - Pg(8,17)*SK_MZ[3]);
+            Kfusion[9] = SK_MZ[0]*(Pg(9,21) + Pg(9,0)*SH_MAG[1] - Pg(9,1)*SH_MAG[2] + Pg(9,3)*SH_MAG[0] + Pg(9,2)*SK_MZ[2] + Pg(9,18)*SK_MZ[1] + Pg(9,16)*SK_MZ[4] - Pg(9,17)*SK_MZ[3]);
 
             if (!inhibitDelAngBiasStates) {
-                Kfusion[10] = SK_MZ[0]*(P[10][21] + P[10][0]*SH_MAG[1] - P[10][1]*SH_MAG[2] + P[10][3]*SH_MAG[0] + P[10][2]*SK_MZ[2] + P[10][18]*SK_MZ[1] + P[10][16]*SK_MZ[4] - P[10][17]*SK_MZ[3]);
-                Kfusion[11] = SK_MZ[0]*(P[11][21] + P[11][0]*SH_MAG[1] - P[11][1]*SH_MAG[2] + P[11][3]*SH_MAG[0] + P[11][2]*SK_MZ[2] + P[11][18]*SK_MZ[1] + P[11][16]*SK_MZ[4] - P[11][17]*SK_MZ[3]);
-                Kfusion[12] = SK_MZ[0]*(P[12][21] + P[12][0]*SH_MAG[1] - P[12][1]*SH_MAG[2] + P[12][3]*SH_MAG[0] + P[12][2]*SK_MZ[2] + P[12][18]*SK_MZ[1] + P[12][16]*SK_MZ[4] - P[12][17]*SK_MZ[3]);
+                Kfusion[10] = SK_MZ[0]*(Pg(10,21) + Pg(10,0)*SH_MAG[1] - Pg(10,1)*SH_MAG[2] + Pg(10,3)*SH_MAG[0] + Pg(10,2)*SK_MZ[2] + Pg(10,18)*SK_MZ[1] + Pg(10,16)*SK_MZ[4] - Pg(10,17)*SK_MZ[3]);
+                Kfusion[11] = SK_MZ[0]*(Pg(11,21) + Pg(11,0)*SH_MAG[1] - Pg(11,1)*SH_MAG[2] + Pg(11,3)*SH_MAG[0] + Pg(11,2)*SK_MZ[2] + Pg(11,18)*SK_MZ[1] + Pg(11,16)*SK_MZ[4] - Pg(11,17)*SK_MZ[3]);
+                Kfusion[12] = SK_MZ[0]*(Pg(12,21) + Pg(12,0)*SH_MAG[1] - Pg(12,1)*SH_MAG[2] + Pg(12,3)*SH_MAG[0] + Pg(12,2)*SK_MZ[2] + Pg(12,18)*SK_MZ[1] + Pg(12,16)*SK_MZ[4] - Pg(12,17)*SK_MZ[3]);
             } else {
                 // zero indexes 10 to 12
                 zero_range(&Kfusion[0], 10, 12);
@@ -797,7 +798,7 @@ void NavEKF3_core::FuseMagnetometer()
                 for (uint8_t index = 0; index < 3; index++) {
                     const uint8_t stateIndex = index + 13;
                     if (!dvelBiasAxisInhibit[index]) {
-                        Kfusion[stateIndex] = SK_MZ[0]*(P[stateIndex][21] + P[stateIndex][0]*SH_MAG[1] - P[stateIndex][1]*SH_MAG[2] + P[stateIndex][3]*SH_MAG[0] + P[stateIndex][2]*SK_MZ[2] + P[stateIndex][18]*SK_MZ[1] + P[stateIndex][16]*SK_MZ[4] - P[stateIndex][17]*SK_MZ[3]);
+                        Kfusion[stateIndex] = SK_MZ[0]*(Pg(stateIndex,21) + Pg(stateIndex,0)*SH_MAG[1] - Pg(stateIndex,1)*SH_MAG[2] + Pg(stateIndex,3)*SH_MAG[0] + Pg(stateIndex,2)*SK_MZ[2] + Pg(stateIndex,18)*SK_MZ[1] + Pg(stateIndex,16)*SK_MZ[4] - Pg(stateIndex,17)*SK_MZ[3]);
                     } else {
                         Kfusion[stateIndex] = 0.0f;
                     }
@@ -809,12 +810,12 @@ void NavEKF3_core::FuseMagnetometer()
 
             // zero Kalman gains to inhibit magnetic field state estimation
             if (!inhibitMagStates) {
-                Kfusion[16] = SK_MZ[0]*(P[16][21] + P[16][0]*SH_MAG[1] - P[16][1]*SH_MAG[2] + P[16][3]*SH_MAG[0] + P[16][2]*SK_MZ[2] + P[16][18]*SK_MZ[1] + P[16][16]*SK_MZ[4] - P[16][17]*SK_MZ[3]);
-                Kfusion[17] = SK_MZ[0]*(P[17][21] + P[17][0]*SH_MAG[1] - P[17][1]*SH_MAG[2] + P[17][3]*SH_MAG[0] + P[17][2]*SK_MZ[2] + P[17][18]*SK_MZ[1] + P[17][16]*SK_MZ[4] - P[17][17]*SK_MZ[3]);
-                Kfusion[18] = SK_MZ[0]*(P[18][21] + P[18][0]*SH_MAG[1] - P[18][1]*SH_MAG[2] + P[18][3]*SH_MAG[0] + P[18][2]*SK_MZ[2] + P[18][18]*SK_MZ[1] + P[18][16]*SK_MZ[4] - P[18][17]*SK_MZ[3]);
-                Kfusion[19] = SK_MZ[0]*(P[19][21] + P[19][0]*SH_MAG[1] - P[19][1]*SH_MAG[2] + P[19][3]*SH_MAG[0] + P[19][2]*SK_MZ[2] + P[19][18]*SK_MZ[1] + P[19][16]*SK_MZ[4] - P[19][17]*SK_MZ[3]);
-                Kfusion[20] = SK_MZ[0]*(P[20][21] + P[20][0]*SH_MAG[1] - P[20][1]*SH_MAG[2] + P[20][3]*SH_MAG[0] + P[20][2]*SK_MZ[2] + P[20][18]*SK_MZ[1] + P[20][16]*SK_MZ[4] - P[20][17]*SK_MZ[3]);
-                Kfusion[21] = SK_MZ[0]*(P[21][21] + P[21][0]*SH_MAG[1] - P[21][1]*SH_MAG[2] + P[21][3]*SH_MAG[0] + P[21][2]*SK_MZ[2] + P[21][18]*SK_MZ[1] + P[21][16]*SK_MZ[4] - P[21][17]*SK_MZ[3]);
+                Kfusion[16] = SK_MZ[0]*(Pg(16,21) + Pg(16,0)*SH_MAG[1] - Pg(16,1)*SH_MAG[2] + Pg(16,3)*SH_MAG[0] + Pg(16,2)*SK_MZ[2] + Pg(16,18)*SK_MZ[1] + Pg(16,16)*SK_MZ[4] - Pg(16,17)*SK_MZ[3]);
+                Kfusion[17] = SK_MZ[0]*(Pg(17,21) + Pg(17,0)*SH_MAG[1] - Pg(17,1)*SH_MAG[2] + Pg(17,3)*SH_MAG[0] + Pg(17,2)*SK_MZ[2] + Pg(17,18)*SK_MZ[1] + Pg(17,16)*SK_MZ[4] - Pg(17,17)*SK_MZ[3]);
+                Kfusion[18] = SK_MZ[0]*(Pg(18,21) + Pg(18,0)*SH_MAG[1] - Pg(18,1)*SH_MAG[2] + Pg(18,3)*SH_MAG[0] + Pg(18,2)*SK_MZ[2] + Pg(18,18)*SK_MZ[1] + Pg(18,16)*SK_MZ[4] - Pg(18,17)*SK_MZ[3]);
+                Kfusion[19] = SK_MZ[0]*(Pg(19,21) + Pg(19,0)*SH_MAG[1] - Pg(19,1)*SH_MAG[2] + Pg(19,3)*SH_MAG[0] + Pg(19,2)*SK_MZ[2] + Pg(19,18)*SK_MZ[1] + Pg(19,16)*SK_MZ[4] - Pg(19,17)*SK_MZ[3]);
+                Kfusion[20] = SK_MZ[0]*(Pg(20,21) + Pg(20,0)*SH_MAG[1] - Pg(20,1)*SH_MAG[2] + Pg(20,3)*SH_MAG[0] + Pg(20,2)*SK_MZ[2] + Pg(20,18)*SK_MZ[1] + Pg(20,16)*SK_MZ[4] - Pg(20,17)*SK_MZ[3]);
+                Kfusion[21] = SK_MZ[0]*(Pg(21,21) + Pg(21,0)*SH_MAG[1] - Pg(21,1)*SH_MAG[2] + Pg(21,3)*SH_MAG[0] + Pg(21,2)*SK_MZ[2] + Pg(21,18)*SK_MZ[1] + Pg(21,16)*SK_MZ[4] - Pg(21,17)*SK_MZ[3]);
             } else {
                 // zero indexes 16 to 21
                 zero_range(&Kfusion[0], 16, 21);
@@ -822,8 +823,8 @@ void NavEKF3_core::FuseMagnetometer()
 
             // zero Kalman gains to inhibit wind state estimation
             if (!inhibitWindStates && !treatWindStatesAsTruth) {
-                Kfusion[22] = SK_MZ[0]*(P[22][21] + P[22][0]*SH_MAG[1] - P[22][1]*SH_MAG[2] + P[22][3]*SH_MAG[0] + P[22][2]*SK_MZ[2] + P[22][18]*SK_MZ[1] + P[22][16]*SK_MZ[4] - P[22][17]*SK_MZ[3]);
-                Kfusion[23] = SK_MZ[0]*(P[23][21] + P[23][0]*SH_MAG[1] - P[23][1]*SH_MAG[2] + P[23][3]*SH_MAG[0] + P[23][2]*SK_MZ[2] + P[23][18]*SK_MZ[1] + P[23][16]*SK_MZ[4] - P[23][17]*SK_MZ[3]);
+                Kfusion[22] = SK_MZ[0]*(Pg(22,21) + Pg(22,0)*SH_MAG[1] - Pg(22,1)*SH_MAG[2] + Pg(22,3)*SH_MAG[0] + Pg(22,2)*SK_MZ[2] + Pg(22,18)*SK_MZ[1] + Pg(22,16)*SK_MZ[4] - Pg(22,17)*SK_MZ[3]);
+                Kfusion[23] = SK_MZ[0]*(Pg(23,21) + Pg(23,0)*SH_MAG[1] - Pg(23,1)*SH_MAG[2] + Pg(23,3)*SH_MAG[0] + Pg(23,2)*SK_MZ[2] + Pg(23,18)*SK_MZ[1] + Pg(23,16)*SK_MZ[4] - Pg(23,17)*SK_MZ[3]);
             } else {
                 // zero indexes 22 to 23
                 zero_range(&Kfusion[0], 22, 23);
@@ -876,8 +877,8 @@ void NavEKF3_core::FuseMagnetometer()
         if (healthyFusion) {
             // update the covariance matrix
             for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                    P[i][j] = P[i][j] - KHP[i][j];
+                for (uint8_t j= i; j<=stateIndexLim; j++) {
+                    P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
                 }
             }
 
@@ -1224,8 +1225,8 @@ bool NavEKF3_core::fuseEulerYaw(yawFusionMethod method)
     if (healthyFusion) {
         // update the covariance matrix
         for (uint8_t i= 0; i<=stateIndexLim; i++) {
-            for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                P[i][j] = P[i][j] - KHP[i][j];
+            for (uint8_t j= i; j<=stateIndexLim; j++) {
+                P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
             }
         }
 
@@ -1408,8 +1409,8 @@ void NavEKF3_core::FuseDeclination(ftype declErr)
     if (healthyFusion) {
         // update the covariance matrix
         for (uint8_t i= 0; i<=stateIndexLim; i++) {
-            for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                P[i][j] = P[i][j] - KHP[i][j];
+            for (uint8_t j= i; j<=stateIndexLim; j++) {
+                P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
             }
         }
 
@@ -173,8 +173,10 @@ void NavEKF3_core::writeWheelOdom(float delAng, float delTime, uint32_t timeStam
 // this needs to be called externally.
 void NavEKF3_core::writeOptFlowMeas(const uint8_t rawFlowQuality, const Vector2f &rawFlowRates, const Vector2f &rawGyroRates, const uint32_t msecFlowMeas, const Vector3f &posOffset, float heightOverride)
 {
-    // limit update rate to maximum allowed by sensor buffers
-    if ((imuSampleTime_ms - flowMeaTime_ms) < frontend->sensorIntervalMin_ms) {
+    // limit update rate to maximum allowed by sensor buffers. When
+    // averaging, every sample is used and the averages are limited instead
+    const bool averaging = frontend->_flowFuseRate > 0;
+    if (!averaging && (imuSampleTime_ms - flowMeaTime_ms) < frontend->sensorIntervalMin_ms) {
         return;
     }
 
@@ -233,10 +235,57 @@ void NavEKF3_core::writeOptFlowMeas(const uint8_t rawFlowQuality, const Vector2f
         ofDataNew.time_ms -= localFilterTimeStep_ms/2;
         // Prevent time delay exceeding age of oldest IMU data in the buffer
         ofDataNew.time_ms = MAX(ofDataNew.time_ms,imuDataDelayed.time_ms);
+        if (averaging) {
+            averageOptFlowMeas(ofDataNew);
+            return;
+        }
         // Save data to buffer
         storedOF.push(ofDataNew);
     }
 }
+
+/*
+  average optical flow samples down to EK3_FLOW_RATE, so a high rate
+  sensor costs no more to fuse than a slow one without its data being
+  thrown away. Averaging N samples with independent noise divides the
+  noise variance by N, which is passed to the fusion via noiseVarScale
+*/
+void NavEKF3_core::averageOptFlowMeas(of_elements &ofDataNew)
+{
+    // start again if the samples have stopped coming
+    if (flowAvg.count > 0 && imuSampleTime_ms - flowAvg.lastSample_ms > 200) {
+        flowAvg.count = 0;
+    }
+    if (flowAvg.count == 0) {
+        flowAvg.flowRadXY.zero();
+        flowAvg.bodyRadXYZ.zero();
+        flowAvg.firstTime_ms = ofDataNew.time_ms;
+        flowAvg.timeSum_ms = 0;
+    }
+    flowAvg.flowRadXY += ofDataNew.flowRadXY;
+    flowAvg.bodyRadXYZ += ofDataNew.bodyRadXYZ;
+    flowAvg.timeSum_ms += ofDataNew.time_ms - flowAvg.firstTime_ms;
+    flowAvg.lastSample_ms = imuSampleTime_ms;
+    flowAvg.count++;
+
+    const uint32_t interval_ms = MAX(1000U / uint32_t(frontend->_flowFuseRate), uint32_t(frontend->sensorIntervalMin_ms));
+    if (imuSampleTime_ms - flowAvg.lastPush_ms < interval_ms && flowAvg.count < UINT8_MAX) {
+        return;
+    }
+
+    // the average is taken at the mean time of its samples
+    const ftype scale = 1.0f / flowAvg.count;
+    ofDataNew.flowRadXY = flowAvg.flowRadXY * scale;
+    ofDataNew.bodyRadXYZ = flowAvg.bodyRadXYZ * scale;
+    ofDataNew.flowRadXYcomp.x = ofDataNew.flowRadXY.x + ofDataNew.bodyRadXYZ.x;
+    ofDataNew.flowRadXYcomp.y = ofDataNew.flowRadXY.y + ofDataNew.bodyRadXYZ.y;
+    ofDataNew.time_ms = flowAvg.firstTime_ms + flowAvg.timeSum_ms / flowAvg.count;
+    ofDataNew.noiseVarScale = scale;
+    storedOF.push(ofDataNew);
+
+    flowAvg.lastPush_ms = imuSampleTime_ms;
+    flowAvg.count = 0;
+}
 #endif  // EK3_FEATURE_OPTFLOW_FUSION
 
 
@@ -460,7 +509,8 @@ void NavEKF3_core::readIMUData(bool startPredictEnabled)
 
     // Rotate quaternon atitude from previous to new and normalise.
     // Accumulation using quaternions prevents introduction of coning errors due to downsampling
-    imuQuatDownSampleNew.rotate(imuDataNew.delAng);
+    // The rotation for the sample is calculated once per IMU by the DAL
+    imuQuatDownSampleNew *= ins.get_delta_angle_quat(imuDataNew.gyro_index);
     imuQuatDownSampleNew.normalize();
 
     // Rotate the latest delta velocity into body frame at the start of accumulation
@@ -935,6 +985,12 @@ void NavEKF3_core::readRngBcnData()
     // search through all the beacons for new data and if we find it stop searching and push the data into the observation buffer
     bool newDataPushed = false;
     uint8_t numRngBcnsChecked = 0;
+    // limit the rate measurements are fused at to bound the time the main filter spends on them.
+    // Beacons are still taken in turn so each gets a fair share of the fusions
+    if (frontend->_rngBcnFuseRate > 0 &&
+        (imuSampleTime_ms - rngBcn.lastPushTime_ms) < 1000U / uint32_t(frontend->_rngBcnFuseRate)) {
+        numRngBcnsChecked = rngBcn.N;
+    }
     // start the search one index up from where we left it last time
     uint8_t index = rngBcn.lastChecked;
     while (!newDataPushed && (numRngBcnsChecked < rngBcn.N)) {
@@ -973,6 +1029,7 @@ void NavEKF3_core::readRngBcnData()
 
             // update the last checked index
             rngBcn.lastChecked = index;
+            rngBcn.lastPushTime_ms = imuSampleTime_ms;
 
             // Save data into the buffer to be fused when the fusion time horizon catches up with it
             rngBcn.storedRange.push(rngBcnDataNew);
@@ -1512,9 +1569,9 @@ void NavEKF3_core::SampleDragData(const imu_elements &imu)
  */
 void NavEKF3_core::getEarthFieldTable(const Location &loc)
 {
-    table_earth_field_ga = AP_Declination::get_earth_field_ga(loc).toftype();
-    table_declination = radians(AP_Declination::get_declination(loc.lat*1.0e-7,
-                                                                loc.lng*1.0e-7));
+    float declination_deg;
+    table_earth_field_ga = table_field_cache.get_earth_field_ga(loc, declination_deg).toftype();
+    table_declination = radians(declination_deg);
     have_table_earth_field = true;
 }
 
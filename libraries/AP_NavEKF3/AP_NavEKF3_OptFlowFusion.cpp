@@ -30,6 +30,11 @@ void NavEKF3_core::SelectFlowFusion()
         optFlowFusionDelayed = false;
     }
 
+    // let another core use this update slot for flow fusion
+    if (deferFusion(FusionSlot::FLOW)) {
+        return;
+    }
+
     of_elements ofDataDelayed;      // OF data at the fusion time horizon
 
     // Check for data at the fusion time horizon
@@ -61,7 +66,7 @@ void NavEKF3_core::SelectFlowFusion()
     if (flowDataToFuse && tiltOK) {
         const bool fuse_optflow = (frontend->_flowUse == FLOW_USE_NAV) && frontend->sources.useVelXYSource(AP_NavEKF_Source::SourceXY::OPTFLOW, core_index);
         // Set the flow noise used by the fusion processes
-        R_LOS = sq(MAX(frontend->_flowNoise, 0.05f));
+        R_LOS = sq(MAX(frontend->_flowNoise, 0.05f)) * ofDataDelayed.noiseVarScale;
         // Fuse the optical flow X and Y axis data into the main filter sequentially
         FuseOptFlow(ofDataDelayed, fuse_optflow);
     }
@@ -201,7 +206,7 @@ void NavEKF3_core::EstimateTerrainOffset(const of_elements &ofDataDelayed)
             Popt = MAX(Popt,1E-6f);
 
             // calculate observation noise variance from parameter
-            ftype flow_noise_variance = sq(MAX(frontend->_flowNoise, 0.05f));
+            ftype flow_noise_variance = sq(MAX(frontend->_flowNoise, 0.05f)) * ofDataDelayed.noiseVarScale;
 
             // Fuse Y axis data
 
@@ -285,13 +290,13 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
     Vector2 losPred;
 
     // Copy required states to local variable names
-    ftype q0  = stateStruct.quat[0];
-    ftype q1 = stateStruct.quat[1];
-    ftype q2 = stateStruct.quat[2];
-    ftype q3 = stateStruct.quat[3];
-    ftype vn = stateStruct.velocity.x;
-    ftype ve = stateStruct.velocity.y;
-    ftype vd = stateStruct.velocity.z;
+    gtype q0  = stateStruct.quat[0];
+    gtype q1 = stateStruct.quat[1];
+    gtype q2 = stateStruct.quat[2];
+    gtype q3 = stateStruct.quat[3];
+    gtype vn = stateStruct.velocity.x;
+    gtype ve = stateStruct.velocity.y;
+    gtype vd = stateStruct.velocity.z;
     ftype pd = stateStruct.position.z;
 
     // constrain height above ground to be above range measured on ground
@@ -330,7 +335,7 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
         memset(&H_LOS[0], 0, sizeof(H_LOS));
         if (obsIndex == 0) {
             // calculate X axis observation Jacobian
-            ftype t2 = 1.0f / range;
+            gtype t2 = 1.0f / range;
             H_LOS[0] = t2*(q1*vd*2.0f+q0*ve*2.0f-q3*vn*2.0f);
             H_LOS[1] = t2*(q0*vd*2.0f-q1*ve*2.0f+q2*vn*2.0f);
             H_LOS[2] = t2*(q3*vd*2.0f+q2*ve*2.0f+q1*vn*2.0f);
@@ -340,98 +345,98 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             H_LOS[6] = t2*(q0*q1*2.0f+q2*q3*2.0f);
 
             // calculate intermediate variables for the X observation innovation variance and Kalman gains
-            ftype t3 = q1*vd*2.0f;
-            ftype t4 = q0*ve*2.0f;
-            ftype t11 = q3*vn*2.0f;
-            ftype t5 = t3+t4-t11;
-            ftype t6 = q0*q3*2.0f;
-            ftype t29 = q1*q2*2.0f;
-            ftype t7 = t6-t29;
-            ftype t8 = q0*q1*2.0f;
-            ftype t9 = q2*q3*2.0f;
-            ftype t10 = t8+t9;
-            ftype t12 = P[0][0]*t2*t5;
-            ftype t13 = q0*vd*2.0f;
-            ftype t14 = q2*vn*2.0f;
-            ftype t28 = q1*ve*2.0f;
-            ftype t15 = t13+t14-t28;
-            ftype t16 = q3*vd*2.0f;
-            ftype t17 = q2*ve*2.0f;
-            ftype t18 = q1*vn*2.0f;
-            ftype t19 = t16+t17+t18;
-            ftype t20 = q3*ve*2.0f;
-            ftype t21 = q0*vn*2.0f;
-            ftype t30 = q2*vd*2.0f;
-            ftype t22 = t20+t21-t30;
-            ftype t23 = q0*q0;
-            ftype t24 = q1*q1;
-            ftype t25 = q2*q2;
-            ftype t26 = q3*q3;
-            ftype t27 = t23-t24+t25-t26;
-            ftype t31 = P[1][1]*t2*t15;
-            ftype t32 = P[6][0]*t2*t10;
-            ftype t33 = P[1][0]*t2*t15;
-            ftype t34 = P[2][0]*t2*t19;
-            ftype t35 = P[5][0]*t2*t27;
-            ftype t79 = P[4][0]*t2*t7;
-            ftype t80 = P[3][0]*t2*t22;
-            ftype t36 = t12+t32+t33+t34+t35-t79-t80;
-            ftype t37 = t2*t5*t36;
-            ftype t38 = P[6][1]*t2*t10;
-            ftype t39 = P[0][1]*t2*t5;
-            ftype t40 = P[2][1]*t2*t19;
-            ftype t41 = P[5][1]*t2*t27;
-            ftype t81 = P[4][1]*t2*t7;
-            ftype t82 = P[3][1]*t2*t22;
-            ftype t42 = t31+t38+t39+t40+t41-t81-t82;
-            ftype t43 = t2*t15*t42;
-            ftype t44 = P[6][2]*t2*t10;
-            ftype t45 = P[0][2]*t2*t5;
-            ftype t46 = P[1][2]*t2*t15;
-            ftype t47 = P[2][2]*t2*t19;
-            ftype t48 = P[5][2]*t2*t27;
-            ftype t83 = P[4][2]*t2*t7;
-            ftype t84 = P[3][2]*t2*t22;
-            ftype t49 = t44+t45+t46+t47+t48-t83-t84;
-            ftype t50 = t2*t19*t49;
-            ftype t51 = P[6][3]*t2*t10;
-            ftype t52 = P[0][3]*t2*t5;
-            ftype t53 = P[1][3]*t2*t15;
-            ftype t54 = P[2][3]*t2*t19;
-            ftype t55 = P[5][3]*t2*t27;
-            ftype t85 = P[4][3]*t2*t7;
-            ftype t86 = P[3][3]*t2*t22;
-            ftype t56 = t51+t52+t53+t54+t55-t85-t86;
-            ftype t57 = P[6][5]*t2*t10;
-            ftype t58 = P[0][5]*t2*t5;
-            ftype t59 = P[1][5]*t2*t15;
-            ftype t60 = P[2][5]*t2*t19;
-            ftype t61 = P[5][5]*t2*t27;
-            ftype t88 = P[4][5]*t2*t7;
-            ftype t89 = P[3][5]*t2*t22;
-            ftype t62 = t57+t58+t59+t60+t61-t88-t89;
-            ftype t63 = t2*t27*t62;
-            ftype t64 = P[6][4]*t2*t10;
-            ftype t65 = P[0][4]*t2*t5;
-            ftype t66 = P[1][4]*t2*t15;
-            ftype t67 = P[2][4]*t2*t19;
-            ftype t68 = P[5][4]*t2*t27;
-            ftype t90 = P[4][4]*t2*t7;
-            ftype t91 = P[3][4]*t2*t22;
-            ftype t69 = t64+t65+t66+t67+t68-t90-t91;
-            ftype t70 = P[6][6]*t2*t10;
-            ftype t71 = P[0][6]*t2*t5;
-            ftype t72 = P[1][6]*t2*t15;
-            ftype t73 = P[2][6]*t2*t19;
-            ftype t74 = P[5][6]*t2*t27;
-            ftype t93 = P[4][6]*t2*t7;
-            ftype t94 = P[3][6]*t2*t22;
-            ftype t75 = t70+t71+t72+t73+t74-t93-t94;
-            ftype t76 = t2*t10*t75;
-            ftype t87 = t2*t22*t56;
-            ftype t92 = t2*t7*t69;
-            ftype t77 = R_LOS+t37+t43+t50+t63+t76-t87-t92;
-            ftype t78;
+            gtype t3 = q1*vd*2.0f;
+            gtype t4 = q0*ve*2.0f;
+            gtype t11 = q3*vn*2.0f;
+            gtype t5 = t3+t4-t11;
+            gtype t6 = q0*q3*2.0f;
+            gtype t29 = q1*q2*2.0f;
+            gtype t7 = t6-t29;
+            gtype t8 = q0*q1*2.0f;
+            gtype t9 = q2*q3*2.0f;
+            gtype t10 = t8+t9;
+            gtype t12 = Pg(0,0)*t2*t5;
+            gtype t13 = q0*vd*2.0f;
+            gtype t14 = q2*vn*2.0f;
+            gtype t28 = q1*ve*2.0f;
+            gtype t15 = t13+t14-t28;
+            gtype t16 = q3*vd*2.0f;
+            gtype t17 = q2*ve*2.0f;
+            gtype t18 = q1*vn*2.0f;
+            gtype t19 = t16+t17+t18;
+            gtype t20 = q3*ve*2.0f;
+            gtype t21 = q0*vn*2.0f;
+            gtype t30 = q2*vd*2.0f;
+            gtype t22 = t20+t21-t30;
+            gtype t23 = q0*q0;
+            gtype t24 = q1*q1;
+            gtype t25 = q2*q2;
+            gtype t26 = q3*q3;
+            gtype t27 = t23-t24+t25-t26;
+            gtype t31 = Pg(1,1)*t2*t15;
+            gtype t32 = Pg(6,0)*t2*t10;
+            gtype t33 = Pg(1,0)*t2*t15;
+            gtype t34 = Pg(2,0)*t2*t19;
+            gtype t35 = Pg(5,0)*t2*t27;
+            gtype t79 = Pg(4,0)*t2*t7;
+            gtype t80 = Pg(3,0)*t2*t22;
+            gtype t36 = t12+t32+t33+t34+t35-t79-t80;
+            gtype t37 = t2*t5*t36;
+            gtype t38 = Pg(6,1)*t2*t10;
+            gtype t39 = Pg(0,1)*t2*t5;
+            gtype t40 = Pg(2,1)*t2*t19;
+            gtype t41 = Pg(5,1)*t2*t27;
+            gtype t81 = Pg(4,1)*t2*t7;
+            gtype t82 = Pg(3,1)*t2*t22;
+            gtype t42 = t31+t38+t39+t40+t41-t81-t82;
+            gtype t43 = t2*t15*t42;
+            gtype t44 = Pg(6,2)*t2*t10;
+            gtype t45 = Pg(0,2)*t2*t5;
+            gtype t46 = Pg(1,2)*t2*t15;
+            gtype t47 = Pg(2,2)*t2*t19;
+            gtype t48 = Pg(5,2)*t2*t27;
+            gtype t83 = Pg(4,2)*t2*t7;
+            gtype t84 = Pg(3,2)*t2*t22;
+            gtype t49 = t44+t45+t46+t47+t48-t83-t84;
+            gtype t50 = t2*t19*t49;
+            gtype t51 = Pg(6,3)*t2*t10;
+            gtype t52 = Pg(0,3)*t2*t5;
+            gtype t53 = Pg(1,3)*t2*t15;
+            gtype t54 = Pg(2,3)*t2*t19;
+            gtype t55 = Pg(5,3)*t2*t27;
+            gtype t85 = Pg(4,3)*t2*t7;
+            gtype t86 = Pg(3,3)*t2*t22;
+            gtype t56 = t51+t52+t53+t54+t55-t85-t86;
+            gtype t57 = Pg(6,5)*t2*t10;
+            gtype t58 = Pg(0,5)*t2*t5;
+            gtype t59 = Pg(1,5)*t2*t15;
+            gtype t60 = Pg(2,5)*t2*t19;
+            gtype t61 = Pg(5,5)*t2*t27;
+            gtype t88 = Pg(4,5)*t2*t7;
+            gtype t89 = Pg(3,5)*t2*t22;
+            gtype t62 = t57+t58+t59+t60+t61-t88-t89;
+            gtype t63 = t2*t27*t62;
+            gtype t64 = Pg(6,4)*t2*t10;
+            gtype t65 = Pg(0,4)*t2*t5;
+            gtype t66 = Pg(1,4)*t2*t15;
+            gtype t67 = Pg(2,4)*t2*t19;
+            gtype t68 = Pg(5,4)*t2*t27;
+            gtype t90 = Pg(4,4)*t2*t7;
+            gtype t91 = Pg(3,4)*t2*t22;
+            gtype t69 = t64+t65+t66+t67+t68-t90-t91;
+            gtype t70 = Pg(6,6)*t2*t10;
+            gtype t71 = Pg(0,6)*t2*t5;
+            gtype t72 = Pg(1,6)*t2*t15;
+            gtype t73 = Pg(2,6)*t2*t19;
+            gtype t74 = Pg(5,6)*t2*t27;
+            gtype t93 = Pg(4,6)*t2*t7;
+            gtype t94 = Pg(3,6)*t2*t22;
+            gtype t75 = t70+t71+t72+t73+t74-t93-t94;
+            gtype t76 = t2*t10*t75;
+            gtype t87 = t2*t22*t56;
+            gtype t92 = t2*t7*t69;
+            gtype t77 = R_LOS+t37+t43+t50+t63+t76-t87-t92;
+            gtype t78;
 
             // calculate innovation variance for X axis observation and protect against a badly conditioned calculation
             if (t77 > R_LOS) {
@@ -450,21 +455,21 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             flowInnov[0] = losPred[0] - ofDataDelayed.flowRadXYcomp.x;
 
             // calculate Kalman gains for X-axis observation
-            Kfusion[0] = t78*(t12-P[0][4]*t2*t7+P[0][1]*t2*t15+P[0][6]*t2*t10+P[0][2]*t2*t19-P[0][3]*t2*t22+P[0][5]*t2*t27);
-            Kfusion[1] = t78*(t31+P[1][0]*t2*t5-P[1][4]*t2*t7+P[1][6]*t2*t10+P[1][2]*t2*t19-P[1][3]*t2*t22+P[1][5]*t2*t27);
-            Kfusion[2] = t78*(t47+P[2][0]*t2*t5-P[2][4]*t2*t7+P[2][1]*t2*t15+P[2][6]*t2*t10-P[2][3]*t2*t22+P[2][5]*t2*t27);
-            Kfusion[3] = t78*(-t86+P[3][0]*t2*t5-P[3][4]*t2*t7+P[3][1]*t2*t15+P[3][6]*t2*t10+P[3][2]*t2*t19+P[3][5]*t2*t27);
-            Kfusion[4] = t78*(-t90+P[4][0]*t2*t5+P[4][1]*t2*t15+P[4][6]*t2*t10+P[4][2]*t2*t19-P[4][3]*t2*t22+P[4][5]*t2*t27);
-            Kfusion[5] = t78*(t61+P[5][0]*t2*t5-P[5][4]*t2*t7+P[5][1]*t2*t15+P[5][6]*t2*t10+P[5][2]*t2*t19-P[5][3]*t2*t22);
-            Kfusion[6] = t78*(t70+P[6][0]*t2*t5-P[6][4]*t2*t7+P[6][1]*t2*t15+P[6][2]*t2*t19-P[6][3]*t2*t22+P[6][5]*t2*t27);
-            Kfusion[7] = t78*(P[7][0]*t2*t5-P[7][4]*t2*t7+P[7][1]*t2*t15+P[7][6]*t2*t10+P[7][2]*t2*t19-P[7][3]*t2*t22+P[7][5]*t2*t27);
-            Kfusion[8] = t78*(P[8][0]*t2*t5-P[8][4]*t2*t7+P[8][1]*t2*t15+P[8][6]*t2*t10+P[8][2]*t2*t19-P[8][3]*t2*t22+P[8][5]*t2*t27);
-            Kfusion[9] = t78*(P[9][0]*t2*t5-P[9][4]*t2*t7+P[9][1]*t2*t15+P[9][6]*t2*t10+P[9][2]*t2*t19-P[9][3]*t2*t22+P[9][5]*t2*t27);
+            Kfusion[0] = t78*(t12-Pg(0,4)*t2*t7+Pg(0,1)*t2*t15+Pg(0,6)*t2*t10+Pg(0,2)*t2*t19-Pg(0,3)*t2*t22+Pg(0,5)*t2*t27);
+            Kfusion[1] = t78*(t31+Pg(1,0)*t2*t5-Pg(1,4)*t2*t7+Pg(1,6)*t2*t10+Pg(1,2)*t2*t19-Pg(1,3)*t2*t22+Pg(1,5)*t2*t27);
+            Kfusion[2] = t78*(t47+Pg(2,0)*t2*t5-Pg(2,4)*t2*t7+Pg(2,1)*t2*t15+Pg(2,6)*t2*t10-Pg(2,3)*t2*t22+Pg(2,5)*t2*t27);
+            Kfusion[3] = t78*(-t86+Pg(3,0)*t2*t5-Pg(3,4)*t2*t7+Pg(3,1)*t2*t15+Pg(3,6)*t2*t10+Pg(3,2)*t2*t19+Pg(3,5)*t2*t27);
+            Kfusion[4] = t78*(-t90+Pg(4,0)*t2*t5+Pg(4,1)*t2*t15+Pg(4,6)*t2*t10+Pg(4,2)*t2*t19-Pg(4,3)*t2*t22+Pg(4,5)*t2*t27);
+            Kfusion[5] = t78*(t61+Pg(5,0)*t2*t5-Pg(5,4)*t2*t7+Pg(5,1)*t2*t15+Pg(5,6)*t2*t10+Pg(5,2)*t2*t19-Pg(5,3)*t2*t22);
+            Kfusion[6] = t78*(t70+Pg(6,0)*t2*t5-Pg(6,4)*t2*t7+Pg(6,1)*t2*t15+Pg(6,2)*t2*t19-Pg(6,3)*t2*t22+Pg(6,5)*t2*t27);
+            Kfusion[7] = t78*(Pg(7,0)*t2*t5-Pg(7,4)*t2*t7+Pg(7,1)*t2*t15+Pg(7,6)*t2*t10+Pg(7,2)*t2*t19-Pg(7,3)*t2*t22+Pg(7,5)*t2*t27);
+            Kfusion[8] = t78*(Pg(8,0)*t2*t5-Pg(8,4)*t2*t7+Pg(8,1)*t2*t15+Pg(8,6)*t2*t10+Pg(8,2)*t2*t19-Pg(8,3)*t2*t22+Pg(8,5)*t2*t27);
+            Kfusion[9] = t78*(Pg(9,0)*t2*t5-Pg(9,4)*t2*t7+Pg(9,1)*t2*t15+Pg(9,6)*t2*t10+Pg(9,2)*t2*t19-Pg(9,3)*t2*t22+Pg(9,5)*t2*t27);
 
             if (!inhibitDelAngBiasStates) {
-                Kfusion[10] = t78*(P[10][0]*t2*t5-P[10][4]*t2*t7+P[10][1]*t2*t15+P[10][6]*t2*t10+P[10][2]*t2*t19-P[10][3]*t2*t22+P[10][5]*t2*t27);
-                Kfusion[11] = t78*(P[11][0]*t2*t5-P[11][4]*t2*t7+P[11][1]*t2*t15+P[11][6]*t2*t10+P[11][2]*t2*t19-P[11][3]*t2*t22+P[11][5]*t2*t27);
-                Kfusion[12] = t78*(P[12][0]*t2*t5-P[12][4]*t2*t7+P[12][1]*t2*t15+P[12][6]*t2*t10+P[12][2]*t2*t19-P[12][3]*t2*t22+P[12][5]*t2*t27);
+                Kfusion[10] = t78*(Pg(10,0)*t2*t5-Pg(10,4)*t2*t7+Pg(10,1)*t2*t15+Pg(10,6)*t2*t10+Pg(10,2)*t2*t19-Pg(10,3)*t2*t22+Pg(10,5)*t2*t27);
+                Kfusion[11] = t78*(Pg(11,0)*t2*t5-Pg(11,4)*t2*t7+Pg(11,1)*t2*t15+Pg(11,6)*t2*t10+Pg(11,2)*t2*t19-Pg(11,3)*t2*t22+Pg(11,5)*t2*t27);
+                Kfusion[12] = t78*(Pg(12,0)*t2*t5-Pg(12,4)*t2*t7+Pg(12,1)*t2*t15+Pg(12,6)*t2*t10+Pg(12,2)*t2*t19-Pg(12,3)*t2*t22+Pg(12,5)*t2*t27);
             } else {
                 // zero indexes 10 to 12
                 zero_range(&Kfusion[0], 10, 12);
@@ -474,7 +479,7 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
                 for (uint8_t index = 0; index < 3; index++) {
                     const uint8_t stateIndex = index + 13;
                     if (!dvelBiasAxisInhibit[index]) {
-                        Kfusion[stateIndex] = t78*(P[stateIndex][0]*t2*t5-P[stateIndex][4]*t2*t7+P[stateIndex][1]*t2*t15+P[stateIndex][6]*t2*t10+P[stateIndex][2]*t2*t19-P[stateIndex][3]*t2*t22+P[stateIndex][5]*t2*t27);
+                        Kfusion[stateIndex] = t78*(Pg(stateIndex,0)*t2*t5-Pg(stateIndex,4)*t2*t7+Pg(stateIndex,1)*t2*t15+Pg(stateIndex,6)*t2*t10+Pg(stateIndex,2)*t2*t19-Pg(stateIndex,3)*t2*t22+Pg(stateIndex,5)*t2*t27);
                     } else {
                         Kfusion[stateIndex] = 0.0f;
                     }
@@ -485,20 +490,20 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             }
 
             if (!inhibitMagStates) {
-                Kfusion[16] = t78*(P[16][0]*t2*t5-P[16][4]*t2*t7+P[16][1]*t2*t15+P[16][6]*t2*t10+P[16][2]*t2*t19-P[16][3]*t2*t22+P[16][5]*t2*t27);
-                Kfusion[17] = t78*(P[17][0]*t2*t5-P[17][4]*t2*t7+P[17][1]*t2*t15+P[17][6]*t2*t10+P[17][2]*t2*t19-P[17][3]*t2*t22+P[17][5]*t2*t27);
-                Kfusion[18] = t78*(P[18][0]*t2*t5-P[18][4]*t2*t7+P[18][1]*t2*t15+P[18][6]*t2*t10+P[18][2]*t2*t19-P[18][3]*t2*t22+P[18][5]*t2*t27);
-                Kfusion[19] = t78*(P[19][0]*t2*t5-P[19][4]*t2*t7+P[19][1]*t2*t15+P[19][6]*t2*t10+P[19][2]*t2*t19-P[19][3]*t2*t22+P[19][5]*t2*t27);
-                Kfusion[20] = t78*(P[20][0]*t2*t5-P[20][4]*t2*t7+P[20][1]*t2*t15+P[20][6]*t2*t10+P[20][2]*t2*t19-P[20][3]*t2*t22+P[20][5]*t2*t27);
-                Kfusion[21] = t78*(P[21][0]*t2*t5-P[21][4]*t2*t7+P[21][1]*t2*t15+P[21][6]*t2*t10+P[21][2]*t2*t19-P[21][3]*t2*t22+P[21][5]*t2*t27);
+                Kfusion[16] = t78*(Pg(16,0)*t2*t5-Pg(16,4)*t2*t7+Pg(16,1)*t2*t15+Pg(16,6)*t2*t10+Pg(16,2)*t2*t19-Pg(16,3)*t2*t22+Pg(16,5)*t2*t27);
+                Kfusion[17] = t78*(Pg(17,0)*t2*t5-Pg(17,4)*t2*t7+Pg(17,1)*t2*t15+Pg(17,6)*t2*t10+Pg(17,2)*t2*t19-Pg(17,3)*t2*t22+Pg(17,5)*t2*t27);
+                Kfusion[18] = t78*(Pg(18,0)*t2*t5-Pg(18,4)*t2*t7+Pg(18,1)*t2*t15+Pg(18,6)*t2*t10+Pg(18,2)*t2*t19-Pg(18,3)*t2*t22+Pg(18,5)*t2*t27);
+                Kfusion[19] = t78*(Pg(19,0)*t2*t5-Pg(19,4)*t2*t7+Pg(19,1)*t2*t15+Pg(19,6)*t2*t10+Pg(19,2)*t2*t19-Pg(19,3)*t2*t22+Pg(19,5)*t2*t27);
+                Kfusion[20] = t78*(Pg(20,0)*t2*t5-Pg(20,4)*t2*t7+Pg(20,1)*t2*t15+Pg(20,6)*t2*t10+Pg(20,2)*t2*t19-Pg(20,3)*t2*t22+Pg(20,5)*t2*t27);
+                Kfusion[21] = t78*(Pg(21,0)*t2*t5-Pg(21,4)*t2*t7+Pg(21,1)*t2*t15+Pg(21,6)*t2*t10+Pg(21,2)*t2*t19-Pg(21,3)*t2*t22+Pg(21,5)*t2*t27);
             } else {
                 // zero indexes 16 to 21
                 zero_range(&Kfusion[0], 16, 21);
             }
 
             if (!inhibitWindStates && !treatWindStatesAsTruth) {
-                Kfusion[22] = t78*(P[22][0]*t2*t5-P[22][4]*t2*t7+P[22][1]*t2*t15+P[22][6]*t2*t10+P[22][2]*t2*t19-P[22][3]*t2*t22+P[22][5]*t2*t27);
-                Kfusion[23] = t78*(P[23][0]*t2*t5-P[23][4]*t2*t7+P[23][1]*t2*t15+P[23][6]*t2*t10+P[23][2]*t2*t19-P[23][3]*t2*t22+P[23][5]*t2*t27);
+                Kfusion[22] = t78*(Pg(22,0)*t2*t5-Pg(22,4)*t2*t7+Pg(22,1)*t2*t15+Pg(22,6)*t2*t10+Pg(22,2)*t2*t19-Pg(22,3)*t2*t22+Pg(22,5)*t2*t27);
+                Kfusion[23] = t78*(Pg(23,0)*t2*t5-Pg(23,4)*t2*t7+Pg(23,1)*t2*t15+Pg(23,6)*t2*t10+Pg(23,2)*t2*t19-Pg(23,3)*t2*t22+Pg(23,5)*t2*t27);
             } else {
                 // zero indexes 22 to 23
                 zero_range(&Kfusion[0], 22, 23);
@@ -507,7 +512,7 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
         } else {
 
             // calculate Y axis observation Jacobian
-            ftype t2 = 1.0f / range;
+            gtype t2 = 1.0f / range;
             H_LOS[0] = -t2*(q2*vd*-2.0f+q3*ve*2.0f+q0*vn*2.0f);
             H_LOS[1] = -t2*(q3*vd*2.0f+q2*ve*2.0f+q1*vn*2.0f);
             H_LOS[2] = t2*(q0*vd*2.0f-q1*ve*2.0f+q2*vn*2.0f);
@@ -517,98 +522,98 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             H_LOS[6] = t2*(q0*q2*2.0f-q1*q3*2.0f);
 
             // calculate intermediate variables for the Y observation innovation variance and Kalman gains
-            ftype t3 = q3*ve*2.0f;
-            ftype t4 = q0*vn*2.0f;
-            ftype t11 = q2*vd*2.0f;
-            ftype t5 = t3+t4-t11;
-            ftype t6 = q0*q3*2.0f;
-            ftype t7 = q1*q2*2.0f;
-            ftype t8 = t6+t7;
-            ftype t9 = q0*q2*2.0f;
-            ftype t28 = q1*q3*2.0f;
-            ftype t10 = t9-t28;
-            ftype t12 = P[0][0]*t2*t5;
-            ftype t13 = q3*vd*2.0f;
-            ftype t14 = q2*ve*2.0f;
-            ftype t15 = q1*vn*2.0f;
-            ftype t16 = t13+t14+t15;
-            ftype t17 = q0*vd*2.0f;
-            ftype t18 = q2*vn*2.0f;
-            ftype t29 = q1*ve*2.0f;
-            ftype t19 = t17+t18-t29;
-            ftype t20 = q1*vd*2.0f;
-            ftype t21 = q0*ve*2.0f;
-            ftype t30 = q3*vn*2.0f;
-            ftype t22 = t20+t21-t30;
-            ftype t23 = q0*q0;
-            ftype t24 = q1*q1;
-            ftype t25 = q2*q2;
-            ftype t26 = q3*q3;
-            ftype t27 = t23+t24-t25-t26;
-            ftype t31 = P[1][1]*t2*t16;
-            ftype t32 = P[5][0]*t2*t8;
-            ftype t33 = P[1][0]*t2*t16;
-            ftype t34 = P[3][0]*t2*t22;
-            ftype t35 = P[4][0]*t2*t27;
-            ftype t80 = P[6][0]*t2*t10;
-            ftype t81 = P[2][0]*t2*t19;
-            ftype t36 = t12+t32+t33+t34+t35-t80-t81;
-            ftype t37 = t2*t5*t36;
-            ftype t38 = P[5][1]*t2*t8;
-            ftype t39 = P[0][1]*t2*t5;
-            ftype t40 = P[3][1]*t2*t22;
-            ftype t41 = P[4][1]*t2*t27;
-            ftype t82 = P[6][1]*t2*t10;
-            ftype t83 = P[2][1]*t2*t19;
-            ftype t42 = t31+t38+t39+t40+t41-t82-t83;
-            ftype t43 = t2*t16*t42;
-            ftype t44 = P[5][2]*t2*t8;
-            ftype t45 = P[0][2]*t2*t5;
-            ftype t46 = P[1][2]*t2*t16;
-            ftype t47 = P[3][2]*t2*t22;
-            ftype t48 = P[4][2]*t2*t27;
-            ftype t79 = P[2][2]*t2*t19;
-            ftype t84 = P[6][2]*t2*t10;
-            ftype t49 = t44+t45+t46+t47+t48-t79-t84;
-            ftype t50 = P[5][3]*t2*t8;
-            ftype t51 = P[0][3]*t2*t5;
-            ftype t52 = P[1][3]*t2*t16;
-            ftype t53 = P[3][3]*t2*t22;
-            ftype t54 = P[4][3]*t2*t27;
-            ftype t86 = P[6][3]*t2*t10;
-            ftype t87 = P[2][3]*t2*t19;
-            ftype t55 = t50+t51+t52+t53+t54-t86-t87;
-            ftype t56 = t2*t22*t55;
-            ftype t57 = P[5][4]*t2*t8;
-            ftype t58 = P[0][4]*t2*t5;
-            ftype t59 = P[1][4]*t2*t16;
-            ftype t60 = P[3][4]*t2*t22;
-            ftype t61 = P[4][4]*t2*t27;
-            ftype t88 = P[6][4]*t2*t10;
-            ftype t89 = P[2][4]*t2*t19;
-            ftype t62 = t57+t58+t59+t60+t61-t88-t89;
-            ftype t63 = t2*t27*t62;
-            ftype t64 = P[5][5]*t2*t8;
-            ftype t65 = P[0][5]*t2*t5;
-            ftype t66 = P[1][5]*t2*t16;
-            ftype t67 = P[3][5]*t2*t22;
-            ftype t68 = P[4][5]*t2*t27;
-            ftype t90 = P[6][5]*t2*t10;
-            ftype t91 = P[2][5]*t2*t19;
-            ftype t69 = t64+t65+t66+t67+t68-t90-t91;
-            ftype t70 = t2*t8*t69;
-            ftype t71 = P[5][6]*t2*t8;
-            ftype t72 = P[0][6]*t2*t5;
-            ftype t73 = P[1][6]*t2*t16;
-            ftype t74 = P[3][6]*t2*t22;
-            ftype t75 = P[4][6]*t2*t27;
-            ftype t92 = P[6][6]*t2*t10;
-            ftype t93 = P[2][6]*t2*t19;
-            ftype t76 = t71+t72+t73+t74+t75-t92-t93;
-            ftype t85 = t2*t19*t49;
-            ftype t94 = t2*t10*t76;
-            ftype t77 = R_LOS+t37+t43+t56+t63+t70-t85-t94;
-            ftype t78;
+            gtype t3 = q3*ve*2.0f;
+            gtype t4 = q0*vn*2.0f;
+            gtype t11 = q2*vd*2.0f;
+            gtype t5 = t3+t4-t11;
+            gtype t6 = q0*q3*2.0f;
+            gtype t7 = q1*q2*2.0f;
+            gtype t8 = t6+t7;
+            gtype t9 = q0*q2*2.0f;
+            gtype t28 = q1*q3*2.0f;
+            gtype t10 = t9-t28;
+            gtype t12 = Pg(0,0)*t2*t5;
+            gtype t13 = q3*vd*2.0f;
+            gtype t14 = q2*ve*2.0f;
+            gtype t15 = q1*vn*2.0f;
+            gtype t16 = t13+t14+t15;
+            gtype t17 = q0*vd*2.0f;
+            gtype t18 = q2*vn*2.0f;
+            gtype t29 = q1*ve*2.0f;
+            gtype t19 = t17+t18-t29;
+            gtype t20 = q1*vd*2.0f;
+            gtype t21 = q0*ve*2.0f;
+            gtype t30 = q3*vn*2.0f;
+            gtype t22 = t20+t21-t30;
+            gtype t23 = q0*q0;
+            gtype t24 = q1*q1;
+            gtype t25 = q2*q2;
+            gtype t26 = q3*q3;
+            gtype t27 = t23+t24-t25-t26;
+            gtype t31 = Pg(1,1)*t2*t16;
+            gtype t32 = Pg(5,0)*t2*t8;
+            gtype t33 = Pg(1,0)*t2*t16;
+            gtype t34 = Pg(3,0)*t2*t22;
+            gtype t35 = Pg(4,0)*t2*t27;
+            gtype t80 = Pg(6,0)*t2*t10;
+            gtype t81 = Pg(2,0)*t2*t19;
+            gtype t36 = t12+t32+t33+t34+t35-t80-t81;
+            gtype t37 = t2*t5*t36;
+            gtype t38 = Pg(5,1)*t2*t8;
+            gtype t39 = Pg(0,1)*t2*t5;
+            gtype t40 = Pg(3,1)*t2*t22;
+            gtype t41 = Pg(4,1)*t2*t27;
+            gtype t82 = Pg(6,1)*t2*t10;
+            gtype t83 = Pg(2,1)*t2*t19;
+            gtype t42 = t31+t38+t39+t40+t41-t82-t83;
+            gtype t43 = t2*t16*t42;
+            gtype t44 = Pg(5,2)*t2*t8;
+            gtype t45 = Pg(0,2)*t2*t5;
+            gtype t46 = Pg(1,2)*t2*t16;
+            gtype t47 = Pg(3,2)*t2*t22;
+            gtype t48 = Pg(4,2)*t2*t27;
+            gtype t79 = Pg(2,2)*t2*t19;
+            gtype t84 = Pg(6,2)*t2*t10;
+            gtype t49 = t44+t45+t46+t47+t48-t79-t84;
+            gtype t50 = Pg(5,3)*t2*t8;
+            gtype t51 = Pg(0,3)*t2*t5;
+            gtype t52 = Pg(1,3)*t2*t16;
+            gtype t53 = Pg(3,3)*t2*t22;
+            gtype t54 = Pg(4,3)*t2*t27;
+            gtype t86 = Pg(6,3)*t2*t10;
+            gtype t87 = Pg(2,3)*t2*t19;
+            gtype t55 = t50+t51+t52+t53+t54-t86-t87;
+            gtype t56 = t2*t22*t55;
+            gtype t57 = Pg(5,4)*t2*t8;
+            gtype t58 = Pg(0,4)*t2*t5;
+            gtype t59 = Pg(1,4)*t2*t16;
+            gtype t60 = Pg(3,4)*t2*t22;
+            gtype t61 = Pg(4,4)*t2*t27;
+            gtype t88 = Pg(6,4)*t2*t10;
+            gtype t89 = Pg(2,4)*t2*t19;
+            gtype t62 = t57+t58+t59+t60+t61-t88-t89;
+            gtype t63 = t2*t27*t62;
+            gtype t64 = Pg(5,5)*t2*t8;
+            gtype t65 = Pg(0,5)*t2*t5;
+            gtype t66 = Pg(1,5)*t2*t16;
+            gtype t67 = Pg(3,5)*t2*t22;
+            gtype t68 = Pg(4,5)*t2*t27;
+            gtype t90 = Pg(6,5)*t2*t10;
+            gtype t91 = Pg(2,5)*t2*t19;
+            gtype t69 = t64+t65+t66+t67+t68-t90-t91;
+            gtype t70 = t2*t8*t69;
+            gtype t71 = Pg(5,6)*t2*t8;
+            gtype t72 = Pg(0,6)*t2*t5;
+            gtype t73 = Pg(1,6)*t2*t16;
+            gtype t74 = Pg(3,6)*t2*t22;
+            gtype t75 = Pg(4,6)*t2*t27;
+            gtype t92 = Pg(6,6)*t2*t10;
+            gtype t93 = Pg(2,6)*t2*t19;
+            gtype t76 = t71+t72+t73+t74+t75-t92-t93;
+            gtype t85 = t2*t19*t49;
+            gtype t94 = t2*t10*t76;
+            gtype t77 = R_LOS+t37+t43+t56+t63+t70-t85-t94;
+            gtype t78;
 
             // calculate innovation variance for Y axis observation and protect against a badly conditioned calculation
             if (t77 > R_LOS) {
@@ -627,21 +632,21 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             flowInnovTime_ms = dal.millis();
 
             // calculate Kalman gains for the Y-axis observation
-            Kfusion[0] = -t78*(t12+P[0][5]*t2*t8-P[0][6]*t2*t10+P[0][1]*t2*t16-P[0][2]*t2*t19+P[0][3]*t2*t22+P[0][4]*t2*t27);
-            Kfusion[1] = -t78*(t31+P[1][0]*t2*t5+P[1][5]*t2*t8-P[1][6]*t2*t10-P[1][2]*t2*t19+P[1][3]*t2*t22+P[1][4]*t2*t27);
-            Kfusion[2] = -t78*(-t79+P[2][0]*t2*t5+P[2][5]*t2*t8-P[2][6]*t2*t10+P[2][1]*t2*t16+P[2][3]*t2*t22+P[2][4]*t2*t27);
-            Kfusion[3] = -t78*(t53+P[3][0]*t2*t5+P[3][5]*t2*t8-P[3][6]*t2*t10+P[3][1]*t2*t16-P[3][2]*t2*t19+P[3][4]*t2*t27);
-            Kfusion[4] = -t78*(t61+P[4][0]*t2*t5+P[4][5]*t2*t8-P[4][6]*t2*t10+P[4][1]*t2*t16-P[4][2]*t2*t19+P[4][3]*t2*t22);
-            Kfusion[5] = -t78*(t64+P[5][0]*t2*t5-P[5][6]*t2*t10+P[5][1]*t2*t16-P[5][2]*t2*t19+P[5][3]*t2*t22+P[5][4]*t2*t27);
-            Kfusion[6] = -t78*(-t92+P[6][0]*t2*t5+P[6][5]*t2*t8+P[6][1]*t2*t16-P[6][2]*t2*t19+P[6][3]*t2*t22+P[6][4]*t2*t27);
-            Kfusion[7] = -t78*(P[7][0]*t2*t5+P[7][5]*t2*t8-P[7][6]*t2*t10+P[7][1]*t2*t16-P[7][2]*t2*t19+P[7][3]*t2*t22+P[7][4]*t2*t27);
-            Kfusion[8] = -t78*(P[8][0]*t2*t5+P[8][5]*t2*t8-P[8][6]*t2*t10+P[8][1]*t2*t16-P[8][2]*t2*t19+P[8][3]*t2*t22+P[8][4]*t2*t27);
-            Kfusion[9] = -t78*(P[9][0]*t2*t5+P[9][5]*t2*t8-P[9][6]*t2*t10+P[9][1]*t2*t16-P[9][2]*t2*t19+P[9][3]*t2*t22+P[9][4]*t2*t27);
+            Kfusion[0] = -t78*(t12+Pg(0,5)*t2*t8-Pg(0,6)*t2*t10+Pg(0,1)*t2*t16-Pg(0,2)*t2*t19+Pg(0,3)*t2*t22+Pg(0,4)*t2*t27);
+            Kfusion[1] = -t78*(t31+Pg(1,0)*t2*t5+Pg(1,5)*t2*t8-Pg(1,6)*t2*t10-Pg(1,2)*t2*t19+Pg(1,3)*t2*t22+Pg(1,4)*t2*t27);
+            Kfusion[2] = -t78*(-t79+Pg(2,0)*t2*t5+Pg(2,5)*t2*t8-Pg(2,6)*t2*t10+Pg(2,1)*t2*t16+Pg(2,3)*t2*t22+Pg(2,4)*t2*t27);
+            Kfusion[3] = -t78*(t53+Pg(3,0)*t2*t5+Pg(3,5)*t2*t8-Pg(3,6)*t2*t10+Pg(3,1)*t2*t16-Pg(3,2)*t2*t19+Pg(3,4)*t2*t27);
+            Kfusion[4] = -t78*(t61+Pg(4,0)*t2*t5+Pg(4,5)*t2*t8-Pg(4,6)*t2*t10+Pg(4,1)*t2*t16-Pg(4,2)*t2*t19+Pg(4,3)*t2*t22);
+            Kfusion[5] = -t78*(t64+Pg(5,0)*t2*t5-Pg(5,6)*t2*t10+Pg(5,1)*t2*t16-Pg(5,2)*t2*t19+Pg(5,3)*t2*t22+Pg(5,4)*t2*t27);
+            Kfusion[6] = -t78*(-t92+Pg(6,0)*t2*t5+Pg(6,5)*t2*t8+Pg(6,1)*t2*t16-Pg(6,2)*t2*t19+Pg(6,3)*t2*t22+Pg(6,4)*t2*t27);
+            Kfusion[7] = -t78*(Pg(7,0)*t2*t5+Pg(7,5)*t2*t8-Pg(7,6)*t2*t10+Pg(7,1)*t2*t16-Pg(7,2)*t2*t19+Pg(7,3)*t2*t22+Pg(7,4)*t2*t27);
+            Kfusion[8] = -t78*(Pg(8,0)*t2*t5+Pg(8,5)*t2*t8-Pg(8,6)*t2*t10+Pg(8,1)*t2*t16-Pg(8,2)*t2*t19+Pg(8,3)*t2*t22+Pg(8,4)*t2*t27);
+            Kfusion[9] = -t78*(Pg(9,0)*t2*t5+Pg(9,5)*t2*t8-Pg(9,6)*t2*t10+Pg(9,1)*t2*t16-Pg(9,2)*t2*t19+Pg(9,3)*t2*t22+Pg(9,4)*t2*t27);
 
             if (!inhibitDelAngBiasStates) {
-                Kfusion[10] = -t78*(P[10][0]*t2*t5+P[10][5]*t2*t8-P[10][6]*t2*t10+P[10][1]*t2*t16-P[10][2]*t2*t19+P[10][3]*t2*t22+P[10][4]*t2*t27);
-                Kfusion[11] = -t78*(P[11][0]*t2*t5+P[11][5]*t2*t8-P[11][6]*t2*t10+P[11][1]*t2*t16-P[11][2]*t2*t19+P[11][3]*t2*t22+P[11][4]*t2*t27);
-                Kfusion[12] = -t78*(P[12][0]*t2*t5+P[12][5]*t2*t8-P[12][6]*t2*t10+P[12][1]*t2*t16-P[12][2]*t2*t19+P[12][3]*t2*t22+P[12][4]*t2*t27);
+                Kfusion[10] = -t78*(Pg(10,0)*t2*t5+Pg(10,5)*t2*t8-Pg(10,6)*t2*t10+Pg(10,1)*t2*t16-Pg(10,2)*t2*t19+Pg(10,3)*t2*t22+Pg(10,4)*t2*t27);
+                Kfusion[11] = -t78*(Pg(11,0)*t2*t5+Pg(11,5)*t2*t8-Pg(11,6)*t2*t10+Pg(11,1)*t2*t16-Pg(11,2)*t2*t19+Pg(11,3)*t2*t22+Pg(11,4)*t2*t27);
+                Kfusion[12] = -t78*(Pg(12,0)*t2*t5+Pg(12,5)*t2*t8-Pg(12,6)*t2*t10+Pg(12,1)*t2*t16-Pg(12,2)*t2*t19+Pg(12,3)*t2*t22+Pg(12,4)*t2*t27);
             } else {
                 // zero indexes 10 to 12
                 zero_range(&Kfusion[0], 10, 12);
@@ -651,7 +656,7 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
                 for (uint8_t index = 0; index < 3; index++) {
                     const uint8_t stateIndex = index + 13;
                     if (!dvelBiasAxisInhibit[index]) {
-                        Kfusion[stateIndex] = -t78*(P[stateIndex][0]*t2*t5+P[stateIndex][5]*t2*t8-P[stateIndex][6]*t2*t10+P[stateIndex][1]*t2*t16-P[stateIndex][2]*t2*t19+P[stateIndex][3]*t2*t22+P[stateIndex][4]*t2*t27);
+                        Kfusion[stateIndex] = -t78*(Pg(stateIndex,0)*t2*t5+Pg(stateIndex,5)*t2*t8-Pg(stateIndex,6)*t2*t10+Pg(stateIndex,1)*t2*t16-Pg(stateIndex,2)*t2*t19+Pg(stateIndex,3)*t2*t22+Pg(stateIndex,4)*t2*t27);
                     } else {
                         Kfusion[stateIndex] = 0.0f;
                     }
@@ -662,20 +667,20 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             }
 
             if (!inhibitMagStates) {
-                Kfusion[16] = -t78*(P[16][0]*t2*t5+P[16][5]*t2*t8-P[16][6]*t2*t10+P[16][1]*t2*t16-P[16][2]*t2*t19+P[16][3]*t2*t22+P[16][4]*t2*t27);
-                Kfusion[17] = -t78*(P[17][0]*t2*t5+P[17][5]*t2*t8-P[17][6]*t2*t10+P[17][1]*t2*t16-P[17][2]*t2*t19+P[17][3]*t2*t22+P[17][4]*t2*t27);
-                Kfusion[18] = -t78*(P[18][0]*t2*t5+P[18][5]*t2*t8-P[18][6]*t2*t10+P[18][1]*t2*t16-P[18][2]*t2*t19+P[18][3]*t2*t22+P[18][4]*t2*t27);
-                Kfusion[19] = -t78*(P[19][0]*t2*t5+P[19][5]*t2*t8-P[19][6]*t2*t10+P[19][1]*t2*t16-P[19][2]*t2*t19+P[19][3]*t2*t22+P[19][4]*t2*t27);
-                Kfusion[20] = -t78*(P[20][0]*t2*t5+P[20][5]*t2*t8-P[20][6]*t2*t10+P[20][1]*t2*t16-P[20][2]*t2*t19+P[20][3]*t2*t22+P[20][4]*t2*t27);
-                Kfusion[21] = -t78*(P[21][0]*t2*t5+P[21][5]*t2*t8-P[21][6]*t2*t10+P[21][1]*t2*t16-P[21][2]*t2*t19+P[21][3]*t2*t22+P[21][4]*t2*t27);
+                Kfusion[16] = -t78*(Pg(16,0)*t2*t5+Pg(16,5)*t2*t8-Pg(16,6)*t2*t10+Pg(16,1)*t2*t16-Pg(16,2)*t2*t19+Pg(16,3)*t2*t22+Pg(16,4)*t2*t27);
+                Kfusion[17] = -t78*(Pg(17,0)*t2*t5+Pg(17,5)*t2*t8-Pg(17,6)*t2*t10+Pg(17,1)*t2*t16-Pg(17,2)*t2*t19+Pg(17,3)*t2*t22+Pg(17,4)*t2*t27);
+                Kfusion[18] = -t78*(Pg(18,0)*t2*t5+Pg(18,5)*t2*t8-Pg(18,6)*t2*t10+Pg(18,1)*t2*t16-Pg(18,2)*t2*t19+Pg(18,3)*t2*t22+Pg(18,4)*t2*t27);
+                Kfusion[19] = -t78*(Pg(19,0)*t2*t5+Pg(19,5)*t2*t8-Pg(19,6)*t2*t10+Pg(19,1)*t2*t16-Pg(19,2)*t2*t19+Pg(19,3)*t2*t22+Pg(19,4)*t2*t27);
+                Kfusion[20] = -t78*(Pg(20,0)*t2*t5+Pg(20,5)*t2*t8-Pg(20,6)*t2*t10+Pg(20,1)*t2*t16-Pg(20,2)*t2*t19+Pg(20,3)*t2*t22+Pg(20,4)*t2*t27);
+                Kfusion[21] = -t78*(Pg(21,0)*t2*t5+Pg(21,5)*t2*t8-Pg(21,6)*t2*t10+Pg(21,1)*t2*t16-Pg(21,2)*t2*t19+Pg(21,3)*t2*t22+Pg(21,4)*t2*t27);
             } else {
                 // zero indexes 16 to 21
                 zero_range(&Kfusion[0], 16, 21);
             }
 
             if (!inhibitWindStates && !treatWindStatesAsTruth) {
-                Kfusion[22] = -t78*(P[22][0]*t2*t5+P[22][5]*t2*t8-P[22][6]*t2*t10+P[22][1]*t2*t16-P[22][2]*t2*t19+P[22][3]*t2*t22+P[22][4]*t2*t27);
-                Kfusion[23] = -t78*(P[23][0]*t2*t5+P[23][5]*t2*t8-P[23][6]*t2*t10+P[23][1]*t2*t16-P[23][2]*t2*t19+P[23][3]*t2*t22+P[23][4]*t2*t27);
+                Kfusion[22] = -t78*(Pg(22,0)*t2*t5+Pg(22,5)*t2*t8-Pg(22,6)*t2*t10+Pg(22,1)*t2*t16-Pg(22,2)*t2*t19+Pg(22,3)*t2*t22+Pg(22,4)*t2*t27);
+                Kfusion[23] = -t78*(Pg(23,0)*t2*t5+Pg(23,5)*t2*t8-Pg(23,6)*t2*t10+Pg(23,1)*t2*t16-Pg(23,2)*t2*t19+Pg(23,3)*t2*t22+Pg(23,4)*t2*t27);
             } else {
                 // zero indexes 22 to 23
                 zero_range(&Kfusion[0], 22, 23);
@@ -730,8 +735,8 @@ void NavEKF3_core::FuseOptFlow(const of_elements &ofDataDelayed, bool really_fus
             if (healthyFusion) {
                 // update the covariance matrix
                 for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                    for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                        P[i][j] = P[i][j] - KHP[i][j];
+                    for (uint8_t j= i; j<=stateIndexLim; j++) {
+                        P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
                     }
                 }
 
@@ -73,10 +73,8 @@ void NavEKF3_core::ResetVelocity(resetDataSource velResetSource)
         velTimeout = false;
         lastVelPassTime_ms = imuSampleTime_ms;
     }
-    for (uint8_t i=0; i<imu_buffer_length; i++) {
-        storedOutput[i].velocity.x = stateStruct.velocity.x;
-        storedOutput[i].velocity.y = stateStruct.velocity.y;
-    }
+    storedOutput.fill_velocity(0, stateStruct.velocity.x);
+    storedOutput.fill_velocity(1, stateStruct.velocity.y);
     outputDataNew.velocity.x = stateStruct.velocity.x;
     outputDataNew.velocity.y = stateStruct.velocity.y;
     outputDataDelayed.velocity.x = stateStruct.velocity.x;
@@ -163,10 +161,8 @@ void NavEKF3_core::ResetPosition(resetDataSource posResetSource)
 #endif // EK3_FEATURE_EXTERNAL_NAV
         }
     }
-    for (uint8_t i=0; i<imu_buffer_length; i++) {
-        storedOutput[i].position.x = stateStruct.position.x;
-        storedOutput[i].position.y = stateStruct.position.y;
-    }
+    storedOutput.fill_position(0, stateStruct.position.x);
+    storedOutput.fill_position(1, stateStruct.position.y);
     outputDataNew.position.x = stateStruct.position.x;
     outputDataNew.position.y = stateStruct.position.y;
     outputDataDelayed.position.x = stateStruct.position.x;
@@ -243,10 +239,8 @@ void NavEKF3_core::ResetPositionNE(ftype posN, ftype posE)
     posResetNE.y = stateStruct.position.y - posOrig.y;
 
     // Add the offset to the output observer states
-    for (uint8_t i=0; i<imu_buffer_length; i++) {
-        storedOutput[i].position.x += posResetNE.x;
-        storedOutput[i].position.y += posResetNE.y;
-    }
+    storedOutput.add_position(0, posResetNE.x);
+    storedOutput.add_position(1, posResetNE.y);
     outputDataNew.position.x += posResetNE.x;
     outputDataNew.position.y += posResetNE.y;
     outputDataDelayed.position.x += posResetNE.x;
@@ -275,9 +269,7 @@ void NavEKF3_core::ResetPositionD(ftype posD)
     outputDataNew.position.z += posResetD;
     vertCompFiltState.pos = outputDataNew.position.z;
     outputDataDelayed.position.z += posResetD;
-    for (uint8_t i=0; i<imu_buffer_length; i++) {
-        storedOutput[i].position.z += posResetD;
-    }
+    storedOutput.add_position(2, posResetD);
 
     // store the time of the reset
     lastPosResetD_ms = imuSampleTime_ms;
@@ -302,9 +294,7 @@ void NavEKF3_core::ResetHeight(void)
         // can make no assumption other than vehicle is not below ground level
         terrainState = MAX(stateStruct.position.z + rngOnGnd , terrainState);
     }
-    for (uint8_t i=0; i<imu_buffer_length; i++) {
-        storedOutput[i].position.z = stateStruct.position.z;
-    }
+    storedOutput.fill_position(2, stateStruct.position.z);
     vertCompFiltState.pos = stateStruct.position.z;
 
     // Calculate the position jump due to the reset
@@ -339,9 +329,7 @@ void NavEKF3_core::ResetHeight(void)
     } else if (onGround) {
         stateStruct.velocity.z = 0.0f;
     }
-    for (uint8_t i=0; i<imu_buffer_length; i++) {
-        storedOutput[i].velocity.z = stateStruct.velocity.z;
-    }
+    storedOutput.fill_velocity(2, stateStruct.velocity.z);
     outputDataNew.velocity.z = stateStruct.velocity.z;
     outputDataDelayed.velocity.z = stateStruct.velocity.z;
     vertCompFiltState.vel = outputDataNew.velocity.z;
@@ -1123,8 +1111,8 @@ void NavEKF3_core::FuseVelPosNED()
                 if (healthyFusion) {
                     // update the covariance matrix
                     for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                        for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                            P[i][j] = P[i][j] - KHP[i][j];
+                        for (uint8_t j= i; j<=stateIndexLim; j++) {
+                            P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
                         }
                     }
 
@@ -2035,8 +2023,8 @@ void NavEKF3_core::FuseBodyVel()
             if (healthyFusion) {
                 // update the covariance matrix
                 for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                    for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                        P[i][j] = P[i][j] - KHP[i][j];
+                    for (uint8_t j= i; j<=stateIndexLim; j++) {
+                        P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
                     }
                 }
 
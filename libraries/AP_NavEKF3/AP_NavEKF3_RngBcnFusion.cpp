@@ -15,6 +15,7 @@ void NavEKF3_core::BeaconFusion::InitialiseVariables()
     varInnov = 0.0f;
     innov = 0.0f;
     memset(&lastTime_ms, 0, sizeof(lastTime_ms));
+    lastPushTime_ms = 0;
     dataToFuse = false;
     vehiclePosNED.zero();
     vehiclePosErr = 1.0f;
@@ -61,6 +62,11 @@ void NavEKF3_core::BeaconFusion::InitialiseVariables()
 // select fusion of range beacon measurements
 void NavEKF3_core::SelectRngBcnFusion()
 {
+    // let another core use this update slot for range beacon fusion
+    if (deferFusion(FusionSlot::RNGBCN)) {
+        return;
+    }
+
     // read range data from the sensor and check for new data in the buffer
     readRngBcnData();
 
@@ -293,8 +299,8 @@ void NavEKF3_core::FuseRngBcn()
             if (healthyFusion) {
                 // update the covariance matrix
                 for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                    for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                        P[i][j] = P[i][j] - KHP[i][j];
+                    for (uint8_t j= i; j<=stateIndexLim; j++) {
+                        P[i][j] = P[j][i] = P[i][j] - KHP[i][j];
                     }
                 }
 
@@ -212,6 +212,7 @@ void NavEKF3_core::InitialiseVariables()
     flowValidMeaTime_ms = imuSampleTime_ms;
     rngValidMeaTime_ms = imuSampleTime_ms;
     flowMeaTime_ms = 0;
+    flowAvg = {};
     prevFlowFuseTime_ms = 0;
     gndHgtValidTime_ms = 0;
     ekfStartTime_ms = imuSampleTime_ms;
@@ -293,6 +294,7 @@ void NavEKF3_core::InitialiseVariables()
     yawAlignGpsValidCount = 0;
     have_table_earth_field = false;
     stateIndexLim = 23;
+    covPredStateIndexLim = 0;
     last_gps_idx = 0;
     delAngCorrection.zero();
     velErrintegral.zero();
@@ -620,6 +622,18 @@ void NavEKF3_core::CovarianceInit()
 
 }
 
+/*
+  mark the states as uninitialised so the next calls to
+  InitialiseFilterBootstrap() start the core again from the current
+  sensor data. Used when a lane that was stopped to save CPU is
+  brought back into use
+*/
+void NavEKF3_core::restartFilter(void)
+{
+    statesInitialised = false;
+    firstInitTime_ms = 0;
+}
+
 /********************************************************
 *                 UPDATE FUNCTIONS                      *
 ********************************************************/
@@ -906,10 +920,10 @@ void NavEKF3_core::calcOutputStates()
     // store INS states in a ring buffer that with the same length and time coordinates as the IMU data buffer
     if (runUpdates) {
         // store the states at the output time horizon
-        storedOutput[storedIMU.get_youngest_index()] = outputDataNew;
+        storedOutput.set(storedIMU.get_youngest_index(), outputDataNew);
 
         // recall the states from the fusion time horizon
-        outputDataDelayed = storedOutput[storedIMU.get_oldest_index()];
+        outputDataDelayed = storedOutput.get(storedIMU.get_oldest_index());
 
         // compare quaternion data with EKF quaternion at the fusion time horizon and calculate correction
 
@@ -976,26 +990,15 @@ void NavEKF3_core::calcOutputStates()
             velCorrection.z = velErr.z * velPosGain + velErrintegral.z * sq(velPosGain) * 0.1F;
         }
 
-        // loop through the output filter state history and apply the corrections to the velocity and position states
+        // apply the corrections to the velocity and position states of the whole output filter state history
         // this method is too expensive to use for the attitude states due to the quaternion operations required
         // but does not introduce a time delay in the 'correction loop' and allows smaller tracking time constants
         // to be used
-        output_elements outputStates;
-        for (unsigned index=0; index < imu_buffer_length; index++) {
-            outputStates = storedOutput[index];
-
-            // a constant  velocity correction is applied
-            outputStates.velocity += velCorrection;
-
-            // a constant position correction is applied
-            outputStates.position += posCorrection;
-
-            // push the updated data to the buffer
-            storedOutput[index] = outputStates;
-        }
+        storedOutput.add_velocity(velCorrection);
+        storedOutput.add_position(posCorrection);
 
         // update output state to corrected values
-        outputDataNew = storedOutput[storedIMU.get_youngest_index()];
+        outputDataNew = storedOutput.get(storedIMU.get_youngest_index());
 
     }
 }
@@ -1181,6 +1184,32 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
         }
     }
 
+#if EK3_FEATURE_REDUCED_COV_PREDICTION
+    // When the IMU bias states are inhibited, ConstrainVariances() holds their off-diagonal
+    // covariances at zero, so a kernel generated with those terms removed gives the same result
+    // for fewer operations. The invariant only holds once ConstrainVariances() has run with the
+    // current state index limit.
+    if (!quatCovResetOnly && stateIndexLim <= 12 && stateIndexLim == covPredStateIndexLim) {
+        const cov_pred_inputs inputs {
+            dt,
+            dax, day, daz,
+            dvx, dvy, dvz,
+            q0, q1, q2, q3,
+            dax_b, day_b, daz_b,
+            dvx_b, dvy_b, dvz_b,
+            daxVar, dayVar, dazVar,
+            dvxVar, dvyVar, dvzVar,
+        };
+        if (stateIndexLim == 9) {
+            CovariancePrediction_0_9(inputs);
+        } else {
+            CovariancePrediction_0_12(inputs);
+        }
+        CovariancePredictionComplete(processNoiseVariance);
+        return;
+    }
+#endif
+
     // calculate the predicted covariance due to inertial sensor error propagation
     // we calculate the lower diagonal and copy to take advantage of symmetry
 
@@ -1738,6 +1767,12 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
         }
     }
 
+    CovariancePredictionComplete(processNoiseVariance);
+}
+
+// add process noise to the predicted covariance in nextP and copy it to P
+void NavEKF3_core::CovariancePredictionComplete(const Vector14 &processNoiseVariance)
+{
     // add the general state process noise variances
     if (stateIndexLim > 9) {
         for (uint8_t i=10; i<=stateIndexLim; i++) {
@@ -1785,6 +1820,7 @@ void NavEKF3_core::CovariancePrediction(Vector3F *rotVarVecPtr)
 
     // constrain values to prevent ill-conditioning
     ConstrainVariances();
+    covPredStateIndexLim = stateIndexLim;
 
     if (vertVelVarClipCounter > 0) {
         vertVelVarClipCounter--;
@@ -1824,9 +1860,7 @@ void NavEKF3_core::StoreOutputReset()
     outputDataNew.velocity = stateStruct.velocity;
     outputDataNew.position = stateStruct.position;
     // write current measurement to entire table
-    for (uint8_t i=0; i<imu_buffer_length; i++) {
-        storedOutput[i] = outputDataNew;
-    }
+    storedOutput.fill(outputDataNew);
     outputDataDelayed = outputDataNew;
     // reset the states for the complementary filter used to provide a vertical position derivative output
     vertCompFiltState.pos = stateStruct.position.z;
@@ -1838,9 +1872,7 @@ void NavEKF3_core::StoreQuatReset()
 {
     outputDataNew.quat = stateStruct.quat;
     // write current measurement to entire table
-    for (uint8_t i=0; i<imu_buffer_length; i++) {
-        storedOutput[i].quat = outputDataNew.quat;
-    }
+    storedOutput.fill_quat(outputDataNew.quat);
     outputDataDelayed.quat = outputDataNew.quat;
 }
 
@@ -1848,16 +1880,17 @@ void NavEKF3_core::StoreQuatReset()
 void NavEKF3_core::StoreQuatRotate(const QuaternionF &deltaQuat)
 {
     outputDataNew.quat = outputDataNew.quat*deltaQuat;
-    // write current measurement to entire table
-    for (uint8_t i=0; i<imu_buffer_length; i++) {
-        storedOutput[i].quat = storedOutput[i].quat*deltaQuat;
-    }
+    // rotate the entire table
+    storedOutput.rotate_quat(deltaQuat);
     outputDataDelayed.quat = outputDataDelayed.quat*deltaQuat;
 }
 
 // force symmetry on the covariance matrix to prevent ill-conditioning
 void NavEKF3_core::ForceSymmetry()
 {
+#if EK3_FEATURE_PACKED_COVARIANCE
+    // packed storage holds a single copy of each off-diagonal element
+#else
     for (uint8_t i=1; i<=stateIndexLim; i++)
     {
         for (uint8_t j=0; j<=i-1; j++)
@@ -1867,6 +1900,23 @@ void NavEKF3_core::ForceSymmetry()
             P[j][i] = temp;
         }
     }
+#endif
+}
+
+/*
+  when fusion is staggered, either by the StaggerFusion option or to
+  reduce CPU load, each core only runs a given
+  fusion step on one in every num_cores updates. The slot is offset by
+  the fusion type so that on any one update the cores are running
+  different fusion steps rather than the same one.
+ */
+bool NavEKF3_core::deferFusion(FusionSlot slot) const
+{
+    const uint8_t ncores = frontend->num_cores;
+    if (ncores < 2 || !frontend->stagger_fusion_enabled()) {
+        return false;
+    }
+    return ((frontend->fusionFrame + uint8_t(slot)) % ncores) != core_index;
 }
 
 // constrain variances (diagonal terms) in the state covariance matrix to  prevent ill-conditioning
@@ -2276,7 +2326,6 @@ void NavEKF3_core::moveEKFOrigin(void)
     outputDataNew.position.xy() += diffNE;
     outputDataDelayed.position.xy() += diffNE;
 
-    for (unsigned index=0; index < imu_buffer_length; index++) {
-        storedOutput[index].position.xy() += diffNE;
-    }
+    storedOutput.add_position(0, diffNE.x);
+    storedOutput.add_position(1, diffNE.y);
 }
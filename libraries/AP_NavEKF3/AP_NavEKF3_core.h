@@ -26,13 +26,16 @@
 
 #include "AP_NavEKF3_feature.h"
 #include <AP_Common/Location.h>
+#include <AP_Declination/AP_Declination.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_Math/vectorN.h>
 #include <AP_NavEKF/AP_NavEKF_core_common.h>
 #include <AP_NavEKF/AP_NavEKF_Source.h>
 #include <AP_NavEKF/EKF_Buffer.h>
+#include <AP_NavEKF/EKF_SymMatrix.h>
 #include <AP_InertialSensor/AP_InertialSensor.h>
 #include <AP_RangeFinder/AP_RangeFinder.h>
+#include <AP_Beacon/AP_Beacon_config.h>
 
 #include "AP_NavEKF/EKFGSF_yaw.h"
 
@@ -96,6 +99,18 @@
 #define EK3_POSXY_STATE_LIMIT 1.0e6
 #endif
 
+/*
+  type used for the observation Jacobian, innovation variance and
+  Kalman gain terms of the magnetometer, optical flow and airspeed
+  fusion. On mixed precision builds these run in single precision
+  while the states, covariance and covariance update stay double
+ */
+#if HAL_WITH_EKF_DOUBLE && EK3_FEATURE_MIXED_PRECISION
+typedef float gtype;
+#else
+typedef ftype gtype;
+#endif
+
 // IMU acceleration process noise in m/s/s used when bad vibration affected IMU accel is detected
 #define BAD_IMU_DATA_ACC_P_NSE 5.0f
 
@@ -126,6 +141,7 @@
 
 class NavEKF3_core : public NavEKF_core_common
 {
+    friend class NavEKF3_Benchmark;
 public:
     // Constructor
     NavEKF3_core(class NavEKF3 *_frontend, class AP_DAL &dal);
@@ -137,6 +153,9 @@ public:
     // This method can only be used when the vehicle is static
     bool InitialiseFilterBootstrap(void);
 
+    // discard the states so InitialiseFilterBootstrap() starts the core again
+    void restartFilter(void);
+
     // Update Filter States - this should be called whenever new IMU data is available
     // The predict flag is set true when a new prediction cycle can be started
     void UpdateFilter(bool predict);
@@ -412,6 +431,9 @@ public:
     // this is used by other instances to level load
     uint8_t getFramesSincePredict(void) const;
 
+    // return true if the EKF prediction and fusion steps ran on the last call to UpdateFilter()
+    bool updatesRun(void) const { return runUpdates; }
+
     // get the IMU index. For now we return the gyro index, as that is most
     // critical for use by other subsystems.
     uint8_t getIMUIndex(void) const { return gyro_index_active; }
@@ -494,6 +516,16 @@ private:
             _v[6] = p6;   _v[7] = p7;  _v[8] = p8;
         }
     };
+    class Vector9G : public VectorN<gtype, 9> {
+    public:
+        Vector9G(gtype p0, gtype p1, gtype p2,
+                 gtype p3, gtype p4, gtype p5,
+                 gtype p6, gtype p7, gtype p8) {
+            _v[0] = p0;   _v[1] = p1;  _v[2] = p2;
+            _v[3] = p3;   _v[4] = p4;  _v[5] = p5;
+            _v[6] = p6;   _v[7] = p7;  _v[8] = p8;
+        }
+    };
     class Vector5 : public VectorN<ftype, 5> {
     public:
         Vector5(ftype p0, ftype p1, ftype p2,
@@ -502,6 +534,14 @@ private:
             _v[3] = p3;   _v[4] = p4;
         }
     };
+    class Vector5G : public VectorN<gtype, 5> {
+    public:
+        Vector5G(gtype p0, gtype p1, gtype p2,
+                 gtype p3, gtype p4) {
+            _v[0] = p0;   _v[1] = p1;  _v[2] = p2;
+            _v[3] = p3;   _v[4] = p4;
+        }
+    };
 
     typedef VectorN<ftype,2> Vector2;
     typedef VectorN<ftype,3> Vector3;
@@ -533,6 +573,8 @@ private:
     typedef ftype Vector7[7];
     typedef ftype Vector8[8];
     typedef ftype Vector9[9];
+    typedef gtype Vector5G[5];
+    typedef gtype Vector9G[9];
     typedef ftype Vector10[10];
     typedef ftype Vector11[11];
     typedef ftype Vector13[13];
@@ -549,6 +591,13 @@ private:
     typedef uint32_t Vector_u32_50[50];
 #endif
 
+#if EK3_FEATURE_PACKED_COVARIANCE
+    // state covariance held as a packed upper triangle (300 elements)
+    typedef EKF_SymMatrix<ftype,24> CovMatrix24;
+#else
+    typedef Matrix24 CovMatrix24;
+#endif
+
     // the states are available in two forms, either as a Vector24, or
     // broken down as individual elements. Both are equivalent (same
     // memory)
@@ -625,6 +674,7 @@ private:
         Vector3F    bodyRadXYZ;     // body frame XYZ axis angular rates averaged across the optical flow measurement interval (rad/sec)
         Vector3F    body_offset;    // XYZ position of the optical flow sensor in body frame (m)
         float       heightOverride; // The fixed height of the sensor above ground in m, when on rover vehicles. 0 if not used
+        ftype       noiseVarScale = 1; // scale on the flow noise variance, less than 1 for averaged samples
     };
 
     struct vel_odm_elements : EKF_obs_element_t {
@@ -711,9 +761,43 @@ private:
     // used to perform a reset of the quaternion state covariances only. Set to null for normal operation.
     void CovariancePrediction(Vector3F *rotVarVecPtr);
 
+    // add process noise to the predicted covariance and copy it back to P
+    void CovariancePredictionComplete(const Vector14 &processNoiseVariance);
+
+#if EK3_FEATURE_REDUCED_COV_PREDICTION
+    // inputs to the reduced covariance prediction kernels
+    struct cov_pred_inputs {
+        ftype dt;
+        ftype dax, day, daz;
+        ftype dvx, dvy, dvz;
+        ftype q0, q1, q2, q3;
+        ftype dax_b, day_b, daz_b;
+        ftype dvx_b, dvy_b, dvz_b;
+        ftype daxVar, dayVar, dazVar;
+        ftype dvxVar, dvyVar, dvzVar;
+    };
+
+    // covariance prediction kernels for states 0-9 and 0-12, used
+    // when the IMU bias states are inhibited. These fill nextP only.
+    void CovariancePrediction_0_9(const cov_pred_inputs &in);
+    void CovariancePrediction_0_12(const cov_pred_inputs &in);
+#endif
+
     // force symmetry on the state covariance matrix
     void ForceSymmetry();
 
+    // expensive fusion steps that can be staggered across cores
+    enum class FusionSlot : uint8_t {
+        MAG    = 0,
+        FLOW   = 1,
+        RNGBCN = 2,
+        TAS    = 3,
+    };
+
+    // return true if this core should defer a fusion step to a later
+    // update so that cores take turns at the expensive fusion steps
+    bool deferFusion(FusionSlot slot) const;
+
     // constrain variances (diagonal terms) in the state covariance matrix
     void ConstrainVariances();
 
@@ -755,6 +839,24 @@ private:
     // zero specified range of columns in the state covariance matrix
     void zeroCols(Matrix24 &covMat, uint8_t first, uint8_t last);
 
+#if EK3_FEATURE_PACKED_COVARIANCE
+    // zero specified range of rows and columns in the packed state
+    // covariance matrix. Rows and columns share storage so both calls
+    // zero the same elements
+    void zeroRows(CovMatrix24 &covMat, uint8_t first, uint8_t last) {
+        covMat.zero_rows_cols(first, last);
+    }
+    void zeroCols(CovMatrix24 &covMat, uint8_t first, uint8_t last) {
+        covMat.zero_rows_cols(first, last);
+    }
+#endif
+
+    // state covariance element in the precision used for the fusion
+    // Jacobian and Kalman gain calculations
+    gtype Pg(uint8_t i, uint8_t j) const {
+        return gtype(P[i][j]);
+    }
+
     // Reset the stored output history to current data
     void StoreOutputReset(void);
 
@@ -906,6 +1008,9 @@ private:
     // fuse optical flow measurements into the main filter
     // really_fuse should be true to actually fuse into the main filter, false to only calculate variances
     void FuseOptFlow(const of_elements &ofDataDelayed, bool really_fuse);
+
+    // average a flow sample, buffering the average at EK3_FLOW_RATE
+    void averageOptFlowMeas(of_elements &ofDataNew);
 #endif
 
     // Control filter mode changes
@@ -1074,7 +1179,7 @@ private:
     uint32_t vertVelVarClipCounter; // counter used to control reset of vertical velocity variance following collapse against the lower limit
 
     ftype gpsNoiseScaler;           // Used to scale the  GPS measurement noise and consistency gates to compensate for operation with small satellite counts
-    Matrix24 P;                     // covariance matrix
+    CovMatrix24 P;                  // covariance matrix
     EKF_IMU_buffer_t<imu_elements> storedIMU;      // IMU data buffer
     EKF_obs_buffer_t<gps_elements> storedGPS;      // GPS data buffer
     EKF_obs_buffer_t<mag_elements> storedMag;      // Magnetometer data buffer
@@ -1083,7 +1188,7 @@ private:
 #if EK3_FEATURE_RANGEFINDER_MEASUREMENTS
     EKF_obs_buffer_t<range_elements> storedRange;  // Range finder data buffer
 #endif
-    EKF_IMU_buffer_t<output_elements> storedOutput;// output state buffer
+    EKF_output_buffer_t<output_elements> storedOutput;// output state buffer
     Matrix3F prevTnb;               // previous nav to body transformation used for INS earth rotation compensation
     ftype accNavMag;                // magnitude of navigation accel - used to adjust GPS obs variance (m/s^2)
     ftype accNavMagHoriz;           // magnitude of navigation accel in horizontal plane (m/s^2)
@@ -1172,6 +1277,7 @@ private:
     uint8_t yawAlignGpsValidCount;  // number of continuous good GPS velocity samples used for in flight yaw alignment
     bool magStateInitComplete;      // true when the magnetic field states have been initialised
     uint8_t stateIndexLim;          // Max state index used during matrix and array operations
+    uint8_t covPredStateIndexLim;   // value of stateIndexLim when the covariance was last constrained after a prediction
     imu_elements imuDataDelayed;    // IMU data at the fusion time horizon
     imu_elements imuDataNew;        // IMU data at the current time horizon
     imu_elements imuDataDownSampledNew; // IMU data at the current time horizon that has been downsampled to a 100Hz rate
@@ -1319,6 +1425,15 @@ private:
     bool gndOffsetValid;            // true when the ground offset state can still be considered valid
     Vector3F delAngBodyOF;          // bias corrected delta angle of the vehicle IMU measured summed across the time since the last OF measurement
     ftype delTimeOF;                // time that delAngBodyOF is summed across
+    struct {
+        Vector2F flowRadXY;         // sum of raw flow rates (rad/sec)
+        Vector3F bodyRadXYZ;        // sum of body rates (rad/sec)
+        uint32_t firstTime_ms;      // time of the first sample being averaged (msec)
+        uint32_t timeSum_ms;        // sum of sample times relative to firstTime_ms (msec)
+        uint32_t lastSample_ms;     // system time of the last sample added (msec)
+        uint32_t lastPush_ms;       // system time an averaged sample was last buffered (msec)
+        uint8_t count;              // number of samples summed
+    } flowAvg;                      // optical flow samples being averaged down to EK3_FLOW_RATE
     bool flowFusionActive;          // true when optical flow fusion is active
 
     Vector3F accelPosOffset;        // position of IMU accelerometer unit in body frame (m)
@@ -1379,7 +1494,8 @@ private:
         bool health;                  // boolean true if range beacon measurements have passed innovation consistency check
         ftype varInnov;               // range beacon observation innovation variance (m^2)
         ftype innov;                  // range beacon observation innovation (m)
-        uint32_t lastTime_ms[4];      // last time we received a range beacon measurement (msec)
+        uint32_t lastTime_ms[AP_BEACON_MAX_BEACONS]; // last time we received a range beacon measurement (msec)
+        uint32_t lastPushTime_ms;     // time a range beacon measurement was last buffered (msec)
         bool dataToFuse;              // true when there is new range beacon data to fuse
         Vector3F vehiclePosNED;       // NED position estimate from the beacon system (NED)
         ftype vehiclePosErr;          // estimated position error from the beacon system (m)
@@ -1545,6 +1661,7 @@ private:
     bool have_table_earth_field;   // true when we have initialised table_earth_field_ga
     Vector3F table_earth_field_ga; // earth field from WMM tables
     ftype table_declination;       // declination in radians from the tables
+    AP_Declination::Cache table_field_cache; // table cell of the last earth field lookup
 
     // 1Hz update
     uint32_t last_oneHz_ms;
@@ -46,3 +46,28 @@
 #ifndef EK3_FEATURE_OPTFLOW_FUSION
 #define EK3_FEATURE_OPTFLOW_FUSION HAL_NAVEKF3_AVAILABLE && AP_OPTICALFLOW_ENABLED
 #endif
+
+// hold the covariance matrix as a packed upper triangle, saving
+// memory and cache footprint on double precision builds
+#ifndef EK3_FEATURE_PACKED_COVARIANCE
+#define EK3_FEATURE_PACKED_COVARIANCE HAL_WITH_EKF_DOUBLE
+#endif
+
+// run the Jacobian and Kalman gain calculations of the magnetometer,
+// optical flow and airspeed fusion in single precision on double
+// precision builds
+#ifndef EK3_FEATURE_MIXED_PRECISION
+#define EK3_FEATURE_MIXED_PRECISION 0
+#endif
+
+// covariance prediction kernels for the reduced state sets used when
+// the IMU bias states are inhibited
+#ifndef EK3_FEATURE_REDUCED_COV_PREDICTION
+#define EK3_FEATURE_REDUCED_COV_PREDICTION EK3_FEATURE_ALL || HAL_PROGRAM_SIZE_LIMIT_KB > 1024
+#endif
+
+// allow the non-primary cores to run on a worker thread on HALs with
+// spare CPU cores
+#ifndef EK3_FEATURE_THREADED_CORES
+#define EK3_FEATURE_THREADED_CORES (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX) && !EK3_FEATURE_ALL
+#endif
@@ -0,0 +1,134 @@
+/*
+  benchmark of the EKF3 airspeed fusion Kalman gain calculation with
+  the gain terms in single and double precision, as selected by
+  EK3_FEATURE_MIXED_PRECISION on double precision builds.
+
+  Each benchmark runs a sequence of airspeed fusions against a 24
+  state covariance held in double. Only the Jacobian, innovation
+  variance and gain terms use the benchmarked type, matching the
+  mixed precision EKF. The "drift" counter is the largest relative
+  difference of the covariance diagonal from the all double
+  sequence after the fusions have been applied.
+ */
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static constexpr uint8_t num_states = 24;
+static constexpr uint16_t num_fusions = 200;
+
+typedef double CovMatrix[num_states][num_states];
+
+static void init_covariance(CovMatrix &P)
+{
+    // diagonally dominant with small correlations between states
+    for (uint8_t i=0; i<num_states; i++) {
+        for (uint8_t j=0; j<num_states; j++) {
+            P[i][j] = (i == j) ? 0.5 + 0.1*i : 1.0e-3 / (1 + i + j);
+        }
+    }
+}
+
+/*
+  one airspeed fusion with the same structure as
+  NavEKF3_core::FuseAirspeed(). T is the type used for the gain terms
+ */
+template <typename T>
+static void fuse_airspeed(CovMatrix &P, const double vel[3], const double wind[2], double tasVariance)
+{
+    const T vn = vel[0];
+    const T ve = vel[1];
+    const T vd = vel[2];
+    const T vwn = wind[0];
+    const T vwe = wind[1];
+    const T VtasPred = norm((ve - vwe), (vn - vwn), vd);
+
+    T SH_TAS[3];
+    SH_TAS[0] = 1.0f/VtasPred;
+    SH_TAS[1] = (SH_TAS[0]*(2.0f*ve - 2.0f*vwe))*0.5f;
+    SH_TAS[2] = (SH_TAS[0]*(2.0f*vn - 2.0f*vwn))*0.5f;
+
+    double H_TAS[num_states] {};
+    H_TAS[4] = SH_TAS[2];
+    H_TAS[5] = SH_TAS[1];
+    H_TAS[6] = vd*SH_TAS[0];
+    H_TAS[22] = -SH_TAS[2];
+    H_TAS[23] = -SH_TAS[1];
+
+    // innovation variance H*P*H' + R in the gain type
+    T varInnov = T(tasVariance);
+    for (uint8_t i=0; i<num_states; i++) {
+        if (H_TAS[i] == 0) {
+            continue;
+        }
+        T PHt = 0;
+        for (uint8_t j=0; j<num_states; j++) {
+            PHt += T(P[i][j]) * T(H_TAS[j]);
+        }
+        varInnov += T(H_TAS[i]) * PHt;
+    }
+    const T SK = 1.0f / varInnov;
+
+    double Kfusion[num_states];
+    for (uint8_t i=0; i<num_states; i++) {
+        Kfusion[i] = SK*(T(P[i][4])*SH_TAS[2] - T(P[i][22])*SH_TAS[2] + T(P[i][5])*SH_TAS[1] - T(P[i][23])*SH_TAS[1] + T(P[i][6])*vd*SH_TAS[0]);
+    }
+
+    // covariance update P = (I - K*H)*P stays double
+    static CovMatrix KHP;
+    for (uint8_t i=0; i<num_states; i++) {
+        for (uint8_t j=0; j<num_states; j++) {
+            double res = 0;
+            res += Kfusion[i] * H_TAS[4] * P[4][j];
+            res += Kfusion[i] * H_TAS[5] * P[5][j];
+            res += Kfusion[i] * H_TAS[6] * P[6][j];
+            res += Kfusion[i] * H_TAS[22] * P[22][j];
+            res += Kfusion[i] * H_TAS[23] * P[23][j];
+            KHP[i][j] = res;
+        }
+    }
+    for (uint8_t i=0; i<num_states; i++) {
+        for (uint8_t j=0; j<num_states; j++) {
+            P[i][j] -= KHP[i][j];
+        }
+        // process noise keeps the covariance from collapsing
+        P[i][i] += 1.0e-4;
+    }
+}
+
+template <typename T>
+static void run_fusions(CovMatrix &P)
+{
+    init_covariance(P);
+    for (uint16_t n=0; n<num_fusions; n++) {
+        const double vel[3] { 20.0 + 0.01*n, 3.0 - 0.005*n, 0.5 };
+        const double wind[2] { 2.0, -1.5 };
+        fuse_airspeed<T>(P, vel, wind, 1.0);
+    }
+}
+
+template <typename T>
+static void BM_FuseAirspeedGain(benchmark::State& state)
+{
+    static CovMatrix P;
+    while (state.KeepRunning()) {
+        run_fusions<T>(P);
+        gbenchmark_escape(&P);
+    }
+
+    // compare against the all double sequence
+    static CovMatrix Pdouble;
+    run_fusions<double>(Pdouble);
+    double drift = 0;
+    for (uint8_t i=0; i<num_states; i++) {
+        drift = MAX(drift, fabs(P[i][i] - Pdouble[i][i]) / Pdouble[i][i]);
+    }
+    state.counters["drift"] = drift;
+}
+
+BENCHMARK_TEMPLATE(BM_FuseAirspeedGain, double);
+BENCHMARK_TEMPLATE(BM_FuseAirspeedGain, float);
+
+BENCHMARK_MAIN();
@@ -552,6 +552,32 @@ def quaternion_error_propagation():
     quat_code_generator.write_matrix(Matrix(P_rot_vec_simple[1]), "tiltErrCovMat", False, "[", "]")
     quat_code_generator.close()
 
+# generate covariance prediction for states 0 to last_state, with the
+# off-diagonal covariances of the inhibited IMU bias states zeroed
+def reduced_covariance_prediction(A, G, var_u, last_state):
+    P = create_symmetric_cov_matrix(24)
+    for index in range(last_state+1, 16):
+        for j in range(24):
+            if j != index:
+                P[index,j] = 0
+                P[j,index] = 0
+
+    n = last_state + 1
+    P_new = A[0:n,:] * P * A[0:n,:].T + G[0:n,:] * var_u * G[0:n,:].T
+
+    for index in range(n):
+        for j in range(n):
+            if index > j:
+                P_new[index,j] = 0
+
+    P_new_simple = cse(P_new, symbols("PS0:400"), optimizations='basic')
+
+    cov_code_generator = CodeGenerator("./generated/covariance_generated_0_" + str(last_state) + ".cpp")
+    cov_code_generator.print_string("Equations for covariance matrix prediction of states 0 to " + str(last_state) + ", without process noise!")
+    cov_code_generator.write_subexpressions(P_new_simple[0])
+    cov_code_generator.write_matrix(Matrix(P_new_simple[1]), "nextP", True, "[", "]")
+    cov_code_generator.close()
+
 def generate_code():
     print('Starting code generation:')
     print('Creating symbolic variables ...')
@@ -665,6 +691,9 @@ def generate_code():
 
     # cov_code_generator.close()
 
+    print('Computing reduced covariance propagation ...')
+    reduced_covariance_prediction(A, G, var_u, 9)
+    reduced_covariance_prediction(A, G, var_u, 12)
 
     # derive autocode for other methods
     print('Computing tilt error covariance matrix ...')
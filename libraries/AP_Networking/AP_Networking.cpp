@@ -468,6 +468,26 @@ const char *AP_Networking::address_to_str(uint32_t addr)
     return SocketAPM::inet_addr_to_str(addr, buf, sizeof(buf));
 }
 
+#if AP_NETWORKING_LWIP_STATS_ENABLED
+void ap_networking_lwip_info(ExpandingString &str);
+
+/*
+  lwIP core time by thread and link statistics for @SYS/lwip.txt
+ */
+void AP_Networking::lwip_info(ExpandingString &str)
+{
+    ap_networking_lwip_info(str);
+    if (backend != nullptr) {
+        backend->link_info(str);
+    }
+#if AP_NETWORKING_PPP_GATEWAY_ENABLED
+    if (backend_PPP != nullptr) {
+        backend_PPP->link_info(str);
+    }
+#endif
+}
+#endif
+
 #ifdef LWIP_PLATFORM_ASSERT
 void ap_networking_platform_assert(const char *msg, int line, const char *file)
 {
@@ -21,6 +21,7 @@ class AP_Networking_Backend;
 class AP_Networking_ChibiOS;
 
 class SocketAPM;
+class ExpandingString;
 
 class AP_Networking
 {
@@ -154,6 +155,11 @@ public:
     // hook for custom routes
     struct netif *routing_hook(uint32_t dest);
 
+#if AP_NETWORKING_LWIP_STATS_ENABLED
+    // lwIP core time by thread and link statistics for @SYS/lwip.txt
+    void lwip_info(ExpandingString &str);
+#endif
+
     /*
       send contents of a file to a socket then close both socket and file
      */
@@ -277,6 +283,8 @@ private:
         void _end() override {}
         void _flush() override {}
         bool _discard_input() override;
+        uint8_t _peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len) override;
+        bool _consume(uint32_t n) override;
 
         enum flow_control get_flow_control(void) override;
 
@@ -297,6 +305,10 @@ private:
         bool close_on_recv_error;
         uint32_t last_udp_srv_recv_time_ms;
 
+        // incremented on each discard of the read buffer, so a receive
+        // straight into the buffer is not committed after a discard
+        uint8_t rx_discard_count;
+
         // statistics
         uint32_t tx_stats_bytes;
         uint32_t rx_stats_bytes;
@@ -7,6 +7,7 @@
 #include "AP_Networking.h"
 
 class AP_Networking;
+class ExpandingString;
 
 #ifndef AP_NETWORKING_MAX_ROUTES
 #define AP_NETWORKING_MAX_ROUTES 4
@@ -31,6 +32,9 @@ public:
 
     // hook for custom routes
     virtual struct netif *routing_hook(uint32_t dest) { return nullptr; }
+
+    // link statistics for @SYS/lwip.txt
+    virtual void link_info(ExpandingString &str) {}
     
 protected:
     AP_Networking &frontend;
@@ -129,6 +129,11 @@
 #define AP_NETWORKING_SENDFILE_BUFSIZE (64*512)
 #endif
 
+// report the time each thread spends in the lwIP core in @SYS/lwip.txt
+#ifndef AP_NETWORKING_LWIP_STATS_ENABLED
+#define AP_NETWORKING_LWIP_STATS_ENABLED AP_NETWORKING_NEED_LWIP
+#endif
+
 #ifndef AP_NETWORKING_PPP_GATEWAY_ENABLED
 #define AP_NETWORKING_PPP_GATEWAY_ENABLED (AP_NETWORKING_BACKEND_CHIBIOS && AP_NETWORKING_BACKEND_PPP)
 #endif
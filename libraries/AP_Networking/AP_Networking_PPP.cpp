@@ -12,6 +12,7 @@
 #include <netif/ppp/pppapi.h>
 #include <netif/ppp/pppos.h>
 #include <lwip/tcpip.h>
+#include <AP_Common/ExpandingString.h>
 #include <stdio.h>
 
 // PPP protocol
@@ -22,6 +23,12 @@
 #define PPP_BUFSIZE_TX 8192
 #endif
 
+// size of uart reads, by default the whole uart buffer so a burst is
+// passed to lwIP in one go with one take of the core lock
+#ifndef PPP_INPUT_CHUNK
+#define PPP_INPUT_CHUNK PPP_BUFSIZE_RX
+#endif
+
 extern const AP_HAL::HAL& hal;
 
 #if LWIP_TCPIP_CORE_LOCKING
@@ -60,10 +67,13 @@ uint32_t AP_Networking_PPP::ppp_output_cb(ppp_pcb *pcb, const void *data, uint32
           if we can't send the whole frame then don't send any of it. This
           minimises issues with the PPP state machine
          */
+        driver.tx_dropped++;
         return 0;
     }
 
-    return driver.uart->write(ptr, remaining);
+    const uint32_t n = driver.uart->write(ptr, remaining);
+    driver.tx_bytes += n;
+    return n;
 }
 
 /*
@@ -159,6 +169,10 @@ bool AP_Networking_PPP::init()
     }
 
     if (need_thread) {
+        rx_buf = NEW_NOTHROW uint8_t[PPP_INPUT_CHUNK];
+        if (rx_buf == nullptr) {
+            return false;
+        }
         hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Networking_PPP::ppp_loop, void),
                                      "ppp",
                                      2048, AP_HAL::Scheduler::PRIORITY_NET, 0);
@@ -219,6 +233,21 @@ void AP_Networking_PPP::ppp_loop(void)
         restart_instance(i);
     }
 
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+    // with a single link we can sleep until data arrives rather than polling
+    AP_HAL::UARTDriver *single_uart = nullptr;
+    uint8_t num_links = 0;
+    for (const auto &inst : iface) {
+        if (inst.uart != nullptr) {
+            single_uart = inst.uart;
+            num_links++;
+        }
+    }
+    if (num_links != 1) {
+        single_uart = nullptr;
+    }
+#endif
+
     while (true) {
         bool read_data = false;
 
@@ -228,6 +257,12 @@ void AP_Networking_PPP::ppp_loop(void)
             }
         }
         if (!read_data) {
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+            if (single_uart != nullptr) {
+                single_uart->wait_timeout(1, 1);
+                continue;
+            }
+#endif
             // ensure we give up some time
             hal.scheduler->delay_microseconds(200);
         }
@@ -308,7 +343,6 @@ void AP_Networking_PPP::restart_instance(const uint8_t idx)
 bool AP_Networking_PPP::update_instance(const uint8_t idx)
 {
     auto &inst = iface[idx];
-    uint8_t buf[1024];
 
     if (inst.need_restart) {
         inst.need_restart = false;
@@ -323,10 +357,11 @@ bool AP_Networking_PPP::update_instance(const uint8_t idx)
     }
 
     const uint32_t now_ms = AP_HAL::millis();
-    auto n = inst.uart->read(buf, sizeof(buf));
+    auto n = inst.uart->read(rx_buf, PPP_INPUT_CHUNK);
     if (n > 0) {
+        inst.rx_bytes += n;
         LWIP_TCPIP_LOCK();
-        pppos_input(inst.ppp, buf, n);
+        pppos_input(inst.ppp, rx_buf, n);
         LWIP_TCPIP_UNLOCK();
         if (inst.ppp->if4_up) {
             // only consider the link active if IPv4 is up
@@ -357,6 +392,19 @@ bool AP_Networking_PPP::update_instance(const uint8_t idx)
     return n > 0;
 }
 
+// link statistics for @SYS/lwip.txt
+void AP_Networking_PPP::link_info(ExpandingString &str)
+{
+    for (const auto &inst : iface) {
+        if (inst.uart == nullptr) {
+            continue;
+        }
+        str.printf("PPP[%u] RX=%u TX=%u TXDROP=%u\n",
+                   unsigned(inst.idx), unsigned(inst.rx_bytes),
+                   unsigned(inst.tx_bytes), unsigned(inst.tx_dropped));
+    }
+}
+
 // hook for custom routes
 struct netif *AP_Networking_PPP::routing_hook(uint32_t dest)
 {
@@ -21,6 +21,9 @@ public:
 
     // hook for custom routes
     struct netif *routing_hook(uint32_t dest) override;
+
+    // link statistics for @SYS/lwip.txt
+    void link_info(ExpandingString &str) override;
     
 private:
     void ppp_loop(void);
@@ -33,8 +36,14 @@ private:
         struct ppp_pcb_s *ppp;
         bool need_restart;
         uint32_t last_read_ms;
+        uint32_t rx_bytes;
+        uint32_t tx_bytes;
+        uint32_t tx_dropped;    // frames dropped for lack of uart space
     } iface[AP_NETWORKING_PPP_NUM_INTERFACES];
 
+    // uart input buffer, shared by all instances
+    uint8_t *rx_buf;
+
     void restart_instance(const uint8_t idx);
     bool update_instance(const uint8_t idx);
 
@@ -29,6 +29,14 @@ extern const AP_HAL::HAL& hal;
 #define AP_NETWORKING_PORT_STACK_SIZE 1024
 #endif
 
+// maximum size of one send or receive on a port, for UDP this is the datagram size
+#define AP_NETWORKING_PORT_MAX_PKT 300U
+
+// maximum number of sends in one pass of send_receive()
+#ifndef AP_NETWORKING_PORT_TX_BATCH
+#define AP_NETWORKING_PORT_TX_BATCH 8
+#endif
+
 const AP_Param::GroupInfo AP_Networking::Port::var_info[] = {
     // @Param: TYPE
     // @DisplayName: Port type
@@ -329,9 +337,23 @@ bool AP_Networking::Port::send_receive(void)
         space = readbuffer->space();
     }
     if (space > 0) {
-        const uint32_t n = MIN(300U, space);
-        uint8_t buf[n];
-        const auto ret = sock->recv(buf, n, 0);
+        const uint32_t n = MIN(AP_NETWORKING_PORT_MAX_PKT, space);
+        /*
+          receive straight into the read buffer when there is enough
+          contiguous space, so a datagram is never split. Otherwise
+          receive into a bounce buffer as before
+         */
+        ByteBuffer::IoVec vec[2];
+        uint8_t nvec;
+        uint32_t discard_count;
+        {
+            WITH_SEMAPHORE(sem);
+            nvec = readbuffer->reserve(vec, n);
+            discard_count = rx_discard_count;
+        }
+        const bool direct = nvec > 0 && vec[0].len == n;
+        uint8_t buf[direct ? 1 : n];
+        const auto ret = sock->recv(direct ? vec[0].data : buf, n, 0);
         if (close_on_recv_error && ret == 0) {
             GCS_SEND_TEXT(MAV_SEVERITY_INFO, "TCP[%u]: closed connection", unsigned(state.idx));
             delete sock;
@@ -340,7 +362,12 @@ bool AP_Networking::Port::send_receive(void)
         }
         if (ret > 0) {
             WITH_SEMAPHORE(sem);
-            readbuffer->write(buf, ret);
+            if (!direct) {
+                readbuffer->write(buf, ret);
+            } else if (discard_count == rx_discard_count) {
+                // don't commit into a buffer that was cleared while we received
+                readbuffer->commit(ret);
+            }
 
             // Cant track dropped read packets because we only read in what there is space for
             // The socket buffer becomes full and data is lost there
@@ -375,14 +402,17 @@ bool AP_Networking::Port::send_receive(void)
         }
     }
 
-    if (connected) {
-        // handle outgoing packets
+    // handle outgoing packets, several sends per pass so high rate
+    // telemetry is not limited to one packet per loop
+    for (uint8_t count = 0; connected && count < AP_NETWORKING_PORT_TX_BATCH; count++) {
         uint32_t available;
+        ByteBuffer::IoVec vec[2];
+        uint8_t nvec;
 
         {
             WITH_SEMAPHORE(sem);
             available = writebuffer->available();
-            available = MIN(300U, available);
+            available = MIN(AP_NETWORKING_PORT_MAX_PKT, available);
 #if AP_MAVLINK_PACKETISE_ENABLED
             if (packetise) {
                 available = mavlink_packetise(*writebuffer, available);
@@ -391,28 +421,39 @@ bool AP_Networking::Port::send_receive(void)
             if (available == 0) {
                 return active;
             }
-        }
-        uint8_t buf[available];
-        uint32_t n;
-        {
-            WITH_SEMAPHORE(sem);
-            n = writebuffer->peekbytes(buf, available);
+            nvec = writebuffer->peekiovec(vec, available);
         }
 
         // nothing to send return
-        if (n <= 0) {
+        if (nvec == 0) {
             return active;
         }
 
+        /*
+          send straight from the write buffer unless the data wraps
+          around the end of the ring, in which case it is gathered
+          into a bounce buffer so that a UDP datagram still holds
+          whole MAVLink packets
+         */
+        const uint8_t *data = vec[0].data;
+        uint32_t n = vec[0].len;
+        uint8_t buf[nvec > 1 ? available : 1];
+        if (nvec > 1) {
+            memcpy(buf, vec[0].data, vec[0].len);
+            memcpy(&buf[vec[0].len], vec[1].data, vec[1].len);
+            data = buf;
+            n += vec[1].len;
+        }
+
         ssize_t ret = -1;
         if (type == NetworkPortType::UDP_SERVER) {
             // UDP Server uses sendto, allowing us to change the destination address port on the fly
             if(last_udp_connect_address != 0 && last_udp_connect_port != 0) {
-                ret = sock->sendto(buf, n, last_udp_connect_address, last_udp_connect_port);
+                ret = sock->sendto(data, n, last_udp_connect_address, last_udp_connect_port);
             }
         } else {
             // TCP Server and Client and UDP Client use send
-            ret = sock->send(buf, n);
+            ret = sock->send(data, n);
         }
 
         if (ret > 0) {
@@ -420,14 +461,17 @@ bool AP_Networking::Port::send_receive(void)
             writebuffer->advance(ret);
             tx_stats_bytes += ret;
             active = true;
-        } else if (errno == ENOTCONN &&
-            (type == NetworkPortType::TCP_CLIENT || type == NetworkPortType::TCP_SERVER)) {
-            // close socket and mark as disconnected, so we can reconnect with another client or when server comes back
-            GCS_SEND_TEXT(MAV_SEVERITY_INFO, "TCP[%u]: disconnected", unsigned(state.idx));
-            sock->close();
-            delete sock;
-            sock = nullptr;
-            connected = false;
+        } else {
+            if (errno == ENOTCONN &&
+                (type == NetworkPortType::TCP_CLIENT || type == NetworkPortType::TCP_SERVER)) {
+                // close socket and mark as disconnected, so we can reconnect with another client or when server comes back
+                GCS_SEND_TEXT(MAV_SEVERITY_INFO, "TCP[%u]: disconnected", unsigned(state.idx));
+                sock->close();
+                delete sock;
+                sock = nullptr;
+                connected = false;
+            }
+            break;
         }
     }
 
@@ -473,9 +517,26 @@ bool AP_Networking::Port::_discard_input()
 {
     WITH_SEMAPHORE(sem);
     readbuffer->clear();
+    rx_discard_count++;
     return true;
 }
 
+/*
+  zero copy access to the read buffer. The network thread only appends
+  to the buffer, so the returned spans stay valid until consumed
+ */
+uint8_t AP_Networking::Port::_peek_iovec(ByteBuffer::IoVec vec[2], uint32_t len)
+{
+    WITH_SEMAPHORE(sem);
+    return readbuffer->peekiovec(vec, len);
+}
+
+bool AP_Networking::Port::_consume(uint32_t n)
+{
+    WITH_SEMAPHORE(sem);
+    return readbuffer->advance(n);
+}
+
 /*
   initialise read/write buffers
  */
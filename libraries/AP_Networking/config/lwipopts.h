@@ -127,8 +127,17 @@ extern "C"
 #define LWIP_TIMEVAL_PRIVATE 0
 #define LWIP_FD_SET_PRIVATE 0
 
+/*
+  TCP window and send buffer, may be raised in hwdef for high rate
+  links. These are checked at compile time by lwIP so can't be
+  parameters
+ */
+#ifndef TCP_WND
 #define TCP_WND 12000
+#endif
+#ifndef TCP_SND_BUF
 #define TCP_SND_BUF 12000
+#endif
 #define DEFAULT_ACCEPTMBOX_SIZE         20
 
     
@@ -218,8 +227,12 @@ a lot of data that needs to be copied, this should be set high. */
 /* PBUF_POOL_SIZE: the number of buffers in the pbuf pool. */
 #define PBUF_POOL_SIZE          120
 
-/* PBUF_POOL_BUFSIZE: the size of each pbuf in the pbuf pool. */
-#define PBUF_POOL_BUFSIZE       256
+/* PBUF_POOL_BUFSIZE: the size of each pbuf in the pbuf pool. PPP
+   input and output work a pool pbuf at a time, so this sets how many
+   allocations and uart writes a frame takes */
+#ifndef PBUF_POOL_BUFSIZE
+#define PBUF_POOL_BUFSIZE       512
+#endif
 
 /** SYS_LIGHTWEIGHT_PROT
  * define SYS_LIGHTWEIGHT_PROT in lwipopts.h if you want inter-task protection
@@ -247,7 +260,9 @@ a lot of data that needs to be copied, this should be set high. */
 #define TCP_QUEUE_OOSEQ         1
 
 /* TCP Maximum segment size. */
+#ifndef TCP_MSS
 #define TCP_MSS                 1024
+#endif
 
 /* TCP sender buffer space (bytes). */
 #ifndef TCP_SND_BUF
@@ -12,7 +12,11 @@
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
 #include <AP_HAL_ChibiOS/hwdef/common/stm32_util.h>
+#include <ch.h>
+#else
+#include <pthread.h>
 #endif
+#include <AP_Common/ExpandingString.h>
 
 #include <string.h>
 #include <sys/time.h>
@@ -92,13 +96,104 @@ sys_thread_new(const char *name, lwip_thread_fn function, void *arg, int stacksi
     return (sys_thread_t)thread_data;
 }
 
+#if AP_NETWORKING_LWIP_STATS_ENABLED
+/*
+  time each thread spends holding the core lock. With core locking
+  all lwIP processing is done with the lock held, so this is the CPU
+  used by lwIP in each thread, whether the tcpip thread, the PPP
+  thread or a thread using sockets
+ */
+#define LWIP_STATS_MAX_THREADS 8
+
+static struct {
+    const void *thread;
+    char name[16];
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t total_us;
+} lwip_thread_stats[LWIP_STATS_MAX_THREADS];
+static uint8_t tcpip_lock_depth;
+static uint32_t tcpip_lock_start_us;
+static uint32_t lwip_stats_start_us;
+
+static const void *current_thread(void)
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+    return chThdGetSelfX();
+#else
+    return (const void *)(uintptr_t)pthread_self();
+#endif
+}
+
+static void current_thread_name(char *name, uint8_t len)
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+    const char *tname = chThdGetSelfX()->name;
+    strncpy(name, tname != nullptr ? tname : "?", len-1);
+#else
+    if (pthread_getname_np(pthread_self(), name, len) != 0) {
+        strncpy(name, "?", len-1);
+    }
+#endif
+}
+
+// called with the core lock held
+static void record_core_time(uint32_t dt_us)
+{
+    const void *thread = current_thread();
+    for (auto &s : lwip_thread_stats) {
+        if (s.thread == nullptr) {
+            s.thread = thread;
+            current_thread_name(s.name, sizeof(s.name));
+        }
+        if (s.thread == thread) {
+            s.count++;
+            s.total_us += dt_us;
+            s.max_us = MAX(s.max_us, dt_us);
+            return;
+        }
+    }
+}
+
+void ap_networking_lwip_info(ExpandingString &str)
+{
+    // take the mutex directly so reading isn't counted
+    WITH_SEMAPHORE(tcpip_mutex);
+    const uint32_t now_us = AP_HAL::micros();
+    const float dt_us = MAX(now_us - lwip_stats_start_us, 1U);
+    lwip_stats_start_us = now_us;
+    str.printf("LWIP core time by thread\n");
+    for (auto &s : lwip_thread_stats) {
+        if (s.thread == nullptr) {
+            break;
+        }
+        str.printf("%-13.13s LOAD=%4.1f%% COUNT=%5u MAX=%5uus\n",
+                   s.name, 100.0f * float(s.total_us) / dt_us,
+                   unsigned(s.count), unsigned(s.max_us));
+        s.count = 0;
+        s.max_us = 0;
+        s.total_us = 0;
+    }
+}
+#endif // AP_NETWORKING_LWIP_STATS_ENABLED
+
 void sys_lock_tcpip_core(void)
 {
     tcpip_mutex.take_blocking();
+#if AP_NETWORKING_LWIP_STATS_ENABLED
+    if (tcpip_lock_depth++ == 0) {
+        tcpip_lock_start_us = AP_HAL::micros();
+    }
+#endif
 }
 
 void sys_unlock_tcpip_core(void)
 {
+#if AP_NETWORKING_LWIP_STATS_ENABLED
+    if (--tcpip_lock_depth == 0) {
+        record_core_time(AP_HAL::micros() - tcpip_lock_start_us);
+    }
+#endif
     tcpip_mutex.give();
 }
 
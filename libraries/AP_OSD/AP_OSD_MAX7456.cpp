@@ -122,6 +122,10 @@
 //time to wait nvm flash complete
 #define MAX_NVM_WAIT 10000
 
+//unchanged characters between changed ones that are rewritten rather
+//than leaving autoincrement mode, which costs more than 4 characters
+#define TRANSFER_MAX_GAP 4
+
 //black and white level
 #ifndef WHITEBRIGHTNESS
 #define WHITEBRIGHTNESS 0x01
@@ -351,6 +355,8 @@ void AP_OSD_MAX7456::reinit()
 
     // force redrawing all screen
     memset(shadow_frame, 0xFF, sizeof(shadow_frame));
+    dirty_rows = UINT16_MAX;
+    content_rows = UINT16_MAX;
 
     initialized = true;
 }
@@ -381,56 +387,72 @@ void AP_OSD_MAX7456::flush()
     transfer_frame();
 }
 
+/*
+  send the changed characters of dirty rows. Each run of changed
+  characters is written with one address and autoincrement mode, with
+  short gaps of unchanged characters rewritten to keep the run going.
+  Rows that don't fit in the buffer stay dirty for the next flush
+ */
 void AP_OSD_MAX7456::transfer_frame()
 {
-    uint16_t previous_pos = UINT16_MAX - 1;
-    bool autoincrement = false;
     if (!initialized) {
         return;
     }
 
     buffer_offset = 0;
     for (uint8_t y=0; y<video_lines; y++) {
-        for (uint8_t x=0; x<video_columns; x++) {
+        if ((dirty_rows & (1U << y)) == 0) {
+            continue;
+        }
+        bool row_complete = true;
+        uint8_t x = 0;
+        while (x < video_columns) {
             if (!is_dirty(x, y)) {
+                x++;
                 continue;
             }
-            //ensure space for 1 char and escape sequence
-            if (buffer_offset >= spi_buffer_size - 32) {
+            //find the end of the run, bridging short gaps
+            uint8_t end = x + 1;
+            for (uint8_t next = end; next < video_columns && next - end <= TRANSFER_MAX_GAP; next++) {
+                if (is_dirty(next, y)) {
+                    end = next + 1;
+                }
+            }
+            const uint8_t len = end - x;
+
+            //ensure space for the address, the characters and the autoincrement escape sequence
+            if (buffer_offset + 2 * (len + 5) > spi_buffer_size) {
+                row_complete = false;
                 break;
             }
-            shadow_frame[y][x] = frame[y][x];
-            uint8_t chr = frame[y][x];
-            uint16_t pos = y * video_columns + x;
-            bool position_changed = ((previous_pos + 1) != pos);
 
-            if (position_changed && autoincrement) {
+            const uint16_t pos = y * video_columns + x;
+            buffer_add_cmd(MAX7456ADD_DMAH, pos >> 8);
+            buffer_add_cmd(MAX7456ADD_DMAL, pos & 0xFF);
+            if (len == 1) {
+                buffer_add_cmd(MAX7456ADD_DMDI, frame[y][x]);
+            } else {
+                buffer_add_cmd(MAX7456ADD_DMM, DMM_AUTOINCREMENT);
+                for (uint8_t i = x; i < end; i++) {
+                    buffer_add_cmd(MAX7456ADD_DMDI, frame[y][i]);
+                }
                 //it is impossible to write to MAX7456ADD_DMAH/MAX7456ADD_DMAL in autoincrement mode
                 //so, exit autoincrement mode
                 buffer_add_cmd(MAX7456ADD_DMDI, 0xFF);
                 buffer_add_cmd(MAX7456ADD_DMM, 0);
-                autoincrement = false;
-            }
-
-            if (!autoincrement) {
-                buffer_add_cmd(MAX7456ADD_DMAH, pos >> 8);
-                buffer_add_cmd(MAX7456ADD_DMAL, pos & 0xFF);
-            }
-
-            if (!autoincrement && is_dirty(x+1, y)) {
-                //(re)enter autoincrement mode
-                buffer_add_cmd(MAX7456ADD_DMM, DMM_AUTOINCREMENT);
-                autoincrement = true;
             }
-
-            buffer_add_cmd(MAX7456ADD_DMDI, chr);
-            previous_pos = pos;
+            memcpy(&shadow_frame[y][x], &frame[y][x], len);
+            x = end;
+        }
+        if (!row_complete) {
+            break;
+        }
+        dirty_rows &= ~(1U << y);
+        if (row_has_content(y)) {
+            content_rows |= (1U << y);
+        } else {
+            content_rows &= ~(1U << y);
         }
-    }
-    if (autoincrement) {
-        buffer_add_cmd(MAX7456ADD_DMDI, 0xFF);
-        buffer_add_cmd(MAX7456ADD_DMM, 0);
-        autoincrement = false;
     }
 
     if (buffer_offset > 0) {
@@ -448,10 +470,23 @@ bool AP_OSD_MAX7456::is_dirty(uint8_t x, uint8_t y)
     return frame[y][x] != shadow_frame[y][x];
 }
 
+// return true if row y of the shadow frame has anything but spaces
+bool AP_OSD_MAX7456::row_has_content(uint8_t y) const
+{
+    for (uint8_t x=0; x<video_columns; x++) {
+        if (shadow_frame[y][x] != ' ') {
+            return true;
+        }
+    }
+    return false;
+}
+
 void AP_OSD_MAX7456::clear()
 {
     AP_OSD_Backend::clear();
     memset(frame, ' ', sizeof(frame));
+    // only rows that were showing something need sending again
+    dirty_rows |= content_rows;
 }
 
 void AP_OSD_MAX7456::write(uint8_t x, uint8_t y, const char* text)
@@ -460,6 +495,9 @@ void AP_OSD_MAX7456::write(uint8_t x, uint8_t y, const char* text)
         return;
     }
     while ((x < VIDEO_COLUMNS) && (*text != 0)) {
+        if (uint8_t(*text) != shadow_frame[y][x]) {
+            dirty_rows |= (1U << y);
+        }
         frame[y][x] = *text;
         ++text;
         ++x;
@@ -80,6 +80,8 @@ private:
 
     bool is_dirty(uint8_t x, uint8_t y);
 
+    bool row_has_content(uint8_t y) const;
+
     AP_HAL::OwnPtr<AP_HAL::Device> _dev;
 
     uint8_t  video_signal_reg;
@@ -99,6 +101,13 @@ private:
     //used to optimize number of characters updated
     uint8_t shadow_frame[video_lines_pal][video_columns];
 
+    //rows with characters differing from shadow_frame, so unchanged
+    //rows are not scanned when transferring
+    uint16_t dirty_rows;
+    //rows of shadow_frame that are not blank, these become dirty on clear()
+    uint16_t content_rows;
+    static_assert(video_lines_pal <= 16, "rows must fit in dirty_rows");
+
     uint8_t buffer[spi_buffer_size];
     int buffer_offset;
 
@@ -25,8 +25,10 @@
 
 #include <cmath>
 #include <string.h>
+#include <ctype.h>
 
 #include <AP_Common/AP_Common.h>
+#include <AP_Common/ExpandingString.h>
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Math/AP_Math.h>
 #include <GCS_MAVLink/GCS.h>
@@ -104,6 +106,23 @@ uint16_t AP_Param::_count_marker;
 uint16_t AP_Param::_count_marker_done;
 HAL_Semaphore AP_Param::_count_sem;
 
+AP_Param::LoadTiming AP_Param::_load_timing;
+
+#if AP_PARAM_NAME_INDEX_ENABLED
+AP_Param::NameIndexEntry *AP_Param::_name_index;
+uint16_t AP_Param::_name_index_count;
+uint16_t AP_Param::_name_index_num_vars;
+uint16_t AP_Param::_name_index_marker;
+uint16_t AP_Param::_name_index_lookup_marker;
+uint8_t AP_Param::_name_index_lookups;
+HAL_Semaphore AP_Param::_name_index_sem;
+
+// lookups made after the parameter set changes before the name index
+// is rebuilt, so that many changes in a row, such as enable
+// parameters being loaded at boot, don't each cause a rebuild
+#define NAME_INDEX_REBUILD_LOOKUPS 8
+#endif
+
 // storage and naming information about all types that can be saved
 const AP_Param::Info *AP_Param::_var_info;
 
@@ -117,6 +136,13 @@ bool AP_Param::eeprom_full;
 
 ObjectBuffer_TS<AP_Param::param_save> AP_Param::save_queue{30};
 bool AP_Param::registered_save_handler;
+AP_Param::SaveStats AP_Param::_save_stats;
+
+#if AP_PARAM_SAVE_COALESCE_ENABLED
+AP_Param::pending_save AP_Param::_save_pending[AP_PARAM_SAVE_COALESCE_SLOTS];
+uint8_t AP_Param::_save_pending_count;
+bool AP_Param::_save_flush_requested;
+#endif
 
 bool AP_Param::done_all_default_params;
 
@@ -912,11 +938,168 @@ AP_Param::find_group(const char *name, uint16_t vindex, ptrdiff_t group_offset,
 }
 
 
+/*
+  shell sort, used to sort tables too large for an insertion sort
+  without the stack use of a recursive sort
+ */
+template <typename T, typename Less>
+static void shell_sort(T *a, uint16_t n, Less less)
+{
+    for (uint16_t gap = n/2; gap > 0; gap /= 2) {
+        for (uint16_t i = gap; i < n; i++) {
+            const T e = a[i];
+            uint16_t j = i;
+            for (; j >= gap && less(e, a[j-gap]); j -= gap) {
+                a[j] = a[j-gap];
+            }
+            a[j] = e;
+        }
+    }
+}
+
+#if AP_PARAM_NAME_INDEX_ENABLED
+/*
+  case insensitive 16 bit FNV-1a hash of a parameter name
+ */
+uint16_t AP_Param::name_hash(const char *name)
+{
+    uint32_t hash = 2166136261U;
+    for (uint8_t i=0; i<AP_MAX_NAME_SIZE && name[i] != 0; i++) {
+        hash = (hash ^ uint8_t(toupper(name[i]))) * 16777619U;
+    }
+    return (hash >> 16) ^ (hash & 0xFFFF);
+}
+
+/*
+  build the name index from a walk of all scalar parameters. Called
+  with _name_index_sem held
+ */
+void AP_Param::name_index_build(void)
+{
+    const uint16_t marker = _count_marker;
+    const uint16_t count = count_parameters();
+
+    if (count > _name_index_count || _name_index == nullptr) {
+        delete[] _name_index;
+        _name_index_count = 0;
+        _name_index = NEW_NOTHROW NameIndexEntry[count];
+        if (_name_index == nullptr) {
+            return;
+        }
+    }
+
+    ParamToken token {};
+    enum ap_var_type type;
+    uint16_t n = 0;
+    for (AP_Param *ap = first(&token, &type);
+         ap != nullptr && n < count;
+         ap = next_scalar(&token, &type)) {
+        char name[AP_MAX_NAME_SIZE+1];
+        ap->copy_name_token(token, name, sizeof(name), true);
+        name[AP_MAX_NAME_SIZE] = 0;
+        _name_index[n++] = { ap, token, name_hash(name), uint8_t(type) };
+    }
+
+    shell_sort(_name_index, n, [](const NameIndexEntry &a, const NameIndexEntry &b) {
+        return a.hash < b.hash;
+    });
+
+    _name_index_count = n;
+    _name_index_num_vars = _num_vars;
+    _name_index_marker = marker;
+}
+
+/*
+  return true if the name index is up to date, rebuilding it if
+  needed. Called with _name_index_sem held
+ */
+bool AP_Param::name_index_update(void)
+{
+    if (_name_index != nullptr &&
+        _name_index_marker == _count_marker &&
+        _name_index_num_vars == _num_vars) {
+        return true;
+    }
+    if (_name_index_lookup_marker != _count_marker) {
+        _name_index_lookup_marker = _count_marker;
+        _name_index_lookups = 0;
+    }
+    if (_num_vars == 0 || ++_name_index_lookups < NAME_INDEX_REBUILD_LOOKUPS) {
+        return false;
+    }
+    name_index_build();
+    // the parameters may have changed while building
+    return _name_index != nullptr && _name_index_marker == _count_marker;
+}
+
+AP_Param *AP_Param::name_index_find(const char *name, enum ap_var_type *ptype, ParamToken *token)
+{
+    // while another thread is building the index fall back to the
+    // walk rather than waiting
+    if (!_name_index_sem.take_nonblocking()) {
+        return nullptr;
+    }
+    if (!name_index_update()) {
+        _name_index_sem.give();
+        return nullptr;
+    }
+
+    // find the first entry with the hash
+    const uint16_t hash = name_hash(name);
+    uint16_t lo = 0, hi = _name_index_count;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (_name_index[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    AP_Param *ret = nullptr;
+    for (uint16_t i = lo; i < _name_index_count && _name_index[i].hash == hash; i++) {
+        const NameIndexEntry &e = _name_index[i];
+        char buf[AP_MAX_NAME_SIZE+1];
+        e.ap->copy_name_token(e.token, buf, sizeof(buf), true);
+        buf[AP_MAX_NAME_SIZE] = 0;
+        if (strncasecmp(name, buf, AP_MAX_NAME_SIZE) == 0) {
+            *ptype = (enum ap_var_type)e.type;
+            if (token != nullptr) {
+                *token = e.token;
+            }
+            ret = e.ap;
+            break;
+        }
+    }
+    _name_index_sem.give();
+    return ret;
+}
+#endif // AP_PARAM_NAME_INDEX_ENABLED
+
 // Find a variable by name.
 //
 AP_Param *
 AP_Param::find(const char *name, enum ap_var_type *ptype, uint16_t *flags)
 {
+#if AP_PARAM_NAME_INDEX_ENABLED
+    enum ap_var_type itype;
+    AP_Param *iap = name_index_find(name, &itype, nullptr);
+    if (iap != nullptr) {
+        *ptype = itype;
+        if (flags != nullptr) {
+            uint32_t group_element = 0;
+            const struct GroupInfo *ginfo;
+            struct GroupNesting group_nesting {};
+            uint8_t idx;
+            iap->find_var_info(&group_element, ginfo, group_nesting, &idx);
+            if (ginfo != nullptr) {
+                *flags = ginfo->flags;
+            }
+        }
+        return iap;
+    }
+#endif
+
     for (uint16_t i=0; i<_num_vars; i++) {
         const auto &info = var_info(i);
         uint8_t type = info.type;
@@ -976,6 +1159,12 @@ AP_Param::find_by_index(uint16_t idx, enum ap_var_type *ptype, ParamToken *token
 // by-name equivalent of find_by_index()
 AP_Param* AP_Param::find_by_name(const char* name, enum ap_var_type *ptype, ParamToken *token)
 {
+#if AP_PARAM_NAME_INDEX_ENABLED
+    AP_Param *iap = name_index_find(name, ptype, token);
+    if (iap != nullptr) {
+        return iap;
+    }
+#endif
     AP_Param *ap;
     for (ap = AP_Param::first(token, ptype);
          ap && *ptype != AP_PARAM_GROUP && *ptype != AP_PARAM_NONE;
@@ -1277,6 +1466,7 @@ void AP_Param::save(bool force_save)
         if (hal.util->get_soft_armed() && hal.scheduler->in_main_thread()) {
             // if we are armed in main thread then don't sleep, instead we lose the
             // parameter save
+            _save_stats.dropped++;
             INTERNAL_ERROR(AP_InternalError::error_t::flow_of_control);
             return;
         }
@@ -1287,6 +1477,7 @@ void AP_Param::save(bool force_save)
         hal.scheduler->delay_microseconds(500);
         hal.scheduler->expect_delay_ms(0);
     }
+    _save_stats.queue_max = MAX(_save_stats.queue_max, save_queue.available());
 }
 
 /*
@@ -1295,22 +1486,153 @@ void AP_Param::save(bool force_save)
 void AP_Param::save_io_handler(void)
 {
     struct param_save p;
+#if AP_PARAM_SAVE_COALESCE_ENABLED
+    // while armed a save is held back for AP_PARAM_SAVE_COALESCE_MS
+    // from when it was first queued, and further saves of the same
+    // parameter in that time are merged with it. A parameter changed
+    // continuously by tuning or a script is written once per interval
+    const bool coalesce = AP_PARAM_SAVE_COALESCE_MS > 0 && hal.util->get_soft_armed();
+    const uint32_t now_ms = AP_HAL::millis();
+    while (save_queue.pop(p)) {
+        if (coalesce) {
+            save_pending_add(p, now_ms);
+        } else {
+            p.param->save_sync(p.force_save, true);
+            _save_stats.written++;
+        }
+    }
+
+    // write everything pending on disarm or when flushed
+    const bool write_all = !coalesce || _save_flush_requested;
+    _save_flush_requested = false;
+    for (uint8_t i=0; i<_save_pending_count; ) {
+        if (write_all || now_ms - _save_pending[i].first_ms >= AP_PARAM_SAVE_COALESCE_MS) {
+            save_pending_write(i);
+        } else {
+            i++;
+        }
+    }
+#else
     while (save_queue.pop(p)) {
         p.param->save_sync(p.force_save, true);
+        _save_stats.written++;
     }
+#endif
     if (hal.scheduler->is_system_initialized()) {
         // pay the cost of parameter counting in the IO thread
         count_parameters();
     }
 }
 
+#if AP_PARAM_SAVE_COALESCE_ENABLED
+/*
+  hold back a save, merging it with a pending save of the same
+  parameter. The value is read when the save is written so the last
+  value wins
+ */
+void AP_Param::save_pending_add(const param_save &p, uint32_t now_ms)
+{
+    // the GCS expects to see the new value now, not when it is written
+    p.param->send_saved_value();
+
+    for (uint8_t i=0; i<_save_pending_count; i++) {
+        if (_save_pending[i].param == p.param) {
+            _save_pending[i].force_save |= p.force_save;
+            _save_stats.coalesced++;
+            return;
+        }
+    }
+    if (_save_pending_count == ARRAY_SIZE(_save_pending)) {
+        // make room by writing the oldest
+        uint8_t oldest = 0;
+        for (uint8_t i=1; i<_save_pending_count; i++) {
+            if (now_ms - _save_pending[i].first_ms > now_ms - _save_pending[oldest].first_ms) {
+                oldest = i;
+            }
+        }
+        save_pending_write(oldest);
+    }
+    _save_pending[_save_pending_count++] = { p.param, now_ms, p.force_save };
+}
+
+/*
+  write a pending save and remove it from the list
+ */
+void AP_Param::save_pending_write(uint8_t i)
+{
+    const pending_save &ps = _save_pending[i];
+    // the value was sent to the GCS when the save was queued
+    ps.param->save_sync(ps.force_save, false);
+    _save_stats.written++;
+    _save_pending[i] = _save_pending[--_save_pending_count];
+}
+
+/*
+  send the value of a parameter being saved to the GCS, unless it is
+  hidden
+ */
+void AP_Param::send_saved_value(void) const
+{
+    uint32_t group_element = 0;
+    const struct GroupInfo *ginfo;
+    struct GroupNesting group_nesting {};
+    uint8_t idx;
+    const struct AP_Param::Info *info = find_var_info(&group_element, ginfo, group_nesting, &idx);
+    if (info == nullptr) {
+        return;
+    }
+    const uint16_t flags = ginfo != nullptr ? ginfo->flags : info->flags;
+    if (flags & AP_PARAM_FLAG_HIDDEN) {
+        return;
+    }
+    char name[AP_MAX_NAME_SIZE+1];
+    copy_name_info(info, ginfo, group_nesting, idx, name, sizeof(name), true);
+    send_parameter(name, (enum ap_var_type)(ginfo != nullptr ? ginfo->type : info->type), idx);
+}
+#endif // AP_PARAM_SAVE_COALESCE_ENABLED
+
+/*
+  report the save queue statistics
+ */
+void AP_Param::save_info(ExpandingString &str)
+{
+    str.printf("queued=%u max=%u written=%u coalesced=%u dropped=%u\n",
+               unsigned(save_queue.available()),
+               unsigned(_save_stats.queue_max),
+               unsigned(_save_stats.written),
+               unsigned(_save_stats.coalesced),
+               unsigned(_save_stats.dropped));
+#if AP_PARAM_SAVE_COALESCE_ENABLED
+    str.printf("pending=%u coalesce_ms=%u\n",
+               unsigned(_save_pending_count),
+               unsigned(AP_PARAM_SAVE_COALESCE_MS));
+#endif
+}
+
+/*
+  return true if there are saves not yet written
+ */
+bool AP_Param::saves_pending(void)
+{
+#if AP_PARAM_SAVE_COALESCE_ENABLED
+    if (_save_pending_count > 0) {
+        return true;
+    }
+#endif
+    return save_queue.available() > 0;
+}
+
 /*
   wait for all parameters to save
 */
 void AP_Param::flush(void)
 {
     uint16_t counter = 200; // 2 seconds max
-    while (counter-- && save_queue.available()) {
+    while (counter-- && saves_pending()) {
+#if AP_PARAM_SAVE_COALESCE_ENABLED
+        // don't wait for saves held back while armed
+        _save_flush_requested = true;
+#endif
         hal.scheduler->expect_delay_ms(10);
         hal.scheduler->delay(10);
         hal.scheduler->expect_delay_ms(0);
@@ -1426,14 +1748,12 @@ bool AP_Param::configured_in_defaults_file(bool &read_only) const
         return false;
     }
 
-    for (uint16_t i=0; i<num_param_overrides; i++) {
-        if (this == param_overrides[i].object_ptr) {
-            read_only = param_overrides[i].read_only;
-            return true;
-        }
+    const struct param_override *po = find_param_override(this);
+    if (po == nullptr) {
+        return false;
     }
-
-    return false;
+    read_only = po->read_only;
+    return true;
 }
 
 bool AP_Param::configured(void) const
@@ -1570,8 +1890,7 @@ void AP_Param::setup_sketch_defaults(void)
 //
 bool AP_Param::load_all()
 {
-    struct Param_header phdr;
-    uint16_t ofs = sizeof(AP_Param::EEPROM_header);
+    const uint32_t start_us = AP_HAL::micros();
 
     reload_defaults_file(false);
 
@@ -1579,7 +1898,34 @@ bool AP_Param::load_all()
         registered_save_handler = true;
         hal.scheduler->register_io_process(FUNCTOR_BIND((&save_dummy), &AP_Param::save_io_handler, void));
     }
-    
+
+    const uint32_t load_start_us = AP_HAL::micros();
+    _load_timing = {};
+    _load_timing.defaults_us = load_start_us - start_us;
+
+#if AP_PARAM_SORTED_LOAD_ENABLED
+    bool found_sentinal;
+    if (load_all_sorted(found_sentinal)) {
+        if (!found_sentinal) {
+            Debug("no sentinal in load_all");
+        }
+        return found_sentinal;
+    }
+#endif
+
+    const bool ret = load_all_headers();
+    _load_timing.load_us = AP_HAL::micros() - load_start_us;
+    return ret;
+}
+
+/*
+  load all variables by looking up each header in storage in turn
+ */
+bool AP_Param::load_all_headers(void)
+{
+    struct Param_header phdr;
+    uint16_t ofs = sizeof(AP_Param::EEPROM_header);
+
     while (ofs < _storage.size()) {
         _storage.read_block(&phdr, ofs, sizeof(phdr));
         if (is_sentinal(phdr)) {
@@ -1595,6 +1941,7 @@ bool AP_Param::load_all()
         if (info != nullptr) {
             _storage.read_block(ptr, ofs+sizeof(phdr), type_size((enum ap_var_type)phdr.type));
         }
+        _load_timing.headers++;
 
         ofs += type_size((enum ap_var_type)phdr.type) + sizeof(phdr);
     }
@@ -1604,6 +1951,178 @@ bool AP_Param::load_all()
     return false;
 }
 
+#if AP_PARAM_SORTED_LOAD_ENABLED
+/*
+  find the last header in storage with an id in a sorted list
+ */
+const AP_Param::StoredHeader *AP_Param::find_stored_header(const StoredHeader *hdrs, uint16_t n, uint32_t id)
+{
+    // find the first header after the id
+    uint16_t lo = 0, hi = n;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (hdrs[mid].id <= id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0 || hdrs[lo-1].id != id) {
+        return nullptr;
+    }
+    return &hdrs[lo-1];
+}
+
+/*
+  load the variables in a group from the headers with its key
+ */
+void AP_Param::load_group_sorted(const StoredHeader *hdrs, uint16_t n,
+                                 uint16_t vindex,
+                                 const struct GroupInfo *group_info,
+                                 uint32_t group_base,
+                                 uint8_t group_shift,
+                                 ptrdiff_t group_offset)
+{
+    const uint16_t key = var_info(vindex).key;
+    uint8_t type;
+    for (uint8_t i=0;
+         (type=group_info[i].type) != AP_PARAM_NONE;
+         i++) {
+        if (type == AP_PARAM_GROUP) {
+            // a nested group
+            if (group_shift + _group_level_shift >= _group_bits) {
+                return;
+            }
+            const struct GroupInfo *ginfo = get_group_info(group_info[i]);
+            if (ginfo == nullptr) {
+                continue;
+            }
+            ptrdiff_t new_offset = group_offset;
+            if (!adjust_group_offset(vindex, group_info[i], new_offset)) {
+                continue;
+            }
+            load_group_sorted(hdrs, n, vindex, ginfo,
+                              group_id(group_info, group_base, i, group_shift),
+                              group_shift + _group_level_shift, new_offset);
+            continue;
+        }
+        const uint32_t id = stored_header_id(key, group_id(group_info, group_base, i, group_shift), type);
+        const StoredHeader *h = find_stored_header(hdrs, n, id);
+        if (h == nullptr) {
+            continue;
+        }
+        ptrdiff_t base;
+        if (!get_base(var_info(vindex), base)) {
+            continue;
+        }
+        _storage.read_block((void*)(base + group_info[i].offset + group_offset),
+                            h->ofs+sizeof(Param_header), type_size((enum ap_var_type)type));
+    }
+}
+
+/*
+  load all variables with one walk of the var_info tree, looking up
+  each variable in a sorted list of the headers in storage, rather
+  than walking the tree for every header. Where a header appears
+  more than once the last in storage wins, as with
+  load_all_headers(). Returns false if there is not enough memory
+  for the list
+ */
+bool AP_Param::load_all_sorted(bool &found_sentinal)
+{
+    const uint32_t start_us = AP_HAL::micros();
+
+    // count the headers
+    struct Param_header phdr;
+    uint16_t n = 0;
+    uint16_t ofs = sizeof(AP_Param::EEPROM_header);
+    found_sentinal = false;
+    while (ofs < _storage.size()) {
+        _storage.read_block(&phdr, ofs, sizeof(phdr));
+        if (is_sentinal(phdr)) {
+            found_sentinal = true;
+            break;
+        }
+        n++;
+        ofs += type_size((enum ap_var_type)phdr.type) + sizeof(phdr);
+    }
+    if (n == 0) {
+        if (found_sentinal) {
+            sentinal_offset = ofs;
+        }
+        _load_timing.scan_us = AP_HAL::micros() - start_us;
+        return true;
+    }
+
+    StoredHeader *hdrs = NEW_NOTHROW StoredHeader[n];
+    if (hdrs == nullptr) {
+        return false;
+    }
+    ofs = sizeof(AP_Param::EEPROM_header);
+    for (uint16_t i=0; i<n; i++) {
+        _storage.read_block(&phdr, ofs, sizeof(phdr));
+        hdrs[i] = { stored_header_id(get_key(phdr), phdr.group_element, phdr.type), ofs };
+        ofs += type_size((enum ap_var_type)phdr.type) + sizeof(phdr);
+    }
+    if (found_sentinal) {
+        sentinal_offset = ofs;
+    }
+    shell_sort(hdrs, n, [](const StoredHeader &a, const StoredHeader &b) {
+        return a.id < b.id || (a.id == b.id && a.ofs < b.ofs);
+    });
+
+    const uint32_t load_start_us = AP_HAL::micros();
+
+    for (uint16_t i=0; i<_num_vars; i++) {
+        const auto &info = var_info(i);
+        // find the headers with this key
+        const uint32_t key_id = stored_header_id(info.key, 0, 0);
+        uint16_t lo = 0, hi = n;
+        while (lo < hi) {
+            const uint16_t mid = (lo + hi) / 2;
+            if (hdrs[mid].id < key_id) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        uint16_t end = lo;
+        while (end < n && (hdrs[end].id >> 23) == info.key) {
+            end++;
+        }
+        if (end == lo) {
+            continue;
+        }
+        if (info.type == AP_PARAM_GROUP) {
+            const struct GroupInfo *group_info = get_group_info(info);
+            if (group_info != nullptr) {
+                load_group_sorted(&hdrs[lo], end-lo, i, group_info, 0, 0, 0);
+            }
+            continue;
+        }
+        // a top level variable matches any group element, take the
+        // last in storage of its type
+        const StoredHeader *h = nullptr;
+        for (uint16_t j=lo; j<end; j++) {
+            if ((hdrs[j].id & 0x1F) == info.type && (h == nullptr || hdrs[j].ofs > h->ofs)) {
+                h = &hdrs[j];
+            }
+        }
+        ptrdiff_t base;
+        if (h != nullptr && get_base(info, base)) {
+            _storage.read_block((void*)base, h->ofs+sizeof(Param_header), type_size((enum ap_var_type)info.type));
+        }
+    }
+
+    delete[] hdrs;
+
+    _load_timing.headers = n;
+    _load_timing.scan_us = load_start_us - start_us;
+    _load_timing.load_us = AP_HAL::micros() - load_start_us;
+    return true;
+}
+#endif // AP_PARAM_SORTED_LOAD_ENABLED
+
 /*
  * reload from hal.util defaults file or embedded param region
  * @last_pass: if this is the last pass on defaults - unknown parameters are
@@ -1618,6 +2137,14 @@ void AP_Param::reload_defaults_file(bool last_pass)
       defaults using that file
      */
     const char *default_file = hal.util->get_custom_defaults_file();
+#if AP_PARAM_DEFAULTS_TABLE_ENABLED
+    // the table was built from the same file, so there is no need to
+    // parse the text
+    if (default_file) {
+        load_defaults_table(last_pass);
+        default_file = nullptr;
+    }
+#endif
     if (default_file) {
 #if AP_FILESYSTEM_FILE_READING_ENABLED
         load_defaults_file_from_filesystem(default_file, last_pass);
@@ -2389,6 +2916,7 @@ bool AP_Param::read_param_defaults_file(const char *filename, bool last_pass, ui
         param_overrides[idx].object_ptr = vp;
         param_overrides[idx].value = value;
         param_overrides[idx].read_only = read_only;
+        param_overrides[idx].order = idx;
         if (read_only) {
             num_read_only++;
         }
@@ -2463,6 +2991,7 @@ bool AP_Param::load_defaults_file(const char *filename, bool last_pass)
     free(mutable_filename);
 
     num_param_overrides = num_defaults;
+    sort_param_overrides();
 
     return true;
 }
@@ -2584,6 +3113,7 @@ void AP_Param::load_param_defaults(const volatile char *ptr, int32_t length, boo
         param_overrides[idx].object_ptr = vp;
         param_overrides[idx].value = value;
         param_overrides[idx].read_only = read_only;
+        param_overrides[idx].order = idx;
         if (read_only) {
             num_read_only++;
         }
@@ -2593,10 +3123,132 @@ void AP_Param::load_param_defaults(const volatile char *ptr, int32_t length, boo
         }
     }
     num_param_overrides = num_defaults;
+    sort_param_overrides();
 }
 #endif // AP_PARAM_MAX_EMBEDDED_PARAM > 0 || defined(HAL_HAVE_AP_ROMFS_EMBEDDED_H)
 
 
+#if AP_PARAM_DEFAULTS_TABLE_ENABLED
+/*
+  board defaults, generated by the build from defaults.parm and
+  sorted by name. Repeated names have been resolved to the last one
+ */
+static const struct {
+    char name[AP_MAX_NAME_SIZE+1];
+    float value;
+    bool read_only;
+} param_defaults_table[] = {
+    HAL_PARAM_DEFAULTS_TABLE
+};
+
+/*
+ * load the board defaults from the table generated at build time
+ * @last_pass: if this is the last pass on defaults - unknown parameters are
+ *             ignored but if this is set a warning will be emitted
+ */
+void AP_Param::load_defaults_table(bool last_pass)
+{
+    delete[] param_overrides;
+    param_overrides_len = 0;
+    num_param_overrides = 0;
+    num_read_only = 0;
+
+    // parameters not in this vehicle leave the end unused
+    param_overrides = NEW_NOTHROW param_override[ARRAY_SIZE(param_defaults_table)];
+    if (param_overrides == nullptr) {
+        AP_HAL::panic("AP_Param: Failed to allocate overrides");
+        return;
+    }
+    param_overrides_len = ARRAY_SIZE(param_defaults_table);
+
+    bool done_all = true;
+    uint16_t idx = 0;
+    for (const auto &d : param_defaults_table) {
+        enum ap_var_type var_type;
+        AP_Param *vp = find(d.name, &var_type);
+        if (!vp) {
+            if (last_pass) {
+#if ENABLE_DEBUG
+                ::printf("Ignored unknown param %s in defaults table\n", d.name);
+                hal.console->printf("Ignored unknown param %s in defaults table\n", d.name);
+#endif
+            }
+            done_all = false;
+            continue;
+        }
+        param_overrides[idx].object_ptr = vp;
+        param_overrides[idx].value = d.value;
+        param_overrides[idx].read_only = d.read_only;
+        param_overrides[idx].order = idx;
+        if (d.read_only) {
+            num_read_only++;
+        }
+        idx++;
+        if (!vp->configured_in_storage()) {
+            vp->set_float(d.value, var_type);
+        }
+    }
+    num_param_overrides = idx;
+    sort_param_overrides();
+
+    done_all_default_params = done_all;
+}
+#endif  // AP_PARAM_DEFAULTS_TABLE_ENABLED
+
+/*
+  sort param_overrides by object pointer so lookups can binary
+  search. Where a parameter is given more than once the last one
+  wins, which is the value that was set on the parameter
+ */
+void AP_Param::sort_param_overrides(void)
+{
+    if (num_param_overrides < 2) {
+        return;
+    }
+    shell_sort(param_overrides, num_param_overrides, [](const param_override &a, const param_override &b) {
+        if (a.object_ptr != b.object_ptr) {
+            return uintptr_t(a.object_ptr) < uintptr_t(b.object_ptr);
+        }
+        return a.order < b.order;
+    });
+
+    uint16_t n = 0;
+    num_read_only = 0;
+    for (uint16_t i=0; i<num_param_overrides; i++) {
+        if (i+1 < num_param_overrides &&
+            param_overrides[i+1].object_ptr == param_overrides[i].object_ptr) {
+            continue;
+        }
+        param_overrides[n] = param_overrides[i];
+        if (param_overrides[n].read_only) {
+            num_read_only++;
+        }
+        n++;
+    }
+    num_param_overrides = n;
+}
+
+/*
+  find the override for a parameter in the sorted param_overrides
+ */
+const struct AP_Param::param_override *AP_Param::find_param_override(const AP_Param *ap)
+{
+    uint16_t lo = 0;
+    uint16_t hi = num_param_overrides;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (uintptr_t(param_overrides[mid].object_ptr) < uintptr_t(ap)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < num_param_overrides && param_overrides[lo].object_ptr == ap) {
+        return &param_overrides[lo];
+    }
+    return nullptr;
+}
+
 #if AP_PARAM_MAX_EMBEDDED_PARAM > 0
 /*
  * load a default set of parameters from a embedded parameter region
@@ -2615,10 +3267,9 @@ void AP_Param::load_embedded_param_defaults(bool last_pass)
  */
 float AP_Param::get_default_value(const AP_Param *vp, const struct GroupInfo &info)
 {
-    for (uint16_t i=0; i<num_param_overrides; i++) {
-        if (vp == param_overrides[i].object_ptr) {
-            return param_overrides[i].value;
-        }
+    const struct param_override *po = find_param_override(vp);
+    if (po != nullptr) {
+        return po->value;
     }
     if ((info.flags & AP_PARAM_FLAG_DEFAULT_POINTER) != 0) {
         return *((float*)((ptrdiff_t)vp - info.def_value_offset));
@@ -2628,10 +3279,9 @@ float AP_Param::get_default_value(const AP_Param *vp, const struct GroupInfo &in
 
 float AP_Param::get_default_value(const AP_Param *vp, const struct Info &info)
 {
-    for (uint16_t i=0; i<num_param_overrides; i++) {
-        if (vp == param_overrides[i].object_ptr) {
-            return param_overrides[i].value;
-        }
+    const struct param_override *po = find_param_override(vp);
+    if (po != nullptr) {
+        return po->value;
     }
     if ((info.flags & AP_PARAM_FLAG_DEFAULT_POINTER) != 0) {
         return *((float*)((ptrdiff_t)vp - info.def_value_offset));
@@ -2908,10 +3558,8 @@ void AP_Param::check_default(AP_Param *ap, float *default_value)
 void AP_Param::add_default(AP_Param *ap, float v)
 {
     // Embedded defaults trump runtime, don't allow override
-    for (uint16_t i=0; i<num_param_overrides; i++) {
-        if (ap == param_overrides[i].object_ptr) {
-            return;
-        }
+    if (find_param_override(ap) != nullptr) {
+        return;
     }
 
     if (default_list != nullptr) {
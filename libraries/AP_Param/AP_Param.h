@@ -35,6 +35,8 @@
 
 #define AP_MAX_NAME_SIZE 16
 
+class ExpandingString;
+
 // optionally enable debug code for dumping keys
 #ifndef AP_PARAM_KEY_DUMP
 #define AP_PARAM_KEY_DUMP 0
@@ -414,6 +416,18 @@ public:
     ///
     void save(bool force_save=false);
 
+    // statistics of the background save queue
+    struct SaveStats {
+        uint16_t queue_max;     // most saves waiting in the queue
+        uint32_t written;       // saves written to storage
+        uint32_t coalesced;     // saves merged with a pending save
+        uint32_t dropped;       // saves lost with the queue full
+    };
+    static const SaveStats &get_save_stats() { return _save_stats; }
+
+    // report the save queue statistics as text
+    static void save_info(ExpandingString &str);
+
     /// Load the variable from EEPROM.
     ///
     /// @return                True if the variable was loaded successfully.
@@ -441,6 +455,15 @@ public:
     // returns storage space :
     static uint16_t storage_size() { return _storage.size(); }
 
+    // time taken by each phase of the last load_all()
+    struct LoadTiming {
+        uint32_t defaults_us;   // loading the defaults file
+        uint32_t scan_us;       // reading and sorting the headers
+        uint32_t load_us;       // loading the values
+        uint16_t headers;       // headers in storage
+    };
+    static const LoadTiming &get_load_timing() { return _load_timing; }
+
     /// reoad the hal.util defaults file. Called after pointer parameters have been allocated
     ///
     static void reload_defaults_file(bool last_pass);
@@ -734,6 +757,29 @@ private:
     static const struct Info *  find_by_header(
                                     struct Param_header phdr,
                                     void **ptr);
+    static bool                 load_all_headers(void);
+#if AP_PARAM_SORTED_LOAD_ENABLED
+    // a header in storage, with the key, group element and type
+    // packed so they sort in that order
+    struct StoredHeader {
+        uint32_t id;
+        uint16_t ofs;
+    };
+    static uint32_t             stored_header_id(uint16_t key, uint32_t group_element, uint8_t type) {
+        return (uint32_t(key) << 23) | (group_element << 5) | type;
+    }
+    static const StoredHeader * find_stored_header(
+                                    const StoredHeader *hdrs, uint16_t n,
+                                    uint32_t id);
+    static bool                 load_all_sorted(bool &found_sentinal);
+    static void                 load_group_sorted(
+                                    const StoredHeader *hdrs, uint16_t n,
+                                    uint16_t vindex,
+                                    const struct GroupInfo *group_info,
+                                    uint32_t group_base,
+                                    uint8_t group_shift,
+                                    ptrdiff_t group_offset);
+#endif
     void                        add_vector3f_suffix(
                                     char *buffer,
                                     size_t buffer_size,
@@ -788,6 +834,11 @@ private:
     // load defaults from supplied string:
     static void load_param_defaults(const volatile char *ptr, int32_t length, bool last_pass);
 
+#if AP_PARAM_DEFAULTS_TABLE_ENABLED
+    // load defaults from the table generated at build time:
+    static void load_defaults_table(bool last_pass);
+#endif
+
     /*
       load defaults from embedded parameters
      */
@@ -818,6 +869,36 @@ private:
     static uint16_t             _count_marker_done;
     static HAL_Semaphore        _count_sem;
     static const struct Info *  _var_info;
+    static LoadTiming           _load_timing;
+
+#if AP_PARAM_NAME_INDEX_ENABLED
+    /*
+      index of the scalar parameters sorted by a hash of their names,
+      built on the first lookups by name and rebuilt after the set of
+      parameters changes
+     */
+    struct NameIndexEntry {
+        AP_Param *ap;
+        ParamToken token;
+        uint16_t hash;
+        uint8_t type;
+    };
+    static NameIndexEntry *     _name_index;
+    static uint16_t             _name_index_count;
+    static uint16_t             _name_index_num_vars;
+    static uint16_t             _name_index_marker;
+    static uint16_t             _name_index_lookup_marker;
+    static uint8_t              _name_index_lookups;
+    static HAL_Semaphore        _name_index_sem;
+
+    static uint16_t name_hash(const char *name);
+    static void name_index_build(void);
+    static bool name_index_update(void);
+
+    // find a parameter using the index, returning nullptr if it is
+    // not indexed or the index is out of date
+    static AP_Param *name_index_find(const char *name, enum ap_var_type *ptype, ParamToken *token);
+#endif
 
 #if AP_PARAM_DYNAMIC_ENABLED
     // allow for a dynamically allocated var table
@@ -841,12 +922,18 @@ private:
         const AP_Param *object_ptr;
         float value;
         bool read_only; // param is marked @READONLY
+        uint16_t order; // position in the defaults, later ones win
     };
     static struct param_override *param_overrides;
     static uint16_t num_param_overrides;
     static uint16_t param_overrides_len;
     static uint16_t num_read_only;
 
+    // sort param_overrides by object_ptr, dropping repeated entries
+    static void sort_param_overrides(void);
+    // binary search of the sorted param_overrides
+    static const struct param_override *find_param_override(const AP_Param *ap);
+
     // values filled into the EEPROM header
     static const uint8_t        k_EEPROM_magic0      = 0x50;
     static const uint8_t        k_EEPROM_magic1      = 0x41; ///< "AP"
@@ -866,6 +953,26 @@ private:
     // background function for saving parameters
     void save_io_handler(void);
 
+    static SaveStats _save_stats;
+    static bool saves_pending(void);
+
+#if AP_PARAM_SAVE_COALESCE_ENABLED
+    // a save held back in the IO thread for up to
+    // AP_PARAM_SAVE_COALESCE_MS after it was first queued
+    struct pending_save {
+        AP_Param *param;
+        uint32_t first_ms;
+        bool force_save;
+    };
+    static pending_save _save_pending[AP_PARAM_SAVE_COALESCE_SLOTS];
+    static uint8_t _save_pending_count;
+    static bool _save_flush_requested;
+
+    void save_pending_add(const param_save &p, uint32_t now_ms);
+    void save_pending_write(uint8_t i);
+    void send_saved_value(void) const;
+#endif
+
     // Store default values from add_default() calls in linked list
     struct defaults_list {
         AP_Param *ap;
@@ -8,6 +8,42 @@
 #define AP_PARAM_DEFAULTS_FILE_PARSING_ENABLED AP_FILESYSTEM_FILE_READING_ENABLED
 #endif
 
+// load board defaults from a table generated at build time from
+// defaults.parm rather than parsing the text at boot
+#ifndef AP_PARAM_DEFAULTS_TABLE_ENABLED
+#ifdef HAL_PARAM_DEFAULTS_TABLE
+#define AP_PARAM_DEFAULTS_TABLE_ENABLED AP_PARAM_DEFAULTS_FILE_PARSING_ENABLED
+#else
+#define AP_PARAM_DEFAULTS_TABLE_ENABLED 0
+#endif
+#endif
+
+// index of parameter names for faster lookups by name
+#ifndef AP_PARAM_NAME_INDEX_ENABLED
+#define AP_PARAM_NAME_INDEX_ENABLED (HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
+
+// load_all() from a sorted list of the headers in storage
+#ifndef AP_PARAM_SORTED_LOAD_ENABLED
+#define AP_PARAM_SORTED_LOAD_ENABLED (HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
+
+// hold back background saves while armed so that repeated changes to
+// a parameter are written to storage once
+#ifndef AP_PARAM_SAVE_COALESCE_ENABLED
+#define AP_PARAM_SAVE_COALESCE_ENABLED 1
+#endif
+
+// longest a save is held back while armed, boards may change it in
+// hwdef. Zero writes saves at once
+#ifndef AP_PARAM_SAVE_COALESCE_MS
+#define AP_PARAM_SAVE_COALESCE_MS 1000
+#endif
+
+#ifndef AP_PARAM_SAVE_COALESCE_SLOTS
+#define AP_PARAM_SAVE_COALESCE_SLOTS 16
+#endif
+
 #ifndef FORCE_APJ_DEFAULT_PARAMETERS
 #define FORCE_APJ_DEFAULT_PARAMETERS 0
 #endif
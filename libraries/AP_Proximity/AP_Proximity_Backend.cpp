@@ -107,13 +107,25 @@ bool AP_Proximity_Backend::database_prepare_for_push(Vector3f &current_pos, Matr
 }
 
 // update Object Avoidance database with Earth-frame point
+// the vehicle position and attitude are looked up once per millisecond,
+// so drivers pushing every sector of a scan don't query AHRS each time.
+// This is only called from the backends' update() on the main thread
 void AP_Proximity_Backend::database_push(float angle, float pitch, float distance)
 {
-    Vector3f current_pos;
-    Matrix3f body_to_ned;
-
-    if (database_prepare_for_push(current_pos, body_to_ned)) {
-        database_push(angle, pitch, distance, AP_HAL::millis(), current_pos, body_to_ned);
+    static struct {
+        uint32_t prepared_ms;
+        bool valid;
+        Vector3f current_pos;
+        Matrix3f body_to_ned;
+    } pose;
+
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms != pose.prepared_ms) {
+        pose.prepared_ms = now_ms;
+        pose.valid = database_prepare_for_push(pose.current_pos, pose.body_to_ned);
+    }
+    if (pose.valid) {
+        database_push(angle, pitch, distance, now_ms, pose.current_pos, pose.body_to_ned);
     }
 }
 
@@ -142,6 +154,9 @@ void AP_Proximity_Backend::database_push(float angle, float pitch, float distanc
     temp_pos.z = temp_pos.z * -1.0f;
 
     oaDb->queue_push(temp_pos, timestamp_ms, distance, AP_OADatabase::OA_DbItem::Source::proximity);
+
+    // also remember the space between the sensor and the object is clear
+    oaDb->queue_push_ray(Vector3f{current_pos.x, current_pos.y, -current_pos.z}, temp_pos, distance);
 #endif  // AP_OADATABASE_ENABLED
 }
 
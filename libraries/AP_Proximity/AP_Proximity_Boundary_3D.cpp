@@ -27,18 +27,32 @@ AP_Proximity_Boundary_3D::AP_Proximity_Boundary_3D()
     init();
 }
 
-// initialise the boundary and sector_edge_vector array used for object avoidance
-//   should be called if the sector_middle_deg or _sector_width_deg arrays are changed
+// initialise the boundary and the sector edge directions used for object avoidance
+//   should be called if the sector middle angles or _pitch_middle_deg array are changed
 void AP_Proximity_Boundary_3D::init()
 {
+    for (uint8_t sector=0; sector < PROXIMITY_NUM_SECTORS; sector++) {
+        const float yaw_rad = radians(get_sector_middle_deg(sector) + (PROXIMITY_SECTOR_WIDTH_DEG/2.0f));
+        _sector_edge_dir[sector] = Vector2f{cosf(yaw_rad), sinf(yaw_rad)};
+    }
     for (uint8_t layer=0; layer < PROXIMITY_NUM_LAYERS; layer++) {
-        const float pitch = ((float)_pitch_middle_deg[layer]);
+        const float pitch_rad = radians(_pitch_middle_deg[layer]);
+        _layer_cos_pitch[layer] = cosf(pitch_rad);
+        _layer_sin_pitch[layer] = sinf(pitch_rad);
         for (uint8_t sector=0; sector < PROXIMITY_NUM_SECTORS; sector++) {
-            const float angle_rad = ((float)_sector_middle_deg[sector]+(PROXIMITY_SECTOR_WIDTH_DEG/2.0f));
-            _sector_edge_vector[layer][sector].offset_bearing(angle_rad, pitch, 100.0f);
-            _boundary_points[layer][sector] = _sector_edge_vector[layer][sector] * PROXIMITY_BOUNDARY_DIST_DEFAULT;
+            _boundary_points[layer][sector] = get_sector_edge_vector(layer, sector) * PROXIMITY_BOUNDARY_DIST_DEFAULT;
         }
     }
+    _closest_face = Face();
+    _closest_face_stale = false;
+}
+
+// vector (of length 100) along the edge between a sector and the next sector clockwise
+// equivalent to Vector3f::offset_bearing() with the edge's yaw and the layer's pitch
+Vector3f AP_Proximity_Boundary_3D::get_sector_edge_vector(uint8_t layer, uint8_t sector) const
+{
+    const float xy_length = _layer_cos_pitch[layer] * 100.0f;
+    return Vector3f{_sector_edge_dir[sector].x * xy_length, _sector_edge_dir[sector].y * xy_length, _layer_sin_pitch[layer] * 100.0f};
 }
 
 // returns face corresponding to the provided yaw and (optionally) pitch
@@ -46,7 +60,11 @@ void AP_Proximity_Boundary_3D::init()
 // yaw is the horizontal body-frame angle (in degrees) to the obstacle (0=directly ahead of the vehicle, 90 is to the right of the vehicle)
 AP_Proximity_Boundary_3D::Face AP_Proximity_Boundary_3D::get_face(float pitch, float yaw) const
 {
-    const uint8_t sector = wrap_360(yaw + (PROXIMITY_SECTOR_WIDTH_DEG * 0.5f)) / 45.0f;
+    uint8_t sector = wrap_360(yaw + (PROXIMITY_SECTOR_WIDTH_DEG * 0.5f)) / PROXIMITY_SECTOR_WIDTH_DEG;
+    if (sector >= PROXIMITY_NUM_SECTORS) {
+        // rounding of angles just below 360
+        sector = 0;
+    }
     const float pitch_limited = constrain_float(pitch, -75.0f, 74.9f);
     const uint8_t layer = (pitch_limited + 75.0f)/PROXIMITY_PITCH_WIDTH_DEG;
     return Face{layer, sector};
@@ -63,20 +81,25 @@ void AP_Proximity_Boundary_3D::set_face_attributes(const Face &face, float pitch
         return;
     }
 
+    FaceData &f = _face[face.layer][face.sector];
+
     // ignore update if another instance has provided a shorter distance within the last 0.2 seconds
-    if ((prx_instance != _prx_instance[face.layer][face.sector]) && _distance_valid[face.layer][face.sector] && (_filtered_distance[face.layer][face.sector].get() < distance)) {
+    if ((prx_instance != f.prx_instance) && f.distance_valid && (f.filtered_distance < distance)) {
         // check if recent
         const uint32_t now_ms = AP_HAL::millis();
-        if (now_ms - _last_update_ms[face.layer][face.sector] < PROXIMITY_FACE_RESET_MS) {
+        if (now_ms - f.last_update_ms < PROXIMITY_FACE_RESET_MS) {
             return;
         }
     }
 
-    _angle[face.layer][face.sector] = angle;
-    _pitch[face.layer][face.sector] = pitch;
-    _distance[face.layer][face.sector] = distance;
-    _distance_valid[face.layer][face.sector] = true;
-    _prx_instance[face.layer][face.sector] = prx_instance;
+    // update closest object before the face's previous distance is overwritten
+    closest_object_update(face, distance);
+
+    f.angle = angle;
+    f.pitch = pitch;
+    f.distance = distance;
+    f.distance_valid = true;
+    f.prx_instance = prx_instance;
 
     // apply filter
     set_filtered_distance(face, distance);
@@ -85,36 +108,23 @@ void AP_Proximity_Boundary_3D::set_face_attributes(const Face &face, float pitch
     update_boundary(face);
 }
 
-// apply a new cutoff_freq to low-pass filter
-void AP_Proximity_Boundary_3D::apply_filter_freq(float cutoff_freq)
-{
-    for (uint8_t layer=0; layer < PROXIMITY_NUM_LAYERS; layer++) {
-        for (uint8_t sector=0; sector < PROXIMITY_NUM_SECTORS; sector++) {
-            _filtered_distance[layer][sector].set_cutoff_frequency(cutoff_freq);
-        }
-    }
-}
-
 // Apply low pass filter on the raw distance
 void AP_Proximity_Boundary_3D::set_filtered_distance(const Face &face, float distance)
 {
     if (!face.valid()) {
         return;
     }
-    if (!is_equal(_filtered_distance[face.layer][face.sector].get_cutoff_freq(), _filter_freq)) {
-        // cutoff freq has changed
-        apply_filter_freq(_filter_freq);
-    }
+    FaceData &f = _face[face.layer][face.sector];
 
     const uint32_t now_ms = AP_HAL::millis();
-    const uint32_t dt = now_ms - _last_update_ms[face.layer][face.sector];
-    if (dt < PROXIMITY_FILT_RESET_TIME) {
-        _filtered_distance[face.layer][face.sector].apply(distance, dt* 0.001f);
+    const uint32_t dt = now_ms - f.last_update_ms;
+    if ((f.last_update_ms != 0) && (dt < PROXIMITY_FILT_RESET_TIME)) {
+        f.filtered_distance += (distance - f.filtered_distance) * calc_lowpass_alpha_dt(dt * 0.001f, _filter_freq);
     } else {
         // reset filter since last distance was passed a long time back
-        _filtered_distance[face.layer][face.sector].reset(distance);
+        f.filtered_distance = distance;
     }
-    _last_update_ms[face.layer][face.sector] = now_ms;
+    f.last_update_ms = now_ms;
 }
 
 // update boundary points used for object avoidance based on a single sector and pitch distance changing
@@ -135,39 +145,39 @@ void AP_Proximity_Boundary_3D::update_boundary(const Face &face)
 
     // boundary point lies on the line between the two sectors at the shorter distance found in the two sectors
     float shortest_distance = PROXIMITY_BOUNDARY_DIST_DEFAULT;
-    if (_distance_valid[layer][sector] && _distance_valid[layer][next_sector]) {
-        shortest_distance = MIN(_filtered_distance[layer][sector].get(), _filtered_distance[layer][next_sector].get());
-    } else if (_distance_valid[layer][sector]) {
-        shortest_distance = _filtered_distance[layer][sector].get();
-    } else if (_distance_valid[layer][next_sector]) {
-        shortest_distance = _filtered_distance[layer][next_sector].get();
+    if (_face[layer][sector].distance_valid && _face[layer][next_sector].distance_valid) {
+        shortest_distance = MIN(_face[layer][sector].filtered_distance, _face[layer][next_sector].filtered_distance);
+    } else if (_face[layer][sector].distance_valid) {
+        shortest_distance = _face[layer][sector].filtered_distance;
+    } else if (_face[layer][next_sector].distance_valid) {
+        shortest_distance = _face[layer][next_sector].filtered_distance;
     }
     if (shortest_distance < PROXIMITY_BOUNDARY_DIST_MIN) {
         shortest_distance = PROXIMITY_BOUNDARY_DIST_MIN;
     }
-    _boundary_points[layer][sector] = _sector_edge_vector[layer][sector] * shortest_distance;
+    _boundary_points[layer][sector] = get_sector_edge_vector(layer, sector) * shortest_distance;
 
     // if the next sector (clockwise) has an invalid distance, set boundary to create a cup like boundary
-    if (!_distance_valid[layer][next_sector]) {
-        _boundary_points[layer][next_sector] = _sector_edge_vector[layer][next_sector] * shortest_distance;
+    if (!_face[layer][next_sector].distance_valid) {
+        _boundary_points[layer][next_sector] = get_sector_edge_vector(layer, next_sector) * shortest_distance;
     }
 
     // repeat for edge between sector and previous sector
     const uint8_t prev_sector = get_prev_sector(sector);
     shortest_distance = PROXIMITY_BOUNDARY_DIST_DEFAULT;
-    if (_distance_valid[layer][prev_sector] && _distance_valid[layer][sector]) {
-        shortest_distance = MIN(_filtered_distance[layer][prev_sector].get(), _filtered_distance[layer][sector].get());
-    } else if (_distance_valid[layer][prev_sector]) {
-        shortest_distance = _filtered_distance[layer][prev_sector].get();
-    } else if (_distance_valid[layer][sector]) {
-        shortest_distance = _filtered_distance[layer][sector].get();
+    if (_face[layer][prev_sector].distance_valid && _face[layer][sector].distance_valid) {
+        shortest_distance = MIN(_face[layer][prev_sector].filtered_distance, _face[layer][sector].filtered_distance);
+    } else if (_face[layer][prev_sector].distance_valid) {
+        shortest_distance = _face[layer][prev_sector].filtered_distance;
+    } else if (_face[layer][sector].distance_valid) {
+        shortest_distance = _face[layer][sector].filtered_distance;
     }
-    _boundary_points[layer][prev_sector] = _sector_edge_vector[layer][prev_sector] * shortest_distance;
+    _boundary_points[layer][prev_sector] = get_sector_edge_vector(layer, prev_sector) * shortest_distance;
 
     // if the sector counter-clockwise from the previous sector has an invalid distance, set boundary to create a cup-like boundary
     const uint8_t prev_sector_ccw = get_prev_sector(prev_sector);
-    if (!_distance_valid[layer][prev_sector_ccw]) {
-        _boundary_points[layer][prev_sector_ccw] = _sector_edge_vector[layer][prev_sector_ccw] * shortest_distance;
+    if (!_face[layer][prev_sector_ccw].distance_valid) {
+        _boundary_points[layer][prev_sector_ccw] = get_sector_edge_vector(layer, prev_sector_ccw) * shortest_distance;
     }
 }
 
@@ -176,9 +186,11 @@ void AP_Proximity_Boundary_3D::reset()
 {
     for (uint8_t layer=0; layer < PROXIMITY_NUM_LAYERS; layer++) {
         for (uint8_t sector=0; sector < PROXIMITY_NUM_SECTORS; sector++) {
-            _distance_valid[layer][sector] = false;
+            _face[layer][sector].distance_valid = false;
         }
     }
+    _closest_face = Face();
+    _closest_face_stale = false;
 }
 
 // Reset this location, specified by Face object, back to default
@@ -190,20 +202,23 @@ void AP_Proximity_Boundary_3D::reset_face(const Face &face, uint8_t prx_instance
         return;
     }
 
+    FaceData &f = _face[face.layer][face.sector];
+
     // return immediately if face already has no valid distance
-    if (!_distance_valid[face.layer][face.sector]) {
+    if (!f.distance_valid) {
         return;
     }
 
     // ignore reset if another instance provided this face's distance within the last 0.2 seconds
-    if (prx_instance != _prx_instance[face.layer][face.sector]) {
+    if (prx_instance != f.prx_instance) {
         const uint32_t now_ms = AP_HAL::millis();
-        if (now_ms - _last_update_ms[face.layer][face.sector] < 200) {
+        if (now_ms - f.last_update_ms < 200) {
             return;
         }
     }
 
-    _distance_valid[face.layer][face.sector] = false;
+    f.distance_valid = false;
+    closest_object_invalidate(face);
 
     // update simple avoidance boundary
     update_boundary(face);
@@ -221,11 +236,14 @@ void AP_Proximity_Boundary_3D::check_face_timeout()
 
     for (uint8_t layer=0; layer < PROXIMITY_NUM_LAYERS; layer++) {
         for (uint8_t sector=0; sector < PROXIMITY_NUM_SECTORS; sector++) {
-            if (_distance_valid[layer][sector]) {
-                if ((now_ms - _last_update_ms[layer][sector]) > PROXIMITY_FACE_RESET_MS) {
+            FaceData &f = _face[layer][sector];
+            if (f.distance_valid) {
+                if ((now_ms - f.last_update_ms) > PROXIMITY_FACE_RESET_MS) {
                     // this face has a valid distance but wasn't updated for a long time, reset it
-                    _distance_valid[layer][sector] = false;
-                    update_boundary(AP_Proximity_Boundary_3D::Face{layer, sector});
+                    const Face face{layer, sector};
+                    f.distance_valid = false;
+                    closest_object_invalidate(face);
+                    update_boundary(face);
                 }
             }
         }
@@ -238,8 +256,8 @@ bool AP_Proximity_Boundary_3D::get_distance(const Face &face, float &distance) c
     if (!face.valid()) {
         return false;
     }
-    if (_distance_valid[face.layer][face.sector]) {
-        distance = _distance[face.layer][face.sector];
+    if (_face[face.layer][face.sector].distance_valid) {
+        distance = _face[face.layer][face.sector].distance;
         return true;
     }
 
@@ -247,7 +265,7 @@ bool AP_Proximity_Boundary_3D::get_distance(const Face &face, float &distance) c
 }
 
 // get the total number of obstacles 
-uint8_t AP_Proximity_Boundary_3D::get_obstacle_count() const
+uint16_t AP_Proximity_Boundary_3D::get_obstacle_count() const
 {
     return PROXIMITY_NUM_LAYERS * PROXIMITY_NUM_SECTORS;
 }
@@ -257,7 +275,7 @@ uint8_t AP_Proximity_Boundary_3D::get_obstacle_count() const
 // "update_boundary" method manipulates two sectors ccw and one sector cw from any valid face.
 // Any boundary that does not fall into these manipulated faces are useless, and will be marked as false
 // The resultant is packed into a Boundary Location object and returned by reference as "face"
-bool AP_Proximity_Boundary_3D::convert_obstacle_num_to_face(uint8_t obstacle_num, Face& face) const
+bool AP_Proximity_Boundary_3D::convert_obstacle_num_to_face(uint16_t obstacle_num, Face& face) const
 {
     // obstacle num is just "flattened layers, and sectors"
     const uint8_t layer = obstacle_num / PROXIMITY_NUM_SECTORS;
@@ -268,7 +286,7 @@ bool AP_Proximity_Boundary_3D::convert_obstacle_num_to_face(uint8_t obstacle_num
     uint8_t valid_sector = sector;
     // check for 3 adjacent sectors
     for (uint8_t i=0; i < 3; i++) {
-        if (_distance_valid[layer][valid_sector]) {
+        if (_face[layer][valid_sector].distance_valid) {
             // update boundary has manipulated this face
             return true;
         }
@@ -284,7 +302,7 @@ bool AP_Proximity_Boundary_3D::convert_obstacle_num_to_face(uint8_t obstacle_num
 // Then returns the closest point on this line from vehicle, in body-frame. 
 // Used by GPS based Simple Avoidance  
 // False is returned if the obstacle_num provided does not produce a valid obstacle 
-bool AP_Proximity_Boundary_3D::get_obstacle(uint8_t obstacle_num, Vector3f& vec_to_obstacle) const
+bool AP_Proximity_Boundary_3D::get_obstacle(uint16_t obstacle_num, Vector3f& vec_to_obstacle) const
 {
     Face face;
     if (!convert_obstacle_num_to_face(obstacle_num, face)) {
@@ -308,7 +326,7 @@ bool AP_Proximity_Boundary_3D::get_obstacle(uint8_t obstacle_num, Vector3f& vec_
 // This helps us know if the passed line segment was in the direction of the boundary, or going in a different direction.
 // Used by GPS based Simple Avoidance  - for "brake mode"
 // False is returned if the obstacle_num provided does not produce a valid obstacle
-bool AP_Proximity_Boundary_3D::closest_point_from_segment_to_obstacle(uint8_t obstacle_num, const Vector3f& seg_start, const Vector3f& seg_end, Vector3f& closest_point) const
+bool AP_Proximity_Boundary_3D::closest_point_from_segment_to_obstacle(uint16_t obstacle_num, const Vector3f& seg_start, const Vector3f& seg_end, Vector3f& closest_point) const
 {
     Face face;
     if (!convert_obstacle_num_to_face(obstacle_num, face)) {
@@ -331,34 +349,62 @@ bool AP_Proximity_Boundary_3D::closest_point_from_segment_to_obstacle(uint8_t ob
     return Vector3f::segment_plane_intersect(seg_start, seg_end, closest_point, start);
 }
 
+// update the closest object with a face's new distance
+//   must be called before the face's distance is updated
+void AP_Proximity_Boundary_3D::closest_object_update(const Face &face, float distance)
+{
+    // lower layers might contain ground so are not candidates
+    if ((face.layer < PROXIMITY_MIDDLE_LAYER) || _closest_face_stale) {
+        return;
+    }
+    if (face == _closest_face) {
+        // the closest face has moved away so another face may now be closer
+        if (distance > _face[face.layer][face.sector].distance) {
+            _closest_face_stale = true;
+        }
+    } else if (!_closest_face.valid() || (distance < _face[_closest_face.layer][_closest_face.sector].distance)) {
+        _closest_face = face;
+    }
+}
+
+// mark the closest object for recalculation if the face's distance has become invalid
+void AP_Proximity_Boundary_3D::closest_object_invalidate(const Face &face)
+{
+    if (face == _closest_face) {
+        _closest_face_stale = true;
+    }
+}
+
 // get distance and angle to closest object (used for pre-arm check)
 //   returns true on success, false if no valid readings
 bool AP_Proximity_Boundary_3D::get_closest_object(float& angle_deg, float &distance) const
 {
-    bool closest_found = false;
-    uint8_t closest_sector = 0;
-    uint8_t closest_layer = 0;
-
-    // check boundary for shortest distance
-    // only check for middle layers and higher
-    // lower layers might contain ground, which will give false pre-arm failure
-    for (uint8_t layer=PROXIMITY_MIDDLE_LAYER; layer<PROXIMITY_NUM_LAYERS; layer++) {
-        for (uint8_t sector=0; sector<PROXIMITY_NUM_SECTORS; sector++) {
-            if (_distance_valid[layer][sector]) {
-                if (!closest_found || (_distance[layer][sector] < _distance[closest_layer][closest_sector])) {
-                    closest_layer = layer;
-                    closest_sector = sector;
-                    closest_found = true;
+    // the closest face is tracked as faces are updated, the whole
+    // boundary is only searched if the closest face moved away or was invalidated
+    if (_closest_face_stale) {
+        _closest_face = Face();
+
+        // check boundary for shortest distance
+        // only check for middle layers and higher
+        // lower layers might contain ground, which will give false pre-arm failure
+        for (uint8_t layer=PROXIMITY_MIDDLE_LAYER; layer<PROXIMITY_NUM_LAYERS; layer++) {
+            for (uint8_t sector=0; sector<PROXIMITY_NUM_SECTORS; sector++) {
+                if (_face[layer][sector].distance_valid) {
+                    if (!_closest_face.valid() || (_face[layer][sector].distance < _face[_closest_face.layer][_closest_face.sector].distance)) {
+                        _closest_face = Face{layer, sector};
+                    }
                 }
             }
         }
+        _closest_face_stale = false;
     }
 
-    if (closest_found) {
-        angle_deg = _angle[closest_layer][closest_sector];
-        distance = _distance[closest_layer][closest_sector];
+    if (!_closest_face.valid()) {
+        return false;
     }
-    return closest_found;
+    angle_deg = _face[_closest_face.layer][_closest_face.sector].angle;
+    distance = _face[_closest_face.layer][_closest_face.sector].distance;
+    return true;
 }
 
 // get number of objects, used for non-GPS avoidance
@@ -371,9 +417,9 @@ uint8_t AP_Proximity_Boundary_3D::get_horizontal_object_count() const
 // returns false if no angle or distance could be returned for some reason
 bool AP_Proximity_Boundary_3D::get_horizontal_object_angle_and_distance(uint8_t object_number, float &angle_deg, float &distance) const
 {
-    if ((object_number < PROXIMITY_NUM_SECTORS) && _distance_valid[PROXIMITY_MIDDLE_LAYER][object_number]) {
-        angle_deg = _angle[PROXIMITY_MIDDLE_LAYER][object_number];
-        distance = _filtered_distance[PROXIMITY_MIDDLE_LAYER][object_number].get();
+    if ((object_number < PROXIMITY_NUM_SECTORS) && _face[PROXIMITY_MIDDLE_LAYER][object_number].distance_valid) {
+        angle_deg = _face[PROXIMITY_MIDDLE_LAYER][object_number].angle;
+        distance = _face[PROXIMITY_MIDDLE_LAYER][object_number].filtered_distance;
         return true;
     }
     return false;
@@ -381,15 +427,15 @@ bool AP_Proximity_Boundary_3D::get_horizontal_object_angle_and_distance(uint8_t
 
 // get an obstacle info for AP_Periph
 // returns false if no angle or distance could be returned for some reason
-bool AP_Proximity_Boundary_3D::get_obstacle_info(uint8_t obstacle_num, float &angle_deg, float &pitch_deg, float &distance) const
+bool AP_Proximity_Boundary_3D::get_obstacle_info(uint16_t obstacle_num, float &angle_deg, float &pitch_deg, float &distance) const
 {
     // obstacle num is just "flattened layers, and sectors"
     const uint8_t layer = obstacle_num / PROXIMITY_NUM_SECTORS;
     const uint8_t sector = obstacle_num % PROXIMITY_NUM_SECTORS;
-    if (_distance_valid[layer][sector]) {
-        angle_deg = _angle[layer][sector];
-        pitch_deg = _pitch[layer][sector];
-        distance = _filtered_distance[layer][sector].get();
+    if (_face[layer][sector].distance_valid) {
+        angle_deg = _face[layer][sector].angle;
+        pitch_deg = _face[layer][sector].pitch;
+        distance = _face[layer][sector].filtered_distance;
         return true;
     }
 
@@ -403,40 +449,49 @@ bool AP_Proximity_Boundary_3D::get_filtered_distance(const Face &face, float &di
         return false;
     }
 
-    if (!_distance_valid[face.layer][face.sector]) {
+    if (!_face[face.layer][face.sector].distance_valid) {
         // invalid distace
         return false;
     }
 
-    distance = _filtered_distance[face.layer][face.sector].get();
+    distance = _face[face.layer][face.sector].filtered_distance;
     return true;
 }
 
 // Get raw and filtered distances in 8 directions per layer
+//   each direction holds the shortest distance of the sectors whose middle lies within 22.5 degrees of it
 bool AP_Proximity_Boundary_3D::get_layer_distances(uint8_t layer_number, float dist_max, Proximity_Distance_Array &prx_dist_array, Proximity_Distance_Array &prx_filt_dist_array) const
 {
     // cycle through all sectors filling in distances and orientations
     // see MAV_SENSOR_ORIENTATION for orientations (0 = forward, 1 = 45 degree clockwise from north, etc)
-    bool valid_distances = false;
     prx_dist_array.offset_valid = 0;
     prx_filt_dist_array.offset_valid = 0;
+    if (layer_number >= PROXIMITY_NUM_LAYERS) {
+        return false;
+    }
     for (uint8_t i=0; i<PROXIMITY_MAX_DIRECTION; i++) {
         prx_dist_array.orientation[i] = i;
-        const AP_Proximity_Boundary_3D::Face face(layer_number, i);
-        if (!face.valid()) {
-            return false;
+        prx_dist_array.distance[i] = dist_max;
+        prx_filt_dist_array.distance[i] = dist_max;
+    }
+
+    for (uint8_t sector=0; sector < PROXIMITY_NUM_SECTORS; sector++) {
+        const FaceData &f = _face[layer_number][sector];
+        if (!f.distance_valid) {
+            continue;
+        }
+        const uint8_t i = uint8_t(wrap_360(get_sector_middle_deg(sector) + 22.5f) / 45.0f) % PROXIMITY_MAX_DIRECTION;
+        if (!prx_dist_array.valid(i) || (f.distance < prx_dist_array.distance[i])) {
+            prx_dist_array.distance[i] = f.distance;
         }
-        if (get_distance(face, prx_dist_array.distance[i]) && get_filtered_distance(face, prx_filt_dist_array.distance[i])) {
-            valid_distances = true;
-            prx_dist_array.offset_valid |= (1U << i);
-            prx_filt_dist_array.offset_valid |= (1U << i);
-        } else {
-            prx_dist_array.distance[i] = dist_max;
-            prx_filt_dist_array.distance[i] = dist_max;
+        if (!prx_filt_dist_array.valid(i) || (f.filtered_distance < prx_filt_dist_array.distance[i])) {
+            prx_filt_dist_array.distance[i] = f.filtered_distance;
         }
+        prx_dist_array.offset_valid |= (1U << i);
+        prx_filt_dist_array.offset_valid |= (1U << i);
     }
 
-    return valid_distances;
+    return prx_dist_array.offset_valid != 0;
 }
 
 // reset the temporary boundary. This fills in distances with FLT_MAX
@@ -17,9 +17,9 @@
 
 #include <AP_Common/AP_Common.h>
 #include <AP_Math/AP_Math.h>
-#include <Filter/LowPassFilter.h>
+#include "AP_Proximity_config.h"
 
-#define PROXIMITY_NUM_SECTORS         8       // number of sectors
+#define PROXIMITY_NUM_SECTORS         AP_PROXIMITY_BOUNDARY_NUM_SECTORS // number of sectors
 #define PROXIMITY_NUM_LAYERS          5       // num of layers in a sector
 #define PROXIMITY_MIDDLE_LAYER        2       // middle layer
 #define PROXIMITY_PITCH_WIDTH_DEG     30      // width between each layer in degrees
@@ -66,7 +66,7 @@ public:
 	    bool operator !=(const Face &other) const { return ((layer != other.layer) || (sector != other.sector)); }
 
         uint8_t layer;  // vertical "steps" on the 3D Boundary. 0th layer is the bottom most layer, 1st layer is 30 degrees above (in body frame) and so on
-        uint8_t sector; // horizontal "steps" on the 3D Boundary. 0th sector is directly in front of the vehicle. Each sector is 45 degrees wide.
+        uint8_t sector; // horizontal "steps" on the 3D Boundary. 0th sector is directly in front of the vehicle. Each sector is PROXIMITY_SECTOR_WIDTH_DEG wide.
     };
 
     // returns face corresponding to the provided yaw and (optionally) pitch
@@ -103,15 +103,15 @@ public:
     bool get_distance(const Face &face, float &distance) const;
 
     // Get the total number of obstacles
-    uint8_t get_obstacle_count() const;
+    uint16_t get_obstacle_count() const;
 
     // Returns a body frame vector (in cm) to an obstacle
     // False is returned if the obstacle_num provided does not produce a valid obstacle
-    bool get_obstacle(uint8_t obstacle_num, Vector3f& vec_to_boundary) const;
+    bool get_obstacle(uint16_t obstacle_num, Vector3f& vec_to_boundary) const;
 
     // Returns a body frame vector (in cm) nearest to obstacle, in betwen seg_start and seg_end
     // True is returned if the segment intersects a plane formed by considering the "closest point" as normal vector to the plane.
-    bool closest_point_from_segment_to_obstacle(uint8_t obstacle_num, const Vector3f& seg_start, const Vector3f& seg_end, Vector3f& closest_point) const;
+    bool closest_point_from_segment_to_obstacle(uint16_t obstacle_num, const Vector3f& seg_start, const Vector3f& seg_end, Vector3f& closest_point) const;
 
     // get distance and angle to closest object (used for pre-arm check)
     //   returns true on success, false if no valid readings
@@ -122,7 +122,7 @@ public:
     bool get_horizontal_object_angle_and_distance(uint8_t object_number, float& angle_deg, float &distance) const;
 
     // get obstacle info for AP_Periph
-    bool get_obstacle_info(uint8_t obstacle_num, float &angle_deg, float &pitch_deg, float &distance) const;
+    bool get_obstacle_info(uint16_t obstacle_num, float &angle_deg, float &pitch_deg, float &distance) const;
 
     // get number of layers
     uint8_t get_num_layers() const { return PROXIMITY_NUM_LAYERS; }
@@ -134,8 +134,9 @@ public:
     void set_filter_freq(float filt_freq) { _filter_freq = filt_freq; }
 
     // sectors
-    static_assert(PROXIMITY_NUM_SECTORS == 8, "PROXIMITY_NUM_SECTOR must be 8");
-    const uint16_t _sector_middle_deg[PROXIMITY_NUM_SECTORS] {0, 45, 90, 135, 180, 225, 270, 315};    // middle angle of each sector
+    static_assert(PROXIMITY_NUM_SECTORS >= 8 && PROXIMITY_NUM_SECTORS < UINT8_MAX, "PROXIMITY_NUM_SECTORS must be between 8 and 254");
+    static_assert(360 % PROXIMITY_NUM_SECTORS == 0, "PROXIMITY_NUM_SECTORS must divide 360");
+    float get_sector_middle_deg(uint8_t sector) const { return sector * PROXIMITY_SECTOR_WIDTH_DEG; }    // middle angle of each sector
     // layers
     static_assert(PROXIMITY_NUM_LAYERS == 5, "PROXIMITY_NUM_LAYERS must be 5");
     const int16_t _pitch_middle_deg[PROXIMITY_NUM_LAYERS] {-60, -30, 0, 30, 60};
@@ -156,10 +157,7 @@ private:
     // "update_boundary" method manipulates two sectors ccw and one sector cw from any valid face.
     // Any boundary that does not fall into these manipulated faces are useless, and will be marked as false
     // The resultant is packed into a Boundary Location object and returned by reference as "face"
-    bool convert_obstacle_num_to_face(uint8_t obstacle_num, Face& face) const WARN_IF_UNUSED;
-
-    // Apply a new cutoff_freq to low-pass filter
-    void apply_filter_freq(float cutoff_freq);
+    bool convert_obstacle_num_to_face(uint16_t obstacle_num, Face& face) const WARN_IF_UNUSED;
 
     // Apply low pass filter on the raw distance
     void set_filtered_distance(const Face &face, float distance);
@@ -167,16 +165,36 @@ private:
     // Return filtered distance for the passed in face
     bool get_filtered_distance(const Face &face, float &distance) const;
 
-    Vector3f _sector_edge_vector[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS];
+    // vector (of length 100) along the edge between a sector and the next sector clockwise
+    Vector3f get_sector_edge_vector(uint8_t layer, uint8_t sector) const;
+
+    // closest object tracking used by get_closest_object
+    //   only faces in the middle layer and above are candidates
+    void closest_object_update(const Face &face, float distance);
+    void closest_object_invalidate(const Face &face);
+
+    // attributes of a single face, kept together so the boundary stays compact at high sector counts
+    struct FaceData {
+        float angle;                // yaw angle in degrees to closest object within this face
+        float pitch;                // pitch angle in degrees to the closest object within this face
+        float distance;             // distance to closest object within this face
+        float filtered_distance;    // low pass filtered distance
+        uint32_t last_update_ms;    // time when distance was last updated
+        uint8_t prx_instance;       // proximity sensor backend instance that provided the distance
+        bool distance_valid;        // true if a valid distance has been received
+    } _face[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS];
+
     Vector3f _boundary_points[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS];
 
-    float _angle[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS];          // yaw angle in degrees to closest object within each sector and layer
-    float _pitch[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS];          // pitch angle in degrees to the closest object within each sector and layer
-    float _distance[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS];       // distance to closest object within each sector and layer
-    bool _distance_valid[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS];  // true if a valid distance received for each sector and layer
-    uint32_t _last_update_ms[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS]; // time when distance was last updated
-    uint8_t _prx_instance[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS]; // proximity sensor backend instance that provided the distance
-    LowPassFilterFloat _filtered_distance[PROXIMITY_NUM_LAYERS][PROXIMITY_NUM_SECTORS]; // low pass filter
+    // sector edge vectors are the product of a horizontal direction per sector and a pitch per layer
+    Vector2f _sector_edge_dir[PROXIMITY_NUM_SECTORS];                   // cos and sin of the yaw angle of each sector's clockwise edge
+    float _layer_cos_pitch[PROXIMITY_NUM_LAYERS];                       // cos of each layer's pitch
+    float _layer_sin_pitch[PROXIMITY_NUM_LAYERS];                       // sin of each layer's pitch
+
+    // closest face in the middle layer and above, only recalculated when that face moves away or is invalidated
+    mutable Face _closest_face;                                         // invalid if there are no valid faces
+    mutable bool _closest_face_stale;                                   // true if _closest_face must be recalculated
+
     float _filter_freq;                                                 // cutoff freq of low pass filter
     uint32_t _last_check_face_timeout_ms;                               // system time to throttle check_face_timeout method
 };
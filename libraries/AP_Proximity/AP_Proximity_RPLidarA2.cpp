@@ -411,8 +411,19 @@ void AP_Proximity_RPLidarA2::parse_response_data()
                 _last_distance_valid = true;
                 _last_angle_deg = angle_deg;
             }
-            // update OA database
-            database_push(_last_angle_deg, _last_distance_m);
+            // use the shortest distance within 2 degree sectors for the OA database
+            const uint16_t a2d = uint16_t(angle_deg * 0.5f) * 2;
+            if (_dist_2deg_valid && _angle_2deg == a2d) {
+                _dist_2deg_m = MIN(_dist_2deg_m, distance_m);
+            } else {
+                // new 2 degree sector, push the old one
+                if (_dist_2deg_valid) {
+                    database_push(_angle_2deg, _dist_2deg_m);
+                }
+                _angle_2deg = a2d;
+                _dist_2deg_m = distance_m;
+                _dist_2deg_valid = true;
+            }
         }
     }
 }
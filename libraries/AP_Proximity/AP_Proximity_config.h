@@ -81,3 +81,10 @@
 #ifndef AP_PROXIMITY_MR72_DRIVER_ENABLED
 #define AP_PROXIMITY_MR72_DRIVER_ENABLED (AP_PROXIMITY_MR72_ENABLED  || AP_PROXIMITY_HEXSOONRADAR_ENABLED)
 #endif  // AP_PROXIMITY_MR72_DRIVER_ENABLED
+
+// number of horizontal sectors in the 3D boundary, must divide 360 evenly
+// (e.g. 8, 36 or 72). Higher counts give a finer boundary for 360 degree lidars
+// at the cost of RAM (roughly 36 bytes per sector per layer)
+#ifndef AP_PROXIMITY_BOUNDARY_NUM_SECTORS
+#define AP_PROXIMITY_BOUNDARY_NUM_SECTORS 8
+#endif
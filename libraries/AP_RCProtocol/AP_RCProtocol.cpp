@@ -187,6 +187,7 @@ void AP_RCProtocol::process_pulse(uint32_t width_s0, uint32_t width_s1)
     }
 
     // otherwise scan all protocols
+    note_searching(now);
     for (uint8_t i = 0; i < ARRAY_SIZE(backend); i++) {
         if (_disabled_for_pulses & (1U << i)) {
             // this protocol is disabled for pulse input
@@ -213,6 +214,7 @@ void AP_RCProtocol::process_pulse(uint32_t width_s0, uint32_t width_s1)
                 }
                 _last_input_ms = now;
                 _detected_with_bytes = false;
+                note_detected(now);
                 break;
             }
         }
@@ -271,8 +273,13 @@ bool AP_RCProtocol::process_byte(uint8_t byte, uint32_t baudrate)
         return true;
     }
 
-    // otherwise scan all protocols
+    // otherwise scan all protocols that can be sent at this baudrate
+    note_searching(now);
+    update_byte_search_mask(baudrate);
     for (uint8_t i = 0; i < ARRAY_SIZE(backend); i++) {
+        if ((_byte_search_mask & (1U << i)) == 0) {
+            continue;
+        }
         if (backend[i] != nullptr) {
             if (!protocol_enabled(rcprotocol_t(i))) {
                 continue;
@@ -289,6 +296,7 @@ bool AP_RCProtocol::process_byte(uint8_t byte, uint32_t baudrate)
                 _detected_protocol = (enum AP_RCProtocol::rcprotocol_t)i;
                 _last_input_ms = now;
                 _detected_with_bytes = true;
+                note_detected(now);
                 for (uint8_t j = 0; j < ARRAY_SIZE(backend); j++) {
                     if (backend[j]) {
                         backend[j]->reset_rc_frame_count();
@@ -303,6 +311,40 @@ bool AP_RCProtocol::process_byte(uint8_t byte, uint32_t baudrate)
     return false;
 }
 
+/*
+  the backends which accept bytes only change with the baudrate, so
+  work them out once per baudrate rather than for every byte
+ */
+void AP_RCProtocol::update_byte_search_mask(uint32_t baudrate)
+{
+    if (baudrate == _byte_search_baud) {
+        return;
+    }
+    _byte_search_baud = baudrate;
+    _byte_search_mask = 0;
+    for (uint8_t i = 0; i < ARRAY_SIZE(backend); i++) {
+        if (backend[i] != nullptr && backend[i]->accepts_baudrate(baudrate)) {
+            _byte_search_mask |= (1U << i);
+        }
+    }
+}
+
+void AP_RCProtocol::note_searching(uint32_t now_ms)
+{
+    // a gap in the input means any earlier input was noise rather
+    // than the start of a receiver reconnecting
+    if (_search_start_ms == 0 || now_ms - _search_last_ms > 200) {
+        _search_start_ms = now_ms;
+    }
+    _search_last_ms = now_ms;
+}
+
+void AP_RCProtocol::note_detected(uint32_t now_ms)
+{
+    _detection_latency_ms = (_search_start_ms != 0) ? now_ms - _search_start_ms : 0;
+    _search_start_ms = 0;
+}
+
 // handshake if nothing else has succeeded so far
 void AP_RCProtocol::process_handshake( uint32_t baudrate)
 {
@@ -355,6 +397,7 @@ static const AP_RCProtocol::SerialConfig serial_configs[] {
 };
 
 static_assert(ARRAY_SIZE(serial_configs) > 0, "must have at least one serial config");
+static_assert(AP_RCProtocol::NONE <= 32, "protocol masks must fit in 32 bits");
 
 void AP_RCProtocol::check_added_uart(void)
 {
@@ -386,12 +429,22 @@ void AP_RCProtocol::check_added_uart(void)
             process_byte(uint8_t(b), current_baud);
         }
     }
-    if (searching) {
+    if (searching && _detected_with_bytes && !should_search(now)) {
+        // detected on this config, remember it for when the signal is lost
+        added.good_config_num = added.config_num;
+        added.good_config_valid = true;
+    } else if (searching) {
         if (now - added.last_config_change_ms > 1000) {
-            // change configs if not detected once a second
-            added.config_num++;
-            if (added.config_num >= ARRAY_SIZE(serial_configs)) {
-                added.config_num = 0;
+            // change configs if not detected once a second, going back
+            // to the last good config between each of the others
+            if (added.good_config_valid && added.config_num != added.good_config_num) {
+                added.config_num = added.good_config_num;
+            } else {
+                added.search_num = (added.search_num + 1) % ARRAY_SIZE(serial_configs);
+                if (added.good_config_valid && added.search_num == added.good_config_num) {
+                    added.search_num = (added.search_num + 1) % ARRAY_SIZE(serial_configs);
+                }
+                added.config_num = added.search_num;
             }
             added.opened = false;
         }
@@ -453,6 +506,7 @@ bool AP_RCProtocol::detect_async_protocol(rcprotocol_t protocol)
 
     // we can provide data, change the detected protocol to be us:
     _detected_protocol = protocol;
+    _detection_latency_ms = 0;
     return true;
 }
 
@@ -486,7 +540,11 @@ void AP_RCProtocol::announce_detected()
     }
     (void)src;  // iofirmware doesn't use this
     (void)name;  // iofirmware doesn't use this
-    GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "RCInput: decoding %s (%s)", name, src);
+    if (_detection_latency_ms != 0) {
+        GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "RCInput: decoding %s (%s) after %ums", name, src, unsigned(_detection_latency_ms));
+    } else {
+        GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "RCInput: decoding %s (%s)", name, src);
+    }
 }
 
 bool AP_RCProtocol::new_input()
@@ -264,6 +264,12 @@ public:
         return _detected_with_bytes;
     }
 
+    // time from the first input seen while searching until the
+    // protocol was detected, zero if not known
+    uint32_t get_detection_latency_ms(void) const {
+        return _detection_latency_ms;
+    }
+
     // handle mavlink radio
 #if AP_RCPROTOCOL_MAVLINK_RADIO_ENABLED
     void handle_radio_rc_channels(const mavlink_radio_rc_channels_t* packet);
@@ -280,6 +286,14 @@ private:
     // having them make an "add_input" callback):
     bool detect_async_protocol(rcprotocol_t protocol);
 
+    // note that input is being searched for a protocol
+    void note_searching(uint32_t now_ms);
+    // note that a protocol has been detected by searching
+    void note_detected(uint32_t now_ms);
+
+    // update the mask of backends which accept bytes at this baudrate
+    void update_byte_search_mask(uint32_t baudrate);
+
     enum rcprotocol_t _detected_protocol = NONE;
     uint16_t _disabled_for_pulses;
     bool _detected_with_bytes;
@@ -289,12 +303,29 @@ private:
     bool _failsafe_active;
     bool _valid_serial_prot;
 
+    // while searching bytes are only given to backends that accept
+    // them at the baudrate they arrive at
+    uint32_t _byte_search_baud;
+    uint32_t _byte_search_mask;
+
+    // detection latency measurement
+    uint32_t _search_start_ms;
+    uint32_t _search_last_ms;
+    uint32_t _detection_latency_ms;
+
     // optional additional uart
     struct {
         AP_HAL::UARTDriver *uart;
         bool opened;
         uint32_t last_config_change_ms;
         uint8_t config_num;
+        // position in the cycle through all configs while searching
+        uint8_t search_num;
+        // config the protocol was last detected with, tried again
+        // between each of the others so a receiver that reconnects
+        // is found quickly
+        uint8_t good_config_num;
+        bool good_config_valid;
     } added;
 
     // allowed RC protocols mask (first bit means "all")
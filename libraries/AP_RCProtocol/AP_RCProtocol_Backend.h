@@ -32,6 +32,9 @@ public:
     virtual ~AP_RCProtocol_Backend() {}
     virtual void process_pulse(uint32_t width_s0, uint32_t width_s1) {}
     virtual void process_byte(uint8_t byte, uint32_t baudrate) {}
+    // return false if bytes at this baudrate can't be this protocol,
+    // allowing the frontend to skip this backend while searching
+    virtual bool accepts_baudrate(uint32_t baudrate) const { return true; }
     virtual void process_handshake(uint32_t baudrate) {}
     uint16_t read(uint8_t chan);
     void read(uint16_t *pwm, uint8_t n);
@@ -215,10 +215,15 @@ uint16_t AP_RCProtocol_CRSF::get_link_rate(ProtocolType protocol) const {
 }
 
 // process a byte provided by a uart from rc stack
+// reject RC data if we have been configured for standalone mode
+bool AP_RCProtocol_CRSF::accepts_baudrate(uint32_t baudrate) const
+{
+    return (baudrate == CRSF_BAUDRATE || baudrate == CRSF_BAUDRATE_1MBIT || baudrate == CRSF_BAUDRATE_2MBIT) && _uart == nullptr;
+}
+
 void AP_RCProtocol_CRSF::process_byte(uint8_t byte, uint32_t baudrate)
 {
-    // reject RC data if we have been configured for standalone mode
-    if ((baudrate != CRSF_BAUDRATE && baudrate != CRSF_BAUDRATE_1MBIT && baudrate != CRSF_BAUDRATE_2MBIT) || _uart) {
+    if (!accepts_baudrate(baudrate)) {
         return;
     }
     _process_byte(byte);
@@ -313,7 +313,7 @@ bool AP_RCProtocol_FPort::check_checksum(void)
 // support byte input
 void AP_RCProtocol_FPort::process_byte(uint8_t b, uint32_t baudrate)
 {
-    if (baudrate != 115200) {
+    if (!accepts_baudrate(baudrate)) {
         return;
     }
     _process_byte(AP_HAL::micros(), b);
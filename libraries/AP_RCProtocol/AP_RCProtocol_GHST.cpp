@@ -424,11 +424,16 @@ bool AP_RCProtocol_GHST::is_telemetry_supported() const
            || _link_status.rf_mode == AP_RCProtocol_GHST::GHST_RF_MODE_RACE250;
 }
 
+// bytes are only GHST at the CRSF or GHST baudrates
+bool AP_RCProtocol_GHST::accepts_baudrate(uint32_t baudrate) const
+{
+    return baudrate == CRSF_BAUDRATE || baudrate == GHST_BAUDRATE;
+}
+
 // process a byte provided by a uart
 void AP_RCProtocol_GHST::process_byte(uint8_t byte, uint32_t baudrate)
 {
-    // reject RC data if we have been configured for standalone mode
-    if (baudrate != CRSF_BAUDRATE && baudrate != GHST_BAUDRATE) {
+    if (!accepts_baudrate(baudrate)) {
         return;
     }
     _process_byte(AP_HAL::micros(), byte);
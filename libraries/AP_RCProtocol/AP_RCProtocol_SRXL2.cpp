@@ -242,7 +242,7 @@ void AP_RCProtocol_SRXL2::start_bind(void)
 // process a byte provided by a uart
 void AP_RCProtocol_SRXL2::process_byte(uint8_t byte, uint32_t baudrate)
 {
-    if (baudrate != 115200) {
+    if (!accepts_baudrate(baudrate)) {
         return;
     }
 
@@ -68,10 +68,13 @@ void AP_RCTelemetry::update_avg_packet_rate()
         if (_scheduler.avg_packet_rate == 0) _scheduler.avg_packet_rate = _scheduler.avg_packet_counter;
         // moving average
         _scheduler.avg_packet_rate = (uint16_t)_scheduler.avg_packet_rate * 0.75f + _scheduler.avg_packet_counter * 0.25f;
+        _scheduler.load_us = _scheduler.load_counter_us;
         // reset
         _scheduler.last_poll_timer = poll_now;
         _scheduler.avg_packet_counter = 0;
-        debug("avg packet rate %dHz, rates(Hz) %d %d %d %d %d %d %d %d", _scheduler.avg_packet_rate,
+        _scheduler.load_counter_us = 0;
+        debug("avg packet rate %dHz, load %uus/s, rates(Hz) %d %d %d %d %d %d %d %d", _scheduler.avg_packet_rate,
+             unsigned(_scheduler.load_us),
              _scheduler.packet_rate[0],
              _scheduler.packet_rate[1],
              _scheduler.packet_rate[2],
@@ -88,6 +91,14 @@ void AP_RCTelemetry::update_avg_packet_rate()
  * returns the actual packet type index (if any) sent by the scheduler
  */
 uint8_t AP_RCTelemetry::run_wfq_scheduler(const bool use_shaper)
+{
+    const uint32_t start_us = AP_HAL::micros();
+    const int8_t idx = wfq_schedule_packet(use_shaper);
+    _scheduler.load_counter_us += AP_HAL::micros() - start_us;
+    return idx;
+}
+
+int8_t AP_RCTelemetry::wfq_schedule_packet(const bool use_shaper)
 {
     update_avg_packet_rate();
     update_max_packet_rate();
@@ -95,8 +106,9 @@ uint8_t AP_RCTelemetry::run_wfq_scheduler(const bool use_shaper)
     uint32_t now = AP_HAL::millis();
     int8_t max_delay_idx = -1;
 
-    float max_delay = 0;
-    float delay = 0;
+    // the longest delay found so far is max_elapsed/max_weight
+    uint32_t max_elapsed = 0;
+    uint32_t max_weight = 1;
     bool packet_ready = false;
 
     // queue messages for any unhealthy sensors
@@ -115,16 +127,20 @@ uint8_t AP_RCTelemetry::run_wfq_scheduler(const bool use_shaper)
 
     // search the packet with the longest delay after the scheduled time
     for (int i=0; i<_time_slots; i++) {
-        // normalize packet delay relative to packet weight
-        delay = (now - _scheduler.packet_timer[i])/static_cast<float>(_scheduler.packet_weight[i]);
+        // normalize packet delay relative to packet weight, comparing
+        // elapsed/weight by cross multiplying to save a division per slot
+        const uint32_t elapsed = now - _scheduler.packet_timer[i];
+        const uint32_t weight = _scheduler.packet_weight[i];
         // use >= so with equal delays we choose the packet with lowest priority
         // this is ensured by the packets being sorted by desc frequency
         // apply the rate limiter
-        if (delay >= max_delay && check_scheduler_entry_time_constraints(now, i, use_shaper)) {
+        if (uint64_t(elapsed) * max_weight >= uint64_t(max_elapsed) * weight &&
+            check_scheduler_entry_time_constraints(now, i, use_shaper)) {
             packet_ready = is_scheduler_entry_enabled(i) && is_packet_ready(i, queue_empty);
 
             if (packet_ready) {
-                max_delay = delay;
+                max_elapsed = elapsed;
+                max_weight = weight;
                 max_delay_idx = i;
             }
         }
@@ -138,7 +154,7 @@ uint8_t AP_RCTelemetry::run_wfq_scheduler(const bool use_shaper)
     _scheduler.packet_rate[max_delay_idx] = (_scheduler.packet_rate[max_delay_idx] + 1000 / (now - _scheduler.packet_timer[max_delay_idx])) / 2;
 #endif
     _scheduler.packet_timer[max_delay_idx] = now;
-    //debug("process_packet(%d): %f", max_delay_idx, max_delay);
+    //debug("process_packet(%d): %u/%u", max_delay_idx, max_elapsed, max_weight);
     // send packet
     process_packet(max_delay_idx);
     // let the caller know which packet type was sent
@@ -77,6 +77,10 @@ public:
     uint16_t get_max_packet_rate() const {
         return _scheduler.max_packet_rate;
     }
+    // microseconds per second spent choosing and sending packets
+    uint32_t get_scheduler_load_us() const {
+        return _scheduler.load_us;
+    }
 
     static float get_vspeed_ms(void);
     static float get_nav_alt_m(Location::AltFrame frame = Location::AltFrame::ABSOLUTE);
@@ -114,6 +118,8 @@ protected:
         uint32_t packet_min_period[TELEM_TIME_SLOT_MAX];
         uint16_t avg_packet_rate;
         uint16_t max_packet_rate;
+        uint32_t load_us;           // time spent in the scheduler over the last second
+        uint32_t load_counter_us;   // time spent in the scheduler this second
 #ifdef TELEM_DEBUG
         uint8_t packet_rate[TELEM_TIME_SLOT_MAX];
 #endif
@@ -133,6 +139,7 @@ private:
 
     // passthrough WFQ scheduler
     virtual void setup_wfq_scheduler() = 0;
+    int8_t wfq_schedule_packet(const bool use_shaper);
     virtual bool get_next_msg_chunk(void) { return false; }
     virtual bool is_packet_ready(uint8_t idx, bool queue_empty) { return true; }
     virtual void process_packet(uint8_t idx) = 0;
@@ -111,6 +111,138 @@ void AP_ROMFS::free(const uint8_t *data)
 #endif
 }
 
+/*
+  state of a stream. The decompressor needs the last 32k of output (the
+  deflate window) for back references, or the whole file if smaller
+ */
+#define ROMFS_STREAM_MAX_WINDOW 32768U
+
+struct AP_ROMFS::Stream {
+    const embedded_file *f;
+    uint32_t ofs;
+#ifndef HAL_ROMFS_UNCOMPRESSED
+    uint32_t crc;
+    uint8_t *window;
+    uint32_t window_size;
+    TINF_DATA d;
+#endif
+};
+
+/*
+  open the named file as a stream
+*/
+AP_ROMFS::Stream *AP_ROMFS::stream_open(const char *name, uint32_t &size)
+{
+    const struct embedded_file *f = find_file(name);
+    if (f == nullptr) {
+        return nullptr;
+    }
+    Stream *s = (Stream *)malloc(sizeof(Stream));
+    if (s == nullptr) {
+        return nullptr;
+    }
+    s->f = f;
+#ifndef HAL_ROMFS_UNCOMPRESSED
+    s->window_size = f->decompressed_size < ROMFS_STREAM_MAX_WINDOW ? f->decompressed_size : ROMFS_STREAM_MAX_WINDOW;
+    if (s->window_size == 0) {
+        s->window_size = 1;
+    }
+    s->window = (uint8_t *)malloc(s->window_size);
+    if (s->window == nullptr) {
+        ::free(s);
+        return nullptr;
+    }
+#endif
+    stream_restart(s);
+    size = f->decompressed_size;
+    return s;
+}
+
+void AP_ROMFS::stream_restart(Stream *s)
+{
+    s->ofs = 0;
+#ifndef HAL_ROMFS_UNCOMPRESSED
+    s->crc = 0;
+    uzlib_uncompress_init(&s->d, s->window, s->window_size);
+    s->d.source = s->f->contents;
+    s->d.source_limit = s->f->contents + s->f->compressed_size;
+#endif
+}
+
+/*
+  read up to count bytes from the stream
+*/
+int32_t AP_ROMFS::stream_read(Stream *s, uint8_t *buf, uint32_t count)
+{
+    const uint32_t remaining = s->f->decompressed_size - s->ofs;
+    if (count > remaining) {
+        count = remaining;
+    }
+    if (count == 0) {
+        return 0;
+    }
+#ifdef HAL_ROMFS_UNCOMPRESSED
+    memcpy(buf, &s->f->contents[s->ofs], count);
+#else
+    s->d.dest = buf;
+    s->d.destSize = count;
+    const int res = uzlib_uncompress(&s->d);
+    if (res != TINF_OK || s->d.dest != buf + count) {
+        return -1;
+    }
+    s->crc = crc32_small(s->crc, buf, count);
+    if (s->ofs + count == s->f->decompressed_size && s->crc != s->f->crc) {
+        return -1;
+    }
+#endif
+    s->ofs += count;
+    return count;
+}
+
+/*
+  move to ofs bytes from the start of the file
+*/
+bool AP_ROMFS::stream_seek(Stream *s, uint32_t ofs)
+{
+    if (ofs > s->f->decompressed_size) {
+        ofs = s->f->decompressed_size;
+    }
+#ifdef HAL_ROMFS_UNCOMPRESSED
+    s->ofs = ofs;
+#else
+    if (ofs < s->ofs) {
+        stream_restart(s);
+    }
+    // decompress and discard up to the new offset
+    uint8_t buf[64];
+    while (s->ofs < ofs) {
+        if (stream_read(s, buf, ofs - s->ofs < sizeof(buf) ? ofs - s->ofs : sizeof(buf)) <= 0) {
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+uint32_t AP_ROMFS::stream_offset(const Stream *s)
+{
+    return s->ofs;
+}
+
+/*
+  close a stream, freeing its memory
+*/
+void AP_ROMFS::stream_close(Stream *s)
+{
+    if (s == nullptr) {
+        return;
+    }
+#ifndef HAL_ROMFS_UNCOMPRESSED
+    ::free(s->window);
+#endif
+    ::free(s);
+}
+
 /*
   directory listing interface. Start with ofs=0. Returns pathnames
   that match dirname prefix. Ends with nullptr return when no more
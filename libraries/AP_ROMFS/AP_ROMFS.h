@@ -19,6 +19,30 @@ public:
     // get the size of a file without decompressing
     static bool find_size(const char *name, uint32_t &size);
 
+    /*
+      streaming interface, decompressing the file as it is read so only
+      a window of the file is held in memory rather than all of it
+     */
+    struct Stream;
+
+    // open the named file as a stream, returning nullptr if not found
+    // or out of memory
+    static Stream *stream_open(const char *name, uint32_t &size);
+
+    // read up to count bytes from the stream. Returns the number of
+    // bytes read, 0 at the end of the file and -1 if the file is corrupt
+    static int32_t stream_read(Stream *s, uint8_t *buf, uint32_t count);
+
+    // move to ofs bytes from the start of the file. Seeking backwards
+    // restarts decompression from the start
+    static bool stream_seek(Stream *s, uint32_t ofs);
+
+    // get the current offset into the file
+    static uint32_t stream_offset(const Stream *s);
+
+    // close a stream, freeing its memory
+    static void stream_close(Stream *s);
+
     /*
       directory listing interface. Start with ofs=0. Returns pathnames
       that match dirname prefix. Ends with nullptr return when no more
@@ -38,5 +62,8 @@ private:
     // find an embedded file
     static const AP_ROMFS::embedded_file *find_file(const char *name);
 
+    // start decompressing a stream from the beginning
+    static void stream_restart(Stream *s);
+
     static const struct embedded_file files[];
 };
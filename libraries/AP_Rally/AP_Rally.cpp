@@ -115,6 +115,7 @@ bool AP_Rally::set_rally_point_with_index(uint8_t i, const RallyLocation &rallyL
     _storage.write_block(i * sizeof(RallyLocation), &rallyLoc, sizeof(RallyLocation));
 
     _last_change_time_ms = AP_HAL::millis();
+    _cache.valid = false;
 
 #if HAL_LOGGING_ENABLED
     AP::logger().Write_RallyPoint(_rally_point_total_count, i, rallyLoc);
@@ -137,22 +138,110 @@ Location AP_Rally::rally_location_to_location(const RallyLocation &rally_loc) co
     return ret;
 }
 
+/*
+  load the rally points into the cache and sort them by latitude. The
+  cache is reloaded when a point is written or RALLY_TOTAL changes
+ */
+bool AP_Rally::update_cache() const
+{
+    const uint8_t total = get_rally_total();
+    if (_cache.valid && _cache.total == total) {
+        return true;
+    }
+    _cache.valid = false;
+
+    if (total > _cache.capacity) {
+        delete[] _cache.points;
+        delete[] _cache.by_lat;
+        _cache.points = NEW_NOTHROW RallyLocation[total];
+        _cache.by_lat = NEW_NOTHROW uint8_t[total];
+        if (_cache.points == nullptr || _cache.by_lat == nullptr) {
+            delete[] _cache.points;
+            delete[] _cache.by_lat;
+            _cache.points = nullptr;
+            _cache.by_lat = nullptr;
+            _cache.capacity = 0;
+            return false;
+        }
+        _cache.capacity = total;
+    }
+
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < total; i++) {
+        if (get_rally_point_with_index(i, _cache.points[count])) {
+            count++;
+        }
+    }
+
+    // insertion sort, there are few points and this is done rarely
+    for (uint8_t i = 0; i < count; i++) {
+        const uint8_t idx = i;
+        uint8_t j = i;
+        while (j > 0 && _cache.points[_cache.by_lat[j-1]].lat > _cache.points[idx].lat) {
+            _cache.by_lat[j] = _cache.by_lat[j-1];
+            j--;
+        }
+        _cache.by_lat[j] = idx;
+    }
+
+    _cache.count = count;
+    _cache.total = total;
+    _cache.valid = true;
+    return true;
+}
+
+bool AP_Rally::check_nearest(const LocationFrame &frame, const RallyLocation &rally, float &min_dis, RallyLocation &nearest) const
+{
+    const Location rally_loc = rally_location_to_location(rally);
+    const Vector2f ne = frame.get_distance_NE(rally_loc);
+    if (min_dis >= 0 && fabsf(ne.x) >= min_dis) {
+        return false;
+    }
+    const float dis = ne.length();
+    if (is_valid(rally_loc) && (dis < min_dis || min_dis < 0)) {
+        min_dis = dis;
+        nearest = rally;
+    }
+    return true;
+}
+
 // returns true if a valid rally point is found, otherwise returns false to indicate home position should be used
 bool AP_Rally::find_nearest_rally_point(const Location &current_loc, RallyLocation &return_loc) const
 {
     float min_dis = -1;
-
-    for (uint8_t i = 0; i < (uint8_t) _rally_point_total_count; i++) {
-        RallyLocation next_rally;
-        if (!get_rally_point_with_index(i, next_rally)) {
-            continue;
+    const LocationFrame frame{current_loc};
+
+    if (update_cache()) {
+        // search out from our latitude in both directions. The north
+        // distance to a point is no more than its distance, so each
+        // direction stops at the first point further north or south
+        // than the nearest so far
+        uint8_t lo = 0;
+        uint8_t hi = _cache.count;
+        while (lo < hi) {
+            const uint8_t mid = (lo + hi) / 2;
+            if (_cache.points[_cache.by_lat[mid]].lat < current_loc.lat) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
         }
-        Location rally_loc = rally_location_to_location(next_rally);
-        float dis = current_loc.get_distance(rally_loc);
-
-        if (is_valid(rally_loc) && (dis < min_dis || min_dis < 0)) {
-            min_dis = dis;
-            return_loc = next_rally;
+        for (uint8_t i = lo; i < _cache.count; i++) {
+            if (!check_nearest(frame, _cache.points[_cache.by_lat[i]], min_dis, return_loc)) {
+                break;
+            }
+        }
+        for (uint8_t i = lo; i > 0; i--) {
+            if (!check_nearest(frame, _cache.points[_cache.by_lat[i-1]], min_dis, return_loc)) {
+                break;
+            }
+        }
+    } else {
+        for (uint8_t i = 0; i < (uint8_t) _rally_point_total_count; i++) {
+            RallyLocation next_rally;
+            if (get_rally_point_with_index(i, next_rally)) {
+                check_nearest(frame, next_rally, min_dis, return_loc);
+            }
         }
     }
 
@@ -92,6 +92,14 @@ private:
 
     virtual bool is_valid(const Location &rally_point) const { return true; }
 
+    // consider a rally point for the nearest, returns false once it is
+    // further north or south than the nearest found so far
+    bool check_nearest(const LocationFrame &frame, const RallyLocation &rally, float &min_dis, RallyLocation &nearest) const;
+
+    // load the rally points into _cache if they have changed, returns
+    // false if they could not be allocated
+    bool update_cache() const;
+
     static StorageAccess _storage;
 
     // parameters
@@ -100,6 +108,18 @@ private:
     AP_Int8  _rally_incl_home;
 
     uint32_t _last_change_time_ms = 0xFFFFFFFF;
+
+    // decoded copy of the valid rally points, so that a search does
+    // not read every point from storage, with their indexes sorted
+    // by latitude
+    mutable struct {
+        RallyLocation *points;
+        uint8_t *by_lat;
+        uint8_t capacity;
+        uint8_t count;
+        uint8_t total;      // RALLY_TOTAL the cache was loaded for
+        bool valid;
+    } _cache;
 };
 
 namespace AP {
@@ -255,11 +255,38 @@ void RangeFinder::update(void)
             drivers[i]->update();
         }
     }
+    update_orient_instances();
 #if HAL_LOGGING_ENABLED
     Log_RFND();
 #endif
 }
 
+/*
+  work out which instance each orientation query should use, now that
+  all the backends have updated their status
+ */
+void RangeFinder::update_orient_instances(void)
+{
+    memset(orient_instance, -1, sizeof(orient_instance));
+    for (uint8_t i=0; i<num_instances; i++) {
+        const AP_RangeFinder_Backend *backend = get_backend(i);
+        if (backend == nullptr) {
+            continue;
+        }
+        const Rotation orientation = backend->orientation();
+        if (orientation >= ROTATION_MAX) {
+            continue;
+        }
+        int8_t &instance = orient_instance[orientation];
+        // prefer the first instance that is in range
+        if (instance < 0 ||
+            (drivers[instance]->status() != Status::Good && backend->status() == Status::Good)) {
+            instance = i;
+        }
+    }
+    orient_instance_valid = true;
+}
+
 __INITFUNC__ bool RangeFinder::_add_backend(AP_RangeFinder_Backend *backend, uint8_t instance, uint8_t serial_instance)
 {
     if (!backend) {
@@ -710,6 +737,23 @@ bool RangeFinder::has_orientation(enum Rotation orientation) const
 
 // find first range finder instance with the specified orientation
 AP_RangeFinder_Backend *RangeFinder::find_instance(enum Rotation orientation) const
+{
+    if (orient_instance_valid && orientation < ROTATION_MAX) {
+        const int8_t instance = orient_instance[orientation];
+        if (instance < 0) {
+            return nullptr;
+        }
+        AP_RangeFinder_Backend *backend = get_backend(instance);
+        // orientation may have been changed since the last update
+        if (backend != nullptr && backend->orientation() == orientation) {
+            return backend;
+        }
+    }
+    return find_instance_search(orientation);
+}
+
+// search all instances for the one to use for an orientation
+AP_RangeFinder_Backend *RangeFinder::find_instance_search(enum Rotation orientation) const
 {
     // first try for a rangefinder that is in range
     for (uint8_t i=0; i<num_instances; i++) {
@@ -336,6 +336,14 @@ private:
 
     uint32_t _log_rfnd_bit = -1;
     void Log_RFND() const;
+
+    // instance find_instance() returns for each orientation, -1 for
+    // none. Rebuilt on each update so the per-orientation accessors
+    // don't search all the backends on every call
+    int8_t orient_instance[ROTATION_MAX];
+    bool orient_instance_valid;
+    void update_orient_instances(void);
+    AP_RangeFinder_Backend *find_instance_search(enum Rotation orientation) const;
 };
 
 namespace AP {
@@ -69,8 +69,8 @@ const AP_Param::GroupInfo AP_Scheduler::var_info[] = {
 
     // @Param: OPTIONS
     // @DisplayName: Scheduling options
-    // @Description: This controls optional aspects of the scheduler.
-    // @Bitmask: 0:Enable per-task perf info
+    // @Description: This controls optional aspects of the scheduler. With earliest deadline first scheduling the fast loop tasks still run first on every loop, but the other tasks that are due are run in order of the end of their period rather than in task table order, so a slow task that has been skipped for lack of time moves ahead of higher rate tasks that have only just become due. Earliest deadline first only takes effect on restart. When running offload tasks on worker threads, the tasks that the vehicle marks as safe to run outside the main loop are handed to a small pool of threads when they are due and take no time from the main loop. This is only available on Linux, SITL and H7 boards.
+    // @Bitmask: 0:Enable per-task perf info,1:Earliest deadline first,2:Run offload tasks on worker threads
     // @User: Advanced
     AP_GROUPINFO("OPTIONS",  2, AP_Scheduler, _options, 0),
 
@@ -142,6 +142,10 @@ void AP_Scheduler::init(const AP_Scheduler::Task *tasks, uint8_t num_tasks, uint
         perf_info.allocate_task_info(_num_tasks);
     }
 
+    if (_options & uint8_t(Options::DEADLINE_SCHEDULING)) {
+        _due_tasks = NEW_NOTHROW DueTask[_num_tasks];
+    }
+
     _log_performance_bit = log_performance_bit;
 
     // sanity check the task lists to ensure the priorities are
@@ -189,8 +193,12 @@ static void fill_nanf_stack(void)
  */
 void AP_Scheduler::run(uint32_t time_available)
 {
-    uint32_t run_started_usec = AP_HAL::micros();
-    uint32_t now = run_started_usec;
+    uint32_t now = AP_HAL::micros();
+
+    // in deadline mode the due tasks are collected here and run
+    // after the fast tasks
+    const bool deadline_mode = (_options & uint8_t(Options::DEADLINE_SCHEDULING)) && _due_tasks != nullptr;
+    uint8_t num_due = 0;
 
     uint8_t vehicle_tasks_offset = 0;
     uint8_t common_tasks_offset = 0;
@@ -238,8 +246,6 @@ void AP_Scheduler::run(uint32_t time_available)
                 // this task is not yet scheduled to run again
                 continue;
             }
-            // this task is due to run. Do we have enough time to run it?
-            _task_time_allowed = task.max_time_micros;
 
             if (dt >= interval_ticks*2) {
                 perf_info.task_slipped(i);
@@ -251,57 +257,66 @@ void AP_Scheduler::run(uint32_t time_available)
                 task_not_achieved++;
             }
 
+#if AP_SCHEDULER_OFFLOAD_ENABLED
+            if (task.offload) {
+                const OffloadResult res = offload_task(i, task);
+                if (res == OffloadResult::QUEUED) {
+                    _last_run[i] = _tick_counter;
+                }
+                if (res != OffloadResult::NOT_AVAILABLE) {
+                    continue;
+                }
+            }
+#endif
+
+            if (deadline_mode) {
+                // the deadline is the end of the period in which the
+                // task became due, so a task that has already waited
+                // sorts ahead of higher rate tasks that only just
+                // became due
+                DueTask &due = _due_tasks[num_due++];
+                due.task = &task;
+                due.index = i;
+                due.late_ticks = dt - interval_ticks;
+                due.slack_ticks = int32_t(interval_ticks*2) - dt;
+                continue;
+            }
+
+            // this task is due to run. Do we have enough time to run it?
+            _task_time_allowed = task.max_time_micros;
             if (_task_time_allowed > time_available) {
                 // not enough time to run this task.  Continue loop -
                 // maybe another task will fit into time remaining
+                perf_info.task_starved(i);
                 continue;
             }
+
+            run_task(i, task, dt - interval_ticks, now, time_available);
         } else {
             _task_time_allowed = get_loop_period_us();
+            run_task(i, task, 0, now, time_available);
         }
+    }
 
-        // run it
-        _task_time_started = now;
-        hal.util->persistent_data.scheduler_task = i;
-#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
-        fill_nanf_stack();
-#endif
-        task.function();
-        hal.util->persistent_data.scheduler_task = -1;
-
-        // record the tick counter when we ran. This drives
-        // when we next run the event
-        _last_run[i] = _tick_counter;
-
-        // work out how long the event actually took
-        now = AP_HAL::micros();
-        uint32_t time_taken = now - _task_time_started;
-        bool overrun = false;
-        if (time_taken > _task_time_allowed) {
-            overrun = true;
-            // the event overran!
-            debug(3, "Scheduler overrun task[%u-%s] (%u/%u)\n",
-                  (unsigned)i,
-                  task.name,
-                  (unsigned)time_taken,
-                  (unsigned)_task_time_allowed);
+    if (num_due > 0) {
+        // earliest deadline first. The insertion sort is stable so
+        // tasks with the same deadline keep their priority order
+        for (uint8_t i=1; i<num_due; i++) {
+            const DueTask due = _due_tasks[i];
+            uint8_t j = i;
+            for (; j > 0 && _due_tasks[j-1].slack_ticks > due.slack_ticks; j--) {
+                _due_tasks[j] = _due_tasks[j-1];
+            }
+            _due_tasks[j] = due;
         }
-
-        perf_info.update_task_info(i, time_taken, overrun);
-
-        if (time_taken >= time_available) {
-            /*
-              we are out of time, but we need to keep walking the task
-              table in case there is another fast loop task after this
-              task, plus we need to update the accouting so we can
-              work out if we need to allocate extra time for the loop
-              (lower the loop rate)
-              Just set time_available to zero, which means we will
-              only run fast tasks after this one
-             */
-            time_available = 0;
-        } else {
-            time_available -= time_taken;
+        for (uint8_t i=0; i<num_due; i++) {
+            const DueTask &due = _due_tasks[i];
+            _task_time_allowed = due.task->max_time_micros;
+            if (_task_time_allowed > time_available) {
+                perf_info.task_starved(due.index);
+                continue;
+            }
+            run_task(due.index, *due.task, due.late_ticks, now, time_available);
         }
     }
 
@@ -315,6 +330,172 @@ void AP_Scheduler::run(uint32_t time_available)
     }
 }
 
+/*
+  run a single task which is late by late_ticks loops, updating now
+  and the time available for the rest of this tick
+ */
+void AP_Scheduler::run_task(uint8_t i, const Task &task, uint16_t late_ticks, uint32_t &now, uint32_t &time_available)
+{
+    // time from the start of the loop in which the task was due to
+    // the time it starts
+    const uint32_t slip_us = late_ticks * get_loop_period_us() + (now - uint32_t(_loop_sample_time_us));
+
+    // run it
+    _task_time_started = now;
+    hal.util->persistent_data.scheduler_task = i;
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+    fill_nanf_stack();
+#endif
+    task.function();
+    hal.util->persistent_data.scheduler_task = -1;
+
+    // record the tick counter when we ran. This drives
+    // when we next run the event
+    _last_run[i] = _tick_counter;
+
+    // work out how long the event actually took
+    now = AP_HAL::micros();
+    uint32_t time_taken = now - _task_time_started;
+    bool overrun = false;
+    if (time_taken > _task_time_allowed) {
+        overrun = true;
+        // the event overran!
+        debug(3, "Scheduler overrun task[%u-%s] (%u/%u)\n",
+              (unsigned)i,
+              task.name,
+              (unsigned)time_taken,
+              (unsigned)_task_time_allowed);
+    }
+
+    perf_info.update_task_info(i, time_taken, overrun, slip_us);
+
+    if (time_taken >= time_available) {
+        /*
+          we are out of time, but we need to keep walking the task
+          table in case there is another fast loop task after this
+          task, plus we need to update the accouting so we can
+          work out if we need to allocate extra time for the loop
+          (lower the loop rate)
+          Just set time_available to zero, which means we will
+          only run fast tasks after this one
+         */
+        time_available = 0;
+    } else {
+        time_available -= time_taken;
+    }
+}
+
+#if AP_SCHEDULER_OFFLOAD_ENABLED
+/*
+  hand a due task to the worker threads. The statistics of the
+  previous completed run are recorded here so the per-task perf info
+  is only ever updated from the main loop
+ */
+AP_Scheduler::OffloadResult AP_Scheduler::offload_task(uint8_t i, const Task &task)
+{
+    if (!(_options & uint8_t(Options::OFFLOAD_TASKS)) || !start_offload_threads()) {
+        return OffloadResult::NOT_AVAILABLE;
+    }
+
+    WITH_SEMAPHORE(_offload.sem);
+    OffloadState &st = _offload.tasks[i];
+    if (st.busy) {
+        return OffloadResult::BUSY;
+    }
+    if (st.last_time_us != 0) {
+        perf_info.update_task_info(i, MIN(st.last_time_us, UINT16_MAX), st.last_time_us > task.max_time_micros, 0);
+        st.last_time_us = 0;
+    }
+    st.task = &task;
+    st.busy = true;
+    _offload.queue[(_offload.queue_head + _offload.queue_count) % _num_tasks] = i;
+    _offload.queue_count++;
+    _offload.wake.signal();
+    return OffloadResult::QUEUED;
+}
+
+/*
+  start the worker threads on first use. Returns false if no thread
+  could be started, in which case offload tasks run in the main loop
+ */
+bool AP_Scheduler::start_offload_threads(void)
+{
+    switch (_offload.state) {
+    case decltype(_offload.state)::RUNNING:
+        return true;
+    case decltype(_offload.state)::FAILED:
+        return false;
+    case decltype(_offload.state)::NOT_STARTED:
+        break;
+    }
+    _offload.state = decltype(_offload.state)::FAILED;
+    _offload.tasks = NEW_NOTHROW OffloadState[_num_tasks];
+    _offload.queue = NEW_NOTHROW uint8_t[_num_tasks];
+    if (_offload.tasks == nullptr || _offload.queue == nullptr) {
+        delete[] _offload.tasks;
+        delete[] _offload.queue;
+        _offload.tasks = nullptr;
+        _offload.queue = nullptr;
+        return false;
+    }
+    // thread names must stay valid for the life of the thread
+    static const char *names[] { "SCH0", "SCH1", "SCH2", "SCH3" };
+    static_assert(AP_SCHEDULER_OFFLOAD_THREADS <= ARRAY_SIZE(names), "too many offload threads");
+    uint8_t started = 0;
+    for (uint8_t i=0; i<AP_SCHEDULER_OFFLOAD_THREADS; i++) {
+        if (hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Scheduler::offload_thread, void),
+                                          names[i], AP_SCHEDULER_OFFLOAD_STACK_SIZE, AP_HAL::Scheduler::PRIORITY_IO, 0)) {
+            started++;
+        }
+    }
+    if (started == 0) {
+        DEV_PRINTF("Unable to start scheduler offload threads\n");
+        delete[] _offload.tasks;
+        delete[] _offload.queue;
+        _offload.tasks = nullptr;
+        _offload.queue = nullptr;
+        return false;
+    }
+    _offload.state = decltype(_offload.state)::RUNNING;
+    return true;
+}
+
+/*
+  worker thread loop. A worker takes one task at a time from the
+  queue, waking another worker if more tasks are waiting so that
+  tasks queued on the same tick can run in parallel
+ */
+void AP_Scheduler::offload_thread(void)
+{
+    while (true) {
+        _offload.wake.wait_blocking();
+        while (true) {
+            OffloadState *st;
+            {
+                WITH_SEMAPHORE(_offload.sem);
+                if (_offload.queue_count == 0) {
+                    break;
+                }
+                st = &_offload.tasks[_offload.queue[_offload.queue_head]];
+                _offload.queue_head = (_offload.queue_head + 1) % _num_tasks;
+                _offload.queue_count--;
+                if (_offload.queue_count > 0) {
+                    _offload.wake.signal();
+                }
+            }
+
+            const uint32_t start_us = AP_HAL::micros();
+            st->task->function();
+            const uint32_t time_taken = AP_HAL::micros() - start_us;
+
+            WITH_SEMAPHORE(_offload.sem);
+            st->last_time_us = MAX(time_taken, 1U);
+            st->busy = false;
+        }
+    }
+}
+#endif  // AP_SCHEDULER_OFFLOAD_ENABLED
+
 /*
   return number of micros until the current task reaches its deadline
  */
@@ -438,6 +619,9 @@ void AP_Scheduler::update_logging()
     if (_log_performance_bit != (uint32_t)-1 &&
         AP::logger().should_log(_log_performance_bit)) {
         Log_Write_Performance();
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+        Log_Write_Task_Histograms();
+#endif
     }
     perf_info.set_loop_rate(get_loop_rate_hz());
     perf_info.reset();
@@ -478,6 +662,39 @@ void AP_Scheduler::Log_Write_Performance()
     };
     AP::logger().WriteCriticalBlock(&pkt, sizeof(pkt));
 }
+
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+// write the run time and start slip percentiles of each task that has
+// run since the last reset of the task statistics
+void AP_Scheduler::Log_Write_Task_Histograms()
+{
+    const uint64_t now_us = AP_HAL::micros64();
+    for (uint8_t i = 0; i < _num_tasks; i++) {
+        const AP::PerfInfo::TaskInfo* ti = perf_info.get_task_info(i);
+        if (ti == nullptr) {
+            return;
+        }
+        if (ti->tick_count == 0) {
+            continue;
+        }
+        const struct log_Task_Histogram pkt {
+            LOG_PACKET_HEADER_INIT(LOG_TASK_HISTOGRAM_MSG),
+            time_us  : now_us,
+            task     : i,
+            count    : uint16_t(MIN(ti->tick_count, UINT16_MAX)),
+            run_p50  : uint16_t(ti->run_time.percentile_us(50)),
+            run_p90  : uint16_t(ti->run_time.percentile_us(90)),
+            run_p99  : uint16_t(ti->run_time.percentile_us(99)),
+            run_max  : ti->max_time_us,
+            slip_p50 : uint16_t(ti->start_slip.percentile_us(50)),
+            slip_p90 : uint16_t(ti->start_slip.percentile_us(90)),
+            slip_p99 : uint16_t(ti->start_slip.percentile_us(99)),
+            starved  : ti->starve_count,
+        };
+        AP::logger().WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+#endif
 #endif  // HAL_LOGGING_ENABLED
 
 // display task statistics as text buffer for @SYS/tasks.txt
@@ -486,6 +703,24 @@ void AP_Scheduler::task_info(ExpandingString &str)
     // a header to allow for machine parsers to determine format
     str.printf("TasksV2\n");
 
+    print_task_info(str, false);
+}
+
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+// display task run time and start slip histograms as text buffer for
+// @SYS/task_hist.txt. Each histogram is shown as its p50/p99/max
+// bucket bounds in microseconds followed by the bucket counts
+void AP_Scheduler::task_histogram_info(ExpandingString &str)
+{
+    // a header to allow for machine parsers to determine format
+    str.printf("TaskHistV1\n");
+
+    print_task_info(str, true);
+}
+#endif
+
+void AP_Scheduler::print_task_info(ExpandingString &str, bool histograms)
+{
     // dynamically enable statistics collection
     if (!(_options & uint8_t(Options::RECORD_TASK_INFO))) {
         _options.set(_options | uint8_t(Options::RECORD_TASK_INFO));
@@ -542,6 +777,12 @@ void AP_Scheduler::task_info(ExpandingString &str)
             task_name = _common_tasks[common_tasks_offset++].name;
         }
 
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+        if (histograms) {
+            ti->print_histograms(task_name, str);
+            continue;
+        }
+#endif
         ti->print(task_name, total_time, str);
     }
 }
@@ -47,7 +47,27 @@
     AP_SCHEDULER_NAME_INITIALIZER(classname, func)\
     .rate_hz = _rate_hz,\
     .max_time_micros = _max_time_micros,        \
-    .priority = _priority \
+    .priority = _priority, \
+    .offload = false \
+}
+
+/*
+  macro for a task which may be run on a worker thread rather than
+  the main loop when SCHED_OPTIONS enables offloading. An offloaded
+  task runs without the scheduler semaphore held and may run at the
+  same time as the main loop and other offloaded tasks, so it must
+  protect any state it shares with them with its own semaphore, or
+  take AP::scheduler().get_semaphore() around code that touches
+  state owned by the main loop. It is never run twice at the same
+  time, and is not started again until its previous run has finished
+ */
+#define SCHED_TASK_CLASS_OFFLOAD(classname, classptr, func, _rate_hz, _max_time_micros, _priority) { \
+    .function = FUNCTOR_BIND(classptr, &classname::func, void),\
+    AP_SCHEDULER_NAME_INITIALIZER(classname, func)\
+    .rate_hz = _rate_hz,\
+    .max_time_micros = _max_time_micros,        \
+    .priority = _priority, \
+    .offload = true \
 }
 
 /*
@@ -58,7 +78,8 @@
     AP_FAST_NAME_INITIALIZER(classname, func)\
     .rate_hz = 0,\
     .max_time_micros = 0,\
-    .priority = AP_Scheduler::FAST_TASK_PRI0 \
+    .priority = AP_Scheduler::FAST_TASK_PRI0, \
+    .offload = false \
 }
 
 /*
@@ -90,10 +111,13 @@ public:
         float rate_hz;
         uint16_t max_time_micros;
         uint8_t priority; // task priority
+        bool offload;     // task may be run on a worker thread
     };
 
     enum class Options : uint8_t {
-        RECORD_TASK_INFO = 1 << 0
+        RECORD_TASK_INFO = 1 << 0,
+        DEADLINE_SCHEDULING = 1 << 1,
+        OFFLOAD_TASKS = 1 << 2,
     };
 
     enum FastTaskPriorities {
@@ -115,6 +139,10 @@ public:
 
     // write out PERF message to logger
     void Log_Write_Performance();
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+    // write out TSKH messages to logger
+    void Log_Write_Task_Histograms();
+#endif
 
     // call when one tick has passed
     void tick(void);
@@ -189,6 +217,9 @@ public:
     HAL_Semaphore &get_semaphore(void) { return _rsem; }
 
     void task_info(ExpandingString &str);
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+    void task_histogram_info(ExpandingString &str);
+#endif
 
     static const struct AP_Param::GroupInfo var_info[];
 
@@ -233,6 +264,50 @@ private:
     // tick counter at the time we last ran each task
     uint16_t *_last_run;
 
+    // tasks due on this tick, used to order them by deadline when
+    // DEADLINE_SCHEDULING is set
+    struct DueTask {
+        const Task *task;
+        int32_t slack_ticks;  // ticks until the end of the period in which the task became due
+        uint16_t late_ticks;  // ticks since the task became due
+        uint8_t index;
+    };
+    DueTask *_due_tasks;
+
+    // run a single task, updating now and time_available
+    void run_task(uint8_t i, const Task &task, uint16_t late_ticks, uint32_t &now, uint32_t &time_available);
+
+#if AP_SCHEDULER_OFFLOAD_ENABLED
+    // pool of worker threads for tasks created with SCHED_TASK_CLASS_OFFLOAD
+    enum class OffloadResult : uint8_t {
+        QUEUED,         // the task has been handed to a worker
+        BUSY,           // the previous run of the task has not finished
+        NOT_AVAILABLE,  // offloading is disabled, run the task in the main loop
+    };
+    OffloadResult offload_task(uint8_t i, const Task &task);
+    bool start_offload_threads(void);
+    void offload_thread(void);
+
+    struct OffloadState {
+        const Task *task;
+        uint32_t last_time_us;  // time taken by the last completed run, 0 once recorded
+        bool busy;              // queued or running on a worker
+    };
+    struct {
+        enum class State : uint8_t {
+            NOT_STARTED,
+            RUNNING,
+            FAILED,
+        } state;
+        HAL_Semaphore sem;            // protects everything below
+        HAL_BinarySemaphore wake;     // signalled when a task is queued
+        OffloadState *tasks;          // one entry per task
+        uint8_t *queue;               // ring of queued task indexes
+        uint8_t queue_head;
+        uint8_t queue_count;
+    } _offload;
+#endif
+
     // number of microseconds allowed for the current task
     uint32_t _task_time_allowed;
 
@@ -273,6 +348,9 @@ private:
 
     // semaphore that is held while not waiting for ins samples
     HAL_Semaphore _rsem;
+
+    // print one line per task for @SYS/tasks.txt or @SYS/task_hist.txt
+    void print_task_info(ExpandingString &str, bool histograms);
 };
 
 namespace AP {
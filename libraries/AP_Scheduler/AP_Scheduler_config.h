@@ -9,3 +9,25 @@
 #ifndef AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED
 #define AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED 1
 #endif
+
+#ifndef AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+#define AP_SCHEDULER_TASK_HISTOGRAM_ENABLED (HAL_PROGRAM_SIZE_LIMIT_KB > 1024)
+#endif
+
+#ifndef AP_SCHEDULER_OFFLOAD_ENABLED
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX || CONFIG_HAL_BOARD == HAL_BOARD_SITL
+#define AP_SCHEDULER_OFFLOAD_ENABLED 1
+#elif CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS && defined(STM32H7)
+#define AP_SCHEDULER_OFFLOAD_ENABLED 1
+#else
+#define AP_SCHEDULER_OFFLOAD_ENABLED 0
+#endif
+#endif
+
+#ifndef AP_SCHEDULER_OFFLOAD_THREADS
+#define AP_SCHEDULER_OFFLOAD_THREADS 2
+#endif
+
+#ifndef AP_SCHEDULER_OFFLOAD_STACK_SIZE
+#define AP_SCHEDULER_OFFLOAD_STACK_SIZE 8192
+#endif
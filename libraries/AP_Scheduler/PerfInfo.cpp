@@ -62,7 +62,7 @@ void AP::PerfInfo::free_task_info()
 }
 
 // called after each run of a task to update its statistics based on measurements taken by the scheduler
-void AP::PerfInfo::update_task_info(uint8_t task_index, uint16_t task_time_us, bool overrun)
+void AP::PerfInfo::update_task_info(uint8_t task_index, uint16_t task_time_us, bool overrun, uint32_t slip_us)
 {
     if (_task_info == nullptr) {
         return;
@@ -73,10 +73,10 @@ void AP::PerfInfo::update_task_info(uint8_t task_index, uint16_t task_time_us, b
         return;
     }
     TaskInfo& ti = _task_info[task_index];
-    ti.update(task_time_us, overrun);
+    ti.update(task_time_us, overrun, slip_us);
 }
 
-void AP::PerfInfo::TaskInfo::update(uint16_t task_time_us, bool overrun)
+void AP::PerfInfo::TaskInfo::update(uint16_t task_time_us, bool overrun, uint32_t slip_us)
 {
     max_time_us = MAX(max_time_us, task_time_us);
     if (min_time_us == 0) {
@@ -89,6 +89,10 @@ void AP::PerfInfo::TaskInfo::update(uint16_t task_time_us, bool overrun)
     if (overrun) {
         overrun_count++;
     }
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+    run_time.add(task_time_us);
+    start_slip.add(slip_us);
+#endif
 }
 
 void AP::PerfInfo::TaskInfo::print(const char* task_name, uint32_t total_time, ExpandingString& str) const
@@ -109,6 +113,65 @@ void AP::PerfInfo::TaskInfo::print(const char* task_name, uint32_t total_time, E
                 unsigned(MIN(overrun_count, 999)), unsigned(MIN(slip_count, 999)), pct);
 }
 
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+void AP::PerfInfo::Histogram::add(uint32_t time_us)
+{
+    const uint8_t bucket = time_us == 0 ? 0 : MIN(32 - __builtin_clz(time_us), num_buckets - 1);
+    if (count[bucket] < UINT16_MAX) {
+        count[bucket]++;
+    }
+}
+
+uint32_t AP::PerfInfo::Histogram::total() const
+{
+    uint32_t ret = 0;
+    for (uint8_t i = 0; i < num_buckets; i++) {
+        ret += count[i];
+    }
+    return ret;
+}
+
+uint32_t AP::PerfInfo::Histogram::percentile_us(uint8_t pct) const
+{
+    const uint32_t n = total();
+    if (n == 0) {
+        return 0;
+    }
+    // number of samples at or below the percentile, rounded up
+    const uint32_t target = MAX((n * pct + 99) / 100, 1U);
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < num_buckets - 1; i++) {
+        sum += count[i];
+        if (sum >= target) {
+            return (1U << i) - 1;
+        }
+    }
+    return 1U << (num_buckets - 2);
+}
+
+void AP::PerfInfo::Histogram::print(const char *label, ExpandingString& str) const
+{
+    str.printf(" %s=%u/%u/%u [", label,
+               unsigned(percentile_us(50)), unsigned(percentile_us(99)), unsigned(max_us()));
+    for (uint8_t i = 0; i < num_buckets; i++) {
+        str.printf(i == 0 ? "%u" : ",%u", unsigned(count[i]));
+    }
+    str.printf("]");
+}
+
+void AP::PerfInfo::TaskInfo::print_histograms(const char* task_name, ExpandingString& str) const
+{
+#if AP_SCHEDULER_EXTENDED_TASKINFO_ENABLED
+    str.printf("%-32.32s N=%5u STV=%5u", task_name, unsigned(MIN(tick_count, 99999U)), unsigned(starve_count));
+#else
+    str.printf("%-16.16s N=%5u STV=%5u", task_name, unsigned(MIN(tick_count, 99999U)), unsigned(starve_count));
+#endif
+    run_time.print("T", str);
+    start_slip.print("S", str);
+    str.printf("\n");
+}
+#endif // AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+
 // check_loop_time - check latest loop time vs min, max and overtime threshold
 void AP::PerfInfo::check_loop_time(uint32_t time_in_micros)
 {
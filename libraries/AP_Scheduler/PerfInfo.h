@@ -13,6 +13,25 @@ class PerfInfo {
 public:
     PerfInfo() {}
 
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+    // histogram of times in microseconds with log2 sized buckets.
+    // Bucket n holds times with n significant bits, so bucket 0 is
+    // 0us, bucket 1 is 1us, bucket 2 is 2-3us and so on, with the
+    // last bucket holding all times from 16384us
+    struct Histogram {
+        static constexpr uint8_t num_buckets = 16;
+        uint16_t count[num_buckets];
+
+        void add(uint32_t time_us);
+        uint32_t total() const;
+        // upper bound of the bucket holding the given percentile
+        uint32_t percentile_us(uint8_t pct) const;
+        // upper bound of the highest non-empty bucket
+        uint32_t max_us() const { return percentile_us(100); }
+        void print(const char *label, ExpandingString& str) const;
+    };
+#endif
+
     // per-task timing information
     struct TaskInfo {
         uint16_t min_time_us;
@@ -21,9 +40,17 @@ public:
         uint32_t tick_count;
         uint16_t slip_count;
         uint16_t overrun_count;
+        uint16_t starve_count;      // runs skipped as the task did not fit in the time left
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+        Histogram run_time;    // time taken by each run of the task
+        Histogram start_slip;  // time from when the task was due to when it started
+#endif
 
-        void update(uint16_t task_time_us, bool overrun);
+        void update(uint16_t task_time_us, bool overrun, uint32_t slip_us);
         void print(const char* task_name, uint32_t total_time, ExpandingString& str) const;
+#if AP_SCHEDULER_TASK_HISTOGRAM_ENABLED
+        void print_histograms(const char* task_name, ExpandingString& str) const;
+#endif
     };
 
     /* Do not allow copies */
@@ -54,7 +81,13 @@ public:
         return (_task_info && task_index < _num_tasks) ? &_task_info[task_index] : nullptr;
     }
     // called after each run of a task to update its statistics based on measurements taken by the scheduler
-    void update_task_info(uint8_t task_index, uint16_t task_time_us, bool overrun);
+    void update_task_info(uint8_t task_index, uint16_t task_time_us, bool overrun, uint32_t slip_us);
+    // record that a due task was skipped for lack of time
+    void task_starved(uint8_t task_index) {
+        if (_task_info && task_index < _num_tasks && _task_info[task_index].starve_count < UINT16_MAX) {
+            _task_info[task_index].starve_count++;
+        }
+    }
     // record that a task slipped
     void task_slipped(uint8_t task_index) {
         if (_task_info && task_index < _num_tasks) {
@@ -98,6 +98,7 @@ const AP_Param::GroupInfo AP_Scripting::var_info[] = {
     // @Bitmask: 4: Disable pre-arm check
     // @Bitmask: 5: Save CRC of current scripts to loaded and running checksum parameters enabling pre-arm
     // @Bitmask: 6: Disable heap expansion on allocation failure
+    // @Bitmask: 7: Allow precompiled bytecode (.luac) scripts from the scripts directory
     // @User: Advanced
     AP_GROUPINFO("DEBUG_OPTS", 4, AP_Scripting, _debug_options, 0),
 
@@ -159,12 +160,71 @@ const AP_Param::GroupInfo AP_Scripting::var_info[] = {
 
     // @Param: THD_PRIORITY
     // @DisplayName: Scripting thread priority
-    // @Description: This sets the priority of the scripting thread. This is normally set to a low priority to prevent scripts from interfering with other parts of the system. Advanced users can change this priority if scripting needs to be prioritised for realtime applications. WARNING: changing this parameter can impact the stability of your flight controller. The scipting thread priority in this parameter is chosen based on a set of system level priorities for other subsystems. It is strongly recommended that you use the lowest priority that is sufficient for your application. Note that all scripts run at the same priority, so if you raise this priority you must carefully audit all lua scripts for behaviour that does not interfere with the operation of the system.
+    // @Description: This sets the priority of the scripting thread. This is normally set to a low priority to prevent scripts from interfering with other parts of the system. Advanced users can change this priority if scripting needs to be prioritised for realtime applications. WARNING: changing this parameter can impact the stability of your flight controller. The scipting thread priority in this parameter is chosen based on a set of system level priorities for other subsystems. It is strongly recommended that you use the lowest priority that is sufficient for your application. Note that all scripts other than fast lane scripts (see SCR_FAST_HEAP) run at the same priority, so if you raise this priority you must carefully audit all lua scripts for behaviour that does not interfere with the operation of the system.
     // @Values: 0:Normal, 1:IO Priority, 2:Storage Priority, 3:UART Priority, 4:I2C Priority, 5:SPI Priority, 6:Timer Priority, 7:Main Priority, 8:Boost Priority
     // @RebootRequired: True
     // @User: Advanced
     AP_GROUPINFO("THD_PRIORITY", 14, AP_Scripting, _thd_priority, uint8_t(ThreadPriority::NORMAL)),
 
+    // @Param: GC_MODE
+    // @DisplayName: Scripting garbage collection mode
+    // @Description: How Lua garbage is collected. Full runs a complete collection after every script run, which keeps memory use lowest but takes longer the more memory scripts use. Incremental does a limited amount of collection work, set by SCR_GC_STEP, after each script run and none while scripts are running, so the time spent collecting is bounded. A full collection is still done if an allocation fails.
+    // @Values: 0:Full, 1:Incremental
+    // @User: Advanced
+    AP_GROUPINFO("GC_MODE", 19, AP_Scripting, _gc_mode, 0),
+
+    // @Param: GC_PAUSE
+    // @DisplayName: Scripting garbage collection pause
+    // @Description: In incremental mode, how much the Lua memory use must grow, as a percentage of the memory in use after a collection cycle, before the next cycle starts. Lower values collect more often and use less memory.
+    // @Range: 100 1000
+    // @Units: %
+    // @User: Advanced
+    AP_GROUPINFO("GC_PAUSE", 20, AP_Scripting, _gc_pause, 200),
+
+    // @Param: GC_STEPMUL
+    // @DisplayName: Scripting garbage collection step multiplier
+    // @Description: In incremental mode, the speed of collection relative to memory allocation, as a percentage. Higher values do more collection work in each step.
+    // @Range: 40 1000
+    // @Units: %
+    // @User: Advanced
+    AP_GROUPINFO("GC_STEPMUL", 21, AP_Scripting, _gc_stepmul, 200),
+
+    // @Param: GC_STEP
+    // @DisplayName: Scripting garbage collection step size
+    // @Description: In incremental mode, the amount of collection work done after each script run, in kilobytes of allocation. This caps the time spent collecting between script runs.
+    // @Range: 1 64
+    // @Units: kB
+    // @User: Advanced
+    AP_GROUPINFO("GC_STEP", 22, AP_Scripting, _gc_step_kb, 8),
+
+#if AP_SCRIPTING_FAST_LANE_ENABLED
+    // @Param: FAST_HEAP
+    // @DisplayName: Scripting fast lane heap size
+    // @Description: Amount of memory for the fast scripting lane, 0 disables it. Scripts in the fast subdirectory of the scripts directory run in their own thread with their own heap, so they are not delayed by other scripts or by collecting their garbage. Each fast lane script runs at the fixed rate set by the delay it returns, measured from when the run was due. Fast lane scripts should only use the vehicle state and control bindings; opening devices, sockets or serial ports is not safe to do from both lanes.
+    // @Range: 0 1048576
+    // @Increment: 1024
+    // @Units: B
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("FAST_HEAP", 23, AP_Scripting, _fast_heap_size, 0),
+
+    // @Param: FAST_VM_I
+    // @DisplayName: Scripting fast lane instruction count
+    // @Description: The number of virtual machine instructions a fast lane script can run each time before considering it to have taken an excessive amount of time
+    // @Range: 1000 1000000
+    // @Increment: 10000
+    // @User: Advanced
+    AP_GROUPINFO("FAST_VM_I", 24, AP_Scripting, _fast_vm_exec_count, 10000),
+
+    // @Param: FAST_PRIO
+    // @DisplayName: Scripting fast lane thread priority
+    // @Description: The priority of the fast lane scripting thread, see SCR_THD_PRIORITY. It is strongly recommended that you use the lowest priority that is sufficient for your application.
+    // @Values: 0:Normal, 1:IO Priority, 2:Storage Priority, 3:UART Priority, 4:I2C Priority, 5:SPI Priority, 6:Timer Priority, 7:Main Priority, 8:Boost Priority
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("FAST_PRIO", 25, AP_Scripting, _fast_thd_priority, uint8_t(ThreadPriority::NORMAL)),
+#endif // AP_SCRIPTING_FAST_LANE_ENABLED
+
 #if AP_SCRIPTING_SERIALDEVICE_ENABLED
     // @Param: SDEV_EN
     // @DisplayName: Scripting serial device enable
@@ -216,23 +276,8 @@ AP_Scripting::AP_Scripting() {
     _singleton = this;
 }
 
-void AP_Scripting::init(void) {
-    if (!_enable) {
-        return;
-    }
-
-#if AP_FILESYSTEM_FILE_WRITING_ENABLED
-    if ((_dir_disable & uint16_t(AP_Scripting::SCR_DIR::SCRIPTS)) == 0) {
-        // Only try creating scripts directory if loading from it is enabled
-        const char *dir_name = SCRIPTING_DIRECTORY;
-        if (AP::FS().mkdir(dir_name)) {
-            if (errno != EEXIST) {
-                GCS_SEND_TEXT(MAV_SEVERITY_INFO, "Scripting: failed to create (%s)", dir_name);
-            }
-        }
-    }
-#endif
-
+// get the HAL priority for a scripting thread priority
+AP_HAL::Scheduler::priority_base AP_Scripting::hal_priority(ThreadPriority thd_priority) {
     AP_HAL::Scheduler::priority_base priority = AP_HAL::Scheduler::PRIORITY_SCRIPTING;
     static const struct {
         ThreadPriority scr_priority;
@@ -249,16 +294,51 @@ void AP_Scripting::init(void) {
         { ThreadPriority::BOOST, AP_HAL::Scheduler::PRIORITY_BOOST },
     };
     for (const auto &p : priority_map) {
-        if (p.scr_priority == _thd_priority) {
+        if (p.scr_priority == thd_priority) {
             priority = p.hal_priority;
         }
     }
+    return priority;
+}
+
+void AP_Scripting::init(void) {
+    if (!_enable) {
+        return;
+    }
+
+#if AP_FILESYSTEM_FILE_WRITING_ENABLED
+    if ((_dir_disable & uint16_t(AP_Scripting::SCR_DIR::SCRIPTS)) == 0) {
+        // Only try creating scripts directory if loading from it is enabled
+        const char *dir_names[] {
+            SCRIPTING_DIRECTORY,
+#if AP_SCRIPTING_FAST_LANE_ENABLED
+            fast_lane_enabled() ? SCRIPTING_DIRECTORY "/fast" : nullptr,
+#endif
+        };
+        for (const char *dir_name : dir_names) {
+            if (dir_name != nullptr && AP::FS().mkdir(dir_name)) {
+                if (errno != EEXIST) {
+                    GCS_SEND_TEXT(MAV_SEVERITY_INFO, "Scripting: failed to create (%s)", dir_name);
+                }
+            }
+        }
+    }
+#endif
 
     if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Scripting::thread, void),
-                                      "Scripting", SCRIPTING_STACK_SIZE, priority, 0)) {
+                                      "Scripting", SCRIPTING_STACK_SIZE, hal_priority(_thd_priority), 0)) {
         GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "Scripting: %s", "failed to start");
         _thread_failed = true;
     }
+
+#if AP_SCRIPTING_FAST_LANE_ENABLED
+    if (fast_lane_enabled() &&
+        !hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Scripting::fast_thread, void),
+                                      "ScriptFast", SCRIPTING_STACK_SIZE, hal_priority(_fast_thd_priority), 0)) {
+        GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "Scripting: %s", "fast lane failed to start");
+        _thread_failed = true;
+    }
+#endif
 }
 
 #if AP_SCRIPTING_SERIALDEVICE_ENABLED
@@ -310,7 +390,7 @@ void AP_Scripting::thread(void) {
         _restart = false;
         _init_failed = false;
 
-        lua_scripts *lua = NEW_NOTHROW lua_scripts(_script_vm_exec_count, _script_heap_size, _debug_options);
+        lua_scripts *lua = NEW_NOTHROW lua_scripts(_script_vm_exec_count, _script_heap_size, _debug_options, lua_scripts::Lane::NORMAL);
         if (lua == nullptr || !lua->heap_allocated()) {
             GCS_SEND_TEXT(MAV_SEVERITY_CRITICAL, "Scripting: %s", "Unable to allocate memory");
             _init_failed = true;
@@ -323,6 +403,9 @@ void AP_Scripting::thread(void) {
 #if AP_ARMING_ENABLED && AP_ARMING_AUX_AUTH_ENABLED
             // Clear any dangling pre-arms from previous script loads
             AP_Arming::get_singleton()->reset_all_aux_auths();
+#endif
+#if AP_SCRIPTING_FAST_LANE_ENABLED
+            _fast_start = true;
 #endif
             // run won't return while scripting is still active
             lua->run();
@@ -333,6 +416,15 @@ void AP_Scripting::thread(void) {
         delete lua;
         lua = nullptr;
 
+#if AP_SCRIPTING_FAST_LANE_ENABLED
+        // stop the fast lane before freeing the resources the lanes share
+        _stop = true;
+        _fast_start = false;
+        while (_fast_running) {
+            hal.scheduler->delay(10);
+        }
+#endif
+
         // clear allocated i2c devices
         for (uint8_t i=0; i<SCRIPTING_MAX_NUM_I2C_DEVICE; i++) {
             delete _i2c_dev[i];
@@ -398,6 +490,35 @@ void AP_Scripting::thread(void) {
         }
     }
 }
+
+#if AP_SCRIPTING_FAST_LANE_ENABLED
+/*
+  run the fast lane each time the main thread starts scripts. The
+  main thread waits for this lane to stop before it frees anything
+  the scripts used
+ */
+void AP_Scripting::fast_thread(void) {
+    while (true) {
+        if (!_fast_start) {
+            hal.scheduler->delay(100);
+            continue;
+        }
+        _fast_running = true;
+        _fast_start = false;
+
+        lua_scripts *lua = NEW_NOTHROW lua_scripts(_fast_vm_exec_count, _fast_heap_size, _debug_options, lua_scripts::Lane::FAST);
+        if (lua == nullptr || !lua->heap_allocated()) {
+            GCS_SEND_TEXT(MAV_SEVERITY_CRITICAL, "Scripting: %s", "Unable to allocate fast lane memory");
+        } else {
+            // run won't return while scripting is still active
+            lua->run();
+        }
+        delete lua;
+
+        _fast_running = false;
+    }
+}
+#endif // AP_SCRIPTING_FAST_LANE_ENABLED
 #pragma GCC pop_options
 
 void AP_Scripting::handle_mission_command(const AP_Mission::Mission_Command& cmd_in)
@@ -477,6 +598,11 @@ bool AP_Scripting::arming_checks(size_t buflen, char *buffer) const
     return true;
 }
 
+void AP_Scripting::scripts_info(ExpandingString &str)
+{
+    lua_scripts::scripts_info(str);
+}
+
 void AP_Scripting::restart_all()
 {
     _restart = true;
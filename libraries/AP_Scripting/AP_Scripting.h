@@ -85,6 +85,9 @@ public:
     
     void restart_all(void);
 
+    // run statistics of each script and heap usage for @SYS/scripts.txt
+    void scripts_info(class ExpandingString &str);
+
    // User parameters for inputs into scripts 
    AP_Float _user[6];
 
@@ -94,6 +97,15 @@ public:
     };
     uint16_t get_disabled_dir() { return uint16_t(_dir_disable.get());}
 
+    enum class GCMode : uint8_t {
+        FULL = 0,
+        INCREMENTAL = 1,
+    };
+    GCMode get_gc_mode() const { return GCMode(_gc_mode.get()); }
+    int16_t get_gc_pause() const { return _gc_pause; }
+    int16_t get_gc_stepmul() const { return _gc_stepmul; }
+    int16_t get_gc_step_kb() const { return _gc_step_kb; }
+
     // the number of and storage for i2c devices
     uint8_t num_i2c_devices;
     AP_HAL::I2CDevice *_i2c_dev[SCRIPTING_MAX_NUM_I2C_DEVICE];
@@ -120,8 +132,6 @@ public:
     // PWMSource storage
     uint8_t num_pwm_source;
     AP_HAL::PWMSource *_pwm_source[SCRIPTING_MAX_NUM_PWM_SOURCE];
-    int get_current_env_ref() { return current_env_ref; }
-    void set_current_env_ref(int ref) { current_env_ref = ref; }
 
 #if AP_NETWORKING_ENABLED
     // SocketAPM storage
@@ -160,12 +170,20 @@ public:
         DISABLE_PRE_ARM = 1U << 4,
         SAVE_CHECKSUM = 1U << 5,
         DISABLE_HEAP_EXPANSION = 1U << 6,
+        ALLOW_BYTECODE = 1U << 7,
     };
 
 private:
 
     void thread(void); // main script execution thread
 
+#if AP_SCRIPTING_FAST_LANE_ENABLED
+    void fast_thread(void); // fast lane script execution thread
+    bool fast_lane_enabled() const { return _fast_heap_size > 0; }
+    bool _fast_start; // set by the main thread to start the fast lane
+    bool _fast_running; // true while the fast lane is running scripts
+#endif
+
     // Check if DEBUG_OPTS bit has been set to save current checksum values to params
     void save_checksum();
 
@@ -192,9 +210,22 @@ private:
     AP_Int16 _dir_disable;
     AP_Int32 _required_loaded_checksum;
     AP_Int32 _required_running_checksum;
+    AP_Int8 _gc_mode;
+    AP_Int16 _gc_pause;
+    AP_Int16 _gc_stepmul;
+    AP_Int16 _gc_step_kb;
 
     AP_Enum<ThreadPriority> _thd_priority;
 
+#if AP_SCRIPTING_FAST_LANE_ENABLED
+    AP_Int32 _fast_heap_size;
+    AP_Int32 _fast_vm_exec_count;
+    AP_Enum<ThreadPriority> _fast_thd_priority;
+#endif
+
+    // get the HAL priority for a scripting thread priority
+    static AP_HAL::Scheduler::priority_base hal_priority(ThreadPriority priority);
+
     bool option_is_set(DebugOption option) const {
         return (uint8_t(_debug_options.get()) & uint8_t(option)) != 0;
     }
@@ -209,7 +240,6 @@ private:
     bool _stop; // true if scripts should be stopped
 
     static AP_Scripting *_singleton;
-    int current_env_ref;
 };
 
 namespace AP {
@@ -15,6 +15,11 @@
     #endif
 #endif
 
+// a second thread for fixed rate scripts, with its own heap
+#ifndef AP_SCRIPTING_FAST_LANE_ENABLED
+#define AP_SCRIPTING_FAST_LANE_ENABLED AP_SCRIPTING_ENABLED && (HAL_PROGRAM_SIZE_LIMIT_KB>1024)
+#endif
+
 #ifndef AP_SCRIPTING_SERIALDEVICE_ENABLED
 #define AP_SCRIPTING_SERIALDEVICE_ENABLED AP_SERIALMANAGER_REGISTER_ENABLED && (HAL_PROGRAM_SIZE_LIMIT_KB>1024)
 #endif
@@ -17,6 +17,11 @@
 ---@type integer
 local enum_integer
 
+-- Methods which return a single userdata object also accept an existing object
+-- of that type as an extra last argument. The result is written into it and it
+-- is returned, so scripts running at a high rate need not create new objects,
+-- eg: local vel = Vector3f() ... ahrs:get_velocity_NED(vel)
+
 -- manual bindings
 
 ---@class (exact) uint32_t_ud
@@ -82,6 +87,77 @@ function uint64_t_ud:toint() end
 ---@return uint32_t_ud -- low (value & 0xFFFFFFFF)
 function uint64_t_ud:split() end
 
+-- Fixed size byte buffer for serial and CAN drivers. A buffer is allocated
+-- once and reused, so reading, writing and decoding bytes does not create
+-- strings. Indexes are one based as for strings.
+---@class (exact) ByteBuffer_ud
+local ByteBuffer_ud = {}
+
+-- create an empty buffer
+---@param capacity integer -- maximum number of bytes, 1 to 65535
+---@return ByteBuffer_ud
+function ByteBuffer(capacity) end
+
+-- Number of bytes in the buffer
+---@return integer
+function ByteBuffer_ud:len() end
+
+-- Maximum number of bytes the buffer can hold
+---@return integer
+function ByteBuffer_ud:capacity() end
+
+-- Remove all bytes
+function ByteBuffer_ud:clear() end
+
+-- Get a byte
+---@param index integer -- 1 to len()
+---@return integer
+function ByteBuffer_ud:get(index) end
+
+-- Set a byte
+---@param index integer -- 1 to len()
+---@param value integer -- 0 to 255
+function ByteBuffer_ud:set(index, value) end
+
+-- Find the first occurrence of a byte value
+---@param value integer -- 0 to 255
+---@param start? integer -- index to start searching from, default 1
+---@return integer|nil -- index of the byte, nil if not found
+function ByteBuffer_ud:find(value, start) end
+
+-- Remove bytes from the start of the buffer, moving the rest down
+---@param count integer -- number of bytes to remove
+---@return integer -- remaining length
+function ByteBuffer_ud:consume(count) end
+
+-- Append as much of a string as fits
+---@param data string
+---@return integer -- number of bytes added
+function ByteBuffer_ud:append(data) end
+
+-- Copy bytes into a string
+---@param start? integer -- first index, default 1
+---@param count? integer -- number of bytes, default to the end of the buffer
+---@return string
+function ByteBuffer_ud:tostring(start, count) end
+
+-- Decode values, as string.unpack with a subset of its formats:
+-- < little endian (default), > big endian, b/B int8/uint8, h/H int16/uint16,
+-- i[n]/I[n] signed/unsigned n byte integer (n 1 to 4, default 4), f float,
+-- d double, x skip one byte. Values of I4 above 2^31-1 wrap to negative.
+-- An error is raised if there are not enough bytes.
+---@param format string
+---@param start? integer -- index of the first byte, default 1
+---@return any ... -- decoded values followed by the index after the last byte read
+function ByteBuffer_ud:unpack(format, start) end
+
+-- Encode values on to the end of the buffer, as string.pack with the formats
+-- of unpack. An error is raised if the values do not fit.
+---@param format string
+---@param ... integer|number|uint32_t_ud -- values to encode, type to match format
+---@return integer -- new length
+function ByteBuffer_ud:pack(format, ...) end
+
 -- system time in milliseconds
 ---@return uint32_t_ud -- milliseconds
 function millis() end
@@ -98,6 +174,15 @@ function micros() end
 ---@return number|nil -- command param 4
 function mission_receive() end
 
+-- Fill a table with a snapshot of common vehicle state, reusing the table on each call.
+-- Fields: armed, roll, pitch, yaw (radians), gyro_x, gyro_y, gyro_z (radians/second),
+-- vel_ok, vel_n, vel_e, vel_d (meters/second), loc_ok, lat, lng (degrees*1e7), alt (centimeters AMSL),
+-- gps_status, gps_num_sats, baro_alt (meters), batt_voltage, batt_current, batt_remaining (percent),
+-- rc (table of RC input PWM indexed from channel 1). Fields for libraries not in the firmware are absent.
+---@param state table -- table to fill
+---@return table -- the same table
+function state_snapshot(state) end
+
 -- Print text, if MAVLink is available the value will be sent with debug severity
 -- If no MAVLink the value will be sent over can
 -- equivalent to gcs:send_text(7, text) or periph:can_printf(text)
@@ -475,6 +560,17 @@ function CANFrame_ud:isExtended() end
 ---@return integer
 function CANFrame_ud:id_signed() end
 
+-- Append the data bytes of the frame to a buffer
+---@param buffer ByteBuffer_ud
+---@return boolean -- false if there was not enough space in the buffer
+function CANFrame_ud:copy_data_to(buffer) end
+
+-- Fill the frame data from the start of a buffer, setting dlc to match. Bytes
+-- are not removed from the buffer, consume them once the frame is sent.
+---@param buffer ByteBuffer_ud
+---@return integer -- number of bytes copied
+function CANFrame_ud:copy_data_from(buffer) end
+
 -- desc
 ---@class (exact) motor_factor_table_ud
 local motor_factor_table_ud = {}
@@ -1318,6 +1414,17 @@ function AP_Scripting_SerialAccess_ud:read() end
 ---@return string|nil -- bytes actually read, which may be 0-length, or nil on error
 function AP_Scripting_SerialAccess_ud:readstring(count) end
 
+-- Reads available bytes into the free space at the end of a buffer
+---@param buffer ByteBuffer_ud
+---@return integer|nil -- number of bytes read, or nil on error
+function AP_Scripting_SerialAccess_ud:readbuffer(buffer) end
+
+-- Writes the contents of a buffer. The bytes actually written are removed
+-- from the buffer, so any remaining bytes can be written later.
+---@param buffer ByteBuffer_ud
+---@return integer -- number of bytes written, which may be 0
+function AP_Scripting_SerialAccess_ud:writebuffer(buffer) end
+
 -- Returns number of available bytes to read.
 ---@return uint32_t_ud
 function AP_Scripting_SerialAccess_ud:available() end
@@ -3893,6 +4000,12 @@ function precland:healthy() end
 -- desc
 follow = {}
 
+-- get the latency compensated location and velocity of any vehicle sending GLOBAL_POSITION_INT or FOLLOW_TARGET
+---@param sysid integer
+---@return Location_ud|nil
+---@return Vector3f_ud|nil
+function follow:get_track_location_and_velocity(sysid) end
+
 -- desc
 ---@return number|nil
 function follow:get_target_heading_deg() end
@@ -0,0 +1,30 @@
+-- This script reads the vehicle attitude rates, velocity and position at 50hz
+-- without creating new objects for the garbage collector on each update.
+-- Methods which return a single Vector, Location or other object accept an
+-- existing object of the same type as an extra last argument. The result is
+-- written into that object, which is also returned.
+---@diagnostic disable: redundant-parameter
+
+local gyro = Vector3f()
+local velocity = Vector3f()
+local position = Location()
+
+local count = 0
+
+function update()
+  ahrs:get_gyro(gyro)
+  local have_velocity = ahrs:get_velocity_NED(velocity)
+  local have_position = ahrs:get_location(position)
+
+  count = count + 1
+  if count >= 50 then
+    count = 0
+    if have_velocity and have_position then
+      gcs:send_text(6, string.format("Yaw rate:%.1f Vel N:%.1f E:%.1f D:%.1f Alt:%.1f", math.deg(gyro:z()),
+                    velocity:x(), velocity:y(), velocity:z(), position:alt() * 0.01))
+    end
+  end
+  return update, 20
+end
+
+return update()
@@ -0,0 +1,63 @@
+-- parse a binary sensor stream using a ByteBuffer, without creating strings
+-- frames are: 0xA5 header, uint8 length, payload of little endian int16 distance (cm) and uint16 signal quality, uint8 checksum
+
+---@diagnostic disable: need-check-nil
+
+local baud_rate = 115200
+local HEADER = 0xA5
+local PAYLOAD_LEN = 4
+
+-- find the first scripting serial port instance, SERIALx_PROTOCOL 28
+local port = assert(serial:find_serial(0), "Could not find Scripting Serial Port")
+port:begin(baud_rate)
+port:set_flow_control(0)
+
+-- allocated once, incoming bytes are appended to the end and frames consumed from the start
+local rx = ByteBuffer(256)
+
+local function checksum(len)
+  local sum = 0
+  for i = 1, len do
+    sum = sum + rx:get(i)
+  end
+  return sum & 0xFF
+end
+
+local function parse()
+  while true do
+    -- drop anything before a header
+    local start = rx:find(HEADER)
+    if not start then
+      rx:clear()
+      return
+    end
+    rx:consume(start - 1)
+
+    local frame_len = 2 + PAYLOAD_LEN + 1
+    if rx:len() < frame_len then
+      return
+    end
+
+    local len, distance, quality, pos = rx:unpack("xBhH")
+    if len == PAYLOAD_LEN and rx:get(pos) == checksum(pos - 1) then
+      gcs:send_named_float("DIST", distance * 0.01)
+      gcs:send_named_float("QUAL", quality)
+      rx:consume(frame_len)
+    else
+      -- not a valid frame, look for the next header
+      rx:consume(1)
+    end
+  end
+end
+
+function update()
+  if rx:len() == rx:capacity() then
+    -- no frames found in a full buffer
+    rx:clear()
+  end
+  port:readbuffer(rx)
+  parse()
+  return update, 10
+end
+
+return update()
@@ -0,0 +1,19 @@
+-- This script reads vehicle state at 100hz with a single binding call per update.
+-- The same table is filled on every call, so the loop does not create garbage.
+
+local state = {}
+local count = 0
+
+function update()
+  state_snapshot(state)
+
+  count = count + 1
+  if count >= 100 then
+    count = 0
+    gcs:send_text(6, string.format("Roll:%.1f Pitch:%.1f Sats:%d Batt:%.2fV RC3:%d", math.deg(state.roll),
+                  math.deg(state.pitch), state.gps_num_sats, state.batt_voltage, state.rc[3]))
+  end
+  return update, 10
+end
+
+return update()
@@ -1342,6 +1342,15 @@ void emit_userdata_allocators(void) {
     fprintf(source, "    return (%s *)ud;\n", node->name);
     fprintf(source, "}\n");
 
+    // push the object passed as out_arg to be overwritten, or a new object if out_arg is zero
+    fprintf(source, "%s * push_%s(lua_State *L, int out_arg) {\n", node->name, node->sanatized_name);
+    fprintf(source, "    if (out_arg == 0) {\n");
+    fprintf(source, "        return new_%s(L);\n", node->sanatized_name);
+    fprintf(source, "    }\n");
+    fprintf(source, "    lua_pushvalue(L, out_arg);\n");
+    fprintf(source, "    return (%s *)lua_touserdata(L, -1);\n", node->name);
+    fprintf(source, "}\n");
+
     // New method used externally, includes argcheck, overridden by custom creation function if provided
     if (node->creation == NULL && should_emit_creation(node)) {
       fprintf(source, "\n");
@@ -1428,6 +1437,7 @@ void emit_userdata_declarations(void) {
   while (node) {
     start_dependency(header, node->dependency);
     fprintf(header, "%s * new_%s(lua_State *L);\n", node->name, node->sanatized_name);
+    fprintf(header, "%s * push_%s(lua_State *L, int out_arg);\n", node->name, node->sanatized_name);
     if (node->creation == NULL && should_emit_creation(node)) {
       fprintf(header, "int lua_new_%s(lua_State *L);\n", node->sanatized_name);
     }
@@ -1900,8 +1910,31 @@ void emit_ap_object_fields() {
   }
 }
 
+// returns the userdata type a method creates if it is the only userdata the method returns, or NULL
+// a script may pass an existing object of this type as an extra last argument to be overwritten in place
+const struct type * reusable_output(const struct method *method) {
+  const struct type *output = NULL;
+  int count = 0;
+  if (method->return_type.type == TYPE_USERDATA) {
+    output = &method->return_type;
+    count++;
+  }
+  if (method->flags & (TYPE_FLAGS_NULLABLE | TYPE_FLAGS_REFERENCE)) {
+    const struct argument *arg = method->arguments;
+    while (arg != NULL) {
+      if ((arg->type.flags & (TYPE_FLAGS_NULLABLE | TYPE_FLAGS_REFERENCE)) && (arg->type.type == TYPE_USERDATA)) {
+        output = &arg->type;
+        count++;
+      }
+      arg = arg->next;
+    }
+  }
+  return (count == 1) ? output : NULL;
+}
+
 // emit references functions for a call, return the number of arduments added
-int emit_references(const struct argument *arg, const char * tab) {
+// if reuse is set userdata is written to the object passed in out_arg rather than a new one
+int emit_references(const struct argument *arg, const char * tab, int reuse) {
   int arg_index = NULLABLE_ARG_COUNT_BASE + 2;
   int return_count = 0;
   // count arguments to return so we know if we need to check the stack
@@ -1940,7 +1973,7 @@ int emit_references(const struct argument *arg, const char * tab) {
           fprintf(source, "%slua_pushstring(L, data_%d);\n", tab, arg_index);
           break;
         case TYPE_USERDATA:
-          fprintf(source, "%s*new_%s(L) = data_%d;\n", tab, arg->type.data.ud.sanatized_name, arg_index);
+          fprintf(source, "%s*%s_%s(L%s) = data_%d;\n", tab, reuse ? "push" : "new", arg->type.data.ud.sanatized_name, reuse ? ", out_arg" : "", arg_index);
           break;
         case TYPE_NONE:
           error(ERROR_INTERNAL, "Attempted to emit a nullable or reference argument of type none");
@@ -1988,7 +2021,16 @@ void emit_userdata_method(const struct userdata *data, const struct method *meth
     }
     arg = arg->next;
   }
-  fprintf(source, "    binding_argcheck(L, %d);\n", arg_count);
+  const struct type *out_type = reusable_output(method);
+  if (out_type != NULL) {
+    // scripts may pass an object to be overwritten rather than creating a new one on each call
+    fprintf(source, "    const int out_arg = binding_argcheck_out(L, %d);\n", arg_count);
+    fprintf(source, "    if (out_arg != 0) {\n");
+    fprintf(source, "        check_%s(L, out_arg);\n", out_type->data.ud.sanatized_name);
+    fprintf(source, "    }\n");
+  } else {
+    fprintf(source, "    binding_argcheck(L, %d);\n", arg_count);
+  }
 
   switch (data->ud_type) {
     case UD_USERDATA:
@@ -2178,7 +2220,7 @@ void emit_userdata_method(const struct userdata *data, const struct method *meth
   if (method->flags & TYPE_FLAGS_REFERENCE) {
     arg = method->arguments;
     // number of arguments to return
-    return_count += emit_references(arg,"    ");
+    return_count += emit_references(arg,"    ", out_type != NULL);
   }
 
   switch (method->return_type.type) {
@@ -2187,7 +2229,7 @@ void emit_userdata_method(const struct userdata *data, const struct method *meth
         fprintf(source, "    if (data) {\n");
         // we need to emit out nullable arguments, iterate the args again, creating and copying objects, while keeping a new count
         arg = method->arguments;
-        return_count = emit_references(arg,"        ");
+        return_count = emit_references(arg,"        ", out_type != NULL);
         fprintf(source, "        return %d;\n", return_count);
         fprintf(source, "    }\n");
         fprintf(source, "    return 0;\n");
@@ -2213,7 +2255,11 @@ void emit_userdata_method(const struct userdata *data, const struct method *meth
       fprintf(source, "    lua_pushstring(L, data);\n");
       break;
     case TYPE_USERDATA:
-      fprintf(source, "    *new_%s(L) = data;\n", method->return_type.data.ud.sanatized_name);
+      if (out_type != NULL) {
+        fprintf(source, "    *push_%s(L, out_arg) = data;\n", method->return_type.data.ud.sanatized_name);
+      } else {
+        fprintf(source, "    *new_%s(L) = data;\n", method->return_type.data.ud.sanatized_name);
+      }
       break;
     case TYPE_AP_OBJECT:
       fprintf(source, "    if (data == NULL) {\n");
@@ -2680,6 +2726,17 @@ void emit_argcheck_helper(void) {
   fprintf(source, "    return 0;\n");
   fprintf(source, "}\n\n");
 
+  // allows one extra argument, an object for the result to be written to
+  // returns its index, or zero if it was not passed
+  fprintf(source, "int binding_argcheck_out(lua_State *L, int expected_arg_count) {\n");
+  fprintf(source, "    const int args = lua_gettop(L);\n");
+  fprintf(source, "    if (args == expected_arg_count + 1) {\n");
+  fprintf(source, "        return args;\n");
+  fprintf(source, "    }\n");
+  fprintf(source, "    binding_argcheck(L, expected_arg_count);\n");
+  fprintf(source, "    return 0;\n");
+  fprintf(source, "}\n\n");
+
   fprintf(source, "int field_argerror(lua_State *L) {\n");
   fprintf(source, "    return binding_argcheck(L, -1); // force too many args error\n");
   fprintf(source, "}\n\n");
@@ -3252,6 +3309,7 @@ int main(int argc, char **argv) {
   fprintf(header, "void load_generated_bindings(lua_State *L);\n");
   fprintf(header, "void load_generated_sandbox(lua_State *L);\n");
   fprintf(header, "int binding_argcheck(lua_State *L, int expected_arg_count);\n");
+  fprintf(header, "int binding_argcheck_out(lua_State *L, int expected_arg_count);\n");
   fprintf(header, "int field_argerror(lua_State *L);\n");
   fprintf(header, "bool userdata_zero_arg_check(lua_State *L);\n");
   fprintf(header, "lua_Integer get_integer(lua_State *L, int arg_num, lua_Integer min_val, lua_Integer max_val);\n");
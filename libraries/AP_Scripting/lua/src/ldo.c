@@ -777,9 +777,9 @@ static void f_parser (lua_State *L, void *ud) {
   struct SParser *p = cast(struct SParser *, ud);
   int c = zgetc(p->z);  /* read first character */
 #if LUA_SUPPORT_LOAD_BINARY
-  // support loading pre-compiled luac
+  // support loading pre-compiled luac, only when asked for explicitly
   if (c == LUA_SIGNATURE[0]) {
-    checkmode(L, p->mode, "binary");
+    checkmode(L, p->mode ? p->mode : "t", "binary");
     cl = luaU_undump(L, p->z, p->name);
   }
   else
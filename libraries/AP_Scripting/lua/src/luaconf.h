@@ -12,10 +12,12 @@
 #include <stddef.h>
 
 /*
-  don't support binary load() by default
+  support loading precompiled scripts. Binary chunks are only accepted
+  when the load mode explicitly includes 'b', which only the script
+  loader does, so scripts can never load() bytecode themselves
  */
 #ifndef LUA_SUPPORT_LOAD_BINARY
-#define LUA_SUPPORT_LOAD_BINARY 0
+#define LUA_SUPPORT_LOAD_BINARY 1
 #endif
 #include <AP_Scripting/lua_common_defs.h>
 
@@ -11,10 +11,15 @@
 #include <AP_Logger/AP_Logger.h>
 #include <AP_Filesystem/AP_Filesystem.h>
 #include <AP_GPS/AP_GPS.h>
+#include <AP_AHRS/AP_AHRS.h>
+#include <AP_Baro/AP_Baro.h>
+#include <AP_BattMonitor/AP_BattMonitor.h>
+#include <RC_Channel/RC_Channel.h>
 
 #include "lua_bindings.h"
 
 #include "lua_boxed_numerics.h"
+#include "lua_byte_buffer.h"
 #include <AP_Scripting/lua_generated_bindings.h>
 
 #include <AP_Scheduler/AP_Scheduler.h>
@@ -360,11 +365,12 @@ int AP_Logger_Write(lua_State *L) {
         return luaL_argerror(L, args, "could not map message type");
     }
 
-    // work out how long the block will be
-    int16_t msg_len = AP_logger->Write_calc_msg_len(fmt_cat);
-    if (msg_len == -1) {
-        return luaL_argerror(L, args, "unknown format");
+    // the length of the block was worked out when the message type
+    // was allocated, which is only valid for the same format
+    if (strncmp(f->fmt, fmt_cat, LS_FORMAT_SIZE) != 0) {
+        return luaL_argerror(L, args, "format does not match previous use of name");
     }
+    const uint8_t msg_len = f->msg_len;
 
     // note that luaM_malloc will never return null, it will fault instead
     char *buffer = (char*)luaM_malloc(L, msg_len);
@@ -742,6 +748,54 @@ int lua_get_CAN_device2(lua_State *L) {
 
     return 1;
 }
+
+/*
+  append the data bytes of a frame to a ByteBuffer, returns false if there is not enough space
+ */
+int AP_HAL__CANFrame_copy_data_to(lua_State *L)
+{
+    binding_argcheck(L, 2);
+
+    AP_HAL::CANFrame *frame = check_AP_HAL__CANFrame(L, 1);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 2);
+
+    const uint8_t len = MIN(AP_HAL::CANFrame::dlcToDataLength(frame->dlc), ARRAY_SIZE(frame->data));
+    if (len > buf->space()) {
+        lua_pushboolean(L, false);
+        return 1;
+    }
+    memcpy(buf->bytes() + buf->length, frame->data, len);
+    buf->length += len;
+
+    lua_pushboolean(L, true);
+    return 1;
+}
+
+/*
+  fill the frame data from the start of a ByteBuffer, up to the frame
+  size, and set the dlc to match. Returns the number of bytes copied,
+  the caller can consume them from the buffer once the frame is sent
+ */
+int AP_HAL__CANFrame_copy_data_from(lua_State *L)
+{
+    binding_argcheck(L, 2);
+
+    AP_HAL::CANFrame *frame = check_AP_HAL__CANFrame(L, 1);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 2);
+
+    // round down to a length that a dlc can represent, only CAN FD frames have gaps
+    const uint8_t max_len = MIN(buf->length, ARRAY_SIZE(frame->data));
+    uint8_t dlc = AP_HAL::CANFrame::dataLengthToDlc(max_len);
+    if (AP_HAL::CANFrame::dlcToDataLength(dlc) > max_len) {
+        dlc--;
+    }
+    const uint8_t len = AP_HAL::CANFrame::dlcToDataLength(dlc);
+    memcpy(frame->data, buf->bytes(), len);
+    frame->dlc = dlc;
+
+    lua_pushinteger(L, len);
+    return 1;
+}
 #endif // AP_SCRIPTING_CAN_SENSOR_ENABLED
 
 #if AP_SERIALMANAGER_ENABLED
@@ -847,6 +901,43 @@ int lua_serial_readstring(lua_State *L) {
     return 1;
 }
 
+/*
+  read available bytes into the free space of a ByteBuffer, returns
+  the number of bytes read or nil on error
+ */
+int lua_serial_readbuffer(lua_State *L) {
+    binding_argcheck(L, 2);
+
+    AP_Scripting_SerialAccess * port = check_AP_Scripting_SerialAccess(L, 1);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 2);
+
+    const ssize_t read_bytes = port->read(buf->bytes() + buf->length, buf->space());
+    if (read_bytes < 0) {
+        return 0; // error, return nil
+    }
+    buf->length += read_bytes;
+
+    lua_pushinteger(L, read_bytes);
+    return 1;
+}
+
+/*
+  write the contents of a ByteBuffer, the bytes written are removed
+  from the buffer so a partial write can be retried with the same buffer
+ */
+int lua_serial_writebuffer(lua_State *L) {
+    binding_argcheck(L, 2);
+
+    AP_Scripting_SerialAccess * port = check_AP_Scripting_SerialAccess(L, 1);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 2);
+
+    const uint32_t written_bytes = port->write(buf->bytes(), buf->length);
+    buf->consume(written_bytes);
+
+    lua_pushinteger(L, written_bytes);
+    return 1;
+}
+
 /*
   directory listing, return table of files in a directory
  */
@@ -1081,12 +1172,6 @@ int SocketAPM_string_to_ipv4_addr(lua_State *L) {
 #endif // AP_NETWORKING_ENABLED
 
 
-int lua_get_current_env_ref()
-{
-    auto *scripting = AP::scripting();
-    return scripting->get_current_env_ref();
-}
-
 // This is used when loading modules with require, lua must only look in enabled directory's
 const char* lua_get_modules_path()
 {
@@ -1290,4 +1375,131 @@ int lua_gps_inject_data(lua_State *L)
 
 #endif  // AP_GPS_ENABLED
 
+// set a number field of the table at the top of the stack
+static void snapshot_set_number(lua_State *L, const char *name, lua_Number value)
+{
+    lua_pushnumber(L, value);
+    lua_setfield(L, -2, name);
+}
+
+static void snapshot_set_integer(lua_State *L, const char *name, lua_Integer value)
+{
+    lua_pushinteger(L, value);
+    lua_setfield(L, -2, name);
+}
+
+static void snapshot_set_boolean(lua_State *L, const char *name, bool value)
+{
+    lua_pushboolean(L, value);
+    lua_setfield(L, -2, name);
+}
+
+/*
+  fill a table with a snapshot of commonly used vehicle state, so a
+  script can read it with one call and one lock of each library
+  rather than one binding call per value. The table passed in is
+  reused, once its fields exist filling it again does not allocate.
+  Fields which are not available are set to zero with a matching _ok
+  flag of false, so the table keeps the same shape between calls
+ */
+int lua_state_snapshot(lua_State *L)
+{
+    binding_argcheck(L, 1);
+    luaL_checktype(L, 1, LUA_TTABLE);
+    lua_settop(L, 1);
+
+    snapshot_set_boolean(L, "armed", hal.util->get_soft_armed());
+
+#if AP_AHRS_ENABLED
+    {
+        AP_AHRS &ahrs = AP::ahrs();
+        WITH_SEMAPHORE(ahrs.get_semaphore());
+
+        // attitude in radians and body rates in radians/second
+        snapshot_set_number(L, "roll", ahrs.get_roll_rad());
+        snapshot_set_number(L, "pitch", ahrs.get_pitch_rad());
+        snapshot_set_number(L, "yaw", ahrs.get_yaw_rad());
+        const Vector3f &gyro = ahrs.get_gyro();
+        snapshot_set_number(L, "gyro_x", gyro.x);
+        snapshot_set_number(L, "gyro_y", gyro.y);
+        snapshot_set_number(L, "gyro_z", gyro.z);
+
+        // NED velocity in meters/second
+        Vector3f vel;
+        const bool vel_ok = ahrs.get_velocity_NED(vel);
+        if (!vel_ok) {
+            vel.zero();
+        }
+        snapshot_set_boolean(L, "vel_ok", vel_ok);
+        snapshot_set_number(L, "vel_n", vel.x);
+        snapshot_set_number(L, "vel_e", vel.y);
+        snapshot_set_number(L, "vel_d", vel.z);
+
+        // position as latitude and longitude in degrees*1e7 and altitude in centimeters above sea level
+        Location loc;
+        const bool loc_ok = ahrs.get_location(loc);
+        snapshot_set_boolean(L, "loc_ok", loc_ok);
+        snapshot_set_integer(L, "lat", loc_ok ? loc.lat : 0);
+        snapshot_set_integer(L, "lng", loc_ok ? loc.lng : 0);
+        snapshot_set_integer(L, "alt", loc_ok ? loc.alt : 0);
+    }
+#endif  // AP_AHRS_ENABLED
+
+#if AP_GPS_ENABLED
+    {
+        const AP_GPS &gps = AP::gps();
+        snapshot_set_integer(L, "gps_status", gps.status());
+        snapshot_set_integer(L, "gps_num_sats", gps.num_sats());
+    }
+#endif  // AP_GPS_ENABLED
+
+#if AP_BARO_ENABLED
+    // altitude above the calibration point in meters
+    snapshot_set_number(L, "baro_alt", AP::baro().get_altitude());
+#endif  // AP_BARO_ENABLED
+
+#if AP_BATTERY_ENABLED
+    {
+        const AP_BattMonitor &battery = AP::battery();
+        snapshot_set_number(L, "batt_voltage", battery.voltage());
+        float current;
+        if (!battery.current_amps(current)) {
+            current = 0;
+        }
+        snapshot_set_number(L, "batt_current", current);
+        uint8_t remaining;
+        if (!battery.capacity_remaining_pct(remaining)) {
+            remaining = 0;
+        }
+        snapshot_set_integer(L, "batt_remaining", remaining);
+    }
+#endif  // AP_BATTERY_ENABLED
+
+#if AP_RC_CHANNEL_ENABLED
+    {
+        // RC input pulse widths in microseconds, as an array indexed from channel 1
+        uint16_t pwm[NUM_RC_CHANNELS] {};
+        {
+#if AP_SCHEDULER_ENABLED
+            WITH_SEMAPHORE(AP::scheduler().get_semaphore());
+#endif
+            rc().get_radio_in(pwm, ARRAY_SIZE(pwm));
+        }
+        if (lua_getfield(L, 1, "rc") != LUA_TTABLE) {
+            lua_pop(L, 1);
+            lua_createtable(L, ARRAY_SIZE(pwm), 0);
+            lua_pushvalue(L, -1);
+            lua_setfield(L, 1, "rc");
+        }
+        for (uint8_t i = 0; i < ARRAY_SIZE(pwm); i++) {
+            lua_pushinteger(L, pwm[i]);
+            lua_rawseti(L, -2, i+1);
+        }
+        lua_pop(L, 1);
+    }
+#endif  // AP_RC_CHANNEL_ENABLED
+
+    return 1;
+}
+
 #endif  // AP_SCRIPTING_ENABLED
@@ -0,0 +1,368 @@
+#include "AP_Scripting_config.h"
+
+#if AP_SCRIPTING_ENABLED
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
+#include "lua_byte_buffer.h"
+#include "lua_boxed_numerics.h"
+#include <AP_Scripting/lua_generated_bindings.h>
+
+void ScriptingByteBuffer::consume(uint16_t count)
+{
+    count = MIN(count, length);
+    length -= count;
+    memmove(bytes(), bytes() + count, length);
+}
+
+// the exposed constructor to lua calls to create a ByteBuffer of a given capacity
+int lua_new_ScriptingByteBuffer(lua_State *L)
+{
+    binding_argcheck(L, 1);
+
+    const uint16_t capacity = get_integer(L, 1, 1, UINT16_MAX);
+
+    // the data is allocated in the same userdata, directly after the header
+    ScriptingByteBuffer *buf = static_cast<ScriptingByteBuffer *>(lua_newuserdata(L, sizeof(ScriptingByteBuffer) + capacity));
+    buf->capacity = capacity;
+    buf->length = 0;
+    luaL_getmetatable(L, "ByteBuffer");
+    lua_setmetatable(L, -2);
+
+    return 1;
+}
+
+int ScriptingByteBuffer_len(lua_State *L)
+{
+    binding_argcheck(L, 1);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    lua_pushinteger(L, buf->length);
+    return 1;
+}
+
+int ScriptingByteBuffer_capacity(lua_State *L)
+{
+    binding_argcheck(L, 1);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    lua_pushinteger(L, buf->capacity);
+    return 1;
+}
+
+int ScriptingByteBuffer_clear(lua_State *L)
+{
+    binding_argcheck(L, 1);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    buf->length = 0;
+    return 0;
+}
+
+// indexes are one based, as for Lua strings and tables
+int ScriptingByteBuffer_get(lua_State *L)
+{
+    binding_argcheck(L, 2);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    const lua_Integer index = get_integer(L, 2, 1, buf->length);
+    lua_pushinteger(L, buf->bytes()[index - 1]);
+    return 1;
+}
+
+int ScriptingByteBuffer_set(lua_State *L)
+{
+    binding_argcheck(L, 3);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    const lua_Integer index = get_integer(L, 2, 1, buf->length);
+    buf->bytes()[index - 1] = get_uint8_t(L, 3);
+    return 0;
+}
+
+// find the first index of a byte value at or after an optional start index, nil if not found
+int ScriptingByteBuffer_find(lua_State *L)
+{
+    const int args = lua_gettop(L);
+    if (args > 3) {
+        return luaL_argerror(L, args, "too many arguments");
+    }
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    const uint8_t value = get_uint8_t(L, 2);
+    const lua_Integer start = (args == 3) ? get_integer(L, 3, 1, UINT16_MAX) : 1;
+    if (start > buf->length) {
+        return 0;
+    }
+
+    const uint8_t *data = buf->bytes();
+    const uint8_t *found = (const uint8_t *)memchr(&data[start - 1], value, buf->length - (start - 1));
+    if (found == nullptr) {
+        return 0;
+    }
+    lua_pushinteger(L, (found - data) + 1);
+    return 1;
+}
+
+// remove bytes from the start of the buffer, moving the rest down
+int ScriptingByteBuffer_consume(lua_State *L)
+{
+    binding_argcheck(L, 2);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    buf->consume(get_uint16_t(L, 2));
+    lua_pushinteger(L, buf->length);
+    return 1;
+}
+
+// append as much of a string as fits, returns the number of bytes added
+int ScriptingByteBuffer_append(lua_State *L)
+{
+    binding_argcheck(L, 2);
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    size_t len;
+    const char *str = luaL_checklstring(L, 2, &len);
+
+    const uint16_t count = MIN(len, size_t(buf->space()));
+    memcpy(buf->bytes() + buf->length, str, count);
+    buf->length += count;
+
+    lua_pushinteger(L, count);
+    return 1;
+}
+
+// return bytes as a string, all of them or count bytes from an optional start index
+int ScriptingByteBuffer_tostring(lua_State *L)
+{
+    const int args = lua_gettop(L);
+    if (args > 3) {
+        return luaL_argerror(L, args, "too many arguments");
+    }
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    const lua_Integer start = (args >= 2) ? get_integer(L, 2, 1, UINT16_MAX) : 1;
+    lua_Integer count = (args == 3) ? get_integer(L, 3, 0, UINT16_MAX) : buf->length;
+    if (start > buf->length) {
+        count = 0;
+    } else {
+        count = MIN(count, buf->length - (start - 1));
+    }
+
+    lua_pushlstring(L, (const char *)&buf->bytes()[start - 1], count);
+    return 1;
+}
+
+/*
+  pack and unpack support a subset of the string.pack formats that
+  covers sensor protocols:
+    < little endian (default), > big endian, = native endian
+    b/B signed/unsigned byte, h/H signed/unsigned 16 bit
+    i[n]/I[n] signed/unsigned integer of n bytes, 1 to 4, default 4
+    f float, d double, x one byte of padding
+  Integers are held in 32 bits, so I4 values above INT32_MAX wrap
+  as they do for string.unpack
+ */
+namespace {
+struct PackFormat {
+    const char *fmt;
+    bool little = true;
+};
+
+enum class PackType {
+    END,
+    INT,
+    UINT,
+    FLOAT,
+    DOUBLE,
+    PADDING,
+};
+
+// get the next item in a format string along with its size
+PackType next_item(lua_State *L, PackFormat &f, uint8_t &size)
+{
+    while (true) {
+        const char c = *f.fmt++;
+        switch (c) {
+        case '\0':
+            f.fmt--;
+            return PackType::END;
+        case ' ':
+            break;
+        case '<':
+        case '=':
+            // all supported boards are little endian
+            f.little = true;
+            break;
+        case '>':
+            f.little = false;
+            break;
+        case 'b':
+            size = 1;
+            return PackType::INT;
+        case 'B':
+            size = 1;
+            return PackType::UINT;
+        case 'h':
+            size = 2;
+            return PackType::INT;
+        case 'H':
+            size = 2;
+            return PackType::UINT;
+        case 'i':
+        case 'I':
+            size = 4;
+            if (*f.fmt >= '1' && *f.fmt <= '4') {
+                size = *f.fmt++ - '0';
+            }
+            return c == 'i' ? PackType::INT : PackType::UINT;
+        case 'f':
+            size = sizeof(float);
+            return PackType::FLOAT;
+        case 'd':
+            size = sizeof(double);
+            return PackType::DOUBLE;
+        case 'x':
+            size = 1;
+            return PackType::PADDING;
+        default:
+            luaL_error(L, "invalid format option '%c'", c);
+            return PackType::END;
+        }
+    }
+}
+
+uint32_t read_uint(const uint8_t *p, uint8_t size, bool little)
+{
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < size; i++) {
+        v |= uint32_t(p[little ? i : size - 1 - i]) << (8 * i);
+    }
+    return v;
+}
+
+void write_uint(uint8_t *p, uint32_t v, uint8_t size, bool little)
+{
+    for (uint8_t i = 0; i < size; i++) {
+        p[little ? i : size - 1 - i] = v >> (8 * i);
+    }
+}
+
+// copy a float or double, reversing the bytes if the endianness differs from the board's
+void copy_ordered(uint8_t *dest, const uint8_t *src, uint8_t size, bool little)
+{
+    for (uint8_t i = 0; i < size; i++) {
+        dest[i] = src[little ? i : size - 1 - i];
+    }
+}
+}
+
+// unpack values from an optional start index, returns the values followed by the index after them
+int ScriptingByteBuffer_unpack(lua_State *L)
+{
+    const int args = lua_gettop(L);
+    if (args > 3) {
+        return luaL_argerror(L, args, "too many arguments");
+    } else if (args < 2) {
+        return luaL_argerror(L, args, "too few arguments");
+    }
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    PackFormat f { luaL_checkstring(L, 2) };
+    uint32_t pos = (args == 3) ? get_integer(L, 3, 1, UINT16_MAX) - 1 : 0;
+
+    const uint8_t *data = buf->bytes();
+    int n = 0;
+    uint8_t size;
+    PackType type;
+    while ((type = next_item(L, f, size)) != PackType::END) {
+        if (pos + size > buf->length) {
+            return luaL_error(L, "data too short");
+        }
+        luaL_checkstack(L, 2, "too many results");
+        switch (type) {
+        case PackType::INT: {
+            uint32_t v = read_uint(&data[pos], size, f.little);
+            if (size < 4) {
+                // sign extend
+                const uint32_t sign = 1U << (size * 8 - 1);
+                v = (v ^ sign) - sign;
+            }
+            lua_pushinteger(L, int32_t(v));
+            n++;
+            break;
+        }
+        case PackType::UINT:
+            lua_pushinteger(L, lua_Integer(read_uint(&data[pos], size, f.little)));
+            n++;
+            break;
+        case PackType::FLOAT: {
+            float v;
+            copy_ordered((uint8_t *)&v, &data[pos], size, f.little);
+            lua_pushnumber(L, v);
+            n++;
+            break;
+        }
+        case PackType::DOUBLE: {
+            double v;
+            copy_ordered((uint8_t *)&v, &data[pos], size, f.little);
+            lua_pushnumber(L, v);
+            n++;
+            break;
+        }
+        case PackType::PADDING:
+        case PackType::END:
+            break;
+        }
+        pos += size;
+    }
+
+    lua_pushinteger(L, pos + 1);
+    return n + 1;
+}
+
+// append values to the buffer, returns the new length
+int ScriptingByteBuffer_pack(lua_State *L)
+{
+    ScriptingByteBuffer *buf = check_ScriptingByteBuffer(L, 1);
+    PackFormat f { luaL_checkstring(L, 2) };
+    const int args = lua_gettop(L);
+
+    // values are only committed once all of them fit
+    uint8_t *data = buf->bytes();
+    uint32_t pos = buf->length;
+    int arg = 3;
+    uint8_t size;
+    PackType type;
+    while ((type = next_item(L, f, size)) != PackType::END) {
+        if (pos + size > buf->capacity) {
+            return luaL_error(L, "buffer full");
+        }
+        if (type != PackType::PADDING && arg > args) {
+            return luaL_argerror(L, arg, "too few arguments");
+        }
+        switch (type) {
+        case PackType::INT:
+            write_uint(&data[pos], uint32_t(luaL_checkinteger(L, arg++)), size, f.little);
+            break;
+        case PackType::UINT:
+            write_uint(&data[pos], coerce_to_uint32_t(L, arg++), size, f.little);
+            break;
+        case PackType::FLOAT: {
+            const float v = luaL_checknumber(L, arg++);
+            copy_ordered(&data[pos], (const uint8_t *)&v, size, f.little);
+            break;
+        }
+        case PackType::DOUBLE: {
+            const double v = luaL_checknumber(L, arg++);
+            copy_ordered(&data[pos], (const uint8_t *)&v, size, f.little);
+            break;
+        }
+        case PackType::PADDING:
+            data[pos] = 0;
+            break;
+        case PackType::END:
+            break;
+        }
+        pos += size;
+    }
+    if (arg <= args) {
+        return luaL_argerror(L, arg, "too many arguments");
+    }
+
+    buf->length = pos;
+    lua_pushinteger(L, buf->length);
+    return 1;
+}
+
+#endif // AP_SCRIPTING_ENABLED
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "lua/src/lua.hpp"
+#include <stdint.h>
+
+/*
+  a fixed capacity byte array for Lua drivers. The bytes follow the
+  header in the same userdata, so a buffer is allocated once and then
+  reused for every read, write and unpack without creating Lua strings
+ */
+struct ScriptingByteBuffer {
+    uint16_t capacity;  // number of bytes allocated after the header
+    uint16_t length;    // number of bytes in use, from the start of the buffer
+
+    uint8_t *bytes() { return reinterpret_cast<uint8_t *>(this + 1); }
+    uint16_t space() const { return capacity - length; }
+
+    // remove count bytes from the start of the buffer
+    void consume(uint16_t count);
+};
+
+int lua_new_ScriptingByteBuffer(lua_State *L);
+int ScriptingByteBuffer_len(lua_State *L);
+int ScriptingByteBuffer_capacity(lua_State *L);
+int ScriptingByteBuffer_clear(lua_State *L);
+int ScriptingByteBuffer_get(lua_State *L);
+int ScriptingByteBuffer_set(lua_State *L);
+int ScriptingByteBuffer_find(lua_State *L);
+int ScriptingByteBuffer_consume(lua_State *L);
+int ScriptingByteBuffer_append(lua_State *L);
+int ScriptingByteBuffer_tostring(lua_State *L);
+int ScriptingByteBuffer_unpack(lua_State *L);
+int ScriptingByteBuffer_pack(lua_State *L);
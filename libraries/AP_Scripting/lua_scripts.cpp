@@ -24,13 +24,13 @@
 
 #include <AP_Scripting/lua_generated_bindings.h>
 
+#include "lua/src/lstate.h"
+
 #define DISABLE_INTERRUPTS_FOR_SCRIPT_RUN 0
 
 extern const AP_HAL::HAL& hal;
 #define ENABLE_DEBUG_MODULE 0
 
-bool lua_scripts::overtime;
-jmp_buf lua_scripts::panic_jmp;
 char *lua_scripts::error_msg_buf;
 HAL_Semaphore lua_scripts::error_msg_buf_sem;
 uint8_t lua_scripts::print_error_count;
@@ -40,6 +40,9 @@ uint32_t lua_scripts::loaded_checksum;
 uint32_t lua_scripts::running_checksum;
 HAL_Semaphore lua_scripts::crc_sem;
 
+lua_scripts *lua_scripts::instances[lua_scripts::num_lanes];
+HAL_Semaphore lua_scripts::instances_sem;
+
 // return string error message for error object at top of stack
 static const char *get_error_object_message(lua_State *L) {
     const char *m = lua_tostring(L, -1);
@@ -49,20 +52,31 @@ static const char *get_error_object_message(lua_State *L) {
     return m;
 }
 
-lua_scripts::lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size, AP_Int8 &debug_options)
-    : _vm_steps(vm_steps),
+lua_scripts::lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size, AP_Int8 &debug_options, Lane lane)
+    : _lane(lane),
+      _vm_steps(vm_steps),
       _debug_options(debug_options)
 {
     const bool allow_heap_expansion = !option_is_set(AP_Scripting::DebugOption::DISABLE_HEAP_EXPANSION);
     _heap.create(heap_size, 10, allow_heap_expansion, 20*1024);
+
+    WITH_SEMAPHORE(instances_sem);
+    instances[uint8_t(_lane)] = this;
 }
 
 lua_scripts::~lua_scripts() {
+    {
+        WITH_SEMAPHORE(instances_sem);
+        instances[uint8_t(_lane)] = nullptr;
+    }
+
+    // the queue lives on the scripting heap
+    _heap.change_size(queue, queue_size * sizeof(script_info *), 0);
     _heap.destroy();
 }
 
 void lua_scripts::hook(lua_State *L, lua_Debug *ar) {
-    lua_scripts::overtime = true;
+    get_instance(L)->overtime = true;
 
     // we need to aggressively bail out as we are over time
     // so we will aggressively trap errors until we clear out
@@ -87,10 +101,8 @@ void lua_scripts::set_and_print_new_error_message(MAV_SEVERITY severity, const c
 
     // reset buffer and print count
     print_error_count = 0;
-    if (error_msg_buf) {
-        _heap.deallocate(error_msg_buf);
-        error_msg_buf = nullptr;
-    }
+    delete[] error_msg_buf;
+    error_msg_buf = nullptr;
 
     // generate va_list and create a copy
     va_list arg_list, arg_list_copy;
@@ -110,8 +122,8 @@ void lua_scripts::set_and_print_new_error_message(MAV_SEVERITY severity, const c
         return;
     }
 
-    // allocate buffer on scripting heap
-    error_msg_buf = (char *)_heap.allocate(len+1);
+    // allocate buffer on the system heap, as any lane may replace it
+    error_msg_buf = NEW_NOTHROW char[len+1];
     if (!error_msg_buf) {
         // allocation failed
         va_end(arg_list);
@@ -132,18 +144,22 @@ void lua_scripts::set_and_print_new_error_message(MAV_SEVERITY severity, const c
 
 int lua_scripts::atpanic(lua_State *L) {
     set_and_print_new_error_message(MAV_SEVERITY_CRITICAL, "Panic: %s", get_error_object_message(L));
-    longjmp(panic_jmp, 1);
+    longjmp(get_instance(L)->panic_jmp, 1);
     return 0;
 }
 
 // helper for print and log of runtime stats
-void lua_scripts::update_stats(const char *name, uint32_t run_time, int total_mem, int run_mem)
+void lua_scripts::update_stats(const char *name, uint32_t run_time, int total_mem, int run_mem, uint32_t vm_steps, uint32_t gc_time, int gc_freed, uint32_t jitter)
 {
     if (option_is_set(AP_Scripting::DebugOption::RUNTIME_MSG)) {
-        GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "Lua: Time: %u Mem: %d + %d",
+        GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "Lua: Time: %u Mem: %d + %d Steps: %u GC: %u -%d Jitter: %u",
                                             (unsigned int)run_time,
                                             (int)total_mem,
-                                            (int)run_mem);
+                                            (int)run_mem,
+                                            (unsigned int)vm_steps,
+                                            (unsigned int)gc_time,
+                                            (int)gc_freed,
+                                            (unsigned int)jitter);
     }
 #if HAL_LOGGING_ENABLED
     if (option_is_set(AP_Scripting::DebugOption::LOG_RUNTIME)) {
@@ -153,7 +169,12 @@ void lua_scripts::update_stats(const char *name, uint32_t run_time, int total_me
             name         : {},
             run_time     : run_time,
             total_mem    : total_mem,
-            run_mem      : run_mem
+            run_mem      : run_mem,
+            vm_steps     : vm_steps,
+            gc_time      : gc_time,
+            gc_freed     : gc_freed,
+            jitter       : jitter,
+            lane         : uint8_t(_lane)
         };
         const char * name_short = strrchr(name, '/');
         if ((strlen(name) > sizeof(pkt.name)) && (name_short != nullptr)) {
@@ -166,8 +187,13 @@ void lua_scripts::update_stats(const char *name, uint32_t run_time, int total_me
 #endif // HAL_LOGGING_ENABLED
 }
 
-lua_scripts::script_info *lua_scripts::load_script(lua_State *L, char *filename) {
-    if (int error = luaL_loadfile(L, filename)) {
+/*
+  load a script from source, or from precompiled bytecode. The Lua
+  version, number formats and type sizes in the bytecode header must
+  match this build
+ */
+lua_scripts::script_info *lua_scripts::load_script(lua_State *L, char *filename, bool bytecode) {
+    if (int error = luaL_loadfilex(L, filename, bytecode ? "b" : "t")) {
         switch (error) {
             case LUA_ERRSYNTAX:
                 set_and_print_new_error_message(MAV_SEVERITY_CRITICAL, "Error: %s", get_error_object_message(L));
@@ -207,8 +233,9 @@ lua_scripts::script_info *lua_scripts::load_script(lua_State *L, char *filename)
     const uint32_t loadEnd = AP_HAL::micros();
     const int endMem = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
 
-    update_stats(filename, loadEnd-loadStart, endMem, loadMem);
+    update_stats(filename, loadEnd-loadStart, endMem, loadMem, 0, 0, 0, 0);
 
+    memset(new_script, 0, sizeof(*new_script));
     new_script->name = filename;
     new_script->env_ref = luaL_ref(L, LUA_REGISTRYINDEX); // store reference to script's environment
     new_script->run_ref = luaL_ref(L, LUA_REGISTRYINDEX); // store reference to function to run
@@ -258,7 +285,7 @@ void lua_scripts::create_sandbox(lua_State *L) {
     load_generated_sandbox(L);
 }
 
-void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname) {
+void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname, bool allow_bytecode) {
     if (dirname == nullptr) {
         return;
     }
@@ -272,7 +299,7 @@ void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname) {
         return;
     }
 
-    // load anything that ends in .lua
+    // load anything that ends in .lua, or .luac for precompiled bytecode
     for (struct dirent *de=AP::FS().readdir(d); de; de=AP::FS().readdir(d)) {
         uint8_t length = strlen(de->d_name);
         if (length < 5) {
@@ -280,26 +307,48 @@ void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname) {
             continue;
         }
 
-        if ((de->d_name[0] == '.') || strncmp(&de->d_name[length-4], ".lua", 4)) {
-            // starts with . (hidden file) or doesn't end in .lua
+        const bool bytecode = (length > 5) && (strncmp(&de->d_name[length-5], ".luac", 5) == 0);
+        if ((de->d_name[0] == '.') || (!bytecode && strncmp(&de->d_name[length-4], ".lua", 4))) {
+            // starts with . (hidden file) or doesn't end in .lua or .luac
+            continue;
+        }
+        if (bytecode && !allow_bytecode) {
+            GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "Lua: %s not loaded, bytecode disabled", de->d_name);
             continue;
         }
 
         // FIXME: because chunk name fetching is not working we are allocating and storing an extra string we shouldn't need to
-        size_t size = strlen(dirname) + strlen(de->d_name) + 2;
+        // one extra byte allows for checking for a .luac of the same name
+        size_t size = strlen(dirname) + strlen(de->d_name) + 3;
         char * filename = (char *) _heap.allocate(size);
         if (filename == nullptr) {
             continue;
         }
         snprintf(filename, size, "%s/%s", dirname, de->d_name);
 
+        if (!bytecode && allow_bytecode) {
+            // a precompiled copy of the script is loaded in its place
+            struct stat st;
+            strcat(filename, "c");
+            const bool have_bytecode = AP::FS().stat(filename, &st) == 0;
+            filename[strlen(filename)-1] = 0;
+            if (have_bytecode) {
+                _heap.deallocate(filename);
+                continue;
+            }
+        }
+
         // we have something that looks like a lua file, attempt to load it
-        script_info * script = load_script(L, filename);
+        script_info * script = load_script(L, filename, bytecode);
         if (script == nullptr) {
             _heap.deallocate(filename);
             continue;
         }
-        reschedule_script(script);
+        if (!queue_push(script)) {
+            set_and_print_new_error_message(MAV_SEVERITY_CRITICAL, "Insufficent memory loading %s", filename);
+            remove_script(L, script);
+            continue;
+        }
 
 #if HAL_LOGGER_FILE_CONTENTS_ENABLED
         if (!option_is_set(AP_Scripting::DebugOption::SUPPRESS_SCRIPT_LOG)) {
@@ -318,20 +367,30 @@ void lua_scripts::reset_loop_overtime(lua_State *L) {
 }
 
 void lua_scripts::run_next_script(lua_State *L) {
-    if (scripts == nullptr) {
+    last_vm_steps = 0;
+    last_jitter_us = 0;
+    if (queue_count == 0) {
 #if defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
         AP_HAL::panic("Lua: Attempted to run a script without any scripts queued");
 #endif // defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
         return;
     }
 
-    uint64_t start_time_ms = AP_HAL::millis64();
-    // strip the selected script out of the list
-    script_info *script = scripts;
-    scripts = script->next;
+    const uint64_t start_time_us64 = AP_HAL::micros64();
+    const uint64_t start_time_ms = start_time_us64 / 1000U;
+    // the selected script stays at the front of the queue while it
+    // runs so its statistics remain visible
+    script_info *script = queue_front();
+
+    // how late the run started, the first run is due as soon as the script loads
+    if (script->run_count > 0) {
+        const uint64_t due_us = script->next_run_ms * 1000U;
+        last_jitter_us = (start_time_us64 > due_us) ? MIN(start_time_us64 - due_us, uint64_t(UINT32_MAX)) : 0;
+    }
 
     // reset the hook to clear the counter
     reset_loop_overtime(L);
+    const uint32_t start_time_us = AP_HAL::micros();
 
     // store top of stack so we can calculate the number of return values
     int stack_top = lua_gettop(L);
@@ -339,9 +398,26 @@ void lua_scripts::run_next_script(lua_State *L) {
     // pop the function to the top of the stack
     lua_rawgeti(L, LUA_REGISTRYINDEX, script->run_ref);
     // set current environment for other users
-    AP::scripting()->set_current_env_ref(script->env_ref);
+    current_env_ref = script->env_ref;
+
+    const int status = lua_pcall(L, 0, LUA_MULTRET, 0);
+
+    // the hook counts down from the VM step limit, so the number of
+    // instructions executed is the amount it has counted down by
+    const uint32_t run_time_us = AP_HAL::micros() - start_time_us;
+    last_vm_steps = L->basehookcount - L->hookcount;
+    {
+        WITH_SEMAPHORE(queue_sem);
+        script->run_count++;
+        script->run_time_us += run_time_us;
+        script->max_run_time_us = MAX(script->max_run_time_us, run_time_us);
+        script->vm_steps += last_vm_steps;
+        script->max_vm_steps = MAX(script->max_vm_steps, last_vm_steps);
+        script->jitter_us += last_jitter_us;
+        script->max_jitter_us = MAX(script->max_jitter_us, last_jitter_us);
+    }
 
-    if(lua_pcall(L, 0, LUA_MULTRET, 0)) {
+    if (status) {
         if (overtime) {
             // script has consumed an excessive amount of CPU time
             set_and_print_new_error_message(MAV_SEVERITY_CRITICAL, "%s exceeded time limit", script->name);
@@ -375,7 +451,16 @@ void lua_scripts::run_next_script(lua_State *L) {
                     }
 
                     // types match the expectations, go ahead and reschedule
-                    script->next_run_ms = start_time_ms + (uint64_t)luaL_checknumber(L, -1);
+                    const uint64_t delay_ms = (uint64_t)luaL_checknumber(L, -1);
+                    if ((_lane == Lane::FAST) && (script->next_run_ms + delay_ms > start_time_ms)) {
+                        // fast lane scripts run at a fixed rate from when they
+                        // were due, so lateness does not accumulate
+                        script->next_run_ms += delay_ms;
+                    } else {
+                        // normal lane scripts, or a fast lane script which has
+                        // fallen a whole period behind and skips the missed runs
+                        script->next_run_ms = start_time_ms + delay_ms;
+                    }
                     lua_pop(L, 1);
                     int old_ref = script->run_ref;
                     script->run_ref = luaL_ref(L, LUA_REGISTRYINDEX);
@@ -400,15 +485,12 @@ void lua_scripts::remove_script(lua_State *L, script_info *script) {
         return;
     }
 
-    // ensure that the script isn't in the loaded list for any reason
-    if (scripts == nullptr) {
-        // nothing to do, already not in the list
-    } else if (scripts == script) {
-        scripts = script->next;
-    } else {
-        for(script_info * current = scripts; current->next != nullptr; current = current->next) {
-            if (current->next == script) {
-                current->next = script->next;
+    {
+        // ensure that the script isn't in the queue for any reason
+        WITH_SEMAPHORE(queue_sem);
+        for (uint16_t i = 0; i < queue_count; i++) {
+            if (queue[i] == script) {
+                queue_remove(i);
                 break;
             }
         }
@@ -437,38 +519,126 @@ void lua_scripts::reschedule_script(script_info *script) {
        return;
     }
 
-    script->next = nullptr;
-    if (scripts == nullptr) {
-        scripts = script;
-        return;
+    // only the script at the front of the queue is ever rescheduled,
+    // as it is the one which has just been run
+    if (queue_front() != script) {
+#if defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
+       AP_HAL::panic("Lua: Attempted to reschedule a script which has not run");
+#endif // defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
+       return;
     }
 
-    uint64_t next_run_ms = script->next_run_ms;
+    WITH_SEMAPHORE(queue_sem);
+    queue_sift_down(0);
+}
 
-    if (scripts->next_run_ms > next_run_ms) {
-        script->next = scripts;
-        scripts = script;
+// add a script to the run queue, returns false if the queue could not be expanded
+bool lua_scripts::queue_push(script_info *script) {
+    WITH_SEMAPHORE(queue_sem);
+    if (queue_count == queue_size) {
+        if (queue_size >= UINT16_MAX / 2) {
+            return false;
+        }
+        const uint16_t new_size = MAX(queue_size * 2, 8);
+        script_info **new_queue = (script_info **)_heap.change_size(queue, queue_size * sizeof(script_info *), new_size * sizeof(script_info *));
+        if (new_queue == nullptr) {
+            return false;
+        }
+        queue = new_queue;
+        queue_size = new_size;
+    }
+    queue[queue_count] = script;
+    queue_count++;
+    queue_sift_up(queue_count - 1);
+    return true;
+}
+
+// remove the script at index idx from the run queue, queue_sem must be held
+void lua_scripts::queue_remove(uint16_t idx) {
+    queue_count--;
+    if (idx == queue_count) {
         return;
     }
+    // move the last script into the gap and restore the heap order
+    queue[idx] = queue[queue_count];
+    queue_sift_up(idx);
+    queue_sift_down(idx);
+}
 
-    script_info *previous = scripts;
-    while (previous->next != nullptr) {
-        if (previous->next->next_run_ms > next_run_ms) {
-            script->next = previous->next;
-            previous->next = script;
-            return;
+// move the script at idx towards the front of the queue until its parent runs no later, queue_sem must be held
+void lua_scripts::queue_sift_up(uint16_t idx) {
+    script_info *script = queue[idx];
+    while (idx > 0) {
+        const uint16_t parent = (idx - 1) / 2;
+        if (queue[parent]->next_run_ms <= script->next_run_ms) {
+            break;
         }
-        previous = previous->next;
+        queue[idx] = queue[parent];
+        idx = parent;
     }
+    queue[idx] = script;
+}
 
-    previous->next = script;
+// move the script at idx away from the front of the queue until its children run no earlier, queue_sem must be held
+void lua_scripts::queue_sift_down(uint16_t idx) {
+    script_info *script = queue[idx];
+    while (true) {
+        uint16_t child = idx * 2 + 1;
+        if (child >= queue_count) {
+            break;
+        }
+        if ((child + 1 < queue_count) && (queue[child + 1]->next_run_ms < queue[child]->next_run_ms)) {
+            child++;
+        }
+        if (script->next_run_ms <= queue[child]->next_run_ms) {
+            break;
+        }
+        queue[idx] = queue[child];
+        idx = child;
+    }
+    queue[idx] = script;
 }
 
-MultiHeap lua_scripts::_heap;
+/*
+  collect garbage after a script run. In full mode this is a complete
+  collection. In incremental mode the collector is stopped while
+  scripts run and does a bounded step of work here instead
+ */
+void lua_scripts::collect_garbage(lua_State *L, uint32_t &gc_time_us, int &gc_freed)
+{
+    const AP_Scripting *scripting = AP_Scripting::get_singleton();
+    const bool incremental = scripting->get_gc_mode() == AP_Scripting::GCMode::INCREMENTAL;
+    if (incremental != gc_incremental) {
+        lua_gc(L, incremental ? LUA_GCSTOP : LUA_GCRESTART, 0);
+        gc_incremental = incremental;
+    }
+
+    const int startMem = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
+    const uint32_t start_us = AP_HAL::micros();
+
+    if (incremental) {
+        lua_gc(L, LUA_GCSETPAUSE, constrain_int16(scripting->get_gc_pause(), 100, 1000));
+        lua_gc(L, LUA_GCSETSTEPMUL, constrain_int16(scripting->get_gc_stepmul(), 40, 1000));
+        lua_gc(L, LUA_GCSTEP, constrain_int16(scripting->get_gc_step_kb(), 1, 64));
+    } else {
+        // this shouldn't matter, but seems to resolve a memory leak
+        lua_gc(L, LUA_GCCOLLECT, 0);
+    }
+
+    gc_time_us = AP_HAL::micros() - start_us;
+    const int endMem = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
+    // finalizers may allocate, so this can be negative
+    gc_freed = MAX(startMem - endMem, 0);
+
+    WITH_SEMAPHORE(queue_sem);
+    gc.count++;
+    gc.time_us += gc_time_us;
+    gc.max_time_us = MAX(gc.max_time_us, gc_time_us);
+    gc.freed += gc_freed;
+}
 
 void *lua_scripts::alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
-    (void)ud; /* not used */
-    return _heap.change_size(ptr, osize, nsize);
+    return ((MultiHeap *)ud)->change_size(ptr, osize, nsize);
 }
 
 void lua_scripts::run(void) {
@@ -488,19 +658,23 @@ void lua_scripts::run(void) {
             lua_close(lua_state); // shutdown the old state
         }
         // remove all the old scheduled scripts
-        for (script_info *script = scripts; script != nullptr; script = scripts) {
+        for (script_info *script = queue_front(); script != nullptr; script = queue_front()) {
             remove_script(nullptr, script);
         }
-        scripts = nullptr;
         overtime = false;
     }
 
-    lua_state = lua_newstate(alloc, NULL);
+    lua_state = lua_newstate(alloc, &_heap);
     lua_State *L = lua_state;
     if (L == nullptr) {
         GCS_SEND_TEXT(MAV_SEVERITY_CRITICAL, "Lua: Couldn't allocate a lua state");
         return;
     }
+    // Lua copies this into every thread it creates, so the hook and
+    // panic handler can find the lane
+    *(lua_scripts **)lua_getextraspace(L) = this;
+    // a new state starts with the collector running
+    gc_incremental = false;
 
 #ifndef HAL_CONSOLE_DISABLED
     const int inital_mem = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
@@ -526,15 +700,18 @@ void lua_scripts::run(void) {
 
     // Scan the filesystem in an appropriate manner and autostart scripts
     // Skip those directores disabled with SCR_DIR_DISABLE param
+    // fast lane scripts are kept in a subdirectory
+    const bool fast = _lane == Lane::FAST;
     uint16_t dir_disable = AP_Scripting::get_singleton()->get_disabled_dir();
     bool loaded = false;
     if ((dir_disable & uint16_t(AP_Scripting::SCR_DIR::SCRIPTS)) == 0) {
-        load_all_scripts_in_dir(L, SCRIPTING_DIRECTORY);
+        load_all_scripts_in_dir(L, fast ? SCRIPTING_DIRECTORY "/fast" : SCRIPTING_DIRECTORY, option_is_set(AP_Scripting::DebugOption::ALLOW_BYTECODE));
         loaded = true;
     }
 #ifdef HAL_HAVE_AP_ROMFS_EMBEDDED_LUA
     if ((dir_disable & uint16_t(AP_Scripting::SCR_DIR::ROMFS)) == 0) {
-        load_all_scripts_in_dir(L, "@ROMFS/scripts");
+        // scripts built into the firmware are trusted to be bytecode
+        load_all_scripts_in_dir(L, fast ? "@ROMFS/scripts/fast" : "@ROMFS/scripts", true);
         loaded = true;
     }
 #endif
@@ -555,32 +732,31 @@ void lua_scripts::run(void) {
         }
 #endif // defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
 
-        if (scripts != nullptr) {
+        script_info *next_script = queue_front();
+        if (next_script != nullptr) {
 #if defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
-              // Sanity check that the scripts list is ordered correctly
-              script_info *sanity = scripts;
-              while (sanity->next != nullptr) {
-                  if (sanity->next_run_ms > sanity->next->next_run_ms) {
+              // Sanity check that the scripts queue is ordered correctly
+              for (uint16_t i = 1; i < queue_count; i++) {
+                  if (queue[(i - 1) / 2]->next_run_ms > queue[i]->next_run_ms) {
                       AP_HAL::panic("Lua: Script tasking order has been violated");
                   }
-                  sanity = sanity->next;
               }
 #endif // defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
 
             // compute delay time
             uint64_t now_ms = AP_HAL::millis64();
-            if (now_ms < scripts->next_run_ms) {
-                hal.scheduler->delay(scripts->next_run_ms - now_ms);
+            if (now_ms < next_script->next_run_ms) {
+                hal.scheduler->delay(next_script->next_run_ms - now_ms);
             }
 
             if (option_is_set(AP_Scripting::DebugOption::RUNTIME_MSG)) {
-                GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "Lua: Running %s", scripts->name);
+                GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "Lua: Running %s", next_script->name);
             }
             // take a copy of the script name for the purposes of
-            // logging statistics.  "scripts" may become invalid
+            // logging statistics.  "next_script" may become invalid
             // during the "run_next_script" call, below.
             char script_name[128+1] {};
-            strncpy_noterm(script_name, scripts->name, 128);
+            strncpy_noterm(script_name, next_script->name, 128);
 
 #if DISABLE_INTERRUPTS_FOR_SCRIPT_RUN
             void *istate = hal.scheduler->disable_interrupts_save();
@@ -589,10 +765,9 @@ void lua_scripts::run(void) {
             const int startMem = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
             const uint32_t loadEnd = AP_HAL::micros();
 
-            // NOTE!  the base pointer of our scripts linked list,
-            // *and all its contents* may become invalid as part of
-            // "run_next_script"!  So do *NOT* attempt to access
-            // anything that was in *scripts after this call.
+            // NOTE!  the script at the front of the queue may be
+            // removed and freed as part of "run_next_script"!  So do
+            // *NOT* attempt to access next_script after this call.
             run_next_script(L);
 
             const uint32_t runEnd = AP_HAL::micros();
@@ -602,14 +777,15 @@ void lua_scripts::run(void) {
             hal.scheduler->restore_interrupts(istate);
 #endif
 
-            update_stats(script_name, runEnd - loadEnd, endMem, endMem - startMem);
-
+            // garbage collect after each script, timed separately from the script
+            uint32_t gc_time_us;
+            int gc_freed;
+            collect_garbage(L, gc_time_us, gc_freed);
 
-            // garbage collect after each script, this shouldn't matter, but seems to resolve a memory leak
-            lua_gc(L, LUA_GCCOLLECT, 0);
+            update_stats(script_name, runEnd - loadEnd, endMem, endMem - startMem, last_vm_steps, gc_time_us, gc_freed, last_jitter_us);
 
         } else {
-            if (option_is_set(AP_Scripting::DebugOption::NO_SCRIPTS_TO_RUN)) {
+            if (option_is_set(AP_Scripting::DebugOption::NO_SCRIPTS_TO_RUN) && !fast) {
                 GCS_SEND_TEXT(MAV_SEVERITY_DEBUG, "Lua: No scripts to run");
             }
             hal.scheduler->delay(1000);
@@ -623,12 +799,12 @@ void lua_scripts::run(void) {
         const uint32_t new_expansion_size = _heap.get_expansion_size();
         if (new_expansion_size > expansion_size) {
             expansion_size = new_expansion_size;
-            set_and_print_new_error_message(MAV_SEVERITY_WARNING, "Required SCR_HEAP_SIZE over %u", unsigned(expansion_size));
+            set_and_print_new_error_message(MAV_SEVERITY_WARNING, "Required %s over %u", fast ? "SCR_FAST_HEAP" : "SCR_HEAP_SIZE", unsigned(expansion_size));
         }
 
-        // re-print the latest error message every 10 seconds 10 times
+        // re-print the latest error message every 10 seconds 10 times, the message is shared by both lanes
         const uint8_t error_prints = 10;
-        if ((print_error_count < error_prints) && (AP_HAL::millis() - last_print_ms > 10000)) {
+        if (!fast && (print_error_count < error_prints) && (AP_HAL::millis() - last_print_ms > 10000)) {
             // note that we do not clear the buffer after we have finished printing, this allows it to be used for a pre-arm check
             print_error(MAV_SEVERITY_DEBUG);
             print_error_count++;
@@ -636,8 +812,8 @@ void lua_scripts::run(void) {
     }
 
     // make sure all scripts have been removed
-    while (scripts != nullptr) {
-        remove_script(lua_state, scripts);
+    while (queue_front() != nullptr) {
+        remove_script(lua_state, queue_front());
     }
 
     if (lua_state != nullptr) {
@@ -645,12 +821,12 @@ void lua_scripts::run(void) {
         lua_state = nullptr;
     }
 
-    error_msg_buf_sem.take_blocking();
-    if (error_msg_buf != nullptr) {
-        _heap.deallocate(error_msg_buf);
+    if (!fast) {
+        error_msg_buf_sem.take_blocking();
+        delete[] error_msg_buf;
         error_msg_buf = nullptr;
+        error_msg_buf_sem.give();
     }
-    error_msg_buf_sem.give();
 }
 
 // Return the file checksums of running and loaded scripts
@@ -666,4 +842,60 @@ uint32_t lua_scripts::get_running_checksum()
     return running_checksum;
 }
 
+// write run statistics of each script followed by garbage collection
+// and scripting heap statistics for @SYS/scripts.txt, times are in microseconds and steps
+// are Lua VM instructions
+void lua_scripts::scripts_info(ExpandingString &str)
+{
+    // a header to allow for machine parsers to determine format
+    str.printf("ScriptsV2\n");
+
+    WITH_SEMAPHORE(instances_sem);
+    for (lua_scripts *lane : instances) {
+        if (lane != nullptr) {
+            WITH_SEMAPHORE(lane->queue_sem);
+            lane->lane_info(str);
+        }
+    }
+}
+
+void lua_scripts::lane_info(ExpandingString &str) const
+{
+    str.printf("LANE %s\n", (_lane == Lane::FAST) ? "FAST" : "NORMAL");
+
+    for (uint16_t i = 0; i < queue_count; i++) {
+        const script_info *script = queue[i];
+        const char *name = strrchr(script->name, '/');
+        name = (name != nullptr) ? name + 1 : script->name;
+        const uint32_t runs = MAX(script->run_count, 1U);
+        str.printf("%-24s RUNS=%-7u AVG=%-7u MAX=%-7u STEPS=%-7u MAXSTEPS=%-7u JIT=%-7u MAXJIT=%-7u TOT=%ums\n",
+                   name,
+                   unsigned(script->run_count),
+                   unsigned(script->run_time_us / runs),
+                   unsigned(script->max_run_time_us),
+                   unsigned(script->vm_steps / runs),
+                   unsigned(script->max_vm_steps),
+                   unsigned(script->jitter_us / runs),
+                   unsigned(script->max_jitter_us),
+                   unsigned(script->run_time_us / 1000U));
+    }
+
+    // time spent collecting garbage between script runs
+    const uint32_t gc_runs = MAX(gc.count, 1U);
+    str.printf("GC RUNS=%-7u AVG=%-7u MAX=%-7u FREED=%ukB TOT=%ums\n",
+               unsigned(gc.count),
+               unsigned(gc.time_us / gc_runs),
+               unsigned(gc.max_time_us),
+               unsigned(gc.freed / 1024U),
+               unsigned(gc.time_us / 1000U));
+
+    // memory use and fragmentation of the scripting heap
+    _heap.info(str);
+}
+
+int lua_get_current_env_ref(lua_State *L)
+{
+    return lua_scripts::get_current_env_ref(L);
+}
+
 #endif  // AP_SCRIPTING_ENABLED
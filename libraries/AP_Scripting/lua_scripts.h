@@ -27,6 +27,7 @@
 #include <GCS_MAVLink/GCS_MAVLink.h>
 #include <AP_HAL/Semaphores.h>
 #include <AP_MultiHeap/AP_MultiHeap.h>
+#include <AP_Common/ExpandingString.h>
 #include "lua_common_defs.h"
 
 #include "lua/src/lua.hpp"
@@ -34,7 +35,15 @@
 class lua_scripts
 {
 public:
-    lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size, AP_Int8 &debug_options);
+    // scripts run in one of two lanes, each with its own thread, heap
+    // and Lua state so one lane can't hold up the other
+    enum class Lane : uint8_t {
+        NORMAL = 0,
+        FAST = 1, // fixed rate scripts from the fast subdirectory
+    };
+    static const uint8_t num_lanes = 2;
+
+    lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size, AP_Int8 &debug_options, Lane lane);
 
     ~lua_scripts();
 
@@ -46,10 +55,21 @@ public:
     // run scripts, does not return unless an error occured
     void run(void);
 
-    static bool overtime; // script exceeded it's execution slot, and we are bailing out
+    // get the environment of the script running in the lane of a Lua state
+    static int get_current_env_ref(lua_State *L) { return get_instance(L)->current_env_ref; }
 
 private:
 
+    // get the lua_scripts running a Lua state, stored in the extra space of every Lua thread
+    static lua_scripts *get_instance(lua_State *L) { return *(lua_scripts **)lua_getextraspace(L); }
+
+    const Lane _lane;
+
+    bool overtime; // script exceeded it's execution slot, and we are bailing out
+
+    // environment of the script being run, for require
+    int current_env_ref;
+
     void create_sandbox(lua_State *L);
 
     typedef struct script_info {
@@ -58,23 +78,49 @@ private:
        uint64_t next_run_ms; // time (in milliseconds) the script should next be run at
        uint32_t crc;         // crc32 checksum
        char *name;           // filename for the script // FIXME: This information should be available from Lua
-       script_info *next;
+       uint32_t run_count;   // number of times the script has been run
+       uint64_t run_time_us; // total time spent running the script
+       uint32_t max_run_time_us; // longest single run of the script
+       uint64_t vm_steps;    // total number of VM instructions executed by the script
+       uint32_t max_vm_steps; // most VM instructions executed in a single run
+       uint64_t jitter_us;   // total time runs started after they were due
+       uint32_t max_jitter_us; // latest start of a single run
     } script_info;
 
-    script_info *load_script(lua_State *L, char *filename);
+    script_info *load_script(lua_State *L, char *filename, bool bytecode);
 
     void reset_loop_overtime(lua_State *L);
 
-    void load_all_scripts_in_dir(lua_State *L, const char *dirname);
+    void load_all_scripts_in_dir(lua_State *L, const char *dirname, bool allow_bytecode);
 
     void run_next_script(lua_State *L);
 
     void remove_script(lua_State *L, script_info *script);
 
-    // reschedule the script for execution. It is assumed the script is not in the list already
+    // reschedule the script for execution. It is assumed the script is not in the queue already
     void reschedule_script(script_info *script);
 
-    script_info *scripts; // linked list of scripts to be run, sorted by next run time (soonest first)
+    // run queue management, a binary min-heap ordered by next run time
+    // so the next script to run is always at the front of the queue
+    bool queue_push(script_info *script);
+    void queue_remove(uint16_t idx);
+    void queue_sift_up(uint16_t idx);
+    void queue_sift_down(uint16_t idx);
+    script_info *queue_front() const { return (queue_count > 0) ? queue[0] : nullptr; }
+
+    // read from the @SYS filesystem, protected by queue_sem
+    script_info **queue; // scripts to be run, queue[0] has the soonest next run time
+    uint16_t queue_count; // number of scripts in the queue
+    uint16_t queue_size; // number of entries allocated for the queue
+    HAL_Semaphore queue_sem;
+
+    // lanes which are running, for the @SYS filesystem, protected by instances_sem
+    static lua_scripts *instances[num_lanes];
+    static HAL_Semaphore instances_sem;
+
+    // number of VM instructions executed and start jitter of the last script run
+    uint32_t last_vm_steps;
+    uint32_t last_jitter_us;
 
     // hook will be run when CPU time for a script is exceeded
     // it must be static to be passed to the C API
@@ -82,7 +128,7 @@ private:
 
     // lua panic handler, will jump back to the start of run
     static int atpanic(lua_State *L);
-    static jmp_buf panic_jmp;
+    jmp_buf panic_jmp;
 
     lua_State *lua_state;
 
@@ -93,14 +139,32 @@ private:
         return (uint8_t(_debug_options.get()) & uint8_t(option)) != 0;
     }
 
+    // allocator for the Lua state, ud is the lane's heap
     static void *alloc(void *ud, void *ptr, size_t osize, size_t nsize);
 
-    static MultiHeap _heap;
+    MultiHeap _heap;
 
     // helper for print and log of runtime stats
-    void update_stats(const char *name, uint32_t run_time, int total_mem, int run_mem);
+    void update_stats(const char *name, uint32_t run_time, int total_mem, int run_mem, uint32_t vm_steps, uint32_t gc_time, int gc_freed, uint32_t jitter);
+
+    // garbage collect after a script run as set by SCR_GC_MODE, returns the time taken and bytes freed
+    void collect_garbage(lua_State *L, uint32_t &gc_time_us, int &gc_freed);
+
+    // true if the collector has been stopped for incremental mode
+    bool gc_incremental;
 
-    // must be static for use in atpanic
+    // garbage collection totals, protected by queue_sem
+    struct gc_stats {
+        uint32_t count;
+        uint64_t time_us;
+        uint32_t max_time_us;
+        uint64_t freed;
+    } gc;
+
+    // write run statistics of this lane's scripts and heap, queue_sem must be held
+    void lane_info(ExpandingString &str) const;
+
+    // shared by all lanes, the message buffer is allocated from the system heap
     static void print_error(MAV_SEVERITY severity);
     static char *error_msg_buf;
     static HAL_Semaphore error_msg_buf_sem;
@@ -126,6 +190,9 @@ public:
     static uint32_t get_loaded_checksum();
     static uint32_t get_running_checksum();
 
+    // write run statistics of each script and scripting heap usage of each lane for @SYS/scripts.txt
+    static void scripts_info(ExpandingString &str);
+
 };
 
 #endif  // AP_SCRIPTING_ENABLED
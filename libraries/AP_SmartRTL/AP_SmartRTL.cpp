@@ -22,7 +22,7 @@ extern const AP_HAL::HAL& hal;
 const AP_Param::GroupInfo AP_SmartRTL::var_info[] = {
     // @Param: ACCURACY
     // @DisplayName: SmartRTL accuracy
-    // @Description: SmartRTL accuracy. The minimum distance between points.
+    // @Description: SmartRTL accuracy. The minimum distance between points. Points are stored to one eighth of this distance, which limits the path to 4096 times this distance from the EKF origin.
     // @Units: m
     // @Range: 0 10
     // @User: Advanced
@@ -30,8 +30,8 @@ const AP_Param::GroupInfo AP_SmartRTL::var_info[] = {
 
     // @Param: POINTS
     // @DisplayName: SmartRTL maximum number of points on path
-    // @Description: SmartRTL maximum number of points on path. Set to 0 to disable SmartRTL.  100 points consumes about 3k of memory.
-    // @Range: 0 500
+    // @Description: SmartRTL maximum number of points on path. Set to 0 to disable SmartRTL.  100 points consumes about 2.5k of memory.
+    // @Range: 0 2000
     // @User: Advanced
     // @RebootRequired: True
     AP_GROUPINFO("POINTS", 1, AP_SmartRTL, _points_max, SMARTRTL_POINTS_DEFAULT),
@@ -62,7 +62,8 @@ const AP_Param::GroupInfo AP_SmartRTL::var_info[] = {
 *    points when their line segments get close. This algorithm will never
 *    compare two consecutive line segments. Obviously the segments (p1,p2) and
 *    (p2,p3) will get very close (they touch), but there would be nothing to
-*    trim between them.
+*    trim between them. Segments are held in a spatial hash of horizontal
+*    cells so each segment is only compared to the segments passing nearby.
 *
 *    2. Simplification uses the Ramer-Douglas-Peucker algorithm. See Wikipedia
 *    for a more complete description.
@@ -107,23 +108,38 @@ void AP_SmartRTL::init()
     }
 
     // allocate arrays
-    _path = (Vector3f*)calloc(_points_max, sizeof(Vector3f));
+    _path = (Vector3i*)calloc(_points_max, sizeof(Vector3i));
+    _path_resolution = _accuracy * SMARTRTL_POINT_RESOLUTION_MULT;
 
     _prune.loops_max = _points_max * SMARTRTL_PRUNING_LOOP_BUFFER_LEN_MULT;
     _prune.loops = (prune_loop_t*)calloc(_prune.loops_max, sizeof(prune_loop_t));
 
+    // spatial hash with a power of two number of buckets, at least one per point
+    uint32_t num_buckets = 1;
+    while (num_buckets < (uint32_t)_points_max) {
+        num_buckets <<= 1;
+    }
+    _prune.bucket_mask = num_buckets - 1;
+    _prune.buckets = (uint16_t*)malloc(num_buckets * sizeof(uint16_t));
+    _prune.entries_max = MIN(_points_max * SMARTRTL_PRUNING_HASH_ENTRIES_MULT, UINT16_MAX - 1);
+    _prune.entries = (hash_entry_t*)calloc(_prune.entries_max, sizeof(hash_entry_t));
+
     _simplify.stack_max = _points_max * SMARTRTL_SIMPLIFY_STACK_LEN_MULT;
     _simplify.stack = (simplify_start_finish_t*)calloc(_simplify.stack_max, sizeof(simplify_start_finish_t));
 
     // check if memory allocation failed
-    if (_path == nullptr || _prune.loops == nullptr || _simplify.stack == nullptr) {
+    if (_path == nullptr || _prune.loops == nullptr || _prune.buckets == nullptr || _prune.entries == nullptr || _simplify.stack == nullptr) {
         log_action(Action::DEACTIVATED_INIT_FAILED);
         GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "SmartRTL deactivated: init failed");
         free(_path);
         free(_prune.loops);
+        free(_prune.buckets);
+        free(_prune.entries);
         free(_simplify.stack);
+        _path = nullptr;
         return;
     }
+    memset(_prune.buckets, 0xFF, num_buckets * sizeof(uint16_t));
 
     _path_points_max = _points_max;
 
@@ -161,7 +177,7 @@ bool AP_SmartRTL::pop_point(Vector3f& point)
     }
 
     // return last point and remove from path
-    point = _path[--_path_points_count];
+    point = get_point(--_path_points_count);
 
     // record count of last point popped
     _path_points_completed_limit = _path_points_count;
@@ -191,7 +207,7 @@ bool AP_SmartRTL::peek_point(Vector3f& point)
     }
 
     // return last point
-    point = _path[_path_points_count-1];
+    point = get_point(_path_points_count-1);
 
     _path_sem.give();
     return true;
@@ -328,13 +344,21 @@ bool AP_SmartRTL::add_point(const Vector3f& point)
 
     // check if we have traveled far enough
     if (_path_points_count > 0) {
-        const Vector3f& last_pos = _path[_path_points_count-1];
+        const Vector3f last_pos = get_point(_path_points_count-1);
         if (last_pos.distance_squared(point) < sq(_accuracy.get())) {
             _path_sem.give();
             return true;
         }
     }
 
+    // check the point can be stored
+    Vector3i path_point;
+    if (!quantize_point(point, path_point)) {
+        _path_sem.give();
+        deactivate(Action::DEACTIVATED_OUT_OF_RANGE, "too far from origin");
+        return false;
+    }
+
     // check we have space in the path
     if (_path_points_count >= _path_points_max) {
         _path_sem.give();
@@ -343,7 +367,7 @@ bool AP_SmartRTL::add_point(const Vector3f& point)
     }
 
     // add point to path
-    _path[_path_points_count++] = point;
+    _path[_path_points_count++] = path_point;
     log_action(Action::POINT_ADD, point);
 
     _path_sem.give();
@@ -523,12 +547,15 @@ void AP_SmartRTL::detect_simplifications()
         const uint16_t end_index = tmp.finish;
 
         // find the point between start and end points that is farthest from the start-end line segment
+        // distances are in path units to avoid scaling every point
+        const Vector3f start_point = _path[start_index].tofloat();
+        const Vector3f end_point = _path[end_index].tofloat();
         float max_dist = 0.0f;
         uint16_t farthest_point_index = start_index;
         for (uint16_t i = start_index + 1; i < end_index; i++) {
             // only check points that have not already been flagged for simplification
             if (_simplify.bitmask.get(i)) {
-                const float dist = _path[i].distance_to_segment(_path[start_index], _path[end_index]);
+                const float dist = _path[i].tofloat().distance_to_segment(start_point, end_point);
                 if (dist > max_dist) {
                     farthest_point_index = i;
                     max_dist = dist;
@@ -538,7 +565,7 @@ void AP_SmartRTL::detect_simplifications()
 
         // if the farthest point is more than ACCURACY * 0.5 add two new elements to the _simplification_stack
         // so that on the next iteration we will check between start-to-farthestpoint and farthestpoint-to-end
-        if (max_dist > SMARTRTL_SIMPLIFY_EPSILON) {
+        if (max_dist * _path_resolution > SMARTRTL_SIMPLIFY_EPSILON) {
             // if the to-do list is full, give up on simplifying. This should never happen.
             if (_simplify.stack_count >= _simplify.stack_max) {
                 _simplify.complete = true;
@@ -561,7 +588,8 @@ void AP_SmartRTL::detect_simplifications()
 /**
 *   This method runs for the allotted time, and detects loops in a path. Any detected loops are added to _prune.loops,
 *   this function does not alter the path in memory. It works by comparing the line segment between any two sequential points
-*   to the line segment between any other two sequential points. If they get close enough, anything between them could be pruned.
+*   to the line segments between earlier sequential points which pass nearby, found using a spatial hash of the segments.
+*   If they get close enough, anything between them could be pruned.
 *
 *   reset_pruning should have been called at least once before this function is called to setup the indexes (_prune.i, etc)
 */
@@ -579,32 +607,38 @@ void AP_SmartRTL::detect_loops()
     // run for defined amount of time
     while (AP_HAL::micros() - start_time_us < SMARTRTL_PRUNING_LOOP_TIME_US) {
 
-        // advance inner loop
-        _prune.j++;
-        if (_prune.j > _prune.i - 2) {
-            // set inner loop back to first point
-            _prune.j = 1;
-            // reduce outer loop
-            _prune.i--;
-            // complete when outer loop has run out of new points to check
-            if (_prune.i < 4 || _prune.i < _prune.path_points_completed) {
+        // add all segments which could be the start of a loop to the spatial hash before searching it
+        if (_prune.segments_hashed < _prune.path_points_count - 3) {
+            if (!hash_add_segment(_prune.segments_hashed + 1)) {
+                // if the hash is full, stop trying to prune
                 _prune.complete = true;
-                _prune.path_points_completed = _prune.path_points_count;
                 return;
             }
+            _prune.segments_hashed++;
+            continue;
+        }
+
+        // complete when outer loop has run out of new points to check
+        if (_prune.i < 4 || _prune.i < _prune.path_points_completed) {
+            _prune.complete = true;
+            _prune.path_points_completed = _prune.path_points_count;
+            return;
         }
 
-        // find the closest distance between two line segments and the mid-point
-        dist_point dp = segment_segment_dist(_path[_prune.i], _path[_prune.i-1], _path[_prune.j-1], _path[_prune.j]);
-        if (dp.distance < SMARTRTL_PRUNING_DELTA) {
+        // find the earliest segment which comes close to this one, and the mid-point
+        uint16_t loop_start;
+        Vector3f midpoint;
+        if (hash_find_loop(_prune.i, loop_start, midpoint)) {
             // if there is a loop here, add to loop array
-            if (!add_loop(_prune.j, _prune.i-1, dp.midpoint)) {
+            if (!add_loop(loop_start, _prune.i-1, midpoint)) {
                 // if the buffer is full, stop trying to prune
                 _prune.complete = true;
+                return;
             }
-            // set inner loop forward to trigger outer loop move to next segment
-            _prune.j = _prune.i;
         }
+
+        // move to next segment
+        _prune.i--;
     }
 }
 
@@ -645,12 +679,35 @@ void AP_SmartRTL::reset_simplification()
 }
 
 // restart pruning algorithm to check new points that have arrived
+// the spatial hash is rebuilt as simplification and pruning move points
 void AP_SmartRTL::restart_pruning(uint16_t path_points_count)
 {
     _prune.complete = false;
     _prune.i = (path_points_count > 0) ? path_points_count - 1 : 0;
-    _prune.j = 0;
+    _prune.segments_hashed = 0;
     _prune.path_points_count = path_points_count;
+
+    // clear the spatial hash
+    memset(_prune.buckets, 0xFF, (_prune.bucket_mask + 1) * sizeof(uint16_t));
+    _prune.entries_count = 0;
+
+    // choose the smallest cell size for which the entries for all segments will fit in the hash
+    float cell_size = SMARTRTL_PRUNING_CELL_MULT / SMARTRTL_POINT_RESOLUTION_MULT;
+    for (uint8_t attempt = 0; attempt < 16; attempt++) {
+        const float cell_size_inv = 1.0f / cell_size;
+        uint32_t entries = 0;
+        for (uint16_t i = 1; i < path_points_count && entries <= _prune.entries_max; i++) {
+            const Vector3i &p1 = _path[i-1];
+            const Vector3i &p2 = _path[i];
+            entries += 1 + abs(int32_t(floorf(p2.x * cell_size_inv)) - int32_t(floorf(p1.x * cell_size_inv)))
+                         + abs(int32_t(floorf(p2.y * cell_size_inv)) - int32_t(floorf(p1.y * cell_size_inv)));
+        }
+        if (entries <= _prune.entries_max) {
+            break;
+        }
+        cell_size *= 2.0f;
+    }
+    _prune.cell_size_inv = 1.0f / cell_size;
 }
 
 // reset pruning algorithm so that it will re-check all points in the path
@@ -672,7 +729,7 @@ void AP_SmartRTL::remove_points_by_simplify_bitmask()
     uint16_t removed = 0;
     for (uint16_t src = 1; src < _path_points_count; src++) {
         if (!_simplify.bitmask.get(src)) {
-            log_action(Action::POINT_SIMPLIFY, _path[src]);
+            log_action(Action::POINT_SIMPLIFY, get_point(src));
             removed++;
         } else {
             _path[dest] = _path[src];
@@ -724,7 +781,7 @@ bool AP_SmartRTL::remove_points_by_loops(uint16_t num_points_to_remove)
         // shift points after the end of the loop down by the number of points in the loop
         uint16_t loop_num_points_to_remove = loop.end_index - loop.start_index;
         for (uint16_t dest = loop.start_index + 1; dest < _path_points_count - loop_num_points_to_remove; dest++) {
-            log_action(Action::POINT_PRUNE, _path[dest]);
+            log_action(Action::POINT_PRUNE, get_point(dest));
             _path[dest] = _path[dest + loop_num_points_to_remove];
         }
 
@@ -773,11 +830,17 @@ bool AP_SmartRTL::add_loop(uint16_t start_index, uint16_t end_index, const Vecto
         return false;
     }
 
+    // midpoint lies between points on the path so can always be stored
+    Vector3i path_midpoint;
+    if (!quantize_point(midpoint, path_midpoint)) {
+        return true;
+    }
+
     // create new loop structure and calculate length squared of loop
-    prune_loop_t new_loop = {start_index, end_index, midpoint, 0.0f};
-    new_loop.length_squared = midpoint.distance_squared(_path[start_index]) + midpoint.distance_squared(_path[end_index]);
+    prune_loop_t new_loop = {start_index, end_index, path_midpoint, 0.0f};
+    new_loop.length_squared = midpoint.distance_squared(get_point(start_index)) + midpoint.distance_squared(get_point(end_index));
     for (uint16_t i = start_index; i < end_index; i++) {
-        new_loop.length_squared += _path[i].distance_squared(_path[i+1]);
+        new_loop.length_squared += get_point(i).distance_squared(get_point(i+1));
     }
 
     // look for overlapping loops and find their combined length
@@ -816,6 +879,122 @@ bool AP_SmartRTL::add_loop(uint16_t start_index, uint16_t end_index, const Vecto
     return true;
 }
 
+// convert a point in meters to the format held in the path, returns false if it is out of range
+bool AP_SmartRTL::quantize_point(const Vector3f& point, Vector3i& path_point) const
+{
+    const Vector3f p = point / _path_resolution;
+    for (uint8_t i = 0; i < 3; i++) {
+        if (!(fabsf(p[i]) < INT16_MAX)) {
+            return false;
+        }
+        path_point[i] = (int16_t)lroundf(p[i]);
+    }
+    return true;
+}
+
+// returns spatial hash bucket of a cell
+uint16_t AP_SmartRTL::hash_bucket(int32_t x, int32_t y) const
+{
+    return ((uint32_t(x) * 73856093U) ^ (uint32_t(y) * 19349663U)) & _prune.bucket_mask;
+}
+
+// add a segment to the spatial hash used to find loops, returns false if the hash is full
+bool AP_SmartRTL::hash_add_segment(uint16_t segment)
+{
+    CellWalker walker;
+    walker.init(_path[segment-1].tofloat().xy() * _prune.cell_size_inv, _path[segment].tofloat().xy() * _prune.cell_size_inv);
+    int32_t x, y;
+    while (walker.next(x, y)) {
+        if (_prune.entries_count >= _prune.entries_max) {
+            return false;
+        }
+        const uint16_t bucket = hash_bucket(x, y);
+        _prune.entries[_prune.entries_count] = hash_entry_t {segment, _prune.buckets[bucket]};
+        _prune.buckets[bucket] = _prune.entries_count++;
+    }
+    return true;
+}
+
+// find the earliest segment in the spatial hash which passes within SMARTRTL_PRUNING_DELTA of a segment
+// returns false if there is none, otherwise fills in the found segment and the point midway between the closest points
+bool AP_SmartRTL::hash_find_loop(uint16_t segment, uint16_t &found_segment, Vector3f &midpoint) const
+{
+    const Vector3f p1 = get_point(segment);
+    const Vector3f p2 = get_point(segment-1);
+
+    // a segment within SMARTRTL_PRUNING_DELTA must cross one of the cells crossed by
+    // this segment or their neighbours, as the cells are larger than SMARTRTL_PRUNING_DELTA.
+    // Only segments before the adjacent segment are accepted
+    found_segment = segment - 1;
+    CellWalker walker;
+    walker.init(_path[segment-1].tofloat().xy() * _prune.cell_size_inv, _path[segment].tofloat().xy() * _prune.cell_size_inv);
+    int32_t x, y;
+    while (walker.next(x, y)) {
+        for (int8_t dx = -1; dx <= 1; dx++) {
+            for (int8_t dy = -1; dy <= 1; dy++) {
+                for (uint16_t e = _prune.buckets[hash_bucket(x+dx, y+dy)]; e != UINT16_MAX; e = _prune.entries[e].next) {
+                    // only an earlier segment would make a longer loop
+                    const uint16_t j = _prune.entries[e].segment;
+                    if (j >= found_segment) {
+                        continue;
+                    }
+                    const dist_point dp = segment_segment_dist(p1, p2, get_point(j-1), get_point(j));
+                    if (dp.distance < SMARTRTL_PRUNING_DELTA) {
+                        found_segment = j;
+                        midpoint = dp.midpoint;
+                    }
+                }
+            }
+        }
+    }
+    return found_segment < segment - 1;
+}
+
+// start and end are in units of cells
+void AP_SmartRTL::CellWalker::init(const Vector2f &start, const Vector2f &end)
+{
+    uint32_t steps = 0;
+    for (uint8_t j = 0; j < 2; j++) {
+        _pos[j] = (int32_t)floorf(start[j]);
+        const int32_t end_pos = (int32_t)floorf(end[j]);
+        const float d = end[j] - start[j];
+        if (end_pos > _pos[j]) {
+            _step[j] = 1;
+            _t_delta[j] = 1.0f / d;
+            _t_max[j] = (_pos[j] + 1 - start[j]) * _t_delta[j];
+        } else if (end_pos < _pos[j]) {
+            _step[j] = -1;
+            _t_delta[j] = -1.0f / d;
+            _t_max[j] = (start[j] - _pos[j]) * _t_delta[j];
+        } else {
+            // never crosses a boundary along this axis
+            _step[j] = 0;
+            _t_delta[j] = FLT_MAX;
+            _t_max[j] = FLT_MAX;
+        }
+        steps += abs(end_pos - _pos[j]);
+    }
+    _steps_left = steps + 1;
+}
+
+// get the current cell and move to the next one crossed by the segment
+// returns false once the cell holding the end of the segment has been passed
+bool AP_SmartRTL::CellWalker::next(int32_t &x, int32_t &y)
+{
+    if (_steps_left == 0) {
+        return false;
+    }
+    x = _pos[0];
+    y = _pos[1];
+    _steps_left--;
+
+    // step across the closest cell boundary
+    const uint8_t axis = (_t_max[0] < _t_max[1]) ? 0 : 1;
+    _pos[axis] += _step[axis];
+    _t_max[axis] += _t_delta[axis];
+    return true;
+}
+
 /**
 *  Returns the closest distance in 3D space between any part of two input segments, defined from p1 to p2 and from p3 to p4.
 *  Also returns the point which is halfway between
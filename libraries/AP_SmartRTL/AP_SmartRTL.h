@@ -7,8 +7,9 @@
 
 // definitions and macros
 #define SMARTRTL_ACCURACY_DEFAULT        2.0f   // default _ACCURACY parameter value.  Points will be no closer than this distance (in meters) together.
-#define SMARTRTL_POINTS_DEFAULT          300    // default _POINTS parameter value.  High numbers improve path pruning but use more memory and CPU for cleanup. Memory used will be 20bytes * this number.
-#define SMARTRTL_POINTS_MAX              500    // the absolute maximum number of points this library can support.
+#define SMARTRTL_POINTS_DEFAULT          300    // default _POINTS parameter value.  High numbers improve path pruning but use more memory and CPU for cleanup. Memory used will be 25bytes * this number.
+#define SMARTRTL_POINTS_MAX              2000   // the absolute maximum number of points this library can support.
+#define SMARTRTL_POINT_RESOLUTION_MULT   0.125f // points are held as 16 bit offsets from the EKF origin in units of this multiple of the _ACCURACY parameter, giving a range of +-8km with the default accuracy
 #define SMARTRTL_TIMEOUT                 15000  // the time in milliseconds with no points saved to the path (for whatever reason), before SmartRTL is disabled for the flight
 #define SMARTRTL_CLEANUP_POINT_TRIGGER   50     // simplification will trigger when this many points are added to the path
 #define SMARTRTL_CLEANUP_START_MARGIN    10     // routine cleanup algorithms begin when the path array has only this many empty slots remaining
@@ -21,6 +22,8 @@
 #define SMARTRTL_PRUNING_DELTA (_accuracy * 0.99)   // How many meters apart must two points be, such that we can assume that there is no obstacle between them.  must be smaller than _ACCURACY parameter
 #define SMARTRTL_PRUNING_LOOP_BUFFER_LEN_MULT 0.25f // pruning loop buffer size as compared to maximum number of points
 #define SMARTRTL_PRUNING_LOOP_TIME_US    200    // maximum time (in microseconds) that the loop finding algorithm will run before returning
+#define SMARTRTL_PRUNING_CELL_MULT       8.0f   // minimum size of the spatial hash cells used to find loops as compared to the _ACCURACY parameter.  must be larger than SMARTRTL_PRUNING_DELTA
+#define SMARTRTL_PRUNING_HASH_ENTRIES_MULT 2    // spatial hash entries as compared to maximum number of points
 
 class AP_SmartRTL {
 
@@ -39,7 +42,7 @@ public:
     uint16_t get_num_points() const;
 
     // get a point on the path
-    const Vector3f& get_point(uint16_t index) const { return _path[index]; }
+    Vector3f get_point(uint16_t index) const { return _path[index].tofloat() * _path_resolution; }
 
     // add point to end of path. returns true on success, false on failure (due to failure to take the semaphore)
     bool add_point(const Vector3f& point);
@@ -104,6 +107,7 @@ private:
         DEACTIVATED_BAD_POSITION_TIMEOUT = 9,
         DEACTIVATED_PATH_FULL_TIMEOUT = 10,
         DEACTIVATED_PROGRAM_ERROR = 11,
+        DEACTIVATED_OUT_OF_RANGE = 12,
     };
 
     // enum for SRTL_OPTIONS parameter
@@ -155,6 +159,37 @@ private:
     // returns false if it failed to remove points (because it could not take semaphore)
     bool remove_points_by_loops(uint16_t num_points_to_remove);
 
+    // convert a point in meters to the format held in the path, returns false if it is out of range
+    bool quantize_point(const Vector3f& point, Vector3i& path_point) const;
+
+    // path segment i joins points i-1 and i
+    // add a segment to the spatial hash used to find loops, returns false if the hash is full
+    bool hash_add_segment(uint16_t segment);
+
+    // find the earliest segment in the spatial hash which passes within SMARTRTL_PRUNING_DELTA of a segment, ignoring the adjacent segment
+    // returns false if there is none, otherwise fills in the found segment and the point midway between the closest points
+    bool hash_find_loop(uint16_t segment, uint16_t &found_segment, Vector3f &midpoint) const;
+
+    // steps through the spatial hash cells crossed by a path segment in the horizontal plane
+    class CellWalker {
+    public:
+        // start and end are in units of cells
+        void init(const Vector2f &start, const Vector2f &end);
+
+        // get the current cell, returns false once the cell holding the end of the segment has been passed
+        bool next(int32_t &x, int32_t &y);
+
+    private:
+        int32_t _pos[2];        // current cell
+        int8_t _step[2];        // direction to step along each axis
+        float _t_max[2];        // proportion along segment at which the next cell boundary along each axis is crossed
+        float _t_delta[2];      // proportion along segment between cell boundaries along each axis
+        uint32_t _steps_left;   // number of cells left to visit
+    };
+
+    // returns spatial hash bucket of a cell
+    uint16_t hash_bucket(int32_t x, int32_t y) const;
+
     // add loop to loops array
     //  returns true if loop added successfully, false on failure (because loop array is full)
     //  checks if loop overlaps with an existing loop, keeps only the longer loop
@@ -197,7 +232,8 @@ private:
     ThoroughCleanupType _thorough_clean_type;   // used by example sketch to test simplify and prune separately
 
     // path variables
-    Vector3f* _path;    // points are stored in meters from EKF origin in NED
+    Vector3i* _path;    // points are stored from EKF origin in NED in units of _path_resolution meters
+    float _path_resolution;     // meters per unit of points in the path array. Fixed when the array is allocated as it depends on the _ACCURACY parameter
     uint16_t _path_points_max;  // after the array has been allocated, we will need to know how big it is. We can't use the parameter, because a user could change the parameter in-flight
     uint16_t _path_points_count;// number of points in the path array
     uint16_t _path_points_completed_limit;  // set by main thread to the path_point_count when a point is popped.  used by simplify and prune algorithms to detect path shrinking
@@ -224,18 +260,30 @@ private:
     typedef struct {
         uint16_t start_index;   // index of the first point in the loop
         uint16_t end_index;     // index of the last point in the loop
-        Vector3f midpoint;      // midpoint which should replace the first point when the loop is removed
+        Vector3i midpoint;      // midpoint which should replace the first point when the loop is removed
         float length_squared;   // length squared (in meters) of the loop (used so we can remove the longest loops)
     } prune_loop_t;
+    typedef struct {
+        uint16_t segment;       // segment crossing the cell
+        uint16_t next;          // index of next entry in the same bucket, UINT16_MAX if last
+    } hash_entry_t;
     struct {
         bool complete;
         uint16_t path_points_count;  // copy of _path_points_count taken when the prune algorithm started
         uint16_t path_points_completed; // number of points in that path that have already been checked for loops and should be ignored
-        uint16_t i;     // loop search's outer loop index
-        uint16_t j;     // loop search's inner loop index
+        uint16_t i;     // loop search's outer loop index, the segment from point i-1 to point i is checked against earlier segments
+        uint16_t segments_hashed;   // number of segments added to the spatial hash, all segments are added before the search starts
         prune_loop_t* loops;// the result of the pruning algorithm
         uint16_t loops_max; // maximum number of elements in the _prunable_loops array
         uint16_t loops_count;   // number of elements in the _prunable_loops array
+
+        // spatial hash of the segments, so only segments passing near segment i are checked
+        uint16_t* buckets;  // index of first entry in each bucket, UINT16_MAX if empty
+        uint16_t bucket_mask;   // number of buckets minus one, the number of buckets is a power of two
+        hash_entry_t* entries;  // entries for the cells each segment crosses
+        uint16_t entries_max;   // maximum number of elements in the entries array
+        uint16_t entries_count; // number of elements in the entries array
+        float cell_size_inv;    // inverse of the size of the hash cells in path units
     } _prune;
 
     // returns true if the two loops overlap (used within add_loop to determine which loops to keep or throw away)
@@ -168,6 +168,14 @@ const AP_Param::GroupInfo SoaringController::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("THML_FLAP", 22, SoaringController, soar_thermal_flap, 0),
 
+    // @Param: THML_MEM
+    // @DisplayName: Thermal memory time
+    // @Description: Time for which thermals that have been circled are remembered. On entering a thermal close to a remembered one its estimate is used to start the thermal estimator. Set to 0 to disable.
+    // @Units: s
+    // @Range: 0 3600
+    // @User: Advanced
+    AP_GROUPINFO("THML_MEM", 23, SoaringController, thermal_mem_s, 600),
+
     AP_GROUPEND
 };
 
@@ -268,12 +276,10 @@ void SoaringController::init_thermalling()
 
     const MatrixN<float,4> q{init_q};
 
-    const float init_p[4] = {INITIAL_STRENGTH_COVARIANCE,
-                             INITIAL_RADIUS_COVARIANCE,
-                             INITIAL_POSITION_COVARIANCE,
-                             INITIAL_POSITION_COVARIANCE};
-
-    const MatrixN<float,4> p{init_p};
+    float init_p[4] = {INITIAL_STRENGTH_COVARIANCE,
+                       INITIAL_RADIUS_COVARIANCE,
+                       INITIAL_POSITION_COVARIANCE,
+                       INITIAL_POSITION_COVARIANCE};
 
     Vector3f position;
 
@@ -283,12 +289,27 @@ void SoaringController::init_thermalling()
     }
 
     // New state vector filter will be reset. Thermal location is placed in front of a/c
-    const float init_xr[4] = {_vario.get_trigger_value(),
-                              INITIAL_THERMAL_RADIUS,
-                              position.x + thermal_distance_ahead * cosf(_ahrs.get_yaw_rad()),
-                              position.y + thermal_distance_ahead * sinf(_ahrs.get_yaw_rad())};
+    float init_xr[4] = {_vario.get_trigger_value(),
+                        INITIAL_THERMAL_RADIUS,
+                        position.x + thermal_distance_ahead * cosf(_ahrs.get_yaw_rad()),
+                        position.y + thermal_distance_ahead * sinf(_ahrs.get_yaw_rad())};
+
+    // If we have circled this thermal recently start from what we
+    // learnt about it, with less uncertainty in its size and position
+    const ThermalMap::Thermal *thermal = find_thermal(Vector2f(init_xr[2], init_xr[3]));
+    if (thermal != nullptr) {
+        init_xr[0] = MAX(init_xr[0], thermal->strength);
+        init_xr[1] = thermal->radius;
+        init_xr[2] = thermal->position.x;
+        init_xr[3] = thermal->position.y;
+        init_p[1] *= 0.25;
+        init_p[2] *= 0.25;
+        init_p[3] *= 0.25;
+        GCS_SEND_TEXT(MAV_SEVERITY_INFO, "Soaring: Known thermal, %.1fm/s", (double)thermal->strength);
+    }
 
     const VectorN<float,4> xr{init_xr};
+    const MatrixN<float,4> p{init_p};
 
     // Also reset covariance matrix p so filter is not affected by previous data
     _ekf.reset(xr, p, q, r);
@@ -305,6 +326,23 @@ void SoaringController::init_thermalling()
     _exit_commanded = false;
 }
 
+// remember the thermal being left for next time
+void SoaringController::exit_thermalling()
+{
+    if (thermal_mem_s <= 0 || _ekf.X[1] <= 0) {
+        return;
+    }
+    _thermal_map.add(Vector2f(_ekf.X[2], _ekf.X[3]), _ekf.X[0], _ekf.X[1], AP_HAL::millis());
+}
+
+const ThermalMap::Thermal *SoaringController::find_thermal(const Vector2f &position) const
+{
+    if (thermal_mem_s <= 0) {
+        return nullptr;
+    }
+    return _thermal_map.find_nearest(position, thermal_mem_s * 1000U, AP_HAL::millis());
+}
+
 void SoaringController::init_cruising()
 {
     if (_last_update_status >= ActiveStatus::MANUAL_MODE_CHANGE) {
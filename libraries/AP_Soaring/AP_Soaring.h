@@ -17,6 +17,7 @@
 #include "ExtendedKalmanFilter.h"
 #include "Variometer.h"
 #include "SpeedToFly.h"
+#include "ThermalMap.h"
 
 static constexpr float INITIAL_THERMAL_RADIUS = 80.0;
 static constexpr float INITIAL_STRENGTH_COVARIANCE = 0.0049;
@@ -30,6 +31,7 @@ class SoaringController {
     class AP_TECS &_tecs;
     Variometer _vario;
     SpeedToFly _speedToFly;
+    ThermalMap _thermal_map;
 
     const AP_FixedWing &_aparm;
 
@@ -79,6 +81,7 @@ protected:
     AP_Float soar_thermal_airspeed;
     AP_Float soar_cruise_airspeed;
     AP_Float soar_thermal_flap;
+    AP_Int16 thermal_mem_s;
 
 public:
     SoaringController(class AP_TECS &tecs, const AP_FixedWing &parms);
@@ -109,6 +112,7 @@ public:
     bool check_thermal_criteria();
     LoiterStatus check_cruise_criteria(Vector2f prev_wp, Vector2f next_wp);
     void init_thermalling();
+    void exit_thermalling();
     void init_cruising();
     void update_thermalling();
     void update_cruising();
@@ -149,6 +153,9 @@ public:
         return soar_thermal_flap;
     }
 
+    // nearest remembered thermal to a position relative to home, or nullptr
+    const ThermalMap::Thermal *find_thermal(const Vector2f &position) const;
+
 private:
 
     ActiveStatus _last_update_status;
@@ -0,0 +1,111 @@
+/* ThermalMap class
+
+Remembers recently circled thermals so that a thermal can be found
+again, and its estimate reused, without starting from scratch.
+*/
+#include "ThermalMap.h"
+
+ThermalMap::ThermalMap()
+{
+    clear();
+}
+
+void ThermalMap::clear()
+{
+    for (uint8_t i=0; i<HASH_SIZE; i++) {
+        _head[i] = -1;
+    }
+    for (uint8_t i=0; i<MAX_THERMALS; i++) {
+        _used[i] = false;
+        _next[i] = -1;
+    }
+}
+
+void ThermalMap::link(uint8_t i)
+{
+    const uint8_t b = hash(cell(_thermals[i].position.x), cell(_thermals[i].position.y));
+    _bucket[i] = b;
+    _next[i] = _head[b];
+    _head[b] = i;
+}
+
+void ThermalMap::unlink(uint8_t i)
+{
+    int8_t *p = &_head[_bucket[i]];
+    while (*p != -1) {
+        if (*p == i) {
+            *p = _next[i];
+            break;
+        }
+        p = &_next[*p];
+    }
+    _next[i] = -1;
+}
+
+int8_t ThermalMap::find_nearest_index(const Vector2f &position, uint32_t max_age_ms, uint32_t now_ms) const
+{
+    const int32_t cx = cell(position.x);
+    const int32_t cy = cell(position.y);
+    int8_t best = -1;
+    float best_dist_sq = sq(MATCH_RADIUS);
+    uint16_t seen_buckets = 0;
+
+    for (int8_t dx=-1; dx<=1; dx++) {
+        for (int8_t dy=-1; dy<=1; dy++) {
+            const uint8_t b = hash(cx+dx, cy+dy);
+            if (seen_buckets & (1U<<b)) {
+                // cells can share a bucket
+                continue;
+            }
+            seen_buckets |= 1U<<b;
+            for (int8_t i=_head[b]; i != -1; i=_next[i]) {
+                if (now_ms - _thermals[i].seen_ms > max_age_ms) {
+                    continue;
+                }
+                const float dist_sq = (_thermals[i].position - position).length_squared();
+                if (dist_sq < best_dist_sq) {
+                    best_dist_sq = dist_sq;
+                    best = i;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+const ThermalMap::Thermal *ThermalMap::find_nearest(const Vector2f &position, uint32_t max_age_ms, uint32_t now_ms) const
+{
+    const int8_t i = find_nearest_index(position, max_age_ms, now_ms);
+    return i == -1 ? nullptr : &_thermals[i];
+}
+
+void ThermalMap::add(const Vector2f &position, float strength, float radius, uint32_t now_ms)
+{
+    // replace a thermal we already know of, else a free slot, else
+    // the one seen longest ago
+    int8_t i = find_nearest_index(position, UINT32_MAX, now_ms);
+    if (i == -1) {
+        uint32_t oldest_age_ms = 0;
+        for (uint8_t j=0; j<MAX_THERMALS; j++) {
+            if (!_used[j]) {
+                i = j;
+                break;
+            }
+            const uint32_t age_ms = now_ms - _thermals[j].seen_ms;
+            if (i == -1 || age_ms > oldest_age_ms) {
+                oldest_age_ms = age_ms;
+                i = j;
+            }
+        }
+    }
+
+    if (_used[i]) {
+        unlink(i);
+    }
+    _thermals[i].position = position;
+    _thermals[i].strength = strength;
+    _thermals[i].radius = radius;
+    _thermals[i].seen_ms = now_ms;
+    _used[i] = true;
+    link(i);
+}
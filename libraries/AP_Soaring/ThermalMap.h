@@ -0,0 +1,56 @@
+/* ThermalMap class
+
+Remembers recently circled thermals so that a thermal can be found
+again, and its estimate reused, without starting from scratch.
+*/
+#pragma once
+
+#include <AP_Math/AP_Math.h>
+
+class ThermalMap {
+public:
+    ThermalMap();
+
+    struct Thermal {
+        Vector2f position;      // m north and east of home
+        float strength;         // m/s
+        float radius;           // m
+        uint32_t seen_ms;       // last time it was circled
+    };
+
+    // radius within which thermals are matched
+    static constexpr float MATCH_RADIUS = 200.0f;
+
+    // store a thermal estimate, replacing any stored within
+    // MATCH_RADIUS of it
+    void add(const Vector2f &position, float strength, float radius, uint32_t now_ms);
+
+    // return the nearest thermal within MATCH_RADIUS of position that
+    // was seen within max_age_ms, or nullptr
+    const Thermal *find_nearest(const Vector2f &position, uint32_t max_age_ms, uint32_t now_ms) const;
+
+    void clear();
+
+private:
+    static constexpr uint8_t MAX_THERMALS = 8;
+
+    // thermals are hashed into square cells of this size, so a match
+    // is always within the 3x3 cells around a position
+    static constexpr float CELL_SIZE = MATCH_RADIUS;
+    static constexpr uint8_t HASH_SIZE = 16;
+
+    Thermal _thermals[MAX_THERMALS];
+    bool _used[MAX_THERMALS];
+
+    // chains of thermals in each hash bucket, -1 terminated
+    int8_t _head[HASH_SIZE];
+    int8_t _next[MAX_THERMALS];
+    uint8_t _bucket[MAX_THERMALS];
+
+    static int32_t cell(float pos) { return (int32_t)floorf(pos / CELL_SIZE); }
+    static uint8_t hash(int32_t cx, int32_t cy) { return ((uint32_t(cx) * 73856093U) ^ (uint32_t(cy) * 19349663U)) % HASH_SIZE; }
+
+    int8_t find_nearest_index(const Vector2f &position, uint32_t max_age_ms, uint32_t now_ms) const;
+    void link(uint8_t i);
+    void unlink(uint8_t i);
+};
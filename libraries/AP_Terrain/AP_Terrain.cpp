@@ -19,6 +19,7 @@
 
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Common/AP_Common.h>
+#include <AP_Common/AP_InitArena.h>
 #include <AP_Math/AP_Math.h>
 #include <GCS_MAVLink/GCS_MAVLink.h>
 #include <GCS_MAVLink/GCS.h>
@@ -58,7 +59,7 @@ const AP_Param::GroupInfo AP_Terrain::var_info[] = {
     // @Param: OPTIONS
     // @DisplayName: Terrain options
     // @Description: Options to change behaviour of terrain system
-    // @Bitmask: 0:Disable Download
+    // @Bitmask: 0:Disable Download, 1:Use compact terrain tiles (Linux and SITL only)
     // @User: Advanced
     AP_GROUPINFO("OPTIONS",   2, AP_Terrain, options, 0),
 
@@ -80,8 +81,8 @@ const AP_Param::GroupInfo AP_Terrain::var_info[] = {
 
     // @Param: CACHE_SZ
     // @DisplayName: Terrain cache size
-    // @Description: The number of 32x28 cache blocks to keep in memory. Each block uses about 1800 bytes of memory
-    // @Range: 0 128
+    // @Description: The number of 32x28 cache blocks to keep in memory. Each block uses about 1800 bytes of memory. If there is not enough memory a smaller cache is used. Blocks beyond the 9 around the vehicle are used to load terrain ahead of the vehicle, so larger caches help fast terrain following aircraft
+    // @Range: 4 128
     // @User: Advanced
     AP_GROUPINFO("CACHE_SZ",  5, AP_Terrain, config_cache_size, TERRAIN_GRID_BLOCK_CACHE_SIZE),
 
@@ -130,6 +131,39 @@ bool AP_Terrain::height_amsl(const Location &loc, float &height, bool corrected)
         return true;
     }
 
+#if AP_TERRAIN_TILES_ENABLED
+    if (!tile_height_amsl(loc, height) &&
+        !height_from_cache(loc, height)) {
+        return false;
+    }
+#else
+    if (!height_from_cache(loc, height)) {
+        return false;
+    }
+#endif
+
+    if (loc.lat == ahrs.get_home().lat &&
+        loc.lng == ahrs.get_home().lng) {
+        // remember home altitude as a special case
+        home_height = height;
+        home_loc = loc;
+        have_home_height = true;
+    }
+
+    if (corrected && have_reference_offset) {
+        height += reference_offset;
+    }
+    
+    return true;
+}
+
+
+/*
+  get height at a location from the grid cache, using bilinear
+  interpolation between the four surrounding grid points
+ */
+bool AP_Terrain::height_from_cache(const Location &loc, float &height)
+{
     struct grid_info info;
 
     calculate_grid_info(loc, info);
@@ -168,22 +202,9 @@ bool AP_Terrain::height_amsl(const Location &loc, float &height, bool corrected)
 
     height = avg;
 
-    if (loc.lat == ahrs.get_home().lat &&
-        loc.lng == ahrs.get_home().lng) {
-        // remember home altitude as a special case
-        home_height = height;
-        home_loc = loc;
-        have_home_height = true;
-    }
-
-    if (corrected && have_reference_offset) {
-        height += reference_offset;
-    }
-    
     return true;
 }
 
-
 /* 
    find difference between home terrain height and the terrain
    height at the current location in meters. A positive result
@@ -390,6 +411,7 @@ void AP_Terrain::update(void)
     // update tiles surrounding our current location:
     if (pos_valid) {
         have_surrounding_tiles = update_surrounding_tiles(loc);
+        prefetch_ahead(loc);
     } else {
         have_surrounding_tiles = false;
     }
@@ -428,6 +450,38 @@ bool AP_Terrain::update_surrounding_tiles(const Location &loc)
     return ret;
 }
 
+/*
+  load grid_blocks ahead of the vehicle along its velocity vector so
+  they have been read from disk (or requested from the GCS) before
+  the vehicle gets there. Only the cache blocks not needed for the
+  squares surrounding the vehicle are used
+ */
+void AP_Terrain::prefetch_ahead(const Location &loc)
+{
+    const uint8_t spare_blocks = cache_size > 10 ? (cache_size - 10) / 2 : 0;
+    const uint8_t num_blocks = MIN(spare_blocks, TERRAIN_PREFETCH_BLOCKS_MAX);
+    if (num_blocks == 0) {
+        return;
+    }
+
+    const Vector2f groundspeed = AP::ahrs().groundspeed_vector();
+    const float speed = groundspeed.length();
+    const float block_dist = MIN(TERRAIN_GRID_BLOCK_SIZE_X, TERRAIN_GRID_BLOCK_SIZE_Y) * 0.7f * grid_spacing;
+    if (speed * 10 < block_dist || !is_positive(block_dist)) {
+        // vehicle won't leave the surrounding squares in the next 10 seconds
+        return;
+    }
+
+    // start beyond the surrounding squares, one block apart
+    const Vector2f step = groundspeed * (block_dist / speed);
+    for (uint8_t i=0; i<num_blocks; i++) {
+        Location loc2 = loc;
+        loc2.offset(step.x * (i + 2), step.y * (i + 2));
+        float height;
+        height_amsl(loc2, height);
+    }
+}
+
 bool AP_Terrain::pre_arm_checks(char *failure_msg, uint8_t failure_msg_len) const
 {
     // check no outstanding requests for data:
@@ -480,6 +534,8 @@ void AP_Terrain::log_terrain_data()
         pending        : pending,
         loaded         : loaded,
         reference_offset : have_reference_offset?reference_offset:0,
+        cache_hits     : cache_hits,
+        cache_misses   : cache_misses,
     };
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
 }
@@ -497,13 +553,30 @@ bool AP_Terrain::allocate(void)
     if (cache != nullptr) {
         return true;
     }
-    cache = (struct grid_cache *)calloc(config_cache_size, sizeof(cache[0]));
+    // if the configured cache doesn't fit in memory fall back to smaller caches
+    const uint8_t config_size = constrain_int16(config_cache_size, TERRAIN_GRID_BLOCK_CACHE_SIZE_MIN, UINT8_MAX);
+    uint8_t size = config_size;
+    while (true) {
+        // the cache is never freed
+#if AP_INIT_ARENA_ENABLED
+        cache = (struct grid_cache *)AP::init_arena().allocate(size * sizeof(cache[0]), "Terrain");
+#else
+        cache = (struct grid_cache *)calloc(size, sizeof(cache[0]));
+#endif
+        if (cache != nullptr || size <= TERRAIN_GRID_BLOCK_CACHE_SIZE_MIN) {
+            break;
+        }
+        size = MAX(size * 3 / 4, TERRAIN_GRID_BLOCK_CACHE_SIZE_MIN);
+    }
     if (cache == nullptr) {
         GCS_SEND_TEXT(MAV_SEVERITY_CRITICAL, "Terrain: Allocation failed");
         memory_alloc_failed = true;
         return false;
     }
-    cache_size = config_cache_size;
+    if (size < config_size) {
+        GCS_SEND_TEXT(MAV_SEVERITY_WARNING, "Terrain: cache reduced to %u blocks", (unsigned)size);
+    }
+    cache_size = size;
     return true;
 }
 
@@ -50,9 +50,30 @@
 #define TERRAIN_GRID_BLOCK_CACHE_SIZE 12
 #endif
 
+// smallest cache we will fall back to if the configured cache can't be allocated
+#define TERRAIN_GRID_BLOCK_CACHE_SIZE_MIN 4
+
+// maximum number of grid_blocks loaded ahead of the vehicle along its velocity vector
+#ifndef TERRAIN_PREFETCH_BLOCKS_MAX
+#define TERRAIN_PREFETCH_BLOCKS_MAX 4
+#endif
+
 // format of grid on disk
 #define TERRAIN_GRID_FORMAT_VERSION 1
 
+// number of degree tiles of compact terrain data mapped at once
+#define TERRAIN_TILES_MAX 4
+
+// format of compact terrain tiles
+#define TERRAIN_TILE_MAGIC 0x43545041 // "APTC"
+#define TERRAIN_TILE_FORMAT_VERSION 1
+
+// maximum number of blocks read or written in one batch of disk IO.
+// Each costs 2k of memory, so boards with less flash do one at a time
+#ifndef TERRAIN_DISK_IO_BATCH
+#define TERRAIN_DISK_IO_BATCH (HAL_PROGRAM_SIZE_LIMIT_KB > 1024 ? 4 : 1)
+#endif
+
 // we allow for a 2cm discrepancy in the grid corners. This is to
 // account for different rounding in terrain DAT file generators using
 // different programming languages
@@ -187,6 +208,15 @@ public:
      */
     void get_statistics(uint16_t &pending, uint16_t &loaded) const;
 
+    /*
+      get number of grid_block cache lookups which found the block
+      in memory (hits) and which had to load it (misses)
+     */
+    void get_cache_statistics(uint32_t &hits, uint32_t &misses) const {
+        hits = cache_hits;
+        misses = cache_misses;
+    }
+
     /*
       get grid spacing in meters
      */
@@ -265,10 +295,57 @@ private:
 
         volatile enum GridCacheState state;
 
-        // the last time access was requested to this block, used for LRU
-        uint32_t last_access_ms;
+        // value of access_counter when access was last requested to this block, used for LRU
+        uint32_t last_access;
+    };
+
+#if AP_TERRAIN_TILES_ENABLED
+    /*
+      a tile file holds heights over a whole degree of latitude and
+      longitude as a single regular grid, for boards which can map the
+      file into memory and read heights directly from it. The header
+      is followed by num_x rows of num_y heights, each a delta from
+      base in units of scale_mm. Grid point x,y is x*spacing meters
+      north and y*spacing meters east of the SW corner of the degree.
+      These files are created by Tools/terrain-tools/create_terrain_tiles.py
+     */
+    struct PACKED tile_header {
+        uint32_t magic;         // TERRAIN_TILE_MAGIC
+        uint16_t version;       // TERRAIN_TILE_FORMAT_VERSION
+        uint16_t spacing;       // meters between grid points
+        int16_t lat_degrees;    // SW corner of the tile
+        int16_t lon_degrees;
+        uint16_t num_x;         // number of grid points north
+        uint16_t num_y;         // number of grid points east
+        int16_t base;           // height in meters of a zero delta
+        uint16_t scale_mm;      // millimeters per unit of delta
+        uint32_t crc;           // CRC32 of the heights
+    };
+
+    // heights with this value have no data
+    static const int16_t TILE_NO_DATA = INT16_MIN;
+
+    enum class TileState : uint8_t {
+        Empty,      // not in use
+        Requested,  // waiting for the IO thread to map the tile
+        Ready,      // tile is mapped
+        Missing,    // no valid tile file for these degrees
     };
 
+    /*
+      a degree tile mapped into memory. The IO thread owns the slot
+      while it is Requested, the main thread otherwise
+     */
+    struct tile_slot {
+        volatile TileState state;
+        int8_t lat_degrees;
+        int16_t lon_degrees;
+        uint32_t last_access;
+        const struct tile_header *header;
+        size_t length;
+    };
+#endif
+
     /*
       grid_info is a broken down representation of a Location, giving
       the index terms for finding the right grid
@@ -339,20 +416,23 @@ private:
     /*
       disk IO functions
      */
-    int16_t find_io_idx(enum GridCacheState state);
+    int16_t find_io_idx(const struct grid_block &block, enum GridCacheState state);
     uint16_t get_block_crc(struct grid_block &block);
-    void check_disk_read(void);
-    void check_disk_write(void);
+    bool check_disk_io(enum GridCacheState state);
     void io_timer(void);
     void open_file(void);
-    void seek_offset(void);
-    uint32_t east_blocks(struct grid_block &block) const;
-    void write_block(void);
-    void read_block(void);
+    bool seek_offset(uint32_t file_offset);
+    uint32_t east_blocks(const struct grid_block &block) const;
+    uint32_t block_file_offset(const struct grid_block &block) const;
+    void write_blocks(void);
+    void read_blocks(void);
 
     // check for missing data in squares surrounding loc:
     bool update_surrounding_tiles(const Location &loc);
 
+    // load grid_blocks ahead of loc along the vehicle's velocity vector
+    void prefetch_ahead(const Location &loc);
+
     /*
       check for missing mission terrain data
      */
@@ -368,6 +448,18 @@ private:
      */
     void update_reference_offset(void);
 
+    // get height from the grid cache
+    bool height_from_cache(const Location &loc, float &height);
+
+#if AP_TERRAIN_TILES_ENABLED
+    /*
+      compact terrain tile functions
+     */
+    bool tile_height_amsl(const Location &loc, float &height);
+    void tile_io(void);
+    bool tile_map(struct tile_slot &slot);
+    void tile_unmap(struct tile_slot &slot);
+#endif
 
     // parameters
     AP_Int8  enable;
@@ -379,13 +471,27 @@ private:
 
     enum class Options {
         DisableDownload = (1U<<0),
+        UseTiles        = (1U<<1),
     };
 
+#if AP_TERRAIN_TILES_ENABLED
+    // memory mapped tiles of compact terrain data
+    struct tile_slot tiles[TERRAIN_TILES_MAX];
+#endif
+
     // cache of grids in memory, LRU
     uint8_t cache_size = 0;
     struct grid_cache *cache = nullptr;
 
-    // a grid_cache block waiting for disk IO
+    // incremented on each cache lookup to order accesses for LRU
+    uint32_t access_counter;
+
+    // cache lookup statistics
+    uint32_t cache_hits;
+    uint32_t cache_misses;
+
+    // a batch of grid_cache blocks waiting for disk IO, all in the
+    // same degree file and sorted by file offset
     enum DiskIoState {
         DiskIoIdle      = 0,
         DiskIoWaitWrite = 1,
@@ -394,7 +500,9 @@ private:
         DiskIoDoneWrite = 4
     };
     volatile enum DiskIoState disk_io_state;
-    union grid_io_block disk_block;
+    union grid_io_block disk_block[TERRAIN_DISK_IO_BATCH];
+    uint32_t disk_block_offset[TERRAIN_DISK_IO_BATCH];
+    uint8_t disk_block_count;
 
 #if HAL_GCS_ENABLED
     // last time we asked for more grids
@@ -447,8 +555,13 @@ private:
     // next mission command to check
     uint16_t next_mission_index;
 
-    // next mission position to check
-    uint8_t next_mission_pos;
+    // next mission position to check, positions after the first 5
+    // are along the leg from the previous waypoint
+    uint16_t next_mission_pos;
+
+    // previous waypoint checked, the start of the leg to the next waypoint
+    Location last_mission_loc;
+    bool have_last_mission_loc;
 
     // last time the mission changed
     uint32_t last_mission_change_ms;
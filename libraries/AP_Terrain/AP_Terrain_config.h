@@ -6,3 +6,8 @@
 #ifndef AP_TERRAIN_AVAILABLE
 #define AP_TERRAIN_AVAILABLE AP_FILESYSTEM_FILE_READING_ENABLED
 #endif
+
+// memory mapped tiles of compact terrain data, needs mmap()
+#ifndef AP_TERRAIN_TILES_ENABLED
+#define AP_TERRAIN_TILES_ENABLED (AP_TERRAIN_AVAILABLE && (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX))
+#endif
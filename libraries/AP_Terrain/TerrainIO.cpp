@@ -29,31 +29,48 @@
 extern const AP_HAL::HAL& hal;
 
 /*
-  check for blocks that need to be read from disk
+  gather a batch of blocks in the given state for disk IO. The batch
+  only holds blocks in the same degree file as the first one found,
+  and is sorted by offset in the file so that the IO thread moves
+  through the file in one direction and can combine adjacent blocks
+  into a single read or write. Returns true if any blocks were found
  */
-void AP_Terrain::check_disk_read(void)
+bool AP_Terrain::check_disk_io(enum GridCacheState state)
 {
-    for (uint16_t i=0; i<cache_size; i++) {
-        if (cache[i].state == GRID_CACHE_DISKWAIT) {
-            disk_block.block = cache[i].grid;
-            disk_io_state = DiskIoWaitRead;
-            return;
+    uint16_t idx[TERRAIN_DISK_IO_BATCH];
+    uint32_t offset[TERRAIN_DISK_IO_BATCH];
+    uint8_t count = 0;
+
+    for (uint16_t i=0; i<cache_size && count < TERRAIN_DISK_IO_BATCH; i++) {
+        const struct grid_block &grid = cache[i].grid;
+        if (cache[i].state != state) {
+            continue;
         }
-    }    
-}
-
-/*
-  check for blocks that need to be written to disk
- */
-void AP_Terrain::check_disk_write(void)
-{
-    for (uint16_t i=0; i<cache_size; i++) {
-        if (cache[i].state == GRID_CACHE_DIRTY) {
-            disk_block.block = cache[i].grid;
-            disk_io_state = DiskIoWaitWrite;
-            return;
+        if (count > 0 &&
+            (grid.lat_degrees != cache[idx[0]].grid.lat_degrees ||
+             grid.lon_degrees != cache[idx[0]].grid.lon_degrees)) {
+            // only one file is open at a time
+            continue;
         }
-    }    
+        // insert in order of file offset
+        const uint32_t ofs = block_file_offset(grid);
+        uint8_t j = count;
+        while (j > 0 && offset[j-1] > ofs) {
+            idx[j] = idx[j-1];
+            offset[j] = offset[j-1];
+            j--;
+        }
+        idx[j] = i;
+        offset[j] = ofs;
+        count++;
+    }
+
+    for (uint8_t i=0; i<count; i++) {
+        disk_block[i].block = cache[idx[i]].grid;
+        disk_block_offset[i] = offset[i];
+    }
+    disk_block_count = count;
+    return count > 0;
 }
 
 /*
@@ -72,41 +89,47 @@ void AP_Terrain::schedule_disk_io(void)
 
     switch (disk_io_state) {
     case DiskIoIdle:
-        // look for a block that needs reading or writing
-        check_disk_read();
-        if (disk_io_state == DiskIoIdle) {
-            // still idle, check for writes
-            check_disk_write();            
+        // look for blocks that need reading, then for writes
+        if (check_disk_io(GRID_CACHE_DISKWAIT)) {
+            disk_io_state = DiskIoWaitRead;
+        } else if (check_disk_io(GRID_CACHE_DIRTY)) {
+            disk_io_state = DiskIoWaitWrite;
         }
         break;
         
-    case DiskIoDoneRead: {
-        // a read has completed
-        int16_t cache_idx = find_io_idx(GRID_CACHE_DISKWAIT);
-        if (cache_idx != -1) {
-            if (disk_block.block.bitmap != 0) {
+    case DiskIoDoneRead:
+        // a batch of reads has completed
+        for (uint8_t i=0; i<disk_block_count; i++) {
+            const struct grid_block &block = disk_block[i].block;
+            int16_t cache_idx = find_io_idx(block, GRID_CACHE_DISKWAIT);
+            if (cache_idx == -1) {
+                continue;
+            }
+            if (block.bitmap != 0) {
                 // when bitmap is zero we read an empty block
-                cache[cache_idx].grid = disk_block.block;
+                cache[cache_idx].grid = block;
             }
             cache[cache_idx].state = GRID_CACHE_VALID;
-            cache[cache_idx].last_access_ms = AP_HAL::millis();
+            cache[cache_idx].last_access = ++access_counter;
         }
         disk_io_state = DiskIoIdle;
         break;
-    }
 
-    case DiskIoDoneWrite: {
-        // a write has completed
-        int16_t cache_idx = find_io_idx(GRID_CACHE_DIRTY);
-        if (cache_idx != -1) {
-            if (cache[cache_idx].grid.bitmap == disk_block.block.bitmap) {
+    case DiskIoDoneWrite:
+        // a batch of writes has completed
+        for (uint8_t i=0; i<disk_block_count; i++) {
+            const struct grid_block &block = disk_block[i].block;
+            int16_t cache_idx = find_io_idx(block, GRID_CACHE_DIRTY);
+            if (cache_idx == -1) {
+                continue;
+            }
+            if (cache[cache_idx].grid.bitmap == block.bitmap) {
                 // only mark valid if more grids haven't been added
                 cache[cache_idx].state = GRID_CACHE_VALID;
             }
         }
         disk_io_state = DiskIoIdle;
         break;
-    }
         
     case DiskIoWaitWrite:
     case DiskIoWaitRead:
@@ -135,7 +158,7 @@ All file operations are done by the IO thread.
  */
 void AP_Terrain::open_file(void)
 {
-    struct grid_block &block = disk_block.block;
+    const struct grid_block &block = disk_block[0].block;
     if (fd != -1 && 
         block.lat_degrees == file_lat_degrees &&
         block.lon_degrees == file_lon_degrees) {
@@ -217,7 +240,7 @@ void AP_Terrain::open_file(void)
 /*
   work out how many blocks needed in a stride for a given location
  */
-uint32_t AP_Terrain::east_blocks(struct grid_block &block) const
+uint32_t AP_Terrain::east_blocks(const struct grid_block &block) const
 {
     Location loc1, loc2;
     loc1.lat = block.lat_degrees*10*1000*1000L;
@@ -232,14 +255,20 @@ uint32_t AP_Terrain::east_blocks(struct grid_block &block) const
 }
 
 /*
-  seek to the right offset for disk_block
+  get the offset of a block in its degree file
  */
-void AP_Terrain::seek_offset(void)
+uint32_t AP_Terrain::block_file_offset(const struct grid_block &block) const
 {
-    struct grid_block &block = disk_block.block;
     // work out how many longitude blocks there are at this latitude
     uint32_t blocknum = east_blocks(block) * block.grid_idx_x + block.grid_idx_y;
-    uint32_t file_offset = blocknum * sizeof(union grid_io_block);
+    return blocknum * sizeof(union grid_io_block);
+}
+
+/*
+  seek to an offset in the open file, returns false on failure
+ */
+bool AP_Terrain::seek_offset(uint32_t file_offset)
+{
     if (AP::FS().lseek(fd, file_offset, SEEK_SET) != (off_t)file_offset) {
 #if TERRAIN_DEBUG
         hal.console->printf("Seek %lu failed - %s\n",
@@ -248,88 +277,119 @@ void AP_Terrain::seek_offset(void)
         AP::FS().close(fd);
         fd = -1;
         io_failure = true;
+        return false;
     }
+    return true;
 }
 
 /*
-  write out disk_block
+  return the number of blocks from start in the batch which are
+  adjacent in the file, so can be read or written together
  */
-void AP_Terrain::write_block(void)
+static uint8_t adjacent_blocks(const uint32_t offset[], uint8_t start, uint8_t count, uint32_t block_size)
 {
-    seek_offset();
-    if (io_failure) {
-        return;
+    uint8_t n = 1;
+    while (start+n < count && offset[start+n] == offset[start] + n*block_size) {
+        n++;
     }
+    return n;
+}
 
-    disk_block.block.crc = get_block_crc(disk_block.block);
+/*
+  write out the batch of disk blocks
+ */
+void AP_Terrain::write_blocks(void)
+{
+    for (uint8_t i=0; i<disk_block_count; i++) {
+        disk_block[i].block.crc = get_block_crc(disk_block[i].block);
+    }
 
-    ssize_t ret = AP::FS().write(fd, &disk_block, sizeof(disk_block));
-    if (ret  != sizeof(disk_block)) {
+    for (uint8_t i=0; i<disk_block_count; ) {
+        const uint8_t n = adjacent_blocks(disk_block_offset, i, disk_block_count, sizeof(union grid_io_block));
+        if (!seek_offset(disk_block_offset[i])) {
+            return;
+        }
+        const ssize_t len = n * sizeof(union grid_io_block);
+        ssize_t ret = AP::FS().write(fd, &disk_block[i], len);
+        if (ret != len) {
 #if TERRAIN_DEBUG
-        hal.console->printf("write failed - %s\n", strerror(errno));
+            hal.console->printf("write failed - %s\n", strerror(errno));
 #endif
-        AP::FS().close(fd);
-        fd = -1;
-        io_failure = true;
-    } else {
-        AP::FS().fsync(fd);
+            AP::FS().close(fd);
+            fd = -1;
+            io_failure = true;
+            return;
+        }
 #if TERRAIN_DEBUG
-        printf("wrote block at %ld %ld ret=%d mask=%07llx\n",
-               (long)disk_block.block.lat,
-               (long)disk_block.block.lon,
-               (int)ret,
-               (unsigned long long)disk_block.block.bitmap);
+        printf("wrote %u blocks at %ld %ld ret=%d\n",
+               (unsigned)n,
+               (long)disk_block[i].block.lat,
+               (long)disk_block[i].block.lon,
+               (int)ret);
 #endif
+        i += n;
     }
+    AP::FS().fsync(fd);
     disk_io_state = DiskIoDoneWrite;
 }
 
 /*
-  read in disk_block
+  read in the batch of disk blocks
  */
-void AP_Terrain::read_block(void)
+void AP_Terrain::read_blocks(void)
 {
-    seek_offset();
-    if (io_failure) {
-        return;
-    }
-    int32_t lat = disk_block.block.lat;
-    int32_t lon = disk_block.block.lon;
-
-    ssize_t ret = AP::FS().read(fd, &disk_block, sizeof(disk_block));
-    if (ret != sizeof(disk_block) || 
-        !TERRAIN_LATLON_EQUAL(disk_block.block.lat,lat) ||
-        !TERRAIN_LATLON_EQUAL(disk_block.block.lon,lon) ||
-        disk_block.block.bitmap == 0 ||
-        disk_block.block.spacing != grid_spacing ||
-        disk_block.block.version != TERRAIN_GRID_FORMAT_VERSION ||
-        disk_block.block.crc != get_block_crc(disk_block.block)) {
+    for (uint8_t i=0; i<disk_block_count; ) {
+        const uint8_t n = adjacent_blocks(disk_block_offset, i, disk_block_count, sizeof(union grid_io_block));
+        if (!seek_offset(disk_block_offset[i])) {
+            return;
+        }
+        int32_t lat[TERRAIN_DISK_IO_BATCH];
+        int32_t lon[TERRAIN_DISK_IO_BATCH];
+        for (uint8_t k=0; k<n; k++) {
+            lat[k] = disk_block[i+k].block.lat;
+            lon[k] = disk_block[i+k].block.lon;
+        }
+
+        ssize_t ret = AP::FS().read(fd, &disk_block[i], n * sizeof(union grid_io_block));
+
+        for (uint8_t k=0; k<n; k++) {
+            struct grid_block &block = disk_block[i+k].block;
+            if (ret < (ssize_t)((k+1) * sizeof(union grid_io_block)) ||
+                !TERRAIN_LATLON_EQUAL(block.lat,lat[k]) ||
+                !TERRAIN_LATLON_EQUAL(block.lon,lon[k]) ||
+                block.bitmap == 0 ||
+                block.spacing != grid_spacing ||
+                block.version != TERRAIN_GRID_FORMAT_VERSION ||
+                block.crc != get_block_crc(block)) {
 #if TERRAIN_DEBUG
-        printf("read empty block at %ld %ld ret=%d (%ld %ld %u 0x%08lx) 0x%04x:0x%04x\n",
-               (long)lat,
-               (long)lon,
-               (int)ret,
-               (long)disk_block.block.lat,
-               (long)disk_block.block.lon,
-               (unsigned)disk_block.block.spacing,
-               (unsigned long)disk_block.block.bitmap,
-               (unsigned)disk_block.block.crc,
-               (unsigned)get_block_crc(disk_block.block));
+                printf("read empty block at %ld %ld ret=%d (%ld %ld %u 0x%08lx) 0x%04x:0x%04x\n",
+                       (long)lat[k],
+                       (long)lon[k],
+                       (int)ret,
+                       (long)block.lat,
+                       (long)block.lon,
+                       (unsigned)block.spacing,
+                       (unsigned long)block.bitmap,
+                       (unsigned)block.crc,
+                       (unsigned)get_block_crc(block));
 #endif
-        // a short read or bad data is not an IO failure, just a
-        // missing block on disk
-        memset(&disk_block, 0, sizeof(disk_block));
-        disk_block.block.lat = lat;
-        disk_block.block.lon = lon;
-        disk_block.block.bitmap = 0;
-    } else {
+                // a short read or bad data is not an IO failure, just a
+                // missing block on disk
+                memset(&disk_block[i+k], 0, sizeof(disk_block[i+k]));
+                block.lat = lat[k];
+                block.lon = lon[k];
+                block.bitmap = 0;
+            } else {
 #if TERRAIN_DEBUG
-        printf("read block at %ld %ld ret=%d mask=%07llx\n",
-               (long)lat,
-               (long)lon,
-               (int)ret,
-               (unsigned long long)disk_block.block.bitmap);
+                printf("read block at %ld %ld ret=%d mask=%07llx\n",
+                       (long)lat[k],
+                       (long)lon[k],
+                       (int)ret,
+                       (unsigned long long)block.bitmap);
 #endif
+            }
+        }
+        i += n;
     }
     disk_io_state = DiskIoDoneRead;
 }
@@ -339,6 +399,12 @@ void AP_Terrain::read_block(void)
  */
 void AP_Terrain::io_timer(void)
 {
+#if AP_TERRAIN_TILES_ENABLED
+    // tiles are mapped outside AP_Filesystem so are not affected by
+    // IO failures on the SD card
+    tile_io();
+#endif
+
     if (io_failure) {
         // retry the IO every 5s to allow for remount of sdcard
         uint32_t now = AP_HAL::millis();
@@ -359,21 +425,21 @@ void AP_Terrain::io_timer(void)
         break;
         
     case DiskIoWaitWrite:
-        // need to write out the block
+        // need to write out the blocks
         open_file();
         if (fd == -1) {
             return;
         }
-        write_block();
+        write_blocks();
         break;
 
     case DiskIoWaitRead:
-        // need to read in the block
+        // need to read in the blocks
         open_file();
         if (fd == -1) {
             return;
         }
-        read_block();
+        read_blocks();
         break;
     }
 }
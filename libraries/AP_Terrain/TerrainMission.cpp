@@ -45,6 +45,7 @@ void AP_Terrain::update_mission_data(void)
         // the mission has changed - start again
         next_mission_index = 1;
         next_mission_pos = 0;
+        have_last_mission_loc = false;
         last_mission_change_ms = mission->last_change_time_ms();
         last_mission_spacing = grid_spacing;
     }
@@ -87,29 +88,47 @@ void AP_Terrain::update_mission_data(void)
 
         // we will fetch 5 points around the waypoint. Four at 10 grid
         // spacings away at 45, 135, 225 and 315 degrees, and the
-        // point itself
-        if (next_mission_pos != 4) {
-            cmd.content.location.offset_bearing(45+90*next_mission_pos, grid_spacing.get() * 10);
-        }
-
-        // we have a mission command to check
-        float height;
-        if (!height_amsl(cmd.content.location, height)) {
-            // if we can't get data for a mission item then return and
-            // check again next time
-            return;
+        // point itself. Then points along the leg from the previous
+        // waypoint, close enough together that a fast vehicle doesn't
+        // fly into squares that have never been loaded
+        const Location wp_loc = cmd.content.location;
+        Location loc = wp_loc;
+        bool waypoint_done = false;
+        if (next_mission_pos < 4) {
+            loc.offset_bearing(45+90*next_mission_pos, grid_spacing.get() * 10);
+        } else if (next_mission_pos > 4) {
+            const float leg_step = MIN(TERRAIN_GRID_BLOCK_SIZE_X, TERRAIN_GRID_BLOCK_SIZE_Y) * 0.7f * grid_spacing;
+            const float leg_dist = (next_mission_pos - 4) * leg_step;
+            if (!have_last_mission_loc || !is_positive(leg_step) ||
+                leg_dist >= last_mission_loc.get_distance(wp_loc)) {
+                waypoint_done = true;
+            } else {
+                loc = last_mission_loc;
+                loc.offset_bearing(last_mission_loc.get_bearing_to(wp_loc) * 0.01f, leg_dist);
+            }
         }
 
-        next_mission_pos++;
-        if (next_mission_pos == 5) {
+        if (waypoint_done) {
 #if TERRAIN_DEBUG
             hal.console->printf("checked waypoint %u\n", (unsigned)next_mission_index);
 #endif
 
             // move to next waypoint
+            last_mission_loc = wp_loc;
+            have_last_mission_loc = true;
             next_mission_index++;
             next_mission_pos = 0;
+            continue;
         }
+
+        // we have a mission command to check
+        float height;
+        if (!height_amsl(loc, height)) {
+            // if we can't get data for a mission item then return and
+            // check again next time
+            return;
+        }
+        next_mission_pos++;
     }
 #endif  // AP_MISSION_ENABLED
 }
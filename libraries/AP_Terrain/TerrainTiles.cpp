@@ -0,0 +1,231 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  memory mapped tiles of compact terrain data for Linux and SITL
+ */
+
+#include "AP_Terrain.h"
+
+#if AP_TERRAIN_TILES_ENABLED
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Common/AP_Common.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern const AP_HAL::HAL& hal;
+
+/*
+  get height at a location from a memory mapped tile. If the tile is
+  not mapped yet ask the IO thread to map it and return false, so the
+  caller falls back to the grid cache in the meantime
+ */
+bool AP_Terrain::tile_height_amsl(const Location &loc, float &height)
+{
+    if (!(options.get() & uint16_t(Options::UseTiles))) {
+        return false;
+    }
+
+    // tiles start on integer degrees, the same as the grid blocks
+    const int8_t lat_degrees = (loc.lat<0?(loc.lat-9999999L):loc.lat) / (10*1000*1000L);
+    const int16_t lon_degrees = (loc.lng<0?(loc.lng-9999999L):loc.lng) / (10*1000*1000L);
+
+    // find the tile, or the slot to map it into. Unused slots are
+    // replaced first, then missing tiles, then the least recently used
+    struct tile_slot *slot = nullptr;
+    struct tile_slot *oldest = nullptr;
+    for (struct tile_slot &t : tiles) {
+        if (t.state != TileState::Empty &&
+            t.lat_degrees == lat_degrees &&
+            t.lon_degrees == lon_degrees) {
+            slot = &t;
+            break;
+        }
+        if (t.state == TileState::Requested) {
+            // owned by the IO thread
+            continue;
+        }
+        if (oldest == nullptr ||
+            t.state < oldest->state ||
+            (t.state == TileState::Ready && oldest->state == TileState::Ready &&
+             t.last_access < oldest->last_access)) {
+            oldest = &t;
+        }
+    }
+
+    if (slot == nullptr) {
+        if (oldest != nullptr) {
+            oldest->lat_degrees = lat_degrees;
+            oldest->lon_degrees = lon_degrees;
+            oldest->state = TileState::Requested;
+        }
+        return false;
+    }
+    if (slot->state != TileState::Ready) {
+        return false;
+    }
+    slot->last_access = ++access_counter;
+
+    const struct tile_header &hdr = *slot->header;
+
+    // find offset from the SW corner of the tile
+    Location ref;
+    ref.lat = lat_degrees*10*1000*1000L;
+    ref.lng = lon_degrees*10*1000*1000L;
+    const Vector2f offset = ref.get_distance_NE(loc);
+    if (offset.x < 0 || offset.y < 0) {
+        return false;
+    }
+
+    // get indices in terms of grid spacing elements
+    const float grid_x = offset.x / hdr.spacing;
+    const float grid_y = offset.y / hdr.spacing;
+    const uint32_t idx_x = grid_x;
+    const uint32_t idx_y = grid_y;
+    if (idx_x+1 >= hdr.num_x || idx_y+1 >= hdr.num_y) {
+        return false;
+    }
+
+    // hXY are the heights of the 4 surrounding grid points
+    const int16_t *row0 = reinterpret_cast<const int16_t *>(slot->header + 1) + idx_x * hdr.num_y + idx_y;
+    const int16_t *row1 = row0 + hdr.num_y;
+    const int16_t h00 = row0[0];
+    const int16_t h01 = row0[1];
+    const int16_t h10 = row1[0];
+    const int16_t h11 = row1[1];
+    if (h00 == TILE_NO_DATA || h01 == TILE_NO_DATA ||
+        h10 == TILE_NO_DATA || h11 == TILE_NO_DATA) {
+        return false;
+    }
+
+    // dual linear interpolation as for the grid cache
+    const float frac_x = grid_x - idx_x;
+    const float frac_y = grid_y - idx_y;
+    const float avg1 = (1.0f-frac_x) * h00  + frac_x * h10;
+    const float avg2 = (1.0f-frac_x) * h01  + frac_x * h11;
+    const float avg  = (1.0f-frac_y) * avg1 + frac_y * avg2;
+
+    height = hdr.base + avg * hdr.scale_mm * 0.001f;
+
+    return true;
+}
+
+/********************************************************
+All the functions below this point run in the IO timer context. The
+IO thread owns a tile slot while its state is Requested.
+*********************************************************/
+
+/*
+  map or unmap tiles as requested by the main thread
+ */
+void AP_Terrain::tile_io(void)
+{
+    for (struct tile_slot &slot : tiles) {
+        if (slot.state != TileState::Requested) {
+            continue;
+        }
+        tile_unmap(slot);
+        slot.state = tile_map(slot) ? TileState::Ready : TileState::Missing;
+    }
+}
+
+/*
+  map the tile file for the slot's degrees into memory and check it,
+  returns false if there is no valid tile file
+ */
+bool AP_Terrain::tile_map(struct tile_slot &slot)
+{
+    const char* terrain_dir = hal.util->get_custom_terrain_directory();
+    if (terrain_dir == nullptr) {
+        terrain_dir = HAL_BOARD_TERRAIN_DIRECTORY;
+    }
+    char path[128];
+    const int len = hal.util->snprintf(path, sizeof(path), "%s/%c%02u%c%03u.DTC",
+                                       terrain_dir,
+                                       slot.lat_degrees<0?'S':'N',
+                                       (unsigned)MIN(abs(slot.lat_degrees), 99),
+                                       slot.lon_degrees<0?'W':'E',
+                                       (unsigned)MIN(abs(slot.lon_degrees), 999));
+    if (len <= 0 || size_t(len) >= sizeof(path)) {
+        return false;
+    }
+
+    const int tile_fd = ::open(path, O_RDONLY|O_CLOEXEC);
+    if (tile_fd == -1) {
+        return false;
+    }
+
+    // populate the mapping now so lookups from the main thread never
+    // wait for the disk
+#ifdef MAP_POPULATE
+    const int flags = MAP_PRIVATE | MAP_POPULATE;
+#else
+    const int flags = MAP_PRIVATE;
+#endif
+    struct stat st;
+    void *p = MAP_FAILED;
+    if (::fstat(tile_fd, &st) == 0 && size_t(st.st_size) >= sizeof(struct tile_header)) {
+        p = ::mmap(nullptr, st.st_size, PROT_READ, flags, tile_fd, 0);
+    }
+    ::close(tile_fd);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    slot.header = (const struct tile_header *)p;
+    slot.length = st.st_size;
+
+    const struct tile_header &hdr = *slot.header;
+    const size_t heights_len = size_t(hdr.num_x) * hdr.num_y * sizeof(int16_t);
+    if (hdr.magic != TERRAIN_TILE_MAGIC ||
+        hdr.version != TERRAIN_TILE_FORMAT_VERSION ||
+        hdr.lat_degrees != slot.lat_degrees ||
+        hdr.lon_degrees != slot.lon_degrees ||
+        hdr.spacing == 0 ||
+        hdr.num_x < 2 ||
+        hdr.num_y < 2 ||
+        sizeof(struct tile_header) + heights_len > slot.length ||
+        (crc_crc32(0xFFFFFFFF, (const uint8_t *)(slot.header + 1), heights_len) ^ 0xFFFFFFFF) != hdr.crc) {
+#if TERRAIN_DEBUG
+        printf("bad terrain tile %s\n", path);
+#endif
+        tile_unmap(slot);
+        return false;
+    }
+
+#if TERRAIN_DEBUG
+    printf("mapped terrain tile %s %ux%u spacing=%u\n", path,
+           (unsigned)hdr.num_x, (unsigned)hdr.num_y, (unsigned)hdr.spacing);
+#endif
+    return true;
+}
+
+/*
+  unmap the tile held by a slot
+ */
+void AP_Terrain::tile_unmap(struct tile_slot &slot)
+{
+    if (slot.header != nullptr) {
+        ::munmap((void *)slot.header, slot.length);
+        slot.header = nullptr;
+        slot.length = 0;
+    }
+}
+
+#endif // AP_TERRAIN_TILES_ENABLED
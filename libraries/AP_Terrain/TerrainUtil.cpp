@@ -106,21 +106,37 @@ void AP_Terrain::calculate_grid_info(const Location &loc, struct grid_info &info
  */
 AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info)
 {
-    uint16_t oldest_i = 0;
+    int16_t oldest_i = -1;
+    uint8_t oldest_rank = UINT8_MAX;
+
+    // blocks with changes waiting to be written to disk are only
+    // replaced if nothing else can be, unless they will never be written
+    const bool keep_dirty = !io_failure;
 
     // see if we have that grid
-    const auto now_ms = AP_HAL::millis();
+    const uint32_t access = ++access_counter;
     for (uint16_t i=0; i<cache_size; i++) {
         if (TERRAIN_LATLON_EQUAL(cache[i].grid.lat,info.grid_lat) &&
             TERRAIN_LATLON_EQUAL(cache[i].grid.lon,info.grid_lon) &&
             cache[i].grid.spacing == grid_spacing) {
-            cache[i].last_access_ms = now_ms;
+            cache[i].last_access = access;
+            cache_hits++;
             return cache[i];
         }
-        if (cache[i].last_access_ms < cache[oldest_i].last_access_ms) {
+        // replace unused blocks first, then the least recently used
+        uint8_t rank = 1;
+        if (cache[i].state == GRID_CACHE_INVALID) {
+            rank = 0;
+        } else if (keep_dirty && cache[i].state == GRID_CACHE_DIRTY) {
+            rank = 2;
+        }
+        if (oldest_i == -1 || rank < oldest_rank ||
+            (rank == oldest_rank && cache[i].last_access < cache[oldest_i].last_access)) {
             oldest_i = i;
+            oldest_rank = rank;
         }
     }
+    cache_misses++;
 
     // Not found. Use the oldest grid and make it this grid,
     // initially unpopulated
@@ -135,7 +151,7 @@ AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info
     grid.grid.lat_degrees = info.lat_degrees;
     grid.grid.lon_degrees = info.lon_degrees;
     grid.grid.version = TERRAIN_GRID_FORMAT_VERSION;
-    grid.last_access_ms = now_ms;
+    grid.last_access = access;
 
     // mark as waiting for disk read
     grid.state = GRID_CACHE_DISKWAIT;
@@ -144,22 +160,22 @@ AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info
 }
 
 /*
-  find cache index of disk_block
+  find cache index of a block being read or written by disk IO
  */
-int16_t AP_Terrain::find_io_idx(enum GridCacheState state)
+int16_t AP_Terrain::find_io_idx(const struct grid_block &block, enum GridCacheState state)
 {
     // try first with given state
     for (uint16_t i=0; i<cache_size; i++) {
-        if (TERRAIN_LATLON_EQUAL(disk_block.block.lat,cache[i].grid.lat) &&
-            TERRAIN_LATLON_EQUAL(disk_block.block.lon,cache[i].grid.lon) &&
+        if (TERRAIN_LATLON_EQUAL(block.lat,cache[i].grid.lat) &&
+            TERRAIN_LATLON_EQUAL(block.lon,cache[i].grid.lon) &&
             cache[i].state == state) {
             return i;
         }
     }    
     // then any state
     for (uint16_t i=0; i<cache_size; i++) {
-        if (TERRAIN_LATLON_EQUAL(disk_block.block.lat,cache[i].grid.lat) &&
-            TERRAIN_LATLON_EQUAL(disk_block.block.lon,cache[i].grid.lon)) {
+        if (TERRAIN_LATLON_EQUAL(block.lat,cache[i].grid.lat) &&
+            TERRAIN_LATLON_EQUAL(block.lon,cache[i].grid.lon)) {
             return i;
         }
     }    
@@ -3,6 +3,7 @@
 #if AP_VEHICLE_ENABLED
 
 #include "AP_Vehicle.h"
+#include <AP_Common/AP_BootTrace.h>
 #include <AP_InertialSensor/AP_InertialSensor_rate_config.h>
 
 #include <AP_BLHeli/AP_BLHeli.h>
@@ -320,6 +321,7 @@ void AP_Vehicle::setup()
     // values from storage:
     AP_Param::check_var_info();
     load_parameters();
+    AP_BOOT_TRACE("params");
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
     if (AP_BoardConfig::get_sdcard_slowdown() != 0) {
@@ -364,6 +366,7 @@ void AP_Vehicle::setup()
     // initialise serial ports
     serial_manager.init();
 #endif
+    AP_BOOT_TRACE("serial");
 #if HAL_GCS_ENABLED
     gcs().setup_console();
 #endif
@@ -406,13 +409,16 @@ void AP_Vehicle::setup()
 #endif
 
     BoardConfig.init();
+    AP_BOOT_TRACE("board");
 
 #if HAL_CANMANAGER_ENABLED
     can_mgr.init();
+    AP_BOOT_TRACE("CAN");
 #endif
 
 #if HAL_LOGGING_ENABLED
     logger.init(get_log_bitmask(), get_log_structures(), get_num_log_structures());
+    AP_BOOT_TRACE("logger");
 #endif
 
     // init cargo gripper
@@ -422,9 +428,11 @@ void AP_Vehicle::setup()
 
     // init_ardupilot is where the vehicle does most of its initialisation.
     init_ardupilot();
+    AP_BOOT_TRACE("vehicle init");
 
 #if AP_SCRIPTING_ENABLED
     scripting.init();
+    AP_BOOT_TRACE("scripting");
 #endif // AP_SCRIPTING_ENABLED
 
 #if AP_AIRSPEED_ENABLED
@@ -526,6 +534,7 @@ void AP_Vehicle::setup()
     // initialisation
     AP_Param::invalidate_count();
 
+    AP_BOOT_TRACE("setup");
     GCS_SEND_TEXT(MAV_SEVERITY_INFO, "ArduPilot Ready");
 
 #if AP_DDS_ENABLED
@@ -619,7 +628,7 @@ const AP_Scheduler::Task AP_Vehicle::scheduler_tasks[] = {
     SCHED_TASK_CLASS(AP_GyroFFT,   &vehicle.gyro_fft,       update,                  400, 50, 205),
     SCHED_TASK_CLASS(AP_GyroFFT,   &vehicle.gyro_fft,       update_parameters,         1, 50, 210),
 #endif
-#if AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED && !AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+#if AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED
     SCHED_TASK(update_dynamic_notch_at_specified_rate,      LOOP_RATE,                    200, 215),
 #endif
 #if AP_VIDEOTX_ENABLED
@@ -643,6 +652,9 @@ const AP_Scheduler::Task AP_Vehicle::scheduler_tasks[] = {
 #if AP_OPENDRONEID_ENABLED
     SCHED_TASK_CLASS(AP_OpenDroneID, &vehicle.opendroneid,  update,                   10,  50, 236),
 #endif
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+    SCHED_TASK_CLASS(AP_VisualOdom, &vehicle.visual_odom,     update,                  100,  50, 237),
+#endif
 #if AP_NETWORKING_ENABLED
     SCHED_TASK_CLASS(AP_Networking, &vehicle.networking,    update,                   10,  50, 238),
 #endif
@@ -860,16 +872,15 @@ void AP_Vehicle::update_dynamic_notch(AP_InertialSensor::HarmonicNotch &notch)
         case HarmonicNotchDynamicMode::UpdateBLHeli: // BLHeli based tracking
             // set the harmonic notch filter frequency scaled on measured frequency
             if (notch.params.hasOption(HarmonicNotchFilterParams::Options::DynamicHarmonic)) {
-                float notches[INS_MAX_NOTCHES];
                 // ESC telemetry will return 0 for missing data, but only after 1s
-                const uint8_t num_notches = AP::esc_telem().get_motor_frequencies_hz(INS_MAX_NOTCHES, notches);
+                const uint8_t num_notches = MIN(_notch_esc_freqs.num_freqs, INS_MAX_NOTCHES);
                 if (num_notches > 0) {
-                    notch.update_frequencies_hz(num_notches, notches);
+                    notch.update_frequencies_hz(num_notches, _notch_esc_freqs.freqs_hz);
                 } else {    // throttle fallback
                     update_throttle_notch(notch);
                 }
             } else {
-                notch.update_freq_hz(AP::esc_telem().get_average_motor_frequency_hz() * ref);
+                notch.update_freq_hz(_notch_esc_freqs.average_hz * ref);
             }
             break;
 #endif
@@ -903,6 +914,15 @@ void AP_Vehicle::update_dynamic_notch(AP_InertialSensor::HarmonicNotch &notch)
 // run notch update at either loop rate or 200Hz
 void AP_Vehicle::update_dynamic_notch_at_specified_rate()
 {
+    if (using_rate_thread) {
+        // the rate thread updates the notches at the gyro rate
+        return;
+    }
+
+#if HAL_WITH_ESC_TELEM
+    update_notch_esc_frequencies();
+#endif
+
     for (auto &notch : ins.harmonic_notches) {
         if (notch.params.hasOption(HarmonicNotchFilterParams::Options::LoopRateUpdate)) {
             update_dynamic_notch(notch);
@@ -917,6 +937,60 @@ void AP_Vehicle::update_dynamic_notch_at_specified_rate()
         }
     }
 }
+
+#if HAL_WITH_ESC_TELEM
+/*
+  read the ESC frequencies once for all of the notches updated in this
+  pass, rather than once per notch, and record the time from new rpm
+  data being received to the notches first using it
+ */
+void AP_Vehicle::update_notch_esc_frequencies()
+{
+    bool esc_tracking = false;
+    for (const auto &notch : ins.harmonic_notches) {
+        if (notch.params.enabled() && notch.params.tracking_mode() == HarmonicNotchDynamicMode::UpdateBLHeli) {
+            esc_tracking = true;
+            break;
+        }
+    }
+    if (!esc_tracking) {
+        return;
+    }
+
+    AP::esc_telem().get_motor_frequencies(_notch_esc_freqs);
+
+    auto &lat = _notch_esc_latency;
+    if (_notch_esc_freqs.newest_update_us != 0 && _notch_esc_freqs.newest_update_us != lat.last_update_us) {
+        lat.last_update_us = _notch_esc_freqs.newest_update_us;
+        const uint32_t age_us = AP_HAL::micros() - _notch_esc_freqs.newest_update_us;
+        lat.sum_us += age_us;
+        lat.max_us = MAX(lat.max_us, age_us);
+        lat.count++;
+    }
+
+#if HAL_LOGGING_ENABLED
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - lat.last_log_ms < 1000 || lat.count == 0) {
+        return;
+    }
+    lat.last_log_ms = now_ms;
+// @LoggerMessage: NESC
+// @Description: Latency from ESC rpm data reception to the harmonic notch update
+// @Field: TimeUS: Time since system startup
+// @Field: N: number of notch updates with new rpm data
+// @Field: Avg: average time from new ESC rpm data being received to the notch update
+// @Field: Max: maximum time from new ESC rpm data being received to the notch update
+    AP::logger().WriteStreaming("NESC", "TimeUS,N,Avg,Max",
+                                "s-ss", "F-FF", "QHII",
+                                AP_HAL::micros64(),
+                                lat.count,
+                                lat.sum_us / lat.count,
+                                lat.max_us);
+    lat.sum_us = lat.max_us = 0;
+    lat.count = 0;
+#endif
+}
+#endif  // HAL_WITH_ESC_TELEM
 #endif  // AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED
 
 void AP_Vehicle::notify_no_such_mode(uint8_t mode_number)
@@ -1087,6 +1161,10 @@ void AP_Vehicle::one_Hz_update(void)
 #endif
 #endif
 
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    // see if we should have a separate rate thread
+    start_rate_thread();
+#endif
 }
 
 void AP_Vehicle::check_motor_noise()
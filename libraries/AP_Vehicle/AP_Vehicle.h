@@ -39,6 +39,7 @@
 #include <AP_Generator/AP_Generator.h>
 #include <AP_Logger/AP_Logger.h>
 #include <AP_InertialSensor/AP_InertialSensor.h>
+#include <AP_InertialSensor/AP_InertialSensor_rate_config.h>
 #include <AP_Notify/AP_Notify.h>                    // Notify library
 #include <AP_Param/AP_Param.h>
 #include <AP_RangeFinder/AP_RangeFinder.h>
@@ -532,8 +533,52 @@ protected:
     void update_dynamic_notch(AP_InertialSensor::HarmonicNotch &notch);
     // run notch update at either loop rate or 200Hz
     void update_dynamic_notch_at_specified_rate();
+#if HAL_WITH_ESC_TELEM
+    // fetch the ESC frequencies once for all the notches about to be updated
+    void update_notch_esc_frequencies();
+#endif
 #endif // AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED
 
+    // type of fast rate attitude controller in operation
+    enum class FastRateType : uint8_t {
+        FAST_RATE_DISABLED            = 0,
+        FAST_RATE_DYNAMIC             = 1,
+        FAST_RATE_FIXED_ARMED         = 2,
+        FAST_RATE_FIXED               = 3,
+    };
+
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    /*
+      vehicle hooks for the fast rate thread, see AP_Vehicle_rate_thread.cpp
+     */
+    // the configured type of fast rate thread, and the gyro rate divisor it aims for
+    virtual FastRateType get_fast_rate_type() const { return FastRateType::FAST_RATE_DISABLED; }
+    virtual uint8_t get_fast_rate_decimation() const { return 1; }
+    // run the rate controllers on a filtered gyro sample, corrected for gyro drift
+    virtual void rate_controller_run_dt(const Vector3f &gyro_rads, float dt) {}
+    // output after each run of the rate controllers, full_push is set at the main loop rate
+    virtual void rate_controller_output(bool full_push) {}
+    // the rate controllers are now run at rate_hz
+    virtual void rate_controller_set_rate(uint32_t rate_hz) {}
+    // update the sample rate of the rate controller notches
+    virtual void rate_controller_set_notch_sample_rate(float sample_rate_hz) {}
+    // called when the fast rate thread takes over or hands back the rate controllers
+    virtual void rate_controller_enabled(bool enabled) {}
+    // the rate at which the rate controllers are logged
+    enum class RateLogging : uint8_t {
+        NONE,
+        MEDIUM,     // 10Hz
+        FAST,       // 1kHz, or the main loop rate if slower
+    };
+    virtual RateLogging get_rate_logging() { return RateLogging::NONE; }
+    virtual void rate_controller_log_update() {}
+    // log the timing of the fast rate thread at 10Hz
+    virtual void rate_controller_log_dt(float dt, float dtAvg, float dtMax, float dtMin) {}
+#endif
+
+    // true when the rate controllers are run from the fast rate thread
+    bool using_rate_thread;
+
 private:
 
 #if AP_SCHEDULER_ENABLED
@@ -554,10 +599,68 @@ private:
     uint8_t one_Hz_counter;
     void one_Hz_update();
 
+#if AP_INERTIALSENSOR_FAST_SAMPLE_WINDOW_ENABLED
+    struct RateControllerRates {
+        uint8_t fast_logging_rate;
+        uint8_t medium_logging_rate;
+        uint8_t filter_rate;
+        uint8_t main_loop_rate;
+    };
+
+    void start_rate_thread();
+    uint8_t calc_gyro_decimation(uint8_t gyro_decimation, uint16_t rate_hz);
+    void rate_controller_thread();
+    void rate_controller_filter_update();
+    void rate_controller_set_rates(uint8_t rate_decimation, RateControllerRates& rates, bool warn_cpu_high);
+    void enable_fast_rate_loop(uint8_t rate_decimation, RateControllerRates& rates);
+    void disable_fast_rate_loop(RateControllerRates& rates);
+
+    bool started_rate_thread;
+
+    /*
+      gyro sample to motor output latency, traced through the rate
+      thread for each sample and logged once a second
+     */
+    struct OutputLatencyTrace {
+        uint32_t sample_us;     // gyro read from the sensor
+        uint32_t filtered_us;   // filtering done and sample queued
+        uint32_t pickup_us;     // sample taken by the rate thread
+        uint32_t pid_us;        // rate controller done
+        uint32_t output_us;     // motor output and push() done
+    };
+    struct {
+        OutputLatencyTrace pending; // last trace, waiting for its output frame to start
+        bool have_pending;
+        uint32_t stage_sum_us[5];   // filter, queue, rate, output and send stages
+        uint32_t total_sum_us;
+        uint32_t total_max_us;
+        uint16_t count;
+        uint16_t send_count;        // traces which include the output frame start
+        uint16_t histogram[6];      // total latency, see output_latency_update()
+    } output_latency;
+    void output_latency_update(const OutputLatencyTrace &trace);
+#if HAL_LOGGING_ENABLED
+    void output_latency_log();
+#endif
+#endif
+
     bool likely_flying;         // true if vehicle is probably flying
     uint32_t _last_flying_ms;   // time when likely_flying last went true
 #if AP_INERTIALSENSOR_HARMONICNOTCH_ENABLED
     uint32_t _last_notch_update_ms[HAL_INS_NUM_HARMONIC_NOTCH_FILTERS]; // last time update_dynamic_notch() was run
+#if HAL_WITH_ESC_TELEM
+    // ESC frequencies shared by the notches updated in one pass, only
+    // written by whichever of the main loop and rate thread updates them
+    AP_ESC_Telem::MotorFrequencies _notch_esc_freqs;
+    // time from ESC rpm data reception to the notches using it
+    struct {
+        uint32_t last_update_us;
+        uint32_t sum_us;
+        uint32_t max_us;
+        uint16_t count;
+        uint32_t last_log_ms;
+    } _notch_esc_latency;
+#endif
 #endif
 
     static AP_Vehicle *_singleton;
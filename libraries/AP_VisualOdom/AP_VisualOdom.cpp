@@ -22,6 +22,7 @@
 #include "AP_VisualOdom_MAV.h"
 #include "AP_VisualOdom_IntelT265.h"
 #include <AP_AHRS/AP_AHRS.h>
+#include <AP_Logger/AP_Logger.h>
 
 extern const AP_HAL::HAL &hal;
 
@@ -114,6 +115,15 @@ const AP_Param::GroupInfo AP_VisualOdom::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("_QUAL_MIN", 8, AP_VisualOdom, _quality_min, 0),
 
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+    // @Param: _DELAY_AUTO
+    // @DisplayName: Visual odometry automatic delay estimation
+    // @Description: Estimate the sensor delay by correlating the sensor's horizontal velocity changes with the IMU's, and use it instead of VISO_DELAY_MS once the vehicle has moved enough for a reliable estimate. VISO_DELAY_MS is used until then.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("_DELAY_AUTO", 9, AP_VisualOdom, _delay_auto, 0),
+#endif
+
     AP_GROUPEND
 };
 
@@ -150,6 +160,73 @@ void AP_VisualOdom::init()
     }
 }
 
+// update the delay estimate with the latest IMU data, called at 100Hz
+void AP_VisualOdom::update()
+{
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+    if (!enabled() || _delay_auto == 0) {
+        return;
+    }
+
+    const uint32_t now_ms = AP_HAL::millis();
+    _delay_est.update_imu(now_ms, AP::ahrs().get_accel_ef().xy());
+
+#if HAL_LOGGING_ENABLED
+    if (now_ms - _delay_log_ms >= 1000) {
+        _delay_log_ms = now_ms;
+        uint16_t est_ms;
+        if (_delay_est.get_delay_ms(est_ms)) {
+            // @LoggerMessage: VISD
+            // @Description: Visual Odometry delay estimate
+            // @Field: TimeUS: System time
+            // @Field: Est: estimated sensor delay
+            // @Field: Corr: correlation between sensor and IMU velocity changes at the estimated delay
+            // @Field: Used: sensor delay passed to the EKF
+            AP::logger().WriteStreaming("VISD",
+                                        "TimeUS,Est,Corr,Used",
+                                        "ss-s",
+                                        "FC-C",
+                                        "QHfH",
+                                        AP_HAL::micros64(),
+                                        est_ms,
+                                        _delay_est.get_correlation(),
+                                        get_delay_ms());
+        }
+    }
+#endif
+#endif  // AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+}
+
+// return the sensor delay in milliseconds
+uint16_t AP_VisualOdom::get_delay_ms() const
+{
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+    uint16_t est_ms;
+    if (_delay_auto != 0 && _delay_est.get_delay_ms(est_ms)) {
+        return est_ms;
+    }
+#endif
+    return MAX(0, _delay_ms);
+}
+
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+// record the sensor's NED position after corrections for the delay estimate
+void AP_VisualOdom::record_position(uint32_t time_ms, const Vector3f &pos)
+{
+    if (_delay_auto != 0) {
+        _delay_est.update_position(time_ms, pos.xy());
+    }
+}
+
+// record the sensor's NED velocity after corrections for the delay estimate
+void AP_VisualOdom::record_velocity(uint32_t time_ms, const Vector3f &vel)
+{
+    if (_delay_auto != 0) {
+        _delay_est.update_velocity(time_ms, vel.xy());
+    }
+}
+#endif  // AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+
 // return true if sensor is enabled
 bool AP_VisualOdom::enabled() const
 {
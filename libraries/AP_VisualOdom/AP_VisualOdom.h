@@ -25,6 +25,7 @@
 #include <GCS_MAVLink/GCS_MAVLink.h>
 #endif
 #include <AP_Math/AP_Math.h>
+#include "AP_VisualOdom_DelayEstimator.h"
 
 class AP_VisualOdom_Backend;
 
@@ -56,6 +57,9 @@ public:
     // detect and initialise any sensors
     void init();
 
+    // update the delay estimate with the latest IMU data, called at 100Hz
+    void update();
+
     // return true if sensor is enabled
     bool enabled() const;
 
@@ -71,8 +75,14 @@ public:
     // return a 3D vector defining the position offset of the camera in meters relative to the body frame origin
     const Vector3f &get_pos_offset(void) const { return _pos_offset; }
 
-    // return the sensor delay in milliseconds (see _DELAY_MS parameter)
-    uint16_t get_delay_ms() const { return MAX(0, _delay_ms); }
+    // return the sensor delay in milliseconds (see _DELAY_MS and _DELAY_AUTO parameters)
+    uint16_t get_delay_ms() const;
+
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+    // record the sensor's NED position and velocity, after corrections, for the delay estimate
+    void record_position(uint32_t time_ms, const Vector3f &pos);
+    void record_velocity(uint32_t time_ms, const Vector3f &vel);
+#endif
 
     // return velocity measurement noise in m/s
     float get_vel_noise() const { return _vel_noise; }
@@ -136,6 +146,12 @@ private:
     AP_Float _pos_noise;        // position measurement noise in meters
     AP_Float _yaw_noise;        // yaw measurement noise in radians
     AP_Int8 _quality_min;       // positions and velocities will only be sent to EKF if over this value.  if 0 all values sent to EKF
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+    AP_Int8 _delay_auto;        // use the estimated delay instead of _delay_ms once available
+
+    AP_VisualOdom_DelayEstimator _delay_est;
+    uint32_t _delay_log_ms;     // system time the delay estimate was last logged
+#endif
 
     // reference to backends
     AP_VisualOdom_Backend *_driver;
@@ -0,0 +1,182 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_VisualOdom_DelayEstimator.h"
+
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+
+#include <AP_HAL/AP_HAL.h>
+
+// time constant of the leak applied to the integrated IMU velocity
+#define DELAY_EST_IMU_LEAK_TC       10.0f
+// IMU samples further apart than this restart the history
+#define DELAY_EST_IMU_MAX_GAP_MS    100U
+// sensor samples further apart than this are not correlated
+#define DELAY_EST_SENSOR_MAX_GAP_MS 200U
+// positions are ignored for this long after a velocity is received
+#define DELAY_EST_VEL_PREFERRED_MS  1000U
+// decay of the correlation sums per sensor sample, about 15s at 30Hz
+#define DELAY_EST_DECAY             0.998f
+// decayed sum of squared sensor velocity changes needed before estimating
+#define DELAY_EST_MIN_EXCITATION    0.5f
+// correlation needed at the best delay before it is used
+#define DELAY_EST_MIN_CORRELATION   0.5f
+// low pass filter applied to the estimate once converged
+#define DELAY_EST_FILTER_ALPHA      0.1f
+
+// record the horizontal NE acceleration from the IMU in m/s/s
+void AP_VisualOdom_DelayEstimator::update_imu(uint32_t now_ms, const Vector2f &accel_ne)
+{
+    if (_imu_count > 0) {
+        const uint32_t dt_ms = now_ms - _imu_hist[_imu_head].time_ms;
+        if (dt_ms == 0) {
+            return;
+        }
+        if (dt_ms > DELAY_EST_IMU_MAX_GAP_MS) {
+            _imu_count = 0;
+        } else {
+            // trapezoidal integration, leaking the integral to stop accel
+            // bias growing it as only changes over a fraction of a second are used
+            const float dt = dt_ms * 0.001f;
+            _imu_vel = (_imu_vel + (accel_ne + _imu_accel) * (0.5f * dt)) * (1.0f - dt / DELAY_EST_IMU_LEAK_TC);
+        }
+    }
+    _imu_accel = accel_ne;
+
+    _imu_head = (_imu_count == 0) ? 0 : (_imu_head + 1) % IMU_HISTORY_LEN;
+    _imu_hist[_imu_head].time_ms = now_ms;
+    _imu_hist[_imu_head].vel = _imu_vel;
+    _imu_count = MIN(_imu_count + 1, IMU_HISTORY_LEN);
+}
+
+// find the integrated IMU velocity at time_ms by interpolating the history
+bool AP_VisualOdom_DelayEstimator::imu_velocity_at(uint32_t time_ms, Vector2f &vel) const
+{
+    for (uint8_t i = 0; i + 1 < _imu_count; i++) {
+        const auto &newer = _imu_hist[(_imu_head + IMU_HISTORY_LEN - i) % IMU_HISTORY_LEN];
+        const auto &older = _imu_hist[(_imu_head + IMU_HISTORY_LEN - i - 1) % IMU_HISTORY_LEN];
+        if (int32_t(time_ms - newer.time_ms) > 0) {
+            // newer than the history
+            return false;
+        }
+        if (int32_t(time_ms - older.time_ms) >= 0) {
+            const float span = newer.time_ms - older.time_ms;
+            const float frac = (time_ms - older.time_ms) / span;
+            vel = older.vel + (newer.vel - older.vel) * frac;
+            return true;
+        }
+    }
+    return false;
+}
+
+// record a horizontal NE velocity from the sensor in m/s
+void AP_VisualOdom_DelayEstimator::update_velocity(uint32_t time_ms, const Vector2f &vel_ne)
+{
+    _last_velocity_msg_ms = AP_HAL::millis();
+    add_velocity(time_ms, vel_ne);
+}
+
+// record a horizontal NE position from the sensor in m
+void AP_VisualOdom_DelayEstimator::update_position(uint32_t time_ms, const Vector2f &pos_ne)
+{
+    if (_last_velocity_msg_ms != 0 && AP_HAL::millis() - _last_velocity_msg_ms < DELAY_EST_VEL_PREFERRED_MS) {
+        return;
+    }
+
+    const uint32_t dt_ms = time_ms - _last_pos_ms;
+    if (_last_pos_ms != 0 && dt_ms > 0 && dt_ms <= DELAY_EST_SENSOR_MAX_GAP_MS) {
+        // the velocity between two positions belongs to the time between them
+        add_velocity(_last_pos_ms + dt_ms / 2, (pos_ne - _last_pos) / (dt_ms * 0.001f));
+    }
+    _last_pos_ms = time_ms;
+    _last_pos = pos_ne;
+}
+
+void AP_VisualOdom_DelayEstimator::add_velocity(uint32_t time_ms, const Vector2f &vel_ne)
+{
+    const uint32_t dt_ms = time_ms - _last_vel_ms;
+    if (_last_vel_ms != 0 && dt_ms > 0 && dt_ms <= DELAY_EST_SENSOR_MAX_GAP_MS) {
+        correlate(_last_vel_ms, time_ms, vel_ne - _last_vel);
+    }
+    _last_vel_ms = time_ms;
+    _last_vel = vel_ne;
+}
+
+/*
+  compare the sensor's change in velocity between t1_ms and t2_ms with
+  the IMU's change in velocity over the same interval shifted back by
+  each candidate delay, then pick the delay that correlates best
+ */
+void AP_VisualOdom_DelayEstimator::correlate(uint32_t t1_ms, uint32_t t2_ms, const Vector2f &delta_vel)
+{
+    Vector2f imu_delta[NUM_DELAYS];
+    for (uint8_t i = 0; i < NUM_DELAYS; i++) {
+        const uint32_t delay_ms = i * DELAY_STEP_MS;
+        Vector2f v1, v2;
+        if (!imu_velocity_at(t1_ms - delay_ms, v1) || !imu_velocity_at(t2_ms - delay_ms, v2)) {
+            // the IMU history must cover every candidate so the sums stay comparable
+            return;
+        }
+        imu_delta[i] = v2 - v1;
+    }
+
+    _sum_sensor_sq = _sum_sensor_sq * DELAY_EST_DECAY + delta_vel.length_squared();
+
+    float corr[NUM_DELAYS];
+    uint8_t best = 0;
+    for (uint8_t i = 0; i < NUM_DELAYS; i++) {
+        _sum_cross[i] = _sum_cross[i] * DELAY_EST_DECAY + delta_vel * imu_delta[i];
+        _sum_imu_sq[i] = _sum_imu_sq[i] * DELAY_EST_DECAY + imu_delta[i].length_squared();
+        const float norm = sqrtf(_sum_sensor_sq * _sum_imu_sq[i]);
+        corr[i] = is_positive(norm) ? _sum_cross[i] / norm : 0.0f;
+        if (corr[i] > corr[best]) {
+            best = i;
+        }
+    }
+    _best_corr = corr[best];
+
+    if (_sum_sensor_sq < DELAY_EST_MIN_EXCITATION || _best_corr < DELAY_EST_MIN_CORRELATION) {
+        return;
+    }
+
+    // fit a parabola through the peak and its neighbours for a finer estimate than the step
+    float offset = 0.0f;
+    if (best > 0 && best + 1 < NUM_DELAYS) {
+        const float denom = corr[best - 1] - 2.0f * corr[best] + corr[best + 1];
+        if (is_negative(denom)) {
+            offset = constrain_float(0.5f * (corr[best - 1] - corr[best + 1]) / denom, -0.5f, 0.5f);
+        }
+    }
+    const float estimate_ms = (best + offset) * DELAY_STEP_MS;
+
+    if (_converged) {
+        _delay_ms += (estimate_ms - _delay_ms) * DELAY_EST_FILTER_ALPHA;
+    } else {
+        _delay_ms = estimate_ms;
+        _converged = true;
+    }
+}
+
+// get the estimated delay in milliseconds
+bool AP_VisualOdom_DelayEstimator::get_delay_ms(uint16_t &delay_ms) const
+{
+    if (!_converged) {
+        return false;
+    }
+    delay_ms = uint16_t(constrain_float(_delay_ms, 0, MAX_DELAY_MS) + 0.5f);
+    return true;
+}
+
+#endif  // AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
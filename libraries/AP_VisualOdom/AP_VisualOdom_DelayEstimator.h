@@ -0,0 +1,94 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "AP_VisualOdom_config.h"
+
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+
+#include <AP_Math/AP_Math.h>
+
+/*
+  estimate the delay of the external navigation data relative to the
+  IMU by cross-correlating changes in the sensor's horizontal velocity
+  with changes in velocity integrated from the IMU's acceleration, over
+  a range of candidate delays
+ */
+class AP_VisualOdom_DelayEstimator
+{
+public:
+    // largest delay that can be estimated, matching the range of VISO_DELAY_MS
+    static constexpr uint16_t MAX_DELAY_MS = 250;
+
+    // record the horizontal NE acceleration from the IMU in m/s/s, called at about 100Hz
+    void update_imu(uint32_t now_ms, const Vector2f &accel_ne);
+
+    // record a horizontal NE velocity from the sensor in m/s, with its system time
+    void update_velocity(uint32_t time_ms, const Vector2f &vel_ne);
+
+    // record a horizontal NE position from the sensor in m, with its system
+    // time. Ignored while velocities are being received
+    void update_position(uint32_t time_ms, const Vector2f &pos_ne);
+
+    // get the estimated delay in milliseconds, returns false until
+    // there has been enough motion to estimate it
+    bool get_delay_ms(uint16_t &delay_ms) const;
+
+    // correlation at the estimated delay, from -1 to 1
+    float get_correlation() const { return _best_corr; }
+
+private:
+    static constexpr uint8_t DELAY_STEP_MS = 10;
+    static constexpr uint8_t NUM_DELAYS = MAX_DELAY_MS / DELAY_STEP_MS + 1;
+    // long enough to look back over the largest delay plus a gap between sensor samples
+    static constexpr uint8_t IMU_HISTORY_LEN = 64;
+
+    // find the integrated IMU velocity at time_ms, returns false if outside the history
+    bool imu_velocity_at(uint32_t time_ms, Vector2f &vel) const;
+
+    // add a sensor velocity sample, correlating its change from the previous one
+    void add_velocity(uint32_t time_ms, const Vector2f &vel_ne);
+
+    // update the correlations with a change in sensor velocity between two times
+    void correlate(uint32_t t1_ms, uint32_t t2_ms, const Vector2f &delta_vel);
+
+    // history of velocity integrated from the IMU
+    struct {
+        uint32_t time_ms;
+        Vector2f vel;
+    } _imu_hist[IMU_HISTORY_LEN];
+    uint8_t _imu_head;
+    uint8_t _imu_count;
+    Vector2f _imu_vel;
+    Vector2f _imu_accel;
+
+    // last sensor sample
+    uint32_t _last_vel_ms;
+    Vector2f _last_vel;
+    uint32_t _last_pos_ms;
+    Vector2f _last_pos;
+    uint32_t _last_velocity_msg_ms;
+
+    // decaying sums for the normalised cross-correlation at each candidate delay
+    float _sum_cross[NUM_DELAYS];
+    float _sum_imu_sq[NUM_DELAYS];
+    float _sum_sensor_sq;
+
+    float _best_corr;
+    float _delay_ms;
+    bool _converged;
+};
+
+#endif  // AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
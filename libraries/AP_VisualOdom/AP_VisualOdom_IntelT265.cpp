@@ -68,6 +68,9 @@ void AP_VisualOdom_IntelT265::handle_pose_estimate(uint64_t remote_time_us, uint
     if (consume) {
         // send attitude and position to EKF
         AP::ahrs().writeExtNavData(pos, att, posErr, angErr, time_ms, _frontend.get_delay_ms(), get_reset_timestamp_ms(reset_counter));
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+        _frontend.record_position(time_ms, pos);
+#endif
     }
 
     // calculate euler orientation for logging
@@ -104,6 +107,9 @@ void AP_VisualOdom_IntelT265::handle_vision_speed_estimate(uint64_t remote_time_
     if (consume) {
         // send velocity to EKF
         AP::ahrs().writeExtNavVelData(vel_corrected, _frontend.get_vel_noise(), time_ms, _frontend.get_delay_ms());
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+        _frontend.record_velocity(time_ms, vel_corrected);
+#endif
     }
 
     // record time for health monitoring
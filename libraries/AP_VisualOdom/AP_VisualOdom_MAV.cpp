@@ -40,6 +40,9 @@ void AP_VisualOdom_MAV::handle_pose_estimate(uint64_t remote_time_us, uint32_t t
     bool consume = (_quality >= _frontend.get_quality_min());
     if (consume) {
         AP::ahrs().writeExtNavData(pos, attitude, posErr, angErr, time_ms, _frontend.get_delay_ms(), get_reset_timestamp_ms(reset_counter));
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+        _frontend.record_position(time_ms, pos);
+#endif
     }
 
     // calculate euler orientation for logging
@@ -68,6 +71,9 @@ void AP_VisualOdom_MAV::handle_vision_speed_estimate(uint64_t remote_time_us, ui
     bool consume = (_quality >= _frontend.get_quality_min());
     if (consume) {
         AP::ahrs().writeExtNavVelData(vel, _frontend.get_vel_noise(), time_ms, _frontend.get_delay_ms());
+#if AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+        _frontend.record_velocity(time_ms, vel);
+#endif
     }
 
     // record time for health monitoring
@@ -18,3 +18,7 @@
 #ifndef AP_VISUALODOM_MAV_ENABLED
 #define AP_VISUALODOM_MAV_ENABLED AP_VISUALODOM_BACKEND_DEFAULT_ENABLED && HAL_GCS_ENABLED
 #endif
+
+#ifndef AP_VISUALODOM_DELAY_ESTIMATE_ENABLED
+#define AP_VISUALODOM_DELAY_ESTIMATE_ENABLED HAL_VISUALODOM_ENABLED
+#endif
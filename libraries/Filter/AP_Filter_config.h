@@ -15,3 +15,23 @@
  #endif // HAL_PROGRAM_SIZE_LIMIT_KB
  #endif // AP_FILTER_NUM_FILTERS
 #endif // AP_FILTER_ENABLED
+
+// apply harmonic notches as a structure of arrays biquad cascade
+#ifndef AP_FILTER_NOTCH_BANK_ENABLED
+#define AP_FILTER_NOTCH_BANK_ENABLED HAL_PROGRAM_SIZE_LIMIT_KB > 1024
+#endif
+
+// use the CMSIS-DSP biquad cascade for the notch bank where the DSP library is linked
+#ifndef AP_FILTER_NOTCH_BANK_CMSIS_ENABLED
+#define AP_FILTER_NOTCH_BANK_CMSIS_ENABLED (AP_FILTER_NOTCH_BANK_ENABLED && HAL_WITH_DSP && CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS)
+#endif
+
+// relative change in notch center frequency below which the coefficients are not recalculated
+#ifndef AP_FILTER_NOTCH_FREQ_CHANGE_RATIO
+#define AP_FILTER_NOTCH_FREQ_CHANGE_RATIO 0.002f
+#endif
+
+// use a lookup table for the trig in the notch coefficient calculation
+#ifndef AP_FILTER_NOTCH_TRIG_LUT_ENABLED
+#define AP_FILTER_NOTCH_TRIG_LUT_ENABLED 1
+#endif
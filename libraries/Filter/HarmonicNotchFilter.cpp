@@ -23,6 +23,10 @@
 #include <AP_Logger/AP_Logger.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
 
+#if AP_FILTER_NOTCH_BANK_CMSIS_ENABLED
+#include <arm_math.h>
+#endif
+
 #define HNF_MAX_FILTERS HAL_HNF_MAX_FILTERS // must be even for double-notch filters
 
 /*
@@ -153,6 +157,9 @@ const AP_Param::GroupInfo HarmonicNotchFilterParams::var_info[] = {
  */
 template <class T>
 HarmonicNotchFilter<T>::~HarmonicNotchFilter() {
+#if AP_FILTER_NOTCH_BANK_ENABLED
+    bank_free();
+#endif
     delete[] _filters;
     _num_filters = 0;
     _num_enabled_filters = 0;
@@ -223,6 +230,12 @@ void HarmonicNotchFilter<T>::allocate_filters(uint8_t num_notches, uint32_t harm
             GCS_SEND_TEXT(MAV_SEVERITY_ERROR, "Failed to allocate %u bytes for notch filter", (unsigned int)(_num_filters * sizeof(NotchFilter<T>)));
             _num_filters = 0;
         }
+#if AP_FILTER_NOTCH_BANK_ENABLED
+        // without a bank we fall back to applying each notch in turn
+        if (_filters != nullptr) {
+            bank_allocate(_num_filters);
+        }
+#endif
     }
 }
 
@@ -244,6 +257,12 @@ void HarmonicNotchFilter<T>::expand_filter_count(uint16_t total_notches)
       note that we rely on the semaphore in
       AP_InertialSensor_Backend.cpp to make this thread safe
      */
+#if AP_FILTER_NOTCH_BANK_ENABLED
+    if (_bank.coeffs != nullptr && !bank_allocate(total_notches)) {
+        _alloc_has_failed = true;
+        return;
+    }
+#endif
     auto filters = NEW_NOTHROW NotchFilter<T>[total_notches];
     if (filters == nullptr) {
         _alloc_has_failed = true;
@@ -280,7 +299,7 @@ void HarmonicNotchFilter<T>::set_center_frequency(uint16_t idx, float notch_cent
        higher than the nyquist.
     */
     if (notch_center >= nyquist_limit) {
-        notch.disable();
+        disable_notch(notch);
         return;
     }
 
@@ -307,7 +326,7 @@ void HarmonicNotchFilter<T>::set_center_frequency(uint16_t idx, float notch_cent
         */
         const float disable_freq = harmonic_min_freq * NOTCHFILTER_ATTENUATION_CUTOFF;
         if (notch_center < disable_freq) {
-            notch.disable();
+            disable_notch(notch);
             return;
         }
 
@@ -332,7 +351,26 @@ void HarmonicNotchFilter<T>::set_center_frequency(uint16_t idx, float notch_cent
     */
     notch_center *= spread_mul;
 
-    notch.init_with_A_and_Q(_sample_freq_hz, notch_center, A, _Q);
+    if (notch.init_with_A_and_Q(_sample_freq_hz, notch_center, A, _Q)) {
+        // coefficients have changed
+#if AP_FILTER_NOTCH_BANK_ENABLED
+        _bank.dirty = true;
+#endif
+    }
+}
+
+/*
+  disable one notch of the harmonic notch
+ */
+template <class T>
+void HarmonicNotchFilter<T>::disable_notch(NotchFilter<T> &notch)
+{
+#if AP_FILTER_NOTCH_BANK_ENABLED
+    if (notch.initialised) {
+        _bank.dirty = true;
+    }
+#endif
+    notch.disable();
 }
 
 /*
@@ -365,6 +403,9 @@ void HarmonicNotchFilter<T>::update(uint8_t num_centers, const float center_freq
         expand_filter_count(total_notches);
     }
 
+#if AP_FILTER_NOTCH_BANK_ENABLED
+    const uint16_t prev_enabled_filters = _num_enabled_filters;
+#endif
     _num_enabled_filters = 0;
 
     // update all of the filters using the new center frequencies and existing A & Q
@@ -387,6 +428,12 @@ void HarmonicNotchFilter<T>::update(uint8_t num_centers, const float center_freq
             set_center_frequency(_num_enabled_filters++, notch_center, 1.0 + _notch_spread, harmonic_mul);
         }
     }
+
+#if AP_FILTER_NOTCH_BANK_ENABLED
+    if (_num_enabled_filters != prev_enabled_filters) {
+        _bank.dirty = true;
+    }
+#endif
 }
 
 /*
@@ -399,6 +446,12 @@ T HarmonicNotchFilter<T>::apply(const T &sample)
         return sample;
     }
 
+#if AP_FILTER_NOTCH_BANK_ENABLED && !NOTCH_DEBUG_LOGGING
+    if (_bank.coeffs != nullptr) {
+        return bank_apply(sample);
+    }
+#endif
+
 #if NOTCH_DEBUG_LOGGING
     static int dfd = -1;
     if (dfd == -1) {
@@ -425,6 +478,32 @@ T HarmonicNotchFilter<T>::apply(const T &sample)
     return output;
 }
 
+template <class T>
+void HarmonicNotchFilter<T>::apply_batch(const T *in, T *out, uint16_t n)
+{
+#if AP_FILTER_NOTCH_BANK_ENABLED && !NOTCH_DEBUG_LOGGING
+    if (_initialised && _bank.coeffs != nullptr) {
+        // the bank already runs each sample through all stages in registers
+        for (uint16_t i = 0; i < n; i++) {
+            out[i] = bank_apply(in[i]);
+        }
+        return;
+    }
+#endif
+
+    if (out != in) {
+        for (uint16_t i = 0; i < n; i++) {
+            out[i] = in[i];
+        }
+    }
+    if (!_initialised) {
+        return;
+    }
+    for (uint16_t i = 0; i < _num_enabled_filters; i++) {
+        _filters[i].apply_batch(out, out, n);
+    }
+}
+
 /*
   reset all of the underlying filters
  */
@@ -438,7 +517,156 @@ void HarmonicNotchFilter<T>::reset()
     for (uint16_t i = 0; i < _num_filters; i++) {
         _filters[i].reset();
     }
+#if AP_FILTER_NOTCH_BANK_ENABLED
+    _bank.need_reset = true;
+#endif
+}
+
+#if AP_FILTER_NOTCH_BANK_ENABLED
+/*
+  allocate the bank, keeping the coefficients and states of any
+  existing stages. On failure the existing bank is left in place
+ */
+template <class T>
+bool HarmonicNotchFilter<T>::bank_allocate(uint16_t num_stages)
+{
+    float *coeffs = NEW_NOTHROW float[num_stages * (5 + 4 * _bank_axes)];
+    bool *active = NEW_NOTHROW bool[num_stages];
+    if (coeffs == nullptr || active == nullptr) {
+        delete[] coeffs;
+        delete[] active;
+        return false;
+    }
+
+    float *state[_bank_axes];
+    for (uint8_t a = 0; a < _bank_axes; a++) {
+        state[a] = &coeffs[num_stages * (5 + 4 * a)];
+    }
+
+    // copy the existing stages, the allocated size of the old bank is _num_filters
+    if (_bank.coeffs != nullptr) {
+        const uint16_t n = MIN(num_stages, _num_filters);
+        memcpy(coeffs, _bank.coeffs, n * 5 * sizeof(float));
+        for (uint8_t a = 0; a < _bank_axes; a++) {
+            memcpy(state[a], _bank.state[a], n * 4 * sizeof(float));
+        }
+        memcpy(active, _bank.active, n * sizeof(bool));
+    }
+
+    bank_free();
+    _bank.coeffs = coeffs;
+    for (uint8_t a = 0; a < _bank_axes; a++) {
+        _bank.state[a] = state[a];
+    }
+    _bank.active = active;
+    _bank.dirty = true;
+    return true;
+}
+
+template <class T>
+void HarmonicNotchFilter<T>::bank_free(void)
+{
+    delete[] _bank.coeffs;
+    delete[] _bank.active;
+    _bank.coeffs = nullptr;
+    _bank.active = nullptr;
+    _bank.num_stages = 0;
+}
+
+/*
+  copy the coefficients of the enabled notches into the bank. A notch
+  that is not initialised is a unity stage, which passes samples
+  through while tracking them in its state in the same way as
+  NotchFilter::apply()
+ */
+template <class T>
+void HarmonicNotchFilter<T>::bank_sync(void)
+{
+    for (uint16_t i = 0; i < _num_enabled_filters; i++) {
+        const auto &notch = _filters[i];
+        float *c = &_bank.coeffs[i * 5];
+        if (notch.initialised) {
+            c[0] = notch.b0;
+            c[1] = notch.b1;
+            c[2] = notch.b2;
+            c[3] = -notch.a1;
+            c[4] = -notch.a2;
+            if (!_bank.active[i]) {
+                // start filtering from the last input, as NotchFilter does
+                for (uint8_t a = 0; a < _bank_axes; a++) {
+                    float *s = &_bank.state[a][i * 4];
+                    s[1] = s[0];
+                    s[3] = s[2];
+                }
+            }
+        } else {
+            c[0] = 1;
+            c[1] = c[2] = c[3] = c[4] = 0;
+        }
+        _bank.active[i] = notch.initialised;
+    }
+    _bank.num_stages = _num_enabled_filters;
+    _bank.dirty = false;
+}
+
+/*
+  apply a sample to the enabled notches as one biquad cascade per axis
+ */
+template <class T>
+T HarmonicNotchFilter<T>::bank_apply(const T &sample)
+{
+    if (_bank.dirty) {
+        bank_sync();
+    }
+
+    float v[_bank_axes];
+    memcpy(v, &sample, sizeof(v));
+
+    if (_bank.need_reset) {
+        // seed the states with the sample and pass it through
+        for (uint16_t i = 0; i < _num_filters; i++) {
+            for (uint8_t a = 0; a < _bank_axes; a++) {
+                float *s = &_bank.state[a][i * 4];
+                s[0] = s[1] = s[2] = s[3] = v[a];
+            }
+        }
+        for (uint16_t i = 0; i < _bank.num_stages; i++) {
+            _filters[i].need_reset = false;
+        }
+        _bank.need_reset = false;
+        return sample;
+    }
+
+    if (_bank.num_stages == 0) {
+        return sample;
+    }
+
+#if AP_FILTER_NOTCH_BANK_CMSIS_ENABLED
+    for (uint8_t a = 0; a < _bank_axes; a++) {
+        const arm_biquad_casd_df1_inst_f32 S { _bank.num_stages, _bank.state[a], _bank.coeffs };
+        arm_biquad_cascade_df1_f32(&S, &v[a], &v[a], 1);
+    }
+#else
+    for (uint16_t i = 0; i < _bank.num_stages; i++) {
+        const float *c = &_bank.coeffs[i * 5];
+        for (uint8_t a = 0; a < _bank_axes; a++) {
+            float *s = &_bank.state[a][i * 4];
+            const float x = v[a];
+            const float y = x*c[0] + s[0]*c[1] + s[1]*c[2] + s[2]*c[3] + s[3]*c[4];
+            s[1] = s[0];
+            s[0] = x;
+            s[3] = s[2];
+            s[2] = y;
+            v[a] = y;
+        }
+    }
+#endif
+
+    T output;
+    memcpy(&output, v, sizeof(v));
+    return output;
 }
+#endif // AP_FILTER_NOTCH_BANK_ENABLED
 
 #if HAL_LOGGING_ENABLED
 // @LoggerMessage: FCN
@@ -499,8 +727,8 @@ void HarmonicNotchFilter<T>::log_notch_centers(uint8_t instance, uint64_t now_us
     }
 
     if (num_sources > 1) {
-        AP::logger().WriteStreaming(
-            "FCN", "TimeUS,I,NF,CF1,CF2,CF3,CF4,CF5,CF6,HF1,HF2,HF3,HF4,HF5,HF6", "s#-zzzzzzzzzzzz", "F--------------", "QBHffffffffffff",
+        AP::logger().WriteStreamingFields(
+            "FCN", "TimeUS,I,NF,CF1,CF2,CF3,CF4,CF5,CF6,HF1,HF2,HF3,HF4,HF5,HF6", "s#-zzzzzzzzzzzz", "F--------------",
             now_us,
             instance,
             _num_filters,
@@ -508,8 +736,8 @@ void HarmonicNotchFilter<T>::log_notch_centers(uint8_t instance, uint64_t now_us
             first_harmonic[0], first_harmonic[1], first_harmonic[2], first_harmonic[3], first_harmonic[4], first_harmonic[5]);
     } else {
         // log single center frequency
-        AP::logger().WriteStreaming(
-            "FCNS", "TimeUS,I,CF,HF", "s#zz", "F---", "QBff",
+        AP::logger().WriteStreamingFields(
+            "FCNS", "TimeUS,I,CF,HF", "s#zz", "F---",
             now_us,
             instance,
             centers[0],
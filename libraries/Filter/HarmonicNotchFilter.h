@@ -18,6 +18,7 @@
 #include <cmath>
 #include <AP_Param/AP_Param.h>
 #include "NotchFilter.h"
+#include "AP_Filter_config.h"
 
 #define HNF_MAX_HARMONICS 16
 
@@ -51,6 +52,9 @@ public:
 
     // apply a sample to each of the underlying filters in turn
     T apply(const T &sample);
+    // apply n samples, running the whole batch through each of the
+    // underlying filters in turn. out may be the same array as in
+    void apply_batch(const T *in, T *out, uint16_t n);
     // reset each of the underlying filters
     void reset();
 
@@ -60,6 +64,9 @@ public:
     void log_notch_centers(uint8_t instance, uint64_t now_us) const;
 
 private:
+    // disable one of the underlying notch filters
+    void disable_notch(NotchFilter<T> &notch);
+
     // underlying bank of notch filters
     NotchFilter<T>*  _filters;
     // sample frequency for each filter
@@ -90,6 +97,39 @@ private:
 
     // pointer to params object for this filter
     HarmonicNotchFilterParams *params;
+
+#if AP_FILTER_NOTCH_BANK_ENABLED
+    // number of float elements in a sample
+    static constexpr uint8_t _bank_axes = sizeof(T) / sizeof(float);
+
+    /*
+      structure of arrays copy of the enabled notches so that each
+      axis is filtered as a single biquad cascade. The layout is that
+      used by arm_biquad_cascade_df1_f32()
+     */
+    struct {
+        // b0, b1, b2, -a1, -a2 for each stage
+        float *coeffs;
+        // x[n-1], x[n-2], y[n-1], y[n-2] for each stage, one array per axis
+        float *state[_bank_axes];
+        // true for stages that were filtering at the last sync
+        bool *active;
+        uint16_t num_stages;
+        // notch coefficients have changed since the last sync
+        bool dirty;
+        // states need to be seeded from the next sample
+        bool need_reset;
+    } _bank;
+
+    // allocate or grow the bank to hold num_stages stages
+    bool bank_allocate(uint16_t num_stages);
+    // free the bank, falling back to applying each notch in turn
+    void bank_free(void);
+    // copy the enabled notch coefficients into the bank
+    void bank_sync(void);
+    // apply a sample to the bank
+    T bank_apply(const T &sample);
+#endif
 };
 
 // Harmonic notch update mode
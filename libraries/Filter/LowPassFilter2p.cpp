@@ -34,6 +34,47 @@ T DigitalBiquadFilter<T>::apply(const T &sample, const struct biquad_params &par
     return output;
 }
 
+/*
+  the same as apply() on each sample, with the delay elements held in
+  locals for the whole batch
+ */
+template <class T>
+void DigitalBiquadFilter<T>::apply_batch(const T *in, T *out, uint16_t n, const struct biquad_params &params) {
+    if (n == 0) {
+        return;
+    }
+    if(!is_positive(params.cutoff_freq) || !is_positive(params.sample_freq)) {
+        if (out != in) {
+            for (uint16_t i = 0; i < n; i++) {
+                out[i] = in[i];
+            }
+        }
+        return;
+    }
+
+    if (!initialised) {
+        reset(in[0], params);
+    }
+
+    const float a1 = params.a1;
+    const float a2 = params.a2;
+    const float b0 = params.b0;
+    const float b1 = params.b1;
+    const float b2 = params.b2;
+    T delay_element_1 = _delay_element_1;
+    T delay_element_2 = _delay_element_2;
+
+    for (uint16_t i = 0; i < n; i++) {
+        const T delay_element_0 = in[i] - delay_element_1 * a1 - delay_element_2 * a2;
+        out[i] = delay_element_0 * b0 + delay_element_1 * b1 + delay_element_2 * b2;
+        delay_element_2 = delay_element_1;
+        delay_element_1 = delay_element_0;
+    }
+
+    _delay_element_1 = delay_element_1;
+    _delay_element_2 = delay_element_2;
+}
+
 template <class T>
 void DigitalBiquadFilter<T>::reset() { 
     initialised = false;
@@ -105,6 +146,11 @@ T LowPassFilter2p<T>::apply(const T &sample) {
     return _filter.apply(sample, _params);
 }
 
+template <class T>
+void LowPassFilter2p<T>::apply_batch(const T *in, T *out, uint16_t n) {
+    _filter.apply_batch(in, out, n, _params);
+}
+
 template <class T>
 void LowPassFilter2p<T>::reset(void) {
     return _filter.reset();
@@ -25,6 +25,84 @@ const static float NOTCH_MAX_SLEW       = 0.05f;
 const static float NOTCH_MAX_SLEW_LOWER = 1.0f - NOTCH_MAX_SLEW;
 const static float NOTCH_MAX_SLEW_UPPER = 1.0f / NOTCH_MAX_SLEW_LOWER;
 
+#if AP_FILTER_NOTCH_TRIG_LUT_ENABLED
+/*
+  sin() over the first quadrant in NOTCH_SIN_LUT_SIZE steps. With
+  linear interpolation the error is below 5e-6, which moves the notch
+  center by a small fraction of a hertz
+ */
+#define NOTCH_SIN_LUT_SIZE 256
+static const float notch_sin_lut[NOTCH_SIN_LUT_SIZE+1] = {
+    0.00000000f, 0.00613588f, 0.01227154f, 0.01840673f, 0.02454123f, 0.03067480f,
+    0.03680722f, 0.04293826f, 0.04906767f, 0.05519524f, 0.06132074f, 0.06744392f,
+    0.07356456f, 0.07968244f, 0.08579731f, 0.09190896f, 0.09801714f, 0.10412163f,
+    0.11022221f, 0.11631863f, 0.12241068f, 0.12849811f, 0.13458071f, 0.14065824f,
+    0.14673047f, 0.15279719f, 0.15885814f, 0.16491312f, 0.17096189f, 0.17700422f,
+    0.18303989f, 0.18906866f, 0.19509032f, 0.20110463f, 0.20711138f, 0.21311032f,
+    0.21910124f, 0.22508391f, 0.23105811f, 0.23702361f, 0.24298018f, 0.24892761f,
+    0.25486566f, 0.26079412f, 0.26671276f, 0.27262136f, 0.27851969f, 0.28440754f,
+    0.29028468f, 0.29615089f, 0.30200595f, 0.30784964f, 0.31368174f, 0.31950203f,
+    0.32531029f, 0.33110631f, 0.33688985f, 0.34266072f, 0.34841868f, 0.35416353f,
+    0.35989504f, 0.36561300f, 0.37131719f, 0.37700741f, 0.38268343f, 0.38834505f,
+    0.39399204f, 0.39962420f, 0.40524131f, 0.41084317f, 0.41642956f, 0.42200027f,
+    0.42755509f, 0.43309382f, 0.43861624f, 0.44412214f, 0.44961133f, 0.45508359f,
+    0.46053871f, 0.46597650f, 0.47139674f, 0.47679923f, 0.48218377f, 0.48755016f,
+    0.49289819f, 0.49822767f, 0.50353838f, 0.50883014f, 0.51410274f, 0.51935599f,
+    0.52458968f, 0.52980362f, 0.53499762f, 0.54017147f, 0.54532499f, 0.55045797f,
+    0.55557023f, 0.56066158f, 0.56573181f, 0.57078075f, 0.57580819f, 0.58081396f,
+    0.58579786f, 0.59075970f, 0.59569930f, 0.60061648f, 0.60551104f, 0.61038281f,
+    0.61523159f, 0.62005721f, 0.62485949f, 0.62963824f, 0.63439328f, 0.63912444f,
+    0.64383154f, 0.64851440f, 0.65317284f, 0.65780669f, 0.66241578f, 0.66699992f,
+    0.67155895f, 0.67609270f, 0.68060100f, 0.68508367f, 0.68954054f, 0.69397146f,
+    0.69837625f, 0.70275474f, 0.70710678f, 0.71143220f, 0.71573083f, 0.72000251f,
+    0.72424708f, 0.72846439f, 0.73265427f, 0.73681657f, 0.74095113f, 0.74505779f,
+    0.74913639f, 0.75318680f, 0.75720885f, 0.76120239f, 0.76516727f, 0.76910334f,
+    0.77301045f, 0.77688847f, 0.78073723f, 0.78455660f, 0.78834643f, 0.79210658f,
+    0.79583690f, 0.79953727f, 0.80320753f, 0.80684755f, 0.81045720f, 0.81403633f,
+    0.81758481f, 0.82110251f, 0.82458930f, 0.82804505f, 0.83146961f, 0.83486287f,
+    0.83822471f, 0.84155498f, 0.84485357f, 0.84812034f, 0.85135519f, 0.85455799f,
+    0.85772861f, 0.86086694f, 0.86397286f, 0.86704625f, 0.87008699f, 0.87309498f,
+    0.87607009f, 0.87901223f, 0.88192126f, 0.88479710f, 0.88763962f, 0.89044872f,
+    0.89322430f, 0.89596625f, 0.89867447f, 0.90134885f, 0.90398929f, 0.90659570f,
+    0.90916798f, 0.91170603f, 0.91420976f, 0.91667906f, 0.91911385f, 0.92151404f,
+    0.92387953f, 0.92621024f, 0.92850608f, 0.93076696f, 0.93299280f, 0.93518351f,
+    0.93733901f, 0.93945922f, 0.94154407f, 0.94359346f, 0.94560733f, 0.94758559f,
+    0.94952818f, 0.95143502f, 0.95330604f, 0.95514117f, 0.95694034f, 0.95870347f,
+    0.96043052f, 0.96212140f, 0.96377607f, 0.96539444f, 0.96697647f, 0.96852209f,
+    0.97003125f, 0.97150389f, 0.97293995f, 0.97433938f, 0.97570213f, 0.97702814f,
+    0.97831737f, 0.97956977f, 0.98078528f, 0.98196387f, 0.98310549f, 0.98421009f,
+    0.98527764f, 0.98630810f, 0.98730142f, 0.98825757f, 0.98917651f, 0.99005821f,
+    0.99090264f, 0.99170975f, 0.99247953f, 0.99321195f, 0.99390697f, 0.99456457f,
+    0.99518473f, 0.99576741f, 0.99631261f, 0.99682030f, 0.99729046f, 0.99772307f,
+    0.99811811f, 0.99847558f, 0.99879546f, 0.99907773f, 0.99932238f, 0.99952942f,
+    0.99969882f, 0.99983058f, 0.99992470f, 0.99998118f, 1.00000000f,
+};
+
+// sin(x) for 0 <= x <= pi
+static float notch_sin(float x)
+{
+    if (x > M_PI_2) {
+        x = M_PI - x;
+    }
+    const float pos = MAX(x, 0) * (NOTCH_SIN_LUT_SIZE / M_PI_2);
+    const uint16_t i = MIN(uint16_t(pos), NOTCH_SIN_LUT_SIZE-1);
+    return notch_sin_lut[i] + (notch_sin_lut[i+1] - notch_sin_lut[i]) * (pos - i);
+}
+
+// sin and cos of omega for 0 <= omega <= pi
+static void notch_sin_cos(float omega, float &s, float &c)
+{
+    s = notch_sin(omega);
+    c = omega <= M_PI_2 ? notch_sin(M_PI_2 - omega) : -notch_sin(omega - M_PI_2);
+}
+#else
+static void notch_sin_cos(float omega, float &s, float &c)
+{
+    s = sinf(omega);
+    c = cosf(omega);
+}
+#endif // AP_FILTER_NOTCH_TRIG_LUT_ENABLED
+
 /*
    calculate the attenuation and quality factors of the filter
  */
@@ -55,14 +133,15 @@ void NotchFilter<T>::init(float sample_freq_hz, float center_freq_hz, float band
 }
 
 template <class T>
-void NotchFilter<T>::init_with_A_and_Q(float sample_freq_hz, float center_freq_hz, float A, float Q)
+bool NotchFilter<T>::init_with_A_and_Q(float sample_freq_hz, float center_freq_hz, float A, float Q)
 {
-    // don't update if no updates required
+    // don't update if no updates required. Changes in center frequency
+    // smaller than AP_FILTER_NOTCH_FREQ_CHANGE_RATIO keep the current coefficients
     if (initialised &&
-        is_equal(center_freq_hz, _center_freq_hz) &&
+        fabsf(center_freq_hz - _center_freq_hz) <= _center_freq_hz * AP_FILTER_NOTCH_FREQ_CHANGE_RATIO &&
         is_equal(sample_freq_hz, _sample_freq_hz) &&
         is_equal(A, _A)) {
-        return;
+        return false;
     }
 
     float new_center_freq = center_freq_hz;
@@ -75,9 +154,11 @@ void NotchFilter<T>::init_with_A_and_Q(float sample_freq_hz, float center_freq_h
 
     if (is_positive(new_center_freq) && (new_center_freq < 0.5 * sample_freq_hz) && (Q > 0.0)) {
         float omega = 2.0 * M_PI * new_center_freq / sample_freq_hz;
-        float alpha = sinf(omega) / (2 * Q);
+        float sin_omega, cos_omega;
+        notch_sin_cos(omega, sin_omega, cos_omega);
+        float alpha = sin_omega / (2 * Q);
         b0 =  1.0 + alpha*sq(A);
-        b1 = -2.0 * cosf(omega);
+        b1 = -2.0 * cos_omega;
         b2 =  1.0 - alpha*sq(A);
         a1 = b1;
         a2 =  1.0 - alpha;
@@ -99,6 +180,7 @@ void NotchFilter<T>::init_with_A_and_Q(float sample_freq_hz, float center_freq_h
         // leave center_freq_hz at last value
         initialised = false;
     }
+    return true;
 }
 
 /*
@@ -128,6 +210,45 @@ T NotchFilter<T>::apply(const T &sample)
     return output;
 }
 
+/*
+  the same as apply() on each sample, with the coefficients and delayed
+  samples held in locals for the whole batch
+ */
+template <class T>
+void NotchFilter<T>::apply_batch(const T *in, T *out, uint16_t n)
+{
+    uint16_t i = 0;
+    if (n > 0 && need_reset) {
+        out[0] = apply(in[0]);
+        i = 1;
+    }
+    if (!initialised) {
+        for (; i < n; i++) {
+            out[i] = apply(in[i]);
+        }
+        return;
+    }
+
+    const float _b0 = b0, _b1 = b1, _b2 = b2, _a1 = a1, _a2 = a2;
+    T x1 = ntchsig1, x2 = ntchsig2;
+    T y1 = signal1, y2 = signal2;
+
+    for (; i < n; i++) {
+        const T sample = in[i];
+        const T output = sample*_b0 + x1*_b1 + x2*_b2 - y1*_a1 - y2*_a2;
+        x2 = x1;
+        x1 = sample;
+        y2 = y1;
+        y1 = output;
+        out[i] = output;
+    }
+
+    ntchsig1 = x1;
+    ntchsig2 = x2;
+    signal1 = y1;
+    signal2 = y2;
+}
+
 template <class T>
 void NotchFilter<T>::reset()
 {
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <inttypes.h>
 #include <AP_Param/AP_Param.h>
+#include "AP_Filter_config.h"
 
 
 template <class T>
@@ -35,8 +36,11 @@ public:
     friend class HarmonicNotchFilter<T>;
     // set parameters
     void init(float sample_freq_hz, float center_freq_hz, float bandwidth_hz, float attenuation_dB);
-    void init_with_A_and_Q(float sample_freq_hz, float center_freq_hz, float A, float Q);
+    // returns false if the change was too small to recalculate the coefficients
+    bool init_with_A_and_Q(float sample_freq_hz, float center_freq_hz, float A, float Q);
     T apply(const T &sample);
+    // apply n samples in turn, out may be the same array as in
+    void apply_batch(const T *in, T *out, uint16_t n);
     void reset();
     float center_freq_hz() const { return _center_freq_hz; }
     float sample_freq_hz() const { return _sample_freq_hz; }
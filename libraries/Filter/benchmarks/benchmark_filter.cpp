@@ -0,0 +1,130 @@
+#include <AP_gbenchmark.h>
+
+#include <Filter/LowPassFilter2p.h>
+#include <Filter/NotchFilter.h>
+#include <Filter/HarmonicNotchFilter.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  the gyro filter chain run on every IMU sample. The input is a fixed
+  gyro-like signal, slow body motion plus motor noise at 180Hz and its
+  harmonics, sampled at 2kHz
+ */
+
+#define FILTER_RATE_HZ 2000
+#define FILTER_NUM_SAMPLES 1024
+
+static Vector3f samples[FILTER_NUM_SAMPLES];
+
+static void fill_samples()
+{
+    for (uint16_t i = 0; i < FILTER_NUM_SAMPLES; i++) {
+        const float t = float(i) / FILTER_RATE_HZ;
+        const float motion = 0.5f * sinf(M_2PI * 2.0f * t);
+        const float noise = 0.2f * sinf(M_2PI * 180.0f * t) + 0.1f * sinf(M_2PI * 360.0f * t) + 0.05f * sinf(M_2PI * 540.0f * t);
+        samples[i] = Vector3f{motion + noise, -motion + 0.7f * noise, 0.3f * motion - noise};
+    }
+}
+
+static void BM_LowPassFilter2pFloat(benchmark::State& state)
+{
+    fill_samples();
+    LowPassFilter2pFloat filter{FILTER_RATE_HZ, 80};
+    uint16_t i = 0;
+
+    while (state.KeepRunning()) {
+        float out = filter.apply(samples[i].x);
+        gbenchmark_escape(&out);
+        i = (i + 1) % FILTER_NUM_SAMPLES;
+    }
+}
+
+static void BM_LowPassFilter2pVector3f(benchmark::State& state)
+{
+    fill_samples();
+    LowPassFilter2pVector3f filter{FILTER_RATE_HZ, 80};
+    uint16_t i = 0;
+
+    while (state.KeepRunning()) {
+        Vector3f out = filter.apply(samples[i]);
+        gbenchmark_escape(&out);
+        i = (i + 1) % FILTER_NUM_SAMPLES;
+    }
+}
+
+static void BM_NotchFilterVector3f(benchmark::State& state)
+{
+    fill_samples();
+    NotchFilterVector3f filter;
+    filter.init(FILTER_RATE_HZ, 180, 90, 40);
+    uint16_t i = 0;
+
+    while (state.KeepRunning()) {
+        Vector3f out = filter.apply(samples[i]);
+        gbenchmark_escape(&out);
+        i = (i + 1) % FILTER_NUM_SAMPLES;
+    }
+}
+
+/*
+  a harmonic notch on the first four harmonics, one notch per motor
+  as used with ESC telemetry on a quad, with state.range(0) of 1 for a
+  single notch or 2 for a double notch
+ */
+static void BM_HarmonicNotchFilterVector3f(benchmark::State& state)
+{
+    fill_samples();
+    HarmonicNotchFilterParams params {};
+    params.set_options(state.range(0) == 2 ? uint16_t(HarmonicNotchFilterParams::Options::DoubleNotch) : 0);
+    params.set_attenuation(40);
+    params.set_bandwidth_hz(90);
+    params.set_center_freq_hz(180);
+    params.set_freq_min_ratio(1.0);
+
+    const uint8_t num_motors = 4;
+    const float motor_freq_hz[num_motors] { 175, 180, 185, 190 };
+    HarmonicNotchFilterVector3f filter;
+    filter.allocate_filters(num_motors, 0x0F, params.num_composite_notches());
+    filter.init(FILTER_RATE_HZ, params);
+    filter.update(num_motors, motor_freq_hz);
+    uint16_t i = 0;
+
+    while (state.KeepRunning()) {
+        Vector3f out = filter.apply(samples[i]);
+        gbenchmark_escape(&out);
+        i = (i + 1) % FILTER_NUM_SAMPLES;
+    }
+}
+
+// the per-loop retune of the harmonic notch from ESC telemetry
+static void BM_HarmonicNotchFilterUpdate(benchmark::State& state)
+{
+    HarmonicNotchFilterParams params {};
+    params.set_attenuation(40);
+    params.set_bandwidth_hz(90);
+    params.set_center_freq_hz(180);
+    params.set_freq_min_ratio(1.0);
+
+    const uint8_t num_motors = 4;
+    float motor_freq_hz[num_motors] { 175, 180, 185, 190 };
+    HarmonicNotchFilterVector3f filter;
+    filter.allocate_filters(num_motors, 0x0F, params.num_composite_notches());
+    filter.init(FILTER_RATE_HZ, params);
+    uint16_t i = 0;
+
+    while (state.KeepRunning()) {
+        motor_freq_hz[i % num_motors] = 170 + (i % 40);
+        filter.update(num_motors, motor_freq_hz);
+        gbenchmark_clobber();
+        i++;
+    }
+}
+
+BENCHMARK(BM_LowPassFilter2pFloat);
+BENCHMARK(BM_LowPassFilter2pVector3f);
+BENCHMARK(BM_NotchFilterVector3f);
+BENCHMARK(BM_HarmonicNotchFilterVector3f)->Arg(1)->Arg(2);
+BENCHMARK(BM_HarmonicNotchFilterUpdate);
+
+BENCHMARK_MAIN();
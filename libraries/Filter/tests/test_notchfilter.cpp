@@ -3,6 +3,7 @@
 #include <Filter/Filter.h>
 #include <Filter/NotchFilter.h>
 #include <Filter/HarmonicNotchFilter.h>
+#include <Filter/LowPassFilter2p.h>
 
 const AP_HAL::HAL& hal = AP_HAL::get_HAL();
 
@@ -363,4 +364,145 @@ TEST(NotchFilterTest, HarmonicNotchTest5)
     fclose(f);
 }
 
+/*
+  test that small changes in center frequency keep the current coefficients
+ */
+TEST(NotchFilterTest, FreqChangeThresholdTest)
+{
+    NotchFilter<float> filter {};
+    float A, Q;
+    NotchFilter<float>::calculate_A_and_Q(100, 50, 30, A, Q);
+    EXPECT_TRUE(filter.init_with_A_and_Q(1000, 100, A, Q));
+    EXPECT_FALSE(filter.init_with_A_and_Q(1000, 100, A, Q));
+    EXPECT_FALSE(filter.init_with_A_and_Q(1000, 100 * (1 + AP_FILTER_NOTCH_FREQ_CHANGE_RATIO * 0.5), A, Q));
+    EXPECT_FLOAT_EQ(filter.center_freq_hz(), 100);
+    EXPECT_TRUE(filter.init_with_A_and_Q(1000, 101, A, Q));
+    EXPECT_FLOAT_EQ(filter.center_freq_hz(), 101);
+}
+
+/*
+  check that a Vector3f harmonic notch gives the same output as
+  applying each of its notches in turn, while notches are retuned,
+  disabled above the nyquist cutoff, re-enabled and reset
+ */
+TEST(NotchFilterTest, HarmonicNotchVectorTest)
+{
+    const float rate_hz = 1000;
+    const float base_freq = 100;
+    const float bandwidth = 50;
+    const float attenuation_dB = 30;
+    const uint8_t num_harmonics = 4;
+
+    HarmonicNotchFilterParams notch_params {};
+    notch_params.set_options(0);
+    notch_params.set_attenuation(attenuation_dB);
+    notch_params.set_bandwidth_hz(bandwidth);
+    notch_params.set_center_freq_hz(base_freq);
+    notch_params.set_freq_min_ratio(0.5);
+
+    HarmonicNotchFilter<Vector3f> filter {};
+    filter.allocate_filters(1, (1U<<num_harmonics)-1, 1);
+    filter.init(rate_hz, notch_params);
+
+    float A, Q;
+    NotchFilter<Vector3f>::calculate_A_and_Q(base_freq, bandwidth, attenuation_dB, A, Q);
+    NotchFilter<Vector3f> ref[num_harmonics] {};
+
+    for (uint32_t s=0; s<4000; s++) {
+        // sweep the fourth harmonic through the 480Hz cutoff
+        const float center = base_freq + 40 * sinf(s * 2 * M_PI / 2000);
+        filter.update(center);
+        for (uint8_t h=0; h<num_harmonics; h++) {
+            const float freq = center * (h+1);
+            if (freq >= rate_hz * 0.48) {
+                ref[h].disable();
+            } else {
+                ref[h].init_with_A_and_Q(rate_hz, freq, A, Q);
+            }
+        }
+        if (s == 2500) {
+            filter.reset();
+            for (auto &r : ref) {
+                r.reset();
+            }
+        }
+
+        const float t = s / rate_hz;
+        const Vector3f sample {
+            sinf(t * 2 * M_PI * 95),
+            0.5f * sinf(t * 2 * M_PI * 310) + 0.1f,
+            sinf(t * 2 * M_PI * 23) - 0.3f * sinf(t * 2 * M_PI * 450),
+        };
+        Vector3f expected = sample;
+        for (auto &r : ref) {
+            expected = r.apply(expected);
+        }
+        const Vector3f v = filter.apply(sample);
+        EXPECT_NEAR(v.x, expected.x, 1e-5);
+        EXPECT_NEAR(v.y, expected.y, 1e-5);
+        EXPECT_NEAR(v.z, expected.z, 1e-5);
+    }
+}
+
+/*
+  check that applying bursts of samples with apply_batch() gives the
+  same output as applying them one at a time, including across a reset
+ */
+TEST(NotchFilterTest, BatchTest)
+{
+    const float rate_hz = 1000;
+
+    HarmonicNotchFilterParams notch_params {};
+    notch_params.set_options(0);
+    notch_params.set_attenuation(30);
+    notch_params.set_bandwidth_hz(40);
+    notch_params.set_center_freq_hz(80);
+    notch_params.set_freq_min_ratio(0.5);
+
+    HarmonicNotchFilter<Vector3f> harmonic {}, harmonic_batch {};
+    harmonic.allocate_filters(1, 0x7, 1);
+    harmonic.init(rate_hz, notch_params);
+    harmonic_batch.allocate_filters(1, 0x7, 1);
+    harmonic_batch.init(rate_hz, notch_params);
+
+    NotchFilter<Vector3f> notch {}, notch_batch {};
+    notch.init(rate_hz, 120, 50, 30);
+    notch_batch.init(rate_hz, 120, 50, 30);
+
+    LowPassFilter2p<Vector3f> lpf {rate_hz, 40}, lpf_batch {rate_hz, 40};
+
+    Vector3f in[13], out[13];
+    uint32_t s = 0;
+    for (uint8_t burst=0; burst<100; burst++) {
+        const uint8_t n = 1 + burst % ARRAY_SIZE(in);
+        if (burst == 60) {
+            harmonic.reset();
+            harmonic_batch.reset();
+            notch.reset();
+            notch_batch.reset();
+            lpf.reset();
+            lpf_batch.reset();
+        }
+        for (uint8_t i=0; i<n; i++, s++) {
+            const float t = s / rate_hz;
+            in[i] = Vector3f(sinf(t * 2 * M_PI * 80),
+                             0.5f * sinf(t * 2 * M_PI * 240) + 0.1f,
+                             sinf(t * 2 * M_PI * 23) - 0.3f * sinf(t * 2 * M_PI * 120));
+        }
+
+        // filter in place, as the INS does
+        memcpy(out, in, sizeof(in));
+        harmonic_batch.apply_batch(out, out, n);
+        notch_batch.apply_batch(out, out, n);
+        lpf_batch.apply_batch(out, out, n);
+
+        for (uint8_t i=0; i<n; i++) {
+            const Vector3f expected = lpf.apply(notch.apply(harmonic.apply(in[i])));
+            EXPECT_NEAR(out[i].x, expected.x, 1e-6);
+            EXPECT_NEAR(out[i].y, expected.y, 1e-6);
+            EXPECT_NEAR(out[i].z, expected.z, 1e-6);
+        }
+    }
+}
+
 AP_GTEST_MAIN()
@@ -60,6 +60,11 @@ bool check_payload_size(mavlink_channel_t chan, uint16_t max_payload_len);
 // operator here to increment a counter.
 #define HAVE_PAYLOAD_SPACE(_chan, id) (comm_get_txspace(_chan) >= PAYLOAD_SIZE(_chan, id) ? true : (gcs_out_of_space_to_send(_chan), false))
 
+// HAVE_PAYLOAD_SPACE_BULK is HAVE_PAYLOAD_SPACE for bulk transfers,
+// such as files and logs, which are held back to keep the latency of
+// other messages down
+#define HAVE_PAYLOAD_SPACE_BULK(_chan, id) (comm_get_txspace_bulk(_chan) >= PAYLOAD_SIZE(_chan, id) ? true : (gcs_out_of_space_to_send(_chan), false))
+
 // CHECK_PAYLOAD_SIZE - macro which may only be used within a
 // GCS_MAVLink object's methods.  It inserts code which will
 // immediately return false from the current function if there is no
@@ -209,6 +214,15 @@ public:
         return MIN(_port->txspace(), 8192U);
     }
 
+    // transmit space for bulk transfers, which may be less than
+    // txspace() to keep the latency of other messages down
+    uint16_t txspace_bulk() const {
+        if (_locked) {
+            return 0;
+        }
+        return MIN(_port->txspace_bulk(), 8192U);
+    }
+
     bool check_payload_size(uint16_t max_payload_len);
 
     // this is called when we discover we'd like to send something but can't:
@@ -484,6 +498,9 @@ public:
     virtual uint64_t capabilities() const;
     uint16_t get_stream_slowdown_ms() const { return stream_slowdown_ms; }
 
+    // true if mission uploads on this link may have several item requests outstanding
+    bool mission_upload_pipelined() const { return option_enabled(Option::MISSION_UPLOAD_PIPELINE); }
+
     MAV_RESULT set_message_interval(uint32_t msg_id, int32_t interval_us);
 
 protected:
@@ -525,6 +542,7 @@ protected:
         // first bit is reserved for: MAVLINK2_SIGNING_DISABLED = (1U << 0),
         NO_FORWARD                = (1U << 1),  // don't forward MAVLink data to or from this device
         NOSTREAMOVERRIDE          = (1U << 2),  // ignore REQUEST_DATA_STREAM messages (eg. from GCSs)
+        MISSION_UPLOAD_PIPELINE   = (1U << 3),  // request several mission items at once during uploads
     };
     bool option_enabled(Option option) const {
         return options & static_cast<uint16_t>(option);
@@ -537,6 +555,13 @@ protected:
     }
     AP_Int8 options_were_converted;
 
+    // percentage of the link bandwidth streams are limited to, 0 to
+    // disable
+    AP_Int8 bw_target_pct;
+
+    // time bulk transfers may delay other messages, 0 to disable
+    AP_Int16 bulk_latency_ms;
+
     virtual void handle_command_ack(const mavlink_message_t &msg);
     void handle_set_mode(const mavlink_message_t &msg);
     void handle_command_int(const mavlink_message_t &msg);
@@ -845,6 +870,17 @@ private:
     // number of extra ms to add to slow things down for the radio
     uint16_t         stream_slowdown_ms;
 
+    // closed-loop control of the stream rates to use the target share
+    // of the link bandwidth.  Intervals of streams faster than 1Hz are
+    // multiplied by scale_pct/100
+    struct {
+        uint32_t last_update_ms;
+        uint32_t last_tx_bytes;
+        uint32_t tx_bytes_per_sec;
+        uint16_t scale_pct = 100;
+    } bw_control;
+    void update_bandwidth_control();
+
     // outbound ("deferred message") queue.
 
     // "special" messages such as heartbeat, next_param etc are stored
@@ -885,6 +921,15 @@ private:
     void find_next_bucket_to_send(uint16_t now16_ms);
     void remove_message_from_bucket(int8_t bucket, ap_message id);
 
+    // when update_send runs out of messages to send it calculates
+    // how long it is until the next deferred message or bucket can
+    // become due, and skips the scheduling until then.  The base
+    // intervals are used, so slowdowns and penalties only make the
+    // wait shorter than it could be, never longer.  Zero when not idle
+    uint16_t send_idle_start16_ms;
+    uint16_t send_idle_ms;
+    void update_send_idle(uint16_t now16_ms);
+
     // bitmask of IDs the code has spontaneously decided it wants to
     // send out.  Examples include HEARTBEAT (gcs_send_heartbeat)
     Bitmask<MSG_LAST> pushed_ap_message_ids;
@@ -1038,6 +1083,21 @@ private:
         int16_t current_session;
         uint32_t last_send_ms;
         uint8_t need_banner_send_mask;
+
+        // read-ahead of the file open for reading, nullptr if it
+        // could not be allocated
+        uint8_t *read_buf;
+        uint32_t read_buf_offset;
+        uint16_t read_buf_len;
+
+        // the whole file open for reading when the filesystem can
+        // map it without copying, used instead of read_buf
+        const uint8_t *map;
+        uint32_t map_len;
+
+        // bytes sent and start time of the current read session
+        uint32_t read_bytes;
+        uint32_t read_start_ms;
     };
     static struct ftp_state ftp;
 
@@ -1045,6 +1105,8 @@ private:
     static bool ftp_check_name_len(const struct pending_ftp &request);
     static int gen_dir_entry(char *dest, size_t space, const char * path, const struct dirent * entry); // FTP helper for emitting a dir response
     static void ftp_list_dir(struct pending_ftp &request, struct pending_ftp &response);
+    static ssize_t ftp_read(uint32_t offset, uint8_t *buf, uint16_t len);
+    static void ftp_close_file(void);
 
     bool ftp_init(void);
     void handle_file_transfer_protocol(const mavlink_message_t &msg);
@@ -1134,6 +1196,13 @@ private:
 
     uint32_t last_mavlink_stats_logged;
 
+    // time spent in update_send since the stats were last logged
+    struct {
+        uint32_t total_us;
+        uint32_t count;
+        uint16_t max_us;
+    } send_loop_stats;
+
     uint8_t last_battery_status_idx;
 
     // if we've ever sent a DISTANCE_SENSOR message out of an
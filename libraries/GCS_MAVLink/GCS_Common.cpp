@@ -912,7 +912,10 @@ void GCS_MAVLINK::handle_radio_status(const mavlink_message_t &msg)
     // use the state of the transmit buffer in the radio to
     // control the stream rate, giving us adaptive software
     // flow control
-    if (packet.txbuf < 20 && stream_slowdown_ms < 2000) {
+    if (bw_target_pct > 0) {
+        // update_bandwidth_control() uses txbuf instead
+        stream_slowdown_ms = 0;
+    } else if (packet.txbuf < 20 && stream_slowdown_ms < 2000) {
         // we are very low on space - slow down a lot
         stream_slowdown_ms += 60;
     } else if (packet.txbuf < 50 && stream_slowdown_ms < 2000) {
@@ -1241,6 +1244,13 @@ uint16_t GCS_MAVLINK::get_reschedule_interval_ms(const deferred_message_bucket_t
 
     interval_ms += stream_slowdown_ms;
 
+    // stretch the streams faster than 1Hz to keep within the target
+    // bandwidth, but not to below 1Hz.  Slower streams are mostly
+    // status which should stay fresh
+    if (bw_control.scale_pct > 100 && interval_ms < 1000) {
+        interval_ms = MIN(interval_ms * bw_control.scale_pct / 100U, 1000U);
+    }
+
     // slow most messages down if we're transfering parameters or
     // waypoints:
     if (_queued_parameter) {
@@ -1277,8 +1287,8 @@ void GCS_MAVLINK::find_next_bucket_to_send(uint16_t now16_ms)
     sending_bucket_id = no_bucket_to_send;
     uint16_t ms_before_send_next_bucket_to_send = UINT16_MAX;
     for (uint8_t i=0; i<ARRAY_SIZE(deferred_message_bucket); i++) {
-        if (deferred_message_bucket[i].ap_message_ids.count() == 0) {
-            // no entries
+        if (deferred_message_bucket[i].interval_ms == 0) {
+            // no entries; buckets are freed when they become empty
             continue;
         }
         const uint16_t interval = get_reschedule_interval_ms(deferred_message_bucket[i]);
@@ -1425,6 +1435,63 @@ int8_t GCS_MAVLINK::deferred_message_to_send_index(uint16_t now16_ms)
     return next_deferred_message_to_send_cache;
 }
 
+/*
+  measure the bytes sent per second and adjust the scaling of the
+  stream intervals to use the target share of the link bandwidth
+ */
+void GCS_MAVLINK::update_bandwidth_control()
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    const uint32_t dt_ms = now_ms - bw_control.last_update_ms;
+    if (dt_ms < 500) {
+        return;
+    }
+    const uint32_t tx_bytes = gcs_tx_bytes[chan];
+    bw_control.tx_bytes_per_sec = uint64_t(tx_bytes - bw_control.last_tx_bytes) * 1000U / dt_ms;
+    bw_control.last_tx_bytes = tx_bytes;
+    bw_control.last_update_ms = now_ms;
+
+    const uint32_t target_bytes_per_sec = _port->bw_in_bytes_per_second() * MIN(uint8_t(bw_target_pct), 100U) / 100U;
+    if (target_bytes_per_sec == 0) {
+        bw_control.scale_pct = 100;
+        return;
+    }
+
+    // the streams would use tx_bytes_per_sec*scale_pct/100 without
+    // scaling, so this scale brings them to the target
+    float scale_pct = float(bw_control.tx_bytes_per_sec) * bw_control.scale_pct / target_bytes_per_sec;
+    if (now_ms - last_radio_status.received_ms < 5000 && last_radio_status.txbuf < 50) {
+        // the radio can't keep up, whatever the byte rate says
+        scale_pct = MAX(scale_pct, bw_control.scale_pct * 1.2f);
+    }
+    // move half way to the new scale each update to avoid oscillating
+    scale_pct = 0.5f * (scale_pct + bw_control.scale_pct);
+    bw_control.scale_pct = constrain_float(scale_pct, 100, 1000);
+}
+
+// called when there is nothing to send; nothing can become due
+// before the soonest base interval of the deferred messages and
+// buckets has passed
+void GCS_MAVLINK::update_send_idle(uint16_t now16_ms)
+{
+    uint16_t idle_ms = UINT16_MAX;
+    if (next_deferred_message_to_send_cache != -1) {
+        const deferred_message_t &deferred = deferred_message[next_deferred_message_to_send_cache];
+        const uint16_t ms_since_last_sent = now16_ms - deferred.last_sent_ms;
+        idle_ms = ms_since_last_sent < deferred.interval_ms ? deferred.interval_ms - ms_since_last_sent : 0;
+    }
+    for (const auto &bucket : deferred_message_bucket) {
+        if (bucket.interval_ms == 0) {
+            continue;
+        }
+        const uint16_t ms_since_last_sent = now16_ms - bucket.last_sent_ms;
+        const uint16_t ms_before_due = ms_since_last_sent < bucket.interval_ms ? bucket.interval_ms - ms_since_last_sent : 0;
+        idle_ms = MIN(idle_ms, ms_before_due);
+    }
+    send_idle_start16_ms = now16_ms;
+    send_idle_ms = idle_ms;
+}
+
 bool GCS_MAVLINK_InProgress::send_ack(MAV_RESULT result)
 {
     if (!HAVE_PAYLOAD_SPACE(chan, COMMAND_ACK)) {
@@ -1551,6 +1618,8 @@ void GCS_MAVLINK_InProgress::check_tasks()
 
 void GCS_MAVLINK::update_send()
 {
+    _port->set_bulk_latency_ms(MAX(bulk_latency_ms.get(), 0));
+
 #if HAL_LOGGING_ENABLED
     if (!hal.scheduler->in_delay_callback()) {
         // AP_Logger will not send log data if we are armed.
@@ -1565,8 +1634,11 @@ void GCS_MAVLINK::update_send()
         deferred_messages_initialised = true;
     }
 
+    update_bandwidth_control();
+
+    const uint32_t send_loop_start_us = AP_HAL::micros();
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
-    uint32_t retry_deferred_body_start = AP_HAL::micros();
+    uint32_t retry_deferred_body_start = send_loop_start_us;
 #endif
 
     // check for any in-progress tasks; check_tasks does its own rate-limiting
@@ -1574,7 +1646,11 @@ void GCS_MAVLINK::update_send()
 
     const uint32_t start = AP_HAL::millis();
     const uint16_t start16 = start & 0xFFFF;
-    while (AP_HAL::millis() - start < 5) { // spend a max of 5ms sending messages.  This should never trigger - out_of_time() should become true
+    // nothing scheduled can be due yet if we are still within the
+    // idle time calculated when we last ran out of things to send
+    const bool idle = uint16_t(start16 - send_idle_start16_ms) < send_idle_ms &&
+        pushed_ap_message_ids.empty();
+    while (!idle && AP_HAL::millis() - start < 5) { // spend a max of 5ms sending messages.  This should never trigger - out_of_time() should become true
         if (gcs().out_of_time()) {
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
             try_send_message_stats.out_of_time++;
@@ -1640,7 +1716,7 @@ void GCS_MAVLINK::update_send()
                 break;
             }
             bucket_message_ids_to_send.clear(next);
-            if (bucket_message_ids_to_send.count() == 0) {
+            if (bucket_message_ids_to_send.empty()) {
                 // we sent everything in the bucket.  Reschedule it.
                 // we try to keep output on a regular clock to avoid
                 // user support questions:
@@ -1662,6 +1738,8 @@ void GCS_MAVLINK::update_send()
 #endif
             continue;
         }
+        // nothing to send
+        update_send_idle(start16);
         break;
     }
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
@@ -1678,12 +1756,17 @@ void GCS_MAVLINK::update_send()
     // between the last pass through here
     send_packet_count += uint8_t(_channel_status.current_tx_seq - last_tx_seq);
     last_tx_seq = _channel_status.current_tx_seq;
+
+    const uint32_t send_loop_us = AP_HAL::micros() - send_loop_start_us;
+    send_loop_stats.total_us += send_loop_us;
+    send_loop_stats.max_us = MAX(send_loop_stats.max_us, uint16_t(MIN(send_loop_us, UINT16_MAX)));
+    send_loop_stats.count++;
 }
 
 void GCS_MAVLINK::remove_message_from_bucket(int8_t bucket, ap_message id)
 {
     deferred_message_bucket[bucket].ap_message_ids.clear(id);
-    if (deferred_message_bucket[bucket].ap_message_ids.count() == 0) {
+    if (deferred_message_bucket[bucket].ap_message_ids.empty()) {
         // bucket empty.  Free it:
         deferred_message_bucket[bucket].interval_ms = 0;
         deferred_message_bucket[bucket].last_sent_ms = 0;
@@ -1691,7 +1774,7 @@ void GCS_MAVLINK::remove_message_from_bucket(int8_t bucket, ap_message id)
 
     if (bucket == sending_bucket_id) {
         bucket_message_ids_to_send.clear(id);
-        if (bucket_message_ids_to_send.count() == 0) {
+        if (bucket_message_ids_to_send.empty()) {
             find_next_bucket_to_send(AP_HAL::millis16());
         } else {
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
@@ -1724,11 +1807,15 @@ bool GCS_MAVLINK::set_ap_message_interval(enum ap_message id, uint16_t interval_
     interval_ms = cap_message_interval(interval_ms);
 #endif
 
+    // the schedule is changing, recalculate the idle time
+    send_idle_ms = 0;
+
     // check if it's a specially-handled message:
     const int8_t deferred_offset = get_deferred_message_index(id);
     if (deferred_offset != -1) {
         deferred_message[deferred_offset].interval_ms = interval_ms;
         deferred_message[deferred_offset].last_sent_ms = AP_HAL::millis16();
+        next_deferred_message_to_send_cache = -1;
         return true;
     }
 
@@ -1914,10 +2001,28 @@ GCS_MAVLINK::update_receive(uint32_t max_time_us)
 
     status.packet_rx_drop_count = 0;
 
-    const uint16_t nbytes = _port->available();
-    for (uint16_t i=0; i<nbytes; i++)
+    /*
+      parse in place from the port's receive buffer if it supports
+      it, consuming what was parsed in one call at the end rather
+      than paying for a read() per byte
+     */
+    uint16_t nbytes = _port->available();
+    ByteBuffer::IoVec vec[2];
+    const uint8_t nvec = _port->peek_iovec(vec, nbytes);
+    if (nvec > 0) {
+        nbytes = vec[0].len + (nvec > 1 ? vec[1].len : 0);
+    }
+    uint16_t i;
+    for (i=0; i<nbytes; i++)
     {
-        const uint8_t c = (uint8_t)_port->read();
+        uint8_t c;
+        if (nvec == 0) {
+            c = (uint8_t)_port->read();
+        } else if (i < vec[0].len) {
+            c = vec[0].data[i];
+        } else {
+            c = vec[1].data[i - vec[0].len];
+        }
         const uint32_t protocol_timeout = 4000;
         
         if (alternative.handler &&
@@ -1967,10 +2072,15 @@ GCS_MAVLINK::update_receive(uint32_t max_time_us)
         if (parsed_packet || i % 100 == 0) {
             // make sure we don't spend too much time parsing mavlink messages
             if (AP_HAL::micros() - tstart_us > max_time_us) {
+                // byte i has been parsed
+                i++;
                 break;
             }
         }
     }
+    if (nvec > 0) {
+        _port->consume(i);
+    }
 
     const uint32_t tnow = AP_HAL::millis();
 
@@ -2106,7 +2216,12 @@ void GCS_MAVLINK::log_mavlink_stats()
     stream_slowdown_ms     : stream_slowdown_ms,
     times_full             : out_of_space_to_send_count,
     GCS_SYSID_last_seen_ms : _sysid_gcs_last_seen_time_ms,
+    send_loop_avg_us       : uint16_t(send_loop_stats.count ? send_loop_stats.total_us / send_loop_stats.count : 0),
+    send_loop_max_us       : send_loop_stats.max_us,
+    tx_bytes_per_sec       : bw_control.tx_bytes_per_sec,
+    bw_scale_pct           : bw_control.scale_pct,
     };
+    send_loop_stats = {};
 
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
 }
@@ -2755,6 +2870,8 @@ void GCS::update_send()
 
     service_statustext();
 
+    GCS_MAVLINK::routing.update();
+
     first_backend_to_send++;
     if (first_backend_to_send >= num_gcs()) {
         first_backend_to_send = 0;
@@ -5981,45 +6098,87 @@ void GCS_MAVLINK::send_extended_sys_state() const
     mavlink_msg_extended_sys_state_send(chan, vtol_state(), landed_state());
 }
 
+#if AP_AHRS_ENABLED
+/*
+  messages which are the same on every channel are packed by the
+  first channel to send them in a scheduler tick, and the other
+  channels sending them in that tick reuse the packet rather than
+  querying the AHRS again.  Each channel still adds its own sequence
+  number and signature when the message is finalised
+ */
+template <typename T>
+struct GCS_SharedMessage {
+    T packet;
+    uint32_t tick;
+    bool valid;
+
+    // returns true if packet was filled in earlier in this tick
+    bool current() const {
+#if AP_SCHEDULER_ENABLED
+        // the scheduler does not tick while in the delay callback
+        return valid && !hal.scheduler->in_delay_callback() && tick == AP::scheduler().ticks32();
+#else
+        return false;
+#endif
+    }
+    // mark packet as filled in for this tick
+    void update() {
+#if AP_SCHEDULER_ENABLED
+        tick = AP::scheduler().ticks32();
+        valid = true;
+#endif
+    }
+};
+
+static GCS_SharedMessage<mavlink_attitude_t> shared_attitude;
+static GCS_SharedMessage<mavlink_attitude_quaternion_t> shared_attitude_quaternion;
+static GCS_SharedMessage<mavlink_global_position_int_t> shared_global_position_int;
+static Location shared_global_position_int_loc;
+#endif  // AP_AHRS_ENABLED
+
 void GCS_MAVLINK::send_attitude() const
 {
 #if AP_AHRS_ENABLED
-    const AP_AHRS &ahrs = AP::ahrs();
-    const Vector3f omega = ahrs.get_gyro();
-    mavlink_msg_attitude_send(
-        chan,
-        AP_HAL::millis(),
-        ahrs.get_roll_rad(),
-        ahrs.get_pitch_rad(),
-        ahrs.get_yaw_rad(),
-        omega.x,
-        omega.y,
-        omega.z);
+    mavlink_attitude_t &packet = shared_attitude.packet;
+    if (!shared_attitude.current()) {
+        const AP_AHRS &ahrs = AP::ahrs();
+        const Vector3f omega = ahrs.get_gyro();
+        packet.time_boot_ms = AP_HAL::millis();
+        packet.roll = ahrs.get_roll_rad();
+        packet.pitch = ahrs.get_pitch_rad();
+        packet.yaw = ahrs.get_yaw_rad();
+        packet.rollspeed = omega.x;
+        packet.pitchspeed = omega.y;
+        packet.yawspeed = omega.z;
+        shared_attitude.update();
+    }
+    mavlink_msg_attitude_send_struct(chan, &packet);
 #endif
 }
 
 void GCS_MAVLINK::send_attitude_quaternion() const
 {
 #if AP_AHRS_ENABLED
-    const AP_AHRS &ahrs = AP::ahrs();
-    Quaternion quat;
-    if (!ahrs.get_quaternion(quat)) {
-        return;
+    mavlink_attitude_quaternion_t &packet = shared_attitude_quaternion.packet;
+    if (!shared_attitude_quaternion.current()) {
+        const AP_AHRS &ahrs = AP::ahrs();
+        Quaternion quat;
+        if (!ahrs.get_quaternion(quat)) {
+            return;
+        }
+        const Vector3f omega = ahrs.get_gyro();
+        packet.time_boot_ms = AP_HAL::millis();
+        packet.q1 = quat.q1;
+        packet.q2 = quat.q2;
+        packet.q3 = quat.q3;
+        packet.q4 = quat.q4;
+        packet.rollspeed = omega.x;
+        packet.pitchspeed = omega.y;
+        packet.yawspeed = omega.z;
+        // repr_offset_q is left zero; unused, but probably should correspond to the AHRS view?
+        shared_attitude_quaternion.update();
     }
-    const Vector3f omega = ahrs.get_gyro();
-    const float repr_offseq_q[] {0,0,0,0};  // unused, but probably should correspond to the AHRS view?
-    mavlink_msg_attitude_quaternion_send(
-        chan,
-        AP_HAL::millis(),
-        quat.q1,
-        quat.q2,
-        quat.q3,
-        quat.q4,
-        omega.x, // rollspeed
-        omega.y, // pitchspeed
-        omega.z, // yawspeed
-        repr_offseq_q
-        );
+    mavlink_msg_attitude_quaternion_send_struct(chan, &packet);
 #endif
 }
 
@@ -6040,6 +6199,14 @@ int32_t GCS_MAVLINK::global_position_int_relative_alt() const {
 void GCS_MAVLINK::send_global_position_int()
 {
 #if AP_AHRS_ENABLED
+    mavlink_global_position_int_t &packet = shared_global_position_int.packet;
+    if (shared_global_position_int.current()) {
+        // keep this channel's cached location in step with the packet
+        global_position_current_loc = shared_global_position_int_loc;
+        mavlink_msg_global_position_int_send_struct(chan, &packet);
+        return;
+    }
+
     AP_AHRS &ahrs = AP::ahrs();
 
     UNUSED_RESULT(ahrs.get_location(global_position_current_loc)); // return value ignored; we send stale data
@@ -6049,17 +6216,19 @@ void GCS_MAVLINK::send_global_position_int()
         vel.zero();
     }
 
-    mavlink_msg_global_position_int_send(
-        chan,
-        AP_HAL::millis(),
-        global_position_current_loc.lat, // in 1E7 degrees
-        global_position_current_loc.lng, // in 1E7 degrees
-        global_position_int_alt(),       // millimeters above ground/sea level
-        global_position_int_relative_alt(), // millimeters above home
-        vel.x * 100,                     // X speed cm/s (+ve North)
-        vel.y * 100,                     // Y speed cm/s (+ve East)
-        vel.z * 100,                     // Z speed cm/s (+ve Down)
-        ahrs.yaw_sensor);                // compass heading in 1/100 degree
+    packet.time_boot_ms = AP_HAL::millis();
+    packet.lat = global_position_current_loc.lat;           // in 1E7 degrees
+    packet.lon = global_position_current_loc.lng;           // in 1E7 degrees
+    packet.alt = global_position_int_alt();                 // millimeters above ground/sea level
+    packet.relative_alt = global_position_int_relative_alt(); // millimeters above home
+    packet.vx = vel.x * 100;                                // X speed cm/s (+ve North)
+    packet.vy = vel.y * 100;                                // Y speed cm/s (+ve East)
+    packet.vz = vel.z * 100;                                // Z speed cm/s (+ve Down)
+    packet.hdg = ahrs.yaw_sensor;                           // compass heading in 1/100 degree
+    shared_global_position_int_loc = global_position_current_loc;
+    shared_global_position_int.update();
+
+    mavlink_msg_global_position_int_send_struct(chan, &packet);
 #endif  // AP_AHRS_ENABLED
 }
 
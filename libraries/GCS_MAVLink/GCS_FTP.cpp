@@ -26,6 +26,7 @@
 #include <AP_Filesystem/AP_Filesystem.h>
 #include <AP_HAL/utility/sparse-endian.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
+#include <AP_Logger/AP_Logger.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -34,6 +35,16 @@ struct GCS_MAVLINK::ftp_state GCS_MAVLINK::ftp;
 // timeout for session inactivity
 #define FTP_SESSION_TIMEOUT 3000
 
+// size of the read-ahead buffer for files being read
+#ifndef FTP_READ_AHEAD_SIZE
+#define FTP_READ_AHEAD_SIZE 4096
+#endif
+
+// the largest burst read sent for one request
+#ifndef FTP_BURST_MAX_BYTES
+#define FTP_BURST_MAX_BYTES (256*1024UL)
+#endif
+
 bool GCS_MAVLINK::ftp_init(void) {
 
     // check if ftp is disabled for memory savings
@@ -101,7 +112,7 @@ bool GCS_MAVLINK::send_ftp_reply(const pending_ftp &reply)
         return false;
     }
     WITH_SEMAPHORE(comm_chan_lock(reply.chan));
-    if (!HAVE_PAYLOAD_SPACE(chan, FILE_TRANSFER_PROTOCOL)) {
+    if (!HAVE_PAYLOAD_SPACE_BULK(chan, FILE_TRANSFER_PROTOCOL)) {
         return false;
     }
     uint8_t payload[251] = {};
@@ -233,8 +244,7 @@ void GCS_MAVLINK::ftp_worker(void) {
                 // if a new session appears and the old session has
                 // been idle for more than the timeout then force
                 // close the old session
-                AP::FS().close(ftp.fd);
-                ftp.fd = -1;
+                ftp_close_file();
                 ftp.current_session = -1;
             }
             // dispatch the command as needed
@@ -246,8 +256,7 @@ void GCS_MAVLINK::ftp_worker(void) {
                 case FTP_OP::ResetSessions:
                     // we already handled this, just listed for completeness
                     if (ftp.fd != -1) {
-                        AP::FS().close(ftp.fd);
-                        ftp.fd = -1;
+                        ftp_close_file();
                     }
                     ftp.current_session = -1;
                     reply.opcode = FTP_OP::Ack;
@@ -262,8 +271,7 @@ void GCS_MAVLINK::ftp_worker(void) {
                             // no activity for 3s, assume client has
                             // timed out receiving open reply, close
                             // the file
-                            AP::FS().close(ftp.fd);
-                            ftp.fd = -1;
+                            ftp_close_file();
                             ftp.current_session = -1;
                         }
                         if (ftp.fd != -1) {
@@ -295,6 +303,16 @@ void GCS_MAVLINK::ftp_worker(void) {
                         }
                         ftp.mode = FTP_FILE_MODE::Read;
                         ftp.current_session = request.session;
+                        if (file_size > 0 && AP::FS().mmap_zero_copy(ftp.fd)) {
+                            ftp.map = AP::FS().mmap(ftp.fd, 0, file_size);
+                            ftp.map_len = ftp.map != nullptr ? file_size : 0;
+                        }
+                        if (ftp.map == nullptr) {
+                            ftp.read_buf = NEW_NOTHROW uint8_t[FTP_READ_AHEAD_SIZE];
+                        }
+                        ftp.read_buf_len = 0;
+                        ftp.read_bytes = 0;
+                        ftp.read_start_ms = now;
 
                         reply.opcode = FTP_OP::Ack;
                         reply.size = sizeof(uint32_t);
@@ -320,14 +338,8 @@ void GCS_MAVLINK::ftp_worker(void) {
                             break;
                         }
 
-                        // seek to requested offset
-                        if (AP::FS().lseek(ftp.fd, request.offset, SEEK_SET) == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
-
                         // fill the buffer
-                        const ssize_t read_bytes = AP::FS().read(ftp.fd, reply.data, MIN(sizeof(reply.data),request.size));
+                        const ssize_t read_bytes = ftp_read(request.offset, reply.data, MIN(sizeof(reply.data),request.size));
                         if (read_bytes == -1) {
                             ftp_error(reply, FTP_ERROR::FailErrno);
                             break;
@@ -336,6 +348,7 @@ void GCS_MAVLINK::ftp_worker(void) {
                             ftp_error(reply, FTP_ERROR::EndOfFile);
                             break;
                         }
+                        ftp.read_bytes += read_bytes;
 
                         reply.opcode = FTP_OP::Ack;
                         reply.offset = request.offset;
@@ -485,12 +498,6 @@ void GCS_MAVLINK::ftp_worker(void) {
                             break;
                         }
 
-                        // seek to requested offset
-                        if (AP::FS().lseek(ftp.fd, request.offset, SEEK_SET) == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
-
                         /*
                           calculate a burst delay so that FTP burst
                           transfer doesn't use more than 1/3 of
@@ -509,11 +516,14 @@ void GCS_MAVLINK::ftp_worker(void) {
                             }
                         }
 
-                        // this transfer size is enough for a full parameter file with max parameters
-                        const uint32_t transfer_size = 500;
+                        // 500 packets is enough for a full parameter file
+                        // with max parameters. Larger files such as logs
+                        // get longer bursts to cut the number of request
+                        // round trips
+                        const uint32_t transfer_size = MAX(500U, FTP_BURST_MAX_BYTES / max_read);
                         for (uint32_t i = 0; (i < transfer_size); i++) {
                             // fill the buffer
-                            const ssize_t read_bytes = AP::FS().read(ftp.fd, reply.data, MIN(sizeof(reply.data), max_read));
+                            const ssize_t read_bytes = ftp_read(request.offset + i * max_read, reply.data, MIN(sizeof(reply.data), max_read));
                             if (read_bytes == -1) {
                                 ftp_error(reply, FTP_ERROR::FailErrno);
                                 break;
@@ -535,6 +545,7 @@ void GCS_MAVLINK::ftp_worker(void) {
                             reply.size = (uint8_t)read_bytes;
 
                             ftp_push_replies(reply);
+                            ftp.read_bytes += read_bytes;
 
                             if (read_bytes < max_read) {
                                 // ensure the NACK which we send next is at the right offset
@@ -594,6 +605,83 @@ void GCS_MAVLINK::ftp_worker(void) {
     }
 }
 
+/*
+  read from the file open for reading. Reads are served from a
+  read-ahead buffer, so a burst or a run of sequential requests turns
+  into a few large filesystem reads instead of one small seek and read
+  per packet, which is much faster on microSD. Where the filesystem
+  can map the file it is copied straight from the mapping
+ */
+ssize_t GCS_MAVLINK::ftp_read(uint32_t offset, uint8_t *buf, uint16_t len)
+{
+    if (ftp.map != nullptr) {
+        if (offset >= ftp.map_len) {
+            return 0;
+        }
+        const uint16_t n = MIN(uint32_t(len), ftp.map_len - offset);
+        memcpy(buf, &ftp.map[offset], n);
+        return n;
+    }
+    if (ftp.read_buf == nullptr) {
+        if (AP::FS().lseek(ftp.fd, offset, SEEK_SET) == -1) {
+            return -1;
+        }
+        return AP::FS().read(ftp.fd, buf, len);
+    }
+    if (offset < ftp.read_buf_offset ||
+        offset + len > ftp.read_buf_offset + ftp.read_buf_len) {
+        // refill, starting on a sector boundary
+        const uint32_t start = offset & ~511U;
+        ftp.read_buf_len = 0;
+        if (AP::FS().lseek(ftp.fd, start, SEEK_SET) == -1) {
+            return -1;
+        }
+        const ssize_t n = AP::FS().read(ftp.fd, ftp.read_buf, FTP_READ_AHEAD_SIZE);
+        if (n == -1) {
+            return -1;
+        }
+        ftp.read_buf_offset = start;
+        ftp.read_buf_len = n;
+    }
+    if (offset >= ftp.read_buf_offset + ftp.read_buf_len) {
+        // end of file
+        return 0;
+    }
+    const uint16_t n = MIN(uint32_t(len), ftp.read_buf_offset + ftp.read_buf_len - offset);
+    memcpy(buf, &ftp.read_buf[offset - ftp.read_buf_offset], n);
+    return n;
+}
+
+// close the open file, logging the throughput of any read
+void GCS_MAVLINK::ftp_close_file(void)
+{
+#if HAL_LOGGING_ENABLED
+    if (ftp.read_bytes > 0) {
+        const uint32_t dt_ms = MAX(AP_HAL::millis() - ftp.read_start_ms, 1U);
+        // @LoggerMessage: FTPR
+        // @Description: MAVLink FTP file read throughput
+        // @Field: TimeUS: Time since system startup
+        // @Field: Bytes: bytes of the file sent
+        // @Field: Rate: average rate the file was sent at
+        AP::logger().WriteStreaming("FTPR", "TimeUS,Bytes,Rate", "sbB", "F00", "QII",
+                                    AP_HAL::micros64(),
+                                    ftp.read_bytes,
+                                    uint32_t(uint64_t(ftp.read_bytes) * 1000U / dt_ms));
+    }
+#endif
+    ftp.read_bytes = 0;
+    delete[] ftp.read_buf;
+    ftp.read_buf = nullptr;
+    ftp.read_buf_len = 0;
+    if (ftp.map != nullptr) {
+        AP::FS().munmap(ftp.fd, ftp.map, ftp.map_len);
+        ftp.map = nullptr;
+        ftp.map_len = 0;
+    }
+    AP::FS().close(ftp.fd);
+    ftp.fd = -1;
+}
+
 // calculates how much string length is needed to fit this in a list response
 int GCS_MAVLINK::gen_dir_entry(char *dest, size_t space, const char *path, const struct dirent * entry) {
 #if AP_FILESYSTEM_HAVE_DIRENT_DTYPE
@@ -71,6 +71,7 @@ mavlink_status_t* mavlink_get_channel_status(uint8_t chan) {
 
 AP_HAL::UARTDriver	*mavlink_comm_port[MAVLINK_COMM_NUM_BUFFERS];
 bool gcs_alternative_active[MAVLINK_COMM_NUM_BUFFERS];
+uint32_t gcs_tx_bytes[MAVLINK_COMM_NUM_BUFFERS];
 
 // per-channel lock
 static HAL_Semaphore chan_locks[MAVLINK_COMM_NUM_BUFFERS];
@@ -127,6 +128,16 @@ uint16_t comm_get_txspace(mavlink_channel_t chan)
     return link->txspace();
 }
 
+/// Check for available transmit space for bulk transfers
+uint16_t comm_get_txspace_bulk(mavlink_channel_t chan)
+{
+    GCS_MAVLINK *link = gcs().chan(chan);
+    if (link == nullptr) {
+        return 0;
+    }
+    return link->txspace_bulk();
+}
+
 /*
   send a buffer out a MAVLink channel
  */
@@ -147,6 +158,7 @@ void comm_send_buffer(mavlink_channel_t chan, const uint8_t *buf, uint8_t len)
         return;
     }
     const size_t written = mavlink_comm_port[chan]->write(buf, len);
+    gcs_tx_bytes[chan] += written;
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
     if (written < len && !mavlink_comm_port[chan]->is_write_locked()) {
         AP_HAL::panic("Short write on UART: %lu < %u", (unsigned long)written, len);
@@ -212,7 +212,7 @@ const AP_Param::GroupInfo GCS_MAVLINK::var_info[] = {
     // @Description: Bitmask for configuring this telemetry channel. For having effect on all channels, set the relevant mask in all MAVx_OPTIONS parameters. Keep in mind that part of the flags may require a reboot to take action.
     // @RebootRequired: True
     // @User: Standard
-    // @Bitmask: 1:Don't forward mavlink to/from, 2:Ignore Streamrate
+    // @Bitmask: 1:Don't forward mavlink to/from, 2:Ignore Streamrate, 3:Pipeline mission uploads
     AP_GROUPINFO("_OPTIONS",   20, GCS_MAVLINK, options, 0),
 
     // PARAMETER_CONVERSION - Added: May-2025 for ArduPilot-4.7
@@ -220,6 +220,22 @@ const AP_Param::GroupInfo GCS_MAVLINK::var_info[] = {
     // This allows one time conversion while allowing user to flash between versions with and without converted params
     AP_GROUPINFO_FLAGS("_OPTIONSCNV",   21, GCS_MAVLINK, options_were_converted, 0, AP_PARAM_FLAG_HIDDEN),
 
+    // @Param: _BW_PCT
+    // @DisplayName: Target bandwidth use
+    // @Description: Percentage of the bandwidth of this telemetry channel to use. When non-zero the rate of the streams faster than 1Hz is adjusted to keep the bytes sent per second at this share of the link's bandwidth, and when a radio reports its transmit buffer is filling up. Slower streams and status messages are not slowed down. This replaces the slowdown from RADIO_STATUS. Zero uses the stream rates as set.
+    // @Units: %
+    // @Range: 0 100
+    // @User: Advanced
+    AP_GROUPINFO("_BW_PCT",   22, GCS_MAVLINK, bw_target_pct, 0),
+
+    // @Param: _BULK_LAT
+    // @DisplayName: Bulk transfer latency
+    // @Description: Longest time file transfers, log downloads, log streaming and parameter downloads may delay other messages on this telemetry channel. Bulk messages are only queued while the data already queued can be sent in this time, so heartbeats, command acknowledgements and control messages are never queued behind more than this much bulk data. Zero queues bulk messages like any other.
+    // @Units: ms
+    // @Range: 0 2000
+    // @User: Advanced
+    AP_GROUPINFO("_BULK_LAT",   23, GCS_MAVLINK, bulk_latency_ms, AP_MAVLINK_BULK_LATENCY_MS_DEFAULT),
+
     AP_GROUPEND
 };
 #undef DRATE
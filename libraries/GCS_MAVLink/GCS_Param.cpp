@@ -60,8 +60,8 @@ GCS_MAVLINK::queued_param_send()
     if (bytes_allowed < size_for_one_param_value_msg) {
         bytes_allowed = size_for_one_param_value_msg;
     }
-    if (bytes_allowed > txspace()) {
-        bytes_allowed = txspace();
+    if (bytes_allowed > txspace_bulk()) {
+        bytes_allowed = txspace_bulk();
     }
     uint32_t count = bytes_allowed / size_for_one_param_value_msg;
 
@@ -15,6 +15,18 @@
 #define HAL_MAVLINK_BINDINGS_ENABLED HAL_GCS_ENABLED
 #endif
 
+// number of MISSION_REQUEST_INT which may be outstanding during an
+// upload on a link with pipelined mission uploads enabled
+#ifndef AP_MISSIONITEM_UPLOAD_WINDOW
+#define AP_MISSIONITEM_UPLOAD_WINDOW 8
+#endif
+
+// default limit on how long file, log and parameter transfers may
+// delay other messages on a link, see MAVn_BULK_LAT
+#ifndef AP_MAVLINK_BULK_LATENCY_MS_DEFAULT
+#define AP_MAVLINK_BULK_LATENCY_MS_DEFAULT 200
+#endif
+
 #ifndef HAL_HIGH_LATENCY2_ENABLED
 #define HAL_HIGH_LATENCY2_ENABLED 1
 #endif
@@ -27,6 +27,7 @@
 #include "MAVLink_routing.h"
 
 #include <AP_ADSB/AP_ADSB.h>
+#include <AP_Logger/AP_Logger.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -35,6 +36,10 @@ extern const AP_HAL::HAL& hal;
 // constructor
 MAVLink_routing::MAVLink_routing(void) : num_routes(0) {}
 
+// route index+1 of each route in the chain for a system ID
+#define FOR_EACH_ROUTE_TO_SYSTEM(r, system) \
+    for (uint8_t r = route_hash[route_hash_index(system)]; r != 0; r = routes[r-1].hash_next)
+
 /*
   forward a MAVLink message to the right port. This also
   automatically learns the route for the sender if it is not
@@ -175,41 +180,54 @@ bool MAVLink_routing::check_and_forward(GCS_MAVLINK &in_link, const mavlink_mess
     bool forwarded = false;
     bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS];
     memset(sent_to_chan, 0, sizeof(sent_to_chan));
-    for (uint8_t i=0; i<num_routes; i++) {
+    auto forward_on_route = [&](const route &r) {
 
         // Skip if channel is private and the target system or component IDs do not match
-        GCS_MAVLINK *out_link = gcs().chan(routes[i].channel);
+        GCS_MAVLINK *out_link = gcs().chan(r.channel);
         if (out_link == nullptr) {
             // this is bad
-            continue;
+            return;
         }
         if (out_link->is_private() &&
-            (target_system != routes[i].sysid ||
-             target_component != routes[i].compid)) {
-            continue;
+            (target_system != r.sysid ||
+             target_component != r.compid)) {
+            return;
         }
 
-        if (broadcast_system || (target_system == routes[i].sysid &&
+        if (broadcast_system || (target_system == r.sysid &&
                                  (broadcast_component || 
-                                  target_component == routes[i].compid ||
+                                  target_component == r.compid ||
                                   !match_system))) {
 
-            if (&in_link != out_link && !sent_to_chan[routes[i].channel]) {
+            if (&in_link != out_link && !sent_to_chan[r.channel]) {
                 if (out_link->check_payload_size(msg.len)) {
 #if ROUTING_DEBUG
                     ::printf("fwd msg %u from chan %u on chan %u sysid=%d compid=%d\n",
                              msg.msgid,
                              (unsigned)in_link.get_chan(),
-                             (unsigned)routes[i].channel,
+                             (unsigned)r.channel,
                              (int)target_system,
                              (int)target_component);
 #endif
-                    _mavlink_resend_uart(routes[i].channel, &msg);
+                    _mavlink_resend_uart(r.channel, &msg);
+                    stats.forwarded++;
                 }
-                sent_to_chan[routes[i].channel] = true;
+                sent_to_chan[r.channel] = true;
                 forwarded = true;
             }
         }
+    };
+    if (broadcast_system) {
+        for (uint8_t i=0; i<num_routes; i++) {
+            forward_on_route(routes[i]);
+        }
+    } else {
+        // only routes to the target system can match
+        FOR_EACH_ROUTE_TO_SYSTEM(r, target_system) {
+            if (routes[r-1].sysid == target_system) {
+                forward_on_route(routes[r-1]);
+            }
+        }
     }
 
     if ((!forwarded && match_system) ||
@@ -239,7 +257,8 @@ void MAVLink_routing::send_to_components(const char *pkt, const mavlink_msg_entr
     bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS] {};
 
     // check learned routes
-    for (uint8_t i=0; i<num_routes; i++) {
+    FOR_EACH_ROUTE_TO_SYSTEM(r, mavlink_system.sysid) {
+        const uint8_t i = r-1;
         if (routes[i].sysid != mavlink_system.sysid) {
             // our system ID hasn't been seen on this link
             continue;
@@ -335,24 +354,60 @@ void MAVLink_routing::learn_route(GCS_MAVLINK &in_link, const mavlink_message_t
         return;
     }
     const mavlink_channel_t in_channel = in_link.get_chan();
-    for (i=0; i<num_routes; i++) {
-        if (routes[i].sysid == msg.sysid &&
-            routes[i].compid == msg.compid &&
-            routes[i].channel == in_channel) {
-            if (routes[i].mavtype == 0 && msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
-                routes[i].mavtype = mavlink_msg_heartbeat_get_type(&msg);
+    const uint32_t now_ms = AP_HAL::millis();
+    FOR_EACH_ROUTE_TO_SYSTEM(r, msg.sysid) {
+        route &rt = routes[r-1];
+        if (rt.sysid == msg.sysid &&
+            rt.compid == msg.compid &&
+            rt.channel == in_channel) {
+            if (rt.mavtype == 0 && msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
+                rt.mavtype = mavlink_msg_heartbeat_get_type(&msg);
             }
-            break;
+            rt.last_seen_ms = now_ms;
+            return;
+        }
+    }
+
+    if (num_routes < MAVLINK_MAX_ROUTES) {
+        i = num_routes++;
+    } else {
+        // the table is full; replace the route seen longest ago if
+        // it has not been seen recently.  Only look once a second as
+        // every message from an unknown source would otherwise
+        // search the table
+        if (now_ms - last_full_ms < 1000) {
+            stats.no_space++;
+            return;
+        }
+        i = 0;
+        for (uint8_t j=1; j<num_routes; j++) {
+            if (now_ms - routes[j].last_seen_ms > now_ms - routes[i].last_seen_ms) {
+                i = j;
+            }
+        }
+        if (now_ms - routes[i].last_seen_ms < MAVLINK_ROUTE_EXPIRE_MS) {
+            last_full_ms = now_ms;
+            stats.no_space++;
+            return;
         }
+        route_hash_remove(i);
+        stats.replaced++;
     }
-    if (i == num_routes && i<MAVLINK_MAX_ROUTES) {
-        routes[i].sysid = msg.sysid;
-        routes[i].compid = msg.compid;
-        routes[i].channel = in_channel;
+
+    {
+        route &rt = routes[i];
+        rt.sysid = msg.sysid;
+        rt.compid = msg.compid;
+        rt.channel = in_channel;
+        rt.mavtype = 0;
         if (msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
-            routes[i].mavtype = mavlink_msg_heartbeat_get_type(&msg);
+            rt.mavtype = mavlink_msg_heartbeat_get_type(&msg);
         }
-        num_routes++;
+        rt.last_seen_ms = now_ms;
+        const uint8_t h = route_hash_index(msg.sysid);
+        rt.hash_next = route_hash[h];
+        route_hash[h] = i+1;
+        stats.learned++;
 #if ROUTING_DEBUG
         ::printf("learned route %u %u via %u\n",
                  (unsigned)msg.sysid,
@@ -362,6 +417,47 @@ void MAVLink_routing::learn_route(GCS_MAVLINK &in_link, const mavlink_message_t
     }
 }
 
+// remove a route from its hash chain
+void MAVLink_routing::route_hash_remove(uint8_t i)
+{
+    uint8_t *link = &route_hash[route_hash_index(routes[i].sysid)];
+    while (*link != 0) {
+        if (*link == i+1) {
+            *link = routes[i].hash_next;
+            break;
+        }
+        link = &routes[*link-1].hash_next;
+    }
+    routes[i].hash_next = 0;
+}
+
+void MAVLink_routing::update()
+{
+#if HAL_LOGGING_ENABLED
+    const uint32_t now_ms = AP_HAL::millis();
+    if (num_routes == 0 || now_ms - last_stats_log_ms < 1000) {
+        return;
+    }
+    last_stats_log_ms = now_ms;
+
+// @LoggerMessage: MAVR
+// @Description: MAVLink routing statistics
+// @Field: TimeUS: Time since system startup
+// @Field: N: number of routes known
+// @Field: Fwd: messages forwarded on a route
+// @Field: Lrn: routes learned
+// @Field: Rep: routes replaced as they had not been seen recently
+// @Field: Full: messages from sources not learned as the table was full
+    AP::logger().WriteStreaming("MAVR", "TimeUS,N,Fwd,Lrn,Rep,Full", "s-----", "F-----", "QBIIII",
+                                AP_HAL::micros64(),
+                                num_routes,
+                                stats.forwarded,
+                                stats.learned,
+                                stats.replaced,
+                                stats.no_space);
+#endif
+}
+
 
 /*
   special handling for heartbeat messages. To ensure routing
@@ -382,9 +478,10 @@ void MAVLink_routing::handle_heartbeat(GCS_MAVLINK &link, const mavlink_message_
     mask &= ~no_route_mask;
     
     // mask out channels that are known sources for this sysid/compid
-    for (uint8_t i=0; i<num_routes; i++) {
-        if (routes[i].sysid == msg.sysid && routes[i].compid == msg.compid) {
-            mask &= ~(1U<<((unsigned)(routes[i].channel-MAVLINK_COMM_0)));
+    FOR_EACH_ROUTE_TO_SYSTEM(r, msg.sysid) {
+        const route &rt = routes[r-1];
+        if (rt.sysid == msg.sysid && rt.compid == msg.compid) {
+            mask &= ~(1U<<((unsigned)(rt.channel-MAVLINK_COMM_0)));
         }
     }
 
@@ -3,11 +3,24 @@
 #pragma once
 
 #include <AP_Common/AP_Common.h>
+#include <AP_HAL/AP_HAL_Boards.h>
 #include "GCS_MAVLink.h"
 
-// 20 routes should be enough for now. This may need to increase as
-// we make more extensive use of MAVLink forwarding
+// boards with networking and DroneCAN tunnels can have dozens of
+// components, smaller boards are limited to 20
+#ifndef MAVLINK_MAX_ROUTES
+#if HAL_PROGRAM_SIZE_LIMIT_KB > 1024
+#define MAVLINK_MAX_ROUTES 64
+#else
 #define MAVLINK_MAX_ROUTES 20
+#endif
+#endif
+
+// number of hash chains routes are found through, a power of 2
+#define MAVLINK_ROUTE_HASH_SIZE 16
+
+// when the table is full a route not seen for this long is replaced
+#define MAVLINK_ROUTE_EXPIRE_MS 10000
 
 /*
   object to handle MAVLink packet routing
@@ -49,16 +62,43 @@ public:
      */
     bool find_by_mavtype_and_compid(uint8_t mavtype, uint8_t compid, uint8_t &sysid, mavlink_channel_t &channel) const;
 
+    // log routing statistics, called at 1Hz or faster
+    void update();
+
+    struct Stats {
+        uint32_t forwarded;   // messages forwarded on a route
+        uint32_t learned;     // new routes
+        uint32_t replaced;    // routes replaced after not being seen
+        uint32_t no_space;    // routes not learned as the table was full
+    };
+    const Stats &get_stats() const { return stats; }
+    uint8_t get_num_routes() const { return num_routes; }
+
 private:
-    // a simple linear routing table. We don't expect to have a lot of
-    // routes, so a scalable structure isn't worthwhile yet.
+    // the routes to each system are found through a hash of the
+    // system ID, so messages for one system and learning from each
+    // message received only look at the routes for that system
     uint8_t num_routes;
     struct route {
         uint8_t sysid;
         uint8_t compid;
         mavlink_channel_t channel;
         uint8_t mavtype;
+        uint8_t hash_next;  // index+1 of the next route in the chain, 0 at the end
+        uint32_t last_seen_ms;
     } routes[MAVLINK_MAX_ROUTES];
+    static_assert(MAVLINK_MAX_ROUTES < UINT8_MAX, "route index must fit in hash_next");
+
+    // index+1 of the first route in each chain, 0 if empty
+    uint8_t route_hash[MAVLINK_ROUTE_HASH_SIZE];
+    static uint8_t route_hash_index(uint8_t sysid) {
+        return sysid & (MAVLINK_ROUTE_HASH_SIZE-1);
+    }
+    void route_hash_remove(uint8_t i);
+
+    Stats stats;
+    uint32_t last_full_ms;
+    uint32_t last_stats_log_ms;
     
     // a channel mask to block routing as required
     uint8_t no_route_mask;
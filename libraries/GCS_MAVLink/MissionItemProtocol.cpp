@@ -22,6 +22,9 @@ void MissionItemProtocol::init_send_requests(GCS_MAVLINK &_link,
 
     link = &_link;
 
+    request_sent_i = request_i;
+    request_window = link->mission_upload_pipelined() ? AP_MISSIONITEM_UPLOAD_WINDOW : 1;
+
     timelast_request_ms = AP_HAL::millis();
     link->send_message(next_item_ap_message_id());
 
@@ -270,6 +273,11 @@ void MissionItemProtocol::handle_mission_item(const mavlink_message_t &msg, cons
 
     // check if this is the requested waypoint
     if (cmd.seq != request_i) {
+        if (request_window > 1 && cmd.seq < request_sent_i) {
+            // a repeated or out of order reply to a pipelined
+            // request; request_i will be requested again
+            return;
+        }
         send_mission_ack(msg, MAV_MISSION_INVALID_SEQUENCE);
         return;
     }
@@ -307,6 +315,7 @@ void MissionItemProtocol::handle_mission_item(const mavlink_message_t &msg, cons
     // update waypoint receiving state machine
     timelast_receive_ms = AP_HAL::millis();
     request_i++;
+    request_sent_i = MAX(request_sent_i, request_i);
 
     if (request_i > request_last) {
         transfer_is_complete(*link, msg);
@@ -351,7 +360,8 @@ void MissionItemProtocol::send_mission_ack(const GCS_MAVLINK &_link,
 }
 
 /**
- * @brief Send the next pending waypoint, called from deferred message
+ * @brief Send the next pending waypoint requests, up to the window
+ * ahead of the next expected item, called from deferred message
  * handling code
  */
 void MissionItemProtocol::queued_request_send()
@@ -366,14 +376,18 @@ void MissionItemProtocol::queued_request_send()
         INTERNAL_ERROR(AP_InternalError::error_t::gcs_bad_missionprotocol_link);
         return;
     }
-    CHECK_PAYLOAD_SIZE2_VOID(link->get_chan(), MISSION_REQUEST);
-    mavlink_msg_mission_request_send(
-        link->get_chan(),
-        dest_sysid,
-        dest_compid,
-        request_i,
-        mission_type());
-    timelast_request_ms = AP_HAL::millis();
+    while (request_sent_i <= request_last &&
+           request_sent_i - request_i < request_window) {
+        CHECK_PAYLOAD_SIZE2_VOID(link->get_chan(), MISSION_REQUEST);
+        mavlink_msg_mission_request_send(
+            link->get_chan(),
+            dest_sysid,
+            dest_compid,
+            request_sent_i,
+            mission_type());
+        request_sent_i++;
+        timelast_request_ms = AP_HAL::millis();
+    }
 }
 
 void MissionItemProtocol::update()
@@ -407,6 +421,7 @@ void MissionItemProtocol::update()
     const uint32_t wp_recv_timeout_ms = 1000U + link->get_stream_slowdown_ms();
     if (tnow - timelast_request_ms > wp_recv_timeout_ms) {
         timelast_request_ms = tnow;
+        request_sent_i = request_i;
         link->send_message(next_item_ap_message_id());
     }
 }
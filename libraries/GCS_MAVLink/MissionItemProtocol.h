@@ -21,6 +21,13 @@
 // Starting of uploads (for the same protocol) is also blocked -
 // essentially the GCS uploading a set of items (e.g. a mission) has a
 // mutex over the mission.
+//
+// On links with pipelined uploads enabled in MAVn_OPTIONS up to
+// AP_MISSIONITEM_UPLOAD_WINDOW items are requested before the first
+// of them arrives, so long uploads over high latency links are not
+// limited to one item per round trip.  Replies to requests which are
+// out of order or repeated are ignored and the next expected item is
+// requested again if it doesn't arrive.
 class MissionItemProtocol
 {
 public:
@@ -86,6 +93,8 @@ private:
     virtual void truncate(const mavlink_mission_count_t &packet) = 0;
 
     uint16_t        request_i; // request index
+    uint16_t        request_sent_i; // next index to request, ahead of request_i when pipelining
+    uint8_t         request_window; // number of requests which may be outstanding
 
     // waypoints
     uint8_t         dest_sysid;  // where to send requests
@@ -0,0 +1,65 @@
+#include <AP_gbenchmark.h>
+
+#include <GCS_MAVLink/GCS_MAVLink.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  packing and parsing of a fixed GLOBAL_POSITION_INT and ATTITUDE
+  stream, the two messages sent most often at high stream rates
+ */
+
+#define MAV_BM_SYSID 1
+#define MAV_BM_COMPID 1
+
+static uint16_t pack_messages(uint8_t *buf, uint32_t time_ms)
+{
+    mavlink_message_t msg;
+    uint16_t len = 0;
+
+    mavlink_msg_global_position_int_pack(MAV_BM_SYSID, MAV_BM_COMPID, &msg,
+                                         time_ms, -353632610, 1491652300, 584000, 10000,
+                                         120, -35, 4, 27000);
+    len += mavlink_msg_to_send_buffer(&buf[len], &msg);
+
+    mavlink_msg_attitude_pack(MAV_BM_SYSID, MAV_BM_COMPID, &msg,
+                              time_ms, 0.05f, -0.02f, 1.57f, 0.001f, -0.002f, 0.01f);
+    len += mavlink_msg_to_send_buffer(&buf[len], &msg);
+
+    return len;
+}
+
+static void BM_MAVLinkPack(benchmark::State& state)
+{
+    uint8_t buf[2*MAVLINK_MAX_PACKET_LEN];
+    uint32_t time_ms = 0;
+
+    while (state.KeepRunning()) {
+        uint16_t len = pack_messages(buf, time_ms);
+        gbenchmark_escape(buf);
+        gbenchmark_escape(&len);
+        time_ms += 10;
+    }
+}
+
+static void BM_MAVLinkParse(benchmark::State& state)
+{
+    uint8_t buf[2*MAVLINK_MAX_PACKET_LEN];
+    const uint16_t len = pack_messages(buf, 1000);
+
+    while (state.KeepRunning()) {
+        mavlink_message_t msg;
+        mavlink_status_t status;
+        uint8_t count = 0;
+        for (uint16_t i = 0; i < len; i++) {
+            count += mavlink_parse_char(MAVLINK_COMM_0, buf[i], &msg, &status);
+        }
+        gbenchmark_escape(&count);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * len);
+}
+
+BENCHMARK(BM_MAVLinkPack);
+BENCHMARK(BM_MAVLinkParse);
+
+BENCHMARK_MAIN();
@@ -34,6 +34,7 @@
 #include <AP_AHRS/AP_AHRS.h>
 #include <AP_HAL_SITL/HAL_SITL_Class.h>
 #include <AP_Vehicle/AP_Vehicle_Type.h>
+#include <AP_Math/fast_math.h>
 
 using namespace SITL;
 
@@ -288,14 +289,19 @@ void Aircraft::sync_frame_time(void)
     uint64_t now = get_wall_time_us();
     uint64_t dt_us = now - last_wall_time_us;
 
-    const float target_dt_us = 1.0e6/(rate_hz*target_speedup);
+    if (!is_positive(target_speedup)) {
+        // unlimited speedup, step the physics as fast as the CPU allows
+        sleep_debt_us = 0;
+    } else {
+        const float target_dt_us = 1.0e6/(rate_hz*target_speedup);
 
-    // accumulate sleep debt if we're running too fast
-    sleep_debt_us += target_dt_us - dt_us;
+        // accumulate sleep debt if we're running too fast
+        sleep_debt_us += target_dt_us - dt_us;
 
-    if (sleep_debt_us < -1.0e5) {
-        // don't let a large negative debt build up
-        sleep_debt_us = -1.0e5;
+        if (sleep_debt_us < -1.0e5) {
+            // don't let a large negative debt build up
+            sleep_debt_us = -1.0e5;
+        }
     }
     if (sleep_debt_us > min_sleep_time) {
         // sleep if we have built up a debt of min_sleep_tim
@@ -306,7 +312,13 @@ void Aircraft::sync_frame_time(void)
 #else
         // ??
 #endif
-        sleep_debt_us -= (get_wall_time_us() - now);
+        const uint64_t slept_us = get_wall_time_us() - now;
+        sleep_debt_us -= slept_us;
+#if AP_SIM_PROFILE_ENABLED
+        if (sitl != nullptr) {
+            sitl->profile.add_time("sleep", slept_us);
+        }
+#endif
     }
     last_wall_time_us = get_wall_time_us();
 
@@ -467,7 +479,7 @@ void Aircraft::fill_fdm(struct sitl_fdm &fdm)
         sitl->speedup.set(get_speedup());
     }
     
-    if (!is_equal(last_speedup, float(sitl->speedup)) && sitl->speedup > 0) {
+    if (!is_equal(last_speedup, float(sitl->speedup)) && sitl->speedup >= 0) {
         set_speedup(sitl->speedup);
         last_speedup = sitl->speedup;
     }
@@ -883,9 +895,10 @@ void Aircraft::update_dynamics(const Vector3f &rot_accel)
 void Aircraft::update_wind(const struct sitl_input &input)
 {
     // wind vector in earth frame
-    wind_ef = Vector3f(cosf(radians(input.wind.direction))*cosf(radians(input.wind.dir_z)), 
-                       sinf(radians(input.wind.direction))*cosf(radians(input.wind.dir_z)), 
-                       sinf(radians(input.wind.dir_z))) * input.wind.speed;
+    float dir_sin, dir_cos, dir_z_sin, dir_z_cos;
+    fast_sincosf<FastMathAccuracy::MEDIUM>(radians(input.wind.direction), dir_sin, dir_cos);
+    fast_sincosf<FastMathAccuracy::MEDIUM>(radians(input.wind.dir_z), dir_z_sin, dir_z_cos);
+    wind_ef = Vector3f(dir_cos*dir_z_cos, dir_sin*dir_z_cos, dir_z_sin) * input.wind.speed;
 
     wind_ef.z += get_local_updraft(position + home.get_distance_NED_double(origin));
 
@@ -894,16 +907,19 @@ void Aircraft::update_wind(const struct sitl_input &input)
 
     if (wind_turb > 0 && !on_ground()) {
 
-        turbulence_azimuth = turbulence_azimuth + (2 * rand());
+        // keep the random azimuth in range for fast_sincosf
+        turbulence_azimuth = wrap_360(turbulence_azimuth + 2.0f * rand());
 
         turbulence_horizontal_speed =
                 static_cast<float>(turbulence_horizontal_speed * iir_coef+wind_turb * rand_normal(0, 1) * (1 - iir_coef));
 
         turbulence_vertical_speed = static_cast<float>((turbulence_vertical_speed * iir_coef) + (wind_turb * rand_normal(0, 1) * (1 - iir_coef)));
 
+        float azimuth_sin, azimuth_cos;
+        fast_sincosf<FastMathAccuracy::LOW>(radians(turbulence_azimuth), azimuth_sin, azimuth_cos);
         wind_ef += Vector3f(
-            cosf(radians(turbulence_azimuth)) * turbulence_horizontal_speed,
-            sinf(radians(turbulence_azimuth)) * turbulence_horizontal_speed,
+            azimuth_cos * turbulence_horizontal_speed,
+            azimuth_sin * turbulence_horizontal_speed,
             turbulence_vertical_speed);
     }
 
@@ -1112,6 +1128,7 @@ void Aircraft::update_external_payload(const struct sitl_input &input)
 
     // update i2c
     if (i2c) {
+        SIM_PROFILE(sitl->profile, "i2c");
         i2c->update(*this);
     }
 
@@ -1364,7 +1381,7 @@ void Aircraft::update_eas_airspeed()
     airspeed_pitot = airspeed;
 
     // calculate angle between the local flow vector and a pitot tube aligned with the X body axis
-    const float pitot_aoa =  atan2f(sqrtf(sq(velocity_air_bf.y) + sq(velocity_air_bf.z)), velocity_air_bf.x);
+    const float pitot_aoa = fast_atan2f<FastMathAccuracy::MEDIUM>(sqrtf(sq(velocity_air_bf.y) + sq(velocity_air_bf.z)), velocity_air_bf.x);
 
     /*
       assume the pitot can correctly capture airspeed up to 20 degrees off the nose
@@ -59,7 +59,7 @@ public:
     virtual void set_start_location(const Location &start_loc, const float start_yaw);
 
     /*
-      set simulation speedup
+      set simulation speedup, zero runs as fast as possible
      */
     void set_speedup(float speedup);
     float get_speedup() const { return target_speedup; }
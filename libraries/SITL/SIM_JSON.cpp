@@ -25,6 +25,14 @@
 #include <stdio.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Logger/AP_Logger.h>
@@ -66,7 +74,10 @@ JSON::JSON(const char *frame_str) :
     printf("Starting SITL: JSON\n");
 
     const char *colon = strchr(frame_str, ':');
-    if (colon) {
+    if (colon && strncmp(colon+1, "shm", 3) == 0) {
+        // optional name of the shared memory object after a second colon
+        shm_name = (colon[4] == ':') ? colon+5 : "";
+    } else if (colon) {
         target_ip = colon+1;
     }
 
@@ -271,16 +282,32 @@ void JSON::recv_fdm(const struct sitl_input &input)
     }
 
     const uint32_t received_bitmask = parse_sensors((const char *)(p1+1));
+    if (!check_received(received_bitmask)) {
+        return;
+    }
+
+    memmove(sensor_buffer, p2, sensor_buffer_len - (p2 - sensor_buffer));
+    sensor_buffer_len = sensor_buffer_len - (p2 - sensor_buffer);
+
+    apply_state(received_bitmask);
+}
+
+/*
+    check received data has the mandatory fields, printing the fields
+    whenever they change
+*/
+bool JSON::check_received(uint32_t received_bitmask)
+{
     if (received_bitmask == 0) {
         // did not receive one of the mandatory fields
         printf("Did not contain all mandatory fields\n");
-        return;
+        return false;
     }
 
     // Must get either attitude or quaternion fields
     if ((received_bitmask & (EULER_ATT | QUAT_ATT)) == 0) {
         printf("Did not receive attitude or quaternion\n");
-        return;
+        return false;
     }
 
     if (received_bitmask != last_received_bitmask) {
@@ -301,9 +328,14 @@ void JSON::recv_fdm(const struct sitl_input &input)
     }
     last_received_bitmask = received_bitmask;
 
-    memmove(sensor_buffer, p2, sensor_buffer_len - (p2 - sensor_buffer));
-    sensor_buffer_len = sensor_buffer_len - (p2 - sensor_buffer);
+    return true;
+}
 
+/*
+    update the vehicle from received sensor data
+*/
+void JSON::apply_state(uint32_t received_bitmask)
+{
     accel_body = state.imu.accel_body;
     gyro = state.imu.gyro;
     velocity_ef = state.velocity;
@@ -446,16 +478,148 @@ void JSON::recv_fdm(const struct sitl_input &input)
 
 }
 
+#if defined(__linux__)
+static void shm_wake(uint32_t *seq)
+{
+    syscall(SYS_futex, seq, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+static void shm_wait(uint32_t *seq, uint32_t old_seq)
+{
+    struct timespec ts {};
+    ts.tv_nsec = UDP_TIMEOUT_MS * 1000000UL;
+    syscall(SYS_futex, seq, FUTEX_WAIT, old_seq, &ts, nullptr, 0);
+}
+#else
+// no futex, the other side polls
+static void shm_wake(uint32_t *) {}
+
+static void shm_wait(uint32_t *, uint32_t)
+{
+    usleep(20);
+}
+#endif
+
+/*
+    create and map the shared memory object for the shm transport
+*/
+bool JSON::open_shm(void)
+{
+    char name[64];
+    if (shm_name[0] != '\0') {
+        strncpy(name, shm_name, sizeof(name)-1);
+        name[sizeof(name)-1] = 0;
+    } else {
+        snprintf(name, sizeof(name), "/ardupilot_json_%u", unsigned(instance));
+    }
+
+    const int fd = ::shm_open(name, O_RDWR | O_CREAT, 0666);
+    if (fd == -1) {
+        printf("JSON: failed to open shared memory %s - %s\n", name, strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, sizeof(struct sim_json_shm)) != 0) {
+        printf("JSON: failed to size shared memory %s - %s\n", name, strerror(errno));
+        ::close(fd);
+        return false;
+    }
+    void *p = mmap(nullptr, sizeof(struct sim_json_shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        printf("JSON: failed to map shared memory %s - %s\n", name, strerror(errno));
+        return false;
+    }
+
+    shm = (struct sim_json_shm *)p;
+    memset(shm, 0, sizeof(*shm));
+    shm->magic = SIM_JSON_SHM_MAGIC;
+    shm->version = SIM_JSON_SHM_VERSION;
+    shm_fdm_seq = 0;
+
+    printf("JSON shared memory interface at %s\n", name);
+    return true;
+}
+
+/*
+    write servos to shared memory and signal the physics backend
+*/
+void JSON::output_servos_shm(const struct sitl_input &input)
+{
+    const uint8_t num_channels = SRV_Channels::have_32_channels() ? 32 : 16;
+    shm->servos.frame_rate = rate_hz;
+    shm->servos.num_channels = num_channels;
+    shm->servos.frame_count = frame_counter;
+    for (uint8_t i=0; i<num_channels; i++) {
+        shm->servos.pwm[i] = input.servos[i];
+    }
+    __atomic_add_fetch(&shm->servos.seq, 1, __ATOMIC_RELEASE);
+    shm_wake(&shm->servos.seq);
+}
+
+/*
+    wait for the physics backend to write the next frame to shared memory
+*/
+void JSON::recv_fdm_shm(const struct sitl_input &input)
+{
+    uint64_t wait_start_us = get_wall_time_us();
+    uint32_t seq;
+    while ((seq = __atomic_load_n(&shm->fdm.seq, __ATOMIC_ACQUIRE)) == shm_fdm_seq) {
+        shm_wait(&shm->fdm.seq, seq);
+        // resend servos if nothing arrives, so a restarted physics backend reconnects
+        if (get_wall_time_us() - wait_start_us > 1000000U) {
+            wait_start_us = get_wall_time_us();
+            printf("No JSON sensor frame received, resending servos\n");
+            output_servos_shm(input);
+        }
+    }
+    shm_fdm_seq = seq;
+
+    const auto &fdm = shm->fdm;
+    uint32_t received_bitmask = fdm.fields & ((1U << ARRAY_SIZE(keytable)) - 1);
+    for (uint8_t i=0; i<ARRAY_SIZE(keytable); i++) {
+        if (keytable[i].required && (received_bitmask & (1U << i)) == 0) {
+            received_bitmask = 0;
+            break;
+        }
+    }
+    if (!check_received(received_bitmask)) {
+        return;
+    }
+
+    state.timestamp_s = fdm.timestamp_s;
+    state.imu.gyro = Vector3f(fdm.gyro[0], fdm.gyro[1], fdm.gyro[2]);
+    state.imu.accel_body = Vector3f(fdm.accel_body[0], fdm.accel_body[1], fdm.accel_body[2]);
+    state.position = Vector3d(fdm.position[0], fdm.position[1], fdm.position[2]);
+    state.attitude = Vector3f(fdm.attitude[0], fdm.attitude[1], fdm.attitude[2]);
+    state.quaternion = Quaternion(fdm.quaternion[0], fdm.quaternion[1], fdm.quaternion[2], fdm.quaternion[3]);
+    state.velocity = Vector3f(fdm.velocity[0], fdm.velocity[1], fdm.velocity[2]);
+    memcpy(state.rng, fdm.rng, sizeof(state.rng));
+    state.wind_vane_apparent.direction = fdm.windvane_direction;
+    state.wind_vane_apparent.speed = fdm.windvane_speed;
+    state.airspeed = fdm.airspeed;
+    state.no_time_sync = (received_bitmask & TIME_SYNC) && fdm.no_time_sync != 0;
+
+    apply_state(received_bitmask);
+}
+
 /*
    update the JSON simulation by one time step
 */
 void JSON::update(const struct sitl_input &input)
 {
-    // send to JSON model
-    output_servos(input);
+    if (shm_name != nullptr) {
+        if (shm == nullptr && !open_shm()) {
+            exit(1);
+        }
+        output_servos_shm(input);
+        recv_fdm_shm(input);
+    } else {
+        // send to JSON model
+        output_servos(input);
 
-    // receive from JSON model
-    recv_fdm(input);
+        // receive from JSON model
+        recv_fdm(input);
+    }
 
     // update magnetic field
     // as the model does not provide mag feild we calculate it from position and attitude
@@ -20,6 +20,7 @@
 
 #include <AP_HAL/utility/Socket_native.h>
 #include "SIM_Aircraft.h"
+#include "SIM_JSON_shm.h"
 
 namespace SITL {
 
@@ -69,6 +70,16 @@ private:
     void recv_fdm(const struct sitl_input &input);
 
     uint32_t parse_sensors(const char *json);
+    bool check_received(uint32_t received_bitmask);
+    void apply_state(uint32_t received_bitmask);
+
+    // shared memory transport, selected with a frame of JSON:shm or JSON:shm:/name
+    const char *shm_name;
+    struct sim_json_shm *shm;
+    uint32_t shm_fdm_seq;
+    bool open_shm(void);
+    void output_servos_shm(const struct sitl_input &input);
+    void recv_fdm_shm(const struct sitl_input &input);
 
     // buffer for parsing pose data in JSON format
     uint8_t sensor_buffer[65000];
@@ -0,0 +1,82 @@
+/*
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*
+  binary layout of the shared memory transport for the JSON
+  backend. This header has no ArduPilot dependencies so physics
+  backends can include it directly.
+
+  ArduPilot creates and initialises the shared memory object. Each
+  side fills in its half and then increments its seq field with
+  release ordering, on Linux it also does a FUTEX_WAKE on the seq
+  field. The other side waits for seq to change, then reads the data
+  with acquire ordering. The simulation runs in lockstep, so there is
+  at most one frame outstanding in each direction.
+
+  If no fdm frame arrives for a second ArduPilot increments
+  servos.seq again without changing frame_count, as it re-sends
+  servo packets over UDP, so a restarted physics backend reconnects.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define SIM_JSON_SHM_MAGIC   0x4E534A41 // "AJSN"
+#define SIM_JSON_SHM_VERSION 1
+
+// bits of fdm.fields, in the same order as the JSON keys
+#define SIM_JSON_SHM_TIMESTAMP   (1U << 0)  // required
+#define SIM_JSON_SHM_GYRO        (1U << 1)  // required
+#define SIM_JSON_SHM_ACCEL_BODY  (1U << 2)  // required
+#define SIM_JSON_SHM_POSITION    (1U << 3)  // required
+#define SIM_JSON_SHM_ATTITUDE    (1U << 4)  // attitude or quaternion required
+#define SIM_JSON_SHM_QUATERNION  (1U << 5)
+#define SIM_JSON_SHM_VELOCITY    (1U << 6)  // required
+#define SIM_JSON_SHM_RNG_1       (1U << 7)  // RNG_1 to RNG_6 in consecutive bits
+#define SIM_JSON_SHM_WIND_DIR    (1U << 13)
+#define SIM_JSON_SHM_WIND_SPD    (1U << 14)
+#define SIM_JSON_SHM_AIRSPEED    (1U << 15)
+#define SIM_JSON_SHM_TIME_SYNC   (1U << 16)
+
+struct sim_json_shm {
+    uint32_t magic;
+    uint32_t version;
+
+    // written by ArduPilot
+    struct {
+        uint32_t seq;
+        uint16_t frame_rate;
+        uint16_t num_channels;  // 16, or 32 with SERVO_32_ENABLE
+        uint32_t frame_count;
+        uint16_t pwm[32];
+    } servos;
+
+    // written by the physics backend, units and frames as for the JSON fields
+    struct {
+        uint32_t seq;
+        uint32_t fields;        // SIM_JSON_SHM_ bits for the values that are valid
+        double timestamp_s;
+        double position[3];
+        float gyro[3];
+        float accel_body[3];
+        float attitude[3];
+        float quaternion[4];
+        float velocity[3];
+        float rng[6];
+        float windvane_direction;
+        float windvane_speed;
+        float airspeed;
+        uint32_t no_time_sync;
+    } fdm;
+};
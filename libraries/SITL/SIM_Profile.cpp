@@ -0,0 +1,159 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  wall clock accounting of simulation step time
+*/
+
+#include "SIM_Profile.h"
+
+#if AP_SIM_PROFILE_ENABLED
+
+#include <AP_Math/AP_Math.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+using namespace SITL;
+
+// interval between reports, in wall clock time
+static constexpr uint64_t REPORT_INTERVAL_US = 10000000;
+
+uint64_t Profile::wall_time_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000ULL + ts.tv_nsec / 1000ULL;
+}
+
+Profile::Scope::Scope(Profile &_profile, const char *_name) :
+    profile(_profile),
+    name(_name),
+    start_us(_profile.enabled ? wall_time_us() : 0),
+    outer_nested_us(_profile.nested_us)
+{
+    profile.nested_us = 0;
+}
+
+/*
+  sections record their own time, time spent in scopes nested inside
+  them is recorded against the nested sections instead
+ */
+Profile::Scope::~Scope()
+{
+    if (start_us != 0 && profile.enabled) {
+        const uint64_t elapsed_us = wall_time_us() - start_us;
+        profile.add(name, elapsed_us - MIN(profile.nested_us, elapsed_us));
+        profile.nested_us = outer_nested_us + elapsed_us;
+    } else {
+        profile.nested_us = outer_nested_us;
+    }
+}
+
+void Profile::add_time(const char *name, uint32_t elapsed_us)
+{
+    if (!enabled) {
+        return;
+    }
+    add(name, elapsed_us);
+    nested_us += elapsed_us;
+}
+
+void Profile::add(const char *name, uint32_t elapsed_us)
+{
+    uint8_t i;
+    for (i=0; i<num_sections; i++) {
+        if (sections[i].name == name || strcmp(sections[i].name, name) == 0) {
+            break;
+        }
+    }
+    if (i == num_sections) {
+        if (num_sections >= ARRAY_SIZE(sections)) {
+            return;
+        }
+        sections[num_sections++] = Section{name, 0, 0, 0};
+    }
+    Section &s = sections[i];
+    s.total_us += elapsed_us;
+    s.count++;
+    s.max_us = MAX(s.max_us, elapsed_us);
+}
+
+void Profile::step_done()
+{
+    if (!enabled) {
+        return;
+    }
+    const uint64_t now_us = wall_time_us();
+    if (last_step_us == 0) {
+        last_step_us = now_us;
+        last_report_us = now_us;
+        return;
+    }
+    max_step_us = MAX(max_step_us, uint32_t(now_us - last_step_us));
+    nested_us = 0;
+    last_step_us = now_us;
+    steps++;
+
+    if (now_us - last_report_us >= REPORT_INTERVAL_US) {
+        report(now_us - last_report_us);
+        last_report_us = now_us;
+    }
+}
+
+/*
+  print the sections sorted by total time. Time not accounted to any
+  section is spent in the firmware between simulation steps
+ */
+void Profile::report(uint64_t period_us)
+{
+    // insertion sort, there are only a few sections
+    Section sorted[ARRAY_SIZE(sections)];
+    uint64_t accounted_us = 0;
+    for (uint8_t i=0; i<num_sections; i++) {
+        uint8_t j = i;
+        while (j > 0 && sorted[j-1].total_us < sections[i].total_us) {
+            sorted[j] = sorted[j-1];
+            j--;
+        }
+        sorted[j] = sections[i];
+        accounted_us += sections[i].total_us;
+    }
+
+    ::printf("SIM profile: %u steps in %.1fs, %.1fus/step avg, %uus max\n",
+             unsigned(steps), period_us * 1.0e-6,
+             steps > 0 ? double(period_us) / steps : 0.0,
+             unsigned(max_step_us));
+    ::printf("  %-20s %8s %8s %8s %6s\n", "section", "calls", "avg us", "max us", "%");
+    for (uint8_t i=0; i<num_sections; i++) {
+        const Section &s = sorted[i];
+        ::printf("  %-20s %8u %8.1f %8u %5.1f%%\n",
+                 s.name, unsigned(s.count),
+                 s.count > 0 ? double(s.total_us) / s.count : 0.0,
+                 unsigned(s.max_us),
+                 100.0 * s.total_us / period_us);
+    }
+    if (period_us > accounted_us) {
+        ::printf("  %-20s %8s %8s %8s %5.1f%%\n", "firmware", "", "", "",
+                 100.0 * (period_us - accounted_us) / period_us);
+    }
+
+    memset(sections, 0, sizeof(sections));
+    num_sections = 0;
+    steps = 0;
+    max_step_us = 0;
+}
+
+#endif  // AP_SIM_PROFILE_ENABLED
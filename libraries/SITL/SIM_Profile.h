@@ -0,0 +1,98 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  wall clock accounting of where the time of each simulation step
+  goes, enabled with --profile-sim
+
+  Each simulated device update is timed against a named section and
+  every ten seconds a table of the sections is printed to stdout,
+  along with the share of the step left for the firmware itself.
+*/
+
+#pragma once
+
+#include "SIM_config.h"
+
+#if AP_SIM_PROFILE_ENABLED
+
+#include <stdint.h>
+#include <AP_Common/AP_Common.h>
+
+namespace SITL {
+
+class Profile {
+public:
+
+    // add the wall clock time of a scope to a section. Scopes may be
+    // nested. The name must be a string literal as only the pointer
+    // is kept
+    class Scope {
+    public:
+        Scope(Profile &_profile, const char *_name);
+        ~Scope();
+
+        CLASS_NO_COPY(Scope);
+
+    private:
+        Profile &profile;
+        const char *name;
+        uint64_t start_us;
+        uint64_t outer_nested_us;
+    };
+
+    void set_enabled(bool _enabled) { enabled = _enabled; }
+    bool is_enabled() const { return enabled; }
+
+    // add time measured by the caller to a section, counted as nested
+    // in the enclosing scope
+    void add_time(const char *name, uint32_t elapsed_us);
+
+    // called once per simulation step, prints the report when it is due
+    void step_done();
+
+private:
+
+    static uint64_t wall_time_us();
+
+    void add(const char *name, uint32_t elapsed_us);
+    void report(uint64_t period_us);
+
+    struct Section {
+        const char *name;
+        uint64_t total_us;
+        uint32_t count;
+        uint32_t max_us;
+    } sections[32];
+    uint8_t num_sections;
+
+    // time spent in scopes nested in the current scope
+    uint64_t nested_us;
+
+    bool enabled;
+    uint32_t steps;
+    uint32_t max_step_us;
+    uint64_t last_step_us;
+    uint64_t last_report_us;
+};
+
+} // namespace SITL
+
+#define SIM_PROFILE(profile, name) SITL::Profile::Scope _sim_profile_scope(profile, name)
+
+#else
+
+#define SIM_PROFILE(profile, name)
+
+#endif  // AP_SIM_PROFILE_ENABLED
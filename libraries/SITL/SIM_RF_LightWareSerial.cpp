@@ -40,12 +40,12 @@ bool RF_LightWareSerial::check_synced()
     return synced;
 }
 
-void RF_LightWareSerial::update(float range)
+void RF_LightWareSerial::update(const Aircraft &aircraft)
 {
     if (!check_synced()) {
         return;
     }
-    return SerialRangeFinder::update(range);
+    return SerialRangeFinder::update(aircraft);
 }
 
 uint32_t RF_LightWareSerial::packet_for_alt(uint16_t alt_cm, uint8_t *buffer, uint8_t buflen)
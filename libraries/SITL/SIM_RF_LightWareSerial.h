@@ -40,7 +40,7 @@ public:
 
     uint32_t packet_for_alt(uint16_t alt_cm, uint8_t *buffer, uint8_t buflen) override;
 
-    void update(float range) override;
+    void update(const Aircraft &aircraft) override;
 
 private:
 
@@ -104,10 +104,10 @@ void RF_Wasp::check_configuration()
     _buflen = 0;
 }
 
-void RF_Wasp::update(float range)
+void RF_Wasp::update(const Aircraft &aircraft)
 {
     check_configuration();
-    return SerialRangeFinder::update(range);
+    return SerialRangeFinder::update(aircraft);
 }
 
 
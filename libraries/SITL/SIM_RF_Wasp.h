@@ -38,7 +38,7 @@ public:
 
     static SerialRangeFinder *create() { return NEW_NOTHROW RF_Wasp(); }
 
-    void update(float range) override;
+    void update(const Aircraft &aircraft) override;
 
     uint32_t packet_for_alt(uint16_t alt_cm, uint8_t *buffer, uint8_t buflen) override;
 
@@ -20,7 +20,7 @@
 
 using namespace SITL;
 
-void SerialRangeFinder::update(float range)
+void SerialRangeFinder::update(const Aircraft &aircraft)
 {
     // just send a chunk of data at 5Hz:
     const uint32_t now = AP_HAL::millis();
@@ -29,7 +29,7 @@ void SerialRangeFinder::update(float range)
     }
     last_sent_ms = now;
 
-    const uint16_t range_cm = uint16_t(range*100);
+    const uint16_t range_cm = uint16_t(aircraft.rangefinder_range()*100);
     uint8_t data[255];
     const uint32_t packetlen = packet_for_alt(range_cm,
                                               data,
@@ -31,8 +31,8 @@ public:
 
     SerialRangeFinder() {};
 
-    // update state
-    virtual void update(float range);
+    // update state, the range is only calculated when a reading is due
+    virtual void update(const Aircraft &aircraft);
 
     virtual uint32_t packet_for_alt(uint16_t alt_cm, uint8_t *buffer, uint8_t buflen) = 0;
 
@@ -324,3 +324,7 @@
 #ifndef AP_SIM_XPLANE_ENABLED
 #define AP_SIM_XPLANE_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL)
 #endif  // AP_SIM_XPLANE_ENABLED
+
+#ifndef AP_SIM_PROFILE_ENABLED
+#define AP_SIM_PROFILE_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_SITL)
+#endif  // AP_SIM_PROFILE_ENABLED
@@ -34,6 +34,7 @@
 #include "SIM_ADSB_Sagetech_MXS.h"
 #include "SIM_Volz.h"
 #include "SIM_AIS.h"
+#include "SIM_Profile.h"
 
 namespace SITL {
 
@@ -546,6 +547,9 @@ public:
 #if AP_TEST_DRONECAN_DRIVERS
     DroneCANDevice dronecan_sim;
 #endif
+#if AP_SIM_PROFILE_ENABLED
+    Profile profile;
+#endif
 
     // ESC telemetry
     AP_Int8 esc_telem;
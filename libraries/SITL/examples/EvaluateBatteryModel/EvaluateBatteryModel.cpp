@@ -36,7 +36,7 @@ SITL::Battery battery;
 
 void setup(void)
 {
-    uint8_t argc;
+    int argc;
     char * const *argv;
 
     hal.util->commandline_arguments(argc, argv);
@@ -53,7 +53,7 @@ SITL::Motor motor{0,0,1,1};
 
 void setup(void)
 {
-    uint8_t argc;
+    int argc;
     char * const *argv;
 
     hal.util->commandline_arguments(argc, argv);